@@ -28,5 +28,8 @@
 #define BVVECS       'vecs'
 #define BVCONTIGUOUS 'contiguous'
 #define BVTENSOR     'tensor'
+#define BVMIXED      'mixed'
+#define BVMMAP       'mmap'
+#define BVPANEL      'panel'
 
 #endif
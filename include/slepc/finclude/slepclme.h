@@ -22,5 +22,8 @@
 #define LMEProblemType     PetscEnum
 
 #define LMEKRYLOV      'krylov'
+#define LMEEKSM        'eksm'
+#define LMERKSM        'rksm'
+#define LMEADI         'adi'
 
 #endif
@@ -29,6 +29,7 @@
 #define SVDTRLanczosGBidiag PetscEnum
 #define SVDKSVDEigenMethod  PetscEnum
 #define SVDKSVDPolarMethod  PetscEnum
+#define SVDRandomizedSketchType PetscEnum
 
 #define SVDCROSS      'cross'
 #define SVDCYCLIC     'cyclic'
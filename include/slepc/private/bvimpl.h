@@ -50,6 +50,7 @@ struct _BVOps {
   PetscErrorCode (*restorearrayread)(BV,const PetscScalar**);
   PetscErrorCode (*restoresplit)(BV,BV*,BV*);
   PetscErrorCode (*restoresplitrows)(BV,IS,IS,BV*,BV*);
+  PetscErrorCode (*resetsplit)(BV);
   PetscErrorCode (*gramschmidt)(BV,PetscInt,Vec,PetscBool*,PetscScalar*,PetscScalar*,PetscReal*,PetscReal*);
   PetscErrorCode (*getmat)(BV,Mat*);
   PetscErrorCode (*restoremat)(BV,Mat*);
@@ -80,6 +81,7 @@ struct _p_BV {
   BVMatMultType      vmm;          /* version of matmult operation */
   PetscBool          rrandom;      /* reproducible random vectors */
   PetscReal          deftol;       /* tolerance for BV_SafeSqrt */
+  PetscInt           sstep;        /* block size of s-step Krylov expansion */
 
   /*---------------------- Cached data and workspace -------------------*/
   Vec                buffer;       /* buffer vector used in orthogonalization */
@@ -96,6 +98,7 @@ struct _p_BV {
   PetscBool          defersfo;     /* deferred call to setfromoptions */
   BV                 cached;       /* cached BV to store result of matrix times BV */
   PetscObjectState   bvstate;      /* state of BV when BVApplyMatrixBV() was called */
+  BV                 cnstr;        /* copy of the constraints as regular columns, used in BVOrthogonalize() */
   BV                 L,R;          /* BV objects obtained with BVGetSplit/Rows() */
   PetscObjectState   lstate,rstate;/* state of L and R when BVGetSplit/Rows() was called */
   PetscInt           lsplit;       /* value of l when BVGetSplit() was called (-1 if BVGetSplitRows()) */
@@ -104,14 +107,64 @@ struct _p_BV {
   PetscRandom        rand;         /* random number generator */
   Mat                Acreate;      /* matrix given at BVCreateFromMat() */
   Mat                Aget;         /* matrix returned for BVGetMat() */
+  PetscObjectId      mmid;         /* id of the matrix A of the product A*V stored in Aget by BVMatMult() */
+  PetscObjectState   mmstate;      /* nonzero state of A when the symbolic product was computed */
   PetscBool          cuda;         /* true if NVIDIA GPU must be used */
   PetscBool          hip;          /* true if AMD GPU must be used */
   PetscBool          sfocalled;    /* setfromoptions has been called */
+  PetscScalar        *sketch;      /* sketches of the columns, used in randomized Gram-Schmidt */
+  PetscInt           nsketch;      /* dimension of the sketch (number of rows of sketch) */
+  PetscInt           sketchk;      /* number of columns (including constraints) with valid sketch */
+  PetscObjectState   sketchstate;  /* state of BV when sketch was last updated */
+  PetscInt           tilebs;       /* row block size of BVMultInPlace kernel (0 if not tuned yet) */
+  PetscInt           nthreads;     /* number of OpenMP threads used in the BV kernels */
+  PetscBool          hierred;      /* two-level (intra-node, inter-node) global reductions */
+  PetscBool          reprored;     /* reproducible global reductions, independent of the number of processes */
+  PetscBool          deviceonly;   /* the data of a GPU BV must not be accessed on the host */
   PetscScalar        *work;
   PetscInt           lwork;
   void               *data;
 };
 
+/*
+  BV_SketchValid - Whether the cached sketches (randomized Gram-Schmidt) are up to date
+*/
+#define BV_SketchValid(bv) ((bv)->sketch && ((PetscObject)(bv))->state==(bv)->sketchstate)
+
+/*
+  BV_SketchKeep - Keeps the cached sketches valid after an operation that modified
+  only columns j,j+1,...; the sketches of these columns are discarded. The flag valid
+  must be BV_SketchValid(bv) as evaluated before the operation.
+*/
+static inline PetscErrorCode BV_SketchKeep(BV bv,PetscBool valid,PetscInt j)
+{
+  PetscFunctionBegin;
+  if (valid) {
+    bv->sketchk = PetscMin(bv->sketchk,bv->nc+j);
+    PetscCall(PetscObjectStateGet((PetscObject)bv,&bv->sketchstate));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  BV_SketchScaleColumn - Same as BV_SketchKeep() for an operation that scaled column j
+*/
+static inline PetscErrorCode BV_SketchScaleColumn(BV bv,PetscBool valid,PetscInt j,PetscScalar alpha)
+{
+  PetscInt       i;
+  PetscScalar    *s;
+
+  PetscFunctionBegin;
+  if (valid) {
+    if (bv->nc+j<bv->sketchk) {
+      s = bv->sketch+(bv->nc+j)*bv->nsketch;
+      for (i=0;i<bv->nsketch;i++) s[i] *= alpha;
+    }
+    PetscCall(PetscObjectStateGet((PetscObject)bv,&bv->sketchstate));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
   BV_SafeSqrt - Computes the square root of a scalar value alpha, which is
   assumed to be z'*B*z. The result is
@@ -241,6 +294,7 @@ static inline PetscErrorCode BV_SetMatrixDiagonal(BV bv,Vec vomega,Mat M)
 
 #define BVCheckSizes(h,arg) do {(void)(h);} while (0)
 #define BVCheckOp(h,arg,op) do {(void)(h);} while (0)
+#define BVCheckHostAccess(h,arg) do {(void)(h);} while (0)
 
 #else
 
@@ -254,26 +308,40 @@ static inline PetscErrorCode BV_SetMatrixDiagonal(BV bv,Vec vomega,Mat M)
     PetscCheck((h)->ops->op,PetscObjectComm((PetscObject)(h)),PETSC_ERR_SUP,"Operation not implemented in this BV type: Parameter #%d",arg); \
   } while (0)
 
+#define BVCheckHostAccess(h,arg) \
+  do { \
+    PetscCheck(!(h)->deviceonly || !((h)->cuda || (h)->hip),PetscObjectComm((PetscObject)(h)),PETSC_ERR_ARG_WRONGSTATE,"Host access to the data of a device-only BV, see BVSetDeviceOnly(): Parameter #%d",arg); \
+  } while (0)
+
 #endif
 
 SLEPC_INTERN PetscErrorCode BVView_Vecs(BV,PetscViewer);
 
 SLEPC_INTERN PetscErrorCode BVAllocateWork_Private(BV,PetscInt);
+SLEPC_INTERN PetscErrorCode BVViewColumns_Private(BV,PetscInt,PetscInt,PetscViewer);
+SLEPC_INTERN PetscErrorCode BVLoadColumns_Private(BV,PetscInt,PetscInt,PetscViewer);
+SLEPC_INTERN PetscErrorCode BV_SketchMultInPlace(BV,PetscBool,Mat,PetscInt,PetscInt);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcSolutionSave_Private(PetscObject,const char[],PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,BV[]);
 
 SLEPC_INTERN PetscErrorCode BVMult_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,PetscScalar,const PetscScalar*,PetscInt,const PetscScalar*,PetscInt,PetscScalar,PetscScalar*,PetscInt);
 SLEPC_INTERN PetscErrorCode BVMultVec_BLAS_Private(BV,PetscInt,PetscInt,PetscScalar,const PetscScalar*,PetscInt,const PetscScalar*,PetscScalar,PetscScalar*);
 SLEPC_INTERN PetscErrorCode BVMultInPlace_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,PetscInt,PetscScalar*,PetscInt,const PetscScalar*,PetscInt,PetscBool);
 SLEPC_INTERN PetscErrorCode BVMultInPlace_Vecs_Private(BV,PetscInt,PetscInt,PetscInt,Vec*,const PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode BVAXPY_BLAS_Private(BV,PetscInt,PetscInt,PetscScalar,const PetscScalar*,PetscInt,PetscScalar,PetscScalar*,PetscInt);
+SLEPC_INTERN PetscErrorCode BVAllreduceSum_Private(BV,PetscScalar*,PetscScalar*,PetscMPIInt);
+SLEPC_INTERN PetscErrorCode BVDot_Reproducible_Private(BV,PetscInt,PetscInt,PetscInt,const PetscScalar*,PetscInt,const PetscScalar*,PetscInt,PetscBool,PetscScalar*,PetscInt,PetscBool);
 SLEPC_INTERN PetscErrorCode BVDot_BLAS_Private(BV,PetscInt,PetscInt,PetscInt,const PetscScalar*,PetscInt,const PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscBool);
 SLEPC_INTERN PetscErrorCode BVDotVec_BLAS_Private(BV,PetscInt,PetscInt,const PetscScalar*,PetscInt,const PetscScalar*,PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode BVScale_BLAS_Private(BV,PetscInt,PetscScalar*,PetscScalar);
+SLEPC_INTERN PetscErrorCode BVFirstTouch_Private(BV,PetscInt,PetscInt,PetscScalar*,PetscInt);
 SLEPC_INTERN PetscErrorCode BVNorm_LAPACK_Private(BV,PetscInt,PetscInt,const PetscScalar*,PetscInt,NormType,PetscReal*,PetscBool);
 SLEPC_INTERN PetscErrorCode BVNormalize_LAPACK_Private(BV,PetscInt,PetscInt,const PetscScalar*,PetscInt,PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode BVGetMat_Default(BV,Mat*);
 SLEPC_INTERN PetscErrorCode BVRestoreMat_Default(BV,Mat*);
+SLEPC_INTERN PetscErrorCode BVMatMult_Product_Private(BV,Mat,BV);
 SLEPC_INTERN PetscErrorCode BVMatCholInv_LAPACK_Private(BV,Mat,Mat);
 SLEPC_INTERN PetscErrorCode BVMatTriInv_LAPACK_Private(BV,Mat,Mat);
+SLEPC_INTERN PetscErrorCode BVMatTriMult_LAPACK_Private(BV,Mat,Mat);
 SLEPC_INTERN PetscErrorCode BVMatSVQB_LAPACK_Private(BV,Mat,Mat);
 SLEPC_INTERN PetscErrorCode BVOrthogonalize_LAPACK_TSQR(BV,PetscInt,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt);
 SLEPC_INTERN PetscErrorCode BVOrthogonalize_LAPACK_TSQR_OnlyR(BV,PetscInt,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt);
@@ -395,6 +463,20 @@ static inline PetscErrorCode BV_SquareRoot_Default(BV bv,PetscInt j,PetscScalar
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   BV_SquareRootSum - Computes both the square root of position j (counted after the
+   constraints) and the value h'*h of the previous positions of the coefficients array,
+   as in BV_SquareRoot() followed by BV_SquareSum(); the GPU versions copy the
+   coefficients to the host only once and do not need a synchronization for each value
+*/
+static inline PetscErrorCode BV_SquareRootSum_Default(BV bv,PetscInt j,PetscScalar *h,PetscReal *beta,PetscReal *sum)
+{
+  PetscFunctionBegin;
+  PetscCall(BV_SquareRoot_Default(bv,j,h,beta));
+  PetscCall(BV_SquareSum_Default(bv,j,h,sum));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    BV_StoreCoefficients_Default - Copy the contents of the coefficients array to an array dest
    provided by the caller (only values from l to j are copied)
@@ -491,9 +573,11 @@ static inline PetscErrorCode BV_SetDefaultLD(BV bv,PetscInt nloc)
 static inline PetscErrorCode BV_MatDenseCUDAGetArrayRead(BV bv,Mat Q,const PetscScalar **d_q)
 {
   const PetscScalar *q;
+  PetscScalar       *dq;
   PetscInt          ldq,mq;
   PetscCuBLASInt    ldq_=0;
   PetscBool         matiscuda;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   (void)bv; // avoid unused parameter warning
@@ -504,8 +588,10 @@ static inline PetscErrorCode BV_MatDenseCUDAGetArrayRead(BV bv,Mat Q,const Petsc
   if (matiscuda) PetscCall(MatDenseCUDAGetArrayRead(Q,d_q));
   else {
     PetscCall(MatDenseGetArrayRead(Q,&q));
-    PetscCallCUDA(cudaMalloc((void**)d_q,ldq*mq*sizeof(PetscScalar)));
-    PetscCallCUDA(cudaMemcpy((void*)*d_q,q,ldq*mq*sizeof(PetscScalar),cudaMemcpyHostToDevice));
+    PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,ldq*mq,&dq));
+    PetscCall(PetscDeviceArrayCopy(dctx,dq,q,ldq*mq));
+    *d_q = dq;
     PetscCall(PetscLogCpuToGpu(ldq*mq*sizeof(PetscScalar)));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -517,7 +603,9 @@ static inline PetscErrorCode BV_MatDenseCUDAGetArrayRead(BV bv,Mat Q,const Petsc
 */
 static inline PetscErrorCode BV_MatDenseCUDARestoreArrayRead(BV bv,Mat Q,const PetscScalar **d_q)
 {
-  PetscBool matiscuda;
+  PetscBool          matiscuda;
+  PetscScalar        *dq;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   (void)bv; // avoid unused parameter warning
@@ -525,7 +613,9 @@ static inline PetscErrorCode BV_MatDenseCUDARestoreArrayRead(BV bv,Mat Q,const P
   if (matiscuda) PetscCall(MatDenseCUDARestoreArrayRead(Q,d_q));
   else {
     PetscCall(MatDenseRestoreArrayRead(Q,NULL));
-    PetscCallCUDA(cudaFree((void*)*d_q));
+    PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+    dq = (PetscScalar*)*d_q;
+    PetscCall(PetscDeviceFree(dctx,dq));
     *d_q = NULL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -547,6 +637,7 @@ SLEPC_INTERN PetscErrorCode BV_SetValue_CUDA(BV,PetscInt,PetscInt,PetscScalar*,P
 SLEPC_INTERN PetscErrorCode BV_SquareSum_CUDA(BV,PetscInt,PetscScalar*,PetscReal*);
 SLEPC_INTERN PetscErrorCode BV_ApplySignature_CUDA(BV,PetscInt,PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode BV_SquareRoot_CUDA(BV,PetscInt,PetscScalar*,PetscReal*);
+SLEPC_INTERN PetscErrorCode BV_SquareRootSum_CUDA(BV,PetscInt,PetscScalar*,PetscReal*,PetscReal*);
 SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_CUDA(BV,PetscInt,PetscScalar*,PetscScalar*);
 #define BV_CleanCoefficients(a,b,c)   ((a)->cuda?BV_CleanCoefficients_CUDA:BV_CleanCoefficients_Default)((a),(b),(c))
 #define BV_AddCoefficients(a,b,c,d)   ((a)->cuda?BV_AddCoefficients_CUDA:BV_AddCoefficients_Default)((a),(b),(c),(d))
@@ -554,6 +645,7 @@ SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_CUDA(BV,PetscInt,PetscScalar*,P
 #define BV_SquareSum(a,b,c,d)         ((a)->cuda?BV_SquareSum_CUDA:BV_SquareSum_Default)((a),(b),(c),(d))
 #define BV_ApplySignature(a,b,c,d)    ((a)->cuda?BV_ApplySignature_CUDA:BV_ApplySignature_Default)((a),(b),(c),(d))
 #define BV_SquareRoot(a,b,c,d)        ((a)->cuda?BV_SquareRoot_CUDA:BV_SquareRoot_Default)((a),(b),(c),(d))
+#define BV_SquareRootSum(a,b,c,d,e)   ((a)->cuda?BV_SquareRootSum_CUDA:BV_SquareRootSum_Default)((a),(b),(c),(d),(e))
 #define BV_StoreCoefficients(a,b,c,d) ((a)->cuda?BV_StoreCoefficients_CUDA:BV_StoreCoefficients_Default)((a),(b),(c),(d))
 
 #elif defined(PETSC_HAVE_HIP)
@@ -565,9 +657,11 @@ SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_CUDA(BV,PetscInt,PetscScalar*,P
 static inline PetscErrorCode BV_MatDenseHIPGetArrayRead(BV bv,Mat Q,const PetscScalar **d_q)
 {
   const PetscScalar *q;
+  PetscScalar       *dq;
   PetscInt          ldq,mq;
   PetscCuBLASInt    ldq_=0;
   PetscBool         matiship;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   (void)bv; // avoid unused parameter warning
@@ -578,8 +672,10 @@ static inline PetscErrorCode BV_MatDenseHIPGetArrayRead(BV bv,Mat Q,const PetscS
   if (matiship) PetscCall(MatDenseHIPGetArrayRead(Q,d_q));
   else {
     PetscCall(MatDenseGetArrayRead(Q,&q));
-    PetscCallHIP(hipMalloc((void**)d_q,ldq*mq*sizeof(PetscScalar)));
-    PetscCallHIP(hipMemcpy((void*)*d_q,q,ldq*mq*sizeof(PetscScalar),hipMemcpyHostToDevice));
+    PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,ldq*mq,&dq));
+    PetscCall(PetscDeviceArrayCopy(dctx,dq,q,ldq*mq));
+    *d_q = dq;
     PetscCall(PetscLogCpuToGpu(ldq*mq*sizeof(PetscScalar)));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -591,7 +687,9 @@ static inline PetscErrorCode BV_MatDenseHIPGetArrayRead(BV bv,Mat Q,const PetscS
 */
 static inline PetscErrorCode BV_MatDenseHIPRestoreArrayRead(BV bv,Mat Q,const PetscScalar **d_q)
 {
-  PetscBool matiship;
+  PetscBool          matiship;
+  PetscScalar        *dq;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   (void)bv; // avoid unused parameter warning
@@ -599,7 +697,9 @@ static inline PetscErrorCode BV_MatDenseHIPRestoreArrayRead(BV bv,Mat Q,const Pe
   if (matiship) PetscCall(MatDenseHIPRestoreArrayRead(Q,d_q));
   else {
     PetscCall(MatDenseRestoreArrayRead(Q,NULL));
-    PetscCallHIP(hipFree((void*)*d_q));
+    PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+    dq = (PetscScalar*)*d_q;
+    PetscCall(PetscDeviceFree(dctx,dq));
     *d_q = NULL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -621,6 +721,7 @@ SLEPC_INTERN PetscErrorCode BV_SetValue_HIP(BV,PetscInt,PetscInt,PetscScalar*,Pe
 SLEPC_INTERN PetscErrorCode BV_SquareSum_HIP(BV,PetscInt,PetscScalar*,PetscReal*);
 SLEPC_INTERN PetscErrorCode BV_ApplySignature_HIP(BV,PetscInt,PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode BV_SquareRoot_HIP(BV,PetscInt,PetscScalar*,PetscReal*);
+SLEPC_INTERN PetscErrorCode BV_SquareRootSum_HIP(BV,PetscInt,PetscScalar*,PetscReal*,PetscReal*);
 SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_HIP(BV,PetscInt,PetscScalar*,PetscScalar*);
 #define BV_CleanCoefficients(a,b,c)   ((a)->hip?BV_CleanCoefficients_HIP:BV_CleanCoefficients_Default)((a),(b),(c))
 #define BV_AddCoefficients(a,b,c,d)   ((a)->hip?BV_AddCoefficients_HIP:BV_AddCoefficients_Default)((a),(b),(c),(d))
@@ -628,6 +729,7 @@ SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_HIP(BV,PetscInt,PetscScalar*,Pe
 #define BV_SquareSum(a,b,c,d)         ((a)->hip?BV_SquareSum_HIP:BV_SquareSum_Default)((a),(b),(c),(d))
 #define BV_ApplySignature(a,b,c,d)    ((a)->hip?BV_ApplySignature_HIP:BV_ApplySignature_Default)((a),(b),(c),(d))
 #define BV_SquareRoot(a,b,c,d)        ((a)->hip?BV_SquareRoot_HIP:BV_SquareRoot_Default)((a),(b),(c),(d))
+#define BV_SquareRootSum(a,b,c,d,e)   ((a)->hip?BV_SquareRootSum_HIP:BV_SquareRootSum_Default)((a),(b),(c),(d),(e))
 #define BV_StoreCoefficients(a,b,c,d) ((a)->hip?BV_StoreCoefficients_HIP:BV_StoreCoefficients_Default)((a),(b),(c),(d))
 
 #else /* CPU */
@@ -637,5 +739,6 @@ SLEPC_INTERN PetscErrorCode BV_StoreCoefficients_HIP(BV,PetscInt,PetscScalar*,Pe
 #define BV_SquareSum(a,b,c,d)         BV_SquareSum_Default((a),(b),(c),(d))
 #define BV_ApplySignature(a,b,c,d)    BV_ApplySignature_Default((a),(b),(c),(d))
 #define BV_SquareRoot(a,b,c,d)        BV_SquareRoot_Default((a),(b),(c),(d))
+#define BV_SquareRootSum(a,b,c,d,e)   BV_SquareRootSum_Default((a),(b),(c),(d),(e))
 #define BV_StoreCoefficients(a,b,c,d) BV_StoreCoefficients_Default((a),(b),(c),(d))
 #endif /* PETSC_HAVE_CUDA */
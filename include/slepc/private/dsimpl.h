@@ -27,6 +27,7 @@ struct _DSOps {
   PetscErrorCode (*setfromoptions)(DS,PetscOptionItems*);
   PetscErrorCode (*view)(DS,PetscViewer);
   PetscErrorCode (*vectors)(DS,DSMatType,PetscInt*,PetscReal*);
+  PetscErrorCode (*vectorsrange)(DS,DSMatType,PetscInt,PetscInt);
   PetscErrorCode (*solve[DS_MAX_SOLVE])(DS,PetscScalar*,PetscScalar*);
   PetscErrorCode (*sort)(DS,PetscScalar*,PetscScalar*,PetscScalar*,PetscScalar*,PetscInt*);
   PetscErrorCode (*sortperm)(DS,PetscInt*,PetscScalar*,PetscScalar*);
@@ -109,6 +110,8 @@ struct _p_DS {
 
 SLEPC_INTERN PetscErrorCode DSAllocateMat_Private(DS,DSMatType);
 SLEPC_INTERN PetscErrorCode DSAllocateWork_Private(DS,PetscInt,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode DSViewMatBinary_Private(DS,DSMatType,PetscViewer);
+SLEPC_INTERN PetscErrorCode DSLoadMatBinary_Private(DS,DSMatType,PetscViewer);
 SLEPC_INTERN PetscErrorCode DSSortEigenvalues_Private(DS,PetscScalar*,PetscScalar*,PetscInt*,PetscBool);
 SLEPC_INTERN PetscErrorCode DSSortEigenvaluesReal_Private(DS,PetscReal*,PetscInt*);
 SLEPC_INTERN PetscErrorCode DSPermuteColumns_Private(DS,PetscInt,PetscInt,PetscInt,DSMatType,PetscInt*);
@@ -116,6 +119,10 @@ SLEPC_INTERN PetscErrorCode DSPermuteColumnsTwo_Private(DS,PetscInt,PetscInt,Pet
 SLEPC_INTERN PetscErrorCode DSPermuteRows_Private(DS,PetscInt,PetscInt,PetscInt,DSMatType,PetscInt*);
 SLEPC_INTERN PetscErrorCode DSPermuteBoth_Private(DS,PetscInt,PetscInt,PetscInt,PetscInt,DSMatType,DSMatType,PetscInt*);
 SLEPC_INTERN PetscErrorCode DSGetTruncateSize_Default(DS,PetscInt,PetscInt,PetscInt*);
+#if defined(SLEPC_HAVE_SCALAPACK)
+SLEPC_INTERN PetscErrorCode DSCopyToScaLAPACK_Private(DS,PetscInt,PetscInt,const PetscScalar*,PetscInt,Mat*);
+SLEPC_INTERN PetscErrorCode DSCopyFromScaLAPACK_Private(DS,Mat,PetscScalar*,PetscInt);
+#endif
 
 SLEPC_INTERN PetscErrorCode DSGHIEPOrthogEigenv(DS,DSMatType,PetscScalar*,PetscScalar*,PetscBool);
 SLEPC_INTERN PetscErrorCode DSPseudoOrthog_HR(PetscInt*,PetscScalar*,PetscInt,PetscReal*,PetscScalar*,PetscInt,PetscBLASInt*,PetscBLASInt*,PetscBool*,PetscScalar*);
@@ -34,8 +34,11 @@ struct _EPSOps {
   PetscErrorCode (*view)(EPS,PetscViewer);
   PetscErrorCode (*backtransform)(EPS);
   PetscErrorCode (*computevectors)(EPS);
+  PetscErrorCode (*geteigenvector)(EPS,PetscInt,Vec,Vec);
   PetscErrorCode (*setdefaultst)(EPS);
   PetscErrorCode (*setdstype)(EPS);
+  PetscErrorCode (*checkpoint)(EPS,PetscViewer);
+  PetscErrorCode (*restart)(EPS,PetscViewer);
 };
 
 /*
@@ -98,6 +101,8 @@ struct _p_EPS {
   PetscBool      trackall;         /* whether all the residuals must be computed */
   PetscBool      purify;           /* whether eigenvectors need to be purified */
   PetscBool      twosided;         /* whether to compute left eigenvectors (two-sided solver) */
+  PetscBool      warmstart;        /* whether to start from the subspace of the previous solve */
+  PetscBool      lazyvecs;         /* whether eigenvectors are formed only when requested */
 
   /*-------------- User-provided functions and contexts -----------------*/
   EPSConvergenceTestFn      *converged;
@@ -131,13 +136,17 @@ struct _p_EPS {
   PetscInt       *perm;            /* permutation for eigenvalue ordering */
   PetscInt       nwork;            /* number of work vectors */
   Vec            *work;            /* work vectors */
+  PetscViewer    rstviewer;        /* checkpoint to be loaded in EPSSolve(), see EPSRestart() */
   void           *data;            /* placeholder for solver-specific stuff */
 
   /* ----------------------- Status variables --------------------------*/
   EPSStateType   state;            /* initial -> setup -> solved -> eigenvectors */
   EPSSolverType  categ;            /* solver category */
   PetscInt       nconv;            /* number of converged eigenvalues */
+  PetscInt       nwarm;            /* number of columns of V retained from the previous solve */
+  PetscBool      vlazy;            /* eigenvectors not formed, V has Schur vectors and DS_MAT_X the coefficients */
   PetscInt       its;              /* number of iterations so far computed */
+  PetscEventPerfInfo perf[SLEPC_PERF_NPHASES]; /* performance data of the last solve */
   PetscInt       n,nloc;           /* problem dimensions (global, local) */
   PetscReal      nrma,nrmb;        /* computed matrix norms */
   PetscBool      useds;            /* whether the solver uses the DS object or not */
@@ -414,9 +423,11 @@ SLEPC_INTERN PetscErrorCode EPSBackTransform_Default(EPS);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors(EPS);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors_Hermitian(EPS);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors_Schur(EPS);
+SLEPC_INTERN PetscErrorCode EPSGetEigenvector_Schur(EPS,PetscInt,Vec,Vec);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors_Indefinite(EPS);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors_Twosided(EPS);
 SLEPC_INTERN PetscErrorCode EPSComputeVectors_Slice(EPS);
+SLEPC_INTERN PetscErrorCode EPSGetEigenvector_Slice(EPS,PetscInt,Vec,Vec);
 SLEPC_INTERN PetscErrorCode EPSComputeResidualNorm_Private(EPS,PetscBool,PetscScalar,PetscScalar,Vec,Vec,Vec*,PetscReal*);
 SLEPC_INTERN PetscErrorCode EPSComputeRitzVector(EPS,PetscScalar*,PetscScalar*,BV,Vec,Vec);
 SLEPC_INTERN PetscErrorCode EPSGetStartVector(EPS,PetscInt,PetscBool*);
@@ -24,10 +24,13 @@ typedef struct _FNOps *FNOps;
 struct _FNOps {
   PetscErrorCode (*evaluatefunction)(FN,PetscScalar,PetscScalar*);
   PetscErrorCode (*evaluatederivative)(FN,PetscScalar,PetscScalar*);
+  PetscErrorCode (*evaluatefunctionarray)(FN,PetscInt,const PetscScalar*,PetscScalar*);
+  PetscErrorCode (*evaluatederivativearray)(FN,PetscInt,const PetscScalar*,PetscScalar*);
   PetscErrorCode (*evaluatefunctionmat[FN_MAX_SOLVE])(FN,Mat,Mat);
   PetscErrorCode (*evaluatefunctionmatcuda[FN_MAX_SOLVE])(FN,Mat,Mat);
   PetscErrorCode (*evaluatefunctionmatvec[FN_MAX_SOLVE])(FN,Mat,Vec);
   PetscErrorCode (*evaluatefunctionmatveccuda[FN_MAX_SOLVE])(FN,Mat,Vec);
+  PetscErrorCode (*evaluatefunctionmatdist[FN_MAX_SOLVE])(FN,Mat,Mat);
   PetscErrorCode (*setfromoptions)(FN,PetscOptionItems*);
   PetscErrorCode (*view)(FN,PetscViewer);
   PetscErrorCode (*duplicate)(FN,MPI_Comm,FN*);
@@ -42,7 +45,7 @@ struct _p_FN {
   PetscScalar    alpha;          /* inner scaling (argument) */
   PetscScalar    beta;           /* outer scaling (result) */
   PetscInt       method;         /* the method to compute matrix functions */
-  FNParallelType pmode;          /* parallel mode (redundant or synchronized) */
+  FNParallelType pmode;          /* parallel mode (redundant, synchronized or distributed) */
 
   /*---------------------- Cached data and workspace -------------------*/
   Mat            W[FN_MAX_W];    /* workspace matrices */
@@ -52,11 +55,10 @@ struct _p_FN {
 };
 
 /*
-  FN_AllocateWorkMat - Allocate a work Mat of the same dimension of A and copy
-  its contents. The work matrix is returned in M and should be freed with
-  FN_FreeWorkMat().
+  FN_AllocateWorkMat_Private - Allocate a work Mat of the same dimension of A,
+  copying its contents only if copy is true.
 */
-static inline PetscErrorCode FN_AllocateWorkMat(FN fn,Mat A,Mat *M)
+static inline PetscErrorCode FN_AllocateWorkMat_Private(FN fn,Mat A,PetscBool copy,Mat *M)
 {
   PetscInt       n,na;
   PetscBool      create=PETSC_FALSE;
@@ -75,15 +77,39 @@ static inline PetscErrorCode FN_AllocateWorkMat(FN fn,Mat A,Mat *M)
       create=PETSC_TRUE;
     }
   }
-  if (create) PetscCall(MatDuplicate(A,MAT_COPY_VALUES,&fn->W[fn->cw]));
-  else PetscCall(MatCopy(A,fn->W[fn->cw],SAME_NONZERO_PATTERN));
+  if (create) PetscCall(MatDuplicate(A,copy?MAT_COPY_VALUES:MAT_DO_NOT_COPY_VALUES,&fn->W[fn->cw]));
+  else if (copy) PetscCall(MatCopy(A,fn->W[fn->cw],SAME_NONZERO_PATTERN));
   *M = fn->W[fn->cw];
   fn->cw++;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 /*
-  FN_FreeWorkMat - Release a work matrix created with FN_AllocateWorkMat().
+  FN_AllocateWorkMat - Allocate a work Mat of the same dimension of A and copy
+  its contents. The work matrix is returned in M and should be freed with
+  FN_FreeWorkMat().
+*/
+static inline PetscErrorCode FN_AllocateWorkMat(FN fn,Mat A,Mat *M)
+{
+  PetscFunctionBegin;
+  PetscCall(FN_AllocateWorkMat_Private(fn,A,PETSC_TRUE,M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  FN_AllocateWorkMatNoCopy - Same as FN_AllocateWorkMat(), but the contents of
+  the work matrix are undefined. To be used when it is only an output argument.
+*/
+static inline PetscErrorCode FN_AllocateWorkMatNoCopy(FN fn,Mat A,Mat *M)
+{
+  PetscFunctionBegin;
+  PetscCall(FN_AllocateWorkMat_Private(fn,A,PETSC_FALSE,M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  FN_FreeWorkMat - Release a work matrix created with FN_AllocateWorkMat() or
+  FN_AllocateWorkMatNoCopy().
 */
 static inline PetscErrorCode FN_FreeWorkMat(FN fn,Mat *M)
 {
@@ -107,4 +133,6 @@ SLEPC_INTERN PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN,Mat,Mat); /* use
 SLEPC_INTERN PetscErrorCode FNSqrtmDenmanBeavers_CUDAm(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
 SLEPC_INTERN PetscErrorCode FNSqrtmNewtonSchulz_CUDA(FN,PetscBLASInt,PetscScalar*,PetscBLASInt,PetscBool);
 SLEPC_INTERN PetscErrorCode FNSqrtmSadeghi_CUDAm(FN,PetscBLASInt,PetscScalar*,PetscBLASInt);
+SLEPC_INTERN PetscErrorCode FNEvaluateFunctionMat_Exp_Pade_CUDA(FN,Mat,Mat); /* used in FNPHI */
+SLEPC_INTERN PetscErrorCode FNEvaluateFunctionMat_Exp_Higham_CUDAm(FN,Mat,Mat); /* used in FNPHI */
 #endif
@@ -52,6 +52,8 @@ struct _p_LME {
   PetscInt       ncv;            /* number of basis vectors */
   PetscReal      tol;            /* tolerance */
   PetscBool      errorifnotconverged;    /* error out if LMESolve() does not converge */
+  PetscInt       nini;           /* number of initial vectors */
+  Vec            *IS;            /* references to user-provided initial space */
 
   /*-------------- User-provided functions and contexts -----------------*/
   PetscErrorCode (*monitor[MAXLMEMONITORS])(LME,PetscInt,PetscReal,void*);
@@ -121,6 +121,8 @@ struct _p_NEP {
   MatStructure   mstr;             /* pattern of split matrices */
   Mat            *P;               /* matrix coefficients of split form (preconditioner) */
   MatStructure   mstrp;            /* pattern of split matrices (preconditioner) */
+  PetscBool      munion;           /* function and jacobian have the union of the patterns */
+  PetscBool      munionp;          /* function_pre has the union of the patterns */
   Vec            *IS;              /* references to user-provided initial space */
   PetscScalar    *eigr,*eigi;      /* real and imaginary parts of eigenvalues */
   PetscReal      *errest;          /* error estimates */
@@ -137,6 +139,7 @@ struct _p_NEP {
   PetscInt       its;              /* number of iterations so far computed */
   PetscInt       n,nloc;           /* problem dimensions (global, local) */
   PetscReal      *nrma;            /* computed matrix norms */
+  BV             *AV;              /* products A_i*V, see NEPProjectOperator() */
   NEPUserInterface fui;            /* how the user has defined the nonlinear operator */
   PetscBool      useds;            /* whether the solver uses the DS object or not */
   Mat            resolvent;        /* shell matrix to be used in NEPApplyResolvent */
@@ -234,7 +237,9 @@ static inline PetscErrorCode NEP_KSPSetOperators(KSP ksp,Mat A,Mat B)
 SLEPC_INTERN PetscErrorCode NEPSetDimensions_Default(NEP,PetscInt,PetscInt*,PetscInt*);
 SLEPC_INTERN PetscErrorCode NEPComputeVectors(NEP);
 SLEPC_INTERN PetscErrorCode NEPReset_Problem(NEP);
+SLEPC_INTERN PetscErrorCode NEPCreateSplitMatrix_Private(PetscInt,Mat*,MatStructure,Mat*,PetscBool*);
 SLEPC_INTERN PetscErrorCode NEPGetDefaultShift(NEP,PetscScalar*);
 SLEPC_INTERN PetscErrorCode NEPComputeVectors_Schur(NEP);
 SLEPC_INTERN PetscErrorCode NEPComputeResidualNorm_Private(NEP,PetscBool,PetscScalar,Vec,Vec*,PetscReal*);
+SLEPC_INTERN PetscErrorCode NEPComputeErrors_Private(NEP,NEPErrorType,PetscInt,PetscReal*);
 SLEPC_INTERN PetscErrorCode NEPNewtonRefinementSimple(NEP,PetscInt*,PetscReal,PetscInt);
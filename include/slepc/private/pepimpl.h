@@ -133,6 +133,7 @@ struct _p_PEP {
   PetscReal      *nrma;            /* computed matrix norms */
   PetscReal      nrml[2];          /* computed matrix norms for the linearization */
   PetscBool      sfactor_set;      /* flag to indicate the user gave sfactor */
+  PetscBool      sdiag_set;        /* flag to indicate the user gave Dl or Dr */
   PetscBool      lineariz;         /* current solver is based on linearization */
   PEPConvergedReason reason;
 };
@@ -26,7 +26,9 @@ struct _RGOps {
   PetscErrorCode (*computebbox)(RG,PetscReal*,PetscReal*,PetscReal*,PetscReal*);
   PetscErrorCode (*computequadrature)(RG,RGQuadRule,PetscInt,PetscScalar*,PetscScalar*,PetscScalar*);
   PetscErrorCode (*checkinside)(RG,PetscReal,PetscReal,PetscInt*);
+  PetscErrorCode (*checkinsidearray)(RG,PetscInt,const PetscReal*,const PetscReal*,PetscInt*);
   PetscErrorCode (*isaxisymmetric)(RG,PetscBool,PetscBool*);
+  PetscErrorCode (*split)(RG,PetscInt,RG*);
   PetscErrorCode (*setfromoptions)(RG,PetscOptionItems*);
   PetscErrorCode (*view)(RG,PetscViewer);
   PetscErrorCode (*destroy)(RG);
@@ -37,6 +39,8 @@ struct _p_RG {
   PetscBool   complement;    /* region is the complement of the specified one */
   PetscReal   sfactor;       /* scaling factor */
   PetscReal   osfactor;      /* old scaling factor, before RGPushScale */
+  PetscReal   *work;         /* coordinates of the points passed to checkinsidearray */
+  PetscInt    lwork;         /* length of array work */
   void        *data;
 };
 
@@ -16,6 +16,7 @@
 /* SUBMANSEC = sys */
 
 SLEPC_INTERN PetscBool SlepcBeganPetsc;
+SLEPC_INTERN PetscInt  MatNormEstimateId;
 
 /* SlepcSwap - swap two variables a,b of the same type using a temporary variable t */
 #define SlepcSwap(a,b,t) do {t=a;a=b;b=t;} while (0)
@@ -53,6 +54,20 @@ struct _n_SlepcConvMon {
   PetscInt oldnconv;  /* previous value of nconv */
 };
 
+/* context for monitors of type XXXMonitorAllBinary, a ring buffer with the last iterations */
+struct _n_SlepcHistMon {
+  PetscInt       size;      /* capacity of the buffer, in number of iterations */
+  PetscInt       ld;        /* maximum number of values stored per iteration */
+  PetscInt       count;     /* total number of iterations recorded */
+  PetscInt       *its,*nconv,*nest;
+  PetscLogDouble t0,*time;  /* time stamps, relative to the first recorded iteration */
+  PetscScalar    *eigr,*eigi;
+  PetscReal      *errest;
+};
+typedef struct _n_SlepcHistMon* SlepcHistMon;
+
+#define SLEPC_HISTMON_SIZE 1000
+
 /* context for structured eigenproblem matrices created via MatCreateXXX */
 struct _n_SlepcMatStruct {
   PetscInt cookie;    /* identify which structured matrix */
@@ -151,10 +166,22 @@ SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcBasisReference_Private(PetscInt,
 SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcBasisDestroy_Private(PetscInt*,Vec**);
 SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcMonitorMakeKey_Internal(const char[],PetscViewerType,PetscViewerFormat,char[]);
 SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscViewerAndFormatCreate_Internal(PetscViewer,PetscViewerFormat,void*,PetscViewerAndFormat**);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcSliceGetNextChunk_Private(PetscObject,MPI_Win,PetscMPIInt,PetscMPIInt,const PetscInt[],PetscInt*);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcSubcommSetType_Private(PetscObject,const char[],PetscSubcomm,PetscSubcommType);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcPerfStatsBegin_Private(PetscLogEvent,PetscLogEvent,PetscEventPerfInfo[]);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcPerfStatsEnd_Private(PetscLogEvent,PetscLogEvent,PetscEventPerfInfo[]);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcPerfStatsView_Private(PetscEventPerfInfo[],PetscInt,PetscViewer);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcHistMonCreate_Private(PetscViewer,PetscViewerFormat,void*,PetscViewerAndFormat**);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcHistMonGetSlot_Private(PetscObject,const char[],PetscInt,PetscInt,PetscInt,PetscInt,PetscViewerAndFormat*,PetscInt*,PetscScalar**,PetscScalar**,PetscReal**);
+SLEPC_SINGLE_LIBRARY_INTERN PetscErrorCode SlepcHistMonDestroy_Private(PetscViewerAndFormat**);
 
 SLEPC_INTERN PetscErrorCode SlepcCitationsInitialize(void);
 SLEPC_INTERN PetscErrorCode SlepcInitialize_DynamicLibraries(void);
+SLEPC_INTERN PetscErrorCode SlepcPreloadPackage_Private(const char[],PetscBool*);
 SLEPC_INTERN PetscErrorCode SlepcInitialize_Packages(void);
+SLEPC_INTERN PetscErrorCode SlepcInitialize_ThreadSafety(void);
+SLEPC_INTERN PetscErrorCode SlepcSCGetKeys_Private(SlepcSC,PetscInt,PetscScalar*,PetscScalar*,PetscInt*,PetscReal*,PetscBool*);
+SLEPC_INTERN PetscErrorCode SlepcSortKeys_Private(PetscInt,const PetscInt*,const PetscReal*,PetscInt*);
 
 /* Macro to check a sequential Mat (including GPU) */
 #if !defined(PETSC_USE_DEBUG)
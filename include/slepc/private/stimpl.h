@@ -65,6 +65,8 @@ struct _p_ST {
   Mat              *Psplit;          /* matrices for the split preconditioner */
   PetscInt         nsplit;           /* number of split preconditioner matrices */
   MatStructure     strp;             /* pattern of split preconditioner matrices */
+  PetscBool        adapttol;         /* adapt the KSP tolerance to the outer residual */
+  PetscInt         inpart;           /* number of partitions for concurrent inertia computations */
 
   /*------------------------- Misc data --------------------------*/
   KSP              ksp;              /* linear solver used in some ST's */
@@ -73,6 +75,13 @@ struct _p_ST {
   Vec              *work;            /* work vectors */
   Vec              wb;               /* balancing requires an extra work vector */
   Vec              wht;              /* extra work vector for hermitian transpose apply */
+  Vec              wc;               /* extra work vector for combined matrix-vector products */
+  Vec              wg;               /* ghost values for combined matrix-vector products */
+  VecScatter       sg;               /* scatter to gather the ghost values in wg */
+  PetscObjectId    sgid;             /* id of the matrix used to build sg */
+  PetscObjectState sgstate;          /* nonzero state of the matrix used to build sg */
+  PetscObjectId    Pid;              /* id of the matrix P built in STMatSetUp() */
+  PetscObjectState Pstate;           /* nonzero state of the matrix P built in STMatSetUp() */
   STStateType      state;            /* initial -> setup -> with updated matrices */
   PetscObjectState *Astate;          /* matrix state (to identify the original matrices) */
   Mat              *T;               /* matrices resulting from transformation */
@@ -84,6 +93,12 @@ struct _p_ST {
   PetscBool        sigma_set;        /* whether the user provided the shift or not */
   PetscBool        asymm;            /* the user matrices are all symmetric */
   PetscBool        aherm;            /* the user matrices are all hermitian */
+  PetscReal        ksprtol;          /* KSP tolerance set by the user, lower bound of adaptive tolerance */
+  PetscSubcomm     isubc;            /* subcommunicators for concurrent inertia computations */
+  Mat              *Ai;              /* copies of the matrices used in inertia computations */
+  PetscObjectState istate[2];        /* state of the matrices when Ai was created */
+  Mat              Si;               /* matrix A-sigma*B whose inertia is computed */
+  Mat              Fi;               /* factor used only for inertia computations */
   void             *data;
 };
 
@@ -113,7 +128,9 @@ SLEPC_INTERN PetscErrorCode STCheckNullSpace_Default(ST,BV);
 SLEPC_INTERN PetscErrorCode STMatShellCreate(ST,PetscScalar,PetscInt,PetscInt*,PetscScalar*,Mat*);
 SLEPC_INTERN PetscErrorCode STMatShellShift(Mat,PetscScalar);
 SLEPC_INTERN PetscErrorCode STCheckFactorPackage(ST);
+SLEPC_INTERN PetscErrorCode STResetInertia_Private(ST);
 SLEPC_INTERN PetscErrorCode STMatMAXPY_Private(ST,PetscScalar,PetscScalar,PetscInt,PetscScalar*,PetscBool,PetscBool,Mat*);
+SLEPC_INTERN PetscErrorCode STMatMultCombination_Private(ST,PetscInt,Mat*,const PetscScalar*,Vec,Vec);
 SLEPC_INTERN PetscErrorCode STCoeffs_Monomial(ST,PetscScalar*);
 SLEPC_INTERN PetscErrorCode STSetDefaultKSP(ST);
 SLEPC_INTERN PetscErrorCode STSetDefaultKSP_Default(ST);
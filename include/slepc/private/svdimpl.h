@@ -20,6 +20,7 @@ SLEPC_EXTERN PetscBool SVDMonitorRegisterAllCalled;
 SLEPC_EXTERN PetscErrorCode SVDRegisterAll(void);
 SLEPC_EXTERN PetscErrorCode SVDMonitorRegisterAll(void);
 SLEPC_EXTERN PetscLogEvent SVD_SetUp,SVD_Solve;
+SLEPC_INTERN PetscInt SVDTransposeStateId;
 
 typedef struct _SVDOps *SVDOps;
 
@@ -35,6 +36,8 @@ struct _SVDOps {
   PetscErrorCode (*view)(SVD,PetscViewer);
   PetscErrorCode (*computevectors)(SVD);
   PetscErrorCode (*setdstype)(SVD);
+  PetscErrorCode (*checkpoint)(SVD,PetscViewer);
+  PetscErrorCode (*restart)(SVD,PetscViewer);
 };
 
 /*
@@ -73,6 +76,7 @@ struct _p_SVD {
   SVDWhich       which;            /* which singular values are computed */
   SVDProblemType problem_type;     /* which kind of problem to be solved */
   PetscBool      impltrans;        /* implicit transpose mode */
+  PetscBool      valuesonly;       /* only singular values are required */
   PetscBool      trackall;         /* whether all the residuals must be computed */
 
   /*-------------- User-provided functions and contexts -----------------*/
@@ -102,12 +106,14 @@ struct _p_SVD {
   PetscInt       *perm;            /* permutation for singular value ordering */
   PetscInt       nworkl,nworkr;    /* number of work vectors */
   Vec            *workl,*workr;    /* work vectors */
+  PetscViewer    rstviewer;        /* checkpoint to be loaded in SVDSolve(), see SVDRestart() */
   void           *data;            /* placeholder for solver-specific stuff */
 
   /* ----------------------- Status variables -------------------------- */
   SVDStateType   state;            /* initial -> setup -> solved -> vectors */
   PetscInt       nconv;            /* number of converged values */
   PetscInt       its;              /* iteration counter */
+  PetscEventPerfInfo perf[SLEPC_PERF_NPHASES]; /* performance data of the last solve */
   PetscBool      leftbasis;        /* if U is filled by the solver */
   PetscBool      swapped;          /* the U and V bases have been swapped (M<N) */
   PetscBool      expltrans;        /* explicit transpose created */
@@ -226,3 +232,5 @@ SLEPC_INTERN PetscErrorCode SVDTwoSideLanczos(SVD,PetscReal*,PetscReal*,BV,BV,Pe
 SLEPC_INTERN PetscErrorCode SVDSetDimensions_Default(SVD);
 SLEPC_INTERN PetscErrorCode SVDComputeVectors(SVD);
 SLEPC_INTERN PetscErrorCode SVDComputeVectors_Left(SVD);
+SLEPC_INTERN PetscErrorCode SVDGetExplicitTranspose_Private(Mat,Mat*);
+SLEPC_INTERN PetscErrorCode SVDReleaseExplicitTranspose_Private(Mat,Mat);
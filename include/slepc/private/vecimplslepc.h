@@ -43,6 +43,7 @@ typedef struct {
 } Vec_Comp;
 
 /* Operations implemented in VecComp */
+SLEPC_INTERN PetscErrorCode VecCompInitialize_Private(void);
 SLEPC_INTERN PetscErrorCode VecDuplicateVecs_Comp(Vec,PetscInt,Vec*[]);
 SLEPC_INTERN PetscErrorCode VecDestroyVecs_Comp(PetscInt,Vec[]);
 SLEPC_INTERN PetscErrorCode VecDuplicate_Comp(Vec,Vec*);
@@ -86,7 +87,7 @@ typedef struct VecPool_ {
   Vec      *vecs;          /* pool of vectors */
   PetscInt n;              /* size of vecs */
   PetscInt used;           /* number of already used vectors */
-  PetscInt guess;          /* expected maximum number of vectors */
+  PetscInt guess;          /* expected maximum number of vectors in use */
   struct VecPool_ *next;   /* list of pool of vectors */
 } VecPool_;
 typedef VecPool_* VecPool;
@@ -190,6 +190,8 @@ BLAS_EXTERN void     LAPACKsytrd_(const char*,const PetscBLASInt*,PetscScalar*,c
 #else
 #define LAPACKsytrd_(a,b,c,d,e,f,g,h,i,j) PetscMissingLapack("SYTRD",a,b,c,d,e,f,g,h,i,j);
 #endif
+/* syrk/herk have the same signature, since alpha and beta are real in herk */
+BLAS_EXTERN void     BLASherk_(const char*,const char*,const PetscBLASInt*,const PetscBLASInt*,const PetscReal*,const PetscScalar*,const PetscBLASInt*,const PetscReal*,PetscScalar*,const PetscBLASInt*);
 #if !defined(PETSC_USE_COMPLEX)
 BLAS_EXTERN void     LAPACKsyevd_(const char*,const char*,PetscBLASInt*,PetscScalar*,PetscBLASInt*,PetscScalar*,PetscScalar*,PetscBLASInt*,PetscBLASInt*,PetscBLASInt*,PetscBLASInt*);
 BLAS_EXTERN void     LAPACKsygvd_(PetscBLASInt*,const char*,const char*,PetscBLASInt*,PetscScalar*,PetscBLASInt*,PetscScalar*,PetscBLASInt*,PetscScalar*,PetscScalar*,PetscBLASInt*,PetscBLASInt*,PetscBLASInt*,PetscBLASInt*);
@@ -89,6 +89,7 @@
 #endif
 #define LAPACKsyevd_ PETSCBLAS(syevd,SYEVD)
 #define LAPACKsygvd_ PETSCBLAS(sygvd,SYGVD)
+#define BLASherk_    PETSCBLAS(syrk,SYRK)
 #else
 #if !defined(SLEPC_MISSING_LAPACK_ORGTR)
 #define LAPACKorgtr_ PETSCBLAS(ungtr,UNGTR)
@@ -101,6 +102,7 @@
 #endif
 #define LAPACKsyevd_ PETSCBLAS(heevd,HEEVD)
 #define LAPACKsygvd_ PETSCBLAS(hegvd,HEGVD)
+#define BLASherk_    PETSCBLAS(herk,HERK)
 #endif
 
 /* subroutines with different signature in real/complex */
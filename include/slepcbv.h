@@ -44,6 +44,9 @@ typedef const char* BVType;
 #define BVVECS       "vecs"
 #define BVCONTIGUOUS "contiguous"
 #define BVTENSOR     "tensor"
+#define BVMIXED      "mixed"
+#define BVMMAP       "mmap"
+#define BVPANEL      "panel"
 
 /* Logging support */
 SLEPC_EXTERN PetscClassId BV_CLASSID;
@@ -57,7 +60,10 @@ SLEPC_EXTERN PetscClassId BV_CLASSID;
 .seealso: BVSetOrthogonalization(), BVGetOrthogonalization(), BVOrthogonalizeColumn(), BVOrthogRefineType
 E*/
 typedef enum { BV_ORTHOG_CGS,
-               BV_ORTHOG_MGS } BVOrthogType;
+               BV_ORTHOG_MGS,
+               BV_ORTHOG_CGS_PIPELINED,
+               BV_ORTHOG_RGS,
+               BV_ORTHOG_DCGS2 } BVOrthogType;
 SLEPC_EXTERN const char *BVOrthogTypes[];
 
 /*E
@@ -85,7 +91,9 @@ typedef enum { BV_ORTHOG_BLOCK_GS,
                BV_ORTHOG_BLOCK_CHOL,
                BV_ORTHOG_BLOCK_TSQR,
                BV_ORTHOG_BLOCK_TSQRCHOL,
-               BV_ORTHOG_BLOCK_SVQB     } BVOrthogBlockType;
+               BV_ORTHOG_BLOCK_SVQB,
+               BV_ORTHOG_BLOCK_CHOLQR2,
+               BV_ORTHOG_BLOCK_SCHOLQR3 } BVOrthogBlockType;
 SLEPC_EXTERN const char *BVOrthogBlockTypes[];
 
 /*E
@@ -207,11 +215,22 @@ SLEPC_EXTERN PetscErrorCode BVOrthogonalize(BV,Mat);
 SLEPC_EXTERN PetscErrorCode BVOrthogonalizeVec(BV,Vec,PetscScalar*,PetscReal*,PetscBool*);
 SLEPC_EXTERN PetscErrorCode BVOrthogonalizeColumn(BV,PetscInt,PetscScalar*,PetscReal*,PetscBool*);
 SLEPC_EXTERN PetscErrorCode BVOrthonormalizeColumn(BV,PetscInt,PetscBool,PetscReal*,PetscBool*);
+SLEPC_EXTERN PetscErrorCode BVMatMultOrthonormalizeColumn(BV,Mat,PetscInt,PetscReal*,PetscBool*);
 SLEPC_EXTERN PetscErrorCode BVOrthogonalizeSomeColumn(BV,PetscInt,PetscBool*,PetscScalar*,PetscReal*,PetscBool*);
 SLEPC_EXTERN PetscErrorCode BVBiorthogonalizeColumn(BV,BV,PetscInt);
 SLEPC_EXTERN PetscErrorCode BVBiorthonormalizeColumn(BV,BV,PetscInt,PetscReal*);
 SLEPC_EXTERN PetscErrorCode BVSetMatMultMethod(BV,BVMatMultType);
 SLEPC_EXTERN PetscErrorCode BVGetMatMultMethod(BV,BVMatMultType*);
+SLEPC_EXTERN PetscErrorCode BVSetKrylovSStep(BV,PetscInt);
+SLEPC_EXTERN PetscErrorCode BVGetKrylovSStep(BV,PetscInt*);
+SLEPC_EXTERN PetscErrorCode BVSetNumThreads(BV,PetscInt);
+SLEPC_EXTERN PetscErrorCode BVGetNumThreads(BV,PetscInt*);
+SLEPC_EXTERN PetscErrorCode BVSetHierarchicalReduction(BV,PetscBool);
+SLEPC_EXTERN PetscErrorCode BVGetHierarchicalReduction(BV,PetscBool*);
+SLEPC_EXTERN PetscErrorCode BVSetReproducibleReduction(BV,PetscBool);
+SLEPC_EXTERN PetscErrorCode BVGetReproducibleReduction(BV,PetscBool*);
+SLEPC_EXTERN PetscErrorCode BVSetDeviceOnly(BV,PetscBool);
+SLEPC_EXTERN PetscErrorCode BVGetDeviceOnly(BV,PetscBool*);
 
 SLEPC_EXTERN PetscErrorCode BVCreateFromMat(Mat,BV*);
 SLEPC_EXTERN PetscErrorCode BVCreateMat(BV,Mat*);
@@ -221,6 +240,8 @@ SLEPC_EXTERN PetscErrorCode BVRestoreMat(BV,Mat*);
 SLEPC_EXTERN PetscErrorCode BVScatter(BV,BV,VecScatter,Vec);
 SLEPC_EXTERN PetscErrorCode BVSumQuadrature(BV,BV,PetscInt,PetscInt,PetscInt,PetscScalar*,PetscScalar*,VecScatter,PetscSubcomm,PetscInt,PetscBool);
 SLEPC_EXTERN PetscErrorCode BVDotQuadrature(BV,BV,PetscScalar*,PetscInt,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscSubcomm,PetscInt,PetscBool);
+SLEPC_EXTERN PetscErrorCode BVSumQuadratureAdd(BV,BV,PetscInt,PetscInt,PetscScalar,PetscScalar);
+SLEPC_EXTERN PetscErrorCode BVDotQuadratureAdd(BV,BV,PetscScalar*,PetscInt,PetscInt,PetscScalar,PetscScalar,PetscBool);
 SLEPC_EXTERN PetscErrorCode BVTraceQuadrature(BV,BV,PetscInt,PetscInt,PetscScalar*,VecScatter,PetscSubcomm,PetscInt,PetscBool,PetscReal*);
 
 /*E
@@ -230,7 +251,8 @@ SLEPC_EXTERN PetscErrorCode BVTraceQuadrature(BV,BV,PetscInt,PetscInt,PetscScala
    Allowed values are
 +  BV_SVD_METHOD_REFINE - based on the SVD of the cross product matrix S'*S, with refinement
 .  BV_SVD_METHOD_QR     - based on the SVD of the triangular factor of qr(S)
--  BV_SVD_METHOD_QR_CAA - variant of QR intended for use in cammunication-avoiding Arnoldi
+.  BV_SVD_METHOD_QR_CAA - variant of QR intended for use in cammunication-avoiding Arnoldi
+-  BV_SVD_METHOD_RANDOM - based on a randomized range finder, cheaper if the rank is small
 
    Level: developer
 
@@ -238,7 +260,8 @@ SLEPC_EXTERN PetscErrorCode BVTraceQuadrature(BV,BV,PetscInt,PetscInt,PetscScala
 E*/
 typedef enum { BV_SVD_METHOD_REFINE,
                BV_SVD_METHOD_QR,
-               BV_SVD_METHOD_QR_CAA } BVSVDMethod;
+               BV_SVD_METHOD_QR_CAA,
+               BV_SVD_METHOD_RANDOM } BVSVDMethod;
 SLEPC_EXTERN const char *BVSVDMethods[];
 
 SLEPC_EXTERN PetscErrorCode BVSVDAndRank(BV,PetscInt,PetscInt,PetscReal,BVSVDMethod,PetscScalar*,PetscReal*,PetscInt*);
@@ -251,6 +274,9 @@ SLEPC_EXTERN PetscErrorCode BVTensorGetDegree(BV,PetscInt*);
 SLEPC_EXTERN PetscErrorCode BVTensorGetFactors(BV,BV*,Mat*);
 SLEPC_EXTERN PetscErrorCode BVTensorRestoreFactors(BV,BV*,Mat*);
 
+SLEPC_EXTERN PetscErrorCode BVMmapSetFile(BV,const char[],PetscInt64);
+SLEPC_EXTERN PetscErrorCode SlepcLoadSolution(MPI_Comm,const char[],PetscInt*,PetscScalar*[],PetscScalar*[],PetscReal*[],BV*,BV*);
+
 SLEPC_EXTERN PetscErrorCode BVSetOptionsPrefix(BV,const char*);
 SLEPC_EXTERN PetscErrorCode BVAppendOptionsPrefix(BV,const char*);
 SLEPC_EXTERN PetscErrorCode BVGetOptionsPrefix(BV,const char*[]);
@@ -8,7 +8,8 @@
    - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 */
 /*
-   Macro definitions to use cuBLAS and hipBLAS functionality
+   Macro definitions to use cuBLAS and hipBLAS functionality, and generic names
+   for the sources that are shared by the CUDA and HIP implementations
 */
 
 #pragma once
@@ -64,3 +65,70 @@
 #endif
 
 #endif // PETSC_HAVE_HIP
+
+/*
+   Generic names for the code that is common to CUDA and HIP: a source file that
+   defines SLEPC_CUPM_CUDA or SLEPC_CUPM_HIP before including the shared code gets
+   the functions of the corresponding vendor, e.g., SlepcCUPMName(BVMult_Svec) is
+   BVMult_Svec_CUDA or BVMult_Svec_HIP, and VecCUPMGetArray() is VecCUDAGetArray()
+   or VecHIPGetArray()
+*/
+#if defined(SLEPC_CUPM_CUDA)
+#define SlepcCUPMName(a)                   PetscConcat(a,_CUDA)
+#define BV_MatDenseCUPMGetArrayRead        BV_MatDenseCUDAGetArrayRead
+#define BV_MatDenseCUPMRestoreArrayRead    BV_MatDenseCUDARestoreArrayRead
+#define MatDenseCUPMGetArray               MatDenseCUDAGetArray
+#define MatDenseCUPMGetArrayRead           MatDenseCUDAGetArrayRead
+#define MatDenseCUPMGetArrayWrite          MatDenseCUDAGetArrayWrite
+#define MatDenseCUPMPlaceArray             MatDenseCUDAPlaceArray
+#define MatDenseCUPMReplaceArray           MatDenseCUDAReplaceArray
+#define MatDenseCUPMResetArray             MatDenseCUDAResetArray
+#define MatDenseCUPMRestoreArray           MatDenseCUDARestoreArray
+#define MatDenseCUPMRestoreArrayRead       MatDenseCUDARestoreArrayRead
+#define MatDenseCUPMRestoreArrayWrite      MatDenseCUDARestoreArrayWrite
+#define PETSC_MEMTYPE_CUPM                 PETSC_MEMTYPE_CUDA
+#define PetscCallCUPM                      PetscCallCUDA
+#define VecCUPMGetArray                    VecCUDAGetArray
+#define VecCUPMGetArrayRead                VecCUDAGetArrayRead
+#define VecCUPMGetArrayWrite               VecCUDAGetArrayWrite
+#define VecCUPMPlaceArray                  VecCUDAPlaceArray
+#define VecCUPMResetArray                  VecCUDAResetArray
+#define VecCUPMRestoreArray                VecCUDARestoreArray
+#define VecCUPMRestoreArrayRead            VecCUDARestoreArrayRead
+#define VecCUPMRestoreArrayWrite           VecCUDARestoreArrayWrite
+#define cupmFree                           cudaFree
+#define cupmMalloc                         cudaMalloc
+#define cupmMemcpy                         cudaMemcpy
+#define cupmMemcpy2D                       cudaMemcpy2D
+#define cupmMemcpyDeviceToDevice           cudaMemcpyDeviceToDevice
+#define cupmMemcpyHostToDevice             cudaMemcpyHostToDevice
+#elif defined(SLEPC_CUPM_HIP)
+#define SlepcCUPMName(a)                   PetscConcat(a,_HIP)
+#define BV_MatDenseCUPMGetArrayRead        BV_MatDenseHIPGetArrayRead
+#define BV_MatDenseCUPMRestoreArrayRead    BV_MatDenseHIPRestoreArrayRead
+#define MatDenseCUPMGetArray               MatDenseHIPGetArray
+#define MatDenseCUPMGetArrayRead           MatDenseHIPGetArrayRead
+#define MatDenseCUPMGetArrayWrite          MatDenseHIPGetArrayWrite
+#define MatDenseCUPMPlaceArray             MatDenseHIPPlaceArray
+#define MatDenseCUPMReplaceArray           MatDenseHIPReplaceArray
+#define MatDenseCUPMResetArray             MatDenseHIPResetArray
+#define MatDenseCUPMRestoreArray           MatDenseHIPRestoreArray
+#define MatDenseCUPMRestoreArrayRead       MatDenseHIPRestoreArrayRead
+#define MatDenseCUPMRestoreArrayWrite      MatDenseHIPRestoreArrayWrite
+#define PETSC_MEMTYPE_CUPM                 PETSC_MEMTYPE_HIP
+#define PetscCallCUPM                      PetscCallHIP
+#define VecCUPMGetArray                    VecHIPGetArray
+#define VecCUPMGetArrayRead                VecHIPGetArrayRead
+#define VecCUPMGetArrayWrite               VecHIPGetArrayWrite
+#define VecCUPMPlaceArray                  VecHIPPlaceArray
+#define VecCUPMResetArray                  VecHIPResetArray
+#define VecCUPMRestoreArray                VecHIPRestoreArray
+#define VecCUPMRestoreArrayRead            VecHIPRestoreArrayRead
+#define VecCUPMRestoreArrayWrite           VecHIPRestoreArrayWrite
+#define cupmFree                           hipFree
+#define cupmMalloc                         hipMalloc
+#define cupmMemcpy                         hipMemcpy
+#define cupmMemcpy2D                       hipMemcpy2D
+#define cupmMemcpyDeviceToDevice           hipMemcpyDeviceToDevice
+#define cupmMemcpyHostToDevice             hipMemcpyHostToDevice
+#endif
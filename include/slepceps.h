@@ -200,6 +200,8 @@ SLEPC_EXTERN PetscErrorCode EPSSetFromOptions(EPS);
 SLEPC_EXTERN PetscErrorCode EPSSetDSType(EPS);
 SLEPC_EXTERN PetscErrorCode EPSSetUp(EPS);
 SLEPC_EXTERN PetscErrorCode EPSSolve(EPS);
+SLEPC_EXTERN PetscErrorCode EPSCheckpoint(EPS,PetscViewer);
+SLEPC_EXTERN PetscErrorCode EPSRestart(EPS,PetscViewer);
 SLEPC_EXTERN PetscErrorCode EPSView(EPS,PetscViewer);
 SLEPC_EXTERN PetscErrorCode EPSViewFromOptions(EPS,PetscObject,const char[]);
 SLEPC_EXTERN PetscErrorCode EPSErrorView(EPS,EPSErrorType,PetscViewer);
@@ -213,6 +215,7 @@ SLEPC_EXTERN PetscErrorCode EPSValuesView(EPS,PetscViewer);
 SLEPC_EXTERN PetscErrorCode EPSValuesViewFromOptions(EPS);
 SLEPC_EXTERN PetscErrorCode EPSVectorsView(EPS,PetscViewer);
 SLEPC_EXTERN PetscErrorCode EPSVectorsViewFromOptions(EPS);
+SLEPC_EXTERN PetscErrorCode EPSSaveSolution(EPS,const char[]);
 
 SLEPC_EXTERN PetscErrorCode EPSSetTarget(EPS,PetscScalar);
 SLEPC_EXTERN PetscErrorCode EPSGetTarget(EPS,PetscScalar*);
@@ -246,13 +249,17 @@ SLEPC_EXTERN PetscErrorCode EPSGetEigenpair(EPS,PetscInt,PetscScalar*,PetscScala
 SLEPC_EXTERN PetscErrorCode EPSGetEigenvalue(EPS,PetscInt,PetscScalar*,PetscScalar*);
 SLEPC_EXTERN PetscErrorCode EPSGetEigenvector(EPS,PetscInt,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode EPSGetLeftEigenvector(EPS,PetscInt,Vec,Vec);
+SLEPC_EXTERN PetscErrorCode EPSGetEigenvectorsBV(EPS,BV*);
+SLEPC_EXTERN PetscErrorCode EPSRestoreEigenvectorsBV(EPS,BV*);
 
 SLEPC_EXTERN PetscErrorCode EPSComputeError(EPS,PetscInt,EPSErrorType,PetscReal*);
+SLEPC_EXTERN PetscErrorCode EPSComputeErrors(EPS,PetscInt,PetscInt,EPSErrorType,PetscReal*);
 PETSC_DEPRECATED_FUNCTION(3, 6, 0, "EPSComputeError()", ) static inline PetscErrorCode EPSComputeRelativeError(EPS eps,PetscInt i,PetscReal *r) {return EPSComputeError(eps,i,EPS_ERROR_RELATIVE,r);}
 PETSC_DEPRECATED_FUNCTION(3, 6, 0, "EPSComputeError() with EPS_ERROR_ABSOLUTE", ) static inline PetscErrorCode EPSComputeResidualNorm(EPS eps,PetscInt i,PetscReal *r) {return EPSComputeError(eps,i,EPS_ERROR_ABSOLUTE,r);}
 SLEPC_EXTERN PetscErrorCode EPSGetInvariantSubspace(EPS,Vec[]);
 SLEPC_EXTERN PetscErrorCode EPSGetErrorEstimate(EPS,PetscInt,PetscReal*);
 SLEPC_EXTERN PetscErrorCode EPSGetIterationNumber(EPS,PetscInt*);
+SLEPC_EXTERN PetscErrorCode EPSGetPerformanceStats(EPS,SlepcPerfPhase,PetscEventPerfInfo*);
 
 SLEPC_EXTERN PetscErrorCode EPSSetWhichEigenpairs(EPS,EPSWhich);
 SLEPC_EXTERN PetscErrorCode EPSGetWhichEigenpairs(EPS,EPSWhich*);
@@ -262,6 +269,10 @@ SLEPC_EXTERN PetscErrorCode EPSSetTrueResidual(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSGetTrueResidual(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSSetPurify(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSGetPurify(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSSetWarmStart(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSGetWarmStart(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSSetLazyVectors(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSGetLazyVectors(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSIsGeneralized(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSIsHermitian(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSIsPositive(EPS,PetscBool*);
@@ -292,6 +303,7 @@ SLEPC_EXTERN PetscErrorCode EPSMonitorConvergedCreate(PetscViewer,PetscViewerFor
 SLEPC_EXTERN PetscErrorCode EPSMonitorConvergedDrawLG(EPS,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 SLEPC_EXTERN PetscErrorCode EPSMonitorConvergedDrawLGCreate(PetscViewer,PetscViewerFormat,void *,PetscViewerAndFormat**);
 SLEPC_EXTERN PetscErrorCode EPSMonitorConvergedDestroy(PetscViewerAndFormat**);
+SLEPC_EXTERN PetscErrorCode EPSMonitorAllBinary(EPS,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 
 SLEPC_EXTERN PetscErrorCode EPSSetOptionsPrefix(EPS,const char*);
 SLEPC_EXTERN PetscErrorCode EPSAppendOptionsPrefix(EPS,const char*);
@@ -349,6 +361,40 @@ SLEPC_EXTERN PetscErrorCode EPSSetStoppingTestFunction(EPS,EPSStoppingTestFn*,vo
 SLEPC_EXTERN PetscErrorCode EPSSetEigenvalueComparison(EPS,SlepcEigenvalueComparisonFn*,void*);
 SLEPC_EXTERN PetscErrorCode EPSSetArbitrarySelection(EPS,SlepcArbitrarySelectionFn*,void*);
 
+/*S
+  EPSBatchOperatorsFn - A prototype of a function that creates the matrices of one of the
+  problems solved with EPSSolveBatch()
+
+  Calling Sequence:
++   eps - eigensolver context that will solve the problem
+.   i   - index of the problem
+.   A   - [output] the matrix associated with the eigensystem
+.   B   - [output] the second matrix in the case of generalized eigenproblems (or NULL)
+-   ctx - [optional] user-defined context passed to EPSSolveBatch()
+
+  Level: advanced
+
+.seealso: EPSSolveBatch()
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(EPSBatchOperatorsFn)(EPS eps,PetscInt i,Mat *A,Mat *B,void *ctx);
+
+/*S
+  EPSBatchResultFn - A prototype of a function that retrieves the solution of one of the
+  problems solved with EPSSolveBatch()
+
+  Calling Sequence:
++   eps - eigensolver context that has solved the problem
+.   i   - index of the problem
+-   ctx - [optional] user-defined context passed to EPSSolveBatch()
+
+  Level: advanced
+
+.seealso: EPSSolveBatch()
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(EPSBatchResultFn)(EPS eps,PetscInt i,void *ctx);
+
+SLEPC_EXTERN PetscErrorCode EPSSolveBatch(EPS,PetscInt,PetscInt,EPSBatchOperatorsFn*,EPSBatchResultFn*,void*);
+
 /* --------- options specific to particular eigensolvers -------- */
 
 /*E
@@ -373,6 +419,8 @@ SLEPC_EXTERN PetscErrorCode EPSPowerSetSignNormalization(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSPowerGetSignNormalization(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSPowerSetSNES(EPS,SNES);
 SLEPC_EXTERN PetscErrorCode EPSPowerGetSNES(EPS,SNES*);
+SLEPC_EXTERN PetscErrorCode EPSPowerSetBlockSize(EPS,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSPowerGetBlockSize(EPS,PetscInt*);
 
 SLEPC_EXTERN PetscErrorCode EPSArnoldiSetDelayed(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSArnoldiGetDelayed(EPS,PetscBool*);
@@ -394,12 +442,24 @@ SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetBSEType(EPS,EPSKrylovSchurBSEType);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetBSEType(EPS,EPSKrylovSchurBSEType*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetRestart(EPS,PetscReal);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetRestart(EPS,PetscReal*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetAdaptiveRestart(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetAdaptiveRestart(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetLocking(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetLocking(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetBlockSize(EPS,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetBlockSize(EPS,PetscInt*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetPartitions(EPS,PetscInt);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetPartitions(EPS,PetscInt*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetDetectZeros(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetDetectZeros(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetDynamicBalance(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetDynamicBalance(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetDistributedVectors(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetDistributedVectors(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetInertiaSamples(EPS,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetInertiaSamples(EPS,PetscInt*);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetDOSParameters(EPS,PetscInt,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetDOSParameters(EPS,PetscInt*,PetscInt*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetDimensions(EPS,PetscInt,PetscInt,PetscInt);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurGetDimensions(EPS,PetscInt*,PetscInt*,PetscInt*);
 SLEPC_EXTERN PetscErrorCode EPSKrylovSchurSetSubintervals(EPS,PetscReal*);
@@ -496,6 +556,11 @@ SLEPC_EXTERN PetscErrorCode EPSLOBPCGSetRestart(EPS,PetscReal);
 SLEPC_EXTERN PetscErrorCode EPSLOBPCGGetRestart(EPS,PetscReal*);
 SLEPC_EXTERN PetscErrorCode EPSLOBPCGSetLocking(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSLOBPCGGetLocking(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSLOBPCGSetLowMemory(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSLOBPCGGetLowMemory(EPS,PetscBool*);
+
+SLEPC_EXTERN PetscErrorCode EPSSubspaceSetChebyshev(EPS,PetscBool,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSSubspaceGetChebyshev(EPS,PetscBool*,PetscInt*);
 
 /*E
     EPSCISSQuadRule - determines the quadrature rule in the CISS solver
@@ -529,8 +594,16 @@ SLEPC_EXTERN PetscErrorCode EPSCISSSetThreshold(EPS,PetscReal,PetscReal);
 SLEPC_EXTERN PetscErrorCode EPSCISSGetThreshold(EPS,PetscReal*,PetscReal*);
 SLEPC_EXTERN PetscErrorCode EPSCISSSetRefinement(EPS,PetscInt,PetscInt);
 SLEPC_EXTERN PetscErrorCode EPSCISSGetRefinement(EPS,PetscInt*,PetscInt*);
+SLEPC_EXTERN PetscErrorCode EPSCISSSetQuadRefinement(EPS,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSCISSGetQuadRefinement(EPS,PetscInt*);
+SLEPC_EXTERN PetscErrorCode EPSCISSSetSubregions(EPS,PetscInt);
+SLEPC_EXTERN PetscErrorCode EPSCISSGetSubregions(EPS,PetscInt*);
 SLEPC_EXTERN PetscErrorCode EPSCISSSetUseST(EPS,PetscBool);
 SLEPC_EXTERN PetscErrorCode EPSCISSGetUseST(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSCISSSetLowMemory(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSCISSGetLowMemory(EPS,PetscBool*);
+SLEPC_EXTERN PetscErrorCode EPSCISSSetRandomizedSVD(EPS,PetscBool);
+SLEPC_EXTERN PetscErrorCode EPSCISSGetRandomizedSVD(EPS,PetscBool*);
 SLEPC_EXTERN PetscErrorCode EPSCISSGetKSPs(EPS,PetscInt*,KSP**);
 
 SLEPC_EXTERN PetscErrorCode EPSLyapIISetLME(EPS,LME);
@@ -70,7 +70,8 @@ typedef enum { FN_COMBINE_ADD,
 .seealso: FNSetParallel()
 E*/
 typedef enum { FN_PARALLEL_REDUNDANT,
-               FN_PARALLEL_SYNCHRONIZED } FNParallelType;
+               FN_PARALLEL_SYNCHRONIZED,
+               FN_PARALLEL_DISTRIBUTED } FNParallelType;
 SLEPC_EXTERN const char *FNParallelTypes[];
 
 SLEPC_EXTERN PetscErrorCode FNCreate(MPI_Comm,FN*);
@@ -94,6 +95,8 @@ SLEPC_EXTERN PetscErrorCode FNGetParallel(FN,FNParallelType*);
 
 SLEPC_EXTERN PetscErrorCode FNEvaluateFunction(FN,PetscScalar,PetscScalar*);
 SLEPC_EXTERN PetscErrorCode FNEvaluateDerivative(FN,PetscScalar,PetscScalar*);
+SLEPC_EXTERN PetscErrorCode FNEvaluateFunctionArray(FN,PetscInt,const PetscScalar[],PetscScalar[]);
+SLEPC_EXTERN PetscErrorCode FNEvaluateDerivativeArray(FN,PetscInt,const PetscScalar[],PetscScalar[]);
 SLEPC_EXTERN PetscErrorCode FNEvaluateFunctionMat(FN,Mat,Mat);
 SLEPC_EXTERN PetscErrorCode FNEvaluateFunctionMatVec(FN,Mat,Vec);
 
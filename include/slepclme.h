@@ -14,6 +14,7 @@
 #pragma once
 
 #include <slepcbv.h>
+#include <slepcst.h>
 
 /* SUBMANSEC = LME */
 
@@ -38,6 +39,9 @@ typedef struct _p_LME* LME;
 J*/
 typedef const char* LMEType;
 #define LMEKRYLOV   "krylov"
+#define LMEEKSM     "eksm"
+#define LMERKSM     "rksm"
+#define LMEADI      "adi"
 
 /* Logging support */
 SLEPC_EXTERN PetscClassId LME_CLASSID;
@@ -70,6 +74,7 @@ SLEPC_EXTERN PetscErrorCode LMESetRHS(LME,Mat);
 SLEPC_EXTERN PetscErrorCode LMEGetRHS(LME,Mat*);
 SLEPC_EXTERN PetscErrorCode LMESetSolution(LME,Mat);
 SLEPC_EXTERN PetscErrorCode LMEGetSolution(LME,Mat*);
+SLEPC_EXTERN PetscErrorCode LMESetInitialSpace(LME,PetscInt,Vec[]);
 SLEPC_EXTERN PetscErrorCode LMESetFromOptions(LME);
 SLEPC_EXTERN PetscErrorCode LMESetUp(LME);
 SLEPC_EXTERN PetscErrorCode LMESolve(LME);
@@ -95,6 +100,8 @@ SLEPC_EXTERN PetscErrorCode LMEGetErrorIfNotConverged(LME,PetscBool*);
 
 SLEPC_EXTERN PetscErrorCode LMEDenseLyapunov(LME,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt);
 SLEPC_EXTERN PetscErrorCode LMEDenseHessLyapunovChol(LME,PetscInt,PetscScalar*,PetscInt,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscReal*);
+SLEPC_EXTERN PetscErrorCode LMEDenseSylvester(LME,PetscInt,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt);
+SLEPC_EXTERN PetscErrorCode LMEDenseDTLyapunov(LME,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt,PetscScalar*,PetscInt);
 PETSC_DEPRECATED_FUNCTION(3, 8, 0, "LMEDenseHessLyapunovChol()", ) static inline PetscErrorCode LMEDenseLyapunovChol(LME lme,PetscScalar *H,PetscInt m,PetscInt ldh,PetscScalar *r,PetscScalar *L,PetscInt ldl,PetscReal *res) {return LMEDenseHessLyapunovChol(lme,m,H,ldh,1,r,m,L,ldl,res);}
 
 SLEPC_EXTERN PetscErrorCode LMEMonitor(LME,PetscInt,PetscReal);
@@ -138,3 +145,8 @@ SLEPC_EXTERN PetscErrorCode LMERegister(const char[],PetscErrorCode(*)(LME));
 SLEPC_EXTERN PetscErrorCode LMEMonitorRegister(const char[],PetscViewerType,PetscViewerFormat,PetscErrorCode(*)(LME,PetscInt,PetscReal,PetscViewerAndFormat*),PetscErrorCode(*)(PetscViewer,PetscViewerFormat,void*,PetscViewerAndFormat**),PetscErrorCode(*)(PetscViewerAndFormat**));
 
 SLEPC_EXTERN PetscErrorCode LMEAllocateSolution(LME,PetscInt);
+
+SLEPC_EXTERN PetscErrorCode LMERationalGetST(LME,ST*);
+SLEPC_EXTERN PetscErrorCode LMEADISetShifts(LME,PetscInt,PetscScalar[]);
+SLEPC_EXTERN PetscErrorCode LMEADIGetShifts(LME,PetscInt*,PetscScalar*[]);
+SLEPC_EXTERN PetscErrorCode LMEADIGetST(LME,ST*);
@@ -35,12 +35,20 @@ SLEPC_EXTERN PetscErrorCode SlepcMagmaInit(void);
 #define magma_xgetrf_gpu(a,b,c,d,e,f)   magma_cgetrf_gpu((a),(b),(magmaFloatComplex_ptr)(c),(d),(e),(f))
 #define magma_xgetri_gpu(a,b,c,d,e,f,g) magma_cgetri_gpu((a),(magmaFloatComplex_ptr)(b),(c),(d),(magmaFloatComplex_ptr)(e),(f),(g))
 #define magma_get_xgetri_nb             magma_get_cgetri_nb
+#define magma_xsyevd(a,b,c,d,e,f,g,h,i,j,k,l,m)         magma_cheevd((a),(b),(c),(magmaFloatComplex*)(d),(e),(f),(magmaFloatComplex*)(g),(h),(i),(j),(k),(l),(m))
+#define magma_xsygvd(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) magma_chegvd((a),(b),(c),(d),(magmaFloatComplex*)(e),(f),(magmaFloatComplex*)(g),(h),(i),(magmaFloatComplex*)(j),(k),(l),(m),(n),(o),(p))
+#define magma_xgesdd(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o)     magma_cgesdd((a),(b),(c),(magmaFloatComplex*)(d),(e),(f),(magmaFloatComplex*)(g),(h),(magmaFloatComplex*)(i),(j),(magmaFloatComplex*)(k),(l),(m),(n),(o))
+#define magma_xgehrd2(a,b,c,d,e,f,g,h,i)                magma_cgehrd2((a),(b),(c),(magmaFloatComplex*)(d),(e),(magmaFloatComplex*)(f),(magmaFloatComplex*)(g),(h),(i))
 #else
 #define magma_xgeev(a,b,c,d,e,f,g,h,i,j,k,l,m,n) magma_zgeev((a),(b),(c),(magmaDoubleComplex*)(d),(e),(magmaDoubleComplex*)(f),(magmaDoubleComplex*)(g),(h),(magmaDoubleComplex*)(i),(j),(magmaDoubleComplex*)(k),(l),(m),(n))
 #define magma_xgesv_gpu(a,b,c,d,e,f,g,h)         magma_zgesv_gpu((a),(b),(magmaDoubleComplex_ptr)(c),(d),(e),(magmaDoubleComplex_ptr)(f),(g),(h))
 #define magma_xgetrf_gpu(a,b,c,d,e,f)   magma_zgetrf_gpu((a),(b),(magmaDoubleComplex_ptr)(c),(d),(e),(f))
 #define magma_xgetri_gpu(a,b,c,d,e,f,g) magma_zgetri_gpu((a),(magmaDoubleComplex_ptr)(b),(c),(d),(magmaDoubleComplex_ptr)(e),(f),(g))
 #define magma_get_xgetri_nb             magma_get_zgetri_nb
+#define magma_xsyevd(a,b,c,d,e,f,g,h,i,j,k,l,m)         magma_zheevd((a),(b),(c),(magmaDoubleComplex*)(d),(e),(f),(magmaDoubleComplex*)(g),(h),(i),(j),(k),(l),(m))
+#define magma_xsygvd(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p) magma_zhegvd((a),(b),(c),(d),(magmaDoubleComplex*)(e),(f),(magmaDoubleComplex*)(g),(h),(i),(magmaDoubleComplex*)(j),(k),(l),(m),(n),(o),(p))
+#define magma_xgesdd(a,b,c,d,e,f,g,h,i,j,k,l,m,n,o)     magma_zgesdd((a),(b),(c),(magmaDoubleComplex*)(d),(e),(f),(magmaDoubleComplex*)(g),(h),(magmaDoubleComplex*)(i),(j),(magmaDoubleComplex*)(k),(l),(m),(n),(o))
+#define magma_xgehrd2(a,b,c,d,e,f,g,h,i)                magma_zgehrd2((a),(b),(c),(magmaDoubleComplex*)(d),(e),(magmaDoubleComplex*)(f),(magmaDoubleComplex*)(g),(h),(i))
 #endif
 #else
 #if defined(PETSC_USE_REAL_SINGLE)
@@ -49,12 +57,20 @@ SLEPC_EXTERN PetscErrorCode SlepcMagmaInit(void);
 #define magma_xgetrf_gpu                magma_sgetrf_gpu
 #define magma_xgetri_gpu                magma_sgetri_gpu
 #define magma_get_xgetri_nb             magma_get_sgetri_nb
+#define magma_xsyevd                    magma_ssyevd
+#define magma_xsygvd                    magma_ssygvd
+#define magma_xgesdd                    magma_sgesdd
+#define magma_xgehrd2                   magma_sgehrd2
 #else
 #define magma_xgeev                     magma_dgeev
 #define magma_xgesv_gpu                 magma_dgesv_gpu
 #define magma_xgetrf_gpu                magma_dgetrf_gpu
 #define magma_xgetri_gpu                magma_dgetri_gpu
 #define magma_get_xgetri_nb             magma_get_dgetri_nb
+#define magma_xsyevd                    magma_dsyevd
+#define magma_xsygvd                    magma_dsygvd
+#define magma_xgesdd                    magma_dgesdd
+#define magma_xgehrd2                   magma_dgehrd2
 #endif
 #endif
 
@@ -15,6 +15,7 @@
 
 #include <slepcbv.h>
 #include <slepcfn.h>
+#include <slepcst.h>
 
 /* SUBMANSEC = MFN */
 
@@ -40,6 +41,7 @@ J*/
 typedef const char* MFNType;
 #define MFNKRYLOV   "krylov"
 #define MFNEXPOKIT  "expokit"
+#define MFNRATKRYLOV "ratkrylov"
 
 /* Logging support */
 SLEPC_EXTERN PetscClassId MFN_CLASSID;
@@ -55,6 +57,8 @@ SLEPC_EXTERN PetscErrorCode MFNSetFromOptions(MFN);
 SLEPC_EXTERN PetscErrorCode MFNSetUp(MFN);
 SLEPC_EXTERN PetscErrorCode MFNSolve(MFN,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode MFNSolveTranspose(MFN,Vec,Vec);
+SLEPC_EXTERN PetscErrorCode MFNSolveMat(MFN,Mat,Mat);
+SLEPC_EXTERN PetscErrorCode MFNSolveTimes(MFN,PetscInt,const PetscScalar[],Vec,Vec[],PetscReal[]);
 SLEPC_EXTERN PetscErrorCode MFNView(MFN,PetscViewer);
 SLEPC_EXTERN PetscErrorCode MFNViewFromOptions(MFN,PetscObject,const char[]);
 SLEPC_EXTERN PetscErrorCode MFNConvergedReasonView(MFN,PetscViewer);
@@ -117,3 +121,9 @@ SLEPC_EXTERN PetscErrorCode MFNRegister(const char[],PetscErrorCode(*)(MFN));
 SLEPC_EXTERN PetscErrorCode MFNMonitorRegister(const char[],PetscViewerType,PetscViewerFormat,PetscErrorCode(*)(MFN,PetscInt,PetscReal,PetscViewerAndFormat*),PetscErrorCode(*)(PetscViewer,PetscViewerFormat,void*,PetscViewerAndFormat**),PetscErrorCode(*)(PetscViewerAndFormat**));
 
 SLEPC_EXTERN PetscErrorCode MFNAllocateSolution(MFN,PetscInt);
+
+SLEPC_EXTERN PetscErrorCode MFNKrylovEvaluateTime(MFN,PetscScalar,Vec,PetscReal*);
+
+SLEPC_EXTERN PetscErrorCode MFNRatKrylovSetPoles(MFN,PetscInt,PetscScalar[]);
+SLEPC_EXTERN PetscErrorCode MFNRatKrylovGetPoles(MFN,PetscInt*,PetscScalar*[]);
+SLEPC_EXTERN PetscErrorCode MFNRatKrylovGetST(MFN,ST*);
@@ -300,6 +300,7 @@ SLEPC_EXTERN PetscErrorCode NEPMonitorConvergedCreate(PetscViewer,PetscViewerFor
 SLEPC_EXTERN PetscErrorCode NEPMonitorConvergedDrawLG(NEP,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 SLEPC_EXTERN PetscErrorCode NEPMonitorConvergedDrawLGCreate(PetscViewer,PetscViewerFormat,void *,PetscViewerAndFormat**);
 SLEPC_EXTERN PetscErrorCode NEPMonitorConvergedDestroy(PetscViewerAndFormat**);
+SLEPC_EXTERN PetscErrorCode NEPMonitorAllBinary(NEP,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 
 SLEPC_EXTERN PetscErrorCode NEPSetOptionsPrefix(NEP,const char*);
 SLEPC_EXTERN PetscErrorCode NEPAppendOptionsPrefix(NEP,const char*);
@@ -362,6 +363,8 @@ SLEPC_EXTERN PetscErrorCode NEPRIISetMaximumIterations(NEP,PetscInt);
 SLEPC_EXTERN PetscErrorCode NEPRIIGetMaximumIterations(NEP,PetscInt*);
 SLEPC_EXTERN PetscErrorCode NEPRIISetLagPreconditioner(NEP,PetscInt);
 SLEPC_EXTERN PetscErrorCode NEPRIIGetLagPreconditioner(NEP,PetscInt*);
+SLEPC_EXTERN PetscErrorCode NEPRIISetLagAdaptive(NEP,PetscBool);
+SLEPC_EXTERN PetscErrorCode NEPRIIGetLagAdaptive(NEP,PetscBool*);
 SLEPC_EXTERN PetscErrorCode NEPRIISetConstCorrectionTol(NEP,PetscBool);
 SLEPC_EXTERN PetscErrorCode NEPRIIGetConstCorrectionTol(NEP,PetscBool*);
 SLEPC_EXTERN PetscErrorCode NEPRIISetHermitian(NEP,PetscBool);
@@ -373,6 +376,8 @@ SLEPC_EXTERN PetscErrorCode NEPRIIGetKSP(NEP,KSP*);
 
 SLEPC_EXTERN PetscErrorCode NEPSLPSetDeflationThreshold(NEP,PetscReal);
 SLEPC_EXTERN PetscErrorCode NEPSLPGetDeflationThreshold(NEP,PetscReal*);
+SLEPC_EXTERN PetscErrorCode NEPSLPSetLagPreconditioner(NEP,PetscInt);
+SLEPC_EXTERN PetscErrorCode NEPSLPGetLagPreconditioner(NEP,PetscInt*);
 SLEPC_EXTERN PetscErrorCode NEPSLPSetEPS(NEP,EPS);
 SLEPC_EXTERN PetscErrorCode NEPSLPGetEPS(NEP,EPS*);
 SLEPC_EXTERN PetscErrorCode NEPSLPSetEPSLeft(NEP,EPS);
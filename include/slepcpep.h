@@ -229,6 +229,7 @@ SLEPC_EXTERN PetscErrorCode PEPValuesView(PEP,PetscViewer);
 SLEPC_EXTERN PetscErrorCode PEPValuesViewFromOptions(PEP);
 SLEPC_EXTERN PetscErrorCode PEPVectorsView(PEP,PetscViewer);
 SLEPC_EXTERN PetscErrorCode PEPVectorsViewFromOptions(PEP);
+SLEPC_EXTERN PetscErrorCode PEPSaveSolution(PEP,const char[]);
 SLEPC_EXTERN PetscErrorCode PEPSetBV(PEP,BV);
 SLEPC_EXTERN PetscErrorCode PEPGetBV(PEP,BV*);
 SLEPC_EXTERN PetscErrorCode PEPSetRG(PEP,RG);
@@ -295,6 +296,7 @@ SLEPC_EXTERN PetscErrorCode PEPMonitorConvergedCreate(PetscViewer,PetscViewerFor
 SLEPC_EXTERN PetscErrorCode PEPMonitorConvergedDrawLG(PEP,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 SLEPC_EXTERN PetscErrorCode PEPMonitorConvergedDrawLGCreate(PetscViewer,PetscViewerFormat,void *,PetscViewerAndFormat**);
 SLEPC_EXTERN PetscErrorCode PEPMonitorConvergedDestroy(PetscViewerAndFormat**);
+SLEPC_EXTERN PetscErrorCode PEPMonitorAllBinary(PEP,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 
 SLEPC_EXTERN PetscErrorCode PEPSetOptionsPrefix(PEP,const char*);
 SLEPC_EXTERN PetscErrorCode PEPAppendOptionsPrefix(PEP,const char*);
@@ -383,6 +385,8 @@ SLEPC_EXTERN PetscErrorCode PEPSTOARSetDimensions(PEP,PetscInt,PetscInt,PetscInt
 SLEPC_EXTERN PetscErrorCode PEPSTOARGetDimensions(PEP,PetscInt*,PetscInt*,PetscInt*);
 SLEPC_EXTERN PetscErrorCode PEPSTOARSetCheckEigenvalueType(PEP,PetscBool);
 SLEPC_EXTERN PetscErrorCode PEPSTOARGetCheckEigenvalueType(PEP,PetscBool*);
+SLEPC_EXTERN PetscErrorCode PEPSTOARSetPartitions(PEP,PetscInt);
+SLEPC_EXTERN PetscErrorCode PEPSTOARGetPartitions(PEP,PetscInt*);
 SLEPC_EXTERN PetscErrorCode PEPCheckDefiniteQEP(PEP,PetscReal*,PetscReal*,PetscInt*,PetscInt*);
 
 /*E
@@ -406,6 +410,8 @@ SLEPC_EXTERN PetscErrorCode PEPJDSetMinimalityIndex(PEP,PetscInt);
 SLEPC_EXTERN PetscErrorCode PEPJDGetMinimalityIndex(PEP,PetscInt*);
 SLEPC_EXTERN PetscErrorCode PEPJDSetProjection(PEP,PEPJDProjection);
 SLEPC_EXTERN PetscErrorCode PEPJDGetProjection(PEP,PEPJDProjection*);
+SLEPC_EXTERN PetscErrorCode PEPJDSetBlockSize(PEP,PetscInt);
+SLEPC_EXTERN PetscErrorCode PEPJDGetBlockSize(PEP,PetscInt*);
 
 /*E
     PEPCISSExtraction - determines the extraction technique in the CISS solver
@@ -87,6 +87,7 @@ SLEPC_EXTERN PetscErrorCode STApplyHermitianTranspose(ST,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatMult(ST,PetscInt,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatMultTranspose(ST,PetscInt,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatMultHermitianTranspose(ST,PetscInt,Vec,Vec);
+SLEPC_EXTERN PetscErrorCode STMatMultCombination(ST,PetscInt,const PetscScalar[],Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatSolve(ST,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatSolveTranspose(ST,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode STMatSolveHermitianTranspose(ST,Vec,Vec);
@@ -99,6 +100,7 @@ SLEPC_EXTERN PetscErrorCode STSetWorkVecs(ST,PetscInt);
 
 SLEPC_EXTERN PetscErrorCode STSetKSP(ST,KSP);
 SLEPC_EXTERN PetscErrorCode STGetKSP(ST,KSP*);
+SLEPC_EXTERN PetscErrorCode STUpdateInnerTolerance(ST,PetscReal);
 SLEPC_EXTERN PetscErrorCode STSetShift(ST,PetscScalar);
 SLEPC_EXTERN PetscErrorCode STGetShift(ST,PetscScalar*);
 SLEPC_EXTERN PetscErrorCode STSetDefaultShift(ST,PetscScalar);
@@ -109,6 +111,10 @@ SLEPC_EXTERN PetscErrorCode STSetTransform(ST,PetscBool);
 SLEPC_EXTERN PetscErrorCode STGetTransform(ST,PetscBool*);
 SLEPC_EXTERN PetscErrorCode STSetStructured(ST,PetscBool);
 SLEPC_EXTERN PetscErrorCode STGetStructured(ST,PetscBool*);
+SLEPC_EXTERN PetscErrorCode STSetAdaptiveInnerTolerance(ST,PetscBool);
+SLEPC_EXTERN PetscErrorCode STGetAdaptiveInnerTolerance(ST,PetscBool*);
+SLEPC_EXTERN PetscErrorCode STSetInertiaPartitions(ST,PetscInt);
+SLEPC_EXTERN PetscErrorCode STGetInertiaPartitions(ST,PetscInt*);
 
 SLEPC_EXTERN PetscErrorCode STSetOptionsPrefix(ST,const char*);
 SLEPC_EXTERN PetscErrorCode STAppendOptionsPrefix(ST,const char*);
@@ -118,6 +124,7 @@ SLEPC_EXTERN PetscErrorCode STBackTransform(ST,PetscInt,PetscScalar*,PetscScalar
 SLEPC_EXTERN PetscErrorCode STIsInjective(ST,PetscBool*);
 
 SLEPC_EXTERN PetscErrorCode STCheckNullSpace(ST,BV);
+SLEPC_EXTERN PetscErrorCode STGetInertia(ST,PetscInt,const PetscReal[],PetscInt[],PetscInt[]);
 
 SLEPC_EXTERN PetscErrorCode STSetPreconditionerMat(ST,Mat);
 SLEPC_EXTERN PetscErrorCode STGetPreconditionerMat(ST,Mat*);
@@ -163,11 +170,49 @@ SLEPC_EXTERN PetscErrorCode STShellSetBackTransform(ST,PetscErrorCode (*)(ST,Pet
 SLEPC_EXTERN PetscErrorCode STCayleyGetAntishift(ST,PetscScalar*);
 SLEPC_EXTERN PetscErrorCode STCayleySetAntishift(ST,PetscScalar);
 
+SLEPC_EXTERN PetscErrorCode STSinvertSetRefinement(ST,PetscInt,PetscReal);
+SLEPC_EXTERN PetscErrorCode STSinvertGetRefinement(ST,PetscInt*,PetscReal*);
+SLEPC_EXTERN PetscErrorCode STSinvertSetShiftCache(ST,PetscInt);
+SLEPC_EXTERN PetscErrorCode STSinvertGetShiftCache(ST,PetscInt*);
+
 PETSC_DEPRECATED_FUNCTION(3, 15, 0, "STGetPreconditionerMat()", ) static inline PetscErrorCode STPrecondGetMatForPC(ST st,Mat *A) {return STGetPreconditionerMat(st,A);}
 PETSC_DEPRECATED_FUNCTION(3, 15, 0, "STSetPreconditionerMat()", ) static inline PetscErrorCode STPrecondSetMatForPC(ST st,Mat A) {return STSetPreconditionerMat(st,A);}
 SLEPC_EXTERN PetscErrorCode STPrecondGetKSPHasMat(ST,PetscBool*);
 SLEPC_EXTERN PetscErrorCode STPrecondSetKSPHasMat(ST,PetscBool);
+SLEPC_EXTERN PetscErrorCode STPrecondGetDeflation(ST,PetscBool*);
+SLEPC_EXTERN PetscErrorCode STPrecondSetDeflation(ST,PetscBool);
+SLEPC_EXTERN PetscErrorCode STPrecondUpdateDeflation(ST,PC,BV);
+SLEPC_EXTERN PetscErrorCode STPrecondApplyDeflated(ST,PC,Vec,Vec);
+
+/*E
+    STFilterType - Selects the method used to build the polynomial filter
+
+    Level: intermediate
+
+.seealso: STFilterSetType(), STFilterGetType()
+E*/
+typedef enum { STFILTER_FILTLAN,
+               STFILTER_CHEBYSHEV } STFilterType;
+SLEPC_EXTERN const char *STFilterTypes[];
+
+/*E
+    STFilterDamping - The damping of the coefficients of the Chebyshev filter,
+    to remove the Gibbs oscillations
 
+    Level: intermediate
+
+.seealso: STFilterSetDamping(), STFilterGetDamping()
+E*/
+typedef enum { STFILTER_DAMPING_NONE,
+               STFILTER_DAMPING_JACKSON,
+               STFILTER_DAMPING_LANCZOS,
+               STFILTER_DAMPING_FEJER } STFilterDamping;
+SLEPC_EXTERN const char *STFilterDampings[];
+
+SLEPC_EXTERN PetscErrorCode STFilterSetType(ST,STFilterType);
+SLEPC_EXTERN PetscErrorCode STFilterGetType(ST,STFilterType*);
+SLEPC_EXTERN PetscErrorCode STFilterSetDamping(ST,STFilterDamping);
+SLEPC_EXTERN PetscErrorCode STFilterGetDamping(ST,STFilterDamping*);
 SLEPC_EXTERN PetscErrorCode STFilterSetInterval(ST,PetscReal,PetscReal);
 SLEPC_EXTERN PetscErrorCode STFilterGetInterval(ST,PetscReal*,PetscReal*);
 SLEPC_EXTERN PetscErrorCode STFilterSetRange(ST,PetscReal,PetscReal);
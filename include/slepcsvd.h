@@ -153,6 +153,8 @@ PETSC_DEPRECATED_FUNCTION(3, 1, 0, "SVDSetInitialSpaces()", ) static inline Pets
 PETSC_DEPRECATED_FUNCTION(3, 1, 0, "SVDSetInitialSpaces()", ) static inline PetscErrorCode SVDSetInitialSpaceLeft(SVD svd,PetscInt nl,Vec *isl) {return SVDSetInitialSpaces(svd,0,PETSC_NULLPTR,nl,isl);}
 SLEPC_EXTERN PetscErrorCode SVDSetImplicitTranspose(SVD,PetscBool);
 SLEPC_EXTERN PetscErrorCode SVDGetImplicitTranspose(SVD,PetscBool*);
+SLEPC_EXTERN PetscErrorCode SVDSetValuesOnly(SVD,PetscBool);
+SLEPC_EXTERN PetscErrorCode SVDGetValuesOnly(SVD,PetscBool*);
 SLEPC_EXTERN PetscErrorCode SVDSetDimensions(SVD,PetscInt,PetscInt,PetscInt);
 SLEPC_EXTERN PetscErrorCode SVDGetDimensions(SVD,PetscInt*,PetscInt*,PetscInt*);
 SLEPC_EXTERN PetscErrorCode SVDSetTolerances(SVD,PetscReal,PetscInt);
@@ -166,7 +168,11 @@ SLEPC_EXTERN PetscErrorCode SVDGetOptionsPrefix(SVD,const char*[]);
 SLEPC_EXTERN PetscErrorCode SVDSetDSType(SVD);
 SLEPC_EXTERN PetscErrorCode SVDSetUp(SVD);
 SLEPC_EXTERN PetscErrorCode SVDSolve(SVD);
+SLEPC_EXTERN PetscErrorCode SVDCheckpoint(SVD,PetscViewer);
+SLEPC_EXTERN PetscErrorCode SVDRestart(SVD,PetscViewer);
+SLEPC_EXTERN PetscErrorCode SVDUpdate(SVD,Mat);
 SLEPC_EXTERN PetscErrorCode SVDGetIterationNumber(SVD,PetscInt*);
+SLEPC_EXTERN PetscErrorCode SVDGetPerformanceStats(SVD,SlepcPerfPhase,PetscEventPerfInfo*);
 SLEPC_EXTERN PetscErrorCode SVDSetConvergenceTest(SVD,SVDConv);
 SLEPC_EXTERN PetscErrorCode SVDGetConvergenceTest(SVD,SVDConv*);
 SLEPC_EXTERN PetscErrorCode SVDConvergedAbsolute(SVD,PetscReal,PetscReal,PetscReal*,void*);
@@ -180,6 +186,8 @@ SLEPC_EXTERN PetscErrorCode SVDGetConvergedReason(SVD,SVDConvergedReason*);
 SLEPC_EXTERN PetscErrorCode SVDGetConverged(SVD,PetscInt*);
 SLEPC_EXTERN PetscErrorCode SVDGetSingularTriplet(SVD,PetscInt,PetscReal*,Vec,Vec);
 SLEPC_EXTERN PetscErrorCode SVDComputeError(SVD,PetscInt,SVDErrorType,PetscReal*);
+SLEPC_EXTERN PetscErrorCode SVDComputeErrors(SVD,PetscInt,PetscInt,SVDErrorType,PetscReal*);
+SLEPC_EXTERN PetscErrorCode SVDGetErrorEstimate(SVD,PetscInt,PetscReal*);
 PETSC_DEPRECATED_FUNCTION(3, 6, 0, "SVDComputeError()", ) static inline PetscErrorCode SVDComputeRelativeError(SVD svd,PetscInt i,PetscReal *r) {return SVDComputeError(svd,i,SVD_ERROR_RELATIVE,r);}
 PETSC_DEPRECATED_FUNCTION(3, 6, 0, "SVDComputeError() with SVD_ERROR_ABSOLUTE", ) static inline PetscErrorCode SVDComputeResidualNorms(SVD svd,PetscInt i,PetscReal *r1,PETSC_UNUSED PetscReal *r2) {return SVDComputeError(svd,i,SVD_ERROR_ABSOLUTE,r1);}
 SLEPC_EXTERN PetscErrorCode SVDView(SVD,PetscViewer);
@@ -195,6 +203,7 @@ SLEPC_EXTERN PetscErrorCode SVDValuesView(SVD,PetscViewer);
 SLEPC_EXTERN PetscErrorCode SVDValuesViewFromOptions(SVD);
 SLEPC_EXTERN PetscErrorCode SVDVectorsView(SVD,PetscViewer);
 SLEPC_EXTERN PetscErrorCode SVDVectorsViewFromOptions(SVD);
+SLEPC_EXTERN PetscErrorCode SVDSaveSolution(SVD,const char[]);
 SLEPC_EXTERN PetscErrorCode SVDDestroy(SVD*);
 SLEPC_EXTERN PetscErrorCode SVDReset(SVD);
 SLEPC_EXTERN PetscErrorCode SVDSetWorkVecs(SVD,PetscInt,PetscInt);
@@ -219,6 +228,7 @@ SLEPC_EXTERN PetscErrorCode SVDMonitorConvergedCreate(PetscViewer,PetscViewerFor
 SLEPC_EXTERN PetscErrorCode SVDMonitorConvergedDrawLG(SVD,PetscInt,PetscInt,PetscReal*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 SLEPC_EXTERN PetscErrorCode SVDMonitorConvergedDrawLGCreate(PetscViewer,PetscViewerFormat,void *,PetscViewerAndFormat**);
 SLEPC_EXTERN PetscErrorCode SVDMonitorConvergedDestroy(PetscViewerAndFormat**);
+SLEPC_EXTERN PetscErrorCode SVDMonitorAllBinary(SVD,PetscInt,PetscInt,PetscReal*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 SLEPC_EXTERN PetscErrorCode SVDMonitorConditioning(SVD,PetscInt,PetscInt,PetscReal*,PetscReal*,PetscInt,PetscViewerAndFormat*);
 
 SLEPC_EXTERN PetscFunctionList SVDList;
@@ -269,6 +279,40 @@ PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(SVDStoppingTestFn)(SVD svd,PetscInt
 SLEPC_EXTERN PetscErrorCode SVDSetConvergenceTestFunction(SVD,SVDConvergenceTestFn*,void*,PetscErrorCode (*)(void*));
 SLEPC_EXTERN PetscErrorCode SVDSetStoppingTestFunction(SVD,SVDStoppingTestFn*,void*,PetscErrorCode (*)(void*));
 
+/*S
+  SVDBatchOperatorsFn - A prototype of a function that creates the matrices of one of the
+  problems solved with SVDSolveBatch()
+
+  Calling Sequence:
++   svd - singular value solver context that will solve the problem
+.   i   - index of the problem
+.   A   - [output] the matrix associated with the singular value problem
+.   B   - [output] the second matrix in the case of GSVD (or NULL)
+-   ctx - [optional] user-defined context passed to SVDSolveBatch()
+
+  Level: advanced
+
+.seealso: SVDSolveBatch()
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(SVDBatchOperatorsFn)(SVD svd,PetscInt i,Mat *A,Mat *B,void *ctx);
+
+/*S
+  SVDBatchResultFn - A prototype of a function that retrieves the solution of one of the
+  problems solved with SVDSolveBatch()
+
+  Calling Sequence:
++   svd - singular value solver context that has solved the problem
+.   i   - index of the problem
+-   ctx - [optional] user-defined context passed to SVDSolveBatch()
+
+  Level: advanced
+
+.seealso: SVDSolveBatch()
+S*/
+PETSC_EXTERN_TYPEDEF typedef PetscErrorCode(SVDBatchResultFn)(SVD svd,PetscInt i,void *ctx);
+
+SLEPC_EXTERN PetscErrorCode SVDSolveBatch(SVD,PetscInt,PetscInt,SVDBatchOperatorsFn*,SVDBatchResultFn*,void*);
+
 /* --------- options specific to particular solvers -------- */
 
 SLEPC_EXTERN PetscErrorCode SVDCrossSetExplicitMatrix(SVD,PetscBool);
@@ -284,6 +328,30 @@ SLEPC_EXTERN PetscErrorCode SVDCyclicGetEPS(SVD,EPS*);
 SLEPC_EXTERN PetscErrorCode SVDLanczosSetOneSide(SVD,PetscBool);
 SLEPC_EXTERN PetscErrorCode SVDLanczosGetOneSide(SVD,PetscBool*);
 
+SLEPC_EXTERN PetscErrorCode SVDRandomizedSetSinglePass(SVD,PetscBool);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedGetSinglePass(SVD,PetscBool*);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedSetStream(SVD,PetscViewer,PetscInt);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedGetStream(SVD,PetscViewer*,PetscInt*);
+
+/*E
+    SVDRandomizedSketchType - determines the type of random matrix used to
+    sketch the range of the matrix in the randomized SVD
+
+    Level: advanced
+
+.seealso: SVDRandomizedSetSketch(), SVDRandomizedGetSketch()
+E*/
+typedef enum { SVD_RANDOMIZED_SKETCH_GAUSSIAN,
+               SVD_RANDOMIZED_SKETCH_SPARSE_SIGN } SVDRandomizedSketchType;
+SLEPC_EXTERN const char *SVDRandomizedSketchTypes[];
+
+SLEPC_EXTERN PetscErrorCode SVDRandomizedSetSketch(SVD,SVDRandomizedSketchType,PetscInt);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedGetSketch(SVD,SVDRandomizedSketchType*,PetscInt*);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedSetPowerIterations(SVD,PetscInt,PetscInt);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedGetPowerIterations(SVD,PetscInt*,PetscInt*);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedSetAdaptiveRank(SVD,PetscBool,PetscInt);
+SLEPC_EXTERN PetscErrorCode SVDRandomizedGetAdaptiveRank(SVD,PetscBool*,PetscInt*);
+
 /*E
     SVDTRLanczosGBidiag - determines the bidiagonalization choice for the
     TRLanczos GSVD solver
@@ -313,6 +381,10 @@ SLEPC_EXTERN PetscErrorCode SVDTRLanczosSetExplicitMatrix(SVD,PetscBool);
 SLEPC_EXTERN PetscErrorCode SVDTRLanczosGetExplicitMatrix(SVD,PetscBool*);
 SLEPC_EXTERN PetscErrorCode SVDTRLanczosSetScale(SVD,PetscReal);
 SLEPC_EXTERN PetscErrorCode SVDTRLanczosGetScale(SVD,PetscReal*);
+SLEPC_EXTERN PetscErrorCode SVDTRLanczosSetBlockSize(SVD,PetscInt);
+SLEPC_EXTERN PetscErrorCode SVDTRLanczosGetBlockSize(SVD,PetscInt*);
+SLEPC_EXTERN PetscErrorCode SVDTRLanczosSetFusedMult(SVD,PetscBool);
+SLEPC_EXTERN PetscErrorCode SVDTRLanczosGetFusedMult(SVD,PetscBool*);
 
 /*E
     SVDPRIMMEMethod - determines the SVD method selected in the PRIMME library
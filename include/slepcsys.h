@@ -82,6 +82,33 @@
 */
 typedef struct _n_SlepcConvMon* SlepcConvMon;
 
+/*E
+   SlepcPerfPhase - Phase of a solve for which performance data is collected
+
+   Values:
++  SLEPC_PERF_SOLVE          - the whole solve, including the setup
+.  SLEPC_PERF_SETUP          - the setup of the solver
+.  SLEPC_PERF_ORTHOGONALIZE  - orthogonalization of the basis vectors
+.  SLEPC_PERF_DSSOLVE        - solution of the projected problems
+.  SLEPC_PERF_DSSYNCHRONIZE  - broadcasts of the projected problems, see DSSynchronize()
+.  SLEPC_PERF_STAPPLY        - application of the spectral transformation
+.  SLEPC_PERF_MATMULT        - matrix-vector products
+-  SLEPC_PERF_KSPSOLVE       - linear solves
+
+   Level: intermediate
+
+.seealso: EPSGetPerformanceStats(), SVDGetPerformanceStats()
+E*/
+typedef enum { SLEPC_PERF_SOLVE,
+               SLEPC_PERF_SETUP,
+               SLEPC_PERF_ORTHOGONALIZE,
+               SLEPC_PERF_DSSOLVE,
+               SLEPC_PERF_DSSYNCHRONIZE,
+               SLEPC_PERF_STAPPLY,
+               SLEPC_PERF_MATMULT,
+               SLEPC_PERF_KSPSOLVE } SlepcPerfPhase;
+#define SLEPC_PERF_NPHASES 8
+
 /*
     Initialization of SLEPc and other system routines
 */
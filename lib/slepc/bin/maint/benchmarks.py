@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+#
+#  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#  SLEPc - Scalable Library for Eigenvalue Problem Computations
+#  Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+#
+#  This file is part of SLEPc.
+#  SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+#  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#
+#  Runs a fixed set of benchmark problems with several solvers, sizes and numbers
+#  of MPI processes, and writes the timings in JSON format, so that the results of
+#  two SLEPc versions (or configurations) can be compared. Invoked by 'make benchmarks'.
+#
+#  Usage:
+#    ./benchmarks.py --slepc-dir=<SLEPC_DIR> --petsc-dir=<PETSC_DIR> --petsc-arch=<PETSC_ARCH>
+#                    [--mpiexec=<MPIEXEC>] [--np=1,2,4] [--sizes=small|medium|large]
+#                    [--filter=<substring>] [--output=<file.json>]
+#
+#  The time and counters of each run are taken from the log event of the solve
+#  (EPSSolve, SVDSolve, PEPSolve), using -log_view in CSV format, maximum over the
+#  processes. Each run also records the wall time of the whole executable.
+#
+
+from __future__ import print_function
+import os, sys, csv, json, time, shlex, argparse, platform, tempfile, subprocess
+
+DATA = os.path.join('share','slepc','datafiles','matrices')
+
+# name, directory, example, arguments, size argument, sizes, log event
+#   sizes are given for the 'small', 'medium' and 'large' sets, None means a fixed problem
+CASES = [
+  ('eps_laplacian3d_krylovschur','src/eps/tutorials','ex19','-eps_nev 8 -eps_type krylovschur -eps_ncv 64',
+   '-da_grid_x {n} -da_grid_y {n} -da_grid_z {n}',{'small':[16,24],'medium':[32,48],'large':[64,96]},'EPSSolve'),
+  ('eps_laplacian3d_lobpcg','src/eps/tutorials','ex19','-eps_nev 8 -eps_type lobpcg -eps_tol 1e-7',
+   '-da_grid_x {n} -da_grid_y {n} -da_grid_z {n}',{'small':[16,24],'medium':[32,48],'large':[64,96]},'EPSSolve'),
+  ('eps_rdb200_krylovschur','src/eps/tutorials','ex4','-file {data}/rdb200.petsc -eps_nev 4',
+   None,None,'EPSSolve'),
+  ('eps_bfw62_krylovschur','src/eps/tutorials','ex7','-f1 {data}/bfw62a.petsc -f2 {data}/bfw62b.petsc -eps_nev 4',
+   None,None,'EPSSolve'),
+  ('eps_bse_krylovschur','src/eps/tutorials','ex55','-eps_nev 4 -eps_ncv 16 -eps_krylovschur_bse_type shao',
+   '-n {n}',{'small':[200,400],'medium':[800,1600],'large':[3200,6400]},'EPSSolve'),
+  ('svd_rdb200_trlanczos','src/svd/tutorials','ex14','-file {data}/rdb200.petsc -svd_nsv 4 -svd_type trlanczos',
+   None,None,'SVDSolve'),
+  ('svd_lauchli_trlanczos','src/svd/tutorials','ex15','-svd_type trlanczos -svd_nsv 4',
+   '-n {n}',{'small':[1000,2000],'medium':[10000,20000],'large':[100000,200000]},'SVDSolve'),
+  ('pep_quadratic_toar','src/pep/tutorials','ex16','-pep_type toar -pep_nev 4 -pep_ncv 21',
+   '-n {n}',{'small':[32,64],'medium':[128,256],'large':[512,1024]},'PEPSolve'),
+  ('pep_speaker_toar','src/pep/tutorials','ex17','-A {data}/speaker107k.petsc,{data}/speaker107c.petsc,{data}/speaker107m.petsc -pep_type toar -pep_nev 4 -pep_ncv 20 -pep_scale scalar',
+   None,None,'PEPSolve'),
+]
+
+def build(opts,directory,example):
+  ''' Builds an example with the legacy makefile of its directory, returns the path of the executable '''
+  path = os.path.join(opts.slepc_dir,directory)
+  cmd = ['make','-s','-C',path,example,'SLEPC_DIR='+opts.slepc_dir,'PETSC_DIR='+opts.petsc_dir,'PETSC_ARCH='+opts.petsc_arch]
+  subprocess.check_call(cmd,stdout=subprocess.DEVNULL)
+  return os.path.join(path,example)
+
+def parseLog(filename,event):
+  ''' Extracts the counters of one event from a -log_view CSV file, maximum over the processes '''
+  info = {'count':0,'time':0.0,'flops':0.0,'messages':0.0,'message_length':0.0,'reductions':0.0}
+  keys = {'Count':'count','Time':'time','FLOP':'flops','Num Messages':'messages','Message Length':'message_length','Num Reductions':'reductions'}
+  with open(filename) as f:
+    for row in csv.DictReader(f):
+      if row.get('Event Name','').strip() != event: continue
+      for k,v in keys.items():
+        if k not in row: continue
+        val = float(row[k]) if v != 'count' else int(float(row[k]))
+        info[v] = max(info[v],val)
+  return info
+
+def run(opts,exe,args,np):
+  ''' Runs an executable, returns its wall time and the log counters of the solve '''
+  fd,logfile = tempfile.mkstemp(suffix='.csv')
+  os.close(fd)
+  cmd = shlex.split(opts.mpiexec)+['-n',str(np),exe]+shlex.split(args)+['-log_view',':'+logfile+':ascii_csv']
+  t0 = time.perf_counter()
+  proc = subprocess.run(cmd,stdout=subprocess.PIPE,stderr=subprocess.STDOUT,universal_newlines=True)
+  wall = time.perf_counter()-t0
+  return proc.returncode,proc.stdout,wall,logfile
+
+def main():
+  parser = argparse.ArgumentParser(description='Run the SLEPc benchmark problems')
+  parser.add_argument('--slepc-dir',default=os.environ.get('SLEPC_DIR',''))
+  parser.add_argument('--petsc-dir',default=os.environ.get('PETSC_DIR',''))
+  parser.add_argument('--petsc-arch',default=os.environ.get('PETSC_ARCH',''))
+  parser.add_argument('--mpiexec',default='mpiexec')
+  parser.add_argument('--np',default='1,2,4',help='comma-separated list of numbers of processes')
+  parser.add_argument('--sizes',default='small',choices=['small','medium','large'])
+  parser.add_argument('--filter',default='',help='run only the cases whose name contains this string')
+  parser.add_argument('--output',default='benchmarks.json')
+  opts = parser.parse_args()
+  if not opts.slepc_dir or not opts.petsc_dir:
+    sys.exit('SLEPC_DIR and PETSC_DIR must be set')
+  nps = [int(p) for p in opts.np.split(',') if p]
+  data = os.path.join(opts.slepc_dir,DATA)
+
+  results = []
+  built = {}
+  failed = 0
+  for name,directory,example,args,sizearg,sizes,event in CASES:
+    if opts.filter and opts.filter not in name: continue
+    key = (directory,example)
+    if key not in built:
+      try:
+        built[key] = build(opts,directory,example)
+      except subprocess.CalledProcessError:
+        print('Could not build %s/%s, skipping %s' % (directory,example,name))
+        built[key] = None
+    exe = built[key]
+    if not exe: continue
+    for n in (sizes[opts.sizes] if sizes else [None]):
+      for np in nps:
+        cargs = args.format(data=data)
+        if sizearg: cargs += ' '+sizearg.format(n=n)
+        rc,out,wall,logfile = run(opts,exe,cargs,np)
+        entry = {'name':name,'example':directory+'/'+example,'size':n,'np':np,'args':cargs,'wall_time':wall,'event':event,'status':'ok' if rc==0 else 'failed'}
+        if rc==0 and os.path.isfile(logfile): entry.update(parseLog(logfile,event))
+        else:
+          failed += 1
+          entry['output'] = out[-2000:]
+        if os.path.isfile(logfile): os.remove(logfile)
+        print('%-32s size=%-8s np=%-3d %s %.3fs' % (name,'' if n is None else n,np,entry['status'],entry.get('time',wall)))
+        results.append(entry)
+  for exe in built.values():
+    if exe and os.path.isfile(exe): os.remove(exe)
+
+  report = {
+    'slepc_dir': opts.slepc_dir,
+    'petsc_arch': opts.petsc_arch,
+    'version': subprocess.run([os.path.join(opts.slepc_dir,'lib','slepc','bin','slepcversion')],stdout=subprocess.PIPE,universal_newlines=True).stdout.strip(),
+    'host': platform.node(),
+    'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+    'sizes': opts.sizes,
+    'results': results
+  }
+  with open(opts.output,'w') as f:
+    json.dump(report,f,indent=2)
+  print('Results written to %s' % opts.output)
+  if failed: sys.exit('%d benchmark runs failed' % failed)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,84 @@
+# ------------------------------------------------------------------------
+#   Matrix-free eigenproblem with a Python operator that is applied to
+#   whole blocks of vectors in each call
+# ------------------------------------------------------------------------
+
+import sys, slepc4py
+slepc4py.init(sys.argv)
+
+from petsc4py import PETSc
+from slepc4py import SLEPc
+
+# this a sequential example
+assert PETSc.COMM_WORLD.getSize() == 1
+
+Print = PETSc.Sys.Print
+
+def laplace1d(x, y):
+    # x and y are 2-D arrays with one vector in each column
+    y[:] = 2*x
+    y[1:]  -= x[:-1]
+    y[:-1] -= x[1:]
+
+class Laplacian1D(object):
+    """
+    Shell matrix that implements both the product by one vector, mult(),
+    and the product by a dense matrix, productNumeric(). The latter is
+    used by SLEPc for the solvers that apply the operator to several
+    vectors at once (e.g., subspace, lobpcg, or krylovschur with a block
+    size larger than one), so that Python is called once per block.
+    """
+
+    def __init__(self):
+        self.nmult = 0
+        self.nblock = 0
+        self.ncols = 0
+
+    def mult(self, A, x, y):
+        self.nmult += 1
+        xx = x.getArray(readonly=1).reshape(-1,1)
+        yy = y.getArray(readonly=0).reshape(-1,1)
+        laplace1d(xx, yy)
+
+    def productSetFromOptions(self, A, producttype, X, Y, Z):
+        return producttype == 'AB'
+
+    def productSymbolic(self, A, product, producttype, X, Y, Z):
+        pass
+
+    def productNumeric(self, A, product, producttype, X, Y, Z):
+        xx = Y.getDenseArray(readonly=True)
+        yy = product.getDenseArray()
+        self.nblock += 1
+        self.ncols += xx.shape[1]
+        laplace1d(xx, yy)
+
+def main():
+    opts = PETSc.Options()
+    n = opts.getInt('n', 200)
+    Print("1-D Laplacian Eigenproblem (matrix-free, block products), n=%d" % n)
+
+    context = Laplacian1D()
+    A = PETSc.Mat().createPython([n,n], context)
+    A.setUp()
+
+    E = SLEPc.EPS().create()
+    E.setOperators(A)
+    E.setProblemType(SLEPc.EPS.ProblemType.HEP)
+    E.setType(SLEPc.EPS.Type.SUBSPACE)
+    E.setDimensions(4)
+    E.setTolerances(1e-6)
+    # apply the operator as a product by a dense matrix (the default)
+    E.getBV().setMatMultMethod(SLEPc.BV.MatMultType.MAT)
+    E.setFromOptions()
+    E.solve()
+
+    nconv = E.getConverged()
+    Print("Number of converged eigenpairs: %d" % nconv)
+    for i in range(min(nconv,4)):
+        Print("  %12f" % E.getEigenvalue(i).real)
+    Print("Calls to Python: %d with single vectors, %d with blocks of %.1f vectors on average"
+          % (context.nmult, context.nblock, context.ncols/max(context.nblock,1)))
+
+if __name__ == '__main__':
+    main()
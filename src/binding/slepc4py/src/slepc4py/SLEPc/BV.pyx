@@ -9,16 +9,25 @@ class BVType(object):
     VECS       = S_(BVVECS)
     CONTIGUOUS = S_(BVCONTIGUOUS)
     TENSOR     = S_(BVTENSOR)
+    MIXED      = S_(BVMIXED)
+    MMAP       = S_(BVMMAP)
+    PANEL      = S_(BVPANEL)
 
 class BVOrthogType(object):
     """
     BV orthogonalization types
 
-    - `CGS`: Classical Gram-Schmidt.
-    - `MGS`: Modified Gram-Schmidt.
+    - `CGS`:           Classical Gram-Schmidt.
+    - `MGS`:           Modified Gram-Schmidt.
+    - `CGS_PIPELINED`: Pipelined Classical Gram-Schmidt.
+    - `RGS`:           Randomized Gram-Schmidt.
+    - `DCGS2`:         Delayed Classical Gram-Schmidt with reorthogonalization.
     """
-    CGS = BV_ORTHOG_CGS
-    MGS = BV_ORTHOG_MGS
+    CGS           = BV_ORTHOG_CGS
+    MGS           = BV_ORTHOG_MGS
+    CGS_PIPELINED = BV_ORTHOG_CGS_PIPELINED
+    RGS           = BV_ORTHOG_RGS
+    DCGS2         = BV_ORTHOG_DCGS2
 
 class BVOrthogRefineType(object):
     """
@@ -41,12 +50,16 @@ class BVOrthogBlockType(object):
     - `TSQR`:     Tall-skinny QR.
     - `TSQRCHOL`: Tall-skinny QR with Cholesky.
     - `SVQB`:     SVQB.
+    - `CHOLQR2`:  Cholesky QR applied twice.
+    - `SCHOLQR3`: Shifted Cholesky QR followed by CholQR2.
     """
     GS       = BV_ORTHOG_BLOCK_GS
     CHOL     = BV_ORTHOG_BLOCK_CHOL
     TSQR     = BV_ORTHOG_BLOCK_TSQR
     TSQRCHOL = BV_ORTHOG_BLOCK_TSQRCHOL
     SVQB     = BV_ORTHOG_BLOCK_SVQB
+    CHOLQR2  = BV_ORTHOG_BLOCK_CHOLQR2
+    SCHOLQR3 = BV_ORTHOG_BLOCK_SCHOLQR3
 
 class BVMatMultType(object):
     """
@@ -65,10 +78,12 @@ class BVSVDMethod(object):
     - `REFINE`: Based on the SVD of the cross product matrix S'*S, with refinement.
     - `QR`:     Based on the SVD of the triangular factor of qr(S).
     - `QR_CAA`: Variant of QR intended for use in cammunication-avoiding Arnoldi.
+    - `RANDOM`: Based on a randomized range finder, cheaper if the rank is small.
     """
     REFINE   = BV_SVD_METHOD_REFINE
     QR       = BV_SVD_METHOD_QR
     QR_CAA   = BV_SVD_METHOD_QR_CAA
+    RANDOM   = BV_SVD_METHOD_RANDOM
 
 # -----------------------------------------------------------------------------
 
@@ -884,6 +899,70 @@ cdef class BV(Object):
         CHKERR( PetscObjectDereference(<PetscObject>A.mat) )
         CHKERR( BVRestoreMat(self.bv, &A.mat) )
 
+    def getArray(self, readonly=False):
+        """
+        Returns a NumPy array that views the local part of the basis vectors,
+        without copying them.
+
+        Parameters
+        ----------
+        readonly: bool, optional
+           Whether the array will only be read.
+
+        Returns
+        -------
+        a: numpy.ndarray
+           A two-dimensional array in Fortran order, with one column for
+           each of the basis vectors (including the constraints, if any)
+           and the local size as number of rows.
+
+        Notes
+        -----
+        The array shares the memory of the BV, so that modifying it changes
+        the BV as well; the leading dimension of the BV is used as the
+        column stride. The user must call `restoreArray()` when no longer
+        needed, and the array must not be used after that. For BV types
+        that do not store the data contiguously, such as `BV.Type.VECS`,
+        and for BV objects with the data on the GPU, a copy in host memory
+        is made; use `getMat()` or `getColumn()` to access the device
+        memory through petsc4py.
+        """
+        cdef PetscInt n = 0, N = 0, m = 0, nc = 0, ld = 0
+        cdef PetscScalar *data = NULL
+        cdef const PetscScalar *rdata = NULL
+        cdef bint ro = asBool(readonly)
+        CHKERR( BVGetSizes(self.bv, &n, &N, &m) )
+        CHKERR( BVGetNumConstraints(self.bv, &nc) )
+        CHKERR( BVGetLeadingDimension(self.bv, &ld) )
+        if ro:
+            CHKERR( BVGetArrayRead(self.bv, &rdata) )
+            data = <PetscScalar*> rdata
+        else:
+            CHKERR( BVGetArray(self.bv, &data) )
+        return array_view_s(n, nc+m, ld, data, ro)
+
+    def restoreArray(self, a):
+        """
+        Restores the array obtained with `getArray()`.
+
+        Parameters
+        ----------
+        a: numpy.ndarray
+           The array obtained with `getArray()`.
+
+        Notes
+        -----
+        If the array was obtained for writing, the state of the BV object
+        is increased, since its contents may have changed.
+        """
+        cdef ndarray ary = a
+        cdef PetscScalar *data = <PetscScalar*> PyArray_DATA(ary)
+        cdef const PetscScalar *rdata = data
+        if a.flags.writeable:
+            CHKERR( BVRestoreArray(self.bv, &data) )
+        else:
+            CHKERR( BVRestoreArrayRead(self.bv, &rdata) )
+
     def dot(self, BV Y):
         """
         Computes the 'block-dot' product of two basis vectors objects.
@@ -975,6 +1054,11 @@ cdef class BV(Object):
             -bv_matmult_mat
 
         The default is bv_matmult_mat.
+
+        With bv_matmult_mat, a Python matrix (see `petsc4py.PETSc.Mat.createPython`)
+        whose context implements ``productSetFromOptions()``, ``productSymbolic()``
+        and ``productNumeric()`` for the 'AB' product is called once for all
+        the columns, instead of once per column with ``mult()``.
         """
         cdef MPI_Comm comm = PetscObjectComm(<PetscObject>self.bv)
         cdef SlepcBVType bv_type = NULL
@@ -557,6 +557,51 @@ cdef class DS(Object):
         CHKERR( PetscObjectDereference(<PetscObject>mat.mat) )
         CHKERR( DSRestoreMat(self.ds, mname, &mat.mat) )
 
+    def getArray(self, matname):
+        """
+        Returns a NumPy array that views the requested matrix, without
+        copying it.
+
+        Parameters
+        ----------
+        matname: `DS.MatType` enumerate
+           The requested matrix.
+
+        Returns
+        -------
+        a: numpy.ndarray
+           A square array in Fortran order, whose size is the leading
+           dimension of the DS.
+
+        Notes
+        -----
+        Modifying the array changes the DS matrix as well. The user must
+        call `restoreArray()` when no longer needed, and the array must not
+        be used after that.
+        """
+        cdef SlepcDSMatType mname = matname
+        cdef PetscInt ld = 0
+        cdef PetscScalar *data = NULL
+        CHKERR( DSGetLeadingDimension(self.ds, &ld) )
+        CHKERR( DSGetArray(self.ds, mname, &data) )
+        return array_view_s(ld, ld, ld, data, False)
+
+    def restoreArray(self, matname, a):
+        """
+        Restores the array obtained with `getArray()`.
+
+        Parameters
+        ----------
+        matname: `DS.MatType` enumerate
+           The selected matrix.
+        a: numpy.ndarray
+           The array obtained with `getArray()`.
+        """
+        cdef SlepcDSMatType mname = matname
+        cdef ndarray ary = a
+        cdef PetscScalar *data = <PetscScalar*> PyArray_DATA(ary)
+        CHKERR( DSRestoreArray(self.ds, mname, &data) )
+
     def setIdentity(self, matname):
         """
         Copy the identity on the active part of a matrix.
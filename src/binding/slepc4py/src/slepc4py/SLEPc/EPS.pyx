@@ -1290,8 +1290,70 @@ cdef class EPS(Object):
     def solve(self):
         """
         Solves the eigensystem.
+
+        Notes
+        -----
+        The Python global interpreter lock is released during the solve,
+        and it is only taken again for calling Python callbacks, if any.
+        Hence other Python threads can run meanwhile, see `solveAsync()`.
+        """
+        cdef SlepcEPS eps = self.eps
+        cdef PetscErrorCode ierr = PETSC_SUCCESS
+        with nogil:
+            ierr = EPSSolve(eps)
+        CHKERR( ierr )
+
+    def solveAsync(self):
+        """
+        Solves the eigensystem in a background thread.
+
+        Returns
+        -------
+        future: concurrent.futures.Future
+            The future of the call to `solve()`; its ``result()`` waits
+            for the solve to finish and raises any error that occurred.
+
+        Notes
+        -----
+        The progress of the solve can be queried from other threads with
+        `getProgress()`. The EPS object, and the PETSc objects used by
+        it, must not be accessed until the solve is finished. In parallel
+        runs, all processes must call `solveAsync()`, and MPI must have
+        been initialized with support for calls from threads (at least
+        MPI_THREAD_SERIALIZED, as done by mpi4py by default).
+        """
+        import concurrent.futures
+        self.set_attr('__progress__', (0, 0, []))
+        if self.get_attr('__monitor__') is None:
+            self.set_attr('__monitor__', [])
+            CHKERR( EPSMonitorSet(self.eps, EPS_Monitor, NULL, NULL) )
+        executor = concurrent.futures.ThreadPoolExecutor(max_workers=1)
+        future = executor.submit(self.solve)
+        executor.shutdown(wait=False)
+        return future
+
+    def getProgress(self):
+        """
+        Gets the progress of a solve started with `solveAsync()`, as
+        given to the monitors in the last iteration.
+
+        Returns
+        -------
+        its: int
+            Iteration number.
+        nconv: int
+            Number of converged eigenpairs.
+        errest: list of real
+            Error estimates of the current approximations.
+
+        Notes
+        -----
+        This function can be called from any Python thread while the
+        solve is running, it does not call SLEPc.
         """
-        CHKERR( EPSSolve(self.eps) )
+        cdef object progress = self.get_attr('__progress__')
+        if progress is None: return (0, 0, [])
+        return progress
 
     def getIterationNumber(self):
         """
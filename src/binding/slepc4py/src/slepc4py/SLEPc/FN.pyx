@@ -32,9 +32,11 @@ class FNParallelType(object):
 
     - `REDUNDANT`:    Every process performs the computation redundantly.
     - `SYNCHRONIZED`: The first process sends the result to the rest.
+    - `DISTRIBUTED`:  The computation is distributed among processes with ScaLAPACK.
     """
     REDUNDANT    = FN_PARALLEL_REDUNDANT
     SYNCHRONIZED = FN_PARALLEL_SYNCHRONIZED
+    DISTRIBUTED  = FN_PARALLEL_DISTRIBUTED
 
 # -----------------------------------------------------------------------------
 
@@ -8,9 +8,11 @@ class MFNType(object):
 
     - `KRYLOV`:  Restarted Krylov solver.
     - `EXPOKIT`: Implementation of the method in Expokit.
+    - `RATKRYLOV`: Rational Krylov solver with cyclic poles.
     """
-    KRYLOV   = S_(MFNKRYLOV)
-    EXPOKIT  = S_(MFNEXPOKIT)
+    KRYLOV    = S_(MFNKRYLOV)
+    EXPOKIT   = S_(MFNEXPOKIT)
+    RATKRYLOV = S_(MFNRATKRYLOV)
 
 class MFNConvergedReason(object):
     CONVERGED_TOL       = MFN_CONVERGED_TOL
@@ -738,8 +738,17 @@ cdef class NEP(Object):
     def solve(self):
         """
         Solves the eigensystem.
-        """
-        CHKERR( NEPSolve(self.nep) )
+
+        Notes
+        -----
+        The Python global interpreter lock is released during the solve,
+        and it is only taken again for calling Python callbacks, if any.
+        """
+        cdef SlepcNEP nep = self.nep
+        cdef PetscErrorCode ierr = PETSC_SUCCESS
+        with nogil:
+            ierr = NEPSolve(nep)
+        CHKERR( ierr )
 
     def getIterationNumber(self):
         """
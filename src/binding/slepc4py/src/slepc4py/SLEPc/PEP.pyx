@@ -1036,8 +1036,17 @@ cdef class PEP(Object):
     def solve(self):
         """
         Solves the eigensystem.
-        """
-        CHKERR( PEPSolve(self.pep) )
+
+        Notes
+        -----
+        The Python global interpreter lock is released during the solve,
+        and it is only taken again for calling Python callbacks, if any.
+        """
+        cdef SlepcPEP pep = self.pep
+        cdef PetscErrorCode ierr = PETSC_SUCCESS
+        with nogil:
+            ierr = PEPSolve(pep)
+        CHKERR( ierr )
 
     def getIterationNumber(self):
         """
@@ -789,8 +789,17 @@ cdef class SVD(Object):
     def solve(self):
         """
         Solves the singular value problem.
-        """
-        CHKERR( SVDSolve(self.svd) )
+
+        Notes
+        -----
+        The Python global interpreter lock is released during the solve,
+        and it is only taken again for calling Python callbacks, if any.
+        """
+        cdef SlepcSVD svd = self.svd
+        cdef PetscErrorCode ierr = PETSC_SUCCESS
+        with nogil:
+            ierr = SVDSolve(svd)
+        CHKERR( ierr )
 
     def getIterationNumber(self):
         """
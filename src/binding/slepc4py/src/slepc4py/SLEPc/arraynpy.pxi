@@ -126,6 +126,23 @@ cdef inline ndarray array_s(PetscInt size, const PetscScalar* data):
 
 # --------------------------------------------------------------------
 
+cdef inline ndarray array_view_s(PetscInt m, PetscInt n, PetscInt ld,
+                                 PetscScalar* data, bint readonly):
+    # m x n view in Fortran order, with leading dimension ld, of a
+    # PETSc-owned array; no data are copied
+    cdef npy_intp dims[2]
+    cdef npy_intp strides[2]
+    cdef int flags = NPY_ARRAY_ALIGNED|NPY_ARRAY_NOTSWAPPED
+    if not readonly: flags |= NPY_ARRAY_WRITEABLE
+    dims[0] = <npy_intp> m
+    dims[1] = <npy_intp> n
+    strides[0] = <npy_intp> sizeof(PetscScalar)
+    strides[1] = <npy_intp> (ld*sizeof(PetscScalar))
+    return PyArray_New(<PyTypeObject*>ndarray, 2, dims, NPY_PETSC_SCALAR,
+                       strides, data, 0, flags, NULL)
+
+# --------------------------------------------------------------------
+
 cdef inline ndarray iarray(object ob, int typenum):
     cdef ndarray ary = PyArray_FROM_OTF(
         ob, typenum, NPY_ARRAY_ALIGNED|NPY_ARRAY_NOTSWAPPED)
@@ -6,10 +6,16 @@ cdef extern from * nogil:
     SlepcBVType BVVECS
     SlepcBVType BVCONTIGUOUS
     SlepcBVType BVTENSOR
+    SlepcBVType BVMIXED
+    SlepcBVType BVMMAP
+    SlepcBVType BVPANEL
 
     ctypedef enum SlepcBVOrthogType "BVOrthogType":
         BV_ORTHOG_CGS
         BV_ORTHOG_MGS
+        BV_ORTHOG_CGS_PIPELINED
+        BV_ORTHOG_RGS
+        BV_ORTHOG_DCGS2
 
     ctypedef enum SlepcBVOrthogRefineType "BVOrthogRefineType":
         BV_ORTHOG_REFINE_IFNEEDED
@@ -22,6 +28,8 @@ cdef extern from * nogil:
         BV_ORTHOG_BLOCK_TSQR
         BV_ORTHOG_BLOCK_TSQRCHOL
         BV_ORTHOG_BLOCK_SVQB
+        BV_ORTHOG_BLOCK_CHOLQR2
+        BV_ORTHOG_BLOCK_SCHOLQR3
 
     ctypedef enum SlepcBVMatMultType "BVMatMultType":
         BV_MATMULT_VECS
@@ -31,6 +39,7 @@ cdef extern from * nogil:
         BV_SVD_METHOD_REFINE
         BV_SVD_METHOD_QR
         BV_SVD_METHOD_QR_CAA
+        BV_SVD_METHOD_RANDOM
 
     PetscErrorCode BVCreate(MPI_Comm,SlepcBV*)
     PetscErrorCode BVCreateMat(SlepcBV,PetscMat*)
@@ -118,6 +127,10 @@ cdef extern from * nogil:
     PetscErrorCode BVCreateFromMat(PetscMat,SlepcBV*)
     PetscErrorCode BVGetMat(SlepcBV,PetscMat*)
     PetscErrorCode BVRestoreMat(SlepcBV,PetscMat*)
+    PetscErrorCode BVGetArray(SlepcBV,PetscScalar**)
+    PetscErrorCode BVRestoreArray(SlepcBV,PetscScalar**)
+    PetscErrorCode BVGetArrayRead(SlepcBV,const PetscScalar**)
+    PetscErrorCode BVRestoreArrayRead(SlepcBV,const PetscScalar**)
 
 cdef inline PetscErrorCode BV_Sizes(
     object size,
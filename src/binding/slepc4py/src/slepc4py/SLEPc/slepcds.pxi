@@ -73,6 +73,8 @@ cdef extern from * nogil:
     PetscErrorCode DSGetRefined(SlepcDS,PetscBool*)
     PetscErrorCode DSGetMat(SlepcDS,SlepcDSMatType,PetscMat*)
     PetscErrorCode DSRestoreMat(SlepcDS,SlepcDSMatType,PetscMat*)
+    PetscErrorCode DSGetArray(SlepcDS,SlepcDSMatType,PetscScalar**)
+    PetscErrorCode DSRestoreArray(SlepcDS,SlepcDSMatType,PetscScalar**)
     PetscErrorCode DSSetIdentity(SlepcDS,SlepcDSMatType)
     PetscErrorCode DSVectors(SlepcDS,SlepcDSMatType,PetscInt*,PetscReal*)
     PetscErrorCode DSSolve(SlepcDS,PetscScalar*,PetscScalar*)
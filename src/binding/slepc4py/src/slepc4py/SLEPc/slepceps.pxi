@@ -394,6 +394,8 @@ cdef PetscErrorCode EPS_Monitor(
     if monitorlist is None: return PETSC_SUCCESS
     cdef object eig = [toComplex(eigr[i], eigi[i]) for i in range(nest)]
     cdef object err = [toReal(errest[i]) for i in range(nest)]
+    if Eps.get_attr('__progress__') is not None:
+        Eps.set_attr('__progress__', (toInt(its), toInt(nconv), err))
     for (monitor, args, kargs) in monitorlist:
         monitor(Eps, toInt(its), toInt(nconv), eig, err, *args, **kargs)
     return PETSC_SUCCESS
@@ -18,6 +18,7 @@ cdef extern from * nogil:
     ctypedef enum SlepcFNParallelType "FNParallelType":
         FN_PARALLEL_REDUNDANT
         FN_PARALLEL_SYNCHRONIZED
+        FN_PARALLEL_DISTRIBUTED
 
     PetscErrorCode FNCreate(MPI_Comm,SlepcFN*)
     PetscErrorCode FNView(SlepcFN,PetscViewer)
@@ -3,6 +3,7 @@ cdef extern from * nogil:
     ctypedef char* SlepcMFNType "const char*"
     SlepcMFNType MFNKRYLOV
     SlepcMFNType MFNEXPOKIT
+    SlepcMFNType MFNRATKRYLOV
 
     ctypedef enum SlepcMFNConvergedReason "MFNConvergedReason":
         MFN_CONVERGED_TOL
@@ -35,6 +35,7 @@ typedef struct {
   PetscBool lock;      /* soft locking active/inactive */
   PetscReal restart;   /* restart parameter */
   PetscInt  guard;     /* number of guard vectors */
+  PetscBool lowmem;    /* compute the Gram matrices by blocks of columns */
 } EPS_LOBPCG;
 
 static PetscErrorCode EPSSetDimensions_LOBPCG(EPS eps,PetscInt nev,PetscInt *ncv,PetscInt *mpd)
@@ -82,6 +83,40 @@ static PetscErrorCode EPSSetUp_LOBPCG(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes M = Z'*A*Z, with Z having nv active columns, by blocks of bs columns.
+   The products A*Z(:,j:j+bs) are stored in W, which must have bs columns, so that
+   no temporary basis of the size of Z is needed as in BVMatProject()
+*/
+static PetscErrorCode EPSLOBPCGProjectByBlocks(BV Z,Mat A,BV W,PetscInt nv,PetscInt bs,Mat M)
+{
+  PetscInt          i,j,c,lw,kw,ldm;
+  PetscScalar       *marray;
+  const PetscScalar *harray;
+  Mat               H;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetActiveColumns(W,&lw,&kw));
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,nv,bs,NULL,&H));
+  for (j=0;j<nv;j+=bs) {
+    c = PetscMin(bs,nv-j);
+    PetscCall(BVSetActiveColumns(Z,j,j+c));
+    PetscCall(BVSetActiveColumns(W,0,c));
+    PetscCall(BVMatMult(Z,A,W));
+    PetscCall(BVSetActiveColumns(Z,0,nv));
+    PetscCall(BVMatProject(W,NULL,Z,H));
+    PetscCall(MatDenseGetArrayRead(H,&harray));
+    PetscCall(MatDenseGetArray(M,&marray));
+    for (i=0;i<c;i++) PetscCall(PetscArraycpy(marray+(j+i)*ldm,harray+i*nv,nv));
+    PetscCall(MatDenseRestoreArray(M,&marray));
+    PetscCall(MatDenseRestoreArrayRead(H,&harray));
+  }
+  PetscCall(MatDestroy(&H));
+  PetscCall(BVSetActiveColumns(W,lw,kw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSolve_LOBPCG(EPS eps)
 {
   EPS_LOBPCG     *ctx = (EPS_LOBPCG*)eps->data;
@@ -349,11 +384,13 @@ static PetscErrorCode EPSSolve_LOBPCG(EPS eps)
     PetscCall(BVSetActiveColumns(Z,0,nv));
     PetscCall(DSSetDimensions(eps->ds,nv,0,0));
     PetscCall(DSGetMat(eps->ds,DS_MAT_A,&M));
-    PetscCall(BVMatProject(Z,A,Z,M));
+    if (ctx->lowmem) PetscCall(EPSLOBPCGProjectByBlocks(Z,A,AX,nv,ctx->bs,M)); /* AX is recomputed below */
+    else PetscCall(BVMatProject(Z,A,Z,M));
     if (flip) PetscCall(MatScale(M,-1.0));
     PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&M));
     PetscCall(DSGetMat(eps->ds,DS_MAT_B,&M));
-    PetscCall(BVMatProject(Z,B,Z,M)); /* covers also the case B=NULL */
+    if (ctx->lowmem && B) PetscCall(EPSLOBPCGProjectByBlocks(Z,B,AX,nv,ctx->bs,M));
+    else PetscCall(BVMatProject(Z,B,Z,M)); /* covers also the case B=NULL */
     PetscCall(DSRestoreMat(eps->ds,DS_MAT_B,&M));
 
     /* 24. Solve the generalized eigenvalue problem */
@@ -618,6 +655,87 @@ PetscErrorCode EPSLOBPCGGetLocking(EPS eps,PetscBool *lock)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSLOBPCGSetLowMemory_LOBPCG(EPS eps,PetscBool lowmem)
+{
+  EPS_LOBPCG *ctx = (EPS_LOBPCG*)eps->data;
+
+  PetscFunctionBegin;
+  ctx->lowmem = lowmem;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSLOBPCGSetLowMemory - Activates a variant of the LOBPCG method that
+   requires less memory.
+
+   Logically Collective
+
+   Input Parameters:
++  eps    - the eigenproblem solver context
+-  lowmem - true if the low-memory variant must be selected
+
+   Options Database Key:
+.  -eps_lobpcg_low_memory - Sets the low-memory flag
+
+   Notes:
+   The Gram matrices of the Rayleigh-Ritz step involve the products of A (and B)
+   with the basis [X R P], which has 3*bs columns for block size bs. By default,
+   these products are computed at once, with temporary storage for 3*bs vectors.
+   In the low-memory variant, they are computed in blocks of bs columns reusing
+   the workspace of A*X, so that the temporary storage is avoided at the cost
+   of smaller matrix-matrix products. The number of matrix-vector products is
+   the same in both variants.
+
+   This may be relevant when the block size is large. Note that soft locking
+   (see EPSLOBPCGSetLocking()) also reduces the cost, since converged vectors
+   are excluded from the residual, preconditioner and conjugate direction blocks.
+
+   Level: advanced
+
+.seealso: EPSLOBPCGGetLowMemory(), EPSLOBPCGSetLocking()
+@*/
+PetscErrorCode EPSLOBPCGSetLowMemory(EPS eps,PetscBool lowmem)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,lowmem,2);
+  PetscTryMethod(eps,"EPSLOBPCGSetLowMemory_C",(EPS,PetscBool),(eps,lowmem));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSLOBPCGGetLowMemory_LOBPCG(EPS eps,PetscBool *lowmem)
+{
+  EPS_LOBPCG *ctx = (EPS_LOBPCG*)eps->data;
+
+  PetscFunctionBegin;
+  *lowmem = ctx->lowmem;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSLOBPCGGetLowMemory - Gets the low-memory flag used in the LOBPCG method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  lowmem - the low-memory flag
+
+   Level: advanced
+
+.seealso: EPSLOBPCGSetLowMemory()
+@*/
+PetscErrorCode EPSLOBPCGGetLowMemory(EPS eps,PetscBool *lowmem)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(lowmem,2);
+  PetscUseMethod(eps,"EPSLOBPCGGetLowMemory_C",(EPS,PetscBool*),(eps,lowmem));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSView_LOBPCG(EPS eps,PetscViewer viewer)
 {
   EPS_LOBPCG     *ctx = (EPS_LOBPCG*)eps->data;
@@ -629,13 +747,14 @@ static PetscErrorCode EPSView_LOBPCG(EPS eps,PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer,"  block size %" PetscInt_FMT "\n",ctx->bs));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  restart parameter=%g (using %" PetscInt_FMT " guard vectors)\n",(double)ctx->restart,ctx->guard));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  soft locking %sactivated\n",ctx->lock?"":"de"));
+    if (ctx->lowmem) PetscCall(PetscViewerASCIIPrintf(viewer,"  using the low-memory variant\n"));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode EPSSetFromOptions_LOBPCG(EPS eps,PetscOptionItems *PetscOptionsObject)
 {
-  PetscBool      lock,flg;
+  PetscBool      lock,lowmem,flg;
   PetscInt       bs;
   PetscReal      restart;
 
@@ -651,6 +770,9 @@ static PetscErrorCode EPSSetFromOptions_LOBPCG(EPS eps,PetscOptionItems *PetscOp
     PetscCall(PetscOptionsBool("-eps_lobpcg_locking","Choose between locking and non-locking variants","EPSLOBPCGSetLocking",PETSC_TRUE,&lock,&flg));
     if (flg) PetscCall(EPSLOBPCGSetLocking(eps,lock));
 
+    PetscCall(PetscOptionsBool("-eps_lobpcg_low_memory","Compute the Gram matrices by blocks to save memory","EPSLOBPCGSetLowMemory",PETSC_FALSE,&lowmem,&flg));
+    if (flg) PetscCall(EPSLOBPCGSetLowMemory(eps,lowmem));
+
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -665,6 +787,8 @@ static PetscErrorCode EPSDestroy_LOBPCG(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetRestart_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGSetLocking_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetLocking_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGSetLowMemory_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetLowMemory_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -695,5 +819,7 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_LOBPCG(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetRestart_C",EPSLOBPCGGetRestart_LOBPCG));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGSetLocking_C",EPSLOBPCGSetLocking_LOBPCG));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetLocking_C",EPSLOBPCGGetLocking_LOBPCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGSetLowMemory_C",EPSLOBPCGSetLowMemory_LOBPCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSLOBPCGGetLowMemory_C",EPSLOBPCGGetLowMemory_LOBPCG));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
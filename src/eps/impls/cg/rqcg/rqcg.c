@@ -15,7 +15,10 @@
    Algorithm:
 
        Conjugate Gradient minimization of the Rayleigh quotient with
-       periodic Rayleigh-Ritz acceleration.
+       periodic Rayleigh-Ritz acceleration. The active vectors are
+       iterated as a block, so that the preconditioner is applied to all
+       gradients at once and the inner products are grouped in a few
+       global reductions per iteration.
 
    References:
 
@@ -31,12 +34,11 @@ static PetscErrorCode EPSSolve_RQCG(EPS);
 typedef struct {
   PetscInt nrest;         /* user-provided reset parameter */
   PetscInt allocsize;     /* number of columns of work BV's allocated at setup */
-  BV       AV,W,P,G;
+  BV       AV,P,G,Z;
 } EPS_RQCG;
 
 static PetscErrorCode EPSSetUp_RQCG(EPS eps)
 {
-  PetscInt       nmat;
   EPS_RQCG       *ctx = (EPS_RQCG*)eps->data;
 
   PetscFunctionBegin;
@@ -54,35 +56,39 @@ static PetscErrorCode EPSSetUp_RQCG(EPS eps)
   PetscCall(EPSAllocateSolution(eps,0));
   PetscCall(EPS_SetInnerProduct(eps));
 
-  PetscCall(STGetNumMatrices(eps->st,&nmat));
   if (!ctx->allocsize) {
     ctx->allocsize = eps->mpd;
-    PetscCall(BVDuplicateResize(eps->V,eps->mpd,&ctx->AV));
-    if (nmat>1) PetscCall(BVDuplicate(ctx->AV,&ctx->W));
-    PetscCall(BVDuplicate(ctx->AV,&ctx->P));
-    PetscCall(BVDuplicate(ctx->AV,&ctx->G));
+    PetscCall(BVDuplicateResize(eps->V,eps->mpd,&ctx->P));
+    PetscCall(BVDuplicateResize(eps->V,4*eps->mpd,&ctx->AV));
+    PetscCall(BVSetMatrix(ctx->AV,NULL,PETSC_FALSE));  /* the work BV's use the standard inner product */
+    PetscCall(BVDuplicateResize(ctx->AV,2*eps->mpd,&ctx->Z));
+    PetscCall(BVDuplicateResize(ctx->AV,eps->mpd,&ctx->G));
   } else if (ctx->allocsize!=eps->mpd) {
     ctx->allocsize = eps->mpd;
-    PetscCall(BVResize(ctx->AV,eps->mpd,PETSC_FALSE));
-    if (nmat>1) PetscCall(BVResize(ctx->W,eps->mpd,PETSC_FALSE));
     PetscCall(BVResize(ctx->P,eps->mpd,PETSC_FALSE));
+    PetscCall(BVResize(ctx->AV,4*eps->mpd,PETSC_FALSE));
+    PetscCall(BVResize(ctx->Z,2*eps->mpd,PETSC_FALSE));
     PetscCall(BVResize(ctx->G,eps->mpd,PETSC_FALSE));
   }
   PetscCall(DSSetType(eps->ds,DSHEP));
   PetscCall(DSAllocate(eps->ds,eps->ncv));
-  PetscCall(EPSSetWorkVecs(eps,1));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   All the active vectors are processed as a block: with m=nv-nconv, the columns of AV
+   contain [A*X A*P B*X B*P], where X=V(:,nconv:nv), so that the coefficients of the
+   minimization problem of all vectors are obtained from a single BVDot with [X P]
+*/
 static PetscErrorCode EPSSolve_RQCG(EPS eps)
 {
   EPS_RQCG       *ctx = (EPS_RQCG*)eps->data;
-  PetscInt       i,j,k,ld,nv,ncv = eps->ncv,kini,nmat;
-  PetscScalar    *C,*gamma,g,pap,pbp,pbx,pax,nu,mu,alpha,beta;
-  PetscReal      resnorm,a,b,c,d,disc,t;
+  PetscInt       i,j,k,ld,nv,ncv = eps->ncv,kini,nmat,m,nc,pass,ldm;
+  PetscScalar    *C,*gamma,*pM,*pD,g,pap,pbp,pbx,pax,nu,mu,alpha,beta;
+  PetscReal      *resnorm,a,b,c,d,disc,t;
   PetscBool      reset;
-  Mat            A,B,Q,Q1;
-  Vec            v,av,bv,p,w=eps->work[0];
+  Mat            A,B,Q,Q1,M,D,Gm,Wm;
+  Vec            v,av;
 
   PetscFunctionBegin;
   PetscCall(DSGetLeadingDimension(eps->ds,&ld));
@@ -90,12 +96,17 @@ static PetscErrorCode EPSSolve_RQCG(EPS eps)
   PetscCall(STGetMatrix(eps->st,0,&A));
   if (nmat>1) PetscCall(STGetMatrix(eps->st,1,&B));
   else B = NULL;
-  PetscCall(PetscMalloc1(eps->mpd,&gamma));
+  PetscCall(BVGetNumConstraints(eps->V,&nc));
+  PetscCall(PetscMalloc2(eps->mpd,&gamma,eps->mpd,&resnorm));
+  ldm = PetscMax(ncv,4*eps->mpd);
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ldm,ldm,NULL,&M));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ldm,ldm,NULL,&D));
 
   kini = eps->nini;
   while (eps->reason == EPS_CONVERGED_ITERATING) {
     eps->its++;
     nv = PetscMin(eps->nconv+eps->mpd,ncv);
+    m  = nv-eps->nconv;
     PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,0));
     for (;kini<nv;kini++) { /* Generate more initial vectors if necessary */
       PetscCall(BVSetRandomColumn(eps->V,kini));
@@ -103,14 +114,13 @@ static PetscErrorCode EPSSolve_RQCG(EPS eps)
     }
     reset = (eps->its>1 && (eps->its-1)%ctx->nrest==0)? PETSC_TRUE: PETSC_FALSE;
 
+    /* Prevent BVDot below to use B-product, restored at the end */
+    PetscCall(BVSetMatrix(eps->V,NULL,PETSC_FALSE));
+    PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
+    PetscCall(BVSetActiveColumns(ctx->AV,0,m));
+    PetscCall(BVMatMult(eps->V,A,ctx->AV));
     if (reset) {
-      /* Prevent BVDotVec below to use B-product, restored at the end */
-      PetscCall(BVSetMatrix(eps->V,NULL,PETSC_FALSE));
-
       /* Compute Rayleigh quotient */
-      PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
-      PetscCall(BVSetActiveColumns(ctx->AV,0,nv-eps->nconv));
-      PetscCall(BVMatMult(eps->V,A,ctx->AV));
       PetscCall(DSGetArray(eps->ds,DS_MAT_A,&C));
       for (i=eps->nconv;i<nv;i++) {
         PetscCall(BVSetActiveColumns(eps->V,eps->nconv,i+1));
@@ -131,39 +141,37 @@ static PetscErrorCode EPSSolve_RQCG(EPS eps)
       PetscCall(DSGetMat(eps->ds,DS_MAT_Q,&Q));
       PetscCall(BVMultInPlace(eps->V,Q,eps->nconv,nv));
       PetscCall(MatDenseGetSubMatrix(Q,eps->nconv,PETSC_DECIDE,eps->nconv,PETSC_DECIDE,&Q1));
-      PetscCall(BVMultInPlace(ctx->AV,Q1,0,nv-eps->nconv));
+      PetscCall(BVMultInPlace(ctx->AV,Q1,0,m));
       PetscCall(MatDenseRestoreSubMatrix(Q,&Q1));
       PetscCall(DSRestoreMat(eps->ds,DS_MAT_Q,&Q));
-      if (B) PetscCall(BVSetMatrix(eps->V,B,PETSC_FALSE));
     } else {
       /* No need to do Rayleigh-Ritz, just take diag(V'*A*V) */
-      for (i=eps->nconv;i<nv;i++) {
-        PetscCall(BVGetColumn(eps->V,i,&v));
-        PetscCall(BVGetColumn(ctx->AV,i-eps->nconv,&av));
-        PetscCall(MatMult(A,v,av));
-        PetscCall(VecDot(av,v,eps->eigr+i));
-        PetscCall(BVRestoreColumn(eps->V,i,&v));
-        PetscCall(BVRestoreColumn(ctx->AV,i-eps->nconv,&av));
-      }
+      PetscCall(BVDot(ctx->AV,eps->V,M));
+      PetscCall(MatDenseGetArray(M,&pM));
+      for (i=eps->nconv;i<nv;i++) eps->eigr[i] = pM[i+(i-eps->nconv)*ldm];
+      PetscCall(MatDenseRestoreArray(M,&pM));
     }
-
-    /* Compute gradient and check convergence */
+    PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
+    PetscCall(BVSetActiveColumns(ctx->AV,2*m,3*m));
+    if (B) PetscCall(BVMatMult(eps->V,B,ctx->AV));
+    else PetscCall(BVCopy(eps->V,ctx->AV));
+    if (B) PetscCall(BVSetMatrix(eps->V,B,PETSC_FALSE));
+
+    /* Compute gradient G = A*X-B*X*diag(eigr) and check convergence */
+    PetscCall(BVSetActiveColumns(ctx->AV,0,m));
+    PetscCall(BVSetActiveColumns(ctx->G,0,m));
+    PetscCall(BVCopy(ctx->AV,ctx->G));
+    PetscCall(MatZeroEntries(D));
+    PetscCall(MatDenseGetArray(D,&pD));
+    for (i=0;i<m;i++) pD[2*m+i+i*ldm] = -eps->eigr[eps->nconv+i];
+    PetscCall(MatDenseRestoreArray(D,&pD));
+    PetscCall(BVSetActiveColumns(ctx->AV,2*m,3*m));
+    PetscCall(BVMult(ctx->G,1.0,1.0,ctx->AV,D));
+    for (i=0;i<m;i++) PetscCall(BVNormColumnBegin(ctx->G,i,NORM_2,resnorm+i));
+    for (i=0;i<m;i++) PetscCall(BVNormColumnEnd(ctx->G,i,NORM_2,resnorm+i));
     k = -1;
     for (i=eps->nconv;i<nv;i++) {
-      PetscCall(BVGetColumn(eps->V,i,&v));
-      PetscCall(BVGetColumn(ctx->AV,i-eps->nconv,&av));
-      PetscCall(BVGetColumn(ctx->G,i-eps->nconv,&p));
-      if (B) {
-        PetscCall(BVGetColumn(ctx->W,i-eps->nconv,&bv));
-        PetscCall(MatMult(B,v,bv));
-        PetscCall(VecWAXPY(p,-eps->eigr[i],bv,av));
-        PetscCall(BVRestoreColumn(ctx->W,i-eps->nconv,&bv));
-      } else PetscCall(VecWAXPY(p,-eps->eigr[i],v,av));
-      PetscCall(BVRestoreColumn(eps->V,i,&v));
-      PetscCall(BVRestoreColumn(ctx->AV,i-eps->nconv,&av));
-      PetscCall(VecNorm(p,NORM_2,&resnorm));
-      PetscCall(BVRestoreColumn(ctx->G,i-eps->nconv,&p));
-      PetscCall((*eps->converged)(eps,eps->eigr[i],0.0,resnorm,&eps->errest[i],eps->convergedctx));
+      PetscCall((*eps->converged)(eps,eps->eigr[i],0.0,resnorm[i-eps->nconv],&eps->errest[i],eps->convergedctx));
       if (k==-1 && eps->errest[i] >= eps->tol) k = i;
     }
     if (k==-1) k = nv;
@@ -176,45 +184,75 @@ static PetscErrorCode EPSSolve_RQCG(EPS eps)
 
     if (eps->reason == EPS_CONVERGED_ITERATING) {
 
-      /* Search direction */
-      for (i=0;i<nv-eps->nconv;i++) {
-        PetscCall(BVGetColumn(ctx->G,i,&v));
-        PetscCall(STApply(eps->st,v,w));
-        PetscCall(VecDot(w,v,&g));
-        PetscCall(BVRestoreColumn(ctx->G,i,&v));
+      /* Search direction, apply the preconditioner to all gradients at once, W = K\G in Z */
+      PetscCall(BVSetActiveColumns(ctx->Z,0,m));
+      PetscCall(BVGetMat(ctx->G,&Gm));
+      PetscCall(BVGetMat(ctx->Z,&Wm));
+      PetscCall(STApplyMat(eps->st,Gm,Wm));
+      PetscCall(BVRestoreMat(ctx->Z,&Wm));
+      PetscCall(BVRestoreMat(ctx->G,&Gm));
+      PetscCall(BVDot(ctx->Z,ctx->G,M));
+      PetscCall(MatDenseGetArray(M,&pM));
+      PetscCall(MatZeroEntries(D));
+      PetscCall(MatDenseGetArray(D,&pD));
+      for (i=0;i<m;i++) {
+        g = pM[i+i*ldm];
         beta = (!reset && eps->its>1)? g/gamma[i]: 0.0;
         gamma[i] = g;
-        PetscCall(BVGetColumn(ctx->P,i,&v));
-        PetscCall(VecAXPBY(v,1.0,beta,w));
-        if (i+eps->nconv>0) {
-          PetscCall(BVSetActiveColumns(eps->V,0,i+eps->nconv));
-          PetscCall(BVOrthogonalizeVec(eps->V,v,NULL,NULL,NULL));
+        pD[i+i*ldm] = beta;
+      }
+      PetscCall(MatDenseRestoreArray(D,&pD));
+      PetscCall(MatDenseRestoreArray(M,&pM));
+      /* P = W + P*diag(beta) */
+      PetscCall(BVSetActiveColumns(ctx->P,0,m));
+      if (!reset && eps->its>1) PetscCall(BVMult(ctx->Z,1.0,1.0,ctx->P,D));
+      PetscCall(BVCopy(ctx->Z,ctx->P));
+      /* each P(:,i) is orthogonalized against V(:,0:nconv+i) */
+      if (!nc) {
+        for (pass=0;pass<2;pass++) {  /* classical Gram-Schmidt with reorthogonalization */
+          PetscCall(BVSetActiveColumns(eps->V,0,nv));
+          PetscCall(BVDot(ctx->P,eps->V,M));
+          PetscCall(MatDenseGetArray(M,&pM));
+          for (i=0;i<m;i++) for (j=eps->nconv+i;j<nv;j++) pM[j+i*ldm] = 0.0;
+          PetscCall(MatDenseRestoreArray(M,&pM));
+          PetscCall(BVMult(ctx->P,-1.0,1.0,eps->V,M));
+        }
+      } else {  /* the constraints are only handled by BVOrthogonalizeVec() */
+        for (i=0;i<m;i++) {
+          if (i+eps->nconv>0) {
+            PetscCall(BVSetActiveColumns(eps->V,0,i+eps->nconv));
+            PetscCall(BVGetColumn(ctx->P,i,&v));
+            PetscCall(BVOrthogonalizeVec(eps->V,v,NULL,NULL,NULL));
+            PetscCall(BVRestoreColumn(ctx->P,i,&v));
+          }
         }
-        PetscCall(BVRestoreColumn(ctx->P,i,&v));
       }
 
-      /* Minimization problem */
-      for (i=eps->nconv;i<nv;i++) {
-        PetscCall(BVGetColumn(eps->V,i,&v));
-        PetscCall(BVGetColumn(ctx->AV,i-eps->nconv,&av));
-        PetscCall(BVGetColumn(ctx->P,i-eps->nconv,&p));
-        PetscCall(VecDot(av,v,&nu));
-        PetscCall(VecDot(av,p,&pax));
-        PetscCall(MatMult(A,p,w));
-        PetscCall(VecDot(w,p,&pap));
-        if (B) {
-          PetscCall(BVGetColumn(ctx->W,i-eps->nconv,&bv));
-          PetscCall(VecDot(bv,v,&mu));
-          PetscCall(VecDot(bv,p,&pbx));
-          PetscCall(BVRestoreColumn(ctx->W,i-eps->nconv,&bv));
-          PetscCall(MatMult(B,p,w));
-          PetscCall(VecDot(w,p,&pbp));
-        } else {
-          PetscCall(VecDot(v,v,&mu));
-          PetscCall(VecDot(v,p,&pbx));
-          PetscCall(VecDot(p,p,&pbp));
-        }
-        PetscCall(BVRestoreColumn(ctx->AV,i-eps->nconv,&av));
+      /* Minimization problem, the coefficients are in the diagonals of [X P]'*[A*X A*P B*X B*P] */
+      PetscCall(BVSetActiveColumns(ctx->P,0,m));
+      PetscCall(BVSetActiveColumns(ctx->AV,m,2*m));
+      PetscCall(BVMatMult(ctx->P,A,ctx->AV));
+      PetscCall(BVSetActiveColumns(ctx->AV,3*m,4*m));
+      if (B) PetscCall(BVMatMult(ctx->P,B,ctx->AV));
+      else PetscCall(BVCopy(ctx->P,ctx->AV));
+      PetscCall(BVSetActiveColumns(ctx->Z,m,2*m));
+      PetscCall(BVCopy(ctx->P,ctx->Z));
+      PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
+      PetscCall(BVSetActiveColumns(ctx->Z,0,m));
+      PetscCall(BVCopy(eps->V,ctx->Z));
+      PetscCall(BVSetActiveColumns(ctx->Z,0,2*m));
+      PetscCall(BVSetActiveColumns(ctx->AV,0,4*m));
+      PetscCall(BVDot(ctx->AV,ctx->Z,M));
+      PetscCall(MatDenseGetArray(M,&pM));
+      PetscCall(MatZeroEntries(D));
+      PetscCall(MatDenseGetArray(D,&pD));
+      for (i=0;i<m;i++) {
+        nu  = pM[i+i*ldm];
+        pax = pM[m+i+i*ldm];
+        pap = pM[m+i+(m+i)*ldm];
+        mu  = pM[i+(2*m+i)*ldm];
+        pbx = pM[m+i+(2*m+i)*ldm];
+        pbp = pM[m+i+(3*m+i)*ldm];
         a = PetscRealPart(pap*pbx-pax*pbp);
         b = PetscRealPart(nu*pbp-mu*pap);
         c = PetscRealPart(mu*pax-nu*pbx);
@@ -225,19 +263,23 @@ static PetscErrorCode EPSSolve_RQCG(EPS eps)
         if (b>=0.0 && a!=0.0) alpha = (b+d)/(2.0*a);
         else if (b!=d) alpha = 2.0*c/(b-d);
         else alpha = 0;
-        /* Next iterate */
-        if (alpha!=0.0) PetscCall(VecAXPY(v,alpha,p));
-        PetscCall(BVRestoreColumn(eps->V,i,&v));
-        PetscCall(BVRestoreColumn(ctx->P,i-eps->nconv,&p));
-        PetscCall(BVOrthonormalizeColumn(eps->V,i,PETSC_TRUE,NULL,NULL));
+        pD[i+(eps->nconv+i)*ldm] = alpha;
       }
+      PetscCall(MatDenseRestoreArray(D,&pD));
+      PetscCall(MatDenseRestoreArray(M,&pM));
+
+      /* Next iterate X = X + P*diag(alpha) */
+      PetscCall(BVMult(eps->V,1.0,1.0,ctx->P,D));
+      for (i=eps->nconv;i<nv;i++) PetscCall(BVOrthonormalizeColumn(eps->V,i,PETSC_TRUE,NULL,NULL));
     }
 
     PetscCall(EPSMonitor(eps,eps->its,k,eps->eigr,eps->eigi,eps->errest,nv));
     eps->nconv = k;
   }
 
-  PetscCall(PetscFree(gamma));
+  PetscCall(PetscFree2(gamma,resnorm));
+  PetscCall(MatDestroy(&M));
+  PetscCall(MatDestroy(&D));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -321,9 +363,9 @@ static PetscErrorCode EPSReset_RQCG(EPS eps)
 
   PetscFunctionBegin;
   PetscCall(BVDestroy(&ctx->AV));
-  PetscCall(BVDestroy(&ctx->W));
   PetscCall(BVDestroy(&ctx->P));
   PetscCall(BVDestroy(&ctx->G));
+  PetscCall(BVDestroy(&ctx->Z));
   ctx->allocsize = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -46,9 +46,12 @@ typedef struct {
   PetscInt          npart;      /* number of partitions */
   PetscInt          refine_inner;
   PetscInt          refine_blocksize;
+  PetscInt          refine_quad; /* maximum number of refinements of the quadrature rule */
   EPSCISSQuadRule   quad;
   EPSCISSExtraction extraction;
   PetscBool         usest;
+  PetscBool         lowmem;     /* accumulate the moments without storing the solutions at all points */
+  PetscBool         randsvd;    /* use a randomized range finder for the SVD of the moments */
   /* private data */
   SlepcContourData  contour;
   PetscReal         *sigma;     /* threshold for numerical rank */
@@ -59,22 +62,39 @@ typedef struct {
   BV                S;
   BV                pV;
   BV                Y;
+  BV                pS;         /* moments in the subcommunicator (low-memory mode) */
+  PetscScalar       *Mu;        /* accumulated projected moments (low-memory mode) */
   PetscBool         useconj;
+  PetscBool         useherm;    /* conjugate points share the linear solver (Hermitian case) */
   PetscBool         usest_set;  /* whether the user set the usest flag or not */
   PetscObjectId     rgid;
   PetscObjectState  rgstate;
+  PetscObjectId     opid[2];    /* matrices used to build the linear solvers of the integration points */
+  PetscObjectState  opstate[2];
+  PetscObjectState  opnzstate[2];
+  PetscBool         kspvalid;   /* the linear solvers correspond to the current integration points */
+  /* split into subregions */
+  PetscInt          nsub;       /* number of subregions (1) */
+  PetscInt          nsubeps;    /* number of subregions assigned to the local partition */
+  EPS               *subeps;    /* solvers of the subregions assigned to the local partition */
 } EPS_CISS;
 
 /*
-  Set up KSP solvers for every integration point, only called if !ctx->usest
+  Set up KSP solvers for every integration point, only called if !ctx->usest.
+  Nothing is done if the matrices and the integration points have not changed since the
+  previous call, and if only the values have changed the matrices of the solvers are
+  updated in place, so that the symbolic factorizations are reused
 */
 static PetscErrorCode EPSCISSSetUp(EPS eps,Mat A,Mat B,Mat Pa,Mat Pb)
 {
   EPS_CISS         *ctx = (EPS_CISS*)eps->data;
   SlepcContourData contour;
   PetscInt         i,p_id,nsplit;
-  Mat              Amat,Pmat;
+  Mat              Amat,Pmat,op[2];
   MatStructure     str,strp;
+  PetscObjectId    id[2]={0,0};
+  PetscObjectState state[2]={0,0},nzstate[2]={0,0};
+  PetscBool        samepattern=PETSC_TRUE,samevalues=PETSC_TRUE,flg;
 
   PetscFunctionBegin;
   if (!ctx->contour || !ctx->contour->ksp) PetscCall(EPSCISSGetKSPs(eps,NULL,NULL));
@@ -82,8 +102,31 @@ static PetscErrorCode EPSCISSSetUp(EPS eps,Mat A,Mat B,Mat Pa,Mat Pb)
   contour = ctx->contour;
   PetscCall(STGetMatStructure(eps->st,&str));
   PetscCall(STGetSplitPreconditionerInfo(eps->st,&nsplit,&strp));
-  for (i=0;i<contour->npoints;i++) {
+  op[0] = A; op[1] = B;
+  for (i=0;i<2;i++) {
+    if (op[i]) {
+      PetscCall(PetscObjectGetId((PetscObject)op[i],&id[i]));
+      PetscCall(PetscObjectStateGet((PetscObject)op[i],&state[i]));
+      PetscCall(MatGetNonzeroState(op[i],&nzstate[i]));
+    }
+    if (id[i]!=ctx->opid[i] || nzstate[i]!=ctx->opnzstate[i]) samepattern = PETSC_FALSE;
+    if (state[i]!=ctx->opstate[i]) samevalues = PETSC_FALSE;
+  }
+  if (nsplit) samepattern = PETSC_FALSE;
+  if (samepattern && samevalues && ctx->kspvalid) {
+    PetscCall(PetscInfo(eps,"Reusing the linear solvers of the integration points\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (i=0;i<(ctx->useherm?contour->npoints/2:contour->npoints);i++) {
     p_id = i*contour->subcomm->n + contour->subcomm->color;
+    PetscCall(KSPGetOperatorsSet(contour->ksp[i],&flg,NULL));
+    if (samepattern && flg) {  /* update the values, the KSP refactors with the same pattern */
+      PetscCall(KSPGetOperators(contour->ksp[i],&Amat,NULL));
+      PetscCall(MatCopy(A,Amat,SUBSET_NONZERO_PATTERN));
+      if (B) PetscCall(MatAXPY(Amat,-ctx->omega[p_id],B,SUBSET_NONZERO_PATTERN));
+      else PetscCall(MatShift(Amat,-ctx->omega[p_id]));
+      continue;
+    }
     PetscCall(MatDuplicate(A,MAT_COPY_VALUES,&Amat));
     if (B) PetscCall(MatAXPY(Amat,-ctx->omega[p_id],B,str));
     else PetscCall(MatShift(Amat,-ctx->omega[p_id]));
@@ -96,49 +139,251 @@ static PetscErrorCode EPSCISSSetUp(EPS eps,Mat A,Mat B,Mat Pa,Mat Pb)
     PetscCall(MatDestroy(&Amat));
     if (nsplit) PetscCall(MatDestroy(&Pmat));
   }
+  for (i=0;i<2;i++) {
+    ctx->opid[i]      = id[i];
+    ctx->opstate[i]   = state[i];
+    ctx->opnzstate[i] = nzstate[i];
+  }
+  ctx->kspvalid = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  In the low-memory mode, adds the contribution of the panel of Y associated to the
+  integration point p_id to the moments S (or pS with partitions) and Mu
+*/
+static PetscErrorCode EPSCISSAccumulate(EPS eps,BV V,PetscInt panel,PetscInt p_id)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  PetscCall(BVSetActiveColumns(ctx->Y,panel*ctx->L,(panel+1)*ctx->L));
+  PetscCall(BVSumQuadratureAdd(ctx->contour->pA?ctx->pS:ctx->S,ctx->Y,ctx->M,ctx->L,ctx->weight[p_id],ctx->pp[p_id]));
+  PetscCall(BVDotQuadratureAdd(ctx->Y,V,ctx->Mu,ctx->M,ctx->L,ctx->weight[p_id],ctx->pp[p_id],ctx->useconj));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  In the low-memory mode, combines the moments accumulated by all partitions
+*/
+static PetscErrorCode EPSCISSAccumulateEnd(EPS eps)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour = ctx->contour;
+  PetscInt         i,j,nloc;
+  PetscMPIInt      sub_size,count;
+  PetscScalar      *pv;
+  Vec              v,sj;
+  BV               S = contour->pA? ctx->pS: ctx->S;
+  MPI_Comm         child,parent;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetSizes(S,&nloc,NULL,NULL));
+  for (j=0;j<ctx->M*ctx->L;j++) {
+    PetscCall(BVGetColumn(S,j,&v));
+    if (PetscUnlikely(ctx->useconj)) {
+      PetscCall(VecGetArray(v,&pv));
+      for (i=0;i<nloc;i++) pv[i] = 2.0*PetscRealPart(pv[i]);
+      PetscCall(VecRestoreArray(v,&pv));
+    }
+    if (contour->pA) {
+      PetscCall(BVGetColumn(ctx->S,j,&sj));
+      PetscCall(VecSet(sj,0.0));
+      PetscCall(VecScatterBegin(contour->scatterin,v,sj,ADD_VALUES,SCATTER_REVERSE));
+      PetscCall(VecScatterEnd(contour->scatterin,v,sj,ADD_VALUES,SCATTER_REVERSE));
+      PetscCall(BVRestoreColumn(ctx->S,j,&sj));
+    }
+    PetscCall(BVRestoreColumn(S,j,&v));
+  }
+  PetscCall(PetscSubcommGetChild(contour->subcomm,&child));
+  PetscCallMPI(MPI_Comm_size(child,&sub_size));
+  for (i=0;i<2*ctx->M*ctx->L*ctx->L;i++) ctx->Mu[i] /= sub_size;
+  PetscCall(PetscMPIIntCast(2*ctx->M*ctx->L*ctx->L,&count));
+  PetscCall(PetscSubcommGetParent(contour->subcomm,&parent));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,ctx->Mu,count,MPIU_SCALAR,MPIU_SUM,parent));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 /*
-  Y_i = (A-z_i B)^{-1}BV for every integration point, Y=[Y_i] is in the context
+  Y_i = (A-z_i B)^{-1}BV for every integration point from i_start, Y=[Y_i] is in the context.
+  In the Hermitian case with paired conjugate points, the second half of the points is
+  solved with the linear solver of the first half, since (A-conj(z_i) B) = (A-z_i B)^H.
+  In the low-memory mode, Y holds the panel of a single point (two with paired points),
+  which is accumulated into the moments S and Mu right after being computed
 */
-static PetscErrorCode EPSCISSSolve(EPS eps,Mat B,BV V,PetscInt L_start,PetscInt L_end)
+static PetscErrorCode EPSCISSSolve(EPS eps,Mat B,BV V,PetscInt i_start,PetscInt L_start,PetscInt L_end)
 {
   EPS_CISS         *ctx = (EPS_CISS*)eps->data;
   SlepcContourData contour;
-  PetscInt         i,p_id;
-  Mat              MV,BMV=NULL,MC;
+  PetscInt         i,p_id,nsolve,py,pc;
+  Mat              MV,BMV=NULL,CMV=NULL,RHS=NULL,MC,R;
   KSP              ksp;
 
   PetscFunctionBegin;
   if (!ctx->contour || !ctx->contour->ksp) PetscCall(EPSCISSGetKSPs(eps,NULL,NULL));
   contour = ctx->contour;
   PetscAssert(ctx->contour && ctx->contour->ksp,PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"Something went wrong with EPSCISSGetKSPs()");
+  PetscAssert(!ctx->useherm || !i_start,PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"Paired conjugate points cannot be solved from a nonzero index");
+  PetscAssert(!ctx->lowmem || (!i_start && !L_start && L_end==ctx->L),PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"The low-memory mode requires solving all points and columns");
+  nsolve = ctx->useherm? contour->npoints/2: contour->npoints;
   PetscCall(BVSetActiveColumns(V,L_start,L_end));
   PetscCall(BVGetMat(V,&MV));
-  for (i=0;i<contour->npoints;i++) {
+  if (B) {
+    PetscCall(MatProductCreate(B,MV,NULL,&BMV));
+    PetscCall(MatProductSetType(BMV,MATPRODUCT_AB));
+    PetscCall(MatProductSetFromOptions(BMV));
+    PetscCall(MatProductSymbolic(BMV));
+    PetscCall(MatProductNumeric(BMV));
+  }
+  R = B? BMV: MV;
+  if (ctx->lowmem) {  /* V must be available for the accumulation of the moments */
+    PetscCall(MatDuplicate(R,MAT_COPY_VALUES,&RHS));
+    PetscCall(MatDestroy(&BMV));
+    PetscCall(BVRestoreMat(V,&MV));
+    R = RHS;
+    PetscCall(BVSetActiveColumns(contour->pA?ctx->pS:ctx->S,0,ctx->M*ctx->L));
+    PetscCall(BVScale(contour->pA?ctx->pS:ctx->S,0.0));
+    PetscCall(PetscArrayzero(ctx->Mu,2*ctx->M*ctx->L*ctx->L));
+  }
+  if (ctx->useherm) {
+    PetscCall(MatDuplicate(R,MAT_COPY_VALUES,&CMV));
+    PetscCall(MatConjugate(CMV));
+  }
+  for (i=i_start;i<nsolve;i++) {
     p_id = i*contour->subcomm->n + contour->subcomm->color;
+    py = ctx->lowmem? 0: i;
+    pc = ctx->lowmem? 1: i+nsolve;
     if (ctx->usest)  {
       PetscCall(STSetShift(eps->st,ctx->omega[p_id]));
       PetscCall(STGetKSP(eps->st,&ksp));
     } else ksp = contour->ksp[i];
-    PetscCall(BVSetActiveColumns(ctx->Y,i*ctx->L+L_start,i*ctx->L+L_end));
+    PetscCall(BVSetActiveColumns(ctx->Y,py*ctx->L+L_start,py*ctx->L+L_end));
     PetscCall(BVGetMat(ctx->Y,&MC));
-    if (B) {
-      if (!i) {
-        PetscCall(MatProductCreate(B,MV,NULL,&BMV));
-        PetscCall(MatProductSetType(BMV,MATPRODUCT_AB));
-        PetscCall(MatProductSetFromOptions(BMV));
-        PetscCall(MatProductSymbolic(BMV));
-      }
-      PetscCall(MatProductNumeric(BMV));
-      PetscCall(KSPMatSolve(ksp,BMV,MC));
-    } else PetscCall(KSPMatSolve(ksp,MV,MC));
+    PetscCall(KSPMatSolve(ksp,R,MC));
     PetscCall(BVRestoreMat(ctx->Y,&MC));
-    if (ctx->usest && i<contour->npoints-1) PetscCall(KSPReset(ksp));
+    if (ctx->useherm) {  /* Y_{i+nsolve} = conj((A-z_i B)^{-T} conj(BV)) */
+      PetscCall(BVSetActiveColumns(ctx->Y,pc*ctx->L+L_start,pc*ctx->L+L_end));
+      PetscCall(BVGetMat(ctx->Y,&MC));
+      PetscCall(KSPMatSolveTranspose(ksp,CMV,MC));
+      PetscCall(MatConjugate(MC));
+      PetscCall(BVRestoreMat(ctx->Y,&MC));
+    }
+    if (ctx->lowmem) {
+      PetscCall(EPSCISSAccumulate(eps,V,py,p_id));
+      if (ctx->useherm) PetscCall(EPSCISSAccumulate(eps,V,pc,(i+nsolve)*contour->subcomm->n+contour->subcomm->color));
+    }
+    if (ctx->usest && i<nsolve-1) PetscCall(KSPReset(ksp));
+  }
+  PetscCall(MatDestroy(&CMV));
+  if (ctx->lowmem) {
+    PetscCall(MatDestroy(&RHS));
+    PetscCall(EPSCISSAccumulateEnd(eps));
+  } else {
+    PetscCall(MatDestroy(&BMV));
+    PetscCall(BVRestoreMat(V,&MV));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Wrappers of the BV quadrature functions, in the low-memory mode the moments have
+  already been accumulated in EPSCISSSolve()
+*/
+static PetscErrorCode EPSCISSSumQuadrature(EPS eps)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour = ctx->contour;
+
+  PetscFunctionBegin;
+  if (!ctx->lowmem) PetscCall(BVSumQuadrature(ctx->S,ctx->Y,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->scatterin,contour->subcomm,contour->npoints,ctx->useconj));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSDotQuadrature(EPS eps,BV V,PetscScalar *Mu)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour = ctx->contour;
+
+  PetscFunctionBegin;
+  if (ctx->lowmem) PetscCall(PetscArraycpy(Mu,ctx->Mu,2*ctx->M*ctx->L*ctx->L));
+  else PetscCall(BVDotQuadrature(ctx->Y,V,Mu,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->subcomm,contour->npoints,ctx->useconj));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Enlarges the block size to Lnew, in the low-memory mode Y only holds one or two panels
+*/
+static PetscErrorCode EPSCISSResizeBases(EPS eps,PetscInt Lnew)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour = ctx->contour;
+
+  PetscFunctionBegin;
+  PetscCall(BVCISSResizeBases(ctx->S,contour->pA?ctx->pV:ctx->V,ctx->Y,ctx->L,Lnew,ctx->M,ctx->lowmem?(ctx->useherm?2:1):contour->npoints));
+  if (ctx->pS) PetscCall(BVResize(ctx->pS,Lnew*ctx->M,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Reorders the quadrature rule so that point N/2+j is the conjugate of point j, with
+  N/2+j = j+npoints/2 (mod npart) so that both are in the same partition. If the rule
+  does not have this structure, the pairing is deactivated
+*/
+static PetscErrorCode EPSCISSPairConjugates(EPS eps)
+{
+  EPS_CISS    *ctx = (EPS_CISS*)eps->data;
+  PetscInt    j,n=ctx->N/2;
+  PetscScalar *w,*z,*zn;
+  PetscReal   tol=10*ctx->N*PETSC_MACHINE_EPSILON;
+
+  PetscFunctionBegin;
+  for (j=0;j<n && ctx->useherm;j++) {
+    if (PetscAbsScalar(ctx->omega[ctx->N-1-j]-PetscConj(ctx->omega[j]))>tol*PetscMax(1.0,PetscAbsScalar(ctx->omega[j]))) ctx->useherm = PETSC_FALSE;
+  }
+  if (!ctx->useherm) {
+    PetscCall(PetscInfo(eps,"The quadrature points are not conjugate pairs, each point has its own linear solver\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc3(n,&w,n,&z,n,&zn));
+  for (j=0;j<n;j++) {
+    w[j]  = ctx->weight[ctx->N-1-j];
+    z[j]  = ctx->omega[ctx->N-1-j];
+    zn[j] = ctx->pp[ctx->N-1-j];
+  }
+  PetscCall(PetscArraycpy(ctx->weight+n,w,n));
+  PetscCall(PetscArraycpy(ctx->omega+n,z,n));
+  PetscCall(PetscArraycpy(ctx->pp+n,zn,n));
+  PetscCall(PetscFree3(w,z,zn));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Triples the number of integration points, solving only at the new points. The rules
+  used with refinement take angles (i+0.5)/n, so point i of the current rule is point
+  3*i+1 of the refined one. The refined rule is stored with the current points first,
+  matching the blocks already computed in Y, followed by the new points
+*/
+static PetscErrorCode EPSCISSRefineQuadrature(EPS eps,Mat B,BV V)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour = ctx->contour;
+  PetscInt         i,j,k,n,np=contour->npoints;
+  PetscScalar      *w,*z,*zn;
+
+  PetscFunctionBegin;
+  n = ctx->useconj? 2*np: np;
+  PetscCall(PetscMalloc3(3*n,&w,3*n+1,&z,3*n,&zn));
+  PetscCall(RGComputeQuadrature(eps->rg,ctx->quad==EPS_CISS_QUADRULE_CHEBYSHEV?RG_QUADRULE_CHEBYSHEV:RG_QUADRULE_TRAPEZOIDAL,3*n,z,zn,w));
+  for (i=0,k=np;i<3*np;i++) {
+    j = (i%3==1)? i/3: k++;
+    ctx->weight[j] = w[i];
+    ctx->omega[j]  = z[i];
+    ctx->pp[j]     = zn[i];
   }
-  PetscCall(MatDestroy(&BMV));
-  PetscCall(BVRestoreMat(V,&MV));
+  PetscCall(PetscFree3(w,z,zn));
+  contour->npoints = 3*np;
+  PetscCall(BVResize(ctx->Y,contour->npoints*ctx->L,PETSC_TRUE));
+  PetscCall(EPSCISSSolve(eps,B,V,np,0,ctx->L));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -209,13 +454,301 @@ static PetscErrorCode rescale_eig(EPS eps,PetscInt nv)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Creates a copy of the region rg in the communicator comm
+*/
+static PetscErrorCode EPSCISSCopyRegion(RG rg,MPI_Comm comm,RG *newrg)
+{
+  PetscScalar center;
+  PetscReal   radius,vscale,start_ang,end_ang,width,a,b,c,d,sfactor;
+  PetscBool   isellipse,isring,isinterval;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)rg,RGELLIPSE,&isellipse));
+  PetscCall(PetscObjectTypeCompare((PetscObject)rg,RGRING,&isring));
+  PetscCall(PetscObjectTypeCompare((PetscObject)rg,RGINTERVAL,&isinterval));
+  PetscCheck(isellipse || isring || isinterval,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"Currently only implemented for interval, elliptic or ring regions");
+  PetscCall(RGCreate(comm,newrg));
+  if (isellipse) {
+    PetscCall(RGEllipseGetParameters(rg,&center,&radius,&vscale));
+    PetscCall(RGSetType(*newrg,RGELLIPSE));
+    PetscCall(RGEllipseSetParameters(*newrg,center,radius,vscale));
+  } else if (isring) {
+    PetscCall(RGRingGetParameters(rg,&center,&radius,&vscale,&start_ang,&end_ang,&width));
+    PetscCall(RGSetType(*newrg,RGRING));
+    PetscCall(RGRingSetParameters(*newrg,center,radius,vscale,start_ang,end_ang,width));
+  } else {
+    PetscCall(RGIntervalGetEndpoints(rg,&a,&b,&c,&d));
+    PetscCall(RGSetType(*newrg,RGINTERVAL));
+    PetscCall(RGIntervalSetEndpoints(*newrg,a,b,c,d));
+  }
+  PetscCall(RGGetScale(rg,&sfactor));
+  PetscCall(RGSetScale(*newrg,sfactor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Set up in case of split into subregions: the region is divided with RGSplit()
+  and the subregions are assigned to the partitions in a round-robin fashion.
+  Each partition creates a child CISS solver for each of its subregions, that
+  works with redundant copies of the matrices in the subcommunicator
+*/
+static PetscErrorCode EPSSetUp_CISS_Split(EPS eps)
+{
+  EPS_CISS         *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData contour;
+  PetscInt         i,k,p,color,nmat,nsplit;
+  RG               *sub,rg;
+  EPS              subeps;
+  ST               st;
+  Mat              A[2],Psplit[2],*pA,*pP;
+  MatStructure     strp;
+  Vec              v0;
+  MPI_Comm         child;
+
+  PetscFunctionBegin;
+  PetscCall(EPSAllocateSolution(eps,0));
+  for (k=0;k<ctx->nsubeps;k++) PetscCall(EPSDestroy(&ctx->subeps[k]));
+  PetscCall(PetscFree(ctx->subeps));
+  ctx->nsubeps = 0;
+
+  /* redundant matrices and scatter context, only if there are several partitions */
+  if (!ctx->contour) {
+    PetscCall(RGCanUseConjugates(eps->rg,ctx->isreal,&ctx->useconj));
+    PetscCall(SlepcContourDataCreate(ctx->useconj?ctx->N/2:ctx->N,ctx->npart,(PetscObject)eps,&ctx->contour));
+  }
+  contour = ctx->contour;
+  nmat = eps->isgeneralized? 2: 1;
+  PetscCall(STGetMatrix(eps->st,0,&A[0]));
+  if (eps->isgeneralized) PetscCall(STGetMatrix(eps->st,1,&A[1]));
+  PetscCall(STGetSplitPreconditionerInfo(eps->st,&nsplit,&strp));
+  if (nsplit) {
+    PetscCall(STGetSplitPreconditionerTerm(eps->st,0,&Psplit[0]));
+    if (eps->isgeneralized) PetscCall(STGetSplitPreconditionerTerm(eps->st,1,&Psplit[1]));
+  }
+  PetscCall(SlepcContourRedundantMat(contour,nmat,A,nsplit?Psplit:NULL));
+  if (contour->pA) {
+    PetscCall(BVGetColumn(eps->V,0,&v0));
+    PetscCall(SlepcContourScatterCreate(contour,v0));
+    PetscCall(BVRestoreColumn(eps->V,0,&v0));
+    PetscCall(PetscSubcommGetChild(contour->subcomm,&child));
+    color = contour->subcomm->color;
+    pA = contour->pA;
+    pP = nsplit? contour->pP: NULL;
+  } else {
+    child = PetscObjectComm((PetscObject)eps);
+    color = 0;
+    pA = A;
+    pP = nsplit? Psplit: NULL;
+  }
+
+  /* create the solvers of the local subregions */
+  PetscCall(PetscMalloc1(ctx->nsub,&sub));
+  PetscCall(RGSplit(eps->rg,ctx->nsub,sub));
+  for (p=color;p<ctx->nsub;p+=ctx->npart) ctx->nsubeps++;
+  PetscCall(PetscMalloc1(ctx->nsubeps,&ctx->subeps));
+  for (p=color,k=0;p<ctx->nsub;p+=ctx->npart,k++) {
+    PetscCall(EPSCreate(child,&subeps));
+    PetscCall(PetscObjectIncrementTabLevel((PetscObject)subeps,(PetscObject)eps,1));
+    PetscCall(EPSSetOptionsPrefix(subeps,((PetscObject)eps)->prefix));
+    PetscCall(EPSAppendOptionsPrefix(subeps,"sub_"));
+    PetscCall(EPSSetOperators(subeps,pA[0],eps->isgeneralized?pA[1]:NULL));
+    PetscCall(EPSSetProblemType(subeps,eps->problem_type));
+    PetscCall(EPSSetTolerances(subeps,eps->tol,eps->max_it));
+    if (nsplit) {
+      PetscCall(EPSGetST(subeps,&st));
+      PetscCall(STSetSplitPreconditioner(st,nsplit,pP,strp));
+    }
+    PetscCall(EPSCISSCopyRegion(sub[p],child,&rg));
+    PetscCall(EPSSetRegion(subeps,rg));
+    PetscCall(RGDestroy(&rg));
+    PetscCall(EPSSetType(subeps,EPSCISS));
+    PetscCall(EPSCISSSetSizes(subeps,ctx->N,ctx->L,ctx->M,1,ctx->L_max,ctx->isreal));
+    PetscCall(EPSCISSSetThreshold(subeps,ctx->delta,ctx->spurious_threshold));
+    PetscCall(EPSCISSSetRefinement(subeps,ctx->refine_inner,ctx->refine_blocksize));
+    PetscCall(EPSCISSSetQuadRefinement(subeps,ctx->refine_quad));
+    PetscCall(EPSCISSSetExtraction(subeps,ctx->extraction));
+    if (ctx->quad) PetscCall(EPSCISSSetQuadRule(subeps,ctx->quad));
+    if (ctx->usest_set) PetscCall(EPSCISSSetUseST(subeps,ctx->usest));
+    PetscCall(EPSCISSSetLowMemory(subeps,ctx->lowmem));
+    PetscCall(EPSCISSSetRandomizedSVD(subeps,ctx->randsvd));
+    PetscCall(EPSSetFromOptions(subeps));
+    ctx->subeps[k] = subeps;
+  }
+  for (i=0;i<ctx->nsub;i++) PetscCall(RGDestroy(&sub[i]));
+  PetscCall(PetscFree(sub));
+
+  PetscCall(DSSetType(eps->ds,DSNHEP));
+  PetscCall(DSAllocate(eps->ds,eps->ncv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Inserts in column j of eps->V the vector x, which is significant only in the
+  owner partition, using the scatter sc from eps->V to the vector xdup of the contour data
+*/
+static PetscErrorCode EPSCISSGatherVec(EPS eps,VecScatter sc,PetscBool owner,Vec x,PetscInt j)
+{
+  EPS_CISS    *ctx = (EPS_CISS*)eps->data;
+  Vec         v,xdup = ctx->contour->xdup;
+  PetscScalar *array;
+
+  PetscFunctionBegin;
+  if (!sc) {  /* a single partition, the vectors have the same layout */
+    PetscCall(BVInsertVec(eps->V,j,x));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(BVGetColumn(eps->V,j,&v));
+  if (owner) {
+    PetscCall(VecGetArray(x,&array));
+    PetscCall(VecPlaceArray(xdup,array));
+  }
+  PetscCall(VecScatterBegin(sc,xdup,v,INSERT_VALUES,SCATTER_REVERSE));
+  PetscCall(VecScatterEnd(sc,xdup,v,INSERT_VALUES,SCATTER_REVERSE));
+  if (owner) {
+    PetscCall(VecResetArray(xdup));
+    PetscCall(VecRestoreArray(x,&array));
+  }
+  PetscCall(BVRestoreColumn(eps->V,j,&v));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Solve in case of split into subregions: each partition solves its subregions,
+  then the eigenvalues are reduced in the whole communicator and the eigenvectors
+  are scattered from the subcommunicators to eps->V
+*/
+static PetscErrorCode EPSSolve_CISS_Split(EPS eps)
+{
+  EPS_CISS           *ctx = (EPS_CISS*)eps->data;
+  SlepcContourData   contour = ctx->contour;
+  PetscInt           i,j,k,p,si,its,nconv,color,m=0,mstart=0,mend=0,*cnt,*off,*idx1=NULL,*idx2=NULL;
+  PetscMPIInt        rank;
+  PetscBool          owner,diverged=PETSC_FALSE;
+  MPI_Comm           comm = PetscObjectComm((PetscObject)eps),child;
+  EPSConvergedReason reason;
+  Mat                A;
+  Vec                v,x=NULL,xi=NULL;
+  IS                 is1,is2;
+  VecScatter         sc=NULL;
+
+  PetscFunctionBegin;
+  if (contour->pA) {
+    PetscCall(PetscSubcommGetChild(contour->subcomm,&child));
+    color = contour->subcomm->color;
+  } else {
+    child = comm;
+    color = 0;
+  }
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+
+  /* solve the local subregions */
+  PetscCall(PetscCalloc2(ctx->nsub,&cnt,ctx->nsub+1,&off));
+  eps->its = 0;
+  for (p=color,k=0;p<ctx->nsub;p+=ctx->npart,k++) {
+    PetscCall(EPSSolve(ctx->subeps[k]));
+    PetscCall(EPSGetConverged(ctx->subeps[k],&nconv));
+    PetscCall(EPSGetIterationNumber(ctx->subeps[k],&its));
+    PetscCall(EPSGetConvergedReason(ctx->subeps[k],&reason));
+    PetscCall(PetscInfo(eps,"Subregion %" PetscInt_FMT ": %" PetscInt_FMT " eigenvalues computed in %" PetscInt_FMT " iterations\n",p,nconv,its));
+    if (!rank) cnt[p] = nconv;
+    eps->its = PetscMax(eps->its,its);
+    if (reason<0) diverged = PETSC_TRUE;
+  }
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,cnt,ctx->nsub,MPIU_INT,MPI_SUM,comm));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,&eps->its,1,MPIU_INT,MPI_MAX,comm));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,&diverged,1,MPIU_BOOL,MPI_LOR,comm));
+  for (p=0;p<ctx->nsub;p++) off[p+1] = off[p]+cnt[p];
+
+  /* make room for all eigenpairs and reduce the eigenvalues */
+  nconv = off[ctx->nsub];
+  if (nconv>eps->ncv) {
+    eps->ncv = nconv;
+    PetscCall(EPSAllocateSolution(eps,0));
+  }
+  for (i=0;i<nconv;i++) {
+    eps->eigr[i]   = 0.0;
+    eps->eigi[i]   = 0.0;
+    eps->errest[i] = 0.0;
+    eps->perm[i]   = i;
+  }
+  if (!rank) {
+    for (p=color,k=0;p<ctx->nsub;p+=ctx->npart,k++) {
+      for (i=0;i<cnt[p];i++) {
+        PetscCall(EPSGetEigenvalue(ctx->subeps[k],i,eps->eigr+off[p]+i,eps->eigi+off[p]+i));
+        PetscCall(EPSGetErrorEstimate(ctx->subeps[k],i,eps->errest+off[p]+i));
+      }
+    }
+  }
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,eps->eigr,nconv,MPIU_SCALAR,MPIU_SUM,comm));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,eps->eigi,nconv,MPIU_SCALAR,MPIU_SUM,comm));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,eps->errest,nconv,MPIU_REAL,MPIU_SUM,comm));
+
+  /* gather the eigenvectors, one partition at a time */
+  if (ctx->nsubeps) {
+    PetscCall(EPSGetOperators(ctx->subeps[0],&A,NULL));
+    PetscCall(MatCreateVecs(A,&x,NULL));
+#if !defined(PETSC_USE_COMPLEX)
+    PetscCall(VecDuplicate(x,&xi));
+#endif
+  }
+  if (contour->pA) {
+    PetscCall(BVGetColumn(eps->V,0,&v));
+    PetscCall(VecGetSize(v,&m));
+    PetscCall(VecGetOwnershipRange(v,&mstart,&mend));
+    PetscCall(BVRestoreColumn(eps->V,0,&v));
+    PetscCall(PetscMalloc2(mend-mstart,&idx1,mend-mstart,&idx2));
+  }
+  for (si=0;si<ctx->npart;si++) {
+    owner = (color==si)? PETSC_TRUE: PETSC_FALSE;
+    if (contour->pA) {
+      for (i=mstart,j=0;i<mend;i++,j++) {
+        idx1[j] = i;
+        idx2[j] = i+m*si;
+      }
+      PetscCall(ISCreateGeneral(comm,mend-mstart,idx1,PETSC_COPY_VALUES,&is1));
+      PetscCall(ISCreateGeneral(comm,mend-mstart,idx2,PETSC_COPY_VALUES,&is2));
+      PetscCall(BVGetColumn(eps->V,0,&v));
+      PetscCall(VecScatterCreate(v,is1,contour->xdup,is2,&sc));
+      PetscCall(BVRestoreColumn(eps->V,0,&v));
+      PetscCall(ISDestroy(&is1));
+      PetscCall(ISDestroy(&is2));
+    }
+    for (p=si,k=0;p<ctx->nsub;p+=ctx->npart,k++) {
+      for (i=0;i<cnt[p];i++) {
+        j = off[p]+i;
+#if !defined(PETSC_USE_COMPLEX)
+        if (eps->eigi[j]!=0.0) {  /* real and imaginary parts in consecutive columns */
+          if (owner) PetscCall(EPSGetEigenvector(ctx->subeps[k],i,x,xi));
+          PetscCall(EPSCISSGatherVec(eps,sc,owner,x,j));
+          PetscCall(EPSCISSGatherVec(eps,sc,owner,xi,j+1));
+          i++;
+          continue;
+        }
+#endif
+        if (owner) PetscCall(EPSGetEigenvector(ctx->subeps[k],i,x,NULL));
+        PetscCall(EPSCISSGatherVec(eps,sc,owner,x,j));
+      }
+    }
+    PetscCall(VecScatterDestroy(&sc));
+  }
+  PetscCall(PetscFree2(idx1,idx2));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&xi));
+  PetscCall(PetscFree2(cnt,off));
+
+  eps->nconv  = nconv;
+  eps->reason = diverged? EPS_DIVERGED_ITS: EPS_CONVERGED_TOL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSetUp_CISS(EPS eps)
 {
   EPS_CISS         *ctx = (EPS_CISS*)eps->data;
   SlepcContourData contour;
-  PetscBool        istrivial,isring,isellipse,isinterval,flg;
+  PetscBool        istrivial,isring,isellipse,isinterval,flg,useconj,useherm;
   PetscReal        c,d;
-  PetscInt         nsplit;
+  PetscInt         i,nsplit,nmax,m,npanels;
   PetscRandom      rand;
   PetscObjectId    id;
   PetscObjectState state;
@@ -256,13 +789,24 @@ static PetscErrorCode EPSSetUp_CISS(EPS eps)
   PetscCall(PetscObjectTypeCompare((PetscObject)eps->rg,RGINTERVAL,&isinterval));
   PetscCheck(isellipse || isring || isinterval,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Currently only implemented for interval, elliptic or ring regions");
 
-  /* if the region has changed, then reset contour data */
+  /* if the region has changed, then the linear solvers must be updated, and the contour
+     data is reset only if the number of integration points per partition changes */
   PetscCall(PetscObjectGetId((PetscObject)eps->rg,&id));
   PetscCall(PetscObjectStateGet((PetscObject)eps->rg,&state));
   if (ctx->rgid && (id != ctx->rgid || state != ctx->rgstate)) {
-    PetscCall(SlepcContourDataDestroy(&ctx->contour));
-    PetscCall(PetscInfo(eps,"Resetting the contour data structure due to a change of region\n"));
-    ctx->rgid = id; ctx->rgstate = state;
+    ctx->kspvalid = PETSC_FALSE;
+    if (ctx->contour) {
+      PetscCall(RGCanUseConjugates(eps->rg,ctx->isreal,&useconj));
+      if (useconj!=ctx->useconj) {
+        PetscCall(SlepcContourDataDestroy(&ctx->contour));
+        PetscCall(PetscInfo(eps,"Resetting the contour data structure due to a change of region\n"));
+      } else PetscCall(PetscInfo(eps,"Reusing the contour data structure after a change of region\n"));
+    }
+  }
+  ctx->rgid = id; ctx->rgstate = state;
+  if (ctx->nsub>1) {
+    PetscCall(EPSSetUp_CISS_Split(eps));
+    PetscFunctionReturn(PETSC_SUCCESS);
   }
 
 #if !defined(PETSC_USE_COMPLEX)
@@ -281,18 +825,30 @@ static PetscErrorCode EPSSetUp_CISS(EPS eps)
   if (!ctx->contour) {
     PetscCall(RGCanUseConjugates(eps->rg,ctx->isreal,&ctx->useconj));
     PetscCall(SlepcContourDataCreate(ctx->useconj?ctx->N/2:ctx->N,ctx->npart,(PetscObject)eps,&ctx->contour));
+    /* the bases in the subcommunicator cannot be reused */
+    PetscCall(BVDestroy(&ctx->pV));
+    PetscCall(BVDestroy(&ctx->pS));
+    PetscCall(BVDestroy(&ctx->Y));
+    ctx->kspvalid = PETSC_FALSE;
   }
 
   PetscCall(EPSAllocateSolution(eps,0));
   PetscCall(BVGetRandomContext(eps->V,&rand));  /* make sure the random context is available when duplicating */
   if (ctx->weight) PetscCall(PetscFree4(ctx->weight,ctx->omega,ctx->pp,ctx->sigma));
-  PetscCall(PetscMalloc4(ctx->N,&ctx->weight,ctx->N+1,&ctx->omega,ctx->N,&ctx->pp,ctx->L_max*ctx->M,&ctx->sigma));
-
-  /* allocate basis vectors */
-  PetscCall(BVDestroy(&ctx->S));
-  PetscCall(BVDuplicateResize(eps->V,ctx->L*ctx->M,&ctx->S));
-  PetscCall(BVDestroy(&ctx->V));
-  PetscCall(BVDuplicateResize(eps->V,ctx->L,&ctx->V));
+  for (i=0,nmax=ctx->N;i<ctx->refine_quad;i++) nmax *= 3;  /* room for the refined quadrature rules */
+  PetscCall(PetscMalloc4(nmax,&ctx->weight,nmax+1,&ctx->omega,nmax,&ctx->pp,ctx->L_max*ctx->M,&ctx->sigma));
+
+  /* allocate basis vectors, unless they are available from a previous setup */
+  if (ctx->S) PetscCall(BVGetSizes(ctx->S,NULL,NULL,&m));
+  if (!ctx->S || m!=ctx->L*ctx->M) {
+    PetscCall(BVDestroy(&ctx->S));
+    PetscCall(BVDuplicateResize(eps->V,ctx->L*ctx->M,&ctx->S));
+  }
+  if (ctx->V) PetscCall(BVGetSizes(ctx->V,NULL,NULL,&m));
+  if (!ctx->V || m!=ctx->L) {
+    PetscCall(BVDestroy(&ctx->V));
+    PetscCall(BVDuplicateResize(eps->V,ctx->L,&ctx->V));
+  }
 
   PetscCall(STGetMatrix(eps->st,0,&A[0]));
   PetscCall(MatIsShell(A[0],&flg));
@@ -301,6 +857,19 @@ static PetscErrorCode EPSSetUp_CISS(EPS eps)
 
   if (!ctx->usest_set) ctx->usest = (ctx->npart>1)? PETSC_FALSE: PETSC_TRUE;
   PetscCheck(!ctx->usest || ctx->npart==1,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The usest flag is not supported when partitions > 1");
+  PetscCheck(!ctx->lowmem || !ctx->refine_quad,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Refinement of the quadrature rule is not available in the low-memory mode");
+  if (ctx->refine_quad) {
+    PetscCheck(ctx->usest,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Refinement of the quadrature rule requires the usest flag");
+    PetscCheck(isellipse || ctx->quad==EPS_CISS_QUADRULE_CHEBYSHEV,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Refinement of the quadrature rule is only available for elliptic regions or the Chebyshev rule");
+  }
+
+  /* in the Hermitian case, the solvers of conjugate points can be shared */
+  useherm = PETSC_FALSE;
+#if defined(PETSC_USE_COMPLEX)
+  if (eps->ishermitian && !ctx->useconj && !ctx->refine_quad && !(ctx->N%(2*ctx->npart))) PetscCall(RGCanUseConjugates(eps->rg,PETSC_TRUE,&useherm));
+#endif
+  if (useherm!=ctx->useherm) ctx->kspvalid = PETSC_FALSE;  /* the points are assigned to the solvers differently */
+  ctx->useherm = useherm;
 
   /* check if a user-defined split preconditioner has been set */
   PetscCall(STGetSplitPreconditionerInfo(eps->st,&nsplit,NULL));
@@ -312,26 +881,44 @@ static PetscErrorCode EPSSetUp_CISS(EPS eps)
   contour = ctx->contour;
   PetscCall(SlepcContourRedundantMat(contour,eps->isgeneralized?2:1,A,nsplit?Psplit:NULL));
   if (contour->pA) {
-    PetscCall(BVGetColumn(ctx->V,0,&v0));
-    PetscCall(SlepcContourScatterCreate(contour,v0));
-    PetscCall(BVRestoreColumn(ctx->V,0,&v0));
-    PetscCall(BVDestroy(&ctx->pV));
-    PetscCall(BVCreate(PetscObjectComm((PetscObject)contour->xsub),&ctx->pV));
-    PetscCall(BVSetSizesFromVec(ctx->pV,contour->xsub,eps->n));
-    PetscCall(BVSetFromOptions(ctx->pV));
-    PetscCall(BVResize(ctx->pV,ctx->L,PETSC_FALSE));
+    if (!contour->scatterin) {  /* the scatter only depends on the parallel layout */
+      PetscCall(BVGetColumn(ctx->V,0,&v0));
+      PetscCall(SlepcContourScatterCreate(contour,v0));
+      PetscCall(BVRestoreColumn(ctx->V,0,&v0));
+    }
+    if (ctx->pV) PetscCall(BVGetSizes(ctx->pV,NULL,NULL,&m));
+    if (!ctx->pV || m!=ctx->L) {
+      PetscCall(BVDestroy(&ctx->pV));
+      PetscCall(BVCreate(PetscObjectComm((PetscObject)contour->xsub),&ctx->pV));
+      PetscCall(BVSetSizesFromVec(ctx->pV,contour->xsub,eps->n));
+      PetscCall(BVSetFromOptions(ctx->pV));
+      PetscCall(BVResize(ctx->pV,ctx->L,PETSC_FALSE));
+    }
+    if (ctx->pS) PetscCall(BVGetSizes(ctx->pS,NULL,NULL,&m));
+    if (ctx->lowmem && (!ctx->pS || m!=ctx->L*ctx->M)) {
+      PetscCall(BVDestroy(&ctx->pS));
+      PetscCall(BVDuplicateResize(ctx->pV,ctx->L*ctx->M,&ctx->pS));
+    }
   }
+  if (!ctx->lowmem) PetscCall(BVDestroy(&ctx->pS));
+  PetscCall(PetscFree(ctx->Mu));
+  if (ctx->lowmem) PetscCall(PetscMalloc1(2*ctx->M*ctx->L_max*ctx->L_max,&ctx->Mu));
 
   EPSCheckDefinite(eps);
   EPSCheckSinvertCondition(eps,ctx->usest," (with the usest flag set)");
 
-  PetscCall(BVDestroy(&ctx->Y));
-  if (contour->pA) {
-    PetscCall(BVCreate(PetscObjectComm((PetscObject)contour->xsub),&ctx->Y));
-    PetscCall(BVSetSizesFromVec(ctx->Y,contour->xsub,eps->n));
-    PetscCall(BVSetFromOptions(ctx->Y));
-    PetscCall(BVResize(ctx->Y,contour->npoints*ctx->L,PETSC_FALSE));
-  } else PetscCall(BVDuplicateResize(eps->V,contour->npoints*ctx->L,&ctx->Y));
+  /* in the low-memory mode Y only holds the solutions at one point (two with paired points) */
+  npanels = ctx->lowmem? (ctx->useherm? 2: 1): contour->npoints;
+  if (ctx->Y) PetscCall(BVGetSizes(ctx->Y,NULL,NULL,&m));
+  if (!ctx->Y || m!=npanels*ctx->L) {
+    PetscCall(BVDestroy(&ctx->Y));
+    if (contour->pA) {
+      PetscCall(BVCreate(PetscObjectComm((PetscObject)contour->xsub),&ctx->Y));
+      PetscCall(BVSetSizesFromVec(ctx->Y,contour->xsub,eps->n));
+      PetscCall(BVSetFromOptions(ctx->Y));
+      PetscCall(BVResize(ctx->Y,npanels*ctx->L,PETSC_FALSE));
+    } else PetscCall(BVDuplicateResize(eps->V,npanels*ctx->L,&ctx->Y));
+  }
 
   if (ctx->extraction == EPS_CISS_EXTRACTION_HANKEL) PetscCall(DSSetType(eps->ds,DSGNHEP));
   else if (eps->isgeneralized) {
@@ -378,8 +965,8 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
   SlepcContourData contour = ctx->contour;
   Mat              A,B,X,M,pA,pB,T,J,Pa=NULL,Pb=NULL;
   BV               V;
-  PetscInt         i,j,ld,nmat,L_add=0,nv=0,L_base=ctx->L,inner,nlocal,*inside,nsplit;
-  PetscScalar      *Mu,*H0,*H1=NULL,*rr,*temp;
+  PetscInt         i,j,k,ld,nmat,L_add=0,nv=0,nv0,L_base=ctx->L,inner,nlocal,*inside,nsplit,npoints=contour->npoints;
+  PetscScalar      *Mu,*Mu0,*H0,*H1=NULL,*rr,*temp;
   PetscReal        error,max_error,norm;
   PetscBool        *fl1;
   Vec              si,si1=NULL,w[3];
@@ -387,11 +974,16 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
 #if defined(PETSC_USE_COMPLEX)
   PetscBool        isellipse;
   PetscReal        est_eig,eta;
+  PetscScalar      tr;
 #else
   PetscReal        normi;
 #endif
 
   PetscFunctionBegin;
+  if (ctx->nsub>1) {
+    PetscCall(EPSSolve_CISS_Split(eps));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   w[0] = eps->work[0];
 #if defined(PETSC_USE_COMPLEX)
   w[1] = NULL;
@@ -402,6 +994,7 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
   PetscCall(VecGetLocalSize(w[0],&nlocal));
   PetscCall(DSGetLeadingDimension(eps->ds,&ld));
   PetscCall(RGComputeQuadrature(eps->rg,ctx->quad==EPS_CISS_QUADRULE_CHEBYSHEV?RG_QUADRULE_CHEBYSHEV:RG_QUADRULE_TRAPEZOIDAL,ctx->N,ctx->omega,ctx->pp,ctx->weight));
+  if (ctx->useherm) PetscCall(EPSCISSPairConjugates(eps));
   PetscCall(STGetNumMatrices(eps->st,&nmat));
   PetscCall(STGetMatrix(eps->st,0,&A));
   if (nmat>1) PetscCall(STGetMatrix(eps->st,1,&B));
@@ -427,11 +1020,14 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
   PetscCall(BVGetRandomContext(ctx->V,&rand));
 
   if (contour->pA) PetscCall(BVScatter(ctx->V,ctx->pV,contour->scatterin,contour->xdup));
-  PetscCall(EPSCISSSolve(eps,J,V,0,ctx->L));
+  PetscCall(EPSCISSSolve(eps,J,V,0,0,ctx->L));
 #if defined(PETSC_USE_COMPLEX)
   PetscCall(PetscObjectTypeCompare((PetscObject)eps->rg,RGELLIPSE,&isellipse));
   if (isellipse) {
-    PetscCall(BVTraceQuadrature(ctx->Y,ctx->V,ctx->L,ctx->L,ctx->weight,contour->scatterin,contour->subcomm,contour->npoints,ctx->useconj,&est_eig));
+    if (ctx->lowmem) {  /* trace of the first block of moments */
+      for (i=0,tr=0.0;i<ctx->L;i++) tr += ctx->Mu[i+i*ctx->L];
+      est_eig = PetscAbsScalar(tr)/(PetscReal)ctx->L;
+    } else PetscCall(BVTraceQuadrature(ctx->Y,ctx->V,ctx->L,ctx->L,ctx->weight,contour->scatterin,contour->subcomm,contour->npoints,ctx->useconj,&est_eig));
     PetscCall(PetscInfo(eps,"Estimated eigenvalue count: %f\n",(double)est_eig));
     eta = PetscPowReal(10.0,-PetscLog10Real(eps->tol)/ctx->N);
     L_add = PetscMax(0,(PetscInt)PetscCeilReal((est_eig*eta)/ctx->M)-ctx->L);
@@ -443,16 +1039,16 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
 #endif
   if (L_add>0) {
     PetscCall(PetscInfo(eps,"Changing L %" PetscInt_FMT " -> %" PetscInt_FMT " by Estimate #Eig\n",ctx->L,ctx->L+L_add));
-    PetscCall(BVCISSResizeBases(ctx->S,contour->pA?ctx->pV:ctx->V,ctx->Y,ctx->L,ctx->L+L_add,ctx->M,contour->npoints));
+    PetscCall(EPSCISSResizeBases(eps,ctx->L+L_add));
     PetscCall(BVSetActiveColumns(ctx->V,ctx->L,ctx->L+L_add));
     PetscCall(BVSetRandomSign(ctx->V));
     if (contour->pA) PetscCall(BVScatter(ctx->V,ctx->pV,contour->scatterin,contour->xdup));
     ctx->L += L_add;
-    PetscCall(EPSCISSSolve(eps,J,V,ctx->L-L_add,ctx->L));
+    PetscCall(EPSCISSSolve(eps,J,V,0,ctx->lowmem?0:ctx->L-L_add,ctx->L));
   }
   PetscCall(PetscMalloc2(ctx->L*ctx->L*ctx->M*2,&Mu,ctx->L*ctx->M*ctx->L*ctx->M,&H0));
   for (i=0;i<ctx->refine_blocksize;i++) {
-    PetscCall(BVDotQuadrature(ctx->Y,(contour->pA)?ctx->pV:ctx->V,Mu,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->subcomm,contour->npoints,ctx->useconj));
+    PetscCall(EPSCISSDotQuadrature(eps,V,Mu));
     PetscCall(CISS_BlockHankel(Mu,0,ctx->L,ctx->M,H0));
     PetscCall(PetscLogEventBegin(EPS_CISS_SVD,eps,0,0,0));
     PetscCall(SlepcCISS_BH_SVD(H0,ctx->L*ctx->M,ctx->delta,ctx->sigma,&nv));
@@ -461,38 +1057,66 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
     L_add = L_base;
     if (ctx->L+L_add>ctx->L_max) L_add = ctx->L_max-ctx->L;
     PetscCall(PetscInfo(eps,"Changing L %" PetscInt_FMT " -> %" PetscInt_FMT " by SVD(H0)\n",ctx->L,ctx->L+L_add));
-    PetscCall(BVCISSResizeBases(ctx->S,contour->pA?ctx->pV:ctx->V,ctx->Y,ctx->L,ctx->L+L_add,ctx->M,contour->npoints));
+    PetscCall(EPSCISSResizeBases(eps,ctx->L+L_add));
     PetscCall(BVSetActiveColumns(ctx->V,ctx->L,ctx->L+L_add));
     PetscCall(BVSetRandomSign(ctx->V));
     if (contour->pA) PetscCall(BVScatter(ctx->V,ctx->pV,contour->scatterin,contour->xdup));
     ctx->L += L_add;
-    PetscCall(EPSCISSSolve(eps,J,V,ctx->L-L_add,ctx->L));
+    PetscCall(EPSCISSSolve(eps,J,V,0,ctx->lowmem?0:ctx->L-L_add,ctx->L));
     if (L_add) {
       PetscCall(PetscFree2(Mu,H0));
       PetscCall(PetscMalloc2(ctx->L*ctx->L*ctx->M*2,&Mu,ctx->L*ctx->M*ctx->L*ctx->M,&H0));
     }
   }
+  if (ctx->refine_quad) {
+    /* refine the quadrature rule until the numerical rank or the moments do not change */
+    PetscCall(PetscMalloc1(ctx->L*ctx->L*ctx->M*2,&Mu0));
+    PetscCall(EPSCISSDotQuadrature(eps,V,Mu));
+    PetscCall(CISS_BlockHankel(Mu,0,ctx->L,ctx->M,H0));
+    PetscCall(PetscLogEventBegin(EPS_CISS_SVD,eps,0,0,0));
+    PetscCall(SlepcCISS_BH_SVD(H0,ctx->L*ctx->M,ctx->delta,ctx->sigma,&nv));
+    PetscCall(PetscLogEventEnd(EPS_CISS_SVD,eps,0,0,0));
+    for (k=0;k<ctx->refine_quad;k++) {
+      PetscCall(PetscArraycpy(Mu0,Mu,ctx->L*ctx->L*ctx->M*2));
+      nv0 = nv;
+      PetscCall(EPSCISSRefineQuadrature(eps,J,V));
+      PetscCall(EPSCISSDotQuadrature(eps,V,Mu));
+      PetscCall(CISS_BlockHankel(Mu,0,ctx->L,ctx->M,H0));
+      PetscCall(PetscLogEventBegin(EPS_CISS_SVD,eps,0,0,0));
+      PetscCall(SlepcCISS_BH_SVD(H0,ctx->L*ctx->M,ctx->delta,ctx->sigma,&nv));
+      PetscCall(PetscLogEventEnd(EPS_CISS_SVD,eps,0,0,0));
+      error = 0.0; norm = 0.0;
+      for (i=0;i<ctx->L*ctx->L*ctx->M*2;i++) {
+        error = PetscMax(error,PetscAbsScalar(Mu[i]-Mu0[i]));
+        norm  = PetscMax(norm,PetscAbsScalar(Mu[i]));
+      }
+      if (norm>0.0) error /= norm;
+      PetscCall(PetscInfo(eps,"Refined quadrature with %" PetscInt_FMT " points: rank %" PetscInt_FMT " -> %" PetscInt_FMT ", relative change of the moments %g\n",ctx->useconj?2*contour->npoints:contour->npoints,nv0,nv,(double)error));
+      if ((nv==nv0 && nv<ctx->L*ctx->M) || error<=eps->tol) break;
+    }
+    PetscCall(PetscFree(Mu0));
+  }
   if (ctx->extraction == EPS_CISS_EXTRACTION_HANKEL) PetscCall(PetscMalloc1(ctx->L*ctx->M*ctx->L*ctx->M,&H1));
 
   while (eps->reason == EPS_CONVERGED_ITERATING) {
     eps->its++;
     for (inner=0;inner<=ctx->refine_inner;inner++) {
       if (ctx->extraction == EPS_CISS_EXTRACTION_HANKEL) {
-        PetscCall(BVDotQuadrature(ctx->Y,(contour->pA)?ctx->pV:ctx->V,Mu,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->subcomm,contour->npoints,ctx->useconj));
+        PetscCall(EPSCISSDotQuadrature(eps,V,Mu));
         PetscCall(CISS_BlockHankel(Mu,0,ctx->L,ctx->M,H0));
         PetscCall(PetscLogEventBegin(EPS_CISS_SVD,eps,0,0,0));
         PetscCall(SlepcCISS_BH_SVD(H0,ctx->L*ctx->M,ctx->delta,ctx->sigma,&nv));
         PetscCall(PetscLogEventEnd(EPS_CISS_SVD,eps,0,0,0));
         break;
       } else {
-        PetscCall(BVSumQuadrature(ctx->S,ctx->Y,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->scatterin,contour->subcomm,contour->npoints,ctx->useconj));
+        PetscCall(EPSCISSSumQuadrature(eps));
         PetscCall(BVSetActiveColumns(ctx->S,0,ctx->L));
         PetscCall(BVSetActiveColumns(ctx->V,0,ctx->L));
         PetscCall(BVCopy(ctx->S,ctx->V));
-        PetscCall(BVSVDAndRank(ctx->S,ctx->M,ctx->L,ctx->delta,BV_SVD_METHOD_REFINE,H0,ctx->sigma,&nv));
+        PetscCall(BVSVDAndRank(ctx->S,ctx->M,ctx->L,ctx->delta,ctx->randsvd?BV_SVD_METHOD_RANDOM:BV_SVD_METHOD_REFINE,H0,ctx->sigma,&nv));
         if (ctx->sigma[0]>ctx->delta && nv==ctx->L*ctx->M && inner!=ctx->refine_inner) {
           if (contour->pA) PetscCall(BVScatter(ctx->V,ctx->pV,contour->scatterin,contour->xdup));
-          PetscCall(EPSCISSSolve(eps,J,V,0,ctx->L));
+          PetscCall(EPSCISSSolve(eps,J,V,0,0,ctx->L));
         } else break;
       }
     }
@@ -555,7 +1179,7 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
       PetscCall(PetscFree3(fl1,inside,rr));
       PetscCall(BVSetActiveColumns(eps->V,0,nv));
       if (ctx->extraction == EPS_CISS_EXTRACTION_HANKEL) {
-        PetscCall(BVSumQuadrature(ctx->S,ctx->Y,ctx->M,ctx->L,ctx->L,ctx->weight,ctx->pp,contour->scatterin,contour->subcomm,contour->npoints,ctx->useconj));
+        PetscCall(EPSCISSSumQuadrature(eps));
         PetscCall(BVSetActiveColumns(ctx->S,0,ctx->L));
         PetscCall(BVCopy(ctx->S,ctx->V));
         PetscCall(BVSetActiveColumns(ctx->S,0,nv));
@@ -610,12 +1234,16 @@ static PetscErrorCode EPSSolve_CISS(EPS eps)
         PetscCall(BVSetActiveColumns(ctx->V,0,ctx->L));
         PetscCall(BVCopy(ctx->S,ctx->V));
         if (contour->pA) PetscCall(BVScatter(ctx->V,ctx->pV,contour->scatterin,contour->xdup));
-        PetscCall(EPSCISSSolve(eps,J,V,0,ctx->L));
+        PetscCall(EPSCISSSolve(eps,J,V,0,0,ctx->L));
       }
     }
   }
   if (ctx->extraction == EPS_CISS_EXTRACTION_HANKEL) PetscCall(PetscFree(H1));
   PetscCall(PetscFree2(Mu,H0));
+  if (contour->npoints!=npoints) {  /* the next solve starts again with the coarse rule */
+    contour->npoints = npoints;
+    PetscCall(BVResize(ctx->Y,npoints*ctx->L,PETSC_FALSE));
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -626,6 +1254,7 @@ static PetscErrorCode EPSComputeVectors_CISS(EPS eps)
   Mat            Z,B=NULL;
 
   PetscFunctionBegin;
+  if (ctx->nsub>1) PetscFunctionReturn(PETSC_SUCCESS);  /* eigenvectors gathered from the subregion solvers */
   if (eps->ishermitian) {
     if (eps->isgeneralized && !eps->ispositive) PetscCall(EPSComputeVectors_Indefinite(eps));
     else PetscCall(EPSComputeVectors_Hermitian(eps));
@@ -729,6 +1358,7 @@ static PetscErrorCode EPSCISSSetSizes_CISS(EPS eps,PetscInt ip,PetscInt bs,Petsc
 .  -eps_ciss_blocksize - Sets the block size
 .  -eps_ciss_moments - Sets the moment size
 .  -eps_ciss_partitions - Sets the number of partitions
+.  -eps_ciss_partitions_node_aware - Aligns the partitions with the shared-memory nodes
 .  -eps_ciss_maxblocksize - Sets the maximum block size
 -  -eps_ciss_realmats - A and B are real
 
@@ -739,6 +1369,9 @@ static PetscErrorCode EPSCISSSetSizes_CISS(EPS eps,PetscInt ip,PetscInt bs,Petsc
    The default number of partitions is 1. This means the internal KSP object is shared
    among all processes of the EPS communicator. Otherwise, the communicator is split
    into npart communicators, so that npart KSP solves proceed simultaneously.
+   The partitions are interlaced by default; with -eps_ciss_partitions_node_aware the
+   processes of each partition are taken from the same shared-memory node as much as
+   possible, so that the communication within the partitions stays inside the nodes.
 
    Level: advanced
 
@@ -976,6 +1609,192 @@ PetscErrorCode EPSCISSGetRefinement(EPS eps, PetscInt *inner, PetscInt *blsize)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSCISSSetQuadRefinement_CISS(EPS eps,PetscInt nref)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  if (nref == PETSC_DETERMINE) nref = 0;
+  else if (nref == PETSC_CURRENT) nref = ctx->refine_quad;
+  PetscCheck(nref>=0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The nref argument must be >= 0");
+  if (ctx->refine_quad != nref) {
+    ctx->refine_quad = nref;
+    eps->state       = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSSetQuadRefinement - Sets the maximum number of refinements of the
+   quadrature rule in the CISS solver.
+
+   Logically Collective
+
+   Input Parameters:
++  eps  - the eigenproblem solver context
+-  nref - maximum number of refinements of the quadrature rule
+
+   Options Database Key:
+.  -eps_ciss_quad_refine <nref> - Sets the maximum number of refinements
+
+   Notes:
+   The solver starts with the number of integration points set in EPSCISSSetSizes(),
+   and each refinement triples the number of points. The new rule contains the
+   points of the previous one, so only the linear systems at the new points are
+   solved. Refinement stops when the numerical rank of the block Hankel matrix of
+   moments does not change, or when the relative change of the moments is below
+   the tolerance.
+
+   Refinement is available for elliptic regions or the Chebyshev quadrature rule,
+   and requires that the ST object is used for the linear solves, see EPSCISSSetUseST().
+
+   PETSC_CURRENT can be used to preserve the current value, and PETSC_DETERMINE
+   to set it to a default of 0 (no refinement).
+
+   Level: advanced
+
+.seealso: EPSCISSGetQuadRefinement(), EPSCISSSetSizes(), EPSCISSSetQuadRule()
+@*/
+PetscErrorCode EPSCISSSetQuadRefinement(EPS eps,PetscInt nref)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,nref,2);
+  PetscTryMethod(eps,"EPSCISSSetQuadRefinement_C",(EPS,PetscInt),(eps,nref));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSGetQuadRefinement_CISS(EPS eps,PetscInt *nref)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  *nref = ctx->refine_quad;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSGetQuadRefinement - Gets the maximum number of refinements of the
+   quadrature rule in the CISS solver.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  nref - maximum number of refinements of the quadrature rule
+
+   Level: advanced
+
+.seealso: EPSCISSSetQuadRefinement()
+@*/
+PetscErrorCode EPSCISSGetQuadRefinement(EPS eps,PetscInt *nref)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(nref,2);
+  PetscUseMethod(eps,"EPSCISSGetQuadRefinement_C",(EPS,PetscInt*),(eps,nref));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSSetSubregions_CISS(EPS eps,PetscInt nsub)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  if (nsub == PETSC_DETERMINE) nsub = 1;
+  else if (nsub == PETSC_CURRENT) nsub = ctx->nsub;
+  PetscCheck(nsub>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The nsub argument must be > 0");
+  if (ctx->nsub != nsub) {
+    ctx->nsub  = nsub;
+    eps->state = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSSetSubregions - Sets the number of subregions in which the region
+   is split, each of them solved by an independent CISS solver.
+
+   Logically Collective
+
+   Input Parameters:
++  eps  - the eigenproblem solver context
+-  nsub - number of subregions
+
+   Options Database Key:
+.  -eps_ciss_subregions <nsub> - Sets the number of subregions
+
+   Notes:
+   If nsub>1, the region is divided with RGSplit() and the subregions are
+   distributed in a round-robin fashion among the partitions set in EPSCISSSetSizes(),
+   so that each partition solves its subregions with redundant copies of the
+   matrices, instead of sharing the integration points of a single contour.
+   This is a form of spectrum slicing that does not require the inertia of the
+   matrices, so it can be used in non-Hermitian problems. The solver of each
+   subregion estimates the number of eigenvalues inside its contour with a
+   stochastic estimate of the trace of the spectral projector, and adjusts its
+   block size accordingly.
+
+   The subregion solvers inherit the parameters of eps, and their options can
+   be set with the prefix -sub_ (e.g., -sub_st_pc_type). The computed eigenpairs
+   are gathered in eps, so that they can be retrieved with EPSGetEigenpair() as
+   usual.
+
+   The region must be an ellipse, a ring or an interval (in real scalars, an
+   interval only, since the subregions of an ellipse are rings).
+
+   PETSC_CURRENT can be used to preserve the current value, and PETSC_DETERMINE
+   to set it to a default of 1 (no split).
+
+   Level: advanced
+
+.seealso: EPSCISSGetSubregions(), EPSCISSSetSizes(), RGSplit()
+@*/
+PetscErrorCode EPSCISSSetSubregions(EPS eps,PetscInt nsub)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,nsub,2);
+  PetscTryMethod(eps,"EPSCISSSetSubregions_C",(EPS,PetscInt),(eps,nsub));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSGetSubregions_CISS(EPS eps,PetscInt *nsub)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  *nsub = ctx->nsub;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSGetSubregions - Gets the number of subregions in which the region
+   is split in the CISS solver.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  nsub - number of subregions
+
+   Level: advanced
+
+.seealso: EPSCISSSetSubregions()
+@*/
+PetscErrorCode EPSCISSGetSubregions(EPS eps,PetscInt *nsub)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(nsub,2);
+  PetscUseMethod(eps,"EPSCISSGetSubregions_C",(EPS,PetscInt*),(eps,nsub));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSCISSSetUseST_CISS(EPS eps,PetscBool usest)
 {
   EPS_CISS *ctx = (EPS_CISS*)eps->data;
@@ -1047,14 +1866,180 @@ PetscErrorCode EPSCISSGetUseST(EPS eps,PetscBool *usest)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSCISSSetLowMemory_CISS(EPS eps,PetscBool lowmem)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  if (ctx->lowmem != lowmem) {
+    ctx->lowmem = lowmem;
+    eps->state  = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSSetLowMemory - Sets a flag to accumulate the moments of the CISS
+   solver without storing the solutions of the linear systems at all
+   integration points.
+
+   Logically Collective
+
+   Input Parameters:
++  eps    - the eigenproblem solver context
+-  lowmem - boolean flag to activate the low-memory mode
+
+   Options Database Keys:
+.  -eps_ciss_low_memory <bool> - whether the low-memory mode is used or not
+
+   Notes:
+   By default, the solutions of the linear systems at all integration points
+   are stored, which requires L*N vectors, where L is the block size and N is
+   the number of integration points (see EPSCISSSetSizes()). In the low-memory
+   mode, the solution at each integration point is added to the moments right
+   after it is computed and then discarded, so that only L*M vectors are needed
+   for the moments, plus L for the solutions at the current point.
+
+   The downside is that when the block size is increased (see EPSCISSSetRefinement())
+   the linear systems must be solved again for all the columns, not only for the
+   new ones. Refinement of the quadrature rule (EPSCISSSetQuadRefinement()) is not
+   available in this mode.
+
+   Level: advanced
+
+.seealso: EPSCISSGetLowMemory(), EPSCISSSetSizes()
+@*/
+PetscErrorCode EPSCISSSetLowMemory(EPS eps,PetscBool lowmem)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,lowmem,2);
+  PetscTryMethod(eps,"EPSCISSSetLowMemory_C",(EPS,PetscBool),(eps,lowmem));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSGetLowMemory_CISS(EPS eps,PetscBool *lowmem)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  *lowmem = ctx->lowmem;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSGetLowMemory - Gets the flag for the low-memory mode of the
+   CISS solver.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameters:
+.  lowmem - boolean flag indicating if the low-memory mode is used
+
+   Level: advanced
+
+.seealso: EPSCISSSetLowMemory()
+@*/
+PetscErrorCode EPSCISSGetLowMemory(EPS eps,PetscBool *lowmem)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(lowmem,2);
+  PetscUseMethod(eps,"EPSCISSGetLowMemory_C",(EPS,PetscBool*),(eps,lowmem));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSSetRandomizedSVD_CISS(EPS eps,PetscBool randsvd)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  ctx->randsvd = randsvd;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSSetRandomizedSVD - Sets a flag to compute the SVD of the moments with
+   a randomized range finder in the CISS solver.
+
+   Logically Collective
+
+   Input Parameters:
++  eps     - the eigenproblem solver context
+-  randsvd - boolean flag to activate the randomized SVD
+
+   Options Database Keys:
+.  -eps_ciss_randomized_svd <bool> - whether the randomized SVD is used or not
+
+   Notes:
+   In the Rayleigh-Ritz extraction, the numerical rank of the L*M moment vectors
+   is determined from their SVD, computed by default from the cross product matrix
+   with refinement (BV_SVD_METHOD_REFINE), whose cost is proportional to (L*M)^2
+   per row. When the number of eigenvalues inside the region is much smaller than
+   L*M, the randomized variant (BV_SVD_METHOD_RANDOM) is cheaper, since it works
+   with a sketch of the moments whose size is adapted to the rank. See BVSVDAndRank().
+
+   This flag has no effect in the Hankel extraction.
+
+   Level: advanced
+
+.seealso: EPSCISSGetRandomizedSVD(), EPSCISSSetExtraction(), BVSVDAndRank()
+@*/
+PetscErrorCode EPSCISSSetRandomizedSVD(EPS eps,PetscBool randsvd)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,randsvd,2);
+  PetscTryMethod(eps,"EPSCISSSetRandomizedSVD_C",(EPS,PetscBool),(eps,randsvd));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSCISSGetRandomizedSVD_CISS(EPS eps,PetscBool *randsvd)
+{
+  EPS_CISS *ctx = (EPS_CISS*)eps->data;
+
+  PetscFunctionBegin;
+  *randsvd = ctx->randsvd;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSCISSGetRandomizedSVD - Gets the flag for the randomized SVD of the moments
+   in the CISS solver.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameters:
+.  randsvd - boolean flag indicating if the randomized SVD is used
+
+   Level: advanced
+
+.seealso: EPSCISSSetRandomizedSVD()
+@*/
+PetscErrorCode EPSCISSGetRandomizedSVD(EPS eps,PetscBool *randsvd)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(randsvd,2);
+  PetscUseMethod(eps,"EPSCISSGetRandomizedSVD_C",(EPS,PetscBool*),(eps,randsvd));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSCISSSetQuadRule_CISS(EPS eps,EPSCISSQuadRule quad)
 {
   EPS_CISS *ctx = (EPS_CISS*)eps->data;
 
   PetscFunctionBegin;
   if (ctx->quad != quad) {
-    ctx->quad  = quad;
-    eps->state = EPS_STATE_INITIAL;
+    ctx->quad     = quad;
+    ctx->kspvalid = PETSC_FALSE;
+    eps->state    = EPS_STATE_INITIAL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1261,6 +2246,11 @@ static PetscErrorCode EPSCISSGetKSPs_CISS(EPS eps,PetscInt *nsolve,KSP **ksp)
    the number of partitions. This value is halved in the case of real matrices with
    a region centered at the real axis.
 
+   In complex scalars, if the problem is Hermitian and the region is symmetric with
+   respect to the real axis, the solutions at a pair of conjugate points are computed
+   with the same linear solver, one of them with a transposed solve that reuses the
+   factorization. In that case only the first half of the KSP objects are used.
+
    Level: advanced
 
 .seealso: EPSCISSSetSizes()
@@ -1276,20 +2266,27 @@ PetscErrorCode EPSCISSGetKSPs(EPS eps,PetscInt *nsolve,KSP **ksp)
 static PetscErrorCode EPSReset_CISS(EPS eps)
 {
   EPS_CISS       *ctx = (EPS_CISS*)eps->data;
+  PetscInt       i;
 
   PetscFunctionBegin;
   PetscCall(BVDestroy(&ctx->S));
   PetscCall(BVDestroy(&ctx->V));
   PetscCall(BVDestroy(&ctx->Y));
-  if (!ctx->usest) PetscCall(SlepcContourDataReset(ctx->contour));
+  if (ctx->contour && (!ctx->usest || ctx->nsub>1)) PetscCall(SlepcContourDataReset(ctx->contour));
   PetscCall(BVDestroy(&ctx->pV));
+  PetscCall(BVDestroy(&ctx->pS));
+  PetscCall(PetscFree(ctx->Mu));
+  ctx->kspvalid = PETSC_FALSE;
+  for (i=0;i<ctx->nsubeps;i++) PetscCall(EPSDestroy(&ctx->subeps[i]));
+  PetscCall(PetscFree(ctx->subeps));
+  ctx->nsubeps = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode EPSSetFromOptions_CISS(EPS eps,PetscOptionItems *PetscOptionsObject)
 {
   PetscReal         r3,r4;
-  PetscInt          i,i1,i2,i3,i4,i5,i6,i7;
+  PetscInt          i,i1,i2,i3,i4,i5,i6,i7,i8,i9;
   PetscBool         b1,b2,flg,flg2,flg3,flg4,flg5,flg6;
   EPS_CISS          *ctx = (EPS_CISS*)eps->data;
   EPSCISSQuadRule   quad;
@@ -1317,10 +2314,26 @@ static PetscErrorCode EPSSetFromOptions_CISS(EPS eps,PetscOptionItems *PetscOpti
     PetscCall(PetscOptionsInt("-eps_ciss_refine_blocksize","Number of blocksize iterative refinement iterations","EPSCISSSetRefinement",i7,&i7,&flg2));
     if (flg || flg2) PetscCall(EPSCISSSetRefinement(eps,i6,i7));
 
+    PetscCall(EPSCISSGetQuadRefinement(eps,&i8));
+    PetscCall(PetscOptionsInt("-eps_ciss_quad_refine","Maximum number of refinements of the quadrature rule","EPSCISSSetQuadRefinement",i8,&i8,&flg));
+    if (flg) PetscCall(EPSCISSSetQuadRefinement(eps,i8));
+
+    PetscCall(EPSCISSGetSubregions(eps,&i9));
+    PetscCall(PetscOptionsInt("-eps_ciss_subregions","Number of subregions solved independently","EPSCISSSetSubregions",i9,&i9,&flg));
+    if (flg) PetscCall(EPSCISSSetSubregions(eps,i9));
+
     PetscCall(EPSCISSGetUseST(eps,&b2));
     PetscCall(PetscOptionsBool("-eps_ciss_usest","Use ST for linear solves","EPSCISSSetUseST",b2,&b2,&flg));
     if (flg) PetscCall(EPSCISSSetUseST(eps,b2));
 
+    PetscCall(EPSCISSGetLowMemory(eps,&b2));
+    PetscCall(PetscOptionsBool("-eps_ciss_low_memory","Accumulate the moments without storing all the solutions","EPSCISSSetLowMemory",b2,&b2,&flg));
+    if (flg) PetscCall(EPSCISSSetLowMemory(eps,b2));
+
+    PetscCall(EPSCISSGetRandomizedSVD(eps,&b2));
+    PetscCall(PetscOptionsBool("-eps_ciss_randomized_svd","Use a randomized range finder for the SVD of the moments","EPSCISSSetRandomizedSVD",b2,&b2,&flg));
+    if (flg) PetscCall(EPSCISSSetRandomizedSVD(eps,b2));
+
     PetscCall(PetscOptionsEnum("-eps_ciss_quadrule","Quadrature rule","EPSCISSSetQuadRule",EPSCISSQuadRules,(PetscEnum)ctx->quad,(PetscEnum*)&quad,&flg));
     if (flg) PetscCall(EPSCISSSetQuadRule(eps,quad));
 
@@ -1352,8 +2365,16 @@ static PetscErrorCode EPSDestroy_CISS(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetThreshold_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetRefinement_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetRefinement_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetQuadRefinement_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetQuadRefinement_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetSubregions_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetSubregions_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetUseST_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetUseST_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetLowMemory_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetLowMemory_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetRandomizedSVD_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetRandomizedSVD_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetQuadRule_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetQuadRule_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetExtraction_C",NULL));
@@ -1375,9 +2396,13 @@ static PetscErrorCode EPSView_CISS(EPS eps,PetscViewer viewer)
     if (ctx->isreal) PetscCall(PetscViewerASCIIPrintf(viewer,"  exploiting symmetry of integration points\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  threshold { delta: %g, spurious threshold: %g }\n",(double)ctx->delta,(double)ctx->spurious_threshold));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  iterative refinement { inner: %" PetscInt_FMT ", blocksize: %" PetscInt_FMT " }\n",ctx->refine_inner, ctx->refine_blocksize));
+    if (ctx->refine_quad) PetscCall(PetscViewerASCIIPrintf(viewer,"  quadrature refinement: up to %" PetscInt_FMT " levels\n",ctx->refine_quad));
+    if (ctx->lowmem) PetscCall(PetscViewerASCIIPrintf(viewer,"  low-memory accumulation of the moments\n"));
+    if (ctx->randsvd && ctx->extraction == EPS_CISS_EXTRACTION_RITZ) PetscCall(PetscViewerASCIIPrintf(viewer,"  randomized SVD of the moments\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  extraction: %s\n",EPSCISSExtractions[ctx->extraction]));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  quadrature rule: %s\n",EPSCISSQuadRules[ctx->quad]));
-    if (ctx->usest) PetscCall(PetscViewerASCIIPrintf(viewer,"  using ST for linear solves\n"));
+    if (ctx->nsub>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  split into %" PetscInt_FMT " subregions solved independently\n",ctx->nsub));
+    else if (ctx->usest) PetscCall(PetscViewerASCIIPrintf(viewer,"  using ST for linear solves\n"));
     else {
       if (!ctx->contour || !ctx->contour->ksp) PetscCall(EPSCISSGetKSPs(eps,NULL,NULL));
       PetscAssert(ctx->contour && ctx->contour->ksp,PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"Something went wrong with EPSCISSGetKSPs()");
@@ -1406,7 +2431,7 @@ static PetscErrorCode EPSSetDefaultST_CISS(EPS eps)
   PetscFunctionBegin;
   if (!((PetscObject)eps->st)->type_name) {
     if (!ctx->usest_set) usest = (ctx->npart>1)? PETSC_FALSE: PETSC_TRUE;
-    if (usest) PetscCall(STSetType(eps->st,STSINVERT));
+    if (usest && ctx->nsub==1) PetscCall(STSetType(eps->st,STSINVERT));
     else {
       /* we are not going to use ST, so avoid factorizing the matrix */
       PetscCall(STSetType(eps->st,STSHIFT));
@@ -1447,8 +2472,16 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_CISS(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetThreshold_C",EPSCISSGetThreshold_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetRefinement_C",EPSCISSSetRefinement_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetRefinement_C",EPSCISSGetRefinement_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetQuadRefinement_C",EPSCISSSetQuadRefinement_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetQuadRefinement_C",EPSCISSGetQuadRefinement_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetSubregions_C",EPSCISSSetSubregions_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetSubregions_C",EPSCISSGetSubregions_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetUseST_C",EPSCISSSetUseST_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetUseST_C",EPSCISSGetUseST_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetLowMemory_C",EPSCISSSetLowMemory_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetLowMemory_C",EPSCISSGetLowMemory_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetRandomizedSVD_C",EPSCISSSetRandomizedSVD_CISS));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetRandomizedSVD_C",EPSCISSGetRandomizedSVD_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetQuadRule_C",EPSCISSSetQuadRule_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSGetQuadRule_C",EPSCISSGetQuadRule_CISS));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSCISSSetExtraction_C",EPSCISSSetExtraction_CISS));
@@ -1467,7 +2500,9 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_CISS(EPS eps)
   ctx->isreal             = PETSC_FALSE;
   ctx->refine_inner       = 0;
   ctx->refine_blocksize   = 0;
+  ctx->refine_quad        = 0;
   ctx->npart              = 1;
+  ctx->nsub               = 1;
   ctx->quad               = (EPSCISSQuadRule)0;
   ctx->extraction         = EPS_CISS_EXTRACTION_RITZ;
   PetscFunctionReturn(PETSC_SUCCESS);
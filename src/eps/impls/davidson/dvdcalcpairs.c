@@ -221,7 +221,7 @@ static inline PetscErrorCode dvd_calcpairs_updateBV0_gen(dvdDashboard *d,BV bv,D
 static PetscErrorCode dvd_calcpairs_proj(dvdDashboard *d)
 {
   PetscInt       i,l,k;
-  Vec            v1,v2;
+  Vec            v1;
   PetscScalar    *pv;
 
   PetscFunctionBegin;
@@ -254,25 +254,20 @@ static PetscErrorCode dvd_calcpairs_proj(dvdDashboard *d)
     /* 3. AV <- [AV A * V(V_new_s:V_new_e-1)] */
     /* Check consistency */
     PetscAssert(k-l==d->V_new_s,PETSC_COMM_SELF,PETSC_ERR_PLIB,"Consistency broken");
-    for (i=l+d->V_new_s;i<l+d->V_new_e;i++) {
-      PetscCall(BVGetColumn(d->eps->V,i,&v1));
-      PetscCall(BVGetColumn(d->AX,i,&v2));
-      PetscCall(MatMult(d->A,v1,v2));
-      PetscCall(BVRestoreColumn(d->eps->V,i,&v1));
-      PetscCall(BVRestoreColumn(d->AX,i,&v2));
-    }
+    /* the whole block of new vectors is multiplied at once, so that the matrix is read only once */
+    PetscCall(BVSetActiveColumns(d->eps->V,l+d->V_new_s,l+d->V_new_e));
+    PetscCall(BVSetActiveColumns(d->AX,l+d->V_new_s,l+d->V_new_e));
+    PetscCall(BVMatMult(d->eps->V,d->A,d->AX));
+    PetscCall(BVSetActiveColumns(d->AX,l,k));
     /* 4. BV <- [BV B * V(V_new_s:V_new_e-1)] */
     if (d->BX) {
       /* Check consistency */
       PetscAssert(k-l==d->V_new_s,PETSC_COMM_SELF,PETSC_ERR_PLIB,"Consistency broken");
-      for (i=l+d->V_new_s;i<l+d->V_new_e;i++) {
-        PetscCall(BVGetColumn(d->eps->V,i,&v1));
-        PetscCall(BVGetColumn(d->BX,i,&v2));
-        PetscCall(MatMult(d->B,v1,v2));
-        PetscCall(BVRestoreColumn(d->eps->V,i,&v1));
-        PetscCall(BVRestoreColumn(d->BX,i,&v2));
-      }
+      PetscCall(BVSetActiveColumns(d->BX,l+d->V_new_s,l+d->V_new_e));
+      PetscCall(BVMatMult(d->eps->V,d->B,d->BX));
+      PetscCall(BVSetActiveColumns(d->BX,l,k));
     }
+    PetscCall(BVSetActiveColumns(d->eps->V,l,k));
     /* 5. W <- [W f(AV,BV)] */
     if (d->W) {
       PetscCall(d->calcpairs_W(d));
@@ -51,6 +51,9 @@ static PetscErrorCode dvd_improvex_gd2_gen(dvdDashboard *d,PetscInt r_s,PetscInt
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* Update the deflation space of the preconditioner */
+  PetscCall(dvd_static_precond_PC_update(d));
+
   PetscCall(BVDuplicateResize(d->eps->V,4,&X));
   PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,4,2,NULL,&M));
 
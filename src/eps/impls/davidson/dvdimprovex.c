@@ -600,6 +600,9 @@ static PetscErrorCode dvd_improvex_jd_gen(dvdDashboard *d,PetscInt r_s,PetscInt
 
   PetscCall(DSGetLeadingDimension(d->eps->ds,&ld));
 
+  /* Update the deflation space of the preconditioner */
+  PetscCall(dvd_static_precond_PC_update(d));
+
   /* Restart lastTol if a new pair converged */
   if (data->dynamic && data->size_cX < lV)
     data->lastTol = 0.5;
@@ -16,7 +16,8 @@
 #include "davidson.h"
 
 typedef struct {
-  PC pc;
+  PC        pc;
+  PetscBool deflation;   /* the preconditioner is projected against the locked vectors */
 } dvdPCWrapper;
 
 /*
@@ -57,7 +58,22 @@ static PetscErrorCode dvd_static_precond_PC_0(dvdDashboard *d,PetscInt i,Vec x,V
   dvdPCWrapper   *dvdpc = (dvdPCWrapper*)d->improvex_precond_data;
 
   PetscFunctionBegin;
-  PetscCall(PCApply(dvdpc->pc,x,Px));
+  if (dvdpc->deflation) PetscCall(STPrecondApplyDeflated(d->eps->st,dvdpc->pc,x,Px));
+  else PetscCall(PCApply(dvdpc->pc,x,Px));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Update the deflation space of the preconditioner with the locked vectors,
+  if the preconditioner is projected (see STPrecondSetDeflation())
+*/
+PetscErrorCode dvd_static_precond_PC_update(dvdDashboard *d)
+{
+  dvdPCWrapper   *dvdpc = (dvdPCWrapper*)d->improvex_precond_data;
+
+  PetscFunctionBegin;
+  if (d->improvex_precond != dvd_static_precond_PC_0 || !dvdpc->deflation) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(STPrecondUpdateDeflation(d->eps->st,dvdpc->pc,d->eps->V));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -88,6 +104,8 @@ PetscErrorCode dvd_static_precond_PC(dvdDashboard *d,dvdBlackboard *b,PC pc)
       PetscCall(PetscNew(&dvdpc));
       dvdpc->pc = pc;
       PetscCall(PetscObjectReference((PetscObject)pc));
+      PetscCall(PetscObjectTypeCompare((PetscObject)d->eps->st,STPRECOND,&t0));
+      if (t0) PetscCall(STPrecondGetDeflation(d->eps->st,&dvdpc->deflation));
       d->improvex_precond_data = dvdpc;
       d->improvex_precond = dvd_static_precond_PC_0;
 
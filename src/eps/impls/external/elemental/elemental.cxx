@@ -9,6 +9,12 @@
 */
 /*
    This file implements a wrapper to eigensolvers in Elemental.
+
+   Memory usage: the matrices are copied to the element-wise distribution of Elemental
+   at the beginning of each solve, since the solver overwrites them, and these copies
+   are freed before the eigenvectors are redistributed to the BV. Hence, apart from the
+   user matrices and the BV, at most two (three in generalized problems) full matrices
+   are allocated, the last one for the eigenvectors, and none is kept after the solve.
 */
 
 #include <slepc/private/epsimpl.h>    /*I "slepceps.h" I*/
@@ -20,11 +26,7 @@ typedef struct {
 
 static PetscErrorCode EPSSetUp_Elemental(EPS eps)
 {
-  EPS_Elemental  *ctx = (EPS_Elemental*)eps->data;
-  Mat            A,B;
-  PetscInt       nmat;
   PetscBool      isshift;
-  PetscScalar    shift;
 
   PetscFunctionBegin;
   EPSCheckHermitianDefinite(eps);
@@ -39,8 +41,21 @@ static PetscErrorCode EPSSetUp_Elemental(EPS eps)
   EPSCheckUnsupported(eps,EPS_FEATURE_BALANCE | EPS_FEATURE_ARBITRARY | EPS_FEATURE_REGION | EPS_FEATURE_STOPPING);
   EPSCheckIgnored(eps,EPS_FEATURE_EXTRACTION | EPS_FEATURE_CONVERGENCE);
   PetscCall(EPSAllocateSolution(eps,0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  /* convert matrices */
+/*
+   Copies the matrices to the distribution of Elemental, the solver overwrites them so
+   they cannot be shared with the user matrices even if these are already of this type
+*/
+static PetscErrorCode EPSElementalConvertMatrices(EPS eps)
+{
+  EPS_Elemental  *ctx = (EPS_Elemental*)eps->data;
+  Mat            A,B;
+  PetscInt       nmat;
+  PetscScalar    shift;
+
+  PetscFunctionBegin;
   PetscCall(MatDestroy(&ctx->Ae));
   PetscCall(MatDestroy(&ctx->Be));
   PetscCall(STGetNumMatrices(eps->st,&nmat));
@@ -61,11 +76,15 @@ static PetscErrorCode EPSSetUp_Elemental(EPS eps)
 static PetscErrorCode EPSSolve_Elemental(EPS eps)
 {
   EPS_Elemental  *ctx = (EPS_Elemental*)eps->data;
-  Mat            A = ctx->Ae,B = ctx->Be,Q,V;
-  Mat_Elemental  *a = (Mat_Elemental*)A->data,*b,*q;
+  Mat            A,B,Q,V;
+  Mat_Elemental  *a,*b,*q;
   PetscInt       i,rrank,ridx,erow;
 
   PetscFunctionBegin;
+  PetscCall(EPSElementalConvertMatrices(eps));
+  A = ctx->Ae;
+  B = ctx->Be;
+  a = (Mat_Elemental*)A->data;
   El::DistMatrix<PetscReal,El::VR,El::STAR> w(*a->grid);
   PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
   q = (Mat_Elemental*)Q->data;
@@ -80,6 +99,10 @@ static PetscErrorCode EPSSolve_Elemental(EPS eps)
     RO2E(A,0,rrank,ridx,&erow);
     eps->eigr[i] = w.Get(erow,0);
   }
+
+  /* the contents of the converted matrices have been overwritten, free them before redistributing Q */
+  PetscCall(MatDestroy(&ctx->Ae));
+  PetscCall(MatDestroy(&ctx->Be));
   PetscCall(BVGetMat(eps->V,&V));
   PetscCall(MatConvert(Q,MATDENSE,MAT_REUSE_MATRIX,&V));
   PetscCall(BVRestoreMat(eps->V,&V));
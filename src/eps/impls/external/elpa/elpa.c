@@ -9,6 +9,12 @@
 */
 /*
    This file implements a wrapper to eigensolvers in ELPA.
+
+   Memory usage: the matrices are copied to the block-cyclic distribution of ScaLAPACK
+   at the beginning of each solve, since the solver overwrites them, and these copies
+   are freed before the eigenvectors are redistributed to the BV. Hence, apart from the
+   user matrices and the BV, at most two (three in generalized problems) full matrices
+   are allocated, the last one for the eigenvectors, and none is kept after the solve.
 */
 
 #include <slepc/private/epsimpl.h>    /*I "slepceps.h" I*/
@@ -44,11 +50,7 @@ typedef struct {
 
 static PetscErrorCode EPSSetUp_ELPA(EPS eps)
 {
-  EPS_ELPA       *ctx = (EPS_ELPA*)eps->data;
-  Mat            A,B;
-  PetscInt       nmat;
   PetscBool      isshift;
-  PetscScalar    shift;
 
   PetscFunctionBegin;
   EPSCheckHermitianDefinite(eps);
@@ -63,8 +65,21 @@ static PetscErrorCode EPSSetUp_ELPA(EPS eps)
   EPSCheckUnsupported(eps,EPS_FEATURE_BALANCE | EPS_FEATURE_ARBITRARY | EPS_FEATURE_REGION | EPS_FEATURE_STOPPING);
   EPSCheckIgnored(eps,EPS_FEATURE_EXTRACTION | EPS_FEATURE_CONVERGENCE);
   PetscCall(EPSAllocateSolution(eps,0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  /* convert matrices */
+/*
+   Copies the matrices to the distribution of ELPA, the solver overwrites them so
+   they cannot be shared with the user matrices even if these are already of this type
+*/
+static PetscErrorCode EPSELPAConvertMatrices(EPS eps)
+{
+  EPS_ELPA       *ctx = (EPS_ELPA*)eps->data;
+  Mat            A,B;
+  PetscInt       nmat;
+  PetscScalar    shift;
+
+  PetscFunctionBegin;
   PetscCall(MatDestroy(&ctx->As));
   PetscCall(MatDestroy(&ctx->Bs));
   PetscCall(STGetNumMatrices(eps->st,&nmat));
@@ -85,13 +100,17 @@ static PetscErrorCode EPSSetUp_ELPA(EPS eps)
 static PetscErrorCode EPSSolve_ELPA(EPS eps)
 {
   EPS_ELPA       *ctx = (EPS_ELPA*)eps->data;
-  Mat            A = ctx->As,B = ctx->Bs,Q,V;
-  Mat_ScaLAPACK  *a = (Mat_ScaLAPACK*)A->data,*b,*q;
+  Mat            A,B,Q,V;
+  Mat_ScaLAPACK  *a,*b,*q;
   PetscReal      *w = eps->errest;  /* used to store real eigenvalues */
   PetscInt       i;
   elpa_t         handle;
 
   PetscFunctionBegin;
+  PetscCall(EPSELPAConvertMatrices(eps));
+  A = ctx->As;
+  B = ctx->Bs;
+  a = (Mat_ScaLAPACK*)A->data;
   PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
   q = (Mat_ScaLAPACK*)Q->data;
 
@@ -124,6 +143,10 @@ static PetscErrorCode EPSSolve_ELPA(EPS eps)
   PetscCallELPA(elpa_deallocate,handle);
   PetscCallELPANOARG(elpa_uninit);
 
+  /* the contents of the converted matrices have been overwritten, free them before redistributing Q */
+  PetscCall(MatDestroy(&ctx->As));
+  PetscCall(MatDestroy(&ctx->Bs));
+
   for (i=0;i<eps->ncv;i++) {
     eps->eigr[i]   = eps->errest[i];
     eps->errest[i] = PETSC_MACHINE_EPSILON;
@@ -213,7 +213,7 @@ PetscErrorCode EPSKrylovConvergence(EPS eps,PetscBool getall,PetscInt kini,Petsc
   Vec            x=NULL,y=NULL,w[3];
 
   PetscFunctionBegin;
-  if (PetscUnlikely(eps->which == EPS_ALL)) {
+  if (PetscUnlikely(eps->which == EPS_ALL || eps->which == EPS_SMALLEST_REAL || eps->which == EPS_LARGEST_REAL)) {
     PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilter));
     if (isfilter) {
       PetscCall(STFilterGetThreshold(eps->st,&gamma));
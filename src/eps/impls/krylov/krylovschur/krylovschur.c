@@ -15,7 +15,7 @@
    Algorithm:
 
        Single-vector Krylov-Schur method for non-symmetric problems,
-       including harmonic extraction.
+       including harmonic extraction. The block variant is in ks-block.c.
 
    References:
 
@@ -30,6 +30,8 @@
 */
 
 #include <slepc/private/epsimpl.h>                /*I "slepceps.h" I*/
+#include <slepc/private/dsimpl.h>
+#include <petsctime.h>
 #include "krylovschur.h"
 
 PetscErrorCode EPSGetArbitraryValues(EPS eps,PetscScalar *rr,PetscScalar *ri)
@@ -62,16 +64,17 @@ static PetscErrorCode EPSSetUp_KrylovSchur_Filter(EPS eps)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
   PetscBool       estimaterange=PETSC_TRUE;
-  PetscReal       rleft,rright;
+  PetscReal       rleft,rright,cut;
   Mat             A;
 
   PetscFunctionBegin;
   EPSCheckHermitianCondition(eps,PETSC_TRUE," with polynomial filter");
   EPSCheckStandardCondition(eps,PETSC_TRUE," with polynomial filter");
-  PetscCheck(eps->intb<PETSC_MAX_REAL || eps->inta>PETSC_MIN_REAL,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The defined computational interval should have at least one of their sides bounded");
+  if (eps->which==EPS_ALL) PetscCheck(eps->intb<PETSC_MAX_REAL || eps->inta>PETSC_MIN_REAL,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The defined computational interval should have at least one of their sides bounded");
+  else PetscCheck(eps->which==EPS_SMALLEST_REAL || eps->which==EPS_LARGEST_REAL,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"With a polynomial filter, only all eigenvalues in an interval or the smallest or largest real eigenvalues can be computed");
   EPSCheckUnsupportedCondition(eps,EPS_FEATURE_ARBITRARY | EPS_FEATURE_REGION | EPS_FEATURE_EXTRACTION,PETSC_TRUE," with polynomial filter");
   if (eps->tol==(PetscReal)PETSC_DETERMINE) eps->tol = SLEPC_DEFAULT_TOL*1e-2;  /* use tighter tolerance */
-  PetscCall(STFilterSetInterval(eps->st,eps->inta,eps->intb));
+  if (eps->which==EPS_ALL) PetscCall(STFilterSetInterval(eps->st,eps->inta,eps->intb));
   if (!ctx->estimatedrange) {
     PetscCall(STFilterGetRange(eps->st,&rleft,&rright));
     estimaterange = (!rleft && !rright)? PETSC_TRUE: PETSC_FALSE;
@@ -83,13 +86,92 @@ static PetscErrorCode EPSSetUp_KrylovSchur_Filter(EPS eps)
     PetscCall(STFilterSetRange(eps->st,rleft,rright));
     ctx->estimatedrange = PETSC_TRUE;
   }
-  if (eps->ncv==PETSC_DETERMINE && eps->nev==1) eps->nev = 40;  /* user did not provide nev estimation */
+  if (eps->which!=EPS_ALL) {
+    /* the wanted end of the spectrum is taken as an interval that would contain
+       twice nev eigenvalues if they were evenly distributed, it is widened in
+       EPSSolve_KrylovSchur_Filter() if it turns out to contain fewer than nev */
+    PetscCall(STFilterGetRange(eps->st,&rleft,&rright));
+    cut = PetscMin(1.0,2.0*eps->nev/eps->n)*(rright-rleft);
+    if (eps->which==EPS_SMALLEST_REAL) PetscCall(STFilterSetInterval(eps->st,rleft,rleft+cut));
+    else PetscCall(STFilterSetInterval(eps->st,rright-cut,rright));
+  } else if (eps->ncv==PETSC_DETERMINE && eps->nev==1) eps->nev = 40;  /* user did not provide nev estimation */
   PetscCall(EPSSetDimensions_Default(eps,eps->nev,&eps->ncv,&eps->mpd));
   PetscCheck(eps->ncv<=eps->nev+eps->mpd,PetscObjectComm((PetscObject)eps),PETSC_ERR_USER_INPUT,"The value of ncv must not be larger than nev+mpd");
   if (eps->max_it==PETSC_DETERMINE) eps->max_it = PetscMax(100,2*eps->n/eps->ncv);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The state at the end of a restart consists of the Rayleigh quotient in the DS
+   and the columns 0:nconv+l of V, the last one being the next Arnoldi vector
+*/
+static PetscErrorCode EPSCheckpoint_KrylovSchur(EPS eps,PetscViewer viewer)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscBool       hermitian;
+
+  PetscFunctionBegin;
+  hermitian = (eps->ishermitian && eps->extraction==EPS_RITZ)?PETSC_TRUE:PETSC_FALSE;
+  PetscCall(PetscViewerBinaryWrite(viewer,&ctx->nkeep,1,PETSC_INT));
+  PetscCall(DSViewMatBinary_Private(eps->ds,hermitian?DS_MAT_T:DS_MAT_A,viewer));
+  PetscCall(BVViewColumns_Private(eps->V,0,eps->nconv+ctx->nkeep+1,viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSRestart_KrylovSchur(EPS eps,PetscViewer viewer)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscBool       hermitian;
+
+  PetscFunctionBegin;
+  hermitian = (eps->ishermitian && eps->extraction==EPS_RITZ)?PETSC_TRUE:PETSC_FALSE;
+  PetscCall(PetscViewerBinaryRead(viewer,&ctx->nkeep,1,NULL,PETSC_INT));
+  PetscCheck(ctx->nkeep>=0 && eps->nconv+ctx->nkeep<eps->ncv,PetscObjectComm((PetscObject)eps),PETSC_ERR_FILE_UNEXPECTED,"Wrong number of kept vectors in the checkpoint");
+  PetscCall(DSLoadMatBinary_Private(eps->ds,hermitian?DS_MAT_T:DS_MAT_A,viewer));
+  PetscCall(BVLoadColumns_Private(eps->V,0,eps->nconv+ctx->nkeep+1,viewer));
+  ctx->resumed = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the smallest or largest eigenvalues with the polynomial filter of the
+   ST, which maps the wanted end of the spectrum to the largest values. If fewer
+   than nev eigenvalues are found in the interval of the filter, the interval is
+   made twice as wide and the computation is repeated
+*/
+static PetscErrorCode EPSSolve_KrylovSchur_Filter(EPS eps)
+{
+  PetscInt  i,nev=eps->nev;
+  PetscReal rleft,rright,inta,intb;
+
+  PetscFunctionBegin;
+  while (PETSC_TRUE) {
+    PetscCall(EPSSolve_KrylovSchur_Default(eps));
+    eps->nev = nev;  /* the convergence test sets nev to the number of eigenvalues in the interval */
+    if (eps->nconv>=nev || eps->reason<0) break;
+    PetscCall(STFilterGetRange(eps->st,&rleft,&rright));
+    PetscCall(STFilterGetInterval(eps->st,&inta,&intb));
+    if (eps->which==EPS_SMALLEST_REAL) {
+      if (intb>=rright) break;
+      intb = PetscMin(rright,rleft+2.0*(intb-rleft));
+    } else {
+      if (inta<=rleft) break;
+      inta = PetscMax(rleft,rright-2.0*(rright-inta));
+    }
+    PetscCall(PetscInfo(eps,"Only %" PetscInt_FMT " eigenvalues found, widening the interval of the filter to [%g,%g]\n",eps->nconv,(double)inta,(double)intb));
+    PetscCall(STFilterSetInterval(eps->st,inta,intb));
+    PetscCall(STSetUp(eps->st));
+    eps->nconv  = 0;
+    eps->reason = EPS_CONVERGED_ITERATING;
+    for (i=0;i<eps->ncv;i++) {
+      eps->eigr[i]   = 0.0;
+      eps->eigi[i]   = 0.0;
+      eps->errest[i] = 0.0;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
 {
   PetscReal         eta;
@@ -97,13 +179,16 @@ static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
   BVOrthogType      otype;
   BVOrthogBlockType obtype;
   EPS_KRYLOVSCHUR   *ctx = (EPS_KRYLOVSCHUR*)eps->data;
-  enum { EPS_KS_DEFAULT,EPS_KS_SYMM,EPS_KS_SLICE,EPS_KS_FILTER,EPS_KS_INDEF,EPS_KS_TWOSIDED } variant;
+  enum { EPS_KS_DEFAULT,EPS_KS_SYMM,EPS_KS_SLICE,EPS_KS_FILTER,EPS_KS_FILTSLICE,EPS_KS_INDEF,EPS_KS_TWOSIDED,EPS_KS_BLOCK } variant;
 
   PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
   if (eps->which==EPS_ALL) {  /* default values in case of spectrum slicing or polynomial filter  */
-    PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
     if (isfilt) PetscCall(EPSSetUp_KrylovSchur_Filter(eps));
     else PetscCall(EPSSetUp_KrylovSchur_Slice(eps));
+  } else if (isfilt && !eps->isstructured && ctx->bs==1) {  /* polynomial acceleration of extreme eigenvalues */
+    if (!eps->which) eps->which = EPS_SMALLEST_REAL;
+    PetscCall(EPSSetUp_KrylovSchur_Filter(eps));
   } else if (eps->isstructured) {
     PetscCall(EPSSetUp_KrylovSchur_BSE(eps));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -120,17 +205,30 @@ static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
   PetscCheck(eps->extraction==EPS_RITZ || eps->extraction==EPS_HARMONIC,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Unsupported extraction type");
 
   if (!ctx->keep) ctx->keep = 0.5;
+  if (ctx->bs>1) {
+    PetscCheck(eps->which!=EPS_ALL,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The block variant cannot be used for computing all eigenvalues in an interval");
+    PetscCheck(!eps->ishermitian || !eps->isgeneralized || eps->ispositive,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The block variant is not available for indefinite problems");
+    EPSCheckUnsupportedCondition(eps,EPS_FEATURE_ARBITRARY | EPS_FEATURE_EXTRACTION | EPS_FEATURE_TWOSIDED,PETSC_TRUE," with block size larger than one");
+    PetscCheck(eps->ncv>=eps->nev+ctx->bs,PetscObjectComm((PetscObject)eps),PETSC_ERR_USER_INPUT,"The value of ncv must be at least nev plus the block size");
+    PetscCheck(eps->mpd>=2*ctx->bs,PetscObjectComm((PetscObject)eps),PETSC_ERR_USER_INPUT,"The value of mpd must be at least twice the block size");
+  }
 
-  PetscCall(EPSAllocateSolution(eps,1));
+  if (eps->which==EPS_ALL && !isfilt && ctx->global && ctx->npart>1 && ctx->distributed) PetscCall(EPSAllocateSolution_Slice(eps));
+  else PetscCall(EPSAllocateSolution(eps,ctx->bs));
   PetscCall(EPS_SetInnerProduct(eps));
   if (eps->arbitrary) PetscCall(EPSSetWorkVecs(eps,2));
   else if (eps->ishermitian && !eps->ispositive) PetscCall(EPSSetWorkVecs(eps,1));
 
   /* dispatch solve method */
-  if (eps->ishermitian) {
+  if (ctx->bs>1) {
+    variant = EPS_KS_BLOCK;
+  } else if (eps->ishermitian) {
     if (eps->which==EPS_ALL) {
       EPSCheckDefiniteCondition(eps,eps->which==EPS_ALL," with spectrum slicing");
-      variant = isfilt? EPS_KS_FILTER: EPS_KS_SLICE;
+      if (isfilt) variant = (ctx->global && ctx->npart>1)? EPS_KS_FILTSLICE: EPS_KS_FILTER;
+      else variant = EPS_KS_SLICE;
+    } else if (isfilt) {
+      variant = EPS_KS_FILTER;
     } else if (eps->isgeneralized && !eps->ispositive) {
       variant = EPS_KS_INDEF;
     } else {
@@ -149,9 +247,14 @@ static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
       default: SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Unsupported extraction type");
     }
   }
+  eps->ops->checkpoint = NULL;
+  eps->ops->restart    = NULL;
+  eps->ops->geteigenvector = NULL;
   switch (variant) {
     case EPS_KS_DEFAULT:
       eps->ops->solve = EPSSolve_KrylovSchur_Default;
+      eps->ops->checkpoint = EPSCheckpoint_KrylovSchur;
+      eps->ops->restart    = EPSRestart_KrylovSchur;
       eps->ops->computevectors = EPSComputeVectors_Schur;
       PetscCall(DSSetType(eps->ds,DSNHEP));
       PetscCall(DSSetExtraRow(eps->ds,PETSC_TRUE));
@@ -159,16 +262,26 @@ static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
       break;
     case EPS_KS_SYMM:
     case EPS_KS_FILTER:
-      eps->ops->solve = EPSSolve_KrylovSchur_Default;
+      eps->ops->solve = (variant==EPS_KS_FILTER && eps->which!=EPS_ALL)? EPSSolve_KrylovSchur_Filter: EPSSolve_KrylovSchur_Default;
       eps->ops->computevectors = EPSComputeVectors_Hermitian;
+      eps->ops->checkpoint = EPSCheckpoint_KrylovSchur;
+      eps->ops->restart    = EPSRestart_KrylovSchur;
       PetscCall(DSSetType(eps->ds,DSHEP));
       PetscCall(DSSetCompact(eps->ds,PETSC_TRUE));
       PetscCall(DSSetExtraRow(eps->ds,PETSC_TRUE));
       PetscCall(DSAllocate(eps->ds,eps->ncv+1));
       break;
+    case EPS_KS_FILTSLICE:
+      eps->ops->solve = EPSSolve_KrylovSchur_FilterSlice;
+      eps->ops->computevectors = NULL;  /* the eigenvectors are gathered from the partitions in the solve */
+      PetscCall(EPSSetUp_KrylovSchur_FilterSlice(eps));
+      PetscCall(DSSetType(eps->ds,DSHEP));
+      PetscCall(DSAllocate(eps->ds,1));
+      break;
     case EPS_KS_SLICE:
       eps->ops->solve = EPSSolve_KrylovSchur_Slice;
       eps->ops->computevectors = EPSComputeVectors_Slice;
+      if (ctx->global && ctx->npart>1 && ctx->distributed) eps->ops->geteigenvector = EPSGetEigenvector_Slice;
       break;
     case EPS_KS_INDEF:
       eps->ops->solve = EPSSolve_KrylovSchur_Indefinite;
@@ -188,6 +301,15 @@ static PetscErrorCode EPSSetUp_KrylovSchur(EPS eps)
       PetscCall(DSAllocate(eps->ds,eps->ncv+1));
       PetscCall(DSSetExtraRow(eps->ds,PETSC_TRUE));
       break;
+    case EPS_KS_BLOCK:
+      eps->ops->solve = EPSSolve_KrylovSchur_Block;
+      eps->ops->computevectors = eps->ishermitian? EPSComputeVectors_Hermitian: EPSComputeVectors_Schur;
+      PetscCall(DSSetType(eps->ds,eps->ishermitian? DSHEP: DSNHEP));
+      PetscCall(DSSetCompact(eps->ds,PETSC_FALSE));
+      PetscCall(DSSetExtraRow(eps->ds,PETSC_TRUE));
+      PetscCall(DSSetBlockSize(eps->ds,ctx->bs));
+      PetscCall(DSAllocate(eps->ds,eps->ncv+ctx->bs));
+      break;
     default: SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"Unexpected error");
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -201,12 +323,12 @@ static PetscErrorCode EPSSetUpSort_KrylovSchur(EPS eps)
 
   PetscFunctionBegin;
   PetscCall(EPSSetUpSort_Default(eps));
-  if (eps->which==EPS_ALL) {
-    PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
+  PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
+  if (eps->which==EPS_ALL || isfilt) {
     if (isfilt) {
       PetscCall(DSGetSlepcSC(eps->ds,&sc));
       sc->rg            = NULL;
-      sc->comparison    = SlepcCompareLargestReal;
+      sc->comparison    = (eps->which==EPS_ALL && ctx->global && ctx->npart>1)? SlepcCompareSmallestReal: SlepcCompareLargestReal;
       sc->comparisonctx = NULL;
       sc->map           = NULL;
       sc->mapobj        = NULL;
@@ -224,14 +346,171 @@ static PetscErrorCode EPSSetUpSort_KrylovSchur(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Builds the starting point of the iteration from the subspace V(:,0:nwarm) kept
+   from the previous solve. The Rayleigh-Ritz projection onto the current operator
+   gives a Schur form, whose leading Schur vectors are locked if they satisfy the
+   convergence criterion, and the rest are combined into the next Arnoldi vector
+*/
+static PetscErrorCode EPSWarmStart_KrylovSchur(EPS eps,PetscBool hermitian)
+{
+  EPS_KRYLOVSCHUR   *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt          i,j,k,m=eps->nwarm,ld,ldt;
+  PetscScalar       re,im,*A,*w;
+  const PetscScalar *pM;
+  PetscReal         *T,norm;
+  PetscBool         breakdown=PETSC_FALSE,isshift,istrivial;
+  BV                W;
+  Mat               Op,M,Q;
+  DS                ds;
+  SlepcSC           sc,sc0;
+  Vec               v,x;
+
+  PetscFunctionBegin;
+  /* orthonormal basis of the previous subspace, it may contain eigenvectors instead of Schur vectors */
+  PetscCall(BVSetActiveColumns(eps->V,0,m));
+  PetscCall(BVOrthogonalize(eps->V,NULL));
+
+  /* Rayleigh-Ritz projection M = V'*Op*V */
+  PetscCall(BVDuplicateResize(eps->V,m,&W));
+  PetscCall(STGetOperator(eps->st,&Op));
+  PetscCall(BVMatMult(eps->V,Op,W));
+  PetscCall(STRestoreOperator(eps->st,&Op));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,m,NULL,&M));
+  PetscCall(BVDot(W,eps->V,M));
+
+  /* Schur form of the projected matrix, sorted with the criterion of the solver */
+  PetscCall(DSCreate(PetscObjectComm((PetscObject)eps),&ds));
+  PetscCall(DSSetType(ds,hermitian?DSHEP:DSNHEP));
+  PetscCall(DSAllocate(ds,m));
+  PetscCall(DSSetDimensions(ds,m,0,0));
+  PetscCall(DSGetSlepcSC(eps->ds,&sc0));
+  PetscCall(DSGetSlepcSC(ds,&sc));
+  *sc = *sc0;
+  PetscCall(DSGetLeadingDimension(ds,&ldt));
+  PetscCall(DSGetArray(ds,DS_MAT_A,&A));
+  PetscCall(MatDenseGetArrayRead(M,&pM));
+  for (j=0;j<m;j++) PetscCall(PetscArraycpy(A+j*ldt,pM+j*m,m));
+  PetscCall(MatDenseRestoreArrayRead(M,&pM));
+  PetscCall(DSRestoreArray(ds,DS_MAT_A,&A));
+  PetscCall(MatDestroy(&M));
+  PetscCall(DSSetState(ds,DS_STATE_RAW));
+  PetscCall(DSSolve(ds,eps->eigr,eps->eigi));
+  PetscCall(DSSort(ds,eps->eigr,eps->eigi,NULL,NULL,NULL));
+  PetscCall(DSSynchronize(ds,eps->eigr,eps->eigi));
+
+  /* rotate the basis, and compute the residual R = Op*V*Q - V*Q*T */
+  PetscCall(DSGetMat(ds,DS_MAT_Q,&Q));
+  PetscCall(BVMultInPlace(eps->V,Q,0,m));
+  PetscCall(BVMultInPlace(W,Q,0,m));
+  PetscCall(DSRestoreMat(ds,DS_MAT_Q,&Q));
+  if (hermitian) {
+    for (j=0;j<m;j++) {
+      PetscCall(BVGetColumn(W,j,&v));
+      PetscCall(BVGetColumn(eps->V,j,&x));
+      PetscCall(VecAXPY(v,-eps->eigr[j],x));
+      PetscCall(BVRestoreColumn(eps->V,j,&x));
+      PetscCall(BVRestoreColumn(W,j,&v));
+    }
+  } else {
+    PetscCall(DSGetMat(ds,DS_MAT_A,&M));
+    PetscCall(BVSetActiveColumns(eps->V,0,m));
+    PetscCall(BVMult(W,-1.0,1.0,eps->V,M));
+    PetscCall(DSRestoreMat(ds,DS_MAT_A,&M));
+  }
+
+  /* lock the leading Schur vectors that are already converged */
+  PetscCall(RGIsTrivial(eps->rg,&istrivial));
+  PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STSHIFT,&isshift));
+  for (k=0;ctx->lock && istrivial && k<m;k++) {
+    re = eps->eigr[k];
+    im = eps->eigi[k];
+    if (isshift || eps->conv==EPS_CONV_NORM) PetscCall(STBackTransform(eps->st,1,&re,&im));
+    PetscCall(BVNormColumn(W,k,NORM_2,&norm));
+#if !defined(PETSC_USE_COMPLEX)
+    if (eps->eigi[k]!=0.0) {
+      PetscReal norm1;
+      PetscCall(BVNormColumn(W,k+1,NORM_2,&norm1));
+      norm = SlepcAbs(norm,norm1);
+    }
+#endif
+    PetscCall((*eps->converged)(eps,re,im,norm,&eps->errest[k],eps->convergedctx));
+    if (eps->errest[k]>=eps->tol) break;
+    if (eps->eigi[k]!=0.0) { eps->errest[k+1] = eps->errest[k]; k++; }
+  }
+  if (!ctx->lock || !istrivial) k = 0;
+  PetscCall(BVDestroy(&W));
+  PetscCall(PetscInfo(eps,"Warm start from a subspace of dimension %" PetscInt_FMT ", with %" PetscInt_FMT " eigenpairs already converged\n",m,k));
+
+  /* locked part of the Rayleigh quotient */
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  if (hermitian) {
+    PetscCall(DSGetArrayReal(eps->ds,DS_MAT_T,&T));
+    for (i=0;i<k;i++) {
+      T[i]    = PetscRealPart(eps->eigr[i]);
+      T[i+ld] = 0.0;
+    }
+    PetscCall(DSRestoreArrayReal(eps->ds,DS_MAT_T,&T));
+  } else {
+    PetscCall(DSGetArray(ds,DS_MAT_A,&w));
+    PetscCall(DSGetArray(eps->ds,DS_MAT_A,&A));
+    for (j=0;j<k;j++) {
+      PetscCall(PetscArrayzero(A+j*ld,ld));
+      PetscCall(PetscArraycpy(A+j*ld,w+j*ldt,k));
+    }
+    PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&A));
+    PetscCall(DSRestoreArray(ds,DS_MAT_A,&w));
+  }
+  PetscCall(DSDestroy(&ds));
+  eps->nconv = k;
+
+  /* the next Arnoldi vector is the sum of the remaining Schur vectors */
+  if (k<m) {
+    PetscCall(PetscMalloc1(m-k,&w));
+    for (i=0;i<m-k;i++) w[i] = 1.0;
+    PetscCall(BVCreateVec(eps->V,&v));
+    PetscCall(BVSetActiveColumns(eps->V,k,m));
+    PetscCall(BVMultVec(eps->V,1.0,0.0,v,w));
+    PetscCall(BVInsertVec(eps->V,k,v));
+    PetscCall(VecDestroy(&v));
+    PetscCall(PetscFree(w));
+    PetscCall(BVOrthonormalizeColumn(eps->V,k,PETSC_FALSE,NULL,&breakdown));
+  }
+  if (k==m || breakdown) PetscCall(EPSGetStartVector(eps,k,NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Adapts the restart parameter to the times of the last restart, in the expansion of
+   the Krylov decomposition (operator and orthogonalization) and in the rest (projected
+   problem and update of the basis). The latter does not depend on how many vectors are
+   kept, so if it dominates it is better to keep few in order to amortize it over more
+   new vectors, while if the expansion dominates it pays off to retain more information.
+   The times are maximized over the processes, so that all of them take the same value.
+*/
+static PetscErrorCode EPSKrylovSchurAdaptKeep(EPS eps,PetscLogDouble texp,PetscLogDouble trest,PetscReal *keep)
+{
+  PetscLogDouble t[2] = {texp,trest};
+  PetscReal      target;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,t,2,MPI_DOUBLE,MPI_MAX,PetscObjectComm((PetscObject)eps)));
+  if (t[0]+t[1]<=0.0) PetscFunctionReturn(PETSC_SUCCESS);
+  target = 0.1+0.8*(PetscReal)(t[0]/(t[0]+t[1]));
+  *keep = PetscMin(0.9,PetscMax(0.1,0.5*(*keep+target)));
+  PetscCall(PetscInfo(eps,"Adapted restart parameter keep=%g (expansion %g s, rest %g s)\n",(double)*keep,(double)t[0],(double)t[1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
   PetscInt        j,*pj,k,l,nv,ld,nconv;
   Mat             U,Op,H,T;
   PetscScalar     *g;
-  PetscReal       beta,gamma=1.0;
+  PetscReal       beta,gamma=1.0,keep=ctx->keep;
   PetscBool       breakdown,harmonic,hermitian;
+  PetscLogDouble  t0=0.0,t1=0.0,t2=0.0;
 
   PetscFunctionBegin;
   PetscCall(DSGetLeadingDimension(eps->ds,&ld));
@@ -241,15 +520,24 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
   if (eps->arbitrary) pj = &j;
   else pj = NULL;
 
-  /* Get the starting Arnoldi vector */
-  PetscCall(EPSGetStartVector(eps,0,NULL));
-  l = 0;
+  /* Get the starting Arnoldi vector, unless the state was loaded from a checkpoint */
+  if (ctx->resumed) {
+    l = ctx->nkeep;
+    ctx->resumed = PETSC_FALSE;
+  } else if (eps->nwarm && !harmonic && !eps->arbitrary && eps->which!=EPS_ALL) {
+    PetscCall(EPSWarmStart_KrylovSchur(eps,hermitian));
+    l = 0;
+  } else {
+    PetscCall(EPSGetStartVector(eps,0,NULL));
+    l = 0;
+  }
 
   /* Restart loop */
   while (eps->reason == EPS_CONVERGED_ITERATING) {
     eps->its++;
 
     /* Compute an nv-step Arnoldi factorization */
+    if (ctx->autokeep) PetscCall(PetscTime(&t0));
     nv = PetscMin(eps->nconv+eps->mpd,eps->ncv);
     PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
     PetscCall(STGetOperator(eps->st,&Op));
@@ -263,6 +551,7 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
       PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&H));
     }
     PetscCall(STRestoreOperator(eps->st,&Op));
+    if (ctx->autokeep) PetscCall(PetscTime(&t1));
     PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
     PetscCall(DSSetState(eps->ds,l?DS_STATE_RAW:DS_STATE_INTERMEDIATE));
     PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
@@ -283,12 +572,13 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
     /* Check convergence */
     PetscCall(EPSKrylovConvergence(eps,PETSC_FALSE,eps->nconv,nv-eps->nconv,beta,0.0,gamma,&k));
     PetscCall((*eps->stopping)(eps,eps->its,eps->max_it,k,eps->nev,&eps->reason,eps->stoppingctx));
+    if (k<nv) PetscCall(STUpdateInnerTolerance(eps->st,eps->errest[k]));
     nconv = k;
 
     /* Update l */
     if (eps->reason != EPS_CONVERGED_ITERATING || breakdown || k==nv) l = 0;
     else {
-      l = PetscMax(1,(PetscInt)((nv-k)*ctx->keep));
+      l = PetscMax(1,(PetscInt)((nv-k)*keep));
       if (!hermitian) PetscCall(DSGetTruncateSize(eps->ds,k,nv,&l));
     }
     if (!ctx->lock && l>0) { l += k; k = 0; } /* non-locking variant: reset no. of converged pairs */
@@ -327,7 +617,12 @@ PetscErrorCode EPSSolve_KrylovSchur_Default(EPS eps)
     PetscCall(DSRestoreMat(eps->ds,DS_MAT_Q,&U));
 
     if (eps->reason == EPS_CONVERGED_ITERATING && !breakdown) PetscCall(BVCopyColumn(eps->V,nv,k+l));
+    if (ctx->autokeep && eps->reason == EPS_CONVERGED_ITERATING) {
+      PetscCall(PetscTime(&t2));
+      PetscCall(EPSKrylovSchurAdaptKeep(eps,t1-t0,t2-t1,&keep));
+    }
     eps->nconv = k;
+    ctx->nkeep = l;
     PetscCall(EPSMonitor(eps,eps->its,nconv,eps->eigr,eps->eigi,eps->errest,nv));
   }
 
@@ -368,7 +663,7 @@ static PetscErrorCode EPSKrylovSchurSetRestart_KrylovSchur(EPS eps,PetscReal kee
 
    Level: advanced
 
-.seealso: EPSKrylovSchurGetRestart()
+.seealso: EPSKrylovSchurGetRestart(), EPSKrylovSchurSetAdaptiveRestart()
 @*/
 PetscErrorCode EPSKrylovSchurSetRestart(EPS eps,PetscReal keep)
 {
@@ -413,6 +708,88 @@ PetscErrorCode EPSKrylovSchurGetRestart(EPS eps,PetscReal *keep)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSKrylovSchurSetAdaptiveRestart_KrylovSchur(EPS eps,PetscBool adapt)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  ctx->autokeep = adapt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetAdaptiveRestart - Activates the adaptation of the restart
+   parameter of the Krylov-Schur method to the measured cost of the iteration.
+
+   Logically Collective
+
+   Input Parameters:
++  eps   - the eigenproblem solver context
+-  adapt - true if the restart parameter must be adapted
+
+   Options Database Key:
+.  -eps_krylovschur_restart_adaptive - Sets the adaptive restart flag
+
+   Notes:
+   When this flag is set, the time spent in each restart is measured and the
+   proportion of vectors kept after restart is adjusted before the next one,
+   starting from the value given in EPSKrylovSchurSetRestart(). The more time
+   is spent in the expansion of the basis (application of the operator and
+   orthogonalization) with respect to the solution of the projected problem
+   and the update of the basis, the more vectors are kept. Since the value
+   depends on the timings, the convergence history may change from one run to
+   another.
+
+   This is only available in the default variant of Krylov-Schur, with one
+   vector per step and no spectrum slicing.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetAdaptiveRestart(), EPSKrylovSchurSetRestart()
+@*/
+PetscErrorCode EPSKrylovSchurSetAdaptiveRestart(EPS eps,PetscBool adapt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,adapt,2);
+  PetscTryMethod(eps,"EPSKrylovSchurSetAdaptiveRestart_C",(EPS,PetscBool),(eps,adapt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetAdaptiveRestart_KrylovSchur(EPS eps,PetscBool *adapt)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *adapt = ctx->autokeep;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetAdaptiveRestart - Gets the flag indicating whether the
+   restart parameter of the Krylov-Schur method is adapted at run time.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  adapt - the adaptive restart flag
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetAdaptiveRestart()
+@*/
+PetscErrorCode EPSKrylovSchurGetAdaptiveRestart(EPS eps,PetscBool *adapt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(adapt,2);
+  PetscUseMethod(eps,"EPSKrylovSchurGetAdaptiveRestart_C",(EPS,PetscBool*),(eps,adapt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSKrylovSchurSetLocking_KrylovSchur(EPS eps,PetscBool lock)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
@@ -488,6 +865,95 @@ PetscErrorCode EPSKrylovSchurGetLocking(EPS eps,PetscBool *lock)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSKrylovSchurSetBlockSize_KrylovSchur(EPS eps,PetscInt bs)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (bs == PETSC_DEFAULT || bs == PETSC_DECIDE) bs = 1;
+  else PetscCheck(bs>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The block size must be positive");
+  if (ctx->bs != bs) {
+    ctx->bs = bs;
+    eps->state = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetBlockSize - Sets the block size of the Krylov-Schur method.
+
+   Logically Collective
+
+   Input Parameters:
++  eps - the eigenproblem solver context
+-  bs  - the block size
+
+   Options Database Key:
+.  -eps_krylovschur_blocksize - Sets the block size
+
+   Notes:
+   With a block size larger than one, the basis is expanded with bs vectors in
+   each step of the Arnoldi (or Lanczos) process, so that the operator is
+   applied to a block of vectors at once with BVMatMult(), and the new block
+   is orthogonalized with the block orthogonalization method selected with
+   BVSetOrthogonalization(). This is more robust than the single-vector method
+   with multiple or tightly clustered eigenvalues, and in the case of sparse
+   matrices it can profit from the better performance of the product by a
+   block of vectors.
+
+   The block variant is not available in spectrum slicing, indefinite problems,
+   two-sided solvers, harmonic extraction or arbitrary selection of eigenpairs.
+   The number of basis vectors ncv must be at least nev plus the block size.
+
+   The default is 1, that is, the single-vector Krylov-Schur method.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetBlockSize(), BVSetOrthogonalization()
+@*/
+PetscErrorCode EPSKrylovSchurSetBlockSize(EPS eps,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,bs,2);
+  PetscTryMethod(eps,"EPSKrylovSchurSetBlockSize_C",(EPS,PetscInt),(eps,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetBlockSize_KrylovSchur(EPS eps,PetscInt *bs)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *bs = ctx->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetBlockSize - Gets the block size used in the Krylov-Schur
+   method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  bs - the block size
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetBlockSize()
+@*/
+PetscErrorCode EPSKrylovSchurGetBlockSize(EPS eps,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(bs,2);
+  PetscUseMethod(eps,"EPSKrylovSchurGetBlockSize_C",(EPS,PetscInt*),(eps,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSKrylovSchurSetPartitions_KrylovSchur(EPS eps,PetscInt npart)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
@@ -528,8 +994,9 @@ static PetscErrorCode EPSKrylovSchurSetPartitions_KrylovSchur(EPS eps,PetscInt n
 +  eps   - the eigenproblem solver context
 -  npart - number of partitions
 
-   Options Database Key:
-.  -eps_krylovschur_partitions <npart> - Sets the number of partitions
+   Options Database Keys:
++  -eps_krylovschur_partitions <npart> - Sets the number of partitions
+-  -eps_krylovschur_partitions_node_aware - Aligns the partitions with the shared-memory nodes
 
    Notes:
    By default, npart=1 so all processes in the communicator participate in
@@ -537,6 +1004,12 @@ static PetscErrorCode EPSKrylovSchurSetPartitions_KrylovSchur(EPS eps,PetscInt n
    divided into npart subintervals, each of them being processed by a
    subset of processes.
 
+   The partitions are formed by consecutive ranks of the communicator. With
+   -eps_krylovschur_partitions_node_aware, the processes are grouped by
+   shared-memory node first, so that each partition spans as few nodes as
+   possible also when the ranks are not placed by blocks, and only the final
+   gathering of the solution involves communication among nodes.
+
    The interval is split proportionally unless the separation points are
    specified with EPSKrylovSchurSetSubintervals().
 
@@ -666,6 +1139,376 @@ PetscErrorCode EPSKrylovSchurGetDetectZeros(EPS eps,PetscBool *detect)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSKrylovSchurSetDynamicBalance_KrylovSchur(EPS eps,PetscBool dynamic)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (ctx->dynamic != dynamic) {
+    ctx->dynamic = dynamic;
+    eps->state   = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetDynamicBalance - Activates the dynamic load balancing
+   between partitions in multi-communicator spectrum slicing.
+
+   Logically Collective
+
+   Input Parameters:
++  eps     - the eigenproblem solver context
+-  dynamic - whether the work is balanced dynamically
+
+   Options Database Key:
+.  -eps_krylovschur_dynamic_balance - Balance the work dynamically; this takes
+   an optional bool value (0/1/no/yes/true/false)
+
+   Notes:
+   By default, each partition computes all eigenvalues in its subinterval, so
+   a subinterval containing a dense cluster of eigenvalues may delay the whole
+   computation while the rest of partitions are idle. With dynamic balancing,
+   each subinterval is further split into pieces, whose number of eigenvalues
+   is obtained from the inertia during the setup. A partition processes the
+   pieces of its subinterval one after the other, and when it has finished
+   them it takes from the partition with more eigenvalues pending the pieces
+   that contain about half of them. The queues of pieces are accessed with
+   MPI one-sided communication.
+
+   The computed eigenpairs are the same as without dynamic balancing, but the
+   ones obtained by EPSKrylovSchurGetSubcommPairs() in each partition may
+   belong to any of the subintervals.
+
+   This option has effect only when several partitions are being used.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetDynamicBalance(), EPSKrylovSchurSetPartitions(), EPSSetInterval()
+@*/
+PetscErrorCode EPSKrylovSchurSetDynamicBalance(EPS eps,PetscBool dynamic)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,dynamic,2);
+  PetscTryMethod(eps,"EPSKrylovSchurSetDynamicBalance_C",(EPS,PetscBool),(eps,dynamic));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetDynamicBalance_KrylovSchur(EPS eps,PetscBool *dynamic)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *dynamic = ctx->dynamic;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetDynamicBalance - Gets the flag indicating whether the work
+   is balanced dynamically between partitions in spectrum slicing.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  dynamic - whether the work is balanced dynamically
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetDynamicBalance()
+@*/
+PetscErrorCode EPSKrylovSchurGetDynamicBalance(EPS eps,PetscBool *dynamic)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(dynamic,2);
+  PetscUseMethod(eps,"EPSKrylovSchurGetDynamicBalance_C",(EPS,PetscBool*),(eps,dynamic));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurSetDistributedVectors_KrylovSchur(EPS eps,PetscBool distributed)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (ctx->distributed != distributed) {
+    ctx->distributed = distributed;
+    eps->state       = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetDistributedVectors - Indicates that the eigenvectors computed
+   in multi-communicator spectrum slicing must be left in the partitions, instead
+   of gathering them in the EPS object.
+
+   Logically Collective
+
+   Input Parameters:
++  eps         - the eigenproblem solver context
+-  distributed - whether the eigenvectors are left in the partitions
+
+   Options Database Key:
+.  -eps_krylovschur_distributed_vectors - Leave the eigenvectors in the partitions;
+   this takes an optional bool value (0/1/no/yes/true/false)
+
+   Notes:
+   By default, when the solve finishes the eigenvectors computed by all partitions
+   are copied to the basis of the EPS object, which then stores all of them in the
+   parent communicator. With a very large number of eigenpairs, this requires
+   a large amount of memory and communication. If this flag is set, each eigenvector
+   stays in the partition that computed it, and EPSGetEigenvector() obtains it
+   from there when it is requested, by scattering only that vector to the parent
+   communicator.
+
+   The eigenvectors of each partition can also be accessed directly in the
+   subcommunicator with EPSKrylovSchurGetSubcommPairs(), for instance to save
+   them to disk in parallel with one viewer per partition.
+
+   EPSGetInvariantSubspace() is not available with this option. The option has
+   effect only when several partitions are being used.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetDistributedVectors(), EPSKrylovSchurSetPartitions(), EPSKrylovSchurGetSubcommPairs()
+@*/
+PetscErrorCode EPSKrylovSchurSetDistributedVectors(EPS eps,PetscBool distributed)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,distributed,2);
+  PetscTryMethod(eps,"EPSKrylovSchurSetDistributedVectors_C",(EPS,PetscBool),(eps,distributed));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetDistributedVectors_KrylovSchur(EPS eps,PetscBool *distributed)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *distributed = ctx->distributed;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetDistributedVectors - Gets the flag indicating whether the
+   eigenvectors computed in spectrum slicing are left in the partitions.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  distributed - whether the eigenvectors are left in the partitions
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetDistributedVectors()
+@*/
+PetscErrorCode EPSKrylovSchurGetDistributedVectors(EPS eps,PetscBool *distributed)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(distributed,2);
+  PetscUseMethod(eps,"EPSKrylovSchurGetDistributedVectors_C",(EPS,PetscBool*),(eps,distributed));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurSetInertiaSamples_KrylovSchur(EPS eps,PetscInt nsamples)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (nsamples == PETSC_DEFAULT || nsamples == PETSC_DECIDE) nsamples = 0;
+  else PetscCheck(nsamples>=0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The number of samples cannot be negative");
+  if (ctx->nsamples != nsamples) {
+    ctx->nsamples = nsamples;
+    eps->state    = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetInertiaSamples - Sets the number of samples of the inertia
+   that are used to choose the subintervals in spectrum slicing with several
+   partitions.
+
+   Logically Collective
+
+   Input Parameters:
++  eps      - the eigenproblem solver context
+-  nsamples - number of samples
+
+   Options Database Key:
+.  -eps_krylovschur_inertia_samples <nsamples> - Sets the number of samples
+
+   Notes:
+   If the subintervals have not been set with EPSKrylovSchurSetSubintervals(),
+   the computational interval is divided in subintervals of equal width, which
+   may result in a bad load balance if the eigenvalues are not uniformly
+   distributed. With nsamples>0, the inertia is computed at nsamples+1 equispaced
+   points of the interval before the computation, distributing the points among
+   the partitions, and the subintervals are chosen so that each of them contains
+   about the same number of eigenvalues, by linear interpolation of the
+   eigenvalue count between the sampled points.
+
+   The default is 0, that is, uniform subintervals. Each sample requires a
+   factorization, so a small number of samples per partition is enough in most
+   cases. As with uniform subintervals, the computational interval must be
+   bounded.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetInertiaSamples(), EPSKrylovSchurSetPartitions(), EPSKrylovSchurSetSubintervals(), STGetInertia()
+@*/
+PetscErrorCode EPSKrylovSchurSetInertiaSamples(EPS eps,PetscInt nsamples)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,nsamples,2);
+  PetscTryMethod(eps,"EPSKrylovSchurSetInertiaSamples_C",(EPS,PetscInt),(eps,nsamples));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetInertiaSamples_KrylovSchur(EPS eps,PetscInt *nsamples)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  *nsamples = ctx->nsamples;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetInertiaSamples - Gets the number of samples of the inertia
+   used to choose the subintervals in spectrum slicing.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  nsamples - number of samples
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetInertiaSamples()
+@*/
+PetscErrorCode EPSKrylovSchurGetInertiaSamples(EPS eps,PetscInt *nsamples)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(nsamples,2);
+  PetscUseMethod(eps,"EPSKrylovSchurGetInertiaSamples_C",(EPS,PetscInt*),(eps,nsamples));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurSetDOSParameters_KrylovSchur(EPS eps,PetscInt nvec,PetscInt deg)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (nvec == PETSC_DETERMINE) nvec = 10;
+  else if (nvec != PETSC_CURRENT) PetscCheck(nvec>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The number of vectors must be > 0");
+  if (deg == PETSC_DETERMINE) deg = 60;
+  else if (deg != PETSC_CURRENT) PetscCheck(deg>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The degree must be > 0");
+  if (nvec != PETSC_CURRENT && ctx->dosvec != nvec) {
+    ctx->dosvec = nvec;
+    eps->state  = EPS_STATE_INITIAL;
+  }
+  if (deg != PETSC_CURRENT && ctx->dosdeg != deg) {
+    ctx->dosdeg = deg;
+    eps->state  = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurSetDOSParameters - Sets the parameters of the estimation of the
+   density of states (DOS) used to choose the slices when computing all eigenvalues
+   in an interval with a polynomial filter and several partitions.
+
+   Logically Collective
+
+   Input Parameters:
++  eps  - the eigenproblem solver context
+.  nvec - number of random vectors
+-  deg  - degree of the Chebyshev expansion
+
+   Options Database Keys:
++  -eps_krylovschur_dos_vectors <nvec> - Sets the number of random vectors
+-  -eps_krylovschur_dos_degree <deg> - Sets the degree of the expansion
+
+   Notes:
+   When STFILTER is used to compute all eigenvalues in an interval and the
+   number of partitions set with EPSKrylovSchurSetPartitions() is larger
+   than one, the interval is split in as many slices as partitions, and each
+   partition computes the eigenvalues of its slice with a polynomial filter,
+   without factorizations. Unless the subintervals have been set with
+   EPSKrylovSchurSetSubintervals(), the slices are chosen so that they contain
+   about the same number of eigenvalues according to an estimation of the
+   DOS with the kernel polynomial method. The estimation requires deg
+   products of the matrix with a block of nvec vectors. The estimated count
+   of each slice is also used as the nev of the partition.
+
+   Use PETSC_DETERMINE for any argument to set the default value (10 vectors
+   and degree 60), or PETSC_CURRENT to keep the current value.
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurGetDOSParameters(), EPSKrylovSchurSetPartitions(), STFILTER
+@*/
+PetscErrorCode EPSKrylovSchurSetDOSParameters(EPS eps,PetscInt nvec,PetscInt deg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,nvec,2);
+  PetscValidLogicalCollectiveInt(eps,deg,3);
+  PetscTryMethod(eps,"EPSKrylovSchurSetDOSParameters_C",(EPS,PetscInt,PetscInt),(eps,nvec,deg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSKrylovSchurGetDOSParameters_KrylovSchur(EPS eps,PetscInt *nvec,PetscInt *deg)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+
+  PetscFunctionBegin;
+  if (nvec) *nvec = ctx->dosvec;
+  if (deg)  *deg  = ctx->dosdeg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSKrylovSchurGetDOSParameters - Gets the parameters of the estimation of the
+   density of states used to choose the slices in filtered runs with several partitions.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameters:
++  nvec - number of random vectors
+-  deg  - degree of the Chebyshev expansion
+
+   Level: advanced
+
+.seealso: EPSKrylovSchurSetDOSParameters()
+@*/
+PetscErrorCode EPSKrylovSchurGetDOSParameters(EPS eps,PetscInt *nvec,PetscInt *deg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscUseMethod(eps,"EPSKrylovSchurGetDOSParameters_C",(EPS,PetscInt*,PetscInt*),(eps,nvec,deg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSKrylovSchurSetDimensions_KrylovSchur(EPS eps,PetscInt nev,PetscInt ncv,PetscInt mpd)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
@@ -1238,7 +2081,7 @@ PetscErrorCode EPSKrylovSchurGetChildEPS(EPS eps,EPS *childeps)
       /* Create context for subcommunicators */
       PetscCall(PetscSubcommCreate(PetscObjectComm((PetscObject)eps),&ctx->subc));
       PetscCall(PetscSubcommSetNumber(ctx->subc,ctx->npart));
-      PetscCall(PetscSubcommSetType(ctx->subc,PETSC_SUBCOMM_CONTIGUOUS));
+      PetscCall(SlepcSubcommSetType_Private((PetscObject)eps,"-eps_krylovschur_partitions_node_aware",ctx->subc,PETSC_SUBCOMM_CONTIGUOUS));
       PetscCall(PetscSubcommGetChild(ctx->subc,&child));
 
       /* Duplicate matrices */
@@ -1449,9 +2292,16 @@ static PetscErrorCode EPSSetFromOptions_KrylovSchur(EPS eps,PetscOptionItems *Pe
     PetscCall(PetscOptionsReal("-eps_krylovschur_restart","Proportion of vectors kept after restart","EPSKrylovSchurSetRestart",0.5,&keep,&flg));
     if (flg) PetscCall(EPSKrylovSchurSetRestart(eps,keep));
 
+    PetscCall(PetscOptionsBool("-eps_krylovschur_restart_adaptive","Adapt the restart parameter to the measured costs","EPSKrylovSchurSetAdaptiveRestart",ctx->autokeep,&b,&flg));
+    if (flg) PetscCall(EPSKrylovSchurSetAdaptiveRestart(eps,b));
+
     PetscCall(PetscOptionsBool("-eps_krylovschur_locking","Choose between locking and non-locking variants","EPSKrylovSchurSetLocking",PETSC_TRUE,&lock,&flg));
     if (flg) PetscCall(EPSKrylovSchurSetLocking(eps,lock));
 
+    i = ctx->bs;
+    PetscCall(PetscOptionsInt("-eps_krylovschur_blocksize","Block size","EPSKrylovSchurSetBlockSize",ctx->bs,&i,&flg));
+    if (flg) PetscCall(EPSKrylovSchurSetBlockSize(eps,i));
+
     i = ctx->npart;
     PetscCall(PetscOptionsInt("-eps_krylovschur_partitions","Number of partitions of the communicator for spectrum slicing","EPSKrylovSchurSetPartitions",ctx->npart,&i,&flg));
     if (flg) PetscCall(EPSKrylovSchurSetPartitions(eps,i));
@@ -1460,6 +2310,24 @@ static PetscErrorCode EPSSetFromOptions_KrylovSchur(EPS eps,PetscOptionItems *Pe
     PetscCall(PetscOptionsBool("-eps_krylovschur_detect_zeros","Check zeros during factorizations at subinterval boundaries","EPSKrylovSchurSetDetectZeros",ctx->detect,&b,&flg));
     if (flg) PetscCall(EPSKrylovSchurSetDetectZeros(eps,b));
 
+    b = ctx->dynamic;
+    PetscCall(PetscOptionsBool("-eps_krylovschur_dynamic_balance","Balance the work dynamically between partitions","EPSKrylovSchurSetDynamicBalance",ctx->dynamic,&b,&flg));
+    if (flg) PetscCall(EPSKrylovSchurSetDynamicBalance(eps,b));
+
+    b = ctx->distributed;
+    PetscCall(PetscOptionsBool("-eps_krylovschur_distributed_vectors","Leave the eigenvectors in the partitions","EPSKrylovSchurSetDistributedVectors",ctx->distributed,&b,&flg));
+    if (flg) PetscCall(EPSKrylovSchurSetDistributedVectors(eps,b));
+
+    i = ctx->nsamples;
+    PetscCall(PetscOptionsInt("-eps_krylovschur_inertia_samples","Number of inertia samples to choose the subintervals","EPSKrylovSchurSetInertiaSamples",ctx->nsamples,&i,&flg));
+    if (flg) PetscCall(EPSKrylovSchurSetInertiaSamples(eps,i));
+
+    i = ctx->dosvec;
+    j = ctx->dosdeg;
+    PetscCall(PetscOptionsInt("-eps_krylovschur_dos_vectors","Number of random vectors of the density of states in filtered slicing","EPSKrylovSchurSetDOSParameters",ctx->dosvec,&i,&f1));
+    PetscCall(PetscOptionsInt("-eps_krylovschur_dos_degree","Degree of the density of states in filtered slicing","EPSKrylovSchurSetDOSParameters",ctx->dosdeg,&j,&f2));
+    if (f1 || f2) PetscCall(EPSKrylovSchurSetDOSParameters(eps,i,j));
+
     i = 1;
     j = k = PETSC_DECIDE;
     PetscCall(PetscOptionsInt("-eps_krylovschur_nev","Number of eigenvalues to compute in each subsolve (only for spectrum slicing)","EPSKrylovSchurSetDimensions",40,&i,&f1));
@@ -1496,17 +2364,25 @@ static PetscErrorCode EPSView_KrylovSchur(EPS eps,PetscViewer viewer)
   PetscFunctionBegin;
   PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
   if (isascii) {
-    PetscCall(PetscViewerASCIIPrintf(viewer,"  %d%% of basis vectors kept after restart\n",(int)(100*ctx->keep)));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"  %d%% of basis vectors kept after restart%s\n",(int)(100*ctx->keep),ctx->autokeep?" (initially, adapted at run time)":""));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  using the %slocking variant\n",ctx->lock?"":"non-"));
+    if (ctx->bs>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  block size: %" PetscInt_FMT "\n",ctx->bs));
     if (eps->problem_type==EPS_BSE) PetscCall(PetscViewerASCIIPrintf(viewer,"  BSE method: %s\n",EPSKrylovSchurBSETypes[ctx->bse]));
+    PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
+    if (isfilt && eps->which!=EPS_ALL) PetscCall(PetscViewerASCIIPrintf(viewer,"  using filtering to accelerate the computation of extreme eigenvalues\n"));
     if (eps->which==EPS_ALL) {
-      PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
-      if (isfilt) PetscCall(PetscViewerASCIIPrintf(viewer,"  using filtering to extract all eigenvalues in an interval\n"));
+      if (isfilt) {
+        PetscCall(PetscViewerASCIIPrintf(viewer,"  using filtering to extract all eigenvalues in an interval\n"));
+        if (ctx->npart>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  filtering in %" PetscInt_FMT " slices, chosen from the density of states with %" PetscInt_FMT " vectors and degree %" PetscInt_FMT "\n",ctx->npart,ctx->dosvec,ctx->dosdeg));
+      }
       else {
         PetscCall(PetscViewerASCIIPrintf(viewer,"  doing spectrum slicing with nev=%" PetscInt_FMT ", ncv=%" PetscInt_FMT ", mpd=%" PetscInt_FMT "\n",ctx->nev,ctx->ncv,ctx->mpd));
         if (ctx->npart>1) {
           PetscCall(PetscViewerASCIIPrintf(viewer,"  multi-communicator spectrum slicing with %" PetscInt_FMT " partitions\n",ctx->npart));
           if (ctx->detect) PetscCall(PetscViewerASCIIPrintf(viewer,"  detecting zeros when factorizing at subinterval boundaries\n"));
+          if (ctx->nsamples && !ctx->subintset) PetscCall(PetscViewerASCIIPrintf(viewer,"  subintervals chosen from the inertia at %" PetscInt_FMT " points\n",ctx->nsamples+1));
+          if (ctx->dynamic) PetscCall(PetscViewerASCIIPrintf(viewer,"  balancing the work dynamically between partitions\n"));
+          if (ctx->distributed) PetscCall(PetscViewerASCIIPrintf(viewer,"  leaving the eigenvectors in the partitions\n"));
         }
         /* view child KSP */
         PetscCall(EPSKrylovSchurGetKSP_KrylovSchur(eps,&ksp));
@@ -1532,16 +2408,28 @@ static PetscErrorCode EPSDestroy_KrylovSchur(EPS eps)
 
   PetscFunctionBegin;
   PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
-  if (eps->which==EPS_ALL && !isfilt) PetscCall(EPSDestroy_KrylovSchur_Slice(eps));
+  if (eps->which==EPS_ALL && (!isfilt || ((EPS_KRYLOVSCHUR*)eps->data)->npart>1)) PetscCall(EPSDestroy_KrylovSchur_Slice(eps));
   PetscCall(PetscFree(eps->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetRestart_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetRestart_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetAdaptiveRestart_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetAdaptiveRestart_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetLocking_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetLocking_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetBlockSize_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetBlockSize_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPartitions_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPartitions_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDetectZeros_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDetectZeros_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDynamicBalance_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDynamicBalance_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDistributedVectors_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDistributedVectors_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetInertiaSamples_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetInertiaSamples_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDOSParameters_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDOSParameters_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDimensions_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDimensions_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetSubintervals_C",NULL));
@@ -1563,7 +2451,7 @@ static PetscErrorCode EPSReset_KrylovSchur(EPS eps)
 
   PetscFunctionBegin;
   PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
-  if (eps->which==EPS_ALL && !isfilt) PetscCall(EPSReset_KrylovSchur_Slice(eps));
+  if (eps->which==EPS_ALL && (!isfilt || ((EPS_KRYLOVSCHUR*)eps->data)->npart>1)) PetscCall(EPSReset_KrylovSchur_Slice(eps));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1584,12 +2472,16 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_KrylovSchur(EPS eps)
   PetscCall(PetscNew(&ctx));
   eps->data   = (void*)ctx;
   ctx->lock   = PETSC_TRUE;
+  ctx->bs     = 1;
   ctx->nev    = 1;
   ctx->ncv    = PETSC_DETERMINE;
   ctx->mpd    = PETSC_DETERMINE;
   ctx->npart  = 1;
   ctx->detect = PETSC_FALSE;
   ctx->global = PETSC_TRUE;
+  ctx->win    = MPI_WIN_NULL;
+  ctx->dosvec = 10;
+  ctx->dosdeg = 60;
 
   eps->useds = PETSC_TRUE;
 
@@ -1605,12 +2497,24 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_KrylovSchur(EPS eps)
 
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetRestart_C",EPSKrylovSchurSetRestart_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetRestart_C",EPSKrylovSchurGetRestart_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetAdaptiveRestart_C",EPSKrylovSchurSetAdaptiveRestart_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetAdaptiveRestart_C",EPSKrylovSchurGetAdaptiveRestart_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetLocking_C",EPSKrylovSchurSetLocking_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetLocking_C",EPSKrylovSchurGetLocking_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetBlockSize_C",EPSKrylovSchurSetBlockSize_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetBlockSize_C",EPSKrylovSchurGetBlockSize_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetPartitions_C",EPSKrylovSchurSetPartitions_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetPartitions_C",EPSKrylovSchurGetPartitions_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDetectZeros_C",EPSKrylovSchurSetDetectZeros_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDetectZeros_C",EPSKrylovSchurGetDetectZeros_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDynamicBalance_C",EPSKrylovSchurSetDynamicBalance_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDynamicBalance_C",EPSKrylovSchurGetDynamicBalance_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDistributedVectors_C",EPSKrylovSchurSetDistributedVectors_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDistributedVectors_C",EPSKrylovSchurGetDistributedVectors_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetInertiaSamples_C",EPSKrylovSchurSetInertiaSamples_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetInertiaSamples_C",EPSKrylovSchurGetInertiaSamples_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDOSParameters_C",EPSKrylovSchurSetDOSParameters_KrylovSchur));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDOSParameters_C",EPSKrylovSchurGetDOSParameters_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetDimensions_C",EPSKrylovSchurSetDimensions_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurGetDimensions_C",EPSKrylovSchurGetDimensions_KrylovSchur));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSKrylovSchurSetSubintervals_C",EPSKrylovSchurSetSubintervals_KrylovSchur));
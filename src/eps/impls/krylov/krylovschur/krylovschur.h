@@ -15,10 +15,15 @@
 
 SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Default(EPS);
 SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_TwoSided(EPS);
+SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Block(EPS);
 SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Slice(EPS);
 SLEPC_INTERN PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS);
+SLEPC_INTERN PetscErrorCode EPSAllocateSolution_Slice(EPS);
 SLEPC_INTERN PetscErrorCode EPSReset_KrylovSchur_Slice(EPS);
 SLEPC_INTERN PetscErrorCode EPSDestroy_KrylovSchur_Slice(EPS);
+SLEPC_INTERN PetscErrorCode EPSBackTransform_Skip(EPS);
+SLEPC_INTERN PetscErrorCode EPSSetUp_KrylovSchur_FilterSlice(EPS);
+SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_FilterSlice(EPS);
 SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_Indefinite(EPS);
 SLEPC_INTERN PetscErrorCode EPSSetUp_KrylovSchur_BSE(EPS);
 SLEPC_INTERN PetscErrorCode EPSSolve_KrylovSchur_BSE_Shao(EPS);
@@ -75,7 +80,11 @@ typedef struct _n_SR *EPS_SR;
 
 typedef struct {
   PetscReal        keep;               /* restart parameter */
+  PetscBool        autokeep;           /* adapt the restart parameter to the measured costs */
   PetscBool        lock;               /* locking/non-locking variant */
+  PetscInt         bs;                 /* block size, only in the block variant */
+  PetscInt         nkeep;              /* number of vectors kept at the last restart */
+  PetscBool        resumed;            /* the state has been loaded from a checkpoint */
   /* the following are used only in spectrum slicing */
   EPS_SR           sr;                 /* spectrum slicing context */
   PetscInt         nev;                /* number of eigenvalues to compute */
@@ -83,8 +92,11 @@ typedef struct {
   PetscInt         mpd;                /* maximum dimension of projected problem */
   PetscInt         npart;              /* number of partitions of subcommunicator */
   PetscBool        detect;             /* check for zeros during factorizations */
+  PetscBool        dynamic;            /* dynamic load balancing between partitions */
+  PetscBool        distributed;        /* leave eigenvectors in the partitions */
   PetscReal        *subintervals;      /* partition of global interval */
   PetscBool        subintset;          /* subintervals set by user */
+  PetscInt         nsamples;           /* inertia samples to choose the subintervals */
   PetscMPIInt      *nconv_loc;         /* converged eigenpairs for each subinterval */
   EPS              eps;                /* additional eps for slice runs */
   PetscBool        global;             /* flag distinguishing global from local eps */
@@ -98,8 +110,15 @@ typedef struct {
   PetscObjectId    Aid,Bid;            /* Id of subcommunicator matrices */
   IS               isrow,iscol;        /* index sets used in update of subcomm mats */
   Mat              *submata,*submatb;  /* seq matrices used in update of subcomm mats */
+  PetscInt         nchunks;            /* number of pieces of the interval (dynamic balancing) */
+  PetscReal        *chunks;            /* endpoints of the pieces, in increasing order */
+  PetscInt         *chunkinertias;     /* inertias at the endpoints of the pieces */
+  PetscInt         queue[2],qinit[2];  /* range of pieces to be processed by this partition */
+  MPI_Win          win;                /* window to access the queues of all partitions */
   /* the following are used only in filter */
   PetscBool        estimatedrange;     /* the filter range was not set by the user */
+  PetscInt         dosvec;             /* number of random vectors of the DOS (filter with several partitions) */
+  PetscInt         dosdeg;             /* degree of the expansion of the DOS (filter with several partitions) */
   /* the following are used only for BSE problem type */
   EPSKrylovSchurBSEType bse;           /* the BSE method */
 } EPS_KRYLOVSCHUR;
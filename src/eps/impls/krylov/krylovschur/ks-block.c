@@ -0,0 +1,168 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SLEPc eigensolver: "krylovschur"
+
+   Method: Block Krylov-Schur
+
+   Algorithm:
+
+       Block version of the Krylov-Schur method, where the basis is expanded
+       with bs vectors at a time. The Rayleigh quotient is block Hessenberg
+       (block tridiagonal in the Hermitian case) and the residual of the
+       Krylov decomposition is a block of bs vectors, which is stored in the
+       extra rows of the DS.
+
+   References:
+
+       [1] Y. Zhou and Y. Saad, "Block Krylov-Schur method for large symmetric
+           eigenvalue problems", Numer. Algorithms 47(4):341-359, 2008.
+*/
+
+#include <slepc/private/epsimpl.h>
+#include "krylovschur.h"
+
+/*
+   Computes the block Arnoldi factorization from column m0 up to column nv,
+   where V(:,m0:m0+bs) must be orthonormal. Each step applies the operator to
+   a block of bs columns at once, and orthogonalizes the new block with the
+   block orthogonalization method of the BV. The coefficients are stored in
+   the columns m0:nv of the DS matrix A, including the bs extra rows.
+*/
+static PetscErrorCode EPSBlockArnoldi_KrylovSchur(EPS eps,BV W,Mat R,PetscInt m0,PetscInt nv)
+{
+  EPS_KRYLOVSCHUR   *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt          i,j,r,ld,ldr,bs=ctx->bs;
+  Mat               Op;
+  PetscScalar       *H;
+  const PetscScalar *pR;
+
+  PetscFunctionBegin;
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  PetscCall(STGetOperator(eps->st,&Op));
+  for (j=m0;j<nv;j+=bs) {
+    /* W = Op*V(:,j:j+bs), copied to V(:,j+bs:j+2*bs) */
+    PetscCall(BVSetActiveColumns(eps->V,j,j+bs));
+    PetscCall(BVMatMult(eps->V,Op,W));
+    PetscCall(BVSetActiveColumns(eps->V,j+bs,j+2*bs));
+    PetscCall(BVCopy(W,eps->V));
+    /* orthogonalize against previous columns, then QR of the new block */
+    PetscCall(BVOrthogonalize(eps->V,R));
+    PetscCall(MatDenseGetArrayRead(R,&pR));
+    PetscCall(DSGetArray(eps->ds,DS_MAT_A,&H));
+    for (i=0;i<bs;i++) {
+      PetscCall(PetscArrayzero(H+(j+i)*ld,ld));
+      for (r=0;r<j+2*bs;r++) H[r+(j+i)*ld] = pR[r+(j+bs+i)*ldr];
+    }
+    PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&H));
+    PetscCall(MatDenseRestoreArrayRead(R,&pR));
+  }
+  PetscCall(STRestoreOperator(eps->st,&Op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode EPSSolve_KrylovSchur_Block(EPS eps)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt        i,j,k,l,nv,m0,ld,lmax,nconv,bs=ctx->bs;
+  Mat             U,R;
+  BV              W;
+  PetscScalar     *H;
+  PetscBool       breakdown=PETSC_FALSE,hermitian;
+
+  PetscFunctionBegin;
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  hermitian = eps->ishermitian;
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,ld,NULL,&R));
+  PetscCall(BVDuplicateResize(eps->V,bs,&W));
+
+  /* Get the starting block of Arnoldi vectors */
+  for (i=0;i<bs;i++) PetscCall(EPSGetStartVector(eps,i,NULL));
+  l = 0;
+
+  /* Restart loop */
+  while (eps->reason == EPS_CONVERGED_ITERATING) {
+    eps->its++;
+
+    /* Compute a block Arnoldi factorization with a whole number of blocks */
+    m0 = eps->nconv+l;
+    nv = PetscMin(eps->nconv+eps->mpd,eps->ncv);
+    nv = m0+bs*((nv-m0)/bs);
+    PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
+    PetscCall(EPSBlockArnoldi_KrylovSchur(eps,W,R,m0,nv));
+    PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
+    PetscCall(DSSetState(eps->ds,DS_STATE_RAW));
+    PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
+
+    /* Solve projected problem */
+    PetscCall(DSSolve(eps->ds,eps->eigr,eps->eigi));
+    PetscCall(DSSort(eps->ds,eps->eigr,eps->eigi,NULL,NULL,NULL));
+    PetscCall(DSSynchronize(eps->ds,eps->eigr,eps->eigi));
+
+    /* Check convergence, the residual norms are computed from the extra rows */
+    PetscCall(EPSKrylovConvergence(eps,PETSC_FALSE,eps->nconv,nv-eps->nconv,1.0,0.0,1.0,&k));
+    PetscCall((*eps->stopping)(eps,eps->its,eps->max_it,k,eps->nev,&eps->reason,eps->stoppingctx));
+    if (k<nv) PetscCall(STUpdateInnerTolerance(eps->st,eps->errest[k]));
+    nconv = k;
+
+    /* Update l, leaving room for the next block */
+    if (eps->reason != EPS_CONVERGED_ITERATING || k==nv) l = 0;
+    else {
+      lmax = PetscMin(eps->ncv,k+eps->mpd)-bs-k;
+      l = PetscMin(PetscMax(1,(PetscInt)((nv-k)*ctx->keep)),lmax-1);
+      if (!hermitian && l>0) PetscCall(DSGetTruncateSize(eps->ds,k,nv,&l));
+    }
+    if (!ctx->lock && l>0) { l += k; k = 0; } /* non-locking variant: reset no. of converged pairs */
+    if (l) PetscCall(PetscInfo(eps,"Preparing to restart keeping l=%" PetscInt_FMT " vectors\n",l));
+
+    if (eps->reason == EPS_CONVERGED_ITERATING) {
+      if (PetscUnlikely(k==nv)) {
+        /* Start a new block Arnoldi factorization */
+        PetscCall(PetscInfo(eps,"All vectors converged in block Krylov-Schur method (it=%" PetscInt_FMT ")\n",eps->its));
+        PetscCall(DSGetArray(eps->ds,DS_MAT_A,&H));
+        for (j=0;j<nv;j++) for (i=0;i<bs;i++) H[nv+i+j*ld] = 0.0;
+        PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&H));
+        if (k<eps->nev) {
+          for (i=0;i<bs && !breakdown;i++) PetscCall(EPSGetStartVector(eps,k+i,&breakdown));
+          if (breakdown) {
+            eps->reason = EPS_DIVERGED_BREAKDOWN;
+            PetscCall(PetscInfo(eps,"Unable to generate more start vectors\n"));
+          }
+        }
+      } else {
+        /* Prepare the Rayleigh quotient for restart */
+        PetscCall(DSUpdateExtraRow(eps->ds));
+        PetscCall(DSTruncate(eps->ds,k+l,PETSC_FALSE));
+        /* locked vectors are deflated, discard their coupling with the residual block */
+        PetscCall(DSGetArray(eps->ds,DS_MAT_A,&H));
+        for (j=0;j<k;j++) for (i=0;i<bs;i++) H[k+l+i+j*ld] = 0.0;
+        PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&H));
+      }
+    }
+    /* Update the corresponding vectors V(:,idx) = V*Q(:,idx) */
+    PetscCall(DSGetMat(eps->ds,DS_MAT_Q,&U));
+    PetscCall(BVMultInPlace(eps->V,U,eps->nconv,k+l));
+    PetscCall(DSRestoreMat(eps->ds,DS_MAT_Q,&U));
+
+    /* The residual block of the factorization is the next block of the basis */
+    if (eps->reason == EPS_CONVERGED_ITERATING && k<nv) {
+      for (i=0;i<bs;i++) PetscCall(BVCopyColumn(eps->V,nv+i,k+l+i));
+    }
+    eps->nconv = k;
+    ctx->nkeep = l;
+    PetscCall(EPSMonitor(eps,eps->its,nconv,eps->eigr,eps->eigi,eps->errest,nv));
+  }
+
+  PetscCall(DSTruncate(eps->ds,eps->nconv,PETSC_TRUE));
+  PetscCall(BVDestroy(&W));
+  PetscCall(MatDestroy(&R));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
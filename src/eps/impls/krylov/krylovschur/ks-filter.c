@@ -0,0 +1,324 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SLEPc eigensolver: "krylovschur"
+
+   Method: Krylov-Schur with polynomial filter in several slices
+
+   Algorithm:
+
+       The computational interval is split in as many slices as partitions
+       of the communicator, with about the same number of eigenvalues each
+       according to an estimation of the density of states (DOS) obtained
+       with the kernel polynomial method. Each partition computes the
+       eigenvalues of its slice with the polynomial filter of STFILTER, so
+       that no factorization is required, and the solution is gathered in
+       all processes at the end.
+
+   References:
+
+       [1] L. Lin, Y. Saad and C. Yang, "Approximating spectral densities of
+           large matrices", SIAM Rev. 58(1):34-65, 2016.
+
+       [2] R. Li, Y. Xi, E. Vecharynski, C. Yang and Y. Saad, "A thick-restart
+           Lanczos algorithm with polynomial filtering for Hermitian eigenvalue
+           problems", SIAM J. Sci. Comput. 38(4):A2512-A2534, 2016.
+*/
+
+#include <slepc/private/epsimpl.h>
+#include "krylovschur.h"
+
+#define FILTER_NPOINTS 200  /* number of points where the DOS is evaluated */
+
+/*
+   Estimates the number of eigenvalues of A in [rleft,x[k]], where [rleft,rright] is
+   the range of the filter, with a Chebyshev expansion of degree deg of the step
+   function with Jackson damping. The Chebyshev moments are the traces of T_k(A)
+   in the mapped variable, estimated with nvec random vectors with entries +-1
+*/
+static PetscErrorCode EPSFilterSliceCount(EPS eps,PetscInt nvec,PetscInt deg,PetscInt np,const PetscReal *x,PetscReal *count)
+{
+  Mat         A,M;
+  BV          W,T[3];
+  PetscInt    i,k;
+  PetscReal   rleft,rright,c,e,*mu,*g,a,th,t;
+  PetscScalar *pM;
+
+  PetscFunctionBegin;
+  PetscCall(STGetMatrix(eps->st,0,&A));
+  PetscCall(STFilterGetRange(eps->st,&rleft,&rright));
+  c = (rright+rleft)/2.0;
+  e = (rright-rleft)/2.0;
+  PetscCall(PetscMalloc2(deg+1,&mu,deg+1,&g));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,nvec,nvec,NULL,&M));
+  PetscCall(BVDuplicateResize(eps->V,nvec,&W));
+  PetscCall(BVSetRandomSign(W));
+  for (i=0;i<3;i++) PetscCall(BVDuplicate(W,&T[i]));
+
+  /* moments mu_k = trace(T_k((A-c*I)/e))/n, with T_{k+1} = 2*(A-c*I)/e*T_k - T_{k-1} */
+  PetscCall(BVCopy(W,T[0]));
+  for (k=0;k<=deg;k++) {
+    PetscCall(BVDot(T[k%3],W,M));
+    PetscCall(MatDenseGetArray(M,&pM));
+    for (mu[k]=0.0,i=0;i<nvec;i++) mu[k] += PetscRealPart(pM[i+i*nvec]);
+    PetscCall(MatDenseRestoreArray(M,&pM));
+    mu[k] /= nvec*eps->n;
+    if (k==deg) break;
+    PetscCall(BVMatMult(T[k%3],A,T[(k+1)%3]));
+    PetscCall(BVMult(T[(k+1)%3],-c,1.0,T[k%3],NULL));
+    PetscCall(BVScale(T[(k+1)%3],(k? 2.0: 1.0)/e));
+    if (k) PetscCall(BVMult(T[(k+1)%3],-1.0,1.0,T[(k+2)%3],NULL));
+  }
+
+  /* Jackson damping coefficients */
+  a = PETSC_PI/(deg+2);
+  for (k=0;k<=deg;k++) g[k] = ((deg-k+2)*PetscCosReal(k*a)+PetscSinReal(k*a)/PetscTanReal(a))/(deg+2);
+
+  /* expansion of the step function of [-1,t], the estimated count must be nondecreasing */
+  for (i=0;i<np;i++) {
+    t  = PetscMax(-1.0,PetscMin(1.0,(x[i]-c)/e));
+    th = PetscAcosReal(t);
+    count[i] = g[0]*mu[0]*(PETSC_PI-th)/PETSC_PI;
+    for (k=1;k<=deg;k++) count[i] -= 2.0*g[k]*mu[k]*PetscSinReal(k*th)/(k*PETSC_PI);
+    count[i] = PetscMax(0.0,PetscMin(1.0,count[i]))*eps->n;
+    if (i) count[i] = PetscMax(count[i],count[i-1]);
+  }
+
+  for (i=0;i<3;i++) PetscCall(BVDestroy(&T[i]));
+  PetscCall(BVDestroy(&W));
+  PetscCall(MatDestroy(&M));
+  PetscCall(PetscFree2(mu,g));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Creates the eps of each partition, that computes the eigenvalues of its slice with
+   the filter. Unless the subintervals have been set by the user, they are chosen so
+   that the DOS estimates the same number of eigenvalues in all of them
+*/
+PetscErrorCode EPSSetUp_KrylovSchur_FilterSlice(EPS eps)
+{
+  EPS_KRYLOVSCHUR    *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt           i,k,np=FILTER_NPOINTS,nev;
+  PetscReal          rleft,rright,a,b,h,t,*x,*count;
+  PetscBool          flg;
+  Mat                A;
+  BV                 V;
+  BVType             type;
+  PetscReal          eta;
+  BVOrthogType       orthog_type;
+  BVOrthogRefineType orthog_ref;
+  BVOrthogBlockType  ob_type;
+  STFilterType       ftype;
+  STFilterDamping    damping;
+  PetscRandom        rand;
+
+  PetscFunctionBegin;
+  PetscCall(STGetMatrix(eps->st,0,&A));
+  PetscCall(MatHasOperation(A,MATOP_CREATE_SUBMATRICES,&flg));
+  PetscCheck(flg,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Filtered slicing with several partitions requires a matrix that can be redistributed in the partitions, use one partition for matrix-free operators");
+  PetscCall(STFilterGetRange(eps->st,&rleft,&rright));
+  a = PetscMax(eps->inta,rleft);
+  b = PetscMin(eps->intb,rright);
+
+  /* estimate the eigenvalue count at equispaced points of [a,b] */
+  PetscCall(PetscMalloc2(np+1,&x,np+1,&count));
+  h = (b-a)/np;
+  for (k=0;k<=np;k++) x[k] = (k==np)? b: a+k*h;
+  PetscCall(EPSFilterSliceCount(eps,ctx->dosvec,ctx->dosdeg,np+1,x,count));
+  PetscCall(PetscInfo(eps,"The density of states gives %g eigenvalues in the interval\n",(double)(count[np]-count[0])));
+
+  /* subintervals with the same estimated number of eigenvalues */
+  if (!ctx->subintset) {
+    PetscCall(PetscFree(ctx->subintervals));
+    PetscCall(PetscMalloc1(ctx->npart+1,&ctx->subintervals));
+    ctx->subintervals[0] = eps->inta;
+    ctx->subintervals[ctx->npart] = eps->intb;
+    for (i=1,k=0;i<ctx->npart;i++) {
+      if (count[np]>count[0]) {
+        t = count[0]+(PetscReal)i*(count[np]-count[0])/ctx->npart;
+        while (k<np-1 && count[k+1]<=t) k++;
+        ctx->subintervals[i] = (count[k+1]>count[k])? x[k]+h*(t-count[k])/(count[k+1]-count[k]): x[k+1];
+      } else ctx->subintervals[i] = a+i*(b-a)/ctx->npart;
+    }
+  }
+
+  /* configure the eps of this partition */
+  PetscCall(EPSKrylovSchurGetChildEPS(eps,&ctx->eps));
+  a = ctx->subintervals[ctx->subc->color];
+  b = ctx->subintervals[ctx->subc->color+1];
+  for (k=0;k<np && x[k+1]<=PetscMax(a,rleft);k++);
+  for (i=k;i<np && x[i]<PetscMin(b,rright);i++);
+  nev = (PetscInt)PetscCeilReal(1.2*(count[i]-count[k]));
+  PetscCall(PetscFree2(x,count));
+  PetscCall(EPSSetInterval(ctx->eps,a,b));
+  PetscCall(EPSSetDimensions(ctx->eps,PetscMax(10,nev),PETSC_DETERMINE,PETSC_DETERMINE));
+  PetscCall(EPSSetTolerances(ctx->eps,eps->tol,eps->max_it));
+  PetscCall(EPSSetConvergenceTest(ctx->eps,eps->conv));
+  PetscCall(EPSKrylovSchurSetRestart(ctx->eps,ctx->keep));
+  PetscCall(EPSKrylovSchurSetLocking(ctx->eps,ctx->lock));
+  PetscCall(STFilterGetType(eps->st,&ftype));
+  PetscCall(STFilterSetType(ctx->eps->st,ftype));
+  PetscCall(STFilterGetDamping(eps->st,&damping));
+  PetscCall(STFilterSetDamping(ctx->eps->st,damping));
+  PetscCall(STFilterGetDegree(eps->st,&k));
+  PetscCall(STFilterSetDegree(ctx->eps->st,k));
+  PetscCall(STFilterSetRange(ctx->eps->st,rleft,rright));
+
+  /* transfer options from eps->V */
+  PetscCall(EPSGetBV(ctx->eps,&V));
+  PetscCall(BVGetRandomContext(V,&rand));  /* make sure the random context is available when duplicating */
+  PetscCall(BVGetType(eps->V,&type));
+  PetscCall(BVSetType(V,type));
+  PetscCall(BVGetOrthogonalization(eps->V,&orthog_type,&orthog_ref,&eta,&ob_type));
+  PetscCall(BVSetOrthogonalization(V,orthog_type,orthog_ref,eta,ob_type));
+
+  ctx->eps->which = EPS_ALL;
+  PetscCall(EPSSetProblemType(ctx->eps,eps->problem_type));
+  PetscCall(EPSSetUp(ctx->eps));
+  eps->ops->backtransform = EPSBackTransform_Skip;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Copies the eigenvectors computed by all partitions to the columns of eps->V,
+   in the same order as the eigenvalues
+*/
+static PetscErrorCode EPSFilterSliceGatherEigenVectors(EPS eps)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  Vec             v,vg,x;
+  IS              is1,is2;
+  VecScatter      vec_sc;
+  PetscInt        nloc,m0,n0,i,si,idx=0,*idx1,*idx2,j;
+  PetscScalar     *array;
+  MPI_Comm        contpar;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetColumn(eps->V,0,&v));
+  PetscCall(VecGetOwnershipRange(v,&n0,&m0));
+  PetscCall(BVRestoreColumn(eps->V,0,&v));
+  PetscCall(EPSCreateVecs(ctx->eps,&x,NULL));
+  PetscCall(VecGetLocalSize(x,&nloc));
+  PetscCall(PetscMalloc2(m0-n0,&idx1,m0-n0,&idx2));
+  PetscCall(PetscSubcommGetContiguousParent(ctx->subc,&contpar));
+  PetscCall(VecCreateMPI(contpar,nloc,PETSC_DECIDE,&vg));
+  for (si=0;si<ctx->npart;si++) {
+    for (i=n0,j=0;i<m0;i++,j++) {
+      idx1[j] = i;
+      idx2[j] = i+eps->n*si;
+    }
+    PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)eps),m0-n0,idx1,PETSC_COPY_VALUES,&is1));
+    PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)eps),m0-n0,idx2,PETSC_COPY_VALUES,&is2));
+    PetscCall(BVGetColumn(eps->V,0,&v));
+    PetscCall(VecScatterCreate(v,is1,vg,is2,&vec_sc));
+    PetscCall(BVRestoreColumn(eps->V,0,&v));
+    PetscCall(ISDestroy(&is1));
+    PetscCall(ISDestroy(&is2));
+    for (i=0;i<ctx->nconv_loc[si];i++) {
+      if (ctx->subc->color==si) {
+        PetscCall(EPSGetEigenvector(ctx->eps,i,x,NULL));
+        PetscCall(VecGetArray(x,&array));
+        PetscCall(VecPlaceArray(vg,array));
+      }
+      PetscCall(BVGetColumn(eps->V,idx,&v));
+      PetscCall(VecScatterBegin(vec_sc,vg,v,INSERT_VALUES,SCATTER_REVERSE));
+      PetscCall(VecScatterEnd(vec_sc,vg,v,INSERT_VALUES,SCATTER_REVERSE));
+      PetscCall(BVRestoreColumn(eps->V,idx++,&v));
+      if (ctx->subc->color==si) {
+        PetscCall(VecResetArray(vg));
+        PetscCall(VecRestoreArray(x,&array));
+      }
+    }
+    PetscCall(VecScatterDestroy(&vec_sc));
+  }
+  PetscCall(PetscFree2(idx1,idx2));
+  PetscCall(VecDestroy(&vg));
+  PetscCall(VecDestroy(&x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode EPSSolve_KrylovSchur_FilterSlice(EPS eps)
+{
+  EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt        i,nconv,its,reason;
+  PetscMPIInt     rank,nproc,aux,*disp;
+  PetscScalar     *eig_loc,*eig;
+  PetscReal       *err_loc,*err;
+  MPI_Comm        child;
+
+  PetscFunctionBegin;
+  /* each partition solves its slice */
+  PetscCall(EPSSolve(ctx->eps));
+  PetscCall(EPSGetConverged(ctx->eps,&nconv));
+  PetscCall(EPSGetIterationNumber(ctx->eps,&its));
+  reason = (PetscInt)ctx->eps->reason;
+  PetscCall(PetscMalloc2(nconv,&eig_loc,nconv,&err_loc));
+  for (i=0;i<nconv;i++) {
+    PetscCall(EPSGetEigenvalue(ctx->eps,i,eig_loc+i,NULL));
+    PetscCall(EPSGetErrorEstimate(ctx->eps,i,err_loc+i));
+  }
+
+  /* gather the number of eigenvalues of each partition */
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)eps),&nproc));
+  PetscCall(PetscFree(ctx->nconv_loc));
+  PetscCall(PetscMalloc1(ctx->npart,&ctx->nconv_loc));
+  PetscCall(PetscMalloc1(ctx->npart,&disp));
+  PetscCall(PetscMPIIntCast(nconv,&aux));
+  if (!rank) {
+    PetscCallMPI(MPI_Allgather(&aux,1,MPI_INT,ctx->nconv_loc,1,MPI_INT,ctx->commrank));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,&its,1,MPIU_INT,MPI_MAX,ctx->commrank));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,&reason,1,MPIU_INT,MPI_MIN,ctx->commrank));
+  }
+  PetscCall(PetscMPIIntCast(ctx->npart,&aux));
+  PetscCallMPI(MPI_Bcast(ctx->nconv_loc,aux,MPI_INT,0,child));
+  PetscCallMPI(MPI_Bcast(&its,1,MPIU_INT,0,child));
+  PetscCallMPI(MPI_Bcast(&reason,1,MPIU_INT,0,child));
+  disp[0] = 0;
+  for (i=1;i<ctx->npart;i++) disp[i] = disp[i-1]+ctx->nconv_loc[i-1];
+  nconv = disp[ctx->npart-1]+ctx->nconv_loc[ctx->npart-1];
+
+  /* make room for all eigenpairs, the number of eigenvalues in the interval was only estimated */
+  if (nconv>eps->ncv) {
+    eps->ncv = nconv;
+    PetscCall(EPSAllocateSolution(eps,0));
+  }
+
+  /* gather eigenvalues and error estimates, all processes with the same rank in the partitions have the whole set */
+  PetscCall(PetscMalloc2(nconv,&eig,nconv,&err));
+  PetscCall(PetscMPIIntCast(ctx->nconv_loc[ctx->subc->color],&aux));
+  if (nproc%ctx->npart==0 || !rank) {
+    PetscCallMPI(MPI_Allgatherv(eig_loc,aux,MPIU_SCALAR,eig,ctx->nconv_loc,disp,MPIU_SCALAR,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(err_loc,aux,MPIU_REAL,err,ctx->nconv_loc,disp,MPIU_REAL,ctx->commrank));
+  }
+  if (nproc%ctx->npart) {
+    PetscCall(PetscMPIIntCast(nconv,&aux));
+    PetscCallMPI(MPI_Bcast(eig,aux,MPIU_SCALAR,0,child));
+    PetscCallMPI(MPI_Bcast(err,aux,MPIU_REAL,0,child));
+  }
+  for (i=0;i<nconv;i++) {
+    eps->eigr[i]   = eig[i];
+    eps->eigi[i]   = 0.0;
+    eps->errest[i] = err[i];
+    eps->perm[i]   = i;
+  }
+  PetscCall(PetscFree2(eig,err));
+  PetscCall(PetscFree2(eig_loc,err_loc));
+  PetscCall(PetscFree(disp));
+
+  PetscCall(EPSFilterSliceGatherEigenVectors(eps));
+  eps->nconv  = nconv;
+  eps->nev    = nconv;  /* as in the filter of a single partition, nev is the number of eigenvalues in the interval */
+  eps->its    = its;
+  eps->reason = (EPSConvergedReason)reason;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
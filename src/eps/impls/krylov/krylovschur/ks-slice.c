@@ -40,6 +40,7 @@ static const char citation[] =
   "}\n";
 
 #define SLICE_PTOL PETSC_SQRT_MACHINE_EPSILON
+#define SLICE_NCHUNKS 4  /* pieces of each subinterval with dynamic load balancing */
 
 static PetscErrorCode EPSSliceResetSR(EPS eps)
 {
@@ -80,6 +81,9 @@ PetscErrorCode EPSReset_KrylovSchur_Slice(EPS eps)
   PetscCall(EPSSliceResetSR(eps));
   PetscCall(PetscFree(ctx->inertias));
   PetscCall(PetscFree(ctx->shifts));
+  PetscCall(PetscFree2(ctx->chunks,ctx->chunkinertias));
+  ctx->nchunks = 0;
+  if (ctx->win!=MPI_WIN_NULL) PetscCallMPI(MPI_Win_free(&ctx->win));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -152,6 +156,51 @@ static PetscErrorCode EPSSliceAllocateSolution(EPS eps,PetscInt extra)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Chooses the subintervals so that all partitions have about the same number of
+   eigenvalues. The inertia is computed at nsamples+1 equispaced points of the
+   interval, which are distributed among the partitions, and the endpoints of the
+   subintervals are obtained by linear interpolation of the eigenvalue count
+*/
+static PetscErrorCode EPSSliceBalanceSubintervals(EPS eps)
+{
+  EPS_KRYLOVSCHUR *ctx=(EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt        i,k,m=0,ns=ctx->nsamples,*inertias,*inertias_loc;
+  PetscReal       h,t,*shifts,*shifts_loc;
+  PetscMPIInt     rank,len;
+  MPI_Comm        child;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  PetscCall(PetscMalloc4(ns+1,&shifts,ns+1,&inertias,ns+1,&shifts_loc,ns+1,&inertias_loc));
+  h = (eps->intb-eps->inta)/ns;
+  for (k=0;k<=ns;k++) {
+    shifts[k]   = (k==ns)? eps->intb: eps->inta+k*h;
+    inertias[k] = -1;
+    if (k%ctx->npart==ctx->subc->color) shifts_loc[m++] = shifts[k];
+  }
+
+  /* each partition computes the inertia at its own points */
+  PetscCall(STGetInertia(ctx->eps->st,m,shifts_loc,inertias_loc,NULL));
+  for (k=0,i=0;k<=ns;k++) if (k%ctx->npart==ctx->subc->color) inertias[k] = inertias_loc[i++];
+  PetscCall(PetscMPIIntCast(ns+1,&len));
+  if (!rank) PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,inertias,len,MPIU_INT,MPI_MAX,ctx->commrank));
+  PetscCallMPI(MPI_Bcast(inertias,len,MPIU_INT,0,child));
+  PetscCall(PetscInfo(eps,"Sampled inertias at %" PetscInt_FMT " points give %" PetscInt_FMT " eigenvalues in the interval\n",ns+1,inertias[ns]-inertias[0]));
+
+  /* invert the piecewise linear eigenvalue count, otherwise keep the uniform subintervals */
+  if (inertias[ns]>inertias[0]) {
+    for (i=1,k=0;i<ctx->npart;i++) {
+      t = inertias[0]+(PetscReal)i*(inertias[ns]-inertias[0])/ctx->npart;
+      while (inertias[k+1]<=t) k++;
+      ctx->subintervals[i] = shifts[k]+h*(t-inertias[k])/(inertias[k+1]-inertias[k]);
+    }
+  }
+  PetscCall(PetscFree4(shifts,inertias,shifts_loc,inertias_loc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSliceGetEPS(EPS eps)
 {
   EPS_KRYLOVSCHUR    *ctx=(EPS_KRYLOVSCHUR*)eps->data,*ctx_local;
@@ -182,6 +231,11 @@ static PetscErrorCode EPSSliceGetEPS(EPS eps)
       PetscCall(PetscMalloc1(ctx->npart+1,&ctx->subintervals));
       for (i=0;i<ctx->npart;i++) ctx->subintervals[i] = eps->inta+h*i;
       ctx->subintervals[ctx->npart] = eps->intb;
+      if (ctx->nsamples) { /* same number of eigenvalues in all subintervals */
+        PetscCall(EPSSliceBalanceSubintervals(eps));
+        a = ctx->subintervals[ctx->subc->color];
+        b = ctx->subintervals[ctx->subc->color+1];
+      }
     } else {
       a = ctx->subintervals[ctx->subc->color];
       b = ctx->subintervals[ctx->subc->color+1];
@@ -194,6 +248,7 @@ static PetscErrorCode EPSSliceGetEPS(EPS eps)
 
   ctx_local = (EPS_KRYLOVSCHUR*)ctx->eps->data;
   ctx_local->detect = ctx->detect;
+  ctx_local->dynamic = (ctx->dynamic && ctx->npart>1)? PETSC_TRUE: PETSC_FALSE;
 
   /* transfer options from eps->V */
   PetscCall(EPSGetBV(ctx->eps,&V));
@@ -224,13 +279,14 @@ static PetscErrorCode EPSSliceGetEPS(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode EPSSliceGetInertia(EPS eps,PetscReal shift,PetscInt *inertia,PetscInt *zeros)
+/*
+   Computes the inertia at the given shift. If factor is true, the shift of the ST
+   is also updated, since its factorization will be used by the eigensolver, otherwise
+   the inertia is obtained with a factorization that is used only for counting
+*/
+static PetscErrorCode EPSSliceGetInertia(EPS eps,PetscReal shift,PetscBool factor,PetscInt *inertia,PetscInt *zeros)
 {
-  KSP            ksp,kspr;
-  PC             pc;
-  Mat            F;
   PetscReal      nzshift=shift;
-  PetscBool      flg;
 
   PetscFunctionBegin;
   if (shift >= PETSC_MAX_REAL) { /* Right-open interval */
@@ -243,16 +299,8 @@ static PetscErrorCode EPSSliceGetInertia(EPS eps,PetscReal shift,PetscInt *inert
        The goal is that the nonzero pattern is the same in all cases and reuse
        the symbolic factorizations */
     nzshift = (shift==0.0)? 10.0/PETSC_MAX_REAL: shift;
-    PetscCall(STSetShift(eps->st,nzshift));
-    PetscCall(STGetKSP(eps->st,&ksp));
-    PetscCall(KSPGetPC(ksp,&pc));
-    PetscCall(PetscObjectTypeCompare((PetscObject)pc,PCREDUNDANT,&flg));
-    if (flg) {
-      PetscCall(PCRedundantGetKSP(pc,&kspr));
-      PetscCall(KSPGetPC(kspr,&pc));
-    }
-    PetscCall(PCFactorGetMatrix(pc,&F));
-    PetscCall(MatGetInertia(F,inertia,zeros,NULL));
+    if (factor) PetscCall(STSetShift(eps->st,nzshift));
+    PetscCall(STGetInertia(eps->st,1,&nzshift,inertia,zeros));
   }
   if (inertia) PetscCall(PetscInfo(eps,"Computed inertia at shift %g: %" PetscInt_FMT "\n",(double)nzshift,*inertia));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -261,9 +309,74 @@ static PetscErrorCode EPSSliceGetInertia(EPS eps,PetscReal shift,PetscInt *inert
 /*
    Dummy backtransform operation
  */
-static PetscErrorCode EPSBackTransform_Skip(EPS eps)
+PetscErrorCode EPSBackTransform_Skip(EPS eps)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Splits the subinterval of each partition in pieces for dynamic load balancing.
+   The inertia at the interior endpoints of the pieces is computed by each partition
+   in its subinterval, and the result is gathered so that all processes know the
+   number of eigenvalues of every piece. The initial queue of each partition contains
+   the pieces of its subinterval.
+*/
+static PetscErrorCode EPSSliceSetUpChunks(EPS eps)
 {
+  EPS_KRYLOVSCHUR *ctx=(EPS_KRYLOVSCHUR*)eps->data;
+  EPS_SR          sr=ctx->sr,sr_loc=((EPS_KRYLOVSCHUR*)ctx->eps->data)->sr;
+  PetscInt        i,nc,zeros=0,inertias_loc[SLICE_NCHUNKS];
+  PetscReal       a,b,shifts_loc[SLICE_NCHUNKS];
+  PetscMPIInt     rank,aux,*nc_loc,*disp;
+  MPI_Comm        child;
+
   PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  /* pieces of the local subinterval, with the inertia at their left endpoints */
+  a = PetscMin(sr_loc->int0,sr_loc->int1);
+  b = PetscMax(sr_loc->int0,sr_loc->int1);
+  nc = (a>PETSC_MIN_REAL && b<PETSC_MAX_REAL)? SLICE_NCHUNKS: 1;
+  shifts_loc[0]   = a;
+  inertias_loc[0] = (sr_loc->int0<sr_loc->int1)? sr_loc->inertia0: sr_loc->inertia1;
+  for (i=1;i<nc;i++) {
+    shifts_loc[i] = a+i*(b-a)/nc;
+    PetscCall(EPSSliceGetInertia(ctx->eps,shifts_loc[i],PETSC_FALSE,&inertias_loc[i],ctx->detect?&zeros:NULL));
+    if (zeros) {
+      shifts_loc[i] *= (1.0+SLICE_PTOL);
+      PetscCall(EPSSliceGetInertia(ctx->eps,shifts_loc[i],PETSC_FALSE,&inertias_loc[i],&zeros));
+      PetscCheck(zeros==0,((PetscObject)eps)->comm,PETSC_ERR_CONV_FAILED,"Inertia computation fails in %g",(double)shifts_loc[i]);
+    }
+  }
+
+  /* gather the pieces of all partitions */
+  PetscCall(PetscMalloc2(ctx->npart,&nc_loc,ctx->npart,&disp));
+  PetscCall(PetscMPIIntCast(nc,&aux));
+  if (!rank) PetscCallMPI(MPI_Allgather(&aux,1,MPI_INT,nc_loc,1,MPI_INT,ctx->commrank));
+  PetscCall(PetscMPIIntCast(ctx->npart,&aux));
+  PetscCallMPI(MPI_Bcast(nc_loc,aux,MPI_INT,0,child));
+  disp[0] = 0;
+  for (i=1;i<ctx->npart;i++) disp[i] = disp[i-1]+nc_loc[i-1];
+  ctx->nchunks = disp[ctx->npart-1]+nc_loc[ctx->npart-1];
+  PetscCall(PetscFree2(ctx->chunks,ctx->chunkinertias));
+  PetscCall(PetscMalloc2(ctx->nchunks+1,&ctx->chunks,ctx->nchunks+1,&ctx->chunkinertias));
+  if (!rank) {
+    PetscCall(PetscMPIIntCast(nc,&aux));
+    PetscCallMPI(MPI_Allgatherv(shifts_loc,aux,MPIU_REAL,ctx->chunks,nc_loc,disp,MPIU_REAL,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(inertias_loc,aux,MPIU_INT,ctx->chunkinertias,nc_loc,disp,MPIU_INT,ctx->commrank));
+  }
+  PetscCall(PetscMPIIntCast(ctx->nchunks,&aux));
+  PetscCallMPI(MPI_Bcast(ctx->chunks,aux,MPIU_REAL,0,child));
+  PetscCallMPI(MPI_Bcast(ctx->chunkinertias,aux,MPIU_INT,0,child));
+  ctx->chunks[ctx->nchunks]        = (sr->dir>0)? sr->int1: sr->int0;
+  ctx->chunkinertias[ctx->nchunks] = (sr->dir>0)? sr->inertia1: sr->inertia0;
+  ctx->qinit[0] = disp[ctx->subc->color];
+  ctx->qinit[1] = disp[ctx->subc->color]+nc_loc[ctx->subc->color];
+  PetscCall(PetscFree2(nc_loc,disp));
+
+  /* window to access the queues, only the first process of each partition uses it */
+  if (ctx->win==MPI_WIN_NULL) PetscCallMPI(MPI_Win_create(ctx->queue,(MPI_Aint)(2*sizeof(PetscInt)),(PetscMPIInt)sizeof(PetscInt),MPI_INFO_NULL,ctx->commrank,&ctx->win));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -278,6 +391,7 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
   Mat             A,B=NULL;
   DSParallelType  ptype;
   MPI_Comm        child;
+  PetscBool       last,fromend;
 
   PetscFunctionBegin;
   if (ctx->global) {
@@ -313,7 +427,7 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
   sr->sPres = NULL;
   sr->nS = 0;
 
-  if (ctx->npart==1 || ctx->global) {
+  if (ctx->npart==1 || ctx->dynamic || ctx->global) {
     /* check presence of ends and finding direction */
     if ((eps->inta > PETSC_MIN_REAL && !(ctx->subintervals && ctx->subintervals[0]==ctx->subintervals[1])) || eps->intb >= PETSC_MAX_REAL) {
       sr->int0 = eps->inta;
@@ -339,7 +453,7 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
     sr_loc = ((EPS_KRYLOVSCHUR*)ctx->eps->data)->sr;
     if (ctx->npart>1) {
       PetscCall(PetscSubcommGetChild(ctx->subc,&child));
-      if ((sr->dir>0&&ctx->subc->color==0)||(sr->dir<0&&ctx->subc->color==ctx->npart-1)) sr->inertia0 = sr_loc->inertia0;
+      if ((sr->dir>0&&ctx->subc->color==0)||(sr->dir<0&&ctx->subc->color==ctx->npart-1)) sr->inertia0 = (sr_loc->dir==sr->dir)? sr_loc->inertia0: sr_loc->inertia1;
       PetscCallMPI(MPI_Comm_rank(child,&rank));
       if (!rank) {
         PetscCall(PetscMPIIntCast((sr->dir>0)?0:ctx->npart-1,&aux));
@@ -374,25 +488,30 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
     }
     sr->inertia1 = sr->inertia0+sr->dir*nEigs;
     sr->numEigs = nEigs;
+    if (((EPS_KRYLOVSCHUR*)ctx->eps->data)->dynamic) PetscCall(EPSSliceSetUpChunks(eps));
     eps->nev = nEigs;
     eps->ncv = nEigs;
     eps->mpd = nEigs;
   } else {
     ctx_glob = (EPS_KRYLOVSCHUR*)ctx->eps->data;
     sr_glob = ctx_glob->sr;
-    if (ctx->npart>1) {
+    if (ctx->npart>1 && !ctx->dynamic) {
       sr->dir = sr_glob->dir;
       sr->int0 = (sr->dir==1)?eps->inta:eps->intb;
       sr->int1 = (sr->dir==1)?eps->intb:eps->inta;
       if ((sr->dir>0&&ctx->subc->color==ctx->npart-1)||(sr->dir<0&&ctx->subc->color==0)) sr->hasEnd = sr_glob->hasEnd;
       else sr->hasEnd = PETSC_TRUE;
     }
-    /* sets first shift */
-    PetscCall(STSetShift(eps->st,(sr->int0==0.0)?10.0/PETSC_MAX_REAL:sr->int0));
+    /* sets first shift; if the subinterval is going to be traversed from int1,
+       the factorization at int0 is needed only to count eigenvalues */
+    last    = (ctx->npart==1 || ctx->dynamic || (sr->dir>0 && ctx->subc->color==ctx->npart-1) || (sr->dir<0 && ctx->subc->color==0))? PETSC_TRUE: PETSC_FALSE;
+    fromend = (last && sr->hasEnd)? PETSC_TRUE: PETSC_FALSE;
+    r = fromend? sr->int1: sr->int0;
+    PetscCall(STSetShift(eps->st,(r==0.0)?10.0/PETSC_MAX_REAL:r));
     PetscCall(STSetUp(eps->st));
 
     /* compute inertia0 */
-    PetscCall(EPSSliceGetInertia(eps,sr->int0,&sr->inertia0,ctx->detect?&zeros:NULL));
+    PetscCall(EPSSliceGetInertia(eps,sr->int0,PetscNot(fromend),&sr->inertia0,ctx->detect?&zeros:NULL));
     /* undocumented option to control what to do when an eigenvalue is found:
        - error out if it's the endpoint of the user-provided interval (or sub-interval)
        - if it's an endpoint computed internally:
@@ -404,15 +523,15 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
     if (zeros) { /* error in factorization */
       PetscCheck(sr->int0!=ctx->eps->inta && sr->int0!=ctx->eps->intb,((PetscObject)eps)->comm,PETSC_ERR_USER,"Found singular matrix for the transformed problem in the interval endpoint");
       PetscCheck(!ctx_glob->subintset || hiteig,((PetscObject)eps)->comm,PETSC_ERR_USER,"Found singular matrix for the transformed problem in an interval endpoint defined by user");
-      if (hiteig==1) { /* idle subgroup */
+      if (hiteig==1 && !ctx->dynamic) { /* idle subgroup */
         sr->inertia0 = -1;
       } else { /* perturb shift */
         sr->int0 *= (1.0+SLICE_PTOL);
-        PetscCall(EPSSliceGetInertia(eps,sr->int0,&sr->inertia0,&zeros));
+        PetscCall(EPSSliceGetInertia(eps,sr->int0,PetscNot(fromend),&sr->inertia0,&zeros));
         PetscCheck(zeros==0,((PetscObject)eps)->comm,PETSC_ERR_CONV_FAILED,"Inertia computation fails in %g",(double)sr->int1);
       }
     }
-    if (ctx->npart>1) {
+    if (ctx->npart>1 && !ctx->dynamic) {
       PetscCall(PetscSubcommGetChild(ctx->subc,&child));
       /* inertia1 is received from neighbour */
       PetscCallMPI(MPI_Comm_rank(child,&rank));
@@ -441,8 +560,12 @@ PetscErrorCode EPSSetUp_KrylovSchur_Slice(EPS eps)
     }
 
     /* last process in eps comm computes inertia1 */
-    if (ctx->npart==1 || ((sr->dir>0 && ctx->subc->color==ctx->npart-1) || (sr->dir<0 && ctx->subc->color==0))) {
-      PetscCall(EPSSliceGetInertia(eps,sr->int1,&sr->inertia1,ctx->detect?&zeros:NULL));
+    if (last) {
+      PetscCall(EPSSliceGetInertia(eps,sr->int1,PETSC_TRUE,&sr->inertia1,ctx->detect?&zeros:NULL));
+      if (zeros && ctx->dynamic && sr->int1!=ctx->eps->inta && sr->int1!=ctx->eps->intb) { /* perturb as in the neighbour piece */
+        sr->int1 *= (1.0+SLICE_PTOL);
+        PetscCall(EPSSliceGetInertia(eps,sr->int1,PETSC_TRUE,&sr->inertia1,&zeros));
+      }
       PetscCheck(zeros==0,((PetscObject)eps)->comm,PETSC_ERR_USER,"Found singular matrix for the transformed problem in an interval endpoint defined by user");
       if (!rank && sr->inertia0==-1) {
         sr->inertia0 = sr->inertia1; sr->int0 = sr->int1;
@@ -495,6 +618,7 @@ static PetscErrorCode EPSSliceGatherEigenVectors(EPS eps)
   PetscScalar     *array;
   EPS_SR          sr_loc;
   BV              V_loc;
+  MPI_Comm        contpar;
 
   PetscFunctionBegin;
   sr_loc = ((EPS_KRYLOVSCHUR*)ctx->eps->data)->sr;
@@ -508,7 +632,9 @@ static PetscErrorCode EPSSliceGatherEigenVectors(EPS eps)
   PetscCall(VecGetLocalSize(v,&nloc));
   PetscCall(BVRestoreColumn(ctx->eps->V,0,&v));
   PetscCall(PetscMalloc2(m0-n0,&idx1,m0-n0,&idx2));
-  PetscCall(VecCreateMPI(PetscObjectComm((PetscObject)eps),nloc,PETSC_DECIDE,&vg));
+  /* vg holds one vector per partition, with the processes ordered by partition */
+  PetscCall(PetscSubcommGetContiguousParent(ctx->subc,&contpar));
+  PetscCall(VecCreateMPI(contpar,nloc,PETSC_DECIDE,&vg));
   idx = -1;
   for (si=0;si<ctx->npart;si++) {
     j = 0;
@@ -556,8 +682,84 @@ PetscErrorCode EPSComputeVectors_Slice(EPS eps)
   PetscFunctionBegin;
   if (ctx->global && ctx->npart>1) {
     PetscCall(EPSComputeVectors(ctx->eps));
-    PetscCall(EPSSliceGatherEigenVectors(eps));
+    if (!ctx->distributed) PetscCall(EPSSliceGatherEigenVectors(eps));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  EPSAllocateSolution_Slice - Allocates the solution of the global eps when the
+  eigenvectors are left in the partitions, eps->V has room for one vector only
+ */
+PetscErrorCode EPSAllocateSolution_Slice(EPS eps)
+{
+  PetscInt ncv=eps->ncv;
+
+  PetscFunctionBegin;
+  eps->ncv = 0;
+  PetscCall(EPSAllocateSolution(eps,1));
+  eps->ncv = ncv;
+  PetscCall(PetscFree4(eps->eigr,eps->eigi,eps->errest,eps->perm));
+  PetscCall(PetscMalloc4(ncv,&eps->eigr,ncv,&eps->eigi,ncv,&eps->errest,ncv,&eps->perm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  EPSGetEigenvector_Slice - Gets the i-th eigenvector from the subcommunicator
+  that computed it, used when the eigenvectors have not been gathered in eps->V
+ */
+PetscErrorCode EPSGetEigenvector_Slice(EPS eps,PetscInt i,Vec Vr,Vec Vi)
+{
+  Vec             vg,v_loc;
+  IS              is1,is2;
+  VecScatter      vec_sc;
+  EPS_KRYLOVSCHUR *ctx=(EPS_KRYLOVSCHUR*)eps->data;
+  PetscInt        nloc,m0,n0,j,k,si,off=0,*idx1,*idx2;
+  PetscScalar     *array;
+  BV              V_loc;
+  MPI_Comm        contpar;
+
+  PetscFunctionBegin;
+  if (Vi) PetscCall(VecSet(Vi,0.0));
+  if (!Vr) PetscFunctionReturn(PETSC_SUCCESS);
+  V_loc = ((EPS_KRYLOVSCHUR*)ctx->eps->data)->sr->V;
+
+  /* find the partition that owns the eigenvector, the columns of eps->V follow the order of partitions */
+  k = eps->perm[i];
+  for (si=0;si<ctx->npart-1 && k>=off+ctx->nconv_loc[si];si++) off += ctx->nconv_loc[si];
+
+  /* scatter the local column of the owner partition to Vr */
+  PetscCall(VecGetOwnershipRange(Vr,&n0,&m0));
+  PetscCall(BVGetColumn(ctx->eps->V,0,&v_loc));
+  PetscCall(VecGetLocalSize(v_loc,&nloc));
+  PetscCall(BVRestoreColumn(ctx->eps->V,0,&v_loc));
+  PetscCall(PetscMalloc2(m0-n0,&idx1,m0-n0,&idx2));
+  for (j=0;j<m0-n0;j++) {
+    idx1[j] = n0+j;
+    idx2[j] = n0+j+eps->n*si;
+  }
+  PetscCall(PetscSubcommGetContiguousParent(ctx->subc,&contpar));
+  PetscCall(VecCreateMPI(contpar,nloc,PETSC_DECIDE,&vg));
+  PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)eps),m0-n0,idx1,PETSC_COPY_VALUES,&is1));
+  PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)eps),m0-n0,idx2,PETSC_COPY_VALUES,&is2));
+  PetscCall(VecScatterCreate(Vr,is1,vg,is2,&vec_sc));
+  PetscCall(ISDestroy(&is1));
+  PetscCall(ISDestroy(&is2));
+  if (ctx->subc->color==si) {
+    PetscCall(BVGetColumn(V_loc,k-off,&v_loc));
+    PetscCall(VecGetArray(v_loc,&array));
+    PetscCall(VecPlaceArray(vg,array));
+  }
+  PetscCall(VecScatterBegin(vec_sc,vg,Vr,INSERT_VALUES,SCATTER_REVERSE));
+  PetscCall(VecScatterEnd(vec_sc,vg,Vr,INSERT_VALUES,SCATTER_REVERSE));
+  if (ctx->subc->color==si) {
+    PetscCall(VecResetArray(vg));
+    PetscCall(VecRestoreArray(v_loc,&array));
+    PetscCall(BVRestoreColumn(V_loc,k-off,&v_loc));
   }
+  PetscCall(VecScatterDestroy(&vec_sc));
+  PetscCall(VecDestroy(&vg));
+  PetscCall(PetscFree2(idx1,idx2));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -622,6 +824,7 @@ static PetscErrorCode EPSSliceGatherSolution(EPS eps)
   PetscScalar     *eigr_loc;
   EPS_SR          sr_loc;
   PetscReal       *shifts_loc;
+  PetscBool       dynamic=((EPS_KRYLOVSCHUR*)ctx->eps->data)->dynamic;
   MPI_Comm        child;
 
   PetscFunctionBegin;
@@ -630,13 +833,21 @@ static PetscErrorCode EPSSliceGatherSolution(EPS eps)
   sr_loc = ((EPS_KRYLOVSCHUR*)ctx->eps->data)->sr;
 
   /* Gather the shifts used and the inertias computed */
-  PetscCall(EPSSliceGetInertias(ctx->eps,&ns,&shifts_loc,&inertias_loc));
-  if (ctx->sr->dir>0 && shifts_loc[ns-1]==sr_loc->int1 && ctx->subc->color<ctx->npart-1) ns--;
-  if (ctx->sr->dir<0 && shifts_loc[ns-1]==sr_loc->int0 && ctx->subc->color>0) {
-    ns--;
-    for (i=0;i<ns;i++) {
-      inertias_loc[i] = inertias_loc[i+1];
-      shifts_loc[i] = shifts_loc[i+1];
+  if (dynamic) {  /* accumulated in EPSSliceSolveDynamic() */
+    ns = ctx->nshifts;
+    shifts_loc = ctx->shifts;
+    inertias_loc = ctx->inertias;
+    ctx->shifts = NULL;
+    ctx->inertias = NULL;
+  } else {
+    PetscCall(EPSSliceGetInertias(ctx->eps,&ns,&shifts_loc,&inertias_loc));
+    if (ctx->sr->dir>0 && shifts_loc[ns-1]==sr_loc->int1 && ctx->subc->color<ctx->npart-1) ns--;
+    if (ctx->sr->dir<0 && shifts_loc[ns-1]==sr_loc->int0 && ctx->subc->color>0) {
+      ns--;
+      for (i=0;i<ns;i++) {
+        inertias_loc[i] = inertias_loc[i+1];
+        shifts_loc[i] = shifts_loc[i+1];
+      }
     }
   }
   PetscCall(PetscMalloc1(ctx->npart,&ns_loc));
@@ -695,6 +906,18 @@ static PetscErrorCode EPSSliceGatherSolution(EPS eps)
     for (j=0;j<ctx->nconv_loc[i];j++) eps->perm[idx++] += off;
   }
 
+  /* with dynamic balancing the pieces are not in order, so sort the shifts and remove duplicates */
+  if (dynamic) {
+    PetscCall(PetscSortRealWithArrayInt(ctx->nshifts,ctx->shifts,ctx->inertias));
+    for (i=1,j=0;i<ctx->nshifts;i++) {
+      if (ctx->shifts[i]==ctx->shifts[j]) continue;
+      j++;
+      ctx->shifts[j] = ctx->shifts[i];
+      ctx->inertias[j] = ctx->inertias[i];
+    }
+    if (ctx->nshifts) ctx->nshifts = j+1;
+  }
+
   /* Gather parallel eigenvectors */
   PetscCall(PetscFree(ns_loc));
   PetscCall(PetscFree(disp));
@@ -810,14 +1033,14 @@ static PetscErrorCode EPSExtractShift(EPS eps)
     sr->sPrev = sr->sPres;
     sr->sPres = sr->pending[--sr->nPend];
     sPres = sr->sPres;
-    PetscCall(EPSSliceGetInertia(eps,sPres->value,&iner,ctx->detect?&zeros:NULL));
+    PetscCall(EPSSliceGetInertia(eps,sPres->value,PETSC_TRUE,&iner,ctx->detect?&zeros:NULL));
     if (zeros) {
       diam = PetscMin(PetscAbsReal(sPres->neighb[0]->value-sPres->value),PetscAbsReal(sPres->neighb[1]->value-sPres->value));
       ptol = PetscMin(SLICE_PTOL,diam/2);
       newShift = sPres->value*(1.0+ptol);
       if (sr->dir*(sPres->neighb[0] && newShift-sPres->neighb[0]->value) < 0) newShift = (sPres->value+sPres->neighb[0]->value)/2;
       else if (sPres->neighb[1] && sr->dir*(sPres->neighb[1]->value-newShift) < 0) newShift = (sPres->value+sPres->neighb[1]->value)/2;
-      PetscCall(EPSSliceGetInertia(eps,newShift,&iner,&zeros));
+      PetscCall(EPSSliceGetInertia(eps,newShift,PETSC_TRUE,&iner,&zeros));
       PetscCheck(zeros==0,((PetscObject)eps)->comm,PETSC_ERR_CONV_FAILED,"Inertia computation fails in %g",(double)newShift);
       sPres->value = newShift;
     }
@@ -1213,6 +1436,147 @@ static PetscErrorCode EPSLookForDeflation(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Gets the index of the next piece to be processed by this partition, or -1 if
+   there is no work left. The queues are accessed with passive target one-sided
+   communication by the first process of each partition, and the result is
+   broadcast to the rest of processes.
+*/
+static PetscErrorCode EPSSliceGetNextChunk(EPS eps,PetscInt *chunk)
+{
+  EPS_KRYLOVSCHUR *ctx=(EPS_KRYLOVSCHUR*)eps->data;
+  PetscMPIInt     rank,color,npart;
+  MPI_Comm        child;
+
+  PetscFunctionBegin;
+  *chunk = -1;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  if (!rank) {
+    PetscCall(PetscMPIIntCast(ctx->subc->color,&color));
+    PetscCall(PetscMPIIntCast(ctx->npart,&npart));
+    PetscCall(SlepcSliceGetNextChunk_Private((PetscObject)eps,ctx->win,color,npart,ctx->chunkinertias,chunk));
+  }
+  PetscCallMPI(MPI_Bcast(chunk,1,MPIU_INT,0,child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solves the pieces of the interval with dynamic load balancing. The eigenpairs
+   computed in the pieces processed by this partition are accumulated, and at the
+   end they replace the solution of the last subsolve, so that they are gathered
+   in the same way as without load balancing. The same is done with the shifts.
+*/
+static PetscErrorCode EPSSliceSolveDynamic(EPS eps)
+{
+  EPS_KRYLOVSCHUR *ctx=(EPS_KRYLOVSCHUR*)eps->data,*ctx_loc=(EPS_KRYLOVSCHUR*)ctx->eps->data;
+  EPS_SR          sr_loc;
+  PetscInt        i,k,chunk,n=0,nalloc=0,its=0,ns,nsh=0,*perm=NULL,*inertias_loc,*inertias=NULL,*aux_i;
+  PetscReal       *errest=NULL,*shifts_loc,*shifts=NULL,*aux_r;
+  PetscScalar     *eigr=NULL,*eigi=NULL,*aux_s1,*aux_s2;
+  PetscReal       *aux_e;
+  PetscInt        *aux_p;
+  PetscMPIInt     rank,color,aux;
+  BV              V=NULL;
+  Vec             v;
+  MPI_Comm        child;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  /* initialize the queues, every partition starts with the pieces of its subinterval */
+  if (!rank) {
+    PetscCall(PetscMPIIntCast(ctx->subc->color,&color));
+    PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,color,0,ctx->win));
+    PetscCallMPI(MPI_Put(ctx->qinit,2,MPIU_INT,color,0,2,MPIU_INT,ctx->win));
+    PetscCallMPI(MPI_Win_unlock(color,ctx->win));
+  }
+  PetscCallMPI(MPI_Barrier(ctx->commrank));
+
+  PetscCall(EPSSliceGetNextChunk(eps,&chunk));
+  while (chunk>=0) {
+    PetscCall(PetscInfo(eps,"Solving piece %" PetscInt_FMT " [%g,%g] with %" PetscInt_FMT " eigenvalues\n",chunk,(double)ctx->chunks[chunk],(double)ctx->chunks[chunk+1],ctx->chunkinertias[chunk+1]-ctx->chunkinertias[chunk]));
+    PetscCall(EPSSetInterval(ctx->eps,ctx->chunks[chunk],ctx->chunks[chunk+1]));
+    PetscCall(EPSSetUp(ctx->eps));
+    PetscCall(EPSSolve_KrylovSchur_Slice(ctx->eps));
+    sr_loc = ctx_loc->sr;
+    k = sr_loc->indexEig;
+
+    /* append the computed eigenpairs */
+    if (n+k>nalloc) {
+      nalloc = PetscMax(2*nalloc,n+k);
+      PetscCall(PetscMalloc4(nalloc,&aux_s1,nalloc,&aux_s2,nalloc,&aux_e,nalloc,&aux_p));
+      PetscCall(PetscArraycpy(aux_s1,eigr,n));
+      PetscCall(PetscArraycpy(aux_s2,eigi,n));
+      PetscCall(PetscArraycpy(aux_e,errest,n));
+      PetscCall(PetscArraycpy(aux_p,perm,n));
+      PetscCall(PetscFree4(eigr,eigi,errest,perm));
+      eigr = aux_s1; eigi = aux_s2; errest = aux_e; perm = aux_p;
+      if (!V) PetscCall(BVDuplicateResize(sr_loc->V,nalloc,&V));
+      else PetscCall(BVResize(V,nalloc,PETSC_TRUE));
+    }
+    for (i=0;i<k;i++) {
+      eigr[n+i]   = sr_loc->eigr[i];
+      eigi[n+i]   = sr_loc->eigi[i];
+      errest[n+i] = sr_loc->errest[i];
+      perm[n+i]   = n+sr_loc->perm[i];
+      PetscCall(BVGetColumn(V,n+i,&v));
+      PetscCall(BVCopyVec(sr_loc->V,i,v));
+      PetscCall(BVRestoreColumn(V,n+i,&v));
+    }
+    n   += k;
+    its += sr_loc->itsKs;
+
+    /* append the shifts and inertias */
+    PetscCall(EPSSliceGetInertias(ctx->eps,&ns,&shifts_loc,&inertias_loc));
+    PetscCall(PetscMalloc2(nsh+ns,&aux_r,nsh+ns,&aux_i));
+    PetscCall(PetscArraycpy(aux_r,shifts,nsh));
+    PetscCall(PetscArraycpy(aux_i,inertias,nsh));
+    PetscCall(PetscArraycpy(aux_r+nsh,shifts_loc,ns));
+    PetscCall(PetscArraycpy(aux_i+nsh,inertias_loc,ns));
+    PetscCall(PetscFree2(shifts,inertias));
+    PetscCall(PetscFree(shifts_loc));
+    PetscCall(PetscFree(inertias_loc));
+    shifts = aux_r; inertias = aux_i; nsh += ns;
+
+    PetscCall(EPSSliceGetNextChunk(eps,&chunk));
+  }
+
+  /* replace the solution of the last subsolve with the accumulated one */
+  sr_loc = ctx_loc->sr;
+  k = PetscMax(1,n);
+  PetscCall(PetscFree4(sr_loc->eigr,sr_loc->eigi,sr_loc->errest,sr_loc->perm));
+  PetscCall(PetscMalloc4(k,&sr_loc->eigr,k,&sr_loc->eigi,k,&sr_loc->errest,k,&sr_loc->perm));
+  PetscCall(PetscArraycpy(sr_loc->eigr,eigr,n));
+  PetscCall(PetscArraycpy(sr_loc->eigi,eigi,n));
+  PetscCall(PetscArraycpy(sr_loc->errest,errest,n));
+  PetscCall(PetscArraycpy(sr_loc->perm,perm,n));
+  PetscCall(PetscFree4(eigr,eigi,errest,perm));
+  if (V) PetscCall(BVResize(V,k,PETSC_TRUE));
+  else PetscCall(BVDuplicateResize(sr_loc->V,k,&V));
+  PetscCall(BVDestroy(&sr_loc->V));
+  sr_loc->V        = V;
+  sr_loc->numEigs  = n;
+  sr_loc->indexEig = n;
+  sr_loc->itsKs    = its;
+  ctx->eps->nconv  = n;
+  PetscCall(PetscFree(ctx->shifts));
+  PetscCall(PetscFree(ctx->inertias));
+  PetscCall(PetscMalloc1(nsh,&ctx->shifts));
+  PetscCall(PetscMalloc1(nsh,&ctx->inertias));
+  PetscCall(PetscArraycpy(ctx->shifts,shifts,nsh));
+  PetscCall(PetscArraycpy(ctx->inertias,inertias,nsh));
+  PetscCall(PetscFree2(shifts,inertias));
+  ctx->nshifts = nsh;
+
+  /* update the number of eigenpairs computed in each partition */
+  PetscCall(PetscMPIIntCast(n,&aux));
+  if (!rank) PetscCallMPI(MPI_Allgather(&aux,1,MPI_INT,ctx->nconv_loc,1,MPI_INT,ctx->commrank));
+  PetscCall(PetscMPIIntCast(ctx->npart,&aux));
+  PetscCallMPI(MPI_Bcast(ctx->nconv_loc,aux,MPI_INT,0,child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode EPSSolve_KrylovSchur_Slice(EPS eps)
 {
   PetscInt         i,lds,ti;
@@ -1226,7 +1590,8 @@ PetscErrorCode EPSSolve_KrylovSchur_Slice(EPS eps)
   PetscFunctionBegin;
   PetscCall(PetscCitationsRegister(citation,&cited));
   if (ctx->global) {
-    PetscCall(EPSSolve_KrylovSchur_Slice(ctx->eps));
+    if (((EPS_KRYLOVSCHUR*)ctx->eps->data)->dynamic) PetscCall(EPSSliceSolveDynamic(eps));
+    else PetscCall(EPSSolve_KrylovSchur_Slice(ctx->eps));
     ctx->eps->state = EPS_STATE_SOLVED;
     eps->reason = EPS_CONVERGED_TOL;
     if (ctx->npart>1) {
@@ -123,13 +123,102 @@ static PetscErrorCode EPSTwoSidedRQUpdate2(EPS eps,Mat M,PetscInt k)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes y = A*x and z = A'*w with a single traversal of the nonzeros of
+   a MATSEQAIJ matrix A, instead of one MatMult() and one MatMultHermitianTranspose()
+*/
+static PetscErrorCode EPSTwoSidedMatMult_SeqAIJ(Mat A,Vec x,Vec y,Vec w,Vec z)
+{
+  PetscInt          i,j,n,nz;
+  const PetscInt    *ia,*ja;
+  const PetscScalar *aa,*px,*pw;
+  PetscScalar       *py,*pz,s,wi;
+  PetscBool         done;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&n,&ia,&ja,&done));
+  PetscCheck(done,PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Cannot get the row structure of the matrix");
+  PetscCall(MatSeqAIJGetArrayRead(A,&aa));
+  PetscCall(VecGetArrayRead(x,&px));
+  PetscCall(VecGetArrayRead(w,&pw));
+  PetscCall(VecGetArrayWrite(y,&py));
+  PetscCall(VecGetArrayWrite(z,&pz));
+  PetscCall(PetscArrayzero(pz,n));
+  for (i=0;i<n;i++) {
+    s  = 0.0;
+    wi = pw[i];
+    for (j=ia[i];j<ia[i+1];j++) {
+      s += aa[j]*px[ja[j]];
+      pz[ja[j]] += PetscConj(aa[j])*wi;
+    }
+    py[i] = s;
+  }
+  nz = ia[n];
+  PetscCall(VecRestoreArrayWrite(z,&pz));
+  PetscCall(VecRestoreArrayWrite(y,&py));
+  PetscCall(VecRestoreArrayRead(w,&pw));
+  PetscCall(VecRestoreArrayRead(x,&px));
+  PetscCall(MatSeqAIJRestoreArrayRead(A,&aa));
+  PetscCall(MatRestoreRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&n,&ia,&ja,&done));
+  PetscCall(PetscLogFlops(4.0*nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the Arnoldi factorizations of Op and Op' from column k up to column m
+   at the same time, obtaining both products of each step with the fused kernel above.
+   On exit, m is the length of the shortest factorization
+*/
+static PetscErrorCode EPSTwoSidedArnoldi_Fused(EPS eps,Mat A,PetscInt k,PetscInt *m,PetscReal *beta,PetscReal *betat,PetscBool *breakdown)
+{
+  PetscInt    j,ld;
+  PetscScalar *S,*T;
+  PetscBool   lindep=PETSC_FALSE,lindept=PETSC_FALSE;
+  Vec         x,y,w,z;
+
+  PetscFunctionBegin;
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  PetscCall(BVSetActiveColumns(eps->V,0,*m));
+  PetscCall(BVSetActiveColumns(eps->W,0,*m));
+  PetscCall(DSGetArray(eps->ds,DS_MAT_A,&S));
+  PetscCall(DSGetArray(eps->ds,DS_MAT_B,&T));
+  for (j=k;j<*m;j++) {
+    PetscCall(BVGetColumn(eps->V,j,&x));
+    PetscCall(BVGetColumn(eps->V,j+1,&y));
+    PetscCall(BVGetColumn(eps->W,j,&w));
+    PetscCall(BVGetColumn(eps->W,j+1,&z));
+    PetscCall(EPSTwoSidedMatMult_SeqAIJ(A,x,y,w,z));
+    PetscCall(BVRestoreColumn(eps->W,j+1,&z));
+    PetscCall(BVRestoreColumn(eps->W,j,&w));
+    PetscCall(BVRestoreColumn(eps->V,j+1,&y));
+    PetscCall(BVRestoreColumn(eps->V,j,&x));
+    PetscCall(BVOrthogonalizeColumn(eps->V,j+1,S+j*ld,beta,&lindep));
+    PetscCall(BVOrthogonalizeColumn(eps->W,j+1,T+j*ld,betat,&lindept));
+    S[j+1+j*ld] = *beta;
+    T[j+1+j*ld] = *betat;
+    if (PetscUnlikely(lindep || lindept || *beta==0.0 || *betat==0.0)) {
+      lindep = PETSC_TRUE;
+      *m = j+1;
+      break;
+    }
+    PetscCall(BVScaleColumn(eps->V,j+1,1.0/(*beta)));
+    PetscCall(BVScaleColumn(eps->W,j+1,1.0/(*betat)));
+  }
+  PetscCall(DSRestoreArray(eps->ds,DS_MAT_B,&T));
+  PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&S));
+  *breakdown = lindep;
+  if (lindep) PetscCall(PetscInfo(eps,"Two-sided Arnoldi finished early at m=%" PetscInt_FMT "\n",*m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode EPSSolve_KrylovSchur_TwoSided(EPS eps)
 {
   EPS_KRYLOVSCHUR *ctx = (EPS_KRYLOVSCHUR*)eps->data;
-  Mat             M,U,Op,OpHT,S,T;
+  Mat             M,U,Op,OpHT,S,T,A=NULL;
   PetscReal       norm,norm2,beta,betat;
-  PetscInt        ld,l,nv,nvt,k,nconv,dsn,dsk;
-  PetscBool       breakdownt,breakdown,breakdownl;
+  PetscInt        ld,l,nv,nvt,k,nconv,dsn,dsk,nmat,sstep;
+  PetscBool       breakdownt,breakdown,breakdownl,fused;
+  BVOrthogType    otype;
 
   PetscFunctionBegin;
   PetscCall(DSGetLeadingDimension(eps->ds,&ld));
@@ -141,6 +230,17 @@ PetscErrorCode EPSSolve_KrylovSchur_TwoSided(EPS eps)
   PetscCall(STGetOperator(eps->st,&Op));
   PetscCall(MatCreateHermitianTranspose(Op,&OpHT));
 
+  /* if Op is an explicit sequential AIJ matrix, both products are computed in one pass */
+  PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STSHIFT,&fused));
+  PetscCall(STGetNumMatrices(eps->st,&nmat));
+  PetscCall(BVGetOrthogonalization(eps->V,&otype,NULL,NULL,NULL));
+  PetscCall(BVGetKrylovSStep(eps->V,&sstep));
+  if (fused && nmat==1 && eps->balance==EPS_BALANCE_NONE && (otype==BV_ORTHOG_CGS || otype==BV_ORTHOG_MGS) && sstep<=1) {
+    PetscCall(STGetMatrixTransformed(eps->st,0,&A));
+    PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&fused));
+  } else fused = PETSC_FALSE;
+  if (fused) PetscCall(PetscInfo(eps,"Computing the products with Op and Op' in a single pass over the matrix\n"));
+
   /* Restart loop */
   while (eps->reason == EPS_CONVERGED_ITERATING) {
     eps->its++;
@@ -148,16 +248,23 @@ PetscErrorCode EPSSolve_KrylovSchur_TwoSided(EPS eps)
     /* Compute an nv-step Arnoldi factorization for Op */
     nv = PetscMin(eps->nconv+eps->mpd,eps->ncv);
     PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
-    PetscCall(DSGetMat(eps->ds,DS_MAT_A,&S));
-    PetscCall(BVMatArnoldi(eps->V,Op,S,eps->nconv+l,&nv,&beta,&breakdown));
-    PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&S));
+    if (fused) {
+      /* both factorizations at once */
+      PetscCall(EPSTwoSidedArnoldi_Fused(eps,A,eps->nconv+l,&nv,&beta,&betat,&breakdown));
+      nvt = nv;
+      breakdownt = breakdown;
+    } else {
+      PetscCall(DSGetMat(eps->ds,DS_MAT_A,&S));
+      PetscCall(BVMatArnoldi(eps->V,Op,S,eps->nconv+l,&nv,&beta,&breakdown));
+      PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&S));
 
-    /* Compute an nv-step Arnoldi factorization for Op' */
-    nvt = nv;
-    PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
-    PetscCall(DSGetMat(eps->ds,DS_MAT_B,&T));
-    PetscCall(BVMatArnoldi(eps->W,OpHT,T,eps->nconv+l,&nvt,&betat,&breakdownt));
-    PetscCall(DSRestoreMat(eps->ds,DS_MAT_B,&T));
+      /* Compute an nv-step Arnoldi factorization for Op' */
+      nvt = nv;
+      PetscCall(DSSetDimensions(eps->ds,nv,eps->nconv,eps->nconv+l));
+      PetscCall(DSGetMat(eps->ds,DS_MAT_B,&T));
+      PetscCall(BVMatArnoldi(eps->W,OpHT,T,eps->nconv+l,&nvt,&betat,&breakdownt));
+      PetscCall(DSRestoreMat(eps->ds,DS_MAT_B,&T));
+    }
 
     /* Make sure both factorizations have the same length */
     nv = PetscMin(nv,nvt);
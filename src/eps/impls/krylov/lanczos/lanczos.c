@@ -184,14 +184,15 @@ static PetscErrorCode EPSSelectiveLanczos(EPS eps,PetscReal *alpha,PetscReal *be
 {
   EPS_LANCZOS    *lanczos = (EPS_LANCZOS*)eps->data;
   PetscInt       i,j,m = *M,n,nritz=0,nritzo;
-  Vec            vj1,av;
-  Mat            Op;
+  Vec            vj1;
+  Mat            Op,Q;
   PetscReal      *d,*e,*ritz,norm;
-  PetscScalar    *Y,*hwork;
+  PetscScalar    *Y,*hwork,*pQ;
   PetscBool      *which;
 
   PetscFunctionBegin;
   PetscCall(PetscCalloc6(m+1,&d,m,&e,m,&ritz,m*m,&Y,m,&which,m,&hwork));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,m,NULL,&Q));
   for (i=0;i<k;i++) which[i] = PETSC_TRUE;
   PetscCall(STGetOperator(eps->st,&Op));
 
@@ -228,16 +229,19 @@ static PetscErrorCode EPSSelectiveLanczos(EPS eps,PetscReal *alpha,PetscReal *be
       if (norm*PetscAbsScalar(Y[i*n+n-1]) < PETSC_SQRT_MACHINE_EPSILON*anorm) nritzo++;
     }
     if (nritzo>nritz) {
+      /* all of them are formed at once, AV = V(:,k:k+n)*Y(:,selected) */
+      PetscCall(MatDenseGetArrayWrite(Q,&pQ));
       nritz = 0;
       for (i=0;i<n;i++) {
         if (norm*PetscAbsScalar(Y[i*n+n-1]) < PETSC_SQRT_MACHINE_EPSILON*anorm) {
-          PetscCall(BVSetActiveColumns(eps->V,k,k+n));
-          PetscCall(BVGetColumn(lanczos->AV,nritz,&av));
-          PetscCall(BVMultVec(eps->V,1.0,0.0,av,Y+i*n));
-          PetscCall(BVRestoreColumn(lanczos->AV,nritz,&av));
+          PetscCall(PetscArraycpy(pQ+k+nritz*m,Y+i*n,n));
           nritz++;
         }
       }
+      PetscCall(MatDenseRestoreArrayWrite(Q,&pQ));
+      PetscCall(BVSetActiveColumns(eps->V,k,k+n));
+      PetscCall(BVSetActiveColumns(lanczos->AV,0,nritz));
+      PetscCall(BVMult(lanczos->AV,1.0,0.0,eps->V,Q));
     }
     if (nritz > 0) {
       PetscCall(BVGetColumn(eps->V,j+1,&vj1));
@@ -253,6 +257,7 @@ static PetscErrorCode EPSSelectiveLanczos(EPS eps,PetscReal *alpha,PetscReal *be
   }
 
   PetscCall(STRestoreOperator(eps->st,&Op));
+  PetscCall(MatDestroy(&Q));
   PetscCall(PetscFree6(d,e,ritz,Y,which,hwork));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -14,17 +14,64 @@
 
 #include <slepc/private/epsimpl.h>
 
+/*
+   The dense problem is solved only in the first process, unless the DS is distributed
+   (e.g., a ScaLAPACK method), since a redundant solve in all processes does not reduce
+   the time and multiplies the memory used for the matrices
+*/
+static PetscErrorCode EPSLAPACKSolveInFirst(EPS eps,PetscBool *first)
+{
+  PetscMPIInt    size;
+  DSParallelType pmode;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)eps),&size));
+  PetscCall(DSGetParallel(eps->ds,&pmode));
+  *first = (size>1 && pmode!=DS_PARALLEL_DISTRIBUTED)? PETSC_TRUE: PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Returns a sequential copy of A, in all processes or only in the first one (the rest get
+   an empty matrix), and without raising an error so that the caller can try other options
+*/
+static PetscErrorCode EPSLAPACKGatherMatrix(Mat A,PetscBool first,Mat *Aseq)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscInt       N;
+  IS             is;
+  Mat            *sub;
+
+  PetscFunctionBegin;
+  if (!first) PetscCall(MatCreateRedundantMatrix(A,0,PETSC_COMM_SELF,MAT_INITIAL_MATRIX,Aseq));
+  else {
+    PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank));
+    PetscCall(MatGetSize(A,&N,NULL));
+    PetscCall(ISCreateStride(PETSC_COMM_SELF,rank?0:N,0,1,&is));
+    ierr = MatCreateSubMatrices(A,1,&is,&is,MAT_INITIAL_MATRIX,&sub);
+    PetscCall(ISDestroy(&is));
+    PetscCall(ierr);
+    *Aseq = sub[0];
+    PetscCall(PetscFree(sub));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSetUp_LAPACK(EPS eps)
 {
   int            ierra,ierrb;
-  PetscBool      isshift,flg,denseok=PETSC_FALSE;
+  PetscBool      isshift,flg,denseok=PETSC_FALSE,first;
   Mat            A,B,OP,shell,Ar,Br,Adense=NULL,Bdense=NULL,Ads,Bds;
   PetscScalar    shift;
   PetscInt       nmat;
+  PetscMPIInt    rank;
   KSP            ksp;
   PC             pc;
 
   PetscFunctionBegin;
+  PetscCall(EPSLAPACKSolveInFirst(eps,&first));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)eps),&rank));
   eps->ncv = eps->n;
   if (eps->mpd!=PETSC_DETERMINE) PetscCall(PetscInfo(eps,"Warning: parameter mpd ignored\n"));
   if (eps->max_it==PETSC_DETERMINE) eps->max_it = 1;
@@ -42,7 +89,7 @@ static PetscErrorCode EPSSetUp_LAPACK(EPS eps)
     PetscCall(MatHasOperation(A,MATOP_CREATE_SUBMATRICES,&flg));
     if (flg) {
       PetscCall(PetscPushErrorHandler(PetscReturnErrorHandler,NULL));
-      ierra  = MatCreateRedundantMatrix(A,0,PETSC_COMM_SELF,MAT_INITIAL_MATRIX,&Ar);
+      ierra  = EPSLAPACKGatherMatrix(A,first,&Ar);
       if (!ierra) ierra |= MatConvert(Ar,MATSEQDENSE,MAT_INITIAL_MATRIX,&Adense);
       ierra |= MatDestroy(&Ar);
       PetscCall(PetscPopErrorHandler());
@@ -52,7 +99,7 @@ static PetscErrorCode EPSSetUp_LAPACK(EPS eps)
       PetscCall(MatHasOperation(B,MATOP_CREATE_SUBMATRICES,&flg));
       if (flg) {
         PetscCall(PetscPushErrorHandler(PetscReturnErrorHandler,NULL));
-        ierrb  = MatCreateRedundantMatrix(B,0,PETSC_COMM_SELF,MAT_INITIAL_MATRIX,&Br);
+        ierrb  = EPSLAPACKGatherMatrix(B,first,&Br);
         if (!ierrb) ierrb |= MatConvert(Br,MATSEQDENSE,MAT_INITIAL_MATRIX,&Bdense);
         ierrb |= MatDestroy(&Br);
         PetscCall(PetscPopErrorHandler());
@@ -93,18 +140,20 @@ static PetscErrorCode EPSSetUp_LAPACK(EPS eps)
     PetscCall(MatComputeOperator(shell,MATDENSE,&OP));
     PetscCall(STRestoreOperator(eps->st,&shell));
     PetscCall(MatDestroy(&Adense));
-    PetscCall(MatCreateRedundantMatrix(OP,0,PETSC_COMM_SELF,MAT_INITIAL_MATRIX,&Adense));
+    PetscCall(EPSLAPACKGatherMatrix(OP,first,&Adense));
     PetscCall(MatDestroy(&OP));
   }
 
   /* fill DS matrices */
-  PetscCall(DSGetMat(eps->ds,DS_MAT_A,&Ads));
-  PetscCall(MatCopy(Adense,Ads,SAME_NONZERO_PATTERN));
-  PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&Ads));
-  if (denseok && eps->isgeneralized) {
-    PetscCall(DSGetMat(eps->ds,DS_MAT_B,&Bds));
-    PetscCall(MatCopy(Bdense,Bds,SAME_NONZERO_PATTERN));
-    PetscCall(DSRestoreMat(eps->ds,DS_MAT_B,&Bds));
+  if (!first || !rank) {
+    PetscCall(DSGetMat(eps->ds,DS_MAT_A,&Ads));
+    PetscCall(MatCopy(Adense,Ads,SAME_NONZERO_PATTERN));
+    PetscCall(DSRestoreMat(eps->ds,DS_MAT_A,&Ads));
+    if (denseok && eps->isgeneralized) {
+      PetscCall(DSGetMat(eps->ds,DS_MAT_B,&Bds));
+      PetscCall(MatCopy(Bdense,Bds,SAME_NONZERO_PATTERN));
+      PetscCall(DSRestoreMat(eps->ds,DS_MAT_B,&Bds));
+    }
   }
   PetscCall(DSSetState(eps->ds,DS_STATE_RAW));
   PetscCall(MatDestroy(&Adense));
@@ -112,13 +161,73 @@ static PetscErrorCode EPSSetUp_LAPACK(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Solves the problem in the first process and scatters the eigenvalues and the requested
+   vectors (DS_MAT_X or DS_MAT_Y) to the rest, into the columns of V
+*/
+static PetscErrorCode EPSSolve_LAPACK_First(EPS eps)
+{
+  PetscInt       n=eps->n,i,k;
+  PetscMPIInt    rank,len;
+  PetscScalar    *pX=NULL,*pY=NULL;
+  PetscBool      twosided=eps->twosided;
+  Vec            v,x;
+  VecScatter     scat;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)eps),&rank));
+  if (!rank) {
+    PetscCall(DSSolve(eps->ds,eps->eigr,eps->eigi));
+    PetscCall(DSSort(eps->ds,eps->eigr,eps->eigi,NULL,NULL,NULL));
+    PetscCall(DSVectors(eps->ds,DS_MAT_X,NULL,NULL));
+    if (twosided) PetscCall(DSVectors(eps->ds,DS_MAT_Y,NULL,NULL));
+  }
+  PetscCall(PetscMPIIntCast(eps->ncv,&len));
+  PetscCallMPI(MPI_Bcast(eps->eigr,len,MPIU_SCALAR,0,PetscObjectComm((PetscObject)eps)));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallMPI(MPI_Bcast(eps->eigi,len,MPIU_SCALAR,0,PetscObjectComm((PetscObject)eps)));
+#endif
+
+  /* the first process holds all the components, scatter them to the columns of V and W */
+  PetscCall(BVGetColumn(eps->V,0,&v));
+  PetscCall(VecScatterCreateToZero(v,&scat,&x));
+  PetscCall(BVRestoreColumn(eps->V,0,&v));
+  if (!rank) PetscCall(DSGetArray(eps->ds,DS_MAT_X,&pX));
+  if (!rank && twosided) PetscCall(DSGetArray(eps->ds,DS_MAT_Y,&pY));
+  for (k=0;k<(twosided?2:1);k++) {
+    for (i=0;i<eps->ncv;i++) {
+      if (!rank) PetscCall(VecPlaceArray(x,(k?pY:pX)+i*n));
+      PetscCall(BVGetColumn(k?eps->W:eps->V,i,&v));
+      PetscCall(VecScatterBegin(scat,x,v,INSERT_VALUES,SCATTER_REVERSE));
+      PetscCall(VecScatterEnd(scat,x,v,INSERT_VALUES,SCATTER_REVERSE));
+      PetscCall(BVRestoreColumn(k?eps->W:eps->V,i,&v));
+      if (!rank) PetscCall(VecResetArray(x));
+    }
+  }
+  if (!rank) PetscCall(DSRestoreArray(eps->ds,DS_MAT_X,&pX));
+  if (!rank && twosided) PetscCall(DSRestoreArray(eps->ds,DS_MAT_Y,&pY));
+  PetscCall(VecScatterDestroy(&scat));
+  PetscCall(VecDestroy(&x));
+
+  eps->nconv  = eps->ncv;
+  eps->its    = 1;
+  eps->reason = EPS_CONVERGED_TOL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSolve_LAPACK(EPS eps)
 {
   PetscInt       n=eps->n,i,low,high;
   PetscScalar    *array,*pX,*pY;
   Vec            v,w;
+  PetscBool      first;
 
   PetscFunctionBegin;
+  PetscCall(EPSLAPACKSolveInFirst(eps,&first));
+  if (first) {
+    PetscCall(EPSSolve_LAPACK_First(eps));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(DSSolve(eps->ds,eps->eigr,eps->eigi));
   PetscCall(DSSort(eps->ds,eps->eigr,eps->eigi,NULL,NULL,NULL));
   PetscCall(DSSynchronize(eps->ds,eps->eigr,eps->eigi));
@@ -14,7 +14,9 @@
 
    Algorithm:
 
-       Lyapunov inverse iteration using LME solvers
+       Lyapunov inverse iteration using LME solvers, where the dominant
+       directions of the solution of each Lyapunov equation are given to
+       the LME solver as initial space for the next one
 
    References:
 
@@ -312,8 +314,8 @@ static PetscErrorCode LyapIIBuildEigenMat(LME lme,Mat S,Mat *Op,Vec *v0)
 static PetscErrorCode EPSSolve_LyapII(EPS eps)
 {
   EPS_LYAPII          *ctx = (EPS_LYAPII*)eps->data;
-  PetscInt            i,ldds,rk,nloc,mloc,nv,idx,k;
-  Vec                 v,w,z=eps->work[0],v0=NULL;
+  PetscInt            i,ldds,rk,nloc,mloc,nv,idx,k,nw=0;
+  Vec                 v,w,z=eps->work[0],v0=NULL,*Wr;
   Mat                 S,C,Ux[2],Y,Y1,R,U,W,X,Op=NULL;
   BV                  V;
   BVOrthogType        type;
@@ -345,6 +347,7 @@ static PetscErrorCode EPSSolve_LyapII(EPS eps)
   PetscCall(MatCreateDense(PetscObjectComm((PetscObject)eps),eps->nloc,PETSC_DECIDE,PETSC_DECIDE,2,NULL,&Ux[1]));
   nv = ctx->rkl;
   PetscCall(PetscMalloc1(nv,&s));
+  PetscCall(VecDuplicateVecs(z,ctx->rkc,&Wr));
 
   /* Initialize first column */
   PetscCall(EPSGetStartVector(eps,0,NULL));
@@ -376,6 +379,7 @@ static PetscErrorCode EPSSolve_LyapII(EPS eps)
     PetscCall(MatCreateLRC(NULL,Ux[idx],NULL,NULL,&C));
     PetscCall(LMESetRHS(ctx->lme,C));
     PetscCall(MatDestroy(&C));
+    if (nw) PetscCall(LMESetInitialSpace(ctx->lme,nw,Wr));  /* recycle the previous solution */
     PetscCall(LMESolve(ctx->lme));
     PetscCall(BVRestoreMat(V,&Y1));
     PetscCall(MatDestroy(&Y));
@@ -398,6 +402,9 @@ static PetscErrorCode EPSSolve_LyapII(EPS eps)
     PetscCall(BVMultInPlace(V,U,0,rk));
     PetscCall(DSRestoreMat(ctx->ds,DS_MAT_U,&U));
     PetscCall(BVSetActiveColumns(V,0,rk));
+    /* the right-hand side of the next equation is a small change of this one, keep the dominant directions */
+    for (i=0;i<rk;i++) PetscCall(BVCopyVec(V,i,Wr[i]));
+    nw = rk;
 
     /* Rank reduction */
     PetscCall(DSSetDimensions(ctx->ds,rk,0,0));
@@ -493,6 +500,7 @@ static PetscErrorCode EPSSolve_LyapII(EPS eps)
         PetscCall(BVRestoreColumn(V,i,&v));
       }
       eps->nconv += k;
+      nw = 0;  /* the next equation is built from a new vector */
       PetscCall(BVSetActiveColumns(eps->V,eps->nconv-rk,eps->nconv));
       PetscCall(BVOrthogonalize(eps->V,NULL));
       PetscCall(DSSetDimensions(eps->ds,eps->nconv,0,0));
@@ -522,6 +530,7 @@ static PetscErrorCode EPSSolve_LyapII(EPS eps)
   PetscCall(BVDestroy(&V));
   PetscCall(EPSDestroy(&epsrr));
   PetscCall(PetscFree(s));
+  PetscCall(VecDestroyVecs(ctx->rkc,&Wr));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
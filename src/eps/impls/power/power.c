@@ -24,6 +24,9 @@
        It can also be used for nonlinear inverse iteration on the problem
        A(x)*x=lambda*B(x)*x, where A and B are not constant but depend on x.
 
+       In the block variant, a block of vectors is iterated simultaneously
+       (orthogonal iteration), with locking of the leading converged vectors.
+
    References:
 
        [1] "Single Vector Iteration Methods in SLEPc", SLEPc Technical Report
@@ -38,6 +41,7 @@
 
 static PetscErrorCode EPSPowerFormFunction_Update(SNES,Vec,Vec,void*);
 static PetscErrorCode EPSSolve_Power(EPS);
+static PetscErrorCode EPSSolve_Power_Block(EPS);
 static PetscErrorCode EPSSolve_TS_Power(EPS);
 
 typedef struct {
@@ -56,6 +60,7 @@ typedef struct {
   PetscInt          idx;  /* index of the first nonzero entry in the iteration vector */
   PetscMPIInt       p;    /* process id of the owner of idx */
   PetscReal         norm0; /* norm of initial vector */
+  PetscInt          bs;    /* block size */
 } EPS_POWER;
 
 static PetscErrorCode SNESMonitor_PowerUpdate(SNES snes,PetscInt its,PetscReal fnorm,void *ctx)
@@ -86,7 +91,8 @@ static PetscErrorCode EPSSetUp_Power(EPS eps)
   EPSCheckNotStructured(eps);
   if (eps->ncv!=PETSC_DETERMINE) {
     PetscCheck(eps->ncv>=eps->nev,PetscObjectComm((PetscObject)eps),PETSC_ERR_USER_INPUT,"The value of ncv must be at least nev");
-  } else eps->ncv = eps->nev;
+    PetscCheck(eps->ncv>=power->bs,PetscObjectComm((PetscObject)eps),PETSC_ERR_USER_INPUT,"The value of ncv must be at least the block size");
+  } else eps->ncv = eps->nev+power->bs-1;
   if (eps->mpd!=PETSC_DETERMINE) PetscCall(PetscInfo(eps,"Warning: parameter mpd ignored\n"));
   if (eps->max_it==PETSC_DETERMINE) {
     /* SNES will directly return the solution for us, and we need to do only one iteration */
@@ -101,9 +107,14 @@ static PetscErrorCode EPSSetUp_Power(EPS eps)
     PetscCall(STGetMatMode(eps->st,&mode));
     PetscCheck(mode!=ST_MATMODE_INPLACE,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"ST matrix mode inplace does not work with variable shifts");
   }
+  if (power->bs>1) {
+    PetscCheck(!power->nonlinear,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The block variant is not available for nonlinear problems");
+    PetscCheck(power->shift_type==EPS_POWER_SHIFT_CONSTANT,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The block variant does not support variable shifts");
+    PetscCheck(!eps->twosided,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The block variant does not have two-sided version");
+  }
   EPSCheckUnsupported(eps,EPS_FEATURE_BALANCE | EPS_FEATURE_ARBITRARY | EPS_FEATURE_REGION | EPS_FEATURE_CONVERGENCE);
   EPSCheckIgnored(eps,EPS_FEATURE_EXTRACTION);
-  PetscCall(EPSAllocateSolution(eps,0));
+  PetscCall(EPSAllocateSolution(eps,power->bs>1?power->bs:0));
   PetscCall(EPS_SetInnerProduct(eps));
 
   if (power->nonlinear) {
@@ -175,14 +186,15 @@ static PetscErrorCode EPSSetUp_Power(EPS eps)
     if (eps->twosided) PetscCall(EPSSetWorkVecs(eps,3));
     else PetscCall(EPSSetWorkVecs(eps,2));
     PetscCall(DSSetType(eps->ds,DSNHEP));
-    PetscCall(DSAllocate(eps->ds,eps->nev));
+    PetscCall(DSAllocate(eps->ds,power->bs>1?eps->ncv:eps->nev));
   }
   /* dispatch solve method */
   if (eps->twosided) {
     PetscCheck(!power->nonlinear,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Nonlinear inverse iteration does not have two-sided variant");
     PetscCheck(power->shift_type!=EPS_POWER_SHIFT_WILKINSON,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Two-sided variant does not support Wilkinson shifts");
     eps->ops->solve = EPSSolve_TS_Power;
-  } else eps->ops->solve = EPSSolve_Power;
+  } else if (power->bs>1) eps->ops->solve = EPSSolve_Power_Block;
+  else eps->ops->solve = EPSSolve_Power;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -574,6 +586,116 @@ static PetscErrorCode EPSSolve_Power(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Block variant: the block V(:,k:k+m) is multiplied by OP with a single product,
+   and the result is orthogonalized against V(:,0:k+m) with the block method of BV.
+   The coefficients of this orthogonalization provide at once the Rayleigh quotients,
+   the residual norms and the columns of the Schur form for the vectors to be locked,
+   and the new (orthonormal) block is obtained from a small QR factorization of them.
+*/
+static PetscErrorCode EPSSolve_Power_Block(EPS eps)
+{
+  EPS_POWER         *power = (EPS_POWER*)eps->data;
+  PetscInt          i,j,r,k,m,c,ld,ldr,bs=power->bs;
+  PetscBLASInt      nr,nc,lwork,info;
+  PetscReal         relerr;
+  PetscScalar       *T,*S,*tau,*work,*pU;
+  const PetscScalar *pR;
+  PetscBool         breakdown=PETSC_FALSE;
+  Mat               Op,R,U;
+  BV                W;
+
+  PetscFunctionBegin;
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,eps->ncv+bs,eps->ncv+bs,NULL,&R));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,eps->ncv+bs,eps->ncv+bs,NULL,&U));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  PetscCall(PetscMalloc3(2*bs*bs,&S,bs,&tau,bs,&work));
+  PetscCall(PetscBLASIntCast(bs,&lwork));
+  PetscCall(BVDuplicateResize(eps->V,bs,&W));
+  PetscCall(STGetOperator(eps->st,&Op));
+
+  /* Get the starting block */
+  for (i=0;i<bs;i++) PetscCall(EPSGetStartVector(eps,i,NULL));
+
+  while (eps->reason == EPS_CONVERGED_ITERATING) {
+    eps->its++;
+    k = eps->nconv;
+    m = PetscMin(bs,eps->ncv-k);
+
+    /* W = OP*V(:,k:k+m), copied to V(:,k+m:k+2*m) and orthogonalized */
+    PetscCall(BVSetActiveColumns(eps->V,k,k+m));
+    PetscCall(BVSetActiveColumns(W,0,m));
+    PetscCall(BVMatMult(eps->V,Op,W));
+    PetscCall(BVSetActiveColumns(eps->V,k+m,k+2*m));
+    PetscCall(BVCopy(W,eps->V));
+    PetscCall(BVOrthogonalize(eps->V,R));
+
+    /* Rayleigh quotients and relative residual norms */
+    PetscCall(MatDenseGetArrayRead(R,&pR));
+    for (i=0;i<m;i++) {
+      j = k+m+i;
+      relerr = 0.0;
+      for (r=k+i+1;r<k+2*m;r++) relerr += PetscRealPart(pR[r+j*ldr]*PetscConj(pR[r+j*ldr]));
+      eps->eigr[k+i]   = pR[k+i+j*ldr];
+      eps->errest[k+i] = PetscSqrtReal(relerr)/PetscAbsScalar(eps->eigr[k+i]);
+    }
+
+    /* lock the leading converged vectors */
+    for (c=0;c<m && eps->errest[k+c]<eps->tol;c++);
+    if (c) {
+      PetscCall(DSGetArray(eps->ds,DS_MAT_A,&T));
+      for (i=0;i<c;i++) {
+        PetscCall(PetscArrayzero(T+(k+i)*ld,ld));
+        for (r=0;r<=k+i;r++) T[r+(k+i)*ld] = pR[r+(k+m+i)*ldr];
+      }
+      PetscCall(DSRestoreArray(eps->ds,DS_MAT_A,&T));
+    }
+
+    /* new block, orthonormal basis of the rest of W purged against V(:,0:k+c),
+       that is [V(:,k+c:k+m) V(:,k+m:k+2*m)]*R(k+c:k+2*m,k+m+c:k+2*m) */
+    if (c<m) {
+      PetscCall(PetscBLASIntCast(2*m-c,&nr));
+      PetscCall(PetscBLASIntCast(m-c,&nc));
+      for (i=0;i<m-c;i++) for (r=0;r<2*m-c;r++) S[r+i*(2*m-c)] = pR[k+c+r+(k+m+c+i)*ldr];
+      PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+      PetscCallBLAS("LAPACKgeqrf",LAPACKgeqrf_(&nr,&nc,S,&nr,tau,work,&lwork,&info));
+      SlepcCheckLapackInfo("geqrf",info);
+      PetscCallBLAS("LAPACKorgqr",LAPACKorgqr_(&nr,&nc,&nc,S,&nr,tau,work,&lwork,&info));
+      SlepcCheckLapackInfo("orgqr",info);
+      PetscCall(PetscFPTrapPop());
+      PetscCall(MatDenseGetArray(U,&pU));
+      for (i=0;i<m-c;i++) for (r=0;r<2*m-c;r++) pU[k+c+r+(k+c+i)*ldr] = S[r+i*(2*m-c)];
+      PetscCall(MatDenseRestoreArray(U,&pU));
+      PetscCall(BVSetActiveColumns(eps->V,k+c,k+2*m));
+      PetscCall(BVMultInPlace(eps->V,U,k+c,k+m));
+    }
+    PetscCall(MatDenseRestoreArrayRead(R,&pR));
+    eps->nconv = k+c;
+
+    /* complete the block with new start vectors */
+    if (c && eps->nconv<eps->nev) {
+      for (i=k+m;i<PetscMin(eps->nconv+bs,eps->ncv) && !breakdown;i++) PetscCall(EPSGetStartVector(eps,i,&breakdown));
+      if (breakdown) {
+        eps->reason = EPS_DIVERGED_BREAKDOWN;
+        PetscCall(PetscInfo(eps,"Unable to generate more start vectors\n"));
+        break;
+      }
+    }
+    PetscCall(EPSMonitor(eps,eps->its,eps->nconv,eps->eigr,eps->eigi,eps->errest,k+m));
+    PetscCall((*eps->stopping)(eps,eps->its,eps->max_it,eps->nconv,eps->nev,&eps->reason,eps->stoppingctx));
+  }
+
+  PetscCall(STRestoreOperator(eps->st,&Op));
+  PetscCall(BVDestroy(&W));
+  PetscCall(PetscFree3(S,tau,work));
+  PetscCall(MatDestroy(&R));
+  PetscCall(MatDestroy(&U));
+  PetscCall(DSSetDimensions(eps->ds,eps->nconv,0,0));
+  PetscCall(DSSetState(eps->ds,DS_STATE_RAW));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSolve_TS_Power(EPS eps)
 {
   EPS_POWER          *power = (EPS_POWER*)eps->data;
@@ -732,6 +854,7 @@ static PetscErrorCode EPSSetFromOptions_Power(EPS eps,PetscOptionItems *PetscOpt
 {
   EPS_POWER         *power = (EPS_POWER*)eps->data;
   PetscBool         flg,val;
+  PetscInt          bs;
   EPSPowerShiftType shift;
 
   PetscFunctionBegin;
@@ -746,6 +869,9 @@ static PetscErrorCode EPSSetFromOptions_Power(EPS eps,PetscOptionItems *PetscOpt
     PetscCall(PetscOptionsBool("-eps_power_update","Update residual monolithically","EPSPowerSetUpdate",power->update,&val,&flg));
     if (flg) PetscCall(EPSPowerSetUpdate(eps,val));
 
+    PetscCall(PetscOptionsInt("-eps_power_blocksize","Block size","EPSPowerSetBlockSize",power->bs,&bs,&flg));
+    if (flg) PetscCall(EPSPowerSetBlockSize(eps,bs));
+
     PetscCall(PetscOptionsBool("-eps_power_sign_normalization","Normalize Bx with sign of first nonzero entry","EPSPowerSetSignNormalization",power->sign_normalization,&power->sign_normalization,&flg));
 
   PetscOptionsHeadEnd();
@@ -1074,6 +1200,91 @@ PetscErrorCode EPSPowerGetSignNormalization(EPS eps,PetscBool *sign_normalizatio
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSPowerSetBlockSize_Power(EPS eps,PetscInt bs)
+{
+  EPS_POWER *power = (EPS_POWER*)eps->data;
+
+  PetscFunctionBegin;
+  if (bs == PETSC_DEFAULT || bs == PETSC_DECIDE) bs = 1;
+  else PetscCheck(bs>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"Invalid block size %" PetscInt_FMT,bs);
+  if (power->bs != bs) {
+    power->bs = bs;
+    eps->state = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSPowerSetBlockSize - Sets the block size of the power iteration.
+
+   Logically Collective
+
+   Input Parameters:
++  eps - the eigenproblem solver context
+-  bs  - the block size
+
+   Options Database Key:
+.  -eps_power_blocksize - Sets the block size
+
+   Notes:
+   If the block size is larger than one, a block of bs vectors is iterated
+   simultaneously (orthogonal iteration), where the operator is applied to the
+   whole block with a single product and the normalization and the convergence
+   check of all the vectors of the block are obtained from one block
+   orthogonalization, see BVSetOrthogonalization(). The leading vectors of the
+   block are locked as soon as they converge.
+
+   This is useful when several eigenvalues are wanted, and also when the
+   dominant eigenvalue is close to the next ones, since the convergence of
+   each vector depends on the ratio with the eigenvalue that follows the block.
+   It is not available for nonlinear problems or variable shifts.
+
+   Level: advanced
+
+.seealso: EPSPowerGetBlockSize()
+@*/
+PetscErrorCode EPSPowerSetBlockSize(EPS eps,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,bs,2);
+  PetscTryMethod(eps,"EPSPowerSetBlockSize_C",(EPS,PetscInt),(eps,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSPowerGetBlockSize_Power(EPS eps,PetscInt *bs)
+{
+  EPS_POWER *power = (EPS_POWER*)eps->data;
+
+  PetscFunctionBegin;
+  *bs = power->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSPowerGetBlockSize - Gets the block size used in the power iteration.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameter:
+.  bs - the block size
+
+   Level: advanced
+
+.seealso: EPSPowerSetBlockSize()
+@*/
+PetscErrorCode EPSPowerGetBlockSize(EPS eps,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(bs,2);
+  PetscUseMethod(eps,"EPSPowerGetBlockSize_C",(EPS,PetscInt*),(eps,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSPowerSetSNES_Power(EPS eps,SNES snes)
 {
   EPS_POWER      *power = (EPS_POWER*)eps->data;
@@ -1177,6 +1388,8 @@ static PetscErrorCode EPSDestroy_Power(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetSignNormalization_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerSetSNES_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetSNES_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerSetBlockSize_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetBlockSize_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1197,7 +1410,10 @@ static PetscErrorCode EPSView_Power(EPS eps,PetscViewer viewer)
       PetscCall(PetscViewerASCIIPushTab(viewer));
       PetscCall(SNESView(power->snes,viewer));
       PetscCall(PetscViewerASCIIPopTab(viewer));
-    } else PetscCall(PetscViewerASCIIPrintf(viewer,"  %s shifts\n",EPSPowerShiftTypes[power->shift_type]));
+    } else {
+      PetscCall(PetscViewerASCIIPrintf(viewer,"  %s shifts\n",EPSPowerShiftTypes[power->shift_type]));
+      if (power->bs>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  block size %" PetscInt_FMT "\n",power->bs));
+    }
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1257,6 +1473,7 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_Power(EPS eps)
   eps->ops->setdefaultst   = EPSSetDefaultST_Power;
   eps->stopping            = EPSStopping_Power;
   ctx->sign_normalization  = PETSC_TRUE;
+  ctx->bs                  = 1;
 
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerSetShiftType_C",EPSPowerSetShiftType_Power));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetShiftType_C",EPSPowerGetShiftType_Power));
@@ -1268,5 +1485,7 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_Power(EPS eps)
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetSignNormalization_C",EPSPowerGetSignNormalization_Power));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerSetSNES_C",EPSPowerSetSNES_Power));
   PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetSNES_C",EPSPowerGetSNES_Power));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerSetBlockSize_C",EPSPowerSetBlockSize_Power));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSPowerGetBlockSize_C",EPSPowerGetBlockSize_Power));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -15,18 +15,26 @@
    Algorithm:
 
        Subspace iteration with Rayleigh-Ritz projection and locking,
-       based on the SRRIT implementation.
+       based on the SRRIT implementation. Optionally, Chebyshev-filtered
+       subspace iteration [2] for symmetric/Hermitian problems.
 
    References:
 
        [1] "Subspace Iteration in SLEPc", SLEPc Technical Report STR-3,
            available at https://slepc.upv.es.
+
+       [2] Y. Zhou and Y. Saad, "A Chebyshev-Davidson algorithm for large
+           symmetric eigenproblems", SIAM J. Matrix Anal. Appl. 29(3):954-971,
+           2007.
 */
 
-#include <slepc/private/epsimpl.h>
+#include <slepc/private/epsimpl.h>                /*I "slepceps.h" I*/
 
 typedef struct {
   PetscBool estimatedrange;     /* the filter range was not set by the user */
+  PetscBool cheby;              /* use Chebyshev-filtered subspace iteration */
+  PetscInt  degree;             /* degree of the Chebyshev filter (0 means automatic) */
+  PetscReal left,right;         /* estimated spectral range of A */
 } EPS_SUBSPACE;
 
 static PetscErrorCode EPSSetUp_Subspace_Filter(EPS eps)
@@ -59,22 +67,47 @@ static PetscErrorCode EPSSetUp_Subspace_Filter(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSSetUp_Subspace_Chebyshev(EPS eps)
+{
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
+  PetscBool      isshift;
+  Mat            A;
+
+  PetscFunctionBegin;
+  EPSCheckHermitianCondition(eps,PETSC_TRUE," with Chebyshev filter");
+  EPSCheckStandardCondition(eps,PETSC_TRUE," with Chebyshev filter");
+  PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STSHIFT,&isshift));
+  PetscCheck(isshift,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The Chebyshev filter requires STSHIFT");
+  if (!eps->which) eps->which = EPS_SMALLEST_REAL;
+  PetscCheck(eps->which==EPS_SMALLEST_REAL || eps->which==EPS_LARGEST_REAL,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The Chebyshev filter supports only smallest real or largest real eigenvalues");
+  EPSCheckUnsupportedCondition(eps,EPS_FEATURE_ARBITRARY | EPS_FEATURE_REGION | EPS_FEATURE_EXTRACTION,PETSC_TRUE," with Chebyshev filter");
+  PetscCall(STGetMatrix(eps->st,0,&A));
+  PetscCall(MatEstimateSpectralRange_EPS(A,&ctx->left,&ctx->right));
+  PetscCall(PetscInfo(eps,"Estimated eigenvalue range [%g,%g]\n",(double)ctx->left,(double)ctx->right));
+  PetscCall(EPSSetDimensions_Default(eps,eps->nev,&eps->ncv,&eps->mpd));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSetUp_Subspace(EPS eps)
 {
-  PetscBool isfilt;
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
+  PetscBool      isfilt;
 
   PetscFunctionBegin;
   EPSCheckDefinite(eps);
   EPSCheckNotStructured(eps);
   if (eps->max_it==PETSC_DETERMINE) eps->max_it = PetscMax(100,2*eps->n/eps->ncv);
-  if (!eps->which) PetscCall(EPSSetWhichEigenpairs_Default(eps));
-  if (eps->which==EPS_ALL) {
-    PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
-    PetscCheck(isfilt,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Spectrum slicing not supported in this solver");
-    PetscCall(EPSSetUp_Subspace_Filter(eps));
-  } else {
-    PetscCheck(eps->which==EPS_LARGEST_MAGNITUDE || eps->which==EPS_TARGET_MAGNITUDE,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"This solver supports only largest magnitude or target magnitude eigenvalues");
-    PetscCall(EPSSetDimensions_Default(eps,eps->nev,&eps->ncv,&eps->mpd));
+  if (ctx->cheby) PetscCall(EPSSetUp_Subspace_Chebyshev(eps));
+  else {
+    if (!eps->which) PetscCall(EPSSetWhichEigenpairs_Default(eps));
+    if (eps->which==EPS_ALL) {
+      PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilt));
+      PetscCheck(isfilt,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Spectrum slicing not supported in this solver");
+      PetscCall(EPSSetUp_Subspace_Filter(eps));
+    } else {
+      PetscCheck(eps->which==EPS_LARGEST_MAGNITUDE || eps->which==EPS_TARGET_MAGNITUDE,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"This solver supports only largest magnitude or target magnitude eigenvalues");
+      PetscCall(EPSSetDimensions_Default(eps,eps->nev,&eps->ncv,&eps->mpd));
+    }
   }
   EPSCheckUnsupported(eps,EPS_FEATURE_ARBITRARY | EPS_FEATURE_EXTRACTION | EPS_FEATURE_TWOSIDED);
   PetscCheck(eps->converged==EPSConvergedRelative,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"This solver only supports relative convergence test");
@@ -176,8 +209,98 @@ static PetscErrorCode EPSSubspaceResidualNorms(BV R,BV V,Mat T,PetscInt l,PetscI
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   EPSSubspaceChebyshevFilter - Replaces V(:,nconv:nv) with p(OP)*V(:,nconv:nv), where
+   p is a Chebyshev polynomial that damps the interval between the last Ritz value and
+   the end of the estimated spectral range, scaled to be one at the first Ritz value.
+   Unless the degree was set by the user, it is chosen for each column from its Ritz
+   value and residual norm (rsd) so that the column is expected to converge, up to
+   maxdeg. Degrees are nondecreasing along the columns, so the recurrence is applied
+   to trailing blocks of decreasing size. AV and R are used as workspace.
+*/
+static PetscErrorCode EPSSubspaceChebyshevFilter(EPS eps,Mat S,BV AV,BV R,PetscReal *rsd,PetscInt nv,PetscInt maxdeg)
+{
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
+  PetscInt       j,k,l,*deg,nconv=eps->nconv,nwanted=PetscMin(eps->nev,nv);
+  PetscReal      shift,a,b,a0,c,e,t,ratio,sg,sg1,sgnew;
+  PetscScalar    sigma;
+  BV             X,Y,W,T;
+  Vec            v;
+
+  PetscFunctionBegin;
+  /* damped interval [a,b] and scaling point a0, for the shifted operator */
+  PetscCall(STGetShift(eps->st,&sigma));
+  shift = PetscRealPart(sigma);
+  a0 = PetscRealPart(eps->eigr[0]);
+  if (eps->which==EPS_SMALLEST_REAL) {
+    a = PetscRealPart(eps->eigr[nv-1]);
+    b = ctx->right-shift;
+    if (b<=a) a = (a0+b)/2.0;
+  } else {
+    a = ctx->left-shift;
+    b = PetscRealPart(eps->eigr[nv-1]);
+    if (b<=a) b = (a0+a)/2.0;
+  }
+  c   = (a+b)/2.0;
+  e   = (b-a)/2.0;
+  sg1 = e/(a0-c);
+
+  /* degree of each column */
+  PetscCall(PetscMalloc1(nv,&deg));
+  for (j=nconv;j<nv;j++) {
+    if (ctx->degree) deg[j] = ctx->degree;
+    else if (j<nwanted) {
+      t     = PetscAbsReal((PetscRealPart(eps->eigr[j])-c)/e);
+      ratio = rsd[j]/(eps->tol*PetscMax(PetscAbsScalar(eps->eigr[j]),PETSC_MACHINE_EPSILON));
+      if (ratio<=1.0) deg[j] = 1;
+      else if (t<=1.0) deg[j] = maxdeg;
+      else deg[j] = (PetscInt)PetscCeilReal(PetscLogReal(ratio)/PetscLogReal(t+PetscSqrtReal(t*t-1.0)));
+      deg[j] = PetscMax(1,PetscMin(deg[j],maxdeg));
+    } else deg[j] = deg[j-1];  /* guard vectors */
+    if (j>nconv) deg[j] = PetscMax(deg[j],deg[j-1]);
+  }
+  PetscCall(PetscInfo(eps,"Chebyshev filter with degrees from %" PetscInt_FMT " to %" PetscInt_FMT "\n",deg[nconv],deg[nv-1]));
+
+  /* first step, Y = (sg1/e)*(OP-c*I)*X */
+  X = eps->V; Y = AV; W = R;
+  l = nconv;
+  PetscCall(BVSetActiveColumns(X,l,nv));
+  PetscCall(BVSetActiveColumns(Y,l,nv));
+  PetscCall(BVMatMult(X,S,Y));
+  PetscCall(BVMult(Y,-c*sg1/e,sg1/e,X,NULL));
+  sg = sg1;
+
+  /* three-term recurrence, W = (2*sgnew/e)*(OP-c*I)*Y - sg*sgnew*X */
+  for (k=2;k<=deg[nv-1];k++) {
+    for (;deg[l]<k;l++) {  /* this column is done, its result is in Y */
+      if (Y!=eps->V) {
+        PetscCall(BVGetColumn(eps->V,l,&v));
+        PetscCall(BVCopyVec(Y,l,v));
+        PetscCall(BVRestoreColumn(eps->V,l,&v));
+      }
+    }
+    sgnew = 1.0/(2.0/sg1-sg);
+    PetscCall(BVSetActiveColumns(X,l,nv));
+    PetscCall(BVSetActiveColumns(Y,l,nv));
+    PetscCall(BVSetActiveColumns(W,l,nv));
+    PetscCall(BVMatMult(Y,S,W));
+    PetscCall(BVMult(W,-2.0*c*sgnew/e,2.0*sgnew/e,Y,NULL));
+    PetscCall(BVMult(W,-sg*sgnew,1.0,X,NULL));
+    T = X; X = Y; Y = W; W = T;
+    sg = sgnew;
+  }
+  if (Y!=eps->V) {
+    PetscCall(BVSetActiveColumns(Y,l,nv));
+    PetscCall(BVSetActiveColumns(eps->V,l,nv));
+    PetscCall(BVCopy(Y,eps->V));
+  }
+  PetscCall(PetscFree(deg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSSolve_Subspace(EPS eps)
 {
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
   Mat            H,Q,S,T,B;
   BV             AV,R;
   PetscBool      indef;
@@ -194,6 +317,7 @@ static PetscErrorCode EPSSolve_Subspace(EPS eps)
   PetscReal      cnvtol = 1e-6;   /* Convergence criterion for cnv */
   PetscInt       orttol = 2;      /* Number of decimal digits whose loss
                                      can be tolerated in orthogonalization */
+  PetscInt       maxdeg = 36;     /* Max degree of the Chebyshev filter */
 
   PetscFunctionBegin;
   its = 0;
@@ -287,6 +411,15 @@ static PetscErrorCode EPSSolve_Subspace(EPS eps)
     PetscCall((*eps->stopping)(eps,eps->its,eps->max_it,eps->nconv,eps->nev,&eps->reason,eps->stoppingctx));
     if (eps->reason != EPS_CONVERGED_ITERATING) break;
 
+    if (ctx->cheby) {
+      /* V(:,idx) = p(OP)*V(:,idx), then orthonormalize */
+      PetscCall(EPSSubspaceChebyshevFilter(eps,S,AV,R,rsd,nv,maxdeg));
+      PetscCall(BVSetActiveColumns(eps->V,eps->nconv,nv));
+      PetscCall(BVOrthogonalize(eps->V,NULL));
+      its++;
+      continue;
+    }
+
     /* Compute nxtsrr (iteration of next projection step) */
     nxtsrr = PetscMin(eps->max_it,PetscMax((PetscInt)PetscFloorReal(stpfac*its),init));
 
@@ -336,10 +469,139 @@ static PetscErrorCode EPSSolve_Subspace(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode EPSSubspaceSetChebyshev_Subspace(EPS eps,PetscBool cheby,PetscInt degree)
+{
+  EPS_SUBSPACE *ctx = (EPS_SUBSPACE*)eps->data;
+
+  PetscFunctionBegin;
+  if (degree == PETSC_DEFAULT || degree == PETSC_DETERMINE) degree = 0;
+  else PetscCheck(degree>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"Invalid degree %" PetscInt_FMT,degree);
+  if (ctx->cheby != cheby || ctx->degree != degree) {
+    ctx->cheby  = cheby;
+    ctx->degree = degree;
+    eps->state  = EPS_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSSubspaceSetChebyshev - Activates the Chebyshev-filtered variant of the
+   subspace iteration method.
+
+   Logically Collective
+
+   Input Parameters:
++  eps    - the eigenproblem solver context
+.  cheby  - true if the Chebyshev filter must be used
+-  degree - the degree of the filter, or `PETSC_DETERMINE` to choose it automatically
+
+   Options Database Keys:
++  -eps_subspace_chebyshev - Activates the Chebyshev filter
+-  -eps_subspace_chebyshev_degree - Sets the degree of the filter
+
+   Notes:
+   In this variant, intended for the smallest or largest eigenvalues of symmetric
+   or Hermitian standard problems, the basis is multiplied in each iteration by a
+   Chebyshev polynomial of the operator that damps the unwanted part of the
+   spectrum, from the last Ritz value to the end of the spectral range, which is
+   estimated during the setup. The polynomial is evaluated with a three-term
+   recurrence in which all the columns are multiplied at once with BVMatMult(),
+   so it runs on the GPU if the BV and the matrix are of a GPU type.
+
+   If the degree is not given, it is chosen for each vector from its Ritz value
+   and residual norm, so that vectors that are close to convergence get a smaller
+   degree. The filter is applied to the operator of ST, which must be `STSHIFT`.
+   This variant is suitable for solving a sequence of related problems with
+   initial vectors taken from the previous solution, see EPSSetInitialSpace().
+
+   Level: advanced
+
+.seealso: EPSSubspaceGetChebyshev(), EPSSetInitialSpace()
+@*/
+PetscErrorCode EPSSubspaceSetChebyshev(EPS eps,PetscBool cheby,PetscInt degree)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,cheby,2);
+  PetscValidLogicalCollectiveInt(eps,degree,3);
+  PetscTryMethod(eps,"EPSSubspaceSetChebyshev_C",(EPS,PetscBool,PetscInt),(eps,cheby,degree));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSSubspaceGetChebyshev_Subspace(EPS eps,PetscBool *cheby,PetscInt *degree)
+{
+  EPS_SUBSPACE *ctx = (EPS_SUBSPACE*)eps->data;
+
+  PetscFunctionBegin;
+  if (cheby) *cheby = ctx->cheby;
+  if (degree) *degree = ctx->degree? ctx->degree: PETSC_DETERMINE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSSubspaceGetChebyshev - Gets the flag and the degree of the Chebyshev
+   filter in the subspace iteration method.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigenproblem solver context
+
+   Output Parameters:
++  cheby  - whether the Chebyshev filter is used
+-  degree - the degree of the filter, `PETSC_DETERMINE` if it is chosen automatically
+
+   Level: advanced
+
+.seealso: EPSSubspaceSetChebyshev()
+@*/
+PetscErrorCode EPSSubspaceGetChebyshev(EPS eps,PetscBool *cheby,PetscInt *degree)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscUseMethod(eps,"EPSSubspaceGetChebyshev_C",(EPS,PetscBool*,PetscInt*),(eps,cheby,degree));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSSetFromOptions_Subspace(EPS eps,PetscOptionItems *PetscOptionsObject)
+{
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
+  PetscBool      cheby,flg1,flg2;
+  PetscInt       degree;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"EPS Subspace Options");
+
+    cheby  = ctx->cheby;
+    degree = ctx->degree? ctx->degree: PETSC_DETERMINE;
+    PetscCall(PetscOptionsBool("-eps_subspace_chebyshev","Use Chebyshev-filtered subspace iteration","EPSSubspaceSetChebyshev",cheby,&cheby,&flg1));
+    PetscCall(PetscOptionsInt("-eps_subspace_chebyshev_degree","Degree of the Chebyshev filter","EPSSubspaceSetChebyshev",degree,&degree,&flg2));
+    if (flg1 || flg2) PetscCall(EPSSubspaceSetChebyshev(eps,cheby,degree));
+
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode EPSView_Subspace(EPS eps,PetscViewer viewer)
+{
+  EPS_SUBSPACE   *ctx = (EPS_SUBSPACE*)eps->data;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii && ctx->cheby) {
+    if (ctx->degree) PetscCall(PetscViewerASCIIPrintf(viewer,"  using Chebyshev filter of degree %" PetscInt_FMT "\n",ctx->degree));
+    else PetscCall(PetscViewerASCIIPrintf(viewer,"  using Chebyshev filter with automatic degree\n"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode EPSDestroy_Subspace(EPS eps)
 {
   PetscFunctionBegin;
   PetscCall(PetscFree(eps->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSSubspaceSetChebyshev_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSSubspaceGetChebyshev_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -357,8 +619,13 @@ SLEPC_EXTERN PetscErrorCode EPSCreate_Subspace(EPS eps)
   eps->ops->solve          = EPSSolve_Subspace;
   eps->ops->setup          = EPSSetUp_Subspace;
   eps->ops->setupsort      = EPSSetUpSort_Subspace;
+  eps->ops->setfromoptions = EPSSetFromOptions_Subspace;
   eps->ops->destroy        = EPSDestroy_Subspace;
+  eps->ops->view           = EPSView_Subspace;
   eps->ops->backtransform  = EPSBackTransform_Default;
   eps->ops->computevectors = EPSComputeVectors_Schur;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSSubspaceSetChebyshev_C",EPSSubspaceSetChebyshev_Subspace));
+  PetscCall(PetscObjectComposeFunction((PetscObject)eps,"EPSSubspaceGetChebyshev_C",EPSSubspaceGetChebyshev_Subspace));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -76,6 +76,8 @@ PetscErrorCode EPSCreate(MPI_Comm comm,EPS *outeps)
   eps->trackall        = PETSC_FALSE;
   eps->purify          = PETSC_TRUE;
   eps->twosided        = PETSC_FALSE;
+  eps->warmstart       = PETSC_FALSE;
+  eps->lazyvecs        = PETSC_FALSE;
 
   eps->converged       = EPSConvergedRelative;
   eps->convergeduser   = NULL;
@@ -346,6 +348,7 @@ PetscErrorCode EPSDestroy(EPS *eps)
   PetscCall(SlepcBasisDestroy_Private(&(*eps)->nds,&(*eps)->defl));
   PetscCall(SlepcBasisDestroy_Private(&(*eps)->nini,&(*eps)->IS));
   PetscCall(SlepcBasisDestroy_Private(&(*eps)->ninil,&(*eps)->ISL));
+  PetscCall(PetscViewerDestroy(&(*eps)->rstviewer));
   if ((*eps)->convergeddestroy) PetscCall((*(*eps)->convergeddestroy)((*eps)->convergedctx));
   PetscCall(EPSMonitorCancel(*eps));
   PetscCall(PetscHeaderDestroy(eps));
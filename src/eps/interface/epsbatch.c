@@ -0,0 +1,175 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   EPS routines related to the solution of many independent problems
+*/
+
+#include <slepc/private/epsimpl.h>       /*I "slepceps.h" I*/
+
+/*
+   Transfers the configuration of the template eps to the eps that solves the problems
+*/
+static PetscErrorCode EPSBatchCopySettings(EPS eps,EPS child)
+{
+  const char *prefix;
+  EPSType    type;
+  STType     sttype;
+  ST         st;
+
+  PetscFunctionBegin;
+  PetscCall(EPSGetType(eps,&type));
+  if (type) PetscCall(EPSSetType(child,type));
+  if (eps->problem_type) PetscCall(EPSSetProblemType(child,eps->problem_type));
+  if (eps->which) PetscCall(EPSSetWhichEigenpairs(child,eps->which));
+  if (eps->which==EPS_ALL && eps->inta<eps->intb) PetscCall(EPSSetInterval(child,eps->inta,eps->intb));
+  PetscCall(EPSSetTarget(child,eps->target));
+  PetscCall(EPSSetDimensions(child,eps->nev,eps->ncv,eps->mpd));
+  PetscCall(EPSSetTolerances(child,eps->tol,eps->max_it));
+  if (eps->conv!=EPS_CONV_USER) PetscCall(EPSSetConvergenceTest(child,eps->conv));
+  PetscCall(EPSSetExtraction(child,eps->extraction));
+  PetscCall(EPSSetPurify(child,eps->purify));
+  PetscCall(EPSSetTwoSided(child,eps->twosided));
+  PetscCall(EPSSetWarmStart(child,eps->warmstart));
+  PetscCall(EPSSetLazyVectors(child,eps->lazyvecs));
+  if (eps->st) {
+    PetscCall(STGetType(eps->st,&sttype));
+    if (sttype) {
+      PetscCall(EPSGetST(child,&st));
+      PetscCall(STSetType(st,sttype));
+    }
+  }
+  PetscCall(EPSGetOptionsPrefix(eps,&prefix));
+  PetscCall(EPSSetOptionsPrefix(child,prefix));
+  PetscCall(EPSSetFromOptions(child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Gets the index of the next problem to be solved by this partition, from a
+   counter in the first process that is incremented by the partition leaders
+*/
+static PetscErrorCode EPSBatchNext(MPI_Win win,PetscSubcomm subc,PetscInt *i)
+{
+  PetscInt    next;
+  PetscMPIInt rank;
+  MPI_Comm    child;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  if (!rank) {
+    PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,0,0,win));
+    PetscCallMPI(MPI_Get(i,1,MPIU_INT,0,0,1,MPIU_INT,win));
+    PetscCallMPI(MPI_Win_flush(0,win));
+    next = *i+1;
+    PetscCallMPI(MPI_Put(&next,1,MPIU_INT,0,0,1,MPIU_INT,win));
+    PetscCallMPI(MPI_Win_unlock(0,win));
+  }
+  PetscCallMPI(MPI_Bcast(i,1,MPIU_INT,0,child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   EPSSolveBatch - Solves a collection of independent eigenproblems, all of them
+   with the same solver configuration.
+
+   Collective
+
+   Input Parameters:
++  eps    - the eigensolver context, used as a template
+.  nprob  - number of problems
+.  npart  - number of partitions of the communicator
+.  getops - function that creates the matrices of each problem, see EPSBatchOperatorsFn
+.  result - function that retrieves the solution of each problem, see EPSBatchResultFn
+-  ctx    - [optional] user-defined context passed to both functions (may be NULL)
+
+   Notes:
+   The communicator of eps is split in npart partitions of contiguous processes,
+   and each partition creates a single EPS object that is reused for all the
+   problems it solves. In this way, the setup of the objects, the workspace of
+   the basis vectors and the projected problem, and the factorizations in ST
+   (if the nonzero pattern is the same, see STSetMatStructure()) are shared
+   among problems of the same size. The problems are assigned to the partitions
+   dynamically, each one taking the next pending problem when it finishes the
+   previous one, so that the load is balanced even if the cost of the problems
+   is different.
+
+   The configuration of the template eps (solver type, problem type, dimensions,
+   tolerances, spectral transformation type, etc.) is copied to the eps of each
+   partition, which is also configured from the options database with the same
+   prefix. The template eps does not need to have matrices.
+
+   The function getops is called by all processes of a partition with the
+   eps that will solve problem i, and it must create the matrices on the
+   communicator of that eps (PetscObjectComm((PetscObject)eps)). The matrices
+   are destroyed after the solve, so the caller should not destroy them. After
+   the solve, result is called in the same way, and it can retrieve any data
+   of the solution with the usual functions such as EPSGetEigenpair().
+
+   If EPSSetWarmStart() is activated in the template, each problem starts from
+   the subspace of the previous problem solved in the same partition.
+
+   Level: advanced
+
+.seealso: EPSSolve(), EPSSetWarmStart(), EPSBatchOperatorsFn, EPSBatchResultFn
+@*/
+PetscErrorCode EPSSolveBatch(EPS eps,PetscInt nprob,PetscInt npart,EPSBatchOperatorsFn *getops,EPSBatchResultFn *result,void *ctx)
+{
+  EPS          child;
+  PetscSubcomm subc=NULL;
+  PetscMPIInt  size,rank;
+  PetscInt     i,counter=0;
+  MPI_Comm     comm;
+  MPI_Win      win=MPI_WIN_NULL;
+  Mat          A,B;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,nprob,2);
+  PetscValidLogicalCollectiveInt(eps,npart,3);
+  PetscCheck(nprob>=0,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The number of problems cannot be negative");
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)eps),&size));
+  PetscCheck(npart>0 && npart<=size,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The number of partitions must be between 1 and %d",(int)size);
+
+  /* create the eps of this partition */
+  if (npart>1) {
+    PetscCall(PetscSubcommCreate(PetscObjectComm((PetscObject)eps),&subc));
+    PetscCall(PetscSubcommSetNumber(subc,npart));
+    PetscCall(PetscSubcommSetType(subc,PETSC_SUBCOMM_CONTIGUOUS));
+    PetscCall(PetscSubcommGetChild(subc,&comm));
+    PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)eps),&rank));
+    PetscCallMPI(MPI_Win_create(&counter,(MPI_Aint)(rank?0:sizeof(PetscInt)),(PetscMPIInt)sizeof(PetscInt),MPI_INFO_NULL,PetscObjectComm((PetscObject)eps),&win));
+  } else comm = PetscObjectComm((PetscObject)eps);
+  PetscCall(EPSCreate(comm,&child));
+  PetscCall(EPSBatchCopySettings(eps,child));
+
+  /* solve the problems, one at a time in each partition */
+  if (npart>1) PetscCall(EPSBatchNext(win,subc,&i));
+  else i = 0;
+  while (i<nprob) {
+    A = NULL; B = NULL;
+    PetscCall((*getops)(child,i,&A,&B,ctx));
+    PetscCheck(A,comm,PETSC_ERR_USER,"The operators function did not create a matrix for problem %" PetscInt_FMT,i);
+    PetscCall(EPSSetOperators(child,A,B));
+    PetscCall(MatDestroy(&A));
+    PetscCall(MatDestroy(&B));
+    PetscCall(EPSSolve(child));
+    if (result) PetscCall((*result)(child,i,ctx));
+    if (npart>1) PetscCall(EPSBatchNext(win,subc,&i));
+    else i++;
+  }
+
+  PetscCall(EPSDestroy(&child));
+  if (npart>1) {
+    PetscCallMPI(MPI_Win_free(&win));
+    PetscCall(PetscSubcommDestroy(&subc));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -115,8 +115,14 @@ PetscErrorCode EPSComputeVectors_Schur(EPS eps)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
-  /* right eigenvectors */
-  PetscCall(DSVectors(eps->ds,DS_MAT_X,NULL,NULL));
+  /* right eigenvectors, only the converged ones are needed */
+  PetscCall(DSVectorsRange(eps->ds,DS_MAT_X,0,eps->nconv));
+
+  /* keep V and Z, the eigenvectors are formed in EPSGetEigenvector_Schur() */
+  if (eps->lazyvecs && !eps->twosided) {
+    eps->vlazy = PETSC_TRUE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   /* V = V * Z */
   PetscCall(DSGetMat(eps->ds,DS_MAT_X,&Z));
@@ -140,7 +146,7 @@ PetscErrorCode EPSComputeVectors_Schur(EPS eps)
 
   /* left eigenvectors */
   if (eps->twosided) {
-    PetscCall(DSVectors(eps->ds,DS_MAT_Y,NULL,NULL));
+    PetscCall(DSVectorsRange(eps->ds,DS_MAT_Y,0,eps->nconv));
     /* W = W * Z */
     PetscCall(DSGetMat(eps->ds,DS_MAT_Y,&Z));
     PetscCall(BVMultInPlace(eps->W,Z,0,eps->nconv));
@@ -168,6 +174,70 @@ PetscErrorCode EPSComputeVectors_Schur(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  EPSGetEigenvector_Schur - Forms the i-th eigenvector as x = V*z, where z is
+  the corresponding column of DS_MAT_X, when EPSComputeVectors_Schur() has not
+  formed them (see EPSSetLazyVectors()). The postprocessing is the same as in
+  EPSComputeVectors_Schur(), restricted to x (and its conjugate pair).
+ */
+PetscErrorCode EPSGetEigenvector_Schur(EPS eps,PetscInt i,Vec Vr,Vec Vi)
+{
+  PetscInt       j,k,kr,ki=-1,ld,nc;
+  PetscScalar    *X;
+  PetscReal      norm,nrm;
+  Vec            x[2],w;
+  PetscBool      fix;
+
+  PetscFunctionBegin;
+  k  = eps->perm[i];
+  kr = k;
+#if !defined(PETSC_USE_COMPLEX)
+  if (eps->eigi[k] > 0.0) ki = k+1;       /* first value of conjugate pair */
+  else if (eps->eigi[k] < 0.0) { kr = k-1; ki = k; }  /* second value of conjugate pair */
+#endif
+  nc = (ki<0)? 1: 2;
+  fix = (eps->balance!=EPS_BALANCE_NONE && eps->D)? PETSC_TRUE: PETSC_FALSE;
+
+  /* x = V*z for the real and imaginary parts */
+  PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+  PetscCall(BVSetActiveColumns(eps->V,0,eps->nconv));
+  PetscCall(DSGetArray(eps->ds,DS_MAT_X,&X));
+  for (j=0;j<nc;j++) {
+    PetscCall(BVCreateVec(eps->V,&x[j]));
+    PetscCall(BVMultVec(eps->V,1.0,0.0,x[j],X+(j?ki:kr)*ld));
+  }
+  PetscCall(DSRestoreArray(eps->ds,DS_MAT_X,&X));
+
+  /* purify, fix balancing and normalize */
+  if (eps->purify || fix) {
+    norm = 0.0;
+    for (j=0;j<nc;j++) {
+      if (eps->purify) {
+        PetscCall(VecDuplicate(x[j],&w));
+        PetscCall(VecCopy(x[j],w));
+        PetscCall(STApply(eps->st,w,x[j]));
+        PetscCall(VecDestroy(&w));
+      }
+      if (fix) PetscCall(VecPointwiseDivide(x[j],x[j],eps->D));
+      PetscCall(BVNormVec(eps->V,x[j],NORM_2,&nrm));
+      norm += nrm*nrm;
+    }
+    norm = PetscSqrtReal(norm);
+    for (j=0;j<nc;j++) PetscCall(VecScale(x[j],1.0/norm));
+  }
+
+  if (Vr) PetscCall(VecCopy(x[0],Vr));
+  if (Vi) {
+    if (nc==1) PetscCall(VecSet(Vi,0.0));
+    else {
+      PetscCall(VecCopy(x[1],Vi));
+      if (ki==k) PetscCall(VecScale(Vi,-1.0));
+    }
+  }
+  for (j=0;j<nc;j++) PetscCall(VecDestroy(&x[j]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSSetWorkVecs - Sets a number of work vectors into an EPS object.
 
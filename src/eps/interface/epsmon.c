@@ -348,6 +348,57 @@ PetscErrorCode EPSMonitorConvergedDestroy(PetscViewerAndFormat **vf)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   EPSMonitorAllBinary - Records the current approximate values and error estimates
+   at each iteration of the eigensolver in memory, and writes them to a binary file
+   when the monitor is destroyed.
+
+   Collective
+
+   Input Parameters:
++  eps    - eigensolver context
+.  its    - iteration number
+.  nconv  - number of converged eigenpairs so far
+.  eigr   - real part of the eigenvalues
+.  eigi   - imaginary part of the eigenvalues
+.  errest - error estimates
+.  nest   - number of error estimates to display
+-  vf     - viewer and format for monitoring
+
+   Options Database Keys:
++  -eps_monitor_all binary:filename - activates EPSMonitorAllBinary()
+-  -eps_monitor_history_size <n> - number of iterations kept in memory
+
+   Notes:
+   Nothing is written during the iteration, so this monitor has a negligible cost
+   compared to EPSMonitorAll() when many iterations or many processes are involved.
+   Only the last n iterations are kept (1000 by default), older ones are overwritten.
+
+   The file is written when the monitor is cancelled, e.g., in EPSDestroy(). It contains
+   the number of stored iterations, and for each of them the iteration number, the number
+   of converged values, the number of values nest, a time stamp in seconds relative to
+   the first iteration, the nest real and imaginary parts of the eigenvalues and the
+   nest error estimates, as written by PetscViewerBinaryWrite().
+
+   Level: intermediate
+
+.seealso: EPSMonitorSet(), EPSMonitorAll()
+@*/
+PetscErrorCode EPSMonitorAllBinary(EPS eps,PetscInt its,PetscInt nconv,PetscScalar *eigr,PetscScalar *eigi,PetscReal *errest,PetscInt nest,PetscViewerAndFormat *vf)
+{
+  PetscInt    i,n;
+  PetscScalar *er,*ei;
+  PetscReal   *err;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidHeaderSpecific(vf->viewer,PETSC_VIEWER_CLASSID,8);
+  PetscCall(SlepcHistMonGetSlot_Private((PetscObject)eps,"-eps_monitor_history_size",eps->ncv,its,nconv,nest,vf,&n,&er,&ei,&err));
+  for (i=0;i<n;i++) { er[i] = eigr[i]; ei[i] = eigi[i]; err[i] = errest[i]; }
+  PetscCall(STBackTransform(eps->st,n,er,ei));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    EPSMonitorFirstDrawLG - Plots the error estimate of the first unconverged
    approximation at each iteration of the eigensolver.
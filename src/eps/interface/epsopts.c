@@ -204,6 +204,10 @@ PetscErrorCode EPSSetFromOptions(EPS eps)
     if (flg) PetscCall(EPSSetPurify(eps,bval));
     PetscCall(PetscOptionsBool("-eps_two_sided","Use two-sided variant (to compute left eigenvectors)","EPSSetTwoSided",eps->twosided,&bval,&flg));
     if (flg) PetscCall(EPSSetTwoSided(eps,bval));
+    PetscCall(PetscOptionsBool("-eps_warm_start","Start from the subspace computed in the previous solve","EPSSetWarmStart",eps->warmstart,&bval,&flg));
+    if (flg) PetscCall(EPSSetWarmStart(eps,bval));
+    PetscCall(PetscOptionsBool("-eps_lazy_vectors","Form eigenvectors only when they are requested","EPSSetLazyVectors",eps->lazyvecs,&bval,&flg));
+    if (flg) PetscCall(EPSSetLazyVectors(eps,bval));
 
     /* -----------------------------------------------------------------------*/
     /*
@@ -1361,6 +1365,142 @@ PetscErrorCode EPSGetPurify(EPS eps,PetscBool *purify)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   EPSSetWarmStart - Activates the reuse of the subspace computed in the previous
+   call to EPSSolve() as the starting point of the next one.
+
+   Logically Collective
+
+   Input Parameters:
++  eps       - the eigensolver context
+-  warmstart - whether to start from the previous solution or not
+
+   Options Database Keys:
+.  -eps_warm_start <boolean> - Sets/resets the boolean flag 'warmstart'
+
+   Notes:
+   This is intended for sequences of eigenproblems where the matrices change
+   slightly from one step to the next, for instance in time stepping or in
+   self-consistent field iterations. Once the matrices have been updated with
+   EPSSetOperators(), the converged subspace of the previous solve is projected
+   onto the new operator (Rayleigh-Ritz) and the computation starts from the
+   resulting Schur form. The Ritz pairs that already satisfy the convergence
+   criterion are locked from the start, and the remaining ones are combined
+   into the initial vector. The factorizations in ST are recomputed only if the
+   matrices have changed; use STSetMatStructure() to indicate that the nonzero
+   pattern is the same, so that the symbolic factorization is reused.
+
+   The previous subspace is discarded if an initial space is provided with
+   EPSSetInitialSpace(), or if the problem size or the number of column vectors
+   change.
+
+   Currently this is used only in the Krylov-Schur solver, in the variants that do
+   not use spectrum slicing, harmonic extraction, the indefinite or the two-sided
+   iteration. Other solvers ignore it.
+
+   Level: advanced
+
+.seealso: EPSGetWarmStart(), EPSSetOperators(), EPSSetInitialSpace(), STSetMatStructure()
+@*/
+PetscErrorCode EPSSetWarmStart(EPS eps,PetscBool warmstart)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,warmstart,2);
+  eps->warmstart = warmstart;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSGetWarmStart - Returns the flag indicating whether the subspace of the
+   previous solve is reused or not.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigensolver context
+
+   Output Parameter:
+.  warmstart - the returned flag
+
+   Level: advanced
+
+.seealso: EPSSetWarmStart()
+@*/
+PetscErrorCode EPSGetWarmStart(EPS eps,PetscBool *warmstart)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(warmstart,2);
+  *warmstart = eps->warmstart;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSSetLazyVectors - Indicates that the eigenvectors must be formed only when
+   they are requested, instead of all at once.
+
+   Logically Collective
+
+   Input Parameters:
++  eps  - the eigensolver context
+-  lazy - whether to form the eigenvectors on demand or not
+
+   Options Database Keys:
+.  -eps_lazy_vectors <boolean> - Sets/resets the boolean flag 'lazy'
+
+   Notes:
+   In non-Hermitian problems, the solvers that compute a partial Schur form
+   obtain the eigenvectors as the product of the Schur vectors by the
+   eigenvectors of the projected matrix, and by default this product is done
+   in place for all converged eigenpairs the first time an eigenvector is
+   requested. With this flag, only the eigenvectors of the projected matrix
+   are computed at that point, and each call to EPSGetEigenvector() forms the
+   requested vector (and purifies and normalizes it, if applicable) with a
+   single matrix-vector product with the Schur vectors. This is cheaper when
+   only a few of many converged eigenvectors are needed. Since the Schur
+   vectors are kept, EPSGetInvariantSubspace() can be called at any time.
+
+   The flag has no effect in Hermitian problems or in the two-sided variants.
+
+   Level: advanced
+
+.seealso: EPSGetLazyVectors(), EPSGetEigenvector(), EPSGetInvariantSubspace()
+@*/
+PetscErrorCode EPSSetLazyVectors(EPS eps,PetscBool lazy)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveBool(eps,lazy,2);
+  eps->lazyvecs = lazy;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSGetLazyVectors - Returns the flag indicating whether the eigenvectors are
+   formed only when they are requested.
+
+   Not Collective
+
+   Input Parameter:
+.  eps - the eigensolver context
+
+   Output Parameter:
+.  lazy - the returned flag
+
+   Level: advanced
+
+.seealso: EPSSetLazyVectors()
+@*/
+PetscErrorCode EPSGetLazyVectors(EPS eps,PetscBool *lazy)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(lazy,2);
+  *lazy = eps->lazyvecs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSSetOptionsPrefix - Sets the prefix used for searching for all
    EPS options in the database.
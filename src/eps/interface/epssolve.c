@@ -28,6 +28,7 @@ static PetscErrorCode EPSComputeValues(EPS eps)
 {
   PetscBool      injective,iscomp,isfilter;
   PetscInt       i,n,aux,nconv0;
+  PetscReal      inta,intb;
   Mat            A,B=NULL,G,Z;
 
   PetscFunctionBegin;
@@ -67,9 +68,10 @@ static PetscErrorCode EPSComputeValues(EPS eps)
         /* in case of STFILTER discard computed eigenvalues that lie outside the wanted interval */
         PetscCall(PetscObjectTypeCompare((PetscObject)eps->st,STFILTER,&isfilter));
         if (isfilter) {
+          PetscCall(STFilterGetInterval(eps->st,&inta,&intb));
           nconv0 = eps->nconv;
           for (i=0;i<eps->nconv;i++) {
-            if (PetscRealPart(eps->eigr[eps->perm[i]])<eps->inta || PetscRealPart(eps->eigr[eps->perm[i]])>eps->intb) {
+            if (PetscRealPart(eps->eigr[eps->perm[i]])<inta || PetscRealPart(eps->eigr[eps->perm[i]])>intb) {
               eps->nconv--;
               if (i<eps->nconv) { SlepcSwap(eps->perm[i],eps->perm[eps->nconv],aux); i--; }
             }
@@ -86,6 +88,32 @@ static PetscErrorCode EPSComputeValues(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   EPSLoadCheckpoint_Private - Reads the solver state from the viewer given in
+   EPSRestart(). The generic part is read here, the rest by the solver.
+*/
+static PetscErrorCode EPSLoadCheckpoint_Private(EPS eps)
+{
+  PetscInt       header[5];
+
+  PetscFunctionBegin;
+  PetscCheck(eps->ops->restart,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"This solver does not support restarting from a checkpoint");
+  PetscCall(PetscViewerBinaryRead(eps->rstviewer,header,5,NULL,PETSC_INT));
+  PetscCheck(header[0]==EPS_CLASSID,PetscObjectComm((PetscObject)eps),PETSC_ERR_FILE_UNEXPECTED,"The file does not contain an EPS checkpoint");
+  PetscCheck(header[1]==eps->n && header[2]==eps->ncv,PetscObjectComm((PetscObject)eps),PETSC_ERR_FILE_UNEXPECTED,"The checkpoint was saved for a problem of size %" PetscInt_FMT " with ncv=%" PetscInt_FMT ", but the current values are %" PetscInt_FMT " and %" PetscInt_FMT,header[1],header[2],eps->n,eps->ncv);
+  eps->its   = header[3];
+  eps->nconv = header[4];
+  if (eps->nconv) {
+    PetscCall(PetscViewerBinaryRead(eps->rstviewer,eps->eigr,eps->nconv,NULL,PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryRead(eps->rstviewer,eps->eigi,eps->nconv,NULL,PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryRead(eps->rstviewer,eps->errest,eps->nconv,NULL,PETSC_REAL));
+  }
+  PetscUseTypeMethod(eps,restart,eps->rstviewer);
+  PetscCall(PetscInfo(eps,"Restarting from a checkpoint at iteration %" PetscInt_FMT " with %" PetscInt_FMT " converged eigenpairs\n",eps->its,eps->nconv));
+  PetscCall(PetscViewerDestroy(&eps->rstviewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSSolve - Solves the eigensystem.
 
@@ -112,13 +140,17 @@ static PetscErrorCode EPSComputeValues(EPS eps)
    eigenvalues graphically, or '-eps_error_relative :myerr.m:ascii_matlab' to save
    the errors in a file that can be executed in Matlab.
 
+   If EPSRestart() has been called before, the solver resumes the computation
+   from the state saved with EPSCheckpoint(). If EPSSetWarmStart() has been
+   activated, the computation starts from the subspace of the previous solve.
+
    Level: beginner
 
-.seealso: EPSCreate(), EPSSetUp(), EPSDestroy(), EPSSetTolerances()
+.seealso: EPSCreate(), EPSSetUp(), EPSDestroy(), EPSSetTolerances(), EPSRestart(), EPSSetWarmStart()
 @*/
 PetscErrorCode EPSSolve(EPS eps)
 {
-  PetscInt       i;
+  PetscInt       i,nwarm=0,m0=0,m;
   PetscBool      hasname;
   STMatMode      matmode;
   Mat            A,B;
@@ -126,18 +158,32 @@ PetscErrorCode EPSSolve(EPS eps)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
   if (eps->state>=EPS_STATE_SOLVED) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(SlepcPerfStatsBegin_Private(EPS_Solve,EPS_SetUp,eps->perf));
   PetscCall(PetscLogEventBegin(EPS_Solve,eps,0,0,0));
 
+  /* Keep the subspace of the previous solve, unless it is going to be overwritten */
+  if (eps->warmstart && eps->V && eps->nconv>0 && !eps->nini && !eps->rstviewer) {
+    nwarm = eps->nconv;
+    PetscCall(BVGetSizes(eps->V,NULL,NULL,&m0));
+  }
+
   /* Call setup */
   PetscCall(EPSSetUp(eps));
+  eps->nwarm = 0;
+  if (nwarm) {
+    PetscCall(BVGetSizes(eps->V,NULL,NULL,&m));
+    if (m==m0) eps->nwarm = PetscMin(nwarm,eps->ncv-1);
+  }
   eps->nconv = 0;
   eps->its   = 0;
+  eps->vlazy = PETSC_FALSE;
   for (i=0;i<eps->ncv;i++) {
     eps->eigr[i]   = 0.0;
     eps->eigi[i]   = 0.0;
     eps->errest[i] = 0.0;
     eps->perm[i]   = i;
   }
+  if (eps->rstviewer) PetscCall(EPSLoadCheckpoint_Private(eps));
   PetscCall(EPSViewFromOptions(eps,NULL,"-eps_view_pre"));
   PetscCall(RGViewFromOptions(eps->rg,NULL,"-rg_view"));
 
@@ -146,8 +192,9 @@ PetscErrorCode EPSSolve(EPS eps)
   PetscCheck(eps->reason,PetscObjectComm((PetscObject)eps),PETSC_ERR_PLIB,"Internal error, solver returned without setting converged reason");
   eps->state = EPS_STATE_SOLVED;
 
-  /* Only the first nconv columns contain useful information (except in CISS) */
-  PetscCall(BVSetActiveColumns(eps->V,0,eps->nconv));
+  /* Only the first nconv columns contain useful information (except in CISS),
+     unless the eigenvectors are not stored in eps->V */
+  if (!eps->ops->geteigenvector) PetscCall(BVSetActiveColumns(eps->V,0,eps->nconv));
   if (eps->twosided) PetscCall(BVSetActiveColumns(eps->W,0,eps->nconv));
 
   /* If inplace, purify eigenvectors before reverting operator */
@@ -167,7 +214,14 @@ PetscErrorCode EPSSolve(EPS eps)
         eps->eigi[i+1] = -eps->eigi[i+1];
         /* the next correction only works with eigenvectors */
         PetscCall(EPSComputeVectors(eps));
-        PetscCall(BVScaleColumn(eps->V,i+1,-1.0));
+        if (eps->vlazy) {  /* the eigenvectors are not formed, change the sign of the coefficients */
+          PetscInt    j,ld;
+          PetscScalar *X;
+          PetscCall(DSGetLeadingDimension(eps->ds,&ld));
+          PetscCall(DSGetArray(eps->ds,DS_MAT_X,&X));
+          for (j=0;j<eps->nconv;j++) X[j+(i+1)*ld] = -X[j+(i+1)*ld];
+          PetscCall(DSRestoreArray(eps->ds,DS_MAT_X,&X));
+        } else PetscCall(BVScaleColumn(eps->V,i+1,-1.0));
       }
       i++;
     }
@@ -177,6 +231,7 @@ PetscErrorCode EPSSolve(EPS eps)
   /* Sort eigenvalues according to eps->which parameter */
   PetscCall(SlepcSortEigenvalues(eps->sc,eps->nconv,eps->eigr,eps->eigi,eps->perm));
   PetscCall(PetscLogEventEnd(EPS_Solve,eps,0,0,0));
+  PetscCall(SlepcPerfStatsEnd_Private(EPS_Solve,EPS_SetUp,eps->perf));
 
   /* Various viewers */
   PetscCall(EPSViewFromOptions(eps,NULL,"-eps_view"));
@@ -207,6 +262,101 @@ PetscErrorCode EPSSolve(EPS eps)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   EPSCheckpoint - Saves the current state of the solver, so that the
+   computation can be resumed later with EPSRestart().
+
+   Collective
+
+   Input Parameters:
++  eps    - the eigensolver context
+-  viewer - a binary viewer opened for writing
+
+   Notes:
+   This function must be called during EPSSolve(), typically from a monitor
+   function (see EPSMonitorSet()), which is invoked at the end of each restart
+   of the solver. The saved state includes the iteration counter, the converged
+   eigenvalues, the projected problem and the basis vectors needed to resume
+   the iteration.
+
+   The basis vectors are written one by one, so parallel MPI-IO can be used by
+   enabling it in the viewer with PetscViewerBinarySetUseMPIIO() or the option
+   -viewer_binary_mpiio.
+
+   Currently this is supported only in the Krylov-Schur solver, in the variants
+   that do not use spectrum slicing, the indefinite or the two-sided iteration.
+
+   Level: advanced
+
+.seealso: EPSRestart(), EPSMonitorSet(), EPSSolve()
+@*/
+PetscErrorCode EPSCheckpoint(EPS eps,PetscViewer viewer)
+{
+  PetscInt       header[5];
+  PetscBool      isbinary;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+  PetscCheckSameComm(eps,1,viewer,2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCheck(isbinary,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Only binary viewers are supported");
+  PetscCheck(eps->state==EPS_STATE_SETUP && eps->reason==EPS_CONVERGED_ITERATING,PetscObjectComm((PetscObject)eps),PETSC_ERR_ORDER,"EPSCheckpoint() must be called during EPSSolve()");
+  PetscCheck(eps->ops->checkpoint,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"This solver does not support checkpointing");
+  header[0] = EPS_CLASSID;
+  header[1] = eps->n;
+  header[2] = eps->ncv;
+  header[3] = eps->its;
+  header[4] = eps->nconv;
+  PetscCall(PetscViewerBinaryWrite(viewer,header,5,PETSC_INT));
+  if (eps->nconv) {
+    PetscCall(PetscViewerBinaryWrite(viewer,eps->eigr,eps->nconv,PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryWrite(viewer,eps->eigi,eps->nconv,PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryWrite(viewer,eps->errest,eps->nconv,PETSC_REAL));
+  }
+  PetscUseTypeMethod(eps,checkpoint,viewer);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSRestart - Specifies a checkpoint saved with EPSCheckpoint(), from which
+   the computation will be resumed in the next call to EPSSolve().
+
+   Collective
+
+   Input Parameters:
++  eps    - the eigensolver context
+-  viewer - a binary viewer opened for reading
+
+   Notes:
+   The eigensolver must be configured in the same way as in the run that
+   saved the checkpoint, with the same problem matrices and number of
+   column vectors. Any initial space is ignored when resuming.
+
+   The viewer is referenced by the EPS object, and it is released after
+   the state is read in EPSSolve().
+
+   Level: advanced
+
+.seealso: EPSCheckpoint(), EPSSolve()
+@*/
+PetscErrorCode EPSRestart(EPS eps,PetscViewer viewer)
+{
+  PetscBool      isbinary;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+  PetscCheckSameComm(eps,1,viewer,2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCheck(isbinary,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"Only binary viewers are supported");
+  PetscCall(PetscObjectReference((PetscObject)viewer));
+  PetscCall(PetscViewerDestroy(&eps->rstviewer));
+  eps->rstviewer = viewer;
+  if (eps->state>EPS_STATE_SETUP) eps->state = EPS_STATE_SETUP;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSGetIterationNumber - Gets the current iteration number. If the
    call to EPSSolve() is complete, then it returns the number of iterations
@@ -240,6 +390,47 @@ PetscErrorCode EPSGetIterationNumber(EPS eps,PetscInt *its)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   EPSGetPerformanceStats - Gets performance data of one phase of the last call
+   to EPSSolve().
+
+   Not Collective
+
+   Input Parameters:
++  eps - the eigensolver solver context
+-  phase - the phase of the solve, see SlepcPerfPhase
+
+   Output Parameter:
+.  info - the performance data
+
+   Notes:
+   The data is taken from the PETSc log events associated with each phase, accumulated
+   from the beginning to the end of EPSSolve() in the current logging stage. The fields
+   count, time, flops, numMessages, messageLength and numReductions of info are set,
+   the rest are zero. Note that the data include the work done by any other object
+   during that interval, and that nested phases are also included in the outer ones,
+   for instance, the matrix-vector products done within the spectral transformation.
+
+   Logging must be active, for instance with PetscLogDefaultBegin() or -log_view,
+   otherwise all data are zero.
+
+   Fortran Note:
+   This function is not available in Fortran.
+
+   Level: intermediate
+
+.seealso: EPSSolve(), SlepcPerfPhase, PetscLogEventGetPerfInfo()
+@*/
+PetscErrorCode EPSGetPerformanceStats(EPS eps,SlepcPerfPhase phase,PetscEventPerfInfo *info)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(info,3);
+  PetscCheck(phase>=0 && phase<SLEPC_PERF_NPHASES,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"Wrong value of phase");
+  *info = eps->perf[phase];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSGetConverged - Gets the number of converged eigenpairs.
 
@@ -347,7 +538,8 @@ PetscErrorCode EPSGetInvariantSubspace(EPS eps,Vec v[])
   PetscAssertPointer(v,2);
   PetscValidHeaderSpecific(*v,VEC_CLASSID,2);
   EPSCheckSolved(eps,1);
-  PetscCheck(eps->ishermitian || eps->state!=EPS_STATE_EIGENVECTORS,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONGSTATE,"EPSGetInvariantSubspace must be called before EPSGetEigenpair,EPSGetEigenvector or EPSComputeError");
+  PetscCheck(!eps->ops->geteigenvector,PetscObjectComm((PetscObject)eps),PETSC_ERR_SUP,"The invariant subspace is not available when the eigenvectors are not stored in the EPS object");
+  PetscCheck(eps->ishermitian || eps->vlazy || eps->state!=EPS_STATE_EIGENVECTORS,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONGSTATE,"EPSGetInvariantSubspace must be called before EPSGetEigenpair,EPSGetEigenvector or EPSComputeError");
   if (eps->balance!=EPS_BALANCE_NONE && eps->D) {
     PetscCall(BVDuplicateResize(eps->V,eps->nconv,&V));
     PetscCall(BVSetActiveColumns(eps->V,0,eps->nconv));
@@ -527,7 +719,9 @@ PetscErrorCode EPSGetEigenvector(EPS eps,PetscInt i,Vec Vr,Vec Vi)
   PetscCall(EPS_GetActualConverged(eps,&nconv));
   PetscCheck(i<nconv,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The index can be nconv-1 at most, see EPSGetConverged()");
   PetscCall(EPSComputeVectors(eps));
-  PetscCall(EPS_GetEigenvector(eps,eps->V,i,Vr,Vi));
+  if (eps->ops->geteigenvector) PetscUseTypeMethod(eps,geteigenvector,i,Vr,Vi);  /* eigenvector not stored in eps->V */
+  else if (eps->vlazy) PetscCall(EPSGetEigenvector_Schur(eps,i,Vr,Vi));  /* eigenvector formed on demand */
+  else PetscCall(EPS_GetEigenvector(eps,eps->V,i,Vr,Vi));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -587,7 +781,8 @@ PetscErrorCode EPSGetLeftEigenvector(EPS eps,PetscInt i,Vec Wr,Vec Wi)
 
   PetscCall(EPSComputeVectors(eps));
   if (trivial) {
-    PetscCall(EPS_GetEigenvector(eps,eps->V,i,Wr,Wi));
+    if (eps->ops->geteigenvector) PetscUseTypeMethod(eps,geteigenvector,i,Wr,Wi);
+    else PetscCall(EPS_GetEigenvector(eps,eps->V,i,Wr,Wi));
     if (eps->problem_type==EPS_BSE) {   /* change sign of bottom part of the vector */
       PetscCall(STGetMatrix(eps->st,0,&H));
       PetscCall(MatNestGetISs(H,is,NULL));
@@ -610,6 +805,140 @@ PetscErrorCode EPSGetLeftEigenvector(EPS eps,PetscInt i,Vec Wr,Vec Wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Moves the eigenvectors to the order given by the permutation, so that the
+   i-th column of V (and W) is the i-th eigenvector, and resets the permutation
+*/
+static PetscErrorCode EPSSortVectors_Private(EPS eps)
+{
+  PetscInt    i;
+  PetscBool   sorted=PETSC_TRUE;
+  PetscScalar *P,*er,*ei;
+  PetscReal   *err;
+  Mat         M;
+
+  PetscFunctionBegin;
+  for (i=0;i<eps->nconv && sorted;i++) if (eps->perm[i]!=i) sorted = PETSC_FALSE;
+  if (sorted) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,eps->nconv,eps->nconv,NULL,&M));
+  PetscCall(MatDenseGetArrayWrite(M,&P));
+  PetscCall(PetscArrayzero(P,eps->nconv*eps->nconv));
+  for (i=0;i<eps->nconv;i++) P[eps->perm[i]+i*eps->nconv] = 1.0;
+  PetscCall(MatDenseRestoreArrayWrite(M,&P));
+  PetscCall(BVMultInPlace(eps->V,M,0,eps->nconv));
+  if (eps->twosided) PetscCall(BVMultInPlace(eps->W,M,0,eps->nconv));
+  PetscCall(MatDestroy(&M));
+  PetscCall(PetscMalloc3(eps->nconv,&er,eps->nconv,&ei,eps->nconv,&err));
+  for (i=0;i<eps->nconv;i++) {
+    er[i]  = eps->eigr[eps->perm[i]];
+    ei[i]  = eps->eigi[eps->perm[i]];
+    err[i] = eps->errest[eps->perm[i]];
+  }
+  for (i=0;i<eps->nconv;i++) {
+    eps->eigr[i]   = er[i];
+    eps->eigi[i]   = ei[i];
+    eps->errest[i] = err[i];
+    eps->perm[i]   = i;
+  }
+  PetscCall(PetscFree3(er,ei,err));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSGetEigenvectorsBV - Gets a BV object that contains all the converged
+   eigenvectors computed by EPSSolve().
+
+   Collective
+
+   Input Parameter:
+.  eps - eigensolver context
+
+   Output Parameter:
+.  X - basis vectors object with the eigenvectors
+
+   Notes:
+   The i-th active column of X is the i-th eigenvector, as returned by
+   EPSGetEigenvector(), for i between 0 and nconv-1 (see EPSGetConverged()).
+   If PETSc is configured with real scalars, a complex conjugate pair of
+   eigenvectors occupies two consecutive columns, the real part and the
+   imaginary part of the eigenvector associated with the eigenvalue with
+   positive imaginary part.
+
+   Whenever possible, X is the BV that the solver uses internally, after
+   reordering its columns in place, so no copy of the eigenvectors is made.
+   This is not possible when EPSSetLazyVectors() is used, in structured
+   problems, or when the eigenvectors are not stored in the EPS object (e.g.,
+   in distributed spectrum slicing), and then X is a new BV with a copy of
+   the eigenvectors. In any case, X must be considered read-only, and it must
+   be returned with EPSRestoreEigenvectorsBV() before calling any other EPS
+   function.
+
+   The eigenvectors can be obtained as a dense matrix with BVGetMat(), for
+   instance to save all of them at once with MatView(), see also
+   EPSVectorsView().
+
+   Level: intermediate
+
+.seealso: EPSRestoreEigenvectorsBV(), EPSGetEigenvector(), EPSGetConverged(), BVGetMat()
+@*/
+PetscErrorCode EPSGetEigenvectorsBV(EPS eps,BV *X)
+{
+  PetscInt i,nconv;
+  Vec      xr,xi;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(X,2);
+  EPSCheckSolved(eps,1);
+  PetscCall(EPSComputeVectors(eps));
+  if (!eps->ops->geteigenvector && !eps->vlazy && !eps->isstructured) {
+    PetscCall(EPSSortVectors_Private(eps));
+    PetscCall(BVSetActiveColumns(eps->V,0,eps->nconv));
+    *X = eps->V;
+  } else {
+    PetscCall(EPS_GetActualConverged(eps,&nconv));
+    PetscCall(BVDuplicateResize(eps->V,nconv,X));
+    PetscCall(BVSetMatrix(*X,NULL,PETSC_FALSE));
+    for (i=0;i<nconv;i++) {
+      xi = NULL;
+      PetscCall(BVGetColumn(*X,i,&xr));
+#if !defined(PETSC_USE_COMPLEX)
+      if (eps->eigi[eps->perm[i]]>0.0) PetscCall(BVGetColumn(*X,i+1,&xi));
+#endif
+      PetscCall(EPSGetEigenvector(eps,i,xr,xi));
+      PetscCall(BVRestoreColumn(*X,i,&xr));
+      if (xi) {
+        PetscCall(BVRestoreColumn(*X,i+1,&xi));
+        i++;
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   EPSRestoreEigenvectorsBV - Returns the BV object obtained with EPSGetEigenvectorsBV().
+
+   Collective
+
+   Input Parameters:
++  eps - eigensolver context
+-  X   - basis vectors object with the eigenvectors
+
+   Level: intermediate
+
+.seealso: EPSGetEigenvectorsBV()
+@*/
+PetscErrorCode EPSRestoreEigenvectorsBV(EPS eps,BV *X)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(X,2);
+  if (*X!=eps->V) PetscCall(BVDestroy(X));
+  *X = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSGetErrorEstimate - Returns the error estimate associated to the i-th
    computed eigenpair.
@@ -674,6 +1003,9 @@ PetscErrorCode EPSComputeResidualNorm_Private(EPS eps,PetscBool trans,PetscScala
   PetscReal      ni,nr;
 #endif
   PetscErrorCode (*matmult)(Mat,Vec,Vec) = trans? MatMultHermitianTranspose: MatMult;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscErrorCode (*matmultadd)(Mat,Vec,Vec,Vec) = trans? MatMultHermitianTransposeAdd: MatMultAdd;
+#endif
 
   PetscFunctionBegin;
   u = z[0]; w = z[2];
@@ -704,19 +1036,63 @@ PetscErrorCode EPSComputeResidualNorm_Private(EPS eps,PetscBool trans,PetscScala
       else PetscCall(VecCopy(xi,w));                        /* w=B*xi */
       PetscCall(VecAXPY(u,trans?-ki:ki,w));                 /* u=A*xr-kr*B*xr+ki*B*xi */
     }
-    PetscCall(VecNorm(u,NORM_2,&nr));
-    PetscCall((*matmult)(A,xi,u));                          /* u=A*xi */
+    /* the imaginary part goes to w, so that both norms are obtained with a single reduction */
     if (SlepcAbsEigenvalue(kr,ki) > PETSC_MACHINE_EPSILON) {
-      PetscCall(VecAXPY(u,-kr,w));                          /* u=A*xi-kr*B*xi */
-      PetscCall(VecAXPY(u,trans?ki:-ki,v));                 /* u=A*xi-kr*B*xi-ki*B*xr */
-    }
-    PetscCall(VecNorm(u,NORM_2,&ni));
+      PetscCall(VecAXPBY(w,trans?ki:-ki,-kr,v));            /* w=-kr*B*xi-ki*B*xr */
+      PetscCall((*matmultadd)(A,xi,w,w));                   /* w=A*xi-kr*B*xi-ki*B*xr */
+    } else PetscCall((*matmult)(A,xi,w));                   /* w=A*xi */
+    PetscCall(VecNormBegin(u,NORM_2,&nr));
+    PetscCall(VecNormBegin(w,NORM_2,&ni));
+    PetscCall(VecNormEnd(u,NORM_2,&nr));
+    PetscCall(VecNormEnd(w,NORM_2,&ni));
     *norm = SlepcAbsEigenvalue(nr,ni);
   }
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   EPSScaleError_Private - Obtains the error of the requested type from the
+   residual norm of the eigenpair
+*/
+static PetscErrorCode EPSScaleError_Private(EPS eps,EPSErrorType type,PetscScalar kr,PetscScalar ki,PetscReal vecnorm,PetscReal *error)
+{
+  Mat       A,B;
+  PetscReal t;
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  switch (type) {
+    case EPS_ERROR_ABSOLUTE:
+      break;
+    case EPS_ERROR_RELATIVE:
+      *error /= SlepcAbsEigenvalue(kr,ki)*vecnorm;
+      break;
+    case EPS_ERROR_BACKWARD:
+      /* initialization of matrix norms */
+      if (!eps->nrma) {
+        PetscCall(STGetMatrix(eps->st,0,&A));
+        PetscCall(MatHasOperation(A,MATOP_NORM,&flg));
+        PetscCheck(flg,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
+        PetscCall(MatNorm(A,NORM_INFINITY,&eps->nrma));
+      }
+      if (eps->isgeneralized) {
+        if (!eps->nrmb) {
+          PetscCall(STGetMatrix(eps->st,1,&B));
+          PetscCall(MatHasOperation(B,MATOP_NORM,&flg));
+          PetscCheck(flg,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
+          PetscCall(MatNorm(B,NORM_INFINITY,&eps->nrmb));
+        }
+      } else eps->nrmb = 1.0;
+      t = SlepcAbsEigenvalue(kr,ki);
+      *error /= (eps->nrma+t*eps->nrmb)*vecnorm;
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    EPSComputeError - Computes the error (based on the residual norm) associated
    with the i-th computed eigenpair.
@@ -737,15 +1113,13 @@ PetscErrorCode EPSComputeResidualNorm_Private(EPS eps,PetscBool trans,PetscScala
 
    Level: beginner
 
-.seealso: EPSErrorType, EPSSolve(), EPSGetErrorEstimate()
+.seealso: EPSErrorType, EPSSolve(), EPSGetErrorEstimate(), EPSComputeErrors()
 @*/
 PetscErrorCode EPSComputeError(EPS eps,PetscInt i,EPSErrorType type,PetscReal *error)
 {
-  Mat            A,B;
   Vec            xr,xi,w[3];
-  PetscReal      t,vecnorm=1.0,errorl;
+  PetscReal      vecnorm=1.0,errorl;
   PetscScalar    kr,ki;
-  PetscBool      flg;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
@@ -783,34 +1157,157 @@ PetscErrorCode EPSComputeError(EPS eps,PetscInt i,EPSErrorType type,PetscReal *e
   }
 
   /* compute error */
-  switch (type) {
-    case EPS_ERROR_ABSOLUTE:
-      break;
-    case EPS_ERROR_RELATIVE:
-      *error /= SlepcAbsEigenvalue(kr,ki)*vecnorm;
-      break;
-    case EPS_ERROR_BACKWARD:
-      /* initialization of matrix norms */
-      if (!eps->nrma) {
-        PetscCall(STGetMatrix(eps->st,0,&A));
-        PetscCall(MatHasOperation(A,MATOP_NORM,&flg));
-        PetscCheck(flg,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
-        PetscCall(MatNorm(A,NORM_INFINITY,&eps->nrma));
+  PetscCall(EPSScaleError_Private(eps,type,kr,ki,vecnorm,error));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* maximum number of eigenpairs whose residuals are computed together in EPSComputeErrors() */
+#define EPS_ERROR_PANEL 16
+
+/*@
+   EPSComputeErrors - Computes the errors (based on the residual norm) associated
+   with a range of computed eigenpairs.
+
+   Collective
+
+   Input Parameters:
++  eps  - the eigensolver context
+.  i0   - index of the first solution
+.  i1   - index after the last solution
+-  type - the type of error to compute
+
+   Output Parameter:
+.  errors - array of length i1-i0 with the errors
+
+   Notes:
+   The result is the same as calling EPSComputeError() for each index i0<=i<i1,
+   but the residuals are computed for several eigenpairs at once, multiplying
+   the matrices by a block of eigenvectors (in a single sparse matrix-matrix
+   product if the matrix type supports it). This is more efficient when many
+   eigenpairs have been computed.
+
+   When only an estimate is needed, the error estimates provided by the solver
+   during the iteration, see EPSGetErrorEstimate(), do not require any
+   additional computation. In Krylov methods, they are obtained from the
+   residual of the Krylov decomposition.
+
+   Level: intermediate
+
+.seealso: EPSComputeError(), EPSErrorType, EPSGetErrorEstimate()
+@*/
+PetscErrorCode EPSComputeErrors(EPS eps,PetscInt i0,PetscInt i1,EPSErrorType type,PetscReal *errors)
+{
+  PetscInt    i,j,p,q,nc,nmat,nconv,col[EPS_ERROR_PANEL];
+  PetscScalar kr[EPS_ERROR_PANEL],ki[EPS_ERROR_PANEL];
+  PetscReal   vecnorm=1.0;
+  BV          X,AX,BX=NULL,Y;
+  Mat         A,B=NULL;
+  Vec         xr,xi=NULL,u,y;
+#if !defined(PETSC_USE_COMPLEX)
+  Vec         w,z;
+  PetscReal   nr,ni;
+#endif
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(eps,i0,2);
+  PetscValidLogicalCollectiveInt(eps,i1,3);
+  PetscValidLogicalCollectiveEnum(eps,type,4);
+  EPSCheckSolved(eps,1);
+  PetscCall(EPS_GetActualConverged(eps,&nconv));
+  PetscCheck(i0>=0 && i0<=i1 && i1<=nconv,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"The indices must satisfy 0<=i0<=i1<=nconv");
+  if (i0==i1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(errors,5);
+
+  /* the left residuals are computed one by one */
+  if (eps->twosided) {
+    for (i=i0;i<i1;i++) PetscCall(EPSComputeError(eps,i,type,errors+i-i0));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall(STGetNumMatrices(eps->st,&nmat));
+  PetscCall(STGetMatrix(eps->st,0,&A));
+  if (nmat>1) PetscCall(STGetMatrix(eps->st,1,&B));
+  PetscCall(BVDuplicateResize(eps->V,2*EPS_ERROR_PANEL,&X));
+  PetscCall(BVSetMatrix(X,NULL,PETSC_FALSE));
+  PetscCall(BVDuplicate(X,&AX));
+  if (nmat>1) PetscCall(BVDuplicate(X,&BX));
+  Y = (nmat>1)? BX: X;
+
+  for (p=i0;p<i1;p+=EPS_ERROR_PANEL) {
+    /* copy the eigenvectors of the panel, two columns for complex conjugate pairs */
+    q  = PetscMin(EPS_ERROR_PANEL,i1-p);
+    nc = 0;
+    for (i=0;i<q;i++) {
+      col[i] = nc;
+      PetscCall(EPSGetEigenvalue(eps,p+i,kr+i,ki+i));
+      PetscCall(BVGetColumn(X,nc,&xr));
+#if !defined(PETSC_USE_COMPLEX)
+      if (ki[i]!=0.0) PetscCall(BVGetColumn(X,nc+1,&xi));
+#endif
+      PetscCall(EPSGetEigenvector(eps,p+i,xr,xi));
+      PetscCall(BVRestoreColumn(X,nc,&xr));
+      nc++;
+#if !defined(PETSC_USE_COMPLEX)
+      if (ki[i]!=0.0) {
+        PetscCall(BVRestoreColumn(X,nc,&xi));
+        xi = NULL;
+        nc++;
       }
-      if (eps->isgeneralized) {
-        if (!eps->nrmb) {
-          PetscCall(STGetMatrix(eps->st,1,&B));
-          PetscCall(MatHasOperation(B,MATOP_NORM,&flg));
-          PetscCheck(flg,PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
-          PetscCall(MatNorm(B,NORM_INFINITY,&eps->nrmb));
+#endif
+    }
+
+    /* multiply all of them at once */
+    PetscCall(BVSetActiveColumns(X,0,nc));
+    PetscCall(BVSetActiveColumns(AX,0,nc));
+    PetscCall(BVMatMult(X,A,AX));
+    if (nmat>1) {
+      PetscCall(BVSetActiveColumns(BX,0,nc));
+      PetscCall(BVMatMult(X,B,BX));
+    }
+
+    /* residual norms, see EPSComputeResidualNorm_Private() */
+    for (i=0;i<q;i++) {
+      j = col[i];
+      if (eps->problem_type==EPS_GHEP) PetscCall(BVNormColumn(X,j,NORM_2,&vecnorm));
+#if !defined(PETSC_USE_COMPLEX)
+      if (ki[i] == 0 || PetscAbsScalar(ki[i]) < PetscAbsScalar(kr[i]*PETSC_MACHINE_EPSILON)) {
+#endif
+        PetscCall(BVGetColumn(AX,j,&u));
+        if (PetscAbsScalar(kr[i]) > PETSC_MACHINE_EPSILON) {
+          PetscCall(BVGetColumn(Y,j,&y));
+          PetscCall(VecAXPY(u,-kr[i],y));                   /* u=A*x-k*B*x */
+          PetscCall(BVRestoreColumn(Y,j,&y));
         }
-      } else eps->nrmb = 1.0;
-      t = SlepcAbsEigenvalue(kr,ki);
-      *error /= (eps->nrma+t*eps->nrmb)*vecnorm;
-      break;
-    default:
-      SETERRQ(PetscObjectComm((PetscObject)eps),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+        PetscCall(VecNorm(u,NORM_2,errors+p+i-i0));
+        PetscCall(BVRestoreColumn(AX,j,&u));
+#if !defined(PETSC_USE_COMPLEX)
+      } else {
+        PetscCall(BVGetColumn(AX,j,&u));
+        PetscCall(BVGetColumn(AX,j+1,&w));
+        if (SlepcAbsEigenvalue(kr[i],ki[i]) > PETSC_MACHINE_EPSILON) {
+          PetscCall(BVGetColumn(Y,j,&y));
+          PetscCall(BVGetColumn(Y,j+1,&z));
+          PetscCall(VecAXPY(u,-kr[i],y));                   /* u=A*xr-kr*B*xr */
+          PetscCall(VecAXPY(u,ki[i],z));                    /* u=A*xr-kr*B*xr+ki*B*xi */
+          PetscCall(VecAXPY(w,-kr[i],z));                   /* w=A*xi-kr*B*xi */
+          PetscCall(VecAXPY(w,-ki[i],y));                   /* w=A*xi-kr*B*xi-ki*B*xr */
+          PetscCall(BVRestoreColumn(Y,j+1,&z));
+          PetscCall(BVRestoreColumn(Y,j,&y));
+        }
+        PetscCall(VecNorm(u,NORM_2,&nr));
+        PetscCall(VecNorm(w,NORM_2,&ni));
+        PetscCall(BVRestoreColumn(AX,j+1,&w));
+        PetscCall(BVRestoreColumn(AX,j,&u));
+        errors[p+i-i0] = SlepcAbsEigenvalue(nr,ni);
+      }
+#endif
+      PetscCall(EPSScaleError_Private(eps,type,kr[i],ki[i],vecnorm,errors+p+i-i0));
+    }
   }
+  PetscCall(BVDestroy(&X));
+  PetscCall(BVDestroy(&AX));
+  PetscCall(BVDestroy(&BX));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -150,6 +150,8 @@ PetscErrorCode EPSView(EPS eps,PetscViewer viewer)
     if (eps->purify) PetscCall(PetscViewerASCIIPrintf(viewer,"  postprocessing eigenvectors with purification\n"));
     if (eps->trueres) PetscCall(PetscViewerASCIIPrintf(viewer,"  computing true residuals explicitly\n"));
     if (eps->trackall) PetscCall(PetscViewerASCIIPrintf(viewer,"  computing all residuals (for tracking convergence)\n"));
+    if (eps->warmstart) PetscCall(PetscViewerASCIIPrintf(viewer,"  starting from the subspace of the previous solve\n"));
+    if (eps->lazyvecs) PetscCall(PetscViewerASCIIPrintf(viewer,"  forming eigenvectors only when requested\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  number of eigenvalues (nev): %" PetscInt_FMT "\n",eps->nev));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  number of column vectors (ncv): %" PetscInt_FMT "\n",eps->ncv));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  maximum dimension of projected problem (mpd): %" PetscInt_FMT "\n",eps->mpd));
@@ -175,6 +177,7 @@ PetscErrorCode EPSView(EPS eps,PetscViewer viewer)
     if (eps->nini) PetscCall(PetscViewerASCIIPrintf(viewer,"  dimension of user-provided initial space: %" PetscInt_FMT "\n",PetscAbs(eps->nini)));
     if (eps->ninil) PetscCall(PetscViewerASCIIPrintf(viewer,"  dimension of user-provided left initial space: %" PetscInt_FMT "\n",PetscAbs(eps->ninil)));
     if (eps->nds) PetscCall(PetscViewerASCIIPrintf(viewer,"  dimension of user-provided deflation space: %" PetscInt_FMT "\n",PetscAbs(eps->nds)));
+    if (eps->state>=EPS_STATE_SOLVED) PetscCall(SlepcPerfStatsView_Private(eps->perf,eps->its,viewer));
   } else PetscTryTypeMethod(eps,view,viewer);
   PetscCall(PetscObjectTypeCompareAny((PetscObject)eps,&isexternal,EPSARPACK,EPSBLOPEX,EPSELEMENTAL,EPSFEAST,EPSPRIMME,EPSSCALAPACK,EPSELPA,EPSEVSL,EPSTRLAN,""));
   if (!isexternal) {
@@ -296,7 +299,7 @@ PetscErrorCode EPSConvergedReasonViewFromOptions(EPS eps)
 
 static PetscErrorCode EPSErrorView_ASCII(EPS eps,EPSErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error;
+  PetscReal      *error;
   PetscScalar    kr,ki;
   PetscInt       i,j,nvals,nconv;
 
@@ -311,13 +314,16 @@ static PetscErrorCode EPSErrorView_ASCII(EPS eps,EPSErrorType etype,PetscViewer
     PetscCall(PetscViewerASCIIPrintf(viewer," No eigenvalues have been found\n\n"));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+  PetscCall(PetscMalloc1(nvals,&error));
+  PetscCall(EPSComputeErrors(eps,0,nvals,etype,error));
   for (i=0;i<nvals;i++) {
-    PetscCall(EPSComputeError(eps,i,etype,&error));
-    if (error>=5.0*eps->tol) {
+    if (error[i]>=5.0*eps->tol) {
       PetscCall(PetscViewerASCIIPrintf(viewer," Problem: some of the first %" PetscInt_FMT " relative errors are higher than the tolerance\n\n",nvals));
+      PetscCall(PetscFree(error));
       PetscFunctionReturn(PETSC_SUCCESS);
     }
   }
+  PetscCall(PetscFree(error));
   if (eps->which==EPS_ALL) PetscCall(PetscViewerASCIIPrintf(viewer," Found %" PetscInt_FMT " eigenvalues, all of them computed up to the required tolerance:",nvals));
   else PetscCall(PetscViewerASCIIPrintf(viewer," All requested eigenvalues computed up to the required tolerance:"));
   for (i=0;i<=(nvals-1)/8;i++) {
@@ -334,7 +340,7 @@ static PetscErrorCode EPSErrorView_ASCII(EPS eps,EPSErrorType etype,PetscViewer
 
 static PetscErrorCode EPSErrorView_DETAIL(EPS eps,EPSErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error,re,im;
+  PetscReal      *error,re,im;
   PetscScalar    kr,ki;
   PetscInt       i,nconv;
   char           ex[30],sep[]=" ---------------------- --------------------\n";
@@ -354,9 +360,10 @@ static PetscErrorCode EPSErrorView_DETAIL(EPS eps,EPSErrorType etype,PetscViewer
   }
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s            k             %s\n%s",sep,ex,sep));
   PetscCall(EPS_GetActualConverged(eps,&nconv));
+  PetscCall(PetscMalloc1(nconv,&error));
+  PetscCall(EPSComputeErrors(eps,0,nconv,etype,error));
   for (i=0;i<nconv;i++) {
     PetscCall(EPSGetEigenvalue(eps,i,&kr,&ki));
-    PetscCall(EPSComputeError(eps,i,etype,&error));
 #if defined(PETSC_USE_COMPLEX)
     re = PetscRealPart(kr);
     im = PetscImaginaryPart(kr);
@@ -364,16 +371,17 @@ static PetscErrorCode EPSErrorView_DETAIL(EPS eps,EPSErrorType etype,PetscViewer
     re = kr;
     im = ki;
 #endif
-    if (im!=0.0) PetscCall(PetscViewerASCIIPrintf(viewer,"  % 9f%+9fi      %12g\n",(double)re,(double)im,(double)error));
-    else PetscCall(PetscViewerASCIIPrintf(viewer,"    % 12f           %12g\n",(double)re,(double)error));
+    if (im!=0.0) PetscCall(PetscViewerASCIIPrintf(viewer,"  % 9f%+9fi      %12g\n",(double)re,(double)im,(double)error[i]));
+    else PetscCall(PetscViewerASCIIPrintf(viewer,"    % 12f           %12g\n",(double)re,(double)error[i]));
   }
+  PetscCall(PetscFree(error));
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s",sep));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode EPSErrorView_MATLAB(EPS eps,EPSErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error;
+  PetscReal      *error;
   PetscInt       i,nconv;
   const char     *name;
 
@@ -381,10 +389,10 @@ static PetscErrorCode EPSErrorView_MATLAB(EPS eps,EPSErrorType etype,PetscViewer
   PetscCall(PetscObjectGetName((PetscObject)eps,&name));
   PetscCall(PetscViewerASCIIPrintf(viewer,"Error_%s = [\n",name));
   PetscCall(EPS_GetActualConverged(eps,&nconv));
-  for (i=0;i<nconv;i++) {
-    PetscCall(EPSComputeError(eps,i,etype,&error));
-    PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)error));
-  }
+  PetscCall(PetscMalloc1(nconv,&error));
+  PetscCall(EPSComputeErrors(eps,0,nconv,etype,error));
+  for (i=0;i<nconv;i++) PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)error[i]));
+  PetscCall(PetscFree(error));
   PetscCall(PetscViewerASCIIPrintf(viewer,"];\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -759,14 +767,27 @@ PetscErrorCode EPSValuesViewFromOptions(EPS eps)
    and left eigenvectors are interleaved, that is, the vectors are output in
    the following order X0, Y0, X1, Y1, X2, Y2, ...
 
+   With a binary or HDF5 viewer in PETSC_VIEWER_NATIVE format, e.g.,
+   -eps_view_vectors binary:evecs.bin:native, the right eigenvectors are
+   written at once as the columns of a single dense matrix named X, see
+   EPSGetEigenvectorsBV(), which can be read with MatLoad(). The left
+   eigenvectors, if any, are written afterwards as a matrix named Y.
+   This avoids a separate write for each vector, and the write is done with
+   collective MPI-IO if the viewer is set up for that (-viewer_binary_mpiio), or
+   with parallel HDF5.
+
    Level: intermediate
 
-.seealso: EPSSolve(), EPSValuesView(), EPSErrorView()
+.seealso: EPSSolve(), EPSValuesView(), EPSErrorView(), EPSGetEigenvectorsBV()
 @*/
 PetscErrorCode EPSVectorsView(EPS eps,PetscViewer viewer)
 {
-  PetscInt       i,nconv;
-  Vec            xr,xi=NULL;
+  PetscInt          i,nconv;
+  Vec               xr,xi=NULL;
+  PetscBool         isbinary,ishdf5;
+  PetscViewerFormat format;
+  BV                X;
+  Mat               M;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
@@ -775,7 +796,25 @@ PetscErrorCode EPSVectorsView(EPS eps,PetscViewer viewer)
   PetscCheckSameComm(eps,1,viewer,2);
   EPSCheckSolved(eps,1);
   PetscCall(EPS_GetActualConverged(eps,&nconv));
-  if (nconv) {
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERHDF5,&ishdf5));
+  PetscCall(PetscViewerGetFormat(viewer,&format));
+  if (nconv && (isbinary || ishdf5) && format==PETSC_VIEWER_NATIVE) {
+    /* all eigenvectors at once, as the columns of a dense matrix */
+    PetscCall(EPSGetEigenvectorsBV(eps,&X));
+    PetscCall(BVGetMat(X,&M));
+    PetscCall(PetscObjectSetName((PetscObject)M,"X"));
+    PetscCall(MatView(M,viewer));
+    PetscCall(BVRestoreMat(X,&M));
+    PetscCall(EPSRestoreEigenvectorsBV(eps,&X));
+    if (eps->twosided) {
+      PetscCall(BVSetActiveColumns(eps->W,0,eps->nconv));
+      PetscCall(BVGetMat(eps->W,&M));
+      PetscCall(PetscObjectSetName((PetscObject)M,"Y"));
+      PetscCall(MatView(M,viewer));
+      PetscCall(BVRestoreMat(eps->W,&M));
+    }
+  } else if (nconv) {
     PetscCall(BVCreateVec(eps->V,&xr));
 #if !defined(PETSC_USE_COMPLEX)
     PetscCall(BVCreateVec(eps->V,&xi));
@@ -829,3 +868,51 @@ PetscErrorCode EPSVectorsViewFromOptions(EPS eps)
   incall = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+   EPSSaveSolution - Saves the computed eigenvalues, error estimates and eigenvectors
+   in a single file, that can be loaded with SlepcLoadSolution().
+
+   Collective
+
+   Input Parameters:
++  eps      - the eigensolver context
+-  filename - name of the file
+
+   Notes:
+   The eigenvectors are stored as the columns of a BV, in the same way as in
+   EPSGetEigenvectorsBV(). When loading the file, the eigenvectors are not read
+   but mapped to memory, see BVMmapSetFile(), so this is an efficient way of
+   keeping a large number of eigenvectors for later use, e.g., for restarting a
+   computation or for postprocessing.
+
+   The file is written in the native binary representation of the machine, see
+   SlepcLoadSolution() for the restrictions that this imposes.
+
+   Level: intermediate
+
+.seealso: SlepcLoadSolution(), EPSGetEigenvectorsBV(), EPSVectorsView()
+@*/
+PetscErrorCode EPSSaveSolution(EPS eps,const char filename[])
+{
+  PetscInt       i,nconv;
+  PetscScalar    *eigr,*eigi;
+  PetscReal      *errest;
+  BV             X;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(eps,EPS_CLASSID,1);
+  PetscAssertPointer(filename,2);
+  EPSCheckSolved(eps,1);
+  PetscCall(EPSGetConverged(eps,&nconv));
+  PetscCall(PetscMalloc3(nconv,&eigr,nconv,&eigi,nconv,&errest));
+  for (i=0;i<nconv;i++) {
+    PetscCall(EPSGetEigenvalue(eps,i,&eigr[i],&eigi[i]));
+    PetscCall(EPSGetErrorEstimate(eps,i,&errest[i]));
+  }
+  PetscCall(EPSGetEigenvectorsBV(eps,&X));
+  PetscCall(SlepcSolutionSave_Private((PetscObject)eps,filename,nconv,eigr,eigi,errest,1,&X));
+  PetscCall(EPSRestoreEigenvectorsBV(eps,&X));
+  PetscCall(PetscFree3(eigr,eigi,errest));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
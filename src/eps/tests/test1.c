@@ -134,6 +134,9 @@ int main(int argc,char **argv)
       test:
          suffix: 1_ks_sinvert
          args: -st_type sinvert -eps_target 22
+      test:
+         suffix: 1_ks_sinvert_refine
+         args: -st_type sinvert -eps_target 22 -st_sinvert_refine_its 2
       test:
          suffix: 1_ks_cayley
          args: -st_type cayley -eps_target 22
@@ -149,6 +152,9 @@ int main(int argc,char **argv)
       test:
          suffix: 1_jd_borth
          args: -eps_type jd -eps_jd_borth
+      test:
+         suffix: 1_xd_deflation
+         args: -eps_type {{gd jd}} -st_precond_deflation
       test:
          suffix: 1_lobpcg
          args: -eps_type lobpcg -st_shift 22 -eps_largest_real
@@ -217,10 +223,15 @@ int main(int argc,char **argv)
          args: -eps_interval .1,1.1 -eps_krylovschur_partitions 2 -st_pc_factor_mat_solver_type mumps -st_mat_mumps_icntl_13 1
          output_file: output/test1_2.out
 
-   test:
-      suffix: 3
+   testset:
       requires: !single
       args: -n 18 -eps_type power -eps_conv_rel -eps_nev 3
+      output_file: output/test1_3.out
+      test:
+         suffix: 3
+      test:
+         suffix: 3_block
+         args: -eps_power_blocksize 3
 
    test:
       suffix: 4
@@ -236,6 +247,9 @@ int main(int argc,char **argv)
       test:
          suffix: 5_lobpcg
          args: -eps_type lobpcg -eps_lobpcg_blocksize 3
+      test:
+         suffix: 5_subspace_chebyshev
+         args: -eps_type subspace -eps_subspace_chebyshev
       test:
          suffix: 5_hpddm
          args: -eps_type lobpcg -eps_lobpcg_blocksize 3 -st_pc_type lu -st_ksp_type hpddm
@@ -302,6 +316,9 @@ int main(int argc,char **argv)
       test:
          suffix: 9_ks_gnhep
          args: -eps_gen_non_hermitian -st_pc_type redundant -st_type sinvert
+      test:
+         suffix: 9_ks_gnhep_lazy
+         args: -eps_gen_non_hermitian -st_pc_type redundant -st_type sinvert -eps_lazy_vectors
       test:
          suffix: 9_ks_ghiep
          args: -eps_gen_indefinite -st_pc_type redundant -st_type sinvert
@@ -311,6 +328,11 @@ int main(int argc,char **argv)
          args: -eps_gen_hermitian -eps_type lobpcg -eps_max_it 200 -eps_lobpcg_blocksize 6
          requires: !single
          timeoutfactor: 2
+      test:
+         suffix: 9_lobpcg_ghep_lowmem
+         args: -eps_gen_hermitian -eps_type lobpcg -eps_max_it 200 -eps_lobpcg_blocksize 6 -eps_lobpcg_low_memory
+         requires: !single
+         timeoutfactor: 2
       test:
          suffix: 9_jd_gnhep
          args: -eps_gen_non_hermitian -eps_type jd -eps_target 0 -eps_ncv 64
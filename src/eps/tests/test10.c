@@ -129,5 +129,8 @@ int main (int argc,char **argv)
       test:
          suffix: 1_gd2
          args: -eps_type gd -eps_gd_double_expansion
+      test:
+         suffix: 1_ks_block
+         args: -eps_type krylovschur -eps_krylovschur_blocksize 3 -bv_orthog_block {{gs chol}}
 
 TEST*/
@@ -128,6 +128,10 @@ int main(int argc,char **argv)
          suffix: 2
          args: -st_type filter -st_filter_degree 150 -eps_nev 1
          requires: !single
+      test:
+         suffix: 2_chebyshev
+         args: -eps_type {{krylovschur subspace}} -st_type filter -st_filter_type chebyshev -eps_nev 1
+         requires: !single
       test:
          suffix: 2_evsl
          nsize: {{1 2}}
@@ -134,6 +134,18 @@ int main(int argc,char **argv)
       test:
          suffix: 5_redundant
          args: -st_pc_type redundant -st_redundant_pc_type cholesky
+      test:
+         suffix: 5_dynamic
+         args: -st_pc_type redundant -st_redundant_pc_type cholesky -eps_krylovschur_dynamic_balance
+      test:
+         suffix: 5_samples
+         args: -st_pc_type redundant -st_redundant_pc_type cholesky -eps_krylovschur_inertia_samples 8
+      test:
+         suffix: 5_distributed
+         args: -st_pc_type redundant -st_redundant_pc_type cholesky -eps_krylovschur_distributed_vectors
+      test:
+         suffix: 5_node
+         args: -st_pc_type redundant -st_redundant_pc_type cholesky -eps_krylovschur_partitions_node_aware
       test:
          suffix: 5_mumps
          requires: mumps !complex
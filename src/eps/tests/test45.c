@@ -0,0 +1,161 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test EPSCheckpoint() and EPSRestart() in Krylov-Schur.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n"
+  "  -ckit <ckit>, where <ckit> = iteration at which the checkpoint is saved.\n"
+  "  -nonsym, to use a nonsymmetric tridiagonal matrix.\n\n";
+
+#include <slepceps.h>
+
+typedef struct {
+  PetscInt  ckit;     /* iteration at which the checkpoint is saved */
+  PetscBool saved;
+  char      filename[PETSC_MAX_PATH_LEN];
+} CkptCtx;
+
+/*
+   Open a binary viewer, honoring options such as -viewer_binary_mpiio
+*/
+PetscErrorCode OpenBinaryViewer(MPI_Comm comm,const char *name,PetscFileMode mode,PetscViewer *viewer)
+{
+  PetscFunctionBeginUser;
+  PetscCall(PetscViewerCreate(comm,viewer));
+  PetscCall(PetscViewerSetType(*viewer,PETSCVIEWERBINARY));
+  PetscCall(PetscViewerFileSetMode(*viewer,mode));
+  PetscCall(PetscViewerSetFromOptions(*viewer));
+  PetscCall(PetscViewerFileSetName(*viewer,name));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Monitor that saves the state of the solver at the given iteration
+*/
+PetscErrorCode MonitorCheckpoint(EPS eps,PetscInt its,PetscInt nconv,PetscScalar *eigr,PetscScalar *eigi,PetscReal *errest,PetscInt nest,void *ctx)
+{
+  CkptCtx            *ck = (CkptCtx*)ctx;
+  PetscViewer        viewer;
+  EPSConvergedReason reason;
+
+  PetscFunctionBeginUser;
+  PetscCall(EPSGetConvergedReason(eps,&reason));
+  if (its==ck->ckit && reason==EPS_CONVERGED_ITERATING) {
+    PetscCall(OpenBinaryViewer(PetscObjectComm((PetscObject)eps),ck->filename,FILE_MODE_WRITE,&viewer));
+    PetscCall(EPSCheckpoint(eps,viewer));
+    PetscCall(PetscViewerDestroy(&viewer));
+    ck->saved = PETSC_TRUE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  EPS            eps;
+  PetscViewer    viewer;
+  CkptCtx        ck;
+  PetscScalar    *eigs,kr;
+  PetscReal      error=0.0;
+  PetscInt       n=200,i,Istart,Iend,nconv,nconv1,its,its1;
+  PetscBool      nonsym;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  ck.ckit  = 3;
+  ck.saved = PETSC_FALSE;
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-ckit",&ck.ckit,NULL));
+  PetscCall(PetscStrncpy(ck.filename,"checkpoint.dat",sizeof(ck.filename)));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-nonsym",&nonsym));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n%s tridiagonal eigenproblem, n=%" PetscInt_FMT "\n\n",nonsym?"Nonsymmetric":"Symmetric",n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,nonsym?-0.5:-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  /* first run, saving a checkpoint */
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,nonsym?EPS_NHEP:EPS_HEP));
+  PetscCall(EPSSetType(eps,EPSKRYLOVSCHUR));
+  PetscCall(EPSSetDimensions(eps,4,12,PETSC_DETERMINE));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(EPSMonitorSet(eps,MonitorCheckpoint,&ck,NULL));
+  PetscCall(EPSSolve(eps));
+  PetscCheck(ck.saved,PETSC_COMM_WORLD,PETSC_ERR_USER,"The solver converged before saving the checkpoint, use a smaller -ckit");
+  PetscCall(EPSGetIterationNumber(eps,&its1));
+  PetscCall(EPSGetConverged(eps,&nconv1));
+  PetscCall(PetscMalloc1(nconv1,&eigs));
+  for (i=0;i<nconv1;i++) PetscCall(EPSGetEigenvalue(eps,i,&eigs[i],NULL));
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Checkpoint saved at iteration %" PetscInt_FMT "\n",ck.ckit));
+
+  /* second run, resuming from the checkpoint */
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,nonsym?EPS_NHEP:EPS_HEP));
+  PetscCall(EPSSetType(eps,EPSKRYLOVSCHUR));
+  PetscCall(EPSSetDimensions(eps,4,12,PETSC_DETERMINE));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(OpenBinaryViewer(PETSC_COMM_WORLD,ck.filename,FILE_MODE_READ,&viewer));
+  PetscCall(EPSRestart(eps,viewer));
+  PetscCall(PetscViewerDestroy(&viewer));
+  PetscCall(EPSSolve(eps));
+  PetscCall(EPSGetIterationNumber(eps,&its));
+  PetscCall(EPSGetConverged(eps,&nconv));
+
+  /* compare both runs */
+  if (its==its1 && nconv==nconv1) {
+    for (i=0;i<nconv;i++) {
+      PetscCall(EPSGetEigenvalue(eps,i,&kr,NULL));
+      error = PetscMax(error,PetscAbsScalar(kr-eigs[i]));
+    }
+    if (error<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The restarted run reproduces the original one\n"));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Difference in the eigenvalues: %g\n",(double)error));
+  } else PetscCall(PetscPrintf(PETSC_COMM_WORLD," The restarted run differs: its=%" PetscInt_FMT " nconv=%" PetscInt_FMT " (original its=%" PetscInt_FMT " nconv=%" PetscInt_FMT ")\n",its,nconv,its1,nconv1));
+
+  PetscCall(PetscFree(eigs));
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test45_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_nolock
+         args: -eps_krylovschur_locking 0
+      test:
+         suffix: 1_mpiio
+         nsize: 2
+         args: -viewer_binary_mpiio
+         requires: defined(PETSC_HAVE_MPIIO)
+
+   test:
+      suffix: 2
+      args: -nonsym -eps_largest_real
+      requires: !single
+
+TEST*/
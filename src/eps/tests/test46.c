@@ -0,0 +1,127 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test EPSSetWarmStart() in a sequence of slowly varying problems.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n"
+  "  -steps <steps>, where <steps> = number of problems in the sequence.\n"
+  "  -nonsym, to use a nonsymmetric tridiagonal matrix.\n\n";
+
+#include <slepceps.h>
+
+/*
+   Fills the tridiagonal matrix of step t, with a diagonal that varies slightly with t
+*/
+PetscErrorCode FillMatrix(Mat A,PetscInt t,PetscBool nonsym)
+{
+  PetscInt i,n,Istart,Iend;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetSize(A,&n,NULL));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,nonsym?-0.5:-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0+0.001*t*i/n,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  EPS            eps,epsw;
+  PetscScalar    kr,kw;
+  PetscReal      error;
+  PetscInt       n=200,steps=3,t,i,nconv,nconvw,its,itsw;
+  PetscBool      nonsym,warm;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-steps",&steps,NULL));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-nonsym",&nonsym));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n%s tridiagonal eigenproblems, n=%" PetscInt_FMT ", steps=%" PetscInt_FMT "\n\n",nonsym?"Nonsymmetric":"Symmetric",n,steps));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(FillMatrix(A,0,nonsym));
+
+  /* two solvers with the same settings, only the second one reuses the previous subspace */
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&epsw));
+  PetscCall(EPSSetOptionsPrefix(epsw,"w_"));
+  PetscCall(EPSSetWarmStart(epsw,PETSC_TRUE));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetOperators(epsw,A,NULL));
+  PetscCall(EPSSetProblemType(eps,nonsym?EPS_NHEP:EPS_HEP));
+  PetscCall(EPSSetProblemType(epsw,nonsym?EPS_NHEP:EPS_HEP));
+  PetscCall(EPSSetType(eps,EPSKRYLOVSCHUR));
+  PetscCall(EPSSetType(epsw,EPSKRYLOVSCHUR));
+  PetscCall(EPSSetDimensions(eps,4,12,PETSC_DETERMINE));
+  PetscCall(EPSSetDimensions(epsw,4,12,PETSC_DETERMINE));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(EPSSetFromOptions(epsw));
+  PetscCall(EPSGetWarmStart(epsw,&warm));
+  PetscCheck(warm,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Warm start has not been activated");
+
+  for (t=0;t<steps;t++) {
+    if (t) {
+      PetscCall(FillMatrix(A,t,nonsym));
+      PetscCall(EPSSetOperators(eps,A,NULL));
+      PetscCall(EPSSetOperators(epsw,A,NULL));
+    }
+    PetscCall(EPSSolve(eps));
+    PetscCall(EPSSolve(epsw));
+    PetscCall(EPSGetIterationNumber(eps,&its));
+    PetscCall(EPSGetIterationNumber(epsw,&itsw));
+    PetscCall(EPSGetConverged(eps,&nconv));
+    PetscCall(EPSGetConverged(epsw,&nconvw));
+
+    /* compare the wanted eigenvalues computed by both solvers */
+    error = 0.0;
+    for (i=0;i<4 && i<nconv && i<nconvw;i++) {
+      PetscCall(EPSGetEigenvalue(eps,i,&kr,NULL));
+      PetscCall(EPSGetEigenvalue(epsw,i,&kw,NULL));
+      error = PetscMax(error,PetscAbsScalar(kr-kw)/PetscAbsScalar(kr));
+    }
+    if (nconv<4 || nconvw<4) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Step %" PetscInt_FMT ": not enough converged eigenpairs\n",t));
+    else if (error>1e-6) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Step %" PetscInt_FMT ": difference in the eigenvalues %g\n",t,(double)error));
+    else if (itsw>its) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Step %" PetscInt_FMT ": the warm start needs more iterations (%" PetscInt_FMT " > %" PetscInt_FMT ")\n",t,itsw,its));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Step %" PetscInt_FMT ": same eigenvalues, the warm start does not need more iterations\n",t));
+  }
+
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(EPSDestroy(&epsw));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test46_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_nolock
+         args: -eps_krylovschur_locking 0 -w_eps_krylovschur_locking 0
+
+   test:
+      suffix: 2
+      args: -nonsym -eps_largest_real -w_eps_largest_real
+      requires: !single
+
+TEST*/
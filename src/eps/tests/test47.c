@@ -0,0 +1,121 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test EPSSolveBatch() with a collection of tridiagonal problems.\n\n"
+  "The command line options are:\n"
+  "  -nprob <nprob>, where <nprob> = number of problems.\n"
+  "  -npart <npart>, where <npart> = number of partitions.\n\n";
+
+#include <slepceps.h>
+
+typedef struct {
+  PetscReal *lambda;  /* largest eigenvalue computed for each problem */
+} BatchCtx;
+
+/*
+   Problem i is the tridiagonal matrix tridiag(-1,2+0.1*i,-1) of order 50+10*i
+*/
+PetscErrorCode GetOperators(EPS eps,PetscInt i,Mat *A,Mat *B,void *ctx)
+{
+  PetscInt j,n=50+10*i,Istart,Iend;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)eps),A));
+  PetscCall(MatSetSizes(*A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(MatGetOwnershipRange(*A,&Istart,&Iend));
+  for (j=Istart;j<Iend;j++) {
+    if (j>0) PetscCall(MatSetValue(*A,j,j-1,-1.0,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(*A,j,j+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(*A,j,j,2.0+0.1*i,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY));
+  *B = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Stores the largest eigenvalue, only in the first process of each partition
+*/
+PetscErrorCode GetResult(EPS eps,PetscInt i,void *ctx)
+{
+  BatchCtx    *user = (BatchCtx*)ctx;
+  PetscScalar kr;
+  PetscInt    nconv;
+  PetscMPIInt rank;
+
+  PetscFunctionBeginUser;
+  PetscCall(EPSGetConverged(eps,&nconv));
+  PetscCheck(nconv>0,PetscObjectComm((PetscObject)eps),PETSC_ERR_NOT_CONVERGED,"Problem %" PetscInt_FMT " did not converge",i);
+  PetscCall(EPSGetEigenvalue(eps,0,&kr,NULL));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)eps),&rank));
+  if (!rank) user->lambda[i] = PetscRealPart(kr);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  EPS         eps;
+  BatchCtx    user;
+  PetscInt    i,nprob=6,npart=1,n;
+  PetscReal   exact,error=0.0;
+  PetscMPIInt len;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-nprob",&nprob,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-npart",&npart,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nBatch of %" PetscInt_FMT " tridiagonal eigenproblems\n\n",nprob));
+  PetscCall(PetscCalloc1(nprob,&user.lambda));
+
+  /* template solver, it does not need matrices */
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetProblemType(eps,EPS_HEP));
+  PetscCall(EPSSetType(eps,EPSKRYLOVSCHUR));
+  PetscCall(EPSSetWhichEigenpairs(eps,EPS_LARGEST_REAL));
+  PetscCall(EPSSetTolerances(eps,1e-10,PETSC_CURRENT));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(EPSSolveBatch(eps,nprob,npart,GetOperators,GetResult,&user));
+
+  /* gather the results of all partitions and check them */
+  PetscCall(PetscMPIIntCast(nprob,&len));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,user.lambda,len,MPIU_REAL,MPIU_SUM,PETSC_COMM_WORLD));
+  for (i=0;i<nprob;i++) {
+    n = 50+10*i;
+    exact = 2.0+0.1*i-2.0*PetscCosReal(n*PETSC_PI/(n+1));
+    error = PetscMax(error,PetscAbsReal(user.lambda[i]-exact)/exact);
+  }
+  if (error<1e-8) PetscCall(PetscPrintf(PETSC_COMM_WORLD," All problems solved correctly\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Maximum relative error %g\n",(double)error));
+
+  PetscCall(PetscFree(user.lambda));
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      requires: !single
+      output_file: output/test47_1.out
+      test:
+         suffix: 1
+      test:
+         suffix: 1_part
+         nsize: 3
+         args: -npart 3
+      test:
+         suffix: 1_part_warm
+         nsize: 4
+         args: -npart 2 -eps_warm_start
+
+TEST*/
@@ -0,0 +1,108 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test EPSGetEigenvectorsBV() with a nonsymmetric matrix.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n\n";
+
+#include <slepceps.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  EPS            eps;
+  BV             X;
+  Vec            xr,xi,v;
+  PetscScalar    kr,ki;
+  PetscReal      nrm,err=0.0;
+  PetscInt       n=100,i,Istart,Iend,nconv,l,k;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nNonsymmetric tridiagonal matrix, n=%" PetscInt_FMT "\n\n",n));
+
+  /* tridiagonal matrix with skew-symmetric off-diagonal part, it has complex eigenvalues */
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,(PetscScalar)i/n,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,EPS_NHEP));
+  PetscCall(EPSSetWhichEigenpairs(eps,EPS_LARGEST_REAL));
+  PetscCall(EPSSetDimensions(eps,6,PETSC_DETERMINE,PETSC_DETERMINE));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(EPSSolve(eps));
+  PetscCall(EPSGetConverged(eps,&nconv));
+  PetscCheck(nconv>=6,PETSC_COMM_WORLD,PETSC_ERR_CONV_FAILED,"Not enough converged eigenpairs");
+
+  /* the columns of the BV must be the eigenvectors given by EPSGetEigenvector() */
+  PetscCall(MatCreateVecs(A,&xr,&v));
+  PetscCall(VecDuplicate(xr,&xi));
+  for (i=0;i<nconv;i++) {
+    PetscCall(EPSGetEigenvalue(eps,i,&kr,&ki));
+    PetscCall(EPSGetEigenvector(eps,i,xr,xi));
+    PetscCall(EPSGetEigenvectorsBV(eps,&X));
+    PetscCall(BVGetActiveColumns(X,&l,&k));
+    PetscCheck(!l && k==nconv,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong active columns of the BV");
+    PetscCall(BVCopyVec(X,(PetscRealPart(ki)<0.0)?i-1:i,v));
+    PetscCall(VecAXPY(v,-1.0,xr));
+    PetscCall(VecNorm(v,NORM_2,&nrm));
+    err = PetscMax(err,nrm);
+#if !defined(PETSC_USE_COMPLEX)
+    if (ki!=0.0) {  /* second column of the pair */
+      PetscCall(BVCopyVec(X,(ki>0.0)?i+1:i,v));
+      PetscCall(VecAXPY(v,(ki>0.0)?-1.0:1.0,xi));
+      PetscCall(VecNorm(v,NORM_2,&nrm));
+      err = PetscMax(err,nrm);
+    }
+#endif
+    PetscCall(EPSRestoreEigenvectorsBV(eps,&X));
+  }
+  if (err<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The columns of the BV are the eigenvectors\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," The columns of the BV differ from the eigenvectors by %g\n",(double)err));
+
+  PetscCall(VecDestroy(&xr));
+  PetscCall(VecDestroy(&xi));
+  PetscCall(VecDestroy(&v));
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      requires: !single
+      output_file: output/test48_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_lazy
+         args: -eps_lazy_vectors
+      test:
+         suffix: 1_sinvert
+         args: -st_type sinvert -eps_target 1 -eps_target_real
+      test:
+         suffix: 1_native
+         args: -eps_view_vectors binary:evecs.bin:native
+
+TEST*/
@@ -0,0 +1,77 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test EPSGetPerformanceStats() with the 1-D Laplacian.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n\n";
+
+#include <slepceps.h>
+
+int main(int argc,char **argv)
+{
+  Mat                A;
+  EPS                eps;
+  PetscEventPerfInfo solve,setup,orth,matmult;
+  PetscInt           n=100,i,Istart,Iend,its;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscLogDefaultBegin());
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n1-D Laplacian Eigenproblem, n=%" PetscInt_FMT "\n\n",n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,EPS_HEP));
+  PetscCall(EPSSetFromOptions(eps));
+
+  /* the data refer to the last solve only, so solve twice */
+  for (i=0;i<2;i++) {
+    PetscCall(EPSSolve(eps));
+    PetscCall(EPSGetIterationNumber(eps,&its));
+    PetscCall(EPSGetPerformanceStats(eps,SLEPC_PERF_SOLVE,&solve));
+    PetscCall(EPSGetPerformanceStats(eps,SLEPC_PERF_SETUP,&setup));
+    PetscCall(EPSGetPerformanceStats(eps,SLEPC_PERF_ORTHOGONALIZE,&orth));
+    PetscCall(EPSGetPerformanceStats(eps,SLEPC_PERF_MATMULT,&matmult));
+    PetscCheck(solve.count==1,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong number of solves %d",solve.count);
+    PetscCheck(setup.count<=1,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong number of setups %d",setup.count);
+    PetscCheck(matmult.count>=its,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Too few matrix-vector products %d",matmult.count);
+    PetscCheck(orth.count>0,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"No orthogonalization was logged");
+    PetscCheck(solve.time>=setup.time,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"The solve time must include the setup");
+    PetscCall(EPSSetTolerances(eps,1e-6,PETSC_CURRENT));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," The performance data are consistent\n"));
+
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2}}
+      output_file: output/test49_1.out
+
+TEST*/
@@ -0,0 +1,96 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Tests EPSSaveSolution() and SlepcLoadSolution().\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of grid subdivisions.\n"
+  "  -file <f>, name of the solution file.\n\n";
+
+#include <slepceps.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  EPS            eps;
+  BV             V,X;
+  Vec            x,y;
+  PetscScalar    *eigr,*eigi,kr,ki;
+  PetscReal      *errest,err,nrm,dmax=0.0;
+  PetscInt       n=30,i,Istart,Iend,nconv,nload;
+  char           filename[PETSC_MAX_PATH_LEN] = "eps_solution.bin";
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetString(NULL,NULL,"-file",filename,sizeof(filename),NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n1-D Laplacian Eigenproblem, n=%" PetscInt_FMT "\n\n",n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  PetscCall(EPSCreate(PETSC_COMM_WORLD,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,EPS_HEP));
+  PetscCall(EPSSetFromOptions(eps));
+  PetscCall(EPSSolve(eps));
+  PetscCall(EPSGetConverged(eps,&nconv));
+
+  /* save the solution and load it back */
+  PetscCall(EPSSaveSolution(eps,filename));
+  PetscCall(SlepcLoadSolution(PETSC_COMM_WORLD,filename,&nload,&eigr,&eigi,&errest,&X,NULL));
+  PetscCheck(nload==nconv,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong number of loaded values");
+
+  /* compare with the solution in the EPS object */
+  PetscCall(EPSGetEigenvectorsBV(eps,&V));
+  for (i=0;i<nconv;i++) {
+    PetscCall(EPSGetEigenvalue(eps,i,&kr,&ki));
+    PetscCall(EPSGetErrorEstimate(eps,i,&err));
+    PetscCheck(kr==eigr[i] && ki==eigi[i] && err==errest[i],PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong loaded value %" PetscInt_FMT,i);
+    PetscCall(BVGetColumn(V,i,&x));
+    PetscCall(BVGetColumn(X,i,&y));
+    PetscCall(VecAXPY(y,-1.0,x));
+    PetscCall(VecNorm(y,NORM_2,&nrm));
+    PetscCall(VecAXPY(y,1.0,x));
+    PetscCall(BVRestoreColumn(X,i,&y));
+    PetscCall(BVRestoreColumn(V,i,&x));
+    dmax = PetscMax(dmax,nrm);
+  }
+  PetscCall(EPSRestoreEigenvectorsBV(eps,&V));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Loaded %s eigenpairs, difference in the vectors is %s\n",nload>=4?"all":"not enough",dmax==0.0?"zero":"nonzero"));
+
+  PetscCall(PetscFree(eigr));
+  PetscCall(PetscFree(eigi));
+  PetscCall(PetscFree(errest));
+  PetscCall(BVDestroy(&X));
+  PetscCall(EPSDestroy(&eps));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2}}
+      args: -eps_nev 4
+      requires: defined(PETSC_HAVE_MMAP)
+      output_file: output/test50_1.out
+
+TEST*/
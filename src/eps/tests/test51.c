@@ -0,0 +1,94 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Solves a batch of independent small problems from several OpenMP threads.\n\n"
+  "The command line options are:\n"
+  "  -nprob <nprob>, number of problems, the k-th one is a 1-D Laplacian of size 20+k.\n\n";
+
+#include <slepceps.h>
+#include <slepcsvd.h>
+
+/*
+   Computes the largest eigenvalue and the largest singular value of the k-th problem,
+   with objects created on PETSC_COMM_SELF that are not shared with other threads
+*/
+static PetscErrorCode SolveProblem(PetscInt k,PetscReal *lambda,PetscReal *sigma)
+{
+  Mat         A;
+  EPS         eps;
+  SVD         svd;
+  PetscInt    i,n=20+k,Istart,Iend,nconv;
+  PetscScalar kr;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF,n,n,3,NULL,&A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  PetscCall(EPSCreate(PETSC_COMM_SELF,&eps));
+  PetscCall(EPSSetOperators(eps,A,NULL));
+  PetscCall(EPSSetProblemType(eps,EPS_HEP));
+  PetscCall(EPSSetWhichEigenpairs(eps,EPS_LARGEST_REAL));
+  PetscCall(EPSSetTolerances(eps,1e-10,PETSC_CURRENT));
+  PetscCall(EPSSolve(eps));
+  PetscCall(EPSGetConverged(eps,&nconv));
+  PetscCheck(nconv>0,PETSC_COMM_SELF,PETSC_ERR_NOT_CONVERGED,"EPS did not converge in problem %" PetscInt_FMT,k);
+  PetscCall(EPSGetEigenpair(eps,0,&kr,NULL,NULL,NULL));
+  *lambda = PetscRealPart(kr);
+  PetscCall(EPSDestroy(&eps));
+
+  PetscCall(SVDCreate(PETSC_COMM_SELF,&svd));
+  PetscCall(SVDSetOperators(svd,A,NULL));
+  PetscCall(SVDSetType(svd,SVDCROSS));
+  PetscCall(SVDSetImplicitTranspose(svd,PETSC_FALSE));
+  PetscCall(SVDSetTolerances(svd,1e-10,PETSC_CURRENT));
+  PetscCall(SVDSolve(svd));
+  PetscCall(SVDGetConverged(svd,&nconv));
+  PetscCheck(nconv>0,PETSC_COMM_SELF,PETSC_ERR_NOT_CONVERGED,"SVD did not converge in problem %" PetscInt_FMT,k);
+  PetscCall(SVDGetSingularTriplet(svd,0,sigma,NULL,NULL));
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(MatDestroy(&A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  PetscInt  k,nprob=8;
+  PetscReal *lambda,*sigma;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-nprob",&nprob,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Batch of %" PetscInt_FMT " independent problems solved by several threads\n",nprob));
+  PetscCall(PetscMalloc2(nprob,&lambda,nprob,&sigma));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (k=0;k<nprob;k++) PetscCallAbort(PETSC_COMM_SELF,SolveProblem(k,lambda+k,sigma+k));
+
+  for (k=0;k<nprob;k++) PetscCall(PetscPrintf(PETSC_COMM_WORLD," n=%3" PetscInt_FMT "  largest eigenvalue %.5f  largest singular value %.5f\n",20+k,(double)lambda[k],(double)sigma[k]));
+  PetscCall(PetscFree2(lambda,sigma));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      env: OMP_NUM_THREADS=4
+      requires: threadsafety openmp !single
+
+TEST*/
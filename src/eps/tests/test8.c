@@ -182,6 +182,12 @@ PetscErrorCode MatGetDiagonal_Laplacian2D(Mat A,Vec diag)
          suffix: 1_elemental
          args: -eps_type elemental
          requires: elemental
+      test:
+         suffix: 1_sstep
+         args: -eps_type {{krylovschur arnoldi}} -bv_krylov_sstep 3
+      test:
+         suffix: 1_pipelined
+         args: -eps_type {{krylovschur arnoldi}} -bv_orthog_type cgs_pipelined -bv_orthog_refine {{never ifneeded}}
       test:
          suffix: 1_krylovschur_vecs
          args: -bv_type vecs -bv_orthog_refine always -eps_ncv 10 -vec_mdot_use_gemv 0
@@ -212,6 +212,34 @@ PetscErrorCode MyEigenSort(PetscScalar ar,PetscScalar ai,PetscScalar br,PetscSca
       test:
          suffix: 1
          args: -eps_type {{krylovschur arnoldi lapack}} -eps_ncv 8 -eps_max_it 300
+      test:
+         suffix: 1_sstep
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 12 -eps_max_it 300 -bv_krylov_sstep 4
+      test:
+         suffix: 1_pipelined
+         nsize: 2
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 8 -eps_max_it 300 -bv_orthog_type cgs_pipelined
+      test:
+         suffix: 1_rgs
+         nsize: 2
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 12 -eps_max_it 300 -bv_orthog_type rgs
+      test:
+         suffix: 1_dcgs2
+         nsize: {{1 2}}
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 8 -eps_max_it 300 -bv_orthog_type dcgs2
+      test:
+         suffix: 1_mixed
+         args: -eps_type krylovschur -eps_ncv 12 -eps_max_it 300 -bv_type mixed -eps_tol 1e-6
+         requires: double
+      test:
+         suffix: 1_mmap
+         nsize: {{1 2}}
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 12 -eps_max_it 300 -bv_type mmap
+         requires: defined(PETSC_HAVE_MMAP)
+      test:
+         suffix: 1_panel
+         nsize: {{1 2}}
+         args: -eps_type {{krylovschur arnoldi}} -eps_ncv 12 -eps_max_it 300 -bv_type panel -bv_panel_rows 16
       test:
          suffix: 1_gd
          args: -eps_type gd -st_pc_type none
@@ -278,6 +306,13 @@ PetscErrorCode MyEigenSort(PetscScalar ar,PetscScalar ai,PetscScalar br,PetscSca
       requires: !single
       output_file: output/test9_6.out
 
+   test:
+      suffix: 6_interval_split
+      nsize: 2
+      args: -eps_type ciss -eps_tol 1e-9 -rg_type interval -rg_interval_endpoints 0.5,0.6 -eps_ciss_subregions 2 -eps_ciss_partitions 2 -eps_all
+      requires: !single
+      output_file: output/test9_6.out
+
    testset:
       args: -eps_nev 4 -eps_two_sided -eps_view_vectors ::ascii_info -eps_view_values
       filter: sed -e "s/\(0x[0-9a-fA-F]*\)/objectid/"
@@ -134,8 +134,14 @@ int main (int argc,char **argv)
       test:
          suffix: 1
          args: -eps_krylovschur_restart .2
+      test:
+         suffix: 1_adaptive
+         args: -eps_krylovschur_restart_adaptive
       test:
          suffix: 2
          args: -eps_ncv 20 -eps_target 0 -st_type sinvert -st_ksp_type cg -st_pc_type jacobi
+      test:
+         suffix: 3
+         args: -eps_ncv 20 -eps_target 0 -st_type sinvert -st_ksp_type cg -st_pc_type jacobi -st_adaptive_inner_tol
 
 TEST*/
@@ -117,6 +117,19 @@ int main(int argc,char **argv)
       test:
          suffix: 2
          args: -library_preload
+      test:
+         suffix: 2_packages
+         args: -library_preload_packages eps
+      test:
+         suffix: 1_block
+         args: -eps_krylovschur_blocksize 3 -bv_orthog_block {{gs chol tsqr svqb}}
+      test:
+         suffix: 1_filter
+         args: -eps_largest_real -st_type filter -st_filter_type chebyshev
+         requires: !__float128
+      test:
+         suffix: 1_monitor_binary
+         args: -eps_monitor_all binary:ex2_history.dat -eps_monitor_history_size 10
 
    testset:
       args: -n 30 -eps_type ciss -eps_ciss_realmats -terse
@@ -141,6 +154,20 @@ int main(int argc,char **argv)
          suffix: ciss_2_block
          args: -rg_type ellipse -rg_ellipse_center 1.175 -rg_ellipse_radius 0.075 -eps_ciss_blocksize 3 -eps_ciss_moments 2
          requires: complex !__float128
+      test:
+         suffix: ciss_2_herm
+         args: -rg_type ellipse -rg_ellipse_center 1.175 -rg_ellipse_radius 0.075 -eps_ciss_realmats 0
+         requires: complex
+      test:
+         suffix: ciss_2_lowmem
+         nsize: 2
+         args: -rg_type ellipse -rg_ellipse_center 1.175 -rg_ellipse_radius 0.075 -eps_ciss_partitions 2 -eps_ciss_low_memory
+      test:
+         suffix: ciss_2_randsvd
+         args: -rg_type ellipse -rg_ellipse_center 1.175 -rg_ellipse_radius 0.075 -eps_ciss_randomized_svd
+      test:
+         suffix: ciss_2_quad_refine
+         args: -rg_type ellipse -rg_ellipse_center 1.175 -rg_ellipse_radius 0.075 -eps_ciss_integration_points 8 -eps_ciss_moments 2 -eps_ciss_quad_refine 2
       test:
          suffix: ciss_2_hpddm
          nsize: 2
@@ -177,6 +204,11 @@ int main(int argc,char **argv)
          suffix: 4_filter
          args: -eps_type {{krylovschur subspace}} -st_type filter -st_filter_degree 200
          requires: !__float128
+      test:
+         suffix: 4_filter_slices
+         nsize: 2
+         args: -st_type filter -st_filter_degree 200 -eps_krylovschur_partitions 2
+         requires: !__float128
       test:
          suffix: 4_filter_cuda
          args: -eps_type {{krylovschur subspace}} -st_type filter -st_filter_degree 200 -mat_type aijcusparse
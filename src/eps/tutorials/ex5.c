@@ -177,4 +177,10 @@ PetscErrorCode MatMarkovModel(PetscInt m,Mat A)
       args: -eps_largest_real -eps_nev 4 -eps_two_sided {{0 1}} -eps_krylovschur_locking {{0 1}} -ds_parallel synchronized -terse
       filter: sed -e "s/90424/90423/" | sed -e "s/85715/85714/"
 
+   test:
+      suffix: 1_block
+      args: -eps_largest_real -eps_nev 4 -eps_krylovschur_blocksize 2 -terse
+      output_file: output/ex5_1.out
+      filter: sed -e "s/90424/90423/" | sed -e "s/85715/85714/"
+
 TEST*/
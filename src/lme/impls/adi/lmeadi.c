@@ -0,0 +1,552 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SLEPc matrix equation solver: "adi"
+
+   Method: Low-rank alternating direction implicit iteration
+
+   Algorithm:
+
+       Low-rank ADI in residual factor form [1] for A*X+X*A'+C1*C1'=0, with
+       shifts p_i in the left half plane. Starting from W=C1, each step
+       computes V=(A+p_i*I)^{-1}*W, W=W-2*Re(p_i)*V, and appends
+       sqrt(-2*Re(p_i))*V to the low-rank factor of the solution. The
+       residual is W*W', so its norm is obtained from the Gram matrix of W.
+
+       The shifts are computed with Penzl's heuristic [2] from the Ritz
+       values of A and inv(A), and are used cyclically. The factorizations
+       of A+p_i*I are kept in the cache of an STSINVERT object.
+
+   References:
+
+       [1] P. Benner, P. Kurschner, and J. Saak, "An improved numerical
+           method for balanced truncation for symmetric second-order
+           systems", Math. Comput. Model. Dyn. Syst. 19(6):593-615, 2013.
+
+       [2] T. Penzl, "A cyclic low-rank Smith method for large sparse
+           Lyapunov equations", SIAM J. Sci. Comput. 21(4):1401-1418, 2000.
+*/
+
+#include <slepc/private/lmeimpl.h>
+#include <slepcblaslapack.h>
+
+typedef struct {
+  ST          st;          /* spectral transformation for the linear solves */
+  PetscInt    nshifts;     /* number of shifts */
+  PetscScalar *shifts;     /* ADI shifts, with negative real part */
+  PetscBool   usershifts;  /* the shifts were provided by the user */
+} LME_ADI;
+
+/*
+   Modulus of (t-p)/(t+p), where t=tr+ti*i
+*/
+static inline PetscReal LMEADIFactor(PetscReal tr,PetscReal ti,PetscScalar p)
+{
+  PetscReal pr = PetscRealPart(p),pi = PetscImaginaryPart(p);
+
+  return PetscSqrtReal(((tr-pr)*(tr-pr)+(ti-pi)*(ti-pi))/((tr+pr)*(tr+pr)+(ti+pi)*(ti+pi)));
+}
+
+/*
+   Computes m Ritz values of Op with an Arnoldi factorization, and inverts them if inv=true
+*/
+static PetscErrorCode LMEADIRitz(LME lme,Mat Op,PetscInt m,PetscBool inv,PetscInt *nr,PetscReal *rr,PetscReal *ri)
+{
+  PetscInt          i,nv=m;
+  PetscReal         t;
+  PetscBool         breakdown;
+  PetscScalar       *h,*work,*wr;
+  PetscBLASInt      n_,ld_,one=1,lwork,info;
+  Mat               H;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscScalar       *wi;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(BVSetActiveColumns(lme->V,0,m+1));
+  PetscCall(BVSetRandomColumn(lme->V,0));
+  PetscCall(BVNormColumn(lme->V,0,NORM_2,&t));
+  PetscCall(BVScaleColumn(lme->V,0,1.0/t));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,m,NULL,&H));
+  PetscCall(BVMatArnoldi(lme->V,Op,H,0,&nv,NULL,&breakdown));
+  PetscCall(PetscBLASIntCast(nv,&n_));
+  PetscCall(PetscBLASIntCast(m,&ld_));
+  lwork = ld_;
+  PetscCall(PetscMalloc2(m,&work,m,&wr));
+  PetscCall(MatDenseGetArray(H,&h));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc1(m,&wi));
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,h,&ld_,wr,wi,NULL,&n_,work,&lwork,&info));
+  for (i=0;i<nv;i++) {
+    rr[i] = wr[i];
+    ri[i] = wi[i];
+  }
+  PetscCall(PetscFree(wi));
+#else
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,h,&ld_,wr,NULL,&n_,work,&lwork,&info));
+  for (i=0;i<nv;i++) {
+    rr[i] = PetscRealPart(wr[i]);
+    ri[i] = PetscImaginaryPart(wr[i]);
+  }
+#endif
+  SlepcCheckLapackInfo("hseqr",info);
+  PetscCall(MatDenseRestoreArray(H,&h));
+  PetscCall(MatDestroy(&H));
+  PetscCall(PetscFree2(work,wr));
+  *nr = nv;
+  if (inv) {
+    for (i=0,*nr=0;i<nv;i++) {
+      t = rr[i]*rr[i]+ri[i]*ri[i];
+      if (t==0.0) continue;
+      rr[*nr] = rr[i]/t;
+      ri[*nr] = -ri[i]/t;
+      (*nr)++;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Penzl's heuristic: the first shift minimizes max|(t-p)/(t+p)| over the set of
+   Ritz values t, and each new shift is the Ritz value where the product of the
+   factors of the previous shifts is largest. With real scalars the shifts are
+   real, and a Ritz value t is replaced by -|t|
+*/
+static PetscErrorCode LMEADIComputeShifts(LME lme)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscInt       i,j,k,n,np,nm,kp,km,N,ibest=0;
+  PetscReal      *rr,*ri,val,best;
+  PetscScalar    *cand;
+  Mat            Op;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(lme->A,&N,NULL));
+  kp = PetscMin(lme->ncv,N-1);
+  km = PetscMin(lme->ncv/2,N-1);
+  PetscCall(PetscMalloc3(kp+km,&rr,kp+km,&ri,kp+km,&cand));
+  PetscCall(LMEADIRitz(lme,lme->A,kp,PETSC_FALSE,&np,rr,ri));
+  PetscCall(STGetOperator(ctx->st,&Op));
+  PetscCall(LMEADIRitz(lme,Op,km,PETSC_TRUE,&nm,rr+np,ri+np));
+  PetscCall(STRestoreOperator(ctx->st,&Op));
+
+  /* keep the stable Ritz values */
+  for (i=0,n=0;i<np+nm;i++) {
+    if (rr[i]>=0.0) continue;
+    rr[n] = rr[i];
+    ri[n] = ri[i];
+#if !defined(PETSC_USE_COMPLEX)
+    cand[n] = -SlepcAbs(rr[i],ri[i]);
+#else
+    cand[n] = PetscCMPLX(rr[i],ri[i]);
+#endif
+    n++;
+  }
+  PetscCheck(n,PetscObjectComm((PetscObject)lme),PETSC_ERR_CONV_FAILED,"No Ritz values in the left half plane, the coefficient matrix does not seem to be stable");
+
+  best = PETSC_MAX_REAL;
+  for (j=0;j<n;j++) {
+    for (val=0.0,i=0;i<n;i++) val = PetscMax(val,LMEADIFactor(rr[i],ri[i],cand[j]));
+    if (val<best) {
+      best  = val;
+      ibest = j;
+    }
+  }
+  ctx->shifts[0] = cand[ibest];
+  for (k=1;k<ctx->nshifts;k++) {
+    best = -1.0;
+    for (i=0;i<n;i++) {
+      for (val=1.0,j=0;j<k;j++) val *= LMEADIFactor(rr[i],ri[i],ctx->shifts[j]);
+      if (val>best) {
+        best  = val;
+        ibest = i;
+      }
+    }
+    if (best==0.0) break;  /* all candidates are already shifts */
+    ctx->shifts[k] = cand[ibest];
+  }
+  if (k<ctx->nshifts) PetscCall(PetscInfo(lme,"Only %" PetscInt_FMT " distinct shifts could be computed\n",k));
+  ctx->nshifts = k;
+  PetscCall(PetscFree3(rr,ri,cand));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESetUp_ADI(LME lme)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscInt       i,N,nc;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(lme->A,&N,NULL));
+  if (lme->ncv==PETSC_DETERMINE) lme->ncv = PetscMin(20,N);
+  if (lme->max_it==PETSC_DETERMINE) lme->max_it = 100;
+  PetscCall(LMEAllocateSolution(lme,1));
+
+  if (!ctx->st) PetscCall(LMEADIGetST(lme,&ctx->st));
+  PetscCall(PetscObjectTypeCompare((PetscObject)ctx->st,STSINVERT,&flg));
+  PetscCheck(flg,PetscObjectComm((PetscObject)lme),PETSC_ERR_SUP,"This solver requires an ST of type sinvert");
+  PetscCall(STSetMatrices(ctx->st,1,&lme->A));
+  PetscCall(STSetTransform(ctx->st,PETSC_TRUE));
+  PetscCall(STSinvertGetShiftCache(ctx->st,&nc));
+  if (nc<ctx->nshifts) PetscCall(STSinvertSetShiftCache(ctx->st,ctx->nshifts));
+
+  if (!ctx->usershifts) {
+    PetscCall(PetscFree(ctx->shifts));
+    PetscCall(PetscMalloc1(ctx->nshifts,&ctx->shifts));
+    PetscCall(STSetShift(ctx->st,0.0));
+    PetscCall(STSetUp(ctx->st));
+    PetscCall(LMEADIComputeShifts(lme));
+  }
+  for (i=0;i<ctx->nshifts;i++) PetscCheck(PetscRealPart(ctx->shifts[i])<0.0,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_WRONG,"The ADI shifts must have negative real part");
+  PetscCall(STSetShift(ctx->st,-ctx->shifts[0]));
+  PetscCall(STSetUp(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Frobenius norm of W*W', computed from the Gram matrix W'*W
+*/
+static PetscErrorCode LMEADIResidualNorm(BV W,Mat G,PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscCall(BVDot(W,W,G));
+  PetscCall(MatNorm(G,NORM_FROBENIUS,norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESolve_ADI_Lyapunov(LME lme)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscBool      fixed = lme->X? PETSC_TRUE: PETSC_FALSE;
+  PetscInt       i,k,col=0,ncols=0;
+  PetscReal      res,pr;
+  PetscScalar    p;
+  Vec            v,w;
+  BV             X1=NULL,C1,W,V;
+  Mat            X1m,X1t,C1m,G;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,NULL));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVSetFromOptions(C1));
+  PetscCall(BVGetActiveColumns(C1,NULL,&k));
+  if (fixed) {
+    PetscCall(MatLRCGetMats(lme->X,NULL,&X1m,NULL,NULL));
+    PetscCall(BVCreateFromMat(X1m,&X1));
+    PetscCall(BVSetFromOptions(X1));
+    PetscCall(BVGetActiveColumns(X1,NULL,&ncols));
+  }
+
+  /* W is the low-rank factor of the residual, V the new block of the solution */
+  PetscCall(BVDuplicate(C1,&W));
+  PetscCall(BVCopy(C1,W));
+  PetscCall(BVDuplicate(C1,&V));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&G));
+
+  PetscCall(LMEADIResidualNorm(W,G,&res));
+  while (lme->reason == LME_CONVERGED_ITERATING) {
+    p  = ctx->shifts[lme->its%ctx->nshifts];
+    pr = PetscRealPart(p);
+    lme->its++;
+
+    /* V = (A+p*I)^{-1}*W, W = W-2*Re(p)*V */
+    PetscCall(STSetShift(ctx->st,-p));
+    for (i=0;i<k;i++) {
+      PetscCall(BVGetColumn(W,i,&w));
+      PetscCall(BVGetColumn(V,i,&v));
+      PetscCall(STApply(ctx->st,w,v));
+      PetscCall(BVRestoreColumn(V,i,&v));
+      PetscCall(BVRestoreColumn(W,i,&w));
+    }
+    PetscCall(BVMult(W,-2.0*pr,1.0,V,NULL));
+
+    /* append sqrt(-2*Re(p))*V to the solution */
+    if (fixed) PetscCheck(col+k<=ncols,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_SIZ,"The solution provided in LMESetSolution() has %" PetscInt_FMT " columns, more are needed",ncols);
+    else if (col) PetscCall(BVResize(X1,col+k,PETSC_TRUE));
+    else PetscCall(BVDuplicateResize(C1,k,&X1));
+    PetscCall(BVSetActiveColumns(X1,col,col+k));
+    PetscCall(BVCopy(V,X1));
+    PetscCall(BVScale(X1,PetscSqrtReal(-2.0*pr)));
+    col += k;
+
+    PetscCall(LMEADIResidualNorm(W,G,&res));
+    PetscCall(LMEMonitor(lme,lme->its,res));
+    if (res<lme->tol) lme->reason = LME_CONVERGED_TOL;
+    else if (lme->its>=lme->max_it) lme->reason = LME_DIVERGED_ITS;
+  }
+  lme->errest = res;
+
+  if (fixed && col<ncols) {  /* zero the columns that were not used */
+    PetscCall(BVSetActiveColumns(X1,col,ncols));
+    PetscCall(BVScale(X1,0.0));
+  }
+  PetscCall(BVSetActiveColumns(X1,0,fixed? ncols: col));
+  PetscCall(BVCreateMat(X1,&X1t));
+  if (fixed) PetscCall(MatCopy(X1t,X1m,SAME_NONZERO_PATTERN));
+  else PetscCall(MatCreateLRC(NULL,X1t,NULL,NULL,&lme->X));
+  PetscCall(MatDestroy(&X1t));
+  PetscCall(MatDestroy(&G));
+  PetscCall(BVDestroy(&W));
+  PetscCall(BVDestroy(&V));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&X1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#define SHIFTMAX 50
+
+static PetscErrorCode LMESetFromOptions_ADI(LME lme,PetscOptionItems *PetscOptionsObject)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscInt       i,k;
+  PetscBool      flg;
+  PetscScalar    array[SHIFTMAX];
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"LME ADI Options");
+
+    k = SHIFTMAX;
+    for (i=0;i<k;i++) array[i] = 0;
+    PetscCall(PetscOptionsScalarArray("-lme_adi_shifts","ADI shifts","LMEADISetShifts",array,&k,&flg));
+    if (flg) PetscCall(LMEADISetShifts(lme,k,array));
+
+    PetscCall(PetscOptionsInt("-lme_adi_nshifts","Number of shifts computed with Penzl's heuristic","LMEADISetShifts",ctx->nshifts,&k,&flg));
+    if (flg) PetscCall(LMEADISetShifts(lme,k,NULL));
+
+  PetscOptionsHeadEnd();
+
+  if (!ctx->st) PetscCall(LMEADIGetST(lme,&ctx->st));
+  PetscCall(STSetFromOptions(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEView_ADI(LME lme,PetscViewer viewer)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscBool      isascii;
+  PetscInt       i;
+  char           str[50];
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    if (ctx->shifts) {
+      PetscCall(PetscViewerASCIIPrintf(viewer,"  %s shifts: ",ctx->usershifts?"user-provided":"Penzl"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_FALSE));
+      for (i=0;i<ctx->nshifts;i++) {
+        PetscCall(SlepcSNPrintfScalar(str,sizeof(str),ctx->shifts[i],PETSC_FALSE));
+        PetscCall(PetscViewerASCIIPrintf(viewer,"%s%s",str,(i<ctx->nshifts-1)?",":""));
+      }
+      PetscCall(PetscViewerASCIIPrintf(viewer,"\n"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_TRUE));
+    } else PetscCall(PetscViewerASCIIPrintf(viewer,"  number of shifts: %" PetscInt_FMT "\n",ctx->nshifts));
+    if (!ctx->st) PetscCall(LMEADIGetST(lme,&ctx->st));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(STView(ctx->st,viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEADISetShifts_ADI(LME lme,PetscInt ns,PetscScalar *shifts)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (ns==PETSC_DECIDE || ns==PETSC_DETERMINE) ns = 10;
+  PetscCheck(ns>0,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_OUTOFRANGE,"Number of shifts must be positive");
+  PetscCall(PetscFree(ctx->shifts));
+  ctx->nshifts    = ns;
+  ctx->usershifts = shifts? PETSC_TRUE: PETSC_FALSE;
+  if (shifts) {
+    PetscCall(PetscMalloc1(ns,&ctx->shifts));
+    for (i=0;i<ns;i++) ctx->shifts[i] = shifts[i];
+  }
+  lme->setupcalled = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   LMEADISetShifts - Sets the shifts to be used in the low-rank ADI iteration.
+
+   Collective
+
+   Input Parameters:
++  lme    - the linear matrix equation solver context
+.  ns     - number of shifts
+-  shifts - array of shifts, or NULL to compute ns shifts automatically
+
+   Options Database Keys:
++  -lme_adi_shifts  - Sets the list of shifts
+-  -lme_adi_nshifts - Sets the number of shifts computed automatically
+
+   Notes:
+   The shifts p_i must have negative real part, and are used cyclically.
+   Each one requires a factorization of A+p_i*I, which is kept with
+   STSinvertSetShiftCache() so that it is computed only once.
+
+   If shifts is NULL, they are computed in LMESetUp() with Penzl's heuristic,
+   from approximately ncv Ritz values of A and ncv/2 Ritz values of inv(A),
+   see LMESetDimensions(). The default is 10 shifts.
+
+   In the case of real scalars, complex shifts are not allowed, and the
+   heuristic then uses -|t| for each Ritz value t.
+
+   Level: advanced
+
+.seealso: LMEADIGetShifts(), LMEADIGetST()
+@*/
+PetscErrorCode LMEADISetShifts(LME lme,PetscInt ns,PetscScalar shifts[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscValidLogicalCollectiveInt(lme,ns,2);
+  PetscTryMethod(lme,"LMEADISetShifts_C",(LME,PetscInt,PetscScalar*),(lme,ns,shifts));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEADIGetShifts_ADI(LME lme,PetscInt *ns,PetscScalar **shifts)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (ns) *ns = ctx->nshifts;
+  if (shifts) {
+    *shifts = NULL;
+    if (ctx->shifts) {
+      PetscCall(PetscMalloc1(ctx->nshifts,shifts));
+      for (i=0;i<ctx->nshifts;i++) (*shifts)[i] = ctx->shifts[i];
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   LMEADIGetShifts - Gets the shifts used in the low-rank ADI iteration.
+
+   Not Collective
+
+   Input Parameter:
+.  lme - the linear matrix equation solver context
+
+   Output Parameters:
++  ns     - number of shifts
+-  shifts - array of shifts
+
+   Notes:
+   The user is responsible for deallocating the returned array. If the shifts
+   are computed automatically, the array is NULL until LMESetUp() is called.
+
+   Level: advanced
+
+.seealso: LMEADISetShifts()
+@*/
+PetscErrorCode LMEADIGetShifts(LME lme,PetscInt *ns,PetscScalar *shifts[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscTryMethod(lme,"LMEADIGetShifts_C",(LME,PetscInt*,PetscScalar**),(lme,ns,shifts));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEADIGetST_ADI(LME lme,ST *st)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+
+  PetscFunctionBegin;
+  if (!ctx->st) {
+    PetscCall(STCreate(PetscObjectComm((PetscObject)lme),&ctx->st));
+    PetscCall(PetscObjectIncrementTabLevel((PetscObject)ctx->st,(PetscObject)lme,1));
+    PetscCall(STSetOptionsPrefix(ctx->st,((PetscObject)lme)->prefix));
+    PetscCall(STAppendOptionsPrefix(ctx->st,"lme_adi_"));
+    PetscCall(PetscObjectSetOptions((PetscObject)ctx->st,((PetscObject)lme)->options));
+    PetscCall(STSetType(ctx->st,STSINVERT));
+  }
+  *st = ctx->st;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   LMEADIGetST - Retrieve the spectral transformation object (ST) used for
+   the linear solves of the low-rank ADI iteration.
+
+   Collective
+
+   Input Parameter:
+.  lme - the linear matrix equation solver context
+
+   Output Parameter:
+.  st - the spectral transformation object
+
+   Notes:
+   The ST is of type STSINVERT, with the shift set to -p_i for each ADI shift
+   p_i. Its linear solver can be configured with options such as
+   -lme_adi_st_ksp_type or -lme_adi_st_pc_type.
+
+   Level: advanced
+
+.seealso: LMEADISetShifts()
+@*/
+PetscErrorCode LMEADIGetST(LME lme,ST *st)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscAssertPointer(st,2);
+  PetscUseMethod(lme,"LMEADIGetST_C",(LME,ST*),(lme,st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEReset_ADI(LME lme)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+
+  PetscFunctionBegin;
+  if (ctx->st) PetscCall(STReset(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEDestroy_ADI(LME lme)
+{
+  LME_ADI        *ctx = (LME_ADI*)lme->data;
+
+  PetscFunctionBegin;
+  PetscCall(STDestroy(&ctx->st));
+  PetscCall(PetscFree(ctx->shifts));
+  PetscCall(PetscFree(lme->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADISetShifts_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADIGetShifts_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADIGetST_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode LMECreate_ADI(LME lme)
+{
+  LME_ADI        *ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  lme->data    = (void*)ctx;
+  ctx->nshifts = 10;
+
+  lme->ops->solve[LME_LYAPUNOV]      = LMESolve_ADI_Lyapunov;
+  lme->ops->setup                    = LMESetUp_ADI;
+  lme->ops->setfromoptions           = LMESetFromOptions_ADI;
+  lme->ops->view                     = LMEView_ADI;
+  lme->ops->reset                    = LMEReset_ADI;
+  lme->ops->destroy                  = LMEDestroy_ADI;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADISetShifts_C",LMEADISetShifts_ADI));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADIGetShifts_C",LMEADIGetShifts_ADI));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMEADIGetST_C",LMEADIGetST_ADI));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
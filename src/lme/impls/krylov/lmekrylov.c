@@ -16,7 +16,13 @@
 
        Project the equation onto the Arnoldi basis and solve the compressed
        equation the Hessenberg matrix H, restart by discarding the Krylov
-       basis but keeping H.
+       basis but keeping H. If an initial space is provided, the equation
+       is first projected onto this space augmented with a Krylov subspace.
+
+       Sylvester equations are projected onto the Arnoldi bases of A and B',
+       and discrete-time Lyapunov equations onto the Arnoldi basis of A, in
+       both cases without restart. The projected solution is compressed with
+       an SVD, so the solution is returned as a low-rank factorization.
 
    References:
 
@@ -35,10 +41,15 @@
 
 static PetscErrorCode LMESetUp_Krylov(LME lme)
 {
-  PetscInt       N;
+  PetscInt       N,M;
 
   PetscFunctionBegin;
   PetscCall(MatGetSize(lme->A,&N,NULL));
+  if (lme->problem_type==LME_SYLVESTER) {
+    PetscCall(MatGetSize(lme->B,&M,NULL));
+    N = PetscMin(N,M);
+    if (lme->ncv>N) lme->ncv = N;
+  }
   if (lme->ncv==PETSC_DETERMINE) lme->ncv = PetscMin(30,N);
   if (lme->max_it==PETSC_DETERMINE) lme->max_it = 100;
   PetscCall(LMEAllocateSolution(lme,1));
@@ -157,7 +168,401 @@ static PetscErrorCode LMESolve_Krylov_Lyapunov_Vec(LME lme,Vec b,PetscBool fixed
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Galerkin projection onto U=[W V], where W is an orthonormal basis of the initial space
+   and V is the Arnoldi basis of the component of b orthogonal to W. Then A*U = U*T + F,
+   with F orthogonal to U, and the residual norm of X = U*Y*U', where Y is the solution
+   of the projected equation, is sqrt(2)*||F*Y||. If it is not below the tolerance, the
+   solution is not updated and the standard method must be used
+*/
+static PetscErrorCode LMESolve_Krylov_Lyapunov_Aug(LME lme,Vec b,PetscBool fixed,PetscInt rrank,BV C1,BV *X1,PetscInt *col,PetscBool *conv,PetscInt *totalits)
+{
+  PetscInt     i,j,r=0,m,ld,ldt,kf,lrank,rank;
+  PetscReal    norm,beta,errest,err2=0.0,sg;
+  PetscBool    lindep,breakdown;
+  PetscScalar  *T,*Y,*CC,*Us,*FY,*c,*pH,*pG,*Qarray,gy,sone=1.0,zero=0.0;
+  PetscBLASInt m_,r_;
+  Mat          H,G,Q;
+  BV           F;
+  Vec          w;
+
+  PetscFunctionBegin;
+  *conv = PETSC_FALSE;
+
+  /* orthonormal basis of the initial space in the leading columns of V */
+  PetscCall(BVSetActiveColumns(lme->V,0,lme->ncv));
+  for (i=0;i<lme->nini && r<lme->ncv/2;i++) {
+    PetscCall(BVInsertVec(lme->V,r,lme->IS[i]));
+    PetscCall(BVOrthonormalizeColumn(lme->V,r,PETSC_FALSE,NULL,&lindep));
+    if (!lindep) r++;
+  }
+  if (!r) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* starting vector of the Krylov part, b = W*c(0:r)+c(r)*v_r */
+  ld = lme->ncv+1;
+  PetscCall(PetscCalloc1(ld,&c));
+  PetscCall(BVInsertVec(lme->V,r,b));
+  PetscCall(BVOrthogonalizeColumn(lme->V,r,c,&norm,&lindep));
+  if (lindep || norm==0.0) {
+    PetscCall(PetscFree(c));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(BVScaleColumn(lme->V,r,1.0/norm));
+  c[r] = norm;
+
+  /* Arnoldi from column r, with the columns of W locked */
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,lme->ncv,NULL,&H));
+  m = lme->ncv;
+  PetscCall(BVMatArnoldi(lme->V,lme->A,H,r,&m,&beta,&breakdown));
+  kf = breakdown? m: m+1;  /* the next Arnoldi vector is not valid after a breakdown */
+
+  /* T = U'*A*U, plus an extra row with the coupling of A*U with v_m */
+  ldt = m+1;
+  PetscCall(PetscCalloc5(ldt*m,&T,m*m,&Y,m*m,&CC,m*m,&Us,r*m,&FY));
+  PetscCall(MatDenseGetArray(H,&pH));
+  for (j=r;j<m;j++) PetscCall(PetscArraycpy(T+j*ldt,pH+j*ld,j+2));
+  PetscCall(MatDenseRestoreArray(H,&pH));
+  PetscCall(MatDestroy(&H));
+  T[m+(m-1)*ldt] = breakdown? 0.0: beta;
+  PetscCall(BVDuplicateResize(lme->V,r,&F));
+  PetscCall(BVSetActiveColumns(lme->V,0,r));
+  PetscCall(BVMatMult(lme->V,lme->A,F));
+  PetscCall(BVSetActiveColumns(lme->V,0,kf));
+  for (i=0;i<r;i++) {  /* the orthogonal part of A*W is kept in F */
+    PetscCall(BVGetColumn(F,i,&w));
+    PetscCall(BVOrthogonalizeVec(lme->V,w,T+i*ldt,NULL,NULL));
+    PetscCall(BVRestoreColumn(F,i,&w));
+  }
+
+  /* solve the projected equation T*Y + Y*T' = -c*c' */
+  for (j=0;j<m;j++) for (i=0;i<m;i++) CC[i+j*m] = c[i]*PetscConj(c[j]);
+  PetscCall(LMEDenseLyapunov(lme,m,T,ldt,CC,m,Y,m));
+
+  /* residual norm, ||F*Y||^2 = ||T(m,:)*Y||^2 + ||F_W*Y(0:r,:)||^2 with F_W orthogonal to v_m */
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,r,r,NULL,&G));
+  PetscCall(BVDot(F,F,G));
+  PetscCall(MatDenseGetArray(G,&pG));
+  PetscCall(PetscBLASIntCast(m,&m_));
+  PetscCall(PetscBLASIntCast(r,&r_));
+  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&r_,&m_,&r_,&sone,pG,&r_,Y,&m_,&zero,FY,&r_));
+  PetscCall(MatDenseRestoreArray(G,&pG));
+  PetscCall(MatDestroy(&G));
+  PetscCall(BVDestroy(&F));
+  for (j=0;j<m;j++) {
+    gy = 0.0;
+    for (i=0;i<m;i++) gy += T[m+i*ldt]*Y[i+j*m];
+    err2 += PetscRealPart(gy*PetscConj(gy));
+    for (i=0;i<r;i++) err2 += PetscRealPart(PetscConj(Y[i+j*m])*FY[i+j*r]);
+  }
+  errest = PetscSqrtReal(2.0*PetscMax(err2,0.0));
+  (*totalits)++;
+  PetscCall(LMEMonitor(lme,*totalits,errest));
+  PetscCall(PetscInfo(lme,"Projection onto the initial space of dimension %" PetscInt_FMT " augmented with %" PetscInt_FMT " Krylov vectors, residual norm %g\n",r,m-r,(double)errest));
+
+  if (errest<lme->tol) {
+    *conv = PETSC_TRUE;
+    lme->errest += errest;
+    /* Y = Us*Us' with Us = Q*Sigma^(1/2), obtained from Q*Sigma computed by LMEDenseRankSVD */
+    PetscCall(LMEDenseRankSVD(lme,m,Y,m,Us,m,&lrank));
+    PetscCall(PetscInfo(lme,"Rank of the projected solution = %" PetscInt_FMT "\n",lrank));
+    if (!fixed) {  /* X1 was not set by user, allocate it with rank columns */
+      rank = lrank;
+      if (*col) PetscCall(BVResize(*X1,*col+rank,PETSC_TRUE));
+      else PetscCall(BVDuplicateResize(C1,rank,X1));
+    } else rank = PetscMin(lrank,rrank);
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,*col+rank,NULL,&Q));
+    PetscCall(MatDenseGetArray(Q,&Qarray));
+    for (j=0;j<rank;j++) {
+      sg = 0.0;
+      for (i=0;i<m;i++) sg += PetscRealPart(Us[i+j*m]*PetscConj(Us[i+j*m]));
+      sg = PetscSqrtReal(PetscSqrtReal(sg));
+      for (i=0;i<m;i++) Qarray[i+(*col+j)*m] = Us[i+j*m]/sg;
+    }
+    PetscCall(MatDenseRestoreArray(Q,&Qarray));
+    PetscCall(BVSetActiveColumns(lme->V,0,m));
+    PetscCall(BVSetActiveColumns(*X1,*col,*col+rank));
+    PetscCall(BVMult(*X1,1.0,0.0,lme->V,Q));
+    PetscCall(MatDestroy(&Q));
+    *col += rank;
+  }
+  PetscCall(PetscFree5(T,Y,CC,Us,FY));
+  PetscCall(PetscFree(c));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode LMESolve_Krylov_Lyapunov(LME lme)
+{
+  PetscBool      fail,conv=PETSC_FALSE,fixed = lme->X? PETSC_TRUE: PETSC_FALSE;
+  PetscInt       i,k,rank=0,col=0;
+  Vec            b;
+  BV             X1=NULL,C1;
+  Mat            X1m,X1t,C1m;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,NULL));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVSetFromOptions(C1));
+  PetscCall(BVGetActiveColumns(C1,NULL,&k));
+  if (fixed) {
+    PetscCall(MatLRCGetMats(lme->X,NULL,&X1m,NULL,NULL));
+    PetscCall(BVCreateFromMat(X1m,&X1));
+    PetscCall(BVSetFromOptions(X1));
+    PetscCall(BVGetActiveColumns(X1,NULL,&rank));
+    rank = rank/k;
+  }
+  for (i=0;i<k;i++) {
+    PetscCall(BVGetColumn(C1,i,&b));
+    if (lme->nini) PetscCall(LMESolve_Krylov_Lyapunov_Aug(lme,b,fixed,rank,C1,&X1,&col,&conv,&lme->its));
+    if (conv) fail = PETSC_FALSE;
+    else PetscCall(LMESolve_Krylov_Lyapunov_Vec(lme,b,fixed,rank,C1,&X1,&col,&fail,&lme->its));
+    PetscCall(BVRestoreColumn(C1,i,&b));
+    if (fail) {
+      lme->reason = LME_DIVERGED_ITS;
+      break;
+    }
+  }
+  if (lme->reason==LME_CONVERGED_ITERATING) lme->reason = LME_CONVERGED_TOL;
+  PetscCall(BVCreateMat(X1,&X1t));
+  if (fixed) PetscCall(MatCopy(X1t,X1m,SAME_NONZERO_PATTERN));
+  else PetscCall(MatCreateLRC(NULL,X1t,NULL,NULL,&lme->X));
+  PetscCall(MatDestroy(&X1t));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&X1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Sylvester equation A*X+X*B=u*v', projected onto the Arnoldi bases V of A and u,
+   and W of B' and v. With A*V = V*H+h*v*e_n' and B'*W = W*G+g*w*e_n', the projected
+   equation is H*Y+Y*G' = ||u||*||v||*e_1*e_1', and the residual norm of X = V*Y*W'
+   is sqrt(|h|^2*||Y(n,:)||^2+|g|^2*||Y(:,n)||^2)
+*/
+static PetscErrorCode LMESolve_Krylov_Sylvester_Vec(LME lme,Vec u,Vec v,BV W,Mat Bh,BV C1,BV C2,BV *X1,BV *X2,PetscInt *col,PetscBool *fail,PetscInt *totalits)
+{
+  PetscInt       i,j,n=0,m,ld,nv,its=0,rank;
+  PetscReal      unorm,vnorm,h,g,err2,errest=0.0;
+  PetscBool      breakdown=PETSC_FALSE,breakdownw=PETSC_FALSE,conv=PETSC_FALSE;
+  PetscScalar    *pH,*pG,*Gt,*CC,*Y,*Us,*Qarray;
+  Mat            H,G,Q;
+
+  PetscFunctionBegin;
+  *fail = PETSC_FALSE;
+  m  = lme->ncv;
+  ld = m+1;
+  PetscCall(VecNorm(u,NORM_2,&unorm));
+  PetscCall(VecNorm(v,NORM_2,&vnorm));
+  PetscCheck(unorm && vnorm,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_WRONG,"Cannot process a zero vector in the right-hand side");
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,m,NULL,&H));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,m,NULL,&G));
+  PetscCall(PetscCalloc4(m*m,&Gt,m*m,&CC,m*m,&Y,m*m,&Us));
+
+  PetscCall(BVSetActiveColumns(lme->V,0,m+1));
+  PetscCall(BVInsertVec(lme->V,0,u));
+  PetscCall(BVScaleColumn(lme->V,0,1.0/unorm));
+  PetscCall(BVSetActiveColumns(W,0,m+1));
+  PetscCall(BVInsertVec(W,0,v));
+  PetscCall(BVScaleColumn(W,0,1.0/vnorm));
+
+  while (!conv && !*fail) {
+    its++;
+    /* extend both Arnoldi factorizations by one vector */
+    nv = n+1;
+    PetscCall(BVMatArnoldi(lme->V,lme->A,H,n,&nv,&h,&breakdown));
+    nv = n+1;
+    PetscCall(BVMatArnoldi(W,Bh,G,n,&nv,&g,&breakdownw));
+    n++;
+    if (breakdown) h = 0.0;
+    if (breakdownw) g = 0.0;
+
+    /* solve the projected equation H*Y+Y*G' = C */
+    PetscCall(MatDenseGetArray(H,&pH));
+    PetscCall(MatDenseGetArray(G,&pG));
+    for (j=0;j<n;j++) for (i=0;i<n;i++) Gt[i+j*n] = PetscConj(pG[j+i*ld]);
+    PetscCall(PetscArrayzero(CC,n*n));
+    CC[0] = unorm*vnorm;
+    PetscCall(LMEDenseSylvester(lme,n,n,pH,ld,Gt,n,CC,n,Y,n));
+    PetscCall(MatDenseRestoreArray(H,&pH));
+    PetscCall(MatDenseRestoreArray(G,&pG));
+
+    /* residual norm */
+    err2 = 0.0;
+    for (i=0;i<n;i++) err2 += h*h*PetscRealPart(Y[n-1+i*n]*PetscConj(Y[n-1+i*n]))+g*g*PetscRealPart(Y[i+(n-1)*n]*PetscConj(Y[i+(n-1)*n]));
+    errest = PetscSqrtReal(err2);
+    PetscCall(LMEMonitor(lme,*totalits+its,errest));
+    if (errest<lme->tol || (breakdown && breakdownw)) conv = PETSC_TRUE;
+    else if (breakdown || breakdownw || n==m || *totalits+its>=lme->max_it) *fail = PETSC_TRUE;
+  }
+
+  if (conv) {
+    lme->errest += errest;
+    /* Y = Us*Vt, X = (V*Us)*(W*Vt')' */
+    PetscCall(LMEDenseRankSVD(lme,n,Y,n,Us,n,&rank));
+    PetscCall(PetscInfo(lme,"Rank of the projected solution = %" PetscInt_FMT "\n",rank));
+    if (*col) {
+      PetscCall(BVResize(*X1,*col+rank,PETSC_TRUE));
+      PetscCall(BVResize(*X2,*col+rank,PETSC_TRUE));
+    } else {
+      PetscCall(BVDuplicateResize(C1,rank,X1));
+      PetscCall(BVDuplicateResize(C2,rank,X2));
+    }
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,*col+rank,NULL,&Q));
+    PetscCall(MatDenseGetArray(Q,&Qarray));
+    for (j=0;j<rank;j++) PetscCall(PetscArraycpy(Qarray+(*col+j)*n,Us+j*n,n));
+    PetscCall(MatDenseRestoreArray(Q,&Qarray));
+    PetscCall(BVSetActiveColumns(lme->V,0,n));
+    PetscCall(BVSetActiveColumns(*X1,*col,*col+rank));
+    PetscCall(BVMult(*X1,1.0,0.0,lme->V,Q));
+    PetscCall(MatDenseGetArray(Q,&Qarray));
+    for (j=0;j<rank;j++) for (i=0;i<n;i++) Qarray[i+(*col+j)*n] = PetscConj(Y[j+i*n]);
+    PetscCall(MatDenseRestoreArray(Q,&Qarray));
+    PetscCall(BVSetActiveColumns(W,0,n));
+    PetscCall(BVSetActiveColumns(*X2,*col,*col+rank));
+    PetscCall(BVMult(*X2,1.0,0.0,W,Q));
+    PetscCall(MatDestroy(&Q));
+    *col += rank;
+  }
+  *totalits += its;
+  PetscCall(PetscFree4(Gt,CC,Y,Us));
+  PetscCall(MatDestroy(&H));
+  PetscCall(MatDestroy(&G));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESolve_Krylov_Sylvester(LME lme)
+{
+  PetscBool      fail;
+  PetscInt       i,k,col=0;
+  Vec            u,v;
+  BV             X1=NULL,X2=NULL,C1,C2,W;
+  Mat            X1t,X2t,C1m,C2m,Bh;
+
+  PetscFunctionBegin;
+  if (lme->X) {  /* the rank of the solution is not known in advance, so it is always created here */
+    PetscCall(PetscInfo(lme,"Discarding the previous solution matrix\n"));
+    PetscCall(MatDestroy(&lme->X));
+  }
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,&C2m));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVSetFromOptions(C1));
+  PetscCall(BVCreateFromMat(C2m,&C2));
+  PetscCall(BVSetFromOptions(C2));
+  PetscCall(BVGetActiveColumns(C1,NULL,&k));
+  PetscCall(BVDuplicateResize(C2,lme->ncv+1,&W));
+  PetscCall(MatCreateHermitianTranspose(lme->B,&Bh));
+  for (i=0;i<k;i++) {
+    PetscCall(BVGetColumn(C1,i,&u));
+    PetscCall(BVGetColumn(C2,i,&v));
+    PetscCall(LMESolve_Krylov_Sylvester_Vec(lme,u,v,W,Bh,C1,C2,&X1,&X2,&col,&fail,&lme->its));
+    PetscCall(BVRestoreColumn(C1,i,&u));
+    PetscCall(BVRestoreColumn(C2,i,&v));
+    if (fail) {
+      lme->reason = LME_DIVERGED_ITS;
+      break;
+    }
+  }
+  if (lme->reason==LME_CONVERGED_ITERATING) lme->reason = LME_CONVERGED_TOL;
+  if (X1) {
+    PetscCall(BVCreateMat(X1,&X1t));
+    PetscCall(BVCreateMat(X2,&X2t));
+    PetscCall(MatCreateLRC(NULL,X1t,NULL,X2t,&lme->X));
+    PetscCall(MatDestroy(&X1t));
+    PetscCall(MatDestroy(&X2t));
+  }
+  PetscCall(MatDestroy(&Bh));
+  PetscCall(BVDestroy(&W));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&C2));
+  PetscCall(BVDestroy(&X1));
+  PetscCall(BVDestroy(&X2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Discrete-time Lyapunov equation A*X*A'-X=-b*b', projected onto the Arnoldi basis V.
+   With A*V = V*H+h*v*e_n', the projected equation is H*Y*H'-Y = -||b||^2*e_1*e_1',
+   and the residual norm of X = V*Y*V' is sqrt(2*|h|^2*||H*Y*e_n||^2+|h|^4*|Y(n,n)|^2)
+*/
+static PetscErrorCode LMESolve_Krylov_DTLyapunov_Vec(LME lme,Vec b,PetscBool fixed,PetscInt rrank,BV C1,BV *X1,PetscInt *col,PetscBool *fail,PetscInt *totalits)
+{
+  PetscInt       i,j,n=0,m,ld,nv,its=0,lrank,rank;
+  PetscReal      bnorm,h,sg,errest=0.0;
+  PetscBool      breakdown=PETSC_FALSE,conv=PETSC_FALSE;
+  PetscScalar    *pH,*CC,*Y,*Us,*Qarray,hy,yn;
+  Mat            H,Q;
+
+  PetscFunctionBegin;
+  *fail = PETSC_FALSE;
+  m  = lme->ncv;
+  ld = m+1;
+  PetscCall(VecNorm(b,NORM_2,&bnorm));
+  PetscCheck(bnorm,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_WRONG,"Cannot process a zero vector in the right-hand side");
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,m,NULL,&H));
+  PetscCall(PetscCalloc3(m*m,&CC,m*m,&Y,m*m,&Us));
+
+  PetscCall(BVSetActiveColumns(lme->V,0,m+1));
+  PetscCall(BVInsertVec(lme->V,0,b));
+  PetscCall(BVScaleColumn(lme->V,0,1.0/bnorm));
+
+  while (!conv && !*fail) {
+    its++;
+    nv = n+1;
+    PetscCall(BVMatArnoldi(lme->V,lme->A,H,n,&nv,&h,&breakdown));
+    n++;
+    if (breakdown) h = 0.0;
+
+    /* solve the projected equation H*Y*H'-Y = -CC */
+    PetscCall(PetscArrayzero(CC,n*n));
+    CC[0] = bnorm*bnorm;
+    PetscCall(MatDenseGetArray(H,&pH));
+    PetscCall(LMEDenseDTLyapunov(lme,n,pH,ld,CC,n,Y,n));
+
+    /* residual norm */
+    sg = 0.0;
+    for (i=0;i<n;i++) {
+      hy = 0.0;
+      for (j=0;j<n;j++) hy += pH[i+j*ld]*Y[j+(n-1)*n];
+      sg += PetscRealPart(hy*PetscConj(hy));
+    }
+    PetscCall(MatDenseRestoreArray(H,&pH));
+    yn = Y[n-1+(n-1)*n];
+    errest = PetscSqrtReal(2.0*h*h*sg+h*h*h*h*PetscRealPart(yn*PetscConj(yn)));
+    PetscCall(LMEMonitor(lme,*totalits+its,errest));
+    if (errest<lme->tol || breakdown) conv = PETSC_TRUE;
+    else if (n==m || *totalits+its>=lme->max_it) *fail = PETSC_TRUE;
+  }
+
+  if (conv) {
+    lme->errest += errest;
+    /* Y = Us*Us' with Us = Q*Sigma^(1/2), obtained from Q*Sigma computed by LMEDenseRankSVD */
+    PetscCall(LMEDenseRankSVD(lme,n,Y,n,Us,n,&lrank));
+    PetscCall(PetscInfo(lme,"Rank of the projected solution = %" PetscInt_FMT "\n",lrank));
+    if (!fixed) {  /* X1 was not set by user, allocate it with rank columns */
+      rank = lrank;
+      if (*col) PetscCall(BVResize(*X1,*col+rank,PETSC_TRUE));
+      else PetscCall(BVDuplicateResize(C1,rank,X1));
+    } else rank = PetscMin(lrank,rrank);
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,*col+rank,NULL,&Q));
+    PetscCall(MatDenseGetArray(Q,&Qarray));
+    for (j=0;j<rank;j++) {
+      sg = 0.0;
+      for (i=0;i<n;i++) sg += PetscRealPart(Us[i+j*n]*PetscConj(Us[i+j*n]));
+      sg = PetscSqrtReal(PetscSqrtReal(sg));
+      for (i=0;i<n;i++) Qarray[i+(*col+j)*n] = Us[i+j*n]/sg;
+    }
+    PetscCall(MatDenseRestoreArray(Q,&Qarray));
+    PetscCall(BVSetActiveColumns(lme->V,0,n));
+    PetscCall(BVSetActiveColumns(*X1,*col,*col+rank));
+    PetscCall(BVMult(*X1,1.0,0.0,lme->V,Q));
+    PetscCall(MatDestroy(&Q));
+    *col += rank;
+  }
+  *totalits += its;
+  PetscCall(PetscFree3(CC,Y,Us));
+  PetscCall(MatDestroy(&H));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESolve_Krylov_DTLyapunov(LME lme)
 {
   PetscBool      fail,fixed = lme->X? PETSC_TRUE: PETSC_FALSE;
   PetscInt       i,k,rank=0,col=0;
@@ -179,7 +584,7 @@ static PetscErrorCode LMESolve_Krylov_Lyapunov(LME lme)
   }
   for (i=0;i<k;i++) {
     PetscCall(BVGetColumn(C1,i,&b));
-    PetscCall(LMESolve_Krylov_Lyapunov_Vec(lme,b,fixed,rank,C1,&X1,&col,&fail,&lme->its));
+    PetscCall(LMESolve_Krylov_DTLyapunov_Vec(lme,b,fixed,rank,C1,&X1,&col,&fail,&lme->its));
     PetscCall(BVRestoreColumn(C1,i,&b));
     if (fail) {
       lme->reason = LME_DIVERGED_ITS;
@@ -200,6 +605,8 @@ SLEPC_EXTERN PetscErrorCode LMECreate_Krylov(LME lme)
 {
   PetscFunctionBegin;
   lme->ops->solve[LME_LYAPUNOV]      = LMESolve_Krylov_Lyapunov;
+  lme->ops->solve[LME_SYLVESTER]     = LMESolve_Krylov_Sylvester;
+  lme->ops->solve[LME_DT_LYAPUNOV]   = LMESolve_Krylov_DTLyapunov;
   lme->ops->setup                    = LMESetUp_Krylov;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
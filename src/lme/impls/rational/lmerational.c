@@ -0,0 +1,447 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SLEPc matrix equation solvers: "eksm" and "rksm"
+
+   Method: Extended and adaptive rational Krylov subspace methods
+
+   Algorithm:
+
+       Project the equation onto a rational Krylov subspace built with
+       rational Arnoldi, A*V*K = V*H, where each step applies either A or
+       (A-s*I)^{-1} to the last vector. The projected matrix V'*A*V is
+       reduced to Hessenberg form and the compressed equation is solved
+       with LMEDenseHessLyapunovChol(). The residual norm is obtained from
+       the last rows of K and H and one extra matrix-vector product.
+
+       EKSM alternates the poles 0 and infinity [1], so that all solves use
+       the same factorization of A. RKSM starts with the same two poles and
+       then chooses each new pole adaptively on the mirror image of the
+       interval spanned by the Ritz values [2].
+
+   References:
+
+       [1] V. Simoncini, "A new iterative method for solving large-scale
+           Lyapunov matrix equations", SIAM J. Sci. Comput. 29(3):1268-1288,
+           2007.
+
+       [2] V. Druskin and V. Simoncini, "Adaptive rational Krylov subspaces
+           for large-scale dynamical systems", Systems Control Lett.
+           60(8):546-560, 2011.
+*/
+
+#include <slepc/private/lmeimpl.h>
+#include <slepcblaslapack.h>
+
+#define NSAMPLE 200   /* number of candidate points for the adaptive poles */
+
+typedef struct {
+  ST        st;         /* spectral transformation for the linear solves */
+  PetscBool adaptive;   /* adaptive poles (RKSM) instead of 0 and infinity (EKSM) */
+} LME_RATIONAL;
+
+static PetscErrorCode LMESetUp_Rational(LME lme)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+  PetscInt       N;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(lme->A,&N,NULL));
+  if (lme->ncv==PETSC_DETERMINE) lme->ncv = PetscMin(50,N);
+  if (lme->max_it==PETSC_DETERMINE) lme->max_it = 100;
+  PetscCall(LMEAllocateSolution(lme,2));
+
+  if (!ctx->st) PetscCall(LMERationalGetST(lme,&ctx->st));
+  PetscCall(PetscObjectTypeCompare((PetscObject)ctx->st,STSINVERT,&flg));
+  PetscCheck(flg,PetscObjectComm((PetscObject)lme),PETSC_ERR_SUP,"This solver requires an ST of type sinvert");
+  PetscCall(STSetMatrices(ctx->st,1,&lme->A));
+  PetscCall(STSetTransform(ctx->st,PETSC_TRUE));
+  PetscCall(STSetShift(ctx->st,0.0));
+  PetscCall(STSetUp(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Chooses the next pole of RKSM as the maximizer of prod|z-s_i|/prod|z-theta_i| on
+   a logarithmic grid of [a,b], where s_i are the finite poles used so far and
+   theta_i are the current Ritz values
+*/
+static PetscErrorCode LMERationalNextPole(PetscInt np,PetscScalar *poles,PetscBool *inf,PetscInt nr,PetscReal *rr,PetscReal *ri,PetscReal a,PetscReal b,PetscScalar *pole)
+{
+  PetscInt  i,l;
+  PetscReal z,val,best=PETSC_MIN_REAL;
+
+  PetscFunctionBegin;
+  *pole = b;
+  for (l=0;l<NSAMPLE;l++) {
+    z = a*PetscPowReal(b/a,(PetscReal)l/(NSAMPLE-1));
+    val = 0.0;
+    for (i=0;i<np;i++) if (!inf[i]) val += PetscLogReal(PetscAbsScalar(z-poles[i]));
+    for (i=0;i<nr;i++) val -= PetscLogReal(PetscHypotReal(z-rr[i],ri[i]));
+    if (val>best) {
+      best  = val;
+      *pole = z;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESolve_Rational_Lyapunov_Vec(LME lme,Vec b,PetscBool fixed,PetscInt rrank,BV C1,BV *X1,PetscInt *col,PetscBool *fail,PetscInt *totalits)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+  PetscInt       i,j,k,n=0,m,ld,lrank,rank,its=0;
+  PetscReal      bnorm,norm,eta=0.0,errest=0.0,a=PETSC_MAX_REAL,bb=0.0,*rr,*ri;
+  PetscBool      lindep,breakdown=PETSC_FALSE,conv=PETSC_FALSE,*inf;
+  PetscScalar    *K,*H,*c,*R,*Hh,*Q,*tau,*work,*r,*U,*P,*P2,*M,*wr,*poles,*Qarray,kappa,sone=1.0,zero=0.0;
+  PetscBLASInt   n_,nrhs,two=2,one=1,lwork,info,*ipiv;
+  Mat            Qm;
+  Vec            v,w;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscScalar    *wi;
+#endif
+
+  PetscFunctionBegin;
+  *fail = PETSC_FALSE;
+  m  = lme->ncv;
+  ld = m+1;
+  PetscCall(PetscBLASIntCast(6*m,&lwork));
+  PetscCall(PetscCalloc5(ld*m,&K,ld*m,&H,m+2,&c,m*(m+2),&R,m*m,&Hh));
+  PetscCall(PetscCalloc5(m*m,&Q,m,&tau,lwork,&work,m,&r,m*m,&U));
+  PetscCall(PetscCalloc5(2*m,&P,2*m,&P2,2*m,&M,m,&wr,m,&poles));
+  PetscCall(PetscMalloc4(m,&inf,m,&ipiv,m,&rr,m,&ri));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc1(m,&wi));
+#endif
+
+  PetscCall(VecNorm(b,NORM_2,&bnorm));
+  PetscCheck(bnorm,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_WRONG,"Cannot process a zero vector in the right-hand side");
+
+  /* set initial vector to b/||b|| */
+  PetscCall(BVSetActiveColumns(lme->V,0,m+2));
+  PetscCall(BVInsertVec(lme->V,0,b));
+  PetscCall(BVScaleColumn(lme->V,0,1.0/bnorm));
+
+  for (j=0;j<m && !conv && !*fail;j++) {
+    its++;
+    n = j+1;
+
+    /* select the pole, the first two are 0 and infinity */
+    if (j<2 || !ctx->adaptive) {
+      inf[j]   = (j%2)? PETSC_TRUE: PETSC_FALSE;
+      poles[j] = 0.0;
+    } else if (bb>a) {
+      inf[j] = PETSC_FALSE;
+      PetscCall(LMERationalNextPole(j,poles,inf,j,rr,ri,a,bb,&poles[j]));
+    } else inf[j] = PETSC_TRUE;  /* no usable estimate of the spectrum */
+
+    /* new basis vector, column j of K and H */
+    if (inf[j]) {
+      PetscCall(BVMatMultColumn(lme->V,lme->A,j));
+      PetscCall(BVOrthogonalizeColumn(lme->V,j+1,H+j*ld,&norm,&lindep));
+      K[j+j*ld] = 1.0;
+    } else {
+      PetscCall(STSetShift(ctx->st,poles[j]));
+      PetscCall(BVGetColumn(lme->V,j,&v));
+      PetscCall(BVGetColumn(lme->V,j+1,&w));
+      PetscCall(STApply(ctx->st,v,w));
+      PetscCall(BVRestoreColumn(lme->V,j,&v));
+      PetscCall(BVRestoreColumn(lme->V,j+1,&w));
+      PetscCall(BVOrthogonalizeColumn(lme->V,j+1,K+j*ld,&norm,&lindep));
+      for (i=0;i<=j+1;i++) H[i+j*ld] = poles[j]*K[i+j*ld];
+      H[j+j*ld] += 1.0;
+    }
+    breakdown = (lindep || norm==0.0)? PETSC_TRUE: PETSC_FALSE;
+    if (breakdown) {  /* invariant subspace, there is no next basis vector */
+      K[n+j*ld] = 0.0;
+      H[n+j*ld] = 0.0;
+    } else PetscCall(BVScaleColumn(lme->V,j+1,1.0/norm));
+
+    /* A*v_{j+1} = V*c+eta*w, with w orthogonal to the basis */
+    kappa = K[n+j*ld];
+    if (!breakdown && kappa!=0.0) {
+      PetscCall(BVMatMultColumn(lme->V,lme->A,j+1));
+      PetscCall(BVOrthogonalizeColumn(lme->V,j+2,c,&eta,NULL));
+    }
+
+    /* T = (H_n-c*kappa*e_n')/K_n and M = [H(n,:)-kappa*c_n*e_n'; -kappa*eta*e_n']/K_n, solved in transposed form */
+    for (k=0;k<n;k++) {
+      for (i=0;i<n;i++) {
+        Hh[k+i*n] = K[i+k*ld];
+        R[k+i*n]  = H[i+k*ld];
+      }
+      R[k+n*n]     = H[n+k*ld];
+      R[k+(n+1)*n] = 0.0;
+    }
+    if (kappa!=0.0) {
+      for (i=0;i<n;i++) R[n-1+i*n] -= c[i]*kappa;
+      R[n-1+n*n]     -= c[n]*kappa;
+      R[n-1+(n+1)*n]  = -eta*kappa;
+    }
+    PetscCall(PetscBLASIntCast(n,&n_));
+    PetscCall(PetscBLASIntCast(n+2,&nrhs));
+    PetscCallBLAS("LAPACKgesv",LAPACKgesv_(&n_,&nrhs,Hh,&n_,ipiv,R,&n_,&info));
+    SlepcCheckLapackInfo("gesv",info);
+    for (k=0;k<n;k++) {
+      for (i=0;i<n;i++) Hh[i+k*n] = R[k+i*n];
+      M[2*k]   = R[k+n*n];
+      M[1+2*k] = R[k+(n+1)*n];
+    }
+
+    /* reduce T to Hessenberg form, T = Q*Hh*Q' */
+    PetscCallBLAS("LAPACKgehrd",LAPACKgehrd_(&n_,&one,&n_,Hh,&n_,tau,work,&lwork,&info));
+    SlepcCheckLapackInfo("gehrd",info);
+    PetscCall(PetscArraycpy(Q,Hh,n*n));
+    PetscCallBLAS("LAPACKorghr",LAPACKorghr_(&n_,&one,&n_,Q,&n_,tau,work,&lwork,&info));
+    SlepcCheckLapackInfo("orghr",info);
+    for (k=0;k<n;k++) for (i=k+2;i<n;i++) Hh[i+k*n] = 0.0;
+
+    /* solve the compressed equation Hh*Y + Y*Hh' = -r*r', with r = ||b||*Q'*e_1 */
+    for (i=0;i<n;i++) r[i] = bnorm*PetscConj(Q[i*n]);
+    PetscCall(LMEDenseHessLyapunovChol(lme,n,Hh,n,1,r,n,U,n,NULL));
+
+    /* residual norm sqrt(2)*||M*Q*U'*U|| */
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&two,&n_,&n_,&sone,M,&two,Q,&n_,&zero,P,&two));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&two,&n_,&n_,&sone,P,&two,U,&n_,&zero,P2,&two));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&two,&n_,&n_,&sone,P2,&two,U,&n_,&zero,P,&two));
+    nrhs = 2*n_;
+    errest = PETSC_SQRT2*BLASnrm2_(&nrhs,P,&one);
+    PetscCall(LMEMonitor(lme,*totalits+its,errest));
+
+    if (breakdown || errest<lme->tol) conv = PETSC_TRUE;
+    else if (*totalits+its>=lme->max_it) *fail = PETSC_TRUE;
+    else if (ctx->adaptive) {
+      /* Ritz values, extend the interval [a,b] that contains their mirror images */
+      PetscCall(PetscArraycpy(R,Hh,n*n));
+#if !defined(PETSC_USE_COMPLEX)
+      PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,R,&n_,wr,wi,NULL,&n_,work,&lwork,&info));
+      for (i=0;i<n;i++) {
+        rr[i] = wr[i];
+        ri[i] = wi[i];
+      }
+#else
+      PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,R,&n_,wr,NULL,&n_,work,&lwork,&info));
+      for (i=0;i<n;i++) {
+        rr[i] = PetscRealPart(wr[i]);
+        ri[i] = PetscImaginaryPart(wr[i]);
+      }
+#endif
+      SlepcCheckLapackInfo("hseqr",info);
+      for (i=0;i<n;i++) {
+        if (rr[i]<0.0) {
+          a  = PetscMin(a,-rr[i]);
+          bb = PetscMax(bb,-rr[i]);
+        }
+      }
+    }
+  }
+  if (!conv) *fail = PETSC_TRUE;
+
+  if (conv) {
+    lme->errest += errest;
+    /* X = V*L*L'*V' with L = Q*U' */
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&n_,&n_,&n_,&sone,Q,&n_,U,&n_,&zero,Hh,&n_));
+    PetscCall(LMEDenseRankSVD(lme,n,Hh,n,U,n,&lrank));
+    PetscCall(PetscInfo(lme,"Rank of the Cholesky factor = %" PetscInt_FMT "\n",lrank));
+    if (!fixed) {  /* X1 was not set by user, allocate it with rank columns */
+      rank = lrank;
+      if (*col) PetscCall(BVResize(*X1,*col+rank,PETSC_TRUE));
+      else PetscCall(BVDuplicateResize(C1,rank,X1));
+    } else rank = PetscMin(lrank,rrank);
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,*col+rank,NULL,&Qm));
+    PetscCall(MatDenseGetArray(Qm,&Qarray));
+    for (j=0;j<rank;j++) PetscCall(PetscArraycpy(Qarray+(*col+j)*n,U+j*n,n));
+    PetscCall(MatDenseRestoreArray(Qm,&Qarray));
+    PetscCall(BVSetActiveColumns(lme->V,0,n));
+    PetscCall(BVSetActiveColumns(*X1,*col,*col+rank));
+    PetscCall(BVMult(*X1,1.0,0.0,lme->V,Qm));
+    PetscCall(MatDestroy(&Qm));
+    *col += rank;
+  }
+  *totalits += its;
+
+  PetscCall(PetscFree5(K,H,c,R,Hh));
+  PetscCall(PetscFree5(Q,tau,work,r,U));
+  PetscCall(PetscFree5(P,P2,M,wr,poles));
+  PetscCall(PetscFree4(inf,ipiv,rr,ri));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscFree(wi));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESolve_Rational_Lyapunov(LME lme)
+{
+  PetscBool      fail,fixed = lme->X? PETSC_TRUE: PETSC_FALSE;
+  PetscInt       i,k,rank=0,col=0;
+  Vec            b;
+  BV             X1=NULL,C1;
+  Mat            X1m,X1t,C1m;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,NULL));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVSetFromOptions(C1));
+  PetscCall(BVGetActiveColumns(C1,NULL,&k));
+  if (fixed) {
+    PetscCall(MatLRCGetMats(lme->X,NULL,&X1m,NULL,NULL));
+    PetscCall(BVCreateFromMat(X1m,&X1));
+    PetscCall(BVSetFromOptions(X1));
+    PetscCall(BVGetActiveColumns(X1,NULL,&rank));
+    rank = rank/k;
+  }
+  for (i=0;i<k;i++) {
+    PetscCall(BVGetColumn(C1,i,&b));
+    PetscCall(LMESolve_Rational_Lyapunov_Vec(lme,b,fixed,rank,C1,&X1,&col,&fail,&lme->its));
+    PetscCall(BVRestoreColumn(C1,i,&b));
+    if (fail) {
+      lme->reason = LME_DIVERGED_ITS;
+      break;
+    }
+  }
+  if (lme->reason==LME_CONVERGED_ITERATING) lme->reason = LME_CONVERGED_TOL;
+  PetscCall(BVCreateMat(X1,&X1t));
+  if (fixed) PetscCall(MatCopy(X1t,X1m,SAME_NONZERO_PATTERN));
+  else PetscCall(MatCreateLRC(NULL,X1t,NULL,NULL,&lme->X));
+  PetscCall(MatDestroy(&X1t));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&X1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMESetFromOptions_Rational(LME lme,PetscOptionItems *PetscOptionsObject)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+
+  PetscFunctionBegin;
+  if (!ctx->st) PetscCall(LMERationalGetST(lme,&ctx->st));
+  PetscCall(STSetFromOptions(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEView_Rational(LME lme,PetscViewer viewer)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer,"  poles: %s\n",ctx->adaptive?"adaptive":"0 and infinity"));
+    if (!ctx->st) PetscCall(LMERationalGetST(lme,&ctx->st));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(STView(ctx->st,viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMERationalGetST_Rational(LME lme,ST *st)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+
+  PetscFunctionBegin;
+  if (!ctx->st) {
+    PetscCall(STCreate(PetscObjectComm((PetscObject)lme),&ctx->st));
+    PetscCall(PetscObjectIncrementTabLevel((PetscObject)ctx->st,(PetscObject)lme,1));
+    PetscCall(STSetOptionsPrefix(ctx->st,((PetscObject)lme)->prefix));
+    PetscCall(STAppendOptionsPrefix(ctx->st,"lme_rational_"));
+    PetscCall(PetscObjectSetOptions((PetscObject)ctx->st,((PetscObject)lme)->options));
+    PetscCall(STSetType(ctx->st,STSINVERT));
+  }
+  *st = ctx->st;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   LMERationalGetST - Retrieve the spectral transformation object (ST) used
+   for the linear solves of the rational Krylov solvers LMEEKSM and LMERKSM.
+
+   Collective
+
+   Input Parameter:
+.  lme - the linear matrix equation solver context
+
+   Output Parameter:
+.  st - the spectral transformation object
+
+   Notes:
+   The ST is of type STSINVERT, and its linear solver can be configured with
+   options such as -lme_rational_st_ksp_type or -lme_rational_st_pc_type.
+
+   With LMEEKSM all solves use the same factorization of A, whereas LMERKSM
+   needs a new factorization for each pole.
+
+   Level: advanced
+
+.seealso: LMESetType()
+@*/
+PetscErrorCode LMERationalGetST(LME lme,ST *st)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscAssertPointer(st,2);
+  PetscUseMethod(lme,"LMERationalGetST_C",(LME,ST*),(lme,st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEReset_Rational(LME lme)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+
+  PetscFunctionBegin;
+  if (ctx->st) PetscCall(STReset(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMEDestroy_Rational(LME lme)
+{
+  LME_RATIONAL   *ctx = (LME_RATIONAL*)lme->data;
+
+  PetscFunctionBegin;
+  PetscCall(STDestroy(&ctx->st));
+  PetscCall(PetscFree(lme->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMERationalGetST_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode LMECreate_Rational(LME lme,PetscBool adaptive)
+{
+  LME_RATIONAL   *ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  lme->data     = (void*)ctx;
+  ctx->adaptive = adaptive;
+
+  lme->ops->solve[LME_LYAPUNOV]      = LMESolve_Rational_Lyapunov;
+  lme->ops->setup                    = LMESetUp_Rational;
+  lme->ops->setfromoptions           = LMESetFromOptions_Rational;
+  lme->ops->view                     = LMEView_Rational;
+  lme->ops->reset                    = LMEReset_Rational;
+  lme->ops->destroy                  = LMEDestroy_Rational;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)lme,"LMERationalGetST_C",LMERationalGetST_Rational));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode LMECreate_EKSM(LME lme)
+{
+  PetscFunctionBegin;
+  PetscCall(LMECreate_Rational(lme,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode LMECreate_RKSM(LME lme)
+{
+  PetscFunctionBegin;
+  PetscCall(LMECreate_Rational(lme,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -223,6 +223,8 @@ PetscErrorCode LMECreate(MPI_Comm comm,LME *outlme)
   lme->ncv             = PETSC_DETERMINE;
   lme->tol             = PETSC_DETERMINE;
   lme->errorifnotconverged = PETSC_FALSE;
+  lme->nini            = 0;
+  lme->IS              = NULL;
 
   lme->numbermonitors  = 0;
 
@@ -421,6 +423,7 @@ PetscErrorCode LMEReset(LME lme)
   PetscCall(MatDestroy(&lme->X));
   PetscCall(BVDestroy(&lme->V));
   PetscCall(VecDestroyVecs(lme->nwork,&lme->work));
+  PetscCall(SlepcBasisDestroy_Private(&lme->nini,&lme->IS));
   lme->nwork = 0;
   lme->setupcalled = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -14,6 +14,59 @@
 #include <slepc/private/lmeimpl.h>     /*I "slepclme.h" I*/
 #include <slepcblaslapack.h>
 
+#define LME_TRSYL_BLOCK 64
+
+/*
+   TrsylRecursive - recursive blocked solution of the triangular Sylvester equation
+   A*X+X*op(B) = C, with op(B)=B if transb="N" or op(B)=B' if transb="C", where A and B
+   are upper (quasi-)triangular. The largest dimension is halved at each level, without
+   splitting 2x2 diagonal blocks, so that most of the work is done in gemm, and blocks
+   of size up to LME_TRSYL_BLOCK are solved with trsyl. On exit, C contains X
+*/
+static PetscErrorCode TrsylRecursive(const char *transb,PetscBLASInt m,PetscBLASInt n,PetscScalar *A,PetscBLASInt lda,PetscScalar *B,PetscBLASInt ldb,PetscScalar *C,PetscBLASInt ldc)
+{
+  PetscBLASInt   m1,m2,n1,n2,ione=1,info;
+  PetscReal      scal;
+  PetscScalar    done=1.0,dmone=-1.0;
+  PetscBool      trans = (transb[0]=='N')? PETSC_FALSE: PETSC_TRUE;
+
+  PetscFunctionBegin;
+  if (!m || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (m<=LME_TRSYL_BLOCK && n<=LME_TRSYL_BLOCK) {
+    PetscCallBLAS("LAPACKtrsyl",LAPACKtrsyl_("N",transb,&ione,&m,&n,A,&lda,B,&ldb,C,&ldc,&scal,&info));
+    SlepcCheckLapackInfo("trsyl",info);
+    PetscCheck(scal==1.0,PETSC_COMM_SELF,PETSC_ERR_SUP,"Current implementation cannot handle scale factor %g",(double)scal);
+  } else if (m>=n) {
+    m1 = m/2;
+#if !defined(PETSC_USE_COMPLEX)
+    if (A[m1+(m1-1)*lda]!=0.0) m1++;
+#endif
+    m2 = m-m1;
+    /* A22*X2+X2*op(B) = C2, C1 = C1-A12*X2, A11*X1+X1*op(B) = C1 */
+    PetscCall(TrsylRecursive(transb,m2,n,A+m1+m1*lda,lda,B,ldb,C+m1,ldc));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&m1,&n,&m2,&dmone,A+m1*lda,&lda,C+m1,&ldc,&done,C,&ldc));
+    PetscCall(TrsylRecursive(transb,m1,n,A,lda,B,ldb,C,ldc));
+  } else {
+    n1 = n/2;
+#if !defined(PETSC_USE_COMPLEX)
+    if (B[n1+(n1-1)*ldb]!=0.0) n1++;
+#endif
+    n2 = n-n1;
+    if (trans) {
+      /* A*X2+X2*B22' = C2, C1 = C1-X2*B12', A*X1+X1*B11' = C1 */
+      PetscCall(TrsylRecursive(transb,m,n2,A,lda,B+n1+n1*ldb,ldb,C+n1*ldc,ldc));
+      PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&m,&n1,&n2,&dmone,C+n1*ldc,&ldc,B+n1*ldb,&ldb,&done,C,&ldc));
+      PetscCall(TrsylRecursive(transb,m,n1,A,lda,B,ldb,C,ldc));
+    } else {
+      /* A*X1+X1*B11 = C1, C2 = C2-X1*B12, A*X2+X2*B22 = C2 */
+      PetscCall(TrsylRecursive(transb,m,n1,A,lda,B,ldb,C,ldc));
+      PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&m,&n2,&n1,&dmone,C,&ldc,B+n1*ldb,&ldb,&done,C+n1*ldc,&ldc));
+      PetscCall(TrsylRecursive(transb,m,n2,A,lda,B+n1+n1*ldb,ldb,C+n1*ldc,ldc));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    LMEDenseRankSVD - given a square matrix A, compute its SVD U*S*V', and determine the
    numerical rank. On exit, U contains U*S and A is overwritten with V'
@@ -212,9 +265,8 @@ static PetscErrorCode CholeskyFactor(PetscInt m,PetscScalar *A,PetscInt lda)
 */
 static PetscErrorCode HessLyapunovChol_LAPACK(PetscInt m,PetscScalar *H,PetscInt ldh,PetscInt k,PetscScalar *B,PetscInt ldb,PetscScalar *U,PetscInt ldu,PetscReal *res)
 {
-  PetscBLASInt   ilo=1,lwork,info,n,kk,lu,lb,ione=1;
+  PetscBLASInt   ilo=1,lwork,info,n,kk,lu,lb;
   PetscInt       i,j;
-  PetscReal      scal;
   PetscScalar    *Q,*C,*W,*Z,*wr,*work,zero=0.0,done=1.0,dmone=-1.0;
 #if !defined(PETSC_USE_COMPLEX)
   PetscScalar    *wi;
@@ -256,9 +308,7 @@ static PetscErrorCode HessLyapunovChol_LAPACK(PetscInt m,PetscScalar *H,PetscInt
   PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&n,&kk,&dmone,Z,&n,Z,&n,&zero,C,&lu));
 
   /* solve triangular Sylvester equation */
-  PetscCallBLAS("LAPACKtrsyl",LAPACKtrsyl_("N","C",&ione,&n,&n,W,&n,W,&n,C,&lu,&scal,&info));
-  SlepcCheckLapackInfo("trsyl",info);
-  PetscCheck(scal==1.0,PETSC_COMM_SELF,PETSC_ERR_SUP,"Current implementation cannot handle scale factor %g",(double)scal);
+  PetscCall(TrsylRecursive("C",n,n,W,n,W,n,C,lu));
 
   /* back-transform C = Q*C*Q' */
   PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&done,Q,&n,C,&n,&zero,W,&n));
@@ -398,9 +448,8 @@ static PetscErrorCode Lyapunov_SLICOT(PetscInt m,PetscScalar *H,PetscInt ldh,Pet
 */
 static PetscErrorCode Lyapunov_LAPACK(PetscInt m,PetscScalar *A,PetscInt lda,PetscScalar *B,PetscInt ldb,PetscScalar *X,PetscInt ldx)
 {
-  PetscBLASInt   sdim,lwork,info,n,lx,lb,ione=1;
+  PetscBLASInt   sdim,lwork,info,n,lx,lb;
   PetscInt       i,j;
-  PetscReal      scal;
   PetscScalar    *Q,*W,*Z,*wr,*work,zero=0.0,done=1.0,dmone=-1.0;
 #if defined(PETSC_USE_COMPLEX)
   PetscReal      *rwork;
@@ -439,9 +488,7 @@ static PetscErrorCode Lyapunov_LAPACK(PetscInt m,PetscScalar *A,PetscInt lda,Pet
   PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&dmone,Z,&n,Q,&n,&zero,X,&lx));
 
   /* solve triangular Sylvester equation */
-  PetscCallBLAS("LAPACKtrsyl",LAPACKtrsyl_("N","C",&ione,&n,&n,W,&n,W,&n,X,&lx,&scal,&info));
-  SlepcCheckLapackInfo("trsyl",info);
-  PetscCheck(scal==1.0,PETSC_COMM_SELF,PETSC_ERR_SUP,"Current implementation cannot handle scale factor %g",(double)scal);
+  PetscCall(TrsylRecursive("C",n,n,W,n,W,n,X,lx));
 
   /* back-transform X = Q*X*Q' */
   PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&done,Q,&n,X,&n,&zero,W,&n));
@@ -514,3 +561,187 @@ PetscErrorCode LMEDenseLyapunov(LME lme,PetscInt m,PetscScalar *A,PetscInt lda,P
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*
+   SchurForm - computes the Schur form T = Q'*A*Q, with T stored in W
+*/
+static PetscErrorCode SchurForm(PetscBLASInt n,PetscScalar *A,PetscInt lda,PetscScalar *W,PetscScalar *Q)
+{
+  PetscBLASInt   sdim,lwork,info;
+  PetscInt       i,j;
+  PetscScalar    *wr,*work;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal      *rwork;
+#else
+  PetscScalar    *wi;
+#endif
+
+  PetscFunctionBegin;
+  lwork = 6*n;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc3(n,&wr,n,&wi,lwork,&work));
+#else
+  PetscCall(PetscMalloc3(n,&wr,lwork,&work,n,&rwork));
+#endif
+  for (j=0;j<n;j++) {
+    for (i=0;i<n;i++) W[i+j*n] = A[i+j*lda];
+  }
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,W,&n,&sdim,wr,wi,Q,&n,work,&lwork,NULL,&info));
+  PetscCall(PetscFree3(wr,wi,work));
+#else
+  PetscCallBLAS("LAPACKgees",LAPACKgees_("V","N",NULL,&n,W,&n,&sdim,wr,Q,&n,work,&lwork,rwork,NULL,&info));
+  PetscCall(PetscFree3(wr,work,rwork));
+#endif
+  SlepcCheckLapackInfo("gees",info);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   LMEDenseSylvester - Computes the solution of a dense continuous-time Sylvester
+   equation.
+
+   Logically Collective
+
+   Input Parameters:
++  lme - linear matrix equation solver context
+.  m   - number of rows and columns of A
+.  n   - number of rows and columns of B
+.  A   - first coefficient matrix
+.  lda - leading dimension of A
+.  B   - second coefficient matrix
+.  ldb - leading dimension of B
+.  C   - right-hand side matrix
+.  ldc - leading dimension of C
+-  ldx - leading dimension of X
+
+   Output Parameter:
+.  X   - the solution
+
+   Note:
+   The Sylvester equation has the form A*X + X*B = C, where A is mxm, B is nxn,
+   and C, X are mxn. It is solved with the Bartels-Stewart algorithm, so A and
+   -B must not have common eigenvalues.
+
+   Level: developer
+
+.seealso: LMEDenseLyapunov(), LMEDenseDTLyapunov(), LMESolve()
+@*/
+PetscErrorCode LMEDenseSylvester(LME lme,PetscInt m,PetscInt n,PetscScalar *A,PetscInt lda,PetscScalar *B,PetscInt ldb,PetscScalar *C,PetscInt ldc,PetscScalar *X,PetscInt ldx)
+{
+  PetscBLASInt   m_,n_,lc;
+  PetscInt       i,j;
+  PetscScalar    *QA,*TA,*QB,*TB,*Z,*Y,zero=0.0,done=1.0;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscValidLogicalCollectiveInt(lme,m,2);
+  PetscValidLogicalCollectiveInt(lme,n,3);
+  PetscAssertPointer(A,4);
+  PetscAssertPointer(B,6);
+  PetscAssertPointer(C,8);
+  PetscAssertPointer(X,10);
+
+  PetscCall(PetscBLASIntCast(m,&m_));
+  PetscCall(PetscBLASIntCast(n,&n_));
+  PetscCall(PetscBLASIntCast(ldc,&lc));
+  PetscCall(PetscMalloc6(m*m,&QA,m*m,&TA,n*n,&QB,n*n,&TB,m*n,&Z,m*n,&Y));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+
+  /* Schur forms of A and B */
+  PetscCall(SchurForm(m_,A,lda,TA,QA));
+  PetscCall(SchurForm(n_,B,ldb,TB,QB));
+
+  /* Y = QA'*C*QB */
+  PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&m_,&n_,&m_,&done,QA,&m_,C,&lc,&zero,Z,&m_));
+  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&m_,&n_,&n_,&done,Z,&m_,QB,&n_,&zero,Y,&m_));
+
+  /* solve triangular Sylvester equation */
+  PetscCall(TrsylRecursive("N",m_,n_,TA,m_,TB,n_,Y,m_));
+
+  /* back-transform X = QA*Y*QB' */
+  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&m_,&n_,&m_,&done,QA,&m_,Y,&m_,&zero,Z,&m_));
+  PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&m_,&n_,&n_,&done,Z,&m_,QB,&n_,&zero,Y,&m_));
+  for (j=0;j<n;j++) {
+    for (i=0;i<m;i++) X[i+j*ldx] = Y[i+j*m];
+  }
+
+  PetscCall(PetscFPTrapPop());
+  PetscCall(PetscFree6(QA,TA,QB,TB,Z,Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   LMEDenseDTLyapunov - Computes the solution of a dense discrete-time Lyapunov
+   equation.
+
+   Logically Collective
+
+   Input Parameters:
++  lme - linear matrix equation solver context
+.  m   - number of rows and columns of A
+.  A   - coefficient matrix
+.  lda - leading dimension of A
+.  B   - right-hand side matrix
+.  ldb - leading dimension of B
+-  ldx - leading dimension of X
+
+   Output Parameter:
+.  X   - the solution
+
+   Notes:
+   The discrete-time Lyapunov (or Stein) equation has the form A*X*A' - X = -B,
+   where all are mxm matrices, and B is symmetric. A must be stable in the
+   discrete-time sense, that is, with all eigenvalues inside the unit disk.
+
+   The solution X = sum_j A^j*B*(A')^j is computed with the squared Smith
+   iteration, which doubles the number of terms of the sum at each step.
+
+   Level: developer
+
+.seealso: LMEDenseLyapunov(), LMEDenseSylvester(), LMESolve()
+@*/
+PetscErrorCode LMEDenseDTLyapunov(LME lme,PetscInt m,PetscScalar *A,PetscInt lda,PetscScalar *B,PetscInt ldb,PetscScalar *X,PetscInt ldx)
+{
+  PetscBLASInt   n,m2,lx,one=1;
+  PetscInt       i,j,k;
+  PetscReal      nx,nt;
+  PetscScalar    *Ak,*W,*T,zero=0.0,done=1.0;
+  PetscBool      conv=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscValidLogicalCollectiveInt(lme,m,2);
+  PetscAssertPointer(A,3);
+  PetscAssertPointer(B,5);
+  PetscAssertPointer(X,7);
+
+  PetscCall(PetscBLASIntCast(m,&n));
+  PetscCall(PetscBLASIntCast(m*m,&m2));
+  PetscCall(PetscBLASIntCast(ldx,&lx));
+  PetscCall(PetscMalloc3(m*m,&Ak,m*m,&W,m*m,&T));
+  for (j=0;j<m;j++) {
+    for (i=0;i<m;i++) {
+      Ak[i+j*m] = A[i+j*lda];
+      X[i+j*ldx] = B[i+j*ldb];
+    }
+  }
+  for (k=0;k<60 && !conv;k++) {
+    /* X = X + Ak*X*Ak', Ak = Ak*Ak */
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&done,Ak,&n,X,&lx,&zero,W,&n));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","C",&n,&n,&n,&done,W,&n,Ak,&n,&zero,T,&n));
+    for (j=0;j<m;j++) {
+      for (i=0;i<m;i++) X[i+j*ldx] += T[i+j*m];
+    }
+    nt = BLASnrm2_(&m2,T,&one);
+    for (nx=0.0,j=0;j<m;j++) nx = SlepcAbs(nx,BLASnrm2_(&n,X+j*ldx,&one));
+    if (nt<=PETSC_MACHINE_EPSILON*nx) conv = PETSC_TRUE;
+    else {
+      PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&n,&n,&done,Ak,&n,Ak,&n,&zero,W,&n));
+      PetscCall(PetscArraycpy(Ak,W,m*m));
+    }
+  }
+  PetscCheck(conv,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"The Smith iteration did not converge, the coefficient matrix may not be stable in the discrete-time sense");
+  PetscCall(PetscFree3(Ak,W,T));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -11,6 +11,9 @@
 #include <slepc/private/lmeimpl.h>  /*I "slepclme.h" I*/
 
 SLEPC_EXTERN PetscErrorCode LMECreate_Krylov(LME);
+SLEPC_EXTERN PetscErrorCode LMECreate_EKSM(LME);
+SLEPC_EXTERN PetscErrorCode LMECreate_RKSM(LME);
+SLEPC_EXTERN PetscErrorCode LMECreate_ADI(LME);
 
 /*@C
   LMERegisterAll - Registers all the matrix functions in the LME package.
@@ -27,6 +30,9 @@ PetscErrorCode LMERegisterAll(void)
   if (LMERegisterAllCalled) PetscFunctionReturn(PETSC_SUCCESS);
   LMERegisterAllCalled = PETSC_TRUE;
   PetscCall(LMERegister(LMEKRYLOV,LMECreate_Krylov));
+  PetscCall(LMERegister(LMEEKSM,LMECreate_EKSM));
+  PetscCall(LMERegister(LMERKSM,LMECreate_RKSM));
+  PetscCall(LMERegister(LMEADI,LMECreate_ADI));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
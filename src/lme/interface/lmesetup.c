@@ -30,6 +30,23 @@ static inline PetscErrorCode LMESetUp_Lyapunov(LME lme)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static inline PetscErrorCode LMESetUp_Sylvester(LME lme)
+{
+  Mat            C1,C2;
+  Vec            dc;
+  PetscInt       m,n,m1,n1;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1,&dc,&C2));
+  PetscCheck(!dc,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_WRONGSTATE,"Sylvester solvers currently require a right-hand side C without diagonal factor");
+  PetscCall(MatGetSize(lme->A,&m,NULL));
+  PetscCall(MatGetSize(lme->B,&n,NULL));
+  PetscCall(MatGetSize(C1,&m1,NULL));
+  PetscCall(MatGetSize(C2,&n1,NULL));
+  PetscCheck(m==m1 && n==n1,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_INCOMP,"The dimensions of the right-hand side C do not match those of A and B");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    LMESetUp - Sets up all the internal data structures necessary for the
    execution of the linear matrix equation solver.
@@ -76,6 +93,7 @@ PetscErrorCode LMESetUp(LME lme)
       break;
     case LME_SYLVESTER:
       LMECheckCoeff(lme,lme->B,"B","Sylvester");
+      PetscCall(LMESetUp_Sylvester(lme));
       break;
     case LME_GEN_LYAPUNOV:
       LMECheckCoeff(lme,lme->D,"D","Generalized Lyapunov");
@@ -86,12 +104,13 @@ PetscErrorCode LMESetUp(LME lme)
       LMECheckCoeff(lme,lme->E,"E","Generalized Sylvester");
       break;
     case LME_DT_LYAPUNOV:
+      PetscCall(LMESetUp_Lyapunov(lme));
       break;
     case LME_STEIN:
       LMECheckCoeff(lme,lme->D,"D","Stein");
       break;
   }
-  PetscCheck(lme->problem_type==LME_LYAPUNOV,PetscObjectComm((PetscObject)lme),PETSC_ERR_SUP,"There is no solver yet for this matrix equation type");
+  PetscCheck(lme->ops->solve[lme->problem_type],PetscObjectComm((PetscObject)lme),PETSC_ERR_SUP,"The specified solver does not support equation type %s",LMEProblemTypes[lme->problem_type]);
 
   /* call specific solver setup */
   PetscUseTypeMethod(lme,setup);
@@ -298,6 +317,9 @@ PetscErrorCode LMEGetRHS(LME lme,Mat *C)
    it is possible to let the solver choose the rank of the solution, by
    setting X to NULL and then calling LMEGetSolution() after LMESolve().
 
+   For Sylvester equations, LMEKRYLOV always chooses the rank, and any
+   matrix provided with this function is replaced by the computed solution.
+
    Level: intermediate
 
 .seealso: LMEGetSolution(), LMESetRHS(), LMESetProblemType(), LMESolve()
@@ -345,6 +367,50 @@ PetscErrorCode LMEGetSolution(LME lme,Mat *X)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   LMESetInitialSpace - Specify a basis of vectors that approximate the range
+   of the solution, so that the solver can use them as an augmentation of the
+   subspace that it generates.
+
+   Collective
+
+   Input Parameters:
++  lme - the linear matrix equation solver context
+.  n   - number of vectors
+-  is  - set of basis vectors of the initial space
+
+   Notes:
+   This is useful when solving a sequence of related equations, such as in
+   EPSLYAPII, where the dominant directions of the previous solution are a good
+   approximation of the range of the new one. In LMEKRYLOV, the Lyapunov
+   equation is first projected onto the initial space augmented with a Krylov
+   subspace of the right-hand side, and the standard method is used only if
+   this projection does not attain the requested tolerance.
+
+   These vectors do not persist from one LMESolve() call to the other, so the
+   initial space should be set every time.
+
+   The vectors do not need to be mutually orthonormal, since they are explicitly
+   orthonormalized internally.
+
+   Level: intermediate
+
+.seealso: LMESolve(), LMESetSolution()
+@*/
+PetscErrorCode LMESetInitialSpace(LME lme,PetscInt n,Vec is[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(lme,LME_CLASSID,1);
+  PetscValidLogicalCollectiveInt(lme,n,2);
+  PetscCheck(n>=0,PetscObjectComm((PetscObject)lme),PETSC_ERR_ARG_OUTOFRANGE,"Argument n cannot be negative");
+  if (n>0) {
+    PetscAssertPointer(is,3);
+    PetscValidHeaderSpecific(*is,VEC_CLASSID,3);
+  }
+  PetscCall(SlepcBasisReference_Private(n,is,&lme->nini,&lme->IS));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    LMEAllocateSolution - Allocate memory storage for common variables such
    as the basis vectors.
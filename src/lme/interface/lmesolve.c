@@ -57,6 +57,7 @@ PetscErrorCode LMESolve(LME lme)
   PetscCall(PetscLogEventEnd(LME_Solve,lme,0,0,0));
 
   PetscCheck(lme->reason,PetscObjectComm((PetscObject)lme),PETSC_ERR_PLIB,"Internal error, solver returned without setting converged reason");
+  PetscCall(SlepcBasisDestroy_Private(&lme->nini,&lme->IS));
 
   PetscCheck(!lme->errorifnotconverged || lme->reason>=0,PetscObjectComm((PetscObject)lme),PETSC_ERR_NOT_CONVERGED,"LMESolve has not converged");
 
@@ -283,6 +284,128 @@ static PetscErrorCode LMEComputeResidualNorm_Lyapunov(LME lme,PetscReal *norm)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   LMEComputeResidualNorm_Factors - Computes the Frobenius norm of L*M' as
+   sqrt(trace((L'*L)*(M'*M))), without forming the product
+*/
+static PetscErrorCode LMEComputeResidualNorm_Factors(BV L,BV M,PetscReal *norm)
+{
+  PetscInt          i,j,q;
+  PetscScalar       tr=0.0;
+  const PetscScalar *g1,*g2;
+  Mat               G1,G2;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetActiveColumns(L,NULL,&q));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,q,q,NULL,&G1));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,q,q,NULL,&G2));
+  PetscCall(BVDot(L,L,G1));
+  PetscCall(BVDot(M,M,G2));
+  PetscCall(MatDenseGetArrayRead(G1,&g1));
+  PetscCall(MatDenseGetArrayRead(G2,&g2));
+  for (j=0;j<q;j++) for (i=0;i<q;i++) tr += g1[i+j*q]*g2[j+i*q];
+  PetscCall(MatDenseRestoreArrayRead(G1,&g1));
+  PetscCall(MatDenseRestoreArrayRead(G2,&g2));
+  *norm = PetscSqrtReal(PetscMax(PetscRealPart(tr),0.0));
+  PetscCall(MatDestroy(&G1));
+  PetscCall(MatDestroy(&G2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   LMEFactorsInsert_Private - Copies the columns of X, scaled by alpha and optionally
+   multiplied by A (or A' if trans is true), to columns from c of L
+*/
+static PetscErrorCode LMEFactorsInsert_Private(BV L,PetscInt c,BV X,Mat A,PetscBool trans,PetscScalar alpha)
+{
+  PetscInt       j,k;
+  Vec            x,y;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetActiveColumns(X,NULL,&k));
+  for (j=0;j<k;j++) {
+    PetscCall(BVGetColumn(X,j,&x));
+    PetscCall(BVGetColumn(L,c+j,&y));
+    if (!A) PetscCall(VecCopy(x,y));
+    else if (trans) PetscCall(MatMultHermitianTranspose(A,x,y));
+    else PetscCall(MatMult(A,x,y));
+    if (alpha!=(PetscScalar)1.0) PetscCall(VecScale(y,alpha));
+    PetscCall(BVRestoreColumn(L,c+j,&y));
+    PetscCall(BVRestoreColumn(X,j,&x));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   LMEComputeResidualNorm_Sylvester - Computes the Frobenius norm of the residual matrix
+   associated with the Sylvester equation, R = A*X1*X2'+X1*(B'*X2)'-C1*C2'
+*/
+static PetscErrorCode LMEComputeResidualNorm_Sylvester(LME lme,PetscReal *norm)
+{
+  PetscInt       k,l;
+  BV             X1,X2,C1,C2,L,M;
+  Mat            X1m,X2m,C1m,C2m;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,&C2m));
+  PetscCall(MatLRCGetMats(lme->X,NULL,&X1m,NULL,&X2m));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVCreateFromMat(C2m,&C2));
+  PetscCall(BVCreateFromMat(X1m,&X1));
+  PetscCall(BVCreateFromMat(X2m,&X2));
+  PetscCall(BVGetActiveColumns(X1,NULL,&k));
+  PetscCall(BVGetActiveColumns(C1,NULL,&l));
+  PetscCall(BVDuplicateResize(X1,2*k+l,&L));
+  PetscCall(BVDuplicateResize(X2,2*k+l,&M));
+  PetscCall(LMEFactorsInsert_Private(L,0,X1,lme->A,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(L,k,X1,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(L,2*k,C1,NULL,PETSC_FALSE,-1.0));
+  PetscCall(LMEFactorsInsert_Private(M,0,X2,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(M,k,X2,lme->B,PETSC_TRUE,1.0));
+  PetscCall(LMEFactorsInsert_Private(M,2*k,C2,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEComputeResidualNorm_Factors(L,M,norm));
+  PetscCall(BVDestroy(&L));
+  PetscCall(BVDestroy(&M));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&C2));
+  PetscCall(BVDestroy(&X1));
+  PetscCall(BVDestroy(&X2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   LMEComputeResidualNorm_DTLyapunov - Computes the Frobenius norm of the residual matrix
+   associated with the discrete-time Lyapunov equation, R = A*X1*X1'*A'-X1*X1'+C1*C1'
+*/
+static PetscErrorCode LMEComputeResidualNorm_DTLyapunov(LME lme,PetscReal *norm)
+{
+  PetscInt       k,l;
+  BV             X1,C1,L,M;
+  Mat            X1m,C1m;
+
+  PetscFunctionBegin;
+  PetscCall(MatLRCGetMats(lme->C,NULL,&C1m,NULL,NULL));
+  PetscCall(MatLRCGetMats(lme->X,NULL,&X1m,NULL,NULL));
+  PetscCall(BVCreateFromMat(C1m,&C1));
+  PetscCall(BVCreateFromMat(X1m,&X1));
+  PetscCall(BVGetActiveColumns(X1,NULL,&k));
+  PetscCall(BVGetActiveColumns(C1,NULL,&l));
+  PetscCall(BVDuplicateResize(X1,2*k+l,&L));
+  PetscCall(BVDuplicateResize(X1,2*k+l,&M));
+  PetscCall(LMEFactorsInsert_Private(L,0,X1,lme->A,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(L,k,X1,NULL,PETSC_FALSE,-1.0));
+  PetscCall(LMEFactorsInsert_Private(L,2*k,C1,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(M,0,X1,lme->A,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(M,k,X1,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEFactorsInsert_Private(M,2*k,C1,NULL,PETSC_FALSE,1.0));
+  PetscCall(LMEComputeResidualNorm_Factors(L,M,norm));
+  PetscCall(BVDestroy(&L));
+  PetscCall(BVDestroy(&M));
+  PetscCall(BVDestroy(&C1));
+  PetscCall(BVDestroy(&X1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    LMEComputeError - Computes the error (based on the residual norm) associated
    with the last equation solved.
@@ -316,6 +439,12 @@ PetscErrorCode LMEComputeError(LME lme,PetscReal *error)
     case LME_LYAPUNOV:
       PetscCall(LMEComputeResidualNorm_Lyapunov(lme,error));
       break;
+    case LME_SYLVESTER:
+      PetscCall(LMEComputeResidualNorm_Sylvester(lme,error));
+      break;
+    case LME_DT_LYAPUNOV:
+      PetscCall(LMEComputeResidualNorm_DTLyapunov(lme,error));
+      break;
     default:
       SETERRQ(PetscObjectComm((PetscObject)lme),PETSC_ERR_SUP,"Not implemented for equation type %s",LMEProblemTypes[lme->problem_type]);
   }
@@ -0,0 +1,129 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test the low-rank ADI solver of LME with a Lyapunov equation.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of grid subdivisions in x dimension.\n"
+  "  -m <m>, where <m> = number of grid subdivisions in y dimension.\n\n";
+
+#include <slepclme.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A,C,C1;
+  LME            lme;
+  PetscReal      tol,errest,error;
+  PetscScalar    *u,*shifts;
+  PetscInt       N,n=10,m,Istart,Iend,II,i,j,ns;
+  PetscBool      flg;
+  LMEType        type;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-m",&m,&flg));
+  if (!flg) m=n;
+  N = n*m;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nLyapunov equation, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid)\n\n",N,n,m));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                       Create the 2-D Laplacian, A
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (II=Istart;II<Iend;II++) {
+    i = II/n; j = II-i*n;
+    if (i>0) PetscCall(MatSetValue(A,II,II-n,1.0,INSERT_VALUES));
+    if (i<m-1) PetscCall(MatSetValue(A,II,II+n,1.0,INSERT_VALUES));
+    if (j>0) PetscCall(MatSetValue(A,II,II-1,1.0,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(A,II,II+1,1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,II,II,-4.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Create a low-rank Mat to store the right-hand side C = C1*C1'
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&C1));
+  PetscCall(MatSetSizes(C1,PETSC_DECIDE,PETSC_DECIDE,N,2));
+  PetscCall(MatSetType(C1,MATDENSE));
+  PetscCall(MatGetOwnershipRange(C1,&Istart,&Iend));
+  PetscCall(MatDenseGetArray(C1,&u));
+  for (i=Istart;i<Iend;i++) {
+    if (i<N/2) u[i-Istart] = 1.0;
+    if (i==0) u[i+Iend-2*Istart] = -2.0;
+    if (i==1) u[i+Iend-2*Istart] = -1.0;
+    if (i==2) u[i+Iend-2*Istart] = -1.0;
+  }
+  PetscCall(MatDenseRestoreArray(C1,&u));
+  PetscCall(MatAssemblyBegin(C1,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C1,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateLRC(NULL,C1,NULL,NULL,&C));
+  PetscCall(MatDestroy(&C1));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                Create the solver and solve the equation
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(LMECreate(PETSC_COMM_WORLD,&lme));
+  PetscCall(LMESetProblemType(lme,LME_LYAPUNOV));
+  PetscCall(LMESetCoefficients(lme,A,NULL,NULL,NULL));
+  PetscCall(LMESetRHS(lme,C));
+  PetscCall(LMESetType(lme,LMEADI));
+  PetscCall(LMESetErrorIfNotConverged(lme,PETSC_TRUE));
+  PetscCall(LMESetFromOptions(lme));
+
+  PetscCall(LMEGetType(lme,&type));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Solver being used: %s\n",type));
+
+  PetscCall(LMESolve(lme));
+  PetscCall(LMEADIGetShifts(lme,&ns,&shifts));
+  for (i=0,flg=PETSC_TRUE;i<ns;i++) if (PetscRealPart(shifts[i])>=0.0) flg = PETSC_FALSE;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," The ADI shifts are %sin the left half plane\n",flg?"":"not "));
+  PetscCall(PetscFree(shifts));
+  PetscCall(LMEGetTolerances(lme,&tol,NULL));
+  PetscCall(LMEGetErrorEstimate(lme,&errest));
+  if (errest<2*tol) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Error estimate reported by the solver below the tolerance\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Error estimate reported by the solver: %.4g\n",(double)errest));
+  PetscCall(LMEComputeError(lme,&error));
+  if (error<100*tol) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed residual norm below 100*tol\n\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed residual norm: %.4g\n\n",(double)error));
+
+  /*
+     Free work space
+  */
+  PetscCall(LMEDestroy(&lme));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&C));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      requires: double
+      output_file: output/test4_1.out
+      test:
+         suffix: 1
+      test:
+         suffix: 2
+         args: -lme_adi_nshifts 6 -lme_adi_st_ksp_type preonly -lme_adi_st_pc_type lu
+      test:
+         suffix: 3
+         args: -lme_adi_shifts -0.2,-0.6,-1.8,-5
+
+TEST*/
@@ -0,0 +1,155 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test Sylvester and discrete-time Lyapunov equations in LME.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of grid subdivisions in x dimension.\n"
+  "  -m <m>, where <m> = dimension of the 1-D Laplacian of the Sylvester equation.\n"
+  "  -dtlyap, to solve the discrete-time Lyapunov equation instead.\n\n";
+
+#include <slepclme.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A,B=NULL,C,C1,C2=NULL;
+  LME            lme;
+  PetscReal      tol,errest,error;
+  PetscScalar    *u;
+  PetscInt       N,n=10,m=30,Istart,Iend,II,i,j;
+  PetscBool      dtlyap=PETSC_FALSE;
+  LMEProblemType ptype;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-dtlyap",&dtlyap,NULL));
+  N = n*n;
+  if (dtlyap) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nDiscrete-time Lyapunov equation, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid)\n\n",N,n,n));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nSylvester equation, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid), M=%" PetscInt_FMT "\n\n",N,n,n,m));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Create the 2-D Laplacian A, scaled and shifted as A/8+I/2 in the
+       discrete-time case, and the 1-D Laplacian B
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (II=Istart;II<Iend;II++) {
+    i = II/n; j = II-i*n;
+    if (i>0) PetscCall(MatSetValue(A,II,II-n,1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,II,II+n,1.0,INSERT_VALUES));
+    if (j>0) PetscCall(MatSetValue(A,II,II-1,1.0,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(A,II,II+1,1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,II,II,-4.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  if (dtlyap) {
+    PetscCall(MatScale(A,0.125));
+    PetscCall(MatShift(A,0.5));
+  } else {
+    PetscCall(MatCreate(PETSC_COMM_WORLD,&B));
+    PetscCall(MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,m,m));
+    PetscCall(MatSetFromOptions(B));
+    PetscCall(MatGetOwnershipRange(B,&Istart,&Iend));
+    for (i=Istart;i<Iend;i++) {
+      if (i>0) PetscCall(MatSetValue(B,i,i-1,1.0,INSERT_VALUES));
+      if (i<m-1) PetscCall(MatSetValue(B,i,i+1,2.0,INSERT_VALUES));
+      PetscCall(MatSetValue(B,i,i,-5.0,INSERT_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY));
+  }
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+       Create a low-rank Mat to store the right-hand side C = C1*C2'
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&C1));
+  PetscCall(MatSetSizes(C1,PETSC_DECIDE,PETSC_DECIDE,N,2));
+  PetscCall(MatSetType(C1,MATDENSE));
+  PetscCall(MatGetOwnershipRange(C1,&Istart,&Iend));
+  PetscCall(MatDenseGetArray(C1,&u));
+  for (i=Istart;i<Iend;i++) {
+    if (i<N/2) u[i-Istart] = 1.0;
+    if (i==0) u[i+Iend-2*Istart] = -2.0;
+    if (i==1) u[i+Iend-2*Istart] = -1.0;
+    if (i==2) u[i+Iend-2*Istart] = -1.0;
+  }
+  PetscCall(MatDenseRestoreArray(C1,&u));
+  PetscCall(MatAssemblyBegin(C1,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C1,MAT_FINAL_ASSEMBLY));
+  if (!dtlyap) {
+    PetscCall(MatCreate(PETSC_COMM_WORLD,&C2));
+    PetscCall(MatSetSizes(C2,PETSC_DECIDE,PETSC_DECIDE,m,2));
+    PetscCall(MatSetType(C2,MATDENSE));
+    PetscCall(MatGetOwnershipRange(C2,&Istart,&Iend));
+    PetscCall(MatDenseGetArray(C2,&u));
+    for (i=Istart;i<Iend;i++) {
+      u[i-Istart] = 1.0;
+      u[i+Iend-2*Istart] = (i%2)? -1.0: 1.0;
+    }
+    PetscCall(MatDenseRestoreArray(C2,&u));
+    PetscCall(MatAssemblyBegin(C2,MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(C2,MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(MatCreateLRC(NULL,C1,NULL,C2,&C));
+  PetscCall(MatDestroy(&C1));
+  PetscCall(MatDestroy(&C2));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                Create the solver and solve the equation
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(LMECreate(PETSC_COMM_WORLD,&lme));
+  PetscCall(LMESetProblemType(lme,dtlyap? LME_DT_LYAPUNOV: LME_SYLVESTER));
+  PetscCall(LMESetCoefficients(lme,A,B,NULL,NULL));
+  PetscCall(LMESetRHS(lme,C));
+  PetscCall(LMESetErrorIfNotConverged(lme,PETSC_TRUE));
+  PetscCall(LMESetFromOptions(lme));
+  PetscCall(LMEGetProblemType(lme,&ptype));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Equation type: %s\n",LMEProblemTypes[ptype]));
+
+  PetscCall(LMESolve(lme));
+  PetscCall(LMEGetTolerances(lme,&tol,NULL));
+  PetscCall(LMEGetErrorEstimate(lme,&errest));
+  if (errest<2*tol) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Error estimate reported by the solver below the tolerance\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Error estimate reported by the solver: %.4g\n",(double)errest));
+  PetscCall(LMEComputeError(lme,&error));
+  if (error<100*tol) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed residual norm below 100*tol\n\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed residual norm: %.4g\n\n",(double)error));
+
+  /*
+     Free work space
+  */
+  PetscCall(LMEDestroy(&lme));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&C));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      requires: double
+
+   test:
+      suffix: 2
+      args: -dtlyap -lme_ncv 60
+      requires: double
+
+TEST*/
@@ -25,6 +25,30 @@
 
 #include <slepc/private/mfnimpl.h>
 
+#if defined(PETSC_HAVE_CUDA)
+/*
+   MFNExpokitCreateDenseMatCUDA - Same as MFN_CreateDenseMat() but with a matrix
+   that lives on the GPU
+*/
+static PetscErrorCode MFNExpokitCreateDenseMatCUDA(PetscInt k,Mat *A)
+{
+  PetscBool      create=PETSC_FALSE;
+  PetscInt       m,n;
+
+  PetscFunctionBegin;
+  if (!*A) create=PETSC_TRUE;
+  else {
+    PetscCall(MatGetSize(*A,&m,&n));
+    if (m!=k || n!=k) {
+      PetscCall(MatDestroy(A));
+      create=PETSC_TRUE;
+    }
+  }
+  if (create) PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,k,k,NULL,A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 static PetscErrorCode MFNSetUp_Expokit(MFN mfn)
 {
   PetscInt       N;
@@ -51,7 +75,12 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
   const PetscScalar *pK;
   PetscReal         anorm,avnorm,tol,err_loc,rndoff,t_out,t_new,t_now,t_step;
   PetscReal         xm,fact,s,p1,p2,beta,beta2,gamma,delta;
-  PetscBool         breakdown;
+  PetscBool         breakdown,usecuda=PETSC_FALSE;
+#if defined(PETSC_HAVE_CUDA)
+  PetscScalar       *d_B=NULL,*d_F,pKe[2];
+  const PetscScalar *d_K;
+  VecType           vtype;
+#endif
 
   PetscFunctionBegin;
   m   = mfn->ncv;
@@ -64,6 +93,17 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
   PetscCall(FNGetScale(mfn->fn,&t,&sfactor));
   PetscCall(FNDuplicate(mfn->fn,PetscObjectComm((PetscObject)mfn->fn),&fn));
   PetscCall(FNSetScale(fn,1.0,1.0));
+#if defined(PETSC_HAVE_CUDA)
+  PetscCall(BVGetVecType(mfn->V,&vtype));
+  PetscCall(PetscStrcmpAny(vtype,&usecuda,VECSEQCUDA,VECMPICUDA,""));
+#if !defined(PETSC_HAVE_MAGMA)
+  if (usecuda) {  /* without MAGMA only the Pade method is available on the GPU */
+    PetscInt method;
+    PetscCall(FNGetMethod(fn,&method));
+    if (!method) PetscCall(FNSetMethod(fn,1));
+  }
+#endif
+#endif
   t_out = PetscAbsScalar(t);
   t_now = 0.0;
   PetscCall(MatNorm(mfn->A,NORM_INFINITY,&anorm));
@@ -83,6 +123,9 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
   PetscCall(PetscCalloc2(m+1,&betaF,ld*ld,&B));
   PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,ld,NULL,&H));
   PetscCall(MatDenseGetArray(H,&Harray));
+#if defined(PETSC_HAVE_CUDA)
+  if (usecuda) PetscCallCUDA(cudaMalloc((void**)&d_B,sizeof(PetscScalar)*ld*ld));
+#endif
 
   while (mfn->reason == MFN_CONVERGED_ITERATING) {
     mfn->its++;
@@ -104,31 +147,60 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
       PetscCall(BVRestoreColumn(mfn->V,m+1,&r));
       PetscCall(BVNormColumn(mfn->V,m+1,NORM_2,&avnorm));
     }
-    PetscCall(PetscArraycpy(B,Harray,ld*ld));
+    if (usecuda) {
+#if defined(PETSC_HAVE_CUDA)
+      /* upload the Hessenberg matrix once, the rejection loop below works on the device */
+      PetscCallCUDA(cudaMemcpy(d_B,Harray,sizeof(PetscScalar)*ld*ld,cudaMemcpyHostToDevice));
+      PetscCall(PetscLogCpuToGpu(sizeof(PetscScalar)*ld*ld));
+#endif
+    } else PetscCall(PetscArraycpy(B,Harray,ld*ld));
 
     ireject = 0;
     while (ireject <= mxrej) {
       mx = mb + k1;
-      for (i=0;i<mx;i++) {
-        for (j=0;j<mx;j++) {
-          Harray[i+j*ld] = sgn*B[i+j*ld]*t_step;
+      if (usecuda) {
+#if defined(PETSC_HAVE_CUDA)
+        PetscCall(MFNExpokitCreateDenseMatCUDA(mx,&M));
+        PetscCall(MFNExpokitCreateDenseMatCUDA(mx,&K));
+        PetscCall(MatDenseCUDAGetArrayWrite(M,&d_F));
+        PetscCallCUDA(cudaMemcpy2D(d_F,sizeof(PetscScalar)*mx,d_B,sizeof(PetscScalar)*ld,sizeof(PetscScalar)*mx,mx,cudaMemcpyDeviceToDevice));
+        PetscCall(MatDenseCUDARestoreArrayWrite(M,&d_F));
+        PetscCall(MatScale(M,sgn*t_step));
+#endif
+      } else {
+        for (i=0;i<mx;i++) {
+          for (j=0;j<mx;j++) {
+            Harray[i+j*ld] = sgn*B[i+j*ld]*t_step;
+          }
         }
+        PetscCall(MFN_CreateDenseMat(mx,&M));
+        PetscCall(MFN_CreateDenseMat(mx,&K));
+        PetscCall(MatDenseGetArray(M,&F));
+        for (j=0;j<mx;j++) PetscCall(PetscArraycpy(F+j*mx,Harray+j*ld,mx));
+        PetscCall(MatDenseRestoreArray(M,&F));
       }
-      PetscCall(MFN_CreateDenseMat(mx,&M));
-      PetscCall(MFN_CreateDenseMat(mx,&K));
-      PetscCall(MatDenseGetArray(M,&F));
-      for (j=0;j<mx;j++) PetscCall(PetscArraycpy(F+j*mx,Harray+j*ld,mx));
-      PetscCall(MatDenseRestoreArray(M,&F));
       PetscCall(FNEvaluateFunctionMat(fn,M,K));
 
       if (k1==0) {
         err_loc = tol;
         break;
       } else {
-        PetscCall(MatDenseGetArrayRead(K,&pK));
-        p1 = PetscAbsScalar(beta*pK[m]);
-        p2 = PetscAbsScalar(beta*pK[m+1]*avnorm);
-        PetscCall(MatDenseRestoreArrayRead(K,&pK));
+        if (usecuda) {
+#if defined(PETSC_HAVE_CUDA)
+          /* only the two entries needed for the error estimate go back to the host */
+          PetscCall(MatDenseCUDAGetArrayRead(K,&d_K));
+          PetscCallCUDA(cudaMemcpy(pKe,d_K+m,2*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+          PetscCall(MatDenseCUDARestoreArrayRead(K,&d_K));
+          PetscCall(PetscLogGpuToCpu(2*sizeof(PetscScalar)));
+          p1 = PetscAbsScalar(beta*pKe[0]);
+          p2 = PetscAbsScalar(beta*pKe[1]*avnorm);
+#endif
+        } else {
+          PetscCall(MatDenseGetArrayRead(K,&pK));
+          p1 = PetscAbsScalar(beta*pK[m]);
+          p2 = PetscAbsScalar(beta*pK[m+1]*avnorm);
+          PetscCall(MatDenseRestoreArrayRead(K,&pK));
+        }
         if (p1 > 10*p2) {
           err_loc = p2;
           xm = 1.0/(PetscReal)m;
@@ -150,9 +222,19 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
     }
 
     mx = mb + PetscMax(0,k1-1);
-    PetscCall(MatDenseGetArrayRead(K,&pK));
-    for (j=0;j<mx;j++) betaF[j] = beta*pK[j];
-    PetscCall(MatDenseRestoreArrayRead(K,&pK));
+    if (usecuda) {
+#if defined(PETSC_HAVE_CUDA)
+      PetscCall(MatDenseCUDAGetArrayRead(K,&d_K));
+      PetscCallCUDA(cudaMemcpy(betaF,d_K,mx*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+      PetscCall(MatDenseCUDARestoreArrayRead(K,&d_K));
+      PetscCall(PetscLogGpuToCpu(mx*sizeof(PetscScalar)));
+      for (j=0;j<mx;j++) betaF[j] *= beta;
+#endif
+    } else {
+      PetscCall(MatDenseGetArrayRead(K,&pK));
+      for (j=0;j<mx;j++) betaF[j] = beta*pK[j];
+      PetscCall(MatDenseRestoreArrayRead(K,&pK));
+    }
     PetscCall(BVSetActiveColumns(mfn->V,0,mx));
     PetscCall(BVMultVec(mfn->V,1.0,0.0,x,betaF));
     PetscCall(VecNorm(x,NORM_2,&beta));
@@ -173,6 +255,9 @@ static PetscErrorCode MFNSolve_Expokit(MFN mfn,Vec b,Vec x)
   PetscCall(MatDestroy(&M));
   PetscCall(MatDestroy(&K));
   PetscCall(FNDestroy(&fn));
+#if defined(PETSC_HAVE_CUDA)
+  if (usecuda) PetscCallCUDA(cudaFree(d_B));
+#endif
   PetscCall(MatDenseRestoreArray(H,&Harray));
   PetscCall(MatDestroy(&H));
   PetscCall(PetscFree2(betaF,B));
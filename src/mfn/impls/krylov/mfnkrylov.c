@@ -17,16 +17,35 @@
        Build Arnoldi approximations using f(H) for the Hessenberg matrix H,
        restart by discarding the Krylov basis but keeping H.
 
+       For the exponential, the contribution of previous cycles is represented
+       by its values at the nodes of a quadrature rule for the Cauchy integral
+       [2], so that the cost per restart does not grow with the number of cycles.
+       Each cycle checks the quadrature against f(H_k) of its own block, and H is
+       glued as in [1] if the contour is not adequate.
+
    References:
 
        [1] M. Eiermann and O. Ernst, "A restarted Krylov subspace method
            for the evaluation of matrix functions", SIAM J. Numer. Anal.
            44(6):2481-2504, 2006.
+
+       [2] A. Frommer, S. Guttel, and M. Schweitzer, "Efficient and stable
+           Arnoldi restarts for matrix functions based on quadrature", SIAM
+           J. Matrix Anal. Appl. 35(2):661-683, 2014.
 */
 
 #include <slepc/private/mfnimpl.h>
 #include <slepcblaslapack.h>
 
+typedef struct {
+  Mat       H;       /* Hessenberg matrix of the last MFNSolveTimes() */
+  FN        g;       /* copy of the function, to change the scaling */
+  PetscInt  m;       /* number of Arnoldi vectors */
+  PetscReal beta;    /* norm of the residual of the Arnoldi relation */
+  PetscReal bnorm;   /* norm of the right-hand side */
+  PetscBool valid;   /* the basis in V corresponds to H */
+} MFN_KRYLOV;
+
 static PetscErrorCode MFNSetUp_Krylov(MFN mfn)
 {
   PetscInt       N;
@@ -39,22 +58,196 @@ static PetscErrorCode MFNSetUp_Krylov(MFN mfn)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_COMPLEX)
+#define NQUAD 32   /* number of quadrature nodes */
+
+typedef struct {
+  PetscScalar  alpha,gamma;   /* scaling factors of the function */
+  PetscComplex *z;            /* quadrature nodes */
+  PetscComplex *w;            /* quadrature weights, including exp(z) */
+  PetscComplex *c;            /* contribution of previous cycles at the nodes */
+  PetscComplex *y,*W;         /* work space, y stores the solves at all nodes */
+  PetscScalar  *hp;           /* Hessenberg matrices of previous cycles */
+  PetscReal    *bp;           /* subdiagonal entries joining previous cycles */
+  PetscInt     np;            /* number of previous cycles */
+} MFN_KRYLOV_QUAD;
+
+/*
+   Nodes and weights of the trapezoidal rule on the parabolic contour
+   z(t) = NQUAD*(0.1309-0.1194*t^2+0.25*i*t), t in [-pi,pi], for the Cauchy
+   integral of exp(z), see L.N. Trefethen, J.A.C. Weideman, and T. Schmelzer,
+   "Talbot quadratures and rational approximations", BIT 46:653-670, 2006
+*/
+static PetscErrorCode MFNKrylovQuadCreate(MFN mfn,PetscInt m,MFN_KRYLOV_QUAD *q)
+{
+  PetscInt  i;
+  PetscReal t;
+
+  PetscFunctionBegin;
+  PetscCall(FNGetScale(mfn->fn,&q->alpha,&q->gamma));
+  PetscCall(PetscMalloc5(NQUAD,&q->z,NQUAD,&q->w,NQUAD,&q->c,NQUAD*m,&q->y,m*m,&q->W));
+  for (i=0;i<NQUAD;i++) {
+    t = -PETSC_PI+(i+0.5)*2.0*PETSC_PI/NQUAD;
+    q->z[i] = (PetscReal)NQUAD*PetscCMPLX(0.1309-0.1194*t*t,0.25*t);
+    q->w[i] = PetscExpComplex(q->z[i])*PetscCMPLX(-2.0*0.1194*t,0.25)/PetscCMPLX(0.0,1.0);
+    q->c[i] = 1.0;
+  }
+  q->hp = NULL;
+  q->bp = NULL;
+  q->np = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNKrylovQuadDestroy(MFN_KRYLOV_QUAD *q)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree5(q->z,q->w,q->c,q->y,q->W));
+  PetscCall(PetscFree(q->hp));
+  PetscCall(PetscFree(q->bp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solves (sigma*I-alpha*H)*x=e_1 for an upper Hessenberg matrix H, with Gaussian
+   elimination with partial pivoting; W is a work array of size n*n
+*/
+static PetscErrorCode MFNKrylovHessenbergSolve(PetscInt n,const PetscScalar *H,PetscInt ld,PetscScalar alpha,PetscComplex sigma,PetscComplex *x,PetscComplex *W,PetscBool *singular)
+{
+  PetscInt     i,j,k;
+  PetscComplex t,l;
+
+  PetscFunctionBegin;
+  *singular = PETSC_FALSE;
+  for (j=0;j<n;j++) {
+    for (i=0;i<PetscMin(j+2,n);i++) W[i+j*n] = -alpha*H[i+j*ld];
+    W[j+j*n] += sigma;
+    x[j] = 0.0;
+  }
+  x[0] = 1.0;
+  for (k=0;k<n-1;k++) {
+    if (PetscAbsComplex(W[k+1+k*n])>PetscAbsComplex(W[k+k*n])) {
+      for (j=k;j<n;j++) { t = W[k+j*n]; W[k+j*n] = W[k+1+j*n]; W[k+1+j*n] = t; }
+      t = x[k]; x[k] = x[k+1]; x[k+1] = t;
+    }
+    if (PetscAbsComplex(W[k+k*n])==0.0) { *singular = PETSC_TRUE; PetscFunctionReturn(PETSC_SUCCESS); }
+    l = W[k+1+k*n]/W[k+k*n];
+    for (j=k+1;j<n;j++) W[k+1+j*n] -= l*W[k+j*n];
+    x[k+1] -= l*x[k];
+  }
+  if (PetscAbsComplex(W[n-1+(n-1)*n])==0.0) { *singular = PETSC_TRUE; PetscFunctionReturn(PETSC_SUCCESS); }
+  for (k=n-1;k>=0;k--) {
+    for (j=k+1;j<n;j++) x[k] -= W[k+j*n]*x[j];
+    x[k] /= W[k+k*n];
+  }
+  PetscCall(PetscLogFlops(8.0*n*n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes in f the last block of f(H)*e_1 for the glued Hessenberg matrix, where
+   fk=f(H_k)*e_1 has been computed for the current block H_k. The block is
+   accepted only if the quadrature reproduces fk, otherwise ok=PETSC_FALSE and
+   nothing is modified. The contribution at the nodes is then updated with beta.
+*/
+static PetscErrorCode MFNKrylovQuadUpdate(MFN mfn,MFN_KRYLOV_QUAD *q,PetscInt m,const PetscScalar *H,PetscInt ld,PetscReal beta,const PetscScalar *fk,PetscScalar *f,PetscBool *ok)
+{
+  PetscInt     i,j;
+  PetscComplex *u,*e,*y;
+  PetscReal    nrm=0.0,err=0.0;
+  PetscBool    singular=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc2(m,&u,m,&e));
+  for (i=0;i<NQUAD && !singular;i++) {
+    y = q->y+i*m;
+    PetscCall(MFNKrylovHessenbergSolve(m,H,ld,q->alpha,q->z[i],y,q->W,&singular));
+    for (j=0;j<m;j++) {
+      e[j] += q->w[i]*y[j];
+      u[j] += q->w[i]*q->c[i]*y[j];
+    }
+  }
+  if (!singular) {
+    for (j=0;j<m;j++) {
+      err += PetscSqr(PetscAbsComplex(q->gamma*e[j]-fk[j]));
+      nrm += PetscSqr(PetscAbsScalar(fk[j]));
+    }
+  }
+  *ok = (!singular && PetscSqrtReal(err)<=1e-2*mfn->tol*PetscSqrtReal(nrm))? PETSC_TRUE: PETSC_FALSE;
+  if (*ok) {
+    for (j=0;j<m;j++) {
+#if defined(PETSC_USE_COMPLEX)
+      f[j] = q->gamma*u[j];
+#else
+      f[j] = q->gamma*PetscRealPartComplex(u[j]);  /* nodes appear in conjugate pairs */
+#endif
+    }
+    for (i=0;i<NQUAD;i++) q->c[i] *= q->alpha*beta*q->y[m-1+i*m];
+  }
+  PetscCall(PetscFree2(u,e));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Saves the Hessenberg matrix of the current cycle, needed to glue H if a later
+   cycle cannot use the quadrature
+*/
+static PetscErrorCode MFNKrylovQuadSave(MFN_KRYLOV_QUAD *q,PetscInt m,const PetscScalar *H,PetscInt ld,PetscReal beta)
+{
+  PetscInt j;
+
+  PetscFunctionBegin;
+  PetscCall(PetscRealloc(sizeof(PetscScalar)*m*m*(q->np+1),&q->hp));
+  PetscCall(PetscRealloc(sizeof(PetscReal)*(q->np+1),&q->bp));
+  for (j=0;j<m;j++) PetscCall(PetscArraycpy(q->hp+q->np*m*m+j*m,H+j*ld,m));
+  q->bp[q->np++] = beta;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Glues the Hessenberg matrices of the saved cycles into G
+*/
+static PetscErrorCode MFNKrylovQuadGlue(MFN_KRYLOV_QUAD *q,PetscInt m,Mat *G)
+{
+  PetscInt    i,j,n=q->np*m;
+  PetscScalar *garray;
+
+  PetscFunctionBegin;
+  PetscCall(MFN_CreateDenseMat(n,G));
+  PetscCall(MatDenseGetArray(*G,&garray));
+  PetscCall(PetscArrayzero(garray,n*n));
+  for (i=0;i<q->np;i++) {
+    for (j=0;j<m;j++) PetscCall(PetscArraycpy(garray+i*m+(j+i*m)*n,q->hp+i*m*m+j*m,m));
+    if (i) garray[i*m+(i*m-1)*n] = q->bp[i-1];
+  }
+  PetscCall(MatDenseRestoreArray(*G,&garray));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 static PetscErrorCode MFNSolve_Krylov(MFN mfn,Vec b,Vec x)
 {
-  PetscInt          n=0,m,ld,ldh,j;
+  PetscInt          n=0,m,ld,ldh,j,off;
   PetscBLASInt      m_,inc=1;
   Mat               M,G=NULL,H=NULL;
   Vec               F=NULL;
   PetscScalar       *marray,*farray,*harray;
   const PetscScalar *garray;
   PetscReal         beta,betaold=0.0,nrm=1.0;
-  PetscBool         breakdown;
+  PetscBool         breakdown,quad=PETSC_FALSE,done;
+#if defined(PETSC_HAVE_COMPLEX)
+  MFN_KRYLOV_QUAD   q;
+#endif
 
   PetscFunctionBegin;
+  ((MFN_KRYLOV*)mfn->data)->valid = PETSC_FALSE;
   m  = mfn->ncv;
   ld = m+1;
   PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,m,NULL,&M));
   PetscCall(MatDenseGetArray(M,&marray));
+#if defined(PETSC_HAVE_COMPLEX)
+  PetscCall(PetscObjectTypeCompare((PetscObject)mfn->fn,FNEXP,&quad));
+  if (quad) PetscCall(MFNKrylovQuadCreate(mfn,m,&q));
+#endif
 
   /* set initial vector to b/||b|| */
   PetscCall(BVInsertVec(mfn->V,0,b));
@@ -68,22 +261,185 @@ static PetscErrorCode MFNSolve_Krylov(MFN mfn,Vec b,Vec x)
     /* compute Arnoldi factorization */
     PetscCall(BVMatArnoldi(mfn->V,mfn->transpose_solve?mfn->AT:mfn->A,M,0,&m,&beta,&breakdown));
 
-    /* save previous Hessenberg matrix in G; allocate new storage for H and f(H) */
+    done = PETSC_FALSE;
+#if defined(PETSC_HAVE_COMPLEX)
+    if (quad) {
+      /* evaluate f(H) for the new H only, the previous cycles enter via the quadrature */
+      PetscCall(MFN_CreateVec(m,&F));
+      PetscCall(MFN_CreateDenseMat(m,&H));
+      PetscCall(MatDenseGetArray(H,&harray));
+      for (j=0;j<m;j++) PetscCall(PetscArraycpy(harray+j*m,marray+j*ld,m));
+      PetscCall(MatDenseRestoreArray(H,&harray));
+      if (mfn->its==1) PetscCall(MatPropagateSymmetryOptions(mfn->A,H));
+      PetscCall(FNEvaluateFunctionMatVec(mfn->fn,H,F));
+      PetscCall(VecGetArray(F,&farray));
+      PetscCall(MFNKrylovQuadUpdate(mfn,&q,m,marray,ld,beta,farray,farray,&done));
+      PetscCall(VecRestoreArray(F,&farray));
+      if (done) {
+        if (m==mfn->ncv) PetscCall(MFNKrylovQuadSave(&q,m,marray,ld,beta));
+      } else {
+        PetscCall(PetscInfo(mfn,"Quadrature not accurate enough in restart %" PetscInt_FMT ", keeping the full Hessenberg matrix\n",mfn->its));
+        if (mfn->its>1) PetscCall(MFNKrylovQuadGlue(&q,mfn->ncv,&G));
+        else done = PETSC_TRUE;  /* f(H) has been computed already */
+        PetscCall(MFNKrylovQuadDestroy(&q));
+        quad = PETSC_FALSE;
+      }
+    }
+#endif
+
+    if (!done) {
+      /* save previous Hessenberg matrix in G; allocate new storage for H and f(H) */
+      if (mfn->its>1 && !G) { G = H; H = NULL; }
+      ldh = n+m;
+      PetscCall(MFN_CreateVec(ldh,&F));
+      PetscCall(MFN_CreateDenseMat(ldh,&H));
+
+      /* glue together the previous H and the new H obtained with Arnoldi */
+      PetscCall(MatDenseGetArray(H,&harray));
+      for (j=0;j<m;j++) PetscCall(PetscArraycpy(harray+n+(j+n)*ldh,marray+j*ld,m));
+      if (mfn->its>1) {
+        PetscCall(MatDenseGetArrayRead(G,&garray));
+        for (j=0;j<n;j++) PetscCall(PetscArraycpy(harray+j*ldh,garray+j*n,n));
+        PetscCall(MatDenseRestoreArrayRead(G,&garray));
+        PetscCall(MatDestroy(&G));
+        harray[n+(n-1)*ldh] = betaold;
+      }
+      PetscCall(MatDenseRestoreArray(H,&harray));
+
+      if (mfn->its==1) {
+        /* set symmetry flag of H from A */
+        PetscCall(MatPropagateSymmetryOptions(mfn->A,H));
+      }
+
+      /* evaluate f(H) */
+      PetscCall(FNEvaluateFunctionMatVec(mfn->fn,H,F));
+      off = n;
+    } else off = 0;
+
+    /* x += ||b||*V*f(H)*e_1 */
+    PetscCall(VecGetArray(F,&farray));
+    PetscCall(PetscBLASIntCast(m,&m_));
+    nrm = BLASnrm2_(&m_,farray+off,&inc);   /* relative norm of the update ||u||/||b|| */
+    PetscCall(MFNMonitor(mfn,mfn->its,nrm));
+    for (j=0;j<m;j++) farray[j+off] *= mfn->bnorm;
+    PetscCall(BVSetActiveColumns(mfn->V,0,m));
+    PetscCall(BVMultVec(mfn->V,1.0,1.0,x,farray+off));
+    PetscCall(VecRestoreArray(F,&farray));
+
+    /* check convergence */
+    if (mfn->its >= mfn->max_it) mfn->reason = MFN_DIVERGED_ITS;
+    if (mfn->its>1) {
+      if (m<mfn->ncv || breakdown || beta==0.0 || nrm<mfn->tol) mfn->reason = MFN_CONVERGED_TOL;
+    }
+
+    /* restart with vector v_{m+1} */
+    if (mfn->reason == MFN_CONVERGED_ITERATING) {
+      PetscCall(BVCopyColumn(mfn->V,m,0));
+      n += m;
+      betaold = beta;
+    }
+  }
+
+#if defined(PETSC_HAVE_COMPLEX)
+  if (quad) PetscCall(MFNKrylovQuadDestroy(&q));
+#endif
+  PetscCall(MatDestroy(&H));
+  PetscCall(MatDestroy(&G));
+  PetscCall(VecDestroy(&F));
+  PetscCall(MatDenseRestoreArray(M,&marray));
+  PetscCall(MatDestroy(&M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Block variant for X=f(A)*B. The block Arnoldi process builds V with ncv blocks of
+   p columns, multiplying A times a whole block at once and orthogonalizing it with
+   the block orthogonalization method of the BV. The restart glues the block
+   Hessenberg matrices, with the coupling block in place of beta.
+*/
+static PetscErrorCode MFNSolveMat_Krylov(MFN mfn,Mat B,Mat X)
+{
+  PetscInt          n=0,m,p,mp,ld,ldh,ldr,i,j,r,N;
+  BV                V,W;
+  Mat               R,H=NULL,G=NULL,FH=NULL;
+  Vec               v,x;
+  PetscScalar       *harray,*R0,*Sold,*C,*fh;
+  const PetscScalar *rarray,*garray;
+  PetscReal         nrm,hnrm,snrm;
+  PetscBool         breakdown;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(B,&N,&p));
+  m  = PetscMax(1,PetscMin(mfn->ncv,N/p));
+  ld = (m+1)*p;
+  PetscCall(BVDuplicateResize(mfn->V,ld,&V));
+  PetscCall(BVDuplicateResize(mfn->V,p,&W));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,ld,NULL,&R));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  PetscCall(PetscCalloc3(p*p,&R0,p*p,&Sold,m*p*p,&C));
+
+  /* initial block, B = V_0*R0 */
+  for (i=0;i<p;i++) {
+    PetscCall(MatDenseGetColumnVecRead(B,i,&v));
+    PetscCall(BVInsertVec(V,i,v));
+    PetscCall(MatDenseRestoreColumnVecRead(B,i,&v));
+  }
+  PetscCall(BVSetActiveColumns(V,0,p));
+  PetscCall(BVOrthogonalize(V,R));
+  PetscCall(MatDenseGetArrayRead(R,&rarray));
+  for (i=0;i<p;i++) PetscCall(PetscArraycpy(R0+i*p,rarray+i*ldr,p));
+  PetscCall(MatDenseRestoreArrayRead(R,&rarray));
+  PetscCall(MatZeroEntries(X));
+
+  /* Restart loop */
+  while (mfn->reason == MFN_CONVERGED_ITERATING) {
+    mfn->its++;
+
+    /* compute block Arnoldi factorization, A*V_j = sum_i V_i*R(i,j+1) */
+    PetscCall(MatZeroEntries(R));
+    breakdown = PETSC_FALSE;
+    for (j=0;j<m && !breakdown;j++) {
+      PetscCall(BVSetActiveColumns(V,j*p,(j+1)*p));
+      PetscCall(BVMatMult(V,mfn->A,W));
+      PetscCall(BVSetActiveColumns(V,(j+1)*p,(j+2)*p));
+      PetscCall(BVCopy(W,V));
+      PetscCall(BVOrthogonalize(V,R));
+      PetscCall(MatDenseGetArrayRead(R,&rarray));
+      hnrm = 0.0; snrm = 0.0;
+      for (i=0;i<p;i++) {
+        for (r=0;r<(j+2)*p;r++) {
+          hnrm += PetscSqr(PetscAbsScalar(rarray[r+((j+1)*p+i)*ldr]));
+          if (r>=(j+1)*p) snrm += PetscSqr(PetscAbsScalar(rarray[r+((j+1)*p+i)*ldr]));
+        }
+      }
+      PetscCall(MatDenseRestoreArrayRead(R,&rarray));
+      if (PetscSqrtReal(snrm)<=10*PETSC_MACHINE_EPSILON*PetscSqrtReal(hnrm)) {
+        breakdown = PETSC_TRUE;
+        m = j+1;
+      }
+    }
+    mp = m*p;
+
+    /* save previous block Hessenberg matrix in G; allocate new storage for H and f(H) */
     if (mfn->its>1) { G = H; H = NULL; }
-    ldh = n+m;
-    PetscCall(MFN_CreateVec(ldh,&F));
+    ldh = n+mp;
     PetscCall(MFN_CreateDenseMat(ldh,&H));
+    PetscCall(MFN_CreateDenseMat(ldh,&FH));
 
-    /* glue together the previous H and the new H obtained with Arnoldi */
+    /* glue together the previous H and the new H, which is R(0:mp,p:mp+p) */
     PetscCall(MatDenseGetArray(H,&harray));
-    for (j=0;j<m;j++) PetscCall(PetscArraycpy(harray+n+(j+n)*ldh,marray+j*ld,m));
+    PetscCall(MatDenseGetArrayRead(R,&rarray));
+    for (j=0;j<mp;j++) PetscCall(PetscArraycpy(harray+n+(j+n)*ldh,rarray+(j+p)*ldr,mp));
     if (mfn->its>1) {
       PetscCall(MatDenseGetArrayRead(G,&garray));
       for (j=0;j<n;j++) PetscCall(PetscArraycpy(harray+j*ldh,garray+j*n,n));
       PetscCall(MatDenseRestoreArrayRead(G,&garray));
       PetscCall(MatDestroy(&G));
-      harray[n+(n-1)*ldh] = betaold;
+      for (j=0;j<p;j++) PetscCall(PetscArraycpy(harray+n+(n-p+j)*ldh,Sold+j*p,p));
     }
+    /* coupling block with the next cycle */
+    for (j=0;j<p;j++) PetscCall(PetscArraycpy(Sold+j*p,rarray+mp+(mp+j)*ldr,p));
+    PetscCall(MatDenseRestoreArrayRead(R,&rarray));
     PetscCall(MatDenseRestoreArray(H,&harray));
 
     if (mfn->its==1) {
@@ -92,44 +448,247 @@ static PetscErrorCode MFNSolve_Krylov(MFN mfn,Vec b,Vec x)
     }
 
     /* evaluate f(H) */
-    PetscCall(FNEvaluateFunctionMatVec(mfn->fn,H,F));
+    PetscCall(FNEvaluateFunctionMat(mfn->fn,H,FH));
 
-    /* x += ||b||*V*f(H)*e_1 */
-    PetscCall(VecGetArray(F,&farray));
-    PetscCall(PetscBLASIntCast(m,&m_));
-    nrm = BLASnrm2_(&m_,farray+n,&inc);   /* relative norm of the update ||u||/||b|| */
+    /* X += V*f(H)(n:n+mp,0:p)*R0 */
+    PetscCall(MatDenseGetArray(FH,&fh));
+    nrm = 0.0;
+    for (j=0;j<p;j++) {
+      for (i=0;i<mp;i++) {
+        C[i+j*mp] = 0.0;
+        for (r=0;r<p;r++) C[i+j*mp] += fh[n+i+r*ldh]*R0[r+j*p];
+        nrm += PetscSqr(PetscAbsScalar(C[i+j*mp]));
+      }
+    }
+    PetscCall(MatDenseRestoreArray(FH,&fh));
+    nrm = PetscSqrtReal(nrm)/mfn->bnorm;   /* relative norm of the update ||U||_F/||B||_F */
     PetscCall(MFNMonitor(mfn,mfn->its,nrm));
-    for (j=0;j<m;j++) farray[j+n] *= mfn->bnorm;
-    PetscCall(BVSetActiveColumns(mfn->V,0,m));
-    PetscCall(BVMultVec(mfn->V,1.0,1.0,x,farray+n));
-    PetscCall(VecRestoreArray(F,&farray));
+    PetscCall(BVSetActiveColumns(V,0,mp));
+    for (j=0;j<p;j++) {
+      PetscCall(MatDenseGetColumnVec(X,j,&x));
+      PetscCall(BVMultVec(V,1.0,1.0,x,C+j*mp));
+      PetscCall(MatDenseRestoreColumnVec(X,j,&x));
+    }
 
     /* check convergence */
     if (mfn->its >= mfn->max_it) mfn->reason = MFN_DIVERGED_ITS;
-    if (mfn->its>1) {
-      if (m<mfn->ncv || breakdown || beta==0.0 || nrm<mfn->tol) mfn->reason = MFN_CONVERGED_TOL;
-    }
+    if (breakdown || (mfn->its>1 && nrm<mfn->tol)) mfn->reason = MFN_CONVERGED_TOL;
 
-    /* restart with vector v_{m+1} */
+    /* restart with block V_{m+1} */
     if (mfn->reason == MFN_CONVERGED_ITERATING) {
-      PetscCall(BVCopyColumn(mfn->V,m,0));
-      n += m;
-      betaold = beta;
+      for (i=0;i<p;i++) PetscCall(BVCopyColumn(V,mp+i,i));
+      n += mp;
     }
   }
 
   PetscCall(MatDestroy(&H));
   PetscCall(MatDestroy(&G));
+  PetscCall(MatDestroy(&FH));
+  PetscCall(MatDestroy(&R));
+  PetscCall(BVDestroy(&V));
+  PetscCall(BVDestroy(&W));
+  PetscCall(PetscFree3(R0,Sold,C));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes f(t*H)*e_1 for the leading m x m block of the Hessenberg matrix in M
+   (with leading dimension ld), together with the error estimate beta*|e_m^T*f(t*H)*e_1|
+*/
+static PetscErrorCode MFNKrylovEvaluateFunction(MFN mfn,PetscScalar t,const PetscScalar *marray,PetscInt ld,PetscInt m,PetscReal beta,Mat *H,Vec *F,PetscReal *err)
+{
+  MFN_KRYLOV        *ctx = (MFN_KRYLOV*)mfn->data;
+  PetscInt          j;
+  PetscScalar       *harray,alpha,gamma;
+  const PetscScalar *farray;
+
+  PetscFunctionBegin;
+  if (!ctx->g) PetscCall(FNDuplicate(mfn->fn,PETSC_COMM_SELF,&ctx->g));
+  PetscCall(FNGetScale(mfn->fn,&alpha,&gamma));
+  PetscCall(FNSetScale(ctx->g,t*alpha,gamma));
+  PetscCall(MFN_CreateDenseMat(m,H));
+  PetscCall(MFN_CreateVec(m,F));
+  PetscCall(MatDenseGetArray(*H,&harray));
+  for (j=0;j<m;j++) PetscCall(PetscArraycpy(harray+j*m,marray+j*ld,m));
+  PetscCall(MatDenseRestoreArray(*H,&harray));
+  PetscCall(MatPropagateSymmetryOptions(mfn->A,*H));
+  PetscCall(FNEvaluateFunctionMatVec(ctx->g,*H,*F));
+  PetscCall(VecGetArrayRead(*F,&farray));
+  *err = beta*PetscAbsScalar(farray[m-1]);
+  PetscCall(VecRestoreArrayRead(*F,&farray));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Unrestarted Arnoldi for several values of t. The basis is extended in chunks until
+   the error estimates of all t are below the tolerance, at most up to ncv vectors
+*/
+static PetscErrorCode MFNSolveTimes_Krylov(MFN mfn,PetscInt nt,const PetscScalar *t,Vec b,Vec *x,PetscReal *errest)
+{
+  MFN_KRYLOV        *ctx = (MFN_KRYLOV*)mfn->data;
+  PetscInt          i,j=0,m,ld,step;
+  Mat               M,H=NULL;
+  Vec               F=NULL;
+  PetscScalar       *marray,*farray,*harray;
+  PetscReal         beta=0.0,err,errmax;
+  PetscBool         breakdown=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  ctx->valid = PETSC_FALSE;
+  PetscCall(FNDestroy(&ctx->g));  /* duplicated again in case the function has changed */
+  ld   = mfn->ncv+1;
+  step = PetscMax(1,PetscMin(10,mfn->ncv/3));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ld,mfn->ncv,NULL,&M));
+  PetscCall(MatDenseGetArray(M,&marray));
+
+  /* set initial vector to b/||b|| */
+  PetscCall(BVInsertVec(mfn->V,0,b));
+  PetscCall(BVScaleColumn(mfn->V,0,1.0/mfn->bnorm));
+
+  while (mfn->reason == MFN_CONVERGED_ITERATING) {
+    mfn->its++;
+
+    /* extend the Arnoldi factorization */
+    m = PetscMin(j+step,mfn->ncv);
+    PetscCall(BVMatArnoldi(mfn->V,mfn->A,M,j,&m,&beta,&breakdown));
+    j = m;
+    if (breakdown) beta = 0.0;
+
+    /* error estimates of all t */
+    errmax = 0.0;
+    for (i=0;i<nt;i++) {
+      PetscCall(MFNKrylovEvaluateFunction(mfn,t[i],marray,ld,j,beta,&H,&F,&err));
+      errmax = PetscMax(errmax,err);
+      if (errest) errest[i] = err;
+    }
+    PetscCall(MFNMonitor(mfn,mfn->its,errmax));
+
+    /* check convergence */
+    if (breakdown || errmax<mfn->tol) mfn->reason = MFN_CONVERGED_TOL;
+    else if (j==mfn->ncv || mfn->its>=mfn->max_it) mfn->reason = MFN_DIVERGED_ITS;
+  }
+
+  /* x_i = ||b||*V*f(t_i*H)*e_1 */
+  PetscCall(BVSetActiveColumns(mfn->V,0,j));
+  for (i=0;i<nt;i++) {
+    PetscCall(MFNKrylovEvaluateFunction(mfn,t[i],marray,ld,j,beta,&H,&F,&err));
+    PetscCall(VecGetArray(F,&farray));
+    PetscCall(BVMultVec(mfn->V,mfn->bnorm,0.0,x[i],farray));
+    PetscCall(VecRestoreArray(F,&farray));
+  }
+
+  /* keep the Hessenberg matrix for MFNKrylovEvaluateTime() */
+  PetscCall(MFN_CreateDenseMat(j,&ctx->H));
+  PetscCall(MatDenseGetArray(ctx->H,&harray));
+  for (i=0;i<j;i++) PetscCall(PetscArraycpy(harray+i*j,marray+i*ld,j));
+  PetscCall(MatDenseRestoreArray(ctx->H,&harray));
+  ctx->m     = j;
+  ctx->beta  = beta;
+  ctx->bnorm = mfn->bnorm;
+  ctx->valid = PETSC_TRUE;
+
+  PetscCall(MatDestroy(&H));
   PetscCall(VecDestroy(&F));
   PetscCall(MatDenseRestoreArray(M,&marray));
   PetscCall(MatDestroy(&M));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode MFNKrylovEvaluateTime_Krylov(MFN mfn,PetscScalar t,Vec x,PetscReal *errest)
+{
+  MFN_KRYLOV        *ctx = (MFN_KRYLOV*)mfn->data;
+  Mat               H=NULL;
+  Vec               F=NULL;
+  PetscScalar       *farray;
+  const PetscScalar *harray;
+  PetscReal         err;
+
+  PetscFunctionBegin;
+  PetscCheck(ctx->valid,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_WRONGSTATE,"Must call MFNSolveTimes() first, and the basis must not be modified by another solve");
+  PetscCall(MatDenseGetArrayRead(ctx->H,&harray));
+  PetscCall(MFNKrylovEvaluateFunction(mfn,t,harray,ctx->m,ctx->m,ctx->beta,&H,&F,&err));
+  PetscCall(MatDenseRestoreArrayRead(ctx->H,&harray));
+  PetscCall(BVSetActiveColumns(mfn->V,0,ctx->m));
+  PetscCall(VecGetArray(F,&farray));
+  PetscCall(BVMultVec(mfn->V,ctx->bnorm,0.0,x,farray));
+  PetscCall(VecRestoreArray(F,&farray));
+  if (errest) *errest = err;
+  PetscCall(MatDestroy(&H));
+  PetscCall(VecDestroy(&F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   MFNKrylovEvaluateTime - Evaluates the solution for another value of t from the
+   Krylov basis computed in the last call to MFNSolveTimes().
+
+   Collective
+
+   Input Parameters:
++  mfn - the matrix function context
+-  t   - the new value of t
+
+   Output Parameters:
++  x      - the approximation of f(t*A)*b
+-  errest - (optional) estimate of the error relative to the norm of b
+
+   Notes:
+   This provides dense output between the values of t passed to MFNSolveTimes(),
+   since it only requires the evaluation of the function of the small Hessenberg
+   matrix and one linear combination of the basis vectors, without any product by A.
+   The error estimate is computed as in MFNSolveTimes(); it is not guaranteed to be
+   below the tolerance for values of t outside the range used to build the basis.
+
+   The basis is no longer available after a call to MFNSolve() with the same
+   object.
+
+   Level: advanced
+
+.seealso: MFNSolveTimes()
+@*/
+PetscErrorCode MFNKrylovEvaluateTime(MFN mfn,PetscScalar t,Vec x,PetscReal *errest)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscValidLogicalCollectiveScalar(mfn,t,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscUseMethod(mfn,"MFNKrylovEvaluateTime_C",(MFN,PetscScalar,Vec,PetscReal*),(mfn,t,x,errest));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNReset_Krylov(MFN mfn)
+{
+  MFN_KRYLOV *ctx = (MFN_KRYLOV*)mfn->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ctx->H));
+  PetscCall(FNDestroy(&ctx->g));
+  ctx->valid = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNDestroy_Krylov(MFN mfn)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(mfn->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNKrylovEvaluateTime_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 SLEPC_EXTERN PetscErrorCode MFNCreate_Krylov(MFN mfn)
 {
+  MFN_KRYLOV *ctx;
+
   PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  mfn->data = (void*)ctx;
+
   mfn->ops->solve          = MFNSolve_Krylov;
+  mfn->ops->solvemat       = MFNSolveMat_Krylov;
+  mfn->ops->solvetimes     = MFNSolveTimes_Krylov;
   mfn->ops->setup          = MFNSetUp_Krylov;
+  mfn->ops->reset          = MFNReset_Krylov;
+  mfn->ops->destroy        = MFNDestroy_Krylov;
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNKrylovEvaluateTime_C",MFNKrylovEvaluateTime_Krylov));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -0,0 +1,456 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SLEPc matrix function solver: "ratkrylov"
+
+   Method: Rational Krylov with a cyclic list of poles
+
+   Algorithm:
+
+       Build a rational Krylov basis V with the solves (A-xi_j*I)\v_j, cycling
+       over a small list of poles, so that A*V*K = V*H for two Hessenberg
+       matrices K and H. The approximation is ||b||*V*f(A_m)*e_1, where the
+       Rayleigh quotient A_m = V'*A*V is obtained from K and H with one
+       additional matrix-vector product [1]. With a single pole this is the
+       shift-and-invert Krylov method [2].
+
+       The linear solves are done with an ST of type STSINVERT, and its cache
+       of factorizations is used when there are several poles, so that each
+       pole is factorized only once.
+
+   References:
+
+       [1] S. Guttel, "Rational Krylov approximation of matrix functions:
+           numerical methods and optimal pole selection", GAMM-Mitt.
+           36(1):8-31, 2013.
+
+       [2] J. van den Eshof and M. Hochbruck, "Preconditioning Lanczos
+           approximations to the matrix exponential", SIAM J. Sci. Comput.
+           27(4):1438-1457, 2006.
+*/
+
+#include <slepc/private/mfnimpl.h>
+#include <slepcblaslapack.h>
+
+typedef struct {
+  ST          st;          /* spectral transformation for the linear solves */
+  PetscInt    npoles;      /* number of poles */
+  PetscScalar *poles;      /* the poles, used cyclically */
+  PetscBool   userpoles;   /* the poles have been provided by the user */
+} MFN_RATKRYLOV;
+
+/*
+   Chooses the poles assuming that the spectrum of alpha*A, with alpha the scaling
+   of the function, lies in the left half plane as in stiff diffusion problems.
+   A single pole is placed at 10/alpha, and several poles are spaced
+   logarithmically in the mirror image of the interval [-rho,-1], where rho is
+   an estimate of the norm of alpha*A
+*/
+static PetscErrorCode MFNRatKrylovComputePoles(MFN mfn)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscScalar   alpha;
+  PetscReal     nrm,rho=100.0;
+  PetscInt      i;
+  PetscBool     flg;
+
+  PetscFunctionBegin;
+  PetscCall(FNGetScale(mfn->fn,&alpha,NULL));
+  PetscCheck(alpha!=0.0,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_WRONG,"The scaling factor of the function cannot be zero");
+  if (ctx->npoles==1) ctx->poles[0] = 10.0/alpha;
+  else {
+    PetscCall(MatHasOperation(mfn->A,MATOP_NORM,&flg));
+    if (flg) {
+      PetscCall(MatNorm(mfn->A,NORM_INFINITY,&nrm));
+      rho = PetscMax(PetscAbsScalar(alpha)*nrm,10.0);
+    }
+    for (i=0;i<ctx->npoles;i++) ctx->poles[i] = PetscPowReal(rho,(PetscReal)i/(ctx->npoles-1))/alpha;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNSetUp_RatKrylov(MFN mfn)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscInt      N,nc;
+  PetscBool     flg;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(mfn->A,&N,NULL));
+  if (mfn->ncv==PETSC_DETERMINE) mfn->ncv = PetscMin(30,N);
+  if (mfn->max_it==PETSC_DETERMINE) mfn->max_it = mfn->ncv;
+  PetscCall(MFNAllocateSolution(mfn,2));
+
+  if (!ctx->userpoles) {
+    PetscCall(PetscFree(ctx->poles));
+    PetscCall(PetscMalloc1(ctx->npoles,&ctx->poles));
+    PetscCall(MFNRatKrylovComputePoles(mfn));
+  }
+
+  if (!ctx->st) PetscCall(MFNRatKrylovGetST(mfn,&ctx->st));
+  PetscCall(PetscObjectTypeCompare((PetscObject)ctx->st,STSINVERT,&flg));
+  PetscCheck(flg,PetscObjectComm((PetscObject)mfn),PETSC_ERR_SUP,"This solver requires an ST of type sinvert");
+  PetscCall(STSetMatrices(ctx->st,1,&mfn->A));
+  PetscCall(STSetTransform(ctx->st,PETSC_TRUE));
+  if (ctx->npoles>1) {
+    PetscCall(STSinvertGetShiftCache(ctx->st,&nc));
+    if (nc<ctx->npoles) PetscCall(STSinvertSetShiftCache(ctx->st,ctx->npoles));
+  }
+  PetscCall(STSetShift(ctx->st,ctx->poles[0]));
+  PetscCall(STSetUp(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNSolve_RatKrylov(MFN mfn,Vec b,Vec x)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscInt      i,j,k,n=0,m,ld;
+  PetscBLASInt  n_,info,*ipiv;
+  Mat           Am=NULL;
+  Vec           v,w,F=NULL;
+  PetscScalar   *K,*c,*T,*S,*g,*aarray,*farray,xi;
+  PetscReal     norm,nrm;
+  PetscBool     breakdown=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  m  = PetscMin(mfn->ncv,mfn->max_it);
+  ld = m+1;
+  PetscCall(PetscCalloc5(ld*m,&K,m+2,&c,m*m,&T,m*m,&S,m,&g));
+  PetscCall(PetscMalloc1(m,&ipiv));
+
+  /* set initial vector to b/||b|| */
+  PetscCall(BVInsertVec(mfn->V,0,b));
+  PetscCall(BVScaleColumn(mfn->V,0,1.0/mfn->bnorm));
+
+  for (j=0;j<m && mfn->reason==MFN_CONVERGED_ITERATING;j++) {
+    mfn->its++;
+    n = j+1;
+
+    /* w = (A-xi*I)\v_j, orthogonalized against V to get column j of K */
+    xi = ctx->poles[j%ctx->npoles];
+    PetscCall(STSetShift(ctx->st,xi));
+    PetscCall(BVGetColumn(mfn->V,j,&v));
+    PetscCall(BVGetColumn(mfn->V,j+1,&w));
+    if (mfn->transpose_solve) PetscCall(STApplyTranspose(ctx->st,v,w));
+    else PetscCall(STApply(ctx->st,v,w));
+    PetscCall(BVRestoreColumn(mfn->V,j,&v));
+    PetscCall(BVRestoreColumn(mfn->V,j+1,&w));
+    PetscCall(BVOrthogonalizeColumn(mfn->V,j+1,K+j*ld,&norm,&breakdown));
+    if (!breakdown && norm>0.0) PetscCall(BVScaleColumn(mfn->V,j+1,1.0/norm));
+    else breakdown = PETSC_TRUE;
+
+    /* correction term c = V'*A*v_{j+1}, not needed if V is invariant */
+    if (!breakdown) {
+      PetscCall(BVMatMultColumn(mfn->V,mfn->transpose_solve?mfn->AT:mfn->A,j+1));
+      PetscCall(BVDotColumn(mfn->V,j+2,c));
+    }
+
+    /* solve A_n*K_n = H_n-c*K(n,n-1)*e_n' with H = I+K*diag(xi), in transposed form */
+    for (k=0;k<n;k++) {
+      xi = ctx->poles[k%ctx->npoles];
+      for (i=0;i<n;i++) {
+        T[k+i*n] = K[i+k*ld];
+        S[k+i*n] = xi*K[i+k*ld];
+      }
+      S[k+k*n] += 1.0;
+    }
+    if (!breakdown) for (i=0;i<n;i++) S[n-1+i*n] -= c[i]*K[n+(n-1)*ld];
+    PetscCall(PetscBLASIntCast(n,&n_));
+    PetscCallBLAS("LAPACKgesv",LAPACKgesv_(&n_,&n_,T,&n_,ipiv,S,&n_,&info));
+    SlepcCheckLapackInfo("gesv",info);
+
+    /* evaluate f(A_n)*e_1 */
+    PetscCall(MFN_CreateDenseMat(n,&Am));
+    PetscCall(MFN_CreateVec(n,&F));
+    PetscCall(MatDenseGetArray(Am,&aarray));
+    for (k=0;k<n;k++) for (i=0;i<n;i++) aarray[i+k*n] = S[k+i*n];
+    PetscCall(MatDenseRestoreArray(Am,&aarray));
+    PetscCall(FNEvaluateFunctionMatVec(mfn->fn,Am,F));
+
+    /* relative norm of the change with respect to the previous approximation */
+    PetscCall(VecGetArray(F,&farray));
+    nrm = 0.0;
+    for (i=0;i<n;i++) {
+      nrm += PetscRealPart((farray[i]-g[i])*PetscConj(farray[i]-g[i]));
+      g[i] = farray[i];
+    }
+    PetscCall(VecRestoreArray(F,&farray));
+    nrm = PetscSqrtReal(nrm);
+    mfn->errest = nrm;
+    PetscCall(MFNMonitor(mfn,mfn->its,nrm));
+
+    /* check convergence */
+    if (breakdown || (n>1 && nrm<mfn->tol)) mfn->reason = MFN_CONVERGED_TOL;
+    else if (n==m) mfn->reason = MFN_DIVERGED_ITS;
+  }
+
+  /* x = ||b||*V*f(A_n)*e_1 */
+  for (i=0;i<n;i++) g[i] *= mfn->bnorm;
+  PetscCall(BVSetActiveColumns(mfn->V,0,n));
+  PetscCall(BVMultVec(mfn->V,1.0,0.0,x,g));
+
+  PetscCall(MatDestroy(&Am));
+  PetscCall(VecDestroy(&F));
+  PetscCall(PetscFree5(K,c,T,S,g));
+  PetscCall(PetscFree(ipiv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#define POLEMAX 30
+
+static PetscErrorCode MFNSetFromOptions_RatKrylov(MFN mfn,PetscOptionItems *PetscOptionsObject)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscInt      i,k;
+  PetscBool     flg;
+  PetscScalar   array[POLEMAX];
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"MFN Rational Krylov Options");
+
+    k = POLEMAX;
+    for (i=0;i<k;i++) array[i] = 0;
+    PetscCall(PetscOptionsScalarArray("-mfn_ratkrylov_poles","Poles of the rational Krylov method","MFNRatKrylovSetPoles",array,&k,&flg));
+    if (flg) PetscCall(MFNRatKrylovSetPoles(mfn,k,array));
+
+    PetscCall(PetscOptionsInt("-mfn_ratkrylov_npoles","Number of poles chosen automatically","MFNRatKrylovSetPoles",ctx->npoles,&k,&flg));
+    if (flg) PetscCall(MFNRatKrylovSetPoles(mfn,k,NULL));
+
+  PetscOptionsHeadEnd();
+
+  if (!ctx->st) PetscCall(MFNRatKrylovGetST(mfn,&ctx->st));
+  PetscCall(STSetFromOptions(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNView_RatKrylov(MFN mfn,PetscViewer viewer)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscBool     isascii;
+  PetscInt      i;
+  char          str[50];
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    if (ctx->poles) {
+      PetscCall(PetscViewerASCIIPrintf(viewer,"  %s poles: ",ctx->userpoles?"user-provided":"automatic"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_FALSE));
+      for (i=0;i<ctx->npoles;i++) {
+        PetscCall(SlepcSNPrintfScalar(str,sizeof(str),ctx->poles[i],PETSC_FALSE));
+        PetscCall(PetscViewerASCIIPrintf(viewer,"%s%s",str,(i<ctx->npoles-1)?",":""));
+      }
+      PetscCall(PetscViewerASCIIPrintf(viewer,"\n"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_TRUE));
+    } else PetscCall(PetscViewerASCIIPrintf(viewer,"  number of poles: %" PetscInt_FMT "\n",ctx->npoles));
+    if (!ctx->st) PetscCall(MFNRatKrylovGetST(mfn,&ctx->st));
+    PetscCall(PetscViewerASCIIPushTab(viewer));
+    PetscCall(STView(ctx->st,viewer));
+    PetscCall(PetscViewerASCIIPopTab(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNRatKrylovSetPoles_RatKrylov(MFN mfn,PetscInt np,PetscScalar *poles)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscInt      i;
+
+  PetscFunctionBegin;
+  if (np==PETSC_DECIDE || np==PETSC_DETERMINE) np = 1;
+  PetscCheck(np>0,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_OUTOFRANGE,"Number of poles must be positive");
+  PetscCall(PetscFree(ctx->poles));
+  ctx->npoles    = np;
+  ctx->userpoles = poles? PETSC_TRUE: PETSC_FALSE;
+  if (poles) {
+    PetscCall(PetscMalloc1(np,&ctx->poles));
+    for (i=0;i<np;i++) ctx->poles[i] = poles[i];
+  }
+  mfn->setupcalled = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   MFNRatKrylovSetPoles - Sets the poles to be used in the rational Krylov method.
+
+   Collective
+
+   Input Parameters:
++  mfn   - the matrix function context
+.  np    - number of poles
+-  poles - array of poles, or NULL to choose np poles automatically
+
+   Options Database Keys:
++  -mfn_ratkrylov_poles  - Sets the list of poles
+-  -mfn_ratkrylov_npoles - Sets the number of poles chosen automatically
+
+   Notes:
+   The poles are used cyclically, and each one requires a factorization of
+   A-xi*I. With a single pole (the default) the method is equivalent to
+   shift-and-invert Krylov. When there are several poles, the factorizations
+   are kept with STSinvertSetShiftCache(), so that each one is computed once.
+
+   If poles is NULL, they are computed in MFNSetUp() from the scaling
+   alpha of the function (see FNSetScale()), assuming that the spectrum of
+   alpha*A lies in the left half plane, as is the case for exp(-t*A) with a
+   discretized diffusion operator A. A single pole is placed at 10/alpha, and
+   several poles are spaced logarithmically between 1/alpha and
+   norm(alpha*A)/alpha.
+
+   In the case of real scalars, complex poles are not allowed.
+
+   Level: advanced
+
+.seealso: MFNRatKrylovGetPoles(), MFNRatKrylovGetST()
+@*/
+PetscErrorCode MFNRatKrylovSetPoles(MFN mfn,PetscInt np,PetscScalar poles[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(mfn,np,2);
+  PetscTryMethod(mfn,"MFNRatKrylovSetPoles_C",(MFN,PetscInt,PetscScalar*),(mfn,np,poles));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNRatKrylovGetPoles_RatKrylov(MFN mfn,PetscInt *np,PetscScalar **poles)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+  PetscInt      i;
+
+  PetscFunctionBegin;
+  if (np) *np = ctx->npoles;
+  if (poles) {
+    *poles = NULL;
+    if (ctx->poles) {
+      PetscCall(PetscMalloc1(ctx->npoles,poles));
+      for (i=0;i<ctx->npoles;i++) (*poles)[i] = ctx->poles[i];
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   MFNRatKrylovGetPoles - Gets the poles used in the rational Krylov method.
+
+   Not Collective
+
+   Input Parameter:
+.  mfn - the matrix function context
+
+   Output Parameters:
++  np    - number of poles
+-  poles - array of poles
+
+   Notes:
+   The user is responsible for deallocating the returned array. If the poles
+   are chosen automatically, the array is NULL until MFNSetUp() is called.
+
+   Level: advanced
+
+.seealso: MFNRatKrylovSetPoles()
+@*/
+PetscErrorCode MFNRatKrylovGetPoles(MFN mfn,PetscInt *np,PetscScalar *poles[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscTryMethod(mfn,"MFNRatKrylovGetPoles_C",(MFN,PetscInt*,PetscScalar**),(mfn,np,poles));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNRatKrylovGetST_RatKrylov(MFN mfn,ST *st)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+
+  PetscFunctionBegin;
+  if (!ctx->st) {
+    PetscCall(STCreate(PetscObjectComm((PetscObject)mfn),&ctx->st));
+    PetscCall(PetscObjectIncrementTabLevel((PetscObject)ctx->st,(PetscObject)mfn,1));
+    PetscCall(STSetOptionsPrefix(ctx->st,((PetscObject)mfn)->prefix));
+    PetscCall(STAppendOptionsPrefix(ctx->st,"mfn_ratkrylov_"));
+    PetscCall(PetscObjectSetOptions((PetscObject)ctx->st,((PetscObject)mfn)->options));
+    PetscCall(STSetType(ctx->st,STSINVERT));
+  }
+  *st = ctx->st;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   MFNRatKrylovGetST - Retrieve the spectral transformation object (ST) used
+   for the linear solves of the rational Krylov method.
+
+   Collective
+
+   Input Parameter:
+.  mfn - the matrix function context
+
+   Output Parameter:
+.  st - the spectral transformation object
+
+   Note:
+   The ST is of type STSINVERT, and its linear solver can be configured with
+   options such as -mfn_ratkrylov_st_ksp_type or -mfn_ratkrylov_st_pc_type.
+
+   Level: advanced
+
+.seealso: MFNRatKrylovSetPoles()
+@*/
+PetscErrorCode MFNRatKrylovGetST(MFN mfn,ST *st)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscAssertPointer(st,2);
+  PetscUseMethod(mfn,"MFNRatKrylovGetST_C",(MFN,ST*),(mfn,st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNReset_RatKrylov(MFN mfn)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+
+  PetscFunctionBegin;
+  if (ctx->st) PetscCall(STReset(ctx->st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MFNDestroy_RatKrylov(MFN mfn)
+{
+  MFN_RATKRYLOV *ctx = (MFN_RATKRYLOV*)mfn->data;
+
+  PetscFunctionBegin;
+  PetscCall(STDestroy(&ctx->st));
+  PetscCall(PetscFree(ctx->poles));
+  PetscCall(PetscFree(mfn->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovSetPoles_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovGetPoles_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovGetST_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode MFNCreate_RatKrylov(MFN mfn)
+{
+  MFN_RATKRYLOV *ctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  mfn->data = (void*)ctx;
+  ctx->npoles = 1;
+
+  mfn->ops->solve          = MFNSolve_RatKrylov;
+  mfn->ops->setup          = MFNSetUp_RatKrylov;
+  mfn->ops->setfromoptions = MFNSetFromOptions_RatKrylov;
+  mfn->ops->view           = MFNView_RatKrylov;
+  mfn->ops->reset          = MFNReset_RatKrylov;
+  mfn->ops->destroy        = MFNDestroy_RatKrylov;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovSetPoles_C",MFNRatKrylovSetPoles_RatKrylov));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovGetPoles_C",MFNRatKrylovGetPoles_RatKrylov));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mfn,"MFNRatKrylovGetST_C",MFNRatKrylovGetST_RatKrylov));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -12,6 +12,7 @@
 
 SLEPC_EXTERN PetscErrorCode MFNCreate_Krylov(MFN);
 SLEPC_EXTERN PetscErrorCode MFNCreate_Expokit(MFN);
+SLEPC_EXTERN PetscErrorCode MFNCreate_RatKrylov(MFN);
 
 /*@C
   MFNRegisterAll - Registers all the matrix functions in the MFN package.
@@ -29,6 +30,7 @@ PetscErrorCode MFNRegisterAll(void)
   MFNRegisterAllCalled = PETSC_TRUE;
   PetscCall(MFNRegister(MFNKRYLOV,MFNCreate_Krylov));
   PetscCall(MFNRegister(MFNEXPOKIT,MFNCreate_Expokit));
+  PetscCall(MFNRegister(MFNRATKRYLOV,MFNCreate_RatKrylov));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -126,6 +126,179 @@ PetscErrorCode MFNSolveTranspose(MFN mfn,Vec b,Vec x)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   MFNSolveMat - Solves the matrix function problem for several vectors at once.
+   Given a matrix B, the matrix X = f(A)*B is returned.
+
+   Collective
+
+   Input Parameters:
++  mfn - matrix function context obtained from MFNCreate()
+-  B   - dense matrix whose columns are the right hand side vectors
+
+   Output Parameter:
+.  X   - dense matrix with the solution, of the same size as B
+
+   Notes:
+   The matrices B and X must be different. For the solvers that provide a block
+   variant (currently MFNKRYLOV), a block Krylov subspace is built from all columns
+   of B, so that the products by A are done for a whole block, the orthogonalization
+   takes a few reductions per block, and the function of the (block) Hessenberg
+   matrix is evaluated once for all columns. In this case, the columns of B should
+   be linearly independent, the convergence criterion refers to the Frobenius norm
+   of the update relative to the norm of B, and the basis has ncv blocks of as many
+   vectors as columns in B. Otherwise, MFNSolve() is called for each column.
+
+   Level: intermediate
+
+.seealso: MFNSolve(), MFNSetDimensions()
+@*/
+PetscErrorCode MFNSolveMat(MFN mfn,Mat B,Mat X)
+{
+  PetscInt       j,n,M,N,nx,Mx,Nx;
+  Vec            b,x;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscValidHeaderSpecific(B,MAT_CLASSID,2);
+  PetscValidHeaderSpecific(X,MAT_CLASSID,3);
+  PetscCheckSameComm(mfn,1,B,2);
+  PetscCheckSameComm(mfn,1,X,3);
+  PetscCheck(B!=X,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_IDN,"B and X must be different matrices");
+  PetscCall(MatGetSize(B,&M,&n));
+  PetscCall(MatGetSize(X,&Mx,&nx));
+  PetscCheck(M==Mx && n==nx,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_SIZ,"Matrices B and X must have the same size");
+  mfn->transpose_solve = PETSC_FALSE;
+
+  /* call setup */
+  PetscCall(MFNSetUp(mfn));
+  if (!mfn->ops->solvemat || n==1) {  /* solve one column at a time */
+    for (j=0;j<n;j++) {
+      PetscCall(MatDenseGetColumnVecRead(B,j,&b));
+      PetscCall(MatDenseGetColumnVecWrite(X,j,&x));
+      PetscCall(MFNSolve_Private(mfn,b,x));
+      PetscCall(MatDenseRestoreColumnVecWrite(X,j,&x));
+      PetscCall(MatDenseRestoreColumnVecRead(B,j,&b));
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  mfn->its = 0;
+  PetscCall(MatGetSize(mfn->A,&N,NULL));
+  PetscCheck(M==N,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_SIZ,"Matrix B has %" PetscInt_FMT " rows, should be %" PetscInt_FMT,M,N);
+
+  PetscCall(MFNViewFromOptions(mfn,NULL,"-mfn_view_pre"));
+
+  /* check nonzero right-hand side */
+  PetscCall(MatNorm(B,NORM_FROBENIUS,&mfn->bnorm));
+  PetscCheck(mfn->bnorm,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_WRONG,"Cannot pass a zero B matrix to MFNSolveMat()");
+
+  /* call solver */
+  PetscCall(PetscLogEventBegin(MFN_Solve,mfn,B,X,0));
+  PetscUseTypeMethod(mfn,solvemat,B,X);
+  PetscCall(PetscLogEventEnd(MFN_Solve,mfn,B,X,0));
+
+  PetscCheck(mfn->reason,PetscObjectComm((PetscObject)mfn),PETSC_ERR_PLIB,"Internal error, solver returned without setting converged reason");
+
+  PetscCheck(!mfn->errorifnotconverged || mfn->reason>=0,PetscObjectComm((PetscObject)mfn),PETSC_ERR_NOT_CONVERGED,"MFNSolveMat has not converged");
+
+  /* various viewers */
+  PetscCall(MFNViewFromOptions(mfn,NULL,"-mfn_view"));
+  PetscCall(MFNConvergedReasonViewFromOptions(mfn));
+  PetscCall(MatViewFromOptions(mfn->A,(PetscObject)mfn,"-mfn_view_mat"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   MFNSolveTimes - Solves the matrix function problem for several values of a
+   parameter t. Given a vector b, the vectors x_i = f(t_i*A)*b are returned.
+
+   Collective
+
+   Input Parameters:
++  mfn - matrix function context obtained from MFNCreate()
+.  nt  - number of values of t
+.  t   - the values of t
+-  b   - the right hand side vector
+
+   Output Parameters:
++  x      - array of nt vectors with the solutions, different from b
+-  errest - (optional) array of nt error estimates, relative to the norm of b
+
+   Notes:
+   The values t_i multiply the argument of the function, on top of the scaling
+   factors set with FNSetScale(), so that for the exponential x_i = exp(t_i*A)*b,
+   as required by exponential integrators.
+
+   In MFNKRYLOV, a single Krylov basis is built for all values of t, extending it
+   until the error estimate of every t_i is below the tolerance, with at most ncv
+   vectors, see MFNSetDimensions(). The basis is kept so that the solution can be
+   evaluated later for other values of t without products by A, see
+   MFNKrylovEvaluateTime(). In other solvers, the problem is solved for each t_i
+   separately, and the error estimates are set to the tolerance.
+
+   Level: intermediate
+
+.seealso: MFNSolve(), MFNKrylovEvaluateTime(), FNSetScale()
+@*/
+PetscErrorCode MFNSolveTimes(MFN mfn,PetscInt nt,const PetscScalar t[],Vec b,Vec x[],PetscReal errest[])
+{
+  PetscInt       i;
+  PetscScalar    alpha,gamma;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mfn,MFN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(mfn,nt,2);
+  PetscCheck(nt>0,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_OUTOFRANGE,"The number of values of t must be positive");
+  PetscAssertPointer(t,3);
+  PetscValidHeaderSpecific(b,VEC_CLASSID,4);
+  PetscCheckSameComm(mfn,1,b,4);
+  PetscAssertPointer(x,5);
+  for (i=0;i<nt;i++) {
+    PetscValidHeaderSpecific(x[i],VEC_CLASSID,5);
+    PetscCheck(x[i]!=b,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_IDN,"The solution vectors must be different from b");
+  }
+  mfn->transpose_solve = PETSC_FALSE;
+
+  /* call setup */
+  PetscCall(MFNSetUp(mfn));
+  if (!mfn->ops->solvetimes) {  /* solve for one t at a time */
+    PetscCall(FNGetScale(mfn->fn,&alpha,&gamma));
+    for (i=0;i<nt;i++) {
+      PetscCall(FNSetScale(mfn->fn,t[i]*alpha,gamma));
+      PetscCall(MFNSolve_Private(mfn,b,x[i]));
+      if (errest) errest[i] = mfn->tol;
+    }
+    PetscCall(FNSetScale(mfn->fn,alpha,gamma));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  mfn->its = 0;
+
+  PetscCall(MFNViewFromOptions(mfn,NULL,"-mfn_view_pre"));
+
+  /* check nonzero right-hand side */
+  PetscCall(VecNorm(b,NORM_2,&mfn->bnorm));
+  PetscCheck(mfn->bnorm,PetscObjectComm((PetscObject)mfn),PETSC_ERR_ARG_WRONG,"Cannot pass a zero b vector to MFNSolveTimes()");
+
+  /* call solver */
+  PetscCall(PetscLogEventBegin(MFN_Solve,mfn,b,0,0));
+  PetscCall(VecLockReadPush(b));
+  PetscUseTypeMethod(mfn,solvetimes,nt,t,b,x,errest);
+  PetscCall(VecLockReadPop(b));
+  PetscCall(PetscLogEventEnd(MFN_Solve,mfn,b,0,0));
+
+  PetscCheck(mfn->reason,PetscObjectComm((PetscObject)mfn),PETSC_ERR_PLIB,"Internal error, solver returned without setting converged reason");
+
+  PetscCheck(!mfn->errorifnotconverged || mfn->reason>=0,PetscObjectComm((PetscObject)mfn),PETSC_ERR_NOT_CONVERGED,"MFNSolveTimes has not converged");
+
+  /* various viewers */
+  PetscCall(MFNViewFromOptions(mfn,NULL,"-mfn_view"));
+  PetscCall(MFNConvergedReasonViewFromOptions(mfn));
+  PetscCall(MatViewFromOptions(mfn->A,(PetscObject)mfn,"-mfn_view_mat"));
+  PetscCall(VecViewFromOptions(b,(PetscObject)mfn,"-mfn_view_rhs"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    MFNGetIterationNumber - Gets the current iteration number. If the
    call to MFNSolve() is complete, then it returns the number of iterations
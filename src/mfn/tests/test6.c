@@ -0,0 +1,122 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Tests MFNSolveMat() by comparing with MFNSolve() for each column.\n\n"
+  "The command line options are:\n"
+  "  -t <sval>, where <sval> = scalar value that multiplies the argument.\n"
+  "  -n <n>, where <n> = number of grid subdivisions in x dimension.\n"
+  "  -k <k>, where <k> = number of columns of the right-hand side.\n\n";
+
+#include <slepcmfn.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A,B,X;
+  MFN            mfn;
+  FN             f;
+  PetscReal      norm,nrmy,err=0.0;
+  PetscScalar    t=0.3;
+  PetscInt       N,n=20,k=4,Istart,Iend,II,i,j;
+  Vec            b,x,y;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL));
+  PetscCall(PetscOptionsGetScalar(NULL,NULL,"-t",&t,NULL));
+  N = n*n;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nMatrix exponential Y=exp(t*A)*B, of the 2-D Laplacian, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid), %" PetscInt_FMT " columns\n\n",N,n,n,k));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                 Build the 2-D Laplacian and the block B
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N));
+  PetscCall(MatSetFromOptions(A));
+
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (II=Istart;II<Iend;II++) {
+    i = II/n; j = II-i*n;
+    if (i>0) PetscCall(MatSetValue(A,II,II-n,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,II,II+n,-1.0,INSERT_VALUES));
+    if (j>0) PetscCall(MatSetValue(A,II,II-1,-1.0,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(A,II,II+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,II,II,4.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  /* column j of B has ones in the entries congruent with j modulo k */
+  PetscCall(MatCreateDense(PETSC_COMM_WORLD,Iend-Istart,PETSC_DECIDE,N,k,NULL,&B));
+  for (II=Istart;II<Iend;II++) PetscCall(MatSetValue(B,II,II%k,1.0,INSERT_VALUES));
+  PetscCall(MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatDuplicate(B,MAT_DO_NOT_COPY_VALUES,&X));
+  PetscCall(MatCreateVecs(A,NULL,&y));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+                Create the solver and set various options
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MFNCreate(PETSC_COMM_WORLD,&mfn));
+  PetscCall(MFNSetOperator(mfn,A));
+  PetscCall(MFNGetFN(mfn,&f));
+  PetscCall(FNSetType(f,FNEXP));
+  PetscCall(FNSetScale(f,t,1.0));
+  PetscCall(MFNSetTolerances(mfn,1e-10,PETSC_CURRENT));
+  PetscCall(MFNSetErrorIfNotConverged(mfn,PETSC_TRUE));
+  PetscCall(MFNSetFromOptions(mfn));
+
+  /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+           Solve the problem, X=exp(t*A)*B, and compare with columns
+     - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+  PetscCall(MFNSolveMat(mfn,B,X));
+  PetscCall(MatNorm(X,NORM_FROBENIUS,&norm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed matrix at time t=%.4g has norm %g\n",(double)PetscRealPart(t),(double)norm));
+
+  for (j=0;j<k;j++) {
+    PetscCall(MatDenseGetColumnVecRead(B,j,&b));
+    PetscCall(MFNSolve(mfn,b,y));
+    PetscCall(MatDenseRestoreColumnVecRead(B,j,&b));
+    PetscCall(VecNorm(y,NORM_2,&nrmy));
+    PetscCall(MatDenseGetColumnVecRead(X,j,&x));
+    PetscCall(VecAXPY(y,-1.0,x));
+    PetscCall(MatDenseRestoreColumnVecRead(X,j,&x));
+    PetscCall(VecNorm(y,NORM_2,&norm));
+    err = PetscMax(err,norm/nrmy);
+  }
+  if (err<1e-7) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The relative difference with MFNSolve() is <1e-7\n\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," The relative difference with MFNSolve() is %g\n\n",(double)err));
+
+  PetscCall(MFNDestroy(&mfn));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&X));
+  PetscCall(VecDestroy(&y));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      args: -mfn_type {{krylov expokit}}
+      output_file: output/test6_1.out
+      requires: !single
+      test:
+         suffix: 1
+      test:
+         suffix: 1_ncv
+         args: -mfn_ncv 8 -bv_orthog_block {{gs chol}}
+
+TEST*/
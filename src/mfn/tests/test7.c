@@ -0,0 +1,103 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Tests MFNSolveTimes() by comparing with MFNSolve() for each t.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of grid subdivisions in x dimension.\n\n";
+
+#include <slepcmfn.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  MFN            mfn;
+  FN             f;
+  MFNType        type;
+  PetscReal      norm,nrmy,err[3];
+  PetscScalar    t[3]={0.1,0.2,0.3},tnew=0.25;
+  PetscInt       N,n=20,Istart,Iend,II,i,j;
+  PetscBool      krylov;
+  Vec            v,x[3],y,z;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  N = n*n;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nMatrix exponential y=exp(t*A)*e for several t, of the 2-D Laplacian, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid)\n\n",N,n,n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (II=Istart;II<Iend;II++) {
+    i = II/n; j = II-i*n;
+    if (i>0) PetscCall(MatSetValue(A,II,II-n,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,II,II+n,-1.0,INSERT_VALUES));
+    if (j>0) PetscCall(MatSetValue(A,II,II-1,-1.0,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(A,II,II+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,II,II,4.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateVecs(A,&v,&y));
+  PetscCall(VecDuplicate(y,&z));
+  PetscCall(VecDuplicateVecs(y,3,&x));
+  PetscCall(VecSet(v,1.0));
+
+  PetscCall(MFNCreate(PETSC_COMM_WORLD,&mfn));
+  PetscCall(MFNSetOperator(mfn,A));
+  PetscCall(MFNGetFN(mfn,&f));
+  PetscCall(FNSetType(f,FNEXP));
+  PetscCall(MFNSetTolerances(mfn,1e-10,PETSC_CURRENT));
+  PetscCall(MFNSetErrorIfNotConverged(mfn,PETSC_TRUE));
+  PetscCall(MFNSetFromOptions(mfn));
+  PetscCall(MFNGetType(mfn,&type));
+  PetscCall(PetscStrcmp(type,MFNKRYLOV,&krylov));
+
+  /* solve for all t, and compare with separate solves */
+  PetscCall(MFNSolveTimes(mfn,3,t,v,x,err));
+  for (i=0;i<3;i++) {
+    PetscCall(VecNorm(x[i],NORM_2,&norm));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed vector at time t=%.4g has norm %g, the error estimate is %s\n",(double)PetscRealPart(t[i]),(double)norm,err[i]<=1e-10?"below the tolerance":"too large"));
+    PetscCall(FNSetScale(f,t[i],1.0));
+    PetscCall(MFNSolve(mfn,v,y));
+    PetscCall(VecNorm(y,NORM_2,&nrmy));
+    PetscCall(VecAXPY(y,-1.0,x[i]));
+    PetscCall(VecNorm(y,NORM_2,&norm));
+    if (norm/nrmy>1e-8) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The relative difference with MFNSolve() is %g\n",(double)(norm/nrmy)));
+  }
+
+  /* evaluate for another t, from the basis in the case of krylov */
+  PetscCall(FNSetScale(f,1.0,1.0));
+  PetscCall(MFNSolveTimes(mfn,3,t,v,x,NULL));
+  if (krylov) PetscCall(MFNKrylovEvaluateTime(mfn,tnew,z,NULL));
+  else PetscCall(MFNSolveTimes(mfn,1,&tnew,v,&z,NULL));
+  PetscCall(VecNorm(z,NORM_2,&norm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Vector at time t=%.4g has norm %g\n\n",(double)PetscRealPart(tnew),(double)norm));
+
+  PetscCall(MFNDestroy(&mfn));
+  PetscCall(MatDestroy(&A));
+  PetscCall(VecDestroy(&v));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroyVecs(3,&x));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -mfn_type {{krylov expokit}}
+      requires: double
+
+TEST*/
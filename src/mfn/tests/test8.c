@@ -0,0 +1,102 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Tests the rational Krylov solver with a stiff diffusion operator.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of grid subdivisions in x dimension.\n"
+  "  -t <t>, where <t> = time parameter (multiplies the matrix).\n\n";
+
+#include <slepcmfn.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  MFN            mfn,mfn2;
+  FN             f,f2;
+  PetscReal      norm,nrmx;
+  PetscScalar    t=0.02,h2;
+  PetscInt       N,n=30,Istart,Iend,II,i,j;
+  Vec            v,x,y;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetScalar(NULL,NULL,"-t",&t,NULL));
+  N = n*n;
+  h2 = (n+1)*(n+1);
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nHeat equation y=exp(-t*A)*e, with A the 2-D Laplacian of the unit square, N=%" PetscInt_FMT " (%" PetscInt_FMT "x%" PetscInt_FMT " grid)\n\n",N,n,n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (II=Istart;II<Iend;II++) {
+    i = II/n; j = II-i*n;
+    if (i>0) PetscCall(MatSetValue(A,II,II-n,-h2,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,II,II+n,-h2,INSERT_VALUES));
+    if (j>0) PetscCall(MatSetValue(A,II,II-1,-h2,INSERT_VALUES));
+    if (j<n-1) PetscCall(MatSetValue(A,II,II+1,-h2,INSERT_VALUES));
+    PetscCall(MatSetValue(A,II,II,4.0*h2,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateVecs(A,&v,&x));
+  PetscCall(VecDuplicate(x,&y));
+  PetscCall(VecSet(v,1.0));
+
+  /* rational Krylov, with the poles chosen automatically */
+  PetscCall(MFNCreate(PETSC_COMM_WORLD,&mfn));
+  PetscCall(MFNSetOperator(mfn,A));
+  PetscCall(MFNSetType(mfn,MFNRATKRYLOV));
+  PetscCall(MFNGetFN(mfn,&f));
+  PetscCall(FNSetType(f,FNEXP));
+  PetscCall(FNSetScale(f,-t,1.0));
+  PetscCall(MFNSetTolerances(mfn,1e-8,PETSC_CURRENT));
+  PetscCall(MFNSetDimensions(mfn,50));
+  PetscCall(MFNSetErrorIfNotConverged(mfn,PETSC_TRUE));
+  PetscCall(MFNSetFromOptions(mfn));
+  PetscCall(MFNSolve(mfn,v,x));
+  PetscCall(VecNorm(x,NORM_2,&nrmx));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Computed vector at time t=%.4g has norm %g\n",(double)PetscRealPart(t),(double)nrmx));
+
+  /* compare with the polynomial Krylov solver */
+  PetscCall(MFNCreate(PETSC_COMM_WORLD,&mfn2));
+  PetscCall(MFNSetOperator(mfn2,A));
+  PetscCall(MFNSetType(mfn2,MFNKRYLOV));
+  PetscCall(MFNGetFN(mfn2,&f2));
+  PetscCall(FNSetType(f2,FNEXP));
+  PetscCall(FNSetScale(f2,-t,1.0));
+  PetscCall(MFNSetTolerances(mfn2,1e-12,1000));
+  PetscCall(MFNSetErrorIfNotConverged(mfn2,PETSC_TRUE));
+  PetscCall(MFNSolve(mfn2,v,y));
+  PetscCall(VecAXPY(y,-1.0,x));
+  PetscCall(VecNorm(y,NORM_2,&norm));
+  if (norm/nrmx>1e-6) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The relative difference with MFNKRYLOV is %g\n",(double)(norm/nrmx)));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n"));
+
+  PetscCall(MFNDestroy(&mfn));
+  PetscCall(MFNDestroy(&mfn2));
+  PetscCall(MatDestroy(&A));
+  PetscCall(VecDestroy(&v));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -mfn_ratkrylov_npoles {{1 3}}
+      requires: double
+
+TEST*/
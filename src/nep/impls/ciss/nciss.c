@@ -59,6 +59,9 @@ typedef struct {
   BV                Y;
   PetscBool         useconj;
   Mat               J;             /* auxiliary matrix when using subcomm */
+  Mat               P;             /* auxiliary preconditioner matrix when using subcomm */
+  PetscBool         munion;        /* J has the union pattern of the split matrices */
+  PetscBool         munionp;       /* P has the union pattern of the split matrices */
   BV                pV;
   NEP_CISS_PROJECT  dsctxf;
   PetscObjectId     rgid;
@@ -94,16 +97,20 @@ static PetscErrorCode NEPComputeFunctionSubcomm(NEP nep,PetscScalar lambda,Mat T
   PetscInt       i;
   PetscScalar    alpha;
   NEP_CISS       *ctx = (NEP_CISS*)nep->data;
+  MatStructure   str,strp;
 
   PetscFunctionBegin;
   PetscAssert(nep->fui!=NEP_USER_INTERFACE_CALLBACK,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_WRONGSTATE,"Should not arrive here with callbacks");
+  /* T and P are duplicates of J and P in the context, which contain the union pattern */
+  str  = ctx->munion? SUBSET_NONZERO_PATTERN: nep->mstr;
+  strp = ctx->munionp? SUBSET_NONZERO_PATTERN: nep->mstrp;
   PetscCall(MatZeroEntries(T));
   if (!deriv && T != P) PetscCall(MatZeroEntries(P));
   for (i=0;i<nep->nt;i++) {
     if (!deriv) PetscCall(FNEvaluateFunction(nep->f[i],lambda,&alpha));
     else PetscCall(FNEvaluateDerivative(nep->f[i],lambda,&alpha));
-    PetscCall(MatAXPY(T,alpha,ctx->contour->pA[i],nep->mstr));
-    if (!deriv && T != P) PetscCall(MatAXPY(P,alpha,ctx->contour->pP[i],nep->mstrp));
+    PetscCall(MatAXPY(T,alpha,ctx->contour->pA[i],str));
+    if (!deriv && T != P) PetscCall(MatAXPY(P,alpha,ctx->contour->pP[i],strp));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -126,6 +133,11 @@ static PetscErrorCode NEPCISSSetUp(NEP nep,Mat T,Mat P)
     p_id = i*contour->subcomm->n + contour->subcomm->color;
     PetscCall(MatDuplicate(T,MAT_DO_NOT_COPY_VALUES,&Amat));
     if (T != P) PetscCall(MatDuplicate(P,MAT_DO_NOT_COPY_VALUES,&Pmat)); else Pmat = Amat;
+    if (nep->fui==NEP_USER_INTERFACE_SPLIT && contour->subcomm->n == 1) {
+      /* the duplicates keep the pattern of the original, see NEPComputeFunction() */
+      PetscCall(PetscObjectCompose((PetscObject)Amat,"NEPSplitPattern",(PetscObject)T));
+      if (T != P) PetscCall(PetscObjectCompose((PetscObject)Pmat,"NEPSplitPattern",(PetscObject)P));
+    }
     if (contour->subcomm->n == 1 || nep->fui==NEP_USER_INTERFACE_CALLBACK) PetscCall(NEPComputeFunction(nep,ctx->omega[p_id],Amat,Pmat));
     else PetscCall(NEPComputeFunctionSubcomm(nep,ctx->omega[p_id],Amat,Pmat,PETSC_FALSE));
     PetscCall(NEP_KSPSetOperators(contour->ksp[i],Amat,Pmat));
@@ -235,7 +247,15 @@ static PetscErrorCode NEPSetUp_CISS(NEP nep)
     PetscCall(SlepcContourRedundantMat(contour,1,&nep->function,(nep->function!=nep->function_pre)?&nep->function_pre:NULL));
   } else PetscCall(SlepcContourRedundantMat(contour,nep->nt,nep->A,nep->P));
   if (contour->pA) {
-    if (!ctx->J) PetscCall(MatDuplicate(contour->pA[0],MAT_DO_NOT_COPY_VALUES,&ctx->J));
+    if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
+      /* the redundant matrices are allocated once with the union pattern of all terms */
+      PetscCall(NEPCreateSplitMatrix_Private(nep->nt,contour->pA,nep->mstr,&ctx->J,&ctx->munion));
+      if (contour->pP) PetscCall(NEPCreateSplitMatrix_Private(nep->nt,contour->pP,nep->mstrp,&ctx->P,&ctx->munionp));
+      else {
+        PetscCall(MatDestroy(&ctx->P));
+        ctx->munionp = PETSC_FALSE;
+      }
+    } else if (!ctx->J) PetscCall(MatDuplicate(contour->pA[0],MAT_DO_NOT_COPY_VALUES,&ctx->J));
     PetscCall(BVGetColumn(ctx->V,0,&v0));
     PetscCall(SlepcContourScatterCreate(contour,v0));
     PetscCall(BVRestoreColumn(ctx->V,0,&v0));
@@ -294,8 +314,13 @@ static PetscErrorCode NEPSolve_CISS(NEP nep)
   PetscCall(DSGetLeadingDimension(nep->ds,&ld));
   PetscCall(RGComputeQuadrature(nep->rg,RG_QUADRULE_TRAPEZOIDAL,ctx->N,ctx->omega,ctx->pp,ctx->weight));
   if (contour->pA) {
-    T = contour->pA[0];
-    P = ((nep->fui==NEP_USER_INTERFACE_SPLIT && nep->P) || (nep->fui==NEP_USER_INTERFACE_CALLBACK && contour->pP))? contour->pP[0]: T;
+    if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
+      T = ctx->J;
+      P = ctx->P? ctx->P: T;
+    } else {
+      T = contour->pA[0];
+      P = contour->pP? contour->pP[0]: T;
+    }
   } else {
     T = nep->function;
     P = nep->function_pre? nep->function_pre: nep->function;
@@ -571,6 +596,7 @@ static PetscErrorCode NEPCISSSetSizes_CISS(NEP nep,PetscInt ip,PetscInt bs,Petsc
 .  -nep_ciss_blocksize - Sets the block size
 .  -nep_ciss_moments - Sets the moment size
 .  -nep_ciss_partitions - Sets the number of partitions
+.  -nep_ciss_partitions_node_aware - Aligns the partitions with the shared-memory nodes
 .  -nep_ciss_maxblocksize - Sets the maximum block size
 -  -nep_ciss_realmats - T(z) is real for real z
 
@@ -581,6 +607,9 @@ static PetscErrorCode NEPCISSSetSizes_CISS(NEP nep,PetscInt ip,PetscInt bs,Petsc
    The default number of partitions is 1. This means the internal KSP object is shared
    among all processes of the NEP communicator. Otherwise, the communicator is split
    into npart communicators, so that npart KSP solves proceed simultaneously.
+   The partitions are interlaced by default; with -nep_ciss_partitions_node_aware the
+   processes of each partition are taken from the same shared-memory node as much as
+   possible, so that the communication within the partitions stays inside the nodes.
 
    The realmats flag can be set to true when T(.) is guaranteed to be real
    when the argument is a real value, for example, when all matrices in
@@ -979,6 +1008,7 @@ static PetscErrorCode NEPReset_CISS(NEP nep)
   PetscCall(BVDestroy(&ctx->Y));
   PetscCall(SlepcContourDataReset(ctx->contour));
   PetscCall(MatDestroy(&ctx->J));
+  PetscCall(MatDestroy(&ctx->P));
   PetscCall(BVDestroy(&ctx->pV));
   if (ctx->extraction == NEP_CISS_EXTRACTION_RITZ && nep->fui==NEP_USER_INTERFACE_CALLBACK) PetscCall(PetscFree(ctx->dsctxf));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -26,12 +26,54 @@
 #include <slepc/private/nepimpl.h>         /*I "slepcnep.h" I*/
 
 typedef struct {
-  PEP       pep;
-  PetscReal tol;       /* tolerance for norm of polynomial coefficients */
-  PetscInt  maxdeg;    /* maximum degree of interpolation polynomial */
-  PetscInt  deg;       /* actual degree of interpolation polynomial */
+  PEP              pep;
+  PetscReal        tol;       /* tolerance for norm of polynomial coefficients */
+  PetscInt         maxdeg;    /* maximum degree of interpolation polynomial */
+  PetscInt         deg;       /* actual degree of interpolation polynomial */
+  PetscBool        valid;     /* the PEP operators correspond to the current problem */
+  PetscInt         nt;        /* number of terms when the PEP operators were built */
+  PetscObjectId    *id;       /* ids of the split matrices and functions */
+  PetscObjectState *state;    /* states of the split matrices */
+  PetscReal        a,b;       /* interval of the interpolation */
 } NEP_INTERPOL;
 
+/*
+   Checks if the split operator has changed since the PEP operators were built
+*/
+static PetscErrorCode NEPInterpolCheckSplitOperator(NEP nep,PetscBool *changed)
+{
+  NEP_INTERPOL     *ctx = (NEP_INTERPOL*)nep->data;
+  PetscInt         i,k,nm=nep->P?3:2;
+  PetscObject      obj[3];
+  PetscObjectId    id;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  *changed = PETSC_FALSE;
+  if (ctx->nt!=nep->nt) {
+    PetscCall(PetscFree2(ctx->id,ctx->state));
+    PetscCall(PetscCalloc2(3*nep->nt,&ctx->id,3*nep->nt,&ctx->state));
+    ctx->nt  = nep->nt;
+    *changed = PETSC_TRUE;
+  }
+  for (i=0;i<nep->nt;i++) {
+    obj[0] = (PetscObject)nep->f[i];
+    obj[1] = (PetscObject)nep->A[i];
+    obj[2] = nep->P? (PetscObject)nep->P[i]: NULL;
+    for (k=0;k<3;k++) {
+      id = 0; state = 0;
+      if (k<nm) {
+        PetscCall(PetscObjectGetId(obj[k],&id));
+        if (k) PetscCall(PetscObjectStateGet(obj[k],&state));
+      }
+      if (id!=ctx->id[3*i+k] || state!=ctx->state[3*i+k]) *changed = PETSC_TRUE;
+      ctx->id[3*i+k]    = id;
+      ctx->state[3*i+k] = state;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode NEPSetUp_Interpol(NEP nep)
 {
   NEP_INTERPOL   *ctx = (NEP_INTERPOL*)nep->data;
@@ -39,7 +81,7 @@ static PetscErrorCode NEPSetUp_Interpol(NEP nep)
   RG             rg;
   PetscReal      a,b,c,d,s,tol;
   PetscScalar    zero=0.0;
-  PetscBool      flg,istrivial,trackall;
+  PetscBool      flg,istrivial,trackall,changed;
   PetscInt       its,in;
 
   PetscFunctionBegin;
@@ -86,6 +128,11 @@ static PetscErrorCode NEPSetUp_Interpol(NEP nep)
   PetscCheck(in>=0,PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"The target is not inside the target set");
   PetscCall(PEPSetTarget(ctx->pep,(nep->target-(a+b)/2)*s));
 
+  /* the interpolation polynomial is kept if the problem has not changed */
+  PetscCall(NEPInterpolCheckSplitOperator(nep,&changed));
+  if (changed || a!=ctx->a || b!=ctx->b) ctx->valid = PETSC_FALSE;
+  ctx->a = a; ctx->b = b;
+
   PetscCall(NEPAllocateSolution(nep,0));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -120,56 +167,69 @@ static PetscErrorCode NEPSolve_Interpol(NEP nep)
   PetscReal      *cs,a,b,s,aprox,aprox0=1.0,*matnorm;
   PetscInt       i,j,k,deg=ctx->maxdeg;
   PetscBool      hasmnorm=PETSC_FALSE;
-  Vec            vr,vi=NULL;
+  Vec            vr,vi=NULL,*IS;
   ST             st;
 
   PetscFunctionBegin;
-  PetscCall(PetscMalloc4((deg+1)*(deg+1),&cs,deg+1,&x,(deg+1)*nep->nt,&fx,nep->nt,&matnorm));
-  for  (j=0;j<nep->nt;j++) {
-    PetscCall(MatHasOperation(nep->A[j],MATOP_NORM,&hasmnorm));
-    if (!hasmnorm) break;
-    PetscCall(MatNorm(nep->A[j],NORM_INFINITY,matnorm+j));
-  }
-  if (!hasmnorm) for (j=0;j<nep->nt;j++) matnorm[j] = 1.0;
   PetscCall(RGIntervalGetEndpoints(nep->rg,&a,&b,NULL,NULL));
-  PetscCall(ChebyshevNodes(deg,a,b,x,cs));
-  for (j=0;j<nep->nt;j++) {
-    for (i=0;i<=deg;i++) PetscCall(FNEvaluateFunction(nep->f[j],x[i],&fx[i+j*(deg+1)]));
-  }
-  /* Polynomial coefficients */
-  PetscCall(PetscMalloc1(deg+1,&A));
-  if (nep->P) PetscCall(PetscMalloc1(deg+1,&P));
-  ctx->deg = deg;
-  for (k=0;k<=deg;k++) {
-    PetscCall(MatDuplicate(nep->A[0],MAT_COPY_VALUES,&A[k]));
-    if (nep->P) PetscCall(MatDuplicate(nep->P[0],MAT_COPY_VALUES,&P[k]));
-    t = 0.0;
-    for (i=0;i<deg+1;i++) t += fx[i]*cs[i*(deg+1)+k];
-    t *= 2.0/(deg+1);
-    if (k==0) t /= 2.0;
-    aprox = matnorm[0]*PetscAbsScalar(t);
-    PetscCall(MatScale(A[k],t));
-    if (nep->P) PetscCall(MatScale(P[k],t));
-    for (j=1;j<nep->nt;j++) {
+  if (ctx->valid) PetscCall(PetscInfo(nep,"Reusing the interpolation polynomial of degree %" PetscInt_FMT " of a previous solve\n",ctx->deg));
+  else {
+    PetscCall(PetscMalloc4((deg+1)*(deg+1),&cs,deg+1,&x,(deg+1)*nep->nt,&fx,nep->nt,&matnorm));
+    for  (j=0;j<nep->nt;j++) {
+      PetscCall(MatHasOperation(nep->A[j],MATOP_NORM,&hasmnorm));
+      if (!hasmnorm) break;
+      PetscCall(MatNorm(nep->A[j],NORM_INFINITY,matnorm+j));
+    }
+    if (!hasmnorm) for (j=0;j<nep->nt;j++) matnorm[j] = 1.0;
+    PetscCall(ChebyshevNodes(deg,a,b,x,cs));
+    for (j=0;j<nep->nt;j++) PetscCall(FNEvaluateFunctionArray(nep->f[j],deg+1,x,fx+j*(deg+1)));
+    /* Polynomial coefficients */
+    PetscCall(PetscMalloc1(deg+1,&A));
+    if (nep->P) PetscCall(PetscMalloc1(deg+1,&P));
+    ctx->deg = deg;
+    for (k=0;k<=deg;k++) {
+      PetscCall(MatDuplicate(nep->A[0],MAT_COPY_VALUES,&A[k]));
+      if (nep->P) PetscCall(MatDuplicate(nep->P[0],MAT_COPY_VALUES,&P[k]));
       t = 0.0;
-      for (i=0;i<deg+1;i++) t += fx[i+j*(deg+1)]*cs[i*(deg+1)+k];
+      for (i=0;i<deg+1;i++) t += fx[i]*cs[i*(deg+1)+k];
       t *= 2.0/(deg+1);
       if (k==0) t /= 2.0;
-      aprox += matnorm[j]*PetscAbsScalar(t);
-      PetscCall(MatAXPY(A[k],t,nep->A[j],nep->mstr));
-      if (nep->P) PetscCall(MatAXPY(P[k],t,nep->P[j],nep->mstrp));
+      aprox = matnorm[0]*PetscAbsScalar(t);
+      PetscCall(MatScale(A[k],t));
+      if (nep->P) PetscCall(MatScale(P[k],t));
+      for (j=1;j<nep->nt;j++) {
+        t = 0.0;
+        for (i=0;i<deg+1;i++) t += fx[i+j*(deg+1)]*cs[i*(deg+1)+k];
+        t *= 2.0/(deg+1);
+        if (k==0) t /= 2.0;
+        aprox += matnorm[j]*PetscAbsScalar(t);
+        PetscCall(MatAXPY(A[k],t,nep->A[j],nep->mstr));
+        if (nep->P) PetscCall(MatAXPY(P[k],t,nep->P[j],nep->mstrp));
+      }
+      if (k==0) aprox0 = aprox;
+      if (k>1 && aprox/aprox0<ctx->tol) { ctx->deg = k; deg = k; break; }
+    }
+    if (k>deg) PetscCall(PetscInfo(nep,"The tolerance %g of the interpolation coefficients was not reached with degree %" PetscInt_FMT "\n",(double)ctx->tol,deg));
+    PetscCall(PEPSetOperators(ctx->pep,deg+1,A));
+    PetscCall(MatDestroyMatrices(deg+1,&A));
+    if (nep->P) {
+      PetscCall(PEPGetST(ctx->pep,&st));
+      PetscCall(STSetSplitPreconditioner(st,deg+1,P,nep->mstrp));
+      PetscCall(MatDestroyMatrices(deg+1,&P));
     }
-    if (k==0) aprox0 = aprox;
-    if (k>1 && aprox/aprox0<ctx->tol) { ctx->deg = k; deg = k; break; }
+    PetscCall(PetscFree4(cs,x,fx,matnorm));
+    ctx->valid = PETSC_TRUE;
   }
-  PetscCall(PEPSetOperators(ctx->pep,deg+1,A));
-  PetscCall(MatDestroyMatrices(deg+1,&A));
-  if (nep->P) {
-    PetscCall(PEPGetST(ctx->pep,&st));
-    PetscCall(STSetSplitPreconditioner(st,deg+1,P,nep->mstrp));
-    PetscCall(MatDestroyMatrices(deg+1,&P));
+
+  /* the initial space of the NEP is used to start the PEP solver */
+  if (nep->nini>0) {
+    PetscCall(BVCreateVec(nep->V,&vr));
+    PetscCall(VecDuplicateVecs(vr,nep->nini,&IS));
+    PetscCall(VecDestroy(&vr));
+    for (i=0;i<nep->nini;i++) PetscCall(BVCopyVec(nep->V,i,IS[i]));
+    PetscCall(PEPSetInitialSpace(ctx->pep,nep->nini,IS));
+    PetscCall(VecDestroyVecs(nep->nini,&IS));
   }
-  PetscCall(PetscFree4(cs,x,fx,matnorm));
 
   /* Solve polynomial eigenproblem */
   PetscCall(PEPSolve(ctx->pep));
@@ -256,9 +316,11 @@ static PetscErrorCode NEPInterpolSetInterpolation_Interpol(NEP nep,PetscReal tol
   PetscFunctionBegin;
   if (tol == (PetscReal)PETSC_DETERMINE) {
     ctx->tol   = PETSC_DETERMINE;
+    ctx->valid = PETSC_FALSE;
     nep->state = NEP_STATE_INITIAL;
   } else if (tol != (PetscReal)PETSC_CURRENT) {
     PetscCheck(tol>0.0,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of tol. Must be > 0");
+    if (ctx->tol != tol) ctx->valid = PETSC_FALSE;
     ctx->tol = tol;
   }
   if (degree == PETSC_DETERMINE) {
@@ -351,7 +413,8 @@ static PetscErrorCode NEPInterpolSetPEP_Interpol(NEP nep,PEP pep)
   PetscFunctionBegin;
   PetscCall(PetscObjectReference((PetscObject)pep));
   PetscCall(PEPDestroy(&ctx->pep));
-  ctx->pep = pep;
+  ctx->pep   = pep;
+  ctx->valid = PETSC_FALSE;
   nep->state = NEP_STATE_INITIAL;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -446,6 +509,7 @@ static PetscErrorCode NEPReset_Interpol(NEP nep)
 
   PetscFunctionBegin;
   PetscCall(PEPReset(ctx->pep));
+  ctx->valid = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -455,6 +519,7 @@ static PetscErrorCode NEPDestroy_Interpol(NEP nep)
 
   PetscFunctionBegin;
   PetscCall(PEPDestroy(&ctx->pep));
+  PetscCall(PetscFree2(ctx->id,ctx->state));
   PetscCall(PetscFree(nep->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPInterpolSetInterpolation_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPInterpolGetInterpolation_C",NULL));
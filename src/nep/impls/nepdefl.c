@@ -239,14 +239,106 @@ PetscErrorCode NEPDeflationLocking(NEP_EXT_OP extop,Vec u,PetscScalar lambda)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes the products A_i*X of the split matrices with the columns of X that have
+   been locked since the last call; locked columns are not modified afterwards
+*/
+static PetscErrorCode NEPDeflationUpdateAX(NEP_EXT_OP extop)
+{
+  PetscInt j,k;
+  Vec      x,y;
+
+  PetscFunctionBegin;
+  for (k=extop->nax;k<extop->n;k++) {
+    PetscCall(BVGetColumn(extop->X,k,&x));
+    for (j=0;j<extop->nep->nt;j++) {
+      PetscCall(BVGetColumn(extop->AX[j],k,&y));
+      PetscCall(MatMult(extop->nep->A[j],x,y));
+      PetscCall(BVRestoreColumn(extop->AX[j],k,&y));
+    }
+    PetscCall(BVRestoreColumn(extop->X,k,&x));
+  }
+  extop->nax = extop->n;
+  for (j=0;j<extop->nep->nt;j++) PetscCall(BVSetActiveColumns(extop->AX[j],0,extop->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the divided differences F12=(H-lambda*I)^{-1}(f(H)-f(lambda)*I) and
+   F13=(H-lambda*I)^{-1}(F12-f'(lambda)*I) from the functions f_i(H), which only change
+   when the invariant pair grows. This is only done when lambda is well separated from
+   the diagonal of H (the locked eigenvalues), otherwise done=PETSC_FALSE is returned
+*/
+static PetscErrorCode NEPDeflationEvaluateHatFunctionDD(NEP_EXT_OP extop,PetscInt idx,PetscScalar lambda,PetscScalar *hfj,PetscScalar *hfjp,PetscInt ld,PetscBool *done)
+{
+  PetscInt     i,j,k,off,ini,fin,ldh=extop->szd+1,n=extop->n;
+  PetscReal    dmin=PETSC_MAX_REAL,scal=PetscAbsScalar(lambda);
+  PetscScalar  *hf,fl,sone=1.0;
+  Mat          Hm,Fm;
+  PetscBLASInt n_,ld_,ldh_;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  if (!extop->fH) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i=0;i<n;i++) {
+    dmin = PetscMin(dmin,PetscAbsScalar(extop->H[i*(ldh+1)]-lambda));
+    scal = PetscMax(scal,PetscAbsScalar(extop->H[i*(ldh+1)]));
+  }
+  if (dmin<=1e-2*PetscMax(scal,1.0)) PetscFunctionReturn(PETSC_SUCCESS);
+  if (extop->nfH!=n) {
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&Hm));
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&Fm));
+    PetscCall(MatDenseGetArrayWrite(Hm,&hf));
+    for (j=0;j<n;j++) for (i=0;i<n;i++) hf[j*n+i] = extop->H[j*ldh+i];
+    PetscCall(MatDenseRestoreArrayWrite(Hm,&hf));
+    for (j=0;j<extop->nep->nt;j++) {
+      PetscCall(MatDensePlaceArray(Fm,extop->fH+j*n*n));
+      PetscCall(FNEvaluateFunctionMat(extop->nep->f[j],Hm,Fm));
+      PetscCall(MatDenseResetArray(Fm));
+    }
+    PetscCall(MatDestroy(&Hm));
+    PetscCall(MatDestroy(&Fm));
+    extop->nfH = n;
+  }
+  if (idx<0) {ini = 0; fin = extop->nep->nt;}
+  else {ini = idx; fin = idx+1;}
+  off = idx<0?ld*n:0;
+  PetscCall(PetscBLASIntCast(n,&n_));
+  PetscCall(PetscBLASIntCast(ld,&ld_));
+  PetscCall(PetscBLASIntCast(ldh,&ldh_));
+  for (i=0;i<n;i++) extop->H[i*(ldh+1)] -= lambda;
+  for (j=ini;j<fin;j++) {
+    hf = hfj+j*off;
+    for (i=0;i<n;i++) for (k=0;k<n;k++) hf[i*ld+k] = extop->fH[j*n*n+i*n+k];
+    PetscCall(FNEvaluateFunction(extop->nep->f[j],lambda,&fl));
+    for (i=0;i<n;i++) hf[i*(ld+1)] -= fl;
+    PetscCallBLAS("BLAStrsm",BLAStrsm_("L","U","N","N",&n_,&n_,&sone,extop->H,&ldh_,hf,&ld_));
+    if (hfjp) {
+      for (i=0;i<n;i++) for (k=0;k<n;k++) hfjp[j*off+i*ld+k] = hf[i*ld+k];
+      hf = hfjp+j*off;
+      PetscCall(FNEvaluateDerivative(extop->nep->f[j],lambda,&fl));
+      for (i=0;i<n;i++) hf[i*(ld+1)] -= fl;
+      PetscCallBLAS("BLAStrsm",BLAStrsm_("L","U","N","N",&n_,&n_,&sone,extop->H,&ldh_,hf,&ld_));
+    }
+  }
+  for (i=0;i<n;i++) extop->H[i*(ldh+1)] += lambda;
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode NEPDeflationEvaluateHatFunction(NEP_EXT_OP extop, PetscInt idx,PetscScalar lambda,PetscScalar *y,PetscScalar *hfj,PetscScalar *hfjp,PetscInt ld)
 {
   PetscInt          i,j,k,off,ini,fin,sz,ldh,n=extop->n;
   Mat               A,B;
   PetscScalar       *array;
   const PetscScalar *barray;
+  PetscBool         done;
 
   PetscFunctionBegin;
+  if (!y) {
+    PetscCall(NEPDeflationEvaluateHatFunctionDD(extop,idx,lambda,hfj,hfjp,ld,&done));
+    if (done) PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (idx<0) {ini = 0; fin = extop->nep->nt;}
   else {ini = idx; fin = idx+1;}
   if (y) sz = hfjp?n+2:n+1;
@@ -306,6 +398,7 @@ static PetscErrorCode MatMult_NEPDeflation(Mat M,Vec x,Vec y)
   PetscInt          nloc,i;
   PetscMPIInt       np;
   PetscBLASInt      n_,one=1,szd_;
+  PetscBool         dot;
 
   PetscFunctionBegin;
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)M),&np));
@@ -318,13 +411,17 @@ static PetscErrorCode MatMult_NEPDeflation(Mat M,Vec x,Vec y)
     PetscCall(VecPlaceArray(x1,xx));
     PetscCall(VecGetArray(y,&yy));
     PetscCall(VecPlaceArray(y1,yy));
+    dot = (PetscBool)(!extop->ref && extop->n);
+    /* the reduction of X'*x1 proceeds while T*x1 is computed */
+    if (dot) PetscCall(BVDotVecBegin(extop->X,x1,matctx->work+extop->szd));
     PetscCall(MatMult(matctx->T,x1,y1));
-    if (!extop->ref && extop->n) {
+    if (dot) {
       PetscCall(VecGetLocalSize(x1,&nloc));
       /* copy for avoiding warning of constant array xx */
       for (i=0;i<extop->n;i++) matctx->work[i] = xx[nloc+i]*PetscSqrtReal(np);
       PetscCall(BVMultVec(matctx->U,1.0,1.0,y1,matctx->work));
-      PetscCall(BVDotVec(extop->X,x1,matctx->work));
+      PetscCall(BVDotVecEnd(extop->X,x1,matctx->work+extop->szd));
+      PetscCall(PetscArraycpy(matctx->work,matctx->work+extop->szd,extop->n));
       PetscCall(PetscBLASIntCast(extop->n,&n_));
       PetscCall(PetscBLASIntCast(extop->szd,&szd_));
       PetscCallBLAS("BLASgemv",BLASgemv_("N",&n_,&n_,&sone,matctx->A,&szd_,matctx->work,&one,&zero,yy+nloc,&one));
@@ -426,10 +523,14 @@ static PetscErrorCode NEPDeflationComputeShellMat(NEP_EXT_OP extop,PetscScalar l
     } else {
       matctx->jacob = jacobian;
       PetscCall(MatDuplicate(jacobian?extop->nep->jacobian:extop->nep->function,MAT_DO_NOT_COPY_VALUES,&matctx->T));
+      /* the duplicates keep the pattern of the original, see NEPComputeFunction() */
+      if (extop->nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(PetscObjectCompose((PetscObject)matctx->T,"NEPSplitPattern",(PetscObject)(jacobian?extop->nep->jacobian:extop->nep->function)));
       *M = Mshell;
       if (!jacobian) {
-        if (extop->nep->function_pre && extop->nep->function_pre != extop->nep->function) PetscCall(MatDuplicate(extop->nep->function_pre,MAT_DO_NOT_COPY_VALUES,&matctx->P));
-        else matctx->P = matctx->T;
+        if (extop->nep->function_pre && extop->nep->function_pre != extop->nep->function) {
+          PetscCall(MatDuplicate(extop->nep->function_pre,MAT_DO_NOT_COPY_VALUES,&matctx->P));
+          if (extop->nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(PetscObjectCompose((PetscObject)matctx->P,"NEPSplitPattern",(PetscObject)extop->nep->function_pre));
+        } else matctx->P = matctx->T;
       }
     }
     if (szd) {
@@ -437,7 +538,7 @@ static PetscErrorCode NEPDeflationComputeShellMat(NEP_EXT_OP extop,PetscScalar l
       PetscCall(VecDuplicate(matctx->w[0],matctx->w+1));
       PetscCall(BVDuplicateResize(extop->nep->V,szd,&matctx->U));
       len = extop->simpU? (size_t)2*szd*szd: (size_t)2*szd*szd*extop->nep->nt;
-      PetscCall(PetscMalloc4(len,&matctx->hfj,szd,&matctx->work,szd*szd,&matctx->A,szd*szd,&matctx->B));
+      PetscCall(PetscMalloc4(len,&matctx->hfj,2*szd,&matctx->work,szd*szd,&matctx->A,szd*szd,&matctx->B));
     }
   } else PetscCall(MatShellGetContext(Mshell,&matctx));
   if (ini || matctx->theta != lambda || matctx->n != extop->n) {
@@ -461,16 +562,14 @@ static PetscErrorCode NEPDeflationComputeShellMat(NEP_EXT_OP extop,PetscScalar l
           PetscCall(NEPDeflationEvaluateHatFunction(extop,-1,lambda,NULL,hfj,hfjp,n));
           matctx->hfjset = PETSC_TRUE;
         }
+        /* U = sum_j A_j*X*hf_j, with the products A_j*X computed only once per locked vector */
+        PetscCall(NEPDeflationUpdateAX(extop));
         PetscCall(BVSetActiveColumns(matctx->U,0,n));
         hf = jacobian?hfjp:hfj;
-        PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,hf,&F));
-        PetscCall(BVMatMult(extop->X,extop->nep->A[0],matctx->U));
-        PetscCall(BVMultInPlace(matctx->U,F,0,n));
-        PetscCall(BVSetActiveColumns(extop->W,0,extop->n));
-        for (j=1;j<extop->nep->nt;j++) {
-          PetscCall(BVMatMult(extop->X,extop->nep->A[j],extop->W));
+        PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&F));
+        for (j=0;j<extop->nep->nt;j++) {
           PetscCall(MatDensePlaceArray(F,hf+j*n*n));
-          PetscCall(BVMult(matctx->U,1.0,1.0,extop->W,F));
+          PetscCall(BVMult(matctx->U,1.0,j?1.0:0.0,extop->AX[j],F));
           PetscCall(MatDenseResetArray(F));
         }
         PetscCall(MatDestroy(&F));
@@ -672,7 +771,10 @@ PetscErrorCode NEPDeflationReset(NEP_EXT_OP extop)
   if (extop->szd) {
     PetscCall(VecDestroy(&extop->w));
     PetscCall(PetscFree3(extop->Hj,extop->XpX,extop->bc));
-    PetscCall(BVDestroy(&extop->W));
+    if (extop->AX) {
+      for (j=0;j<extop->nep->nt;j++) PetscCall(BVDestroy(&extop->AX[j]));
+      PetscCall(PetscFree2(extop->AX,extop->fH));
+    }
   }
   PetscCall(MatDestroy(&extop->MF));
   PetscCall(MatDestroy(&extop->MJ));
@@ -695,6 +797,10 @@ PetscErrorCode NEPDeflationReset(NEP_EXT_OP extop)
       PetscCall(VecDestroy(&extop->proj->w));
       PetscCall(BVDestroy(&extop->proj->V1));
     }
+    if (extop->proj->AV) {
+      for (j=0;j<extop->nep->nt;j++) PetscCall(BVDestroy(&extop->proj->AV[j]));
+      PetscCall(PetscFree(extop->proj->AV));
+    }
     PetscCall(PetscFree(extop->proj));
   }
   PetscCall(PetscFree(extop));
@@ -705,7 +811,7 @@ PetscErrorCode NEPDeflationInitialize(NEP nep,BV X,KSP ksp,PetscBool sincfun,Pet
 {
   NEP_EXT_OP        op;
   NEP_DEF_FUN_SOLVE solve;
-  PetscInt          szd;
+  PetscInt          szd,j;
   Vec               x;
 
   PetscFunctionBegin;
@@ -732,7 +838,12 @@ PetscErrorCode NEPDeflationInitialize(NEP nep,BV X,KSP ksp,PetscBool sincfun,Pet
       op->simpU = PETSC_TRUE;
     }
     PetscCall(PetscCalloc3(szd*szd*op->max_midx,&(op)->Hj,szd*szd,&(op)->XpX,szd,&op->bc));
-    PetscCall(BVDuplicateResize(op->X,op->szd,&op->W));
+    if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
+      PetscCall(PetscMalloc2(nep->nt,&op->AX,nep->nt*szd*szd,&op->fH));
+      for (j=0;j<nep->nt;j++) PetscCall(BVDuplicateResize(op->X,szd,&op->AX[j]));
+      op->nax = 0;
+      op->nfH = -1;
+    }
   }
   if (ksp) {
     PetscCall(PetscNew(&solve));
@@ -859,7 +970,7 @@ static PetscErrorCode NEPDeflationDSNEPComputeMatrix(DS ds,PetscScalar lambda,Pe
 
 PetscErrorCode NEPDeflationProjectOperator(NEP_EXT_OP extop,BV Vext,DS ds,PetscInt j0,PetscInt j1)
 {
-  PetscInt        k,j,n=extop->n,dim;
+  PetscInt        k,j,dim;
   Vec             v,ve;
   BV              V1;
   Mat             G;
@@ -899,22 +1010,25 @@ PetscErrorCode NEPDeflationProjectOperator(NEP_EXT_OP extop,BV Vext,DS ds,PetscI
     V1 = proj->V1;
   } else V1 = Vext;
 
-  /* Compute matrices V1^* A_i V1 */
+  /* Compute matrices V1^* A_i V1, by bordering with the new columns j0:j1 of A_i V1 */
+  if (!proj->AV) {
+    PetscCall(PetscMalloc1(nep->nt,&proj->AV));
+    for (k=0;k<nep->nt;k++) PetscCall(BVDuplicateResize(V1,proj->dim,&proj->AV[k]));
+  }
   PetscCall(BVSetActiveColumns(V1,j0,j1));
   for (k=0;k<nep->nt;k++) {
+    PetscCall(BVSetActiveColumns(proj->AV[k],j0,j1));
+    PetscCall(BVMatMult(V1,nep->A[k],proj->AV[k]));
     PetscCall(DSGetMat(ds,DSMatExtra[k],&G));
-    PetscCall(BVMatProject(V1,nep->A[k],V1,G));
+    PetscCall(BVMatProject(proj->AV[k],NULL,V1,G));
     PetscCall(DSRestoreMat(ds,DSMatExtra[k],&G));
   }
 
   if (extop->n) {
     if (extop->szd) {
       /* Compute matrices V1^* A_i X  and V1^* X */
-      PetscCall(BVSetActiveColumns(extop->W,0,n));
-      for (k=0;k<nep->nt;k++) {
-        PetscCall(BVMatMult(extop->X,nep->A[k],extop->W));
-        PetscCall(BVDot(extop->W,V1,proj->V1pApX[k]));
-      }
+      PetscCall(NEPDeflationUpdateAX(extop));
+      for (k=0;k<nep->nt;k++) PetscCall(BVDot(extop->AX[k],V1,proj->V1pApX[k]));
       PetscCall(BVDot(V1,extop->X,proj->XpV1));
     }
   }
@@ -37,7 +37,10 @@ struct _n_nep_ext_op {
   NEP_DEF_FUN_SOLVE solve;  /* MatSolve context for the operator */
   NEP_DEF_PROJECT   proj;   /* context for the projected eigenproblem */
   /* auxiliary computations */
-  BV                W;
+  BV                *AX;    /* products A_i*X with the split matrices (split form only) */
+  PetscInt          nax;    /* number of columns of AX already computed */
+  PetscScalar       *fH;    /* functions f_i(H) of the split form */
+  PetscInt          nfH;    /* size of H when fH was computed */
   PetscScalar       *Hj;    /* matrix containing the powers of the invariant pair matrix */
   PetscScalar       *XpX;   /* X^*X */
   DS                ds;
@@ -81,6 +84,7 @@ struct _n_nep_def_project {
   PetscScalar  *V2;
   Vec          w;
   BV           V1;
+  BV           *AV;   /* products A_i*V1 with the split matrices */
   PetscInt     dim;
   PetscScalar  *work;
   PetscInt     lwork;
@@ -195,68 +195,98 @@ static PetscErrorCode NEPNLEIGSRationalSingularities(NEP nep,PetscInt *ndptx,Pet
 #define LAPGEEV "ggev3"
 #endif
 
-/*  Adaptive Anderson-Antoulas algorithm */
-static PetscErrorCode NEPNLEIGSAAAComputation(NEP nep,PetscInt ndpt,PetscScalar *ds,PetscScalar *F,PetscInt *ndptx,PetscScalar *dxi)
+/*
+   Adaptive Anderson-Antoulas algorithm
+
+   The nf functions sampled in F (ndpt values each, with leading dimension ndpt) are
+   approximated with common support points (set-valued AAA), each of them scaled with its
+   maximum value if nf>1. The contents of F are overwritten.
+*/
+static PetscErrorCode NEPNLEIGSAAAComputation(NEP nep,PetscInt ndpt,PetscInt nf,PetscScalar *ds,PetscScalar *F,PetscInt *ndptx,PetscScalar *dxi)
 {
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
-  PetscScalar    mean=0.0,*z,*f,*C,*A,*VT,*work,*ww,szero=0.0,sone=1.0;
-  PetscScalar    *N,*D;
-  PetscReal      *S,norm,err,*R;
-  PetscInt       i,k,j,idx=0,cont;
-  PetscBLASInt   n_,m_,lda_,lwork,info,one=1;
+  PetscScalar    *mean,*z,*f,*C,*A=NULL,*VT,*work,*ww,*W,*B,szero=0.0,sone=1.0;
+  PetscScalar    *N,*D,*Q;
+  PetscReal      *S,norm,err,*R,scal;
+  PetscInt       i,k,j,l,idx=0,cont,acol=0,ldq;
+  PetscBLASInt   n_,m_,lda_,ldq_,ldr_,lwork,info,one=1;
 #if defined(PETSC_USE_COMPLEX)
   PetscReal      *rwork;
 #endif
 
   PetscFunctionBegin;
-  PetscCall(PetscBLASIntCast(8*ndpt,&lwork));
-  PetscCall(PetscMalloc5(ndpt,&R,ndpt,&z,ndpt,&f,ndpt*ndpt,&C,ndpt,&ww));
-  PetscCall(PetscMalloc6(ndpt*ndpt,&A,ndpt,&S,ndpt*ndpt,&VT,lwork,&work,ndpt,&D,ndpt,&N));
+  PetscCall(PetscBLASIntCast((7+nf)*ndpt,&lwork));
+  PetscCall(PetscMalloc6(ndpt,&R,ndpt,&z,nf*ndpt,&f,ndpt*ndpt,&C,ndpt,&ww,nf,&mean));
+  PetscCall(PetscMalloc6(ndpt,&S,ndpt*ndpt,&VT,lwork,&work,ndpt,&D,ndpt,&N,ndpt,&Q));
 #if defined(PETSC_USE_COMPLEX)
   PetscCall(PetscMalloc1(8*ndpt,&rwork));
 #endif
   PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  if (nf>1) {
+    for (l=0;l<nf;l++) {
+      scal = 0.0;
+      for (i=0;i<ndpt;i++) scal = PetscMax(PetscAbsScalar(F[i+l*ndpt]),scal);
+      if (scal>0.0) for (i=0;i<ndpt;i++) F[i+l*ndpt] /= scal;
+    }
+  }
   norm = 0.0;
-  for (i=0;i<ndpt;i++) {
-    mean += F[i];
-    norm = PetscMax(PetscAbsScalar(F[i]),norm);
+  for (l=0;l<nf;l++) {
+    mean[l] = 0.0;
+    for (i=0;i<ndpt;i++) {
+      mean[l] += F[i+l*ndpt];
+      norm = PetscMax(PetscAbsScalar(F[i+l*ndpt]),norm);
+    }
+    mean[l] /= ndpt;
   }
-  mean /= ndpt;
   PetscCall(PetscBLASIntCast(ndpt,&lda_));
-  for (i=0;i<ndpt;i++) R[i] = PetscAbsScalar(F[i]-mean);
+  PetscCall(PetscBLASIntCast(nf*ndpt,&ldq_));
+  ldq = nf*ndpt;
+  for (i=0;i<ndpt;i++) {
+    R[i] = 0.0;
+    for (l=0;l<nf;l++) R[i] = PetscMax(R[i],PetscAbsScalar(F[i+l*ndpt]-mean[l]));
+  }
   /* next support point */
   err = 0.0;
   for (i=0;i<ndpt;i++) if (R[i]>=err) {idx = i; err = R[i];}
   for (k=0;k<ndpt-1;k++) {
-    z[k] = ds[idx]; f[k] = F[idx]; R[idx] = -1.0;
+    z[k] = ds[idx]; R[idx] = -1.0;
+    for (l=0;l<nf;l++) f[k+l*ndpt] = F[idx+l*ndpt];
     /* next column of Cauchy matrix */
     for (i=0;i<ndpt;i++) {
       C[i+k*ndpt] = 1.0/(ds[i]-ds[idx]);
     }
 
-    PetscCall(PetscArrayzero(A,ndpt*ndpt));
+    /* Loewner matrix, the storage is enlarged when needed since it is rebuilt at each step */
+    if (k+1>acol) {
+      PetscCall(PetscFree(A));
+      acol = PetscMin(PetscMax(2*acol,32),ndpt);
+      PetscCall(PetscMalloc1(ldq*acol,&A));
+    }
     cont = 0;
-    for (i=0;i<ndpt;i++) {
-      if (R[i]!=-1.0) {
-        for (j=0;j<=k;j++)A[cont+j*ndpt] = C[i+j*ndpt]*F[i]-C[i+j*ndpt]*f[j];
-        cont++;
+    for (l=0;l<nf;l++) {
+      for (i=0;i<ndpt;i++) {
+        if (R[i]!=-1.0) {
+          for (j=0;j<=k;j++) A[cont+j*ldq] = C[i+j*ndpt]*F[i+l*ndpt]-C[i+j*ndpt]*f[j+l*ndpt];
+          cont++;
+        }
       }
     }
     PetscCall(PetscBLASIntCast(cont,&m_));
     PetscCall(PetscBLASIntCast(k+1,&n_));
 #if defined(PETSC_USE_COMPLEX)
-    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("N","A",&m_,&n_,A,&lda_,S,NULL,&lda_,VT,&lda_,work,&lwork,rwork,&info));
+    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("N","A",&m_,&n_,A,&ldq_,S,NULL,&ldq_,VT,&lda_,work,&lwork,rwork,&info));
 #else
-    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("N","A",&m_,&n_,A,&lda_,S,NULL,&lda_,VT,&lda_,work,&lwork,&info));
+    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("N","A",&m_,&n_,A,&ldq_,S,NULL,&ldq_,VT,&lda_,work,&lwork,&info));
 #endif
     SlepcCheckLapackInfo("gesvd",info);
-    for (i=0;i<=k;i++) {
-      ww[i] = PetscConj(VT[i*ndpt+k]);
-      D[i] = ww[i]*f[i];
+    for (i=0;i<=k;i++) ww[i] = PetscConj(VT[i*ndpt+k]);
+    /* denominator of the barycentric form, and residual at the remaining points */
+    PetscCallBLAS("BLASgemv",BLASgemv_("N",&lda_,&n_,&sone,C,&lda_,ww,&one,&szero,Q,&one));
+    for (l=0;l<nf;l++) {
+      for (i=0;i<=k;i++) D[i] = ww[i]*f[i+l*ndpt];
+      PetscCallBLAS("BLASgemv",BLASgemv_("N",&lda_,&n_,&sone,C,&lda_,D,&one,&szero,N,&one));
+      for (i=0;i<ndpt;i++) if (R[i]>=0) R[i] = l? PetscMax(R[i],PetscAbsScalar(F[i+l*ndpt]-N[i]/Q[i])): PetscAbsScalar(F[i]-N[i]/Q[i]);
     }
-    PetscCallBLAS("BLASgemv",BLASgemv_("N",&lda_,&n_,&sone,C,&lda_,D,&one,&szero,N,&one));
-    PetscCallBLAS("BLASgemv",BLASgemv_("N",&lda_,&n_,&sone,C,&lda_,ww,&one,&szero,D,&one));
-    for (i=0;i<ndpt;i++) if (R[i]>=0) R[i] = PetscAbsScalar(F[i]-N[i]/D[i]);
     /* next support point */
     err = 0.0;
     for (i=0;i<ndpt;i++) if (R[i]>=err) {idx = i; err = R[i];}
@@ -265,20 +295,20 @@ static PetscErrorCode NEPNLEIGSAAAComputation(NEP nep,PetscInt ndpt,PetscScalar
 
   PetscCheck(k<ndpt-1,PetscObjectComm((PetscObject)nep),PETSC_ERR_CONV_FAILED,"Failed to determine singularities automatically in general problem");
   /* poles */
-  PetscCall(PetscArrayzero(C,ndpt*ndpt));
-  PetscCall(PetscArrayzero(A,ndpt*ndpt));
+  n_++;
+  ldr_ = n_;
+  PetscCall(PetscCalloc2(n_*n_,&W,n_*n_,&B));
   for (i=0;i<=k;i++) {
-    C[i+ndpt*i] = 1.0;
-    A[(i+1)*ndpt] = ww[i];
-    A[i+1] = 1.0;
-    A[i+1+(i+1)*ndpt] = z[i];
+    B[i+n_*i] = 1.0;
+    W[(i+1)*n_] = ww[i];
+    W[i+1] = 1.0;
+    W[i+1+(i+1)*n_] = z[i];
   }
-  C[0] = 0.0; C[k+1+(k+1)*ndpt] = 1.0;
-  n_++;
+  B[0] = 0.0; B[k+1+(k+1)*n_] = 1.0;
 #if defined(PETSC_USE_COMPLEX)
-  PetscCallBLAS("LAPACK" LAPGEEV,LAPACKggevalt_("N","N",&n_,A,&lda_,C,&lda_,D,N,NULL,&lda_,NULL,&lda_,work,&lwork,rwork,&info));
+  PetscCallBLAS("LAPACK" LAPGEEV,LAPACKggevalt_("N","N",&n_,W,&ldr_,B,&ldr_,D,N,NULL,&ldr_,NULL,&ldr_,work,&lwork,rwork,&info));
 #else
-  PetscCallBLAS("LAPACK" LAPGEEV,LAPACKggevalt_("N","N",&n_,A,&lda_,C,&lda_,D,VT,N,NULL,&lda_,NULL,&lda_,work,&lwork,&info));
+  PetscCallBLAS("LAPACK" LAPGEEV,LAPACKggevalt_("N","N",&n_,W,&ldr_,B,&ldr_,D,VT,N,NULL,&ldr_,NULL,&ldr_,work,&lwork,&info));
 #endif
   SlepcCheckLapackInfo(LAPGEEV,info);
   cont = 0.0;
@@ -287,8 +317,10 @@ static PetscErrorCode NEPNLEIGSAAAComputation(NEP nep,PetscInt ndpt,PetscScalar
   }
   *ndptx = cont;
   PetscCall(PetscFPTrapPop());
-  PetscCall(PetscFree5(R,z,f,C,ww));
-  PetscCall(PetscFree6(A,S,VT,work,D,N));
+  PetscCall(PetscFree2(W,B));
+  PetscCall(PetscFree(A));
+  PetscCall(PetscFree6(R,z,f,C,ww,mean));
+  PetscCall(PetscFree6(S,VT,work,D,N,Q));
 #if defined(PETSC_USE_COMPLEX)
   PetscCall(PetscFree(rwork));
 #endif
@@ -298,44 +330,49 @@ static PetscErrorCode NEPNLEIGSAAAComputation(NEP nep,PetscInt ndpt,PetscScalar
 /*  Singularities using Adaptive Anderson-Antoulas algorithm */
 static PetscErrorCode NEPNLEIGSAAASingularities(NEP nep,PetscInt ndpt,PetscScalar *ds,PetscInt *ndptx,PetscScalar *dxi)
 {
-  Vec            u,v,w;
+  Vec            *u,v,w;
   PetscRandom    rand=NULL;
-  PetscScalar    *F,*isol;
-  PetscInt       i,k,nisol,nt;
+  PetscScalar    *F,*isol,dots[NSKETCHES];
+  PetscInt       i,k,l,nisol,nt;
   Mat            T;
   FN             f;
 
   PetscFunctionBegin;
-  PetscCall(PetscMalloc1(ndpt,&F));
   if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
+    PetscCall(PetscMalloc1(ndpt,&F));
     PetscCall(PetscMalloc1(ndpt,&isol));
     *ndptx = 0;
     PetscCall(NEPGetSplitOperatorInfo(nep,&nt,NULL));
     nisol = *ndptx;
     for (k=0;k<nt;k++) {
       PetscCall(NEPGetSplitOperatorTerm(nep,k,NULL,&f));
-      for (i=0;i<ndpt;i++) PetscCall(FNEvaluateFunction(f,ds[i],&F[i]));
-      PetscCall(NEPNLEIGSAAAComputation(nep,ndpt,ds,F,&nisol,isol));
+      PetscCall(FNEvaluateFunctionArray(f,ndpt,ds,F));
+      PetscCall(NEPNLEIGSAAAComputation(nep,ndpt,1,ds,F,&nisol,isol));
       if (nisol) PetscCall(NEPNLEIGSAuxiliarRmDuplicates(nisol,isol,ndptx,dxi,ndpt));
     }
     PetscCall(PetscFree(isol));
   } else {
-    PetscCall(MatCreateVecs(nep->function,&u,NULL));
-    PetscCall(VecDuplicate(u,&v));
-    PetscCall(VecDuplicate(u,&w));
+    /* sketches u_l^* T(z) v of the matrix-valued function, approximated simultaneously */
+    PetscCall(PetscMalloc1(NSKETCHES*ndpt,&F));
+    PetscCall(MatCreateVecs(nep->function,&v,NULL));
+    PetscCall(VecDuplicate(v,&w));
+    PetscCall(VecDuplicateVecs(v,NSKETCHES,&u));
     if (nep->V) PetscCall(BVGetRandomContext(nep->V,&rand));
-    PetscCall(VecSetRandom(u,rand));
-    PetscCall(VecNormalize(u,NULL));
+    for (l=0;l<NSKETCHES;l++) {
+      PetscCall(VecSetRandom(u[l],rand));
+      PetscCall(VecNormalize(u[l],NULL));
+    }
     PetscCall(VecSetRandom(v,rand));
     PetscCall(VecNormalize(v,NULL));
     T = nep->function;
     for (i=0;i<ndpt;i++) {
       PetscCall(NEPComputeFunction(nep,ds[i],T,T));
       PetscCall(MatMult(T,v,w));
-      PetscCall(VecDot(w,u,&F[i]));
+      PetscCall(VecMDot(w,NSKETCHES,u,dots));
+      for (l=0;l<NSKETCHES;l++) F[i+l*ndpt] = dots[l];
     }
-    PetscCall(NEPNLEIGSAAAComputation(nep,ndpt,ds,F,ndptx,dxi));
-    PetscCall(VecDestroy(&u));
+    PetscCall(NEPNLEIGSAAAComputation(nep,ndpt,NSKETCHES,ds,F,ndptx,dxi));
+    PetscCall(VecDestroyVecs(NSKETCHES,&u));
     PetscCall(VecDestroy(&v));
     PetscCall(VecDestroy(&w));
   }
@@ -615,7 +652,7 @@ static PetscErrorCode NEPNLEIGSDividedDifferences_split(NEP nep)
   PetscErrorCode ierr;
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
   PetscInt       k,j,i,maxnmat,nmax;
-  PetscReal      norm0,norm,*matnorm;
+  PetscReal      norm0,norm,*matnorm,nrm;
   PetscScalar    *s=ctx->s,*beta=ctx->beta,*xi=ctx->xi,*b,alpha,*coeffs,*pK,*pH,sone=1.0;
   Mat            T,P,Ts,K,H;
   PetscBool      shell,hasmnorm=PETSC_FALSE,matrix=PETSC_TRUE;
@@ -623,7 +660,7 @@ static PetscErrorCode NEPNLEIGSDividedDifferences_split(NEP nep)
 
   PetscFunctionBegin;
   nmax = ctx->ddmaxit;
-  PetscCall(PetscMalloc1(nep->nt*nmax,&ctx->coeffD));
+  PetscCall(PetscMalloc2(nep->nt*nmax,&ctx->coeffD,nep->nt,&ctx->nnzD));
   PetscCall(PetscMalloc3(nmax+1,&b,nmax+1,&coeffs,nep->nt,&matnorm));
   for (j=0;j<nep->nt;j++) {
     PetscCall(MatHasOperation(nep->A[j],MATOP_NORM,&hasmnorm));
@@ -695,6 +732,20 @@ static PetscErrorCode NEPNLEIGSDividedDifferences_split(NEP nep)
       break;
     }
   }
+  /* Drop the trailing divided differences of each term whose accumulated contribution is
+     below the tolerance, so that terms of low degree (e.g., the polynomial part) or with
+     rapidly decaying coefficients only involve a few blocks of the linearization */
+  for (j=0;j<nep->nt;j++) {
+    norm = 0.0;
+    for (k=ctx->nmat-1;k>0;k--) {
+      nrm = PetscAbsScalar(ctx->coeffD[k*nep->nt+j]);
+      if (hasmnorm) nrm *= matnorm[j];
+      norm += nrm;
+      if (norm/norm0 >= ctx->ddtol/nep->nt) break;
+    }
+    ctx->nnzD[j] = k+1;
+    for (i=k+1;i<ctx->nmat;i++) ctx->coeffD[i*nep->nt+j] = 0.0;
+  }
   if (!ctx->ksp) PetscCall(NEPNLEIGSGetKSPs(nep,&ctx->nshiftsw,&ctx->ksp));
   PetscCall(MatIsShellAny(nep->A,nep->nt,&shell));
   maxnmat = PetscMax(ctx->ddmaxit,nep->nt);
@@ -864,13 +915,69 @@ static PetscErrorCode NEPNLEIGSKrylovConvergence(NEP nep,PetscBool getall,PetscI
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode NEPSetUp_NLEIGS(NEP nep)
+/*
+   Free the Leja-Bagby points and the divided differences, and the factorizations of the shifts
+*/
+static PetscErrorCode NEPNLEIGSResetInterpolation(NEP nep)
 {
-  PetscInt       k,in;
-  PetscScalar    zero=0.0;
+  PetscInt       k;
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
-  SlepcSC        sc;
-  PetscBool      istrivial;
+
+  PetscFunctionBegin;
+  if (nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(PetscFree2(ctx->coeffD,ctx->nnzD));
+  else if (ctx->D) {
+    for (k=0;k<ctx->nmat;k++) PetscCall(MatDestroy(&ctx->D[k]));
+  }
+  PetscCall(PetscFree4(ctx->s,ctx->xi,ctx->beta,ctx->D));
+  for (k=0;k<ctx->nshiftsw;k++) PetscCall(KSPReset(ctx->ksp[k]));
+  PetscCall(VecDestroy(&ctx->vrn));
+  ctx->ddvalid = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Check if the split operator has changed since the divided differences were computed,
+   and record the current one; the callback interface always resets the solver instead
+*/
+static PetscErrorCode NEPNLEIGSCheckSplitOperator(NEP nep,PetscBool *changed)
+{
+  PetscInt         i;
+  PetscObjectId    id;
+  PetscObjectState state;
+  NEP_NLEIGS       *ctx=(NEP_NLEIGS*)nep->data;
+
+  PetscFunctionBegin;
+  *changed = PETSC_FALSE;
+  if (nep->fui!=NEP_USER_INTERFACE_SPLIT) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ctx->ddnt!=nep->nt) {
+    PetscCall(PetscFree2(ctx->ddid,ctx->ddstate));
+    PetscCall(PetscMalloc2(2*nep->nt,&ctx->ddid,nep->nt,&ctx->ddstate));
+    ctx->ddnt = nep->nt;
+    *changed  = PETSC_TRUE;
+  }
+  for (i=0;i<nep->nt;i++) {
+    PetscCall(PetscObjectGetId((PetscObject)nep->A[i],&id));
+    if (id!=ctx->ddid[2*i]) *changed = PETSC_TRUE;
+    ctx->ddid[2*i] = id;
+    PetscCall(PetscObjectGetId((PetscObject)nep->f[i],&id));
+    if (id!=ctx->ddid[2*i+1]) *changed = PETSC_TRUE;
+    ctx->ddid[2*i+1] = id;
+    PetscCall(PetscObjectStateGet((PetscObject)nep->A[i],&state));
+    if (state!=ctx->ddstate[i]) *changed = PETSC_TRUE;
+    ctx->ddstate[i] = state;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode NEPSetUp_NLEIGS(NEP nep)
+{
+  PetscInt         k,in;
+  PetscScalar      zero=0.0;
+  NEP_NLEIGS       *ctx=(NEP_NLEIGS*)nep->data;
+  SlepcSC          sc;
+  PetscBool        istrivial,changed;
+  PetscObjectId    id;
+  PetscObjectState state;
 
   PetscFunctionBegin;
   PetscCall(NEPSetDimensions_Default(nep,nep->nev,&nep->ncv,&nep->mpd));
@@ -882,24 +989,38 @@ static PetscErrorCode NEPSetUp_NLEIGS(NEP nep)
   if (!nep->which) nep->which = NEP_TARGET_MAGNITUDE;
   PetscCheck(nep->which==NEP_TARGET_MAGNITUDE || nep->which==NEP_TARGET_REAL || nep->which==NEP_TARGET_IMAGINARY || nep->which==NEP_WHICH_USER,PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"This solver supports only target selection of eigenvalues");
 
-  /* Initialize the NLEIGS context structure */
-  k = ctx->ddmaxit;
-  PetscCall(PetscMalloc4(k,&ctx->s,k,&ctx->xi,k,&ctx->beta,k,&ctx->D));
-  nep->data = ctx;
   if (nep->tol==(PetscReal)PETSC_DETERMINE) nep->tol = SLEPC_DEFAULT_TOL;
   if (ctx->ddtol==(PetscReal)PETSC_DETERMINE) ctx->ddtol = nep->tol/10.0;
   if (!ctx->keep) ctx->keep = 0.5;
-
-  /* Compute Leja-Bagby points and scaling values */
-  PetscCall(NEPNLEIGSLejaBagbyPoints(nep));
   if (nep->problem_type!=NEP_RATIONAL) {
     PetscCall(RGCheckInside(nep->rg,1,&nep->target,&zero,&in));
     PetscCheck(in>=0,PetscObjectComm((PetscObject)nep),PETSC_ERR_SUP,"The target is not inside the target set");
   }
 
-  /* Compute the divided difference matrices */
-  if (nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(NEPNLEIGSDividedDifferences_split(nep));
-  else PetscCall(NEPNLEIGSDividedDifferences_callback(nep));
+  /* the interpolation of a previous setup is kept if the problem, the region and the shifts have not changed */
+  PetscCall(NEPNLEIGSCheckSplitOperator(nep,&changed));
+  PetscCall(PetscObjectGetId((PetscObject)nep->rg,&id));
+  PetscCall(PetscObjectStateGet((PetscObject)nep->rg,&state));
+  if (ctx->ddvalid && (changed || id!=ctx->rgid || state!=ctx->rgstate || (!ctx->nshifts && nep->target!=ctx->ddtarget))) ctx->ddvalid = PETSC_FALSE;
+  if (ctx->ddvalid) PetscCall(PetscInfo(nep,"Reusing the divided differences and shift factorizations of a previous setup\n"));
+  else {
+    PetscCall(NEPNLEIGSResetInterpolation(nep));
+
+    /* Initialize the NLEIGS context structure */
+    k = ctx->ddmaxit;
+    PetscCall(PetscMalloc4(k,&ctx->s,k,&ctx->xi,k,&ctx->beta,k,&ctx->D));
+
+    /* Compute Leja-Bagby points and scaling values */
+    PetscCall(NEPNLEIGSLejaBagbyPoints(nep));
+
+    /* Compute the divided difference matrices */
+    if (nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(NEPNLEIGSDividedDifferences_split(nep));
+    else PetscCall(NEPNLEIGSDividedDifferences_callback(nep));
+    ctx->ddvalid  = PETSC_TRUE;
+    ctx->rgid     = id;
+    ctx->rgstate  = state;
+    ctx->ddtarget = nep->target;
+  }
   PetscCall(NEPAllocateSolution(nep,ctx->nmat-1));
   PetscCall(NEPSetWorkVecs(nep,4));
   if (!ctx->fullbasis) {
@@ -940,7 +1061,7 @@ static PetscErrorCode NEPSetUp_NLEIGS(NEP nep)
 static PetscErrorCode NEPTOARExtendBasis(NEP nep,PetscInt idxrktg,PetscScalar *S,PetscInt ls,PetscInt nv,BV W,BV V,Vec t,PetscScalar *r,PetscInt lr,Vec *t_)
 {
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
-  PetscInt       deg=ctx->nmat-1,k,j;
+  PetscInt       deg=ctx->nmat-1,k,j,nc;
   Vec            v=t_[0],q=t_[1],w;
   PetscScalar    *beta=ctx->beta,*s=ctx->s,*xi=ctx->xi,*coeffs,sigma;
 
@@ -969,17 +1090,20 @@ static PetscErrorCode NEPTOARExtendBasis(NEP nep,PetscInt idxrktg,PetscScalar *S
     PetscCall(BVRestoreColumn(W,k-1,&w));
   }
   if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
-    for (j=0;j<ctx->nmat-2;j++) coeffs[j] = ctx->coeffD[nep->nt*j];
-    coeffs[ctx->nmat-2] = ctx->coeffD[nep->nt*(ctx->nmat-1)];
-    PetscCall(BVMultVec(W,1.0,0.0,v,coeffs));
-    PetscCall(MatMult(nep->A[0],v,q));
-    for (k=1;k<nep->nt;k++) {
-      for (j=0;j<ctx->nmat-2;j++) coeffs[j] = ctx->coeffD[nep->nt*j+k];
-      coeffs[ctx->nmat-2] = ctx->coeffD[nep->nt*(ctx->nmat-1)+k];
-      PetscCall(BVMultVec(W,1.0,0,v,coeffs));
-      PetscCall(MatMult(nep->A[k],v,t));
-      PetscCall(VecAXPY(q,1.0,t));
+    for (k=0;k<nep->nt;k++) {
+      /* the columns of W beyond the nonzero divided differences of the term are skipped */
+      nc = (ctx->nnzD[k]<ctx->nmat)? PetscMin(ctx->nnzD[k],deg-1): deg;
+      for (j=0;j<PetscMin(nc,deg-1);j++) coeffs[j] = ctx->coeffD[nep->nt*j+k];
+      if (nc==deg) coeffs[deg-1] = ctx->coeffD[nep->nt*deg+k];
+      PetscCall(BVSetActiveColumns(W,0,nc));
+      PetscCall(BVMultVec(W,1.0,0.0,v,coeffs));
+      if (!k) PetscCall(MatMult(nep->A[k],v,q));
+      else {
+        PetscCall(MatMult(nep->A[k],v,t));
+        PetscCall(VecAXPY(q,1.0,t));
+      }
     }
+    PetscCall(BVSetActiveColumns(W,0,deg));
     PetscCall(KSPSolve(ctx->ksp[idxrktg],q,t));
     PetscCall(VecScale(t,-1.0));
   } else {
@@ -1294,6 +1418,7 @@ static PetscErrorCode NEPNLEIGSSetSingularitiesFunction_NLEIGS(NEP nep,PetscErro
   PetscFunctionBegin;
   if (fun) nepctx->computesingularities = fun;
   if (ctx) nepctx->singularitiesctx     = ctx;
+  nepctx->ddvalid = PETSC_FALSE;
   nep->state = NEP_STATE_INITIAL;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1528,11 +1653,16 @@ static PetscErrorCode NEPNLEIGSSetInterpolation_NLEIGS(NEP nep,PetscReal tol,Pet
 
   PetscFunctionBegin;
   if (tol == (PetscReal)PETSC_DETERMINE) {
-    ctx->ddtol = PETSC_DETERMINE;
-    nep->state = NEP_STATE_INITIAL;
+    ctx->ddtol   = PETSC_DETERMINE;
+    ctx->ddvalid = PETSC_FALSE;
+    nep->state   = NEP_STATE_INITIAL;
   } else if (tol != (PetscReal)PETSC_CURRENT) {
     PetscCheck(tol>0.0,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of tol. Must be > 0");
-    ctx->ddtol = tol;
+    if (ctx->ddtol != tol) {
+      ctx->ddtol   = tol;
+      ctx->ddvalid = PETSC_FALSE;
+      nep->state   = NEP_STATE_INITIAL;
+    }
   }
   if (degree == PETSC_DETERMINE) {
     ctx->ddmaxit = 0;
@@ -1568,6 +1698,13 @@ static PetscErrorCode NEPNLEIGSSetInterpolation_NLEIGS(NEP nep,PetscReal tol,Pet
    PETSC_CURRENT can be used to preserve the current value of any of the
    arguments, and PETSC_DETERMINE to set them to a default value.
 
+   The divided differences and the factorizations of the shifts are kept in the
+   solver after the setup, and are reused in subsequent solves as long as the
+   region, the shifts (or the target) and the interpolation parameters do not
+   change. Setting new problem matrices or functions discards them. If the user
+   changes the nonlinear function in a different way, e.g., by modifying data
+   of the callback context, NEPReset() must be called before the next solve.
+
    Level: advanced
 
 .seealso: NEPNLEIGSGetInterpolation()
@@ -1633,6 +1770,7 @@ static PetscErrorCode NEPNLEIGSSetRKShifts_NLEIGS(NEP nep,PetscInt ns,PetscScala
     for (i=0;i<ns;i++) ctx->shifts[i] = shifts[i];
   }
   ctx->nshifts = ns;
+  ctx->ddvalid = PETSC_FALSE;
   nep->state   = NEP_STATE_INITIAL;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1956,13 +2094,7 @@ static PetscErrorCode NEPReset_NLEIGS(NEP nep)
   NEP_NLEIGS     *ctx=(NEP_NLEIGS*)nep->data;
 
   PetscFunctionBegin;
-  if (nep->fui==NEP_USER_INTERFACE_SPLIT) PetscCall(PetscFree(ctx->coeffD));
-  else {
-    for (k=0;k<ctx->nmat;k++) PetscCall(MatDestroy(&ctx->D[k]));
-  }
-  PetscCall(PetscFree4(ctx->s,ctx->xi,ctx->beta,ctx->D));
-  for (k=0;k<ctx->nshiftsw;k++) PetscCall(KSPReset(ctx->ksp[k]));
-  PetscCall(VecDestroy(&ctx->vrn));
+  PetscCall(NEPNLEIGSResetInterpolation(nep));
   if (ctx->fullbasis) {
     PetscCall(MatDestroy(&ctx->A));
     PetscCall(EPSReset(ctx->eps));
@@ -1982,6 +2114,7 @@ static PetscErrorCode NEPDestroy_NLEIGS(NEP nep)
   PetscCall(PetscFree(ctx->ksp));
   if (ctx->nshifts) PetscCall(PetscFree(ctx->shifts));
   if (ctx->fullbasis) PetscCall(EPSDestroy(&ctx->eps));
+  PetscCall(PetscFree2(ctx->ddid,ctx->ddstate));
   PetscCall(PetscFree(nep->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPNLEIGSSetSingularitiesFunction_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPNLEIGSGetSingularitiesFunction_C",NULL));
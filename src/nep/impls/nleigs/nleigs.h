@@ -15,6 +15,7 @@
 
 #define  LBPOINTS  100   /* default value of the maximum number of Leja-Bagby points */
 #define  NDPOINTS  1e4   /* number of discretization points */
+#define  NSKETCHES 4     /* number of sketches of T(z) used by AAA in the callback interface */
 
 typedef struct {
   BV             V;         /* tensor vector basis for the linearization */
@@ -24,6 +25,7 @@ typedef struct {
   PetscScalar    *beta;     /* scaling factors */
   Mat            *D;        /* divided difference matrices */
   PetscScalar    *coeffD;   /* coefficients for divided differences in split form */
+  PetscInt       *nnzD;     /* number of nonzero divided differences of each term in split form */
   PetscInt       nshifts;   /* provided number of shifts */
   PetscScalar    *shifts;   /* user-provided shifts for the Rational Krylov variant */
   PetscInt       nshiftsw;  /* actual number of shifts (1 if Krylov-Schur) */
@@ -38,6 +40,13 @@ typedef struct {
   EPS            eps;       /* eigensolver used in the full basis variant */
   Mat            A;         /* shell matrix used for the eps in full basis */
   Vec            w[6];      /* work vectors */
+  PetscBool      ddvalid;   /* the divided differences of a previous setup can be reused */
+  PetscObjectId  rgid;      /* id of the region used to compute the divided differences */
+  PetscObjectState rgstate; /* state of the region used to compute the divided differences */
+  PetscScalar    ddtarget;  /* target used in the shift factorizations */
+  PetscInt       ddnt;      /* number of split terms used to compute the divided differences */
+  PetscObjectId  *ddid;     /* ids of the split matrices and functions (2*ddnt) */
+  PetscObjectState *ddstate; /* states of the split matrices (ddnt) */
   void           *singularitiesctx;
   PetscErrorCode (*computesingularities)(NEP,PetscInt*,PetscScalar*,void*);
 } NEP_NLEIGS;
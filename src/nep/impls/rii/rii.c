@@ -28,6 +28,7 @@
 typedef struct {
   PetscInt  max_inner_it;     /* maximum number of Newton iterations */
   PetscInt  lag;              /* interval to rebuild preconditioner */
+  PetscBool lagadapt;         /* rebuild the preconditioner when the convergence degrades */
   PetscBool cctol;            /* constant correction tolerance */
   PetscBool herm;             /* whether the Hermitian version of the scalar equation must be used */
   PetscReal deftol;           /* tolerance for the deflation (threshold) */
@@ -58,7 +59,7 @@ static PetscErrorCode NEPSolve_RII(NEP nep)
   PetscScalar        lambda,lambda2,sigma,a1,a2,corr;
   PetscReal          nrm,resnorm=1.0,ktol=0.1,perr,rtol;
   PetscBool          skip=PETSC_FALSE,lock=PETSC_FALSE;
-  PetscInt           inner_its,its=0;
+  PetscInt           inner_its,its=0,lastupd=0,kits=0,kits0=0;
   NEP_EXT_OP         extop=NULL;
   KSPConvergedReason kspreason;
 
@@ -154,7 +155,15 @@ static PetscErrorCode NEPSolve_RII(NEP nep)
     if (nep->reason == NEP_CONVERGED_ITERATING) {
       if (!skip) {
         /* update preconditioner and set adaptive tolerance */
-        if (ctx->lag && !(its%ctx->lag) && its>=2*ctx->lag && perr && nep->errest[nep->nconv]>.5*perr) PetscCall(NEPDeflationSolveSetUp(extop,lambda2));
+        if (ctx->lagadapt) {
+          /* rebuild if the residual decreases slowly or the linear solves become more expensive */
+          if (ctx->lag && its-lastupd>=ctx->lag && ((perr && nep->errest[nep->nconv]>.5*perr) || (kits0 && kits>2*kits0))) {
+            PetscCall(PetscInfo(nep,"iter=%" PetscInt_FMT ", rebuilding the preconditioner\n",nep->its+its));
+            PetscCall(NEPDeflationSolveSetUp(extop,lambda2));
+            lastupd = its;
+            kits0   = 0;
+          }
+        } else if (ctx->lag && !(its%ctx->lag) && its>=2*ctx->lag && perr && nep->errest[nep->nconv]>.5*perr) PetscCall(NEPDeflationSolveSetUp(extop,lambda2));
         if (!ctx->cctol) {
           ktol = PetscMax(ktol/2.0,rtol);
           PetscCall(KSPSetTolerances(ctx->ksp,ktol,PETSC_CURRENT,PETSC_CURRENT,PETSC_CURRENT));
@@ -168,6 +177,8 @@ static PetscErrorCode NEPSolve_RII(NEP nep)
           nep->reason = NEP_DIVERGED_LINEAR_SOLVE;
           break;
         }
+        PetscCall(KSPGetIterationNumber(ctx->ksp,&kits));
+        if (!kits0) kits0 = kits;
 
         /* update eigenvector: u = u - delta */
         PetscCall(VecAXPY(u,-1.0,delta));
@@ -176,6 +187,8 @@ static PetscErrorCode NEPSolve_RII(NEP nep)
         PetscCall(VecNormalize(u,NULL));
       } else {
         its = -1;
+        lastupd = -1;
+        kits0 = 0;
         PetscCall(NEPDeflationSetRandomVec(extop,u));
         PetscCall(NEPDeflationSolveSetUp(extop,sigma));
         PetscCall(VecCopy(u,r));
@@ -225,6 +238,8 @@ static PetscErrorCode NEPSetFromOptions_RII(NEP nep,PetscOptionItems *PetscOptio
     PetscCall(PetscOptionsInt("-nep_rii_lag_preconditioner","Interval to rebuild preconditioner","NEPRIISetLagPreconditioner",ctx->lag,&i,&flg));
     if (flg) PetscCall(NEPRIISetLagPreconditioner(nep,i));
 
+    PetscCall(PetscOptionsBool("-nep_rii_lag_adaptive","Rebuild the preconditioner only when the convergence degrades","NEPRIISetLagAdaptive",ctx->lagadapt,&ctx->lagadapt,NULL));
+
     r = 0.0;
     PetscCall(PetscOptionsReal("-nep_rii_deflation_threshold","Tolerance used as a threshold for including deflated eigenpairs","NEPRIISetDeflationThreshold",ctx->deftol,&r,&flg));
     if (flg) PetscCall(NEPRIISetDeflationThreshold(nep,r));
@@ -381,6 +396,87 @@ PetscErrorCode NEPRIIGetLagPreconditioner(NEP nep,PetscInt *lag)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode NEPRIISetLagAdaptive_RII(NEP nep,PetscBool adapt)
+{
+  NEP_RII *ctx = (NEP_RII*)nep->data;
+
+  PetscFunctionBegin;
+  ctx->lagadapt = adapt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   NEPRIISetLagAdaptive - Sets a flag to rebuild the preconditioner only when
+   the convergence of the nonlinear iteration degrades.
+
+   Logically Collective
+
+   Input Parameters:
++  nep   - nonlinear eigenvalue solver
+-  adapt - a boolean value
+
+   Options Database Keys:
+.  -nep_rii_lag_adaptive <bool> - set the boolean flag
+
+   Notes:
+   By default, the preconditioner is rebuilt with the current eigenvalue
+   approximation every lag iterations (see NEPRIISetLagPreconditioner()),
+   provided that the residual has not been reduced enough. If this flag is
+   set, the lag is taken as the minimum number of iterations between two
+   rebuilds, and the preconditioner is rebuilt whenever the residual norm
+   is not halved in one iteration, or the number of iterations of the linear
+   solver doubles with respect to the first solve after the last rebuild.
+
+   With a direct solver, the matrix keeps the same nonzero pattern in all
+   rebuilds, so the symbolic factorization is reused.
+
+   Level: intermediate
+
+.seealso: NEPRIIGetLagAdaptive(), NEPRIISetLagPreconditioner()
+@*/
+PetscErrorCode NEPRIISetLagAdaptive(NEP nep,PetscBool adapt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(nep,adapt,2);
+  PetscTryMethod(nep,"NEPRIISetLagAdaptive_C",(NEP,PetscBool),(nep,adapt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode NEPRIIGetLagAdaptive_RII(NEP nep,PetscBool *adapt)
+{
+  NEP_RII *ctx = (NEP_RII*)nep->data;
+
+  PetscFunctionBegin;
+  *adapt = ctx->lagadapt;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   NEPRIIGetLagAdaptive - Returns the flag indicating whether the preconditioner
+   is rebuilt only when the convergence degrades.
+
+   Not Collective
+
+   Input Parameter:
+.  nep - nonlinear eigenvalue solver
+
+   Output Parameter:
+.  adapt - the value of the flag
+
+   Level: intermediate
+
+.seealso: NEPRIISetLagAdaptive()
+@*/
+PetscErrorCode NEPRIIGetLagAdaptive(NEP nep,PetscBool *adapt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
+  PetscAssertPointer(adapt,2);
+  PetscUseMethod(nep,"NEPRIIGetLagAdaptive_C",(NEP,PetscBool*),(nep,adapt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode NEPRIISetConstCorrectionTol_RII(NEP nep,PetscBool cct)
 {
   NEP_RII *ctx = (NEP_RII*)nep->data;
@@ -696,7 +792,8 @@ static PetscErrorCode NEPView_RII(NEP nep,PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer,"  maximum number of inner iterations: %" PetscInt_FMT "\n",ctx->max_inner_it));
     if (ctx->cctol) PetscCall(PetscViewerASCIIPrintf(viewer,"  using a constant tolerance for the linear solver\n"));
     if (ctx->herm) PetscCall(PetscViewerASCIIPrintf(viewer,"  using the Hermitian version of the scalar nonlinear equation\n"));
-    if (ctx->lag) PetscCall(PetscViewerASCIIPrintf(viewer,"  updating the preconditioner every %" PetscInt_FMT " iterations\n",ctx->lag));
+    if (ctx->lag && ctx->lagadapt) PetscCall(PetscViewerASCIIPrintf(viewer,"  updating the preconditioner adaptively, at least %" PetscInt_FMT " iterations apart\n",ctx->lag));
+    else if (ctx->lag) PetscCall(PetscViewerASCIIPrintf(viewer,"  updating the preconditioner every %" PetscInt_FMT " iterations\n",ctx->lag));
     if (ctx->deftol) PetscCall(PetscViewerASCIIPrintf(viewer,"  deflation threshold: %g\n",(double)ctx->deftol));
     if (!ctx->ksp) PetscCall(NEPRIIGetKSP(nep,&ctx->ksp));
     PetscCall(PetscViewerASCIIPushTab(viewer));
@@ -726,6 +823,8 @@ static PetscErrorCode NEPDestroy_RII(NEP nep)
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetMaximumIterations_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetLagPreconditioner_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetLagPreconditioner_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetLagAdaptive_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetLagAdaptive_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetConstCorrectionTol_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetConstCorrectionTol_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetHermitian_C",NULL));
@@ -746,6 +845,7 @@ SLEPC_EXTERN PetscErrorCode NEPCreate_RII(NEP nep)
   nep->data = (void*)ctx;
   ctx->max_inner_it = 10;
   ctx->lag          = 1;
+  ctx->lagadapt     = PETSC_FALSE;
   ctx->cctol        = PETSC_FALSE;
   ctx->herm         = PETSC_FALSE;
   ctx->deftol       = 0.0;
@@ -764,6 +864,8 @@ SLEPC_EXTERN PetscErrorCode NEPCreate_RII(NEP nep)
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetMaximumIterations_C",NEPRIIGetMaximumIterations_RII));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetLagPreconditioner_C",NEPRIISetLagPreconditioner_RII));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetLagPreconditioner_C",NEPRIIGetLagPreconditioner_RII));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetLagAdaptive_C",NEPRIISetLagAdaptive_RII));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetLagAdaptive_C",NEPRIIGetLagAdaptive_RII));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetConstCorrectionTol_C",NEPRIISetConstCorrectionTol_RII));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIIGetConstCorrectionTol_C",NEPRIIGetConstCorrectionTol_RII));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPRIISetHermitian_C",NEPRIISetHermitian_RII));
@@ -20,6 +20,7 @@ struct _n_nep_def_ctx {
   PetscInt    n;
   PetscBool   ref;
   PetscScalar *eig;
+  PetscScalar *work;   /* workspace of the deflated operators, of size 2*sz */
   BV          V,W;
 };
 
@@ -115,7 +116,7 @@ static PetscErrorCode NEPDeflationNEDestroy(NEP_NEDEF_CTX defctx)
 {
   PetscFunctionBegin;
   if (!defctx) PetscFunctionReturn(PETSC_SUCCESS);
-  PetscCall(PetscFree(defctx->eig));
+  PetscCall(PetscFree2(defctx->eig,defctx->work));
   PetscCall(PetscFree(defctx));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -129,7 +130,7 @@ static PetscErrorCode NEPDeflationNECreate(NEP nep,BV V,BV W,PetscInt sz,NEP_NED
   *defctx = op;
   op->n   = 0;
   op->ref = PETSC_FALSE;
-  PetscCall(PetscCalloc1(sz,&op->eig));
+  PetscCall(PetscCalloc2(sz,&op->eig,2*sz,&op->work));
   PetscCall(PetscObjectStateIncrease((PetscObject)V));
   PetscCall(PetscObjectStateIncrease((PetscObject)W));
   op->V = V;
@@ -166,7 +167,7 @@ static PetscErrorCode MatMult_NEPDeflationNE(Mat M,Vec x,Vec r)
     eig = matctx->defctx->eig;
     t = matctx->w[0];
     PetscCall(VecCopy(x,t));
-    PetscCall(PetscMalloc2(k,&h,k,&alpha));
+    h = matctx->defctx->work; alpha = h+k;
     for (i=0;i<k;i++) alpha[i] = (lambda-eig[i]-1.0)/(lambda-eig[i]);
     PetscCall(BVDotVec(matctx->defctx->V,t,h));
     for (i=0;i<k;i++) h[i] *= alpha[i];
@@ -179,7 +180,6 @@ static PetscErrorCode MatMult_NEPDeflationNE(Mat M,Vec x,Vec r)
       PetscCall(MatMult(matctx->F,tt,t));
       PetscCall(VecAXPY(r,1.0,t));
     }
-    PetscCall(PetscFree2(h,alpha));
   } else PetscCall(MatMult(matctx->isJ?matctx->J:matctx->F,x,r));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -200,7 +200,7 @@ static PetscErrorCode MatMultTranspose_NEPDeflationNE(Mat M,Vec x,Vec r)
     k = matctx->defctx->n;
     lambda = matctx->lambda;
     eig = matctx->defctx->eig;
-    PetscCall(PetscMalloc2(k,&h,k,&alphaC));
+    h = matctx->defctx->work; alphaC = h+k;
     for (i=0;i<k;i++) alphaC[i] = PetscConj((lambda-eig[i]-1.0)/(lambda-eig[i]));
     PetscCall(BVDotVec(matctx->defctx->W,t,h));
     for (i=0;i<k;i++) h[i] *= alphaC[i];
@@ -215,7 +215,6 @@ static PetscErrorCode MatMultTranspose_NEPDeflationNE(Mat M,Vec x,Vec r)
       PetscCall(MatMultTranspose(matctx->F,tt,t));
       PetscCall(VecAXPY(r,1.0,t));
     }
-    PetscCall(PetscFree2(h,alphaC));
   } else PetscCall(MatMultTranspose(matctx->isJ?matctx->J:matctx->F,t,r));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -237,12 +236,11 @@ static PetscErrorCode MatSolve_NEPDeflationNE(Mat M,Vec b,Vec x)
     k = matctx->defctx->n;
     lambda = matctx->lambda;
     eig = matctx->defctx->eig;
-    PetscCall(PetscMalloc2(k,&h,k,&alpha));
+    h = matctx->defctx->work; alpha = h+k;
     PetscCall(BVDotVec(matctx->defctx->V,x,h));
     for (i=0;i<k;i++) alpha[i] = (lambda-eig[i]-1.0)/(lambda-eig[i]);
     for (i=0;i<k;i++) h[i] *= alpha[i]/(1.0-alpha[i]);
     PetscCall(BVMultVec(matctx->defctx->W,1.0,1.0,x,h));
-    PetscCall(PetscFree2(h,alpha));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -265,12 +263,11 @@ static PetscErrorCode MatSolveTranspose_NEPDeflationNE(Mat M,Vec b,Vec x)
     k = matctx->defctx->n;
     lambda = matctx->lambda;
     eig = matctx->defctx->eig;
-    PetscCall(PetscMalloc2(k,&h,k,&alphaC));
+    h = matctx->defctx->work; alphaC = h+k;
     PetscCall(BVDotVec(matctx->defctx->W,x,h));
     for (i=0;i<k;i++) alphaC[i] = PetscConj((lambda-eig[i]-1.0)/(lambda-eig[i]));
     for (i=0;i<k;i++) h[i] *= alphaC[i]/(1.0-alphaC[i]);
     PetscCall(BVMultVec(matctx->defctx->V,1.0,1.0,x,h));
-    PetscCall(PetscFree2(h,alphaC));
     PetscCall(VecConjugate(x));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -336,7 +333,7 @@ static PetscErrorCode NEPDeflationNERecoverEigenvectors(NEP_NEDEF_CTX defctx,Vec
   if (defctx->n && !defctx->ref) {
     eig = defctx->eig;
     k = defctx->n;
-    PetscCall(PetscMalloc2(k,&h,k,&alpha));
+    h = defctx->work; alpha = h+k;
     for (i=0;i<k;i++) alpha[i] = (lambda-eig[i]-1.0)/(lambda-eig[i]);
     PetscCall(BVDotVec(defctx->V,u,h));
     for (i=0;i<k;i++) h[i] *= alpha[i];
@@ -349,7 +346,6 @@ static PetscErrorCode NEPDeflationNERecoverEigenvectors(NEP_NEDEF_CTX defctx,Vec
       PetscCall(BVMultVec(defctx->V,-1.0,1.0,w,h));
       PetscCall(VecNormalize(w,NULL));
     }
-    PetscCall(PetscFree2(h,alpha));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -376,14 +372,32 @@ static PetscErrorCode NEPDeflationNESetRefine(NEP_NEDEF_CTX defctx,PetscBool ref
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes the maximum of the norms of the right and left residuals, with a single reduction
+*/
+static PetscErrorCode NEPSLPTwoSidedResidualNorm(Mat mF,Vec u,Vec w,Vec r,Vec rl,PetscReal *resnorm)
+{
+  PetscReal resl;
+
+  PetscFunctionBegin;
+  PetscCall(MatMult(mF,u,r));
+  PetscCall(MatMultTranspose(mF,w,rl));
+  PetscCall(VecNormBegin(r,NORM_2,resnorm));
+  PetscCall(VecNormBegin(rl,NORM_2,&resl));
+  PetscCall(VecNormEnd(r,NORM_2,resnorm));
+  PetscCall(VecNormEnd(rl,NORM_2,&resl));
+  *resnorm = PetscMax(*resnorm,resl);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode NEPSolve_SLP_Twosided(NEP nep)
 {
   NEP_SLP        *ctx = (NEP_SLP*)nep->data;
   Mat            mF,mJ,M,Mt;
-  Vec            u,r,t,w;
+  Vec            u,r,rl,t,w;
   BV             X,Y;
   PetscScalar    sigma,lambda,mu,im=0.0,mu2,im2;
-  PetscReal      resnorm,resl;
+  PetscReal      resnorm;
   PetscInt       nconv,nconv2,i;
   PetscBool      skip=PETSC_FALSE,lock=PETSC_FALSE;
   NEP_NEDEF_CTX  defctx=NULL;    /* Extended operator for deflation */
@@ -405,6 +419,7 @@ PetscErrorCode NEPSolve_SLP_Twosided(NEP nep)
   PetscCall(BVCopyVec(nep->V,0,u));
   PetscCall(BVCopyVec(nep->W,0,w));
   PetscCall(VecDuplicate(u,&r));
+  PetscCall(VecDuplicate(u,&rl));
   PetscCall(NEPDeflationNEFunctionCreate(defctx,nep,nep->function,nep->function_pre?nep->function_pre:nep->function,NULL,ctx->ksp,PETSC_FALSE,&mF));
   PetscCall(NEPDeflationNEFunctionCreate(defctx,nep,nep->function,nep->function,nep->jacobian,NULL,PETSC_TRUE,&mJ));
   PetscCall(NEPSLPSetUpEPSMat(nep,mF,mJ,PETSC_FALSE,&M));
@@ -418,15 +433,9 @@ PetscErrorCode NEPSolve_SLP_Twosided(NEP nep)
   while (nep->reason == NEP_CONVERGED_ITERATING) {
     nep->its++;
 
-    /* form residual,  r = T(lambda)*u (used in convergence test only) */
+    /* form residuals, r = T(lambda)*u and rl = T(lambda)^T*w (used in convergence test only) */
     PetscCall(NEPDeflationNEComputeFunction(nep,mF,lambda));
-    PetscCall(MatMultTranspose(mF,w,r));
-    PetscCall(VecNorm(r,NORM_2,&resl));
-    PetscCall(MatMult(mF,u,r));
-
-    /* convergence test */
-    PetscCall(VecNorm(r,NORM_2,&resnorm));
-    resnorm = PetscMax(resnorm,resl);
+    PetscCall(NEPSLPTwoSidedResidualNorm(mF,u,w,r,rl,&resnorm));
     PetscCall((*nep->converged)(nep,lambda,0,resnorm,&nep->errest[nep->nconv],nep->convergedctx));
     nep->eigr[nep->nconv] = lambda;
     if (nep->errest[nep->nconv]<=nep->tol || nep->errest[nep->nconv]<=ctx->deftol) {
@@ -434,11 +443,7 @@ PetscErrorCode NEPSolve_SLP_Twosided(NEP nep)
         PetscCall(NEPDeflationNERecoverEigenvectors(defctx,u,w,lambda));
         PetscCall(VecConjugate(w));
         PetscCall(NEPDeflationNESetRefine(defctx,PETSC_TRUE));
-        PetscCall(MatMultTranspose(mF,w,r));
-        PetscCall(VecNorm(r,NORM_2,&resl));
-        PetscCall(MatMult(mF,u,r));
-        PetscCall(VecNorm(r,NORM_2,&resnorm));
-        resnorm = PetscMax(resnorm,resl);
+        PetscCall(NEPSLPTwoSidedResidualNorm(mF,u,w,r,rl,&resnorm));
         PetscCall((*nep->converged)(nep,lambda,0,resnorm,&nep->errest[nep->nconv],nep->convergedctx));
         if (nep->errest[nep->nconv]<=nep->tol) lock = PETSC_TRUE;
       } else if (nep->errest[nep->nconv]<=nep->tol) lock = PETSC_TRUE;
@@ -512,6 +517,7 @@ PetscErrorCode NEPSolve_SLP_Twosided(NEP nep)
   PetscCall(VecDestroy(&u));
   PetscCall(VecDestroy(&w));
   PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&rl));
   PetscCall(MatDestroy(&mF));
   PetscCall(MatDestroy(&mJ));
   PetscCall(BVDestroy(&X));
@@ -148,8 +148,8 @@ PetscErrorCode NEPSolve_SLP(NEP nep)
   Vec               uu,u,r;
   PetscScalar       sigma,lambda,mu,im;
   PetscReal         resnorm;
-  PetscInt          nconv;
-  PetscBool         skip=PETSC_FALSE,lock=PETSC_FALSE;
+  PetscInt          nconv,lastupd=0,kits=0,kits0=0;
+  PetscBool         skip=PETSC_FALSE,lock=PETSC_FALSE,direct,reuse=PETSC_FALSE;
   NEP_EXT_OP        extop=NULL;    /* Extended operator for deflation */
 
   PetscFunctionBegin;
@@ -158,6 +158,7 @@ PetscErrorCode NEPSolve_SLP(NEP nep)
   if (!nep->nini) PetscCall(BVSetRandomColumn(nep->V,0));
   lambda = sigma;
   if (!ctx->ksp) PetscCall(NEPSLPGetKSP(nep,&ctx->ksp));
+  PetscCall(PetscObjectTypeCompare((PetscObject)ctx->ksp,KSPPREONLY,&direct));
   PetscCall(NEPDeflationInitialize(nep,nep->V,ctx->ksp,PETSC_TRUE,nep->nev,&extop));
   PetscCall(NEPDeflationCreateVec(extop,&u));
   PetscCall(VecDuplicate(u,&r));
@@ -200,10 +201,22 @@ PetscErrorCode NEPSolve_SLP(NEP nep)
 
     if (nep->reason == NEP_CONVERGED_ITERATING) {
       if (!skip) {
+        /* keep the preconditioner of an iterative solver unless its number of iterations doubles */
+        if (!direct && ctx->lag!=1 && nep->its>1) {
+          reuse = (!ctx->lag || nep->its-lastupd<ctx->lag)? PETSC_TRUE: PETSC_FALSE;
+          if (kits0 && kits>2*kits0) reuse = PETSC_FALSE;
+          PetscCall(KSPSetReusePreconditioner(ctx->ksp,reuse));
+          if (!reuse) {
+            lastupd = nep->its;
+            kits0   = 0;
+          }
+        }
         /* evaluate T(lambda) and T'(lambda) */
         PetscCall(NEPSLPSetUpLinearEP(nep,extop,lambda,u,nep->its==1?PETSC_TRUE:PETSC_FALSE));
         /* compute new eigenvalue correction mu and eigenvector approximation u */
         PetscCall(EPSSolve(ctx->eps));
+        PetscCall(KSPGetIterationNumber(ctx->ksp,&kits));
+        if (!kits0) kits0 = kits;
         PetscCall(EPSGetConverged(ctx->eps,&nconv));
         if (!nconv) {
           PetscCall(PetscInfo(nep,"iter=%" PetscInt_FMT ", inner iteration failed, stopping solve\n",nep->its));
@@ -239,6 +252,7 @@ PetscErrorCode NEPSolve_SLP(NEP nep)
   PetscCall(DSRestoreMat(nep->ds,DS_MAT_A,&A));
   PetscCall(MatDestroy(&H));
   PetscCall(DSSolve(nep->ds,nep->eigr,nep->eigi));
+  if (reuse) PetscCall(KSPSetReusePreconditioner(ctx->ksp,PETSC_FALSE));
   PetscCall(NEPDeflationReset(extop));
   PetscCall(VecDestroy(&u));
   PetscCall(VecDestroy(&r));
@@ -250,6 +264,7 @@ static PetscErrorCode NEPSetFromOptions_SLP(NEP nep,PetscOptionItems *PetscOptio
   NEP_SLP        *ctx = (NEP_SLP*)nep->data;
   PetscBool      flg;
   PetscReal      r;
+  PetscInt       i;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject,"NEP SLP Options");
@@ -258,6 +273,10 @@ static PetscErrorCode NEPSetFromOptions_SLP(NEP nep,PetscOptionItems *PetscOptio
     PetscCall(PetscOptionsReal("-nep_slp_deflation_threshold","Tolerance used as a threshold for including deflated eigenpairs","NEPSLPSetDeflationThreshold",ctx->deftol,&r,&flg));
     if (flg) PetscCall(NEPSLPSetDeflationThreshold(nep,r));
 
+    i = 0;
+    PetscCall(PetscOptionsInt("-nep_slp_lag_preconditioner","Interval to rebuild preconditioner","NEPSLPSetLagPreconditioner",ctx->lag,&i,&flg));
+    if (flg) PetscCall(NEPSLPSetLagPreconditioner(nep,i));
+
   PetscOptionsHeadEnd();
 
   if (!ctx->eps) PetscCall(NEPSLPGetEPS(nep,&ctx->eps));
@@ -353,6 +372,88 @@ PetscErrorCode NEPSLPGetDeflationThreshold(NEP nep,PetscReal *deftol)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode NEPSLPSetLagPreconditioner_SLP(NEP nep,PetscInt lag)
+{
+  NEP_SLP *ctx = (NEP_SLP*)nep->data;
+
+  PetscFunctionBegin;
+  PetscCheck(lag>=0,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_OUTOFRANGE,"Lag must be non-negative");
+  ctx->lag = lag;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   NEPSLPSetLagPreconditioner - Determines when the preconditioner of the linear
+   solves is rebuilt in the nonlinear iteration.
+
+   Logically Collective
+
+   Input Parameters:
++  nep - nonlinear eigenvalue solver
+-  lag - 0 indicates NEVER rebuild, 1 means rebuild every time T(lambda) is
+          computed within the nonlinear iteration, 2 means every second time, etc.
+
+   Options Database Keys:
+.  -nep_slp_lag_preconditioner <lag> - the lag value
+
+   Notes:
+   The default is 1. The linear systems with T(lambda) in the inner eigensolver
+   are always solved with the current eigenvalue approximation, only the
+   preconditioner is kept from a previous iteration. Regardless of the lag, the
+   preconditioner is rebuilt whenever the number of iterations of the linear
+   solver doubles with respect to the first solve after the last rebuild.
+
+   The lag has no effect if the KSP is of type KSPPREONLY, since a lagged
+   direct solver would not solve the linear eigenproblem of the current
+   iteration. The symbolic factorization is reused in any case, since T(lambda)
+   keeps the same nonzero pattern.
+
+   Level: intermediate
+
+.seealso: NEPSLPGetLagPreconditioner(), NEPRIISetLagPreconditioner()
+@*/
+PetscErrorCode NEPSLPSetLagPreconditioner(NEP nep,PetscInt lag)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(nep,lag,2);
+  PetscTryMethod(nep,"NEPSLPSetLagPreconditioner_C",(NEP,PetscInt),(nep,lag));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode NEPSLPGetLagPreconditioner_SLP(NEP nep,PetscInt *lag)
+{
+  NEP_SLP *ctx = (NEP_SLP*)nep->data;
+
+  PetscFunctionBegin;
+  *lag = ctx->lag;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   NEPSLPGetLagPreconditioner - Indicates how often the preconditioner is rebuilt.
+
+   Not Collective
+
+   Input Parameter:
+.  nep - nonlinear eigenvalue solver
+
+   Output Parameter:
+.  lag - the lag parameter
+
+   Level: intermediate
+
+.seealso: NEPSLPSetLagPreconditioner()
+@*/
+PetscErrorCode NEPSLPGetLagPreconditioner(NEP nep,PetscInt *lag)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
+  PetscAssertPointer(lag,2);
+  PetscUseMethod(nep,"NEPSLPGetLagPreconditioner_C",(NEP,PetscInt*),(nep,lag));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode NEPSLPSetEPS_SLP(NEP nep,EPS eps)
 {
   NEP_SLP        *ctx = (NEP_SLP*)nep->data;
@@ -597,6 +698,7 @@ static PetscErrorCode NEPView_SLP(NEP nep,PetscViewer viewer)
   PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
   if (isascii) {
     if (ctx->deftol) PetscCall(PetscViewerASCIIPrintf(viewer,"  deflation threshold: %g\n",(double)ctx->deftol));
+    if (ctx->lag!=1) PetscCall(PetscViewerASCIIPrintf(viewer,"  updating the preconditioner every %" PetscInt_FMT " iterations\n",ctx->lag));
     if (!ctx->eps) PetscCall(NEPSLPGetEPS(nep,&ctx->eps));
     PetscCall(PetscViewerASCIIPushTab(viewer));
     PetscCall(EPSView(ctx->eps,viewer));
@@ -633,6 +735,8 @@ static PetscErrorCode NEPDestroy_SLP(NEP nep)
   PetscCall(PetscFree(nep->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetDeflationThreshold_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetDeflationThreshold_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetLagPreconditioner_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetLagPreconditioner_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetEPS_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetEPS_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetEPSLeft_C",NULL));
@@ -652,6 +756,7 @@ SLEPC_EXTERN PetscErrorCode NEPCreate_SLP(NEP nep)
 
   nep->useds  = PETSC_TRUE;
   ctx->deftol = PETSC_DETERMINE;
+  ctx->lag    = 1;
 
   nep->ops->solve          = NEPSolve_SLP;
   nep->ops->setup          = NEPSetUp_SLP;
@@ -663,6 +768,8 @@ SLEPC_EXTERN PetscErrorCode NEPCreate_SLP(NEP nep)
 
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetDeflationThreshold_C",NEPSLPSetDeflationThreshold_SLP));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetDeflationThreshold_C",NEPSLPGetDeflationThreshold_SLP));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetLagPreconditioner_C",NEPSLPSetLagPreconditioner_SLP));
+  PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetLagPreconditioner_C",NEPSLPGetLagPreconditioner_SLP));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetEPS_C",NEPSLPSetEPS_SLP));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPGetEPS_C",NEPSLPGetEPS_SLP));
   PetscCall(PetscObjectComposeFunction((PetscObject)nep,"NEPSLPSetEPSLeft_C",NEPSLPSetEPSLeft_SLP));
@@ -18,6 +18,7 @@ typedef struct {
   EPS       epsts;    /* linear eigensolver for T'*z = mu*Tp'*z */
   KSP       ksp;
   PetscReal deftol;   /* tolerance for the deflation (threshold) */
+  PetscInt  lag;      /* interval to rebuild the preconditioner of the linear solves */
 } NEP_SLP;
 
 SLEPC_INTERN PetscErrorCode NEPSolve_SLP(NEP);
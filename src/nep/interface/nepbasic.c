@@ -97,6 +97,8 @@ PetscErrorCode NEPCreate(MPI_Comm comm,NEP *outnep)
   nep->mstr            = UNKNOWN_NONZERO_PATTERN;
   nep->P               = NULL;
   nep->mstrp           = UNKNOWN_NONZERO_PATTERN;
+  nep->munion          = PETSC_FALSE;
+  nep->munionp         = PETSC_FALSE;
   nep->IS              = NULL;
   nep->eigr            = NULL;
   nep->eigi            = NULL;
@@ -112,6 +114,7 @@ PetscErrorCode NEPCreate(MPI_Comm comm,NEP *outnep)
   nep->n               = 0;
   nep->nloc            = 0;
   nep->nrma            = NULL;
+  nep->AV              = NULL;
   nep->fui             = (NEPUserInterface)0;
   nep->useds           = PETSC_FALSE;
   nep->resolvent       = NULL;
@@ -287,7 +290,13 @@ PetscErrorCode NEPReset_Problem(NEP nep)
   PetscCall(MatDestroy(&nep->function));
   PetscCall(MatDestroy(&nep->function_pre));
   PetscCall(MatDestroy(&nep->jacobian));
+  nep->munion  = PETSC_FALSE;
+  nep->munionp = PETSC_FALSE;
   if (nep->fui==NEP_USER_INTERFACE_SPLIT) {
+    if (nep->AV) {
+      for (i=0;i<nep->nt;i++) PetscCall(BVDestroy(&nep->AV[i]));
+      PetscCall(PetscFree(nep->AV));
+    }
     PetscCall(MatDestroyMatrices(nep->nt,&nep->A));
     for (i=0;i<nep->nt;i++) PetscCall(FNDestroy(&nep->f[i]));
     PetscCall(PetscFree(nep->f));
@@ -816,7 +825,9 @@ PetscErrorCode NEPGetJacobian(NEP nep,Mat *A,NEPJacobianFn **jac,void **ctx)
    in the pattern of the first one, then use SUBSET_NONZERO_PATTERN. If
    patterns are known to be different, use DIFFERENT_NONZERO_PATTERN.
    If set to UNKNOWN_NONZERO_PATTERN, the patterns will be compared to
-   determine if they are equal.
+   determine if they are equal. In the last two cases, the union of the
+   patterns is computed once in NEPSetUp(), so that subsequent evaluations
+   of T(lambda) do not need to allocate a new matrix.
 
    This function must be called before NEPSetUp(). If it is called again
    after NEPSetUp() then the NEP object is reset.
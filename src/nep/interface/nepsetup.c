@@ -13,6 +13,28 @@
 
 #include <slepc/private/nepimpl.h>       /*I "slepcnep.h" I*/
 
+/*
+   Creates a matrix with the union of the nonzero patterns of the split matrices, so
+   that the linear combinations in NEPComputeFunction() and NEPComputeJacobian() are
+   done in place, without allocating a new matrix each time
+*/
+PetscErrorCode NEPCreateSplitMatrix_Private(PetscInt nt,Mat *A,MatStructure str,Mat *T,PetscBool *munion)
+{
+  PetscInt       i;
+  PetscBool      shell;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(T));
+  PetscCall(MatDuplicate(A[0],MAT_DO_NOT_COPY_VALUES,T));
+  PetscCall(MatIsShellAny(A,nt,&shell));
+  *munion = (!shell && (str==DIFFERENT_NONZERO_PATTERN || str==UNKNOWN_NONZERO_PATTERN))? PETSC_TRUE: PETSC_FALSE;
+  if (*munion) {
+    for (i=1;i<nt;i++) PetscCall(MatAXPY(*T,1.0,A[i],str));
+    PetscCall(MatZeroEntries(*T));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    NEPSetDSType - Sets the type of the internal DS object based on the current
    settings of the nonlinear eigensolver.
@@ -91,9 +113,9 @@ PetscErrorCode NEPSetUp(NEP nep)
     PetscCall(MatGetLocalSize(T,&nep->nloc,NULL));
     break;
   case NEP_USER_INTERFACE_SPLIT:
-    PetscCall(MatDuplicate(nep->A[0],MAT_DO_NOT_COPY_VALUES,&nep->function));
-    if (nep->P) PetscCall(MatDuplicate(nep->P[0],MAT_DO_NOT_COPY_VALUES,&nep->function_pre));
-    PetscCall(MatDuplicate(nep->A[0],MAT_DO_NOT_COPY_VALUES,&nep->jacobian));
+    PetscCall(NEPCreateSplitMatrix_Private(nep->nt,nep->A,nep->mstr,&nep->function,&nep->munion));
+    if (nep->P) PetscCall(NEPCreateSplitMatrix_Private(nep->nt,nep->P,nep->mstrp,&nep->function_pre,&nep->munionp));
+    PetscCall(NEPCreateSplitMatrix_Private(nep->nt,nep->A,nep->mstr,&nep->jacobian,&nep->munion));
     PetscCall(MatGetSize(nep->A[0],&nep->n,NULL));
     PetscCall(MatGetLocalSize(nep->A[0],&nep->nloc,NULL));
     break;
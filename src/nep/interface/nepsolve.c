@@ -157,7 +157,9 @@ PetscErrorCode NEPSolve(NEP nep)
    operator is equal to sum_i V'*A_i*V*f_i(lambda), so this function
    computes all matrices Ei = V'*A_i*V, and stores them in the extra
    matrices inside DS. Only rows/columns in the range [j0,j1-1] are computed,
-   the previous ones are assumed to be available already.
+   the previous ones are assumed to be available already. The products A_i*V
+   are kept internally and only computed for the new columns, so columns of V
+   before j0 must not have been modified since the previous call.
 
    Level: developer
 
@@ -165,7 +167,7 @@ PetscErrorCode NEPSolve(NEP nep)
 @*/
 PetscErrorCode NEPProjectOperator(NEP nep,PetscInt j0,PetscInt j1)
 {
-  PetscInt       k;
+  PetscInt       k,m,ma=0;
   Mat            G;
 
   PetscFunctionBegin;
@@ -174,10 +176,22 @@ PetscErrorCode NEPProjectOperator(NEP nep,PetscInt j0,PetscInt j1)
   PetscValidLogicalCollectiveInt(nep,j1,3);
   NEPCheckProblem(nep,1);
   NEPCheckSplit(nep,1);
+  PetscCall(BVGetSizes(nep->V,NULL,NULL,&m));
+  if (nep->AV) PetscCall(BVGetSizes(nep->AV[0],NULL,NULL,&ma));
+  if (ma!=m) {
+    if (!nep->AV) PetscCall(PetscCalloc1(nep->nt,&nep->AV));
+    for (k=0;k<nep->nt;k++) {
+      PetscCall(BVDestroy(&nep->AV[k]));
+      PetscCall(BVDuplicate(nep->V,&nep->AV[k]));
+    }
+  }
   PetscCall(BVSetActiveColumns(nep->V,j0,j1));
   for (k=0;k<nep->nt;k++) {
+    /* border the projection with the new columns of A_k*V */
+    PetscCall(BVSetActiveColumns(nep->AV[k],j0,j1));
+    PetscCall(BVMatMult(nep->V,nep->A[k],nep->AV[k]));
     PetscCall(DSGetMat(nep->ds,DSMatExtra[k],&G));
-    PetscCall(BVMatProject(nep->V,nep->A[k],nep->V,G));
+    PetscCall(BVMatProject(nep->AV[k],NULL,nep->V,G));
     PetscCall(DSRestoreMat(nep->ds,DSMatExtra[k],&G));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -623,6 +637,53 @@ PetscErrorCode NEPComputeResidualNorm_Private(NEP nep,PetscBool adj,PetscScalar
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   NEPComputeErrorType_Private - Scales the residual norm of an eigenpair according to the
+   error type, er is the norm of the eigenvector
+*/
+static PetscErrorCode NEPComputeErrorType_Private(NEP nep,PetscScalar kr,PetscReal er,NEPErrorType type,PetscReal *error)
+{
+  PetscInt    j;
+  PetscScalar s;
+  PetscReal   z=0.0,nrm;
+  PetscBool   flg;
+
+  PetscFunctionBegin;
+  switch (type) {
+    case NEP_ERROR_ABSOLUTE:
+      break;
+    case NEP_ERROR_RELATIVE:
+      *error /= PetscAbsScalar(kr)*er;
+      break;
+    case NEP_ERROR_BACKWARD:
+      if (nep->fui!=NEP_USER_INTERFACE_SPLIT) {
+        PetscCall(NEPComputeFunction(nep,kr,nep->function,nep->function));
+        PetscCall(MatHasOperation(nep->function,MATOP_NORM,&flg));
+        PetscCheck(flg,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
+        PetscCall(MatNorm(nep->function,NORM_INFINITY,&nrm));
+        *error /= nrm*er;
+        break;
+      }
+      /* initialization of matrix norms */
+      if (!nep->nrma[0]) {
+        for (j=0;j<nep->nt;j++) {
+          PetscCall(MatHasOperation(nep->A[j],MATOP_NORM,&flg));
+          PetscCheck(flg,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
+          PetscCall(MatNorm(nep->A[j],NORM_INFINITY,&nep->nrma[j]));
+        }
+      }
+      for (j=0;j<nep->nt;j++) {
+        PetscCall(FNEvaluateFunction(nep->f[j],kr,&s));
+        z = z + nep->nrma[j]*PetscAbsScalar(s);
+      }
+      *error /= z*er;
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    NEPComputeError - Computes the error (based on the residual norm) associated
    with the i-th computed eigenpair.
@@ -649,10 +710,9 @@ PetscErrorCode NEPComputeResidualNorm_Private(NEP nep,PetscBool adj,PetscScalar
 PetscErrorCode NEPComputeError(NEP nep,PetscInt i,NEPErrorType type,PetscReal *error)
 {
   Vec            xr,xi=NULL;
-  PetscInt       j,nwork,issplit=0;
-  PetscScalar    kr,ki,s;
-  PetscReal      er,z=0.0,errorl,nrm;
-  PetscBool      flg;
+  PetscInt       nwork,issplit=0;
+  PetscScalar    kr,ki;
+  PetscReal      er,errorl;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
@@ -693,37 +753,80 @@ PetscErrorCode NEPComputeError(NEP nep,PetscInt i,NEPErrorType type,PetscReal *e
   }
 
   /* compute error */
-  switch (type) {
-    case NEP_ERROR_ABSOLUTE:
-      break;
-    case NEP_ERROR_RELATIVE:
-      *error /= PetscAbsScalar(kr)*er;
-      break;
-    case NEP_ERROR_BACKWARD:
-      if (nep->fui!=NEP_USER_INTERFACE_SPLIT) {
-        PetscCall(NEPComputeFunction(nep,kr,nep->function,nep->function));
-        PetscCall(MatHasOperation(nep->function,MATOP_NORM,&flg));
-        PetscCheck(flg,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
-        PetscCall(MatNorm(nep->function,NORM_INFINITY,&nrm));
-        *error /= nrm*er;
-        break;
-      }
-      /* initialization of matrix norms */
-      if (!nep->nrma[0]) {
-        for (j=0;j<nep->nt;j++) {
-          PetscCall(MatHasOperation(nep->A[j],MATOP_NORM,&flg));
-          PetscCheck(flg,PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_WRONG,"The computation of backward errors requires a matrix norm operation");
-          PetscCall(MatNorm(nep->A[j],NORM_INFINITY,&nep->nrma[j]));
-        }
-      }
-      for (j=0;j<nep->nt;j++) {
-        PetscCall(FNEvaluateFunction(nep->f[j],kr,&s));
-        z = z + nep->nrma[j]*PetscAbsScalar(s);
-      }
-      *error /= z*er;
-      break;
-    default:
-      SETERRQ(PetscObjectComm((PetscObject)nep),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+  PetscCall(NEPComputeErrorType_Private(nep,kr,er,type,error));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   NEPComputeErrors_Private - Computes the errors associated with the first n computed
+   eigenpairs, as in NEPComputeError(). In split form, the products A_j*X are computed
+   for all eigenvectors at once and combined with the values f_j(lambda_i), and the norms
+   are obtained with a single reduction.
+*/
+PetscErrorCode NEPComputeErrors_Private(NEP nep,NEPErrorType type,PetscInt n,PetscReal *error)
+{
+  PetscInt    i,j,k,l,m,nv=nep->nconv;
+  PetscScalar s;
+  PetscReal   *nrm;
+  PetscBool   batch;
+  BV          R,Z;
+
+  PetscFunctionBegin;
+  batch = (nep->fui==NEP_USER_INTERFACE_SPLIT && !nep->twosided && n>1)? PETSC_TRUE: PETSC_FALSE;
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<nv && batch;i++) if (nep->eigi[i]!=0.0) batch = PETSC_FALSE;
+#endif
+  if (!batch) {
+    for (i=0;i<n;i++) PetscCall(NEPComputeError(nep,i,type,error+i));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(NEPComputeVectors(nep));
+  PetscCall(BVGetActiveColumns(nep->V,&l,&m));
+  PetscCall(BVSetActiveColumns(nep->V,0,nv));
+  PetscCall(BVDuplicateResize(nep->V,nv,&R));
+  PetscCall(BVDuplicateResize(nep->V,nv,&Z));
+  for (j=0;j<nep->nt;j++) {
+    PetscCall(BVMatMult(nep->V,nep->A[j],j?Z:R));
+    for (k=0;k<nv;k++) {
+      PetscCall(FNEvaluateFunction(nep->f[j],nep->eigr[k],&s));
+      PetscCall(BVScaleColumn(j?Z:R,k,s));
+    }
+    if (j) PetscCall(BVAXPY(R,1.0,Z));
+  }
+  PetscCall(PetscMalloc1(2*nv,&nrm));
+  for (k=0;k<nv;k++) {
+    PetscCall(BVNormColumnBegin(R,k,NORM_2,nrm+k));
+    PetscCall(BVNormColumnBegin(nep->V,k,NORM_2,nrm+nv+k));
+  }
+  for (k=0;k<nv;k++) {
+    PetscCall(BVNormColumnEnd(R,k,NORM_2,nrm+k));
+    PetscCall(BVNormColumnEnd(nep->V,k,NORM_2,nrm+nv+k));
+  }
+  for (i=0;i<n;i++) {
+    k = nep->perm[i];
+    error[i] = nrm[k];
+    PetscCall(NEPComputeErrorType_Private(nep,nep->eigr[k],nrm[nv+k],type,error+i));
+  }
+  PetscCall(PetscFree(nrm));
+  PetscCall(BVDestroy(&R));
+  PetscCall(BVDestroy(&Z));
+  PetscCall(BVSetActiveColumns(nep->V,l,m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Structure flag to combine the split matrices into A, which is SUBSET_NONZERO_PATTERN if A
+   is the matrix T created in NEPSetUp(), or a duplicate of it, and T has the union pattern
+*/
+static PetscErrorCode NEPGetSplitStructure_Private(Mat A,Mat T,PetscBool munion,MatStructure mstr,MatStructure *str)
+{
+  PetscObject obj=NULL;
+
+  PetscFunctionBegin;
+  *str = mstr;
+  if (munion && T) {
+    if (A!=T) PetscCall(PetscObjectQuery((PetscObject)A,"NEPSplitPattern",&obj));
+    if (A==T || obj==(PetscObject)T) *str = SUBSET_NONZERO_PATTERN;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -755,6 +858,7 @@ PetscErrorCode NEPComputeFunction(NEP nep,PetscScalar lambda,Mat A,Mat B)
 {
   PetscInt       i;
   PetscScalar    alpha;
+  MatStructure   str,strp;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
@@ -767,12 +871,15 @@ PetscErrorCode NEPComputeFunction(NEP nep,PetscScalar lambda,Mat A,Mat B)
     PetscCall(PetscLogEventEnd(NEP_FunctionEval,nep,A,B,0));
     break;
   case NEP_USER_INTERFACE_SPLIT:
+    /* the matrices created in NEPSetUp() already contain the union of the patterns */
+    PetscCall(NEPGetSplitStructure_Private(A,nep->function,nep->munion,nep->mstr,&str));
+    PetscCall(NEPGetSplitStructure_Private(B,nep->function_pre,nep->munionp,nep->mstrp,&strp));
     PetscCall(MatZeroEntries(A));
     if (A != B) PetscCall(MatZeroEntries(B));
     for (i=0;i<nep->nt;i++) {
       PetscCall(FNEvaluateFunction(nep->f[i],lambda,&alpha));
-      PetscCall(MatAXPY(A,alpha,nep->A[i],nep->mstr));
-      if (A != B) PetscCall(MatAXPY(B,alpha,nep->P[i],nep->mstrp));
+      PetscCall(MatAXPY(A,alpha,nep->A[i],str));
+      if (A != B) PetscCall(MatAXPY(B,alpha,nep->P[i],strp));
     }
     break;
   }
@@ -804,6 +911,7 @@ PetscErrorCode NEPComputeJacobian(NEP nep,PetscScalar lambda,Mat A)
 {
   PetscInt       i;
   PetscScalar    alpha;
+  MatStructure   str;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(nep,NEP_CLASSID,1);
@@ -816,10 +924,11 @@ PetscErrorCode NEPComputeJacobian(NEP nep,PetscScalar lambda,Mat A)
     PetscCall(PetscLogEventEnd(NEP_JacobianEval,nep,A,0,0));
     break;
   case NEP_USER_INTERFACE_SPLIT:
+    PetscCall(NEPGetSplitStructure_Private(A,nep->jacobian,nep->munion,nep->mstr,&str));
     PetscCall(MatZeroEntries(A));
     for (i=0;i<nep->nt;i++) {
       PetscCall(FNEvaluateDerivative(nep->f[i],lambda,&alpha));
-      PetscCall(MatAXPY(A,alpha,nep->A[i],nep->mstr));
+      PetscCall(MatAXPY(A,alpha,nep->A[i],str));
     }
     break;
   }
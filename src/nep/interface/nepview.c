@@ -277,7 +277,7 @@ PetscErrorCode NEPConvergedReasonViewFromOptions(NEP nep)
 
 static PetscErrorCode NEPErrorView_ASCII(NEP nep,NEPErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error;
+  PetscReal      *errors;
   PetscInt       i,j,k,nvals;
 
   PetscFunctionBegin;
@@ -290,13 +290,16 @@ static PetscErrorCode NEPErrorView_ASCII(NEP nep,NEPErrorType etype,PetscViewer
     PetscCall(PetscViewerASCIIPrintf(viewer," No eigenvalues have been found\n\n"));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+  PetscCall(PetscMalloc1(nvals,&errors));
+  PetscCall(NEPComputeErrors_Private(nep,etype,nvals,errors));
   for (i=0;i<nvals;i++) {
-    PetscCall(NEPComputeError(nep,i,etype,&error));
-    if (error>=5.0*nep->tol) {
+    if (errors[i]>=5.0*nep->tol) {
+      PetscCall(PetscFree(errors));
       PetscCall(PetscViewerASCIIPrintf(viewer," Problem: some of the first %" PetscInt_FMT " relative errors are higher than the tolerance\n\n",nvals));
       PetscFunctionReturn(PETSC_SUCCESS);
     }
   }
+  PetscCall(PetscFree(errors));
   if (nep->which==NEP_ALL) PetscCall(PetscViewerASCIIPrintf(viewer," Found %" PetscInt_FMT " eigenvalues, all of them computed up to the required tolerance:",nvals));
   else PetscCall(PetscViewerASCIIPrintf(viewer," All requested eigenvalues computed up to the required tolerance:"));
   for (i=0;i<=(nvals-1)/8;i++) {
@@ -313,7 +316,7 @@ static PetscErrorCode NEPErrorView_ASCII(NEP nep,NEPErrorType etype,PetscViewer
 
 static PetscErrorCode NEPErrorView_DETAIL(NEP nep,NEPErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error,re,im;
+  PetscReal      *errors,re,im;
   PetscScalar    kr,ki;
   PetscInt       i;
   char           ex[30],sep[]=" ---------------------- --------------------\n";
@@ -332,9 +335,10 @@ static PetscErrorCode NEPErrorView_DETAIL(NEP nep,NEPErrorType etype,PetscViewer
       break;
   }
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s            k             %s\n%s",sep,ex,sep));
+  PetscCall(PetscMalloc1(nep->nconv,&errors));
+  PetscCall(NEPComputeErrors_Private(nep,etype,nep->nconv,errors));
   for (i=0;i<nep->nconv;i++) {
     PetscCall(NEPGetEigenpair(nep,i,&kr,&ki,NULL,NULL));
-    PetscCall(NEPComputeError(nep,i,etype,&error));
 #if defined(PETSC_USE_COMPLEX)
     re = PetscRealPart(kr);
     im = PetscImaginaryPart(kr);
@@ -342,26 +346,27 @@ static PetscErrorCode NEPErrorView_DETAIL(NEP nep,NEPErrorType etype,PetscViewer
     re = kr;
     im = ki;
 #endif
-    if (im!=0.0) PetscCall(PetscViewerASCIIPrintf(viewer,"  % 9f%+9fi      %12g\n",(double)re,(double)im,(double)error));
-    else PetscCall(PetscViewerASCIIPrintf(viewer,"    % 12f           %12g\n",(double)re,(double)error));
+    if (im!=0.0) PetscCall(PetscViewerASCIIPrintf(viewer,"  % 9f%+9fi      %12g\n",(double)re,(double)im,(double)errors[i]));
+    else PetscCall(PetscViewerASCIIPrintf(viewer,"    % 12f           %12g\n",(double)re,(double)errors[i]));
   }
+  PetscCall(PetscFree(errors));
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s",sep));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode NEPErrorView_MATLAB(NEP nep,NEPErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error;
+  PetscReal      *errors;
   PetscInt       i;
   const char     *name;
 
   PetscFunctionBegin;
   PetscCall(PetscObjectGetName((PetscObject)nep,&name));
   PetscCall(PetscViewerASCIIPrintf(viewer,"Error_%s = [\n",name));
-  for (i=0;i<nep->nconv;i++) {
-    PetscCall(NEPComputeError(nep,i,etype,&error));
-    PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)error));
-  }
+  PetscCall(PetscMalloc1(nep->nconv,&errors));
+  PetscCall(NEPComputeErrors_Private(nep,etype,nep->nconv,errors));
+  for (i=0;i<nep->nconv;i++) PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)errors[i]));
+  PetscCall(PetscFree(errors));
   PetscCall(PetscViewerASCIIPrintf(viewer,"];\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -273,6 +273,12 @@ int main(int argc,char **argv)
       test:
          suffix: 1_slp
          args: -nep_type slp -nep_slp_st_pc_type redundant -split {{0 1}}
+      test:
+         suffix: 1_slp_lag
+         args: -nep_type slp -nep_slp_st_pc_type redundant -nep_slp_lag_preconditioner 3 -split 1
+      test:
+         suffix: 1_rii_lag
+         args: -nep_type rii -nep_target 0.55 -nep_rii_lag_preconditioner 2 -nep_rii_lag_adaptive -split {{0 1}}
       test:
          suffix: 1_interpol
          args: -nep_type interpol -rg_type interval -rg_interval_endpoints .5,1,-.1,.1 -nep_target .7 -nep_interpol_st_pc_type redundant
@@ -12,7 +12,8 @@ static char help[] = "Test the NEPProjectOperator() function.\n\n"
   "This is based on ex22.\n"
   "The command line options are:\n"
   "  -n <n>, where <n> = number of grid subdivisions.\n"
-  "  -tau <tau>, where <tau> is the delay parameter.\n";
+  "  -tau <tau>, where <tau> is the delay parameter.\n"
+  "  -borders, to project the operator one column at a time.\n";
 
 /*
    Solve parabolic partial differential equation with time delay tau
@@ -44,11 +45,13 @@ int main(int argc,char **argv)
   PetscScalar    coeffs[2],b,*M;
   PetscInt       n=32,Istart,Iend,i,j,k,nc;
   PetscReal      tau=0.001,h,a=20,xi;
+  PetscBool      borders=PETSC_FALSE;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
   PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
   PetscCall(PetscOptionsGetReal(NULL,NULL,"-tau",&tau,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-borders",&borders,NULL));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n1-D Delay Eigenproblem, n=%" PetscInt_FMT ", tau=%g\n",n,(double)tau));
   h = PETSC_PI/(PetscReal)(n+1);
 
@@ -132,7 +135,9 @@ int main(int argc,char **argv)
   PetscCall(DSNEPSetFN(ds,3,funs));
   PetscCall(DSAllocate(ds,nc));
   PetscCall(DSSetDimensions(ds,nc,0,0));
-  PetscCall(NEPProjectOperator(nep,0,nc));
+  if (borders) {
+    for (i=0;i<nc;i++) PetscCall(NEPProjectOperator(nep,i,i+1));
+  } else PetscCall(NEPProjectOperator(nep,0,nc));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
                 Display projected matrices and clean up
@@ -163,6 +168,7 @@ int main(int argc,char **argv)
 
    test:
       suffix: 1
-      args: -nep_ncv 5
+      args: -nep_ncv 5 -borders {{0 1}}
+      output_file: output/test13_1.out
 
 TEST*/
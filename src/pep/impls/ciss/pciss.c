@@ -53,6 +53,7 @@ typedef struct {
   BV                S;
   BV                Y;
   PetscBool         useconj;
+  PetscBool         useherm;       /* conjugate points share the linear solver (Hermitian case) */
   Mat               J,*Psplit;     /* auxiliary matrices */
   BV                pV;
   PetscObjectId     rgid;
@@ -89,6 +90,37 @@ static PetscErrorCode PEPComputeFunction(PEP pep,PetscScalar lambda,Mat T,Mat P,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Reorder the integration points so that point N/2+j is the conjugate of point j
+*/
+static PetscErrorCode PEPCISSPairConjugates(PEP pep)
+{
+  PEP_CISS    *ctx = (PEP_CISS*)pep->data;
+  PetscInt    j,n=ctx->N/2;
+  PetscScalar *w,*z,*zn;
+  PetscReal   tol=10*ctx->N*PETSC_MACHINE_EPSILON;
+
+  PetscFunctionBegin;
+  for (j=0;j<n && ctx->useherm;j++) {
+    if (PetscAbsScalar(ctx->omega[ctx->N-1-j]-PetscConj(ctx->omega[j]))>tol*PetscMax(1.0,PetscAbsScalar(ctx->omega[j]))) ctx->useherm = PETSC_FALSE;
+  }
+  if (!ctx->useherm) {
+    PetscCall(PetscInfo(pep,"The quadrature points are not conjugate pairs, each point has its own linear solver\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc3(n,&w,n,&z,n,&zn));
+  for (j=0;j<n;j++) {
+    w[j]  = ctx->weight[ctx->N-1-j];
+    z[j]  = ctx->omega[ctx->N-1-j];
+    zn[j] = ctx->pp[ctx->N-1-j];
+  }
+  PetscCall(PetscArraycpy(ctx->weight+n,w,n));
+  PetscCall(PetscArraycpy(ctx->omega+n,z,n));
+  PetscCall(PetscArraycpy(ctx->pp+n,zn,n));
+  PetscCall(PetscFree3(w,z,zn));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
   Set up KSP solvers for every integration point
 */
@@ -103,7 +135,7 @@ static PetscErrorCode PEPCISSSetUp(PEP pep,Mat T,Mat P)
   if (!ctx->contour || !ctx->contour->ksp) PetscCall(PEPCISSGetKSPs(pep,NULL,NULL));
   contour = ctx->contour;
   PetscAssert(ctx->contour && ctx->contour->ksp,PetscObjectComm((PetscObject)pep),PETSC_ERR_PLIB,"Something went wrong with PEPCISSGetKSPs()");
-  for (i=0;i<contour->npoints;i++) {
+  for (i=0;i<(ctx->useherm?contour->npoints/2:contour->npoints);i++) {
     p_id = i*contour->subcomm->n + contour->subcomm->color;
     PetscCall(MatDuplicate(T,MAT_DO_NOT_COPY_VALUES,&Amat));
     if (T != P) PetscCall(MatDuplicate(P,MAT_DO_NOT_COPY_VALUES,&Pmat)); else Pmat = Amat;
@@ -117,16 +149,20 @@ static PetscErrorCode PEPCISSSetUp(PEP pep,Mat T,Mat P)
 
 /*
   Y_i = F(z_i)^{-1}Fp(z_i)V for every integration point, Y=[Y_i] is in the context
+
+  In the Hermitian case, point i+nsolve is the conjugate of point i, and since
+  F(conj(z))=F(z)^H its solution is obtained with the transpose of the solver of point i
 */
 static PetscErrorCode PEPCISSSolve(PEP pep,Mat dT,BV V,PetscInt L_start,PetscInt L_end)
 {
   PEP_CISS         *ctx = (PEP_CISS*)pep->data;
   SlepcContourData contour;
-  PetscInt         i,p_id;
-  Mat              MV,BMV=NULL,MC;
+  PetscInt         i,p_id,nsolve;
+  Mat              MV,BMV=NULL,MC,CMV=NULL;
 
   PetscFunctionBegin;
   contour = ctx->contour;
+  nsolve = ctx->useherm? contour->npoints/2: contour->npoints;
   PetscCall(BVSetActiveColumns(V,L_start,L_end));
   PetscCall(BVGetMat(V,&MV));
   for (i=0;i<contour->npoints;i++) {
@@ -141,9 +177,17 @@ static PetscErrorCode PEPCISSSolve(PEP pep,Mat dT,BV V,PetscInt L_start,PetscInt
       PetscCall(MatProductSymbolic(BMV));
     }
     PetscCall(MatProductNumeric(BMV));
-    PetscCall(KSPMatSolve(contour->ksp[i],BMV,MC));
+    if (i<nsolve) PetscCall(KSPMatSolve(contour->ksp[i],BMV,MC));
+    else {  /* Y_i = conj(F(z_{i-nsolve})^{-T} conj(Fp(z_i)V)) */
+      if (!CMV) PetscCall(MatDuplicate(BMV,MAT_COPY_VALUES,&CMV));
+      else PetscCall(MatCopy(BMV,CMV,SAME_NONZERO_PATTERN));
+      PetscCall(MatConjugate(CMV));
+      PetscCall(KSPMatSolveTranspose(contour->ksp[i-nsolve],CMV,MC));
+      PetscCall(MatConjugate(MC));
+    }
     PetscCall(BVRestoreMat(ctx->Y,&MC));
   }
+  PetscCall(MatDestroy(&CMV));
   PetscCall(MatDestroy(&BMV));
   PetscCall(BVRestoreMat(V,&MV));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -199,6 +243,12 @@ static PetscErrorCode PEPSetUp_CISS(PEP pep)
     PetscCall(SlepcContourDataCreate(ctx->useconj?ctx->N/2:ctx->N,ctx->npart,(PetscObject)pep,&ctx->contour));
   }
 
+  /* in the Hermitian case, the solvers of conjugate points can be shared */
+  ctx->useherm = PETSC_FALSE;
+#if defined(PETSC_USE_COMPLEX)
+  if ((pep->problem_type==PEP_HERMITIAN || pep->problem_type==PEP_HYPERBOLIC) && !ctx->useconj && !(ctx->N%(2*ctx->npart))) PetscCall(RGCanUseConjugates(pep->rg,PETSC_TRUE,&ctx->useherm));
+#endif
+
   PetscCall(PEPAllocateSolution(pep,0));
   if (ctx->weight) PetscCall(PetscFree4(ctx->weight,ctx->omega,ctx->pp,ctx->sigma));
   PetscCall(PetscMalloc4(ctx->N,&ctx->weight,ctx->N,&ctx->omega,ctx->N,&ctx->pp,ctx->L_max*ctx->M,&ctx->sigma));
@@ -270,6 +320,7 @@ static PetscErrorCode PEPSolve_CISS(PEP pep)
   sc->mapobj        = NULL;
   PetscCall(DSGetLeadingDimension(pep->ds,&ld));
   PetscCall(RGComputeQuadrature(pep->rg,RG_QUADRULE_TRAPEZOIDAL,ctx->N,ctx->omega,ctx->pp,ctx->weight));
+  if (ctx->useherm) PetscCall(PEPCISSPairConjugates(pep));
   PetscCall(STGetSplitPreconditionerInfo(pep->st,&nsplit,NULL));
   if (contour->pA) {
     T = contour->pA[0];
@@ -540,6 +591,7 @@ static PetscErrorCode PEPCISSSetSizes_CISS(PEP pep,PetscInt ip,PetscInt bs,Petsc
 .  -pep_ciss_blocksize - Sets the block size
 .  -pep_ciss_moments - Sets the moment size
 .  -pep_ciss_partitions - Sets the number of partitions
+.  -pep_ciss_partitions_node_aware - Aligns the partitions with the shared-memory nodes
 .  -pep_ciss_maxblocksize - Sets the maximum block size
 -  -pep_ciss_realmats - all coefficient matrices of P(.) are real
 
@@ -550,6 +602,9 @@ static PetscErrorCode PEPCISSSetSizes_CISS(PEP pep,PetscInt ip,PetscInt bs,Petsc
    The default number of partitions is 1. This means the internal KSP object is shared
    among all processes of the PEP communicator. Otherwise, the communicator is split
    into npart communicators, so that npart KSP solves proceed simultaneously.
+   The partitions are interlaced by default; with -pep_ciss_partitions_node_aware the
+   processes of each partition are taken from the same shared-memory node as much as
+   possible, so that the communication within the partitions stays inside the nodes.
 
    Level: advanced
 
@@ -924,6 +979,12 @@ static PetscErrorCode PEPCISSGetKSPs_CISS(PEP pep,PetscInt *nsolve,KSP **ksp)
    the number of partitions. This value is halved in the case of real matrices with
    a region centered at the real axis.
 
+   In complex scalars, if the problem is Hermitian (see PEPSetProblemType()) and the
+   region is symmetric with respect to the real axis, the solutions at a pair of
+   conjugate points are computed with the same linear solver, one of them with a
+   transposed solve that reuses the factorization. In that case only the first half
+   of the KSP objects are used.
+
    Level: advanced
 
 .seealso: PEPCISSSetSizes()
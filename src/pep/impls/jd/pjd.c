@@ -68,6 +68,7 @@ typedef struct {
   PetscInt    midx;          /* minimality index */
   PetscInt    mmidx;         /* maximum allowed minimality index */
   PEPJDProjection proj;      /* projection type (orthogonal, harmonic) */
+  PetscInt    bs;            /* block size, number of corrections added per iteration */
 } PEP_JD;
 
 typedef struct {
@@ -934,7 +935,7 @@ static PetscErrorCode PEPJDMatSetUp(PEP pep,PetscInt sz,PetscScalar *theta)
   if (sz==2 && theta[1]==0.0) sz = 1;
   PetscCall(MatShellGetContext(pjd->Pshell,&matctx));
   PetscCall(PCShellGetContext(pjd->pcshell,&pcctx));
-  if (matctx->Pr && matctx->theta[0]==theta[0] && ((!matctx->Pi && sz==1) || (sz==2 && matctx->theta[1]==theta[1]))) {
+  if (matctx->Pr && matctx->theta[0]==theta[0] && matctx->theta[1]==((sz==2)?theta[1]:0.0)) {
     if (pcctx->n == pjd->nlock) PetscFunctionReturn(PETSC_SUCCESS);
     skipmat = PETSC_TRUE;
   }
@@ -952,6 +953,7 @@ static PetscErrorCode PEPJDMatSetUp(PEP pep,PetscInt sz,PetscScalar *theta)
       } else Pr = matctx->Pr;
     }
     matctx->theta[0] = theta[0];
+    matctx->theta[1] = 0.0;
 #if !defined(PETSC_USE_COMPLEX)
     if (sz==2) {
       if (!matctx->Pi) PetscCall(MatDuplicate(pep->A[0],MAT_COPY_VALUES,&matctx->Pi));
@@ -1196,16 +1198,100 @@ static PetscErrorCode PEPJDSystemSetUp(PEP pep,PetscInt sz,PetscScalar *theta,Ve
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Solves the correction equation for the Ritz pair (theta,u) with residual r and
+   appends the solution to the search space, increasing nv accordingly. When block
+   is set, a linearly dependent correction is discarded instead of raising an error
+*/
+static PetscErrorCode PEPJDExpandBasis(PEP pep,PetscInt sz,PetscScalar *theta,Vec *u,Vec *r,Vec *p,Vec *ww,PetscBool block,PetscInt *nv)
+{
+  PEP_JD         *pjd = (PEP_JD*)pep->data;
+  PetscInt       off,nloc,kspsf=1;
+  PetscMPIInt    np,count;
+  PetscScalar    *array;
+  PetscReal      norm;
+  PetscBool      lindep;
+  Vec            tc,rc,t[2],rr[2];
+  KSP            ksp;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)pep),&np));
+  PetscCall(BVGetSizes(pep->V,&nloc,NULL,NULL));
+  PetscCall(STGetKSP(pep->st,&ksp));
+#if !defined (PETSC_USE_COMPLEX)
+  kspsf = 2;
+#endif
+  /* Update system mat */
+  PetscCall(PEPJDSystemSetUp(pep,sz,theta,u,p,ww));
+  /* Solve correction equation to expand basis */
+  PetscCall(BVGetColumn(pjd->V,*nv,&t[0]));
+  rr[0] = r[0];
+  if (sz==2) {
+    PetscCall(BVGetColumn(pjd->V,*nv+1,&t[1]));
+    rr[1] = r[1];
+  } else {
+    t[1] = NULL;
+    rr[1] = NULL;
+  }
+  PetscCall(VecCreateCompWithVecs(t,kspsf,pjd->vtempl,&tc));
+  PetscCall(VecCreateCompWithVecs(rr,kspsf,pjd->vtempl,&rc));
+  PetscCall(VecCompSetSubVecs(pjd->vtempl,sz,NULL));
+  PetscCall(KSPSolve(ksp,rc,tc));
+  PetscCall(VecDestroy(&tc));
+  PetscCall(VecDestroy(&rc));
+  PetscCall(VecGetArray(t[0],&array));
+  PetscCall(PetscMPIIntCast(pep->nconv,&count));
+  PetscCallMPI(MPI_Bcast(array+nloc,count,MPIU_SCALAR,np-1,PetscObjectComm((PetscObject)pep)));
+  PetscCall(VecRestoreArray(t[0],&array));
+  PetscCall(BVRestoreColumn(pjd->V,*nv,&t[0]));
+  PetscCall(BVOrthogonalizeColumn(pjd->V,*nv,NULL,&norm,&lindep));
+  if (lindep || norm==0.0) {
+    PetscCheck(sz!=1 || block,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
+    off = 1;
+  } else {
+    off = 0;
+    PetscCall(BVScaleColumn(pjd->V,*nv,1.0/norm));
+  }
+#if !defined(PETSC_USE_COMPLEX)
+  if (sz==2) {
+    PetscCall(VecGetArray(t[1],&array));
+    PetscCallMPI(MPI_Bcast(array+nloc,count,MPIU_SCALAR,np-1,PetscObjectComm((PetscObject)pep)));
+    PetscCall(VecRestoreArray(t[1],&array));
+    PetscCall(BVRestoreColumn(pjd->V,*nv+1,&t[1]));
+    if (off) PetscCall(BVCopyColumn(pjd->V,*nv+1,*nv));
+    PetscCall(BVOrthogonalizeColumn(pjd->V,*nv+1-off,NULL,&norm,&lindep));
+    if (lindep || norm==0.0) {
+      PetscCheck(off==0 || block,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
+      off++;
+    } else PetscCall(BVScaleColumn(pjd->V,*nv+1-off,1.0/norm));
+  }
+#endif
+  if (pjd->proj==PEP_JD_PROJECTION_HARMONIC && off<sz) {
+    PetscCall(BVInsertVec(pjd->W,*nv,r[0]));
+    if (sz==2 && !off) PetscCall(BVInsertVec(pjd->W,*nv+1,r[1]));
+    PetscCall(BVOrthogonalizeColumn(pjd->W,*nv,NULL,&norm,&lindep));
+    PetscCheck(!lindep && norm>0.0,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
+    PetscCall(BVScaleColumn(pjd->W,*nv,1.0/norm));
+    if (sz==2 && !off) {
+      PetscCall(BVOrthogonalizeColumn(pjd->W,*nv+1,NULL,&norm,&lindep));
+      PetscCheck(!lindep && norm>0.0,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
+      PetscCall(BVScaleColumn(pjd->W,*nv+1,1.0/norm));
+    }
+  }
+  *nv += sz-off;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PEPSolve_JD(PEP pep)
 {
   PEP_JD          *pjd = (PEP_JD*)pep->data;
-  PetscInt        k,nv,nvc,ld,minv,dim,bupdated=0,sz=1,kspsf=1,idx,off,maxits,nloc;
-  PetscMPIInt     np,count;
-  PetscScalar     theta[2]={0.0,0.0},ritz[2]={0.0,0.0},*pX,*eig,*eigi,*array;
+  PetscInt        k,j,nv,nvc,ld,minv,dim,bupdated=0,sz=1,kspsf=1,idx,maxits,nb,*szb=NULL;
+  PetscMPIInt     np;
+  PetscScalar     theta[2]={0.0,0.0},ritz[2]={0.0,0.0},rb_ritz[2]={0.0,0.0},*pX,*eig,*eigi;
   PetscReal       norm,*res,tol=0.0,rtol,abstol, dtol;
-  PetscBool       lindep,ini=PETSC_TRUE;
-  Vec             tc,t[2]={NULL,NULL},u[2]={NULL,NULL},p[2]={NULL,NULL};
-  Vec             rc,rr[2],r[2]={NULL,NULL},*ww=pep->work,v[2];
+  PetscBool       ini=PETSC_TRUE;
+  Vec             u[2]={NULL,NULL},p[2]={NULL,NULL},*ub=NULL,*rb=NULL;
+  Vec             r[2]={NULL,NULL},*ww=pep->work,v[2];
   Mat             G,X,Y;
   KSP             ksp;
   PEP_JD_PCSHELL  *pcctx;
@@ -1217,7 +1303,6 @@ static PetscErrorCode PEPSolve_JD(PEP pep)
   PetscFunctionBegin;
   PetscCall(PetscCitationsRegister(citation,&cited));
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)pep),&np));
-  PetscCall(BVGetSizes(pep->V,&nloc,NULL,NULL));
   PetscCall(DSGetLeadingDimension(pep->ds,&ld));
   PetscCall(PetscCalloc3(pep->ncv+pep->nev,&eig,pep->ncv+pep->nev,&eigi,pep->ncv+pep->nev,&res));
   pjd->nlock = 0;
@@ -1242,6 +1327,11 @@ static PetscErrorCode PEPSolve_JD(PEP pep)
   PetscCall(VecDuplicate(u[0],&p[1]));
   PetscCall(VecDuplicate(u[0],&r[1]));
 #endif
+  if (pjd->bs>1) {
+    PetscCall(PetscMalloc1(pjd->bs-1,&szb));
+    PetscCall(VecDuplicateVecs(u[0],kspsf*(pjd->bs-1),&ub));
+    PetscCall(VecDuplicateVecs(u[0],kspsf*(pjd->bs-1),&rb));
+  }
 
   /* Restart loop */
   while (pep->reason == PEP_CONVERGED_ITERATING) {
@@ -1360,67 +1450,37 @@ static PetscErrorCode PEPSolve_JD(PEP pep)
       } else {
         if (!idx && pep->errest[pep->nconv]<pjd->fix) {theta[0] = ritz[0]; theta[1] = ritz[1];}
         else {theta[0] = pep->target; theta[1] = 0.0;}
-        /* Update system mat */
-        PetscCall(PEPJDSystemSetUp(pep,sz,theta,u,p,ww));
-        /* Solve correction equation to expand basis */
-        PetscCall(BVGetColumn(pjd->V,nv,&t[0]));
-        rr[0] = r[0];
-        if (sz==2) {
-          PetscCall(BVGetColumn(pjd->V,nv+1,&t[1]));
-          rr[1] = r[1];
-        } else {
-          t[1] = NULL;
-          rr[1] = NULL;
-        }
-        PetscCall(VecCreateCompWithVecs(t,kspsf,pjd->vtempl,&tc));
-        PetscCall(VecCreateCompWithVecs(rr,kspsf,pjd->vtempl,&rc));
-        PetscCall(VecCompSetSubVecs(pjd->vtempl,sz,NULL));
-        tol  = PetscMax(rtol,tol/2);
-        PetscCall(KSPSetTolerances(ksp,tol,abstol,dtol,maxits));
-        PetscCall(KSPSolve(ksp,rc,tc));
-        PetscCall(VecDestroy(&tc));
-        PetscCall(VecDestroy(&rc));
-        PetscCall(VecGetArray(t[0],&array));
-        PetscCall(PetscMPIIntCast(pep->nconv,&count));
-        PetscCallMPI(MPI_Bcast(array+nloc,count,MPIU_SCALAR,np-1,PetscObjectComm((PetscObject)pep)));
-        PetscCall(VecRestoreArray(t[0],&array));
-        PetscCall(BVRestoreColumn(pjd->V,nv,&t[0]));
-        PetscCall(BVOrthogonalizeColumn(pjd->V,nv,NULL,&norm,&lindep));
-        if (lindep || norm==0.0) {
-          PetscCheck(sz!=1,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
-          off = 1;
-        } else {
-          off = 0;
-          PetscCall(BVScaleColumn(pjd->V,nv,1.0/norm));
-        }
+        nb = 0;
+        if (pjd->bs>1 && !idx && theta[1]==0.0) {
+          /* Ritz vectors and residuals of the next bs-1 Ritz pairs, the basis is still unchanged */
+          PetscCall(DSGetArray(pep->ds,DS_MAT_X,&pX));
+          PetscCall(BVSetActiveColumns(pjd->V,0,nv));
+          for (j=sz;nb<pjd->bs-1 && j<nv;j+=szb[nb++]) {
+            rb_ritz[0] = pep->eigr[j];
+            szb[nb] = 1;
 #if !defined(PETSC_USE_COMPLEX)
-        if (sz==2) {
-          PetscCall(VecGetArray(t[1],&array));
-          PetscCallMPI(MPI_Bcast(array+nloc,count,MPIU_SCALAR,np-1,PetscObjectComm((PetscObject)pep)));
-          PetscCall(VecRestoreArray(t[1],&array));
-          PetscCall(BVRestoreColumn(pjd->V,nv+1,&t[1]));
-          if (off) PetscCall(BVCopyColumn(pjd->V,nv+1,nv));
-          PetscCall(BVOrthogonalizeColumn(pjd->V,nv+1-off,NULL,&norm,&lindep));
-          if (lindep || norm==0.0) {
-            PetscCheck(off==0,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
-            off = 1;
-          } else PetscCall(BVScaleColumn(pjd->V,nv+1-off,1.0/norm));
-        }
+            rb_ritz[1] = pep->eigi[j];
+            if (rb_ritz[1]!=0.0) szb[nb] = 2;
+            if (j+szb[nb]>nv) break;
 #endif
-        if (pjd->proj==PEP_JD_PROJECTION_HARMONIC) {
-          PetscCall(BVInsertVec(pjd->W,nv,r[0]));
-          if (sz==2 && !off) PetscCall(BVInsertVec(pjd->W,nv+1,r[1]));
-          PetscCall(BVOrthogonalizeColumn(pjd->W,nv,NULL,&norm,&lindep));
-          PetscCheck(!lindep && norm>0.0,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
-          PetscCall(BVScaleColumn(pjd->W,nv,1.0/norm));
-          if (sz==2 && !off) {
-            PetscCall(BVOrthogonalizeColumn(pjd->W,nv+1,NULL,&norm,&lindep));
-            PetscCheck(!lindep && norm>0.0,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Linearly dependent continuation vector");
-            PetscCall(BVScaleColumn(pjd->W,nv+1,1.0/norm));
+            PetscCall(BVMultVec(pjd->V,1.0,0.0,ub[kspsf*nb],pX+j*ld));
+#if !defined(PETSC_USE_COMPLEX)
+            if (szb[nb]==2) PetscCall(BVMultVec(pjd->V,1.0,0.0,ub[kspsf*nb+1],pX+(j+1)*ld));
+#endif
+            PetscCall(PEPJDComputeResidual(pep,PETSC_FALSE,szb[nb],ub+kspsf*nb,rb_ritz,rb+kspsf*nb,ww));
           }
+          PetscCall(DSRestoreArray(pep->ds,DS_MAT_X,&pX));
         }
         bupdated = idx?0:nv;
-        nv += sz-off;
+        tol = PetscMax(rtol,tol/2);
+        PetscCall(KSPSetTolerances(ksp,tol,abstol,dtol,maxits));
+        PetscCall(PEPJDExpandBasis(pep,sz,theta,u,r,p,ww,PETSC_FALSE,&nv));
+        /* Block variant: expand also with the corrections of the next Ritz pairs, with the same
+           theta so that the preconditioner and the extended factor are shared by all of them */
+        for (j=0;j<nb;j++) {
+          if (nv+szb[j]>=pep->ncv-1) break;
+          PetscCall(PEPJDExpandBasis(pep,szb[j],theta,ub+kspsf*j,rb+kspsf*j,p,ww,PETSC_TRUE,&nv));
+        }
       }
       for (k=0;k<nvc;k++) {
         eig[pep->nconv-idx+k] = pep->eigr[k];
@@ -1447,6 +1507,11 @@ static PetscErrorCode PEPSolve_JD(PEP pep)
   PetscCall(VecDestroy(&r[1]));
   PetscCall(VecDestroy(&p[1]));
 #endif
+  if (pjd->bs>1) {
+    PetscCall(PetscFree(szb));
+    PetscCall(VecDestroyVecs(kspsf*(pjd->bs-1),&ub));
+    PetscCall(VecDestroyVecs(kspsf*(pjd->bs-1),&rb));
+  }
   PetscCall(KSPSetTolerances(ksp,rtol,abstol,dtol,maxits));
   PetscCall(KSPSetPC(ksp,pcctx->pc));
   PetscCall(VecDestroy(&pcctx->Bp[0]));
@@ -1853,6 +1918,89 @@ PetscErrorCode PEPJDGetProjection(PEP pep,PEPJDProjection *proj)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PEPJDSetBlockSize_JD(PEP pep,PetscInt bs)
+{
+  PEP_JD *pjd = (PEP_JD*)pep->data;
+
+  PetscFunctionBegin;
+  if (bs == PETSC_DEFAULT || bs == PETSC_DECIDE) bs = 1;
+  PetscCheck(bs>0,PetscObjectComm((PetscObject)pep),PETSC_ERR_ARG_OUTOFRANGE,"Invalid block size, should be >0");
+  if (pjd->bs != bs) pep->state = PEP_STATE_INITIAL;
+  pjd->bs = bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PEPJDSetBlockSize - Sets the number of correction vectors to be added to the
+   search space in every iteration.
+
+   Logically Collective
+
+   Input Parameters:
++  pep - the eigenproblem solver context
+-  bs  - block size
+
+   Options Database Key:
+.  -pep_jd_blocksize - number of vectors added to the search space every iteration
+
+   Notes:
+   With bs>1, the search space is expanded with the solutions of the correction
+   equations of the bs Ritz pairs closest to the target. All of them use the same
+   shift, so the polynomial matrix, its preconditioner and the factorization of the
+   small dense block associated with the locked eigenpairs are computed once per
+   iteration and shared by the block. This can improve the throughput when many
+   interior eigenvalues are wanted.
+
+   The additional corrections are computed only in iterations that do not lock any
+   eigenpair, and they are skipped when the basis is full.
+
+   Level: advanced
+
+.seealso: PEPJDGetBlockSize()
+@*/
+PetscErrorCode PEPJDSetBlockSize(PEP pep,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pep,PEP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pep,bs,2);
+  PetscTryMethod(pep,"PEPJDSetBlockSize_C",(PEP,PetscInt),(pep,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PEPJDGetBlockSize_JD(PEP pep,PetscInt *bs)
+{
+  PEP_JD *pjd = (PEP_JD*)pep->data;
+
+  PetscFunctionBegin;
+  *bs = pjd->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PEPJDGetBlockSize - Returns the number of correction vectors added to the
+   search space in every iteration.
+
+   Not Collective
+
+   Input Parameter:
+.  pep - the eigenproblem solver context
+
+   Output Parameter:
+.  bs - block size
+
+   Level: advanced
+
+.seealso: PEPJDSetBlockSize()
+@*/
+PetscErrorCode PEPJDGetBlockSize(PEP pep,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pep,PEP_CLASSID,1);
+  PetscAssertPointer(bs,2);
+  PetscUseMethod(pep,"PEPJDGetBlockSize_C",(PEP,PetscInt*),(pep,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PEPSetFromOptions_JD(PEP pep,PetscOptionItems *PetscOptionsObject)
 {
   PetscBool       flg,b1;
@@ -1878,6 +2026,9 @@ static PetscErrorCode PEPSetFromOptions_JD(PEP pep,PetscOptionItems *PetscOption
     PetscCall(PetscOptionsEnum("-pep_jd_projection","Type of projection","PEPJDSetProjection",PEPJDProjectionTypes,(PetscEnum)PEP_JD_PROJECTION_HARMONIC,(PetscEnum*)&proj,&flg));
     if (flg) PetscCall(PEPJDSetProjection(pep,proj));
 
+    PetscCall(PetscOptionsInt("-pep_jd_blocksize","Number of vectors to add to the search space","PEPJDSetBlockSize",1,&i1,&flg));
+    if (flg) PetscCall(PEPJDSetBlockSize(pep,i1));
+
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1895,6 +2046,7 @@ static PetscErrorCode PEPView_JD(PEP pep,PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer,"  projection type: %s\n",PEPJDProjectionTypes[pjd->proj]));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  maximum allowed minimality index: %" PetscInt_FMT "\n",pjd->mmidx));
     if (pjd->reusepc) PetscCall(PetscViewerASCIIPrintf(viewer,"  reusing the preconditioner\n"));
+    if (pjd->bs>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  block size: %" PetscInt_FMT "\n",pjd->bs));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1950,6 +2102,8 @@ static PetscErrorCode PEPDestroy_JD(PEP pep)
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetMinimalityIndex_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDSetProjection_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetProjection_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDSetBlockSize_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetBlockSize_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1964,6 +2118,7 @@ SLEPC_EXTERN PetscErrorCode PEPCreate_JD(PEP pep)
   pep->lineariz = PETSC_FALSE;
   pjd->fix      = 0.01;
   pjd->mmidx    = 0;
+  pjd->bs       = 1;
 
   pep->ops->solve          = PEPSolve_JD;
   pep->ops->setup          = PEPSetUp_JD;
@@ -1983,5 +2138,7 @@ SLEPC_EXTERN PetscErrorCode PEPCreate_JD(PEP pep)
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetMinimalityIndex_C",PEPJDGetMinimalityIndex_JD));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDSetProjection_C",PEPJDSetProjection_JD));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetProjection_C",PEPJDGetProjection_JD));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDSetBlockSize_C",PEPJDSetBlockSize_JD));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPJDGetBlockSize_C",PEPJDGetBlockSize_JD));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
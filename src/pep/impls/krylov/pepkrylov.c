@@ -45,7 +45,7 @@ PetscErrorCode PEPExtractVectors_TOAR(PEP pep)
   }
   PetscCall(STBackTransform(pep->st,k,er,ei));
 
-  PetscCall(DSVectors(pep->ds,DS_MAT_X,NULL,NULL));
+  PetscCall(DSVectorsRange(pep->ds,DS_MAT_X,0,k));
   PetscCall(DSGetArray(pep->ds,DS_MAT_X,&X));
 
   PetscCall(PetscBLASIntCast(k,&k_));
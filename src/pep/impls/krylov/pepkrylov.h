@@ -19,6 +19,7 @@ SLEPC_INTERN PetscErrorCode PEPSolve_STOAR(PEP);
 SLEPC_INTERN PetscErrorCode PEPSolve_STOAR_QSlice(PEP);
 SLEPC_INTERN PetscErrorCode PEPSetUp_STOAR_QSlice(PEP);
 SLEPC_INTERN PetscErrorCode PEPReset_STOAR_QSlice(PEP);
+SLEPC_INTERN PetscErrorCode PEPSTOARDestroyPartitions(PEP);
 
 typedef struct {
   PetscReal     keep;         /* restart parameter */
@@ -101,4 +102,16 @@ typedef struct {
   PetscBool     hyperbolic;     /* hyperbolic problem flag */
   PetscReal     alpha,beta;     /* coefficients defining the linearization */
   PetscBool     checket;        /* check eigenvalue type during spectrum slicing */
+  PetscInt      npart;          /* number of partitions of the communicator */
+  PetscSubcomm  subc;           /* context for subcommunicators */
+  MPI_Comm      commrank;       /* group processes with same rank in subcommunicators */
+  PetscBool     commset;        /* flag indicating that commrank was created */
+  PEP           pep;            /* auxiliary PEP that solves the pieces in a partition */
+  PetscObjectState Astate[3];   /* state of subcommunicator matrices */
+  PetscObjectId Aid[3];         /* Id of subcommunicator matrices */
+  PetscInt      nchunks;        /* number of pieces of the interval */
+  PetscReal     *chunks;        /* endpoints of the pieces, in increasing order */
+  PetscInt      *chunkeigs;     /* accumulated number of eigenvalues in the pieces */
+  PetscInt      queue[2],qinit[2]; /* range of pieces to be processed by this partition */
+  MPI_Win       win;            /* window to access the queues of all partitions */
 } PEP_STOAR;
@@ -70,7 +70,7 @@ static PetscErrorCode PEPExtractVectors_QArnoldi(PEP pep)
 
   PetscFunctionBegin;
   if (pep->nconv==0) PetscFunctionReturn(PETSC_SUCCESS);
-  PetscCall(DSVectors(pep->ds,DS_MAT_X,NULL,NULL));
+  PetscCall(DSVectorsRange(pep->ds,DS_MAT_X,0,k));
 
   /* update vectors V = V*X */
   PetscCall(DSGetMat(pep->ds,DS_MAT_X,&X));
@@ -41,6 +41,7 @@ static const char citation[] =
   "}\n";
 
 #define SLICE_PTOL PETSC_SQRT_MACHINE_EPSILON
+#define SLICE_NCHUNKS 4  /* pieces of the interval per partition */
 
 static PetscErrorCode PEPQSliceResetSR(PEP pep)
 {
@@ -61,8 +62,10 @@ static PetscErrorCode PEPQSliceResetSR(PEP pep)
       PetscCall(PetscFree(s));
     }
     PetscCall(PetscFree(sr->S));
-    for (i=0;i<pep->nconv;i++) PetscCall(PetscFree(sr->qinfo[i].q));
-    PetscCall(PetscFree(sr->qinfo));
+    if (sr->qinfo) {  /* not allocated with several partitions */
+      for (i=0;i<pep->nconv;i++) PetscCall(PetscFree(sr->qinfo[i].q));
+      PetscCall(PetscFree(sr->qinfo));
+    }
     for (i=0;i<3;i++) PetscCall(VecDestroy(&sr->v[i]));
     PetscCall(EPSDestroy(&sr->eps));
     PetscCall(PetscFree(sr));
@@ -79,6 +82,24 @@ PetscErrorCode PEPReset_STOAR_QSlice(PEP pep)
   PetscCall(PEPQSliceResetSR(pep));
   PetscCall(PetscFree(ctx->inertias));
   PetscCall(PetscFree(ctx->shifts));
+  if (ctx->pep) PetscCall(PEPReset(ctx->pep));
+  PetscCall(PetscFree2(ctx->chunks,ctx->chunkeigs));
+  ctx->nchunks = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PEPSTOARDestroyPartitions(PEP pep)
+{
+  PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
+
+  PetscFunctionBegin;
+  if (ctx->win!=MPI_WIN_NULL) PetscCallMPI(MPI_Win_free(&ctx->win));
+  PetscCall(PEPDestroy(&ctx->pep));
+  PetscCall(PetscSubcommDestroy(&ctx->subc));
+  if (ctx->commset) {
+    PetscCallMPI(MPI_Comm_free(&ctx->commrank));
+    ctx->commset = PETSC_FALSE;
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -472,6 +493,187 @@ static PetscErrorCode PEPBackTransform_Skip(PEP pep)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Creates the auxiliary PEP that solves the pieces of the interval assigned to
+   the partition of this process, with redundant copies of the matrices, and
+   transfers to it the settings of the parent solver
+*/
+static PetscErrorCode PEPQSliceGetChildPEP(PEP pep)
+{
+  PEP_STOAR        *ctx=(PEP_STOAR*)pep->data,*ctx_loc;
+  Mat              Ar[3];
+  PetscInt         i;
+  PetscMPIInt      rank;
+  PetscObjectState state;
+  PetscObjectId    id;
+  PetscBool        update=PETSC_FALSE,flg;
+  const char       *prefix;
+  STType           sttype;
+  MatStructure     str;
+  ST               st;
+  KSP              ksp,ksp_loc;
+  KSPType          ksptype;
+  PC               pc,pc_loc;
+  PCType           pctype;
+  MatSolverType    stype;
+  BV               V;
+  BVType           bvtype;
+  MPI_Comm         child;
+
+  PetscFunctionBegin;
+  if (!ctx->subc) {
+    PetscCall(PetscSubcommCreate(PetscObjectComm((PetscObject)pep),&ctx->subc));
+    PetscCall(PetscSubcommSetNumber(ctx->subc,ctx->npart));
+    PetscCall(SlepcSubcommSetType_Private((PetscObject)pep,"-pep_stoar_partitions_node_aware",ctx->subc,PETSC_SUBCOMM_CONTIGUOUS));
+  }
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  /* Create subcommunicator grouping processes with same rank */
+  if (!ctx->commset) {
+    PetscCallMPI(MPI_Comm_rank(child,&rank));
+    PetscCallMPI(MPI_Comm_split(PetscObjectComm((PetscObject)pep),rank,ctx->subc->color,&ctx->commrank));
+    ctx->commset = PETSC_TRUE;
+  }
+  if (!ctx->pep) {
+    PetscCall(PEPCreate(child,&ctx->pep));
+    PetscCall(PEPGetOptionsPrefix(pep,&prefix));
+    PetscCall(PEPSetOptionsPrefix(ctx->pep,prefix));
+    PetscCall(PEPSetType(ctx->pep,PEPSTOAR));
+    update = PETSC_TRUE;
+  }
+
+  /* Duplicate matrices, unless the child already has copies of the current ones */
+  for (i=0;i<pep->nmat;i++) {
+    PetscCall(MatGetState(pep->A[i],&state));
+    PetscCall(PetscObjectGetId((PetscObject)pep->A[i],&id));
+    if (ctx->Astate[i]!=state || ctx->Aid[i]!=id) update = PETSC_TRUE;
+  }
+  if (update) {
+    for (i=0;i<pep->nmat;i++) {
+      PetscCall(MatCreateRedundantMatrix(pep->A[i],0,child,MAT_INITIAL_MATRIX,&Ar[i]));
+      PetscCall(MatPropagateSymmetryOptions(pep->A[i],Ar[i]));
+      PetscCall(MatGetState(pep->A[i],&ctx->Astate[i]));
+      PetscCall(PetscObjectGetId((PetscObject)pep->A[i],&ctx->Aid[i]));
+    }
+    PetscCall(PEPSetOperators(ctx->pep,pep->nmat,Ar));
+    for (i=0;i<pep->nmat;i++) PetscCall(MatDestroy(&Ar[i]));
+  }
+
+  /* Settings of the solver, the options database is not processed again */
+  PetscCall(PEPSetProblemType(ctx->pep,pep->problem_type));
+  PetscCall(PEPSetWhichEigenpairs(ctx->pep,PEP_ALL));
+  PetscCall(PEPSetTolerances(ctx->pep,pep->tol,pep->max_it));
+  PetscCall(PEPSetScale(ctx->pep,pep->scale,pep->sfactor_set?pep->sfactor:(PetscReal)PETSC_DETERMINE,NULL,NULL,pep->sits,pep->slambda));
+  ctx_loc = (PEP_STOAR*)ctx->pep->data;
+  ctx_loc->lock    = ctx->lock;
+  ctx_loc->nev     = ctx->nev;
+  ctx_loc->ncv     = ctx->ncv;
+  ctx_loc->mpd     = ctx->mpd;
+  ctx_loc->detect  = ctx->detect;
+  ctx_loc->alpha   = ctx->alpha;
+  ctx_loc->beta    = ctx->beta;
+  ctx_loc->checket = ctx->checket;
+  if (pep->V && ((PetscObject)pep->V)->type_name) {
+    PetscCall(BVGetType(pep->V,&bvtype));
+    PetscCall(PEPGetBV(ctx->pep,&V));
+    PetscCall(BVSetType(V,bvtype));
+  }
+
+  /* Transfer the spectral transformation and the linear solver */
+  PetscCall(PEPGetST(ctx->pep,&st));
+  PetscCall(STGetType(pep->st,&sttype));
+  PetscCall(STSetType(st,sttype));
+  PetscCall(STGetMatStructure(pep->st,&str));
+  PetscCall(STSetMatStructure(st,str));
+  PetscCall(STGetKSP(pep->st,&ksp));
+  PetscCall(STGetKSP(st,&ksp_loc));
+  PetscCall(KSPGetType(ksp,&ksptype));
+  if (ksptype) PetscCall(KSPSetType(ksp_loc,ksptype));
+  PetscCall(KSPGetPC(ksp,&pc));
+  PetscCall(KSPGetPC(ksp_loc,&pc_loc));
+  PetscCall(PCGetType(pc,&pctype));
+  if (pctype) PetscCall(PCSetType(pc_loc,pctype));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)pc,&flg,PCLU,PCCHOLESKY,""));
+  if (flg) {
+    PetscCall(PCFactorGetMatSolverType(pc,&stype));
+    if (stype) PetscCall(PCFactorSetMatSolverType(pc_loc,stype));
+  }
+  ctx->pep->state = PEP_STATE_INITIAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Splits the interval in pieces, which are counted by the partitions in a cyclic
+   way, so that all processes know how many eigenvalues each piece contains. Then
+   each partition gets an initial queue of consecutive pieces, such that all the
+   queues contain about the same number of eigenvalues
+*/
+static PetscErrorCode PEPQSliceSetUpPartitions(PEP pep)
+{
+  PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
+  PEP_SR         sr=ctx->sr,sr_loc;
+  PetscInt       i,p,nc,total,*cnt,*inl,*inr;
+  PetscReal      h;
+  PetscMPIInt    rank,color,aux;
+  MPI_Comm       child;
+
+  PetscFunctionBegin;
+  PetscCheck(pep->inta>PETSC_MIN_REAL && pep->intb<PETSC_MAX_REAL,PetscObjectComm((PetscObject)pep),PETSC_ERR_ARG_WRONG,"The computational interval must be bounded to use several partitions");
+  PetscCall(PEPQSliceGetChildPEP(pep));
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  PetscCall(PetscMPIIntCast(ctx->subc->color,&color));
+
+  nc = ctx->npart*SLICE_NCHUNKS;
+  PetscCall(PetscFree2(ctx->chunks,ctx->chunkeigs));
+  PetscCall(PetscMalloc2(nc+1,&ctx->chunks,nc+1,&ctx->chunkeigs));
+  ctx->nchunks = nc;
+  h = (pep->intb-pep->inta)/nc;
+  for (i=0;i<nc;i++) ctx->chunks[i] = pep->inta+i*h;
+  ctx->chunks[nc] = pep->intb;
+
+  /* number of eigenvalues and inertias at both ends of each piece */
+  PetscCall(PetscCalloc1(3*nc,&cnt));
+  inl = cnt+nc;
+  inr = cnt+2*nc;
+  for (i=color;i<nc;i+=ctx->npart) {
+    PetscCall(PEPSetInterval(ctx->pep,ctx->chunks[i],ctx->chunks[i+1]));
+    PetscCall(PEPSetUp(ctx->pep));
+    sr_loc = ((PEP_STOAR*)ctx->pep->data)->sr;
+    cnt[i] = sr_loc->numEigs;
+    inl[i] = (sr_loc->dir==1)? sr_loc->inertia0: sr_loc->inertia1;
+    inr[i] = (sr_loc->dir==1)? sr_loc->inertia1: sr_loc->inertia0;
+  }
+  PetscCall(PetscMPIIntCast(3*nc,&aux));
+  if (!rank) PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,cnt,aux,MPIU_INT,MPI_SUM,ctx->commrank));
+  PetscCallMPI(MPI_Bcast(cnt,aux,MPIU_INT,0,child));
+  ctx->chunkeigs[0] = 0;
+  for (i=0;i<nc;i++) ctx->chunkeigs[i+1] = ctx->chunkeigs[i]+cnt[i];
+  total = ctx->chunkeigs[nc];
+
+  /* the parent keeps the global interval, with the inertias at its ends */
+  sr->int0     = pep->inta;
+  sr->int1     = pep->intb;
+  sr->dir      = 1;
+  sr->hasEnd   = PETSC_TRUE;
+  sr->inertia0 = inl[0];
+  sr->inertia1 = inr[nc-1];
+  sr->numEigs  = total;
+  PetscCall(PetscFree(cnt));
+
+  /* every piece goes to the partition that contains its middle eigenvalue */
+  ctx->qinit[0] = ctx->qinit[1] = 0;
+  for (i=0;i<nc;i++) {
+    p = total? PetscMin(ctx->npart-1,(ctx->chunkeigs[i]+ctx->chunkeigs[i+1])*ctx->npart/(2*total)): i*ctx->npart/nc;
+    if (p<color) ctx->qinit[0] = ctx->qinit[1] = i+1;
+    else if (p==color) ctx->qinit[1] = i+1;
+  }
+  PetscCall(PetscInfo(pep,"QSlice setup: %" PetscInt_FMT " eigenvalues in [%g,%g], partition %d starts with pieces %" PetscInt_FMT " to %" PetscInt_FMT "\n",total,(double)pep->inta,(double)pep->intb,(int)color,ctx->qinit[0],ctx->qinit[1]-1));
+
+  /* window to access the queues, only the first process of each partition uses it */
+  if (ctx->win==MPI_WIN_NULL) PetscCallMPI(MPI_Win_create(ctx->queue,(MPI_Aint)(2*sizeof(PetscInt)),(PetscMPIInt)sizeof(PetscInt),MPI_INFO_NULL,ctx->commrank,&ctx->win));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode PEPSetUp_STOAR_QSlice(PEP pep)
 {
   PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
@@ -514,6 +716,13 @@ PetscErrorCode PEPSetUp_STOAR_QSlice(PEP pep)
 
   ctx->hyperbolic = (pep->problem_type==PEP_HYPERBOLIC)? PETSC_TRUE: PETSC_FALSE;
 
+  /* with several partitions the pieces of the interval are set up in the child solver */
+  if (ctx->npart>1) {
+    PetscCall(PEPQSliceSetUpPartitions(pep));
+    pep->ncv = 0; pep->nev = 0; pep->mpd = 0;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* check presence of ends and finding direction */
   if (pep->inta > PETSC_MIN_REAL || pep->intb >= PETSC_MAX_REAL) {
     sr->int0 = pep->inta;
@@ -1365,6 +1574,240 @@ static PetscErrorCode PEPQSliceGetInertias(PEP pep,PetscInt *n,PetscReal **shift
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Gets the index of the next piece to be processed by this partition, or -1 if
+   there is no work left. The queues are accessed by the first process of each
+   partition, and the result is broadcast to the rest of processes.
+*/
+static PetscErrorCode PEPQSliceGetNextChunk(PEP pep,PetscInt *chunk)
+{
+  PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
+  PetscMPIInt    rank,color,npart;
+  MPI_Comm       child;
+
+  PetscFunctionBegin;
+  *chunk = -1;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  if (!rank) {
+    PetscCall(PetscMPIIntCast(ctx->subc->color,&color));
+    PetscCall(PetscMPIIntCast(ctx->npart,&npart));
+    PetscCall(SlepcSliceGetNextChunk_Private((PetscObject)pep,ctx->win,color,npart,ctx->chunkeigs,chunk));
+  }
+  PetscCallMPI(MPI_Bcast(chunk,1,MPIU_INT,0,child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Gathers the eigenvectors computed in the partitions, stored in V_loc, into
+   the basis of the parent solver
+*/
+static PetscErrorCode PEPQSliceGatherEigenVectors(PEP pep,BV V_loc,PetscMPIInt *nconv_loc)
+{
+  PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
+  Vec            v,vg,v_loc;
+  IS             is1,is2;
+  VecScatter     vec_sc;
+  PetscInt       nloc,m0,n0,i,si,idx,*idx1,*idx2,j;
+  PetscScalar    *array;
+  MPI_Comm       contpar;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetColumn(pep->V,0,&v));
+  PetscCall(VecGetOwnershipRange(v,&n0,&m0));
+  PetscCall(BVRestoreColumn(pep->V,0,&v));
+  PetscCall(BVGetColumn(ctx->pep->V,0,&v));
+  PetscCall(VecGetLocalSize(v,&nloc));
+  PetscCall(BVRestoreColumn(ctx->pep->V,0,&v));
+  PetscCall(PetscMalloc2(m0-n0,&idx1,m0-n0,&idx2));
+  PetscCall(PetscSubcommGetContiguousParent(ctx->subc,&contpar));
+  PetscCall(VecCreateMPI(contpar,nloc,PETSC_DECIDE,&vg));
+  idx = -1;
+  for (si=0;si<ctx->npart;si++) {
+    j = 0;
+    for (i=n0;i<m0;i++) {
+      idx1[j]   = i;
+      idx2[j++] = i+pep->n*si;
+    }
+    PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)pep),(m0-n0),idx1,PETSC_COPY_VALUES,&is1));
+    PetscCall(ISCreateGeneral(PetscObjectComm((PetscObject)pep),(m0-n0),idx2,PETSC_COPY_VALUES,&is2));
+    PetscCall(BVGetColumn(pep->V,0,&v));
+    PetscCall(VecScatterCreate(v,is1,vg,is2,&vec_sc));
+    PetscCall(BVRestoreColumn(pep->V,0,&v));
+    PetscCall(ISDestroy(&is1));
+    PetscCall(ISDestroy(&is2));
+    for (i=0;i<nconv_loc[si];i++) {
+      PetscCall(BVGetColumn(pep->V,++idx,&v));
+      if (ctx->subc->color==si) {
+        PetscCall(BVGetColumn(V_loc,i,&v_loc));
+        PetscCall(VecGetArray(v_loc,&array));
+        PetscCall(VecPlaceArray(vg,array));
+      }
+      PetscCall(VecScatterBegin(vec_sc,vg,v,INSERT_VALUES,SCATTER_REVERSE));
+      PetscCall(VecScatterEnd(vec_sc,vg,v,INSERT_VALUES,SCATTER_REVERSE));
+      if (ctx->subc->color==si) {
+        PetscCall(VecResetArray(vg));
+        PetscCall(VecRestoreArray(v_loc,&array));
+        PetscCall(BVRestoreColumn(V_loc,i,&v_loc));
+      }
+      PetscCall(BVRestoreColumn(pep->V,idx,&v));
+    }
+    PetscCall(VecScatterDestroy(&vec_sc));
+  }
+  PetscCall(PetscFree2(idx1,idx2));
+  PetscCall(VecDestroy(&vg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solves the pieces of the interval with dynamic load balancing between the
+   partitions. The eigenpairs, shifts and inertias of the pieces processed by
+   each partition are accumulated, and at the end they are gathered in the
+   parent solver.
+*/
+static PetscErrorCode PEPQSliceSolvePartitions(PEP pep)
+{
+  PEP_STOAR      *ctx=(PEP_STOAR*)pep->data;
+  PEP            pep_loc=ctx->pep;
+  PEP_SR         sr_loc;
+  PetscInt       i,j,k,chunk,n=0,nalloc=0,its=0,ns,nsh=0,*perm=NULL,*inertias_loc,*inertias=NULL,*aux_i,*aux_p;
+  PetscReal      *errest=NULL,*shifts_loc,*shifts=NULL,*aux_r,*aux_e;
+  PetscScalar    *eigr=NULL,*eigi=NULL,*aux_s1,*aux_s2;
+  PetscMPIInt    rank,color,npart,aux,*count,*disp;
+  BV             V=NULL;
+  Vec            v;
+  MPI_Comm       child;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(ctx->subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  PetscCall(PetscMPIIntCast(ctx->subc->color,&color));
+  PetscCall(PetscMPIIntCast(ctx->npart,&npart));
+  /* initialize the queues, computed in PEPQSliceSetUpPartitions() */
+  if (!rank) {
+    PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,color,0,ctx->win));
+    PetscCallMPI(MPI_Put(ctx->qinit,2,MPIU_INT,color,0,2,MPIU_INT,ctx->win));
+    PetscCallMPI(MPI_Win_unlock(color,ctx->win));
+  }
+  PetscCallMPI(MPI_Barrier(ctx->commrank));
+
+  PetscCall(PEPQSliceGetNextChunk(pep,&chunk));
+  while (chunk>=0) {
+    PetscCall(PetscInfo(pep,"Solving piece %" PetscInt_FMT " [%g,%g] with %" PetscInt_FMT " eigenvalues\n",chunk,(double)ctx->chunks[chunk],(double)ctx->chunks[chunk+1],ctx->chunkeigs[chunk+1]-ctx->chunkeigs[chunk]));
+    PetscCall(PEPSetInterval(pep_loc,ctx->chunks[chunk],ctx->chunks[chunk+1]));
+    PetscCall(PEPSetUp(pep_loc));
+    pep_loc->nconv = 0;
+    PetscCall(PEPSolve_STOAR_QSlice(pep_loc));
+    sr_loc = ((PEP_STOAR*)pep_loc->data)->sr;
+    k = pep_loc->nconv;
+
+    /* append the computed eigenpairs */
+    if (n+k>nalloc) {
+      nalloc = PetscMax(2*nalloc,n+k);
+      PetscCall(PetscMalloc4(nalloc,&aux_s1,nalloc,&aux_s2,nalloc,&aux_e,nalloc,&aux_p));
+      PetscCall(PetscArraycpy(aux_s1,eigr,n));
+      PetscCall(PetscArraycpy(aux_s2,eigi,n));
+      PetscCall(PetscArraycpy(aux_e,errest,n));
+      PetscCall(PetscArraycpy(aux_p,perm,n));
+      PetscCall(PetscFree4(eigr,eigi,errest,perm));
+      eigr = aux_s1; eigi = aux_s2; errest = aux_e; perm = aux_p;
+      if (!V) PetscCall(BVDuplicateResize(pep_loc->V,nalloc,&V));
+      else PetscCall(BVResize(V,nalloc,PETSC_TRUE));
+    }
+    for (i=0;i<k;i++) {
+      eigr[n+i]   = pep_loc->eigr[i];
+      eigi[n+i]   = pep_loc->eigi[i];
+      errest[n+i] = pep_loc->errest[i];
+      perm[n+i]   = n+pep_loc->perm[i];
+      PetscCall(BVGetColumn(V,n+i,&v));
+      PetscCall(BVCopyVec(pep_loc->V,i,v));
+      PetscCall(BVRestoreColumn(V,n+i,&v));
+    }
+    n   += k;
+    its += sr_loc->itsKs;
+
+    /* append the shifts and inertias */
+    PetscCall(PEPQSliceGetInertias(pep_loc,&ns,&shifts_loc,&inertias_loc));
+    PetscCall(PetscMalloc2(nsh+ns,&aux_r,nsh+ns,&aux_i));
+    PetscCall(PetscArraycpy(aux_r,shifts,nsh));
+    PetscCall(PetscArraycpy(aux_i,inertias,nsh));
+    PetscCall(PetscArraycpy(aux_r+nsh,shifts_loc,ns));
+    PetscCall(PetscArraycpy(aux_i+nsh,inertias_loc,ns));
+    PetscCall(PetscFree2(shifts,inertias));
+    PetscCall(PetscFree(shifts_loc));
+    PetscCall(PetscFree(inertias_loc));
+    shifts = aux_r; inertias = aux_i; nsh += ns;
+
+    PetscCall(PEPQSliceGetNextChunk(pep,&chunk));
+  }
+
+  /* Gather the eigenvalues, the data are replicated in each partition */
+  PetscCall(PetscMalloc2(npart,&count,npart,&disp));
+  PetscCall(PetscMPIIntCast(n,&aux));
+  if (!rank) PetscCallMPI(MPI_Allgather(&aux,1,MPI_INT,count,1,MPI_INT,ctx->commrank));
+  PetscCallMPI(MPI_Bcast(count,npart,MPI_INT,0,child));
+  disp[0] = 0;
+  for (i=1;i<npart;i++) disp[i] = disp[i-1]+count[i-1];
+  pep->nconv = disp[npart-1]+count[npart-1];
+  PetscCall(PetscFree4(pep->eigr,pep->eigi,pep->errest,pep->perm));
+  k = PetscMax(1,pep->nconv);
+  PetscCall(PetscMalloc4(k,&pep->eigr,k,&pep->eigi,k,&pep->errest,k,&pep->perm));
+  if (!rank) {
+    PetscCallMPI(MPI_Allgatherv(eigr,aux,MPIU_SCALAR,pep->eigr,count,disp,MPIU_SCALAR,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(eigi,aux,MPIU_SCALAR,pep->eigi,count,disp,MPIU_SCALAR,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(errest,aux,MPIU_REAL,pep->errest,count,disp,MPIU_REAL,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(perm,aux,MPIU_INT,pep->perm,count,disp,MPIU_INT,ctx->commrank));
+    PetscCallMPI(MPIU_Allreduce(&its,&pep->its,1,MPIU_INT,MPI_SUM,ctx->commrank));
+  }
+  PetscCall(PetscMPIIntCast(pep->nconv,&aux));
+  PetscCallMPI(MPI_Bcast(pep->eigr,aux,MPIU_SCALAR,0,child));
+  PetscCallMPI(MPI_Bcast(pep->eigi,aux,MPIU_SCALAR,0,child));
+  PetscCallMPI(MPI_Bcast(pep->errest,aux,MPIU_REAL,0,child));
+  PetscCallMPI(MPI_Bcast(pep->perm,aux,MPIU_INT,0,child));
+  PetscCallMPI(MPI_Bcast(&pep->its,1,MPIU_INT,0,child));
+  for (i=1;i<npart;i++) {
+    for (j=disp[i];j<disp[i]+count[i];j++) pep->perm[j] += disp[i];
+  }
+
+  /* Gather the eigenvectors */
+  PetscCall(BVResize(pep->V,k,PETSC_FALSE));
+  PetscCall(PEPQSliceGatherEigenVectors(pep,V,count));
+
+  /* Gather the shifts and inertias, the pieces are not in order so sort them and remove duplicates */
+  PetscCall(PetscMPIIntCast(nsh,&aux));
+  if (!rank) PetscCallMPI(MPI_Allgather(&aux,1,MPI_INT,count,1,MPI_INT,ctx->commrank));
+  PetscCallMPI(MPI_Bcast(count,npart,MPI_INT,0,child));
+  for (i=1;i<npart;i++) disp[i] = disp[i-1]+count[i-1];
+  ctx->nshifts = disp[npart-1]+count[npart-1];
+  PetscCall(PetscFree(ctx->shifts));
+  PetscCall(PetscFree(ctx->inertias));
+  PetscCall(PetscMalloc1(ctx->nshifts,&ctx->shifts));
+  PetscCall(PetscMalloc1(ctx->nshifts,&ctx->inertias));
+  if (!rank) {
+    PetscCallMPI(MPI_Allgatherv(shifts,aux,MPIU_REAL,ctx->shifts,count,disp,MPIU_REAL,ctx->commrank));
+    PetscCallMPI(MPI_Allgatherv(inertias,aux,MPIU_INT,ctx->inertias,count,disp,MPIU_INT,ctx->commrank));
+  }
+  PetscCall(PetscMPIIntCast(ctx->nshifts,&aux));
+  PetscCallMPI(MPI_Bcast(ctx->shifts,aux,MPIU_REAL,0,child));
+  PetscCallMPI(MPI_Bcast(ctx->inertias,aux,MPIU_INT,0,child));
+  PetscCall(PetscSortRealWithArrayInt(ctx->nshifts,ctx->shifts,ctx->inertias));
+  for (i=1,j=0;i<ctx->nshifts;i++) {
+    if (ctx->shifts[i]==ctx->shifts[j]) continue;
+    j++;
+    ctx->shifts[j] = ctx->shifts[i];
+    ctx->inertias[j] = ctx->inertias[i];
+  }
+  if (ctx->nshifts) ctx->nshifts = j+1;
+
+  pep->nev    = pep->nconv;
+  pep->reason = PEP_CONVERGED_TOL;
+  PetscCall(PetscFree2(count,disp));
+  PetscCall(PetscFree4(eigr,eigi,errest,perm));
+  PetscCall(PetscFree2(shifts,inertias));
+  PetscCall(BVDestroy(&V));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode PEPSolve_STOAR_QSlice(PEP pep)
 {
   PetscInt       i,j,ti,deg=pep->nmat-1;
@@ -1383,6 +1826,12 @@ PetscErrorCode PEPSolve_STOAR_QSlice(PEP pep)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* With several partitions the pieces are solved by the child solvers */
+  if (ctx->npart>1) {
+    PetscCall(PEPQSliceSolvePartitions(pep));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* Inner product matrix */
   PetscCall(PEPSTOARSetUpInnerMatrix(pep,&B));
 
@@ -174,7 +174,7 @@ static PetscErrorCode PEPSTOARrun(PEP pep,PetscReal *a,PetscReal *b,PetscReal *o
   PetscInt       lds,d,ld,offq,nqt,ldds;
   Vec            v=t_[0],t=t_[1],q=t_[2];
   PetscReal      norm,sym=0.0,fro=0.0,*f;
-  PetscScalar    *y,*S,*x,sigma;
+  PetscScalar    *y,*S,*x,sigma,coeff[3];
   PetscBLASInt   j_,one=1;
   PetscBool      lindep,flg,sinvert=PETSC_FALSE;
   Mat            MS;
@@ -208,19 +208,19 @@ static PetscErrorCode PEPSTOARrun(PEP pep,PetscReal *a,PetscReal *b,PetscReal *o
     if (!sinvert) {
       PetscCall(STMatMult(pep->st,0,v,q));
       PetscCall(BVMultVec(pep->V,1.0,0.0,v,S+offq+j*lds));
-      PetscCall(STMatMult(pep->st,1,v,t));
-      PetscCall(VecAXPY(q,pep->sfactor,t));
       if (ctx->beta && ctx->alpha) {
-        PetscCall(STMatMult(pep->st,2,v,t));
-        PetscCall(VecAXPY(q,-pep->sfactor*pep->sfactor*ctx->beta/ctx->alpha,t));
+        coeff[0] = 0.0; coeff[1] = pep->sfactor; coeff[2] = -pep->sfactor*pep->sfactor*ctx->beta/ctx->alpha;
+        PetscCall(STMatMultCombination(pep->st,3,coeff,v,t));
+        PetscCall(VecAXPY(q,1.0,t));
+      } else {
+        PetscCall(STMatMult(pep->st,1,v,t));
+        PetscCall(VecAXPY(q,pep->sfactor,t));
       }
       PetscCall(STMatSolve(pep->st,q,t));
       PetscCall(VecScale(t,-1.0/(pep->sfactor*pep->sfactor)));
     } else {
-      PetscCall(STMatMult(pep->st,1,v,q));
-      PetscCall(STMatMult(pep->st,2,v,t));
-      PetscCall(VecAXPY(q,sigma*pep->sfactor,t));
-      PetscCall(VecScale(q,pep->sfactor));
+      coeff[0] = 0.0; coeff[1] = pep->sfactor; coeff[2] = sigma*pep->sfactor*pep->sfactor;
+      PetscCall(STMatMultCombination(pep->st,3,coeff,v,q));
       PetscCall(BVMultVec(pep->V,1.0,0.0,v,S+offq+j*lds));
       PetscCall(STMatMult(pep->st,2,v,t));
       PetscCall(VecAXPY(q,pep->sfactor*pep->sfactor,t));
@@ -503,6 +503,10 @@ static PetscErrorCode PEPSetFromOptions_STOAR(PEP pep,PetscOptionItems *PetscOpt
     PetscCall(PetscOptionsBool("-pep_stoar_check_eigenvalue_type","Check eigenvalue type during spectrum slicing","PEPSTOARSetCheckEigenvalueType",ctx->checket,&b,&flg));
     if (flg) PetscCall(PEPSTOARSetCheckEigenvalueType(pep,b));
 
+    i = ctx->npart;
+    PetscCall(PetscOptionsInt("-pep_stoar_partitions","Number of partitions of the communicator for spectrum slicing","PEPSTOARSetPartitions",ctx->npart,&i,&flg));
+    if (flg) PetscCall(PEPSTOARSetPartitions(pep,i));
+
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1008,6 +1012,108 @@ PetscErrorCode PEPSTOARGetCheckEigenvalueType(PEP pep,PetscBool *checket)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PEPSTOARSetPartitions_STOAR(PEP pep,PetscInt npart)
+{
+  PEP_STOAR   *ctx = (PEP_STOAR*)pep->data;
+  PetscMPIInt size;
+  PetscInt    newnpart;
+
+  PetscFunctionBegin;
+  if (npart == PETSC_DEFAULT || npart == PETSC_DECIDE) {
+    newnpart = 1;
+  } else {
+    PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)pep),&size));
+    PetscCheck(npart>0 && npart<=size,PetscObjectComm((PetscObject)pep),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of npart");
+    newnpart = npart;
+  }
+  if (ctx->npart!=newnpart) {
+    PetscCall(PEPSTOARDestroyPartitions(pep));
+    ctx->npart = newnpart;
+    pep->state = PEP_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PEPSTOARSetPartitions - Sets the number of partitions for the case of doing
+   spectrum slicing for a computational interval with the communicator split
+   in several sub-communicators.
+
+   Logically Collective
+
+   Input Parameters:
++  pep   - the eigenproblem solver context
+-  npart - number of partitions
+
+   Options Database Keys:
++  -pep_stoar_partitions <npart> - Sets the number of partitions
+-  -pep_stoar_partitions_node_aware - Aligns the partitions with the shared-memory nodes
+
+   Notes:
+   By default, npart=1 so all processes in the communicator participate in
+   the processing of the whole interval. If npart>1 then the interval is
+   split in pieces that are processed by subsets of processes, each of them
+   holding a redundant copy of the coefficient matrices.
+
+   The pieces are distributed so that all partitions start with about the same
+   number of eigenvalues, according to the inertia at the endpoints of the
+   pieces. A partition that finishes its pieces takes the pending ones of the
+   partition with more eigenvalues left, about half of them, so the work is
+   balanced dynamically during the solve.
+
+   The computational interval must be bounded when using several partitions.
+
+   The partitions are formed by consecutive ranks of the communicator, or by
+   processes of the same shared-memory node as much as possible with the option
+   -pep_stoar_partitions_node_aware.
+
+   Level: advanced
+
+.seealso: PEPSTOARGetPartitions(), PEPSetInterval()
+@*/
+PetscErrorCode PEPSTOARSetPartitions(PEP pep,PetscInt npart)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pep,PEP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pep,npart,2);
+  PetscTryMethod(pep,"PEPSTOARSetPartitions_C",(PEP,PetscInt),(pep,npart));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PEPSTOARGetPartitions_STOAR(PEP pep,PetscInt *npart)
+{
+  PEP_STOAR *ctx = (PEP_STOAR*)pep->data;
+
+  PetscFunctionBegin;
+  *npart = ctx->npart;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PEPSTOARGetPartitions - Gets the number of partitions of the communicator
+   in case of spectrum slicing.
+
+   Not Collective
+
+   Input Parameter:
+.  pep - the eigenproblem solver context
+
+   Output Parameter:
+.  npart - number of partitions
+
+   Level: advanced
+
+.seealso: PEPSTOARSetPartitions()
+@*/
+PetscErrorCode PEPSTOARGetPartitions(PEP pep,PetscInt *npart)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pep,PEP_CLASSID,1);
+  PetscAssertPointer(npart,2);
+  PetscUseMethod(pep,"PEPSTOARGetPartitions_C",(PEP,PetscInt*),(pep,npart));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PEPView_STOAR(PEP pep,PetscViewer viewer)
 {
   PEP_STOAR      *ctx = (PEP_STOAR*)pep->data;
@@ -1019,6 +1125,7 @@ static PetscErrorCode PEPView_STOAR(PEP pep,PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer,"  using the %slocking variant\n",ctx->lock?"":"non-"));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  linearization parameters: alpha=%g beta=%g\n",(double)ctx->alpha,(double)ctx->beta));
     if (pep->which==PEP_ALL && !ctx->hyperbolic) PetscCall(PetscViewerASCIIPrintf(viewer,"  checking eigenvalue type: %s\n",ctx->checket?"enabled":"disabled"));
+    if (pep->which==PEP_ALL && ctx->npart>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  number of partitions: %" PetscInt_FMT ", with dynamic load balancing\n",ctx->npart));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1036,6 +1143,7 @@ static PetscErrorCode PEPDestroy_STOAR(PEP pep)
 
   PetscFunctionBegin;
   PetscCall(BVDestroy(&ctx->V));
+  PetscCall(PEPSTOARDestroyPartitions(pep));
   PetscCall(PetscFree(pep->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARSetLocking_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetLocking_C",NULL));
@@ -1048,6 +1156,8 @@ static PetscErrorCode PEPDestroy_STOAR(PEP pep)
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetLinearization_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARSetCheckEigenvalueType_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetCheckEigenvalueType_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARSetPartitions_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetPartitions_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1067,6 +1177,8 @@ SLEPC_EXTERN PetscErrorCode PEPCreate_STOAR(PEP pep)
   ctx->alpha    = 1.0;
   ctx->beta     = 0.0;
   ctx->checket  = PETSC_TRUE;
+  ctx->npart    = 1;
+  ctx->win      = MPI_WIN_NULL;
 
   pep->ops->setup          = PEPSetUp_STOAR;
   pep->ops->setfromoptions = PEPSetFromOptions_STOAR;
@@ -1088,5 +1200,7 @@ SLEPC_EXTERN PetscErrorCode PEPCreate_STOAR(PEP pep)
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetLinearization_C",PEPSTOARGetLinearization_STOAR));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARSetCheckEigenvalueType_C",PEPSTOARSetCheckEigenvalueType_STOAR));
   PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetCheckEigenvalueType_C",PEPSTOARGetCheckEigenvalueType_STOAR));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARSetPartitions_C",PEPSTOARSetPartitions_STOAR));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pep,"PEPSTOARGetPartitions_C",PEPSTOARGetPartitions_STOAR));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -44,7 +44,7 @@ typedef struct {
   VecScatter   scatter_sub;
   VecScatter   *scatter_id,*scatterp_id;
   Mat          *A;
-  BV           V,W,M2,M3,Wt;
+  BV           V,W,M2,M3,Wt,Z,Zt;
   PetscScalar  *M4,*w,*wt,*d,*dt;
   Vec          t,tg,Rv,Vi,tp,tpg;
   PetscInt     idx,*cols;
@@ -149,7 +149,9 @@ static PetscErrorCode NRefSysSetup_shell(PEP pep,PetscInt k,PetscScalar *fH,Pets
   }
   /* T11 */
   if (!ctx->compM1) {
-    PetscCall(MatCopy(A[0],M1,DIFFERENT_NONZERO_PATTERN));
+    /* M1 already has the nonzero pattern of all A[j], keep it to reuse the symbolic factorization */
+    if (str!=SAME_NONZERO_PATTERN) str = SUBSET_NONZERO_PATTERN;
+    PetscCall(MatCopy(A[0],M1,str));
     PetscCall(PEPEvaluateBasis(pep,h,0,Ts,NULL));
     for (j=1;j<nmat;j++) PetscCall(MatAXPY(M1,Ts[j],A[j],str));
   }
@@ -344,15 +346,20 @@ static PetscErrorCode NRefRightSide(PetscInt nmat,PetscReal *pcf,Mat *A,PetscInt
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode NRefSysSolve_mbe(PetscInt k,PetscInt sz,BV W,PetscScalar *w,BV Wt,PetscScalar *wt,PetscScalar *d,PetscScalar *dt,KSP ksp,BV T2,BV T3 ,PetscScalar *T4,PetscBool trans,Vec x1,PetscScalar *x2,Vec sol1,PetscScalar *sol2,Vec vw)
+/*
+   If Z is not NULL, x1 must be the sz-th column of T2 (T3 if trans) and Z must contain
+   the solutions of the systems with M1 (M1^T if trans) for the columns of T2 (T3),
+   so that the solve is replaced by a linear combination of the columns of Z
+*/
+static PetscErrorCode NRefSysSolve_mbe(PetscInt k,PetscInt sz,BV W,PetscScalar *w,BV Wt,PetscScalar *wt,PetscScalar *d,PetscScalar *dt,KSP ksp,BV T2,BV T3 ,PetscScalar *T4,PetscBool trans,BV Z,Vec x1,PetscScalar *x2,Vec sol1,PetscScalar *sol2,Vec vw)
 {
   PetscInt       i,j,incf,incc;
-  PetscScalar    *y,*g,*xx2,*ww,y2,*dd;
+  PetscScalar    *y,*g,*xx2,*ww,y2,*dd,*c;
   Vec            v,t,xx1;
   BV             WW,T;
 
   PetscFunctionBegin;
-  PetscCall(PetscMalloc3(sz,&y,sz,&g,k,&xx2));
+  PetscCall(PetscMalloc4(sz,&y,sz,&g,k,&xx2,sz+1,&c));
   if (trans) {
     WW = W; ww = w; dd = d; T = T3; incf = 0; incc = 1;
   } else {
@@ -376,7 +383,12 @@ static PetscErrorCode NRefSysSolve_mbe(PetscInt k,PetscInt sz,BV W,PetscScalar *
     for (j=0;j<=i;j++) xx2[j] -= y[i]*T4[j*incf+incc*i+(i*incf+incc*j)*k];
     g[i] = xx2[i];
   }
-  if (trans) PetscCall(KSPSolveTranspose(ksp,xx1,sol1));
+  if (Z) {
+    for (i=0;i<sz;i++) c[i] = -y[i];
+    c[sz] = 1.0;
+    PetscCall(BVSetActiveColumns(Z,0,sz+1));
+    PetscCall(BVMultVec(Z,1.0,0.0,sol1,c));
+  } else if (trans) PetscCall(KSPSolveTranspose(ksp,xx1,sol1));
   else PetscCall(KSPSolve(ksp,xx1,sol1));
   if (trans) {
     WW = Wt; ww = wt; dd = dt; T = T2; incf = 1; incc = 0;
@@ -397,7 +409,7 @@ static PetscErrorCode NRefSysSolve_mbe(PetscInt k,PetscInt sz,BV W,PetscScalar *
     sol2[i] = y[i]+y2;
     PetscCall(BVRestoreColumn(WW,i,&v));
   }
-  PetscCall(PetscFree3(y,g,xx2));
+  PetscCall(PetscFree4(y,g,xx2,c));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -411,8 +423,9 @@ static PetscErrorCode NRefSysSetup_mbe(PEP pep,PetscInt k,KSP ksp,PetscScalar *f
   PetscBLASInt   lds_,lda_,k_;
   MatStructure   str;
   PetscBool      flg;
-  BV             M2=matctx->M2,M3=matctx->M3,W=matctx->W,Wt=matctx->Wt;
+  BV             M2=matctx->M2,M3=matctx->M3,W=matctx->W,Wt=matctx->Wt,Z=matctx->Z,Zt=matctx->Zt;
   Vec            vc,vc2;
+  Mat            B,X;
 
   PetscFunctionBegin;
   PetscCall(PetscMalloc3(nmat*k*k,&T12,k*k,&Tr,PetscMax(k*k,nmat),&Ts));
@@ -438,7 +451,9 @@ static PetscErrorCode NRefSysSetup_mbe(PEP pep,PetscInt k,KSP ksp,PetscScalar *f
 
   /* T11 */
   if (!matctx->compM1) {
-    PetscCall(MatCopy(A[0],M1,DIFFERENT_NONZERO_PATTERN));
+    /* M1 already has the nonzero pattern of all A[j], keep it to reuse the symbolic factorization */
+    if (str!=SAME_NONZERO_PATTERN) str = SUBSET_NONZERO_PATTERN;
+    PetscCall(MatCopy(A[0],M1,str));
     PetscCall(PEPEvaluateBasis(pep,h,0,Ts,NULL));
     for (j=1;j<nmat;j++) PetscCall(MatAXPY(M1,Ts[j],A[j],str));
   }
@@ -489,11 +504,27 @@ static PetscErrorCode NRefSysSetup_mbe(PEP pep,PetscInt k,KSP ksp,PetscScalar *f
   PetscCall(KSPSetUp(ksp));
   PetscCall(MatDestroy(&Mk));
 
+  /* The solves with M1 in BEMW are applied to the columns of M2 (M3 for the transpose)
+     after eliminating the previous ones, so compute all of them at once */
+  PetscCall(BVSetActiveColumns(M2,0,k));
+  PetscCall(BVSetActiveColumns(Z,0,k));
+  PetscCall(BVGetMat(M2,&B));
+  PetscCall(BVGetMat(Z,&X));
+  PetscCall(KSPMatSolve(ksp,B,X));
+  PetscCall(BVRestoreMat(Z,&X));
+  PetscCall(BVRestoreMat(M2,&B));
+  PetscCall(BVSetActiveColumns(Zt,0,k));
+  PetscCall(BVGetMat(M3,&B));
+  PetscCall(BVGetMat(Zt,&X));
+  PetscCall(KSPMatSolveTranspose(ksp,B,X));
+  PetscCall(BVRestoreMat(Zt,&X));
+  PetscCall(BVRestoreMat(M3,&B));
+
   /* Set up for BEMW */
   for (i=0;i<k;i++) {
     PetscCall(BVGetColumn(M2,i,&vc));
     PetscCall(BVGetColumn(W,i,&vc2));
-    PetscCall(NRefSysSolve_mbe(k,i,W,w,Wt,wt,d,dt,ksp,M2,M3,M4,PETSC_FALSE,vc,M4+i*k,vc2,w+i*k,matctx->t));
+    PetscCall(NRefSysSolve_mbe(k,i,W,w,Wt,wt,d,dt,ksp,M2,M3,M4,PETSC_FALSE,Z,vc,M4+i*k,vc2,w+i*k,matctx->t));
     PetscCall(BVRestoreColumn(M2,i,&vc));
     PetscCall(BVGetColumn(M3,i,&vc));
     PetscCall(VecConjugate(vc));
@@ -507,7 +538,7 @@ static PetscErrorCode NRefSysSetup_mbe(PEP pep,PetscInt k,KSP ksp,PetscScalar *f
     PetscCall(BVGetColumn(M3,i,&vc));
     PetscCall(BVGetColumn(Wt,i,&vc2));
     for (j=0;j<=i;j++) Ts[j] = M4[i+j*k];
-    PetscCall(NRefSysSolve_mbe(k,i,W,w,Wt,wt,d,dt,ksp,M2,M3,M4,PETSC_TRUE,vc,Ts,vc2,wt+i*k,matctx->t));
+    PetscCall(NRefSysSolve_mbe(k,i,W,w,Wt,wt,d,dt,ksp,M2,M3,M4,PETSC_TRUE,Zt,vc,Ts,vc2,wt+i*k,matctx->t));
     PetscCall(BVRestoreColumn(M3,i,&vc));
     PetscCall(BVGetColumn(M2,i,&vc));
     PetscCall(VecConjugate(vc2));
@@ -567,7 +598,9 @@ static PetscErrorCode NRefSysSetup_explicit(PEP pep,PetscInt k,KSP ksp,PetscScal
 
   /* T11 */
   if (!matctx->compM1) {
-    PetscCall(MatCopy(A[0],E[0],DIFFERENT_NONZERO_PATTERN));
+    /* E[0] already has the nonzero pattern of all A[j], keep it so that the pattern of M does not change */
+    if (str!=SAME_NONZERO_PATTERN) str = SUBSET_NONZERO_PATTERN;
+    PetscCall(MatCopy(A[0],E[0],str));
     PetscCall(PEPEvaluateBasis(pep,h,0,Ts,NULL));
     for (j=1;j<nmat;j++) PetscCall(MatAXPY(E[0],Ts[j],A[j],str));
   }
@@ -767,7 +800,7 @@ static PetscErrorCode NRefSysIter(PetscInt i,PEP pep,PetscInt k,KSP ksp,PetscSca
         PetscCall(NRefSysSolve_explicit(k,ksp,R,Rh,Vi,dHi,matctx));
         break;
       case PEP_REFINE_SCHEME_MBE:
-        PetscCall(NRefSysSolve_mbe(k,k,matctx->W,matctx->w,matctx->Wt,matctx->wt,matctx->d,matctx->dt,ksp,matctx->M2,matctx->M3 ,matctx->M4,PETSC_FALSE,R,Rh,Vi,dHi,matctx->t));
+        PetscCall(NRefSysSolve_mbe(k,k,matctx->W,matctx->w,matctx->Wt,matctx->wt,matctx->d,matctx->dt,ksp,matctx->M2,matctx->M3 ,matctx->M4,PETSC_FALSE,NULL,R,Rh,Vi,dHi,matctx->t));
         break;
       case PEP_REFINE_SCHEME_SCHUR:
         PetscCall(NRefSysSolve_shell(ksp,pep->nmat,R,Rh,k,Vi,dHi));
@@ -1113,6 +1146,8 @@ static PetscErrorCode PEPNRefSetUp(PEP pep,PetscInt k,PetscScalar *H,PetscInt ld
       PetscCall(BVDuplicateResize(matctx->V,k,&matctx->M2));
       PetscCall(BVDuplicate(matctx->M2,&matctx->M3));
       PetscCall(BVDuplicate(matctx->M2,&matctx->Wt));
+      PetscCall(BVDuplicate(matctx->M2,&matctx->Z));
+      PetscCall(BVDuplicate(matctx->M2,&matctx->Zt));
       PetscCall(PetscMalloc5(k*k,&matctx->M4,k*k,&matctx->w,k*k,&matctx->wt,k,&matctx->d,k,&matctx->dt));
       matctx->compM1 = PETSC_TRUE;
       M = matctx->M1;
@@ -1404,6 +1439,8 @@ PetscErrorCode PEPNewtonRefinement_TOAR(PEP pep,PetscScalar sigma,PetscInt *maxi
     PetscCall(BVDestroy(&matctx->Wt));
     PetscCall(BVDestroy(&matctx->M2));
     PetscCall(BVDestroy(&matctx->M3));
+    PetscCall(BVDestroy(&matctx->Z));
+    PetscCall(BVDestroy(&matctx->Zt));
     PetscCall(MatDestroy(&matctx->M1));
     PetscCall(VecDestroy(&matctx->t));
     PetscCall(PetscFree5(matctx->M4,matctx->w,matctx->wt,matctx->d,matctx->dt));
@@ -191,16 +191,21 @@ static PetscErrorCode PEPTOARCoefficients(PEP pep,PetscBool sinvert,PetscScalar
 
 /*
   Compute a run of Arnoldi iterations dim(work)=ld
+
+  The columns of S are accessed one at a time, so that when S is stored in device
+  memory only the column being computed is moved to the host, while the level-2
+  orthogonalization operates on the device copy of S
 */
 static PetscErrorCode PEPTOARrun(PEP pep,PetscScalar sigma,Mat A,PetscInt k,PetscInt *M,PetscReal *beta,PetscBool *breakdown,Vec *t_)
 {
   PEP_TOAR       *ctx = (PEP_TOAR*)pep->data;
   PetscInt       j,m=*M,deg=pep->nmat-1,ld;
   PetscInt       ldh,lds,nqt,l;
-  Vec            t;
+  Vec            t,v;
   PetscReal      norm=0.0;
   PetscBool      flg,sinvert=PETSC_FALSE,lindep;
-  PetscScalar    *H,*x,*S;
+  PetscScalar    *H,*x,*S,*Sj;
+  const PetscScalar *s;
   Mat            MS;
 
   PetscFunctionBegin;
@@ -208,7 +213,6 @@ static PetscErrorCode PEPTOARrun(PEP pep,PetscScalar sigma,Mat A,PetscInt k,Pets
   PetscCall(MatDenseGetArray(A,&H));
   PetscCall(MatDenseGetLDA(A,&ldh));
   PetscCall(BVTensorGetFactors(ctx->V,NULL,&MS));
-  PetscCall(MatDenseGetArray(MS,&S));
   PetscCall(BVGetSizes(pep->V,NULL,NULL,&ld));
   lds = ld*deg;
   PetscCall(BVGetActiveColumns(pep->V,&l,&nqt));
@@ -219,16 +223,25 @@ static PetscErrorCode PEPTOARrun(PEP pep,PetscScalar sigma,Mat A,PetscInt k,Pets
     PetscCheck(flg,PetscObjectComm((PetscObject)pep),PETSC_ERR_SUP,"ST type not supported for TOAR without transforming matrices");
     PetscCall(PetscObjectTypeCompare((PetscObject)pep->st,STSINVERT,&sinvert));
   }
+  PetscCall(PetscMalloc1(lds,&Sj));
+  PetscCall(MatDenseGetColumnVecRead(MS,k,&v));
+  PetscCall(VecGetArrayRead(v,&s));
+  PetscCall(PetscArraycpy(Sj,s,lds));
+  PetscCall(VecRestoreArrayRead(v,&s));
+  PetscCall(MatDenseRestoreColumnVecRead(MS,k,&v));
   PetscCall(BVSetActiveColumns(ctx->V,0,m));
   for (j=k;j<m;j++) {
+    PetscCall(MatDenseGetColumnVec(MS,j+1,&v));
+    PetscCall(VecGetArray(v,&S));
+
     /* apply operator */
     PetscCall(BVGetColumn(pep->V,nqt,&t));
-    PetscCall(PEPTOARExtendBasis(pep,sinvert,sigma,S+j*lds,ld,nqt,pep->V,t,S+(j+1)*lds,ld,t_));
+    PetscCall(PEPTOARExtendBasis(pep,sinvert,sigma,Sj,ld,nqt,pep->V,t,S,ld,t_));
     PetscCall(BVRestoreColumn(pep->V,nqt,&t));
 
     /* orthogonalize */
-    if (sinvert) x = S+(j+1)*lds;
-    else x = S+(deg-1)*ld+(j+1)*lds;
+    if (sinvert) x = S;
+    else x = S+(deg-1)*ld;
     PetscCall(BVOrthogonalizeColumn(pep->V,nqt,x,&norm,&lindep));
     if (!lindep) {
       x[nqt] = norm;
@@ -236,7 +249,9 @@ static PetscErrorCode PEPTOARrun(PEP pep,PetscScalar sigma,Mat A,PetscInt k,Pets
       nqt++;
     }
 
-    PetscCall(PEPTOARCoefficients(pep,sinvert,sigma,nqt-1,S+j*lds,ld,S+(j+1)*lds,ld,x));
+    PetscCall(PEPTOARCoefficients(pep,sinvert,sigma,nqt-1,Sj,ld,S,ld,x));
+    PetscCall(VecRestoreArray(v,&S));
+    PetscCall(MatDenseRestoreColumnVec(MS,j+1,&v));
 
     /* level-2 orthogonalization */
     PetscCall(BVOrthogonalizeColumn(ctx->V,j+1,H+j*ldh,&norm,breakdown));
@@ -247,10 +262,17 @@ static PetscErrorCode PEPTOARrun(PEP pep,PetscScalar sigma,Mat A,PetscInt k,Pets
     }
     PetscCall(BVScaleColumn(ctx->V,j+1,1.0/norm));
     PetscCall(BVSetActiveColumns(pep->V,l,nqt));
+    if (j<m-1) {  /* keep a host copy of the new column for the next step */
+      PetscCall(MatDenseGetColumnVecRead(MS,j+1,&v));
+      PetscCall(VecGetArrayRead(v,&s));
+      PetscCall(PetscArraycpy(Sj,s,lds));
+      PetscCall(VecRestoreArrayRead(v,&s));
+      PetscCall(MatDenseRestoreColumnVecRead(MS,j+1,&v));
+    }
   }
   *beta = norm;
   PetscCall(BVSetActiveColumns(ctx->V,0,*M));
-  PetscCall(MatDenseRestoreArray(MS,&S));
+  PetscCall(PetscFree(Sj));
   PetscCall(BVTensorRestoreFactors(ctx->V,NULL,&MS));
   PetscCall(MatDenseRestoreArray(A,&H));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -373,21 +395,22 @@ static PetscErrorCode PEPExtractInvariantPair(PEP pep,PetscScalar sigma,PetscInt
     PetscCall(BVSetActiveColumns(pep->V,0,sr));
     for (j=0;j<pep->nmat;j++) {
       PetscCall(BVMatMult(pep->V,A[j],Y));
-      PetscCall(PEPEvaluateBasisM(pep,k,T,ldt,i,&Hp,&Hj));
+      /* phi_j(T) is obtained from the two previous ones with one step of the recurrence */
+      PetscCall(PEPEvaluateBasisM(pep,k,T,ldt,j,&Hp,&Hj));
       for (i=0;i<pep->nmat-1;i++) {
         PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&sr_,&k_,&k_,&a,S+i*ld,&lds_,Hj,&k_,&g,At,&sr_));
         PetscCall(MatDenseGetArray(M,&pM));
         for (jj=0;jj<k;jj++) PetscCall(PetscArraycpy(pM+jj*sr,At+jj*sr,sr));
         PetscCall(MatDenseRestoreArray(M,&pM));
-        PetscCall(BVMult(R[i],1.0,(i==0)?0.0:1.0,Y,M));
+        PetscCall(BVMult(R[i],1.0,(j==0)?0.0:1.0,Y,M));
       }
     }
 
     /* frobenius norm */
-    maxnrm = 0.0;
+    maxnrm = PETSC_MAX_REAL;
     for (i=0;i<pep->nmat-1;i++) {
       PetscCall(BVNorm(R[i],NORM_FROBENIUS,&norm));
-      if (maxnrm > norm) {
+      if (norm < maxnrm) {
         maxnrm = norm;
         idxcpy = i;
       }
@@ -566,11 +589,11 @@ static PetscErrorCode PEPSolve_TOAR(PEP pep)
       PetscCall(DSSolve(pep->ds,pep->eigr,pep->eigi));
       PetscCall(DSSort(pep->ds,pep->eigr,pep->eigi,NULL,NULL,NULL));
       PetscCall(DSSynchronize(pep->ds,pep->eigr,pep->eigi));
+      PetscCall(MatDenseRestoreArray(MS,&S));
+      PetscCall(BVTensorRestoreFactors(ctx->V,NULL,&MS));
       PetscCall(DSGetMat(pep->ds,DS_MAT_Q,&MQ));
       PetscCall(BVMultInPlace(ctx->V,MQ,0,pep->nconv));
       PetscCall(DSRestoreMat(pep->ds,DS_MAT_Q,&MQ));
-      PetscCall(MatDenseRestoreArray(MS,&S));
-      PetscCall(BVTensorRestoreFactors(ctx->V,NULL,&MS));
     }
   }
   PetscCall(STGetTransform(pep->st,&flg));
@@ -21,7 +21,7 @@ static PetscErrorCode MatMult_Linear_Shift(Mat M,Vec x,Vec y)
   const PetscScalar *px;
   PetscScalar       *py,a,sigma=0.0;
   PetscInt          nmat,deg,i,m;
-  Vec               x1,x2,x3,y1,aux;
+  Vec               x1,x2,x3,y1,aux,aux2;
   PetscReal         *ca,*cb,*cg;
   PetscBool         flg;
 
@@ -36,7 +36,7 @@ static PetscErrorCode MatMult_Linear_Shift(Mat M,Vec x,Vec y)
   ca = pep->pbc;
   cb = pep->pbc+nmat;
   cg = pep->pbc+2*nmat;
-  x1=ctx->w[0];x2=ctx->w[1];x3=ctx->w[2];y1=ctx->w[3];aux=ctx->w[4];
+  x1=ctx->w[0];x2=ctx->w[1];x3=ctx->w[2];y1=ctx->w[3];aux=ctx->w[4];aux2=ctx->w[5];
 
   PetscCall(VecSet(y,0.0));
   PetscCall(VecGetArrayRead(x,&px));
@@ -68,17 +68,19 @@ static PetscErrorCode MatMult_Linear_Shift(Mat M,Vec x,Vec y)
     PetscCall(VecResetArray(y1));
   }
 
-  /* last block */
+  /* last block, the right-hand side is accumulated in aux2 to avoid a copy before the solve */
   PetscCall(VecPlaceArray(y1,py+(deg-1)*m));
   for (i=0;i<deg;i++) {
     PetscCall(VecPlaceArray(x1,px+i*m));
-    PetscCall(STMatMult(pep->st,i,x1,aux));
-    PetscCall(VecAXPY(y1,a,aux));
+    if (!i) PetscCall(STMatMult(pep->st,0,x1,aux2));
+    else {
+      PetscCall(STMatMult(pep->st,i,x1,aux));
+      PetscCall(VecAXPY(aux2,a,aux));
+    }
     PetscCall(VecResetArray(x1));
     a *= pep->sfactor;
   }
-  PetscCall(VecCopy(y1,aux));
-  PetscCall(STMatSolve(pep->st,aux,y1));
+  PetscCall(STMatSolve(pep->st,aux2,y1));
   PetscCall(VecScale(y1,-ca[deg-1]/a));
   PetscCall(VecPlaceArray(x1,px+(deg-2)*m));
   PetscCall(VecPlaceArray(x2,px+(deg-1)*m));
@@ -114,7 +116,6 @@ static PetscErrorCode MatMult_Linear_Sinvert(Mat M,Vec x,Vec y)
   cg = pep->pbc+2*nmat;
   x1=ctx->w[0];y1=ctx->w[1];y2=ctx->w[2];y3=ctx->w[3];aux=ctx->w[4];aux2=ctx->w[5];
   PetscCall(EPSGetTarget(ctx->eps,&sigma));
-  PetscCall(VecSet(y,0.0));
   PetscCall(VecGetArrayRead(x,&px));
   PetscCall(VecGetArray(y,&py));
   a = pep->sfactor;
@@ -132,8 +133,7 @@ static PetscErrorCode MatMult_Linear_Sinvert(Mat M,Vec x,Vec y)
     PetscCall(VecPlaceArray(x1,px+m));
     PetscCall(VecPlaceArray(y1,py+m));
     PetscCall(VecPlaceArray(y2,py+2*m));
-    PetscCall(VecCopy(x1,y2));
-    PetscCall(VecAXPY(y2,sigma-cb[1],y1));
+    PetscCall(VecWAXPY(y2,sigma-cb[1],y1,x1));
     PetscCall(VecScale(y2,1.0/ca[1]));
     PetscCall(VecResetArray(x1));
     PetscCall(VecResetArray(y1));
@@ -146,8 +146,7 @@ static PetscErrorCode MatMult_Linear_Sinvert(Mat M,Vec x,Vec y)
     PetscCall(VecPlaceArray(y1,py+(i-1)*m));
     PetscCall(VecPlaceArray(y2,py+i*m));
     PetscCall(VecPlaceArray(y3,py+(i+1)*m));
-    PetscCall(VecCopy(x1,y3));
-    PetscCall(VecAXPY(y3,sigma-cb[i],y2));
+    PetscCall(VecWAXPY(y3,sigma-cb[i],y2,x1));
     PetscCall(VecAXPY(y3,-cg[i],y1));
     PetscCall(VecScale(y3,1.0/ca[i]));
     PetscCall(VecResetArray(x1));
@@ -156,30 +155,38 @@ static PetscErrorCode MatMult_Linear_Sinvert(Mat M,Vec x,Vec y)
     PetscCall(VecResetArray(y3));
   }
 
-  /* last block */
+  /* last block, all other blocks have been set, so y is not zeroed beforehand */
   PetscCall(VecPlaceArray(y1,py));
   for (i=0;i<deg-2;i++) {
     PetscCall(VecPlaceArray(y2,py+(i+1)*m));
-    PetscCall(STMatMult(pep->st,i+1,y2,aux));
-    PetscCall(VecAXPY(y1,a,aux));
+    if (!i) {
+      PetscCall(STMatMult(pep->st,1,y2,y1));
+      PetscCall(VecScale(y1,a));
+    } else {
+      PetscCall(STMatMult(pep->st,i+1,y2,aux));
+      PetscCall(VecAXPY(y1,a,aux));
+    }
     PetscCall(VecResetArray(y2));
     a *= pep->sfactor;
   }
   i = deg-2;
   PetscCall(VecPlaceArray(y2,py+(i+1)*m));
-  PetscCall(VecPlaceArray(y3,py+i*m));
-  PetscCall(VecCopy(y2,aux2));
-  PetscCall(VecAXPY(aux2,cg[i+1]/ca[i+1],y3));
-  PetscCall(STMatMult(pep->st,i+1,aux2,aux));
-  PetscCall(VecAXPY(y1,a,aux));
+  if (i) {
+    PetscCall(VecPlaceArray(y3,py+i*m));
+    PetscCall(VecWAXPY(aux2,cg[i+1]/ca[i+1],y3,y2));
+    PetscCall(VecResetArray(y3));
+    PetscCall(STMatMult(pep->st,i+1,aux2,aux));
+    PetscCall(VecAXPY(y1,a,aux));
+  } else {  /* quadratic case, y1 has not been set yet */
+    PetscCall(STMatMult(pep->st,1,y2,y1));
+    PetscCall(VecScale(y1,a));
+  }
   PetscCall(VecResetArray(y2));
-  PetscCall(VecResetArray(y3));
   a *= pep->sfactor;
   i = deg-1;
   PetscCall(VecPlaceArray(x1,px+i*m));
   PetscCall(VecPlaceArray(y3,py+i*m));
-  PetscCall(VecCopy(x1,aux2));
-  PetscCall(VecAXPY(aux2,sigma-cb[i],y3));
+  PetscCall(VecWAXPY(aux2,sigma-cb[i],y3,x1));
   PetscCall(VecScale(aux2,1.0/ca[i]));
   PetscCall(STMatMult(pep->st,i+1,aux2,aux));
   PetscCall(VecAXPY(y1,a,aux));
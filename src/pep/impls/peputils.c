@@ -38,14 +38,14 @@ PetscErrorCode PEPEvaluateBasisMat(PEP pep,PetscInt k,PetscScalar *T,PetscInt ld
     PetscCall(PetscBLASIntCast(ldtp,&ldtp_));
     PetscCall(PetscBLASIntCast(k,&k_));
     ca = pep->pbc; cb = pep->pbc+pep->nmat; cg = pep->pbc+2*pep->nmat;
-    for (i=0;i<k;i++) T[i*ldt+i] -= cb[idx-1];
-    if (idx>1) {
-      for (i=0;i<k;i++) PetscCall(PetscArraycpy(Tj+i*ldtj,Tpp+i*ldtpp,k));
-    }
+    if (cb[idx-1]!=0.0) for (i=0;i<k;i++) T[i*ldt+i] -= cb[idx-1];
     a = 1/ca[idx-1];
     g = (idx==1)?0.0:-cg[idx-1]/ca[idx-1];
+    if (g!=0.0) {  /* the term in phi_(j-2) vanishes e.g. in the monomial basis */
+      for (i=0;i<k;i++) PetscCall(PetscArraycpy(Tj+i*ldtj,Tpp+i*ldtpp,k));
+    }
     PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&k_,&k_,&k_,&a,T,&ldt_,Tp,&ldtp_,&g,Tj,&ldtj_));
-    for (i=0;i<k;i++) T[i*ldt+i] += cb[idx-1];
+    if (cb[idx-1]!=0.0) for (i=0;i<k;i++) T[i*ldt+i] += cb[idx-1];
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -77,33 +77,50 @@ PetscErrorCode PEPEvaluateBasis(PEP pep,PetscScalar sigma,PetscScalar isigma,Pet
 
 /*
    PEPEvaluateBasisDerivative - evaluate the derivative of the polynomial basis on a given parameter sigma
+
+   The recurrences of the basis and of its derivative are run together in a single pass,
+   keeping only the last two values of the basis
 */
 PetscErrorCode PEPEvaluateBasisDerivative(PEP pep,PetscScalar sigma,PetscScalar isigma,PetscScalar *vals,PetscScalar *ivals)
 {
   PetscInt       nmat=pep->nmat,k;
   PetscReal      *a=pep->pbc,*b=pep->pbc+nmat,*g=pep->pbc+2*nmat;
+  PetscScalar    p0=1.0,p1,p2;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscScalar    ip0=0.0,ip1=0.0,ip2;
+#endif
 
   PetscFunctionBegin;
-  PetscCall(PEPEvaluateBasis(pep,sigma,isigma,vals,ivals));
-  for (k=nmat-1;k>0;k--) {
-    vals[k] = vals[k-1];
-    if (ivals) ivals[k] = ivals[k-1];
-  }
+  if (ivals) for (k=0;k<nmat;k++) ivals[k] = 0.0;
   vals[0] = 0.0;
-  vals[1] = vals[1]/a[0];
+  vals[1] = 1.0/a[0];
+  p1 = (sigma-b[0])/a[0];
 #if !defined(PETSC_USE_COMPLEX)
-  if (ivals) ivals[1] = ivals[1]/a[0];
+  if (ivals) ip1 = isigma/a[0];
 #endif
   for (k=2;k<nmat;k++) {
-    vals[k] += (sigma-b[k-1])*vals[k-1]-g[k-1]*vals[k-2];
+    /* derivative of the k-th basis polynomial */
+    vals[k] = p1+((sigma-b[k-1])*vals[k-1]-g[k-1]*vals[k-2]);
+#if !defined(PETSC_USE_COMPLEX)
     if (ivals) vals[k] -= isigma*ivals[k-1];
+#endif
     vals[k] /= a[k-1];
 #if !defined(PETSC_USE_COMPLEX)
     if (ivals) {
-      ivals[k] += (sigma-b[k-1])*ivals[k-1]+isigma*vals[k-1]-g[k-1]*ivals[k-2];
+      ivals[k] = ip1+((sigma-b[k-1])*ivals[k-1]+isigma*vals[k-1]-g[k-1]*ivals[k-2]);
       ivals[k] /= a[k-1];
     }
 #endif
+    /* k-th basis polynomial */
+    p2 = ((sigma-b[k-1])*p1-g[k-1]*p0)/a[k-1];
+#if !defined(PETSC_USE_COMPLEX)
+    if (ivals) {
+      p2 -= isigma*ip1/a[k-1];
+      ip2 = ((sigma-b[k-1])*ip1+isigma*p1-g[k-1]*ip0)/a[k-1];
+      ip0 = ip1; ip1 = ip2;
+    }
+#endif
+    p0 = p1; p1 = p2;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
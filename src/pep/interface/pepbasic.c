@@ -117,6 +117,7 @@ PetscErrorCode PEPCreate(MPI_Comm comm,PEP *outpep)
   pep->nloc            = 0;
   pep->nrma            = NULL;
   pep->sfactor_set     = PETSC_FALSE;
+  pep->sdiag_set       = PETSC_FALSE;
   pep->lineariz        = PETSC_FALSE;
   pep->reason          = PEP_CONVERGED_ITERATING;
 
@@ -308,6 +309,7 @@ PetscErrorCode PEPReset(PEP pep)
   }
   PetscCall(VecDestroy(&pep->Dl));
   PetscCall(VecDestroy(&pep->Dr));
+  pep->sdiag_set = PETSC_FALSE;
   PetscCall(BVDestroy(&pep->V));
   PetscCall(VecDestroyVecs(pep->nwork,&pep->work));
   pep->nwork = 0;
@@ -1004,6 +1004,15 @@ PetscErrorCode PEPGetStoppingTest(PEP pep,PEPStop *stop)
    matrices represented as Vec objects storing diagonal elements. If not
    provided, these matrices are computed internally. This option requires
    that the polynomial coefficient matrices are of MATAIJ type.
+   The scaling is applied implicitly in the operations of the solver, so no
+   scaled copies of the coefficient matrices are formed.
+
+   The balancing iteration is run in every PEPSetUp() unless Dl or Dr have been
+   provided by the user, in which case these are used as they are (a missing one
+   is taken as the identity). In a sequence of solves where the coefficient
+   matrices change only slightly, the cost of the balancing can be saved by
+   passing to PEPSetScale() the vectors obtained with PEPGetScale() after the
+   first solve. The user-provided vectors are discarded in PEPReset().
    The parameter 'its' is the number of iterations performed by the method.
    Parameter 'lambda' must be positive. Use PETSC_DETERMINE or set lambda = 1.0
    if no information about eigenvalues is available. PETSC_CURRENT can also
@@ -1037,6 +1046,7 @@ PetscErrorCode PEPSetScale(PEP pep,PEPScale scale,PetscReal alpha,Vec Dl,Vec Dr,
       PetscCall(PetscObjectReference((PetscObject)Dl));
       PetscCall(VecDestroy(&pep->Dl));
       pep->Dl = Dl;
+      pep->sdiag_set = PETSC_TRUE;
     }
     if (Dr) {
       PetscValidHeaderSpecific(Dr,VEC_CLASSID,5);
@@ -1044,6 +1054,7 @@ PetscErrorCode PEPSetScale(PEP pep,PEPScale scale,PetscReal alpha,Vec Dl,Vec Dr,
       PetscCall(PetscObjectReference((PetscObject)Dr));
       PetscCall(VecDestroy(&pep->Dr));
       pep->Dr = Dr;
+      pep->sdiag_set = PETSC_TRUE;
     }
     PetscValidLogicalCollectiveInt(pep,its,6);
     PetscValidLogicalCollectiveReal(pep,lambda,7);
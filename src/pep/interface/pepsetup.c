@@ -238,9 +238,15 @@ PetscErrorCode PEPSetUp(PEP pep)
 
   /* build balancing matrix if required */
   if (pep->scale==PEP_SCALE_DIAGONAL || pep->scale==PEP_SCALE_BOTH) {
-    if (!pep->Dl) PetscCall(BVCreateVec(pep->V,&pep->Dl));
-    if (!pep->Dr) PetscCall(BVCreateVec(pep->V,&pep->Dr));
-    PetscCall(PEPBuildDiagonalScaling(pep));
+    if (!pep->Dl) {
+      PetscCall(BVCreateVec(pep->V,&pep->Dl));
+      if (pep->sdiag_set) PetscCall(VecSet(pep->Dl,1.0));
+    }
+    if (!pep->Dr) {
+      PetscCall(BVCreateVec(pep->V,&pep->Dr));
+      if (pep->sdiag_set) PetscCall(VecSet(pep->Dr,1.0));
+    }
+    if (!pep->sdiag_set) PetscCall(PEPBuildDiagonalScaling(pep));  /* otherwise reuse the vectors given by the user */
   }
 
   /* process initial vectors */
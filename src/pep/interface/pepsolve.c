@@ -19,6 +19,7 @@
 
 #include <slepc/private/pepimpl.h>       /*I "slepcpep.h" I*/
 #include <slepc/private/bvimpl.h>
+#include <slepc/private/stimpl.h>
 #include <petscdraw.h>
 
 static PetscBool  cited = PETSC_FALSE;
@@ -375,21 +376,21 @@ PetscErrorCode PEPGetErrorEstimate(PEP pep,PetscInt i,PetscReal *errest)
 PetscErrorCode PEPComputeResidualNorm_Private(PEP pep,PetscScalar kr,PetscScalar ki,Vec xr,Vec xi,Vec *z,PetscReal *norm)
 {
   Mat            *A=pep->A;
-  PetscInt       i,nmat=pep->nmat;
+  PetscInt       nmat=pep->nmat;
   PetscScalar    t[20],*vals=t,*ivals=NULL;
-  Vec            u,w;
+  Vec            u;
 #if !defined(PETSC_USE_COMPLEX)
-  Vec            ui,wi;
+  PetscInt       i;
+  Vec            w,ui,wi;
   PetscReal      ni;
   PetscBool      imag;
   PetscScalar    it[20];
 #endif
 
   PetscFunctionBegin;
-  u = z[0]; w = z[1];
-  PetscCall(VecSet(u,0.0));
+  u = z[0];
 #if !defined(PETSC_USE_COMPLEX)
-  ui = z[2]; wi = z[3];
+  w = z[1]; ui = z[2]; wi = z[3];
   ivals = it;
 #endif
   if (nmat>20) {
@@ -404,28 +405,31 @@ PetscErrorCode PEPComputeResidualNorm_Private(PEP pep,PetscScalar kr,PetscScalar
     imag = PETSC_FALSE;
   else {
     imag = PETSC_TRUE;
+    PetscCall(VecSet(u,0.0));
     PetscCall(VecSet(ui,0.0));
   }
 #endif
-  for (i=0;i<nmat;i++) {
-    if (vals[i]!=0.0) {
-      PetscCall(MatMult(A[i],xr,w));
-      PetscCall(VecAXPY(u,vals[i],w));
-    }
 #if !defined(PETSC_USE_COMPLEX)
-    if (imag) {
+  if (!imag) {
+#endif
+    /* u = sum_i vals[i]*A[i]*xr, fused in a single pass if the matrices share the pattern */
+    PetscCall(STMatMultCombination_Private(pep->st,nmat,A,vals,xr,u));
+#if !defined(PETSC_USE_COMPLEX)
+  } else {
+    for (i=0;i<nmat;i++) {
       if (ivals[i]!=0 || vals[i]!=0) {
         PetscCall(MatMult(A[i],xi,wi));
-        if (vals[i]==0) PetscCall(MatMult(A[i],xr,w));
+        PetscCall(MatMult(A[i],xr,w));
       }
+      if (vals[i]!=0) PetscCall(VecAXPY(u,vals[i],w));
       if (ivals[i]!=0) {
         PetscCall(VecAXPY(u,-ivals[i],wi));
         PetscCall(VecAXPY(ui,ivals[i],w));
       }
       if (vals[i]!=0) PetscCall(VecAXPY(ui,vals[i],wi));
     }
-#endif
   }
+#endif
   PetscCall(VecNorm(u,NORM_2,norm));
 #if !defined(PETSC_USE_COMPLEX)
   if (imag) {
@@ -797,3 +797,66 @@ PetscErrorCode PEPVectorsViewFromOptions(PEP pep)
   incall = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+   PEPSaveSolution - Saves the computed eigenvalues, error estimates and eigenvectors
+   in a single file, that can be loaded with SlepcLoadSolution().
+
+   Collective
+
+   Input Parameters:
++  pep      - the eigensolver context
+-  filename - name of the file
+
+   Notes:
+   The eigenvectors are stored as the columns of a BV, in the order of
+   PEPGetEigenpair(). If PETSc was configured with real scalars, a complex
+   conjugate pair of eigenvectors occupies two consecutive columns, with the
+   real and imaginary parts of the eigenvector associated with the eigenvalue
+   with positive imaginary part. When loading the file with SlepcLoadSolution(),
+   the storage of the eigenvectors is mapped to the file, see BVMmapSetFile().
+
+   Level: intermediate
+
+.seealso: SlepcLoadSolution(), PEPVectorsView()
+@*/
+PetscErrorCode PEPSaveSolution(PEP pep,const char filename[])
+{
+  PetscInt       i,k;
+  PetscScalar    *eigr,*eigi;
+  PetscReal      *errest;
+  Vec            xr,xi;
+  BV             X;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pep,PEP_CLASSID,1);
+  PetscAssertPointer(filename,2);
+  PEPCheckSolved(pep,1);
+  PetscCall(PetscMalloc3(pep->nconv,&eigr,pep->nconv,&eigi,pep->nconv,&errest));
+  for (i=0;i<pep->nconv;i++) {
+    PetscCall(PEPGetEigenpair(pep,i,&eigr[i],&eigi[i],NULL,NULL));
+    PetscCall(PEPGetErrorEstimate(pep,i,&errest[i]));
+  }
+  PetscCall(PEPComputeVectors(pep));
+  PetscCall(BVDuplicateResize(pep->V,PetscMax(pep->nconv,1),&X));
+  PetscCall(BVSetMatrix(X,NULL,PETSC_FALSE));
+  for (i=0;i<pep->nconv;i++) {
+    k  = pep->perm[i];
+    xi = NULL;
+    PetscCall(BVGetColumn(X,i,&xr));
+#if !defined(PETSC_USE_COMPLEX)
+    if (pep->eigi[k]>0.0) PetscCall(BVGetColumn(X,i+1,&xi));
+#endif
+    PetscCall(BV_GetEigenvector(pep->V,k,pep->eigi[k],xr,xi));
+    PetscCall(BVRestoreColumn(X,i,&xr));
+    if (xi) {
+      PetscCall(BVRestoreColumn(X,i+1,&xi));
+      i++;
+    }
+  }
+  PetscCall(BVSetActiveColumns(X,0,pep->nconv));
+  PetscCall(SlepcSolutionSave_Private((PetscObject)pep,filename,pep->nconv,eigr,eigi,errest,1,&X));
+  PetscCall(BVDestroy(&X));
+  PetscCall(PetscFree3(eigr,eigi,errest));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
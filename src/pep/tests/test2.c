@@ -26,7 +26,8 @@ static char help[] = "Test the solution of a PEP from a finite element model of
   "  -mu <value> ... mass (default 1).\n"
   "  -tau <value> ... damping constant of the dampers (default 10).\n"
   "  -kappa <value> ... damping constant of the springs (default 5).\n"
-  "  -initv ... set an initial vector.\n\n";
+  "  -initv ... set an initial vector.\n"
+  "  -samepattern ... store explicit zeros in M so that all matrices have the same pattern.\n\n";
 
 #include <slepcpep.h>
 
@@ -74,7 +75,7 @@ int main(int argc,char **argv)
   PEP            pep;             /* polynomial eigenproblem solver context */
   PetscInt       n=30,Istart,Iend,i,nev;
   PetscReal      mu=1.0,tau=10.0,kappa=5.0;
-  PetscBool      initv=PETSC_FALSE,skipnorm=PETSC_FALSE;
+  PetscBool      initv=PETSC_FALSE,skipnorm=PETSC_FALSE,samepattern=PETSC_FALSE;
   Vec            IV[2];
 
   PetscFunctionBeginUser;
@@ -86,6 +87,7 @@ int main(int argc,char **argv)
   PetscCall(PetscOptionsGetReal(NULL,NULL,"-kappa",&kappa,NULL));
   PetscCall(PetscOptionsGetBool(NULL,NULL,"-initv",&initv,NULL));
   PetscCall(PetscOptionsGetBool(NULL,NULL,"-skipnorm",&skipnorm,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-samepattern",&samepattern,NULL));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
      Compute the matrices that define the eigensystem, (k^2*M+k*C+K)x=0
@@ -126,7 +128,11 @@ int main(int argc,char **argv)
   PetscCall(MatSetSizes(M,PETSC_DECIDE,PETSC_DECIDE,n,n));
   PetscCall(MatSetFromOptions(M));
   PetscCall(MatGetOwnershipRange(M,&Istart,&Iend));
-  for (i=Istart;i<Iend;i++) PetscCall(MatSetValue(M,i,i,mu,INSERT_VALUES));
+  for (i=Istart;i<Iend;i++) {
+    if (samepattern && i>0) PetscCall(MatSetValue(M,i,i-1,0.0,INSERT_VALUES));
+    PetscCall(MatSetValue(M,i,i,mu,INSERT_VALUES));
+    if (samepattern && i<n-1) PetscCall(MatSetValue(M,i,i+1,0.0,INSERT_VALUES));
+  }
   PetscCall(MatAssemblyBegin(M,MAT_FINAL_ASSEMBLY));
   PetscCall(MatAssemblyEnd(M,MAT_FINAL_ASSEMBLY));
 
@@ -196,6 +202,10 @@ int main(int argc,char **argv)
       test:
          suffix: 1_linear_gd
          args: -pep_type linear -pep_linear_eps_type gd -pep_linear_explicitmatrix
+      test:
+         suffix: 1_samepattern
+         nsize: {{1 2}}
+         args: -pep_type toar -samepattern -st_matstructure same -st_pc_type jacobi
 
    testset:
       args: -pep_target -0.43 -pep_nev 4 -pep_ncv 20 -st_type sinvert
@@ -221,10 +231,17 @@ int main(int argc,char **argv)
       test:
          suffix: 2_stoar
          args: -pep_type stoar -pep_hermitian
+      test:
+         suffix: 2_stoar_samepattern
+         args: -pep_type stoar -pep_hermitian -samepattern -st_matstructure same
       test:
          suffix: 2_jd
          args: -pep_type jd -st_type precond -pep_max_it 200 -pep_ncv 24
          requires: !single
+      test:
+         suffix: 2_jd_block
+         args: -pep_type jd -st_type precond -pep_max_it 200 -pep_ncv 24 -pep_jd_blocksize 2
+         requires: !single
 
    test:
       suffix: 3
@@ -346,10 +363,15 @@ int main(int argc,char **argv)
       requires: x !single
       output_file: output/test2_3.out
 
-   test:
-      suffix: 14
+   testset:
       requires: complex double
       args: -pep_type ciss -rg_type ellipse -rg_ellipse_center -48.5 -rg_ellipse_radius 1.5 -pep_ciss_delta 1e-10
+      output_file: output/test2_14.out
+      test:
+         suffix: 14
+      test:
+         suffix: 14_hermitian
+         args: -pep_hermitian
 
    testset:
       args: -pep_nev 4 -initv -mat_type aijhipsparse
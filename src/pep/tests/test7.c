@@ -167,8 +167,15 @@ int main(int argc,char **argv)
 
 /*TEST
 
-   test:
+   testset:
       requires: !single
       args: -showinertia 0
+      output_file: output/test7_1.out
+      test:
+         suffix: 1
+      test:
+         suffix: 1_partitions
+         nsize: 2
+         args: -pep_stoar_partitions 2
 
 TEST*/
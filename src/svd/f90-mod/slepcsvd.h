@@ -51,6 +51,9 @@
       PetscEnum, parameter :: SVD_PRIMME_NORMALEQUATIONS =  2
       PetscEnum, parameter :: SVD_PRIMME_AUGMENTED       =  3
 
+      PetscEnum, parameter :: SVD_RANDOMIZED_SKETCH_GAUSSIAN    =  0
+      PetscEnum, parameter :: SVD_RANDOMIZED_SKETCH_SPARSE_SIGN =  1
+
 !
 !   Possible arguments to SVDMonitorSet()
 !
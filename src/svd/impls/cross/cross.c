@@ -421,6 +421,14 @@ static PetscErrorCode SVDCrossSetExplicitMatrix_Cross(SVD svd,PetscBool explicit
    Options Database Key:
 .  -svd_cross_explicitmatrix <boolean> - Indicates the boolean flag
 
+   Notes:
+   The explicit matrix is computed with MatProductCreate(), so that if A is a
+   GPU matrix such as MATAIJCUSPARSE or MATAIJHIPSPARSE the product is formed
+   on the device with the sparse matrix-matrix product of the vendor library.
+   Otherwise, the operator is a shell matrix whose work vector has the same type
+   as the vectors of A, and the matrix-vector products with A and A^T are done
+   one after the other on the device without copies to the host.
+
    Level: advanced
 
 .seealso: SVDCrossGetExplicitMatrix()
@@ -514,7 +514,8 @@ static PetscErrorCode SVDSetUp_Cyclic(SVD svd)
   PetscCall(EPSGetTolerances(cyclic->eps,NULL,&svd->max_it));
   if (svd->tol==(PetscReal)PETSC_DETERMINE) svd->tol = SLEPC_DEFAULT_TOL;
 
-  svd->leftbasis = PETSC_TRUE;
+  /* the left basis is filled only when computing the vectors */
+  svd->leftbasis = PetscNot(svd->valuesonly && !svd->isgeneralized);
   PetscCall(SVDAllocateSolution(svd,0));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
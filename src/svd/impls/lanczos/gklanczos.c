@@ -55,13 +55,96 @@ static PetscErrorCode SVDSetUp_Lanczos(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   One step of the two-sided bidiagonalization that computes v_i and u_i with a
+   single global reduction. The vector z = A'*u_{i-1}-alpha_{i-1}*v_{i-1} is stored
+   in V(:,i) and y = A*z in U(:,i), and all inner products (V'*z, z'*z, U'*y, y'*y)
+   are computed at once. Since z = b*v_i+V*h and A*V is in the span of U, the
+   projection of y onto the orthogonal complement of U is a*b*u_i, so u_i is
+   obtained without a second reduction. The local subtraction of alpha_{i-1}*v_{i-1}
+   keeps h small, so that computing u_i from y does not amplify rounding errors.
+   A second orthogonalization is done only if the norm estimates require it
+*/
+static PetscErrorCode SVDTwoSideLanczosStepCombined(SVD svd,PetscReal *alpha,PetscReal *beta,PetscInt i,PetscScalar *hv,PetscScalar *hu,PetscBool *lindep)
+{
+  PetscReal          nz,ny,sv,su,a,b,eta;
+  PetscInt           j;
+  Vec                u,v,v1;
+  BVOrthogRefineType refine;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetOrthogonalization(svd->V,NULL,&refine,&eta,NULL));
+  PetscCall(BVGetColumn(svd->V,i,&v));
+  PetscCall(BVGetColumn(svd->U,i-1,&u));
+  PetscCall(MatMult(svd->AT,u,v));
+  PetscCall(BVRestoreColumn(svd->U,i-1,&u));
+  PetscCall(BVGetColumn(svd->V,i-1,&v1));
+  PetscCall(VecAXPY(v,-alpha[i-1],v1));
+  PetscCall(BVRestoreColumn(svd->V,i-1,&v1));
+  PetscCall(BVGetColumn(svd->U,i,&u));
+  PetscCall(MatMult(svd->A,v,u));
+  PetscCall(BVRestoreColumn(svd->U,i,&u));
+  PetscCall(BVRestoreColumn(svd->V,i,&v));
+
+  /* single reduction for all inner products */
+  PetscCall(BVSetActiveColumns(svd->V,0,i));
+  PetscCall(BVSetActiveColumns(svd->U,0,i));
+  PetscCall(BVDotColumnBegin(svd->V,i,hv));
+  PetscCall(BVNormColumnBegin(svd->V,i,NORM_2,&nz));
+  PetscCall(BVDotColumnBegin(svd->U,i,hu));
+  PetscCall(BVNormColumnBegin(svd->U,i,NORM_2,&ny));
+  PetscCall(BVDotColumnEnd(svd->V,i,hv));
+  PetscCall(BVNormColumnEnd(svd->V,i,NORM_2,&nz));
+  PetscCall(BVDotColumnEnd(svd->U,i,hu));
+  PetscCall(BVNormColumnEnd(svd->U,i,NORM_2,&ny));
+
+  /* v_i = (z-V*hv)/b */
+  sv = 0.0;
+  su = 0.0;
+  for (j=0;j<i;j++) {
+    sv += PetscRealPart(hv[j]*PetscConj(hv[j]));
+    su += PetscRealPart(hu[j]*PetscConj(hu[j]));
+  }
+  PetscCall(BVMultColumn(svd->V,-1.0,1.0,i,hv));
+  b = nz*nz-sv;
+  if (refine==BV_ORTHOG_REFINE_ALWAYS || b<=0.0 || (refine==BV_ORTHOG_REFINE_IFNEEDED && PetscSqrtReal(b)<eta*nz)) PetscCall(BVOrthonormalizeColumn(svd->V,i,PETSC_FALSE,&b,lindep));
+  else {
+    b = PetscSqrtReal(b);
+    *lindep = (b<PETSC_MACHINE_EPSILON*nz)? PETSC_TRUE: PETSC_FALSE;
+    if (!*lindep) PetscCall(BVScaleColumn(svd->V,i,1.0/b));
+  }
+  beta[i-1] = b;
+  if (PetscUnlikely(*lindep)) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* u_i = (y-U*hu)/(a*b) */
+  PetscCall(BVMultColumn(svd->U,-1.0,1.0,i,hu));
+  a = ny*ny-su;
+  if (refine==BV_ORTHOG_REFINE_ALWAYS || a<=0.0 || (refine==BV_ORTHOG_REFINE_IFNEEDED && PetscSqrtReal(a)<eta*ny)) PetscCall(BVOrthonormalizeColumn(svd->U,i,PETSC_FALSE,&a,lindep));
+  else {
+    a = PetscSqrtReal(a);
+    *lindep = (a<PETSC_MACHINE_EPSILON*ny)? PETSC_TRUE: PETSC_FALSE;
+    if (!*lindep) PetscCall(BVScaleColumn(svd->U,i,1.0/a));
+  }
+  alpha[i] = a/b;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Two-sided Golub-Kahan-Lanczos bidiagonalization with full reorthogonalization,
+   from column k up to n. If the orthogonalization type of V is BV_ORTHOG_CGS_PIPELINED,
+   the orthogonalizations of each pair v_i, u_i are done with a single reduction
+*/
 PetscErrorCode SVDTwoSideLanczos(SVD svd,PetscReal *alpha,PetscReal *beta,BV V,BV U,PetscInt k,PetscInt *n,PetscBool *breakdown)
 {
   PetscInt       i;
   Vec            u,v;
-  PetscBool      lindep=PETSC_FALSE;
+  PetscBool      lindep=PETSC_FALSE,combined;
+  PetscScalar    *hv=NULL,*hu=NULL;
+  BVOrthogType   orthog;
 
   PetscFunctionBegin;
+  PetscCall(BVGetOrthogonalization(svd->V,&orthog,NULL,NULL,NULL));
+  combined = (orthog==BV_ORTHOG_CGS_PIPELINED)? PETSC_TRUE: PETSC_FALSE;
   PetscCall(BVGetColumn(svd->V,k,&v));
   PetscCall(BVGetColumn(svd->U,k,&u));
   PetscCall(MatMult(svd->A,v,u));
@@ -74,7 +157,16 @@ PetscErrorCode SVDTwoSideLanczos(SVD svd,PetscReal *alpha,PetscReal *beta,BV V,B
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  if (combined) PetscCall(PetscMalloc2(*n,&hv,*n,&hu));
   for (i=k+1;i<*n;i++) {
+    if (combined) {
+      PetscCall(SVDTwoSideLanczosStepCombined(svd,alpha,beta,i,hv,hu,&lindep));
+      if (PetscUnlikely(lindep)) {
+        *n = i;
+        break;
+      }
+      continue;
+    }
     PetscCall(BVGetColumn(svd->V,i,&v));
     PetscCall(BVGetColumn(svd->U,i-1,&u));
     PetscCall(MatMult(svd->AT,u,v));
@@ -96,6 +188,7 @@ PetscErrorCode SVDTwoSideLanczos(SVD svd,PetscReal *alpha,PetscReal *beta,BV V,B
       break;
     }
   }
+  if (combined) PetscCall(PetscFree2(hv,hu));
 
   if (!lindep) {
     PetscCall(BVGetColumn(svd->V,*n,&v));
@@ -355,6 +448,10 @@ static PetscErrorCode SVDLanczosSetOneSide_Lanczos(SVD svd,PetscBool oneside)
    the orthogonalization associated to left singular vectors. It also saves
    the memory required for storing such vectors.
 
+   In the two-sided variant, if the orthogonalization type of the BV is
+   BV_ORTHOG_CGS_PIPELINED, the orthogonalizations of the left and right
+   vectors of each step are done with a single global reduction.
+
    Level: advanced
 
 .seealso: SVDTRLanczosSetOneSide()
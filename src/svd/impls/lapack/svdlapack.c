@@ -16,10 +16,11 @@
 
 static PetscErrorCode SVDSetUp_LAPACK(SVD svd)
 {
-  PetscInt       M,N,P=0;
+  PetscInt       M,N,P=0,M0,N0;
 
   PetscFunctionBegin;
   PetscCall(MatGetSize(svd->A,&M,&N));
+  PetscCall(MatGetSize(svd->OP,&M0,&N0));
   if (!svd->isgeneralized) svd->ncv = N;
   else {
     PetscCall(MatGetSize(svd->OPb,&P,NULL));
@@ -28,18 +29,23 @@ static PetscErrorCode SVDSetUp_LAPACK(SVD svd)
   if (svd->mpd!=PETSC_DETERMINE) PetscCall(PetscInfo(svd,"Warning: parameter mpd ignored\n"));
   SVDCheckUnsupported(svd,SVD_FEATURE_STOPPING);
   if (svd->max_it==PETSC_DETERMINE) svd->max_it = 1;
-  svd->leftbasis = PETSC_TRUE;
+  /* the left basis is not needed if only singular values are computed (standard problem) */
+  svd->leftbasis = PetscNot(svd->valuesonly && !svd->isgeneralized && !svd->ishyperbolic);
   PetscCall(SVDAllocateSolution(svd,0));
-  PetscCall(DSAllocate(svd->ds,PetscMax(N,PetscMax(M,P))));
+  /* for tall matrices in standard problems the SVD is computed for the triangular factor */
+  if (!svd->isgeneralized && !svd->ishyperbolic && M0>N0) PetscCall(DSAllocate(svd->ds,N0));
+  else PetscCall(DSAllocate(svd->ds,PetscMax(N,PetscMax(M,P))));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode SVDSolve_LAPACK(SVD svd)
 {
-  PetscInt          M,N,n,i,j,k,ld,lowu,lowv,highu,highv;
+  PetscInt          M,N,n,i,j,k,ld,lda,lowu,lowv,highu,highv;
   Mat               A,Ar,mat;
   Vec               u,v;
-  PetscScalar       *pU,*pV,*pu,*pv,*w;
+  PetscScalar       *pU,*pV,*pu,*pv,*w,*pA=NULL,*pR,*tau,*work,sone=1.0,szero=0.0;
+  PetscBLASInt      m_,n_,lda_,ml_,lwork,info,one=1;
+  PetscBool         qr;
 
   PetscFunctionBegin;
   PetscCall(DSGetLeadingDimension(svd->ds,&ld));
@@ -47,11 +53,40 @@ static PetscErrorCode SVDSolve_LAPACK(SVD svd)
   PetscCall(MatConvert(Ar,MATSEQDENSE,MAT_INITIAL_MATRIX,&mat));
   PetscCall(MatDestroy(&Ar));
   PetscCall(MatGetSize(mat,&M,&N));
-  PetscCall(DSSetDimensions(svd->ds,M,0,0));
-  PetscCall(DSSVDSetDimensions(svd->ds,N));
-  PetscCall(DSGetMat(svd->ds,DS_MAT_A,&A));
-  PetscCall(MatCopy(mat,A,SAME_NONZERO_PATTERN));
-  PetscCall(DSRestoreMat(svd->ds,DS_MAT_A,&A));
+  qr = (M>N)? PETSC_TRUE: PETSC_FALSE;
+  if (qr) {
+    /* A=Q*R, the SVD of R is computed and the left singular vectors are multiplied by Q */
+    PetscCall(MatDenseGetLDA(mat,&lda));
+    PetscCall(PetscBLASIntCast(M,&m_));
+    PetscCall(PetscBLASIntCast(N,&n_));
+    PetscCall(PetscBLASIntCast(lda,&lda_));
+    PetscCall(PetscBLASIntCast(64*N,&lwork));
+    PetscCall(PetscMalloc2(N,&tau,lwork,&work));
+    PetscCall(MatDenseGetArray(mat,&pA));
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    PetscCallBLAS("LAPACKgeqrf",LAPACKgeqrf_(&m_,&n_,pA,&lda_,tau,work,&lwork,&info));
+    SlepcCheckLapackInfo("geqrf",info);
+    PetscCall(DSSetDimensions(svd->ds,N,0,0));
+    PetscCall(DSSVDSetDimensions(svd->ds,N));
+    PetscCall(DSGetArray(svd->ds,DS_MAT_A,&pR));
+    for (j=0;j<N;j++) {
+      for (i=0;i<=j;i++) pR[i+j*ld] = pA[i+j*lda];
+      for (i=j+1;i<N;i++) pR[i+j*ld] = 0.0;
+    }
+    PetscCall(DSRestoreArray(svd->ds,DS_MAT_A,&pR));
+    if (!svd->valuesonly) {
+      PetscCallBLAS("LAPACKorgqr",LAPACKorgqr_(&m_,&n_,&n_,pA,&lda_,tau,work,&lwork,&info));
+      SlepcCheckLapackInfo("orgqr",info);
+    }
+    PetscCall(PetscFPTrapPop());
+    PetscCall(PetscFree2(tau,work));
+  } else {
+    PetscCall(DSSetDimensions(svd->ds,M,0,0));
+    PetscCall(DSSVDSetDimensions(svd->ds,N));
+    PetscCall(DSGetMat(svd->ds,DS_MAT_A,&A));
+    PetscCall(MatCopy(mat,A,SAME_NONZERO_PATTERN));
+    PetscCall(DSRestoreMat(svd->ds,DS_MAT_A,&A));
+  }
   PetscCall(DSSetState(svd->ds,DS_STATE_RAW));
 
   n = PetscMin(M,N);
@@ -67,13 +102,18 @@ static PetscErrorCode SVDSolve_LAPACK(SVD svd)
     if (svd->which == SVD_SMALLEST) k = n - i - 1;
     else k = i;
     svd->sigma[k] = PetscRealPart(w[i]);
+    if (svd->valuesonly) continue;
     PetscCall(BVGetColumn(svd->U,k,&u));
     PetscCall(BVGetColumn(svd->V,k,&v));
     PetscCall(VecGetOwnershipRange(u,&lowu,&highu));
     PetscCall(VecGetOwnershipRange(v,&lowv,&highv));
     PetscCall(VecGetArray(u,&pu));
     PetscCall(VecGetArray(v,&pv));
-    if (M>=N) {
+    if (qr) {
+      PetscCall(PetscBLASIntCast(highu-lowu,&ml_));
+      PetscCallBLAS("BLASgemv",BLASgemv_("N",&ml_,&n_,&sone,pA+lowu,&lda_,pU+i*ld,&one,&szero,pu,&one));
+      for (j=lowv;j<highv;j++) pv[j-lowv] = pV[i*ld+j];
+    } else if (M>=N) {
       for (j=lowu;j<highu;j++) pu[j-lowu] = pU[i*ld+j];
       for (j=lowv;j<highv;j++) pv[j-lowv] = pV[i*ld+j];
     } else {
@@ -87,6 +127,7 @@ static PetscErrorCode SVDSolve_LAPACK(SVD svd)
   }
   PetscCall(DSRestoreArray(svd->ds,DS_MAT_U,&pU));
   PetscCall(DSRestoreArray(svd->ds,DS_MAT_V,&pV));
+  if (qr) PetscCall(MatDenseRestoreArray(mat,&pA));
 
   svd->nconv  = n;
   svd->its    = 1;
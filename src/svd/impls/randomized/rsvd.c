@@ -16,28 +16,59 @@
 
        Randomized singular value decomposition.
 
+       There is also a single-pass variant that computes the two sketches
+       Y=A*Omega and W=Psi*A with one sweep over the matrix and obtains the
+       approximation from them [2]. The matrix can then be read by blocks of
+       columns from a binary viewer, without storing it in memory.
+
    References:
 
        [1] N. Halko, P.-G. Martinsson, and J. A. Tropp, "Finding
            structure with randomness: Probabilistic algorithms for
            constructing approximate matrix decompositions", SIAM Rev.,
            53(2):217-288, 2011.
+
+       [2] J. A. Tropp, A. Yurtsever, M. Udell, and V. Cevher, "Practical
+           sketching algorithms for low-rank matrix approximation", SIAM J.
+           Matrix Anal. Appl., 38(4):1454-1485, 2017.
 */
 
 #include <slepc/private/svdimpl.h>                /*I "slepcsvd.h" I*/
+#include <slepcblaslapack.h>
+
+typedef struct {
+  PetscBool               singlepass;   /* compute the approximation from a single pass over the matrix */
+  PetscViewer             stream;       /* viewer from which the matrix is read by blocks of columns */
+  PetscInt                bs;           /* number of columns of each block in the stream */
+  SVDRandomizedSketchType sketch;       /* type of random matrix used for the sketch of the range */
+  PetscInt                sparsity;     /* number of nonzeros per row of the sparse sign sketch */
+  PetscInt                npower;       /* fixed number of power iterations, or PETSC_DETERMINE */
+  PetscInt                orthint;      /* orthogonalization interval in the power iterations */
+  PetscBool               adaptive;     /* determine the rank from the error of the approximation */
+  PetscInt                adaptbs;      /* number of columns added in each step of the adaptive variant */
+} SVD_RANDOMIZED;
 
 static PetscErrorCode SVDSetUp_Randomized(SVD svd)
 {
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
   PetscInt       N;
 
   PetscFunctionBegin;
   SVDCheckStandard(svd);
   SVDCheckDefinite(svd);
   PetscCheck(svd->which==SVD_LARGEST,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"This solver supports only largest singular values");
+  if (ctx->stream) ctx->singlepass = PETSC_TRUE;
+  PetscCheck(!ctx->singlepass || !ctx->adaptive,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"The adaptive rank determination is not available in the single-pass variant");
+  PetscCheck(!ctx->singlepass || ctx->npower==PETSC_DETERMINE,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Power iterations are not possible in the single-pass variant");
+  SVDCheckIgnoredCondition(svd,SVD_FEATURE_CONVERGENCE|SVD_FEATURE_STOPPING,ctx->singlepass," with single pass");
+  SVDCheckIgnoredCondition(svd,SVD_FEATURE_STOPPING,ctx->adaptive," with adaptive rank");
   PetscCall(MatGetSize(svd->A,NULL,&N));
   PetscCall(SVDSetDimensions_Default(svd));
   PetscCheck(svd->ncv>=svd->nsv,PetscObjectComm((PetscObject)svd),PETSC_ERR_USER_INPUT,"The value of ncv must not be smaller than nsv");
   if (svd->max_it==PETSC_DETERMINE) svd->max_it = PetscMax(N/svd->ncv,100);
+  if (ctx->npower!=PETSC_DETERMINE) svd->max_it = ctx->npower+1;
+  if (ctx->adaptive && ctx->adaptbs==PETSC_DETERMINE) ctx->adaptbs = PetscMax(1,svd->ncv/4);
+  if (ctx->adaptive) ctx->adaptbs = PetscMin(ctx->adaptbs,svd->ncv);
   svd->leftbasis = PETSC_TRUE;
   svd->mpd = svd->ncv;
   PetscCall(SVDAllocateSolution(svd,0));
@@ -88,17 +119,105 @@ static PetscErrorCode BlockMatMult(BV V,Mat A,BV Y,Mat AT)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Fills the active columns of V with the random test matrix Omega. In the case of
+   a sparse sign sketch, each row of Omega has a few nonzeros equal to +-1/sqrt(nnz)
+   in random positions, and Omega is also returned as a sparse matrix in Om
+*/
+static PetscErrorCode SVDRandomizedFormSketch(SVD svd,BV V,Mat *Om)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscInt       i,j,t,l,k,nc,n,N,row,Istart,nz,*cols;
+  PetscScalar    *vals;
+  PetscReal      r;
+  PetscRandom    rand;
+  Mat            Vm;
+
+  PetscFunctionBegin;
+  *Om = NULL;
+  if (ctx->sketch==SVD_RANDOMIZED_SKETCH_GAUSSIAN) {
+    PetscCall(BVSetRandomNormal(V));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(BVGetActiveColumns(V,&l,&k));
+  PetscCall(BVGetSizes(V,&n,&N,NULL));
+  nc = k-l;
+  nz = PetscMin(ctx->sparsity,nc);
+  PetscCall(MatCreateAIJ(PetscObjectComm((PetscObject)svd),n,PETSC_DECIDE,N,nc,nz,NULL,nz,NULL,Om));
+  PetscCall(MatGetOwnershipRange(*Om,&Istart,NULL));
+  PetscCall(BVGetRandomContext(V,&rand));
+  PetscCall(PetscMalloc2(nz,&cols,nz,&vals));
+  for (i=0;i<n;i++) {
+    for (j=0;j<nz;j++) {
+      do {  /* draw a column that is not yet in this row */
+        PetscCall(PetscRandomGetValueReal(rand,&r));
+        cols[j] = PetscMin((PetscInt)(r*nc),nc-1);
+        for (t=0;t<j && cols[t]!=cols[j];t++);
+      } while (t<j);
+      PetscCall(PetscRandomGetValueReal(rand,&r));
+      vals[j] = (r<0.5? -1.0: 1.0)/PetscSqrtReal((PetscReal)nz);
+    }
+    row = Istart+i;
+    PetscCall(MatSetValues(*Om,1,&row,nz,cols,vals,INSERT_VALUES));
+  }
+  PetscCall(PetscFree2(cols,vals));
+  PetscCall(MatAssemblyBegin(*Om,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*Om,MAT_FINAL_ASSEMBLY));
+  PetscCall(BVGetMat(V,&Vm));
+  PetscCall(MatZeroEntries(Vm));
+  PetscCall(MatCopy(*Om,Vm,DIFFERENT_NONZERO_PATTERN));
+  PetscCall(BVRestoreMat(V,&Vm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes Y = A*Omega, where Omega is stored in the active columns of V. If Omega is
+   available as a sparse matrix and A is AIJ, the sparse product costs nnz(A)*nnz(row of
+   Omega) flops instead of nnz(A)*ncv
+*/
+static PetscErrorCode SVDRandomizedSketchMult(BV V,Mat Om,Mat A,BV Y,Mat AT)
+{
+  PetscBool flg=PETSC_FALSE;
+  Mat       AOm,Ym;
+
+  PetscFunctionBegin;
+  if (Om) PetscCall(PetscObjectTypeCompareAny((PetscObject)A,&flg,MATSEQAIJ,MATMPIAIJ,""));
+  if (flg) {
+    PetscCall(MatMatMult(A,Om,MAT_INITIAL_MATRIX,PETSC_DETERMINE,&AOm));
+    PetscCall(BVGetMat(Y,&Ym));
+    PetscCall(MatZeroEntries(Ym));
+    PetscCall(MatCopy(AOm,Ym,DIFFERENT_NONZERO_PATTERN));
+    PetscCall(BVRestoreMat(Y,&Ym));
+    PetscCall(MatDestroy(&AOm));
+  } else PetscCall(BlockMatMult(V,A,Y,AT));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDSolve_Randomized_SinglePass(SVD);
+static PetscErrorCode SVDSolve_Randomized_Adaptive(SVD);
+
 static PetscErrorCode SVDSolve_Randomized(SVD svd)
 {
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
   PetscScalar    *w;
   PetscReal      res=1.0;
   PetscInt       i,k=0;
-  Mat            A,U,V;
+  PetscBool      fixed=(ctx->npower!=PETSC_DETERMINE)? PETSC_TRUE: PETSC_FALSE;
+  Mat            A,U,V,Om;
 
   PetscFunctionBegin;
+  if (ctx->singlepass) {
+    PetscCall(SVDSolve_Randomized_SinglePass(svd));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (ctx->adaptive) {
+    PetscCall(SVDSolve_Randomized_Adaptive(svd));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   /* Form random matrix, G. Complete the initial basis with random vectors */
   PetscCall(BVSetActiveColumns(svd->V,svd->nini,svd->ncv));
-  PetscCall(BVSetRandomNormal(svd->V));
+  PetscCall(SVDRandomizedFormSketch(svd,svd->V,&Om));
+  if (svd->nini) PetscCall(MatDestroy(&Om));
   PetscCall(PetscCalloc1(svd->ncv,&w));
 
   /* Subspace Iteration */
@@ -107,11 +226,18 @@ static PetscErrorCode SVDSolve_Randomized(SVD svd)
     PetscCall(BVSetActiveColumns(svd->V,svd->nconv,svd->ncv));
     PetscCall(BVSetActiveColumns(svd->U,svd->nconv,svd->ncv));
     /* Form AG */
-    PetscCall(BlockMatMult(svd->V,svd->A,svd->U,svd->AT));
-    /* Orthogonalization Q=qr(AG)*/
-    PetscCall(BVOrthogonalize(svd->U,NULL));
+    if (svd->its==1) {
+      PetscCall(SVDRandomizedSketchMult(svd->V,Om,svd->A,svd->U,svd->AT));
+      PetscCall(MatDestroy(&Om));
+    } else PetscCall(BlockMatMult(svd->V,svd->A,svd->U,svd->AT));
+    /* Orthogonalization Q=qr(AG), only every orthint steps of a fixed number of power iterations */
+    if (!fixed || svd->its%ctx->orthint==0 || svd->its>ctx->npower) PetscCall(BVOrthogonalize(svd->U,NULL));
     /* Form B^*= AQ */
     PetscCall(BlockMatMult(svd->U,svd->AT,svd->V,svd->A));
+    if (fixed && svd->its<=ctx->npower) {
+      if (svd->its%ctx->orthint==0) PetscCall(BVOrthogonalize(svd->V,NULL));
+      continue;
+    }
 
     PetscCall(DSSetDimensions(svd->ds,svd->ncv,svd->nconv,svd->ncv));
     PetscCall(DSSVDSetDimensions(svd->ds,svd->ncv));
@@ -136,9 +262,9 @@ static PetscErrorCode SVDSolve_Randomized(SVD svd)
       svd->sigma[i] = PetscRealPart(w[i]);
       PetscCall((*svd->converged)(svd,svd->sigma[i],res,&svd->errest[i],svd->convergedctx));
       if (svd->errest[i] < svd->tol) k++;
-      else break;
+      else if (!fixed) break;
     }
-    if (svd->conv == SVD_CONV_MAXIT && svd->its >= svd->max_it) {
+    if ((svd->conv == SVD_CONV_MAXIT && svd->its >= svd->max_it) || fixed) {
       k = svd->nsv;
       for (i=0;i<svd->ncv;i++) svd->sigma[i] = PetscRealPart(w[i]);
     }
@@ -150,10 +276,846 @@ static PetscErrorCode SVDSolve_Randomized(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Adds the contribution of the next block of columns of the stream to the sketches,
+   Y += A(:,c0:c0+nj)*Omega(c0:c0+nj,:) and W(c0:c0+nj,:) = A(:,c0:c0+nj)^H*P, where
+   Omega is generated on the fly and P = Psi^H. The local columns of the block are
+   those of the current process in the layout of W, so that W is filled locally
+*/
+static PetscErrorCode SVDRandomizedReadBlock(SVD svd,PetscInt c0,PetscInt nj,BV Y,BV T,BV P,BV W)
+{
+  SVD_RANDOMIZED    *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscInt          j,m,M,n,nloc,k,l,vs,ve,off,lds,ldw;
+  Mat               Aj;
+  BV                Om,S;
+  BVType            type;
+  MPI_Comm          comm;
+  PetscScalar       *pw;
+  const PetscScalar *ps;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)svd,&comm));
+  PetscCall(BVGetSizes(Y,&m,&M,NULL));
+  PetscCall(BVGetActiveColumns(Y,NULL,&k));
+  PetscCall(BVGetActiveColumns(P,NULL,&l));
+  PetscCall(BVGetSizes(W,&n,NULL,NULL));
+  PetscCallMPI(MPI_Scan(&n,&ve,1,MPIU_INT,MPI_SUM,comm));
+  vs = ve-n;
+  nloc = PetscMax(0,PetscMin(c0+nj,ve)-PetscMax(c0,vs));
+  off  = PetscMax(c0,vs)-vs;
+
+  /* load the block with the row layout of Y and the column layout of W */
+  PetscCall(MatCreate(comm,&Aj));
+  PetscCall(MatSetSizes(Aj,m,nloc,M,nj));
+  PetscCall(MatLoad(Aj,ctx->stream));
+
+  PetscCall(BVGetType(Y,&type));
+  PetscCall(BVCreate(comm,&Om));
+  PetscCall(BVSetSizes(Om,nloc,nj,k));
+  PetscCall(BVSetType(Om,type));
+  PetscCall(BVSetRandomNormal(Om));
+  PetscCall(BVCreate(comm,&S));
+  PetscCall(BVSetSizes(S,nloc,nj,l));
+  PetscCall(BVSetType(S,type));
+
+  /* range sketch */
+  if (!c0) PetscCall(BVMatMult(Om,Aj,Y));
+  else {
+    PetscCall(BVMatMult(Om,Aj,T));
+    PetscCall(BVMult(Y,1.0,1.0,T,NULL));
+  }
+
+  /* co-range sketch, copied to the corresponding rows of W */
+  PetscCall(BVMatMultHermitianTranspose(P,Aj,S));
+  PetscCall(BVGetLeadingDimension(S,&lds));
+  PetscCall(BVGetLeadingDimension(W,&ldw));
+  PetscCall(BVGetArrayRead(S,&ps));
+  PetscCall(BVGetArray(W,&pw));
+  for (j=0;j<l;j++) PetscCall(PetscArraycpy(pw+off+j*ldw,ps+j*lds,nloc));
+  PetscCall(BVRestoreArray(W,&pw));
+  PetscCall(BVRestoreArrayRead(S,&ps));
+
+  PetscCall(BVDestroy(&Om));
+  PetscCall(BVDestroy(&S));
+  PetscCall(MatDestroy(&Aj));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes R = C*(C^H*C)^{-1}, so that R^H is the pseudoinverse of the l x k matrix C,
+   by means of the QR factorization C = Q_c*R_c, R = Q_c*R_c^{-H}
+*/
+static PetscErrorCode SVDRandomizedPseudoinverse(Mat C,Mat R)
+{
+  PetscInt          i,j,l,k,ldc,ldr;
+  PetscBLASInt      l_,k_,ld_,lwork,info;
+  PetscScalar       *pR,*T,*tau,*work,sone=1.0;
+  const PetscScalar *pC;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(C,&l,&k));
+  PetscCall(MatDenseGetLDA(C,&ldc));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  PetscCall(PetscBLASIntCast(l,&l_));
+  PetscCall(PetscBLASIntCast(k,&k_));
+  PetscCall(PetscBLASIntCast(ldr,&ld_));
+  lwork = k_;
+  PetscCall(PetscMalloc3(k*k,&T,k,&tau,k,&work));
+  PetscCall(MatDenseGetArrayRead(C,&pC));
+  PetscCall(MatDenseGetArray(R,&pR));
+  for (j=0;j<k;j++) PetscCall(PetscArraycpy(pR+j*ldr,pC+j*ldc,l));
+  PetscCallBLAS("LAPACKgeqrf",LAPACKgeqrf_(&l_,&k_,pR,&ld_,tau,work,&lwork,&info));
+  SlepcCheckLapackInfo("geqrf",info);
+  PetscCall(PetscArrayzero(T,k*k));
+  for (j=0;j<k;j++) for (i=0;i<=j;i++) T[i+j*k] = pR[i+j*ldr];
+  PetscCallBLAS("LAPACKorgqr",LAPACKorgqr_(&l_,&k_,&k_,pR,&ld_,tau,work,&lwork,&info));
+  SlepcCheckLapackInfo("orgqr",info);
+  PetscCallBLAS("BLAStrsm",BLAStrsm_("R","U","C","N",&l_,&k_,&sone,T,&k_,pR,&ld_));
+  PetscCall(MatDenseRestoreArray(R,&pR));
+  PetscCall(MatDenseRestoreArrayRead(C,&pC));
+  PetscCall(PetscFree3(T,tau,work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Single-pass variant [2]: Y = A*Omega and W^H = Psi*A are computed with one sweep over A,
+   either in memory or by blocks of columns read from the stream. With Q = qr(Y), the
+   approximation is A ~ Q*X with X = (Psi*Q)^+ * W^H, whose SVD is obtained from the
+   QR factorization of X^H as in the subspace iteration. The sketches are done with the
+   matrix as given by the user, so the left basis is V if the solver has swapped them
+*/
+static PetscErrorCode SVDSolve_Randomized_SinglePass(SVD svd)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscScalar    *w;
+  PetscInt       i,k=svd->ncv,l,M,N,c0;
+  BV             Y,X,P,W,T=NULL;
+  Mat            A=NULL,AT=NULL,C,R,U,V,Om;
+
+  PetscFunctionBegin;
+  Y = svd->swapped? svd->V: svd->U;
+  X = svd->swapped? svd->U: svd->V;
+  PetscCall(MatGetSize(svd->OP,&M,&N));
+  l = PetscMin(2*k+1,M);
+  PetscCall(BVDuplicateResize(Y,l,&P));
+  PetscCall(BVDuplicateResize(X,l,&W));
+  PetscCall(BVSetRandomNormal(P));
+  PetscCall(BVSetActiveColumns(Y,0,k));
+  PetscCall(BVSetActiveColumns(X,0,k));
+  PetscCall(PetscCalloc1(svd->ncv,&w));
+  svd->its = 1;
+
+  /* Form the sketches Y=A*Omega and W=A^H*Psi^H */
+  if (ctx->stream) {
+    PetscCall(BVDuplicate(Y,&T));
+    PetscCall(BVSetActiveColumns(T,0,k));
+    for (c0=0;c0<N;c0+=ctx->bs) PetscCall(SVDRandomizedReadBlock(svd,c0,PetscMin(ctx->bs,N-c0),Y,T,P,W));
+    PetscCall(BVDestroy(&T));
+  } else {
+    A  = svd->swapped? svd->AT: svd->A;
+    AT = svd->swapped? svd->A: svd->AT;
+    PetscCall(SVDRandomizedFormSketch(svd,X,&Om));
+    PetscCall(SVDRandomizedSketchMult(X,Om,A,Y,AT));
+    PetscCall(MatDestroy(&Om));
+    PetscCall(BlockMatMult(P,AT,W,A));
+  }
+
+  /* Q = qr(Y), X^H = W*R with R^H = (Psi*Q)^+ */
+  PetscCall(BVOrthogonalize(Y,NULL));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,l,k,NULL,&C));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,l,k,NULL,&R));
+  PetscCall(BVDot(Y,P,C));
+  PetscCall(SVDRandomizedPseudoinverse(C,R));
+  PetscCall(BVMult(X,1.0,0.0,W,R));
+  PetscCall(MatDestroy(&C));
+  PetscCall(MatDestroy(&R));
+
+  /* SVD of the R factor of X^H */
+  PetscCall(DSSetDimensions(svd->ds,svd->ncv,0,svd->ncv));
+  PetscCall(DSSVDSetDimensions(svd->ds,svd->ncv));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_A,&A));
+  PetscCall(MatZeroEntries(A));
+  PetscCall(BVOrthogonalize(X,A));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_A,&A));
+  PetscCall(DSSetState(svd->ds,DS_STATE_RAW));
+  PetscCall(DSSolve(svd->ds,w,NULL));
+  PetscCall(DSSort(svd->ds,w,NULL,NULL,NULL,NULL));
+  PetscCall(DSSynchronize(svd->ds,w,NULL));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_U,&U));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_V,&V));
+  PetscCall(BVMultInPlace(Y,V,0,svd->ncv));
+  PetscCall(BVMultInPlace(X,U,0,svd->ncv));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_U,&U));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_V,&V));
+
+  /* the residuals would require another pass, the error estimates are not computed */
+  for (i=0;i<svd->ncv;i++) {
+    svd->sigma[i]  = PetscRealPart(w[i]);
+    svd->errest[i] = 0.0;
+  }
+  svd->nconv  = svd->nsv;
+  svd->reason = SVD_CONVERGED_TOL;
+  PetscCall(SVDMonitor(svd,svd->its,svd->nconv,svd->sigma,svd->errest,svd->ncv));
+  PetscCall(PetscFree(w));
+  PetscCall(BVDestroy(&P));
+  PetscCall(BVDestroy(&W));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Adaptive rank determination with the blocked randomized QB factorization of
+   Martinsson and Voronin: blocks of b columns are added to Q until the error
+   ||A-Q*B||_F, updated as ||A||_F^2-||B||_F^2, is below tol*||A||_F. Each block is
+   orthogonalized against the previous ones, including after the power iterations
+*/
+static PetscErrorCode SVDSolve_Randomized_Adaptive(SVD svd)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscScalar    *w;
+  PetscReal      res=1.0,nrma,nrmb,err;
+  PetscInt       i,p,r=0,b;
+  BV             Z;
+  Mat            A,U,V,Om;
+
+  PetscFunctionBegin;
+  PetscCall(MatNorm(svd->OP,NORM_FROBENIUS,&nrma));
+  err = nrma*nrma;
+  PetscCall(BVDuplicateResize(svd->V,ctx->adaptbs,&Z));
+  PetscCall(PetscCalloc1(svd->ncv,&w));
+
+  /* Grow the basis by blocks */
+  while (svd->reason == SVD_CONVERGED_ITERATING) {
+    svd->its++;
+    b = PetscMin(ctx->adaptbs,svd->ncv-r);
+    PetscCall(BVSetActiveColumns(svd->V,r,r+b));
+    PetscCall(BVSetActiveColumns(svd->U,r,r+b));
+    PetscCall(BVSetActiveColumns(Z,0,b));
+    PetscCall(SVDRandomizedFormSketch(svd,svd->V,&Om));
+    PetscCall(SVDRandomizedSketchMult(svd->V,Om,svd->A,svd->U,svd->AT));
+    PetscCall(MatDestroy(&Om));
+    PetscCall(BVOrthogonalize(svd->U,NULL));
+    for (p=0;p<ctx->npower;p++) {
+      PetscCall(BlockMatMult(svd->U,svd->AT,Z,svd->A));
+      if ((p+1)%ctx->orthint==0) PetscCall(BVOrthogonalize(Z,NULL));
+      PetscCall(BlockMatMult(Z,svd->A,svd->U,svd->AT));
+      PetscCall(BVOrthogonalize(svd->U,NULL));
+    }
+    /* B_i^* = A^*Q_i, and update of the error */
+    PetscCall(BlockMatMult(svd->U,svd->AT,svd->V,svd->A));
+    PetscCall(BVNorm(svd->V,NORM_FROBENIUS,&nrmb));
+    err -= nrmb*nrmb;
+    r += b;
+    PetscCall(PetscInfo(svd,"Rank %" PetscInt_FMT ", relative error of the approximation %g\n",r,(double)(PetscSqrtReal(PetscMax(err,0.0))/nrma)));
+    if (err <= svd->tol*svd->tol*nrma*nrma) svd->reason = SVD_CONVERGED_TOL;
+    else if (r == svd->ncv) svd->reason = SVD_DIVERGED_ITS;
+  }
+  PetscCall(BVDestroy(&Z));
+
+  /* SVD of the R factor of B^* */
+  PetscCall(BVSetActiveColumns(svd->V,0,r));
+  PetscCall(BVSetActiveColumns(svd->U,0,r));
+  PetscCall(DSSetDimensions(svd->ds,r,0,r));
+  PetscCall(DSSVDSetDimensions(svd->ds,r));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_A,&A));
+  PetscCall(MatZeroEntries(A));
+  PetscCall(BVOrthogonalize(svd->V,A));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_A,&A));
+  PetscCall(DSSetState(svd->ds,DS_STATE_RAW));
+  PetscCall(DSSolve(svd->ds,w,NULL));
+  PetscCall(DSSort(svd->ds,w,NULL,NULL,NULL,NULL));
+  PetscCall(DSSynchronize(svd->ds,w,NULL));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_U,&U));
+  PetscCall(DSGetMat(svd->ds,DS_MAT_V,&V));
+  PetscCall(BVMultInPlace(svd->U,V,0,r));
+  PetscCall(BVMultInPlace(svd->V,U,0,r));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_U,&U));
+  PetscCall(DSRestoreMat(svd->ds,DS_MAT_V,&V));
+
+  /* all the computed triplets are returned, with their error estimates */
+  for (i=0;i<r;i++) {
+    PetscCall(SVDRandomizedResidualNorm(svd,i,w[i],&res));
+    svd->sigma[i] = PetscRealPart(w[i]);
+    PetscCall((*svd->converged)(svd,svd->sigma[i],res,&svd->errest[i],svd->convergedctx));
+  }
+  svd->nconv = r;
+  PetscCall(SVDMonitor(svd,svd->its,svd->nconv,svd->sigma,svd->errest,r));
+  PetscCall(PetscFree(w));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDSetFromOptions_Randomized(SVD svd,PetscOptionItems *PetscOptionsObject)
+{
+  SVD_RANDOMIZED          *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscBool               set,val,flg1,flg2;
+  PetscInt                nz,np,oi,bs;
+  SVDRandomizedSketchType sketch;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"SVD Randomized Options");
+
+    PetscCall(PetscOptionsBool("-svd_randomized_single_pass","Compute the approximation from a single pass over the matrix","SVDRandomizedSetSinglePass",ctx->singlepass,&val,&set));
+    if (set) PetscCall(SVDRandomizedSetSinglePass(svd,val));
+
+    sketch = ctx->sketch;
+    nz = ctx->sparsity;
+    PetscCall(PetscOptionsEnum("-svd_randomized_sketch","Type of random test matrix","SVDRandomizedSetSketch",SVDRandomizedSketchTypes,(PetscEnum)sketch,(PetscEnum*)&sketch,&flg1));
+    PetscCall(PetscOptionsInt("-svd_randomized_sketch_nnz","Number of nonzeros per row of the sparse sign sketch","SVDRandomizedSetSketch",nz,&nz,&flg2));
+    if (flg1 || flg2) PetscCall(SVDRandomizedSetSketch(svd,sketch,nz));
+
+    np = ctx->npower;
+    oi = ctx->orthint;
+    PetscCall(PetscOptionsInt("-svd_randomized_power_its","Fixed number of power iterations","SVDRandomizedSetPowerIterations",np,&np,&flg1));
+    PetscCall(PetscOptionsInt("-svd_randomized_orth_interval","Orthogonalization interval in the power iterations","SVDRandomizedSetPowerIterations",oi,&oi,&flg2));
+    if (flg1 || flg2) PetscCall(SVDRandomizedSetPowerIterations(svd,np,oi));
+
+    val = ctx->adaptive;
+    bs = ctx->adaptbs;
+    PetscCall(PetscOptionsBool("-svd_randomized_adaptive_rank","Determine the rank adaptively","SVDRandomizedSetAdaptiveRank",val,&val,&flg1));
+    PetscCall(PetscOptionsInt("-svd_randomized_adaptive_bs","Number of columns added in each step of the adaptive rank determination","SVDRandomizedSetAdaptiveRank",bs,&bs,&flg2));
+    if (flg1 || flg2) PetscCall(SVDRandomizedSetAdaptiveRank(svd,val,bs));
+
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedSetSinglePass_Randomized(SVD svd,PetscBool singlepass)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (ctx->singlepass != singlepass) {
+    ctx->singlepass = singlepass;
+    svd->state = SVD_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedSetSinglePass - Indicate if the randomized SVD must be computed
+   from a single pass over the matrix.
+
+   Logically Collective
+
+   Input Parameters:
++  svd        - singular value solver
+-  singlepass - boolean flag indicating if the single-pass variant is used
+
+   Options Database Key:
+.  -svd_randomized_single_pass <boolean> - Indicates the boolean flag
+
+   Notes:
+   By default, the randomized solver performs a subspace iteration, where each
+   iteration requires a product with the matrix and another one with its transpose,
+   until the residuals of the singular triplets satisfy the tolerance. In the
+   single-pass variant, two random sketches Y=A*Omega and W=Psi*A are computed
+   with a single sweep over the matrix, and the approximate singular triplets are
+   obtained from them. This is appropriate when the matrix is too large to be read
+   several times, see SVDRandomizedSetStream(). The approximation is exact if the
+   rank of A does not exceed ncv, otherwise its quality depends on the decay of the
+   singular values beyond ncv.
+
+   The computation of residuals would require another pass over the matrix, so
+   the error estimates are not computed in this variant, and nsv singular triplets
+   are always returned. The tolerance and the convergence and stopping tests are
+   ignored. For a matrix stored in memory, the errors can be checked afterwards
+   with SVDComputeError().
+
+   Level: advanced
+
+.seealso: SVDRandomizedGetSinglePass(), SVDRandomizedSetStream()
+@*/
+PetscErrorCode SVDRandomizedSetSinglePass(SVD svd,PetscBool singlepass)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveBool(svd,singlepass,2);
+  PetscTryMethod(svd,"SVDRandomizedSetSinglePass_C",(SVD,PetscBool),(svd,singlepass));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedGetSinglePass_Randomized(SVD svd,PetscBool *singlepass)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  *singlepass = ctx->singlepass;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedGetSinglePass - Gets the flag indicating if the randomized SVD
+   is computed from a single pass over the matrix.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - singular value solver
+
+   Output Parameter:
+.  singlepass - boolean flag indicating if the single-pass variant is used
+
+   Level: advanced
+
+.seealso: SVDRandomizedSetSinglePass()
+@*/
+PetscErrorCode SVDRandomizedGetSinglePass(SVD svd,PetscBool *singlepass)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(singlepass,2);
+  PetscUseMethod(svd,"SVDRandomizedGetSinglePass_C",(SVD,PetscBool*),(svd,singlepass));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedSetStream_Randomized(SVD svd,PetscViewer viewer,PetscInt bs)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (viewer) PetscCall(PetscObjectReference((PetscObject)viewer));
+  PetscCall(PetscViewerDestroy(&ctx->stream));
+  ctx->stream = viewer;
+  if (bs == PETSC_DETERMINE || bs == PETSC_DEFAULT) ctx->bs = 64;
+  else if (bs != PETSC_CURRENT) {
+    PetscCheck(bs>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The block size must be > 0");
+    ctx->bs = bs;
+  }
+  svd->state = SVD_STATE_INITIAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedSetStream - Sets a viewer from which the matrix is read by
+   blocks of columns in the single-pass variant of the randomized SVD.
+
+   Collective
+
+   Input Parameters:
++  svd    - singular value solver
+.  viewer - binary viewer opened for reading (or NULL to use the matrix in memory)
+-  bs     - number of columns of each block
+
+   Notes:
+   The viewer must contain the matrix A as a sequence of matrices written with
+   MatView(), each of them with all the rows of A and bs consecutive columns (the
+   last one may have less columns). The blocks are read one at a time with MatLoad()
+   during SVDSolve(), so the memory required for A is that of one block. Setting
+   a stream implies the single-pass variant, see SVDRandomizedSetSinglePass().
+
+   The matrix passed in SVDSetOperators() is not used for computation, it only
+   provides the dimensions and the parallel layout of the singular vectors. It can
+   be a shell matrix without operations, see MatCreateShell(). Each call to SVDSolve()
+   reads the blocks from the current position of the viewer.
+
+   Use PETSC_DETERMINE for bs to set a default value, or PETSC_CURRENT to keep
+   the current value.
+
+   Level: advanced
+
+.seealso: SVDRandomizedGetStream(), SVDRandomizedSetSinglePass(), MatLoad()
+@*/
+PetscErrorCode SVDRandomizedSetStream(SVD svd,PetscViewer viewer,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  if (viewer) {
+    PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+    PetscCheckSameComm(svd,1,viewer,2);
+  }
+  PetscValidLogicalCollectiveInt(svd,bs,3);
+  PetscTryMethod(svd,"SVDRandomizedSetStream_C",(SVD,PetscViewer,PetscInt),(svd,viewer,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedGetStream_Randomized(SVD svd,PetscViewer *viewer,PetscInt *bs)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (viewer) *viewer = ctx->stream;
+  if (bs) *bs = ctx->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedGetStream - Gets the viewer from which the matrix is read in
+   the single-pass variant of the randomized SVD, and the number of columns of
+   each block.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - singular value solver
+
+   Output Parameters:
++  viewer - the binary viewer (NULL if not set)
+-  bs     - number of columns of each block
+
+   Level: advanced
+
+.seealso: SVDRandomizedSetStream()
+@*/
+PetscErrorCode SVDRandomizedGetStream(SVD svd,PetscViewer *viewer,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscUseMethod(svd,"SVDRandomizedGetStream_C",(SVD,PetscViewer*,PetscInt*),(svd,viewer,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedSetSketch_Randomized(SVD svd,SVDRandomizedSketchType sketch,PetscInt nnz)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  ctx->sketch = sketch;
+  if (nnz == PETSC_DETERMINE || nnz == PETSC_DEFAULT) ctx->sparsity = 8;
+  else if (nnz != PETSC_CURRENT) {
+    PetscCheck(nnz>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The number of nonzeros must be > 0");
+    ctx->sparsity = nnz;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedSetSketch - Sets the type of random test matrix used to sketch
+   the range of the matrix in the randomized SVD.
+
+   Logically Collective
+
+   Input Parameters:
++  svd    - singular value solver
+.  sketch - the type of sketch
+-  nnz    - number of nonzeros per row in the sparse sign sketch
+
+   Options Database Keys:
++  -svd_randomized_sketch <sketch> - Sets the type of sketch, either 'gaussian' or 'sparse_sign'
+-  -svd_randomized_sketch_nnz <nnz> - Sets the number of nonzeros per row
+
+   Notes:
+   The default is a Gaussian test matrix Omega, whose product A*Omega has the cost
+   of ncv products with A. In the sparse sign sketch, each row of Omega has nnz
+   nonzero entries equal to +-1/sqrt(nnz) at random columns. If A is an AIJ matrix,
+   the product A*Omega is computed as a sparse matrix-matrix product, whose cost is
+   proportional to nnz instead of ncv, so it is much cheaper for large ncv. The
+   quality of the sketch is similar to the Gaussian one for nnz around 8, which is the
+   default value. Use PETSC_DETERMINE for nnz to set the default, or PETSC_CURRENT
+   to keep the current value.
+
+   The sketch is used in the first step of the subspace iteration or each block of
+   the adaptive variant, and in the single-pass variant with the matrix in memory.
+   When the matrix is read from a stream, the sketch is always Gaussian.
+
+   Level: advanced
+
+.seealso: SVDRandomizedGetSketch(), SVDRandomizedSetPowerIterations(), SVDRandomizedSetAdaptiveRank()
+@*/
+PetscErrorCode SVDRandomizedSetSketch(SVD svd,SVDRandomizedSketchType sketch,PetscInt nnz)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(svd,sketch,2);
+  PetscValidLogicalCollectiveInt(svd,nnz,3);
+  PetscTryMethod(svd,"SVDRandomizedSetSketch_C",(SVD,SVDRandomizedSketchType,PetscInt),(svd,sketch,nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedGetSketch_Randomized(SVD svd,SVDRandomizedSketchType *sketch,PetscInt *nnz)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (sketch) *sketch = ctx->sketch;
+  if (nnz) *nnz = ctx->sparsity;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedGetSketch - Gets the type of random test matrix used in the
+   randomized SVD.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - singular value solver
+
+   Output Parameters:
++  sketch - the type of sketch
+-  nnz    - number of nonzeros per row in the sparse sign sketch
+
+   Level: advanced
+
+.seealso: SVDRandomizedSetSketch()
+@*/
+PetscErrorCode SVDRandomizedGetSketch(SVD svd,SVDRandomizedSketchType *sketch,PetscInt *nnz)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscUseMethod(svd,"SVDRandomizedGetSketch_C",(SVD,SVDRandomizedSketchType*,PetscInt*),(svd,sketch,nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedSetPowerIterations_Randomized(SVD svd,PetscInt npower,PetscInt orthint)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (npower == PETSC_DETERMINE || npower == PETSC_DEFAULT) ctx->npower = PETSC_DETERMINE;
+  else if (npower != PETSC_CURRENT) {
+    PetscCheck(npower>=0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The number of power iterations cannot be negative");
+    ctx->npower = npower;
+  }
+  if (orthint == PETSC_DETERMINE || orthint == PETSC_DEFAULT) ctx->orthint = 1;
+  else if (orthint != PETSC_CURRENT) {
+    PetscCheck(orthint>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The orthogonalization interval must be > 0");
+    ctx->orthint = orthint;
+  }
+  svd->state = SVD_STATE_INITIAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedSetPowerIterations - Sets a fixed number of power iterations
+   in the randomized SVD, and how often the basis is orthogonalized.
+
+   Logically Collective
+
+   Input Parameters:
++  svd     - singular value solver
+.  npower  - number of power iterations
+-  orthint - orthogonalization interval
+
+   Options Database Keys:
++  -svd_randomized_power_its <npower> - Sets the number of power iterations
+-  -svd_randomized_orth_interval <orthint> - Sets the orthogonalization interval
+
+   Notes:
+   By default (npower=PETSC_DETERMINE), the randomized solver iterates until all
+   requested singular triplets satisfy the convergence criterion, with a residual
+   check in each iteration. With a fixed number of power iterations, the range is
+   sketched with (A*A^*)^npower*A*Omega and the approximate triplets are computed
+   only once at the end, so the cost is known in advance and there are no products
+   for the residuals in the intermediate iterations. The nsv triplets are returned
+   with their error estimates, whether or not they satisfy the tolerance.
+
+   In the power iterations, the bases are orthogonalized only every orthint applications
+   of A and A^*, which saves work but amplifies the effect of rounding errors on the
+   smallest singular values. The default orthint=1 is the numerically stable choice.
+
+   Use PETSC_DETERMINE to set the default values, or PETSC_CURRENT to keep the
+   current value of any of the arguments.
+
+   Level: advanced
+
+.seealso: SVDRandomizedGetPowerIterations(), SVDRandomizedSetAdaptiveRank()
+@*/
+PetscErrorCode SVDRandomizedSetPowerIterations(SVD svd,PetscInt npower,PetscInt orthint)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveInt(svd,npower,2);
+  PetscValidLogicalCollectiveInt(svd,orthint,3);
+  PetscTryMethod(svd,"SVDRandomizedSetPowerIterations_C",(SVD,PetscInt,PetscInt),(svd,npower,orthint));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedGetPowerIterations_Randomized(SVD svd,PetscInt *npower,PetscInt *orthint)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (npower) *npower = ctx->npower;
+  if (orthint) *orthint = ctx->orthint;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedGetPowerIterations - Gets the fixed number of power iterations
+   and the orthogonalization interval of the randomized SVD.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - singular value solver
+
+   Output Parameters:
++  npower  - number of power iterations (PETSC_DETERMINE if they are not fixed)
+-  orthint - orthogonalization interval
+
+   Level: advanced
+
+.seealso: SVDRandomizedSetPowerIterations()
+@*/
+PetscErrorCode SVDRandomizedGetPowerIterations(SVD svd,PetscInt *npower,PetscInt *orthint)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscUseMethod(svd,"SVDRandomizedGetPowerIterations_C",(SVD,PetscInt*,PetscInt*),(svd,npower,orthint));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedSetAdaptiveRank_Randomized(SVD svd,PetscBool adaptive,PetscInt bs)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  ctx->adaptive = adaptive;
+  if (bs == PETSC_DETERMINE || bs == PETSC_DEFAULT) ctx->adaptbs = PETSC_DETERMINE;
+  else if (bs != PETSC_CURRENT) {
+    PetscCheck(bs>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The block size must be > 0");
+    ctx->adaptbs = bs;
+  }
+  svd->state = SVD_STATE_INITIAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedSetAdaptiveRank - Activates the adaptive determination of the
+   rank of the approximation in the randomized SVD.
+
+   Logically Collective
+
+   Input Parameters:
++  svd      - singular value solver
+.  adaptive - whether the rank is determined adaptively
+-  bs       - number of columns added to the basis in each step
+
+   Options Database Keys:
++  -svd_randomized_adaptive_rank <boolean> - Activates the adaptive rank determination
+-  -svd_randomized_adaptive_bs <bs> - Sets the number of columns of each step
+
+   Notes:
+   In the adaptive variant, the basis of the range is extended with bs columns at
+   a time, each block obtained from a new sketch (and the power iterations, if set
+   with SVDRandomizedSetPowerIterations()) and orthogonalized against the previous ones.
+   The error of the approximation A~Q*Q^*A in the Frobenius norm is updated cheaply
+   after each block, and the process stops when it is below tol*||A||_F, where tol is
+   the tolerance set with SVDSetTolerances(), or when the basis has ncv columns. All
+   the computed singular triplets are returned, so their number, given by
+   SVDGetConverged(), is the numerical rank determined for the given tolerance,
+   regardless of nsv. The converged reason is SVD_DIVERGED_ITS if ncv columns were
+   not enough to attain the tolerance.
+
+   Since the error is computed as ||A||_F^2-||Q^*A||_F^2, it cannot go below the
+   square root of the machine precision, relative to ||A||_F. The matrix must
+   support MatNorm() with NORM_FROBENIUS.
+
+   The default value of bs (PETSC_DETERMINE) is ncv/4.
+
+   Level: advanced
+
+.seealso: SVDRandomizedGetAdaptiveRank(), SVDRandomizedSetPowerIterations(), SVDSetTolerances()
+@*/
+PetscErrorCode SVDRandomizedSetAdaptiveRank(SVD svd,PetscBool adaptive,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveBool(svd,adaptive,2);
+  PetscValidLogicalCollectiveInt(svd,bs,3);
+  PetscTryMethod(svd,"SVDRandomizedSetAdaptiveRank_C",(SVD,PetscBool,PetscInt),(svd,adaptive,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRandomizedGetAdaptiveRank_Randomized(SVD svd,PetscBool *adaptive,PetscInt *bs)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  if (adaptive) *adaptive = ctx->adaptive;
+  if (bs) *bs = ctx->adaptbs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRandomizedGetAdaptiveRank - Gets the flag of the adaptive determination
+   of the rank in the randomized SVD, and the number of columns of each step.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - singular value solver
+
+   Output Parameters:
++  adaptive - whether the rank is determined adaptively
+-  bs       - number of columns added to the basis in each step
+
+   Level: advanced
+
+.seealso: SVDRandomizedSetAdaptiveRank()
+@*/
+PetscErrorCode SVDRandomizedGetAdaptiveRank(SVD svd,PetscBool *adaptive,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscUseMethod(svd,"SVDRandomizedGetAdaptiveRank_C",(SVD,PetscBool*,PetscInt*),(svd,adaptive,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDDestroy_Randomized(SVD svd)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerDestroy(&ctx->stream));
+  PetscCall(PetscFree(svd->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetSinglePass_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetSinglePass_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetStream_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetStream_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetSketch_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetSketch_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetPowerIterations_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetPowerIterations_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetAdaptiveRank_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetAdaptiveRank_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDView_Randomized(SVD svd,PetscViewer viewer)
+{
+  SVD_RANDOMIZED *ctx = (SVD_RANDOMIZED*)svd->data;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    if (ctx->stream) PetscCall(PetscViewerASCIIPrintf(viewer,"  single-pass variant, reading the matrix by blocks of %" PetscInt_FMT " columns\n",ctx->bs));
+    else if (ctx->singlepass) PetscCall(PetscViewerASCIIPrintf(viewer,"  single-pass variant\n"));
+    if (ctx->sketch==SVD_RANDOMIZED_SKETCH_SPARSE_SIGN) PetscCall(PetscViewerASCIIPrintf(viewer,"  sparse sign sketch with %" PetscInt_FMT " nonzeros per row\n",ctx->sparsity));
+    if (ctx->npower!=PETSC_DETERMINE) PetscCall(PetscViewerASCIIPrintf(viewer,"  %" PetscInt_FMT " power iterations, orthogonalization every %" PetscInt_FMT "\n",ctx->npower,ctx->orthint));
+    if (ctx->adaptive) PetscCall(PetscViewerASCIIPrintf(viewer,"  adaptive rank determination, adding %" PetscInt_FMT " columns per step\n",ctx->adaptbs));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 SLEPC_EXTERN PetscErrorCode SVDCreate_Randomized(SVD svd)
 {
+  SVD_RANDOMIZED *ctx;
+
   PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  svd->data     = (void*)ctx;
+  ctx->bs       = 64;
+  ctx->sketch   = SVD_RANDOMIZED_SKETCH_GAUSSIAN;
+  ctx->sparsity = 8;
+  ctx->npower   = PETSC_DETERMINE;
+  ctx->orthint  = 1;
+  ctx->adaptbs  = PETSC_DETERMINE;
+
   svd->ops->setup          = SVDSetUp_Randomized;
   svd->ops->solve          = SVDSolve_Randomized;
+  svd->ops->destroy        = SVDDestroy_Randomized;
+  svd->ops->setfromoptions = SVDSetFromOptions_Randomized;
+  svd->ops->view           = SVDView_Randomized;
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetSinglePass_C",SVDRandomizedSetSinglePass_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetSinglePass_C",SVDRandomizedGetSinglePass_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetStream_C",SVDRandomizedSetStream_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetStream_C",SVDRandomizedGetStream_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetSketch_C",SVDRandomizedSetSketch_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetSketch_C",SVDRandomizedGetSketch_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetPowerIterations_C",SVDRandomizedSetPowerIterations_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetPowerIterations_C",SVDRandomizedGetPowerIterations_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedSetAdaptiveRank_C",SVDRandomizedSetAdaptiveRank_Randomized));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDRandomizedGetAdaptiveRank_C",SVDRandomizedGetAdaptiveRank_Randomized));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -15,6 +15,7 @@
    Algorithm:
 
        Golub-Kahan-Lanczos bidiagonalization with thick-restart.
+       Optionally, block bidiagonalization with bs vectors at a time.
 
    References:
 
@@ -26,10 +27,16 @@
            efficient parallel SVD solver based on restarted Lanczos
            bidiagonalization", Elec. Trans. Numer. Anal. 31:68-85,
            2008.
+
+       [3] G.H. Golub, F.T. Luk, and M.L. Overton, "A block Lanczos
+           method for computing the singular values and corresponding
+           singular vectors of a matrix", ACM Trans. Math. Software
+           7(2):149-169, 1981.
 */
 
 #include <slepc/private/svdimpl.h>          /*I "slepcsvd.h" I*/
 #include <slepc/private/bvimpl.h>
+#include <slepc/private/dsimpl.h>
 
 static PetscBool  cited = PETSC_FALSE,citedg = PETSC_FALSE;
 static const char citation[] =
@@ -61,8 +68,16 @@ typedef struct {
   PetscReal           scalef;    /* scale factor for matrix B */
   PetscReal           scaleth;   /* scale threshold for automatic scaling */
   PetscBool           explicitmatrix;
+  PetscInt            bs;        /* block size */
+  PetscBool           fusedmult; /* fused products with A and A^H in one-sided variant */
   /* auxiliary variables */
+  PetscInt            nkeep;     /* number of vectors kept at the last restart */
+  PetscBool           resumed;   /* the state has been loaded from a checkpoint */
+  PetscBool           fused;     /* the fused kernel is used in the current solve */
   Mat                 Z;         /* aux matrix for GSVD, Z=[A;B] */
+  PetscReal           zscalef;   /* scale factor used in the explicit Z */
+  PetscObjectId       zid[2];    /* ids of A and B used in the explicit Z */
+  PetscObjectState    zstate[2]; /* states of A and B used in the explicit Z */
 } SVD_TRLANCZOS;
 
 /* Context for shell matrix [A; B] */
@@ -95,15 +110,36 @@ static PetscErrorCode MatZCreateContext(SVD svd,MatZData **zdata)
    If matrices are swapped, the scale factor is inverted.*/
 static PetscErrorCode MatZUpdateScale(SVD svd)
 {
-  SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
-  MatZData       *zdata;
-  Mat            mats[2],normal;
-  MatType        Atype;
-  PetscBool      sametype;
-  PetscReal      scalef = svd->swapped? 1.0/lanczos->scalef : lanczos->scalef;
+  SVD_TRLANCZOS    *lanczos = (SVD_TRLANCZOS*)svd->data;
+  MatZData         *zdata;
+  Mat              mats[2],normal;
+#if defined(PETSC_USE_COMPLEX)
+  Mat              ZH;
+#endif
+  MatType          Atype;
+  PC               pc;
+  PetscBool        sametype,factor=PETSC_FALSE;
+  PetscObjectId    id[2];
+  PetscObjectState state[2];
+  PetscReal        scalef = svd->swapped? 1.0/lanczos->scalef : lanczos->scalef;
 
   PetscFunctionBegin;
   if (lanczos->explicitmatrix) {
+    /* Keep Z and the setup of the KSP (e.g., a factorization) if nothing has changed */
+    PetscCall(PetscObjectGetId((PetscObject)svd->A,&id[0]));
+    PetscCall(PetscObjectGetId((PetscObject)svd->B,&id[1]));
+    PetscCall(PetscObjectStateGet((PetscObject)svd->A,&state[0]));
+    PetscCall(PetscObjectStateGet((PetscObject)svd->B,&state[1]));
+    if (lanczos->Z && scalef==lanczos->zscalef && id[0]==lanczos->zid[0] && id[1]==lanczos->zid[1] && state[0]==lanczos->zstate[0] && state[1]==lanczos->zstate[1]) {
+      PetscCall(PetscInfo(svd,"Reusing the matrix Z=[A;B] and the setup of the linear solver\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    lanczos->zscalef   = scalef;
+    lanczos->zid[0]    = id[0];
+    lanczos->zid[1]    = id[1];
+    lanczos->zstate[0] = state[0];
+    lanczos->zstate[1] = state[1];
+
     /* Destroy the matrix Z and create it again */
     PetscCall(MatDestroy(&lanczos->Z));
     mats[0] = svd->A;
@@ -124,10 +160,25 @@ static PetscErrorCode MatZUpdateScale(SVD svd)
     zdata->scalef = scalef;
   }
 
-  /* create normal equations matrix, to build the preconditioner in LSQR */
-  PetscCall(MatCreateNormalHermitian(lanczos->Z,&normal));
-
+  /* create normal equations matrix, to build the preconditioner in LSQR; it is
+     formed explicitly for preconditioners that factorize it, such as Cholesky */
   if (!lanczos->ksp) PetscCall(SVDTRLanczosGetKSP(svd,&lanczos->ksp));
+  if (lanczos->explicitmatrix) {
+    PetscCall(KSPGetPC(lanczos->ksp,&pc));
+    PetscCall(PetscObjectTypeCompareAny((PetscObject)pc,&factor,PCCHOLESKY,PCICC,PCLU,PCILU,""));
+  }
+  if (factor) {
+#if defined(PETSC_USE_COMPLEX)
+    PetscCall(MatHermitianTranspose(lanczos->Z,MAT_INITIAL_MATRIX,&ZH));
+    PetscCall(MatMatMult(ZH,lanczos->Z,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&normal));
+    PetscCall(MatDestroy(&ZH));
+#else
+    PetscCall(MatTransposeMatMult(lanczos->Z,lanczos->Z,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&normal));
+#endif
+    PetscCall(MatSetOption(normal,MAT_HERMITIAN,PETSC_TRUE));
+    PetscCall(MatSetOption(normal,MAT_SPD,PETSC_TRUE));
+  } else PetscCall(MatCreateNormalHermitian(lanczos->Z,&normal));
+
   PetscCall(SVD_KSPSetOperators(lanczos->ksp,lanczos->Z,normal));
   PetscCall(KSPSetUp(lanczos->ksp));
   PetscCall(MatDestroy(&normal));
@@ -206,6 +257,7 @@ static PetscErrorCode SVDSetUp_TRLanczos(SVD svd)
   SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
   MatZData       *zdata;
   Mat            aux;
+  BVOrthogType   orthog;
 
   PetscFunctionBegin;
   PetscCall(MatGetSize(svd->A,&M,&N));
@@ -214,8 +266,19 @@ static PetscErrorCode SVDSetUp_TRLanczos(SVD svd)
   PetscCheck(lanczos->lock || svd->mpd>=svd->ncv,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Should not use mpd parameter in non-locking variant");
   if (svd->max_it==PETSC_DETERMINE) svd->max_it = PetscMax(N/svd->ncv,100);
   if (!lanczos->keep) lanczos->keep = 0.5;
+  if (lanczos->bs>1) {
+    PetscCheck(!svd->isgeneralized && !svd->ishyperbolic,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"The block variant is only available for standard SVD problems");
+    PetscCheck(svd->ncv>=svd->nsv+lanczos->bs && svd->mpd>=lanczos->bs,PetscObjectComm((PetscObject)svd),PETSC_ERR_USER_INPUT,"In the block variant, ncv must be at least nsv+bs and mpd at least bs");
+    if (lanczos->oneside) PetscCall(PetscInfo(svd,"The one-sided variant is ignored in the block variant\n"));
+  }
   svd->leftbasis = PETSC_TRUE;
-  PetscCall(SVDAllocateSolution(svd,1));
+  PetscCall(SVDAllocateSolution(svd,lanczos->bs));
+  lanczos->fused = PETSC_FALSE;
+  if (lanczos->fusedmult && lanczos->oneside && lanczos->bs==1 && !svd->isgeneralized && !svd->ishyperbolic) {
+    PetscCall(BVGetOrthogonalization(svd->V,&orthog,NULL,NULL,NULL));
+    if (orthog==BV_ORTHOG_CGS) PetscCall(PetscObjectTypeCompare((PetscObject)svd->A,MATSEQAIJ,&lanczos->fused));
+  }
+  if (lanczos->fusedmult && !lanczos->fused) PetscCall(PetscInfo(svd,"Fused products are only used in the one-sided variant with CGS for a MATSEQAIJ matrix\n"));
   if (svd->isgeneralized) {
     PetscCall(MatGetSize(svd->B,&P,NULL));
     if (lanczos->bidiag == SVD_TRLANCZOS_GBIDIAG_LOWER && ((svd->which==SVD_LARGEST && P<=N) || (svd->which==SVD_SMALLEST && M>N && P<=N))) {
@@ -253,9 +316,9 @@ static PetscErrorCode SVDSetUp_TRLanczos(SVD svd)
   } else if (svd->ishyperbolic) {
     PetscCall(BV_SetMatrixDiagonal(svd->swapped?svd->V:svd->U,svd->omega,svd->OP));
     PetscCall(SVDSetWorkVecs(svd,1,0));
-  }
-  PetscCall(DSSetCompact(svd->ds,PETSC_TRUE));
-  PetscCall(DSSetExtraRow(svd->ds,PETSC_TRUE));
+  } else if (lanczos->fused) PetscCall(SVDSetWorkVecs(svd,0,2));
+  PetscCall(DSSetCompact(svd->ds,lanczos->bs>1? PETSC_FALSE: PETSC_TRUE));
+  PetscCall(DSSetExtraRow(svd->ds,lanczos->bs>1? PETSC_FALSE: PETSC_TRUE));
   PetscCall(DSAllocate(svd->ds,svd->ncv+1));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -354,11 +417,55 @@ static PetscErrorCode SVDOrthogonalizeCGS(BV V,PetscInt i,PetscScalar* h,PetscRe
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes y = A*x and z = A'*y with a single traversal of the nonzeros of a
+   MATSEQAIJ matrix A, instead of one MatMult() and one MatMultHermitianTranspose()
+*/
+static PetscErrorCode SVDTRLanczosMatMult_SeqAIJ(Mat A,Vec x,Vec y,Vec z)
+{
+  PetscInt          i,j,m,n,nz;
+  const PetscInt    *ia,*ja;
+  const PetscScalar *aa,*px;
+  PetscScalar       *py,*pz,s;
+  PetscBool         done;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+  PetscCheck(done,PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Cannot get the row structure of the matrix");
+  PetscCall(MatGetLocalSize(A,NULL,&n));
+  PetscCall(MatSeqAIJGetArrayRead(A,&aa));
+  PetscCall(VecGetArrayRead(x,&px));
+  PetscCall(VecGetArrayWrite(y,&py));
+  PetscCall(VecGetArrayWrite(z,&pz));
+  PetscCall(PetscArrayzero(pz,n));
+  for (i=0;i<m;i++) {
+    s = 0.0;
+    for (j=ia[i];j<ia[i+1];j++) s += aa[j]*px[ja[j]];
+    py[i] = s;
+    for (j=ia[i];j<ia[i+1];j++) pz[ja[j]] += PetscConj(aa[j])*s;
+  }
+  nz = ia[m];
+  PetscCall(VecRestoreArrayWrite(z,&pz));
+  PetscCall(VecRestoreArrayWrite(y,&py));
+  PetscCall(VecRestoreArrayRead(x,&px));
+  PetscCall(MatSeqAIJRestoreArrayRead(A,&aa));
+  PetscCall(MatRestoreRowIJ(A,0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+  PetscCall(PetscLogFlops(4.0*nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   In the one-sided variant with fused products, the vector A'*u_i is not computed
+   with a product, but from the recurrence A'*u_i = A'*A*v_i - b_i*A'*u_{i-1},
+   where A*v_i and A'*A*v_i are obtained with the kernel above. The unnormalized
+   A'*u_{i-1} is kept in svd->workr[0]
+*/
 static PetscErrorCode SVDOneSideTRLanczosCGS(SVD svd,PetscReal *alpha,PetscReal *beta,BV V,BV U,PetscInt nconv,PetscInt l,PetscInt n,PetscScalar* work)
 {
+  SVD_TRLANCZOS      *lanczos = (SVD_TRLANCZOS*)svd->data;
   PetscReal          a,b,eta;
   PetscInt           i,j,k=nconv+l;
-  Vec                ui,ui1,vi;
+  Vec                ui,ui1,vi,w=NULL,z=NULL;
   BVOrthogRefineType refine;
 
   PetscFunctionBegin;
@@ -373,11 +480,19 @@ static PetscErrorCode SVDOneSideTRLanczosCGS(SVD svd,PetscReal *alpha,PetscReal
     PetscCall(BVMultColumn(U,-1.0,1.0,k,work));
   }
   PetscCall(BVGetOrthogonalization(V,NULL,&refine,&eta,NULL));
+  if (lanczos->fused) {
+    w = svd->workr[0];
+    z = svd->workr[1];
+  }
 
   for (i=k+1;i<n;i++) {
     PetscCall(BVGetColumn(V,i,&vi));
     PetscCall(BVGetColumn(U,i-1,&ui1));
-    PetscCall(MatMult(svd->AT,ui1,vi));
+    if (lanczos->fused && i>k+1) PetscCall(VecCopy(w,vi));
+    else {
+      PetscCall(MatMult(svd->AT,ui1,vi));
+      if (lanczos->fused) PetscCall(VecCopy(vi,w));
+    }
     PetscCall(BVRestoreColumn(V,i,&vi));
     PetscCall(BVRestoreColumn(U,i-1,&ui1));
     PetscCall(BVNormColumnBegin(U,i-1,NORM_2,&a));
@@ -406,7 +521,10 @@ static PetscErrorCode SVDOneSideTRLanczosCGS(SVD svd,PetscReal *alpha,PetscReal
     PetscCall(BVGetColumn(V,i,&vi));
     PetscCall(BVGetColumn(U,i,&ui));
     PetscCall(BVGetColumn(U,i-1,&ui1));
-    PetscCall(MatMult(svd->A,vi,ui));
+    if (lanczos->fused) {
+      PetscCall(SVDTRLanczosMatMult_SeqAIJ(svd->A,vi,ui,z));
+      PetscCall(VecAYPX(w,-b/a,z));
+    } else PetscCall(MatMult(svd->A,vi,ui));
     PetscCall(VecAXPY(ui,-b,ui1));
     PetscCall(BVRestoreColumn(V,i,&vi));
     PetscCall(BVRestoreColumn(U,i,&ui));
@@ -418,7 +536,8 @@ static PetscErrorCode SVDOneSideTRLanczosCGS(SVD svd,PetscReal *alpha,PetscReal
 
   PetscCall(BVGetColumn(V,n,&vi));
   PetscCall(BVGetColumn(U,n-1,&ui1));
-  PetscCall(MatMult(svd->AT,ui1,vi));
+  if (lanczos->fused && n>k+1) PetscCall(VecCopy(w,vi));
+  else PetscCall(MatMult(svd->AT,ui1,vi));
   PetscCall(BVRestoreColumn(V,n,&vi));
   PetscCall(BVRestoreColumn(U,n-1,&ui1));
 
@@ -447,6 +566,185 @@ static PetscErrorCode SVDOneSideTRLanczosCGS(SVD svd,PetscReal *alpha,PetscReal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes Y = A*V for the active columns of V and Y, with A being either the
+   matrix or its Hermitian transpose (virtual or explicit)
+*/
+static PetscErrorCode BlockMatMult(BV V,Mat A,BV Y,Mat AT)
+{
+  PetscFunctionBegin;
+  if (!PetscDefined(USE_COMPLEX)) PetscCall(BVMatMult(V,A,Y));
+  else {
+    PetscBool flg=PETSC_FALSE;
+    PetscCall(PetscObjectTypeCompare((PetscObject)A,MATHERMITIANTRANSPOSEVIRTUAL,&flg));
+    if (flg) PetscCall(BVMatMultHermitianTranspose(V,AT,Y));
+    else PetscCall(BVMatMult(V,A,Y));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the block Golub-Kahan-Lanczos bidiagonalization from column m0 up to
+   column nv, where V(:,m0:m0+bs) must be orthonormal. Each step multiplies a block
+   of bs columns by A or A^H at once, and orthogonalizes the new block against all
+   previous columns with the block orthogonalization method of the BV. The
+   coefficients of U^H*A*V are stored in columns m0:nv of the DS matrix A, and the
+   triangular factor of the last block of V is returned in T (of size bs x bs)
+*/
+static PetscErrorCode SVDBlockLanczos(SVD svd,Mat R,PetscInt m0,PetscInt nv,PetscScalar *T)
+{
+  SVD_TRLANCZOS     *lanczos = (SVD_TRLANCZOS*)svd->data;
+  PetscInt          i,j,r,ld,ldr,bs=lanczos->bs;
+  PetscScalar       *A;
+  const PetscScalar *pR;
+
+  PetscFunctionBegin;
+  PetscCall(DSGetLeadingDimension(svd->ds,&ld));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  for (j=m0;j<nv;j+=bs) {
+    /* U(:,j:j+bs) = A*V(:,j:j+bs), orthogonalized against U(:,0:j) */
+    PetscCall(BVSetActiveColumns(svd->V,j,j+bs));
+    PetscCall(BVSetActiveColumns(svd->U,j,j+bs));
+    PetscCall(BlockMatMult(svd->V,svd->A,svd->U,svd->AT));
+    PetscCall(BVOrthogonalize(svd->U,R));
+    PetscCall(MatDenseGetArrayRead(R,&pR));
+    PetscCall(DSGetArray(svd->ds,DS_MAT_A,&A));
+    for (i=0;i<bs;i++) {
+      PetscCall(PetscArrayzero(A+(j+i)*ld,ld));
+      for (r=0;r<j+bs;r++) A[r+(j+i)*ld] = pR[r+(j+i)*ldr];
+    }
+    PetscCall(DSRestoreArray(svd->ds,DS_MAT_A,&A));
+    PetscCall(MatDenseRestoreArrayRead(R,&pR));
+    /* V(:,j+bs:j+2*bs) = A^H*U(:,j:j+bs), orthogonalized against V(:,0:j+bs) */
+    PetscCall(BVSetActiveColumns(svd->V,j+bs,j+2*bs));
+    PetscCall(BlockMatMult(svd->U,svd->AT,svd->V,svd->A));
+    PetscCall(BVOrthogonalize(svd->V,R));
+  }
+  /* the residual of the last block is V(:,nv:nv+bs)*T */
+  PetscCall(MatDenseGetArrayRead(R,&pR));
+  for (i=0;i<bs;i++) {
+    for (r=0;r<bs;r++) T[r+i*bs] = pR[nv+r+(nv+i)*ldr];
+  }
+  PetscCall(MatDenseRestoreArrayRead(R,&pR));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Block variant of the thick-restart method. The projected matrix U^H*A*V is
+   block upper bidiagonal, and after a restart it has the singular values of the
+   kept triplets in the diagonal and the coupling with the next block in the
+   following columns, so it is stored in the dense (non-compact) DS. The relation
+   A*V = U*B holds exactly, and A^H*U = V*B^H + V(:,nv:nv+bs)*[0 T], so the
+   residual norm of a triplet is the norm of T times the last bs entries of its
+   left singular vector of B
+*/
+static PetscErrorCode SVDSolve_TRLanczos_Block(SVD svd)
+{
+  SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
+  PetscScalar    *w,*T,*A,*pU,*x;
+  PetscReal      res;
+  PetscInt       i,j,r,k,l,nv,m0,ld,lmax,bs=lanczos->bs;
+  Mat            U,V,R;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCitationsRegister(citation,&cited));
+  PetscCall(DSGetLeadingDimension(svd->ds,&ld));
+  PetscCall(PetscMalloc3(ld,&w,bs*bs,&T,bs,&x));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,svd->ncv+bs,svd->ncv+bs,NULL,&R));
+
+  /* get the starting block, completing the initial vectors with random ones */
+  for (i=svd->nini;i<bs;i++) PetscCall(BVSetRandomColumn(svd->V,i));
+  PetscCall(BVSetActiveColumns(svd->V,0,bs));
+  PetscCall(BVOrthogonalize(svd->V,NULL));
+  l = 0;
+
+  while (svd->reason == SVD_CONVERGED_ITERATING) {
+    svd->its++;
+
+    /* compute the bidiagonalization with a whole number of blocks */
+    m0 = svd->nconv+l;
+    nv = PetscMin(svd->nconv+svd->mpd,svd->ncv);
+    nv = m0+bs*((nv-m0)/bs);
+    PetscCall(DSSetDimensions(svd->ds,nv,svd->nconv,svd->nconv+l));
+    PetscCall(DSSVDSetDimensions(svd->ds,nv));
+    /* the leading part is diagonal, with the kept singular values */
+    PetscCall(DSGetArray(svd->ds,DS_MAT_A,&A));
+    for (i=svd->nconv;i<m0;i++) {
+      PetscCall(PetscArrayzero(A+i*ld,ld));
+      A[i+i*ld] = svd->sigma[i];
+    }
+    PetscCall(DSRestoreArray(svd->ds,DS_MAT_A,&A));
+    PetscCall(SVDBlockLanczos(svd,R,m0,nv,T));
+    PetscCall(BVSetActiveColumns(svd->V,svd->nconv,nv));
+    PetscCall(BVSetActiveColumns(svd->U,svd->nconv,nv));
+
+    /* solve projected problem */
+    PetscCall(DSSetState(svd->ds,DS_STATE_RAW));
+    PetscCall(DSSolve(svd->ds,w,NULL));
+    PetscCall(DSSort(svd->ds,w,NULL,NULL,NULL,NULL));
+    PetscCall(DSSynchronize(svd->ds,w,NULL));
+    for (i=svd->nconv;i<nv;i++) svd->sigma[i] = PetscRealPart(w[i]);
+
+    /* check convergence, the residual norms are computed from T */
+    if (PetscUnlikely(svd->conv == SVD_CONV_MAXIT && svd->its >= svd->max_it)) k = svd->nsv;
+    else {
+      PetscCall(DSGetArray(svd->ds,DS_MAT_U,&pU));
+      for (k=svd->nconv;k<nv;k++) {
+        for (r=0;r<bs;r++) {
+          x[r] = 0.0;
+          for (j=0;j<bs;j++) x[r] += T[r+j*bs]*pU[nv-bs+j+k*ld];
+        }
+        res = 0.0;
+        for (r=0;r<bs;r++) res += PetscRealPart(x[r]*PetscConj(x[r]));
+        res = PetscSqrtReal(res);
+        PetscCall((*svd->converged)(svd,svd->sigma[k],res,&svd->errest[k],svd->convergedctx));
+        if (svd->errest[k] >= svd->tol) break;
+      }
+      PetscCall(DSRestoreArray(svd->ds,DS_MAT_U,&pU));
+    }
+    PetscCall((*svd->stopping)(svd,svd->its,svd->max_it,k,svd->nsv,&svd->reason,svd->stoppingctx));
+
+    /* update l, leaving room for the next block */
+    if (svd->reason != SVD_CONVERGED_ITERATING || k==nv) l = 0;
+    else {
+      lmax = PetscMin(svd->ncv,k+svd->mpd)-bs-k;
+      l = PetscMin(PetscMax(1,(PetscInt)((nv-k)*lanczos->keep)),lmax);
+    }
+    if (!lanczos->lock && l>0) { l += k; k = 0; } /* non-locking variant: reset no. of converged triplets */
+    if (l) PetscCall(PetscInfo(svd,"Preparing to restart keeping l=%" PetscInt_FMT " vectors\n",l));
+
+    /* compute converged singular vectors and restart vectors */
+    PetscCall(DSGetMat(svd->ds,DS_MAT_V,&V));
+    PetscCall(BVMultInPlace(svd->V,V,svd->nconv,k+l));
+    PetscCall(DSRestoreMat(svd->ds,DS_MAT_V,&V));
+    PetscCall(DSGetMat(svd->ds,DS_MAT_U,&U));
+    PetscCall(BVMultInPlace(svd->U,U,svd->nconv,k+l));
+    PetscCall(DSRestoreMat(svd->ds,DS_MAT_U,&U));
+
+    if (svd->reason == SVD_CONVERGED_ITERATING) {
+      if (l) {
+        /* the next block of V is the residual block */
+        for (i=0;i<bs;i++) PetscCall(BVCopyColumn(svd->V,nv+i,k+l+i));
+      } else {
+        /* start a new bidiagonalization, orthogonal to the converged vectors */
+        PetscCall(PetscInfo(svd,"Starting a new block bidiagonalization (it=%" PetscInt_FMT ")\n",svd->its));
+        for (i=0;i<bs;i++) PetscCall(BVSetRandomColumn(svd->V,k+i));
+        PetscCall(BVSetActiveColumns(svd->V,k,k+bs));
+        PetscCall(BVOrthogonalize(svd->V,NULL));
+      }
+    }
+
+    svd->nconv = k;
+    PetscCall(SVDMonitor(svd,svd->its,svd->nconv,svd->sigma,svd->errest,nv));
+  }
+
+  /* free working space */
+  PetscCall(PetscFree3(w,T,x));
+  PetscCall(MatDestroy(&R));
+  PetscCall(DSTruncate(svd->ds,svd->nconv,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SVDSolve_TRLanczos(SVD svd)
 {
   SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
@@ -458,6 +756,10 @@ static PetscErrorCode SVDSolve_TRLanczos(SVD svd)
   BVOrthogType   orthog;
 
   PetscFunctionBegin;
+  if (lanczos->bs>1) {
+    PetscCall(SVDSolve_TRLanczos_Block(svd));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscCitationsRegister(citation,&cited));
   /* allocate working space */
   PetscCall(DSGetLeadingDimension(svd->ds,&ld));
@@ -465,13 +767,18 @@ static PetscErrorCode SVDSolve_TRLanczos(SVD svd)
   PetscCall(PetscMalloc1(ld,&w));
   if (lanczos->oneside) PetscCall(PetscMalloc1(svd->ncv+1,&swork));
 
-  /* normalize start vector */
-  if (!svd->nini) {
-    PetscCall(BVSetRandomColumn(svd->V,0));
-    PetscCall(BVOrthonormalizeColumn(svd->V,0,PETSC_TRUE,NULL,NULL));
+  /* normalize start vector, unless the state was loaded from a checkpoint */
+  if (lanczos->resumed) {
+    l = lanczos->nkeep;
+    lanczos->resumed = PETSC_FALSE;
+  } else {
+    if (!svd->nini) {
+      PetscCall(BVSetRandomColumn(svd->V,0));
+      PetscCall(BVOrthonormalizeColumn(svd->V,0,PETSC_TRUE,NULL,NULL));
+    }
+    l = 0;
   }
 
-  l = 0;
   while (svd->reason == SVD_CONVERGED_ITERATING) {
     svd->its++;
 
@@ -528,18 +835,21 @@ static PetscErrorCode SVDSolve_TRLanczos(SVD svd)
     PetscCall(BVMultInPlace(svd->V,V,svd->nconv,k+l));
     PetscCall(DSRestoreMat(svd->ds,DS_MAT_V,&V));
     PetscCall(DSGetMat(svd->ds,DS_MAT_U,&U));
-    PetscCall(BVMultInPlace(svd->U,U,svd->nconv,k+l));
+    /* the one-sided recurrence does not use the converged left vectors, only the kept ones */
+    if (lanczos->oneside && svd->valuesonly) PetscCall(BVMultInPlace(svd->U,U,k,k+l));
+    else PetscCall(BVMultInPlace(svd->U,U,svd->nconv,k+l));
     PetscCall(DSRestoreMat(svd->ds,DS_MAT_U,&U));
 
     /* copy the last vector to be the next initial vector */
     if (svd->reason == SVD_CONVERGED_ITERATING && !breakdown) PetscCall(BVCopyColumn(svd->V,nv,k+l));
 
     svd->nconv = k;
+    lanczos->nkeep = l;
     PetscCall(SVDMonitor(svd,svd->its,svd->nconv,svd->sigma,svd->errest,nv));
   }
 
   /* orthonormalize U columns in one side method */
-  if (lanczos->oneside) {
+  if (lanczos->oneside && !svd->valuesonly) {
     for (i=0;i<svd->nconv;i++) PetscCall(BVOrthonormalizeColumn(svd->U,i,PETSC_FALSE,NULL,NULL));
   }
 
@@ -550,6 +860,41 @@ static PetscErrorCode SVDSolve_TRLanczos(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The state at the end of a restart consists of the arrowhead matrix in the DS,
+   the columns 0:nconv+l-1 of U and 0:nconv+l of V, the last one being the next
+   Lanczos vector
+*/
+static PetscErrorCode SVDCheckpoint_TRLanczos(SVD svd,PetscViewer viewer)
+{
+  SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  PetscCheck(svd->problem_type==SVD_STANDARD,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Checkpointing is only available for standard SVD problems");
+  PetscCheck(lanczos->bs==1,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Checkpointing is not available in the block variant");
+  PetscCall(PetscViewerBinaryWrite(viewer,&lanczos->nkeep,1,PETSC_INT));
+  PetscCall(DSViewMatBinary_Private(svd->ds,DS_MAT_T,viewer));
+  PetscCall(BVViewColumns_Private(svd->V,0,svd->nconv+lanczos->nkeep+1,viewer));
+  PetscCall(BVViewColumns_Private(svd->U,0,svd->nconv+lanczos->nkeep,viewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDRestart_TRLanczos(SVD svd,PetscViewer viewer)
+{
+  SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  PetscCheck(svd->problem_type==SVD_STANDARD,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Checkpointing is only available for standard SVD problems");
+  PetscCheck(lanczos->bs==1,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Checkpointing is not available in the block variant");
+  PetscCall(PetscViewerBinaryRead(viewer,&lanczos->nkeep,1,NULL,PETSC_INT));
+  PetscCheck(lanczos->nkeep>=0 && svd->nconv+lanczos->nkeep<svd->ncv,PetscObjectComm((PetscObject)svd),PETSC_ERR_FILE_UNEXPECTED,"Wrong number of kept vectors in the checkpoint");
+  PetscCall(DSLoadMatBinary_Private(svd->ds,DS_MAT_T,viewer));
+  PetscCall(BVLoadColumns_Private(svd->V,0,svd->nconv+lanczos->nkeep+1,viewer));
+  PetscCall(BVLoadColumns_Private(svd->U,0,svd->nconv+lanczos->nkeep,viewer));
+  lanczos->resumed = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SVDLanczosHSVD(SVD svd,PetscReal *alpha,PetscReal *beta,PetscReal *omega,Mat A,Mat AT,BV V,BV U,PetscInt k,PetscInt *n,PetscBool *breakdown)
 {
   PetscInt       i;
@@ -1623,6 +1968,7 @@ static PetscErrorCode SVDSetFromOptions_TRLanczos(SVD svd,PetscOptionItems *Pets
   SVD_TRLANCZOS       *lanczos = (SVD_TRLANCZOS*)svd->data;
   PetscBool           flg,val,lock;
   PetscReal           keep,scale;
+  PetscInt            bs;
   SVDTRLanczosGBidiag bidiag;
 
   PetscFunctionBegin;
@@ -1637,6 +1983,12 @@ static PetscErrorCode SVDSetFromOptions_TRLanczos(SVD svd,PetscOptionItems *Pets
     PetscCall(PetscOptionsBool("-svd_trlanczos_locking","Choose between locking and non-locking variants","SVDTRLanczosSetLocking",PETSC_TRUE,&lock,&flg));
     if (flg) PetscCall(SVDTRLanczosSetLocking(svd,lock));
 
+    PetscCall(PetscOptionsBool("-svd_trlanczos_fusedmult","Use fused products with A and A^H in the one-sided variant","SVDTRLanczosSetFusedMult",lanczos->fusedmult,&val,&flg));
+    if (flg) PetscCall(SVDTRLanczosSetFusedMult(svd,val));
+
+    PetscCall(PetscOptionsInt("-svd_trlanczos_blocksize","Block size of the bidiagonalization","SVDTRLanczosSetBlockSize",lanczos->bs,&bs,&flg));
+    if (flg) PetscCall(SVDTRLanczosSetBlockSize(svd,bs));
+
     PetscCall(PetscOptionsEnum("-svd_trlanczos_gbidiag","Bidiagonalization choice for Generalized Problem","SVDTRLanczosSetGBidiag",SVDTRLanczosGBidiags,(PetscEnum)lanczos->bidiag,(PetscEnum*)&bidiag,&flg));
     if (flg) PetscCall(SVDTRLanczosSetGBidiag(svd,bidiag));
 
@@ -1689,9 +2041,13 @@ static PetscErrorCode SVDTRLanczosSetOneSide_TRLanczos(SVD svd,PetscBool oneside
    One-sided orthogonalization is also available for the GSVD, in which case
    two orthogonalizations out of three are avoided.
 
+   In combination with SVDSetValuesOnly(), the one-sided variant does not
+   update the converged left vectors at restart, since the recurrence only
+   needs the ones that are kept.
+
    Level: advanced
 
-.seealso: SVDLanczosSetOneSide()
+.seealso: SVDLanczosSetOneSide(), SVDSetValuesOnly()
 @*/
 PetscErrorCode SVDTRLanczosSetOneSide(SVD svd,PetscBool oneside)
 {
@@ -2062,6 +2418,7 @@ static PetscErrorCode SVDTRLanczosSetExplicitMatrix_TRLanczos(SVD svd,PetscBool
   PetscFunctionBegin;
   if (lanczos->explicitmatrix != explicitmat) {
     lanczos->explicitmatrix = explicitmat;
+    PetscCall(MatDestroy(&lanczos->Z));
     svd->state = SVD_STATE_INITIAL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -2084,6 +2441,13 @@ static PetscErrorCode SVDTRLanczosSetExplicitMatrix_TRLanczos(SVD svd,PetscBool
    This option is relevant for the GSVD case only.
    Z is the coefficient matrix of the KSP solver used internally.
 
+   With the explicit matrix, a direct solver can be used for the least-squares
+   problems, either a sparse QR of Z (e.g., -svd_trlanczos_pc_type qr) or a
+   Cholesky factorization of Z'*Z (-svd_trlanczos_pc_type cholesky), in which
+   case Z'*Z is also built explicitly. The matrix Z and the setup of the KSP,
+   including the factorization, are kept across restarts and across successive
+   calls to SVDSolve(), as long as A, B and the scale factor do not change.
+
    Level: advanced
 
 .seealso: SVDTRLanczosGetExplicitMatrix()
@@ -2218,6 +2582,184 @@ PetscErrorCode SVDTRLanczosGetScale(SVD svd,PetscReal *scale)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode SVDTRLanczosSetBlockSize_TRLanczos(SVD svd,PetscInt bs)
+{
+  SVD_TRLANCZOS *ctx = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  if (bs == PETSC_DEFAULT || bs == PETSC_DECIDE) bs = 1;
+  else PetscCheck(bs>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The block size must be positive");
+  if (ctx->bs != bs) {
+    ctx->bs = bs;
+    svd->state = SVD_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDTRLanczosSetBlockSize - Sets the block size of the bidiagonalization in
+   the thick-restart Lanczos method.
+
+   Logically Collective
+
+   Input Parameters:
++  svd - the singular value solver
+-  bs  - the block size
+
+   Options Database Key:
+.  -svd_trlanczos_blocksize - Sets the block size
+
+   Notes:
+   With a block size bs larger than one, the block Golub-Kahan-Lanczos
+   bidiagonalization is used, where the matrix and its transpose are applied
+   to bs vectors at once with BVMatMult(), and each new block is orthogonalized
+   against the previous ones with BVOrthogonalize(). The block orthogonalization
+   method can be selected with BVSetOrthogonalization(), for instance with
+   -bv_orthog_block cholqr2 or -bv_orthog_block tsqr. This is usually faster than
+   the variant with bs=1 if multiplying several vectors at once is cheap, and it
+   is also more robust in the case of clustered or multiple singular values.
+
+   The block variant is only available for standard SVD problems. It always
+   uses full two-sided reorthogonalization, and the number of column vectors
+   ncv must be at least nsv+bs.
+
+   Level: advanced
+
+.seealso: SVDTRLanczosGetBlockSize(), SVDSetDimensions(), BVOrthogonalize()
+@*/
+PetscErrorCode SVDTRLanczosSetBlockSize(SVD svd,PetscInt bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveInt(svd,bs,2);
+  PetscTryMethod(svd,"SVDTRLanczosSetBlockSize_C",(SVD,PetscInt),(svd,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDTRLanczosGetBlockSize_TRLanczos(SVD svd,PetscInt *bs)
+{
+  SVD_TRLANCZOS *ctx = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  *bs = ctx->bs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDTRLanczosGetBlockSize - Gets the block size used in the thick-restart
+   Lanczos method.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - the singular value solver
+
+   Output Parameter:
+.  bs - the block size
+
+   Level: advanced
+
+.seealso: SVDTRLanczosSetBlockSize()
+@*/
+PetscErrorCode SVDTRLanczosGetBlockSize(SVD svd,PetscInt *bs)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(bs,2);
+  PetscUseMethod(svd,"SVDTRLanczosGetBlockSize_C",(SVD,PetscInt*),(svd,bs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDTRLanczosSetFusedMult_TRLanczos(SVD svd,PetscBool fused)
+{
+  SVD_TRLANCZOS *ctx = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  if (ctx->fusedmult != fused) {
+    ctx->fusedmult = fused;
+    svd->state     = SVD_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDTRLanczosSetFusedMult - Indicates if the products with the matrix and its
+   transpose must be fused in the one-sided variant of the thick-restart Lanczos
+   method.
+
+   Logically Collective
+
+   Input Parameters:
++  svd   - the singular value solver
+-  fused - true if the products are fused
+
+   Options Database Key:
+.  -svd_trlanczos_fusedmult - Sets the flag
+
+   Notes:
+   In the one-sided variant (see SVDTRLanczosSetOneSide()) with classical
+   Gram-Schmidt, the left Lanczos vectors u_i are not reorthogonalized, so the
+   product A'*u_i can be obtained from the recurrence A'*u_i = A'*A*v_i - b_i*A'*u_{i-1}.
+   If this flag is set, A*v_i and A'*A*v_i are computed with a single traversal
+   of the nonzeros of the matrix, and the product A'*u_i is avoided, so that the
+   matrix is read only once per iteration. This is useful when the cost of the
+   products is dominated by the memory traffic of the matrix.
+
+   Currently, it is only effective for standard problems with a MATSEQAIJ matrix.
+   If the matrix has more columns than rows, its explicit transpose must be used,
+   which is the default (see SVDSetImplicitTranspose()). Otherwise, this flag
+   is ignored. Since the recurrence
+   may amplify rounding errors when a_i is small compared to b_i, the
+   computed residuals should be checked with SVDComputeError().
+
+   Level: advanced
+
+.seealso: SVDTRLanczosGetFusedMult(), SVDTRLanczosSetOneSide()
+@*/
+PetscErrorCode SVDTRLanczosSetFusedMult(SVD svd,PetscBool fused)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveBool(svd,fused,2);
+  PetscTryMethod(svd,"SVDTRLanczosSetFusedMult_C",(SVD,PetscBool),(svd,fused));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SVDTRLanczosGetFusedMult_TRLanczos(SVD svd,PetscBool *fused)
+{
+  SVD_TRLANCZOS *ctx = (SVD_TRLANCZOS*)svd->data;
+
+  PetscFunctionBegin;
+  *fused = ctx->fusedmult;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDTRLanczosGetFusedMult - Returns the flag indicating whether the products
+   with the matrix and its transpose are fused in the one-sided variant of the
+   thick-restart Lanczos method.
+
+   Not Collective
+
+   Input Parameter:
+.  svd - the singular value solver
+
+   Output Parameter:
+.  fused - the flag
+
+   Level: advanced
+
+.seealso: SVDTRLanczosSetFusedMult()
+@*/
+PetscErrorCode SVDTRLanczosGetFusedMult(SVD svd,PetscBool *fused)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(fused,2);
+  PetscUseMethod(svd,"SVDTRLanczosGetFusedMult_C",(SVD,PetscBool*),(svd,fused));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SVDReset_TRLanczos(SVD svd)
 {
   SVD_TRLANCZOS  *lanczos = (SVD_TRLANCZOS*)svd->data;
@@ -2251,6 +2793,10 @@ static PetscErrorCode SVDDestroy_TRLanczos(SVD svd)
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetExplicitMatrix_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetScale_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetScale_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetBlockSize_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetBlockSize_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetFusedMult_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetFusedMult_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -2280,7 +2826,11 @@ static PetscErrorCode SVDView_TRLanczos(SVD svd,PetscViewer viewer)
       PetscCall(PetscViewerASCIIPushTab(viewer));
       PetscCall(KSPView(lanczos->ksp,viewer));
       PetscCall(PetscViewerASCIIPopTab(viewer));
-    } else PetscCall(PetscViewerASCIIPrintf(viewer,"  %s-sided reorthogonalization\n",lanczos->oneside? "one": "two"));
+    } else if (lanczos->bs>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  block bidiagonalization with block size %" PetscInt_FMT "\n",lanczos->bs));
+    else {
+      PetscCall(PetscViewerASCIIPrintf(viewer,"  %s-sided reorthogonalization\n",lanczos->oneside? "one": "two"));
+      if (lanczos->fusedmult) PetscCall(PetscViewerASCIIPrintf(viewer,"  using fused products with A and A^H\n"));
+    }
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2309,6 +2859,7 @@ SLEPC_EXTERN PetscErrorCode SVDCreate_TRLanczos(SVD svd)
   ctx->bidiag  = SVD_TRLANCZOS_GBIDIAG_LOWER;
   ctx->scalef  = 1.0;
   ctx->scaleth = 0.0;
+  ctx->bs      = 1;
 
   svd->ops->setup          = SVDSetUp_TRLanczos;
   svd->ops->solve          = SVDSolve_TRLanczos;
@@ -2319,6 +2870,8 @@ SLEPC_EXTERN PetscErrorCode SVDCreate_TRLanczos(SVD svd)
   svd->ops->setfromoptions = SVDSetFromOptions_TRLanczos;
   svd->ops->view           = SVDView_TRLanczos;
   svd->ops->setdstype      = SVDSetDSType_TRLanczos;
+  svd->ops->checkpoint     = SVDCheckpoint_TRLanczos;
+  svd->ops->restart        = SVDRestart_TRLanczos;
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetOneSide_C",SVDTRLanczosSetOneSide_TRLanczos));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetOneSide_C",SVDTRLanczosGetOneSide_TRLanczos));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetGBidiag_C",SVDTRLanczosSetGBidiag_TRLanczos));
@@ -2333,5 +2886,9 @@ SLEPC_EXTERN PetscErrorCode SVDCreate_TRLanczos(SVD svd)
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetExplicitMatrix_C",SVDTRLanczosGetExplicitMatrix_TRLanczos));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetScale_C",SVDTRLanczosSetScale_TRLanczos));
   PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetScale_C",SVDTRLanczosGetScale_TRLanczos));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetBlockSize_C",SVDTRLanczosSetBlockSize_TRLanczos));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetBlockSize_C",SVDTRLanczosGetBlockSize_TRLanczos));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosSetFusedMult_C",SVDTRLanczosSetFusedMult_TRLanczos));
+  PetscCall(PetscObjectComposeFunction((PetscObject)svd,"SVDTRLanczosGetFusedMult_C",SVDTRLanczosGetFusedMult_TRLanczos));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -17,6 +17,7 @@ const char *SVDErrorTypes[] = {"ABSOLUTE","RELATIVE","SVDErrorType","SVD_ERROR_"
 const char *SVDPRIMMEMethods[] = {"","HYBRID","NORMALEQUATIONS","AUGMENTED","SVDPRIMMEMethod","SVD_PRIMME_",NULL};
 const char *SVDKSVDEigenMethods[] = {"","MRRR","DC","ELPA","SVDKSVDEigenMethod","SVD_KSVD_EIGEN_",NULL};
 const char *SVDKSVDPolarMethods[] = {"","QDWH","ZOLOPD","SVDKSVDPolarMethod","SVD_KSVD_POLAR_",NULL};
+const char *SVDRandomizedSketchTypes[] = {"GAUSSIAN","SPARSE_SIGN","SVDRandomizedSketchType","SVD_RANDOMIZED_SKETCH_",NULL};
 const char *const SVDConvergedReasons_Shifted[] = {"","DIVERGED_SYMMETRY_LOST","DIVERGED_BREAKDOWN","DIVERGED_ITS","CONVERGED_ITERATING","CONVERGED_TOL","CONVERGED_USER","CONVERGED_MAXIT","SVDConvergedReason","SVD_",NULL};
 const char *const*SVDConvergedReasons = SVDConvergedReasons_Shifted + 4;
 
@@ -68,6 +69,8 @@ PetscErrorCode SVDInitializePackage(void)
   /* Register Events */
   PetscCall(PetscLogEventRegister("SVDSetUp",SVD_CLASSID,&SVD_SetUp));
   PetscCall(PetscLogEventRegister("SVDSolve",SVD_CLASSID,&SVD_Solve));
+  /* Register composed data, here rather than on first use so that threads do not race for it */
+  if (SVDTransposeStateId<0) PetscCall(PetscObjectComposedDataRegister(&SVDTransposeStateId));
   /* Process Info */
   classids[0] = SVD_CLASSID;
   PetscCall(PetscInfoProcessClass("svd",1,&classids[0]));
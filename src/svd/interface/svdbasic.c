@@ -69,6 +69,7 @@ PetscErrorCode SVDCreate(MPI_Comm comm,SVD *outsvd)
   svd->which            = SVD_LARGEST;
   svd->problem_type     = (SVDProblemType)0;
   svd->impltrans        = PETSC_FALSE;
+  svd->valuesonly       = PETSC_FALSE;
   svd->trackall         = PETSC_FALSE;
 
   svd->converged        = NULL;
@@ -135,6 +136,9 @@ PetscErrorCode SVDReset(SVD svd)
   if (svd) PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
   if (!svd) PetscFunctionReturn(PETSC_SUCCESS);
   PetscTryTypeMethod(svd,reset);
+  PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->A));
+  PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->AT));
+  PetscCall(SVDReleaseExplicitTranspose_Private(svd->OPb,svd->BT));
   PetscCall(MatDestroy(&svd->OP));
   PetscCall(MatDestroy(&svd->OPb));
   PetscCall(VecDestroy(&svd->omega));
@@ -180,6 +184,7 @@ PetscErrorCode SVDDestroy(SVD *svd)
   /* just in case the initial vectors have not been used */
   PetscCall(SlepcBasisDestroy_Private(&(*svd)->nini,&(*svd)->IS));
   PetscCall(SlepcBasisDestroy_Private(&(*svd)->ninil,&(*svd)->ISL));
+  PetscCall(PetscViewerDestroy(&(*svd)->rstviewer));
   PetscCall(SVDMonitorCancel(*svd));
   PetscCall(PetscHeaderDestroy(svd));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -0,0 +1,159 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SVD routines related to the solution of many independent problems
+*/
+
+#include <slepc/private/svdimpl.h>       /*I "slepcsvd.h" I*/
+
+/*
+   Transfers the configuration of the template svd to the svd that solves the problems
+*/
+static PetscErrorCode SVDBatchCopySettings(SVD svd,SVD child)
+{
+  const char *prefix;
+  SVDType    type;
+
+  PetscFunctionBegin;
+  PetscCall(SVDGetType(svd,&type));
+  if (type) PetscCall(SVDSetType(child,type));
+  if (svd->problem_type) PetscCall(SVDSetProblemType(child,svd->problem_type));
+  PetscCall(SVDSetWhichSingularTriplets(child,svd->which));
+  PetscCall(SVDSetDimensions(child,svd->nsv,svd->ncv,svd->mpd));
+  PetscCall(SVDSetTolerances(child,svd->tol,svd->max_it));
+  if (svd->conv!=SVD_CONV_USER) PetscCall(SVDSetConvergenceTest(child,svd->conv));
+  PetscCall(SVDSetImplicitTranspose(child,svd->impltrans));
+  PetscCall(SVDSetValuesOnly(child,svd->valuesonly));
+  PetscCall(SVDSetTrackAll(child,svd->trackall));
+  PetscCall(SVDGetOptionsPrefix(svd,&prefix));
+  PetscCall(SVDSetOptionsPrefix(child,prefix));
+  PetscCall(SVDSetFromOptions(child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Gets the index of the next problem to be solved by this partition, from a
+   counter in the first process that is incremented by the partition leaders
+*/
+static PetscErrorCode SVDBatchNext(MPI_Win win,PetscSubcomm subc,PetscInt *i)
+{
+  PetscInt    next;
+  PetscMPIInt rank;
+  MPI_Comm    child;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSubcommGetChild(subc,&child));
+  PetscCallMPI(MPI_Comm_rank(child,&rank));
+  if (!rank) {
+    PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,0,0,win));
+    PetscCallMPI(MPI_Get(i,1,MPIU_INT,0,0,1,MPIU_INT,win));
+    PetscCallMPI(MPI_Win_flush(0,win));
+    next = *i+1;
+    PetscCallMPI(MPI_Put(&next,1,MPIU_INT,0,0,1,MPIU_INT,win));
+    PetscCallMPI(MPI_Win_unlock(0,win));
+  }
+  PetscCallMPI(MPI_Bcast(i,1,MPIU_INT,0,child));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   SVDSolveBatch - Solves a collection of independent singular value problems,
+   all of them with the same solver configuration.
+
+   Collective
+
+   Input Parameters:
++  svd    - the singular value solver context, used as a template
+.  nprob  - number of problems
+.  npart  - number of partitions of the communicator
+.  getops - function that creates the matrices of each problem, see SVDBatchOperatorsFn
+.  result - function that retrieves the solution of each problem, see SVDBatchResultFn
+-  ctx    - [optional] user-defined context passed to both functions (may be NULL)
+
+   Notes:
+   The communicator of svd is split in npart partitions of contiguous processes,
+   and each partition creates a single SVD object that is reused for all the
+   problems it solves, so that the overhead of creating and configuring a solver
+   for each problem is avoided, as well as the allocation of the workspace when
+   consecutive problems have the same size. The problems are assigned to the
+   partitions dynamically, each one taking the next pending problem when it
+   finishes the previous one. For many small matrices, npart should be equal to
+   the number of processes, so that each problem is solved sequentially.
+
+   The configuration of the template svd (solver type, problem type, dimensions,
+   tolerances, etc.) is copied to the svd of each partition, which is also
+   configured from the options database with the same prefix. The template svd
+   does not need to have matrices.
+
+   The function getops is called by all processes of a partition with the
+   svd that will solve problem i, and it must create the matrices on the
+   communicator of that svd (PetscObjectComm((PetscObject)svd)). The matrices
+   are destroyed after the solve, so the caller should not destroy them. In
+   hyperbolic problems, the signature can be set in getops with SVDSetSignature().
+   After the solve, result is called in the same way, and it can retrieve any
+   data of the solution with the usual functions such as SVDGetSingularTriplet().
+
+   Level: advanced
+
+.seealso: SVDSolve(), SVDBatchOperatorsFn, SVDBatchResultFn, EPSSolveBatch()
+@*/
+PetscErrorCode SVDSolveBatch(SVD svd,PetscInt nprob,PetscInt npart,SVDBatchOperatorsFn *getops,SVDBatchResultFn *result,void *ctx)
+{
+  SVD          child;
+  PetscSubcomm subc=NULL;
+  PetscMPIInt  size,rank;
+  PetscInt     i,counter=0;
+  MPI_Comm     comm;
+  MPI_Win      win=MPI_WIN_NULL;
+  Mat          A,B;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveInt(svd,nprob,2);
+  PetscValidLogicalCollectiveInt(svd,npart,3);
+  PetscCheck(nprob>=0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The number of problems cannot be negative");
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)svd),&size));
+  PetscCheck(npart>0 && npart<=size,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The number of partitions must be between 1 and %d",(int)size);
+
+  /* create the svd of this partition */
+  if (npart>1) {
+    PetscCall(PetscSubcommCreate(PetscObjectComm((PetscObject)svd),&subc));
+    PetscCall(PetscSubcommSetNumber(subc,npart));
+    PetscCall(PetscSubcommSetType(subc,PETSC_SUBCOMM_CONTIGUOUS));
+    PetscCall(PetscSubcommGetChild(subc,&comm));
+    PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)svd),&rank));
+    PetscCallMPI(MPI_Win_create(&counter,(MPI_Aint)(rank?0:sizeof(PetscInt)),(PetscMPIInt)sizeof(PetscInt),MPI_INFO_NULL,PetscObjectComm((PetscObject)svd),&win));
+  } else comm = PetscObjectComm((PetscObject)svd);
+  PetscCall(SVDCreate(comm,&child));
+  PetscCall(SVDBatchCopySettings(svd,child));
+
+  /* solve the problems, one at a time in each partition */
+  if (npart>1) PetscCall(SVDBatchNext(win,subc,&i));
+  else i = 0;
+  while (i<nprob) {
+    A = NULL; B = NULL;
+    PetscCall((*getops)(child,i,&A,&B,ctx));
+    PetscCheck(A,comm,PETSC_ERR_USER,"The operators function did not create a matrix for problem %" PetscInt_FMT,i);
+    PetscCall(SVDSetOperators(child,A,B));
+    PetscCall(MatDestroy(&A));
+    PetscCall(MatDestroy(&B));
+    PetscCall(SVDSolve(child));
+    if (result) PetscCall((*result)(child,i,ctx));
+    if (npart>1) PetscCall(SVDBatchNext(win,subc,&i));
+    else i++;
+  }
+
+  PetscCall(SVDDestroy(&child));
+  if (npart>1) {
+    PetscCallMPI(MPI_Win_free(&win));
+    PetscCall(PetscSubcommDestroy(&subc));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -316,6 +316,55 @@ PetscErrorCode SVDMonitorConvergedDestroy(PetscViewerAndFormat **vf)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   SVDMonitorAllBinary - Records the current approximate values and error estimates
+   at each iteration of the singular value solver in memory, and writes them to a binary file
+   when the monitor is destroyed.
+
+   Collective
+
+   Input Parameters:
++  svd    - singular value solver context
+.  its    - iteration number
+.  nconv  - number of converged singular triplets so far
+.  sigma  - singular values
+.  errest - error estimates
+.  nest   - number of error estimates to display
+-  vf     - viewer and format for monitoring
+
+   Options Database Keys:
++  -svd_monitor_all binary:filename - activates SVDMonitorAllBinary()
+-  -svd_monitor_history_size <n> - number of iterations kept in memory
+
+   Notes:
+   Nothing is written during the iteration, so this monitor has a negligible cost
+   compared to SVDMonitorAll() when many iterations or many processes are involved.
+   Only the last n iterations are kept (1000 by default), older ones are overwritten.
+
+   The file is written when the monitor is cancelled, e.g., in SVDDestroy(). It contains
+   the number of stored iterations, and for each of them the iteration number, the number
+   of converged values, the number of values nest, a time stamp in seconds relative to
+   the first iteration, the nest real and imaginary parts of the singular values and the
+   nest error estimates, as written by PetscViewerBinaryWrite().
+
+   Level: intermediate
+
+.seealso: SVDMonitorSet(), SVDMonitorAll()
+@*/
+PetscErrorCode SVDMonitorAllBinary(SVD svd,PetscInt its,PetscInt nconv,PetscReal *sigma,PetscReal *errest,PetscInt nest,PetscViewerAndFormat *vf)
+{
+  PetscInt    i,n;
+  PetscScalar *er,*ei;
+  PetscReal   *err;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidHeaderSpecific(vf->viewer,PETSC_VIEWER_CLASSID,7);
+  PetscCall(SlepcHistMonGetSlot_Private((PetscObject)svd,"-svd_monitor_history_size",svd->ncv,its,nconv,nest,vf,&n,&er,&ei,&err));
+  for (i=0;i<n;i++) { er[i] = sigma[i]; err[i] = errest[i]; }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    SVDMonitorFirstDrawLG - Plots the error estimate of the first unconverged
    approximation at each iteration of the singular value solver.
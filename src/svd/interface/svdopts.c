@@ -29,7 +29,10 @@
 
    Notes:
    By default, the transpose of the matrix is explicitly built (if the matrix
-   has defined the MatTranspose operation).
+   has defined the MatTranspose operation). The explicit transpose is built only
+   once and shared by all SVD objects that have the same matrix, as long as the
+   matrix is not modified, and it is freed when the last of them is reset or
+   destroyed.
 
    If this flag is set to true, the solver does not build the transpose, but
    handles it implicitly via MatMultTranspose() (or MatMultHermitianTranspose()
@@ -78,6 +81,73 @@ PetscErrorCode SVDGetImplicitTranspose(SVD svd,PetscBool *impl)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   SVDSetValuesOnly - Indicates that only the singular values are required,
+   so that the singular vectors need not be computed or stored.
+
+   Logically Collective
+
+   Input Parameters:
++  svd  - the singular value solver context
+-  flg  - whether only singular values are required
+
+   Options Database Key:
+.  -svd_values_only - Compute only the singular values.
+
+   Notes:
+   This is useful when the singular values are needed for norm or condition
+   number estimates, and the storage of the singular vectors would be a
+   significant fraction of the memory. In this mode, solvers that would only
+   fill the left basis at the end (such as SVDCYCLIC or SVDLAPACK) do not
+   allocate it, the one-sided variant of SVDTRLANCZOS only updates the columns
+   of the left basis that are needed to restart, and the singular vectors are
+   never formed.
+
+   After SVDSolve(), SVDGetSingularTriplet() can be called only to retrieve the
+   singular values, and the errors reported by SVDErrorView() are the
+   estimates used by the solver, see SVDGetErrorEstimate().
+
+   Level: intermediate
+
+.seealso: SVDGetValuesOnly(), SVDGetSingularTriplet(), SVDGetErrorEstimate()
+@*/
+PetscErrorCode SVDSetValuesOnly(SVD svd,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveBool(svd,flg,2);
+  if (svd->valuesonly!=flg) {
+    svd->valuesonly = flg;
+    svd->state      = SVD_STATE_INITIAL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDGetValuesOnly - Returns the flag indicating whether only the singular
+   values are required.
+
+   Not Collective
+
+   Input Parameter:
+.  svd  - the singular value solver context
+
+   Output Parameter:
+.  flg  - whether only singular values are required
+
+   Level: intermediate
+
+.seealso: SVDSetValuesOnly()
+@*/
+PetscErrorCode SVDGetValuesOnly(SVD svd,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(flg,2);
+  *flg = svd->valuesonly;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDSetTolerances - Sets the tolerance and maximum
    iteration count used by the default SVD convergence testers.
@@ -634,6 +704,9 @@ PetscErrorCode SVDSetFromOptions(SVD svd)
     PetscCall(PetscOptionsBool("-svd_implicittranspose","Handle matrix transpose implicitly","SVDSetImplicitTranspose",svd->impltrans,&val,&flg));
     if (flg) PetscCall(SVDSetImplicitTranspose(svd,val));
 
+    PetscCall(PetscOptionsBool("-svd_values_only","Compute only the singular values","SVDSetValuesOnly",svd->valuesonly,&val,&flg));
+    if (flg) PetscCall(SVDSetValuesOnly(svd,val));
+
     i = svd->max_it;
     PetscCall(PetscOptionsInt("-svd_max_it","Maximum number of iterations","SVDSetTolerances",svd->max_it,&i,&flg1));
     r = svd->tol;
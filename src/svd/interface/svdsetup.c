@@ -13,6 +13,52 @@
 
 #include <slepc/private/svdimpl.h>      /*I "slepcsvd.h" I*/
 
+PetscInt SVDTransposeStateId = -1;
+
+/*
+   SVDGetExplicitTranspose_Private - Gets the explicit Hermitian transpose of op, which
+   is shared by all SVD objects with the same matrix. It is composed with op when it is
+   built for the first time, and reused as long as op has not been modified.
+*/
+PetscErrorCode SVDGetExplicitTranspose_Private(Mat op,Mat *T)
+{
+  PetscInt  valid=0;
+  PetscBool flg=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (SVDTransposeStateId<0) PetscCall(PetscObjectComposedDataRegister(&SVDTransposeStateId));
+  PetscCall(PetscObjectQuery((PetscObject)op,"SVDExplicitTranspose",(PetscObject*)T));
+  if (*T) PetscCall(PetscObjectComposedDataGetInt((PetscObject)op,SVDTransposeStateId,valid,flg));
+  if (*T && flg && valid) PetscCall(PetscObjectReference((PetscObject)*T));
+  else {
+    if (*T) PetscCall(PetscInfo(op,"The matrix has been modified, the explicit transpose is built again\n"));
+    PetscCall(MatHermitianTranspose(op,MAT_INITIAL_MATRIX,T));
+    PetscCall(PetscObjectCompose((PetscObject)op,"SVDExplicitTranspose",(PetscObject)*T));
+    PetscCall(PetscObjectComposedDataSetInt((PetscObject)op,SVDTransposeStateId,1));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SVDReleaseExplicitTranspose_Private - Must be called before destroying a matrix T that
+   may have been obtained with SVDGetExplicitTranspose_Private(). If the only remaining
+   reference is the one of op, it is removed so that the transpose is freed.
+*/
+PetscErrorCode SVDReleaseExplicitTranspose_Private(Mat op,Mat T)
+{
+  Mat      C=NULL;
+  PetscInt cnt;
+
+  PetscFunctionBegin;
+  if (!op || !T) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectQuery((PetscObject)op,"SVDExplicitTranspose",(PetscObject*)&C));
+  if (C==T) {
+    PetscCall(PetscObjectGetReference((PetscObject)T,&cnt));
+    if (cnt<=2) PetscCall(PetscObjectCompose((PetscObject)op,"SVDExplicitTranspose",NULL));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDSetOperators - Set the matrices associated with the singular value problem.
 
@@ -63,6 +109,9 @@ PetscErrorCode SVDSetOperators(SVD svd,Mat A,Mat B)
   if (B) PetscCall(PetscObjectReference((PetscObject)B));
   if (svd->state && !samesize) PetscCall(SVDReset(svd));
   else {
+    PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->A));
+    PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->AT));
+    PetscCall(SVDReleaseExplicitTranspose_Private(svd->OPb,svd->BT));
     PetscCall(MatDestroy(&svd->OP));
     PetscCall(MatDestroy(&svd->OPb));
     PetscCall(MatDestroy(&svd->A));
@@ -278,6 +327,12 @@ PetscErrorCode SVDSetUp(SVD svd)
       PetscCall(PetscObjectTypeCompareAny((PetscObject)svd,&flg,SVDLAPACK,SVDSCALAPACK,SVDKSVD,SVDELEMENTAL,""));
       if (flg) svd->expltrans = PETSC_FALSE;
     }
+    /* in the 2D block-cyclic layout, the product by the transpose is as cheap as the product by the matrix */
+    PetscCall(PetscObjectTypeCompare((PetscObject)svd->OP,MATSCALAPACK,&flg));
+    if (flg && svd->expltrans) {
+      PetscCall(PetscInfo(svd,"Using the implicit transpose of the MATSCALAPACK operator\n"));
+      svd->expltrans = PETSC_FALSE;
+    }
   }
 
   /* get matrix dimensions */
@@ -293,16 +348,18 @@ PetscErrorCode SVDSetUp(SVD svd)
     PetscCheck(nom==m,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_SIZ,"Local size of signature (%" PetscInt_FMT ") does not match the local row size of A (%" PetscInt_FMT ")",nom,m);
   }
 
-  /* build transpose matrix */
+  /* build transpose matrix, the explicit one is shared with other SVD objects */
+  PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->A));
+  PetscCall(SVDReleaseExplicitTranspose_Private(svd->OP,svd->AT));
   PetscCall(MatDestroy(&svd->A));
   PetscCall(MatDestroy(&svd->AT));
   PetscCall(PetscObjectReference((PetscObject)svd->OP));
   if (svd->expltrans) {
     if (svd->isgeneralized || M>=N) {
       svd->A = svd->OP;
-      PetscCall(MatHermitianTranspose(svd->OP,MAT_INITIAL_MATRIX,&svd->AT));
+      PetscCall(SVDGetExplicitTranspose_Private(svd->OP,&svd->AT));
     } else {
-      PetscCall(MatHermitianTranspose(svd->OP,MAT_INITIAL_MATRIX,&svd->A));
+      PetscCall(SVDGetExplicitTranspose_Private(svd->OP,&svd->A));
       svd->AT = svd->OP;
     }
   } else {
@@ -317,12 +374,13 @@ PetscErrorCode SVDSetUp(SVD svd)
 
   /* build transpose matrix B for GSVD */
   if (svd->isgeneralized) {
+    PetscCall(SVDReleaseExplicitTranspose_Private(svd->OPb,svd->BT));
     PetscCall(MatDestroy(&svd->B));
     PetscCall(MatDestroy(&svd->BT));
     PetscCall(PetscObjectReference((PetscObject)svd->OPb));
     if (svd->expltrans) {
       svd->B = svd->OPb;
-      PetscCall(MatHermitianTranspose(svd->OPb,MAT_INITIAL_MATRIX,&svd->BT));
+      PetscCall(SVDGetExplicitTranspose_Private(svd->OPb,&svd->BT));
     } else {
       svd->B = svd->OPb;
       PetscCall(MatCreateHermitianTranspose(svd->OPb,&svd->BT));
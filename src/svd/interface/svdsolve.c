@@ -77,11 +77,38 @@ PetscErrorCode SVDComputeVectors(SVD svd)
 {
   PetscFunctionBegin;
   SVDCheckSolved(svd,1);
+  PetscCheck(!svd->valuesonly,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_WRONGSTATE,"The singular vectors are not available, since only singular values were requested with SVDSetValuesOnly()");
   if (svd->state==SVD_STATE_SOLVED) PetscTryTypeMethod(svd,computevectors);
   svd->state = SVD_STATE_VECTORS;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   SVDLoadCheckpoint_Private - Reads the solver state from the viewer given in
+   SVDRestart(). The generic part is read here, the rest by the solver.
+*/
+static PetscErrorCode SVDLoadCheckpoint_Private(SVD svd)
+{
+  PetscInt       header[6],M,N;
+
+  PetscFunctionBegin;
+  PetscCheck(svd->ops->restart,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"This solver does not support restarting from a checkpoint");
+  PetscCall(MatGetSize(svd->A,&M,&N));
+  PetscCall(PetscViewerBinaryRead(svd->rstviewer,header,6,NULL,PETSC_INT));
+  PetscCheck(header[0]==SVD_CLASSID,PetscObjectComm((PetscObject)svd),PETSC_ERR_FILE_UNEXPECTED,"The file does not contain an SVD checkpoint");
+  PetscCheck(header[1]==M && header[2]==N && header[3]==svd->ncv,PetscObjectComm((PetscObject)svd),PETSC_ERR_FILE_UNEXPECTED,"The checkpoint was saved for a problem of size %" PetscInt_FMT "x%" PetscInt_FMT " with ncv=%" PetscInt_FMT ", but the current values are %" PetscInt_FMT "x%" PetscInt_FMT " and %" PetscInt_FMT,header[1],header[2],header[3],M,N,svd->ncv);
+  svd->its   = header[4];
+  svd->nconv = header[5];
+  if (svd->nconv) {
+    PetscCall(PetscViewerBinaryRead(svd->rstviewer,svd->sigma,svd->nconv,NULL,PETSC_REAL));
+    PetscCall(PetscViewerBinaryRead(svd->rstviewer,svd->errest,svd->nconv,NULL,PETSC_REAL));
+  }
+  PetscUseTypeMethod(svd,restart,svd->rstviewer);
+  PetscCall(PetscInfo(svd,"Restarting from a checkpoint at iteration %" PetscInt_FMT " with %" PetscInt_FMT " converged triplets\n",svd->its,svd->nconv));
+  PetscCall(PetscViewerDestroy(&svd->rstviewer));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDSolve - Solves the singular value problem.
 
@@ -109,9 +136,12 @@ PetscErrorCode SVDComputeVectors(SVD svd)
    singular values graphically, or '-svd_error_relative :myerr.m:ascii_matlab' to save
    the errors in a file that can be executed in Matlab.
 
+   If SVDRestart() has been called before, the solver resumes the computation
+   from the state saved with SVDCheckpoint().
+
    Level: beginner
 
-.seealso: SVDCreate(), SVDSetUp(), SVDDestroy()
+.seealso: SVDCreate(), SVDSetUp(), SVDDestroy(), SVDRestart()
 @*/
 PetscErrorCode SVDSolve(SVD svd)
 {
@@ -120,6 +150,7 @@ PetscErrorCode SVDSolve(SVD svd)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
   if (svd->state>=SVD_STATE_SOLVED) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(SlepcPerfStatsBegin_Private(SVD_Solve,SVD_SetUp,svd->perf));
   PetscCall(PetscLogEventBegin(SVD_Solve,svd,0,0,0));
 
   /* call setup */
@@ -131,6 +162,7 @@ PetscErrorCode SVDSolve(SVD svd)
     svd->errest[i] = 0.0;
     svd->perm[i]   = i;
   }
+  if (svd->rstviewer) PetscCall(SVDLoadCheckpoint_Private(svd));
   PetscCall(SVDViewFromOptions(svd,NULL,"-svd_view_pre"));
 
   switch (svd->problem_type) {
@@ -156,6 +188,7 @@ PetscErrorCode SVDSolve(SVD svd)
     PetscCall(PetscFree(workperm));
   }
   PetscCall(PetscLogEventEnd(SVD_Solve,svd,0,0,0));
+  PetscCall(SlepcPerfStatsEnd_Private(SVD_Solve,SVD_SetUp,svd->perf));
 
   /* various viewers */
   PetscCall(SVDViewFromOptions(svd,NULL,"-svd_view"));
@@ -173,6 +206,99 @@ PetscErrorCode SVDSolve(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   SVDCheckpoint - Saves the current state of the solver, so that the
+   computation can be resumed later with SVDRestart().
+
+   Collective
+
+   Input Parameters:
++  svd    - the singular value solver context
+-  viewer - a binary viewer opened for writing
+
+   Notes:
+   This function must be called during SVDSolve(), typically from a monitor
+   function (see SVDMonitorSet()), which is invoked at the end of each restart
+   of the solver. The saved state includes the iteration counter, the converged
+   singular values, the projected problem and the basis vectors needed to resume
+   the iteration.
+
+   The basis vectors are written one by one, so parallel MPI-IO can be used by
+   enabling it in the viewer with PetscViewerBinarySetUseMPIIO() or the option
+   -viewer_binary_mpiio.
+
+   Currently this is supported only in SVDTRLANCZOS for standard problems.
+
+   Level: advanced
+
+.seealso: SVDRestart(), SVDMonitorSet(), SVDSolve()
+@*/
+PetscErrorCode SVDCheckpoint(SVD svd,PetscViewer viewer)
+{
+  PetscInt       header[6];
+  PetscBool      isbinary;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+  PetscCheckSameComm(svd,1,viewer,2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCheck(isbinary,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Only binary viewers are supported");
+  PetscCheck(svd->state==SVD_STATE_SETUP && svd->reason==SVD_CONVERGED_ITERATING,PetscObjectComm((PetscObject)svd),PETSC_ERR_ORDER,"SVDCheckpoint() must be called during SVDSolve()");
+  PetscCheck(svd->ops->checkpoint,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"This solver does not support checkpointing");
+  header[0] = SVD_CLASSID;
+  PetscCall(MatGetSize(svd->A,&header[1],&header[2]));
+  header[3] = svd->ncv;
+  header[4] = svd->its;
+  header[5] = svd->nconv;
+  PetscCall(PetscViewerBinaryWrite(viewer,header,6,PETSC_INT));
+  if (svd->nconv) {
+    PetscCall(PetscViewerBinaryWrite(viewer,svd->sigma,svd->nconv,PETSC_REAL));
+    PetscCall(PetscViewerBinaryWrite(viewer,svd->errest,svd->nconv,PETSC_REAL));
+  }
+  PetscUseTypeMethod(svd,checkpoint,viewer);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDRestart - Specifies a checkpoint saved with SVDCheckpoint(), from which
+   the computation will be resumed in the next call to SVDSolve().
+
+   Collective
+
+   Input Parameters:
++  svd    - the singular value solver context
+-  viewer - a binary viewer opened for reading
+
+   Notes:
+   The solver must be configured in the same way as in the run that saved
+   the checkpoint, with the same problem matrix and number of column vectors.
+   Any initial space is ignored when resuming.
+
+   The viewer is referenced by the SVD object, and it is released after
+   the state is read in SVDSolve().
+
+   Level: advanced
+
+.seealso: SVDCheckpoint(), SVDSolve()
+@*/
+PetscErrorCode SVDRestart(SVD svd,PetscViewer viewer)
+{
+  PetscBool      isbinary;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
+  PetscCheckSameComm(svd,1,viewer,2);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCheck(isbinary,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Only binary viewers are supported");
+  PetscCall(PetscObjectReference((PetscObject)viewer));
+  PetscCall(PetscViewerDestroy(&svd->rstviewer));
+  svd->rstviewer = viewer;
+  if (svd->state>SVD_STATE_SETUP) svd->state = SVD_STATE_SETUP;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDGetIterationNumber - Gets the current iteration number. If the
    call to SVDSolve() is complete, then it returns the number of iterations
@@ -206,6 +332,47 @@ PetscErrorCode SVDGetIterationNumber(SVD svd,PetscInt *its)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   SVDGetPerformanceStats - Gets performance data of one phase of the last call
+   to SVDSolve().
+
+   Not Collective
+
+   Input Parameters:
++  svd - the singular value solver context
+-  phase - the phase of the solve, see SlepcPerfPhase
+
+   Output Parameter:
+.  info - the performance data
+
+   Notes:
+   The data is taken from the PETSc log events associated with each phase, accumulated
+   from the beginning to the end of SVDSolve() in the current logging stage. The fields
+   count, time, flops, numMessages, messageLength and numReductions of info are set,
+   the rest are zero. Note that the data include the work done by any other object
+   during that interval, and that nested phases are also included in the outer ones,
+   for instance, the matrix-vector products done within the spectral transformation.
+
+   Logging must be active, for instance with PetscLogDefaultBegin() or -log_view,
+   otherwise all data are zero.
+
+   Fortran Note:
+   This function is not available in Fortran.
+
+   Level: intermediate
+
+.seealso: SVDSolve(), SlepcPerfPhase, PetscLogEventGetPerfInfo()
+@*/
+PetscErrorCode SVDGetPerformanceStats(SVD svd,SlepcPerfPhase phase,PetscEventPerfInfo *info)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(info,3);
+  PetscCheck(phase>=0 && phase<SLEPC_PERF_NPHASES,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"Wrong value of phase");
+  *info = svd->perf[phase];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDGetConvergedReason - Gets the reason why the SVDSolve() iteration was
    stopped.
@@ -295,6 +462,7 @@ PetscErrorCode SVDGetConverged(SVD svd,PetscInt *nconv)
    Both u or v can be NULL if singular vectors are not required.
    Otherwise, the caller must provide valid Vec objects, i.e.,
    they must be created by the calling program with e.g. MatCreateVecs().
+   If SVDSetValuesOnly() has been set, both u and v must be NULL.
 
    The index i should be a value between 0 and nconv-1 (see SVDGetConverged()).
    Singular triplets are indexed according to the ordering criterion established
@@ -309,7 +477,7 @@ PetscErrorCode SVDGetConverged(SVD svd,PetscInt *nconv)
 
    Level: beginner
 
-.seealso: SVDSolve(), SVDGetConverged(), SVDSetWhichSingularTriplets()
+.seealso: SVDSolve(), SVDGetConverged(), SVDSetWhichSingularTriplets(), SVDSetValuesOnly()
 @*/
 PetscErrorCode SVDGetSingularTriplet(SVD svd,PetscInt i,PetscReal *sigma,Vec u,Vec v)
 {
@@ -337,6 +505,42 @@ PetscErrorCode SVDGetSingularTriplet(SVD svd,PetscInt i,PetscReal *sigma,Vec u,V
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   SVDGetErrorEstimate - Returns the error estimate associated to the i-th
+   computed singular triplet.
+
+   Not Collective
+
+   Input Parameters:
++  svd - the singular value solver context
+-  i   - index of the solution
+
+   Output Parameter:
+.  errest - the error estimate
+
+   Notes:
+   This is the error estimate used internally by the solver to check
+   convergence, which does not require any computation. In Lanczos methods it
+   is obtained from the bidiagonalization relation, without computing the
+   singular vectors. The actual error can be computed with SVDComputeError()
+   or SVDComputeErrors().
+
+   Level: advanced
+
+.seealso: SVDComputeError(), SVDComputeErrors()
+@*/
+PetscErrorCode SVDGetErrorEstimate(SVD svd,PetscInt i,PetscReal *errest)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(errest,3);
+  SVDCheckSolved(svd,1);
+  PetscCheck(i>=0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The index cannot be negative");
+  PetscCheck(i<svd->nconv,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The index can be nconv-1 at most, see SVDGetConverged()");
+  *errest = svd->errest[svd->perm[i]];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    SVDComputeResidualNorms_Standard - Computes the norms of the left and
    right residuals associated with the i-th computed singular triplet.
@@ -454,6 +658,39 @@ static PetscErrorCode SVDComputeResidualNorms_Hyperbolic(SVD svd,PetscReal sigma
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   SVDScaleError_Private - Obtains the error of the requested type from the
+   two components of the residual norm of the singular triplet
+*/
+static PetscErrorCode SVDScaleError_Private(SVD svd,SVDErrorType type,PetscReal sigma,PetscReal norm1,PetscReal norm2,PetscReal vecnorm,PetscReal *error)
+{
+  PetscReal c,s;
+
+  PetscFunctionBegin;
+  *error = SlepcAbs(norm1,norm2);
+  switch (type) {
+    case SVD_ERROR_ABSOLUTE:
+      break;
+    case SVD_ERROR_RELATIVE:
+      if (svd->isgeneralized) {
+        s = 1.0/PetscSqrtReal(1.0+sigma*sigma);
+        c = sigma*s;
+        norm1 /= c*vecnorm;
+        norm2 /= s*vecnorm;
+        *error = PetscMax(norm1,norm2);
+      } else *error /= sigma*vecnorm;
+      break;
+    case SVD_ERROR_NORM:
+      if (!svd->nrma) PetscCall(MatNorm(svd->OP,NORM_INFINITY,&svd->nrma));
+      if (svd->isgeneralized && !svd->nrmb) PetscCall(MatNorm(svd->OPb,NORM_INFINITY,&svd->nrmb));
+      *error /= PetscMax(svd->nrma,svd->nrmb)*vecnorm;
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDComputeError - Computes the error (based on the residual norm) associated
    with the i-th singular triplet.
@@ -481,11 +718,11 @@ static PetscErrorCode SVDComputeResidualNorms_Hyperbolic(SVD svd,PetscReal sigma
 
    Level: beginner
 
-.seealso: SVDErrorType, SVDSolve()
+.seealso: SVDErrorType, SVDSolve(), SVDComputeErrors(), SVDGetErrorEstimate()
 @*/
 PetscErrorCode SVDComputeError(SVD svd,PetscInt i,SVDErrorType type,PetscReal *error)
 {
-  PetscReal      sigma,norm1,norm2,c,s;
+  PetscReal      sigma,norm1,norm2;
   Vec            u=NULL,v=NULL,x=NULL,y=NULL,z=NULL;
   PetscReal      vecnorm=1.0;
 
@@ -535,7 +772,6 @@ PetscErrorCode SVDComputeError(SVD svd,PetscInt i,SVDErrorType type,PetscReal *e
       PetscCall(SVDComputeResidualNorms_Hyperbolic(svd,sigma,svd->sign[svd->perm[i]],u,v,x,y,z,&norm1,&norm2));
       break;
   }
-  *error = SlepcAbs(norm1,norm2);
 
   /* compute 2-norm of eigenvector of the cyclic form */
   if (type!=SVD_ERROR_ABSOLUTE) {
@@ -555,25 +791,131 @@ PetscErrorCode SVDComputeError(SVD svd,PetscInt i,SVDErrorType type,PetscReal *e
   }
 
   /* compute error */
-  switch (type) {
-    case SVD_ERROR_ABSOLUTE:
-      break;
-    case SVD_ERROR_RELATIVE:
-      if (svd->isgeneralized) {
-        s = 1.0/PetscSqrtReal(1.0+sigma*sigma);
-        c = sigma*s;
-        norm1 /= c*vecnorm;
-        norm2 /= s*vecnorm;
-        *error = PetscMax(norm1,norm2);
-      } else *error /= sigma*vecnorm;
-      break;
-    case SVD_ERROR_NORM:
-      if (!svd->nrma) PetscCall(MatNorm(svd->OP,NORM_INFINITY,&svd->nrma));
-      if (svd->isgeneralized && !svd->nrmb) PetscCall(MatNorm(svd->OPb,NORM_INFINITY,&svd->nrmb));
-      *error /= PetscMax(svd->nrma,svd->nrmb)*vecnorm;
-      break;
-    default:
-      SETERRQ(PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"Invalid error type");
+  PetscCall(SVDScaleError_Private(svd,type,sigma,norm1,norm2,vecnorm,error));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* maximum number of singular triplets whose residuals are computed together in SVDComputeErrors() */
+#define SVD_ERROR_PANEL 16
+
+/*@
+   SVDComputeErrors - Computes the errors (based on the residual norm) associated
+   with a range of computed singular triplets.
+
+   Collective
+
+   Input Parameters:
++  svd  - the singular value solver context
+.  i0   - index of the first solution
+.  i1   - index after the last solution
+-  type - the type of error to compute
+
+   Output Parameter:
+.  errors - array of length i1-i0 with the errors
+
+   Notes:
+   The result is the same as calling SVDComputeError() for each index i0<=i<i1,
+   but the residuals are computed for several singular triplets at once,
+   multiplying the matrix and its transpose by a block of singular vectors (in a
+   single sparse matrix-matrix product if the matrix type supports it). This is
+   more efficient when many singular triplets have been computed. In the case of
+   the GSVD, the errors are computed one by one.
+
+   When only an estimate is needed, the error estimates provided by the solver
+   during the iteration, see SVDGetErrorEstimate(), do not require any
+   additional computation. In Lanczos methods, they are obtained from the
+   residual of the bidiagonalization.
+
+   Level: intermediate
+
+.seealso: SVDComputeError(), SVDErrorType, SVDGetErrorEstimate()
+@*/
+PetscErrorCode SVDComputeErrors(SVD svd,PetscInt i0,PetscInt i1,SVDErrorType type,PetscReal *errors)
+{
+  PetscInt  i,p,q;
+  PetscReal sigma[SVD_ERROR_PANEL],vecnorm[SVD_ERROR_PANEL],norm2,sign;
+  BV        U,V,AV,AU;
+  Vec       u,v,x,y;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidLogicalCollectiveInt(svd,i0,2);
+  PetscValidLogicalCollectiveInt(svd,i1,3);
+  PetscValidLogicalCollectiveEnum(svd,type,4);
+  SVDCheckSolved(svd,1);
+  PetscCheck(i0>=0 && i0<=i1 && i1<=svd->nconv,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_OUTOFRANGE,"The indices must satisfy 0<=i0<=i1<=nconv");
+  if (i0==i1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(errors,5);
+
+  /* the generalized residuals are computed one by one */
+  if (svd->isgeneralized) {
+    for (i=i0;i<i1;i++) PetscCall(SVDComputeError(svd,i,type,errors+i-i0));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall(MatCreateVecsEmpty(svd->OP,&v,&u));
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),&U));
+  PetscCall(BVSetType(U,((PetscObject)svd->V)->type_name));
+  PetscCall(BVSetSizesFromVec(U,u,SVD_ERROR_PANEL));
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),&V));
+  PetscCall(BVSetType(V,((PetscObject)svd->V)->type_name));
+  PetscCall(BVSetSizesFromVec(V,v,SVD_ERROR_PANEL));
+  PetscCall(VecDestroy(&u));
+  PetscCall(VecDestroy(&v));
+  PetscCall(BVDuplicate(U,&AV));
+  PetscCall(BVDuplicate(V,&AU));
+
+  for (p=i0;p<i1;p+=SVD_ERROR_PANEL) {
+    /* copy the singular vectors of the panel */
+    q = PetscMin(SVD_ERROR_PANEL,i1-p);
+    for (i=0;i<q;i++) {
+      PetscCall(BVGetColumn(U,i,&u));
+      PetscCall(BVGetColumn(V,i,&v));
+      PetscCall(SVDGetSingularTriplet(svd,p+i,sigma+i,u,v));
+      PetscCall(BVRestoreColumn(U,i,&u));
+      PetscCall(BVRestoreColumn(V,i,&v));
+    }
+    PetscCall(BVSetActiveColumns(U,0,q));
+    PetscCall(BVSetActiveColumns(V,0,q));
+    PetscCall(BVSetActiveColumns(AV,0,q));
+    PetscCall(BVSetActiveColumns(AU,0,q));
+
+    /* norm1 = ||A*v-sigma*u||_2 for all of them at once */
+    PetscCall(BVMatMult(V,svd->OP,AV));
+    for (i=0;i<q;i++) {
+      PetscCall(BVGetColumn(AV,i,&x));
+      PetscCall(BVGetColumn(U,i,&u));
+      PetscCall(VecAXPY(x,-sigma[i],u));
+      PetscCall(VecNorm(x,NORM_2,errors+p+i-i0));
+      /* 2-norm of eigenvector of the cyclic form */
+      vecnorm[i] = PETSC_SQRT2;
+      if (svd->ishyperbolic) {
+        if (type!=SVD_ERROR_ABSOLUTE) {
+          PetscCall(VecNorm(u,NORM_2,vecnorm+i));
+          vecnorm[i] = PetscSqrtReal(1.0+vecnorm[i]*vecnorm[i]);
+        }
+        PetscCall(VecPointwiseMult(u,u,svd->omega));
+      }
+      PetscCall(BVRestoreColumn(U,i,&u));
+      PetscCall(BVRestoreColumn(AV,i,&x));
+    }
+
+    /* norm2 = ||A^T*u-sigma*v||_2 (||A^T*Omega*u-sigma*sign*v||_2 in HSVD) */
+    PetscCall(BVMatMultHermitianTranspose(U,svd->OP,AU));
+    for (i=0;i<q;i++) {
+      sign = svd->ishyperbolic? svd->sign[svd->perm[p+i]]: 1.0;
+      PetscCall(BVGetColumn(AU,i,&y));
+      PetscCall(BVGetColumn(V,i,&v));
+      PetscCall(VecAXPY(y,-sigma[i]*sign,v));
+      PetscCall(VecNorm(y,NORM_2,&norm2));
+      PetscCall(BVRestoreColumn(V,i,&v));
+      PetscCall(BVRestoreColumn(AU,i,&y));
+      PetscCall(SVDScaleError_Private(svd,type,sigma[i],errors[p+i-i0],norm2,vecnorm[i],errors+p+i-i0));
+    }
   }
+  PetscCall(BVDestroy(&U));
+  PetscCall(BVDestroy(&V));
+  PetscCall(BVDestroy(&AV));
+  PetscCall(BVDestroy(&AU));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -0,0 +1,306 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   SVD routines for updating a computed partial SVD when the matrix grows
+
+   References:
+
+       [1] M. Brand, "Fast low-rank modifications of the thin singular
+           value decomposition", Linear Algebra Appl. 415(1):20-30, 2006.
+*/
+
+#include <slepc/private/svdimpl.h>   /*I "slepcsvd.h" I*/
+
+/*
+   Updates the rank-k factorization G*diag(s)*F' of the matrix with p new rows
+   in the dimension of G, given as the rows of X (herm=PETSC_TRUE) or the columns
+   of X (herm=PETSC_FALSE). With X'*F = F*C+P*Q, where P is orthonormal against F,
+   the extended matrix is [G 0; 0 I]*K*[F P]' with
+
+            K = [ diag(s)  0  ]
+                [   C'     Q' ]
+
+   so the updated factors are [G 0; 0 I]*Y and [F P]*Z, where Y*S*Z' is the SVD
+   of K truncated to rank k. On output, Gnew is a new BV with the layout of the
+   vector t, and F contains the updated vectors in its first k columns
+*/
+static PetscErrorCode SVDUpdate_Private(SVD svd,BV G,BV *F,PetscReal *s,PetscInt k,Mat X,PetscBool herm,Vec t,BV *Gnew)
+{
+  PetscInt          i,j,p,lo,hi,g0,ld,ldr;
+  PetscScalar       *pK,*pY,*pg,*w;
+  const PetscScalar *pR;
+  DS                ds;
+  SlepcSC           sc;
+  Mat               R,Y,Z;
+  BV                E,W;
+  Vec               e,g,gn;
+  IS                is;
+  VecScatter        scat;
+
+  PetscFunctionBegin;
+  /* E = identity, with the layout of the new rows */
+  if (herm) {
+    PetscCall(MatGetSize(X,&p,NULL));
+    PetscCall(MatCreateVecs(X,NULL,&e));
+  } else {
+    PetscCall(MatGetSize(X,NULL,&p));
+    PetscCall(MatCreateVecs(X,&e,NULL));
+  }
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),&E));
+  PetscCall(BVSetType(E,((PetscObject)*F)->type_name));
+  PetscCall(BVSetSizesFromVec(E,e,p));
+  PetscCall(VecGetOwnershipRange(e,&lo,&hi));
+  PetscCall(VecDestroy(&e));
+  for (j=0;j<p;j++) {
+    PetscCall(BVGetColumn(E,j,&e));
+    PetscCall(VecSet(e,0.0));
+    if (j>=lo && j<hi) PetscCall(VecSetValue(e,j,1.0,INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(e));
+    PetscCall(VecAssemblyEnd(e));
+    PetscCall(BVRestoreColumn(E,j,&e));
+  }
+
+  /* W = [F X'], orthogonalize the last p columns against F */
+  PetscCall(BVDuplicateResize(*F,k+p,&W));
+  PetscCall(BVSetActiveColumns(*F,0,k));
+  PetscCall(BVSetActiveColumns(W,0,k));
+  PetscCall(BVCopy(*F,W));
+  PetscCall(BVSetActiveColumns(W,k,k+p));
+  if (herm) PetscCall(BVMatMultHermitianTranspose(E,X,W));
+  else PetscCall(BVMatMult(E,X,W));
+  PetscCall(BVDestroy(&E));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k+p,k+p,NULL,&R));
+  PetscCall(BVOrthogonalize(W,R));
+
+  /* build and solve the small problem */
+  PetscCall(DSCreate(PetscObjectComm((PetscObject)svd),&ds));
+  PetscCall(DSSetType(ds,DSSVD));
+  PetscCall(DSGetSlepcSC(ds,&sc));
+  sc->comparison    = SlepcCompareLargestReal;
+  sc->comparisonctx = NULL;
+  sc->map           = NULL;
+  sc->mapobj        = NULL;
+  PetscCall(DSAllocate(ds,k+p));
+  PetscCall(DSGetLeadingDimension(ds,&ld));
+  PetscCall(DSSetDimensions(ds,k+p,0,0));
+  PetscCall(DSSVDSetDimensions(ds,k+p));
+  PetscCall(MatDenseGetLDA(R,&ldr));
+  PetscCall(MatDenseGetArrayRead(R,&pR));
+  PetscCall(DSGetArray(ds,DS_MAT_A,&pK));
+  for (j=0;j<k+p;j++) PetscCall(PetscArrayzero(pK+j*ld,k+p));
+  for (i=0;i<k;i++) pK[i+i*ld] = s[i];
+  for (i=0;i<p;i++) {
+    for (j=0;j<k+p;j++) pK[k+i+j*ld] = PetscConj(pR[j+(k+i)*ldr]);
+  }
+  PetscCall(DSRestoreArray(ds,DS_MAT_A,&pK));
+  PetscCall(MatDenseRestoreArrayRead(R,&pR));
+  PetscCall(MatDestroy(&R));
+  PetscCall(DSSetState(ds,DS_STATE_RAW));
+  PetscCall(PetscMalloc1(k+p,&w));
+  PetscCall(DSSolve(ds,w,NULL));
+  PetscCall(DSSort(ds,w,NULL,NULL,NULL,NULL));
+  PetscCall(DSSynchronize(ds,w,NULL));
+  for (i=0;i<k;i++) s[i] = PetscRealPart(w[i]);
+  PetscCall(PetscFree(w));
+
+  /* updated vectors of the dimension that does not grow, F = [F P]*Z */
+  PetscCall(DSGetMat(ds,DS_MAT_V,&Z));
+  PetscCall(BVSetActiveColumns(W,0,k+p));
+  PetscCall(BVMultInPlace(W,Z,0,k));
+  PetscCall(DSRestoreMat(ds,DS_MAT_V,&Z));
+  PetscCall(BVDestroy(F));
+  *F = W;
+
+  /* updated vectors of the dimension that grows, Gnew = [G*Y1; Y2] */
+  PetscCall(DSGetMat(ds,DS_MAT_U,&Y));
+  PetscCall(BVSetActiveColumns(G,0,k));
+  PetscCall(BVMultInPlace(G,Y,0,k));
+  PetscCall(DSRestoreMat(ds,DS_MAT_U,&Y));
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),Gnew));
+  PetscCall(BVSetType(*Gnew,((PetscObject)G)->type_name));
+  PetscCall(BVSetSizesFromVec(*Gnew,t,k));
+  PetscCall(BVGetSizes(G,NULL,&g0,NULL));
+  PetscCall(BVCreateVec(G,&g));
+  PetscCall(VecGetOwnershipRange(g,&lo,&hi));
+  PetscCall(ISCreateStride(PetscObjectComm((PetscObject)svd),hi-lo,lo,1,&is));
+  PetscCall(VecScatterCreate(g,is,t,is,&scat));
+  PetscCall(ISDestroy(&is));
+  PetscCall(VecDestroy(&g));
+  PetscCall(VecGetOwnershipRange(t,&lo,&hi));
+  PetscCall(DSGetArray(ds,DS_MAT_U,&pY));
+  for (j=0;j<k;j++) {
+    PetscCall(BVGetColumn(G,j,&g));
+    PetscCall(BVGetColumn(*Gnew,j,&gn));
+    PetscCall(VecSet(gn,0.0));
+    PetscCall(VecScatterBegin(scat,g,gn,INSERT_VALUES,SCATTER_FORWARD));
+    PetscCall(VecScatterEnd(scat,g,gn,INSERT_VALUES,SCATTER_FORWARD));
+    PetscCall(VecGetArray(gn,&pg));
+    for (i=PetscMax(lo,g0);i<hi;i++) pg[i-lo] = pY[k+i-g0+j*ld];
+    PetscCall(VecRestoreArray(gn,&pg));
+    PetscCall(BVRestoreColumn(*Gnew,j,&gn));
+    PetscCall(BVRestoreColumn(G,j,&g));
+  }
+  PetscCall(DSRestoreArray(ds,DS_MAT_U,&pY));
+  PetscCall(VecScatterDestroy(&scat));
+  PetscCall(DSDestroy(&ds));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SVDUpdate - Updates the computed singular triplets after new rows or new
+   columns have been appended to the matrix.
+
+   Collective
+
+   Input Parameters:
++  svd - the singular value solver context
+-  A   - the new matrix
+
+   Notes:
+   This function must be called after SVDSolve() (or a previous SVDUpdate()),
+   and A must contain the previous matrix as its leading block, with some
+   additional rows or some additional columns at the end (but not both, call
+   SVDUpdate() twice to add rows and columns). The dimension that does not
+   grow must have the same parallel layout as in the previous matrix.
+
+   The nconv computed singular triplets are taken as a rank-nconv factorization
+   of the previous matrix, which is updated with the method of Brand, so that
+   A is not multiplied by any vector and the previous rows or columns are not
+   read again. The cost is an orthogonalization of the new rows (or columns)
+   against the singular vectors and the SVD of a dense matrix whose dimension
+   is nconv plus the number of new rows (or columns). On output, A becomes the
+   operator of svd, as in SVDSetOperators(), and the updated nconv singular
+   triplets can be retrieved with SVDGetSingularTriplet().
+
+   The result is exact if the previous matrix had rank nconv. Otherwise, the
+   part of the previous matrix that is not captured by the computed triplets is
+   neglected, so the updated triplets are approximations whose quality degrades
+   with successive updates. The error estimates are set to zero, the actual
+   residuals can be checked with SVDComputeError(), and a new SVDSolve() should
+   be done when they are not small enough.
+
+   This is only available for standard SVD problems with the largest singular
+   values (see SVDSetWhichSingularTriplets()).
+
+   Level: advanced
+
+.seealso: SVDSolve(), SVDSetOperators(), SVDGetSingularTriplet(), SVDComputeError()
+@*/
+PetscErrorCode SVDUpdate(SVD svd,Mat A)
+{
+  PetscInt       i,k,M,N,M1,N1,m,n,m1,n1,lo,hi;
+  PetscReal      *s;
+  Mat            X;
+  BV             U,V,Unew=NULL,Vnew=NULL,Ut;
+  Vec            u,v,t,tl;
+  IS             isr,isc;
+  PetscBool      rows;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,2);
+  PetscCheckSameComm(svd,1,A,2);
+  SVDCheckSolved(svd,1);
+  SVDCheckStandard(svd);
+  PetscCheck(!svd->ishyperbolic,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Not available for hyperbolic problems");
+  PetscCheck(svd->which==SVD_LARGEST,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Only available for the largest singular values");
+  k = svd->nconv;
+  PetscCheck(k>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_ORDER,"There are no computed singular triplets to update");
+  PetscCall(MatGetSize(svd->OP,&M,&N));
+  PetscCall(MatGetLocalSize(svd->OP,&m,&n));
+  PetscCall(MatGetSize(A,&M1,&N1));
+  PetscCall(MatGetLocalSize(A,&m1,&n1));
+  PetscCheck(M1>=M && N1>=N && (M1>M || N1>N),PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_SIZ,"The new matrix must have more rows or more columns than the previous one");
+  PetscCheck(M1==M || N1==N,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"Rows and columns must be added in separate updates");
+  rows = (M1>M)? PETSC_TRUE: PETSC_FALSE;
+  PetscCheck(rows? n1==n: m1==m,PetscObjectComm((PetscObject)svd),PETSC_ERR_ARG_SIZ,"The dimension that does not grow must have the same local size as in the previous matrix");
+
+  /* get the current singular triplets, in decreasing order */
+  PetscCall(PetscMalloc1(k,&s));
+  PetscCall(MatCreateVecs(svd->OP,&v,&u));
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),&U));
+  PetscCall(BVSetType(U,((PetscObject)svd->V)->type_name));
+  PetscCall(BVSetSizesFromVec(U,u,k));
+  PetscCall(BVCreate(PetscObjectComm((PetscObject)svd),&V));
+  PetscCall(BVSetType(V,((PetscObject)svd->V)->type_name));
+  PetscCall(BVSetSizesFromVec(V,v,k));
+  PetscCall(VecDestroy(&u));
+  PetscCall(VecDestroy(&v));
+  for (i=0;i<k;i++) {
+    PetscCall(BVGetColumn(U,i,&u));
+    PetscCall(BVGetColumn(V,i,&v));
+    PetscCall(SVDGetSingularTriplet(svd,i,&s[i],u,v));
+    PetscCall(BVRestoreColumn(U,i,&u));
+    PetscCall(BVRestoreColumn(V,i,&v));
+  }
+
+  /* extract the new rows or columns and update the factorization */
+  if (rows) {
+    PetscCall(MatGetOwnershipRange(A,&lo,&hi));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)svd),PetscMax(0,hi-PetscMax(lo,M)),PetscMax(lo,M),1,&isr));
+    PetscCall(MatGetOwnershipRangeColumn(A,&lo,&hi));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)svd),hi-lo,lo,1,&isc));
+    PetscCall(MatCreateVecs(A,NULL,&t));
+  } else {
+    PetscCall(MatGetOwnershipRange(A,&lo,&hi));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)svd),hi-lo,lo,1,&isr));
+    PetscCall(MatGetOwnershipRangeColumn(A,&lo,&hi));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)svd),PetscMax(0,hi-PetscMax(lo,N)),PetscMax(lo,N),1,&isc));
+    PetscCall(MatCreateVecs(A,&t,NULL));
+  }
+  PetscCall(MatCreateSubMatrix(A,isr,isc,MAT_INITIAL_MATRIX,&X));
+  PetscCall(ISDestroy(&isr));
+  PetscCall(ISDestroy(&isc));
+  if (rows) {
+    PetscCall(SVDUpdate_Private(svd,U,&V,s,k,X,PETSC_TRUE,t,&Unew));
+    Vnew = V;
+    PetscCall(PetscObjectReference((PetscObject)Vnew));
+  } else {
+    PetscCall(SVDUpdate_Private(svd,V,&U,s,k,X,PETSC_FALSE,t,&Vnew));
+    Unew = U;
+    PetscCall(PetscObjectReference((PetscObject)Unew));
+  }
+  PetscCall(MatDestroy(&X));
+  PetscCall(VecDestroy(&t));
+  PetscCall(BVDestroy(&U));
+  PetscCall(BVDestroy(&V));
+
+  /* set the new matrix and store the updated triplets in the solver */
+  PetscCall(SVDSetOperators(svd,A,NULL));
+  PetscCall(SVDSetUp(svd));
+  if (!svd->U) PetscCall(SVDGetBV(svd,NULL,&svd->U));
+  PetscCall(BVGetSizes(svd->U,NULL,NULL,&i));
+  if (!i) {
+    if (!((PetscObject)svd->U)->type_name) PetscCall(BVSetType(svd->U,((PetscObject)svd->V)->type_name));
+    PetscCall(MatCreateVecsEmpty(svd->A,NULL,&tl));
+    PetscCall(BVSetSizesFromVec(svd->U,tl,svd->ncv));
+    PetscCall(VecDestroy(&tl));
+  }
+  PetscCheck(k<=svd->ncv,PetscObjectComm((PetscObject)svd),PETSC_ERR_SUP,"The number of updated triplets %" PetscInt_FMT " is larger than ncv=%" PetscInt_FMT,k,svd->ncv);
+  Ut = svd->swapped? svd->V: svd->U;
+  PetscCall(BVSetActiveColumns(Ut,0,k));
+  PetscCall(BVCopy(Unew,Ut));
+  Ut = svd->swapped? svd->U: svd->V;
+  PetscCall(BVSetActiveColumns(Ut,0,k));
+  PetscCall(BVCopy(Vnew,Ut));
+  PetscCall(BVDestroy(&Unew));
+  PetscCall(BVDestroy(&Vnew));
+  svd->its   = 0;
+  svd->nconv = k;
+  for (i=0;i<svd->ncv;i++) {
+    svd->sigma[i]  = (i<k)? s[i]: 0.0;
+    svd->errest[i] = 0.0;
+    svd->perm[i]   = i;
+  }
+  PetscCall(PetscFree(s));
+  svd->reason = SVD_CONVERGED_TOL;
+  svd->state  = SVD_STATE_VECTORS;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -12,6 +12,7 @@
 */
 
 #include <slepc/private/svdimpl.h>      /*I "slepcsvd.h" I*/
+#include <slepc/private/bvimpl.h>
 #include <petscdraw.h>
 
 /*@
@@ -67,6 +68,7 @@ PetscErrorCode SVDView(SVD svd,PetscViewer viewer)
     } else type = "not yet set";
     PetscCall(PetscViewerASCIIPrintf(viewer,"  problem type: %s\n",type));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  transpose mode: %s\n",svd->impltrans?"implicit":"explicit"));
+    if (svd->valuesonly) PetscCall(PetscViewerASCIIPrintf(viewer,"  computing only singular values, no singular vectors\n"));
     if (svd->which == SVD_LARGEST) PetscCall(PetscViewerASCIIPrintf(viewer,"  selected portion of the spectrum: largest\n"));
     else PetscCall(PetscViewerASCIIPrintf(viewer,"  selected portion of the spectrum: smallest\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  number of singular values (nsv): %" PetscInt_FMT "\n",svd->nsv));
@@ -95,6 +97,7 @@ PetscErrorCode SVDView(SVD svd,PetscViewer viewer)
     PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_TRUE));
     if (svd->nini) PetscCall(PetscViewerASCIIPrintf(viewer,"  dimension of user-provided initial space: %" PetscInt_FMT "\n",PetscAbs(svd->nini)));
     if (svd->ninil) PetscCall(PetscViewerASCIIPrintf(viewer,"  dimension of user-provided initial left space: %" PetscInt_FMT "\n",PetscAbs(svd->ninil)));
+    if (svd->state>=SVD_STATE_SOLVED) PetscCall(SlepcPerfStatsView_Private(svd->perf,svd->its,viewer));
   } else PetscTryTypeMethod(svd,view,viewer);
   PetscCall(PetscObjectTypeCompareAny((PetscObject)svd,&isshell,SVDCROSS,SVDCYCLIC,""));
   PetscCall(PetscObjectTypeCompareAny((PetscObject)svd,&isexternal,SVDSCALAPACK,SVDKSVD,SVDELEMENTAL,SVDPRIMME,""));
@@ -205,9 +208,24 @@ PetscErrorCode SVDConvergedReasonViewFromOptions(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes the errors of the first n singular triplets, or takes the estimates
+   of the solver if the singular vectors are not available
+*/
+static PetscErrorCode SVDErrorView_GetErrors(SVD svd,PetscInt n,SVDErrorType etype,PetscReal *error)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  if (svd->valuesonly) {
+    for (i=0;i<n;i++) PetscCall(SVDGetErrorEstimate(svd,i,error+i));
+  } else PetscCall(SVDComputeErrors(svd,0,n,etype,error));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode SVDErrorView_ASCII(SVD svd,SVDErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error,sigma;
+  PetscReal      *error,sigma;
   PetscInt       i,j;
 
   PetscFunctionBegin;
@@ -215,13 +233,16 @@ static PetscErrorCode SVDErrorView_ASCII(SVD svd,SVDErrorType etype,PetscViewer
     PetscCall(PetscViewerASCIIPrintf(viewer," Problem: less than %" PetscInt_FMT " singular values converged\n\n",svd->nsv));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+  PetscCall(PetscMalloc1(svd->nsv,&error));
+  PetscCall(SVDErrorView_GetErrors(svd,svd->nsv,etype,error));
   for (i=0;i<svd->nsv;i++) {
-    PetscCall(SVDComputeError(svd,i,etype,&error));
-    if (error>=5.0*svd->tol) {
+    if (error[i]>=5.0*svd->tol) {
       PetscCall(PetscViewerASCIIPrintf(viewer," Problem: some of the first %" PetscInt_FMT " relative errors are higher than the tolerance\n\n",svd->nsv));
+      PetscCall(PetscFree(error));
       PetscFunctionReturn(PETSC_SUCCESS);
     }
   }
+  PetscCall(PetscFree(error));
   PetscCall(PetscViewerASCIIPrintf(viewer," All requested %ssingular values computed up to the required tolerance:",svd->isgeneralized?"generalized ":""));
   for (i=0;i<=(svd->nsv-1)/8;i++) {
     PetscCall(PetscViewerASCIIPrintf(viewer,"\n     "));
@@ -237,7 +258,7 @@ static PetscErrorCode SVDErrorView_ASCII(SVD svd,SVDErrorType etype,PetscViewer
 
 static PetscErrorCode SVDErrorView_DETAIL(SVD svd,SVDErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error,sigma;
+  PetscReal      *error,sigma;
   PetscInt       i;
   char           ex[30],sep[]=" ---------------------- --------------------\n";
 
@@ -256,28 +277,30 @@ static PetscErrorCode SVDErrorView_DETAIL(SVD svd,SVDErrorType etype,PetscViewer
       break;
   }
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s          sigma           %s\n%s",sep,ex,sep));
+  PetscCall(PetscMalloc1(svd->nconv,&error));
+  PetscCall(SVDErrorView_GetErrors(svd,svd->nconv,etype,error));
   for (i=0;i<svd->nconv;i++) {
     PetscCall(SVDGetSingularTriplet(svd,i,&sigma,NULL,NULL));
-    PetscCall(SVDComputeError(svd,i,etype,&error));
-    PetscCall(PetscViewerASCIIPrintf(viewer,"       % 6f          %12g\n",(double)sigma,(double)error));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"       % 6f          %12g\n",(double)sigma,(double)error[i]));
   }
+  PetscCall(PetscFree(error));
   PetscCall(PetscViewerASCIIPrintf(viewer,"%s",sep));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode SVDErrorView_MATLAB(SVD svd,SVDErrorType etype,PetscViewer viewer)
 {
-  PetscReal      error;
+  PetscReal      *error;
   PetscInt       i;
   const char     *name;
 
   PetscFunctionBegin;
   PetscCall(PetscObjectGetName((PetscObject)svd,&name));
   PetscCall(PetscViewerASCIIPrintf(viewer,"Error_%s = [\n",name));
-  for (i=0;i<svd->nconv;i++) {
-    PetscCall(SVDComputeError(svd,i,etype,&error));
-    PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)error));
-  }
+  PetscCall(PetscMalloc1(svd->nconv,&error));
+  PetscCall(SVDErrorView_GetErrors(svd,svd->nconv,etype,error));
+  for (i=0;i<svd->nconv;i++) PetscCall(PetscViewerASCIIPrintf(viewer,"%18.16e\n",(double)error[i]));
+  PetscCall(PetscFree(error));
   PetscCall(PetscViewerASCIIPrintf(viewer,"];\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -575,6 +598,55 @@ PetscErrorCode SVDValuesViewFromOptions(SVD svd)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Get a BV with the converged columns of V in the order given by svd->perm, as the
+   active columns; it is V itself if no reordering is needed, and then the caller
+   must reset the active columns of V
+*/
+static PetscErrorCode SVDGetSortedVectors_Private(SVD svd,BV V,BV *X)
+{
+  PetscInt  i;
+  Vec       x;
+  PetscBool sorted=PETSC_TRUE;
+
+  PetscFunctionBegin;
+  for (i=0;i<svd->nconv;i++) if (svd->perm[i]!=i) { sorted = PETSC_FALSE; break; }
+  if (sorted) {
+    PetscCall(PetscObjectReference((PetscObject)V));
+    *X = V;
+  } else {
+    PetscCall(BVDuplicateResize(V,svd->nconv,X));
+    for (i=0;i<svd->nconv;i++) {
+      PetscCall(BVGetColumn(*X,i,&x));
+      PetscCall(BVCopyVec(V,svd->perm[i],x));
+      PetscCall(BVRestoreColumn(*X,i,&x));
+    }
+  }
+  PetscCall(BVSetActiveColumns(*X,0,svd->nconv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Write the converged columns of V, in the order given by svd->perm, as a dense matrix
+*/
+static PetscErrorCode SVDVectorsView_Native(SVD svd,BV V,const char name[],PetscViewer viewer)
+{
+  PetscInt  l,k;
+  BV        X;
+  Mat       M;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetActiveColumns(V,&l,&k));
+  PetscCall(SVDGetSortedVectors_Private(svd,V,&X));
+  PetscCall(BVGetMat(X,&M));
+  PetscCall(PetscObjectSetName((PetscObject)M,name));
+  PetscCall(MatView(M,viewer));
+  PetscCall(BVRestoreMat(X,&M));
+  PetscCall(BVDestroy(&X));
+  PetscCall(BVSetActiveColumns(V,l,k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SVDVectorsView - Outputs computed singular vectors to a viewer.
 
@@ -587,20 +659,30 @@ PetscErrorCode SVDValuesViewFromOptions(SVD svd)
    Options Database Key:
 .  -svd_view_vectors - output singular vectors
 
-   Note:
+   Notes:
    Right and left singular vectors are interleaved, that is, the vectors are
    output in the following order V0, U0, V1, U1, V2, U2, ...
 
+   With a binary or HDF5 viewer in PETSC_VIEWER_NATIVE format, e.g.,
+   -svd_view_vectors binary:svecs.bin:native, the right singular vectors are
+   written at once as the columns of a dense matrix named V, followed by the
+   left singular vectors as a matrix named U, which can be read with MatLoad().
+   This avoids a separate write for each vector, and the write is done with
+   collective MPI-IO if the viewer is set up for that (-viewer_binary_mpiio), or
+   with parallel HDF5.
+
    Level: intermediate
 
 .seealso: SVDSolve(), SVDValuesView(), SVDErrorView()
 @*/
 PetscErrorCode SVDVectorsView(SVD svd,PetscViewer viewer)
 {
-  PetscInt       i,k;
-  Vec            x;
-  char           vname[30];
-  const char     *ename;
+  PetscInt          i,k;
+  Vec               x;
+  char              vname[30];
+  const char        *ename;
+  PetscBool         isbinary,ishdf5;
+  PetscViewerFormat format;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
@@ -608,7 +690,14 @@ PetscErrorCode SVDVectorsView(SVD svd,PetscViewer viewer)
   PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,2);
   PetscCheckSameComm(svd,1,viewer,2);
   SVDCheckSolved(svd,1);
-  if (svd->nconv) {
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERHDF5,&ishdf5));
+  PetscCall(PetscViewerGetFormat(viewer,&format));
+  if (svd->nconv && (isbinary || ishdf5) && format==PETSC_VIEWER_NATIVE) {
+    PetscCall(SVDComputeVectors(svd));
+    PetscCall(SVDVectorsView_Native(svd,svd->V,"V",viewer));
+    PetscCall(SVDVectorsView_Native(svd,svd->U,"U",viewer));
+  } else if (svd->nconv) {
     PetscCall(PetscObjectGetName((PetscObject)svd,&ename));
     PetscCall(SVDComputeVectors(svd));
     for (i=0;i<svd->nconv;i++) {
@@ -661,3 +750,56 @@ PetscErrorCode SVDVectorsViewFromOptions(SVD svd)
   incall = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+   SVDSaveSolution - Saves the computed singular values, error estimates and singular
+   vectors in a single file, that can be loaded with SlepcLoadSolution().
+
+   Collective
+
+   Input Parameters:
++  svd      - the singular value solver context
+-  filename - name of the file
+
+   Notes:
+   The right and left singular vectors are stored as the columns of two BV
+   objects, in the order of SVDGetSingularTriplet(). When loading the file with
+   SlepcLoadSolution(), they are returned in X and Y, respectively, with their
+   storage mapped to the file, see BVMmapSetFile(). The imaginary parts of the
+   values are zero.
+
+   Level: intermediate
+
+.seealso: SlepcLoadSolution(), SVDVectorsView()
+@*/
+PetscErrorCode SVDSaveSolution(SVD svd,const char filename[])
+{
+  PetscInt       i,l[2],k[2];
+  PetscReal      sigma,*errest;
+  PetscScalar    *eigr,*eigi;
+  BV             X[2];
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(svd,SVD_CLASSID,1);
+  PetscAssertPointer(filename,2);
+  SVDCheckSolved(svd,1);
+  PetscCall(PetscMalloc3(svd->nconv,&eigr,svd->nconv,&eigi,svd->nconv,&errest));
+  for (i=0;i<svd->nconv;i++) {
+    PetscCall(SVDGetSingularTriplet(svd,i,&sigma,NULL,NULL));
+    PetscCall(SVDGetErrorEstimate(svd,i,&errest[i]));
+    eigr[i] = sigma;
+    eigi[i] = 0.0;
+  }
+  PetscCall(SVDComputeVectors(svd));
+  PetscCall(BVGetActiveColumns(svd->V,&l[0],&k[0]));
+  PetscCall(BVGetActiveColumns(svd->U,&l[1],&k[1]));
+  PetscCall(SVDGetSortedVectors_Private(svd,svd->V,&X[0]));
+  PetscCall(SVDGetSortedVectors_Private(svd,svd->U,&X[1]));
+  PetscCall(SlepcSolutionSave_Private((PetscObject)svd,filename,svd->nconv,eigr,eigi,errest,2,X));
+  PetscCall(BVDestroy(&X[0]));
+  PetscCall(BVDestroy(&X[1]));
+  PetscCall(BVSetActiveColumns(svd->V,l[0],k[0]));
+  PetscCall(BVSetActiveColumns(svd->U,l[1],k[1]));
+  PetscCall(PetscFree3(eigr,eigi,errest));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,155 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test SVDCheckpoint() and SVDRestart() in TRLanczos.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n"
+  "  -ckit <ckit>, where <ckit> = iteration at which the checkpoint is saved.\n\n";
+
+#include <slepcsvd.h>
+
+typedef struct {
+  PetscInt  ckit;     /* iteration at which the checkpoint is saved */
+  PetscBool saved;
+  char      filename[PETSC_MAX_PATH_LEN];
+} CkptCtx;
+
+/*
+   Open a binary viewer, honoring options such as -viewer_binary_mpiio
+*/
+PetscErrorCode OpenBinaryViewer(MPI_Comm comm,const char *name,PetscFileMode mode,PetscViewer *viewer)
+{
+  PetscFunctionBeginUser;
+  PetscCall(PetscViewerCreate(comm,viewer));
+  PetscCall(PetscViewerSetType(*viewer,PETSCVIEWERBINARY));
+  PetscCall(PetscViewerFileSetMode(*viewer,mode));
+  PetscCall(PetscViewerSetFromOptions(*viewer));
+  PetscCall(PetscViewerFileSetName(*viewer,name));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Monitor that saves the state of the solver at the given iteration
+*/
+PetscErrorCode MonitorCheckpoint(SVD svd,PetscInt its,PetscInt nconv,PetscReal *sigma,PetscReal *errest,PetscInt nest,void *ctx)
+{
+  CkptCtx            *ck = (CkptCtx*)ctx;
+  PetscViewer        viewer;
+  SVDConvergedReason reason;
+
+  PetscFunctionBeginUser;
+  PetscCall(SVDGetConvergedReason(svd,&reason));
+  if (its==ck->ckit && reason==SVD_CONVERGED_ITERATING) {
+    PetscCall(OpenBinaryViewer(PetscObjectComm((PetscObject)svd),ck->filename,FILE_MODE_WRITE,&viewer));
+    PetscCall(SVDCheckpoint(svd,viewer));
+    PetscCall(PetscViewerDestroy(&viewer));
+    ck->saved = PETSC_TRUE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  SVD            svd;
+  PetscViewer    viewer;
+  CkptCtx        ck;
+  PetscReal      *sigmas,sigma,error=0.0;
+  PetscInt       n=200,i,j,Istart,Iend,col[5],nconv,nconv1,its,its1;
+  PetscScalar    value[] = { -1, 1, 1, 1, 1 };
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  ck.ckit  = 2;
+  ck.saved = PETSC_FALSE;
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-ckit",&ck.ckit,NULL));
+  PetscCall(PetscStrncpy(ck.filename,"checkpoint.dat",sizeof(ck.filename)));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nSingular values of a Grcar matrix, n=%" PetscInt_FMT "\n\n",n));
+
+  /* Grcar matrix, with -1 in the subdiagonal, and 1 in the diagonal and the 3 superdiagonals */
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    col[0]=i-1; col[1]=i; col[2]=i+1; col[3]=i+2; col[4]=i+3;
+    if (i==0) PetscCall(MatSetValues(A,1,&i,PetscMin(4,n-i),col+1,value+1,INSERT_VALUES));
+    else PetscCall(MatSetValues(A,1,&i,PetscMin(5,n-i+1),col,value,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  /* first run, saving a checkpoint */
+  PetscCall(SVDCreate(PETSC_COMM_WORLD,&svd));
+  PetscCall(SVDSetOperators(svd,A,NULL));
+  PetscCall(SVDSetType(svd,SVDTRLANCZOS));
+  PetscCall(SVDSetDimensions(svd,4,10,PETSC_DETERMINE));
+  PetscCall(SVDSetFromOptions(svd));
+  PetscCall(SVDMonitorSet(svd,MonitorCheckpoint,&ck,NULL));
+  PetscCall(SVDSolve(svd));
+  PetscCheck(ck.saved,PETSC_COMM_WORLD,PETSC_ERR_USER,"The solver converged before saving the checkpoint, use a smaller -ckit");
+  PetscCall(SVDGetIterationNumber(svd,&its1));
+  PetscCall(SVDGetConverged(svd,&nconv1));
+  PetscCall(PetscMalloc1(nconv1,&sigmas));
+  for (i=0;i<nconv1;i++) PetscCall(SVDGetSingularTriplet(svd,i,&sigmas[i],NULL,NULL));
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Checkpoint saved at iteration %" PetscInt_FMT "\n",ck.ckit));
+
+  /* second run, resuming from the checkpoint */
+  PetscCall(SVDCreate(PETSC_COMM_WORLD,&svd));
+  PetscCall(SVDSetOperators(svd,A,NULL));
+  PetscCall(SVDSetType(svd,SVDTRLANCZOS));
+  PetscCall(SVDSetDimensions(svd,4,10,PETSC_DETERMINE));
+  PetscCall(SVDSetFromOptions(svd));
+  PetscCall(OpenBinaryViewer(PETSC_COMM_WORLD,ck.filename,FILE_MODE_READ,&viewer));
+  PetscCall(SVDRestart(svd,viewer));
+  PetscCall(PetscViewerDestroy(&viewer));
+  PetscCall(SVDSolve(svd));
+  PetscCall(SVDGetIterationNumber(svd,&its));
+  PetscCall(SVDGetConverged(svd,&nconv));
+
+  /* compare both runs */
+  if (its==its1 && nconv==nconv1) {
+    for (j=0;j<nconv;j++) {
+      PetscCall(SVDGetSingularTriplet(svd,j,&sigma,NULL,NULL));
+      error = PetscMax(error,PetscAbsReal(sigma-sigmas[j]));
+    }
+    if (error<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD," The restarted run reproduces the original one\n"));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Difference in the singular values: %g\n",(double)error));
+  } else PetscCall(PetscPrintf(PETSC_COMM_WORLD," The restarted run differs: its=%" PetscInt_FMT " nconv=%" PetscInt_FMT " (original its=%" PetscInt_FMT " nconv=%" PetscInt_FMT ")\n",its,nconv,its1,nconv1));
+
+  PetscCall(PetscFree(sigmas));
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test21_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_oneside
+         args: -svd_trlanczos_oneside
+      test:
+         suffix: 1_nolock
+         args: -svd_trlanczos_locking 0
+      test:
+         suffix: 1_mpiio
+         nsize: 2
+         args: -viewer_binary_mpiio
+         requires: defined(PETSC_HAVE_MPIIO)
+
+TEST*/
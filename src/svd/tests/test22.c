@@ -0,0 +1,125 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test the variants of the randomized SVD, including the single-pass one with the matrix read by blocks of columns.\n\n"
+  "The command line options are:\n"
+  "  -m <m>, where <m> = number of rows.\n"
+  "  -n <n>, where <n> = number of columns.\n"
+  "  -bs <bs>, where <bs> = number of columns of each block.\n"
+  "  -inmemory, to use the matrix in memory instead of the stream (the other variants\n"
+  "   of the randomized solver can then be selected from the command line).\n\n";
+
+#include <slepcsvd.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A,S,Aj;
+  SVD            svd;
+  PetscViewer    viewer;
+  IS             isrow,iscol;
+  PetscReal      sigma;
+  PetscInt       m=120,n=100,bs=16,i,Istart,Iend,Jstart,Jend,c0,nsv;
+  PetscBool      inmemory=PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-inmemory",&inmemory,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nRandomized SVD of a diagonal matrix\n\n"));
+
+  /* Rectangular diagonal matrix with entries 4^(-i), so that the singular values decay fast */
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,m,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i<n) PetscCall(MatSetValue(A,i,i,PetscPowReal(4.0,-(PetscReal)i),INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+
+  PetscCall(SVDCreate(PETSC_COMM_WORLD,&svd));
+  PetscCall(SVDSetType(svd,SVDRANDOMIZED));
+  PetscCall(SVDSetDimensions(svd,4,12,PETSC_DETERMINE));
+  if (inmemory) {
+    PetscCall(SVDSetOperators(svd,A,NULL));
+    PetscCall(SVDRandomizedSetSinglePass(svd,PETSC_TRUE));
+  } else {
+    /* Write the matrix by blocks of columns */
+    PetscCall(PetscViewerBinaryOpen(PETSC_COMM_WORLD,"blocks.dat",FILE_MODE_WRITE,&viewer));
+    PetscCall(MatGetOwnershipRangeColumn(A,&Jstart,&Jend));
+    PetscCall(ISCreateStride(PETSC_COMM_WORLD,Iend-Istart,Istart,1,&isrow));
+    for (c0=0;c0<n;c0+=bs) {
+      PetscCall(ISCreateStride(PETSC_COMM_WORLD,PetscMax(0,PetscMin(c0+bs,PetscMin(n,Jend))-PetscMax(c0,Jstart)),PetscMax(c0,Jstart),1,&iscol));
+      PetscCall(MatCreateSubMatrix(A,isrow,iscol,MAT_INITIAL_MATRIX,&Aj));
+      PetscCall(MatView(Aj,viewer));
+      PetscCall(MatDestroy(&Aj));
+      PetscCall(ISDestroy(&iscol));
+    }
+    PetscCall(ISDestroy(&isrow));
+    PetscCall(PetscViewerDestroy(&viewer));
+
+    /* The operator only provides the dimensions, the matrix is read from the stream */
+    PetscCall(MatCreateShell(PETSC_COMM_WORLD,Iend-Istart,Jend-Jstart,m,n,NULL,&S));
+    PetscCall(SVDSetOperators(svd,S,NULL));
+    PetscCall(MatDestroy(&S));
+    PetscCall(PetscViewerBinaryOpen(PETSC_COMM_WORLD,"blocks.dat",FILE_MODE_READ,&viewer));
+    PetscCall(SVDRandomizedSetStream(svd,viewer,bs));
+    PetscCall(PetscViewerDestroy(&viewer));
+  }
+  PetscCall(SVDSetFromOptions(svd));
+  PetscCall(SVDSolve(svd));
+
+  PetscCall(SVDGetDimensions(svd,&nsv,NULL,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," Largest singular values:"));
+  for (i=0;i<nsv;i++) {
+    PetscCall(SVDGetSingularTriplet(svd,i,&sigma,NULL,NULL));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD," %.4f",(double)sigma));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n"));
+
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test22_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_wide
+         nsize: 2
+         args: -m 90 -bs 24
+      test:
+         suffix: 1_inmemory
+         args: -inmemory
+      test:
+         suffix: 1_inmemory_wide
+         args: -inmemory -m 90
+      test:
+         suffix: 1_sparse_sign
+         nsize: {{1 2}}
+         args: -inmemory -svd_randomized_sketch sparse_sign
+      test:
+         suffix: 1_power
+         args: -inmemory -svd_randomized_single_pass 0 -svd_randomized_power_its 2 -svd_randomized_orth_interval {{1 2}}
+      test:
+         suffix: 1_adaptive
+         nsize: {{1 2}}
+         args: -inmemory -svd_randomized_single_pass 0 -svd_randomized_adaptive_rank -svd_tol 1e-6 -svd_randomized_sketch {{gaussian sparse_sign}}
+
+TEST*/
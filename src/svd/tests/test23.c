@@ -0,0 +1,120 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test SVDUpdate() with a matrix that grows by rows and then by columns.\n\n"
+  "The command line options are:\n"
+  "  -m <m>, where <m> = initial number of rows.\n"
+  "  -n <n>, where <n> = initial number of columns.\n"
+  "  -p <p>, where <p> = number of rows to be added.\n"
+  "  -q <q>, where <q> = number of columns to be added.\n\n";
+
+#include <slepcsvd.h>
+
+/*
+   Creates the leading M x N block of the matrix A(i,j) = 1/(i+j+1), with
+   the local number of columns given by nloc
+*/
+static PetscErrorCode CreateMatrix(PetscInt M,PetscInt N,PetscInt nloc,Mat *A)
+{
+  PetscInt Istart,Iend,i,j;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreate(PETSC_COMM_WORLD,A));
+  PetscCall(MatSetSizes(*A,PETSC_DECIDE,nloc,M,N));
+  PetscCall(MatSetType(*A,MATDENSE));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(MatSetUp(*A));
+  PetscCall(MatGetOwnershipRange(*A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    for (j=0;j<N;j++) PetscCall(MatSetValue(*A,i,j,1.0/(i+j+1),INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PrintSingularValues(SVD svd,const char *title)
+{
+  PetscInt  i;
+  PetscReal sigma,error,maxerr=0.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD," %s:",title));
+  for (i=0;i<4;i++) {
+    PetscCall(SVDGetSingularTriplet(svd,i,&sigma,NULL,NULL));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD," %.4f",(double)sigma));
+    PetscCall(SVDComputeError(svd,i,SVD_ERROR_RELATIVE,&error));
+    maxerr = PetscMax(maxerr,error);
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n"));
+  if (maxerr>1e-4) PetscCall(PetscPrintf(PETSC_COMM_WORLD," Warning: relative error %g\n",(double)maxerr));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Mat      A;
+  SVD      svd;
+  PetscInt m=50,n=40,p=20,q=15,nloc;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-p",&p,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-q",&q,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nSVD of a Hilbert-like matrix updated with %" PetscInt_FMT " rows and %" PetscInt_FMT " columns\n\n",p,q));
+
+  /* solve the initial problem */
+  PetscCall(CreateMatrix(m,n,PETSC_DECIDE,&A));
+  PetscCall(MatGetLocalSize(A,NULL,&nloc));
+  PetscCall(SVDCreate(PETSC_COMM_WORLD,&svd));
+  PetscCall(SVDSetOperators(svd,A,NULL));
+  /* compute more triplets than printed, so that the neglected part is small */
+  PetscCall(SVDSetDimensions(svd,8,PETSC_DETERMINE,PETSC_DETERMINE));
+  PetscCall(SVDSetTolerances(svd,1e-12,PETSC_CURRENT));
+  PetscCall(SVDSetFromOptions(svd));
+  PetscCall(SVDSolve(svd));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PrintSingularValues(svd,"Initial matrix"));
+
+  /* append p rows, keeping the layout of the columns */
+  PetscCall(CreateMatrix(m+p,n,nloc,&A));
+  PetscCall(SVDUpdate(svd,A));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PrintSingularValues(svd,"After adding rows"));
+
+  /* append q columns, keeping the layout of the rows */
+  PetscCall(CreateMatrix(m+p,n+q,PETSC_DECIDE,&A));
+  PetscCall(SVDUpdate(svd,A));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PrintSingularValues(svd,"After adding columns"));
+
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test23_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2}}
+      test:
+         suffix: 1_trlanczos
+         args: -svd_type trlanczos -svd_trlanczos_oneside {{0 1}}
+      test:
+         suffix: 1_wide
+         args: -m 30 -n 40 -p 30 -q 10 -svd_type lanczos
+         output_file: output/test23_1_wide.out
+
+TEST*/
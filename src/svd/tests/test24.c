@@ -0,0 +1,123 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test SVDSolveBatch() with a collection of tall-skinny problems.\n\n"
+  "The command line options are:\n"
+  "  -nprob <nprob>, where <nprob> = number of problems.\n"
+  "  -npart <npart>, where <npart> = number of partitions.\n\n";
+
+#include <slepcsvd.h>
+
+typedef struct {
+  PetscReal *sigma;  /* largest singular value computed for each problem */
+} BatchCtx;
+
+/*
+   Problem i is the matrix [D;D] with D=diag(1,2,...,n)+0.1*i*I and n=10+i,
+   whose singular values are sqrt(2)*D(j,j)
+*/
+PetscErrorCode GetOperators(SVD svd,PetscInt i,Mat *A,Mat *B,void *ctx)
+{
+  PetscInt j,n=10+i,Istart,Iend;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)svd),A));
+  PetscCall(MatSetSizes(*A,PETSC_DECIDE,PETSC_DECIDE,2*n,n));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(MatGetOwnershipRange(*A,&Istart,&Iend));
+  for (j=Istart;j<Iend;j++) PetscCall(MatSetValue(*A,j,j%n,(j%n)+1.0+0.1*i,INSERT_VALUES));
+  PetscCall(MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY));
+  *B = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Stores the largest singular value, only in the first process of each partition
+*/
+PetscErrorCode GetResult(SVD svd,PetscInt i,void *ctx)
+{
+  BatchCtx    *user = (BatchCtx*)ctx;
+  PetscReal   sigma;
+  PetscInt    nconv;
+  PetscMPIInt rank;
+
+  PetscFunctionBeginUser;
+  PetscCall(SVDGetConverged(svd,&nconv));
+  PetscCheck(nconv>0,PetscObjectComm((PetscObject)svd),PETSC_ERR_NOT_CONVERGED,"Problem %" PetscInt_FMT " did not converge",i);
+  PetscCall(SVDGetSingularTriplet(svd,0,&sigma,NULL,NULL));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)svd),&rank));
+  if (!rank) user->sigma[i] = sigma;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  SVD         svd;
+  BatchCtx    user;
+  PetscInt    i,nprob=6,npart=1,n;
+  PetscReal   exact,error=0.0;
+  PetscMPIInt len;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-nprob",&nprob,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-npart",&npart,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\nBatch of %" PetscInt_FMT " tall-skinny singular value problems\n\n",nprob));
+  PetscCall(PetscCalloc1(nprob,&user.sigma));
+
+  /* template solver, it does not need matrices */
+  PetscCall(SVDCreate(PETSC_COMM_WORLD,&svd));
+  PetscCall(SVDSetType(svd,SVDLAPACK));
+  PetscCall(SVDSetTolerances(svd,1e-10,PETSC_CURRENT));
+  PetscCall(SVDSetFromOptions(svd));
+  PetscCall(SVDSolveBatch(svd,nprob,npart,GetOperators,GetResult,&user));
+
+  /* gather the results of all partitions and check them */
+  PetscCall(PetscMPIIntCast(nprob,&len));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,user.sigma,len,MPIU_REAL,MPIU_SUM,PETSC_COMM_WORLD));
+  for (i=0;i<nprob;i++) {
+    n = 10+i;
+    exact = PetscSqrtReal(2.0)*(n+0.1*i);
+    error = PetscMax(error,PetscAbsReal(user.sigma[i]-exact)/exact);
+  }
+  if (error<1e-8) PetscCall(PetscPrintf(PETSC_COMM_WORLD," All problems solved correctly\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD," Maximum relative error %g\n",(double)error));
+
+  PetscCall(PetscFree(user.sigma));
+  PetscCall(SVDDestroy(&svd));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      requires: !single
+      output_file: output/test24_1.out
+      test:
+         suffix: 1
+      test:
+         suffix: 1_part
+         nsize: 3
+         args: -npart 3
+      test:
+         suffix: 1_trlanczos
+         nsize: 2
+         args: -npart 2 -svd_type trlanczos
+      test:
+         suffix: 1_values_only
+         nsize: 2
+         args: -npart 2 -svd_values_only -svd_type {{lapack cyclic}}
+      test:
+         suffix: 1_values_only_trlanczos
+         args: -svd_values_only -svd_type trlanczos -svd_trlanczos_oneside
+
+TEST*/
@@ -130,6 +130,9 @@ int main(int argc,char **argv)
       test:
          suffix: 1_trlanczos
          args: -svd_type trlanczos -svd_trlanczos_locking {{0 1}}
+      test:
+         suffix: 1_twoside_pipelined
+         args: -svd_type {{lanczos trlanczos}} -bv_orthog_type cgs_pipelined -bv_orthog_refine {{never ifneeded always}}
       test:
          suffix: 1_trlanczos_one
          args: -svd_type trlanczos -svd_trlanczos_oneside
@@ -139,6 +142,12 @@ int main(int argc,char **argv)
       test:
          suffix: 1_trlanczos_one_always
          args: -svd_type trlanczos -svd_trlanczos_oneside -bv_orthog_refine always
+      test:
+         suffix: 1_trlanczos_one_fused
+         args: -svd_type trlanczos -svd_trlanczos_oneside -svd_trlanczos_fusedmult
+      test:
+         suffix: 1_trlanczos_block
+         args: -svd_type trlanczos -svd_trlanczos_blocksize 3 -bv_orthog_block {{gs cholqr2 tsqr}}
       test:
          suffix: 1_cross
          args: -svd_type cross
@@ -186,6 +195,9 @@ int main(int argc,char **argv)
       test:
          suffix: 2_trlanczos_one_always
          args: -svd_type trlanczos -svd_trlanczos_oneside -bv_orthog_refine always
+      test:
+         suffix: 2_trlanczos_block
+         args: -svd_type trlanczos -svd_trlanczos_blocksize 2 -svd_trlanczos_locking {{0 1}}
       test:
          suffix: 2_cross
          args: -svd_type cross
@@ -230,6 +242,9 @@ int main(int argc,char **argv)
       test:
          suffix: 3_cuda_cross
          args: -svd_type cross
+      test:
+         suffix: 3_cuda_cross_exp
+         args: -svd_type cross -svd_cross_explicitmatrix
       test:
          suffix: 3_cuda_cyclic
          args: -svd_type cyclic
@@ -279,6 +294,9 @@ int main(int argc,char **argv)
       test:
          suffix: 6_hip_cross
          args: -svd_type cross
+      test:
+         suffix: 6_hip_cross_exp
+         args: -svd_type cross -svd_cross_explicitmatrix
       test:
          suffix: 6_hip_cyclic
          args: -svd_type cyclic
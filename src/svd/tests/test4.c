@@ -195,4 +195,16 @@ int main(int argc,char **argv)
          suffix: 4_hip_cross
          args: -svd_type cross
 
+   testset:
+      args: -svd_monitor_cancel -mat_type scalapack
+      requires: scalapack
+      filter: grep -v "Transpose mode" | sed -e "s/scalapack/seqaij/"
+      output_file: output/test4_1.out
+      test:
+         suffix: 5_scalapack_trlanczos
+         args: -svd_type trlanczos -svd_ncv 12 -svd_trlanczos_blocksize {{1 2}}
+      test:
+         suffix: 5_scalapack_randomized
+         args: -svd_type randomized
+
 TEST*/
@@ -145,6 +145,11 @@ int main(int argc,char **argv)
       requires: double
       test:
          suffix: 1
+      test:
+         suffix: 1_native
+         nsize: {{1 2}}
+         args: -svd_view_vectors binary:svecs.bin:native
+         output_file: output/ex15_1.out
       test:
          suffix: 1_scalapack
          nsize: {{1 2}}
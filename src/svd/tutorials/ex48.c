@@ -164,6 +164,9 @@ int main(int argc,char **argv)
          suffix: 1_spqr
          args: -svd_type trlanczos -svd_trlanczos_explicitmatrix -svd_trlanczos_pc_type qr -svd_trlanczos_scale 1e5 -svd_trlanczos_oneside {{0 1}}
          requires: suitesparse
+      test:
+         suffix: 1_cholesky
+         args: -svd_type trlanczos -svd_trlanczos_explicitmatrix -svd_trlanczos_pc_type cholesky -svd_trlanczos_scale 1e5 -svd_trlanczos_oneside {{0 1}}
       test:
          suffix: 1_autoscale
          args: -svd_type trlanczos -svd_trlanczos_gbidiag {{lower upper}} -svd_trlanczos_scale -5 -svd_trlanczos_ksp_rtol 1e-16 -svd_trlanczos_oneside {{0 1}}
@@ -18,6 +18,8 @@
 
       PetscEnum, parameter :: BV_ORTHOG_CGS             =  0
       PetscEnum, parameter :: BV_ORTHOG_MGS             =  1
+      PetscEnum, parameter :: BV_ORTHOG_CGS_PIPELINED   =  2
+      PetscEnum, parameter :: BV_ORTHOG_RGS             =  3
 
       PetscEnum, parameter :: BV_ORTHOG_REFINE_IFNEEDED =  0
       PetscEnum, parameter :: BV_ORTHOG_REFINE_NEVER    =  1
@@ -28,6 +30,8 @@
       PetscEnum, parameter :: BV_ORTHOG_BLOCK_TSQR      =  2
       PetscEnum, parameter :: BV_ORTHOG_BLOCK_TSQRCHOL  =  3
       PetscEnum, parameter :: BV_ORTHOG_BLOCK_SVQB      =  4
+      PetscEnum, parameter :: BV_ORTHOG_BLOCK_CHOLQR2   =  5
+      PetscEnum, parameter :: BV_ORTHOG_BLOCK_SCHOLQR3  =  6
 
       PetscEnum, parameter :: BV_MATMULT_VECS           =  0
       PetscEnum, parameter :: BV_MATMULT_MAT            =  1
@@ -176,21 +176,10 @@ static PetscErrorCode BVMatMult_Contiguous(BV V,Mat A,BV W)
 {
   BV_CONTIGUOUS  *v = (BV_CONTIGUOUS*)V->data,*w = (BV_CONTIGUOUS*)W->data;
   PetscInt       j;
-  Mat            Vmat,Wmat;
 
   PetscFunctionBegin;
-  if (V->vmm) {
-    PetscCall(BVGetMat(V,&Vmat));
-    PetscCall(BVGetMat(W,&Wmat));
-    PetscCall(MatProductCreateWithMat(A,Vmat,NULL,Wmat));
-    PetscCall(MatProductSetType(Wmat,MATPRODUCT_AB));
-    PetscCall(MatProductSetFromOptions(Wmat));
-    PetscCall(MatProductSymbolic(Wmat));
-    PetscCall(MatProductNumeric(Wmat));
-    PetscCall(MatProductClear(Wmat));
-    PetscCall(BVRestoreMat(V,&Vmat));
-    PetscCall(BVRestoreMat(W,&Wmat));
-  } else {
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
     for (j=0;j<V->k-V->l;j++) PetscCall(MatMult(A,v->V[V->nc+V->l+j],w->V[W->nc+W->l+j]));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -225,7 +214,8 @@ static PetscErrorCode BVResize_Contiguous(BV bv,PetscInt m,PetscBool copy)
 
   PetscFunctionBegin;
   PetscCall(PetscLayoutGetBlockSize(bv->map,&bs));
-  PetscCall(PetscCalloc1(m*bv->ld,&newarray));
+  PetscCall(PetscMalloc1(m*bv->ld,&newarray));
+  PetscCall(BVFirstTouch_Private(bv,bv->n,m,newarray,bv->ld));
   PetscCall(PetscMalloc1(m,&newV));
   for (j=0;j<m;j++) {
     if (ctx->mpi) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)bv),bs,bv->n,PETSC_DECIDE,newarray+j*bv->ld,newV+j));
@@ -284,6 +274,18 @@ static PetscErrorCode BVGetArrayRead_Contiguous(BV bv,const PetscScalar **a)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode BVResetSplit_Contiguous(BV bv)
+{
+  BV_CONTIGUOUS  *ctx = (BV_CONTIGUOUS*)bv->data;
+  BV_CONTIGUOUS  *pctx = (BV_CONTIGUOUS*)bv->splitparent->data;
+  PetscInt       lsplit = bv->splitparent->lsplit;
+
+  PetscFunctionBegin;
+  ctx->V     = (bv->issplit==1)? pctx->V: pctx->V+lsplit;
+  ctx->array = (bv->issplit==1)? pctx->array: pctx->array+lsplit*bv->ld;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode BVDestroy_Contiguous(BV bv)
 {
   BV_CONTIGUOUS  *ctx = (BV_CONTIGUOUS*)bv->data;
@@ -365,7 +367,8 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Contiguous(BV bv)
     ctx->array = (bv->issplit==1)? array: array+lsplit*bv->ld;
   } else {
     /* regular BV: allocate memory and Vecs for the BV entries */
-    PetscCall(PetscCalloc1(bv->m*bv->ld,&ctx->array));
+    PetscCall(PetscMalloc1(bv->m*bv->ld,&ctx->array));
+    PetscCall(BVFirstTouch_Private(bv,nloc,bv->m,ctx->array,bv->ld));
     PetscCall(PetscMalloc1(bv->m,&ctx->V));
     for (j=0;j<bv->m;j++) {
       if (ctx->mpi) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)bv),bs,nloc,PETSC_DECIDE,ctx->array+j*bv->ld,ctx->V+j));
@@ -411,6 +414,7 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Contiguous(BV bv)
   bv->ops->getarrayread     = BVGetArrayRead_Contiguous;
   bv->ops->getmat           = BVGetMat_Default;
   bv->ops->restoremat       = BVRestoreMat_Default;
+  bv->ops->resetsplit       = BVResetSplit_Contiguous;
   bv->ops->destroy          = BVDestroy_Contiguous;
   bv->ops->view             = BVView_Contiguous;
   PetscFunctionReturn(PETSC_SUCCESS);
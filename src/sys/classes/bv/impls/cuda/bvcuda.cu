@@ -9,6 +9,11 @@
 */
 /*
    CUDA-related code common to several BV impls
+
+   All work is issued on the stream of the current PETSc device context, with
+   workspace obtained from its stream-ordered memory pool, so that no implicit
+   device synchronization occurs; the stream is synchronized only before the host
+   reads a result
 */
 
 #include <slepc/private/bvimpl.h>
@@ -70,9 +75,13 @@ PetscErrorCode BVMultInPlace_BLAS_CUDA(BV,PetscInt m_,PetscInt k_,PetscInt s,Pet
   size_t            freemem,totmem;
   cublasHandle_t    cublasv2handle;
   cublasOperation_t bt;
+  cudaStream_t      stream;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   PetscCall(PetscCUBLASGetHandle(&cublasv2handle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+  PetscCall(PetscDeviceContextGetStreamHandle(dctx,(void**)&stream));
   PetscCall(PetscCuBLASIntCast(m_,&m));
   PetscCall(PetscCuBLASIntCast(e-s,&n));
   PetscCall(PetscCuBLASIntCast(k_,&k));
@@ -89,24 +98,24 @@ PetscErrorCode BVMultInPlace_BLAS_CUDA(BV,PetscInt m_,PetscInt k_,PetscInt s,Pet
   /* try to allocate the whole matrix */
   PetscCallCUDA(cudaMemGetInfo(&freemem,&totmem));
   if (freemem>=lda*n*sizeof(PetscScalar)) {
-    PetscCallCUDA(cudaMalloc((void**)&d_work,lda*n*sizeof(PetscScalar)));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,lda*n,&d_work));
     PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_N,bt,m,n,k,&sone,d_A,lda,d_B1,ldb,&szero,d_work,lda));
-    PetscCallCUDA(cudaMemcpy2D(d_A+s*lda,lda*sizeof(PetscScalar),d_work,lda*sizeof(PetscScalar),m*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice));
+    PetscCallCUDA(cudaMemcpy2DAsync(d_A+s*lda,lda*sizeof(PetscScalar),d_work,lda*sizeof(PetscScalar),m*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice,stream));
   } else {
     PetscCall(PetscCuBLASIntCast(freemem/(m*sizeof(PetscScalar)),&bs));
-    PetscCallCUDA(cudaMalloc((void**)&d_work,bs*n*sizeof(PetscScalar)));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,bs*n,&d_work));
     PetscCall(PetscCuBLASIntCast(m % bs,&l));
     if (l) {
       PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_N,bt,l,n,k,&sone,d_A,lda,d_B1,ldb,&szero,d_work,l));
-      PetscCallCUDA(cudaMemcpy2D(d_A+s*lda,lda*sizeof(PetscScalar),d_work,l*sizeof(PetscScalar),l*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice));
+      PetscCallCUDA(cudaMemcpy2DAsync(d_A+s*lda,lda*sizeof(PetscScalar),d_work,l*sizeof(PetscScalar),l*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice,stream));
     }
     for (;l<m;l+=bs) {
       PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_N,bt,bs,n,k,&sone,d_A+l,lda,d_B1,ldb,&szero,d_work,bs));
-      PetscCallCUDA(cudaMemcpy2D(d_A+l+s*lda,lda*sizeof(PetscScalar),d_work,bs*sizeof(PetscScalar),bs*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice));
+      PetscCallCUDA(cudaMemcpy2DAsync(d_A+l+s*lda,lda*sizeof(PetscScalar),d_work,bs*sizeof(PetscScalar),bs*sizeof(PetscScalar),n,cudaMemcpyDeviceToDevice,stream));
     }
   }
   PetscCall(PetscLogGpuTimeEnd());
-  PetscCallCUDA(cudaFree(d_work));
+  PetscCall(PetscDeviceFree(dctx,d_work));
   PetscCall(PetscLogGpuFlops(2.0*m*n*k));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -135,33 +144,52 @@ PetscErrorCode BVAXPY_BLAS_CUDA(BV,PetscInt n_,PetscInt k_,PetscScalar alpha,con
 /*
     C := A'*B
 
-    C is a CPU array
+    C is a CPU array; with GPU-aware MPI the reduction is done on device buffers
 */
 PetscErrorCode BVDot_BLAS_CUDA(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const PetscScalar *d_A,PetscInt lda_,const PetscScalar *d_B,PetscInt ldb_,PetscScalar *C,PetscInt ldc_,PetscBool mpi)
 {
-  PetscScalar       *d_work,sone=1.0,szero=0.0,*CC;
+  PetscScalar       *d_work,*d_red,sone=1.0,szero=0.0,*CC;
   PetscInt          j;
   PetscCuBLASInt    m=0,n=0,k=0,lda=0,ldb=0,ldc=0;
   PetscMPIInt       len;
   cublasHandle_t    cublasv2handle;
+  PetscDeviceContext dctx;
+  cudaStream_t      stream;
 
   PetscFunctionBegin;
   PetscCall(PetscCUBLASGetHandle(&cublasv2handle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
   PetscCall(PetscCuBLASIntCast(m_,&m));
   PetscCall(PetscCuBLASIntCast(n_,&n));
   PetscCall(PetscCuBLASIntCast(k_,&k));
   PetscCall(PetscCuBLASIntCast(lda_,&lda));
   PetscCall(PetscCuBLASIntCast(ldb_,&ldb));
   PetscCall(PetscCuBLASIntCast(ldc_,&ldc));
-  PetscCallCUDA(cudaMalloc((void**)&d_work,m*n*sizeof(PetscScalar)));
+  PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,m*n,&d_work));
   if (mpi) {
-    if (ldc==m) {
+    if (use_gpu_aware_mpi) {  /* reduce on GPU, then copy the result to C */
+      PetscCall(PetscDeviceContextGetStreamHandle(dctx,(void**)&stream));
+      PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,m*n,&d_red));
+      if (k) {
+        PetscCall(PetscLogGpuTimeBegin());
+        PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_C,CUBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
+        PetscCall(PetscLogGpuTimeEnd());
+      } else PetscCall(PetscDeviceArrayZero(dctx,d_work,m*n));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
+      PetscCall(PetscMPIIntCast(m*n,&len));
+      PetscCallMPI(MPIU_Allreduce(d_work,d_red,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+      PetscCallCUDA(cudaMemcpy2DAsync(C,ldc*sizeof(PetscScalar),d_red,m*sizeof(PetscScalar),m*sizeof(PetscScalar),n,cudaMemcpyDeviceToHost,stream));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
+      PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
+      PetscCall(PetscDeviceFree(dctx,d_red));
+    } else if (ldc==m) {
       PetscCall(BVAllocateWork_Private(bv,m*n));
       if (k) {
         PetscCall(PetscLogGpuTimeBegin());
         PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_C,CUBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,ldc));
         PetscCall(PetscLogGpuTimeEnd());
-        PetscCallCUDA(cudaMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+        PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       } else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
@@ -173,7 +201,8 @@ PetscErrorCode BVDot_BLAS_CUDA(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const P
         PetscCall(PetscLogGpuTimeBegin());
         PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_C,CUBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
         PetscCall(PetscLogGpuTimeEnd());
-        PetscCallCUDA(cudaMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+        PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       } else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
@@ -186,12 +215,13 @@ PetscErrorCode BVDot_BLAS_CUDA(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const P
       PetscCall(PetscLogGpuTimeBegin());
       PetscCallCUBLAS(cublasXgemm(cublasv2handle,CUBLAS_OP_C,CUBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
       PetscCall(PetscLogGpuTimeEnd());
-      PetscCallCUDA(cudaMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       for (j=0;j<n;j++) PetscCall(PetscArraycpy(C+j*ldc,bv->work+j*m,m));
     }
   }
-  PetscCallCUDA(cudaFree(d_work));
+  PetscCall(PetscDeviceFree(dctx,d_work));
   PetscCall(PetscLogGpuFlops(2.0*m*n*k));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -207,43 +237,44 @@ PetscErrorCode BVDotVec_BLAS_CUDA(BV bv,PetscInt n_,PetscInt k_,const PetscScala
   PetscCuBLASInt    n=0,k=0,lda=0,one=1;
   PetscMPIInt       len;
   cublasHandle_t    cublasv2handle;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   PetscCall(PetscCUBLASGetHandle(&cublasv2handle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
   PetscCall(PetscCuBLASIntCast(n_,&n));
   PetscCall(PetscCuBLASIntCast(k_,&k));
   PetscCall(PetscCuBLASIntCast(lda_,&lda));
   if (!y) PetscCall(VecCUDAGetArrayWrite(bv->buffer,&d_work));
-  else PetscCallCUDA(cudaMalloc((void**)&d_work,k*sizeof(PetscScalar)));
+  else PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,k,&d_work));
   if (mpi) {
-    PetscCall(BVAllocateWork_Private(bv,k));
+    PetscCall(BVAllocateWork_Private(bv,y?k:2*k));
     if (n) {
       PetscCall(PetscLogGpuTimeBegin());
       PetscCallCUBLAS(cublasXgemv(cublasv2handle,CUBLAS_OP_C,n,k,&sone,d_A,lda,d_x,one,&szero,d_work,one));
       PetscCall(PetscLogGpuTimeEnd());
-      PetscCallCUDA(cudaMemcpy(bv->work,d_work,k*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,k));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
     } else PetscCall(PetscArrayzero(bv->work,k));
     /* reduction */
     PetscCall(PetscMPIIntCast(k,&len));
     if (!y) {
       if (use_gpu_aware_mpi) {  /* case 1: reduce on GPU using a temporary buffer */
-        PetscCallCUDA(cudaMalloc((void**)&yy,k*sizeof(PetscScalar)));
+        PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUDA,k,&yy));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCallMPI(MPIU_Allreduce(d_work,yy,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
-        PetscCallCUDA(cudaMemcpy(d_work,yy,k*sizeof(PetscScalar),cudaMemcpyDeviceToDevice));
-        PetscCallCUDA(cudaFree(yy));
+        PetscCall(PetscDeviceArrayCopy(dctx,d_work,yy,k));
+        PetscCall(PetscDeviceFree(dctx,yy));
       } else {  /* case 2: reduce on CPU, copy result back to GPU */
-        PetscCall(BVAllocateWork_Private(bv,2*k));
         yy = bv->work+k;
-        PetscCallCUDA(cudaMemcpy(bv->work,d_work,k*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
-        PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
         PetscCallMPI(MPIU_Allreduce(bv->work,yy,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
-        PetscCallCUDA(cudaMemcpy(d_work,yy,k*sizeof(PetscScalar),cudaMemcpyHostToDevice));
+        PetscCall(PetscDeviceArrayCopy(dctx,d_work,yy,k));
         PetscCall(PetscLogCpuToGpu(k*sizeof(PetscScalar)));
       }
       PetscCall(VecCUDARestoreArrayWrite(bv->buffer,&d_work));
     } else {  /* case 3: user-provided array y, reduce on CPU */
-      PetscCallCUDA(cudaFree(d_work));
+      PetscCall(PetscDeviceFree(dctx,d_work));
       PetscCallMPI(MPIU_Allreduce(bv->work,y,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
     }
   } else {
@@ -254,9 +285,10 @@ PetscErrorCode BVDotVec_BLAS_CUDA(BV bv,PetscInt n_,PetscInt k_,const PetscScala
     }
     if (!y) PetscCall(VecCUDARestoreArrayWrite(bv->buffer,&d_work));
     else {
-      PetscCallCUDA(cudaMemcpy(y,d_work,k*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,y,d_work,k));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
-      PetscCallCUDA(cudaFree(d_work));
+      PetscCall(PetscDeviceFree(dctx,d_work));
     }
   }
   PetscCall(PetscLogGpuFlops(2.0*n*k));
@@ -523,6 +555,34 @@ PetscErrorCode BV_SquareRoot_CUDA(BV bv,PetscInt j,PetscScalar *h,PetscReal *bet
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   BV_SquareRootSum_CUDA - Computes the square root of position j (counted after the constraints)
+   and the sum of squares of the previous positions of the coefficients array, with a
+   single copy to the host
+*/
+PetscErrorCode BV_SquareRootSum_CUDA(BV bv,PetscInt j,PetscScalar *h,PetscReal *beta,PetscReal *sum)
+{
+  const PetscScalar *d_h;
+  PetscInt          i;
+
+  PetscFunctionBegin;
+  if (!h) {
+    PetscCall(BVAllocateWork_Private(bv,bv->nc+j+1));
+    PetscCall(VecCUDAGetArrayRead(bv->buffer,&d_h));
+    PetscCall(PetscLogGpuTimeBegin());
+    PetscCallCUDA(cudaMemcpy(bv->work,d_h,(bv->nc+j+1)*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
+    PetscCall(PetscLogGpuToCpu((bv->nc+j+1)*sizeof(PetscScalar)));
+    PetscCall(PetscLogGpuTimeEnd());
+    PetscCall(VecCUDARestoreArrayRead(bv->buffer,&d_h));
+    h = bv->work;
+  }
+  PetscCall(BV_SafeSqrt(bv,h[bv->nc+j],beta));
+  *sum = 0.0;
+  for (i=0;i<bv->nc+j;i++) *sum += PetscRealPart(h[i]*PetscConj(h[i]));
+  PetscCall(PetscLogFlops(2.0*(bv->nc+j)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    BV_StoreCoefficients_CUDA - Copy the contents of the coefficients array to an array dest
    provided by the caller (only values from l to j are copied)
@@ -9,6 +9,11 @@
 */
 /*
    HIP-related code common to several BV impls
+
+   All work is issued on the stream of the current PETSc device context, with
+   workspace obtained from its stream-ordered memory pool, so that no implicit
+   device synchronization occurs; the stream is synchronized only before the host
+   reads a result
 */
 
 #include <slepc/private/bvimpl.h>
@@ -70,9 +75,13 @@ PetscErrorCode BVMultInPlace_BLAS_HIP(BV,PetscInt m_,PetscInt k_,PetscInt s,Pets
   size_t             freemem,totmem;
   hipblasHandle_t    hipblashandle;
   hipblasOperation_t bt;
+  hipStream_t        stream;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   PetscCall(PetscHIPBLASGetHandle(&hipblashandle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+  PetscCall(PetscDeviceContextGetStreamHandle(dctx,(void**)&stream));
   PetscCall(PetscHipBLASIntCast(m_,&m));
   PetscCall(PetscHipBLASIntCast(e-s,&n));
   PetscCall(PetscHipBLASIntCast(k_,&k));
@@ -89,24 +98,24 @@ PetscErrorCode BVMultInPlace_BLAS_HIP(BV,PetscInt m_,PetscInt k_,PetscInt s,Pets
   /* try to allocate the whole matrix */
   PetscCallHIP(hipMemGetInfo(&freemem,&totmem));
   if (freemem>=lda*n*sizeof(PetscScalar)) {
-    PetscCallHIP(hipMalloc((void**)&d_work,lda*n*sizeof(PetscScalar)));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,lda*n,&d_work));
     PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_N,bt,m,n,k,&sone,d_A,lda,d_B1,ldb,&szero,d_work,lda));
-    PetscCallHIP(hipMemcpy2D(d_A+s*lda,lda*sizeof(PetscScalar),d_work,lda*sizeof(PetscScalar),m*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice));
+    PetscCallHIP(hipMemcpy2DAsync(d_A+s*lda,lda*sizeof(PetscScalar),d_work,lda*sizeof(PetscScalar),m*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice,stream));
   } else {
     PetscCall(PetscHipBLASIntCast(freemem/(m*sizeof(PetscScalar)),&bs));
-    PetscCallHIP(hipMalloc((void**)&d_work,bs*n*sizeof(PetscScalar)));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,bs*n,&d_work));
     PetscCall(PetscHipBLASIntCast(m % bs,&l));
     if (l) {
       PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_N,bt,l,n,k,&sone,d_A,lda,d_B1,ldb,&szero,d_work,l));
-      PetscCallHIP(hipMemcpy2D(d_A+s*lda,lda*sizeof(PetscScalar),d_work,l*sizeof(PetscScalar),l*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice));
+      PetscCallHIP(hipMemcpy2DAsync(d_A+s*lda,lda*sizeof(PetscScalar),d_work,l*sizeof(PetscScalar),l*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice,stream));
     }
     for (;l<m;l+=bs) {
       PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_N,bt,bs,n,k,&sone,d_A+l,lda,d_B1,ldb,&szero,d_work,bs));
-      PetscCallHIP(hipMemcpy2D(d_A+l+s*lda,lda*sizeof(PetscScalar),d_work,bs*sizeof(PetscScalar),bs*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice));
+      PetscCallHIP(hipMemcpy2DAsync(d_A+l+s*lda,lda*sizeof(PetscScalar),d_work,bs*sizeof(PetscScalar),bs*sizeof(PetscScalar),n,hipMemcpyDeviceToDevice,stream));
     }
   }
   PetscCall(PetscLogGpuTimeEnd());
-  PetscCallHIP(hipFree(d_work));
+  PetscCall(PetscDeviceFree(dctx,d_work));
   PetscCall(PetscLogGpuFlops(2.0*m*n*k));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -135,33 +144,52 @@ PetscErrorCode BVAXPY_BLAS_HIP(BV,PetscInt n_,PetscInt k_,PetscScalar alpha,cons
 /*
     C := A'*B
 
-    C is a CPU array
+    C is a CPU array; with GPU-aware MPI the reduction is done on device buffers
 */
 PetscErrorCode BVDot_BLAS_HIP(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const PetscScalar *d_A,PetscInt lda_,const PetscScalar *d_B,PetscInt ldb_,PetscScalar *C,PetscInt ldc_,PetscBool mpi)
 {
-  PetscScalar       *d_work,sone=1.0,szero=0.0,*CC;
+  PetscScalar       *d_work,*d_red,sone=1.0,szero=0.0,*CC;
   PetscInt          j;
   PetscHipBLASInt   m=0,n=0,k=0,lda=0,ldb=0,ldc=0;
   PetscMPIInt       len;
   hipblasHandle_t   hipblashandle;
+  PetscDeviceContext dctx;
+  hipStream_t        stream;
 
   PetscFunctionBegin;
   PetscCall(PetscHIPBLASGetHandle(&hipblashandle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
   PetscCall(PetscHipBLASIntCast(m_,&m));
   PetscCall(PetscHipBLASIntCast(n_,&n));
   PetscCall(PetscHipBLASIntCast(k_,&k));
   PetscCall(PetscHipBLASIntCast(lda_,&lda));
   PetscCall(PetscHipBLASIntCast(ldb_,&ldb));
   PetscCall(PetscHipBLASIntCast(ldc_,&ldc));
-  PetscCallHIP(hipMalloc((void**)&d_work,m*n*sizeof(PetscScalar)));
+  PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,m*n,&d_work));
   if (mpi) {
-    if (ldc==m) {
+    if (use_gpu_aware_mpi) {  /* reduce on GPU, then copy the result to C */
+      PetscCall(PetscDeviceContextGetStreamHandle(dctx,(void**)&stream));
+      PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,m*n,&d_red));
+      if (k) {
+        PetscCall(PetscLogGpuTimeBegin());
+        PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_C,HIPBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
+        PetscCall(PetscLogGpuTimeEnd());
+      } else PetscCall(PetscDeviceArrayZero(dctx,d_work,m*n));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
+      PetscCall(PetscMPIIntCast(m*n,&len));
+      PetscCallMPI(MPIU_Allreduce(d_work,d_red,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+      PetscCallHIP(hipMemcpy2DAsync(C,ldc*sizeof(PetscScalar),d_red,m*sizeof(PetscScalar),m*sizeof(PetscScalar),n,hipMemcpyDeviceToHost,stream));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
+      PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
+      PetscCall(PetscDeviceFree(dctx,d_red));
+    } else if (ldc==m) {
       PetscCall(BVAllocateWork_Private(bv,m*n));
       if (k) {
         PetscCall(PetscLogGpuTimeBegin());
         PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_C,HIPBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,ldc));
         PetscCall(PetscLogGpuTimeEnd());
-        PetscCallHIP(hipMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+        PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       } else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
@@ -173,7 +201,8 @@ PetscErrorCode BVDot_BLAS_HIP(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const Pe
         PetscCall(PetscLogGpuTimeBegin());
         PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_C,HIPBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
         PetscCall(PetscLogGpuTimeEnd());
-        PetscCallHIP(hipMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+        PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       } else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
@@ -186,12 +215,13 @@ PetscErrorCode BVDot_BLAS_HIP(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const Pe
       PetscCall(PetscLogGpuTimeBegin());
       PetscCallHIPBLAS(hipblasXgemm(hipblashandle,HIPBLAS_OP_C,HIPBLAS_OP_N,m,n,k,&sone,d_A,lda,d_B,ldb,&szero,d_work,m));
       PetscCall(PetscLogGpuTimeEnd());
-      PetscCallHIP(hipMemcpy(bv->work,d_work,m*n*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,m*n));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(m*n*sizeof(PetscScalar)));
       for (j=0;j<n;j++) PetscCall(PetscArraycpy(C+j*ldc,bv->work+j*m,m));
     }
   }
-  PetscCallHIP(hipFree(d_work));
+  PetscCall(PetscDeviceFree(dctx,d_work));
   PetscCall(PetscLogGpuFlops(2.0*m*n*k));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -207,43 +237,44 @@ PetscErrorCode BVDotVec_BLAS_HIP(BV bv,PetscInt n_,PetscInt k_,const PetscScalar
   PetscHipBLASInt   n=0,k=0,lda=0,one=1;
   PetscMPIInt       len;
   hipblasHandle_t   hipblashandle;
+  PetscDeviceContext dctx;
 
   PetscFunctionBegin;
   PetscCall(PetscHIPBLASGetHandle(&hipblashandle));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
   PetscCall(PetscHipBLASIntCast(n_,&n));
   PetscCall(PetscHipBLASIntCast(k_,&k));
   PetscCall(PetscHipBLASIntCast(lda_,&lda));
   if (!y) PetscCall(VecHIPGetArrayWrite(bv->buffer,&d_work));
-  else PetscCallHIP(hipMalloc((void**)&d_work,k*sizeof(PetscScalar)));
+  else PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,k,&d_work));
   if (mpi) {
-    PetscCall(BVAllocateWork_Private(bv,k));
+    PetscCall(BVAllocateWork_Private(bv,y?k:2*k));
     if (n) {
       PetscCall(PetscLogGpuTimeBegin());
       PetscCallHIPBLAS(hipblasXgemv(hipblashandle,HIPBLAS_OP_C,n,k,&sone,d_A,lda,d_x,one,&szero,d_work,one));
       PetscCall(PetscLogGpuTimeEnd());
-      PetscCallHIP(hipMemcpy(bv->work,d_work,k*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,bv->work,d_work,k));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
     } else PetscCall(PetscArrayzero(bv->work,k));
     /* reduction */
     PetscCall(PetscMPIIntCast(k,&len));
     if (!y) {
       if (use_gpu_aware_mpi) {  /* case 1: reduce on GPU using a temporary buffer */
-        PetscCallHIP(hipMalloc((void**)&yy,k*sizeof(PetscScalar)));
+        PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,k,&yy));
+        PetscCall(PetscDeviceContextSynchronize(dctx));
         PetscCallMPI(MPIU_Allreduce(d_work,yy,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
-        PetscCallHIP(hipMemcpy(d_work,yy,k*sizeof(PetscScalar),hipMemcpyDeviceToDevice));
-        PetscCallHIP(hipFree(yy));
+        PetscCall(PetscDeviceArrayCopy(dctx,d_work,yy,k));
+        PetscCall(PetscDeviceFree(dctx,yy));
       } else {  /* case 2: reduce on CPU, copy result back to GPU */
-        PetscCall(BVAllocateWork_Private(bv,2*k));
         yy = bv->work+k;
-        PetscCallHIP(hipMemcpy(bv->work,d_work,k*sizeof(PetscScalar),hipMemcpyDeviceToHost));
-        PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
         PetscCallMPI(MPIU_Allreduce(bv->work,yy,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
-        PetscCallHIP(hipMemcpy(d_work,yy,k*sizeof(PetscScalar),hipMemcpyHostToDevice));
+        PetscCall(PetscDeviceArrayCopy(dctx,d_work,yy,k));
         PetscCall(PetscLogCpuToGpu(k*sizeof(PetscScalar)));
       }
       PetscCall(VecHIPRestoreArrayWrite(bv->buffer,&d_work));
     } else {  /* case 3: user-provided array y, reduce on CPU */
-      PetscCallHIP(hipFree(d_work));
+      PetscCall(PetscDeviceFree(dctx,d_work));
       PetscCallMPI(MPIU_Allreduce(bv->work,y,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
     }
   } else {
@@ -254,9 +285,10 @@ PetscErrorCode BVDotVec_BLAS_HIP(BV bv,PetscInt n_,PetscInt k_,const PetscScalar
     }
     if (!y) PetscCall(VecHIPRestoreArrayWrite(bv->buffer,&d_work));
     else {
-      PetscCallHIP(hipMemcpy(y,d_work,k*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+      PetscCall(PetscDeviceArrayCopy(dctx,y,d_work,k));
+      PetscCall(PetscDeviceContextSynchronize(dctx));
       PetscCall(PetscLogGpuToCpu(k*sizeof(PetscScalar)));
-      PetscCallHIP(hipFree(d_work));
+      PetscCall(PetscDeviceFree(dctx,d_work));
     }
   }
   PetscCall(PetscLogGpuFlops(2.0*n*k));
@@ -523,6 +555,34 @@ PetscErrorCode BV_SquareRoot_HIP(BV bv,PetscInt j,PetscScalar *h,PetscReal *beta
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   BV_SquareRootSum_HIP - Computes the square root of position j (counted after the constraints)
+   and the sum of squares of the previous positions of the coefficients array, with a
+   single copy to the host
+*/
+PetscErrorCode BV_SquareRootSum_HIP(BV bv,PetscInt j,PetscScalar *h,PetscReal *beta,PetscReal *sum)
+{
+  const PetscScalar *d_h;
+  PetscInt          i;
+
+  PetscFunctionBegin;
+  if (!h) {
+    PetscCall(BVAllocateWork_Private(bv,bv->nc+j+1));
+    PetscCall(VecHIPGetArrayRead(bv->buffer,&d_h));
+    PetscCall(PetscLogGpuTimeBegin());
+    PetscCallHIP(hipMemcpy(bv->work,d_h,(bv->nc+j+1)*sizeof(PetscScalar),hipMemcpyDeviceToHost));
+    PetscCall(PetscLogGpuToCpu((bv->nc+j+1)*sizeof(PetscScalar)));
+    PetscCall(PetscLogGpuTimeEnd());
+    PetscCall(VecHIPRestoreArrayRead(bv->buffer,&d_h));
+    h = bv->work;
+  }
+  PetscCall(BV_SafeSqrt(bv,h[bv->nc+j],beta));
+  *sum = 0.0;
+  for (i=0;i<bv->nc+j;i++) *sum += PetscRealPart(h[i]*PetscConj(h[i]));
+  PetscCall(PetscLogFlops(2.0*(bv->nc+j)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    BV_StoreCoefficients_HIP - Copy the contents of the coefficients array to an array dest
    provided by the caller (only values from l to j are copied)
@@ -204,22 +204,11 @@ static PetscErrorCode BVNormalize_Mat(BV bv,PetscScalar *eigi)
 static PetscErrorCode BVMatMult_Mat(BV V,Mat A,BV W)
 {
   PetscInt       j;
-  Mat            Vmat,Wmat;
   Vec            vv,ww;
 
   PetscFunctionBegin;
-  if (V->vmm) {
-    PetscCall(BVGetMat(V,&Vmat));
-    PetscCall(BVGetMat(W,&Wmat));
-    PetscCall(MatProductCreateWithMat(A,Vmat,NULL,Wmat));
-    PetscCall(MatProductSetType(Wmat,MATPRODUCT_AB));
-    PetscCall(MatProductSetFromOptions(Wmat));
-    PetscCall(MatProductSymbolic(Wmat));
-    PetscCall(MatProductNumeric(Wmat));
-    PetscCall(MatProductClear(Wmat));
-    PetscCall(BVRestoreMat(V,&Vmat));
-    PetscCall(BVRestoreMat(W,&Wmat));
-  } else {
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
     for (j=0;j<V->k-V->l;j++) {
       PetscCall(BVGetColumn(V,V->l+j,&vv));
       PetscCall(BVGetColumn(W,W->l+j,&ww));
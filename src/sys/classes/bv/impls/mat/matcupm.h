@@ -0,0 +1,460 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   BV implemented with a dense Mat, code shared by the CUDA and HIP versions
+
+   This file is included by the source of each version after defining either
+   SLEPC_CUPM_CUDA or SLEPC_CUPM_HIP, see slepccupmblas.h
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepccupmblas.h>
+#include "../src/sys/classes/bv/impls/mat/bvmat.h"
+
+PetscErrorCode SlepcCUPMName(BVMult_Mat)(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  BV_MAT            *y = (BV_MAT*)Y->data,*x = (BV_MAT*)X->data;
+  const PetscScalar *d_px,*d_A,*d_B,*d_q;
+  PetscScalar       *d_py,*d_C;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (!Y->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseCUPMGetArrayRead(x->A,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(MatDenseCUPMGetArrayWrite(y->A,&d_py));
+  else PetscCall(MatDenseCUPMGetArray(y->A,&d_py));
+  d_A = d_px+(X->nc+X->l)*X->ld;
+  d_C = d_py+(Y->nc+Y->l)*Y->ld;
+  if (Q) {
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(BV_MatDenseCUPMGetArrayRead(Y,Q,&d_q));
+    d_B = d_q+Y->l*ldq+X->l;
+    PetscCall(SlepcCUPMName(BVMult_BLAS)(Y,Y->n,Y->k-Y->l,X->k-X->l,alpha,d_A,X->ld,d_B,ldq,beta,d_C,Y->ld));
+    PetscCall(BV_MatDenseCUPMRestoreArrayRead(Y,Q,&d_q));
+  } else PetscCall(SlepcCUPMName(BVAXPY_BLAS)(Y,Y->n,Y->k-Y->l,alpha,d_A,X->ld,beta,d_C,Y->ld));
+  PetscCall(MatDenseCUPMRestoreArrayRead(x->A,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(MatDenseCUPMRestoreArrayWrite(y->A,&d_py));
+  else PetscCall(MatDenseCUPMRestoreArray(y->A,&d_py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultVec_Mat)(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  BV_MAT            *x = (BV_MAT*)X->data;
+  PetscScalar       *d_py,*d_q;
+  const PetscScalar *d_px;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseCUPMGetArrayRead(x->A,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMGetArrayWrite(y,&d_py));
+  else PetscCall(VecCUPMGetArray(y,&d_py));
+  if (!q) PetscCall(VecCUPMGetArray(X->buffer,&d_q));
+  else {
+    PetscInt k=X->k-X->l;
+    PetscCallCUPM(cupmMalloc((void**)&d_q,k*sizeof(PetscScalar)));
+    PetscCallCUPM(cupmMemcpy(d_q,q,k*sizeof(PetscScalar),cupmMemcpyHostToDevice));
+    PetscCall(PetscLogCpuToGpu(k*sizeof(PetscScalar)));
+  }
+  PetscCall(SlepcCUPMName(BVMultVec_BLAS)(X,X->n,X->k-X->l,alpha,d_px+(X->nc+X->l)*X->ld,X->ld,d_q,beta,d_py));
+  PetscCall(MatDenseCUPMRestoreArrayRead(x->A,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMRestoreArrayWrite(y,&d_py));
+  else PetscCall(VecCUPMRestoreArray(y,&d_py));
+  if (!q) PetscCall(VecCUPMRestoreArray(X->buffer,&d_q));
+  else PetscCallCUPM(cupmFree(d_q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultInPlace_Mat)(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_MAT            *ctx = (BV_MAT*)V->data;
+  PetscScalar       *d_pv;
+  const PetscScalar *d_q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseCUPMGetArray(ctx->A,&d_pv));
+  PetscCall(BV_MatDenseCUPMGetArrayRead(V,Q,&d_q));
+  PetscCall(SlepcCUPMName(BVMultInPlace_BLAS)(V,V->n,V->k-V->l,s-V->l,e-V->l,d_pv+(V->nc+V->l)*V->ld,V->ld,d_q+V->l*ldq+V->l,ldq,PETSC_FALSE));
+  PetscCall(BV_MatDenseCUPMRestoreArrayRead(V,Q,&d_q));
+  PetscCall(MatDenseCUPMRestoreArray(ctx->A,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultInPlaceHermitianTranspose_Mat)(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_MAT            *ctx = (BV_MAT*)V->data;
+  PetscScalar       *d_pv;
+  const PetscScalar *d_q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseCUPMGetArray(ctx->A,&d_pv));
+  PetscCall(BV_MatDenseCUPMGetArrayRead(V,Q,&d_q));
+  PetscCall(SlepcCUPMName(BVMultInPlace_BLAS)(V,V->n,V->k-V->l,s-V->l,e-V->l,d_pv+(V->nc+V->l)*V->ld,V->ld,d_q+V->l*ldq+V->l,ldq,PETSC_TRUE));
+  PetscCall(BV_MatDenseCUPMRestoreArrayRead(V,Q,&d_q));
+  PetscCall(MatDenseCUPMRestoreArray(ctx->A,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDot_Mat)(BV X,BV Y,Mat M)
+{
+  BV_MAT            *x = (BV_MAT*)X->data,*y = (BV_MAT*)Y->data;
+  const PetscScalar *d_px,*d_py;
+  PetscScalar       *pm;
+  PetscInt          ldm;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatDenseCUPMGetArrayRead(x->A,&d_px));
+  PetscCall(MatDenseCUPMGetArrayRead(y->A,&d_py));
+  PetscCall(MatDenseGetArrayWrite(M,&pm));
+  PetscCall(SlepcCUPMName(BVDot_BLAS)(X,Y->k-Y->l,X->k-X->l,X->n,d_py+(Y->nc+Y->l)*Y->ld,Y->ld,d_px+(X->nc+X->l)*X->ld,X->ld,pm+X->l*ldm+Y->l,ldm,x->mpi));
+  PetscCall(MatDenseRestoreArrayWrite(M,&pm));
+  PetscCall(MatDenseCUPMRestoreArrayRead(x->A,&d_px));
+  PetscCall(MatDenseCUPMRestoreArrayRead(y->A,&d_py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDotVec_Mat)(BV X,Vec y,PetscScalar *q)
+{
+  BV_MAT            *x = (BV_MAT*)X->data;
+  const PetscScalar *d_px,*d_py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(MatDenseCUPMGetArrayRead(x->A,&d_px));
+  PetscCall(VecCUPMGetArrayRead(z,&d_py));
+  PetscCall(SlepcCUPMName(BVDotVec_BLAS)(X,X->n,X->k-X->l,d_px+(X->nc+X->l)*X->ld,X->ld,d_py,q,x->mpi));
+  PetscCall(VecCUPMRestoreArrayRead(z,&d_py));
+  PetscCall(MatDenseCUPMRestoreArrayRead(x->A,&d_px));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDotVec_Local_Mat)(BV X,Vec y,PetscScalar *m)
+{
+  BV_MAT            *x = (BV_MAT*)X->data;
+  const PetscScalar *d_px,*d_py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(MatDenseCUPMGetArrayRead(x->A,&d_px));
+  PetscCall(VecCUPMGetArrayRead(z,&d_py));
+  PetscCall(SlepcCUPMName(BVDotVec_BLAS)(X,X->n,X->k-X->l,d_px+(X->nc+X->l)*X->ld,X->ld,d_py,m,PETSC_FALSE));
+  PetscCall(VecCUPMRestoreArrayRead(z,&d_py));
+  PetscCall(MatDenseCUPMRestoreArrayRead(x->A,&d_px));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVScale_Mat)(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscScalar    *d_array,*d_A;
+  PetscInt       n=0;
+
+  PetscFunctionBegin;
+  if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseCUPMGetArray(ctx->A,&d_array));
+  if (PetscUnlikely(j<0)) {
+    d_A = d_array+(bv->nc+bv->l)*bv->ld;
+    n = (bv->k-bv->l)*bv->ld;
+  } else {
+    d_A = d_array+(bv->nc+j)*bv->ld;
+    n = bv->n;
+  }
+  PetscCall(SlepcCUPMName(BVScale_BLAS)(bv,n,d_A,alpha));
+  PetscCall(MatDenseCUPMRestoreArray(ctx->A,&d_array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNorm_Mat)(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_MAT            *ctx = (BV_MAT*)bv->data;
+  const PetscScalar *array,*d_array,*d_A;
+  PetscInt          n=0;
+
+  PetscFunctionBegin;
+  if (!ctx->mpi && ((j<0 && type==NORM_FROBENIUS && bv->ld==bv->n) || (j>=0 && type==NORM_2))) {
+    /* compute on GPU with cuBLAS or hipBLAS - TODO: include the MPI case here */
+    *val = 0.0;
+    if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(MatDenseCUPMGetArrayRead(ctx->A,&d_array));
+    if (PetscUnlikely(j<0)) {
+      d_A = d_array+(bv->nc+bv->l)*bv->ld;
+      n = (bv->k-bv->l)*bv->ld;
+    } else {
+      d_A = d_array+(bv->nc+j)*bv->ld;
+      n = bv->n;
+    }
+    PetscCall(SlepcCUPMName(BVNorm_BLAS)(bv,n,d_A,val));
+    PetscCall(MatDenseCUPMRestoreArrayRead(ctx->A,&d_array));
+  } else {
+    /* compute on CPU */
+    PetscCall(MatDenseGetArrayRead(ctx->A,&array));
+    if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,ctx->mpi));
+    else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,array+(bv->nc+j)*bv->ld,bv->ld,type,val,ctx->mpi));
+    PetscCall(MatDenseRestoreArrayRead(ctx->A,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNorm_Local_Mat)(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_MAT            *ctx = (BV_MAT*)bv->data;
+  const PetscScalar *array,*d_array,*d_A;
+  PetscInt          n=0;
+
+  PetscFunctionBegin;
+  if ((j<0 && type==NORM_FROBENIUS && bv->ld==bv->n) || (j>=0 && type==NORM_2)) {
+    /* compute on GPU with cuBLAS or hipBLAS */
+    *val = 0.0;
+    if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(MatDenseCUPMGetArrayRead(ctx->A,&d_array));
+    if (PetscUnlikely(j<0)) {
+      d_A = d_array+(bv->nc+bv->l)*bv->ld;
+      n = (bv->k-bv->l)*bv->ld;
+    } else {
+      d_A = d_array+(bv->nc+j)*bv->ld;
+      n = bv->n;
+    }
+    PetscCall(SlepcCUPMName(BVNorm_BLAS)(bv,n,d_A,val));
+    PetscCall(MatDenseCUPMRestoreArrayRead(ctx->A,&d_array));
+  } else {
+    /* compute on CPU */
+    PetscCall(MatDenseGetArrayRead(ctx->A,&array));
+    if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+    else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,array+(bv->nc+j)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+    PetscCall(MatDenseRestoreArrayRead(ctx->A,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNormalize_Mat)(BV bv,PetscScalar *eigi)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscScalar    *array,*d_array,*wi=NULL;
+
+  PetscFunctionBegin;
+  if (eigi) wi = eigi+bv->l;
+  if (!ctx->mpi) {
+    /* compute on GPU with cuBLAS or hipBLAS - TODO: include the MPI case here */
+    if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(MatDenseCUPMGetArray(ctx->A,&d_array));
+    PetscCall(SlepcCUPMName(BVNormalize_BLAS)(bv,bv->n,bv->k-bv->l,d_array+(bv->nc+bv->l)*bv->ld,bv->ld,wi));
+    PetscCall(MatDenseCUPMRestoreArray(ctx->A,&d_array));
+  } else {
+    /* compute on CPU */
+    PetscCall(MatDenseGetArray(ctx->A,&array));
+    PetscCall(BVNormalize_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,wi,ctx->mpi));
+    PetscCall(MatDenseRestoreArray(ctx->A,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMatMult_Mat)(BV V,Mat A,BV W)
+{
+  BV_MAT            *v = (BV_MAT*)V->data,*w = (BV_MAT*)W->data;
+  const PetscScalar *d_pv;
+  PetscScalar       *d_pw;
+  PetscInt          j;
+
+  PetscFunctionBegin;
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
+    PetscCall(MatDenseCUPMGetArrayRead(v->A,&d_pv));
+    PetscCall(MatDenseCUPMGetArrayWrite(w->A,&d_pw));
+    for (j=0;j<V->k-V->l;j++) {
+      PetscCall(VecCUPMPlaceArray(V->cv[1],(PetscScalar *)d_pv+(V->nc+V->l+j)*V->ld));
+      PetscCall(VecCUPMPlaceArray(W->cv[1],d_pw+(W->nc+W->l+j)*W->ld));
+      PetscCall(MatMult(A,V->cv[1],W->cv[1]));
+      PetscCall(VecCUPMResetArray(V->cv[1]));
+      PetscCall(VecCUPMResetArray(W->cv[1]));
+    }
+    PetscCall(MatDenseCUPMRestoreArrayRead(v->A,&d_pv));
+    PetscCall(MatDenseCUPMRestoreArrayWrite(w->A,&d_pw));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVCopy_Mat)(BV V,BV W)
+{
+  BV_MAT            *v = (BV_MAT*)V->data,*w = (BV_MAT*)W->data;
+  const PetscScalar *d_pv;
+  PetscScalar       *d_pw;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseCUPMGetArrayRead(v->A,&d_pv));
+  PetscCall(MatDenseCUPMGetArray(w->A,&d_pw));
+  PetscCallCUPM(cupmMemcpy2D(d_pw+(W->nc+W->l)*W->ld,W->ld*sizeof(PetscScalar),d_pv+(V->nc+V->l)*V->ld,V->ld*sizeof(PetscScalar),V->n*sizeof(PetscScalar),V->k-V->l,cupmMemcpyDeviceToDevice));
+  PetscCall(MatDenseCUPMRestoreArrayRead(v->A,&d_pv));
+  PetscCall(MatDenseCUPMRestoreArray(w->A,&d_pw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVCopyColumn_Mat)(BV V,PetscInt j,PetscInt i)
+{
+  BV_MAT         *v = (BV_MAT*)V->data;
+  PetscScalar    *d_pv;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseCUPMGetArray(v->A,&d_pv));
+  PetscCallCUPM(cupmMemcpy(d_pv+(V->nc+i)*V->ld,d_pv+(V->nc+j)*V->ld,V->n*sizeof(PetscScalar),cupmMemcpyDeviceToDevice));
+  PetscCall(MatDenseCUPMRestoreArray(v->A,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVGetColumn_Mat)(BV bv,PetscInt j,Vec*)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscScalar    *d_pv;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  PetscCall(MatDenseCUPMGetArray(ctx->A,&d_pv));
+  PetscCall(VecCUPMPlaceArray(bv->cv[l],d_pv+(bv->nc+j)*bv->ld));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreColumn_Mat)(BV bv,PetscInt j,Vec*)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  PetscCall(VecCUPMResetArray(bv->cv[l]));
+  PetscCall(MatDenseCUPMRestoreArray(ctx->A,NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreSplit_Mat)(BV bv,BV *L,BV *R)
+{
+  Mat               A;
+  const PetscScalar *d_pv;
+  PetscObjectState  lstate,rstate;
+  PetscBool         change=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  /* force sync flag to PETSC_OFFLOAD_BOTH */
+  if (L) {
+    PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
+    if (lstate != bv->lstate) {
+      A = ((BV_MAT*)bv->L->data)->A;
+      PetscCall(MatDenseCUPMGetArrayRead(A,&d_pv));
+      PetscCall(MatDenseCUPMRestoreArrayRead(A,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (R) {
+    PetscCall(PetscObjectStateGet((PetscObject)*R,&rstate));
+    if (rstate != bv->rstate) {
+      A = ((BV_MAT*)bv->R->data)->A;
+      PetscCall(MatDenseCUPMGetArrayRead(A,&d_pv));
+      PetscCall(MatDenseCUPMRestoreArrayRead(A,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (change) {
+    A = ((BV_MAT*)bv->data)->A;
+    PetscCall(MatDenseCUPMGetArray(A,(PetscScalar **)&d_pv));
+    PetscCall(MatDenseCUPMRestoreArray(A,(PetscScalar **)&d_pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreSplitRows_Mat)(BV bv,IS,IS,BV *U,BV *L)
+{
+  Mat               A;
+  const PetscScalar *d_pv;
+  PetscObjectState  lstate,rstate;
+  PetscBool         change=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  /* force sync flag to PETSC_OFFLOAD_BOTH */
+  if (U) {
+    PetscCall(PetscObjectStateGet((PetscObject)*U,&rstate));
+    if (rstate != bv->rstate) {
+      A = ((BV_MAT*)bv->R->data)->A;
+      PetscCall(MatDenseCUPMGetArrayRead(A,&d_pv));
+      PetscCall(MatDenseCUPMRestoreArrayRead(A,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (L) {
+    PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
+    if (lstate != bv->lstate) {
+      A = ((BV_MAT*)bv->L->data)->A;
+      PetscCall(MatDenseCUPMGetArrayRead(A,&d_pv));
+      PetscCall(MatDenseCUPMRestoreArrayRead(A,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (change) {
+    A = ((BV_MAT*)bv->data)->A;
+    PetscCall(MatDenseCUPMGetArray(A,(PetscScalar **)&d_pv));
+    PetscCall(MatDenseCUPMRestoreArray(A,(PetscScalar **)&d_pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVGetMat_Mat)(BV bv,Mat *A)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscScalar    *vv,*aa;
+  PetscBool      create=PETSC_FALSE;
+  PetscInt       m,cols;
+
+  PetscFunctionBegin;
+  m = bv->k-bv->l;
+  if (!bv->Aget) create=PETSC_TRUE;
+  else {
+    PetscCall(MatDenseCUPMGetArray(bv->Aget,&aa));
+    PetscCheck(!aa,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"BVGetMat already called on this BV");
+    PetscCall(MatGetSize(bv->Aget,NULL,&cols));
+    if (cols!=m) {
+      PetscCall(MatDestroy(&bv->Aget));
+      create=PETSC_TRUE;
+    }
+  }
+  PetscCall(MatDenseCUPMGetArray(ctx->A,&vv));
+  if (create) {
+    PetscCall(MatCreateDenseFromVecType(PetscObjectComm((PetscObject)bv),bv->vtype,bv->n,PETSC_DECIDE,bv->N,m,bv->ld,vv,&bv->Aget)); /* pass a pointer to avoid allocation of storage */
+    PetscCall(MatDenseCUPMReplaceArray(bv->Aget,NULL));  /* replace with a null pointer, the value after BVRestoreMat */
+  }
+  PetscCall(MatDenseCUPMPlaceArray(bv->Aget,vv+(bv->nc+bv->l)*bv->ld));  /* set the actual pointer */
+  *A = bv->Aget;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreMat_Mat)(BV bv,Mat *A)
+{
+  BV_MAT         *ctx = (BV_MAT*)bv->data;
+  PetscScalar    *vv,*aa;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseCUPMGetArray(bv->Aget,&aa));
+  vv = aa-(bv->nc+bv->l)*bv->ld;
+  PetscCall(MatDenseCUPMResetArray(bv->Aget));
+  PetscCall(MatDenseCUPMRestoreArray(ctx->A,&vv));
+  *A = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
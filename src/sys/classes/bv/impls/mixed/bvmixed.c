@@ -0,0 +1,597 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   BV implemented as a single array stored in single precision, with all
+   computations done in the working precision
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepcblaslapack.h>
+
+/* scalars are stored as one float (real) or two floats (complex) */
+#if defined(PETSC_USE_COMPLEX)
+#define BV_MIXED_NR 2
+#define BV_MIXED_GET(a,i)   PetscCMPLX((PetscReal)(a)[2*(i)],(PetscReal)(a)[2*(i)+1])
+#define BV_MIXED_SET(a,i,x) do { (a)[2*(i)] = (float)PetscRealPart(x); (a)[2*(i)+1] = (float)PetscImaginaryPart(x); } while (0)
+#else
+#define BV_MIXED_NR 1
+#define BV_MIXED_GET(a,i)   ((PetscScalar)(a)[i])
+#define BV_MIXED_SET(a,i,x) ((a)[i] = (float)(x))
+#endif
+#define BV_MIXED_PTR(a,i)   ((a)+BV_MIXED_NR*(i))
+
+/* panels of rows are converted to the working precision, with about BV_MIXED_PANEL entries */
+#define BV_MIXED_PANEL   32768
+#define BV_MIXED_MINROWS 64
+
+typedef struct {
+  float       *array;   /* the entries of the BV, (nc+m)*ld scalars stored in single precision */
+  PetscScalar *w;       /* workspace for panels converted to the working precision */
+  PetscInt    lw;       /* size of w */
+  PetscScalar *a;       /* full array in working precision, returned by BVGetArray() */
+  PetscBool   mpi;
+} BV_MIXED;
+
+static PetscErrorCode BVMixedAllocateWork(BV bv,PetscInt s)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  if (s>ctx->lw) {
+    PetscCall(PetscFree(ctx->w));
+    PetscCall(PetscMalloc1(s,&ctx->w));
+    ctx->lw = s;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Number of rows of a panel with ncols columns
+*/
+static inline PetscInt BVMixedPanelRows(BV bv,PetscInt ncols)
+{
+  return PetscMax(1,PetscMin(bv->n,PetscMax(BV_MIXED_MINROWS,BV_MIXED_PANEL/PetscMax(ncols,1))));
+}
+
+/*
+   B := A, where A (mxn, ld=lda) is stored in single precision
+*/
+static inline PetscErrorCode BVMixedUnpack(const float *A,PetscInt lda,PetscInt m,PetscInt n,PetscScalar *B,PetscInt ldb)
+{
+  PetscInt i,j;
+
+  PetscFunctionBegin;
+  for (j=0;j<n;j++) for (i=0;i<m;i++) B[i+j*ldb] = BV_MIXED_GET(A,i+j*lda);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   A := B, where A (mxn, ld=lda) is stored in single precision
+*/
+static inline PetscErrorCode BVMixedPack(const PetscScalar *B,PetscInt ldb,PetscInt m,PetscInt n,float *A,PetscInt lda)
+{
+  PetscInt i,j;
+
+  PetscFunctionBegin;
+  for (j=0;j<n;j++) for (i=0;i<m;i++) BV_MIXED_SET(A,i+j*lda,B[i+j*ldb]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMult_Mixed(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  BV_MIXED          *y = (BV_MIXED*)Y->data,*x = (BV_MIXED*)X->data;
+  const PetscScalar *q=NULL;
+  PetscScalar       *px,*py;
+  PetscInt          ldq=0,i,r,nr,kx=X->k-X->l,ky=Y->k-Y->l;
+  const float       *ax = BV_MIXED_PTR(x->array,(X->nc+X->l)*X->ld);
+  float             *ay = BV_MIXED_PTR(y->array,(Y->nc+Y->l)*Y->ld);
+
+  PetscFunctionBegin;
+  r = BVMixedPanelRows(Y,kx+ky);
+  PetscCall(BVMixedAllocateWork(Y,r*(kx+ky)));
+  px = y->w;
+  py = y->w+r*kx;
+  if (Q) {
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(MatDenseGetArrayRead(Q,&q));
+  }
+  for (i=0;i<Y->n;i+=r) {
+    nr = PetscMin(r,Y->n-i);
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(ax,i),X->ld,nr,kx,px,nr));
+    if (beta!=(PetscScalar)0.0) PetscCall(BVMixedUnpack(BV_MIXED_PTR(ay,i),Y->ld,nr,ky,py,nr));
+    else PetscCall(PetscArrayzero(py,nr*ky));
+    if (Q) PetscCall(BVMult_BLAS_Private(Y,nr,ky,kx,alpha,px,nr,q+Y->l*ldq+X->l,ldq,beta,py,nr));
+    else PetscCall(BVAXPY_BLAS_Private(Y,nr,ky,alpha,px,nr,beta,py,nr));
+    PetscCall(BVMixedPack(py,nr,nr,ky,BV_MIXED_PTR(ay,i),Y->ld));
+  }
+  if (Q) PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultVec_Mixed(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  BV_MIXED       *x = (BV_MIXED*)X->data;
+  PetscScalar    *py,*qq=q;
+  PetscInt       i,r,nr,k=X->k-X->l;
+  const float    *ax = BV_MIXED_PTR(x->array,(X->nc+X->l)*X->ld);
+
+  PetscFunctionBegin;
+  r = BVMixedPanelRows(X,k);
+  PetscCall(BVMixedAllocateWork(X,r*k));
+  PetscCall(VecGetArray(y,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  for (i=0;i<X->n;i+=r) {
+    nr = PetscMin(r,X->n-i);
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(ax,i),X->ld,nr,k,x->w,nr));
+    PetscCall(BVMultVec_BLAS_Private(X,nr,k,alpha,x->w,nr,qq,beta,py+i));
+  }
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArray(y,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlace_Mixed_Private(BV V,Mat Q,PetscInt s,PetscInt e,PetscBool btrans)
+{
+  BV_MIXED          *ctx = (BV_MIXED*)V->data;
+  const PetscScalar *q;
+  PetscInt          ldq,i,r,nr,k=V->k-V->l;
+  float             *av = BV_MIXED_PTR(ctx->array,(V->nc+V->l)*V->ld);
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  r = BVMixedPanelRows(V,k);
+  PetscCall(BVMixedAllocateWork(V,r*k));
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseGetArrayRead(Q,&q));
+  for (i=0;i<V->n;i+=r) {
+    nr = PetscMin(r,V->n-i);
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(av,i),V->ld,nr,k,ctx->w,nr));
+    PetscCall(BVMultInPlace_BLAS_Private(V,nr,k,s-V->l,e-V->l,ctx->w,nr,q+V->l*ldq+V->l,ldq,btrans));
+    PetscCall(BVMixedPack(ctx->w+(s-V->l)*nr,nr,nr,e-s,BV_MIXED_PTR(av,i+(s-V->l)*V->ld),V->ld));
+  }
+  PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlace_Mixed(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscFunctionBegin;
+  PetscCall(BVMultInPlace_Mixed_Private(V,Q,s,e,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlaceHermitianTranspose_Mixed(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscFunctionBegin;
+  PetscCall(BVMultInPlace_Mixed_Private(V,Q,s,e,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDot_Mixed(BV X,BV Y,Mat M)
+{
+  BV_MIXED       *x = (BV_MIXED*)X->data,*y = (BV_MIXED*)Y->data;
+  PetscScalar    *m,*px,*py,*acc,*res,zero=0.0,one=1.0;
+  PetscInt       ldm,i,j,r,nr,kx=X->k-X->l,ky=Y->k-Y->l;
+  PetscBLASInt   m_,n_,k_;
+  PetscMPIInt    len;
+  const float    *ax = BV_MIXED_PTR(x->array,(X->nc+X->l)*X->ld);
+  const float    *ay = BV_MIXED_PTR(y->array,(Y->nc+Y->l)*Y->ld);
+
+  PetscFunctionBegin;
+  r = BVMixedPanelRows(X,kx+ky);
+  PetscCall(BVMixedAllocateWork(X,r*(kx+ky)+2*kx*ky));
+  px  = x->w;
+  py  = x->w+r*kx;
+  acc = py+r*ky;
+  res = acc+kx*ky;
+  PetscCall(PetscBLASIntCast(ky,&m_));
+  PetscCall(PetscBLASIntCast(kx,&n_));
+  PetscCall(PetscArrayzero(acc,kx*ky));
+  /* accumulate the local contributions of all panels */
+  for (i=0;i<X->n;i+=r) {
+    nr = PetscMin(r,X->n-i);
+    PetscCall(PetscBLASIntCast(nr,&k_));
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(ax,i),X->ld,nr,kx,px,nr));
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(ay,i),Y->ld,nr,ky,py,nr));
+    if (m_ && n_) PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&m_,&n_,&k_,&one,py,&k_,px,&k_,i?&one:&zero,acc,&m_));
+  }
+  PetscCall(PetscLogFlops(2.0*kx*ky*X->n));
+  if (x->mpi) {
+    PetscCall(PetscMPIIntCast(kx*ky,&len));
+    PetscCall(BVAllreduceSum_Private(X,acc,res,len));
+  } else res = acc;
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatDenseGetArray(M,&m));
+  for (j=0;j<kx;j++) PetscCall(PetscArraycpy(m+(X->l+j)*ldm+Y->l,res+j*ky,ky));
+  PetscCall(MatDenseRestoreArray(M,&m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   q := X'*y, with the local contributions of all panels added before the reduction
+*/
+static PetscErrorCode BVDotVec_Mixed_Private(BV X,const PetscScalar *py,PetscScalar *q,PetscBool mpi)
+{
+  BV_MIXED       *x = (BV_MIXED*)X->data;
+  PetscScalar    *acc,zero=0.0,done=1.0;
+  PetscInt       i,r,nr,k=X->k-X->l;
+  PetscBLASInt   n_,k_,one=1;
+  PetscMPIInt    len;
+  const float    *ax = BV_MIXED_PTR(x->array,(X->nc+X->l)*X->ld);
+
+  PetscFunctionBegin;
+  r = BVMixedPanelRows(X,k);
+  PetscCall(BVMixedAllocateWork(X,r*k+k));
+  acc = x->w+r*k;
+  PetscCall(PetscBLASIntCast(k,&k_));
+  PetscCall(PetscArrayzero(acc,k));
+  for (i=0;i<X->n;i+=r) {
+    nr = PetscMin(r,X->n-i);
+    PetscCall(PetscBLASIntCast(nr,&n_));
+    PetscCall(BVMixedUnpack(BV_MIXED_PTR(ax,i),X->ld,nr,k,x->w,nr));
+    if (k_) PetscCallBLAS("BLASgemv",BLASgemv_("C",&n_,&k_,&done,x->w,&n_,(PetscScalar*)py+i,&one,i?&done:&zero,acc,&one));
+  }
+  PetscCall(PetscLogFlops(2.0*X->n*k));
+  if (mpi) {
+    PetscCall(PetscMPIIntCast(k,&len));
+    PetscCall(BVAllreduceSum_Private(X,acc,q,len));
+  } else PetscCall(PetscArraycpy(q,acc,k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Mixed(BV X,Vec y,PetscScalar *q)
+{
+  BV_MIXED          *x = (BV_MIXED*)X->data;
+  const PetscScalar *py;
+  PetscScalar       *qq=q;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  PetscCall(BVDotVec_Mixed_Private(X,py,qq,x->mpi));
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Local_Mixed(BV X,Vec y,PetscScalar *m)
+{
+  const PetscScalar *py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  PetscCall(BVDotVec_Mixed_Private(X,py,m,PETSC_FALSE));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVScale_Mixed(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+  PetscInt       i,c,c0,c1;
+  float          *a;
+
+  PetscFunctionBegin;
+  if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (PetscUnlikely(j<0)) { c0 = bv->nc+bv->l; c1 = bv->nc+bv->k; }
+  else { c0 = bv->nc+j; c1 = c0+1; }
+  for (c=c0;c<c1;c++) {
+    a = BV_MIXED_PTR(ctx->array,c*bv->ld);
+    if (PetscUnlikely(alpha == (PetscScalar)0.0)) PetscCall(PetscArrayzero(a,BV_MIXED_NR*bv->n));
+    else for (i=0;i<bv->n;i++) BV_MIXED_SET(a,i,alpha*BV_MIXED_GET(a,i));
+  }
+  PetscCall(PetscLogFlops(1.0*bv->n*(c1-c0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Norm of column j (all active columns if j<0), computed in the working precision
+*/
+static PetscErrorCode BVNorm_Mixed_Private(BV bv,PetscInt j,NormType type,PetscReal *val,PetscBool mpi)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+  PetscInt       c0,k;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(j<0)) { c0 = bv->nc+bv->l; k = bv->k-bv->l; }
+  else { c0 = bv->nc+j; k = 1; }
+  PetscCall(BVMixedAllocateWork(bv,PetscMax(1,bv->n*k)));
+  PetscCall(BVMixedUnpack(BV_MIXED_PTR(ctx->array,c0*bv->ld),bv->ld,bv->n,k,ctx->w,bv->n));
+  PetscCall(BVNorm_LAPACK_Private(bv,bv->n,k,ctx->w,PetscMax(1,bv->n),type,val,mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Mixed(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(BVNorm_Mixed_Private(bv,j,type,val,ctx->mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Local_Mixed(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscFunctionBegin;
+  PetscCall(BVNorm_Mixed_Private(bv,j,type,val,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNormalize_Mixed(BV bv,PetscScalar *eigi)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+  PetscScalar    *wi=NULL;
+  PetscInt       k=bv->k-bv->l,ld=PetscMax(1,bv->n);
+  float          *a = BV_MIXED_PTR(ctx->array,(bv->nc+bv->l)*bv->ld);
+
+  PetscFunctionBegin;
+  if (eigi) wi = eigi+bv->l;
+  PetscCall(BVMixedAllocateWork(bv,ld*k));
+  PetscCall(BVMixedUnpack(a,bv->ld,bv->n,k,ctx->w,ld));
+  PetscCall(BVNormalize_LAPACK_Private(bv,bv->n,k,ctx->w,ld,wi,ctx->mpi));
+  PetscCall(BVMixedPack(ctx->w,ld,bv->n,k,a,bv->ld));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMatMult_Mixed(BV V,Mat A,BV W)
+{
+  PetscInt       j;
+  Vec            vv,ww;
+
+  PetscFunctionBegin;
+  /* always column by column, to avoid a copy of the BV in the working precision */
+  for (j=0;j<V->k-V->l;j++) {
+    PetscCall(BVGetColumn(V,V->l+j,&vv));
+    PetscCall(BVGetColumn(W,W->l+j,&ww));
+    PetscCall(MatMult(A,vv,ww));
+    PetscCall(BVRestoreColumn(V,V->l+j,&vv));
+    PetscCall(BVRestoreColumn(W,W->l+j,&ww));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopy_Mixed(BV V,BV W)
+{
+  BV_MIXED       *v = (BV_MIXED*)V->data,*w = (BV_MIXED*)W->data;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  for (j=0;j<V->k-V->l;j++) PetscCall(PetscArraycpy(BV_MIXED_PTR(w->array,(W->nc+W->l+j)*W->ld),BV_MIXED_PTR(v->array,(V->nc+V->l+j)*V->ld),BV_MIXED_NR*V->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopyColumn_Mixed(BV V,PetscInt j,PetscInt i)
+{
+  BV_MIXED       *v = (BV_MIXED*)V->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArraycpy(BV_MIXED_PTR(v->array,(V->nc+i)*V->ld),BV_MIXED_PTR(v->array,(V->nc+j)*V->ld),BV_MIXED_NR*V->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVResize_Mixed(BV bv,PetscInt m,PetscBool copy)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+  float          *newarray;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(BV_MIXED_NR*m*bv->ld,&newarray));
+  if (copy) PetscCall(PetscArraycpy(newarray,ctx->array,BV_MIXED_NR*PetscMin(m,bv->m)*bv->ld));
+  PetscCall(PetscFree(ctx->array));
+  ctx->array = newarray;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetColumn_Mixed(BV bv,PetscInt j,Vec *v)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+  PetscScalar    *pv;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  PetscCall(VecGetArrayWrite(bv->cv[l],&pv));
+  PetscCall(BVMixedUnpack(BV_MIXED_PTR(ctx->array,(bv->nc+j)*bv->ld),bv->ld,bv->n,1,pv,bv->n));
+  PetscCall(VecRestoreArrayWrite(bv->cv[l],&pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreColumn_Mixed(BV bv,PetscInt j,Vec *v)
+{
+  BV_MIXED          *ctx = (BV_MIXED*)bv->data;
+  const PetscScalar *pv;
+  PetscObjectState  st;
+  PetscInt          l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  /* copy back to the BV storage only if the vector has been modified */
+  PetscCall(VecGetState(bv->cv[l],&st));
+  if (st!=bv->st[l]) {
+    PetscCall(VecGetArrayRead(bv->cv[l],&pv));
+    PetscCall(BVMixedPack(pv,bv->n,bv->n,1,BV_MIXED_PTR(ctx->array,(bv->nc+j)*bv->ld),bv->ld));
+    PetscCall(VecRestoreArrayRead(bv->cv[l],&pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArray_Mixed(BV bv,PetscScalar **a)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ctx->a,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"BVGetArray already called on this BV");
+  PetscCall(PetscMalloc1((bv->nc+bv->m)*bv->ld,&ctx->a));
+  PetscCall(BVMixedUnpack(ctx->array,bv->ld,bv->n,bv->nc+bv->m,ctx->a,bv->ld));
+  *a = ctx->a;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreArray_Mixed(BV bv,PetscScalar **a)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(BVMixedPack(ctx->a,bv->ld,bv->n,bv->nc+bv->m,ctx->array,bv->ld));
+  PetscCall(PetscFree(ctx->a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArrayRead_Mixed(BV bv,const PetscScalar **a)
+{
+  PetscFunctionBegin;
+  PetscCall(BVGetArray_Mixed(bv,(PetscScalar**)a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreArrayRead_Mixed(BV bv,const PetscScalar **a)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(ctx->a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVView_Mixed(BV bv,PetscViewer viewer)
+{
+  PetscInt          j;
+  Vec               v;
+  PetscViewerFormat format;
+  PetscBool         isascii,ismatlab=PETSC_FALSE;
+  const char        *bvname,*name;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    PetscCall(PetscViewerGetFormat(viewer,&format));
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscCall(PetscViewerASCIIPrintf(viewer,"  storing vectors in single precision\n"));
+    if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+    if (format == PETSC_VIEWER_ASCII_MATLAB) ismatlab = PETSC_TRUE;
+  }
+  if (ismatlab) {
+    PetscCall(PetscObjectGetName((PetscObject)bv,&bvname));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[];\n",bvname));
+  }
+  for (j=0;j<bv->m;j++) {
+    PetscCall(BVGetColumn(bv,j,&v));
+    PetscCall(VecView(v,viewer));
+    if (ismatlab) {
+      PetscCall(PetscObjectGetName((PetscObject)v,&name));
+      PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[%s,%s];clear %s\n",bvname,bvname,name,name));
+    }
+    PetscCall(BVRestoreColumn(bv,j,&v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDestroy_Mixed(BV bv)
+{
+  BV_MIXED       *ctx = (BV_MIXED*)bv->data;
+
+  PetscFunctionBegin;
+  if (!bv->issplit) PetscCall(PetscFree(ctx->array));
+  PetscCall(PetscFree(ctx->w));
+  PetscCall(PetscFree(ctx->a));
+  PetscCall(VecDestroy(&bv->cv[0]));
+  PetscCall(VecDestroy(&bv->cv[1]));
+  PetscCall(PetscFree(bv->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode BVCreate_Mixed(BV bv)
+{
+  BV_MIXED          *ctx;
+  PetscInt          j,nloc,lsplit,lda;
+  PetscBool         seq,isdense;
+  const PetscScalar *aa;
+  float             *array;
+  BV                parent;
+  MatType           mtype;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_REAL_DOUBLE)
+  SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"BVMIXED requires PETSc configured with double precision");
+#endif
+  PetscCall(PetscNew(&ctx));
+  bv->data = (void*)ctx;
+
+  PetscCall(PetscStrcmp(bv->vtype,VECMPI,&ctx->mpi));
+  if (!ctx->mpi) {
+    PetscCall(PetscStrcmp(bv->vtype,VECSEQ,&seq));
+    PetscCheck(seq,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Cannot create a mixed BV from a non-standard vector type: %s",bv->vtype);
+  }
+
+  PetscCall(PetscLayoutGetLocalSize(bv->map,&nloc));
+  PetscCall(BV_SetDefaultLD(bv,nloc));
+
+  if (PetscUnlikely(bv->issplit)) {
+    /* split BV: share memory of the parent BV */
+    parent = bv->splitparent;
+    lsplit = parent->lsplit;
+    array  = ((BV_MIXED*)parent->data)->array;
+    if (bv->issplit>0) ctx->array = (bv->issplit==1)? array: BV_MIXED_PTR(array,lsplit*bv->ld);
+    else ctx->array = (bv->issplit==-1)? array: BV_MIXED_PTR(array,-lsplit);
+  } else {
+    /* regular BV: allocate memory for the BV entries */
+    PetscCall(PetscCalloc1(BV_MIXED_NR*bv->m*bv->ld,&ctx->array));
+  }
+
+  if (PetscUnlikely(bv->Acreate)) {
+    PetscCall(MatGetType(bv->Acreate,&mtype));
+    PetscCall(PetscStrcmpAny(mtype,&isdense,MATSEQDENSE,MATMPIDENSE,""));
+    PetscCheck(isdense,PetscObjectComm((PetscObject)bv->Acreate),PETSC_ERR_SUP,"BVMIXED requires a dense matrix in BVCreateFromMat()");
+    PetscCall(MatDenseGetArrayRead(bv->Acreate,&aa));
+    PetscCall(MatDenseGetLDA(bv->Acreate,&lda));
+    for (j=0;j<bv->m;j++) PetscCall(BVMixedPack(aa+j*lda,lda,bv->n,1,BV_MIXED_PTR(ctx->array,j*bv->ld),bv->ld));
+    PetscCall(MatDenseRestoreArrayRead(bv->Acreate,&aa));
+    PetscCall(MatDestroy(&bv->Acreate));
+  }
+
+  PetscCall(BVCreateVec(bv,&bv->cv[0]));
+  PetscCall(BVCreateVec(bv,&bv->cv[1]));
+
+  bv->ops->mult             = BVMult_Mixed;
+  bv->ops->multvec          = BVMultVec_Mixed;
+  bv->ops->multinplace      = BVMultInPlace_Mixed;
+  bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Mixed;
+  bv->ops->dot              = BVDot_Mixed;
+  bv->ops->dotvec           = BVDotVec_Mixed;
+  bv->ops->dotvec_local     = BVDotVec_Local_Mixed;
+  bv->ops->scale            = BVScale_Mixed;
+  bv->ops->norm             = BVNorm_Mixed;
+  bv->ops->norm_local       = BVNorm_Local_Mixed;
+  bv->ops->normalize        = BVNormalize_Mixed;
+  bv->ops->matmult          = BVMatMult_Mixed;
+  bv->ops->copy             = BVCopy_Mixed;
+  bv->ops->copycolumn       = BVCopyColumn_Mixed;
+  bv->ops->resize           = BVResize_Mixed;
+  bv->ops->getcolumn        = BVGetColumn_Mixed;
+  bv->ops->restorecolumn    = BVRestoreColumn_Mixed;
+  bv->ops->getarray         = BVGetArray_Mixed;
+  bv->ops->restorearray     = BVRestoreArray_Mixed;
+  bv->ops->getarrayread     = BVGetArrayRead_Mixed;
+  bv->ops->restorearrayread = BVRestoreArrayRead_Mixed;
+  bv->ops->getmat           = BVGetMat_Default;
+  bv->ops->restoremat       = BVRestoreMat_Default;
+  bv->ops->destroy          = BVDestroy_Mixed;
+  bv->ops->view             = BVView_Mixed;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,682 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   BV implemented as an array of Vecs sharing a contiguous array that is
+   mapped to a (temporary) file, so that the basis can be larger than memory;
+   the storage can also be mapped to a region of a user file, see BVMmapSetFile()
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepcblaslapack.h>
+#if defined(PETSC_HAVE_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#endif
+#if defined(PETSC_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+#include <stdlib.h>
+
+/* operations with many columns are done in panels of columns of about this size in bytes */
+#define BV_MMAP_PANEL 33554432
+
+typedef struct {
+  Vec         *V;
+  PetscScalar *array;
+  size_t      len;      /* length of the mapping in bytes */
+  size_t      delta;    /* offset of array from the start of the (page-aligned) mapping */
+  PetscScalar *w;       /* workspace for local results */
+  PetscInt    lw;       /* size of w */
+  PetscBool   mpi;
+} BV_MMAP;
+
+static PetscErrorCode BVMmapAllocateWork(BV bv,PetscInt s)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (s>ctx->lw) {
+    PetscCall(PetscFree(ctx->w));
+    PetscCall(PetscMalloc1(s,&ctx->w));
+    ctx->lw = s;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Map a zero-initialized array of n scalars to an anonymous temporary file,
+   created in the directory given by -bv_mmap_dir (default: PETSc's tmp directory)
+*/
+static PetscErrorCode BVMmapAllocate(BV bv,PetscInt n,PetscScalar **array,size_t *len)
+{
+#if defined(PETSC_HAVE_MMAP) && defined(PETSC_HAVE_UNISTD_H)
+  char           dir[PETSC_MAX_PATH_LEN],fname[PETSC_MAX_PATH_LEN];
+  PetscBool      flg;
+  int            fd;
+  void           *p;
+
+  PetscFunctionBegin;
+  *len = PetscMax(1,(size_t)n)*sizeof(PetscScalar);
+  PetscCall(PetscOptionsGetString(((PetscObject)bv)->options,((PetscObject)bv)->prefix,"-bv_mmap_dir",dir,sizeof(dir),&flg));
+  if (!flg) PetscCall(PetscGetTmp(PETSC_COMM_SELF,dir,sizeof(dir)));
+  PetscCall(PetscSNPrintf(fname,sizeof(fname),"%s/slepc-bv-XXXXXX",dir));
+  fd = mkstemp(fname);
+  PetscCheck(fd>=0,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to create file %s to store the BV",fname);
+  PetscCheck(!unlink(fname),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to unlink file %s",fname);
+  PetscCheck(!ftruncate(fd,(off_t)*len),PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Unable to extend file to %" PetscInt64_FMT " bytes, check the space available in %s",(PetscInt64)*len,dir);
+  p = mmap(NULL,*len,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  PetscCheck(p!=MAP_FAILED,PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to map %" PetscInt64_FMT " bytes of file storage",(PetscInt64)*len);
+  PetscCheck(!close(fd),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to close file %s",fname);
+  *array = (PetscScalar*)p;
+  PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"BVMMAP requires mmap() support");
+#endif
+}
+
+static PetscErrorCode BVMmapFree(PetscScalar **array,size_t len,size_t delta)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MMAP)
+  if (*array) PetscCheck(!munmap((void*)((char*)*array-delta),len),PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to unmap BV storage");
+#endif
+  *array = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Hint the system to read in advance columns [j,j+k) of the BV (non-blocking)
+*/
+static inline PetscErrorCode BVMmapPrefetch(BV bv,PetscInt j,PetscInt k)
+{
+#if defined(PETSC_HAVE_MMAP) && defined(MADV_WILLNEED)
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  long           pg = sysconf(_SC_PAGESIZE);
+  char           *p,*q;
+
+  PetscFunctionBegin;
+  if (k<=0 || !bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  p = (char*)(ctx->array+j*bv->ld);
+  q = (char*)(ctx->array+(j+k-1)*bv->ld+bv->n);
+  p -= ((size_t)p)%pg;   /* madvise() requires a page-aligned address */
+  (void)madvise(p,(size_t)(q-p),MADV_WILLNEED);
+  PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  (void)bv;(void)j;(void)k;  // avoid unused parameter warning
+  PetscFunctionReturn(PETSC_SUCCESS);
+#endif
+}
+
+/*
+   Number of columns of a panel
+*/
+static inline PetscInt BVMmapPanelCols(BV bv)
+{
+  return PetscMax(1,(PetscInt)(BV_MMAP_PANEL/(sizeof(PetscScalar)*PetscMax(1,bv->ld))));
+}
+
+static PetscErrorCode BVMult_Mmap(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  BV_MMAP           *y = (BV_MMAP*)Y->data,*x = (BV_MMAP*)X->data;
+  const PetscScalar *q;
+  PetscInt          ldq,p,np,pc,kx=X->k-X->l;
+
+  PetscFunctionBegin;
+  if (Q) {
+    /* Y = beta*Y + alpha*sum_p X(:,p)*Q(p,:), streaming the panels of X */
+    pc = BVMmapPanelCols(X);
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(MatDenseGetArrayRead(Q,&q));
+    PetscCall(BVMmapPrefetch(X,X->nc+X->l,PetscMin(pc,kx)));
+    for (p=0;p<kx;p+=pc) {
+      np = PetscMin(pc,kx-p);
+      PetscCall(BVMmapPrefetch(X,X->nc+X->l+p+np,PetscMin(pc,kx-p-np)));
+      PetscCall(BVMult_BLAS_Private(Y,Y->n,Y->k-Y->l,np,alpha,x->array+(X->nc+X->l+p)*X->ld,X->ld,q+Y->l*ldq+X->l+p,ldq,p?1.0:beta,y->array+(Y->nc+Y->l)*Y->ld,Y->ld));
+    }
+    if (!kx) PetscCall(BVScale_BLAS_Private(Y,(Y->k-Y->l)*Y->ld,y->array+(Y->nc+Y->l)*Y->ld,beta));
+    PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  } else PetscCall(BVAXPY_BLAS_Private(Y,Y->n,Y->k-Y->l,alpha,x->array+(X->nc+X->l)*X->ld,X->ld,beta,y->array+(Y->nc+Y->l)*Y->ld,Y->ld));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultVec_Mmap(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  BV_MMAP        *x = (BV_MMAP*)X->data;
+  PetscScalar    *py,*qq=q;
+  PetscInt       p,np,pc,k=X->k-X->l;
+
+  PetscFunctionBegin;
+  pc = BVMmapPanelCols(X);
+  PetscCall(VecGetArray(y,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  PetscCall(BVMmapPrefetch(X,X->nc+X->l,PetscMin(pc,k)));
+  for (p=0;p<k;p+=pc) {
+    np = PetscMin(pc,k-p);
+    PetscCall(BVMmapPrefetch(X,X->nc+X->l+p+np,PetscMin(pc,k-p-np)));
+    PetscCall(BVMultVec_BLAS_Private(X,X->n,np,alpha,x->array+(X->nc+X->l+p)*X->ld,X->ld,qq+p,p?1.0:beta,py));
+  }
+  if (!k) PetscCall(BVScale_BLAS_Private(X,X->n,py,beta));
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArray(y,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlace_Mmap(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_MMAP           *ctx = (BV_MMAP*)V->data;
+  const PetscScalar *q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseGetArrayRead(Q,&q));
+  PetscCall(BVMmapPrefetch(V,V->nc+V->l,V->k-V->l));
+  PetscCall(BVMultInPlace_BLAS_Private(V,V->n,V->k-V->l,s-V->l,e-V->l,ctx->array+(V->nc+V->l)*V->ld,V->ld,q+V->l*ldq+V->l,ldq,PETSC_FALSE));
+  PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlaceHermitianTranspose_Mmap(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_MMAP           *ctx = (BV_MMAP*)V->data;
+  const PetscScalar *q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseGetArrayRead(Q,&q));
+  PetscCall(BVMmapPrefetch(V,V->nc+V->l,V->k-V->l));
+  PetscCall(BVMultInPlace_BLAS_Private(V,V->n,V->k-V->l,s-V->l,e-V->l,ctx->array+(V->nc+V->l)*V->ld,V->ld,q+V->l*ldq+V->l,ldq,PETSC_TRUE));
+  PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDot_Mmap(BV X,BV Y,Mat M)
+{
+  BV_MMAP        *x = (BV_MMAP*)X->data,*y = (BV_MMAP*)Y->data;
+  PetscScalar    *m,*res;
+  PetscInt       ldm,j,p,np,pc,kx=X->k-X->l,ky=Y->k-Y->l;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  /* local products for each panel of X, followed by a single reduction */
+  pc = BVMmapPanelCols(X);
+  PetscCall(BVMmapAllocateWork(X,2*kx*ky));
+  PetscCall(BVMmapPrefetch(X,X->nc+X->l,PetscMin(pc,kx)));
+  for (p=0;p<kx;p+=pc) {
+    np = PetscMin(pc,kx-p);
+    PetscCall(BVMmapPrefetch(X,X->nc+X->l+p+np,PetscMin(pc,kx-p-np)));
+    PetscCall(BVDot_BLAS_Private(X,ky,np,X->n,y->array+(Y->nc+Y->l)*Y->ld,Y->ld,x->array+(X->nc+X->l+p)*X->ld,X->ld,x->w+p*ky,ky,PETSC_FALSE));
+  }
+  if (!X->n) PetscCall(PetscArrayzero(x->w,kx*ky));
+  res = x->w;
+  if (x->mpi) {
+    res = x->w+kx*ky;
+    PetscCall(PetscMPIIntCast(kx*ky,&len));
+    PetscCall(BVAllreduceSum_Private(X,x->w,res,len));
+  }
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatDenseGetArray(M,&m));
+  for (j=0;j<kx;j++) PetscCall(PetscArraycpy(m+(X->l+j)*ldm+Y->l,res+j*ky,ky));
+  PetscCall(MatDenseRestoreArray(M,&m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   q := X'*y computed by panels, the reduction (if mpi) is done at the end
+*/
+static PetscErrorCode BVDotVec_Mmap_Private(BV X,const PetscScalar *py,PetscScalar *q,PetscBool mpi)
+{
+  BV_MMAP        *x = (BV_MMAP*)X->data;
+  PetscInt       p,np,pc,k=X->k-X->l;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  pc = BVMmapPanelCols(X);
+  PetscCall(BVMmapAllocateWork(X,k));
+  PetscCall(BVMmapPrefetch(X,X->nc+X->l,PetscMin(pc,k)));
+  for (p=0;p<k;p+=pc) {
+    np = PetscMin(pc,k-p);
+    PetscCall(BVMmapPrefetch(X,X->nc+X->l+p+np,PetscMin(pc,k-p-np)));
+    PetscCall(BVDotVec_BLAS_Private(X,X->n,np,x->array+(X->nc+X->l+p)*X->ld,X->ld,py,mpi?x->w+p:q+p,PETSC_FALSE));
+  }
+  if (!X->n) PetscCall(PetscArrayzero(mpi?x->w:q,k));
+  if (mpi) {
+    PetscCall(PetscMPIIntCast(k,&len));
+    PetscCall(BVAllreduceSum_Private(X,x->w,q,len));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Mmap(BV X,Vec y,PetscScalar *q)
+{
+  BV_MMAP           *x = (BV_MMAP*)X->data;
+  const PetscScalar *py;
+  PetscScalar       *qq=q;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  PetscCall(BVDotVec_Mmap_Private(X,py,qq,x->mpi));
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Local_Mmap(BV X,Vec y,PetscScalar *m)
+{
+  const PetscScalar *py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  PetscCall(BVDotVec_Mmap_Private(X,py,m,PETSC_FALSE));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVScale_Mmap(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (PetscUnlikely(j<0)) PetscCall(BVScale_BLAS_Private(bv,(bv->k-bv->l)*bv->ld,ctx->array+(bv->nc+bv->l)*bv->ld,alpha));
+  else PetscCall(BVScale_BLAS_Private(bv,bv->n,ctx->array+(bv->nc+j)*bv->ld,alpha));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Mmap(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,ctx->array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,ctx->mpi));
+  else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,ctx->array+(bv->nc+j)*bv->ld,bv->ld,type,val,ctx->mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Local_Mmap(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,ctx->array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+  else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,ctx->array+(bv->nc+j)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNormalize_Mmap(BV bv,PetscScalar *eigi)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscScalar    *wi=NULL;
+
+  PetscFunctionBegin;
+  if (eigi) wi = eigi+bv->l;
+  PetscCall(BVNormalize_LAPACK_Private(bv,bv->n,bv->k-bv->l,ctx->array+(bv->nc+bv->l)*bv->ld,bv->ld,wi,ctx->mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMatMult_Mmap(BV V,Mat A,BV W)
+{
+  BV_MMAP        *v = (BV_MMAP*)V->data,*w = (BV_MMAP*)W->data;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
+    for (j=0;j<V->k-V->l;j++) {
+      PetscCall(BVMmapPrefetch(V,V->nc+V->l+j+1,1));
+      PetscCall(MatMult(A,v->V[V->nc+V->l+j],w->V[W->nc+W->l+j]));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopy_Mmap(BV V,BV W)
+{
+  BV_MMAP        *v = (BV_MMAP*)V->data,*w = (BV_MMAP*)W->data;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  for (j=0;j<V->k-V->l;j++) PetscCall(PetscArraycpy(w->array+(W->nc+W->l+j)*W->ld,v->array+(V->nc+V->l+j)*V->ld,V->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopyColumn_Mmap(BV V,PetscInt j,PetscInt i)
+{
+  BV_MMAP        *v = (BV_MMAP*)V->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArraycpy(v->array+(V->nc+i)*V->ld,v->array+(V->nc+j)*V->ld,V->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Create the Vecs that wrap the columns of the array
+*/
+static PetscErrorCode BVMmapCreateVecs(BV bv,PetscInt m,PetscScalar *array,Vec **V)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscInt       j,bs;
+  char           str[50];
+
+  PetscFunctionBegin;
+  PetscCall(PetscLayoutGetBlockSize(bv->map,&bs));
+  PetscCall(PetscMalloc1(m,V));
+  for (j=0;j<m;j++) {
+    if (ctx->mpi) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)bv),bs,bv->n,PETSC_DECIDE,array+j*bv->ld,*V+j));
+    else PetscCall(VecCreateSeqWithArray(PetscObjectComm((PetscObject)bv),bs,bv->n,array+j*bv->ld,*V+j));
+  }
+  if (((PetscObject)bv)->name) {
+    for (j=0;j<m;j++) {
+      PetscCall(PetscSNPrintf(str,sizeof(str),"%s_%" PetscInt_FMT,((PetscObject)bv)->name,j));
+      PetscCall(PetscObjectSetName((PetscObject)(*V)[j],str));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVResize_Mmap(BV bv,PetscInt m,PetscBool copy)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscScalar    *newarray;
+  Vec            *newV;
+  size_t         newlen;
+
+  PetscFunctionBegin;
+  PetscCall(BVMmapAllocate(bv,m*bv->ld,&newarray,&newlen));
+  PetscCall(BVMmapCreateVecs(bv,m,newarray,&newV));
+  if (copy) PetscCall(PetscArraycpy(newarray,ctx->array,PetscMin(m,bv->m)*bv->ld));
+  PetscCall(VecDestroyVecs(bv->m,&ctx->V));
+  ctx->V = newV;
+  PetscCall(BVMmapFree(&ctx->array,ctx->len,ctx->delta));
+  ctx->array = newarray;
+  ctx->len   = newlen;
+  ctx->delta = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetColumn_Mmap(BV bv,PetscInt j,Vec *v)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  bv->cv[l] = ctx->V[bv->nc+j];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreColumn_Mmap(BV bv,PetscInt j,Vec *v)
+{
+  PetscInt l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  bv->cv[l] = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArray_Mmap(BV bv,PetscScalar **a)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  *a = ctx->array;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArrayRead_Mmap(BV bv,const PetscScalar **a)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  *a = ctx->array;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDestroy_Mmap(BV bv)
+{
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+
+  PetscFunctionBegin;
+  if (!bv->issplit) {
+    PetscCall(VecDestroyVecs(bv->nc+bv->m,&ctx->V));
+    PetscCall(BVMmapFree(&ctx->array,ctx->len,ctx->delta));
+  }
+  PetscCall(PetscFree(ctx->w));
+  PetscCall(PetscObjectComposeFunction((PetscObject)bv,"BVMmapSetFile_C",NULL));
+  PetscCall(PetscFree(bv->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVView_Mmap(BV bv,PetscViewer viewer)
+{
+  PetscInt          j;
+  Vec               v;
+  PetscViewerFormat format;
+  PetscBool         isascii,ismatlab=PETSC_FALSE;
+  const char        *bvname,*name;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    PetscCall(PetscViewerGetFormat(viewer,&format));
+    if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+    if (format == PETSC_VIEWER_ASCII_MATLAB) ismatlab = PETSC_TRUE;
+  }
+  if (ismatlab) {
+    PetscCall(PetscObjectGetName((PetscObject)bv,&bvname));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[];\n",bvname));
+  }
+  for (j=0;j<bv->m;j++) {
+    PetscCall(BVGetColumn(bv,j,&v));
+    PetscCall(VecView(v,viewer));
+    if (ismatlab) {
+      PetscCall(PetscObjectGetName((PetscObject)v,&name));
+      PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[%s,%s];clear %s\n",bvname,bvname,name,name));
+    }
+    PetscCall(BVRestoreColumn(bv,j,&v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMmapSetFile_Mmap(BV bv,const char filename[],PetscInt64 offset)
+{
+#if defined(PETSC_HAVE_MMAP) && defined(PETSC_HAVE_UNISTD_H)
+  BV_MMAP        *ctx = (BV_MMAP*)bv->data;
+  MPI_Comm       comm = PetscObjectComm((PetscObject)bv);
+  PetscMPIInt    rank;
+  PetscInt64     lbytes,loff=0,total;
+  long           pg = sysconf(_SC_PAGESIZE);
+  size_t         delta=0,len=0;
+  PetscScalar    *array=NULL;
+  struct stat    st;
+  int            fd;
+  void           *p;
+
+  PetscFunctionBegin;
+  PetscCheck(!bv->issplit && !bv->nc,comm,PETSC_ERR_SUP,"Cannot map the storage of a split BV or a BV with constraints to a file");
+  PetscCheck(bv->ci[0]==-1 && bv->ci[1]==-1,comm,PETSC_ERR_ARG_WRONGSTATE,"Must restore all columns before calling BVMmapSetFile()");
+  PetscCheck(offset>=0 && offset%sizeof(PetscScalar)==0,comm,PETSC_ERR_ARG_OUTOFRANGE,"The offset must be a nonnegative multiple of sizeof(PetscScalar)");
+  PetscCallMPI(MPI_Comm_rank(comm,&rank));
+
+  /* the local arrays are stored one after the other, in the order of the processes */
+  lbytes = (PetscInt64)bv->ld*bv->m*sizeof(PetscScalar);
+  PetscCallMPI(MPI_Exscan(&lbytes,&loff,1,MPIU_INT64,MPI_SUM,comm));
+  if (!rank) loff = 0;
+  PetscCallMPI(MPIU_Allreduce(&lbytes,&total,1,MPIU_INT64,MPI_SUM,comm));
+  if (!rank) {
+    fd = open(filename,O_RDWR|O_CREAT,0644);
+    PetscCheck(fd>=0,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to open file %s",filename);
+    PetscCheck(!fstat(fd,&st),PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Unable to get the size of file %s",filename);
+    if ((PetscInt64)st.st_size<offset+total) PetscCheck(!ftruncate(fd,(off_t)(offset+total)),PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Unable to extend file %s to %" PetscInt64_FMT " bytes",filename,offset+total);
+    PetscCheck(!close(fd),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to close file %s",filename);
+  }
+  PetscCallMPI(MPI_Barrier(comm));
+
+  if (lbytes) {
+    loff += offset;
+    delta = (size_t)(loff%pg);   /* mmap() requires a page-aligned offset */
+    len   = (size_t)lbytes+delta;
+    fd = open(filename,O_RDWR);
+    PetscCheck(fd>=0,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to open file %s",filename);
+    p = mmap(NULL,len,PROT_READ|PROT_WRITE,MAP_SHARED,fd,(off_t)(loff-delta));
+    PetscCheck(p!=MAP_FAILED,PETSC_COMM_SELF,PETSC_ERR_MEM,"Unable to map %" PetscInt64_FMT " bytes of file %s",(PetscInt64)len,filename);
+    PetscCheck(!close(fd),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to close file %s",filename);
+    array = (PetscScalar*)((char*)p+delta);
+  }
+
+  /* replace the current storage */
+  PetscCall(VecDestroyVecs(bv->m,&ctx->V));
+  PetscCall(BVMmapFree(&ctx->array,ctx->len,ctx->delta));
+  ctx->array = array;
+  ctx->len   = len;
+  ctx->delta = delta;
+  PetscCall(BVMmapCreateVecs(bv,bv->m,ctx->array,&ctx->V));
+  PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  SETERRQ(PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"BVMMAP requires mmap() support");
+#endif
+}
+
+/*@
+   BVMmapSetFile - Maps the storage of a BV of type BVMMAP to a region of a file,
+   so that the columns of the BV are the data contained in the file.
+
+   Collective
+
+   Input Parameters:
++  bv       - the basis vectors context
+.  filename - name of the file
+-  offset   - position in bytes of the region within the file
+
+   Notes:
+   The region contains the local arrays of all processes, one after the other (in
+   rank order), each of them stored by columns with the leading dimension of the BV,
+   see BVGetLeadingDimension(). The file is created or extended if it is not large
+   enough. The previous content of the BV is discarded.
+
+   No data is read when calling this function, the pages of the file are loaded on
+   demand when the columns are accessed, and any modification of the BV is written
+   to the file. This can be used to access the vectors stored in a file without
+   reading them first, see SlepcLoadSolution().
+
+   The offset must be a multiple of sizeof(PetscScalar). The file must be accessible
+   by all processes. If the BV is resized afterwards with BVResize(), the new storage
+   is no longer associated with the file.
+
+   Level: advanced
+
+.seealso: BVSetType(), SlepcLoadSolution()
+@*/
+PetscErrorCode BVMmapSetFile(BV bv,const char filename[],PetscInt64 offset)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidType(bv,1);
+  BVCheckSizes(bv,1);
+  PetscAssertPointer(filename,2);
+  PetscUseMethod(bv,"BVMmapSetFile_C",(BV,const char[],PetscInt64),(bv,filename,offset));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode BVCreate_Mmap(BV bv)
+{
+  BV_MMAP        *ctx;
+  PetscInt       j,nloc,lsplit,lda;
+  PetscBool      seq,isdense;
+  PetscScalar    *aa,*array;
+  BV             parent;
+  Vec            *Vpar;
+  MatType        mtype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  bv->data = (void*)ctx;
+
+  PetscCall(PetscStrcmp(bv->vtype,VECMPI,&ctx->mpi));
+  if (!ctx->mpi) {
+    PetscCall(PetscStrcmp(bv->vtype,VECSEQ,&seq));
+    PetscCheck(seq,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Cannot create a mmap BV from a non-standard vector type: %s",bv->vtype);
+  }
+
+  PetscCall(PetscLayoutGetLocalSize(bv->map,&nloc));
+  PetscCall(BV_SetDefaultLD(bv,nloc));
+
+  if (PetscUnlikely(bv->issplit)) {
+    PetscCheck(bv->issplit>0,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"BVMMAP does not support BVGetSplitRows()");
+    /* split BV: share memory and Vecs of the parent BV */
+    parent = bv->splitparent;
+    lsplit = parent->lsplit;
+    Vpar   = ((BV_MMAP*)parent->data)->V;
+    ctx->V = (bv->issplit==1)? Vpar: Vpar+lsplit;
+    array  = ((BV_MMAP*)parent->data)->array;
+    ctx->array = (bv->issplit==1)? array: array+lsplit*bv->ld;
+  } else {
+    /* regular BV: map memory and create Vecs for the BV entries */
+    PetscCall(BVMmapAllocate(bv,bv->m*bv->ld,&ctx->array,&ctx->len));
+    PetscCall(BVMmapCreateVecs(bv,bv->m,ctx->array,&ctx->V));
+  }
+
+  if (PetscUnlikely(bv->Acreate)) {
+    PetscCall(MatGetType(bv->Acreate,&mtype));
+    PetscCall(PetscStrcmpAny(mtype,&isdense,MATSEQDENSE,MATMPIDENSE,""));
+    PetscCheck(isdense,PetscObjectComm((PetscObject)bv->Acreate),PETSC_ERR_SUP,"BVMMAP requires a dense matrix in BVCreateFromMat()");
+    PetscCall(MatDenseGetArray(bv->Acreate,&aa));
+    PetscCall(MatDenseGetLDA(bv->Acreate,&lda));
+    for (j=0;j<bv->m;j++) PetscCall(PetscArraycpy(ctx->array+j*bv->ld,aa+j*lda,bv->n));
+    PetscCall(MatDenseRestoreArray(bv->Acreate,&aa));
+    PetscCall(MatDestroy(&bv->Acreate));
+  }
+
+  bv->ops->mult             = BVMult_Mmap;
+  bv->ops->multvec          = BVMultVec_Mmap;
+  bv->ops->multinplace      = BVMultInPlace_Mmap;
+  bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Mmap;
+  bv->ops->dot              = BVDot_Mmap;
+  bv->ops->dotvec           = BVDotVec_Mmap;
+  bv->ops->dotvec_local     = BVDotVec_Local_Mmap;
+  bv->ops->scale            = BVScale_Mmap;
+  bv->ops->norm             = BVNorm_Mmap;
+  bv->ops->norm_local       = BVNorm_Local_Mmap;
+  bv->ops->normalize        = BVNormalize_Mmap;
+  bv->ops->matmult          = BVMatMult_Mmap;
+  bv->ops->copy             = BVCopy_Mmap;
+  bv->ops->copycolumn       = BVCopyColumn_Mmap;
+  bv->ops->resize           = BVResize_Mmap;
+  bv->ops->getcolumn        = BVGetColumn_Mmap;
+  bv->ops->restorecolumn    = BVRestoreColumn_Mmap;
+  bv->ops->getarray         = BVGetArray_Mmap;
+  bv->ops->getarrayread     = BVGetArrayRead_Mmap;
+  bv->ops->getmat           = BVGetMat_Default;
+  bv->ops->restoremat       = BVRestoreMat_Default;
+  bv->ops->destroy          = BVDestroy_Mmap;
+  bv->ops->view             = BVView_Mmap;
+  PetscCall(PetscObjectComposeFunction((PetscObject)bv,"BVMmapSetFile_C",BVMmapSetFile_Mmap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
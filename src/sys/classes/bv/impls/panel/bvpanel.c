@@ -0,0 +1,620 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   BV implemented as a single array split in panels of rows, each panel
+   storing the entries of all columns contiguously
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepcblaslapack.h>
+
+/* default number of rows of a panel, so that it holds about BV_PANEL_SIZE entries */
+#define BV_PANEL_SIZE    32768
+#define BV_PANEL_MINROWS 64
+
+typedef struct {
+  PetscScalar *array;   /* the entries of the BV, stored in panels of rows */
+  PetscInt    pr;       /* number of rows of each panel (the last one may be smaller) */
+  PetscInt    stride;   /* number of columns stored in each panel */
+  PetscInt    coff;     /* offset of the first column (nonzero for split BV's) */
+  PetscScalar *w;       /* workspace */
+  PetscInt    lw;       /* size of w */
+  PetscScalar *a;       /* full array in column-major order, returned by BVGetArray() */
+  PetscBool   mpi;
+} BV_PANEL;
+
+/*
+   Pointer to column c (including constraints) of the panel that starts
+   at row i and has nr rows; its leading dimension is nr
+*/
+static inline PetscScalar *BVPanelPtr(BV_PANEL *ctx,PetscInt i,PetscInt nr,PetscInt c)
+{
+  return ctx->array+i*ctx->stride+(ctx->coff+c)*nr;
+}
+
+static PetscErrorCode BVPanelAllocateWork(BV bv,PetscInt s)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  if (s>ctx->lw) {
+    PetscCall(PetscFree(ctx->w));
+    PetscCall(PetscMalloc1(s,&ctx->w));
+    ctx->lw = s;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   B := columns c0:c0+nc-1 of the BV, with B in column-major order (ld=ldb)
+*/
+static PetscErrorCode BVPanelUnpack(BV bv,PetscInt c0,PetscInt nc,PetscScalar *B,PetscInt ldb)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscInt       i,j,nr;
+
+  PetscFunctionBegin;
+  for (i=0;i<bv->n;i+=ctx->pr) {
+    nr = PetscMin(ctx->pr,bv->n-i);
+    for (j=0;j<nc;j++) PetscCall(PetscArraycpy(B+i+j*ldb,BVPanelPtr(ctx,i,nr,c0+j),nr));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Columns c0:c0+nc-1 of the BV := B, with B in column-major order (ld=ldb)
+*/
+static PetscErrorCode BVPanelPack(BV bv,const PetscScalar *B,PetscInt ldb,PetscInt c0,PetscInt nc)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscInt       i,j,nr;
+
+  PetscFunctionBegin;
+  for (i=0;i<bv->n;i+=ctx->pr) {
+    nr = PetscMin(ctx->pr,bv->n-i);
+    for (j=0;j<nc;j++) PetscCall(PetscArraycpy(BVPanelPtr(ctx,i,nr,c0+j),B+i+j*ldb,nr));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline PetscErrorCode BVPanelCheckCompatible(BV X,BV Y)
+{
+  PetscFunctionBegin;
+  PetscCheck(((BV_PANEL*)X->data)->pr==((BV_PANEL*)Y->data)->pr,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_INCOMP,"BV objects have different panel sizes %" PetscInt_FMT " and %" PetscInt_FMT,((BV_PANEL*)X->data)->pr,((BV_PANEL*)Y->data)->pr);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMult_Panel(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  BV_PANEL          *y = (BV_PANEL*)Y->data,*x = (BV_PANEL*)X->data;
+  const PetscScalar *q=NULL;
+  PetscInt          ldq=0,i,nr,kx=X->k-X->l,ky=Y->k-Y->l;
+
+  PetscFunctionBegin;
+  PetscCall(BVPanelCheckCompatible(X,Y));
+  if (Q) {
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(MatDenseGetArrayRead(Q,&q));
+  }
+  for (i=0;i<Y->n;i+=y->pr) {
+    nr = PetscMin(y->pr,Y->n-i);
+    if (Q) PetscCall(BVMult_BLAS_Private(Y,nr,ky,kx,alpha,BVPanelPtr(x,i,nr,X->nc+X->l),nr,q+Y->l*ldq+X->l,ldq,beta,BVPanelPtr(y,i,nr,Y->nc+Y->l),nr));
+    else PetscCall(BVAXPY_BLAS_Private(Y,nr,ky,alpha,BVPanelPtr(x,i,nr,X->nc+X->l),nr,beta,BVPanelPtr(y,i,nr,Y->nc+Y->l),nr));
+  }
+  if (Q) PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultVec_Panel(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  BV_PANEL       *x = (BV_PANEL*)X->data;
+  PetscScalar    *py,*qq=q;
+  PetscInt       i,nr,k=X->k-X->l;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArray(y,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  for (i=0;i<X->n;i+=x->pr) {
+    nr = PetscMin(x->pr,X->n-i);
+    PetscCall(BVMultVec_BLAS_Private(X,nr,k,alpha,BVPanelPtr(x,i,nr,X->nc+X->l),nr,qq,beta,py+i));
+  }
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArray(y,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlace_Panel_Private(BV V,Mat Q,PetscInt s,PetscInt e,PetscBool btrans)
+{
+  BV_PANEL          *ctx = (BV_PANEL*)V->data;
+  const PetscScalar *q;
+  PetscInt          ldq,i,nr,k=V->k-V->l;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseGetArrayRead(Q,&q));
+  for (i=0;i<V->n;i+=ctx->pr) {
+    nr = PetscMin(ctx->pr,V->n-i);
+    PetscCall(BVMultInPlace_BLAS_Private(V,nr,k,s-V->l,e-V->l,BVPanelPtr(ctx,i,nr,V->nc+V->l),nr,q+V->l*ldq+V->l,ldq,btrans));
+  }
+  PetscCall(MatDenseRestoreArrayRead(Q,&q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlace_Panel(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscFunctionBegin;
+  PetscCall(BVMultInPlace_Panel_Private(V,Q,s,e,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMultInPlaceHermitianTranspose_Panel(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscFunctionBegin;
+  PetscCall(BVMultInPlace_Panel_Private(V,Q,s,e,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDot_Panel(BV X,BV Y,Mat M)
+{
+  BV_PANEL       *x = (BV_PANEL*)X->data,*y = (BV_PANEL*)Y->data;
+  PetscScalar    *m,*acc,*res,zero=0.0,one=1.0;
+  PetscReal      rzero=0.0,rone=1.0;
+  PetscInt       ldm,i,j,p,nr,kx=X->k-X->l,ky=Y->k-Y->l,len;
+  PetscBLASInt   m_,n_,k_;
+  PetscMPIInt    len_;
+  PetscBool      herm;
+
+  PetscFunctionBegin;
+  PetscCall(BVPanelCheckCompatible(X,Y));
+  /* X'*X is Hermitian, so only the upper triangle is computed and reduced */
+  herm = (x->array==y->array && x->coff+X->nc+X->l==y->coff+Y->nc+Y->l && kx==ky)? PETSC_TRUE: PETSC_FALSE;
+  len  = herm? kx*(kx+1)/2: kx*ky;
+  PetscCall(BVPanelAllocateWork(X,kx*ky+2*len));
+  acc = x->w;
+  res = acc+kx*ky;
+  PetscCall(PetscBLASIntCast(ky,&m_));
+  PetscCall(PetscBLASIntCast(kx,&n_));
+  PetscCall(PetscArrayzero(acc,kx*ky));
+  /* accumulate the local contributions of all panels */
+  for (i=0;i<X->n;i+=x->pr) {
+    nr = PetscMin(x->pr,X->n-i);
+    PetscCall(PetscBLASIntCast(nr,&k_));
+    if (!m_ || !n_) continue;
+    if (herm) PetscCallBLAS("BLASherk",BLASherk_("U","C",&n_,&k_,&rone,BVPanelPtr(x,i,nr,X->nc+X->l),&k_,i?&rone:&rzero,acc,&n_));
+    else PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&m_,&n_,&k_,&one,BVPanelPtr(y,i,nr,Y->nc+Y->l),&k_,BVPanelPtr(x,i,nr,X->nc+X->l),&k_,i?&one:&zero,acc,&m_));
+  }
+  if (herm) {
+    PetscCall(PetscLogFlops(1.0*kx*(kx+1)*X->n));
+    for (p=0,j=0;j<kx;j++) for (i=0;i<=j;i++) res[p++] = acc[i+j*kx];
+    if (x->mpi) {
+      PetscCall(PetscMPIIntCast(len,&len_));
+      PetscCall(BVAllreduceSum_Private(X,res,res+len,len_));
+      res += len;
+    }
+    for (p=0,j=0;j<kx;j++) for (i=0;i<=j;i++) acc[i+j*kx] = res[p++];
+    for (j=0;j<kx;j++) for (i=j+1;i<kx;i++) acc[i+j*kx] = PetscConj(acc[j+i*kx]);
+    res = acc;
+  } else {
+    PetscCall(PetscLogFlops(2.0*kx*ky*X->n));
+    if (x->mpi) {
+      PetscCall(PetscMPIIntCast(len,&len_));
+      PetscCall(BVAllreduceSum_Private(X,acc,res,len_));
+    } else res = acc;
+  }
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatDenseGetArray(M,&m));
+  for (j=0;j<kx;j++) PetscCall(PetscArraycpy(m+(X->l+j)*ldm+Y->l,res+j*ky,ky));
+  PetscCall(MatDenseRestoreArray(M,&m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   q := X'*y, with the local contributions of all panels added before the reduction
+*/
+static PetscErrorCode BVDotVec_Panel_Private(BV X,const PetscScalar *py,PetscScalar *q,PetscBool mpi)
+{
+  BV_PANEL       *x = (BV_PANEL*)X->data;
+  PetscScalar    *acc,zero=0.0,done=1.0;
+  PetscInt       i,nr,k=X->k-X->l;
+  PetscBLASInt   n_,k_,one=1;
+  PetscMPIInt    len;
+
+  PetscFunctionBegin;
+  PetscCall(BVPanelAllocateWork(X,k));
+  acc = x->w;
+  PetscCall(PetscBLASIntCast(k,&k_));
+  PetscCall(PetscArrayzero(acc,k));
+  for (i=0;i<X->n;i+=x->pr) {
+    nr = PetscMin(x->pr,X->n-i);
+    PetscCall(PetscBLASIntCast(nr,&n_));
+    if (k_) PetscCallBLAS("BLASgemv",BLASgemv_("C",&n_,&k_,&done,BVPanelPtr(x,i,nr,X->nc+X->l),&n_,(PetscScalar*)py+i,&one,i?&done:&zero,acc,&one));
+  }
+  PetscCall(PetscLogFlops(2.0*X->n*k));
+  if (mpi) {
+    PetscCall(PetscMPIIntCast(k,&len));
+    PetscCall(BVAllreduceSum_Private(X,acc,q,len));
+  } else PetscCall(PetscArraycpy(q,acc,k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Panel(BV X,Vec y,PetscScalar *q)
+{
+  BV_PANEL          *x = (BV_PANEL*)X->data;
+  const PetscScalar *py;
+  PetscScalar       *qq=q;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  if (!q) PetscCall(VecGetArray(X->buffer,&qq));
+  PetscCall(BVDotVec_Panel_Private(X,py,qq,x->mpi));
+  if (!q) PetscCall(VecRestoreArray(X->buffer,&qq));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDotVec_Local_Panel(BV X,Vec y,PetscScalar *m)
+{
+  const PetscScalar *py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecGetArrayRead(z,&py));
+  PetscCall(BVDotVec_Panel_Private(X,py,m,PETSC_FALSE));
+  PetscCall(VecRestoreArrayRead(z,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVScale_Panel(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscInt       i,nr,c0,nc;
+
+  PetscFunctionBegin;
+  if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (PetscUnlikely(j<0)) { c0 = bv->nc+bv->l; nc = bv->k-bv->l; }
+  else { c0 = bv->nc+j; nc = 1; }
+  /* the columns are contiguous within each panel */
+  for (i=0;i<bv->n;i+=ctx->pr) {
+    nr = PetscMin(ctx->pr,bv->n-i);
+    PetscCall(BVScale_BLAS_Private(bv,nr*nc,BVPanelPtr(ctx,i,nr,c0),alpha));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Norm of column j (all active columns if j<0), computed on a column-major copy
+*/
+static PetscErrorCode BVNorm_Panel_Private(BV bv,PetscInt j,NormType type,PetscReal *val,PetscBool mpi)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscInt       c0,k;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(j<0)) { c0 = bv->nc+bv->l; k = bv->k-bv->l; }
+  else { c0 = bv->nc+j; k = 1; }
+  PetscCall(BVPanelAllocateWork(bv,PetscMax(1,bv->n*k)));
+  PetscCall(BVPanelUnpack(bv,c0,k,ctx->w,bv->n));
+  PetscCall(BVNorm_LAPACK_Private(bv,bv->n,k,ctx->w,PetscMax(1,bv->n),type,val,mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Panel(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(BVNorm_Panel_Private(bv,j,type,val,ctx->mpi));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNorm_Local_Panel(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  PetscFunctionBegin;
+  PetscCall(BVNorm_Panel_Private(bv,j,type,val,PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVNormalize_Panel(BV bv,PetscScalar *eigi)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscScalar    *wi=NULL;
+  PetscInt       k=bv->k-bv->l,ld=PetscMax(1,bv->n);
+
+  PetscFunctionBegin;
+  if (eigi) wi = eigi+bv->l;
+  PetscCall(BVPanelAllocateWork(bv,ld*k));
+  PetscCall(BVPanelUnpack(bv,bv->nc+bv->l,k,ctx->w,ld));
+  PetscCall(BVNormalize_LAPACK_Private(bv,bv->n,k,ctx->w,ld,wi,ctx->mpi));
+  PetscCall(BVPanelPack(bv,ctx->w,ld,bv->nc+bv->l,k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVMatMult_Panel(BV V,Mat A,BV W)
+{
+  PetscInt       j;
+  Vec            vv,ww;
+
+  PetscFunctionBegin;
+  /* the product with a dense matrix works on column-major copies obtained with BVGetMat() */
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
+    for (j=0;j<V->k-V->l;j++) {
+      PetscCall(BVGetColumn(V,V->l+j,&vv));
+      PetscCall(BVGetColumn(W,W->l+j,&ww));
+      PetscCall(MatMult(A,vv,ww));
+      PetscCall(BVRestoreColumn(V,V->l+j,&vv));
+      PetscCall(BVRestoreColumn(W,W->l+j,&ww));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopy_Panel(BV V,BV W)
+{
+  BV_PANEL       *v = (BV_PANEL*)V->data,*w = (BV_PANEL*)W->data;
+  PetscInt       i,nr;
+
+  PetscFunctionBegin;
+  PetscCall(BVPanelCheckCompatible(V,W));
+  for (i=0;i<V->n;i+=v->pr) {
+    nr = PetscMin(v->pr,V->n-i);
+    PetscCall(PetscArraycpy(BVPanelPtr(w,i,nr,W->nc+W->l),BVPanelPtr(v,i,nr,V->nc+V->l),nr*(V->k-V->l)));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVCopyColumn_Panel(BV V,PetscInt j,PetscInt i)
+{
+  BV_PANEL       *v = (BV_PANEL*)V->data;
+  PetscInt       r,nr;
+
+  PetscFunctionBegin;
+  for (r=0;r<V->n;r+=v->pr) {
+    nr = PetscMin(v->pr,V->n-r);
+    PetscCall(PetscArraycpy(BVPanelPtr(v,r,nr,V->nc+i),BVPanelPtr(v,r,nr,V->nc+j),nr));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVResize_Panel(BV bv,PetscInt m,PetscBool copy)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+  PetscScalar    *newarray;
+  PetscInt       i,nr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(m*bv->n,&newarray));
+  if (copy) {
+    for (i=0;i<bv->n;i+=ctx->pr) {
+      nr = PetscMin(ctx->pr,bv->n-i);
+      PetscCall(PetscArraycpy(newarray+i*m,ctx->array+i*ctx->stride,nr*PetscMin(m,bv->m)));
+    }
+  }
+  PetscCall(PetscFree(ctx->array));
+  ctx->array  = newarray;
+  ctx->stride = m;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetColumn_Panel(BV bv,PetscInt j,Vec *v)
+{
+  PetscScalar    *pv;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  PetscCall(VecGetArrayWrite(bv->cv[l],&pv));
+  PetscCall(BVPanelUnpack(bv,bv->nc+j,1,pv,bv->n));
+  PetscCall(VecRestoreArrayWrite(bv->cv[l],&pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreColumn_Panel(BV bv,PetscInt j,Vec *v)
+{
+  const PetscScalar *pv;
+  PetscObjectState  st;
+  PetscInt          l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  /* copy back to the BV storage only if the vector has been modified */
+  PetscCall(VecGetState(bv->cv[l],&st));
+  if (st!=bv->st[l]) {
+    PetscCall(VecGetArrayRead(bv->cv[l],&pv));
+    PetscCall(BVPanelPack(bv,pv,bv->n,bv->nc+j,1));
+    PetscCall(VecRestoreArrayRead(bv->cv[l],&pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArray_Panel(BV bv,PetscScalar **a)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!ctx->a,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"BVGetArray already called on this BV");
+  PetscCall(PetscMalloc1((bv->nc+bv->m)*bv->ld,&ctx->a));
+  PetscCall(BVPanelUnpack(bv,0,bv->nc+bv->m,ctx->a,bv->ld));
+  *a = ctx->a;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreArray_Panel(BV bv,PetscScalar **a)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(BVPanelPack(bv,ctx->a,bv->ld,0,bv->nc+bv->m));
+  PetscCall(PetscFree(ctx->a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVGetArrayRead_Panel(BV bv,const PetscScalar **a)
+{
+  PetscFunctionBegin;
+  PetscCall(BVGetArray_Panel(bv,(PetscScalar**)a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVRestoreArrayRead_Panel(BV bv,const PetscScalar **a)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(ctx->a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVResetSplit_Panel(BV bv)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data,*pctx = (BV_PANEL*)bv->splitparent->data;
+
+  PetscFunctionBegin;
+  ctx->array  = pctx->array;
+  ctx->stride = pctx->stride;
+  ctx->coff   = (bv->issplit==1)? pctx->coff: pctx->coff+bv->splitparent->lsplit;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVView_Panel(BV bv,PetscViewer viewer)
+{
+  BV_PANEL          *ctx = (BV_PANEL*)bv->data;
+  PetscInt          j;
+  Vec               v;
+  PetscViewerFormat format;
+  PetscBool         isascii,ismatlab=PETSC_FALSE;
+  const char        *bvname,*name;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii) {
+    PetscCall(PetscViewerGetFormat(viewer,&format));
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscCall(PetscViewerASCIIPrintf(viewer,"  storing vectors in panels of %" PetscInt_FMT " rows\n",ctx->pr));
+    if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) PetscFunctionReturn(PETSC_SUCCESS);
+    if (format == PETSC_VIEWER_ASCII_MATLAB) ismatlab = PETSC_TRUE;
+  }
+  if (ismatlab) {
+    PetscCall(PetscObjectGetName((PetscObject)bv,&bvname));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[];\n",bvname));
+  }
+  for (j=0;j<bv->m;j++) {
+    PetscCall(BVGetColumn(bv,j,&v));
+    PetscCall(VecView(v,viewer));
+    if (ismatlab) {
+      PetscCall(PetscObjectGetName((PetscObject)v,&name));
+      PetscCall(PetscViewerASCIIPrintf(viewer,"%s=[%s,%s];clear %s\n",bvname,bvname,name,name));
+    }
+    PetscCall(BVRestoreColumn(bv,j,&v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVDestroy_Panel(BV bv)
+{
+  BV_PANEL       *ctx = (BV_PANEL*)bv->data;
+
+  PetscFunctionBegin;
+  if (!bv->issplit) PetscCall(PetscFree(ctx->array));
+  PetscCall(PetscFree(ctx->w));
+  PetscCall(PetscFree(ctx->a));
+  PetscCall(VecDestroy(&bv->cv[0]));
+  PetscCall(VecDestroy(&bv->cv[1]));
+  PetscCall(PetscFree(bv->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+SLEPC_EXTERN PetscErrorCode BVCreate_Panel(BV bv)
+{
+  BV_PANEL          *ctx;
+  PetscInt          j,nloc,lda;
+  PetscBool         seq,isdense,flg;
+  const PetscScalar *aa;
+  MatType           mtype;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  bv->data = (void*)ctx;
+
+  PetscCall(PetscStrcmp(bv->vtype,VECMPI,&ctx->mpi));
+  if (!ctx->mpi) {
+    PetscCall(PetscStrcmp(bv->vtype,VECSEQ,&seq));
+    PetscCheck(seq,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Cannot create a panel BV from a non-standard vector type: %s",bv->vtype);
+  }
+
+  PetscCall(PetscLayoutGetLocalSize(bv->map,&nloc));
+  PetscCall(BV_SetDefaultLD(bv,nloc));
+
+  if (PetscUnlikely(bv->issplit)) {
+    /* split BV: share memory of the parent BV, with the same panels */
+    PetscCheck(bv->issplit>0,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"BVGetSplitRows() is not available in BVPANEL");
+    ctx->pr = ((BV_PANEL*)bv->splitparent->data)->pr;
+    PetscCall(BVResetSplit_Panel(bv));
+  } else {
+    /* regular BV: allocate memory for the BV entries */
+    ctx->pr = PetscMax(BV_PANEL_MINROWS,BV_PANEL_SIZE/PetscMax(bv->m,1));
+    PetscCall(PetscOptionsGetInt(((PetscObject)bv)->options,((PetscObject)bv)->prefix,"-bv_panel_rows",&ctx->pr,&flg));
+    PetscCheck(!flg || ctx->pr>0,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Number of rows of the panels must be positive");
+    ctx->pr     = PetscMax(1,PetscMin(ctx->pr,nloc));
+    ctx->stride = bv->m;
+    PetscCall(PetscCalloc1(bv->m*nloc,&ctx->array));
+  }
+
+  if (PetscUnlikely(bv->Acreate)) {
+    PetscCall(MatGetType(bv->Acreate,&mtype));
+    PetscCall(PetscStrcmpAny(mtype,&isdense,MATSEQDENSE,MATMPIDENSE,""));
+    PetscCheck(isdense,PetscObjectComm((PetscObject)bv->Acreate),PETSC_ERR_SUP,"BVPANEL requires a dense matrix in BVCreateFromMat()");
+    PetscCall(MatDenseGetArrayRead(bv->Acreate,&aa));
+    PetscCall(MatDenseGetLDA(bv->Acreate,&lda));
+    for (j=0;j<bv->m;j++) PetscCall(BVPanelPack(bv,aa+j*lda,lda,j,1));
+    PetscCall(MatDenseRestoreArrayRead(bv->Acreate,&aa));
+    PetscCall(MatDestroy(&bv->Acreate));
+  }
+
+  PetscCall(BVCreateVec(bv,&bv->cv[0]));
+  PetscCall(BVCreateVec(bv,&bv->cv[1]));
+
+  bv->ops->mult             = BVMult_Panel;
+  bv->ops->multvec          = BVMultVec_Panel;
+  bv->ops->multinplace      = BVMultInPlace_Panel;
+  bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Panel;
+  bv->ops->dot              = BVDot_Panel;
+  bv->ops->dotvec           = BVDotVec_Panel;
+  bv->ops->dotvec_local     = BVDotVec_Local_Panel;
+  bv->ops->scale            = BVScale_Panel;
+  bv->ops->norm             = BVNorm_Panel;
+  bv->ops->norm_local       = BVNorm_Local_Panel;
+  bv->ops->normalize        = BVNormalize_Panel;
+  bv->ops->matmult          = BVMatMult_Panel;
+  bv->ops->copy             = BVCopy_Panel;
+  bv->ops->copycolumn       = BVCopyColumn_Panel;
+  bv->ops->resize           = BVResize_Panel;
+  bv->ops->getcolumn        = BVGetColumn_Panel;
+  bv->ops->restorecolumn    = BVRestoreColumn_Panel;
+  bv->ops->getarray         = BVGetArray_Panel;
+  bv->ops->restorearray     = BVRestoreArray_Panel;
+  bv->ops->getarrayread     = BVGetArrayRead_Panel;
+  bv->ops->restorearrayread = BVRestoreArrayRead_Panel;
+  bv->ops->getmat           = BVGetMat_Default;
+  bv->ops->restoremat       = BVRestoreMat_Default;
+  bv->ops->resetsplit       = BVResetSplit_Panel;
+  bv->ops->destroy          = BVDestroy_Panel;
+  bv->ops->view             = BVView_Panel;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
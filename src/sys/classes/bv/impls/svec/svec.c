@@ -203,22 +203,11 @@ static PetscErrorCode BVNormalize_Svec(BV bv,PetscScalar *eigi)
 static PetscErrorCode BVMatMult_Svec(BV V,Mat A,BV W)
 {
   PetscInt       j;
-  Mat            Vmat,Wmat;
   Vec            vv,ww;
 
   PetscFunctionBegin;
-  if (V->vmm) {
-    PetscCall(BVGetMat(V,&Vmat));
-    PetscCall(BVGetMat(W,&Wmat));
-    PetscCall(MatProductCreateWithMat(A,Vmat,NULL,Wmat));
-    PetscCall(MatProductSetType(Wmat,MATPRODUCT_AB));
-    PetscCall(MatProductSetFromOptions(Wmat));
-    PetscCall(MatProductSymbolic(Wmat));
-    PetscCall(MatProductNumeric(Wmat));
-    PetscCall(MatProductClear(Wmat));
-    PetscCall(BVRestoreMat(V,&Vmat));
-    PetscCall(BVRestoreMat(W,&Wmat));
-  } else {
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
     for (j=0;j<V->k-V->l;j++) {
       PetscCall(BVGetColumn(V,V->l+j,&vv));
       PetscCall(BVGetColumn(W,W->l+j,&ww));
@@ -258,6 +247,22 @@ static PetscErrorCode BVCopyColumn_Svec(BV V,PetscInt j,PetscInt i)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   If threads are used, replace the storage of v (with m columns) by an array
+   whose pages are first touched by the threads that will operate on them
+*/
+static PetscErrorCode BVSvecFirstTouch(BV bv,Vec v,PetscInt m)
+{
+  PetscScalar    *array;
+
+  PetscFunctionBegin;
+  if (bv->nthreads<=1 || bv->cuda || bv->hip) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(m*bv->ld,&array));
+  PetscCall(BVFirstTouch_Private(bv,bv->n,m,array,bv->ld));
+  PetscCall(VecReplaceArray(v,array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode BVResize_Svec(BV bv,PetscInt m,PetscBool copy)
 {
   BV_SVEC           *ctx = (BV_SVEC*)bv->data;
@@ -273,6 +278,7 @@ static PetscErrorCode BVResize_Svec(BV bv,PetscInt m,PetscBool copy)
   PetscCall(VecSetType(vnew,bv->vtype));
   PetscCall(VecSetSizes(vnew,m*bv->ld,PETSC_DECIDE));
   PetscCall(VecSetBlockSize(vnew,bs));
+  PetscCall(BVSvecFirstTouch(bv,vnew,m));
   if (((PetscObject)bv)->name) {
     PetscCall(PetscSNPrintf(str,sizeof(str),"%s_0",((PetscObject)bv)->name));
     PetscCall(PetscObjectSetName((PetscObject)vnew,str));
@@ -381,6 +387,55 @@ static PetscErrorCode BVView_Svec(BV bv,PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Place in the Vec of a split BV the memory of the parent BV at the current
+   split point, removing first the previously placed array if reset is true
+*/
+static PetscErrorCode BVSvecPlaceSplit(BV bv,PetscBool reset)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  BV                parent = bv->splitparent;
+  PetscInt          lsplit = parent->lsplit;
+  Vec               vpar = ((BV_SVEC*)parent->data)->v;
+  const PetscScalar *array,*ptr;
+
+  PetscFunctionBegin;
+  if (bv->cuda) {
+#if defined(PETSC_HAVE_CUDA)
+    PetscCall(VecCUDAGetArrayRead(vpar,&array));
+    if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
+    else ptr = (bv->issplit==1)? array: array-lsplit;
+    PetscCall(VecCUDARestoreArrayRead(vpar,&array));
+    if (reset) PetscCall(VecCUDAResetArray(ctx->v));
+    PetscCall(VecCUDAPlaceArray(ctx->v,ptr));
+#endif
+  } else if (bv->hip) {
+#if defined(PETSC_HAVE_HIP)
+    PetscCall(VecHIPGetArrayRead(vpar,&array));
+    if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
+    else ptr = (bv->issplit==1)? array: array-lsplit;
+    PetscCall(VecHIPRestoreArrayRead(vpar,&array));
+    if (reset) PetscCall(VecHIPResetArray(ctx->v));
+    PetscCall(VecHIPPlaceArray(ctx->v,ptr));
+#endif
+  } else {
+    PetscCall(VecGetArrayRead(vpar,&array));
+    if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
+    else ptr = (bv->issplit==1)? array: array-lsplit;
+    PetscCall(VecRestoreArrayRead(vpar,&array));
+    if (reset) PetscCall(VecResetArray(ctx->v));
+    PetscCall(VecPlaceArray(ctx->v,ptr));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BVResetSplit_Svec(BV bv)
+{
+  PetscFunctionBegin;
+  PetscCall(BVSvecPlaceSplit(bv,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode BVDestroy_Svec(BV bv)
 {
   BV_SVEC        *ctx = (BV_SVEC*)bv->data;
@@ -397,13 +452,11 @@ static PetscErrorCode BVDestroy_Svec(BV bv)
 SLEPC_EXTERN PetscErrorCode BVCreate_Svec(BV bv)
 {
   BV_SVEC           *ctx;
-  PetscInt          nloc,N,bs,tglobal=0,tlocal,lsplit,j,lda;
+  PetscInt          nloc,N,bs,tglobal=0,tlocal,j,lda;
   PetscBool         seq,isdense;
   PetscScalar       *vv;
-  const PetscScalar *aa,*array,*ptr;
+  const PetscScalar *aa;
   char              str[50];
-  BV                parent;
-  Vec               vpar;
   MatType           mtype;
 
   PetscFunctionBegin;
@@ -426,44 +479,28 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Svec(BV bv)
 
   if (PetscUnlikely(bv->issplit)) {
     /* split BV: create Vec sharing the memory of the parent BV */
-    parent = bv->splitparent;
-    lsplit = parent->lsplit;
-    vpar = ((BV_SVEC*)parent->data)->v;
     if (bv->cuda) {
 #if defined(PETSC_HAVE_CUDA)
-      PetscCall(VecCUDAGetArrayRead(vpar,&array));
-      if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
-      else ptr = (bv->issplit==1)? array: array-lsplit;
-      PetscCall(VecCUDARestoreArrayRead(vpar,&array));
       if (ctx->mpi) PetscCall(VecCreateMPICUDAWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,PETSC_DECIDE,NULL,&ctx->v));
       else PetscCall(VecCreateSeqCUDAWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,NULL,&ctx->v));
-      PetscCall(VecCUDAPlaceArray(ctx->v,ptr));
 #endif
     } else if (bv->hip) {
 #if defined(PETSC_HAVE_HIP)
-      PetscCall(VecHIPGetArrayRead(vpar,&array));
-      if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
-      else ptr = (bv->issplit==1)? array: array-lsplit;
-      PetscCall(VecHIPRestoreArrayRead(vpar,&array));
       if (ctx->mpi) PetscCall(VecCreateMPIHIPWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,PETSC_DECIDE,NULL,&ctx->v));
       else PetscCall(VecCreateSeqHIPWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,NULL,&ctx->v));
-      PetscCall(VecHIPPlaceArray(ctx->v,ptr));
 #endif
     } else {
-      PetscCall(VecGetArrayRead(vpar,&array));
-      if (bv->issplit>0) ptr = (bv->issplit==1)? array: array+lsplit*bv->ld;
-      else ptr = (bv->issplit==1)? array: array-lsplit;
-      PetscCall(VecRestoreArrayRead(vpar,&array));
       if (ctx->mpi) PetscCall(VecCreateMPIWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,PETSC_DECIDE,NULL,&ctx->v));
       else PetscCall(VecCreateSeqWithArray(PetscObjectComm((PetscObject)bv),bs,tlocal,NULL,&ctx->v));
-      PetscCall(VecPlaceArray(ctx->v,ptr));
     }
+    PetscCall(BVSvecPlaceSplit(bv,PETSC_FALSE));
   } else {
     /* regular BV: create Vec to store the BV entries */
     PetscCall(VecCreate(PetscObjectComm((PetscObject)bv),&ctx->v));
     PetscCall(VecSetType(ctx->v,bv->vtype));
     PetscCall(VecSetSizes(ctx->v,tlocal,PETSC_DECIDE));
     PetscCall(VecSetBlockSize(ctx->v,bs));
+    PetscCall(BVSvecFirstTouch(bv,ctx->v,bv->m));
   }
   if (((PetscObject)bv)->name) {
     PetscCall(PetscSNPrintf(str,sizeof(str),"%s_0",((PetscObject)bv)->name));
@@ -559,6 +596,7 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Svec(BV bv)
   bv->ops->restorearray     = BVRestoreArray_Svec;
   bv->ops->getarrayread     = BVGetArrayRead_Svec;
   bv->ops->restorearrayread = BVRestoreArrayRead_Svec;
+  bv->ops->resetsplit       = BVResetSplit_Svec;
   bv->ops->destroy          = BVDestroy_Svec;
   if (!ctx->mpi) bv->ops->view = BVView_Svec;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -0,0 +1,500 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   BV implemented as a single Vec, code shared by the CUDA and HIP versions
+
+   This file is included by the source of each version after defining either
+   SLEPC_CUPM_CUDA or SLEPC_CUPM_HIP, see slepccupmblas.h
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepccupmblas.h>
+#include "../src/sys/classes/bv/impls/svec/svec.h"
+
+PetscErrorCode SlepcCUPMName(BVMult_Svec)(BV Y,PetscScalar alpha,PetscScalar beta,BV X,Mat Q)
+{
+  BV_SVEC           *y = (BV_SVEC*)Y->data,*x = (BV_SVEC*)X->data;
+  const PetscScalar *d_px,*d_A,*d_B,*d_q;
+  PetscScalar       *d_py,*d_C;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (!Y->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecCUPMGetArrayRead(x->v,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMGetArrayWrite(y->v,&d_py));
+  else PetscCall(VecCUPMGetArray(y->v,&d_py));
+  d_A = d_px+(X->nc+X->l)*X->ld;
+  d_C = d_py+(Y->nc+Y->l)*Y->ld;
+  if (Q) {
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(BV_MatDenseCUPMGetArrayRead(Y,Q,&d_q));
+    d_B = d_q+Y->l*ldq+X->l;
+    PetscCall(SlepcCUPMName(BVMult_BLAS)(Y,Y->n,Y->k-Y->l,X->k-X->l,alpha,d_A,X->ld,d_B,ldq,beta,d_C,Y->ld));
+    PetscCall(BV_MatDenseCUPMRestoreArrayRead(Y,Q,&d_q));
+  } else PetscCall(SlepcCUPMName(BVAXPY_BLAS)(Y,Y->n,Y->k-Y->l,alpha,d_A,X->ld,beta,d_C,Y->ld));
+  PetscCall(VecCUPMRestoreArrayRead(x->v,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMRestoreArrayWrite(y->v,&d_py));
+  else PetscCall(VecCUPMRestoreArray(y->v,&d_py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultVec_Svec)(BV X,PetscScalar alpha,PetscScalar beta,Vec y,PetscScalar *q)
+{
+  BV_SVEC           *x = (BV_SVEC*)X->data;
+  PetscScalar       *d_py,*d_q;
+  const PetscScalar *d_px;
+  PetscDeviceContext dctx;
+
+  PetscFunctionBegin;
+  PetscCall(VecCUPMGetArrayRead(x->v,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMGetArrayWrite(y,&d_py));
+  else PetscCall(VecCUPMGetArray(y,&d_py));
+  if (!q) PetscCall(VecCUPMGetArray(X->buffer,&d_q));
+  else {
+    PetscInt k=X->k-X->l;
+    PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+    PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_CUPM,k,&d_q));
+    PetscCall(PetscDeviceArrayCopy(dctx,d_q,q,k));
+    PetscCall(PetscLogCpuToGpu(k*sizeof(PetscScalar)));
+  }
+  PetscCall(SlepcCUPMName(BVMultVec_BLAS)(X,X->n,X->k-X->l,alpha,d_px+(X->nc+X->l)*X->ld,X->ld,d_q,beta,d_py));
+  PetscCall(VecCUPMRestoreArrayRead(x->v,&d_px));
+  if (beta==(PetscScalar)0.0) PetscCall(VecCUPMRestoreArrayWrite(y,&d_py));
+  else PetscCall(VecCUPMRestoreArray(y,&d_py));
+  if (!q) PetscCall(VecCUPMRestoreArray(X->buffer,&d_q));
+  else PetscCall(PetscDeviceFree(dctx,d_q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultInPlace_Svec)(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)V->data;
+  PetscScalar       *d_pv;
+  const PetscScalar *d_q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(VecCUPMGetArray(ctx->v,&d_pv));
+  PetscCall(BV_MatDenseCUPMGetArrayRead(V,Q,&d_q));
+  PetscCall(SlepcCUPMName(BVMultInPlace_BLAS)(V,V->n,V->k-V->l,s-V->l,e-V->l,d_pv+(V->nc+V->l)*V->ld,V->ld,d_q+V->l*ldq+V->l,ldq,PETSC_FALSE));
+  PetscCall(BV_MatDenseCUPMRestoreArrayRead(V,Q,&d_q));
+  PetscCall(VecCUPMRestoreArray(ctx->v,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMultInPlaceHermitianTranspose_Svec)(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)V->data;
+  PetscScalar       *d_pv;
+  const PetscScalar *d_q;
+  PetscInt          ldq;
+
+  PetscFunctionBegin;
+  if (s>=e || !V->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(VecCUPMGetArray(ctx->v,&d_pv));
+  PetscCall(BV_MatDenseCUPMGetArrayRead(V,Q,&d_q));
+  PetscCall(SlepcCUPMName(BVMultInPlace_BLAS)(V,V->n,V->k-V->l,s-V->l,e-V->l,d_pv+(V->nc+V->l)*V->ld,V->ld,d_q+V->l*ldq+V->l,ldq,PETSC_TRUE));
+  PetscCall(BV_MatDenseCUPMRestoreArrayRead(V,Q,&d_q));
+  PetscCall(VecCUPMRestoreArray(ctx->v,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDot_Svec)(BV X,BV Y,Mat M)
+{
+  BV_SVEC           *x = (BV_SVEC*)X->data,*y = (BV_SVEC*)Y->data;
+  const PetscScalar *d_px,*d_py;
+  PetscScalar       *pm;
+  PetscInt          ldm;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(VecCUPMGetArrayRead(x->v,&d_px));
+  PetscCall(VecCUPMGetArrayRead(y->v,&d_py));
+  PetscCall(MatDenseGetArrayWrite(M,&pm));
+  PetscCall(SlepcCUPMName(BVDot_BLAS)(X,Y->k-Y->l,X->k-X->l,X->n,d_py+(Y->nc+Y->l)*Y->ld,Y->ld,d_px+(X->nc+X->l)*X->ld,X->ld,pm+X->l*ldm+Y->l,ldm,x->mpi));
+  PetscCall(MatDenseRestoreArrayWrite(M,&pm));
+  PetscCall(VecCUPMRestoreArrayRead(x->v,&d_px));
+  PetscCall(VecCUPMRestoreArrayRead(y->v,&d_py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDotVec_Svec)(BV X,Vec y,PetscScalar *q)
+{
+  BV_SVEC           *x = (BV_SVEC*)X->data;
+  const PetscScalar *d_px,*d_py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecCUPMGetArrayRead(x->v,&d_px));
+  PetscCall(VecCUPMGetArrayRead(z,&d_py));
+  PetscCall(SlepcCUPMName(BVDotVec_BLAS)(X,X->n,X->k-X->l,d_px+(X->nc+X->l)*X->ld,X->ld,d_py,q,x->mpi));
+  PetscCall(VecCUPMRestoreArrayRead(z,&d_py));
+  PetscCall(VecCUPMRestoreArrayRead(x->v,&d_px));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVDotVec_Local_Svec)(BV X,Vec y,PetscScalar *m)
+{
+  BV_SVEC           *x = (BV_SVEC*)X->data;
+  const PetscScalar *d_px,*d_py;
+  Vec               z = y;
+
+  PetscFunctionBegin;
+  if (PetscUnlikely(X->matrix)) {
+    PetscCall(BV_IPMatMult(X,y));
+    z = X->Bx;
+  }
+  PetscCall(VecCUPMGetArrayRead(x->v,&d_px));
+  PetscCall(VecCUPMGetArrayRead(z,&d_py));
+  PetscCall(SlepcCUPMName(BVDotVec_BLAS)(X,X->n,X->k-X->l,d_px+(X->nc+X->l)*X->ld,X->ld,d_py,m,PETSC_FALSE));
+  PetscCall(VecCUPMRestoreArrayRead(z,&d_py));
+  PetscCall(VecCUPMRestoreArrayRead(x->v,&d_px));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVScale_Svec)(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *d_array,*d_A;
+  PetscInt       n=0;
+
+  PetscFunctionBegin;
+  if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecCUPMGetArray(ctx->v,&d_array));
+  if (PetscUnlikely(j<0)) {
+    d_A = d_array+(bv->nc+bv->l)*bv->ld;
+    n = (bv->k-bv->l)*bv->ld;
+  } else {
+    d_A = d_array+(bv->nc+j)*bv->ld;
+    n = bv->n;
+  }
+  PetscCall(SlepcCUPMName(BVScale_BLAS)(bv,n,d_A,alpha));
+  PetscCall(VecCUPMRestoreArray(ctx->v,&d_array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNorm_Svec)(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  const PetscScalar *array,*d_array,*d_A;
+  PetscInt          n=0;
+  PetscReal         lnrm;
+
+  PetscFunctionBegin;
+  if ((j<0 && type==NORM_FROBENIUS && bv->ld==bv->n) || (j>=0 && type==NORM_2)) {
+    /* compute on GPU with cuBLAS or hipBLAS, in parallel only the local norms are reduced */
+    *val = 0.0;
+    if (bv->n) {
+      PetscCall(VecCUPMGetArrayRead(ctx->v,&d_array));
+      if (PetscUnlikely(j<0)) {
+        d_A = d_array+(bv->nc+bv->l)*bv->ld;
+        n = (bv->k-bv->l)*bv->ld;
+      } else {
+        d_A = d_array+(bv->nc+j)*bv->ld;
+        n = bv->n;
+      }
+      PetscCall(SlepcCUPMName(BVNorm_BLAS)(bv,n,d_A,val));
+      PetscCall(VecCUPMRestoreArrayRead(ctx->v,&d_array));
+    }
+    if (ctx->mpi) {
+      lnrm = (*val)*(*val);
+      PetscCallMPI(MPIU_Allreduce(&lnrm,val,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+      *val = PetscSqrtReal(*val);
+    }
+  } else {
+    /* compute on CPU */
+    PetscCall(VecGetArrayRead(ctx->v,&array));
+    if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,ctx->mpi));
+    else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,array+(bv->nc+j)*bv->ld,bv->ld,type,val,ctx->mpi));
+    PetscCall(VecRestoreArrayRead(ctx->v,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNorm_Local_Svec)(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  const PetscScalar *array,*d_array,*d_A;
+  PetscInt          n=0;
+
+  PetscFunctionBegin;
+  if ((j<0 && type==NORM_FROBENIUS && bv->ld==bv->n) || (j>=0 && type==NORM_2)) {
+    /* compute on GPU with cuBLAS or hipBLAS */
+    *val = 0.0;
+    if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(VecCUPMGetArrayRead(ctx->v,&d_array));
+    if (PetscUnlikely(j<0)) {
+      d_A = d_array+(bv->nc+bv->l)*bv->ld;
+      n = (bv->k-bv->l)*bv->ld;
+    } else {
+      d_A = d_array+(bv->nc+j)*bv->ld;
+      n = bv->n;
+    }
+    PetscCall(SlepcCUPMName(BVNorm_BLAS)(bv,n,d_A,val));
+    PetscCall(VecCUPMRestoreArrayRead(ctx->v,&d_array));
+  } else {
+    /* compute on CPU */
+    PetscCall(VecGetArrayRead(ctx->v,&array));
+    if (PetscUnlikely(j<0)) PetscCall(BVNorm_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+    else PetscCall(BVNorm_LAPACK_Private(bv,bv->n,1,array+(bv->nc+j)*bv->ld,bv->ld,type,val,PETSC_FALSE));
+    PetscCall(VecRestoreArrayRead(ctx->v,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVNormalize_Svec)(BV bv,PetscScalar *eigi)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *array,*d_array,*wi=NULL;
+
+  PetscFunctionBegin;
+  if (eigi) wi = eigi+bv->l;
+  if (!ctx->mpi) {
+    /* compute on GPU with cuBLAS or hipBLAS - TODO: include the MPI case here */
+    if (!bv->n) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(VecCUPMGetArray(ctx->v,&d_array));
+    PetscCall(SlepcCUPMName(BVNormalize_BLAS)(bv,bv->n,bv->k-bv->l,d_array+(bv->nc+bv->l)*bv->ld,bv->ld,wi));
+    PetscCall(VecCUPMRestoreArray(ctx->v,&d_array));
+  } else {
+    /* compute on CPU */
+    PetscCall(VecGetArray(ctx->v,&array));
+    PetscCall(BVNormalize_LAPACK_Private(bv,bv->n,bv->k-bv->l,array+(bv->nc+bv->l)*bv->ld,bv->ld,wi,ctx->mpi));
+    PetscCall(VecRestoreArray(ctx->v,&array));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVMatMult_Svec)(BV V,Mat A,BV W)
+{
+  BV_SVEC           *v = (BV_SVEC*)V->data,*w = (BV_SVEC*)W->data;
+  const PetscScalar *d_pv;
+  PetscScalar       *d_pw;
+  PetscInt          j;
+
+  PetscFunctionBegin;
+  if (V->vmm) PetscCall(BVMatMult_Product_Private(V,A,W));
+  else {
+    PetscCall(VecCUPMGetArrayRead(v->v,&d_pv));
+    PetscCall(VecCUPMGetArrayWrite(w->v,&d_pw));
+    for (j=0;j<V->k-V->l;j++) {
+      PetscCall(VecCUPMPlaceArray(V->cv[1],(PetscScalar *)d_pv+(V->nc+V->l+j)*V->ld));
+      PetscCall(VecCUPMPlaceArray(W->cv[1],d_pw+(W->nc+W->l+j)*W->ld));
+      PetscCall(MatMult(A,V->cv[1],W->cv[1]));
+      PetscCall(VecCUPMResetArray(V->cv[1]));
+      PetscCall(VecCUPMResetArray(W->cv[1]));
+    }
+    PetscCall(VecCUPMRestoreArrayRead(v->v,&d_pv));
+    PetscCall(VecCUPMRestoreArrayWrite(w->v,&d_pw));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVCopy_Svec)(BV V,BV W)
+{
+  BV_SVEC           *v = (BV_SVEC*)V->data,*w = (BV_SVEC*)W->data;
+  const PetscScalar *d_pv;
+  PetscScalar       *d_pw;
+
+  PetscFunctionBegin;
+  PetscCall(VecCUPMGetArrayRead(v->v,&d_pv));
+  PetscCall(VecCUPMGetArray(w->v,&d_pw));
+  PetscCallCUPM(cupmMemcpy2D(d_pw+(W->nc+W->l)*W->ld,W->ld*sizeof(PetscScalar),d_pv+(V->nc+V->l)*V->ld,V->ld*sizeof(PetscScalar),V->n*sizeof(PetscScalar),V->k-V->l,cupmMemcpyDeviceToDevice));
+  PetscCall(VecCUPMRestoreArrayRead(v->v,&d_pv));
+  PetscCall(VecCUPMRestoreArray(w->v,&d_pw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVCopyColumn_Svec)(BV V,PetscInt j,PetscInt i)
+{
+  BV_SVEC        *v = (BV_SVEC*)V->data;
+  PetscScalar    *d_pv;
+
+  PetscFunctionBegin;
+  PetscCall(VecCUPMGetArray(v->v,&d_pv));
+  PetscCallCUPM(cupmMemcpy(d_pv+(V->nc+i)*V->ld,d_pv+(V->nc+j)*V->ld,V->n*sizeof(PetscScalar),cupmMemcpyDeviceToDevice));
+  PetscCall(VecCUPMRestoreArray(v->v,&d_pv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVResize_Svec)(BV bv,PetscInt m,PetscBool copy)
+{
+  BV_SVEC           *ctx = (BV_SVEC*)bv->data;
+  const PetscScalar *d_pv;
+  PetscScalar       *d_pnew;
+  PetscInt          bs;
+  Vec               vnew;
+  char              str[50];
+
+  PetscFunctionBegin;
+  PetscCall(PetscLayoutGetBlockSize(bv->map,&bs));
+  PetscCall(VecCreate(PetscObjectComm((PetscObject)bv),&vnew));
+  PetscCall(VecSetType(vnew,bv->vtype));
+  PetscCall(VecSetSizes(vnew,m*bv->ld,PETSC_DECIDE));
+  PetscCall(VecSetBlockSize(vnew,bs));
+  if (((PetscObject)bv)->name) {
+    PetscCall(PetscSNPrintf(str,sizeof(str),"%s_0",((PetscObject)bv)->name));
+    PetscCall(PetscObjectSetName((PetscObject)vnew,str));
+  }
+  if (copy) {
+    PetscCall(VecCUPMGetArrayRead(ctx->v,&d_pv));
+    PetscCall(VecCUPMGetArrayWrite(vnew,&d_pnew));
+    PetscCallCUPM(cupmMemcpy(d_pnew,d_pv,PetscMin(m,bv->m)*bv->ld*sizeof(PetscScalar),cupmMemcpyDeviceToDevice));
+    PetscCall(VecCUPMRestoreArrayRead(ctx->v,&d_pv));
+    PetscCall(VecCUPMRestoreArrayWrite(vnew,&d_pnew));
+  }
+  PetscCall(VecDestroy(&ctx->v));
+  ctx->v = vnew;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVGetColumn_Svec)(BV bv,PetscInt j,Vec*)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *d_pv;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = BVAvailableVec;
+  PetscCall(VecCUPMGetArray(ctx->v,&d_pv));
+  PetscCall(VecCUPMPlaceArray(bv->cv[l],d_pv+(bv->nc+j)*bv->ld));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreColumn_Svec)(BV bv,PetscInt j,Vec*)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscInt       l;
+
+  PetscFunctionBegin;
+  l = (j==bv->ci[0])? 0: 1;
+  PetscCall(VecCUPMResetArray(bv->cv[l]));
+  PetscCall(VecCUPMRestoreArray(ctx->v,NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreSplit_Svec)(BV bv,BV *L,BV *R)
+{
+  Vec               v;
+  const PetscScalar *d_pv;
+  PetscObjectState  lstate,rstate;
+  PetscBool         change=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  /* force sync flag to PETSC_OFFLOAD_BOTH */
+  if (L) {
+    PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
+    if (lstate != bv->lstate) {
+      v = ((BV_SVEC*)bv->L->data)->v;
+      PetscCall(VecCUPMGetArrayRead(v,&d_pv));
+      PetscCall(VecCUPMRestoreArrayRead(v,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (R) {
+    PetscCall(PetscObjectStateGet((PetscObject)*R,&rstate));
+    if (rstate != bv->rstate) {
+      v = ((BV_SVEC*)bv->R->data)->v;
+      PetscCall(VecCUPMGetArrayRead(v,&d_pv));
+      PetscCall(VecCUPMRestoreArrayRead(v,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (change) {
+    v = ((BV_SVEC*)bv->data)->v;
+    PetscCall(VecCUPMGetArray(v,(PetscScalar **)&d_pv));
+    PetscCall(VecCUPMRestoreArray(v,(PetscScalar **)&d_pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreSplitRows_Svec)(BV bv,IS,IS,BV *U,BV *L)
+{
+  Vec               v;
+  const PetscScalar *d_pv;
+  PetscObjectState  lstate,rstate;
+  PetscBool         change=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  /* force sync flag to PETSC_OFFLOAD_BOTH */
+  if (U) {
+    PetscCall(PetscObjectStateGet((PetscObject)*U,&rstate));
+    if (rstate != bv->rstate) {
+      v = ((BV_SVEC*)bv->R->data)->v;
+      PetscCall(VecCUPMGetArrayRead(v,&d_pv));
+      PetscCall(VecCUPMRestoreArrayRead(v,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (L) {
+    PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
+    if (lstate != bv->lstate) {
+      v = ((BV_SVEC*)bv->L->data)->v;
+      PetscCall(VecCUPMGetArrayRead(v,&d_pv));
+      PetscCall(VecCUPMRestoreArrayRead(v,&d_pv));
+      change = PETSC_TRUE;
+    }
+  }
+  if (change) {
+    v = ((BV_SVEC*)bv->data)->v;
+    PetscCall(VecCUPMGetArray(v,(PetscScalar **)&d_pv));
+    PetscCall(VecCUPMRestoreArray(v,(PetscScalar **)&d_pv));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVGetMat_Svec)(BV bv,Mat *A)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *vv,*aa;
+  PetscBool      create=PETSC_FALSE;
+  PetscInt       m,cols;
+
+  PetscFunctionBegin;
+  m = bv->k-bv->l;
+  if (!bv->Aget) create=PETSC_TRUE;
+  else {
+    PetscCall(MatDenseCUPMGetArray(bv->Aget,&aa));
+    PetscCheck(!aa,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"BVGetMat already called on this BV");
+    PetscCall(MatGetSize(bv->Aget,NULL,&cols));
+    if (cols!=m) {
+      PetscCall(MatDestroy(&bv->Aget));
+      create=PETSC_TRUE;
+    }
+  }
+  PetscCall(VecCUPMGetArray(ctx->v,&vv));
+  if (create) {
+    PetscCall(MatCreateDenseFromVecType(PetscObjectComm((PetscObject)bv),bv->vtype,bv->n,PETSC_DECIDE,bv->N,m,bv->ld,vv,&bv->Aget)); /* pass a pointer to avoid allocation of storage */
+    PetscCall(MatDenseCUPMReplaceArray(bv->Aget,NULL));  /* replace with a null pointer, the value after BVRestoreMat */
+  }
+  PetscCall(MatDenseCUPMPlaceArray(bv->Aget,vv+(bv->nc+bv->l)*bv->ld));  /* set the actual pointer */
+  *A = bv->Aget;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode SlepcCUPMName(BVRestoreMat_Svec)(BV bv,Mat *A)
+{
+  BV_SVEC        *ctx = (BV_SVEC*)bv->data;
+  PetscScalar    *vv,*aa;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseCUPMGetArray(bv->Aget,&aa));
+  vv = aa-(bv->nc+bv->l)*bv->ld;
+  PetscCall(MatDenseCUPMResetArray(bv->Aget));
+  PetscCall(VecCUPMRestoreArray(ctx->v,&vv));
+  *A = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -13,17 +13,7 @@
 
 #include <slepc/private/bvimpl.h>      /*I "slepcbv.h" I*/
 #include <slepcblaslapack.h>
-
-typedef struct {
-  BV          U;        /* first factor */
-  Mat         S;        /* second factor */
-  PetscScalar *qB;      /* auxiliary matrix used in non-standard inner products */
-  PetscScalar *sw;      /* work space */
-  PetscInt    d;        /* degree of the tensor BV */
-  PetscInt    ld;       /* leading dimension of a single block in S */
-  PetscInt    puk;      /* copy of the k value */
-  Vec         u;        /* auxiliary work vector */
-} BV_TENSOR;
+#include "bvtensor.h"
 
 static PetscErrorCode BVMultInPlace_Tensor(BV V,Mat Q,PetscInt s,PetscInt e)
 {
@@ -159,7 +149,7 @@ static PetscErrorCode BVTensorNormColumn(BV bv,PetscInt j,PetscReal *norm)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode BVOrthogonalizeGS1_Tensor(BV bv,PetscInt k,Vec v,PetscBool *which,PetscScalar *h,PetscScalar *c,PetscReal *onorm,PetscReal *norm)
+PetscErrorCode BVOrthogonalizeGS1_Tensor(BV bv,PetscInt k,Vec v,PetscBool *which,PetscScalar *h,PetscScalar *c,PetscReal *onorm,PetscReal *norm)
 {
   BV_TENSOR         *ctx = (BV_TENSOR*)bv->data;
   PetscScalar       *pS,*cc,*x,dot,sonem=-1.0,sone=1.0,szero=0.0;
@@ -715,19 +705,45 @@ static PetscErrorCode BVDestroy_Tensor(BV bv)
 SLEPC_EXTERN PetscErrorCode BVCreate_Tensor(BV bv)
 {
   BV_TENSOR      *ctx;
+  PetscBool      cuda=PETSC_FALSE,hip=PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PetscNew(&ctx));
   bv->data = (void*)ctx;
   ctx->puk = -1;
 
-  bv->ops->multinplace      = BVMultInPlace_Tensor;
-  bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Tensor;
-  bv->ops->dot              = BVDot_Tensor;
-  bv->ops->scale            = BVScale_Tensor;
-  bv->ops->norm             = BVNorm_Tensor;
-  bv->ops->copycolumn       = BVCopyColumn_Tensor;
-  bv->ops->gramschmidt      = BVOrthogonalizeGS1_Tensor;
+  /* S is allocated in device memory if the U factor uses CUDA or HIP vectors */
+  PetscCall(PetscStrcmpAny(bv->vtype,&cuda,VECSEQCUDA,VECMPICUDA,""));
+  PetscCall(PetscStrcmpAny(bv->vtype,&hip,VECSEQHIP,VECMPIHIP,""));
+  if (cuda) {
+#if defined(PETSC_HAVE_CUDA)
+    bv->ops->multinplace      = BVMultInPlace_Tensor_CUDA;
+    bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Tensor_CUDA;
+    bv->ops->dot              = BVDot_Tensor_CUDA;
+    bv->ops->scale            = BVScale_Tensor_CUDA;
+    bv->ops->norm             = BVNorm_Tensor_CUDA;
+    bv->ops->copycolumn       = BVCopyColumn_Tensor_CUDA;
+    bv->ops->gramschmidt      = BVOrthogonalizeGS1_Tensor_CUDA;
+#endif
+  } else if (hip) {
+#if defined(PETSC_HAVE_HIP)
+    bv->ops->multinplace      = BVMultInPlace_Tensor_HIP;
+    bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Tensor_HIP;
+    bv->ops->dot              = BVDot_Tensor_HIP;
+    bv->ops->scale            = BVScale_Tensor_HIP;
+    bv->ops->norm             = BVNorm_Tensor_HIP;
+    bv->ops->copycolumn       = BVCopyColumn_Tensor_HIP;
+    bv->ops->gramschmidt      = BVOrthogonalizeGS1_Tensor_HIP;
+#endif
+  } else {
+    bv->ops->multinplace      = BVMultInPlace_Tensor;
+    bv->ops->multinplacetrans = BVMultInPlaceHermitianTranspose_Tensor;
+    bv->ops->dot              = BVDot_Tensor;
+    bv->ops->scale            = BVScale_Tensor;
+    bv->ops->norm             = BVNorm_Tensor;
+    bv->ops->copycolumn       = BVCopyColumn_Tensor;
+    bv->ops->gramschmidt      = BVOrthogonalizeGS1_Tensor;
+  }
   bv->ops->destroy          = BVDestroy_Tensor;
   bv->ops->view             = BVView_Tensor;
 
@@ -765,6 +781,10 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Tensor(BV bv)
 
    The communicator of V will be the same as U.
 
+   If U uses CUDA or HIP vectors, then S is a sequential dense matrix stored in
+   device memory, and the operations on the coefficients of V are carried out
+   on the GPU.
+
    On input, the content of U is irrelevant. Alternatively, it may contain
    some nonzero columns that will be used by BVTensorBuildFirstColumn().
 
@@ -774,7 +794,7 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Tensor(BV bv)
 @*/
 PetscErrorCode BVCreateTensor(BV U,PetscInt d,BV *V)
 {
-  PetscBool      match;
+  PetscBool      match,cuda=PETSC_FALSE,hip=PETSC_FALSE;
   PetscInt       n,N,m;
   VecType        vtype;
   BV_TENSOR      *ctx;
@@ -801,7 +821,17 @@ PetscErrorCode BVCreateTensor(BV U,PetscInt d,BV *V)
   ctx->d  = d;
   ctx->ld = m;
   PetscCall(PetscObjectReference((PetscObject)U));
-  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,d*m,m-d+1,NULL,&ctx->S));
+  PetscCall(PetscStrcmpAny(vtype,&cuda,VECSEQCUDA,VECMPICUDA,""));
+  PetscCall(PetscStrcmpAny(vtype,&hip,VECSEQHIP,VECMPIHIP,""));
+  if (cuda) {
+#if defined(PETSC_HAVE_CUDA)
+    PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,d*m,m-d+1,NULL,&ctx->S));
+#endif
+  } else if (hip) {
+#if defined(PETSC_HAVE_HIP)
+    PetscCall(MatCreateSeqDenseHIP(PETSC_COMM_SELF,d*m,m-d+1,NULL,&ctx->S));
+#endif
+  } else PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,d*m,m-d+1,NULL,&ctx->S));
   PetscCall(PetscObjectSetName((PetscObject)ctx->S,"S"));
 
   /* Copy user-provided attributes of U */
@@ -0,0 +1,44 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+#pragma once
+
+typedef struct {
+  BV          U;        /* first factor */
+  Mat         S;        /* second factor */
+  PetscScalar *qB;      /* auxiliary matrix used in non-standard inner products */
+  PetscScalar *sw;      /* work space */
+  PetscInt    d;        /* degree of the tensor BV */
+  PetscInt    ld;       /* leading dimension of a single block in S */
+  PetscInt    puk;      /* copy of the k value */
+  Vec         u;        /* auxiliary work vector */
+} BV_TENSOR;
+
+SLEPC_INTERN PetscErrorCode BVOrthogonalizeGS1_Tensor(BV,PetscInt,Vec,PetscBool*,PetscScalar*,PetscScalar*,PetscReal*,PetscReal*);
+
+#if defined(PETSC_HAVE_CUDA)
+SLEPC_INTERN PetscErrorCode BVMultInPlace_Tensor_CUDA(BV,Mat,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVMultInPlaceHermitianTranspose_Tensor_CUDA(BV,Mat,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVDot_Tensor_CUDA(BV,BV,Mat);
+SLEPC_INTERN PetscErrorCode BVScale_Tensor_CUDA(BV,PetscInt,PetscScalar);
+SLEPC_INTERN PetscErrorCode BVNorm_Tensor_CUDA(BV,PetscInt,NormType,PetscReal*);
+SLEPC_INTERN PetscErrorCode BVCopyColumn_Tensor_CUDA(BV,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVOrthogonalizeGS1_Tensor_CUDA(BV,PetscInt,Vec,PetscBool*,PetscScalar*,PetscScalar*,PetscReal*,PetscReal*);
+#endif
+
+#if defined(PETSC_HAVE_HIP)
+SLEPC_INTERN PetscErrorCode BVMultInPlace_Tensor_HIP(BV,Mat,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVMultInPlaceHermitianTranspose_Tensor_HIP(BV,Mat,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVDot_Tensor_HIP(BV,BV,Mat);
+SLEPC_INTERN PetscErrorCode BVScale_Tensor_HIP(BV,PetscInt,PetscScalar);
+SLEPC_INTERN PetscErrorCode BVNorm_Tensor_HIP(BV,PetscInt,NormType,PetscReal*);
+SLEPC_INTERN PetscErrorCode BVCopyColumn_Tensor_HIP(BV,PetscInt,PetscInt);
+SLEPC_INTERN PetscErrorCode BVOrthogonalizeGS1_Tensor_HIP(BV,PetscInt,Vec,PetscBool*,PetscScalar*,PetscScalar*,PetscReal*,PetscReal*);
+#endif
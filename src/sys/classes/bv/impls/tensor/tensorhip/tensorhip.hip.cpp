@@ -0,0 +1,167 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   Tensor BV that is represented in compact form as V = (I otimes U) S (HIP version)
+*/
+
+#include <slepc/private/bvimpl.h>
+#include <slepccupmblas.h>
+#include "../src/sys/classes/bv/impls/tensor/bvtensor.h"
+
+PetscErrorCode BVMultInPlace_Tensor_HIP(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_TENSOR         *ctx = (BV_TENSOR*)V->data;
+  PetscScalar       *d_pS;
+  const PetscScalar *d_q;
+  PetscInt          ldq,lds = ctx->ld*ctx->d;
+
+  PetscFunctionBegin;
+  if (s>=e) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseHIPGetArray(ctx->S,&d_pS));
+  PetscCall(BV_MatDenseHIPGetArrayRead(V,Q,&d_q));
+  PetscCall(BVMultInPlace_BLAS_HIP(V,lds,V->k-V->l,s-V->l,e-V->l,d_pS+(V->nc+V->l)*lds,lds,d_q+V->l*ldq+V->l,ldq,PETSC_FALSE));
+  PetscCall(BV_MatDenseHIPRestoreArrayRead(V,Q,&d_q));
+  PetscCall(MatDenseHIPRestoreArray(ctx->S,&d_pS));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode BVMultInPlaceHermitianTranspose_Tensor_HIP(BV V,Mat Q,PetscInt s,PetscInt e)
+{
+  BV_TENSOR         *ctx = (BV_TENSOR*)V->data;
+  PetscScalar       *d_pS;
+  const PetscScalar *d_q;
+  PetscInt          ldq,lds = ctx->ld*ctx->d;
+
+  PetscFunctionBegin;
+  if (s>=e) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDenseGetLDA(Q,&ldq));
+  PetscCall(MatDenseHIPGetArray(ctx->S,&d_pS));
+  PetscCall(BV_MatDenseHIPGetArrayRead(V,Q,&d_q));
+  PetscCall(BVMultInPlace_BLAS_HIP(V,lds,V->k-V->l,s-V->l,e-V->l,d_pS+(V->nc+V->l)*lds,lds,d_q+V->l*ldq+V->l,ldq,PETSC_TRUE));
+  PetscCall(BV_MatDenseHIPRestoreArrayRead(V,Q,&d_q));
+  PetscCall(MatDenseHIPRestoreArray(ctx->S,&d_pS));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode BVDot_Tensor_HIP(BV X,BV Y,Mat M)
+{
+  BV_TENSOR         *x = (BV_TENSOR*)X->data,*y = (BV_TENSOR*)Y->data;
+  PetscScalar       *pm;
+  const PetscScalar *d_px,*d_py;
+  PetscInt          ldm,lds = x->ld*x->d;
+
+  PetscFunctionBegin;
+  PetscCheck(x->U==y->U,PetscObjectComm((PetscObject)X),PETSC_ERR_SUP,"BVDot() in BVTENSOR requires that both operands have the same U factor");
+  PetscCheck(lds==y->ld*y->d,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_SIZ,"Mismatching dimensions ld*d %" PetscInt_FMT " %" PetscInt_FMT,lds,y->ld*y->d);
+  PetscCall(MatDenseGetLDA(M,&ldm));
+  PetscCall(MatDenseHIPGetArrayRead(x->S,&d_px));
+  PetscCall(MatDenseHIPGetArrayRead(y->S,&d_py));
+  PetscCall(MatDenseGetArrayWrite(M,&pm));
+  PetscCall(BVDot_BLAS_HIP(X,Y->k-Y->l,X->k-X->l,lds,d_py+(Y->nc+Y->l)*lds,lds,d_px+(X->nc+X->l)*lds,lds,pm+X->l*ldm+Y->l,ldm,PETSC_FALSE));
+  PetscCall(MatDenseRestoreArrayWrite(M,&pm));
+  PetscCall(MatDenseHIPRestoreArrayRead(x->S,&d_px));
+  PetscCall(MatDenseHIPRestoreArrayRead(y->S,&d_py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode BVScale_Tensor_HIP(BV bv,PetscInt j,PetscScalar alpha)
+{
+  BV_TENSOR      *ctx = (BV_TENSOR*)bv->data;
+  PetscScalar    *d_pS;
+  PetscInt       lds = ctx->ld*ctx->d;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseHIPGetArray(ctx->S,&d_pS));
+  if (PetscUnlikely(j<0)) PetscCall(BVScale_BLAS_HIP(bv,(bv->k-bv->l)*lds,d_pS+(bv->nc+bv->l)*lds,alpha));
+  else PetscCall(BVScale_BLAS_HIP(bv,lds,d_pS+(bv->nc+j)*lds,alpha));
+  PetscCall(MatDenseHIPRestoreArray(ctx->S,&d_pS));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode BVNorm_Tensor_HIP(BV bv,PetscInt j,NormType type,PetscReal *val)
+{
+  BV_TENSOR         *ctx = (BV_TENSOR*)bv->data;
+  const PetscScalar *pS,*d_pS;
+  PetscInt          lds = ctx->ld*ctx->d;
+
+  PetscFunctionBegin;
+  if ((j<0 && type==NORM_FROBENIUS) || (j>=0 && type==NORM_2)) {
+    /* compute on GPU with hipBLAS, the columns of S are stored contiguously */
+    PetscCall(MatDenseHIPGetArrayRead(ctx->S,&d_pS));
+    if (PetscUnlikely(j<0)) PetscCall(BVNorm_BLAS_HIP(bv,(bv->k-bv->l)*lds,d_pS+(bv->nc+bv->l)*lds,val));
+    else PetscCall(BVNorm_BLAS_HIP(bv,lds,d_pS+(bv->nc+j)*lds,val));
+    PetscCall(MatDenseHIPRestoreArrayRead(ctx->S,&d_pS));
+  } else {
+    /* compute on CPU */
+    PetscCall(MatDenseGetArrayRead(ctx->S,&pS));
+    if (j<0) PetscCall(BVNorm_LAPACK_Private(bv,lds,bv->k-bv->l,pS+(bv->nc+bv->l)*lds,lds,type,val,PETSC_FALSE));
+    else PetscCall(BVNorm_LAPACK_Private(bv,lds,1,pS+(bv->nc+j)*lds,lds,type,val,PETSC_FALSE));
+    PetscCall(MatDenseRestoreArrayRead(ctx->S,&pS));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode BVCopyColumn_Tensor_HIP(BV V,PetscInt j,PetscInt i)
+{
+  BV_TENSOR      *ctx = (BV_TENSOR*)V->data;
+  PetscScalar    *d_pS;
+  PetscInt       lds = ctx->ld*ctx->d;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseHIPGetArray(ctx->S,&d_pS));
+  PetscCallHIP(hipMemcpy(d_pS+(V->nc+i)*lds,d_pS+(V->nc+j)*lds,lds*sizeof(PetscScalar),hipMemcpyDeviceToDevice));
+  PetscCall(MatDenseHIPRestoreArray(ctx->S,&d_pS));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Classical Gram-Schmidt step for a column of S on the GPU. Only the k coefficients
+   are moved between host and device. Non-standard inner products and MGS are done
+   on the CPU.
+*/
+PetscErrorCode BVOrthogonalizeGS1_Tensor_HIP(BV bv,PetscInt k,Vec v,PetscBool *which,PetscScalar *h,PetscScalar *c,PetscReal *onorm,PetscReal *norm)
+{
+  BV_TENSOR      *ctx = (BV_TENSOR*)bv->data;
+  PetscScalar    *d_pS,*d_cc,*cc;
+  PetscInt       lds = ctx->ld*ctx->d;
+  PetscDeviceContext dctx;
+
+  PetscFunctionBegin;
+  if (ctx->qB || bv->orthog_type==BV_ORTHOG_MGS) {
+    PetscCall(BVOrthogonalizeGS1_Tensor(bv,k,v,which,h,c,onorm,norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(!v,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Orthogonalization against an external vector is not allowed in BVTENSOR");
+  PetscCall(MatDenseHIPGetArray(ctx->S,&d_pS));
+  if (!c) PetscCall(VecGetArray(bv->buffer,&cc));
+  else cc = c;
+
+  if (onorm) PetscCall(BVNorm_BLAS_HIP(bv,lds,d_pS+k*lds,onorm));
+
+  /* cc = S_{0:k-1}^* s_k */
+  PetscCall(BVDotVec_BLAS_HIP(bv,lds,k,d_pS,lds,d_pS+k*lds,cc,PETSC_FALSE));
+
+  /* s_k = s_k - S_{0:k-1} cc */
+  if (PetscUnlikely(bv->indef)) PetscCall(BV_ApplySignature(bv,k,cc,PETSC_TRUE));
+  PetscCall(PetscDeviceContextGetCurrentContext(&dctx));
+  PetscCall(PetscDeviceMalloc(dctx,PETSC_MEMTYPE_HIP,k,&d_cc));
+  PetscCall(PetscDeviceArrayCopy(dctx,d_cc,cc,k));
+  PetscCall(PetscLogCpuToGpu(k*sizeof(PetscScalar)));
+  PetscCall(BVMultVec_BLAS_HIP(bv,lds,k,-1.0,d_pS,lds,d_cc,1.0,d_pS+k*lds));
+  PetscCall(PetscDeviceFree(dctx,d_cc));
+  if (PetscUnlikely(bv->indef)) PetscCall(BV_ApplySignature(bv,k,cc,PETSC_FALSE));
+
+  if (norm) PetscCall(BVNorm_BLAS_HIP(bv,lds,d_pS+k*lds,norm));
+  PetscCall(BV_AddCoefficients(bv,k,h,cc));
+  PetscCall(MatDenseHIPRestoreArray(ctx->S,&d_pS));
+  if (!c) PetscCall(VecRestoreArray(bv->buffer,&cc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
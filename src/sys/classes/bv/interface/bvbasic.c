@@ -12,6 +12,9 @@
 */
 
 #include <slepc/private/bvimpl.h>      /*I "slepcbv.h" I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscBool         BVRegisterAllCalled = PETSC_FALSE;
 PetscFunctionList BVList = NULL;
@@ -283,6 +286,7 @@ PetscErrorCode BVSetNumConstraints(BV V,PetscInt nc)
       PetscCall(BVRestoreColumn(V,i+diff,&y));
     }
   }
+  PetscCall(BVDestroy(&V->cnstr));
   V->nc = nc;
   V->ci[0] = -V->nc-1;
   V->ci[1] = -V->nc-1;
@@ -353,9 +357,14 @@ PetscErrorCode BVResize(BV bv,PetscInt m,PetscBool copy)
 
   PetscCall(PetscLogEventBegin(BV_Create,bv,0,0,0));
   PetscUseTypeMethod(bv,resize,m,copy);
+  if (!bv->lsplit) {  /* cached split BV's refer to the old storage */
+    PetscCall(BVDestroy(&bv->L));
+    PetscCall(BVDestroy(&bv->R));
+  }
   PetscCall(VecDestroy(&bv->buffer));
   PetscCall(BVDestroy(&bv->cached));
   PetscCall(PetscFree2(bv->h,bv->c));
+  PetscCall(PetscFree(bv->sketch));
   if (bv->omega) {
     if (bv->cuda) {
 #if defined(PETSC_HAVE_CUDA)
@@ -866,6 +875,7 @@ PetscErrorCode BVSetFromOptions(BV bv)
   char               type[256];
   PetscBool          flg1,flg2,flg3,flg4;
   PetscReal          r;
+  PetscInt           i;
   BVOrthogType       otype;
   BVOrthogRefineType orefine;
   BVOrthogBlockType  oblock;
@@ -874,6 +884,10 @@ PetscErrorCode BVSetFromOptions(BV bv)
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
   PetscCall(BVRegisterAll());
   PetscObjectOptionsBegin((PetscObject)bv);
+    /* the number of threads must be set before type creation, where memory is first touched */
+    PetscCall(PetscOptionsInt("-bv_num_threads","Number of threads used in local operations","BVSetNumThreads",bv->nthreads,&i,&flg1));
+    if (flg1) PetscCall(BVSetNumThreads(bv,i));
+
     PetscCall(PetscOptionsFList("-bv_type","Basis Vectors type","BVSetType",BVList,(char*)(((PetscObject)bv)->type_name?((PetscObject)bv)->type_name:BVMAT),type,sizeof(type),&flg1));
     if (flg1) PetscCall(BVSetType(bv,type));
     else if (!((PetscObject)bv)->type_name) PetscCall(BVSetType(bv,BVMAT));
@@ -890,6 +904,13 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
     PetscCall(PetscOptionsEnum("-bv_matmult","Method for BVMatMult","BVSetMatMultMethod",BVMatMultTypes,(PetscEnum)bv->vmm,(PetscEnum*)&bv->vmm,NULL));
 
+    PetscCall(PetscOptionsInt("-bv_krylov_sstep","Number of vectors generated per block in Krylov expansions","BVSetKrylovSStep",bv->sstep,&i,&flg1));
+    if (flg1) PetscCall(BVSetKrylovSStep(bv,i));
+
+    PetscCall(PetscOptionsBool("-bv_hierarchical_reduction","Reduce first within each node and then among nodes","BVSetHierarchicalReduction",bv->hierred,&bv->hierred,NULL));
+    PetscCall(PetscOptionsBool("-bv_reproducible_reduction","Compute inner products and norms independently of the number of processes","BVSetReproducibleReduction",bv->reprored,&bv->reprored,NULL));
+    PetscCall(PetscOptionsBool("-bv_device_only","Forbid access to the data of a GPU BV from the host","BVSetDeviceOnly",bv->deviceonly,&bv->deviceonly,NULL));
+
     PetscCall(PetscOptionsReal("-bv_definite_tol","Tolerance for checking a definite inner product","BVSetDefiniteTolerance",r,&r,&flg1));
     if (flg1) PetscCall(BVSetDefiniteTolerance(bv,r));
 
@@ -921,7 +942,10 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
    Options Database Keys:
 +  -bv_orthog_type <type> - Where <type> is cgs for Classical Gram-Schmidt orthogonalization
-                         (default) or mgs for Modified Gram-Schmidt orthogonalization
+                         (default), mgs for Modified Gram-Schmidt orthogonalization,
+                         cgs_pipelined for pipelined Classical Gram-Schmidt, rgs for
+                         randomized Gram-Schmidt, or dcgs2 for delayed Classical Gram-Schmidt
+                         with reorthogonalization
 .  -bv_orthog_refine <ref> - Where <ref> is one of never, ifneeded (default) or always
 .  -bv_orthog_eta <eta> -  For setting the value of eta
 -  -bv_orthog_block <block> - Where <block> is the block-orthogonalization method
@@ -935,6 +959,33 @@ PetscErrorCode BVSetFromOptions(BV bv)
 
    When using several processors, MGS is likely to result in bad scalability.
 
+   The pipelined variant of CGS computes the inner products and the norm of
+   the vector with a single nonblocking reduction. In BVMatArnoldi() and
+   BVMatLanczos() this reduction is overlapped with the next matrix-vector
+   product, which is applied to the vector before orthogonalization and then
+   corrected with the Krylov recurrence. The overlap is lost each time
+   refinement is needed, so it is most effective with BV_ORTHOG_REFINE_NEVER
+   or with small values of eta. The operator must not use split-phase
+   reductions on the same communicator, e.g., a pipelined KSP in ST.
+
+   The randomized variant (RGS) replaces the inner products with the basis by
+   a least squares problem in a small random subspace. Each vector is mapped with
+   a sparse sign embedding of dimension 4*m (m being the number of columns), whose
+   sketch is reduced in a single small global reduction, and the coefficients are
+   then computed locally from the cached sketches of the previous columns. The
+   resulting basis is orthonormal with respect to the sketched inner product, so
+   it is well conditioned but not orthonormal to working precision. RGS is not
+   available for non-standard inner products (see BVSetMatrix()), in which case
+   CGS is used instead.
+
+   The delayed variant of CGS with reorthogonalization (DCGS2) always does two
+   passes of Gram-Schmidt, regardless of the refinement type. In BVMatArnoldi()
+   the second pass of each vector is delayed to the next step, where its inner
+   products are computed in the same reduction as the first pass of the next
+   vector, so that only one global synchronization is required per step instead
+   of two. In the rest of operations it is equivalent to CGS with refinement
+   BV_ORTHOG_REFINE_ALWAYS.
+
    If the method set for block orthogonalization is GS, then the computation
    is done column by column with the vector orthogonalization.
 
@@ -953,6 +1004,9 @@ PetscErrorCode BVSetOrthogonalization(BV bv,BVOrthogType type,BVOrthogRefineType
   switch (type) {
     case BV_ORTHOG_CGS:
     case BV_ORTHOG_MGS:
+    case BV_ORTHOG_CGS_PIPELINED:
+    case BV_ORTHOG_RGS:
+    case BV_ORTHOG_DCGS2:
       bv->orthog_type = type;
       break;
     default:
@@ -979,6 +1033,8 @@ PetscErrorCode BVSetOrthogonalization(BV bv,BVOrthogType type,BVOrthogRefineType
     case BV_ORTHOG_BLOCK_TSQR:
     case BV_ORTHOG_BLOCK_TSQRCHOL:
     case BV_ORTHOG_BLOCK_SVQB:
+    case BV_ORTHOG_BLOCK_CHOLQR2:
+    case BV_ORTHOG_BLOCK_SCHOLQR3:
       bv->orthog_block = block;
       break;
     default:
@@ -1036,6 +1092,12 @@ PetscErrorCode BVGetOrthogonalization(BV bv,BVOrthogType *type,BVOrthogRefineTyp
 
    The default is BV_MATMULT_MAT except in the case of BVVECS.
 
+   In BV_MATMULT_MAT, the dense matrices that are multiplied share the memory
+   of the BV objects (except in BVVECS, whose columns are not contiguous), and
+   the symbolic phase of the product is reused in subsequent calls with the same
+   matrix and BV objects, as long as the nonzero pattern of the matrix does not
+   change.
+
    Level: advanced
 
 .seealso: BVMatMult(), BVGetMatMultMethod(), BVMatMultType
@@ -1084,6 +1146,375 @@ PetscErrorCode BVGetMatMultMethod(BV bv,BVMatMultType *method)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   BVSetKrylovSStep - Sets the number of vectors that are generated per block
+   in the s-step variant of the Krylov expansions.
+
+   Logically Collective
+
+   Input Parameters:
++  bv - the basis vectors context
+-  s  - the number of vectors per block
+
+   Options Database Key:
+.  -bv_krylov_sstep <s> - the number of vectors per block
+
+   Notes:
+   When s>1, BVMatArnoldi() and BVMatLanczos() build the Krylov basis in
+   blocks of s vectors. Each block is generated with s consecutive products
+   by the matrix using a Newton basis, whose shifts are Ritz values of the
+   current factorization in Leja order, and then it is orthogonalized with
+   a block Cholesky QR that requires one global reduction per pass instead of
+   one (or more) per vector. The Hessenberg (or tridiagonal) matrix of the
+   standard Arnoldi (or Lanczos) recurrence is recovered from the change of
+   basis, so the output is equivalent to the one-vector-per-step factorization.
+
+   This reduces the number of synchronizations by a factor of s, which can
+   be beneficial on large numbers of processes where the latency of global
+   reductions dominates. Since the block basis may become ill-conditioned,
+   small values (e.g., s between 2 and 8) are recommended. If the Cholesky
+   factorization of a block fails, the computation continues with the
+   standard one-vector-per-step expansion.
+
+   Use s=1 (the default) to disable the s-step variant. PETSC_DETERMINE
+   also resets it to 1.
+
+   Level: advanced
+
+.seealso: BVGetKrylovSStep(), BVMatArnoldi(), BVMatLanczos()
+@*/
+PetscErrorCode BVSetKrylovSStep(BV bv,PetscInt s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveInt(bv,s,2);
+  if (s == PETSC_DETERMINE || s == PETSC_DECIDE) bv->sstep = 1;
+  else if (s != PETSC_CURRENT) {
+    PetscCheck(s>0,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of s. Must be > 0");
+    bv->sstep = s;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVGetKrylovSStep - Gets the number of vectors that are generated per block
+   in the s-step variant of the Krylov expansions.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  s - the number of vectors per block
+
+   Level: advanced
+
+.seealso: BVSetKrylovSStep()
+@*/
+PetscErrorCode BVGetKrylovSStep(BV bv,PetscInt *s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscAssertPointer(s,2);
+  *s = bv->sstep;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVSetNumThreads - Sets the number of threads used in the local computations
+   of the BV operations.
+
+   Logically Collective
+
+   Input Parameters:
++  bv - the basis vectors context
+-  nt - the number of threads
+
+   Options Database Key:
+.  -bv_num_threads <nt> - the number of threads
+
+   Notes:
+   This is relevant in hybrid MPI+OpenMP runs (e.g., one MPI process per
+   socket), and has effect only if PETSc has been configured with OpenMP.
+   The local rows are partitioned statically among the threads, which call
+   the BLAS on their own part. In BVSVEC and BVCONTIGUOUS, the storage is
+   initialized with the same partition, so that the memory pages are placed
+   (first-touch) in the NUMA domain of the thread that will work on them.
+   For this reason, the number of threads must be set before the BV type is
+   set, and BVDuplicate() preserves it.
+
+   To avoid oversubscription, a sequential BLAS should be used (or the
+   multithreaded BLAS should be restricted to one thread), and the OpenMP
+   threads should be bound to cores, e.g., with OMP_PROC_BIND=close.
+
+   Use PETSC_DECIDE to use the maximum number of OpenMP threads available.
+   The default is 1, i.e., no threading other than the one of the BLAS.
+
+   Level: advanced
+
+.seealso: BVGetNumThreads(), BVSetType()
+@*/
+PetscErrorCode BVSetNumThreads(BV bv,PetscInt nt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveInt(bv,nt,2);
+  if (nt == PETSC_DECIDE || nt == PETSC_DETERMINE) {
+#if defined(PETSC_HAVE_OPENMP)
+    bv->nthreads = omp_get_max_threads();
+#else
+    bv->nthreads = 1;
+#endif
+  } else if (nt != PETSC_CURRENT) {
+    PetscCheck(nt>0,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of nt. Must be > 0");
+#if defined(PETSC_HAVE_OPENMP)
+    bv->nthreads = nt;
+#else
+    if (nt>1) PetscCall(PetscInfo(bv,"Ignoring the number of threads since PETSc has not been configured with OpenMP\n"));
+#endif
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVGetNumThreads - Gets the number of threads used in the local computations
+   of the BV operations.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  nt - the number of threads
+
+   Level: advanced
+
+.seealso: BVSetNumThreads()
+@*/
+PetscErrorCode BVGetNumThreads(BV bv,PetscInt *nt)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscAssertPointer(nt,2);
+  *nt = bv->nthreads;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVSetHierarchicalReduction - Selects whether the global reductions of the
+   inner products are done in two levels, first within each node and then
+   among the nodes.
+
+   Logically Collective
+
+   Input Parameters:
++  bv   - the basis vectors context
+-  flg  - whether to use hierarchical reductions
+
+   Options Database Key:
+.  -bv_hierarchical_reduction <flg> - the flag
+
+   Notes:
+   By default, the Gram matrices computed by BVDot(), BVDotVec() and related
+   operations are summed with a single MPI_Allreduce() over the communicator
+   of the BV. With the hierarchical scheme, the processes sharing memory
+   (as given by MPI_Comm_split_type()) first reduce on the local leader, the
+   leaders of all nodes then do the global reduction, and the result is
+   broadcast within the node. This may be faster in runs with many nodes
+   and large blocks, e.g., in CISS or LOBPCG.
+
+   If MPI supports shared-memory windows, the steps within the node do not
+   use messages: the contributions are stored in a window shared by the
+   processes of the node, each process adds up a chunk of the entries, and the
+   result of the global reduction is read by all of them from the window.
+
+   The auxiliary communicators are created the first time they are needed
+   and are shared by all BV objects with the same communicator.
+
+   Level: advanced
+
+.seealso: BVGetHierarchicalReduction(), BVDot()
+@*/
+PetscErrorCode BVSetHierarchicalReduction(BV bv,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveBool(bv,flg,2);
+  bv->hierred = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVGetHierarchicalReduction - Gets the flag indicating whether the global
+   reductions are done in two levels.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  flg - the flag
+
+   Level: advanced
+
+.seealso: BVSetHierarchicalReduction()
+@*/
+PetscErrorCode BVGetHierarchicalReduction(BV bv,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscAssertPointer(flg,2);
+  *flg = bv->hierred;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVSetReproducibleReduction - Selects whether the inner products and norms
+   are computed with reproducible sums, so that the results are bitwise
+   identical for any number of processes.
+
+   Logically Collective
+
+   Input Parameters:
++  bv   - the basis vectors context
+-  flg  - whether to use reproducible reductions
+
+   Options Database Key:
+.  -bv_reproducible_reduction <flg> - the flag
+
+   Notes:
+   Floating-point addition is not associative, so in general the result of
+   BVDot(), BVDotVec() or BVNorm() depends on how the rows are distributed
+   among processes and threads, and on the order of the global reduction.
+   With this option, each sum is split in three sums whose terms are rounded
+   beforehand to a precision given by the largest term over all processes,
+   so that these sums are exact (pre-rounding, as in ReproBLAS). The result
+   is then independent of the order of the operations, with accuracy comparable
+   to the standard summation. Together with the option -bv_reproducible_random,
+   this removes the dependence on the number of processes of the BV operations
+   done by the eigensolvers, although other operations such as the product by
+   a parallel matrix may still introduce differences.
+
+   The cost is bounded as follows: the local computation does not use the BLAS
+   and has about 4+9 (real) or 2*(4+9) (complex) flops per term instead of 2, and
+   each reduction is replaced by a maximum of the same length followed by a
+   sum of length 3 (real) or 6 (complex) times larger. Hence it is only
+   recommended for regression testing and for comparing results across runs
+   with different number of processes.
+
+   This is available in BVSVEC, BVCONTIGUOUS and BVMAT, with vectors in the
+   host memory, and also in the norms of BVMIXED and BVPANEL. With the
+   split phase functions such as BVDotVecBegin()/BVDotVecEnd() the whole
+   operation is done in the End call.
+
+   Level: advanced
+
+.seealso: BVGetReproducibleReduction(), BVDot(), BVDotVec(), BVNorm()
+@*/
+PetscErrorCode BVSetReproducibleReduction(BV bv,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveBool(bv,flg,2);
+  bv->reprored = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVGetReproducibleReduction - Gets the flag indicating whether the inner
+   products and norms are computed with reproducible sums.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  flg - the flag
+
+   Level: advanced
+
+.seealso: BVSetReproducibleReduction()
+@*/
+PetscErrorCode BVGetReproducibleReduction(BV bv,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscAssertPointer(flg,2);
+  *flg = bv->reprored;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVSetDeviceOnly - Selects whether the data of a BV that lives in GPU memory
+   can be accessed from the host.
+
+   Logically Collective
+
+   Input Parameters:
++  bv   - the basis vectors context
+-  flg  - whether to forbid host access
+
+   Options Database Key:
+.  -bv_device_only <flg> - the flag
+
+   Notes:
+   The vectors of a BV with a GPU vector type (see BVSetVecType()) are
+   allocated only in device memory, and the host copy is allocated and updated
+   on demand, when the data is accessed from the host with BVGetArray() or
+   BVGetArrayRead(). This happens for instance in operations that have no
+   device implementation, which results in hidden host-device transfers.
+
+   With this flag set, such accesses are an error in debug mode, so that
+   they can be located with a debugger or from the error traceback. In
+   optimized mode the flag has no effect. To access the data on the host on
+   purpose, e.g., for viewing it, unset the flag before and set it again
+   afterwards. Access through the vectors obtained with BVGetColumn() is not
+   checked.
+
+   The flag is ignored if the BV is not on the GPU.
+
+   Level: advanced
+
+.seealso: BVGetDeviceOnly(), BVSetVecType(), BVGetArray(), BVGetArrayRead()
+@*/
+PetscErrorCode BVSetDeviceOnly(BV bv,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscValidLogicalCollectiveBool(bv,flg,2);
+  bv->deviceonly = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVGetDeviceOnly - Gets the flag indicating whether host access to the
+   data of a GPU BV is forbidden.
+
+   Not Collective
+
+   Input Parameter:
+.  bv - basis vectors context
+
+   Output Parameter:
+.  flg - the flag
+
+   Level: advanced
+
+.seealso: BVSetDeviceOnly()
+@*/
+PetscErrorCode BVGetDeviceOnly(BV bv,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(bv,BV_CLASSID,1);
+  PetscAssertPointer(flg,2);
+  *flg = bv->deviceonly;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    BVGetColumn - Returns a Vec object that contains the entries of the
    requested column of the basis vectors object.
@@ -1173,7 +1604,10 @@ PetscErrorCode BVRestoreColumn(BV bv,PetscInt j,Vec *v)
   PetscCall(PetscObjectGetId((PetscObject)*v,&id));
   PetscCheck(id==bv->id[l],PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONG,"Argument 3 is not the same Vec that was obtained with BVGetColumn");
   PetscCall(VecGetState(*v,&st));
-  if (st!=bv->st[l]) PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+  if (st!=bv->st[l]) {
+    PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+    if (j<0) PetscCall(BVDestroy(&bv->cnstr));  /* a constraint has been modified */
+  }
   PetscUseTypeMethod(bv,restorecolumn,j,v);
   bv->ci[l] = -bv->nc-1;
   bv->st[l] = -1;
@@ -1219,6 +1653,7 @@ PetscErrorCode BVGetArray(BV bv,PetscScalar **a)
   PetscValidType(bv,1);
   BVCheckSizes(bv,1);
   BVCheckOp(bv,1,getarray);
+  BVCheckHostAccess(bv,1);
   PetscUseTypeMethod(bv,getarray,a);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1283,6 +1718,7 @@ PetscErrorCode BVGetArrayRead(BV bv,const PetscScalar **a)
   PetscValidType(bv,1);
   BVCheckSizes(bv,1);
   BVCheckOp(bv,1,getarrayread);
+  BVCheckHostAccess(bv,1);
   PetscUseTypeMethod(bv,getarrayread,a);
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1613,6 +2049,101 @@ PetscErrorCode BVRestoreMat(BV bv,Mat *A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_SCALAPACK)
+/*
+   Computes W = A*V when A is a MATSCALAPACK matrix, or the (Hermitian) transpose of
+   one. The block of vectors is redistributed to the 2D block-cyclic layout of A, so
+   that the product is done with a single PBLAS gemm instead of one matrix-vector
+   product per column, each with its own redistribution. The transpose is computed
+   as (V^T*A)^T, since PETSc does not provide the transposed product for MATSCALAPACK
+*/
+static PetscErrorCode BVMatMult_ScaLAPACK_Private(Mat A,Mat Vmat,Mat Wmat,PetscBool *done)
+{
+  Mat       A0=A,Vs,Vt,Ws,Wt,Wd;
+  PetscBool flg,trans,herm;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A,MATTRANSPOSEVIRTUAL,&trans));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A,MATHERMITIANTRANSPOSEVIRTUAL,&herm));
+  if (trans) PetscCall(MatTransposeGetMat(A,&A0));
+  else if (herm) PetscCall(MatHermitianTransposeGetMat(A,&A0));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A0,MATSCALAPACK,&flg));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)Vmat,&flg,MATSEQDENSE,MATMPIDENSE,""));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatConvert(Vmat,MATSCALAPACK,MAT_INITIAL_MATRIX,&Vs));
+  if (trans || herm) {
+    if (trans) PetscCall(MatTranspose(Vs,MAT_INITIAL_MATRIX,&Vt));
+    else PetscCall(MatHermitianTranspose(Vs,MAT_INITIAL_MATRIX,&Vt));
+    PetscCall(MatMatMult(Vt,A0,MAT_INITIAL_MATRIX,PETSC_DETERMINE,&Wt));
+    if (trans) PetscCall(MatTranspose(Wt,MAT_INITIAL_MATRIX,&Ws));
+    else PetscCall(MatHermitianTranspose(Wt,MAT_INITIAL_MATRIX,&Ws));
+    PetscCall(MatDestroy(&Vt));
+    PetscCall(MatDestroy(&Wt));
+  } else PetscCall(MatMatMult(A0,Vs,MAT_INITIAL_MATRIX,PETSC_DETERMINE,&Ws));
+  PetscCall(MatConvert(Ws,MATDENSE,MAT_INITIAL_MATRIX,&Wd));
+  PetscCall(MatCopy(Wd,Wmat,SAME_NONZERO_PATTERN));
+  PetscCall(MatDestroy(&Vs));
+  PetscCall(MatDestroy(&Ws));
+  PetscCall(MatDestroy(&Wd));
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*
+   BVMatMult_Product_Private - Computes W = A*V as a product of A times the dense
+   matrices that share the memory of V and W (as returned by BVGetMat), so that
+   no copies are done and the sparse-times-dense kernel of A is used.
+
+   The symbolic product is kept in the matrix of W, and only the numeric phase
+   is done in subsequent calls with the same A and V, unless A's nonzero
+   pattern has changed.
+*/
+PetscErrorCode BVMatMult_Product_Private(BV V,Mat A,BV W)
+{
+  Mat              Vmat,Wmat,pA,pB;
+  MatProductType   ptype;
+  PetscObjectId    id;
+  PetscObjectState nzstate;
+  PetscBool        reuse=PETSC_FALSE;
+#if defined(PETSC_HAVE_SCALAPACK)
+  PetscBool        done;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(BVGetMat(V,&Vmat));
+  PetscCall(BVGetMat(W,&Wmat));
+#if defined(PETSC_HAVE_SCALAPACK)
+  PetscCall(BVMatMult_ScaLAPACK_Private(A,Vmat,Wmat,&done));
+  if (done) {
+    PetscCall(BVRestoreMat(V,&Vmat));
+    PetscCall(BVRestoreMat(W,&Wmat));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCall(PetscObjectGetId((PetscObject)A,&id));
+  PetscCall(MatGetNonzeroState(A,&nzstate));
+  PetscCall(MatProductGetType(Wmat,&ptype));
+  if (ptype==MATPRODUCT_AB && id==W->mmid && nzstate==W->mmstate) {
+    PetscCall(MatProductGetMats(Wmat,&pA,&pB,NULL));
+    reuse = (pA==A && pB==Vmat)? PETSC_TRUE: PETSC_FALSE;
+  }
+  if (!reuse) {
+    PetscCall(MatProductCreateWithMat(A,Vmat,NULL,Wmat));
+    PetscCall(MatProductSetType(Wmat,MATPRODUCT_AB));
+    PetscCall(MatProductSetFromOptions(Wmat));
+    PetscCall(MatProductSymbolic(Wmat));
+    W->mmid    = id;
+    W->mmstate = nzstate;
+  }
+  PetscCall(MatProductNumeric(Wmat));
+  PetscCall(BVRestoreMat(V,&Vmat));
+  PetscCall(BVRestoreMat(W,&Wmat));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Copy all user-provided attributes of V to another BV object W
  */
@@ -1622,6 +2153,10 @@ static inline PetscErrorCode BVDuplicate_Private(BV V,BV W)
   PetscCall(PetscLayoutReference(V->map,&W->map));
   PetscCall(BVSetVecType(W,V->vtype));
   W->ld           = V->ld;
+  W->nthreads     = V->nthreads;
+  W->hierred      = V->hierred;
+  W->reprored     = V->reprored;
+  W->deviceonly   = V->deviceonly;
   PetscCall(BVSetType(W,((PetscObject)V)->type_name));
   W->orthog_type  = V->orthog_type;
   W->orthog_ref   = V->orthog_ref;
@@ -1633,6 +2168,8 @@ static inline PetscErrorCode BVDuplicate_Private(BV V,BV W)
   W->vmm          = V->vmm;
   W->rrandom      = V->rrandom;
   W->deftol       = V->deftol;
+  W->sstep        = V->sstep;
+  W->tilebs       = V->tilebs;
   if (V->rand) PetscCall(PetscObjectReference((PetscObject)V->rand));
   W->rand         = V->rand;
   W->sfocalled    = V->sfocalled;
@@ -1871,6 +2408,7 @@ PetscErrorCode BVCopyVec(BV V,PetscInt j,Vec w)
 PetscErrorCode BVCopyColumn(BV V,PetscInt j,PetscInt i)
 {
   PetscScalar *omega;
+  PetscBool   sketch;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(V,BV_CLASSID,1);
@@ -1880,6 +2418,7 @@ PetscErrorCode BVCopyColumn(BV V,PetscInt j,PetscInt i)
   PetscValidLogicalCollectiveInt(V,i,3);
   if (j==i) PetscFunctionReturn(PETSC_SUCCESS);
 
+  sketch = BV_SketchValid(V);
   PetscCall(PetscLogEventBegin(BV_Copy,V,0,0,0));
   if (V->omega) {
     PetscCall(VecGetArray(V->omega,&omega));
@@ -1889,6 +2428,7 @@ PetscErrorCode BVCopyColumn(BV V,PetscInt j,PetscInt i)
   PetscUseTypeMethod(V,copycolumn,j,i);
   PetscCall(PetscLogEventEnd(BV_Copy,V,0,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)V));
+  PetscCall(BV_SketchKeep(V,sketch,i));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1898,7 +2438,18 @@ static PetscErrorCode BVGetSplit_Private(BV bv,PetscBool left,BV *split)
 
   PetscFunctionBegin;
   ncols = left? bv->nc+bv->l: bv->m-bv->l;
-  if (*split && (ncols!=(*split)->m || bv->N!=(*split)->N)) PetscCall(BVDestroy(split));
+  /* a cached split BV is reused as a view of the new column range if its type supports it */
+  if (*split && (bv->N!=(*split)->N || (!(*split)->ops->resetsplit && ncols!=(*split)->m))) PetscCall(BVDestroy(split));
+  if (*split && (*split)->ops->resetsplit) {
+    if (ncols!=(*split)->nc+(*split)->m) {  /* workspace sized for the previous number of columns */
+      PetscCall(VecDestroy(&(*split)->buffer));
+      PetscCall(MatDestroy(&(*split)->Abuffer));
+      PetscCall(PetscFree2((*split)->h,(*split)->c));
+      PetscCall(PetscFree((*split)->sketch));
+    }
+    PetscUseTypeMethod(*split,resetsplit);
+    PetscCall(PetscObjectStateIncrease((PetscObject)*split));  /* invalidate data cached in the split BV */
+  }
   if (!*split) {
     PetscCall(BVCreate(PetscObjectComm((PetscObject)bv),split));
     (*split)->issplit = left? 1: 2;
@@ -1948,6 +2499,10 @@ static PetscErrorCode BVGetSplit_Private(BV bv,PetscBool left,BV *split)
    The returned BV's must not be destroyed. BVRestoreSplit() must be called
    when they are no longer needed.
 
+   The split BV's are kept in bv, and in subsequent calls they are reused as
+   views of the new column ranges, so that in BVSVEC and BVCONTIGUOUS no object
+   is allocated after the first call.
+
    Pass NULL for any of the output BV's that is not needed.
 
    Level: advanced
@@ -1990,6 +2545,8 @@ PetscErrorCode BVGetSplit(BV bv,BV *L,BV *R)
 @*/
 PetscErrorCode BVRestoreSplit(BV bv,BV *L,BV *R)
 {
+  PetscObjectState lstate=0,rstate=0;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
   PetscValidType(bv,1);
@@ -2000,7 +2557,11 @@ PetscErrorCode BVRestoreSplit(BV bv,BV *L,BV *R)
   PetscCheck(!L || ((*L)->ci[0]<=(*L)->nc-1 && (*L)->ci[1]<=(*L)->nc-1),PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"Argument 2 has unrestored columns, use BVRestoreColumn()");
   PetscCheck(!R || ((*R)->ci[0]<=(*R)->nc-1 && (*R)->ci[1]<=(*R)->nc-1),PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"Argument 3 has unrestored columns, use BVRestoreColumn()");
 
+  if (L) PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
+  if (R) PetscCall(PetscObjectStateGet((PetscObject)*R,&rstate));
   PetscTryTypeMethod(bv,restoresplit,L,R);
+  /* the parent has been modified if any of the children has */
+  if ((L && lstate!=bv->lstate) || (R && rstate!=bv->rstate)) PetscCall(PetscObjectStateIncrease((PetscObject)bv));
   bv->lsplit = 0;
   if (L) *L = NULL;
   if (R) *R = NULL;
@@ -2016,6 +2577,10 @@ static inline PetscErrorCode BVDuplicateNewLayout_Private(BV V,BV W)
   PetscCall(PetscLayoutCreateFromSizes(PetscObjectComm((PetscObject)V),W->n,W->N,1,&W->map));
   PetscCall(BVSetVecType(W,V->vtype));
   W->ld           = V->ld;
+  W->nthreads     = V->nthreads;
+  W->hierred      = V->hierred;
+  W->reprored     = V->reprored;
+  W->deviceonly   = V->deviceonly;
   PetscCall(BVSetType(W,((PetscObject)V)->type_name));
   W->orthog_type  = V->orthog_type;
   W->orthog_ref   = V->orthog_ref;
@@ -2024,6 +2589,7 @@ static inline PetscErrorCode BVDuplicateNewLayout_Private(BV V,BV W)
   W->vmm          = V->vmm;
   W->rrandom      = V->rrandom;
   W->deftol       = V->deftol;
+  W->sstep        = V->sstep;
   if (V->rand) PetscCall(PetscObjectReference((PetscObject)V->rand));
   W->rand         = V->rand;
   W->sfocalled    = V->sfocalled;
@@ -2047,6 +2613,10 @@ static PetscErrorCode BVGetSplitRows_Private(BV bv,PetscBool top,IS is,BV *split
   PetscCall(ISGetSize(is,&N));
   PetscCall(ISGetLocalSize(is,&n));
   if (*split && (bv->m!=(*split)->m || N!=(*split)->N)) PetscCall(BVDestroy(split));
+  if (*split && (*split)->ops->resetsplit) {
+    PetscUseTypeMethod(*split,resetsplit);
+    PetscCall(PetscObjectStateIncrease((PetscObject)*split));
+  }
   if (!*split) {
     PetscCall(BVCreate(PetscObjectComm((PetscObject)bv),split));
     (*split)->issplit = top? -1: -2;
@@ -2147,6 +2717,8 @@ PetscErrorCode BVGetSplitRows(BV bv,IS isup,IS islo,BV *U,BV *L)
 @*/
 PetscErrorCode BVRestoreSplitRows(BV bv,IS isup,IS islo,BV *U,BV *L)
 {
+  PetscObjectState ustate=0,lstate=0;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
   PetscValidType(bv,1);
@@ -2154,7 +2726,11 @@ PetscErrorCode BVRestoreSplitRows(BV bv,IS isup,IS islo,BV *U,BV *L)
   PetscCheck(bv->lsplit<0,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"Must call BVGetSplitRows first");
   PetscCheck(!U || ((*U)->ci[0]<=(*U)->nc-1 && (*U)->ci[1]<=(*U)->nc-1),PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"The upper BV has unrestored columns, use BVRestoreColumn()");
   PetscCheck(!L || ((*L)->ci[0]<=(*L)->nc-1 && (*L)->ci[1]<=(*L)->nc-1),PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_WRONGSTATE,"The lower BV has unrestored columns, use BVRestoreColumn()");
+  if (U) PetscCall(PetscObjectStateGet((PetscObject)*U,&ustate));
+  if (L) PetscCall(PetscObjectStateGet((PetscObject)*L,&lstate));
   PetscTryTypeMethod(bv,restoresplitrows,isup,islo,U,L);
+  /* the parent has been modified if any of the children has */
+  if ((U && ustate!=bv->rstate) || (L && lstate!=bv->lstate)) PetscCall(PetscObjectStateIncrease((PetscObject)bv));
   bv->lsplit = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
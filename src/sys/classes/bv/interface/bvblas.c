@@ -13,9 +13,355 @@
 
 #include <slepc/private/bvimpl.h>
 #include <slepcblaslapack.h>
+#include <petsctime.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 #define BLOCKSIZE 64
 
+#if defined(PETSC_HAVE_OPENMP)
+/* minimum number of rows per thread, and alignment of the row ranges of threads */
+#define BV_THREAD_MINROWS 1024
+#define BV_THREAD_ALIGN   64
+
+/*
+   Number of threads to be used in a kernel operating on m rows
+*/
+static inline int BV_NumThreads(BV bv,PetscInt m)
+{
+  PetscInt nt = PetscMin(bv->nthreads,m/BV_THREAD_MINROWS);
+
+  return (nt>1 && !omp_in_parallel())? (int)nt: 1;
+}
+
+/*
+   Range of rows [*s,*e) of a kernel with m rows that is assigned to thread t of nt.
+   All kernels (and BVFirstTouch_Private) use the same static partition, so that
+   each thread operates on the memory pages that it touched first
+*/
+static inline void BV_ThreadRows(PetscBLASInt m,int nt,int t,PetscBLASInt *s,PetscBLASInt *e)
+{
+  PetscBLASInt chunk = ((m/nt)/BV_THREAD_ALIGN)*BV_THREAD_ALIGN;
+
+  *s = t*chunk;
+  *e = (t==nt-1)? m: (t+1)*chunk;
+}
+#endif
+
+/*
+   Communicators for hierarchical reductions, cached as an attribute of the
+   communicator of the BV so that they are shared by all BV objects. If MPI
+   supports shared-memory windows, the node also has a window, allocated by
+   the leader, with one slot of len scalars per process plus one for the result
+*/
+typedef struct {
+  MPI_Comm    node;     /* processes in the same shared-memory node */
+  MPI_Comm    leader;   /* first process of each node (MPI_COMM_NULL in the rest) */
+  PetscMPIInt nsize;    /* number of processes in the node */
+  PetscMPIInt nrank;    /* rank in the node */
+  MPI_Win     win;      /* window shared by the processes of the node */
+  PetscScalar *shm;     /* base address of the window in the local process */
+  PetscMPIInt shmlen;   /* length of each slot of the window */
+} BV_HierComm;
+
+static PetscMPIInt BV_HierComm_keyval = MPI_KEYVAL_INVALID;
+
+static PetscMPIInt MPIAPI BV_HierCommDelete(MPI_Comm comm,PetscMPIInt keyval,void *val,void *extra)
+{
+  BV_HierComm *hc = (BV_HierComm*)val;
+
+  if (hc->win!=MPI_WIN_NULL) {
+    (void)MPI_Win_unlock_all(hc->win);
+    (void)MPI_Win_free(&hc->win);
+  }
+  (void)MPI_Comm_free(&hc->node);
+  if (hc->leader!=MPI_COMM_NULL) (void)MPI_Comm_free(&hc->leader);
+  (void)PetscFree(hc);
+  return MPI_SUCCESS;
+}
+
+static PetscErrorCode BV_HierCommFinalize(void)
+{
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_free_keyval(&BV_HierComm_keyval));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode BV_GetHierComm(BV bv,BV_HierComm **hc)
+{
+  MPI_Comm       comm = PetscObjectComm((PetscObject)bv);
+  PetscMPIInt    flg,rank;
+
+  PetscFunctionBegin;
+  if (BV_HierComm_keyval==MPI_KEYVAL_INVALID) {
+    PetscCallMPI(MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN,BV_HierCommDelete,&BV_HierComm_keyval,NULL));
+    PetscCall(PetscRegisterFinalize(BV_HierCommFinalize));
+  }
+  PetscCallMPI(MPI_Comm_get_attr(comm,BV_HierComm_keyval,hc,&flg));
+  if (!flg) {
+    PetscCall(PetscNew(hc));
+    PetscCallMPI(MPI_Comm_split_type(comm,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&(*hc)->node));
+    PetscCallMPI(MPI_Comm_rank((*hc)->node,&rank));
+    PetscCallMPI(MPI_Comm_size((*hc)->node,&(*hc)->nsize));
+    PetscCallMPI(MPI_Comm_split(comm,rank?MPI_UNDEFINED:0,0,&(*hc)->leader));
+    (*hc)->nrank = rank;
+    (*hc)->win   = MPI_WIN_NULL;
+    PetscCallMPI(MPI_Comm_set_attr(comm,BV_HierComm_keyval,*hc));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+/*
+   Makes sure that the window of the node has slots of at least len scalars;
+   it is collective on the node communicator
+*/
+static PetscErrorCode BV_HierCommGetWindow(BV_HierComm *hc,PetscMPIInt len)
+{
+  PetscMPIInt disp;
+  MPI_Aint    sz;
+
+  PetscFunctionBegin;
+  if (hc->win!=MPI_WIN_NULL && hc->shmlen>=len) PetscFunctionReturn(PETSC_SUCCESS);
+  if (hc->win!=MPI_WIN_NULL) {
+    PetscCallMPI(MPI_Win_unlock_all(hc->win));
+    PetscCallMPI(MPI_Win_free(&hc->win));
+  }
+  sz = hc->nrank? 0: (MPI_Aint)(hc->nsize+1)*len*sizeof(PetscScalar);
+  PetscCallMPI(MPI_Win_allocate_shared(sz,sizeof(PetscScalar),MPI_INFO_NULL,hc->node,&hc->shm,&hc->win));
+  PetscCallMPI(MPI_Win_shared_query(hc->win,0,&sz,&disp,&hc->shm));
+  PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK,hc->win));
+  hc->shmlen = len;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Synchronization of the processes of the node, with a consistent view of the window */
+static inline PetscErrorCode BV_HierCommSync(BV_HierComm *hc)
+{
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Win_sync(hc->win));
+  PetscCallMPI(MPI_Barrier(hc->node));
+  PetscCallMPI(MPI_Win_sync(hc->win));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Hierarchical sum through the window of the node: each process stores its
+   contribution in its slot, then adds up a chunk of the entries of all slots
+   into the result slot, the leaders do the global reduction in place, and all
+   processes read the result. The slots of the contributions and of the result
+   are different, so that a process may store the contribution of the next sum
+   while others are still reading the result of the previous one
+*/
+static PetscErrorCode BVAllreduceSum_Shared(BV_HierComm *hc,PetscScalar *in,PetscScalar *out,PetscMPIInt len)
+{
+  PetscMPIInt i,r,s,e,chunk;
+  PetscScalar *res,sum;
+
+  PetscFunctionBegin;
+  PetscCall(BV_HierCommGetWindow(hc,len));
+  res = hc->shm+(size_t)hc->nsize*hc->shmlen;
+  PetscCall(PetscArraycpy(hc->shm+(size_t)hc->nrank*hc->shmlen,in,len));
+  PetscCall(BV_HierCommSync(hc));
+  chunk = len/hc->nsize+((len%hc->nsize)?1:0);
+  s = PetscMin(hc->nrank*chunk,len);
+  e = PetscMin(s+chunk,len);
+  for (i=s;i<e;i++) {
+    sum = 0.0;
+    for (r=0;r<hc->nsize;r++) sum += hc->shm[(size_t)r*hc->shmlen+i];
+    res[i] = sum;
+  }
+  PetscCall(BV_HierCommSync(hc));
+  if (hc->leader!=MPI_COMM_NULL) PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,res,len,MPIU_SCALAR,MPIU_SUM,hc->leader));
+  PetscCall(BV_HierCommSync(hc));
+  PetscCall(PetscArraycpy(out,res,len));
+  PetscCall(PetscLogFlops((hc->nsize-1.0)*(e-s)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*
+    Global sum of len scalars, out := sum(in)
+
+    With hierarchical reduction, the contributions are first reduced within
+    each shared-memory node, then among the nodes (one process per node), and
+    the result is broadcast within the node. The steps within the node are done
+    through a shared-memory window if MPI supports it
+*/
+PetscErrorCode BVAllreduceSum_Private(BV bv,PetscScalar *in,PetscScalar *out,PetscMPIInt len)
+{
+  BV_HierComm    *hc;
+
+  PetscFunctionBegin;
+  if (!bv->hierred) {
+    PetscCallMPI(MPIU_Allreduce(in,out,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(BV_GetHierComm(bv,&hc));
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  if (hc->nsize>1) {
+    PetscCall(BVAllreduceSum_Shared(hc,in,out,len));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCallMPI(MPI_Reduce(in,out,len,MPIU_SCALAR,MPIU_SUM,0,hc->node));
+  if (hc->leader!=MPI_COMM_NULL) PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,out,len,MPIU_SCALAR,MPIU_SUM,hc->leader));
+  PetscCallMPI(MPI_Bcast(out,len,MPIU_SCALAR,0,hc->node));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* number of folds of the reproducible sums, and number of real sums per scalar */
+#define BV_REPRO_FOLDS 3
+#if defined(PETSC_USE_COMPLEX)
+#define BV_REPRO_NR 2
+#else
+#define BV_REPRO_NR 1
+#endif
+
+/*
+   Extractor for a sum of N terms bounded by mx: a power of two sigma >= 2*N*mx,
+   so that the terms rounded to the grid of sigma, (sigma+t)-sigma, and all their
+   partial sums are exact, whatever the order in which they are added
+*/
+static inline PetscReal BVReproExtractor(PetscReal mx,PetscInt N)
+{
+  if (mx==0.0) return 0.0;
+  return PetscPowReal(2.0,PetscCeilReal(PetscLog2Real(mx))+PetscCeilReal(PetscLog2Real((PetscReal)PetscMax(N,1)))+2);
+}
+
+/*
+    C := A'*B computed with reproducible sums, whose result does not depend on
+    the number of processes or the order of the operations
+
+    A' is mxk (ld=lda), B is kxn (ld=ldb), C is mxn (ld=ldc). If diag is true then
+    m=n and only the diagonal is computed, in C[j], j=0..n-1
+
+    Each sum is split in BV_REPRO_FOLDS exact sums (pre-rounding, as in Demmel and
+    Nguyen), where the extractors are obtained from the maximum absolute value of
+    the terms in all processes. This requires an extra reduction, and the terms are
+    computed twice. The compiler must not reassociate floating-point operations
+*/
+PetscErrorCode BVDot_Reproducible_Private(BV bv,PetscInt m,PetscInt n,PetscInt k,const PetscScalar *A,PetscInt lda,const PetscScalar *B,PetscInt ldb,PetscBool diag,PetscScalar *C,PetscInt ldc,PetscBool mpi)
+{
+  PetscInt          e,i,j,r,f,c,ne=diag?n:m*n,ns,N;
+  PetscReal         *mx,*sg,*S,t[BV_REPRO_NR],x,q,s[BV_REPRO_NR];
+  PetscScalar       p;
+  const PetscScalar *a,*b;
+  PetscMPIInt       len;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)bv);
+
+  PetscFunctionBegin;
+  ns = BV_REPRO_NR*ne;
+  N  = mpi? bv->N: k;
+  PetscCall(PetscMalloc3(ns,&mx,BV_REPRO_FOLDS*ns,&sg,BV_REPRO_FOLDS*ns,&S));
+
+  /* first pass: maximum absolute value of the terms of each sum */
+  for (e=0;e<ne;e++) {
+    i = diag? e: e%m;
+    j = diag? e: e/m;
+    a = A+i*lda;
+    b = B+j*ldb;
+    for (c=0;c<BV_REPRO_NR;c++) mx[BV_REPRO_NR*e+c] = 0.0;
+    for (r=0;r<k;r++) {
+      p = PetscConj(a[r])*b[r];
+      mx[BV_REPRO_NR*e] = PetscMax(mx[BV_REPRO_NR*e],PetscAbsReal(PetscRealPart(p)));
+#if defined(PETSC_USE_COMPLEX)
+      mx[BV_REPRO_NR*e+1] = PetscMax(mx[BV_REPRO_NR*e+1],PetscAbsReal(PetscImaginaryPart(p)));
+#endif
+    }
+  }
+  if (mpi) {
+    PetscCall(PetscMPIIntCast(ns,&len));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,mx,len,MPIU_REAL,MPIU_MAX,comm));
+  }
+  for (e=0;e<ns;e++) {
+    sg[e] = BVReproExtractor(mx[e],N);
+    /* the remainder of each fold is at most half an ulp of its extractor */
+    for (f=1;f<BV_REPRO_FOLDS;f++) sg[f*ns+e] = BVReproExtractor(0.5*PETSC_MACHINE_EPSILON*sg[(f-1)*ns+e],N);
+  }
+
+  /* second pass: exact sums of the terms rounded to the extractors */
+  PetscCall(PetscArrayzero(S,BV_REPRO_FOLDS*ns));
+  for (e=0;e<ne;e++) {
+    i = diag? e: e%m;
+    j = diag? e: e/m;
+    a = A+i*lda;
+    b = B+j*ldb;
+    for (r=0;r<k;r++) {
+      p    = PetscConj(a[r])*b[r];
+      t[0] = PetscRealPart(p);
+#if defined(PETSC_USE_COMPLEX)
+      t[1] = PetscImaginaryPart(p);
+#endif
+      for (c=0;c<BV_REPRO_NR;c++) {
+        x = t[c];
+        for (f=0;f<BV_REPRO_FOLDS && sg[f*ns+BV_REPRO_NR*e+c]!=0.0;f++) {
+          q = (sg[f*ns+BV_REPRO_NR*e+c]+x)-sg[f*ns+BV_REPRO_NR*e+c];
+          S[f*ns+BV_REPRO_NR*e+c] += q;
+          x -= q;
+        }
+      }
+    }
+  }
+  PetscCall(PetscLogFlops((4.0+3.0*BV_REPRO_FOLDS)*BV_REPRO_NR*ne*k));
+  if (mpi) {
+    PetscCall(PetscMPIIntCast(BV_REPRO_FOLDS*ns,&len));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,S,len,MPIU_REAL,MPIU_SUM,comm));
+  }
+
+  /* add up the folds, always in the same order */
+  for (e=0;e<ne;e++) {
+    for (c=0;c<BV_REPRO_NR;c++) {
+      s[c] = 0.0;
+      for (f=BV_REPRO_FOLDS-1;f>=0;f--) s[c] += S[f*ns+BV_REPRO_NR*e+c];
+    }
+#if defined(PETSC_USE_COMPLEX)
+    p = PetscCMPLX(s[0],s[1]);
+#else
+    p = s[0];
+#endif
+    if (diag) C[e] = p;
+    else C[(e%m)+(e/m)*ldc] = p;
+  }
+  PetscCall(PetscFree3(mx,sg,S));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    Zero the mxk array A (ld=lda); if threads are used, each thread zeros its own
+    range of rows, so that the pages are mapped in its NUMA domain (first-touch)
+*/
+PetscErrorCode BVFirstTouch_Private(BV bv,PetscInt m_,PetscInt k_,PetscScalar *A,PetscInt lda_)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   m,lda;
+  PetscInt       j;
+  int            nt;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,m_);
+  if (nt>1) {
+    PetscCall(PetscBLASIntCast(m_,&m));
+    PetscCall(PetscBLASIntCast(lda_,&lda));
+    #pragma omp parallel num_threads(nt) private(j)
+    {
+      PetscBLASInt rs,re;
+      int          t = omp_get_thread_num();
+
+      BV_ThreadRows(m,nt,t,&rs,&re);
+      if (t==nt-1) re = lda;
+      for (j=0;j<k_;j++) (void)PetscArrayzero(A+j*lda+rs,re-rs);
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCall(PetscArrayzero(A,k_*lda_));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
     C := alpha*A*B + beta*C
 
@@ -27,6 +373,9 @@ PetscErrorCode BVMult_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,Pet
 #if defined(PETSC_HAVE_FBLASLAPACK) || defined(PETSC_HAVE_F2CBLASLAPACK)
   PetscBLASInt   l,bs=BLOCKSIZE;
 #endif
+#if defined(PETSC_HAVE_OPENMP)
+  int            nt;
+#endif
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(m_,&m));
@@ -35,6 +384,21 @@ PetscErrorCode BVMult_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,Pet
   PetscCall(PetscBLASIntCast(lda_,&lda));
   PetscCall(PetscBLASIntCast(ldb_,&ldb));
   PetscCall(PetscBLASIntCast(ldc_,&ldc));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,m_);
+  if (nt>1) {
+    #pragma omp parallel num_threads(nt)
+    {
+      PetscBLASInt rs,re,mt;
+
+      BV_ThreadRows(m,nt,omp_get_thread_num(),&rs,&re);
+      mt = re-rs;
+      BLASgemm_("N","N",&mt,&n,&k,&alpha,(PetscScalar*)A+rs,&lda,(PetscScalar*)B,&ldb,&beta,C+rs,&ldc);
+    }
+    PetscCall(PetscLogFlops(2.0*m*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
 #if defined(PETSC_HAVE_FBLASLAPACK) || defined(PETSC_HAVE_F2CBLASLAPACK)
   l = m % bs;
   if (l) PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&l,&n,&k,&alpha,(PetscScalar*)A,&lda,(PetscScalar*)B,&ldb,&beta,C,&ldc));
@@ -56,27 +420,81 @@ PetscErrorCode BVMult_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,Pet
 PetscErrorCode BVMultVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar alpha,const PetscScalar *A,PetscInt lda_,const PetscScalar *x,PetscScalar beta,PetscScalar *y)
 {
   PetscBLASInt   n,k,lda,one=1;
+#if defined(PETSC_HAVE_OPENMP)
+  int            nt;
+#endif
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(n_,&n));
   PetscCall(PetscBLASIntCast(k_,&k));
   PetscCall(PetscBLASIntCast(lda_,&lda));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,n_);
+  if (nt>1) {
+    #pragma omp parallel num_threads(nt)
+    {
+      PetscBLASInt rs,re,nr;
+
+      BV_ThreadRows(n,nt,omp_get_thread_num(),&rs,&re);
+      nr = re-rs;
+      BLASgemv_("N",&nr,&k,&alpha,A+rs,&lda,x,&one,&beta,y+rs,&one);
+    }
+    PetscCall(PetscLogFlops(2.0*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (n) PetscCallBLAS("BLASgemv",BLASgemv_("N",&n,&k,&alpha,A,&lda,x,&one,&beta,y,&one));
   PetscCall(PetscLogFlops(2.0*n*k));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* candidate row block sizes tried when tuning BVMultInPlace_BLAS_Private() */
+#define BV_TILE_NCAND 5
+static const PetscBLASInt BVTileRows[BV_TILE_NCAND] = {32,64,128,256,512};
+/* the block size is tuned only for problems with at least these rows and columns */
+#define BV_TILE_MINROWS 8192
+#define BV_TILE_MINCOLS 64
+/* size in bytes of the tile of B that is swept for each row block */
+#define BV_TILE_CACHE 524288
+
+/*
+    W := A(l:l+bs-1,:)*B(:,s:e-1), computed by tiles of nb columns of B
+
+    A is bsxk (ld=lda), B is kxn (ld=ldb, starting at column s), W is bsxn (ld=bs)
+*/
+static inline void BVMultInPlace_RowBlock(PetscBLASInt bs,PetscBLASInt n,PetscBLASInt k,PetscBLASInt nb,const char *bt,PetscBool btrans,PetscScalar *A,PetscBLASInt lda,PetscScalar *pb,PetscBLASInt ldb,PetscScalar *W)
+{
+  PetscScalar  zero=0.0,one=1.0;
+  PetscBLASInt c,nc;
+
+  for (c=0;c<n;c+=nb) {
+    nc = PetscMin(nb,n-c);
+    BLASgemm_("N",bt,&bs,&nc,&k,&one,A,&lda,btrans?pb+c:pb+c*ldb,&ldb,&zero,W+c*bs,&bs);
+  }
+}
+
 /*
     A(:,s:e-1) := A*B(:,s:e-1)
 
     A is mxk (ld=lda), B is kxn (ld=ldb), n=e-s
+
+    The rows of A are processed in blocks of bs rows, and for each block the
+    columns of B are swept in tiles that fit in cache. The block size bs is
+    tuned the first time the kernel is applied to a large enough BV, by timing
+    the candidate sizes on the first row blocks of the actual computation,
+    and is then kept in the BV (and inherited by its duplicates). If threads
+    are used, each thread processes the row blocks of its own range of rows.
 */
 PetscErrorCode BVMultInPlace_BLAS_Private(BV bv,PetscInt m_,PetscInt k_,PetscInt s,PetscInt e,PetscScalar *A,PetscInt lda_,const PetscScalar *B,PetscInt ldb_,PetscBool btrans)
 {
-  PetscScalar    *pb,zero=0.0,one=1.0;
-  PetscBLASInt   m,n,k,l,lda,ldb,bs=BLOCKSIZE;
+  PetscScalar    *pb;
+  PetscBLASInt   m,n,k,l,r,lda,ldb,bs,nb,i;
   PetscInt       j,n_=e-s;
+  PetscLogDouble t0,t1,tbest=0.0;
   const char     *bt;
+#if defined(PETSC_HAVE_OPENMP)
+  int            nt;
+#endif
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(m_,&m));
@@ -84,7 +502,6 @@ PetscErrorCode BVMultInPlace_BLAS_Private(BV bv,PetscInt m_,PetscInt k_,PetscInt
   PetscCall(PetscBLASIntCast(k_,&k));
   PetscCall(PetscBLASIntCast(lda_,&lda));
   PetscCall(PetscBLASIntCast(ldb_,&ldb));
-  PetscCall(BVAllocateWork_Private(bv,BLOCKSIZE*n_));
   if (PetscUnlikely(btrans)) {
     pb = (PetscScalar*)B+s;
     bt = "C";
@@ -92,13 +509,58 @@ PetscErrorCode BVMultInPlace_BLAS_Private(BV bv,PetscInt m_,PetscInt k_,PetscInt
     pb = (PetscScalar*)B+s*ldb;
     bt = "N";
   }
-  l = m % bs;
-  if (l) {
-    PetscCallBLAS("BLASgemm",BLASgemm_("N",bt,&l,&n,&k,&one,A,&lda,pb,&ldb,&zero,bv->work,&l));
-    for (j=0;j<n;j++) PetscCall(PetscArraycpy(A+(s+j)*lda,bv->work+j*l,l));
+  PetscCall(PetscBLASIntCast(PetscMax(16,BV_TILE_CACHE/(PetscMax(1,k_)*(PetscInt)sizeof(PetscScalar))),&nb));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,m_);
+  if (nt>1) {
+    bs = bv->tilebs? (PetscBLASInt)bv->tilebs: BLOCKSIZE;
+    PetscCall(BVAllocateWork_Private(bv,nt*bs*n_));
+    #pragma omp parallel num_threads(nt) private(j)
+    {
+      PetscBLASInt rs,re,r,nr;
+      int          t = omp_get_thread_num();
+      PetscScalar  *W = bv->work+t*bs*n_;
+
+      BV_ThreadRows(m,nt,t,&rs,&re);
+      for (r=rs;r<re;r+=nr) {
+        nr = PetscMin(bs,re-r);
+        BVMultInPlace_RowBlock(nr,n,k,nb,bt,btrans,A+r,lda,pb,ldb,W);
+        for (j=0;j<n;j++) (void)PetscArraycpy(A+(s+j)*lda+r,W+j*nr,nr);
+      }
+    }
+    PetscCall(PetscLogFlops(2.0*m*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  l = 0;
+  if (!bv->tilebs && m>=BV_TILE_MINROWS && k>=BV_TILE_MINCOLS) {
+    /* process the first row blocks with each candidate size and keep the fastest */
+    PetscCall(BVAllocateWork_Private(bv,BVTileRows[BV_TILE_NCAND-1]*n_));
+    for (i=0;i<BV_TILE_NCAND;i++) {
+      bs = BVTileRows[i];
+      PetscCall(PetscTime(&t0));
+      PetscCallBLAS("BLASgemm",BVMultInPlace_RowBlock(bs,n,k,nb,bt,btrans,A+l,lda,pb,ldb,bv->work));
+      for (j=0;j<n;j++) PetscCall(PetscArraycpy(A+(s+j)*lda+l,bv->work+j*bs,bs));
+      PetscCall(PetscTime(&t1));
+      if (!i || (t1-t0)/bs<tbest) {
+        tbest = (t1-t0)/bs;
+        bv->tilebs = bs;
+      }
+      l += bs;
+    }
+    PetscCall(PetscInfo(bv,"Tuned row block size of BVMultInPlace: %" PetscInt_FMT "\n",bv->tilebs));
+  }
+  bs = bv->tilebs? (PetscBLASInt)bv->tilebs: BLOCKSIZE;
+  r = (m-l) % bs;
+  if (r) {
+    PetscCall(BVAllocateWork_Private(bv,r*n_));
+    PetscCallBLAS("BLASgemm",BVMultInPlace_RowBlock(r,n,k,nb,bt,btrans,A+l,lda,pb,ldb,bv->work));
+    for (j=0;j<n;j++) PetscCall(PetscArraycpy(A+(s+j)*lda+l,bv->work+j*r,r));
+    l += r;
   }
+  PetscCall(BVAllocateWork_Private(bv,bs*n_));
   for (;l<m;l+=bs) {
-    PetscCallBLAS("BLASgemm",BLASgemm_("N",bt,&bs,&n,&k,&one,A+l,&lda,pb,&ldb,&zero,bv->work,&bs));
+    PetscCallBLAS("BLASgemm",BVMultInPlace_RowBlock(bs,n,k,nb,bt,btrans,A+l,lda,pb,ldb,bv->work));
     for (j=0;j<n;j++) PetscCall(PetscArraycpy(A+(s+j)*lda+l,bv->work+j*bs,bs));
   }
   PetscCall(PetscLogFlops(2.0*m*n*k));
@@ -117,15 +579,46 @@ PetscErrorCode BVMultInPlace_Vecs_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt
   PetscBLASInt      m = 0,n,k,l,bs=BLOCKSIZE;
   PetscInt          j;
   const char        *bt;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscScalar       **pv;
+  int               nt;
+#endif
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(m_,&m));
   PetscCall(PetscBLASIntCast(n_,&n));
   PetscCall(PetscBLASIntCast(k_,&k));
-  PetscCall(BVAllocateWork_Private(bv,2*BLOCKSIZE*n_));
-  out = bv->work+BLOCKSIZE*n_;
   if (btrans) bt = "C";
   else bt = "N";
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,m_);
+  if (nt>1) {
+    /* get all arrays first, then each thread processes the blocks of its range of rows */
+    PetscCall(PetscMalloc1(n_,&pv));
+    for (j=0;j<n;j++) PetscCall(VecGetArray(V[j],&pv[j]));
+    PetscCall(BVAllocateWork_Private(bv,2*nt*BLOCKSIZE*n_));
+    #pragma omp parallel num_threads(nt) private(j)
+    {
+      PetscBLASInt rs,re,r,nr;
+      int          t = omp_get_thread_num();
+      PetscScalar  *win = bv->work+2*t*BLOCKSIZE*n_,*wout = win+BLOCKSIZE*n_;
+
+      BV_ThreadRows(m,nt,t,&rs,&re);
+      for (r=rs;r<re;r+=nr) {
+        nr = PetscMin(bs,re-r);
+        for (j=0;j<n;j++) (void)PetscArraycpy(win+j*nr,pv[j]+r,nr);
+        BLASgemm_("N",bt,&nr,&n,&n,&one,win,&nr,(PetscScalar*)B,&k,&zero,wout,&nr);
+        for (j=0;j<n;j++) (void)PetscArraycpy(pv[j]+r,wout+j*nr,nr);
+      }
+    }
+    for (j=0;j<n;j++) PetscCall(VecRestoreArray(V[j],&pv[j]));
+    PetscCall(PetscFree(pv));
+    PetscCall(PetscLogFlops(2.0*n*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCall(BVAllocateWork_Private(bv,2*BLOCKSIZE*n_));
+  out = bv->work+BLOCKSIZE*n_;
   l = m % bs;
   if (l) {
     for (j=0;j<n;j++) {
@@ -166,8 +659,30 @@ PetscErrorCode BVAXPY_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar alp
 {
   PetscBLASInt   m,one=1;
   PetscInt       i,j;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscBLASInt   n;
+  int            nt;
+#endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,n_);
+  if (nt>1) {
+    PetscCall(PetscBLASIntCast(n_,&n));
+    #pragma omp parallel num_threads(nt) private(i,j)
+    {
+      PetscBLASInt rs,re;
+
+      BV_ThreadRows(n,nt,omp_get_thread_num(),&rs,&re);
+      for (j=0;j<k_;j++) {
+        if (beta!=(PetscScalar)1.0) for (i=rs;i<re;i++) B[i+j*ldb_] = alpha*A[i+j*lda_] + beta*B[i+j*ldb_];
+        else for (i=rs;i<re;i++) B[i+j*ldb_] += alpha*A[i+j*lda_];
+      }
+    }
+    PetscCall(PetscLogFlops((beta==(PetscScalar)1.0)?2.0*n_*k_:3.0*n_*k_));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (lda_==n_ && ldb_==n_) {
     PetscCall(PetscBLASIntCast(n_*k_,&m));
     if (beta!=(PetscScalar)1.0) PetscCallBLAS("BLASscal",BLASscal_(&m,&beta,B,&one));
@@ -191,38 +706,136 @@ PetscErrorCode BVAXPY_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,PetscScalar alp
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    C := A'*A, computing (and reducing) only the upper triangle
+
+    A is kxn (ld=lda), C is nxn (ld=ldc)
+*/
+static PetscErrorCode BVDotHermitian_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,const PetscScalar *A,PetscInt lda_,PetscScalar *C,PetscInt ldc_,PetscBool mpi)
+{
+  PetscReal      rone=1.0,rzero=0.0;
+  PetscScalar    *W,*P;
+  PetscBLASInt   n,k,lda,ldc;
+  PetscInt       i,j,p,nn=n_*n_,np=n_*(n_+1)/2;
+  PetscMPIInt    len;
+  int            nt=1;
+#if defined(PETSC_HAVE_OPENMP)
+  int            t;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(n_,&n));
+  PetscCall(PetscBLASIntCast(k_,&k));
+  PetscCall(PetscBLASIntCast(lda_,&lda));
+  PetscCall(PetscBLASIntCast(ldc_,&ldc));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,k_);
+#endif
+  if (nt>1 || mpi) {
+    /* local result in W (one for each thread), packed upper triangle in P */
+    PetscCall(BVAllocateWork_Private(bv,nt*nn+2*np));
+    W = bv->work;
+    P = W+nt*nn;
+    if (nt>1) {
+#if defined(PETSC_HAVE_OPENMP)
+      #pragma omp parallel num_threads(nt)
+      {
+        PetscBLASInt rs,re,kt;
+        int          tid = omp_get_thread_num();
+
+        BV_ThreadRows(k,nt,tid,&rs,&re);
+        kt = re-rs;
+        BLASherk_("U","C",&n,&kt,&rone,(PetscScalar*)A+rs,&lda,&rzero,W+tid*nn,&n);
+      }
+      for (t=1;t<nt;t++) for (j=0;j<n_;j++) for (i=0;i<=j;i++) W[i+j*n_] += W[t*nn+i+j*n_];
+#endif
+    } else PetscCallBLAS("BLASherk",BLASherk_("U","C",&n,&k,&rone,(PetscScalar*)A,&lda,&rzero,W,&n));
+    for (p=0,j=0;j<n_;j++) for (i=0;i<=j;i++) P[p++] = W[i+j*n_];
+    if (mpi) {
+      PetscCall(PetscMPIIntCast(np,&len));
+      PetscCall(BVAllreduceSum_Private(bv,P,P+np,len));
+      P += np;
+    }
+    for (p=0,j=0;j<n_;j++) for (i=0;i<=j;i++) C[i+j*ldc_] = P[p++];
+  } else PetscCallBLAS("BLASherk",BLASherk_("U","C",&n,&k,&rone,(PetscScalar*)A,&lda,&rzero,C,&ldc));
+  for (j=0;j<n_;j++) for (i=j+1;i<n_;i++) C[i+j*ldc_] = PetscConj(C[j+i*ldc_]);
+  PetscCall(PetscLogFlops(1.0*n*(n+1)*k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
     C := A'*B
 
     A' is mxk (ld=lda), B is kxn (ld=ldb), C is mxn (ld=ldc)
+
+    If A and B are the same, the result is Hermitian and this is exploited
+    to halve the computation and the size of the reduction
 */
 PetscErrorCode BVDot_BLAS_Private(BV bv,PetscInt m_,PetscInt n_,PetscInt k_,const PetscScalar *A,PetscInt lda_,const PetscScalar *B,PetscInt ldb_,PetscScalar *C,PetscInt ldc_,PetscBool mpi)
 {
   PetscScalar    zero=0.0,one=1.0,*CC;
   PetscBLASInt   m,n,k,lda,ldb,ldc,j;
   PetscMPIInt    len;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscInt       i,mn=m_*n_;
+  int            nt,t;
+#endif
 
   PetscFunctionBegin;
+  if (PetscUnlikely(bv->reprored)) {
+    PetscCall(BVDot_Reproducible_Private(bv,m_,n_,k_,A,lda_,B,ldb_,PETSC_FALSE,C,ldc_,mpi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (A==B && m_==n_ && lda_==ldb_) {
+    PetscCall(BVDotHermitian_BLAS_Private(bv,n_,k_,A,lda_,C,ldc_,mpi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscBLASIntCast(m_,&m));
   PetscCall(PetscBLASIntCast(n_,&n));
   PetscCall(PetscBLASIntCast(k_,&k));
   PetscCall(PetscBLASIntCast(lda_,&lda));
   PetscCall(PetscBLASIntCast(ldb_,&ldb));
   PetscCall(PetscBLASIntCast(ldc_,&ldc));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,k_);
+  if (nt>1) {
+    /* each thread computes the contribution of its range of rows, then they are added up */
+    PetscCall(BVAllocateWork_Private(bv,(nt+1)*mn));
+    #pragma omp parallel num_threads(nt)
+    {
+      PetscBLASInt rs,re,kt;
+      int          tid = omp_get_thread_num();
+
+      BV_ThreadRows(k,nt,tid,&rs,&re);
+      kt = re-rs;
+      BLASgemm_("C","N",&m,&n,&kt,&one,(PetscScalar*)A+rs,&lda,(PetscScalar*)B+rs,&ldb,&zero,bv->work+tid*mn,&m);
+    }
+    for (t=1;t<nt;t++) for (i=0;i<mn;i++) bv->work[i] += bv->work[t*mn+i];
+    CC = bv->work;
+    if (mpi) {
+      CC = bv->work+nt*mn;
+      PetscCall(PetscMPIIntCast(mn,&len));
+      PetscCall(BVAllreduceSum_Private(bv,bv->work,CC,len));
+    }
+    for (j=0;j<n;j++) PetscCall(PetscArraycpy(C+j*ldc,CC+j*m,m));
+    PetscCall(PetscLogFlops(2.0*m*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (mpi) {
     if (ldc==m) {
       PetscCall(BVAllocateWork_Private(bv,m*n));
       if (k) PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&m,&n,&k,&one,(PetscScalar*)A,&lda,(PetscScalar*)B,&ldb,&zero,bv->work,&ldc));
       else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
-      PetscCallMPI(MPIU_Allreduce(bv->work,C,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+      PetscCall(BVAllreduceSum_Private(bv,bv->work,C,len));
     } else {
       PetscCall(BVAllocateWork_Private(bv,2*m*n));
       CC = bv->work+m*n;
       if (k) PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&m,&n,&k,&one,(PetscScalar*)A,&lda,(PetscScalar*)B,&ldb,&zero,bv->work,&m));
       else PetscCall(PetscArrayzero(bv->work,m*n));
       PetscCall(PetscMPIIntCast(m*n,&len));
-      PetscCallMPI(MPIU_Allreduce(bv->work,CC,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+      PetscCall(BVAllreduceSum_Private(bv,bv->work,CC,len));
       for (j=0;j<n;j++) PetscCall(PetscArraycpy(C+j*ldc,CC+j*m,m));
     }
   } else {
@@ -242,17 +855,47 @@ PetscErrorCode BVDotVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,const PetscSc
   PetscScalar    zero=0.0,done=1.0;
   PetscBLASInt   n,k,lda,one=1;
   PetscMPIInt    len;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscInt       i;
+  int            nt,t;
+#endif
 
   PetscFunctionBegin;
+  if (PetscUnlikely(bv->reprored)) {
+    PetscCall(BVDot_Reproducible_Private(bv,k_,1,n_,A,lda_,x,n_,PETSC_FALSE,y,k_,mpi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscBLASIntCast(n_,&n));
   PetscCall(PetscBLASIntCast(k_,&k));
   PetscCall(PetscBLASIntCast(lda_,&lda));
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,n_);
+  if (nt>1) {
+    PetscCall(BVAllocateWork_Private(bv,nt*k_));
+    #pragma omp parallel num_threads(nt)
+    {
+      PetscBLASInt rs,re,nr;
+      int          tid = omp_get_thread_num();
+
+      BV_ThreadRows(n,nt,tid,&rs,&re);
+      nr = re-rs;
+      BLASgemv_("C",&nr,&k,&done,A+rs,&lda,x+rs,&one,&zero,bv->work+tid*k_,&one);
+    }
+    for (t=1;t<nt;t++) for (i=0;i<k_;i++) bv->work[i] += bv->work[t*k_+i];
+    if (mpi) {
+      PetscCall(PetscMPIIntCast(k,&len));
+      PetscCall(BVAllreduceSum_Private(bv,bv->work,y,len));
+    } else PetscCall(PetscArraycpy(y,bv->work,k_));
+    PetscCall(PetscLogFlops(2.0*n*k));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (mpi) {
     PetscCall(BVAllocateWork_Private(bv,k));
     if (n) PetscCallBLAS("BLASgemv",BLASgemv_("C",&n,&k,&done,A,&lda,x,&one,&zero,bv->work,&one));
     else PetscCall(PetscArrayzero(bv->work,k));
     PetscCall(PetscMPIIntCast(k,&len));
-    PetscCallMPI(MPIU_Allreduce(bv->work,y,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)bv)));
+    PetscCall(BVAllreduceSum_Private(bv,bv->work,y,len));
   } else {
     if (n) PetscCallBLAS("BLASgemv",BLASgemv_("C",&n,&k,&done,A,&lda,x,&one,&zero,y,&one));
   }
@@ -266,8 +909,28 @@ PetscErrorCode BVDotVec_BLAS_Private(BV bv,PetscInt n_,PetscInt k_,const PetscSc
 PetscErrorCode BVScale_BLAS_Private(BV bv,PetscInt n_,PetscScalar *A,PetscScalar alpha)
 {
   PetscBLASInt   n,one=1;
+#if defined(PETSC_HAVE_OPENMP)
+  int            nt;
+#endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = BV_NumThreads(bv,n_);
+  if (nt>1 && alpha!=(PetscScalar)1.0) {
+    PetscCall(PetscBLASIntCast(n_,&n));
+    #pragma omp parallel num_threads(nt)
+    {
+      PetscBLASInt rs,re,nr;
+
+      BV_ThreadRows(n,nt,omp_get_thread_num(),&rs,&re);
+      nr = re-rs;
+      if (alpha == (PetscScalar)0.0) (void)PetscArrayzero(A+rs,nr);
+      else BLASscal_(&nr,&alpha,A+rs,&one);
+    }
+    if (alpha!=(PetscScalar)0.0) PetscCall(PetscLogFlops(1.0*n));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (PetscUnlikely(alpha == (PetscScalar)0.0)) PetscCall(PetscArrayzero(A,n_));
   else if (alpha!=(PetscScalar)1.0) {
     PetscCall(PetscBLASIntCast(n_,&n));
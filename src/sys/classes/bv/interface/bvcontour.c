@@ -236,6 +236,126 @@ PetscErrorCode BVDotQuadrature(BV Y,BV V,PetscScalar *Mu,PetscInt M,PetscInt L,P
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   BVSumQuadratureAdd - Adds to the sum of terms of the quadrature rule the
+   contribution of one integration point.
+
+   Collective
+
+   Input Parameters:
++  Y  - basis vectors with the solutions at the integration point
+.  M  - number of moments
+.  L  - block size
+.  w  - quadrature weight of the integration point
+-  zn - normalized quadrature point
+
+   Output Parameter:
+.  S  - basis vectors where the sum is accumulated
+
+   Notes:
+   The active columns of Y must be the L columns of the panel of one integration
+   point j. The function computes S_k = S_k + w_j*zn_j^k*Y_j for each of the M
+   panels of L columns of S. Calling it for every integration point, with S
+   initially zero, gives the same result as BVSumQuadrature(), but the panel
+   Y_j can be discarded right after the call, so only L vectors are needed to
+   hold the solutions instead of L*npoints.
+
+   S and Y must have the same parallel layout, so when using subcommunicators
+   S is a basis in the subcommunicator, and the result must be combined with
+   the other subcommunicators afterwards. Similarly, if conjugate points are
+   used the real part must be taken afterwards.
+
+   Level: developer
+
+.seealso: BVSumQuadrature(), BVDotQuadratureAdd()
+@*/
+PetscErrorCode BVSumQuadratureAdd(BV S,BV Y,PetscInt M,PetscInt L,PetscScalar w,PetscScalar zn)
+{
+  PetscInt    k,l,m;
+  PetscScalar alpha=w;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(S,BV_CLASSID,1);
+  PetscValidHeaderSpecific(Y,BV_CLASSID,2);
+  PetscValidLogicalCollectiveInt(S,M,3);
+  PetscValidLogicalCollectiveInt(S,L,4);
+  PetscCheck(Y->k-Y->l==L,PetscObjectComm((PetscObject)Y),PETSC_ERR_ARG_SIZ,"Y must have %" PetscInt_FMT " active columns",L);
+
+  PetscCall(BVGetActiveColumns(S,&l,&m));
+  for (k=0;k<M;k++) {
+    PetscCall(BVSetActiveColumns(S,k*L,(k+1)*L));
+    PetscCall(BVMult(S,alpha,1.0,Y,NULL));
+    alpha *= zn;
+  }
+  PetscCall(BVSetActiveColumns(S,l,m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVDotQuadratureAdd - Adds to the projection terms of the quadrature rule
+   the contribution of one integration point.
+
+   Collective
+
+   Input Parameters:
++  Y       - basis vectors with the solutions at the integration point
+.  V       - second basis vectors
+.  M       - number of moments
+.  L       - block size
+.  w       - quadrature weight of the integration point
+.  zn      - normalized quadrature point
+-  useconj - whether conjugate points can be used or not
+
+   Output Parameter:
+.  Mu      - array where the result is accumulated
+
+   Notes:
+   The active columns of Y must be the L columns of the panel of one integration
+   point j. The function computes Mu_k = Mu_k + w_j*zn_j^k*V'*Y_j for each of
+   the 2*M blocks of size LxL of Mu, with the same layout as in BVDotQuadrature().
+   Calling it for every integration point, with Mu initially zero, allows
+   discarding each panel Y_j right after the call.
+
+   No reduction is done, so when using subcommunicators all processes of a
+   subcommunicator obtain the contribution of its integration points, and
+   the result must be combined with the other subcommunicators afterwards.
+
+   Level: developer
+
+.seealso: BVDotQuadrature(), BVSumQuadratureAdd()
+@*/
+PetscErrorCode BVDotQuadratureAdd(BV Y,BV V,PetscScalar *Mu,PetscInt M,PetscInt L,PetscScalar w,PetscScalar zn,PetscBool useconj)
+{
+  PetscInt          j,k,s;
+  PetscScalar       alp=w;
+  Mat               H;
+  const PetscScalar *pH;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(Y,BV_CLASSID,1);
+  PetscValidHeaderSpecific(V,BV_CLASSID,2);
+  PetscValidLogicalCollectiveInt(Y,M,4);
+  PetscValidLogicalCollectiveInt(Y,L,5);
+  PetscCheck(Y->k-Y->l==L,PetscObjectComm((PetscObject)Y),PETSC_ERR_ARG_SIZ,"Y must have %" PetscInt_FMT " active columns",L);
+
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,L,Y->k,NULL,&H));  /* only the last L columns are computed */
+  PetscCall(BVSetActiveColumns(V,0,L));
+  PetscCall(BVDot(Y,V,H));
+  PetscCall(MatDenseGetArrayRead(H,&pH));
+  for (k=0;k<2*M;k++) {
+    for (j=0;j<L;j++) {
+      for (s=0;s<L;s++) {
+        if (!useconj) Mu[s+(j+k*L)*L] += alp*pH[s+(Y->l+j)*L];
+        else Mu[s+(j+k*L)*L] += 2.0*PetscRealPart(alp*pH[s+(Y->l+j)*L]);
+      }
+    }
+    alp *= zn;
+  }
+  PetscCall(MatDenseRestoreArrayRead(H,&pH));
+  PetscCall(MatDestroy(&H));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    BVTraceQuadrature - Computes an estimate of the number of eigenvalues
    inside a region via quantities computed in the quadrature rule of
@@ -497,6 +617,117 @@ static PetscErrorCode BVSVDAndRank_QR_CAA(BV S,PetscInt M,PetscInt L,PetscReal d
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Randomized range finder: the range of S is approximated by an orthonormal basis Q of
+   the sketch S*Omega, obtained from the eigendecomposition of its Gram matrix so that the
+   directions of negligible singular values are discarded. Then S is approximated as
+   Q*(Q'*S), and the SVD of the small matrix Q'*S gives the singular values. The size of
+   the sketch starts at a fraction of the number of columns and is doubled while the
+   sketch does not reveal a rank deficiency
+*/
+static PetscErrorCode BVSVDAndRank_Random(BV S,PetscInt L,PetscReal delta,PetscReal *sigma,PetscInt *rank)
+{
+  PetscInt       i,j,k,r,ml=S->k;
+  PetscBLASInt   m,n,lda,ldu=1,ldvt=1,lwork,info;
+  PetscMPIInt    len;
+  PetscScalar    *work,*pG,*pB;
+  PetscReal      *lambda;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal      *rwork;
+#endif
+  PetscBool      indef;
+  PetscRandom    rand;
+  Mat            Omega,G,B,U,Bmat;
+  BV             Y;
+
+  PetscFunctionBegin;
+  PetscCall(BVGetMatrix(S,&Bmat,&indef));  /* the SVD is computed in the standard inner product */
+  if (Bmat) PetscCall(PetscObjectReference((PetscObject)Bmat));
+  PetscCall(BVSetMatrix(S,NULL,PETSC_FALSE));
+  PetscCall(BVGetRandomContext(S,&rand));
+  PetscCall(PetscMalloc2(5*ml,&work,ml,&lambda));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc1(5*ml,&rwork));
+#endif
+  lwork = 5*ml;
+  k = PetscMin(ml,PetscMax(L,ml/4));
+  while (PETSC_TRUE) {
+    /* sketch Y = S*Omega and its orthonormal basis Y(:,0:r) */
+    PetscCall(BVDuplicateResize(S,k,&Y));
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,ml,k,NULL,&Omega));
+    PetscCall(MatSetRandom(Omega,rand));
+    PetscCall(MatDenseGetArray(Omega,&pG));  /* all processes must use the same test matrix */
+    PetscCall(PetscMPIIntCast(ml*k,&len));
+    PetscCallMPI(MPI_Bcast(pG,len,MPIU_SCALAR,0,PetscObjectComm((PetscObject)S)));
+    PetscCall(MatDenseRestoreArray(Omega,&pG));
+    PetscCall(BVMult(Y,1.0,0.0,S,Omega));
+    PetscCall(MatDestroy(&Omega));
+    PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&G));
+    PetscCall(BVDot(Y,Y,G));
+    PetscCall(MatDenseGetArray(G,&pG));
+    PetscCall(PetscBLASIntCast(k,&m));
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("O","N",&m,&m,pG,&m,lambda,NULL,&ldu,NULL,&ldvt,work,&lwork,rwork,&info));
+#else
+    PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("O","N",&m,&m,pG,&m,lambda,NULL,&ldu,NULL,&ldvt,work,&lwork,&info));
+#endif
+    SlepcCheckLapackInfo("gesvd",info);
+    PetscCall(PetscFPTrapPop());
+    for (r=0;r<k && lambda[r]>k*PETSC_MACHINE_EPSILON*lambda[0];r++) {
+      for (j=0;j<k;j++) pG[j+r*k] /= PetscSqrtReal(lambda[r]);
+    }
+    PetscCall(MatDenseRestoreArray(G,&pG));
+    if (r<k || k==ml) break;
+    PetscCall(MatDestroy(&G));
+    PetscCall(BVDestroy(&Y));
+    k = PetscMin(2*k,ml);  /* the rank may be larger than the sketch */
+  }
+  if (!r) r = 1;  /* S is zero */
+  PetscCall(BVSetActiveColumns(Y,0,k));
+  PetscCall(BVMultInPlace(Y,G,0,r));
+  PetscCall(MatDestroy(&G));
+
+  /* SVD of B = Q'*S, then S(:,0:r) = Q*U */
+  PetscCall(BVSetActiveColumns(Y,0,r));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,r,ml,NULL,&B));
+  PetscCall(BVDot(S,Y,B));
+  PetscCall(MatDenseGetArray(B,&pB));
+  PetscCall(PetscBLASIntCast(r,&m));
+  PetscCall(PetscBLASIntCast(ml,&n));
+  lda = m;
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("O","N",&m,&n,pB,&lda,sigma,NULL,&ldu,NULL,&ldvt,work,&lwork,rwork,&info));
+#else
+  PetscCallBLAS("LAPACKgesvd",LAPACKgesvd_("O","N",&m,&n,pB,&lda,sigma,NULL,&ldu,NULL,&ldvt,work,&lwork,&info));
+#endif
+  SlepcCheckLapackInfo("gesvd",info);
+  PetscCall(PetscFPTrapPop());
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,r,r,pB,&U));
+  PetscCall(BVMultInPlace(Y,U,0,r));
+  PetscCall(MatDestroy(&U));
+  PetscCall(MatDenseRestoreArray(B,&pB));
+  PetscCall(MatDestroy(&B));
+  PetscCall(BVSetActiveColumns(S,0,r));
+  PetscCall(BVCopy(Y,S));
+  PetscCall(BVSetActiveColumns(S,0,ml));
+  PetscCall(BVDestroy(&Y));
+  for (i=r;i<ml;i++) sigma[i] = 0.0;
+
+  *rank = 0;
+  for (i=0;i<r;i++) {
+    if (sigma[i]/PetscMax(sigma[0],1.0)>delta) (*rank)++;
+  }
+  PetscCall(BVSetMatrix(S,Bmat,indef));
+  PetscCall(MatDestroy(&Bmat));
+  PetscCall(PetscFree2(work,lambda));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscFree(rwork));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    BVSVDAndRank - Compute the SVD (left singular vectors only, and singular
    values) and determine the numerical rank according to a tolerance.
@@ -524,7 +755,12 @@ static PetscErrorCode BVSVDAndRank_QR_CAA(BV S,PetscInt M,PetscInt L,PetscReal d
    integral methods. All columns up to m*l are modified, and the active
    columns are set to 0..m*l.
 
-   The method is one of BV_SVD_METHOD_REFINE, BV_SVD_METHOD_QR, BV_SVD_METHOD_QR_CAA.
+   The method is one of BV_SVD_METHOD_REFINE, BV_SVD_METHOD_QR, BV_SVD_METHOD_QR_CAA,
+   BV_SVD_METHOD_RANDOM. The latter uses a randomized range finder, whose cost is
+   proportional to the numerical rank instead of m*l, so it is cheaper when the
+   rank is clearly smaller than m*l. In this case, only the first columns of S,
+   as many as the detected rank, contain left singular vectors, and the singular
+   values beyond the size of the sketch are set to zero.
 
    The A workspace should be m*l*m*l in size.
 
@@ -560,6 +796,9 @@ PetscErrorCode BVSVDAndRank(BV S,PetscInt m,PetscInt l,PetscReal delta,BVSVDMeth
     case BV_SVD_METHOD_QR_CAA:
       PetscCall(BVSVDAndRank_QR_CAA(S,m,l,delta,A,sigma,rank));
       break;
+    case BV_SVD_METHOD_RANDOM:
+      PetscCall(BVSVDAndRank_Random(S,l,delta,sigma,rank));
+      break;
   }
   PetscCall(PetscLogEventEnd(BV_SVDAndRank,S,0,0,0));
   PetscFunctionReturn(PETSC_SUCCESS);
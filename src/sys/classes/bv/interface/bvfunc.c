@@ -18,11 +18,11 @@ PetscLogEvent    BV_Create = 0,BV_Copy = 0,BV_Mult = 0,BV_MultVec = 0,BV_MultInP
 static PetscBool BVPackageInitialized = PETSC_FALSE;
 MPI_Op MPIU_TSQR = 0,MPIU_LAPY2;
 
-const char *BVOrthogTypes[] = {"CGS","MGS","BVOrthogType","BV_ORTHOG_",NULL};
+const char *BVOrthogTypes[] = {"CGS","MGS","CGS_PIPELINED","RGS","DCGS2","BVOrthogType","BV_ORTHOG_",NULL};
 const char *BVOrthogRefineTypes[] = {"IFNEEDED","NEVER","ALWAYS","BVOrthogRefineType","BV_ORTHOG_REFINE_",NULL};
-const char *BVOrthogBlockTypes[] = {"GS","CHOL","TSQR","TSQRCHOL","SVQB","BVOrthogBlockType","BV_ORTHOG_BLOCK_",NULL};
+const char *BVOrthogBlockTypes[] = {"GS","CHOL","TSQR","TSQRCHOL","SVQB","CHOLQR2","SCHOLQR3","BVOrthogBlockType","BV_ORTHOG_BLOCK_",NULL};
 const char *BVMatMultTypes[] = {"VECS","MAT","MAT_SAVE","BVMatMultType","BV_MATMULT_",NULL};
-const char *BVSVDMethods[] = {"REFINE","QR","QR_CAA","BVSVDMethod","BV_SVD_METHOD_",NULL};
+const char *BVSVDMethods[] = {"REFINE","QR","QR_CAA","RANDOM","BVSVDMethod","BV_SVD_METHOD_",NULL};
 
 /*@C
    BVFinalizePackage - This function destroys everything in the Slepc interface
@@ -127,9 +127,11 @@ PetscErrorCode BVDestroy(BV *bv)
   PetscCall(VecDestroy(&(*bv)->Bx));
   PetscCall(VecDestroy(&(*bv)->buffer));
   PetscCall(BVDestroy(&(*bv)->cached));
+  PetscCall(BVDestroy(&(*bv)->cnstr));
   PetscCall(BVDestroy(&(*bv)->L));
   PetscCall(BVDestroy(&(*bv)->R));
   PetscCall(PetscFree((*bv)->work));
+  PetscCall(PetscFree((*bv)->sketch));
   PetscCall(PetscFree2((*bv)->h,(*bv)->c));
   PetscCall(VecDestroy(&(*bv)->omega));
   PetscCall(MatDestroy(&(*bv)->Acreate));
@@ -182,6 +184,7 @@ PetscErrorCode BVCreate(MPI_Comm comm,BV *newbv)
   bv->vmm          = BV_MATMULT_MAT;
   bv->rrandom      = PETSC_FALSE;
   bv->deftol       = 10*PETSC_MACHINE_EPSILON;
+  bv->sstep        = 1;
 
   bv->buffer       = NULL;
   bv->Abuffer      = NULL;
@@ -201,6 +204,7 @@ PetscErrorCode BVCreate(MPI_Comm comm,BV *newbv)
   bv->omega        = NULL;
   bv->defersfo     = PETSC_FALSE;
   bv->cached       = NULL;
+  bv->cnstr        = NULL;
   bv->bvstate      = 0;
   bv->L            = NULL;
   bv->R            = NULL;
@@ -212,9 +216,20 @@ PetscErrorCode BVCreate(MPI_Comm comm,BV *newbv)
   bv->rand         = NULL;
   bv->Acreate      = NULL;
   bv->Aget         = NULL;
+  bv->mmid         = 0;
+  bv->mmstate      = 0;
   bv->cuda         = PETSC_FALSE;
   bv->hip          = PETSC_FALSE;
   bv->sfocalled    = PETSC_FALSE;
+  bv->sketch       = NULL;
+  bv->nsketch      = 0;
+  bv->sketchk      = 0;
+  bv->sketchstate  = 0;
+  bv->tilebs       = 0;
+  bv->nthreads     = 1;
+  bv->hierred      = PETSC_FALSE;
+  bv->reprored     = PETSC_FALSE;
+  bv->deviceonly   = PETSC_FALSE;
   bv->work         = NULL;
   bv->lwork        = 0;
   bv->data         = NULL;
@@ -430,6 +445,7 @@ PetscErrorCode BVInsertConstraints(BV V,PetscInt *nc,Vec *C)
   msave = V->m;
   PetscCall(BVResize(V,*nc+V->m,PETSC_FALSE));
   PetscCall(BVInsertVecs(V,0,nc,C,PETSC_TRUE));
+  PetscCall(BVDestroy(&V->cnstr));
   V->nc = *nc;
   V->m  = msave;
   V->ci[0] = -V->nc-1;
@@ -549,7 +565,7 @@ PetscErrorCode BVView(BV bv,PetscViewer viewer)
 {
   PetscBool         isascii;
   PetscViewerFormat format;
-  const char        *orthname[2] = {"classical","modified"};
+  const char        *orthname[5] = {"classical","modified","pipelined classical","randomized","delayed classical"};
   const char        *refname[3] = {"if needed","never","always"};
 
   PetscFunctionBegin;
@@ -597,6 +613,11 @@ PetscErrorCode BVView(BV bv,PetscViewer viewer)
           PetscCall(PetscViewerASCIIPrintf(viewer,"  mat_save is deprecated, use mat\n"));
           break;
       }
+      if (bv->sstep>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  s-step Krylov expansion with s=%" PetscInt_FMT "\n",bv->sstep));
+      if (bv->nthreads>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  using %" PetscInt_FMT " threads in local operations\n",bv->nthreads));
+      if (bv->hierred) PetscCall(PetscViewerASCIIPrintf(viewer,"  using hierarchical (intra-node and inter-node) reductions\n"));
+      if (bv->reprored) PetscCall(PetscViewerASCIIPrintf(viewer,"  using reproducible reductions, independent of the number of processes\n"));
+      if (bv->deviceonly && (bv->cuda || bv->hip)) PetscCall(PetscViewerASCIIPrintf(viewer,"  data is not accessed on the host (device-only)\n"));
       if (bv->rrandom) PetscCall(PetscViewerASCIIPrintf(viewer,"  generating random vectors independent of the number of processes\n"));
     }
   }
@@ -626,6 +647,49 @@ PetscErrorCode BVViewFromOptions(BV bv,PetscObject obj,const char name[])
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   BVViewColumns_Private - Writes columns l:k-1 of the BV to a binary viewer,
+   preceded by the number of columns.
+
+   The columns are written one at a time with VecView(), so parallel MPI-IO
+   is used if it has been enabled in the viewer (-viewer_binary_mpiio).
+*/
+PetscErrorCode BVViewColumns_Private(BV bv,PetscInt l,PetscInt k,PetscViewer viewer)
+{
+  PetscInt       j,nc=k-l;
+  Vec            v;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryWrite(viewer,&nc,1,PETSC_INT));
+  for (j=l;j<k;j++) {
+    PetscCall(BVGetColumn(bv,j,&v));
+    PetscCall(VecView(v,viewer));
+    PetscCall(BVRestoreColumn(bv,j,&v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   BVLoadColumns_Private - Reads columns l:k-1 of the BV from a binary viewer,
+   as written by BVViewColumns_Private().
+*/
+PetscErrorCode BVLoadColumns_Private(BV bv,PetscInt l,PetscInt k,PetscViewer viewer)
+{
+  PetscInt       j,nc;
+  Vec            w;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryRead(viewer,&nc,1,NULL,PETSC_INT));
+  PetscCheck(nc==k-l,PetscObjectComm((PetscObject)bv),PETSC_ERR_FILE_UNEXPECTED,"The file contains %" PetscInt_FMT " columns, but %" PetscInt_FMT " were expected",nc,k-l);
+  PetscCall(BVCreateVec(bv,&w));
+  for (j=l;j<k;j++) {
+    PetscCall(VecLoad(w,viewer));
+    PetscCall(BVInsertVec(bv,j,w));
+  }
+  PetscCall(VecDestroy(&w));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    BVRegister - Adds a new storage format to the BV package.
 
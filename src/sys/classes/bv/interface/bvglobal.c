@@ -201,6 +201,7 @@ PetscErrorCode BVDotVecBegin(BV X,Vec y,PetscScalar *m)
 
   PetscCall(VecGetLocalSize(y,&n));
   PetscCheck(X->n==n,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_INCOMP,"Mismatching local dimension X %" PetscInt_FMT ", y %" PetscInt_FMT,X->n,n);
+  if (PetscUnlikely(X->reprored)) PetscFunctionReturn(PETSC_SUCCESS);  /* computed in BVDotVecEnd() */
 
   if (X->ops->dotvec_begin) PetscUseTypeMethod(X,dotvec_begin,y,m);
   else {
@@ -248,7 +249,8 @@ PetscErrorCode BVDotVecEnd(BV X,Vec y,PetscScalar *m)
   PetscValidType(X,1);
   BVCheckSizes(X,1);
 
-  if (X->ops->dotvec_end) PetscUseTypeMethod(X,dotvec_end,y,m);
+  if (PetscUnlikely(X->reprored)) PetscCall(BVDotVec(X,y,m));
+  else if (X->ops->dotvec_end) PetscUseTypeMethod(X,dotvec_end,y,m);
   else {
     nv = X->k-X->l;
     PetscCall(PetscObjectGetComm((PetscObject)X,&comm));
@@ -356,6 +358,7 @@ PetscErrorCode BVDotColumnBegin(BV X,PetscInt j,PetscScalar *m)
 
   PetscCheck(j>=0,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_OUTOFRANGE,"Index j must be non-negative");
   PetscCheck(j<X->m,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_OUTOFRANGE,"Index j=%" PetscInt_FMT " but BV only has %" PetscInt_FMT " columns",j,X->m);
+  if (PetscUnlikely(X->reprored)) PetscFunctionReturn(PETSC_SUCCESS);  /* computed in BVDotColumnEnd() */
   ksave = X->k;
   X->k = j;
   PetscCall(BVGetColumn(X,j,&y));
@@ -412,6 +415,10 @@ PetscErrorCode BVDotColumnEnd(BV X,PetscInt j,PetscScalar *m)
 
   PetscCheck(j>=0,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_OUTOFRANGE,"Index j must be non-negative");
   PetscCheck(j<X->m,PetscObjectComm((PetscObject)X),PETSC_ERR_ARG_OUTOFRANGE,"Index j=%" PetscInt_FMT " but BV only has %" PetscInt_FMT " columns",j,X->m);
+  if (PetscUnlikely(X->reprored)) {
+    PetscCall(BVDotColumn(X,j,m));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   ksave = X->k;
   X->k = j;
 
@@ -441,13 +448,34 @@ PetscErrorCode BVDotColumnEnd(BV X,PetscInt j,PetscScalar *m)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Same as VecDot(x,y,p) but with reproducible sums, see BVSetReproducibleReduction()
+*/
+static PetscErrorCode BVVecDot_Reproducible(BV bv,Vec x,Vec y,PetscScalar *p)
+{
+  const PetscScalar *px,*py;
+  PetscInt          n;
+  PetscMPIInt       size;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)bv),&size));
+  PetscCall(VecGetLocalSize(x,&n));
+  PetscCall(VecGetArrayRead(x,&px));
+  PetscCall(VecGetArrayRead(y,&py));
+  PetscCall(BVDot_Reproducible_Private(bv,1,1,n,py,n,px,n,PETSC_TRUE,p,1,(size>1)?PETSC_TRUE:PETSC_FALSE));
+  PetscCall(VecRestoreArrayRead(x,&px));
+  PetscCall(VecRestoreArrayRead(y,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static inline PetscErrorCode BVNorm_Private(BV bv,Vec z,NormType type,PetscReal *val)
 {
   PetscScalar    p;
 
   PetscFunctionBegin;
   PetscCall(BV_IPMatMult(bv,z));
-  PetscCall(VecDot(bv->Bx,z,&p));
+  if (PetscUnlikely(bv->reprored)) PetscCall(BVVecDot_Reproducible(bv,bv->Bx,z,&p));
+  else PetscCall(VecDot(bv->Bx,z,&p));
   PetscCall(BV_SafeSqrt(bv,p,val));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -539,6 +567,7 @@ PetscErrorCode BVNorm(BV bv,NormType type,PetscReal *val)
 PetscErrorCode BVNormVec(BV bv,Vec v,NormType type,PetscReal *val)
 {
   PetscInt       n;
+  PetscScalar    p;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
@@ -557,6 +586,9 @@ PetscErrorCode BVNormVec(BV bv,Vec v,NormType type,PetscReal *val)
     PetscCall(VecGetLocalSize(v,&n));
     PetscCheck(bv->n==n,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_INCOMP,"Mismatching local dimension bv %" PetscInt_FMT ", v %" PetscInt_FMT,bv->n,n);
     PetscCall(BVNorm_Private(bv,v,type,val));
+  } else if (PetscUnlikely(bv->reprored) && (type==NORM_2 || type==NORM_FROBENIUS)) {
+    PetscCall(BVVecDot_Reproducible(bv,v,v,&p));
+    *val = PetscSqrtReal(PetscRealPart(p));
   } else PetscCall(VecNorm(v,type,val));
   PetscCall(PetscLogEventEnd(BV_NormVec,bv,0,0,0));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -593,6 +625,7 @@ PetscErrorCode BVNormVecBegin(BV bv,Vec v,NormType type,PetscReal *val)
   PetscCheckSameTypeAndComm(bv,1,v,2);
 
   PetscCheck(type!=NORM_1_AND_2 || bv->matrix,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Requested norm not available");
+  if (PetscUnlikely(bv->reprored)) PetscFunctionReturn(PETSC_SUCCESS);  /* computed in BVNormVecEnd() */
 
   PetscCall(PetscLogEventBegin(BV_NormVec,bv,0,0,0));
   if (bv->matrix) { /* non-standard inner product */
@@ -631,7 +664,8 @@ PetscErrorCode BVNormVecEnd(BV bv,Vec v,NormType type,PetscReal *val)
 
   PetscCheck(type!=NORM_1_AND_2,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Requested norm not available");
 
-  if (bv->matrix) PetscCall(BVNorm_End_Private(bv,v,type,val));  /* non-standard inner product */
+  if (PetscUnlikely(bv->reprored)) PetscCall(BVNormVec(bv,v,type,val));
+  else if (bv->matrix) PetscCall(BVNorm_End_Private(bv,v,type,val));  /* non-standard inner product */
   else PetscCall(VecNormEnd(v,type,val));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -717,6 +751,7 @@ PetscErrorCode BVNormColumnBegin(BV bv,PetscInt j,NormType type,PetscReal *val)
 
   PetscCheck(j>=0 && j<bv->m,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Argument j has wrong value %" PetscInt_FMT ", the number of columns is %" PetscInt_FMT,j,bv->m);
   PetscCheck(type!=NORM_1_AND_2 || bv->matrix,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Requested norm not available");
+  if (PetscUnlikely(bv->reprored)) PetscFunctionReturn(PETSC_SUCCESS);  /* computed in BVNormColumnEnd() */
 
   PetscCall(PetscLogEventBegin(BV_NormVec,bv,0,0,0));
   PetscCall(BVGetColumn(bv,j,&z));
@@ -771,6 +806,10 @@ PetscErrorCode BVNormColumnEnd(BV bv,PetscInt j,NormType type,PetscReal *val)
   BVCheckSizes(bv,1);
 
   PetscCheck(type!=NORM_1_AND_2,PetscObjectComm((PetscObject)bv),PETSC_ERR_SUP,"Requested norm not available");
+  if (PetscUnlikely(bv->reprored)) {
+    PetscCall(BVNormColumn(bv,j,type,val));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
 
   PetscCall(BVGetColumn(bv,j,&z));
   if (bv->matrix) PetscCall(BVNorm_End_Private(bv,z,type,val)); /* non-standard inner product */
@@ -12,6 +12,489 @@
 */
 
 #include <slepc/private/bvimpl.h>          /*I   "slepcbv.h"   I*/
+#include <slepcblaslapack.h>
+
+/*
+   Compute s shifts for the Newton basis from the eigenvalues of the w x w
+   upper Hessenberg matrix Hw (overwritten), sorted in modified Leja order.
+   Also returns a scaling factor rho, an estimate of the capacity of the set.
+ */
+static PetscErrorCode BVKrylovSStepShifts_Private(PetscInt w,PetscScalar *Hw,PetscInt s,PetscScalar *theta,PetscReal *rho)
+{
+  PetscInt     i,c,p,best;
+  PetscReal    sc,bscore,d;
+  PetscScalar  *wr,*work;
+  PetscBool    *used;
+  PetscBLASInt n_,one=1,lwork,info;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscScalar  *wi;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(w,&n_));
+  lwork = n_;
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscMalloc4(w,&wr,w,&wi,w,&work,w,&used));
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,Hw,&n_,wr,wi,NULL,&n_,work,&lwork,&info));
+#else
+  PetscCall(PetscMalloc3(w,&wr,w,&work,w,&used));
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n_,&one,&n_,Hw,&n_,wr,NULL,&n_,work,&lwork,&info));
+#endif
+  SlepcCheckLapackInfo("hseqr",info);
+  PetscCall(PetscFPTrapPop());
+
+  /* modified Leja ordering: start with the largest modulus, then maximize the product of distances */
+  for (c=0;c<w;c++) used[c] = PETSC_FALSE;
+  for (i=0;i<s;i++) {
+    if (i<w) {
+      best = -1; bscore = 0.0;
+      for (c=0;c<w;c++) {
+        if (used[c]) continue;
+        if (!i) sc = PetscAbsScalar(wr[c]);
+        else {
+          for (sc=0.0,p=0;p<i;p++) {
+            d = PetscAbsScalar(wr[c]-theta[p]);
+            if (d==0.0) { sc = PETSC_MIN_REAL; break; }
+            sc += PetscLogReal(d);
+          }
+        }
+        if (best<0 || sc>bscore) { best = c; bscore = sc; }
+      }
+      used[best] = PETSC_TRUE;
+      theta[i] = wr[best];
+    } else theta[i] = theta[i%w];  /* not enough Ritz values, reuse them cyclically */
+  }
+
+  /* scaling factor: a quarter of the diameter of the set of Ritz values */
+  *rho = 0.0;
+  for (c=0;c<w;c++) for (p=c+1;p<w;p++) *rho = PetscMax(*rho,PetscAbsScalar(wr[c]-wr[p]));
+  *rho /= 4.0;
+  if (*rho==0.0) for (c=0;c<w;c++) *rho = PetscMax(*rho,PetscAbsScalar(wr[c]));
+  if (*rho==0.0) *rho = 1.0;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCall(PetscFree4(wr,wi,work,used));
+#else
+  PetscCall(PetscFree3(wr,work,used));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Cholesky factorization G = R'*R of the s x s Gram matrix, and S = inv(R).
+   Returns ok=PETSC_FALSE if the factorization fails or R is numerically singular
+   with respect to the norms of the columns before orthogonalization (onrm).
+ */
+static PetscErrorCode BVKrylovSStepChol_Private(PetscInt s,PetscScalar *G,PetscScalar *S,PetscReal *onrm,PetscBool *ok)
+{
+  PetscInt     i;
+  PetscBLASInt n_,info;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(s,&n_));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&n_,G,&n_,&info));
+  PetscCall(PetscLogFlops((1.0*s*s*s)/3.0));
+  *ok = info? PETSC_FALSE: PETSC_TRUE;
+  for (i=0;i<s && *ok;i++) if (onrm && PetscAbsScalar(G[i+i*s])<PETSC_SQRT_MACHINE_EPSILON*onrm[i]) *ok = PETSC_FALSE;
+  if (*ok) {
+    for (i=0;i<s-1;i++) PetscCall(PetscArrayzero(G+i*s+i+1,s-i-1));
+    PetscCall(PetscArraycpy(S,G,s*s));
+    PetscCallBLAS("LAPACKtrtri",LAPACKtrtri_("U","N",&n_,S,&n_,&info));
+    SlepcCheckLapackInfo("trtri",info);
+    PetscCall(PetscLogFlops(0.33*s*s*s));
+  }
+  PetscCall(PetscFPTrapPop());
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Extend a Krylov decomposition of order j with a block of s vectors,
+   V(:,j+1:j+s), generated by a Newton basis and orthogonalized with
+   block classical Gram-Schmidt followed by Cholesky QR. The new columns
+   j:j+s-1 of the Hessenberg matrix (in h, with leading dimension ldh)
+   are recovered from the change of basis. If symm is true, then h
+   contains the tridiagonal matrix stored as in BVMatLanczos().
+   On failure ok=PETSC_FALSE and V(:,j+1:j+s) are left in an undefined state.
+ */
+static PetscErrorCode BVKrylovSStepBlock_Private(BV V,Mat A,PetscScalar *h,PetscInt ldh,PetscBool symm,PetscInt k,PetscInt j,PetscInt s,PetscReal *beta,PetscBool *ok)
+{
+  PetscInt          i,r,c,w,ldz=j+s+1,pass,chol,rmax,oldl=V->l,oldk=V->k;
+  PetscReal         rho,*alpha=(PetscReal*)h,*betat=alpha+ldh,*onrm;
+  PetscScalar       *Hw,*theta,*Cacc,*Racc,*S,*Z,*P,*T,*pg,*pm,sone=1.0;
+  const PetscScalar *cpm;
+  PetscBool         refine;
+  PetscBLASInt      s_,m_,ldz_;
+  Mat               M,G;
+  BV                L,W;
+  Vec               x,y;
+
+  PetscFunctionBegin;
+  *ok = PETSC_TRUE;
+  w = PetscMin(j-k,4*s);
+  PetscCall(PetscCalloc6(w*w,&Hw,s,&theta,(j+1)*s,&Cacc,3*s*s,&Racc,ldz*(s+1),&Z,ldz*s,&P));
+  PetscCall(PetscMalloc1(s,&onrm));
+  S = Racc+s*s;
+  T = S+s*s;
+
+  /* shifts of the Newton basis taken from the trailing part of the current Hessenberg matrix */
+  for (c=0;c<w;c++) {
+    if (symm) {
+      Hw[c+c*w] = alpha[j-w+c];
+      if (c<w-1) Hw[c+1+c*w] = Hw[c+(c+1)*w] = betat[j-w+c];
+    } else for (r=0;r<=PetscMin(c+1,w-1);r++) Hw[r+c*w] = h[j-w+r+(j-w+c)*ldh];
+  }
+  PetscCall(BVKrylovSStepShifts_Private(w,Hw,s,theta,&rho));
+
+  /* matrix powers kernel: A*x_i = theta_i*x_i + rho*x_{i+1} */
+  for (i=0;i<s;i++) {
+    PetscCall(BVMatMultColumn(V,A,j+i));
+    PetscCall(BVGetColumn(V,j+i,&x));
+    PetscCall(BVGetColumn(V,j+i+1,&y));
+    PetscCall(VecAXPBY(y,-theta[i]/rho,1.0/rho,x));
+    PetscCall(BVRestoreColumn(V,j+i,&x));
+    PetscCall(BVRestoreColumn(V,j+i+1,&y));
+  }
+
+  /* block Gram-Schmidt against V(:,0:j), one reduction for the projection and one for the Gram matrix */
+  PetscCall(BVSetActiveColumns(V,j+1,j+s+1));
+  PetscCall(BVGetSplit(V,&L,&W));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,j+1,s,NULL,&M));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,s,s,NULL,&G));
+  for (pass=0;pass<2;pass++) {
+    PetscCall(BVDot(W,L,M));
+    PetscCall(BVMult(W,-1.0,1.0,L,M));
+    PetscCall(MatDenseGetArrayRead(M,&cpm));
+    for (i=0;i<(j+1)*s;i++) Cacc[i] += cpm[i];
+    PetscCall(MatDenseRestoreArrayRead(M,&cpm));
+    PetscCall(BVDot(W,W,G));
+    PetscCall(MatDenseGetArrayRead(G,&cpm));
+    for (i=0;i<s;i++) {
+      onrm[i] = PetscRealPart(cpm[i+i*s]);
+      for (r=0;r<=j;r++) onrm[i] += PetscRealPart(Cacc[r+i*(j+1)]*PetscConj(Cacc[r+i*(j+1)]));
+      onrm[i] = PetscSqrtReal(PetscMax(onrm[i],0.0));
+    }
+    refine = (V->orthog_ref==BV_ORTHOG_REFINE_ALWAYS)? PETSC_TRUE: PETSC_FALSE;
+    if (V->orthog_ref==BV_ORTHOG_REFINE_IFNEEDED) {
+      for (i=0;i<s && !refine;i++) if (PetscSqrtReal(PetscMax(PetscRealPart(cpm[i+i*s]),0.0))<V->orthog_eta*onrm[i]) refine = PETSC_TRUE;
+    }
+    PetscCall(MatDenseRestoreArrayRead(G,&cpm));
+    if (pass || !refine) break;
+  }
+
+  /* Cholesky QR of the block, repeated once unless refinement is disabled */
+  for (i=0;i<s;i++) Racc[i+i*s] = 1.0;
+  for (chol=0;chol<((V->orthog_ref==BV_ORTHOG_REFINE_NEVER)?1:2) && *ok;chol++) {
+    if (chol) PetscCall(BVDot(W,W,G));
+    PetscCall(MatDenseGetArray(G,&pg));
+    PetscCall(BVKrylovSStepChol_Private(s,pg,S,chol?NULL:onrm,ok));
+    if (*ok) {
+      /* Racc = R*Racc */
+      for (c=0;c<s;c++) for (r=0;r<=c;r++) for (T[r+c*s]=0.0,i=r;i<=c;i++) T[r+c*s] += pg[r+i*s]*Racc[i+c*s];
+      PetscCall(PetscArraycpy(Racc,T,s*s));
+    }
+    PetscCall(MatDenseRestoreArray(G,&pg));
+    if (*ok) {
+      PetscCall(MatDenseGetArray(G,&pg));
+      PetscCall(PetscArraycpy(pg,S,s*s));
+      PetscCall(MatDenseRestoreArray(G,&pg));
+      PetscCall(BVMultInPlace(W,G,0,s));
+    }
+  }
+  PetscCall(MatDestroy(&M));
+  PetscCall(MatDestroy(&G));
+  PetscCall(BVRestoreSplit(V,&L,&W));
+  PetscCall(BVSetActiveColumns(V,oldl,oldk));
+
+  if (*ok) {
+    /* [x_0 ... x_s] = V(:,0:j+s)*Z */
+    Z[j] = 1.0;
+    for (i=1;i<=s;i++) {
+      PetscCall(PetscArraycpy(Z+i*ldz,Cacc+(i-1)*(j+1),j+1));
+      PetscCall(PetscArraycpy(Z+j+1+i*ldz,Racc+(i-1)*s,s));
+    }
+    /* P = Z*B, where B is the (s+1) x s bidiagonal matrix of the Newton recurrence */
+    for (i=0;i<s;i++) for (r=0;r<ldz;r++) P[r+i*ldz] = theta[i]*Z[r+i*ldz]+rho*Z[r+(i+1)*ldz];
+    /* subtract the contribution of the already computed columns of H */
+    if (symm) {
+      for (i=0;i<s;i++) P[j+i*ldz] -= betat[j-1]*Z[j-1+i*ldz];
+    } else {
+      for (c=0;c<j;c++) {
+        rmax = (c<k)? k: c+1;
+        for (i=0;i<s;i++) for (r=0;r<=rmax;r++) P[r+i*ldz] -= h[r+c*ldh]*Z[c+i*ldz];
+      }
+    }
+    /* H(:,j:j+s-1) = P*inv(Z(j:j+s-1,0:s-1)), the latter is upper triangular */
+    PetscCall(PetscBLASIntCast(s,&s_));
+    PetscCall(PetscBLASIntCast(symm?s+1:ldz,&m_));
+    PetscCall(PetscBLASIntCast(ldz,&ldz_));
+    pm = symm? P+j: P;
+    PetscCallBLAS("BLAStrsm",BLAStrsm_("R","U","N","N",&m_,&s_,&sone,Z+j,&ldz_,pm,&ldz_));
+    PetscCall(PetscLogFlops(1.0*m_*s*s));
+    for (i=0;i<s;i++) {
+      if (symm) {
+        alpha[j+i] = PetscRealPart(P[j+i+i*ldz]);
+        betat[j+i] = PetscRealPart(P[j+i+1+i*ldz]);
+      } else PetscCall(PetscArraycpy(h+(j+i)*ldh,P+i*ldz,PetscMin(j+i+2,ldh)));
+    }
+    if (beta) *beta = PetscRealPart(P[j+s+(s-1)*ldz]);
+  }
+  PetscCall(PetscFree6(Hw,theta,Cacc,Racc,Z,P));
+  PetscCall(PetscFree(onrm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Arnoldi/Lanczos expansion with blocks of V->sstep vectors, see BVSetKrylovSStep().
+   A few standard steps are carried out first to get estimates of the spectrum, and
+   also at the end if the remaining number of vectors is not enough to fill a block.
+   The matrix H (or T if symm) is updated as the columns are computed.
+ */
+static PetscErrorCode BVMatKrylov_SStep_Private(BV V,Mat A,Mat H,PetscBool symm,PetscInt k,PetscInt *m,PetscReal *beta,PetscBool *lindep)
+{
+  PetscScalar       *h;
+  const PetscScalar *a;
+  PetscReal         *alpha,*betat;
+  PetscInt          j=k,s,ldh;
+  PetscBool         ok=PETSC_TRUE;
+  Vec               buf;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseGetLDA(H,&ldh));
+  PetscCall(MatDenseGetArray(H,&h));
+  alpha = (PetscReal*)h;
+  betat = alpha+ldh;
+  while (j<*m) {
+    s = PetscMin(V->sstep,*m-j);
+    if (ok && s>1 && j-k>=V->sstep && j+s<V->N) {
+      PetscCall(BVKrylovSStepBlock_Private(V,A,h,ldh,symm,k,j,s,beta,&ok));
+      if (ok) {
+        j += s;
+        continue;
+      }
+      PetscCall(PetscInfo(V,"Cholesky QR failed in block starting at j=%" PetscInt_FMT ", continuing with one vector per step\n",j));
+    }
+    PetscCall(BVMatMultColumn(V,A,j));
+    if (PetscUnlikely(j==V->N-1)) PetscCall(BV_OrthogonalizeColumn_Safe(V,j+1,NULL,beta,lindep)); /* safeguard in case the full basis is requested */
+    else PetscCall(BVOrthonormalizeColumn(V,j+1,PETSC_FALSE,beta,lindep));
+    PetscCall(BVGetBufferVec(V,&buf));
+    PetscCall(VecGetArrayRead(buf,&a));
+    if (symm) {
+      alpha[j] = PetscRealPart(a[j+(j+1)*V->m]);
+      betat[j] = PetscRealPart(a[j+1+(j+1)*V->m]);
+    } else PetscCall(PetscArraycpy(h+j*ldh,a+(j+1)*V->m,PetscMin(j+2,ldh)));
+    PetscCall(VecRestoreArrayRead(buf,&a));
+    if (PetscUnlikely(*lindep)) {
+      *m = j+1;
+      break;
+    }
+    j++;
+  }
+  PetscCall(MatDenseRestoreArray(H,&h));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Arnoldi/Lanczos expansion with pipelined CGS, see BVSetOrthogonalization().
+   The inner products and norm of w=A*v_j are computed with a single nonblocking
+   reduction, while the product A*w is computed. After normalization, A*v_{j+1}
+   is obtained from A*w with the Krylov recurrence, so no extra matrix-vector
+   product is needed. The first pass is followed by a standard one only if
+   refinement is required. In the symmetric case, the recurrence neglects the
+   coefficients of columns other than the last two, and it is disabled if these
+   coefficients are not small.
+   The matrix H (or T if symm) is updated as the columns are computed.
+ */
+static PetscErrorCode BVMatKrylov_Pipelined_Private(BV V,Mat A,Mat H,PetscBool symm,PetscInt k,PetscInt *m,PetscReal *beta,PetscBool *lindep)
+{
+  PetscScalar       *h,*c,*ct,*g;
+  const PetscScalar *a;
+  PetscReal         *alpha,*betat,nw,est,nrm,tail;
+  PetscInt          i,j,r,rmax,ldh,lsave=V->l;
+  PetscBool         pipe,havew=PETSC_FALSE,refine;
+  MPI_Comm          comm;
+  Vec               buf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)V,&comm));
+  PetscCall(MatDenseGetLDA(H,&ldh));
+  PetscCall(MatDenseGetArray(H,&h));
+  alpha = (PetscReal*)h;
+  betat = alpha+ldh;
+  PetscCall(PetscMalloc3(*m,&c,*m,&ct,*m+1,&g));
+  V->l = 0;
+  for (j=k;j<*m;j++) {
+    if (!havew) PetscCall(BVMatMultColumn(V,A,j));
+    pipe = (j+1<*m && j+2<V->N && (!symm || j>=k+2))? PETSC_TRUE: PETSC_FALSE;
+
+    /* first CGS pass, overlapping the reduction with the next matrix-vector product */
+    PetscCall(BVDotColumnBegin(V,j+1,c));
+    PetscCall(BVNormColumnBegin(V,j+1,NORM_2,&nw));
+    PetscCall(PetscCommSplitReductionBegin(comm));
+    if (pipe) PetscCall(BVMatMultColumn(V,A,j+1));
+    PetscCall(BVDotColumnEnd(V,j+1,c));
+    PetscCall(BVNormColumnEnd(V,j+1,NORM_2,&nw));
+    PetscCall(BVMultColumn(V,-1.0,1.0,j+1,c));
+    for (est=nw*nw,i=0;i<=j;i++) {
+      ct[i] = c[i];
+      est -= PetscRealPart(c[i]*PetscConj(c[i]));
+    }
+
+    /* second pass if needed, with the standard orthogonalization */
+    *lindep = PETSC_FALSE;
+    if (PetscUnlikely(j==V->N-1)) {  /* the full basis was requested, the vector is numerically zero */
+      nrm = 0.0;
+      *lindep = PETSC_TRUE;
+    } else {
+      refine = (V->orthog_ref==BV_ORTHOG_REFINE_ALWAYS || est<=0.0 || (V->orthog_ref==BV_ORTHOG_REFINE_IFNEEDED && est<V->orthog_eta*V->orthog_eta*nw*nw))? PETSC_TRUE: PETSC_FALSE;
+      if (refine) {
+        PetscCall(BVOrthogonalizeColumn(V,j+1,NULL,&nrm,lindep));
+        PetscCall(BVGetBufferVec(V,&buf));
+        PetscCall(VecGetArrayRead(buf,&a));
+        for (i=0;i<=j;i++) ct[i] += a[i+(j+1)*V->m];
+        PetscCall(VecRestoreArrayRead(buf,&a));
+      } else nrm = PetscSqrtReal(est);
+    }
+
+    /* store the new column of H */
+    if (symm) {
+      alpha[j] = PetscRealPart(ct[j]);
+      betat[j] = nrm;
+    } else {
+      PetscCall(PetscArraycpy(h+j*ldh,ct,j+1));
+      if (j+1<ldh) h[j+1+j*ldh] = nrm;
+    }
+    if (beta) *beta = nrm;
+    if (PetscUnlikely(*lindep || nrm==0.0)) {
+      *lindep = PETSC_TRUE;
+      *m = j+1;
+      break;
+    }
+    PetscCall(BVScaleColumn(V,j+1,1.0/nrm));
+
+    /* A*v_{j+1} = (A*w-A*V(:,0:j)*ct)/nrm, where A*V(:,0:j) = V(:,0:j+1)*H(0:j+1,0:j) */
+    if (pipe) {
+      PetscCall(PetscArrayzero(g,j+2));
+      if (symm) {
+        for (tail=0.0,i=0;i<j-1;i++) tail += PetscRealPart(ct[i]*PetscConj(ct[i]));
+        if (PetscSqrtReal(tail)>PETSC_SQRT_MACHINE_EPSILON*nw) pipe = PETSC_FALSE;  /* recompute A*v_{j+1} */
+        else {
+          g[j-2] = betat[j-2]*ct[j-1];
+          g[j-1] = alpha[j-1]*ct[j-1]+betat[j-1]*ct[j];
+          g[j]   = betat[j-1]*ct[j-1]+alpha[j]*ct[j];
+          g[j+1] = betat[j]*ct[j];
+        }
+      } else {
+        for (i=0;i<=j;i++) {
+          rmax = (i<k)? k: i+1;
+          for (r=0;r<=rmax;r++) g[r] += h[r+i*ldh]*ct[i];
+        }
+      }
+      if (pipe) PetscCall(BVMultColumn(V,-1.0/nrm,1.0/nrm,j+2,g));
+    }
+    havew = pipe;
+  }
+  V->l = lsave;
+  PetscCall(PetscFree3(c,ct,g));
+  PetscCall(MatDenseRestoreArray(H,&h));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Arnoldi expansion with delayed CGS2 (DCGS2), see BVSetOrthogonalization().
+   The second pass of Gram-Schmidt of column j is delayed to the next step, so
+   that its inner products are computed in the same reduction as those of the
+   first pass of w=A*q, where q is column j after the first pass only (scaled
+   with an estimate of its norm). The correction of q is then propagated to
+   w and to column j-1 of H by means of the Arnoldi relation, as in DCGS2-Arnoldi
+   of Swirydowicz et al. (2020). Only one global reduction is needed per step,
+   plus one at the end to complete the last column.
+   The matrix H is updated as the columns are computed.
+ */
+static PetscErrorCode BVMatKrylov_DCGS2_Private(BV V,Mat A,Mat H,PetscInt k,PetscInt *m,PetscReal *beta,PetscBool *lindep)
+{
+  PetscScalar *h,*a,*d,*g,dj;
+  PetscReal   nq,nw,est,nu=1.0,nut=1.0;
+  PetscInt    i,j,r,rmax,ldh,lsave=V->l;
+  MPI_Comm    comm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)V,&comm));
+  PetscCall(MatDenseGetLDA(H,&ldh));
+  PetscCall(MatDenseGetArray(H,&h));
+  PetscCall(PetscMalloc3(*m+1,&a,*m+1,&d,*m+1,&g));
+  V->l = 0;
+  *lindep = PETSC_FALSE;
+  for (j=k;j<=*m;j++) {
+    /* w = A*q, except in the last step where only the second pass of q is left */
+    if (j<*m) PetscCall(BVMatMultColumn(V,A,j));
+
+    /* single reduction: a = V(:,0:j-1)'*q, |q|, d = V(:,0:j)'*w, |w| */
+    if (j>k) {
+      PetscCall(BVDotColumnBegin(V,j,a));
+      PetscCall(BVNormColumnBegin(V,j,NORM_2,&nq));
+    }
+    if (j<*m) {
+      PetscCall(BVDotColumnBegin(V,j+1,d));
+      PetscCall(BVNormColumnBegin(V,j+1,NORM_2,&nw));
+    }
+    PetscCall(PetscCommSplitReductionBegin(comm));
+    if (j>k) {
+      PetscCall(BVDotColumnEnd(V,j,a));
+      PetscCall(BVNormColumnEnd(V,j,NORM_2,&nq));
+    }
+    if (j<*m) {
+      PetscCall(BVDotColumnEnd(V,j+1,d));
+      PetscCall(BVNormColumnEnd(V,j+1,NORM_2,&nw));
+    }
+
+    /* delayed second pass of q = V(:,0:j-1)*a + nu*v_j, and correction of column j-1 of H */
+    if (j>k) {
+      for (est=nq*nq,i=0;i<j;i++) est -= PetscRealPart(a[i]*PetscConj(a[i]));
+      PetscCall(BVMultColumn(V,-1.0,1.0,j,a));
+      if (PetscUnlikely(est<=0.0)) PetscCall(BVNormColumn(V,j,NORM_2,&nu));
+      else nu = PetscSqrtReal(est);
+      for (i=0;i<j;i++) h[i+(j-1)*ldh] += nut*a[i];
+      h[j+(j-1)*ldh] = nut*nu;
+      if (beta) *beta = nut*nu;
+      if (nu!=0.0) PetscCall(BVScaleColumn(V,j,1.0/nu));
+      if (PetscUnlikely(nu==0.0 || nu<V->orthog_eta*nq)) {
+        *lindep = PETSC_TRUE;
+        *m = j;
+        break;
+      }
+      if (j==*m) break;
+      /* V(:,0:j)'*A*v_j = (d-H(0:j,0:j-1)*a)/nu, with d(j) = v_j'*w */
+      for (dj=d[j],i=0;i<j;i++) dj -= PetscConj(a[i])*d[i];
+      d[j] = dj/nu;
+      PetscCall(PetscArrayzero(g,j+1));
+      for (i=0;i<j;i++) {
+        rmax = (i<k)? k: i+1;
+        for (r=0;r<=rmax;r++) g[r] += h[r+i*ldh]*a[i];
+      }
+    } else PetscCall(PetscArrayzero(g,j+1));
+
+    /* first pass of the new column, nu*nut*q = w - V(:,0:j)*d */
+    for (est=nw*nw,i=0;i<=j;i++) est -= PetscRealPart(d[i]*PetscConj(d[i]));
+    PetscCall(BVMultColumn(V,-1.0,1.0,j+1,d));
+    if (PetscUnlikely(est<=0.0)) PetscCall(BVNormColumn(V,j+1,NORM_2,&nut));
+    else nut = PetscSqrtReal(est);
+    nut /= nu;
+    for (r=0;r<=j;r++) h[r+j*ldh] = (d[r]-g[r])/nu;
+    if (j+1<ldh) h[j+1+j*ldh] = nut;
+    if (PetscUnlikely(nut==0.0)) {
+      if (beta) *beta = 0.0;
+      *lindep = PETSC_TRUE;
+      *m = j+1;
+      break;
+    }
+    PetscCall(BVScaleColumn(V,j+1,1.0/(nu*nut)));
+  }
+  V->l = lsave;
+  PetscCall(PetscFree3(a,d,g));
+  PetscCall(MatDenseRestoreArray(H,&h));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
 /*@
    BVMatArnoldi - Computes an Arnoldi factorization associated with a matrix.
@@ -49,16 +532,25 @@ $                    A * V - V * H = beta*v_m * e_m^T
    To create an Arnoldi factorization from scratch, set k=0 and make sure the
    first column contains the normalized initial vector.
 
+   If an s-step expansion has been requested with BVSetKrylovSStep(), and H
+   is provided, the basis is built in blocks of s vectors that require a
+   constant number of global reductions per block. Otherwise, if the
+   orthogonalization type is BV_ORTHOG_CGS_PIPELINED, the global reduction of
+   each step is overlapped with the next matrix-vector product, and if it is
+   BV_ORTHOG_DCGS2 the second pass of Gram-Schmidt of each column is delayed
+   and fused with the reduction of the next step. In the rest of cases, each
+   step is done with BVMatMultOrthonormalizeColumn().
+
    Level: advanced
 
-.seealso: BVMatLanczos(), BVSetActiveColumns(), BVOrthonormalizeColumn()
+.seealso: BVMatLanczos(), BVSetActiveColumns(), BVOrthonormalizeColumn(), BVSetKrylovSStep(), BVMatMultOrthonormalizeColumn()
 @*/
 PetscErrorCode BVMatArnoldi(BV V,Mat A,Mat H,PetscInt k,PetscInt *m,PetscReal *beta,PetscBool *breakdown)
 {
   PetscScalar       *h;
   const PetscScalar *a;
   PetscInt          j,ldh,rows,cols;
-  PetscBool         lindep=PETSC_FALSE;
+  PetscBool         lindep=PETSC_FALSE,sstep,pipe,dcgs2;
   Vec               buf;
 
   PetscFunctionBegin;
@@ -85,19 +577,28 @@ PetscErrorCode BVMatArnoldi(BV V,Mat A,Mat H,PetscInt k,PetscInt *m,PetscReal *b
     PetscCheck(cols>=*m,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Matrix H has %" PetscInt_FMT " columns, should have at least %" PetscInt_FMT,cols,*m);
   }
 
-  for (j=k;j<*m;j++) {
-    PetscCall(BVMatMultColumn(V,A,j));
-    if (PetscUnlikely(j==V->N-1)) PetscCall(BV_OrthogonalizeColumn_Safe(V,j+1,NULL,beta,&lindep)); /* safeguard in case the full basis is requested */
-    else PetscCall(BVOrthonormalizeColumn(V,j+1,PETSC_FALSE,beta,&lindep));
-    if (PetscUnlikely(lindep)) {
-      *m = j+1;
-      break;
+  sstep = (H && V->sstep>1 && !V->nc && !V->indef)? PETSC_TRUE: PETSC_FALSE;
+  pipe  = (H && !sstep && V->orthog_type==BV_ORTHOG_CGS_PIPELINED && !V->nc && !V->indef)? PETSC_TRUE: PETSC_FALSE;
+  dcgs2 = (H && !sstep && V->orthog_type==BV_ORTHOG_DCGS2 && !V->nc && !V->indef && *m<V->N)? PETSC_TRUE: PETSC_FALSE;
+  if (sstep) PetscCall(BVMatKrylov_SStep_Private(V,A,H,PETSC_FALSE,k,m,beta,&lindep));
+  else if (pipe) PetscCall(BVMatKrylov_Pipelined_Private(V,A,H,PETSC_FALSE,k,m,beta,&lindep));
+  else if (dcgs2) PetscCall(BVMatKrylov_DCGS2_Private(V,A,H,k,m,beta,&lindep));
+  else {
+    for (j=k;j<*m;j++) {
+      if (PetscUnlikely(j==V->N-1)) {  /* safeguard in case the full basis is requested */
+        PetscCall(BVMatMultColumn(V,A,j));
+        PetscCall(BV_OrthogonalizeColumn_Safe(V,j+1,NULL,beta,&lindep));
+      } else PetscCall(BVMatMultOrthonormalizeColumn(V,A,j,beta,&lindep));
+      if (PetscUnlikely(lindep)) {
+        *m = j+1;
+        break;
+      }
     }
   }
   if (breakdown) *breakdown = lindep;
   if (lindep) PetscCall(PetscInfo(V,"Arnoldi finished early at m=%" PetscInt_FMT "\n",*m));
 
-  if (H) {
+  if (H && !sstep && !pipe && !dcgs2) {
     PetscCall(MatDenseGetArray(H,&h));
     PetscCall(BVGetBufferVec(V,&buf));
     PetscCall(VecGetArrayRead(buf,&a));
@@ -158,9 +659,13 @@ $                    A * V - V * T = beta*v_m * e_m^T
    To create a Lanczos factorization from scratch, set k=0 and make sure the
    first column contains the normalized initial vector.
 
+   If an s-step expansion has been requested with BVSetKrylovSStep(), and T
+   is provided, the basis is built in blocks of s vectors, as in BVMatArnoldi().
+   Similarly, BV_ORTHOG_CGS_PIPELINED is handled as in BVMatArnoldi().
+
    Level: advanced
 
-.seealso: BVMatArnoldi(), BVSetActiveColumns(), BVOrthonormalizeColumn(), DSGetMat()
+.seealso: BVMatArnoldi(), BVSetActiveColumns(), BVOrthonormalizeColumn(), DSGetMat(), BVSetKrylovSStep()
 @*/
 PetscErrorCode BVMatLanczos(BV V,Mat A,Mat T,PetscInt k,PetscInt *m,PetscReal *beta,PetscBool *breakdown)
 {
@@ -168,7 +673,7 @@ PetscErrorCode BVMatLanczos(BV V,Mat A,Mat T,PetscInt k,PetscInt *m,PetscReal *b
   const PetscScalar *a;
   PetscReal         *alpha,*betat;
   PetscInt          j,ldt,rows,cols,mincols=PetscDefined(USE_COMPLEX)?1:2;
-  PetscBool         lindep=PETSC_FALSE;
+  PetscBool         lindep=PETSC_FALSE,sstep,pipe;
   Vec               buf;
 
   PetscFunctionBegin;
@@ -195,19 +700,26 @@ PetscErrorCode BVMatLanczos(BV V,Mat A,Mat T,PetscInt k,PetscInt *m,PetscReal *b
     PetscCheck(cols>=mincols,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Matrix T has %" PetscInt_FMT " columns, should have at least %" PetscInt_FMT,cols,mincols);
   }
 
-  for (j=k;j<*m;j++) {
-    PetscCall(BVMatMultColumn(V,A,j));
-    if (PetscUnlikely(j==V->N-1)) PetscCall(BV_OrthogonalizeColumn_Safe(V,j+1,NULL,beta,&lindep)); /* safeguard in case the full basis is requested */
-    else PetscCall(BVOrthonormalizeColumn(V,j+1,PETSC_FALSE,beta,&lindep));
-    if (PetscUnlikely(lindep)) {
-      *m = j+1;
-      break;
+  sstep = (T && V->sstep>1 && !V->nc && !V->indef)? PETSC_TRUE: PETSC_FALSE;
+  pipe  = (T && !sstep && V->orthog_type==BV_ORTHOG_CGS_PIPELINED && !V->nc && !V->indef)? PETSC_TRUE: PETSC_FALSE;
+  if (sstep) PetscCall(BVMatKrylov_SStep_Private(V,A,T,PETSC_TRUE,k,m,beta,&lindep));
+  else if (pipe) PetscCall(BVMatKrylov_Pipelined_Private(V,A,T,PETSC_TRUE,k,m,beta,&lindep));
+  else {
+    for (j=k;j<*m;j++) {
+      if (PetscUnlikely(j==V->N-1)) {  /* safeguard in case the full basis is requested */
+        PetscCall(BVMatMultColumn(V,A,j));
+        PetscCall(BV_OrthogonalizeColumn_Safe(V,j+1,NULL,beta,&lindep));
+      } else PetscCall(BVMatMultOrthonormalizeColumn(V,A,j,beta,&lindep));
+      if (PetscUnlikely(lindep)) {
+        *m = j+1;
+        break;
+      }
     }
   }
   if (breakdown) *breakdown = lindep;
   if (lindep) PetscCall(PetscInfo(V,"Lanczos finished early at m=%" PetscInt_FMT "\n",*m));
 
-  if (T) {
+  if (T && !sstep && !pipe) {
     PetscCall(MatDenseGetArray(T,&t));
     alpha = (PetscReal*)t;
     betat = alpha+ldt;
@@ -45,7 +45,13 @@ PetscErrorCode BVNorm_LAPACK_Private(BV bv,PetscInt m_,PetscInt n_,const PetscSc
   PetscCall(PetscBLASIntCast(m_,&m));
   PetscCall(PetscBLASIntCast(n_,&n));
   PetscCall(PetscBLASIntCast(lda_,&lda));
-  if (type==NORM_FROBENIUS || type==NORM_2) {
+  if ((type==NORM_FROBENIUS || type==NORM_2) && PetscUnlikely(bv->reprored)) {
+    /* squared norms of the columns with reproducible sums, added in a fixed order */
+    PetscCall(BVAllocateWork_Private(bv,n_));
+    PetscCall(BVDot_Reproducible_Private(bv,n_,n_,m_,A,lda_,A,lda_,PETSC_TRUE,bv->work,n_,mpi));
+    for (lnrm=0.0,j=0;j<n_;j++) lnrm += PetscRealPart(bv->work[j]);
+    *nrm = PetscSqrtReal(lnrm);
+  } else if (type==NORM_FROBENIUS || type==NORM_2) {
     lnrm = LAPACKlange_("F",&m,&n,(PetscScalar*)A,&lda,rwork);
     if (mpi) PetscCallMPI(MPIU_Allreduce(&lnrm,nrm,1,MPIU_REAL,MPIU_LAPY2,PetscObjectComm((PetscObject)bv)));
     else *nrm = lnrm;
@@ -98,22 +104,39 @@ PetscErrorCode BVNormalize_LAPACK_Private(BV bv,PetscInt m_,PetscInt n_,const Pe
   PetscCall(BVAllocateWork_Private(bv,2*n_));
   rwork = (PetscReal*)bv->work;
   rwork2 = rwork+n_;
-  /* compute local norms */
-  for (j=0;j<n_;j++) {
-    k = 1;
+  if (PetscUnlikely(bv->reprored)) {
+    /* squared norms with reproducible sums, placed after the reals of rwork */
+    PetscCall(BVDot_Reproducible_Private(bv,n_,n_,m_,A,lda_,A,lda_,PETSC_TRUE,bv->work+n_,n_,mpi));
+    for (j=0;j<n_;j++) {
+      k = 1;
 #if !defined(PETSC_USE_COMPLEX)
-    if (eigi && eigi[j] != 0.0) k = 2;
+      if (eigi && eigi[j] != 0.0) k = 2;
+#endif
+      if (k==2) {
+        rwork[j] = PetscSqrtReal(PetscRealPart(bv->work[n_+j])+PetscRealPart(bv->work[n_+j+1]));
+        rwork[j+1] = rwork[j];
+        j++;
+      } else rwork[j] = PetscSqrtReal(PetscRealPart(bv->work[n_+j]));
+    }
+    norms = rwork;
+  } else {
+    /* compute local norms */
+    for (j=0;j<n_;j++) {
+      k = 1;
+#if !defined(PETSC_USE_COMPLEX)
+      if (eigi && eigi[j] != 0.0) k = 2;
 #endif
-    rwork[j] = LAPACKlange_("F",&m,&k,(PetscScalar*)(A+j*lda_),&lda,rwork2);
-    if (k==2) { rwork[j+1] = rwork[j]; j++; }
+      rwork[j] = LAPACKlange_("F",&m,&k,(PetscScalar*)(A+j*lda_),&lda,rwork2);
+      if (k==2) { rwork[j+1] = rwork[j]; j++; }
+    }
+    /* reduction to get global norms */
+    if (mpi) {
+      PetscCall(PetscMPIIntCast(n_,&len));
+      PetscCall(PetscArrayzero(rwork2,n_));
+      PetscCallMPI(MPIU_Allreduce(rwork,rwork2,len,MPIU_REAL,MPIU_LAPY2,PetscObjectComm((PetscObject)bv)));
+      norms = rwork2;
+    } else norms = rwork;
   }
-  /* reduction to get global norms */
-  if (mpi) {
-    PetscCall(PetscMPIIntCast(n_,&len));
-    PetscCall(PetscArrayzero(rwork2,n_));
-    PetscCallMPI(MPIU_Allreduce(rwork,rwork2,len,MPIU_REAL,MPIU_LAPY2,PetscObjectComm((PetscObject)bv)));
-    norms = rwork2;
-  } else norms = rwork;
   /* scale columns */
   for (j=0;j<n_;j++) {
     k = 1;
@@ -251,6 +274,34 @@ PetscErrorCode BVMatTriInv_LAPACK_Private(BV bv,Mat R,Mat S)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Compute the product of two upper triangular matrices, R := T*R.
+   Only the block l:k-1 is referenced.
+ */
+PetscErrorCode BVMatTriMult_LAPACK_Private(BV bv,Mat T,Mat R)
+{
+  PetscInt       k,l,n,ld,ldt;
+  PetscScalar    *pR,*pT,one=1.0;
+  PetscBLASInt   n_,ld_,ldt_;
+
+  PetscFunctionBegin;
+  l = bv->l;
+  k = bv->k;
+  n = k-l;
+  PetscCall(MatGetSize(R,&ld,NULL));
+  PetscCall(MatGetSize(T,&ldt,NULL));
+  PetscCall(PetscBLASIntCast(n,&n_));
+  PetscCall(PetscBLASIntCast(ld,&ld_));
+  PetscCall(PetscBLASIntCast(ldt,&ldt_));
+  PetscCall(MatDenseGetArray(R,&pR));
+  PetscCall(MatDenseGetArray(T,&pT));
+  PetscCallBLAS("BLAStrmm",BLAStrmm_("L","U","N","N",&n_,&n_,&one,pT+l*ldt+l,&ldt_,pR+l*ld+l,&ld_));
+  PetscCall(PetscLogFlops(1.0*n*n*n/3.0));
+  PetscCall(MatDenseRestoreArray(R,&pR));
+  PetscCall(MatDenseRestoreArray(T,&pT));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Compute the matrix to be used for post-multiplying the basis in the SVQB
    block orthogonalization method.
@@ -220,6 +220,7 @@ PetscErrorCode BVMultColumn(BV X,PetscScalar alpha,PetscScalar beta,PetscInt j,P
 PetscErrorCode BVMultInPlace(BV V,Mat Q,PetscInt s,PetscInt e)
 {
   PetscInt       m,n;
+  PetscBool      sketch;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(V,BV_CLASSID,1);
@@ -237,10 +238,12 @@ PetscErrorCode BVMultInPlace(BV V,Mat Q,PetscInt s,PetscInt e)
   PetscCheck(m>=V->k,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Mat argument has %" PetscInt_FMT " rows, should have at least %" PetscInt_FMT,m,V->k);
   PetscCheck(e<=n,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Mat argument only has %" PetscInt_FMT " columns, the requested value of e is larger: %" PetscInt_FMT,n,e);
 
+  sketch = BV_SketchValid(V);
   PetscCall(PetscLogEventBegin(BV_MultInPlace,V,Q,0,0));
   PetscUseTypeMethod(V,multinplace,Q,s,e);
   PetscCall(PetscLogEventEnd(BV_MultInPlace,V,Q,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)V));
+  PetscCall(BV_SketchMultInPlace(V,sketch,Q,s,e));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -340,6 +343,8 @@ PetscErrorCode BVScale(BV bv,PetscScalar alpha)
 @*/
 PetscErrorCode BVScaleColumn(BV bv,PetscInt j,PetscScalar alpha)
 {
+  PetscBool      sketch;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
   PetscValidLogicalCollectiveInt(bv,j,2);
@@ -350,10 +355,12 @@ PetscErrorCode BVScaleColumn(BV bv,PetscInt j,PetscScalar alpha)
   PetscCheck(j>=0 && j<bv->m,PetscObjectComm((PetscObject)bv),PETSC_ERR_ARG_OUTOFRANGE,"Argument j has wrong value %" PetscInt_FMT ", the number of columns is %" PetscInt_FMT,j,bv->m);
   if (alpha == (PetscScalar)1.0) PetscFunctionReturn(PETSC_SUCCESS);
 
+  sketch = BV_SketchValid(bv);
   PetscCall(PetscLogEventBegin(BV_Scale,bv,0,0,0));
   PetscUseTypeMethod(bv,scale,j,alpha);
   PetscCall(PetscLogEventEnd(BV_Scale,bv,0,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+  PetscCall(BV_SketchScaleColumn(bv,sketch,j,alpha));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -862,6 +869,7 @@ PetscErrorCode BVMatMultHermitianTranspose(BV V,Mat A,BV Y)
 PetscErrorCode BVMatMultColumn(BV V,Mat A,PetscInt j)
 {
   Vec            vj,vj1;
+  PetscBool      sketch;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(V,BV_CLASSID,1);
@@ -873,6 +881,7 @@ PetscErrorCode BVMatMultColumn(BV V,Mat A,PetscInt j)
   PetscCheck(j>=0,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_OUTOFRANGE,"Index j must be non-negative");
   PetscCheck(j+1<V->m,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_OUTOFRANGE,"Result should go in index j+1=%" PetscInt_FMT " but BV only has %" PetscInt_FMT " columns",j+1,V->m);
 
+  sketch = BV_SketchValid(V);
   PetscCall(PetscLogEventBegin(BV_MatMultVec,V,A,0,0));
   PetscCall(BVGetColumn(V,j,&vj));
   PetscCall(BVGetColumn(V,j+1,&vj1));
@@ -881,6 +890,7 @@ PetscErrorCode BVMatMultColumn(BV V,Mat A,PetscInt j)
   PetscCall(BVRestoreColumn(V,j+1,&vj1));
   PetscCall(PetscLogEventEnd(BV_MatMultVec,V,A,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)V));
+  PetscCall(BV_SketchKeep(V,sketch,j+1));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -12,6 +12,7 @@
 */
 
 #include <slepc/private/bvimpl.h>          /*I   "slepcbv.h"   I*/
+#include <slepcblaslapack.h>
 
 /*
    BV_NormVecOrColumn - Compute the 2-norm of the working vector, irrespective of
@@ -84,6 +85,21 @@ static PetscErrorCode BVOrthogonalizeMGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   BVDotVecNorm_Pipelined - Same as BVDotVec() followed by BVNormVec() but fusing
+   both in a single nonblocking reduction
+*/
+static inline PetscErrorCode BVDotVecNorm_Pipelined(BV bv,Vec v,PetscScalar *c,PetscReal *nrm)
+{
+  PetscFunctionBegin;
+  PetscCall(BVDotVecBegin(bv,v,c));
+  PetscCall(BVNormVecBegin(bv,v,NORM_2,nrm));
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)v)));
+  PetscCall(BVDotVecEnd(bv,v,c));
+  PetscCall(BVNormVecEnd(bv,v,NORM_2,nrm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    BVOrthogonalizeCGS1 - Compute |v'| (estimated), |v| and one step of CGS with
    only one global synchronization
@@ -91,6 +107,7 @@ static PetscErrorCode BVOrthogonalizeMGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
 static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *which,PetscScalar *h,PetscScalar *c,PetscReal *onorm,PetscReal *norm)
 {
   PetscReal      sum,beta;
+  PetscBool      hassum=PETSC_FALSE;
 
   PetscFunctionBegin;
   /* h = W^* v ; alpha = (v, v) */
@@ -98,8 +115,12 @@ static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
   if (onorm || norm) {
     if (!v) {
       PetscCall(BVDotColumnInc(bv,j,c));
-      PetscCall(BV_SquareRoot(bv,j,c,&beta));
-    } else {
+      /* h'*h is not modified by the update of v, get it together with alpha */
+      hassum = (norm && !bv->indef)? PETSC_TRUE: PETSC_FALSE;
+      if (hassum) PetscCall(BV_SquareRootSum(bv,j,c,&beta,&sum));
+      else PetscCall(BV_SquareRoot(bv,j,c,&beta));
+    } else if (bv->orthog_type==BV_ORTHOG_CGS_PIPELINED) PetscCall(BVDotVecNorm_Pipelined(bv,v,c,&beta));
+    else {
       PetscCall(BVDotVec(bv,v,c));
       PetscCall(BVNormVec(bv,v,NORM_2,&beta));
     }
@@ -121,7 +142,7 @@ static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
     if (PetscUnlikely(bv->indef)) PetscCall(BV_NormVecOrColumn(bv,j,v,norm));
     else {
       /* estimate |v'| from |v| */
-      PetscCall(BV_SquareSum(bv,j,c,&sum));
+      if (!hassum) PetscCall(BV_SquareSum(bv,j,c,&sum));
       *norm = beta*beta-sum;
       if (PetscUnlikely(*norm <= 0.0)) PetscCall(BV_NormVecOrColumn(bv,j,v,norm));
       else *norm = PetscSqrtReal(*norm);
@@ -131,10 +152,241 @@ static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-#define BVOrthogonalizeGS1(a,b,c,d,e,f,g,h) (bv->ops->gramschmidt?(*bv->ops->gramschmidt):(mgs?BVOrthogonalizeMGS1:BVOrthogonalizeCGS1))(a,b,c,d,e,f,g,h)
+/*
+   BVMatMultCGS1 - Compute w=A*v_{j-1} in column j and one step of CGS of w, as in
+   BVOrthogonalizeCGS1(). The inner products, including w'*w, are computed right after
+   the matrix-vector product while w is still fetched, and in the same operation if
+   the matrix provides the composed function "BVMatMultDot_C"
+*/
+static PetscErrorCode BVMatMultCGS1(BV bv,Mat A,PetscInt j,PetscReal *onorm,PetscReal *norm)
+{
+  PetscErrorCode    (*multdot)(Mat,Vec,Vec,PetscInt,const PetscScalar*,PetscInt,PetscScalar*)=NULL;
+  const PetscScalar *pv;
+  PetscScalar       *qq;
+  PetscReal         sum,beta;
+  PetscInt          nv=bv->nc+j+1;
+  PetscMPIInt       len,size;
+  PetscBool         flg=PETSC_FALSE;
+  Vec               v,w;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectQueryFunction((PetscObject)A,"BVMatMultDot_C",&multdot));
+  if (multdot && !bv->cuda && !bv->hip && !bv->reprored) PetscCall(PetscObjectTypeCompareAny((PetscObject)bv,&flg,BVSVEC,BVCONTIGUOUS,BVMAT,""));
+  PetscCall(BVGetColumn(bv,j-1,&v));
+  PetscCall(BVGetColumn(bv,j,&w));
+
+  /* w = A*v ; h = V'*w, where V includes w itself */
+  if (flg) {
+    PetscCall(BVAllocateWork_Private(bv,nv));
+    PetscCall(PetscLogEventBegin(BV_MatMultVec,bv,A,0,0));
+    PetscCall(BVGetArrayRead(bv,&pv));
+    PetscCall((*multdot)(A,v,w,nv,pv,bv->ld,bv->work));
+    PetscCall(BVRestoreArrayRead(bv,&pv));
+    PetscCall(PetscLogEventEnd(BV_MatMultVec,bv,A,0,0));
+    PetscCall(PetscLogEventBegin(BV_DotVec,bv,0,0,0));
+    PetscCall(VecGetArray(bv->buffer,&qq));
+    PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)bv),&size));
+    if (size>1) {
+      PetscCall(PetscMPIIntCast(nv,&len));
+      PetscCall(BVAllreduceSum_Private(bv,bv->work,qq,len));
+    } else PetscCall(PetscArraycpy(qq,bv->work,nv));
+    PetscCall(VecRestoreArray(bv->buffer,&qq));
+    PetscCall(PetscLogEventEnd(BV_DotVec,bv,0,0,0));
+  } else {
+    PetscCall(PetscLogEventBegin(BV_MatMultVec,bv,A,0,0));
+    PetscCall(MatMult(A,v,w));
+    PetscCall(PetscLogEventEnd(BV_MatMultVec,bv,A,0,0));
+    PetscCall(PetscLogEventBegin(BV_DotVec,bv,0,0,0));
+    bv->k = j+1;
+    PetscUseTypeMethod(bv,dotvec,w,NULL);
+    PetscCall(PetscLogEventEnd(BV_DotVec,bv,0,0,0));
+  }
+  PetscCall(BVRestoreColumn(bv,j-1,&v));
+  /* h'*h is not modified by the update of w, get it together with w'*w */
+  if (norm) PetscCall(BV_SquareRootSum(bv,j,NULL,&beta,&sum));
+  else PetscCall(BV_SquareRoot(bv,j,NULL,&beta));
+
+  /* w = w - V h */
+  bv->k = j;
+  PetscCall(PetscLogEventBegin(BV_MultVec,bv,0,0,0));
+  PetscUseTypeMethod(bv,multvec,-1.0,1.0,w,NULL);
+  PetscCall(PetscLogEventEnd(BV_MultVec,bv,0,0,0));
+  PetscCall(BVRestoreColumn(bv,j,&w));
+
+  /* estimate |w'| from |w| */
+  if (onorm) *onorm = beta;
+  if (norm) {
+    *norm = beta*beta-sum;
+    if (PetscUnlikely(*norm <= 0.0)) PetscCall(BVNormColumn(bv,j,NORM_2,norm));
+    else *norm = PetscSqrtReal(*norm);
+  }
+  PetscCall(BV_AddCoefficients(bv,j,NULL,NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* number of nonzeros per row of the sparse sign embedding, and sketch dimension per column */
+#define BV_SKETCH_NNZ    8
+#define BV_SKETCH_FACTOR 4
+
+/*
+   BV_SketchHash - Hash function (splitmix64) used to generate the sparse sign embedding,
+   so that the embedding depends only on the global row index and not on the distribution
+*/
+static inline unsigned long long BV_SketchHash(unsigned long long x)
+{
+  x += 0x9E3779B97F4A7C15ULL;
+  x  = (x^(x>>30))*0xBF58476D1CE4E5B9ULL;
+  x  = (x^(x>>27))*0x94D049BB133111EBULL;
+  return x^(x>>31);
+}
+
+/*
+   BV_SketchLocal - Add the contribution of the local part of z to the sketch s = Theta*z,
+   where Theta is a sparse sign embedding with BV_SKETCH_NNZ nonzeros per row
+*/
+static PetscErrorCode BV_SketchLocal(BV bv,Vec z,PetscScalar *s)
+{
+  PetscInt           i,l,n,rstart,t=bv->nsketch;
+  unsigned long long hv;
+  PetscReal          scal=1.0/PetscSqrtReal((PetscReal)BV_SKETCH_NNZ);
+  const PetscScalar  *pz;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetOwnershipRange(z,&rstart,NULL));
+  PetscCall(VecGetLocalSize(z,&n));
+  PetscCall(VecGetArrayRead(z,&pz));
+  for (i=0;i<n;i++) {
+    for (l=0;l<BV_SKETCH_NNZ;l++) {
+      hv = BV_SketchHash((unsigned long long)(rstart+i)*BV_SKETCH_NNZ+l);
+      if (hv&1) s[(hv>>1)%t] -= scal*pz[i];
+      else s[(hv>>1)%t] += scal*pz[i];
+    }
+  }
+  PetscCall(VecRestoreArrayRead(z,&pz));
+  PetscCall(PetscLogFlops(2.0*BV_SKETCH_NNZ*n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   BV_SketchColumns - Compute the sketch p of the working vector (either v or column j),
+   and update the cached sketches of columns -nc..j-1 that are out of date, all of them
+   with a single global reduction
+*/
+static PetscErrorCode BV_SketchColumns(BV bv,PetscInt j,Vec v,PetscScalar **p)
+{
+  PetscInt       i,i0,n=bv->nc+j,t,nw;
+  PetscMPIInt    len;
+  Vec            z;
+
+  PetscFunctionBegin;
+  if (!bv->sketch) {
+    bv->nsketch = BV_SKETCH_FACTOR*(bv->nc+bv->m);
+    PetscCall(PetscMalloc1(bv->nsketch*(bv->nc+bv->m+1),&bv->sketch));
+    bv->sketchk = 0;
+  } else if (!BV_SketchValid(bv)) bv->sketchk = 0;
+  t  = bv->nsketch;
+  i0 = PetscMin(bv->sketchk,n);
+  nw = n-i0+1;
+  PetscCall(BVAllocateWork_Private(bv,2*t*nw));
+  PetscCall(PetscArrayzero(bv->work,t*nw));
+  for (i=i0;i<n;i++) {
+    PetscCall(BVGetColumn(bv,i-bv->nc,&z));
+    PetscCall(BV_SketchLocal(bv,z,bv->work+(i-i0)*t));
+    PetscCall(BVRestoreColumn(bv,i-bv->nc,&z));
+  }
+  if (v) PetscCall(BV_SketchLocal(bv,v,bv->work+(n-i0)*t));
+  else {
+    PetscCall(BVGetColumn(bv,j,&z));
+    PetscCall(BV_SketchLocal(bv,z,bv->work+(n-i0)*t));
+    PetscCall(BVRestoreColumn(bv,j,&z));
+  }
+  PetscCall(PetscMPIIntCast(t*nw,&len));
+  PetscCall(BVAllreduceSum_Private(bv,bv->work,bv->work+t*nw,len));
+  PetscCall(PetscArraycpy(bv->sketch+i0*t,bv->work+t*nw,t*(nw-1)));
+  /* the sketch of v goes to the scratch column, the one of column j to its own slot */
+  *p = v? bv->sketch+(bv->nc+bv->m)*t: bv->sketch+n*t;
+  PetscCall(PetscArraycpy(*p,bv->work+t*nw+(n-i0)*t,t));
+  bv->sketchk = PetscMax(bv->sketchk,v?n:n+1);
+  PetscCall(PetscObjectStateGet((PetscObject)bv,&bv->sketchstate));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   BVOrthogonalizeRGS1 - Compute one step of randomized Gram-Schmidt, with only one
+   (small) global synchronization. The coefficients solve the least squares problem
+   min ||Theta*(v-V*c)||, which is done with the cached sketches S = Theta*V, assumed
+   to have orthonormal columns. The norms computed are those of the sketched vectors.
+*/
+static PetscErrorCode BVOrthogonalizeRGS1(BV bv,PetscInt j,Vec v,PetscBool *which,PetscScalar *h,PetscScalar *c,PetscReal *onorm,PetscReal *norm)
+{
+  PetscInt       n=bv->nc+j;
+  PetscBLASInt   t_,n_,one=1;
+  PetscScalar    *p,*cc=c,sone=1.0,smone=-1.0,szero=0.0;
+
+  PetscFunctionBegin;
+  (void)which; // avoid unused parameter warning
+  bv->k = j;
+  PetscCall(BV_SketchColumns(bv,j,v,&p));
+  PetscCall(PetscBLASIntCast(bv->nsketch,&t_));
+  PetscCall(PetscBLASIntCast(n,&n_));
+  if (onorm) *onorm = BLASnrm2_(&t_,p,&one);
+
+  /* c = S^* p ; s = p - S c */
+  if (!c) PetscCall(VecGetArray(bv->buffer,&cc));
+  if (n) {
+    PetscCallBLAS("BLASgemv",BLASgemv_("C",&t_,&n_,&sone,bv->sketch,&t_,p,&one,&szero,cc,&one));
+    PetscCallBLAS("BLASgemv",BLASgemv_("N",&t_,&n_,&smone,bv->sketch,&t_,cc,&one,&sone,p,&one));
+  }
+  if (!c) PetscCall(VecRestoreArray(bv->buffer,&cc));
+  PetscCall(PetscLogFlops(4.0*n*bv->nsketch));
+
+  /* q = v - V c */
+  if (!v) {
+    PetscCall(BVMultColumn(bv,-1.0,1.0,j,c));
+    PetscCall(PetscObjectStateGet((PetscObject)bv,&bv->sketchstate));
+  } else PetscCall(BVMultVec(bv,-1.0,1.0,v,c));
+
+  if (norm) *norm = BLASnrm2_(&t_,p,&one);
+  PetscCall(BV_AddCoefficients(bv,j,h,c));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   BV_SketchMultInPlace - Update the cached sketches after BVMultInPlace(), which computed
+   V(:,s:e-1) = V(:,l:k-1)*Q(l:k-1,s:e-1). The flag valid must be BV_SketchValid(V) as
+   evaluated before the operation.
+*/
+PetscErrorCode BV_SketchMultInPlace(BV V,PetscBool valid,Mat Q,PetscInt s,PetscInt e)
+{
+  PetscInt          ldq,t=V->nsketch;
+  PetscBLASInt      t_,m_,n_,ldq_;
+  PetscScalar       sone=1.0,szero=0.0;
+  const PetscScalar *q;
+
+  PetscFunctionBegin;
+  if (!valid || V->sketchk<V->nc+V->k || V->sketchk<V->nc+s) PetscFunctionReturn(PETSC_SUCCESS);
+  if (s<e && V->l<V->k) {
+    PetscCall(MatDenseGetLDA(Q,&ldq));
+    PetscCall(PetscBLASIntCast(t,&t_));
+    PetscCall(PetscBLASIntCast(e-s,&m_));
+    PetscCall(PetscBLASIntCast(V->k-V->l,&n_));
+    PetscCall(PetscBLASIntCast(ldq,&ldq_));
+    PetscCall(BVAllocateWork_Private(V,t*(e-s)));
+    PetscCall(MatDenseGetArrayRead(Q,&q));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&t_,&m_,&n_,&sone,V->sketch+(V->nc+V->l)*t,&t_,q+s*ldq+V->l,&ldq_,&szero,V->work,&t_));
+    PetscCall(MatDenseRestoreArrayRead(Q,&q));
+    PetscCall(PetscArraycpy(V->sketch+(V->nc+s)*t,V->work,t*(e-s)));
+    PetscCall(PetscLogFlops(2.0*t*(e-s)*(V->k-V->l)));
+  }
+  V->sketchk = PetscMax(V->sketchk,V->nc+e);
+  PetscCall(PetscObjectStateGet((PetscObject)V,&V->sketchstate));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#define BVOrthogonalizeGS1(a,b,c,d,e,f,g,h) (bv->ops->gramschmidt?(*bv->ops->gramschmidt):(mgs?BVOrthogonalizeMGS1:(rgs?BVOrthogonalizeRGS1:BVOrthogonalizeCGS1)))(a,b,c,d,e,f,g,h)
 
 /*
-   BVOrthogonalizeGS - Orthogonalize with (classical or modified) Gram-Schmidt
+   BVOrthogonalizeGS - Orthogonalize with (classical, modified or randomized) Gram-Schmidt
 
    j      - the index of the column to orthogonalize (cannot use both j and v)
    v      - the vector to orthogonalize (cannot use both j and v)
@@ -144,10 +396,11 @@ static PetscErrorCode BVOrthogonalizeCGS1(BV bv,PetscInt j,Vec v,PetscBool *whic
 */
 static PetscErrorCode BVOrthogonalizeGS(BV bv,PetscInt j,Vec v,PetscBool *which,PetscReal *norm,PetscBool *lindep)
 {
-  PetscScalar    *h,*c,*omega;
-  PetscReal      onrm,nrm;
-  PetscInt       k,l;
-  PetscBool      mgs,dolindep,signature;
+  PetscScalar        *h,*c,*omega;
+  PetscReal          onrm,nrm;
+  PetscInt           k,l;
+  PetscBool          mgs,rgs,dolindep,signature;
+  BVOrthogRefineType ref;
 
   PetscFunctionBegin;
   if (v) {
@@ -161,6 +414,7 @@ static PetscErrorCode BVOrthogonalizeGS(BV bv,PetscInt j,Vec v,PetscBool *which,
   }
 
   mgs = (bv->orthog_type==BV_ORTHOG_MGS)? PETSC_TRUE: PETSC_FALSE;
+  rgs = (bv->orthog_type==BV_ORTHOG_RGS && !bv->matrix)? PETSC_TRUE: PETSC_FALSE;
 
   /* if indefinite inner product, skip the computation of lindep */
   if (bv->indef && lindep) *lindep = PETSC_FALSE;
@@ -171,7 +425,9 @@ static PetscErrorCode BVOrthogonalizeGS(BV bv,PetscInt j,Vec v,PetscBool *which,
 
   PetscCall(BV_CleanCoefficients(bv,k,h));
 
-  switch (bv->orthog_ref) {
+  /* DCGS2 is CGS2 when it is not delayed */
+  ref = (bv->orthog_type==BV_ORTHOG_DCGS2)? BV_ORTHOG_REFINE_ALWAYS: bv->orthog_ref;
+  switch (ref) {
 
   case BV_ORTHOG_REFINE_IFNEEDED:
     PetscCall(BVOrthogonalizeGS1(bv,k,v,which,h,c,&onrm,&nrm));
@@ -187,9 +443,12 @@ static PetscErrorCode BVOrthogonalizeGS(BV bv,PetscInt j,Vec v,PetscBool *which,
     break;
 
   case BV_ORTHOG_REFINE_NEVER:
-    PetscCall(BVOrthogonalizeGS1(bv,k,v,which,h,c,NULL,NULL));
-    /* compute ||v|| */
-    if (norm || dolindep || signature) PetscCall(BV_NormVecOrColumn(bv,k,v,&nrm));
+    /* compute ||v|| (with RGS, the norm of the sketch) */
+    if (rgs) PetscCall(BVOrthogonalizeGS1(bv,k,v,which,h,c,NULL,(norm||dolindep)?&nrm:NULL));
+    else {
+      PetscCall(BVOrthogonalizeGS1(bv,k,v,which,h,c,NULL,NULL));
+      if (norm || dolindep || signature) PetscCall(BV_NormVecOrColumn(bv,k,v,&nrm));
+    }
     /* linear dependence check: just test for exactly zero norm */
     if (dolindep) *lindep = PetscNot(nrm);
     break;
@@ -315,6 +574,7 @@ PetscErrorCode BVOrthogonalizeVec(BV bv,Vec v,PetscScalar *H,PetscReal *norm,Pet
 PetscErrorCode BVOrthogonalizeColumn(BV bv,PetscInt j,PetscScalar *H,PetscReal *norm,PetscBool *lindep)
 {
   PetscInt       ksave,lsave;
+  PetscBool      sketch;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
@@ -331,11 +591,13 @@ PetscErrorCode BVOrthogonalizeColumn(BV bv,PetscInt j,PetscScalar *H,PetscReal *
   if (!bv->buffer) PetscCall(BVGetBufferVec(bv,&bv->buffer));
   PetscCall(BV_AllocateSignature(bv));
   PetscCall(BVOrthogonalizeGS(bv,j,NULL,NULL,norm,lindep));
+  sketch = BV_SketchValid(bv);
   bv->k = ksave;
   bv->l = lsave;
   if (H) PetscCall(BV_StoreCoefficients(bv,j,NULL,H));
   PetscCall(PetscLogEventEnd(BV_OrthogonalizeVec,bv,0,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+  PetscCall(BV_SketchKeep(bv,sketch,bv->m));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -379,10 +641,10 @@ PetscErrorCode BVOrthogonalizeColumn(BV bv,PetscInt j,PetscScalar *H,PetscReal *
 @*/
 PetscErrorCode BVOrthonormalizeColumn(BV bv,PetscInt j,PetscBool replace,PetscReal *norm,PetscBool *lindep)
 {
-  PetscScalar    alpha;
+  PetscScalar    alpha=1.0;
   PetscReal      nrm;
   PetscInt       ksave,lsave;
-  PetscBool      lndep;
+  PetscBool      lndep,sketch;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(bv,BV_CLASSID,1);
@@ -409,6 +671,7 @@ PetscErrorCode BVOrthonormalizeColumn(BV bv,PetscInt j,PetscBool replace,PetscRe
       PetscCall(BVOrthogonalizeGS(bv,j,NULL,NULL,&nrm,&lndep));
     }
   }
+  sketch = BV_SketchValid(bv);
   bv->k = ksave;
   bv->l = lsave;
   PetscCall(PetscLogEventEnd(BV_OrthogonalizeVec,bv,0,0,0));
@@ -423,6 +686,124 @@ PetscErrorCode BVOrthonormalizeColumn(BV bv,PetscInt j,PetscBool replace,PetscRe
   if (norm) *norm = nrm;
   if (lindep) *lindep = lndep;
   PetscCall(PetscObjectStateIncrease((PetscObject)bv));
+  PetscCall(BV_SketchScaleColumn(bv,sketch,j,alpha));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   BVMatMultOrthonormalizeColumn - Computes the matrix-vector product for a
+   specified column, storing the result in the next column v_{j+1}=A*v_j, and
+   orthonormalizes it with respect to the previous columns.
+
+   Neighbor-wise Collective
+
+   Input Parameters:
++  V - basis vectors context
+.  A - the matrix
+-  j - the column
+
+   Output Parameters:
++  norm   - (optional) norm of the vector after orthogonalization and before normalization
+-  lindep - (optional) flag indicating that linear dependence was determined during
+            orthogonalization
+
+   Notes:
+   This is equivalent to a call to BVMatMultColumn() followed by a call to
+   BVOrthonormalizeColumn() for column j+1 (with replace=PETSC_FALSE), but
+   with classical Gram-Schmidt the two operations are fused in a single pass,
+   so that the inner products of the first step of Gram-Schmidt are computed
+   right after the matrix-vector product, while the new vector is still fetched.
+   The orthogonalization coefficients are stored in the internal buffer as in
+   BVOrthonormalizeColumn(). With other orthogonalization types, or with a
+   non-standard inner product, the two operations are done separately.
+
+   A matrix-free operator can compute the local inner products in the same
+   loop as the matrix-vector product, by composing with the matrix a function
+   "BVMatMultDot_C" with the calling sequence
+.vb
+   PetscErrorCode multdot(Mat A,Vec x,Vec y,PetscInt nv,const PetscScalar *W,PetscInt ldw,PetscScalar *c)
+.ve
+   that computes y=A*x and then c[i] = W(:,i)'*y, for i=0,...,nv-1, with
+   the local rows only. W is the local part of the columns of V, including the
+   constraints, stored by columns with leading dimension ldw, and its last
+   column is y itself. This is used with BVSVEC, BVCONTIGUOUS and BVMAT in the CPU.
+
+   Level: advanced
+
+.seealso: BVMatMultColumn(), BVOrthonormalizeColumn(), BVMatArnoldi(), BVSetOrthogonalization()
+@*/
+PetscErrorCode BVMatMultOrthonormalizeColumn(BV V,Mat A,PetscInt j,PetscReal *norm,PetscBool *lindep)
+{
+  PetscScalar    alpha=1.0;
+  PetscReal      onrm,nrm;
+  PetscInt       ksave,lsave,l;
+  PetscBool      dolindep,lndep=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(V,BV_CLASSID,1);
+  PetscValidType(V,1);
+  BVCheckSizes(V,1);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,2);
+  PetscCheckSameComm(V,1,A,2);
+  PetscValidLogicalCollectiveInt(V,j,3);
+  PetscCheck(j>=0,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_OUTOFRANGE,"Index j must be non-negative");
+  PetscCheck(j+1<V->m,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_OUTOFRANGE,"Result should go in index j+1=%" PetscInt_FMT " but BV only has %" PetscInt_FMT " columns",j+1,V->m);
+
+  if (PetscUnlikely((V->orthog_type!=BV_ORTHOG_CGS && V->orthog_type!=BV_ORTHOG_CGS_PIPELINED && V->orthog_type!=BV_ORTHOG_DCGS2) || V->matrix)) {
+    PetscCall(BVMatMultColumn(V,A,j));
+    PetscCall(BVOrthonormalizeColumn(V,j+1,PETSC_FALSE,norm,lindep));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  /* orthogonalize, the first step of CGS is fused with the matrix-vector product */
+  PetscCall(PetscLogEventBegin(BV_OrthogonalizeVec,V,0,0,0));
+  ksave = V->k;
+  lsave = V->l;
+  V->l = -V->nc;  /* must also orthogonalize against constraints and leading columns */
+  if (!V->buffer) PetscCall(BVGetBufferVec(V,&V->buffer));
+  dolindep = lindep? PETSC_TRUE: PETSC_FALSE;
+  PetscCall(BV_CleanCoefficients(V,j+1,NULL));
+  switch ((V->orthog_type==BV_ORTHOG_DCGS2)? BV_ORTHOG_REFINE_ALWAYS: V->orthog_ref) {
+
+  case BV_ORTHOG_REFINE_IFNEEDED:
+    PetscCall(BVMatMultCGS1(V,A,j+1,&onrm,&nrm));
+    /* repeat if ||q|| < eta ||h|| */
+    l = 1;
+    while (l<3 && nrm && PetscAbsReal(nrm) < V->orthog_eta*PetscAbsReal(onrm)) {
+      l++;
+      PetscCall(BVOrthogonalizeCGS1(V,j+1,NULL,NULL,NULL,NULL,&onrm,&nrm));
+    }
+    lndep = PetscNot(nrm && PetscAbsReal(nrm) >= V->orthog_eta*PetscAbsReal(onrm));
+    break;
+
+  case BV_ORTHOG_REFINE_NEVER:
+    PetscCall(BVMatMultCGS1(V,A,j+1,NULL,NULL));
+    PetscCall(BVNormColumn(V,j+1,NORM_2,&nrm));
+    lndep = PetscNot(nrm);
+    break;
+
+  case BV_ORTHOG_REFINE_ALWAYS:
+    PetscCall(BVMatMultCGS1(V,A,j+1,NULL,NULL));
+    PetscCall(BVOrthogonalizeCGS1(V,j+1,NULL,NULL,NULL,NULL,dolindep?&onrm:NULL,&nrm));
+    if (dolindep) lndep = PetscNot(nrm && PetscAbsReal(nrm) >= V->orthog_eta*PetscAbsReal(onrm));
+    break;
+  }
+  /* store norm value next to the orthogonalization coefficients */
+  PetscCall(BV_SetValue(V,j+1,j+1,NULL,(dolindep && lndep)? 0.0: nrm));
+  V->k = ksave;
+  V->l = lsave;
+  PetscCall(PetscLogEventEnd(BV_OrthogonalizeVec,V,0,0,0));
+
+  /* scale */
+  if (nrm!=1.0 && nrm!=0.0) {
+    alpha = 1.0/nrm;
+    PetscCall(PetscLogEventBegin(BV_Scale,V,0,0,0));
+    PetscUseTypeMethod(V,scale,j+1,alpha);
+    PetscCall(PetscLogEventEnd(BV_Scale,V,0,0,0));
+  }
+  if (norm) *norm = nrm;
+  if (lindep) *lindep = lndep;
+  PetscCall(PetscObjectStateIncrease((PetscObject)V));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -501,6 +882,39 @@ static PetscErrorCode BVOrthogonalize_BlockGS(BV V,Mat R)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Project the active columns onto the orthogonal complement of the constraints
+   with block Gram-Schmidt, V2 = V2 - C*(C'*V2), repeated twice unless refinement
+   is disabled. The constraints are copied once to a regular BV that is kept in
+   V->cnstr until they change, so that each product is a single BVDot/BVMult.
+ */
+static PetscErrorCode BVOrthogonalize_Constraints(BV V)
+{
+  PetscInt       i,npass;
+  Mat            M;
+  Vec            v;
+
+  PetscFunctionBegin;
+  if (V->cnstr && V->cnstr->matrix!=V->matrix) PetscCall(BVDestroy(&V->cnstr));
+  if (!V->cnstr) {
+    PetscCall(BVDuplicateResize(V,V->nc,&V->cnstr));
+    for (i=0;i<V->nc;i++) {
+      PetscCall(BVGetColumn(V,i-V->nc,&v));
+      PetscCall(BVInsertVec(V->cnstr,i,v));
+      PetscCall(BVRestoreColumn(V,i-V->nc,&v));
+    }
+  }
+  PetscCall(BVSetActiveColumns(V->cnstr,0,V->nc));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,V->nc,V->k,NULL,&M));
+  npass = (V->orthog_ref==BV_ORTHOG_REFINE_NEVER)? 1: 2;
+  for (i=0;i<npass;i++) {
+    PetscCall(BVDot(V,V->cnstr,M));
+    PetscCall(BVMult(V,-1.0,1.0,V->cnstr,M));
+  }
+  PetscCall(MatDestroy(&M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Orthogonalize a set of vectors with Gram-Schmidt, column by column.
  */
@@ -531,13 +945,13 @@ static PetscErrorCode BVOrthogonalize_GS(BV V,Mat R)
     if (R) {
       PetscCall(BVOrthogonalizeColumn(V,j,NULL,&norm,NULL));
       lsave = V->l;
-      V->l = -V->nc;
+      V->l = 0;  /* the coefficients of the constraints are not stored in R */
       PetscCall(BV_StoreCoefficients(V,j,NULL,r+j*ldr));
       V->l = lsave;
       r[j+j*ldr] = norm;
     } else PetscCall(BVOrthogonalizeColumn(V,j,NULL,&norm,NULL));
     PetscCheck(norm,PetscObjectComm((PetscObject)V),PETSC_ERR_CONV_FAILED,"Breakdown in BVOrthogonalize due to a linearly dependent column");
-    if (V->matrix && V->orthog_type==BV_ORTHOG_CGS) {  /* fill cached BV */
+    if (V->matrix && (V->orthog_type==BV_ORTHOG_CGS || V->orthog_type==BV_ORTHOG_DCGS2)) {  /* fill cached BV */
       PetscCall(BVGetColumn(V->cached,j,&v));
       PetscCall(VecCopy(V->Bx,v));
       PetscCall(BVRestoreColumn(V->cached,j,&v));
@@ -583,7 +997,7 @@ static inline PetscErrorCode BV_StoreCoeffsBlock_Default(BV bv,Mat R,PetscBool t
   PetscCall(MatDenseGetArray(R,&rr));
   ldb  = bv->m+bv->nc;
   PetscCall(VecGetArrayRead(bv->buffer,&bb));
-  for (j=bv->l;j<bv->k;j++) PetscCall(PetscArraycpy(rr+j*ldr,bb+j*ldb,(tri?(j+1):bv->k)+bv->nc));
+  for (j=bv->l;j<bv->k;j++) PetscCall(PetscArraycpy(rr+j*ldr,bb+j*ldb,tri?(j+1):bv->k));
   PetscCall(VecRestoreArrayRead(bv->buffer,&bb));
   PetscCall(MatDenseRestoreArray(R,&rr));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -609,6 +1023,50 @@ static PetscErrorCode BVOrthogonalize_Chol(BV V,Mat Rin)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Orthogonalize a set of vectors with repeated Cholesky QR (CholQR2), or with
+   shifted Cholesky QR followed by CholQR2 (shifted CholQR3). In each pass we
+   compute R_p=chol(V'*V) and V=V*inv(R_p), the overall factor being the product
+   of all R_p. The shift of the first pass, s = 11*(N*n+n*(n+1))*eps*trace(V'*V),
+   guarantees that the Cholesky factorization does not break down
+ */
+static PetscErrorCode BVOrthogonalize_CholQR(BV V,Mat Rin,PetscBool shifted)
+{
+  Mat            R,G,S,W=NULL;
+  PetscInt       i,p,n=V->k-V->l,ld;
+  PetscScalar    *pr;
+  PetscReal      trace=0.0,shift;
+
+  PetscFunctionBegin;
+  PetscCall(BV_GetBufferMat(V));
+  R = V->Abuffer;
+  PetscCall(MatDuplicate(R,MAT_DO_NOT_COPY_VALUES,&G));
+  if (Rin) S = Rin;   /* use Rin as a workspace for S */
+  else {
+    PetscCall(MatDuplicate(R,MAT_DO_NOT_COPY_VALUES,&W));
+    S = W;
+  }
+  if (V->l) PetscCall(BVOrthogonalize_BlockGS(V,R));
+  for (p=0;p<(shifted?3:2);p++) {
+    PetscCall(BVDot(V,V,p?G:R));
+    if (shifted && !p) {
+      PetscCall(MatGetSize(R,&ld,NULL));
+      PetscCall(MatDenseGetArray(R,&pr));
+      for (i=V->l;i<V->k;i++) trace += PetscRealPart(pr[i+i*ld]);
+      shift = 11.0*((PetscReal)V->N*n+n*(n+1))*PETSC_MACHINE_EPSILON*trace;
+      for (i=V->l;i<V->k;i++) pr[i+i*ld] += shift;
+      PetscCall(MatDenseRestoreArray(R,&pr));
+    }
+    PetscCall(BVMatCholInv_LAPACK_Private(V,p?G:R,S));
+    PetscCall(BVMultInPlace(V,S,V->l,V->k));
+    if (p) PetscCall(BVMatTriMult_LAPACK_Private(V,G,R));
+  }
+  PetscCall(MatDestroy(&G));
+  PetscCall(MatDestroy(&W));
+  if (Rin) PetscCall(BV_StoreCoeffsBlock_Default(V,Rin,PETSC_TRUE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Orthogonalize a set of vectors with the Tall-Skinny QR method
  */
@@ -713,6 +1171,19 @@ static PetscErrorCode BVOrthogonalize_SVQB(BV V,Mat Rin)
    column with successive calls to BVOrthogonalizeColumn(). Note that in the
    SVQB method the R factor is not upper triangular.
 
+   If V has constraints (see BVInsertConstraints()), the active columns are
+   also orthogonalized against them, and the corresponding coefficients are not
+   stored in R. With GS this is done column by column, as in BVOrthogonalizeColumn().
+   The other methods first project all active columns at once, with two passes
+   of block Gram-Schmidt (one if refinement is disabled with BVSetOrthogonalization())
+   using a copy of the constraints that is kept in V until they are modified.
+
+   The CHOLQR2 method applies Cholesky QR twice, which is as accurate as TSQR
+   provided that V is not too ill-conditioned (condition number below the square
+   root of the inverse of the machine epsilon), with only two global reductions.
+   SCHOLQR3 adds a first pass of Cholesky QR with a diagonal shift, so that it
+   can also handle ill-conditioned V, at the cost of one more reduction.
+
    If V is rank-deficient or very ill-conditioned, that is, one or more columns are
    (almost) linearly dependent with respect to the rest, then the algorithm may
    break down or result in larger numerical error. Linearly dependent columns are
@@ -721,7 +1192,7 @@ static PetscErrorCode BVOrthogonalize_SVQB(BV V,Mat Rin)
 
    Level: intermediate
 
-.seealso: BVOrthogonalizeColumn(), BVOrthogonalizeVec(), BVSetMatrix(), BVSetActiveColumns(), BVSetOrthogonalization(), BVOrthogBlockType
+.seealso: BVOrthogonalizeColumn(), BVOrthogonalizeVec(), BVSetMatrix(), BVSetActiveColumns(), BVSetOrthogonalization(), BVOrthogBlockType, BVInsertConstraints()
 @*/
 PetscErrorCode BVOrthogonalize(BV V,Mat R)
 {
@@ -739,9 +1210,9 @@ PetscErrorCode BVOrthogonalize(BV V,Mat R)
     PetscCheck(m==n,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Mat argument is not square, it has %" PetscInt_FMT " rows and %" PetscInt_FMT " columns",m,n);
     PetscCheck(n>=V->k,PetscObjectComm((PetscObject)V),PETSC_ERR_ARG_SIZ,"Mat size %" PetscInt_FMT " is smaller than the number of BV active columns %" PetscInt_FMT,n,V->k);
   }
-  PetscCheck(!V->nc,PetscObjectComm((PetscObject)V),PETSC_ERR_SUP,"Not implemented for BV with constraints, use BVOrthogonalizeColumn() instead");
 
   PetscCall(PetscLogEventBegin(BV_Orthogonalize,V,R,0,0));
+  if (V->nc && V->orthog_block!=BV_ORTHOG_BLOCK_GS) PetscCall(BVOrthogonalize_Constraints(V));
   switch (V->orthog_block) {
   case BV_ORTHOG_BLOCK_GS: /* proceed column by column with Gram-Schmidt */
     PetscCall(BVOrthogonalize_GS(V,R));
@@ -760,6 +1231,12 @@ PetscErrorCode BVOrthogonalize(BV V,Mat R)
   case BV_ORTHOG_BLOCK_SVQB:
     PetscCall(BVOrthogonalize_SVQB(V,R));
     break;
+  case BV_ORTHOG_BLOCK_CHOLQR2:
+    PetscCall(BVOrthogonalize_CholQR(V,R,PETSC_FALSE));
+    break;
+  case BV_ORTHOG_BLOCK_SCHOLQR3:
+    PetscCall(BVOrthogonalize_CholQR(V,R,PETSC_TRUE));
+    break;
   }
   PetscCall(PetscLogEventEnd(BV_Orthogonalize,V,R,0,0));
   PetscCall(PetscObjectStateIncrease((PetscObject)V));
@@ -15,6 +15,9 @@ SLEPC_EXTERN PetscErrorCode BVCreate_Contiguous(BV);
 SLEPC_EXTERN PetscErrorCode BVCreate_Svec(BV);
 SLEPC_EXTERN PetscErrorCode BVCreate_Mat(BV);
 SLEPC_EXTERN PetscErrorCode BVCreate_Tensor(BV);
+SLEPC_EXTERN PetscErrorCode BVCreate_Mixed(BV);
+SLEPC_EXTERN PetscErrorCode BVCreate_Mmap(BV);
+SLEPC_EXTERN PetscErrorCode BVCreate_Panel(BV);
 
 /*@C
    BVRegisterAll - Registers all of the storage variants in the BV package.
@@ -35,5 +38,8 @@ PetscErrorCode BVRegisterAll(void)
   PetscCall(BVRegister(BVSVEC,BVCreate_Svec));
   PetscCall(BVRegister(BVMAT,BVCreate_Mat));
   PetscCall(BVRegister(BVTENSOR,BVCreate_Tensor));
+  PetscCall(BVRegister(BVMIXED,BVCreate_Mixed));
+  PetscCall(BVRegister(BVMMAP,BVCreate_Mmap));
+  PetscCall(BVRegister(BVPANEL,BVCreate_Panel));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
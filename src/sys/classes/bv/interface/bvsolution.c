@@ -0,0 +1,235 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   Solution files: the computed values, error estimates and vectors of a solver,
+   stored in a single file so that the vectors can be mapped to a BVMMAP
+
+   The file starts with a header of PetscInt64 entries:
+     cookie, sizeof(PetscScalar), sizeof(PetscReal), n, nbv, number of processes,
+     for each BV: global size N, number of columns k, offset of its data in bytes,
+     for each BV: the local size and leading dimension in each process,
+   followed by the n values (real parts), the n imaginary parts (PetscScalar) and
+   the n error estimates (PetscReal). Then, at offsets that are multiple of
+   SLEPC_SOLUTION_ALIGN, the data of each BV as expected by BVMmapSetFile().
+   The data are written in the native binary representation of the machine.
+*/
+
+#include <slepc/private/bvimpl.h>      /*I "slepcbv.h" I*/
+
+#define SLEPC_SOLUTION_FILE_CLASSID 1211260
+#define SLEPC_SOLUTION_ALIGN        65536
+#define SLEPC_SOLUTION_MAXBV        2
+
+static inline PetscInt64 SlepcSolutionAlign(PetscInt64 off)
+{
+  return ((off+SLEPC_SOLUTION_ALIGN-1)/SLEPC_SOLUTION_ALIGN)*SLEPC_SOLUTION_ALIGN;
+}
+
+/*
+   SlepcSolutionSave_Private - Writes a solution file with n values and error estimates,
+   and the active columns of nbv BV objects (at most SLEPC_SOLUTION_MAXBV). All arrays
+   are significant in process 0 only.
+*/
+PetscErrorCode SlepcSolutionSave_Private(PetscObject obj,const char filename[],PetscInt n,PetscScalar *eigr,PetscScalar *eigi,PetscReal *errest,PetscInt nbv,BV bvs[])
+{
+  MPI_Comm       comm = PetscObjectComm(obj);
+  PetscMPIInt    rank,size;
+  PetscInt64     *head,loc[2],off;
+  PetscInt       b,j,l,k,nloc,N,ld,nh;
+  BV             X[SLEPC_SOLUTION_MAXBV];
+  Vec            x;
+  FILE           *fp;
+
+  PetscFunctionBegin;
+  PetscCheck(nbv>=0 && nbv<=SLEPC_SOLUTION_MAXBV,comm,PETSC_ERR_ARG_OUTOFRANGE,"Wrong number of BV objects");
+  PetscCallMPI(MPI_Comm_rank(comm,&rank));
+  PetscCallMPI(MPI_Comm_size(comm,&size));
+  nh = 6+nbv*(3+2*size);
+  PetscCall(PetscCalloc1(nh,&head));
+  head[0] = SLEPC_SOLUTION_FILE_CLASSID;
+  head[1] = sizeof(PetscScalar);
+  head[2] = sizeof(PetscReal);
+  head[3] = n;
+  head[4] = nbv;
+  head[5] = size;
+  off = SlepcSolutionAlign(nh*sizeof(PetscInt64)+n*(2*sizeof(PetscScalar)+sizeof(PetscReal)));
+  for (b=0;b<nbv;b++) {
+    /* the vectors are copied to a BV that is mapped to the file, with the same layout */
+    PetscCall(BVGetActiveColumns(bvs[b],&l,&k));
+    PetscCall(BVGetSizes(bvs[b],&nloc,&N,NULL));
+    PetscCall(BVCreate(comm,&X[b]));
+    PetscCall(BVSetSizes(X[b],nloc,N,PetscMax(k-l,1)));
+    PetscCall(BVSetVecType(X[b],VECSTANDARD));
+    PetscCall(BVSetType(X[b],BVMMAP));
+    PetscCall(BVGetLeadingDimension(X[b],&ld));
+    loc[0] = nloc;
+    loc[1] = ld;
+    PetscCallMPI(MPI_Allgather(loc,2,MPIU_INT64,head+6+nbv*3+b*2*size,2,MPIU_INT64,comm));
+    head[6+3*b]   = N;
+    head[6+3*b+1] = k-l;
+    head[6+3*b+2] = off;
+    for (j=0;j<size;j++) off += head[6+nbv*3+b*2*size+2*j+1]*(k-l)*(PetscInt64)sizeof(PetscScalar);
+    off = SlepcSolutionAlign(off);
+  }
+
+  /* header and values, written by the first process */
+  if (!rank) {
+    fp = fopen(filename,"wb");
+    PetscCheck(fp,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to open file %s",filename);
+    PetscCheck(fwrite(head,sizeof(PetscInt64),nh,fp)==(size_t)nh,PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Error writing to file %s",filename);
+    if (n) {
+      PetscCheck(fwrite(eigr,sizeof(PetscScalar),n,fp)==(size_t)n,PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Error writing to file %s",filename);
+      PetscCheck(fwrite(eigi,sizeof(PetscScalar),n,fp)==(size_t)n,PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Error writing to file %s",filename);
+      PetscCheck(fwrite(errest,sizeof(PetscReal),n,fp)==(size_t)n,PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Error writing to file %s",filename);
+    }
+    PetscCheck(!fclose(fp),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to close file %s",filename);
+  }
+
+  /* vectors */
+  for (b=0;b<nbv;b++) {
+    PetscCall(BVGetActiveColumns(bvs[b],&l,&k));
+    if (k>l) {
+      PetscCall(BVMmapSetFile(X[b],filename,head[6+3*b+2]));
+      for (j=l;j<k;j++) {
+        PetscCall(BVGetColumn(X[b],j-l,&x));
+        PetscCall(BVCopyVec(bvs[b],j,x));
+        PetscCall(BVRestoreColumn(X[b],j-l,&x));
+      }
+    }
+    PetscCall(BVDestroy(&X[b]));
+  }
+  PetscCall(PetscFree(head));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode SlepcSolutionCreateBV(MPI_Comm comm,const char filename[],PetscInt64 *head,PetscInt b,BV *X)
+{
+  PetscMPIInt    rank,size;
+  PetscInt       nbv=(PetscInt)head[4],k=(PetscInt)head[6+3*b+1],ld;
+  PetscInt64     *loc;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(comm,&rank));
+  PetscCallMPI(MPI_Comm_size(comm,&size));
+  loc = head+6+nbv*3+b*2*size+2*rank;
+  PetscCall(BVCreate(comm,X));
+  PetscCall(BVSetSizes(*X,(PetscInt)loc[0],(PetscInt)head[6+3*b],PetscMax(k,1)));
+  PetscCall(BVSetVecType(*X,VECSTANDARD));
+  PetscCall(BVSetType(*X,BVMMAP));
+  PetscCall(BVGetLeadingDimension(*X,&ld));
+  PetscCheck(ld==loc[1],PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"File %s was written with a different leading dimension",filename);
+  if (k) PetscCall(BVMmapSetFile(*X,filename,head[6+3*b+2]));
+  PetscCall(BVSetActiveColumns(*X,0,k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   SlepcLoadSolution - Loads the solution stored in a file by EPSSaveSolution(),
+   SVDSaveSolution() or PEPSaveSolution().
+
+   Collective
+
+   Input Parameters:
++  comm     - the communicator, with the same number of processes that saved the file
+-  filename - name of the file
+
+   Output Parameters:
++  n      - number of values
+.  eigr   - real part of the values (or singular values)
+.  eigi   - imaginary part of the values
+.  errest - error estimates
+.  X      - basis vectors with the eigenvectors or right singular vectors
+-  Y      - basis vectors with the left singular vectors (only for SVD)
+
+   Notes:
+   Any of the output arguments can be NULL. The arrays must be freed by the user
+   with PetscFree(), and the basis vectors with BVDestroy().
+
+   The vectors are not read, X and Y are of type BVMMAP with the storage mapped
+   to the file, see BVMmapSetFile(), so the columns are loaded on demand when
+   they are accessed. Note that modifying X or Y modifies the file.
+
+   The file is written with the native binary representation, so it must be
+   loaded on a machine with the same one, and with the same number of processes
+   and scalar type. The local sizes of the basis vectors are the ones used when
+   saving the file.
+
+   Level: intermediate
+
+.seealso: EPSSaveSolution(), SVDSaveSolution(), PEPSaveSolution(), BVMmapSetFile()
+@*/
+PetscErrorCode SlepcLoadSolution(MPI_Comm comm,const char filename[],PetscInt *n,PetscScalar *eigr[],PetscScalar *eigi[],PetscReal *errest[],BV *X,BV *Y)
+{
+  PetscMPIInt    rank,size;
+  PetscInt64     h[6],*head;
+  PetscInt       nv,nbv,nh;
+  PetscScalar    *er,*ei;
+  PetscReal      *err;
+  FILE           *fp=NULL;
+
+  PetscFunctionBegin;
+  PetscAssertPointer(filename,2);
+  PetscCallMPI(MPI_Comm_rank(comm,&rank));
+  PetscCallMPI(MPI_Comm_size(comm,&size));
+  if (!rank) {
+    fp = fopen(filename,"rb");
+    PetscCheck(fp,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to open file %s",filename);
+    PetscCheck(fread(h,sizeof(PetscInt64),6,fp)==6,PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Error reading file %s",filename);
+  }
+  PetscCallMPI(MPI_Bcast(h,6,MPIU_INT64,0,comm));
+  PetscCheck(h[0]==SLEPC_SOLUTION_FILE_CLASSID,comm,PETSC_ERR_FILE_UNEXPECTED,"File %s is not a SLEPc solution file",filename);
+  PetscCheck(h[1]==sizeof(PetscScalar) && h[2]==sizeof(PetscReal),comm,PETSC_ERR_FILE_UNEXPECTED,"File %s was written with a different scalar type",filename);
+  PetscCheck(h[5]==size,comm,PETSC_ERR_ARG_SIZ,"File %s was written with %" PetscInt64_FMT " processes, cannot load it with %d",filename,h[5],size);
+  nv  = (PetscInt)h[3];
+  nbv = (PetscInt)h[4];
+  nh  = 6+nbv*(3+2*size);
+  PetscCall(PetscMalloc1(nh,&head));
+  PetscCall(PetscArraycpy(head,h,6));
+  PetscCall(PetscMalloc3(nv,&er,nv,&ei,nv,&err));
+  if (!rank) {
+    PetscCheck(fread(head+6,sizeof(PetscInt64),nh-6,fp)==(size_t)(nh-6),PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Error reading file %s",filename);
+    if (nv) {
+      PetscCheck(fread(er,sizeof(PetscScalar),nv,fp)==(size_t)nv,PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Error reading file %s",filename);
+      PetscCheck(fread(ei,sizeof(PetscScalar),nv,fp)==(size_t)nv,PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Error reading file %s",filename);
+      PetscCheck(fread(err,sizeof(PetscReal),nv,fp)==(size_t)nv,PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Error reading file %s",filename);
+    }
+    PetscCheck(!fclose(fp),PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Unable to close file %s",filename);
+  }
+  PetscCallMPI(MPI_Bcast(head+6,(PetscMPIInt)(nh-6),MPIU_INT64,0,comm));
+  if (nv) {
+    PetscCallMPI(MPI_Bcast(er,(PetscMPIInt)nv,MPIU_SCALAR,0,comm));
+    PetscCallMPI(MPI_Bcast(ei,(PetscMPIInt)nv,MPIU_SCALAR,0,comm));
+    PetscCallMPI(MPI_Bcast(err,(PetscMPIInt)nv,MPIU_REAL,0,comm));
+  }
+  if (n) *n = nv;
+  if (eigr) {
+    PetscCall(PetscMalloc1(nv,eigr));
+    PetscCall(PetscArraycpy(*eigr,er,nv));
+  }
+  if (eigi) {
+    PetscCall(PetscMalloc1(nv,eigi));
+    PetscCall(PetscArraycpy(*eigi,ei,nv));
+  }
+  if (errest) {
+    PetscCall(PetscMalloc1(nv,errest));
+    PetscCall(PetscArraycpy(*errest,err,nv));
+  }
+  PetscCall(PetscFree3(er,ei,err));
+  if (X) {
+    PetscCheck(nbv>0,comm,PETSC_ERR_FILE_UNEXPECTED,"File %s does not contain vectors",filename);
+    PetscCall(SlepcSolutionCreateBV(comm,filename,head,0,X));
+  }
+  if (Y) {
+    PetscCheck(nbv>1,comm,PETSC_ERR_FILE_UNEXPECTED,"File %s does not contain left vectors",filename);
+    PetscCall(SlepcSolutionCreateBV(comm,filename,head,1,Y));
+  }
+  PetscCall(PetscFree(head));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
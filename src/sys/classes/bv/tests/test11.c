@@ -220,7 +220,7 @@ int main(int argc,char **argv)
 /*TEST
 
    testset:
-      args: -bv_orthog_block {{gs chol tsqr tsqrchol svqb}}
+      args: -bv_orthog_block {{gs chol tsqr tsqrchol svqb cholqr2 scholqr3}}
       nsize: 2
       output_file: output/test11_1.out
       test:
@@ -236,7 +236,7 @@ int main(int argc,char **argv)
          requires: hip
 
    testset:
-      args: -withb -bv_orthog_block {{gs chol svqb}}
+      args: -withb -bv_orthog_block {{gs chol svqb cholqr2 scholqr3}}
       nsize: 2
       output_file: output/test11_4.out
       test:
@@ -252,7 +252,7 @@ int main(int argc,char **argv)
          requires: hip
 
    testset:
-      args: -resid -bv_orthog_block {{gs chol tsqr tsqrchol svqb}}
+      args: -resid -bv_orthog_block {{gs chol tsqr tsqrchol svqb cholqr2 scholqr3}}
       nsize: 2
       output_file: output/test11_6.out
       test:
@@ -268,7 +268,7 @@ int main(int argc,char **argv)
          requires: hip
 
    testset:
-      args: -resid -withb -bv_orthog_block {{gs chol svqb}}
+      args: -resid -withb -bv_orthog_block {{gs chol svqb cholqr2 scholqr3}}
       nsize: 2
       output_file: output/test11_9.out
       test:
@@ -0,0 +1,105 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test BVMultInPlace with a large BV, comparing with BVMult.\n\n";
+
+#include <slepcbv.h>
+
+int main(int argc,char **argv)
+{
+  Vec            t;
+  Mat            Q,Qt;
+  BV             X,Y;
+  PetscInt       i,j,n=10000,k=80,it;
+  PetscScalar    *q;
+  PetscReal      nrm,nrmx;
+  PetscBool      trans;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-trans",&trans));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Test BVMultInPlace with a BV of %" PetscInt_FMT " columns.\n",k));
+
+  /* Create template vector */
+  PetscCall(VecCreate(PETSC_COMM_WORLD,&t));
+  PetscCall(VecSetSizes(t,PETSC_DECIDE,n));
+  PetscCall(VecSetFromOptions(t));
+
+  /* Create BV objects X and Y */
+  PetscCall(BVCreate(PETSC_COMM_WORLD,&X));
+  PetscCall(PetscObjectSetName((PetscObject)X,"X"));
+  PetscCall(BVSetSizesFromVec(X,t,k));
+  PetscCall(BVSetFromOptions(X));
+  PetscCall(BVDuplicate(X,&Y));
+  PetscCall(PetscObjectSetName((PetscObject)Y,"Y"));
+
+  /* Create Mat */
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&Q));
+  PetscCall(PetscObjectSetName((PetscObject)Q,"Q"));
+  PetscCall(MatDenseGetArray(Q,&q));
+  for (i=0;i<k;i++)
+    for (j=0;j<k;j++)
+      q[i+j*k] = (i==j)? 1.0: 1.0/(PetscReal)(i+j+2);
+  PetscCall(MatDenseRestoreArray(Q,&q));
+  if (trans) PetscCall(MatHermitianTranspose(Q,MAT_INITIAL_MATRIX,&Qt));
+
+  /* Repeat twice, so that the second time the tuned block size is used */
+  PetscCall(BVSetRandom(X));
+  for (it=0;it<2;it++) {
+    /* Y = X*Q computed with BVMult */
+    PetscCall(BVMult(Y,1.0,0.0,X,trans?Qt:Q));
+
+    /* X = X*Q computed with BVMultInPlace */
+    if (trans) PetscCall(BVMultInPlaceHermitianTranspose(X,Q,0,k));
+    else PetscCall(BVMultInPlace(X,Q,0,k));
+
+    /* Compare the results */
+    PetscCall(BVNorm(X,NORM_FROBENIUS,&nrmx));
+    PetscCall(BVMult(Y,-1.0,1.0,X,NULL));
+    PetscCall(BVNorm(Y,NORM_FROBENIUS,&nrm));
+    if (nrm<100*PETSC_MACHINE_EPSILON*nrmx) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Difference < 100*eps\n"));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Difference: %g\n",(double)(nrm/nrmx)));
+    PetscCall(BVScale(X,1.0/nrmx));
+  }
+
+  PetscCall(BVDestroy(&X));
+  PetscCall(BVDestroy(&Y));
+  PetscCall(MatDestroy(&Q));
+  if (trans) PetscCall(MatDestroy(&Qt));
+  PetscCall(VecDestroy(&t));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test20_1.out
+      test:
+         suffix: 1
+         args: -bv_type {{vecs contiguous svec mat}}
+      test:
+         suffix: 1_trans
+         args: -bv_type {{contiguous svec}} -trans
+      test:
+         suffix: 1_panel
+         args: -bv_type panel -bv_panel_rows 100
+      test:
+         suffix: 1_threads
+         args: -bv_type {{contiguous svec}} -bv_num_threads 2 -trans
+         requires: openmp
+      test:
+         suffix: 2
+         nsize: 2
+         args: -bv_type {{contiguous svec}} -n 20000
+
+TEST*/
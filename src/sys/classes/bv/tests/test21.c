@@ -0,0 +1,159 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test BVMatArnoldi() with a shell matrix, using BVMatMultOrthonormalizeColumn().\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n"
+  "  -m <m>, where <m> = dimension of the Arnoldi basis.\n"
+  "  -multdot, to provide the fused product and inner products in the shell matrix.\n\n";
+
+#include <slepcbv.h>
+
+/*
+   Shell matrix that wraps an assembled matrix
+*/
+PetscErrorCode MatMult_Wrap(Mat S,Vec x,Vec y)
+{
+  Mat A;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatShellGetContext(S,&A));
+  PetscCall(MatMult(A,x,y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Compute y=A*x and the local inner products c = W'*y
+*/
+PetscErrorCode MatMultDot_Wrap(Mat S,Vec x,Vec y,PetscInt nv,const PetscScalar *W,PetscInt ldw,PetscScalar *c)
+{
+  Mat               A;
+  PetscInt          i,j,nloc;
+  const PetscScalar *py;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatShellGetContext(S,&A));
+  PetscCall(MatMult(A,x,y));
+  PetscCall(VecGetLocalSize(y,&nloc));
+  PetscCall(VecGetArrayRead(y,&py));
+  for (j=0;j<nv;j++) {
+    c[j] = 0.0;
+    for (i=0;i<nloc;i++) c[j] += PetscConj(W[i+j*ldw])*py[i];
+  }
+  PetscCall(VecRestoreArrayRead(y,&py));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Mat         A,S,H,G;
+  BV          V,Y;
+  Vec         v,y;
+  PetscInt    i,j,n=100,m=10,Istart,Iend;
+  PetscReal   beta,norm;
+  PetscBool   multdot=PETSC_FALSE,breakdown;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-multdot",&multdot,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Test BVMatArnoldi with a shell matrix of size %" PetscInt_FMT ", m=%" PetscInt_FMT ".\n",n,m));
+
+  /* Create nonsymmetric tridiagonal matrix and the shell matrix that wraps it */
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,-0.5,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateShell(PETSC_COMM_WORLD,Iend-Istart,Iend-Istart,n,n,A,&S));
+  PetscCall(MatShellSetOperation(S,MATOP_MULT,(void(*)(void))MatMult_Wrap));
+  if (multdot) PetscCall(PetscObjectComposeFunction((PetscObject)S,"BVMatMultDot_C",MatMultDot_Wrap));
+
+  /* Create BV objects and Hessenberg matrix */
+  PetscCall(MatCreateVecs(A,&v,NULL));
+  PetscCall(BVCreate(PETSC_COMM_WORLD,&V));
+  PetscCall(BVSetSizesFromVec(V,v,m+1));
+  PetscCall(BVSetFromOptions(V));
+  PetscCall(BVDuplicate(V,&Y));
+  PetscCall(VecDestroy(&v));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,m,NULL,&H));
+
+  /* Compute Arnoldi factorization A*V = V*H + beta*v_m*e_m' */
+  PetscCall(BVSetRandomColumn(V,0));
+  PetscCall(BVOrthonormalizeColumn(V,0,PETSC_TRUE,NULL,NULL));
+  PetscCall(BVMatArnoldi(V,S,H,0,&m,&beta,&breakdown));
+  PetscCheck(!breakdown,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Unexpected breakdown");
+
+  /* Check orthogonality */
+  PetscCall(BVSetActiveColumns(V,0,m+1));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m+1,m+1,NULL,&G));
+  PetscCall(BVDot(V,V,G));
+  PetscCall(MatShift(G,-1.0));
+  PetscCall(MatNorm(G,NORM_1,&norm));
+  if (norm<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Level of orthogonality < 100*eps\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Level of orthogonality: %g\n",(double)norm));
+  PetscCall(MatDestroy(&G));
+
+  /* Check the Arnoldi relation */
+  for (j=0;j<m;j++) {
+    PetscCall(BVGetColumn(V,j,&v));
+    PetscCall(BVGetColumn(Y,j,&y));
+    PetscCall(MatMult(A,v,y));
+    PetscCall(BVRestoreColumn(V,j,&v));
+    PetscCall(BVRestoreColumn(Y,j,&y));
+  }
+  PetscCall(BVSetActiveColumns(V,0,m));
+  PetscCall(BVSetActiveColumns(Y,0,m));
+  PetscCall(BVMult(Y,-1.0,1.0,V,H));
+  PetscCall(BVGetColumn(V,m,&v));
+  PetscCall(BVGetColumn(Y,m-1,&y));
+  PetscCall(VecAXPY(y,-beta,v));
+  PetscCall(BVRestoreColumn(V,m,&v));
+  PetscCall(BVRestoreColumn(Y,m-1,&y));
+  PetscCall(BVNorm(Y,NORM_FROBENIUS,&norm));
+  if (norm<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Residual of the Arnoldi relation < 100*eps\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Residual of the Arnoldi relation: %g\n",(double)norm));
+
+  PetscCall(BVDestroy(&V));
+  PetscCall(BVDestroy(&Y));
+  PetscCall(MatDestroy(&H));
+  PetscCall(MatDestroy(&S));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test21_1.out
+      test:
+         suffix: 1
+         args: -bv_type {{vecs contiguous svec mat}} -multdot {{0 1}} -bv_orthog_refine {{ifneeded always}}
+      test:
+         suffix: 1_mgs
+         args: -bv_type {{contiguous svec}} -multdot -bv_orthog_type mgs
+      test:
+         suffix: 1_dcgs2
+         nsize: {{1 2}}
+         args: -bv_type {{vecs contiguous svec mat}} -bv_orthog_type dcgs2
+      test:
+         suffix: 2
+         nsize: 2
+         args: -bv_type {{contiguous svec mat}} -multdot {{0 1}}
+
+TEST*/
@@ -0,0 +1,143 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test BV operations with reproducible reductions.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = vector dimension.\n"
+  "  -k <k>, where <k> = number of columns.\n\n";
+
+#include <slepcbv.h>
+
+/*
+   Fill the columns of X with values that depend only on the global index
+*/
+PetscErrorCode FillBV(BV X,PetscInt k)
+{
+  Vec         v;
+  PetscInt    i,j,Istart,Iend;
+  PetscScalar *pv;
+
+  PetscFunctionBeginUser;
+  for (j=0;j<k;j++) {
+    PetscCall(BVGetColumn(X,j,&v));
+    PetscCall(VecGetOwnershipRange(v,&Istart,&Iend));
+    PetscCall(VecGetArray(v,&pv));
+    for (i=Istart;i<Iend;i++) pv[i-Istart] = PetscSinReal((PetscReal)((i+1)*(j+1)))/(PetscReal)(i%7+1);
+    PetscCall(VecRestoreArray(v,&pv));
+    PetscCall(BVRestoreColumn(X,j,&v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            t1,t2,v;
+  Mat            M1,M2,M3;
+  BV             X,Y;
+  PetscMPIInt    rank,size;
+  PetscInt       n=200,k=8,nloc,base;
+  PetscScalar    *m1,*m2,*q1,*q2;
+  PetscReal      nrm1,nrm2,nrmv1,nrmv2,err,nrm;
+  PetscBool      eqdot,eqvec,eqnrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD,&rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD,&size));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Test BV with reproducible reductions, n=%" PetscInt_FMT ", k=%" PetscInt_FMT ".\n",n,k));
+
+  /* Two template vectors with different distribution of the rows */
+  PetscCall(VecCreate(PETSC_COMM_WORLD,&t1));
+  PetscCall(VecSetSizes(t1,PETSC_DECIDE,n));
+  PetscCall(VecSetFromOptions(t1));
+  base = n/(2*size);
+  nloc = (rank==size-1)? n-(size-1)*base: base;
+  PetscCall(VecCreate(PETSC_COMM_WORLD,&t2));
+  PetscCall(VecSetSizes(t2,nloc,n));
+  PetscCall(VecSetFromOptions(t2));
+
+  /* Create BV objects with the same content */
+  PetscCall(BVCreate(PETSC_COMM_WORLD,&X));
+  PetscCall(BVSetSizesFromVec(X,t1,k));
+  PetscCall(BVSetReproducibleReduction(X,PETSC_TRUE));
+  PetscCall(BVSetFromOptions(X));
+  PetscCall(BVCreate(PETSC_COMM_WORLD,&Y));
+  PetscCall(BVSetSizesFromVec(Y,t2,k));
+  PetscCall(BVSetType(Y,((PetscObject)X)->type_name));
+  PetscCall(BVSetReproducibleReduction(Y,PETSC_TRUE));
+  PetscCall(FillBV(X,k));
+  PetscCall(FillBV(Y,k));
+
+  /* Gram matrices, inner products with the last column and norms */
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&M1));
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&M2));
+  PetscCall(BVDot(X,X,M1));
+  PetscCall(BVDot(Y,Y,M2));
+  PetscCall(PetscMalloc2(k,&q1,k,&q2));
+  PetscCall(BVDotColumn(X,k-1,q1));
+  PetscCall(BVDotColumn(Y,k-1,q2));
+  PetscCall(BVNorm(X,NORM_FROBENIUS,&nrm1));
+  PetscCall(BVNorm(Y,NORM_FROBENIUS,&nrm2));
+  PetscCall(BVGetColumn(X,0,&v));
+  PetscCall(BVNormVec(X,v,NORM_2,&nrmv1));
+  PetscCall(BVRestoreColumn(X,0,&v));
+  PetscCall(BVGetColumn(Y,0,&v));
+  PetscCall(BVNormVec(Y,v,NORM_2,&nrmv2));
+  PetscCall(BVRestoreColumn(Y,0,&v));
+
+  PetscCall(MatDenseGetArray(M1,&m1));
+  PetscCall(MatDenseGetArray(M2,&m2));
+  PetscCall(PetscArraycmp(m1,m2,k*k,&eqdot));
+  PetscCall(MatDenseRestoreArray(M1,&m1));
+  PetscCall(MatDenseRestoreArray(M2,&m2));
+  PetscCall(PetscArraycmp(q1,q2,k-1,&eqvec));
+  eqnrm = (nrm1==nrm2 && nrmv1==nrmv2)? PETSC_TRUE: PETSC_FALSE;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Gram matrices are %sbitwise identical\n",eqdot?"":"NOT "));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Inner products with a column are %sbitwise identical\n",eqvec?"":"NOT "));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Norms are %sbitwise identical\n",eqnrm?"":"NOT "));
+
+  /* Compare with the standard reduction */
+  PetscCall(MatDuplicate(M1,MAT_DO_NOT_COPY_VALUES,&M3));
+  PetscCall(BVSetReproducibleReduction(X,PETSC_FALSE));
+  PetscCall(BVDot(X,X,M3));
+  PetscCall(MatAXPY(M3,-1.0,M1,SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(M3,NORM_FROBENIUS,&err));
+  PetscCall(MatNorm(M1,NORM_FROBENIUS,&nrm));
+  if (err<100*PETSC_MACHINE_EPSILON*nrm) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Difference with the standard reduction < 100*eps\n"));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Difference with the standard reduction: %g\n",(double)(err/nrm)));
+
+  PetscCall(PetscFree2(q1,q2));
+  PetscCall(MatDestroy(&M1));
+  PetscCall(MatDestroy(&M2));
+  PetscCall(MatDestroy(&M3));
+  PetscCall(BVDestroy(&X));
+  PetscCall(BVDestroy(&Y));
+  PetscCall(VecDestroy(&t1));
+  PetscCall(VecDestroy(&t2));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test22_1.out
+      test:
+         suffix: 1
+         nsize: {{1 2 3}}
+         args: -bv_type {{contiguous svec mat}}
+      test:
+         suffix: 1_hierred
+         nsize: 3
+         args: -bv_type svec -bv_hierarchical_reduction
+
+TEST*/
@@ -0,0 +1,188 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Microbenchmark of BV kernels: BVMult, BVMultInPlace, BVDot and BVOrthogonalize.\n\n"
+  "The command line options are:\n"
+  "  -n <n1,n2,...>, list of global vector dimensions.\n"
+  "  -k <k1,k2,...>, list of number of columns.\n"
+  "  -ldextra <e>, the leading dimension is the local size plus e.\n"
+  "  -bv_types <t1,t2,...>, list of BV types (add -vec_type cuda for GPU runs).\n"
+  "  -its <its>, number of repetitions of each kernel.\n"
+  "  -peak_gflops <p> and -peak_bw <b>, machine peak in GFLOP/s and GB/s for the roofline bound.\n"
+  "  -terse, do not print the measured rates.\n\n";
+
+#include <slepcbv.h>
+
+#define MAXLIST 16
+
+/*
+   Print one line of results; the flop and byte counts are the nominal ones of the
+   kernel (memory traffic assuming that each column is read or written once)
+*/
+static PetscErrorCode PrintRate(const char *kernel,PetscInt its,PetscLogDouble t,PetscLogDouble flops,PetscLogDouble bytes,PetscReal peakf,PetscReal peakb,PetscBool terse)
+{
+  PetscLogDouble gflops,gbs,bound;
+
+  PetscFunctionBeginUser;
+  if (terse) {
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD,"   %-20s done\n",kernel));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  t      = PetscMax(t/its,1e-12);
+  gflops = 1e-9*flops/t;
+  gbs    = 1e-9*bytes/t;
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"   %-20s %10.3e s  %9.3f GFLOP/s  %9.3f GB/s",kernel,t,gflops,gbs));
+  if (peakf>0.0 && peakb>0.0) {
+    bound = PetscMin(peakf,peakb*flops/bytes);
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD,"  %5.1f%% of roofline",100.0*gflops/bound));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            t;
+  Mat            Q,M;
+  BV             X,Y;
+  PetscInt       nlist[MAXLIST]={10000},klist[MAXLIST]={16},nn=MAXLIST,nk=MAXLIST,i,j,it,its=10,n,k,nloc,ldextra=0;
+  PetscInt       ntypes=MAXLIST;
+  char           *types[MAXLIST];
+  PetscReal      peakf=0.0,peakb=0.0;
+  PetscBool      flg,terse;
+  PetscLogDouble t0,t1,tacc,flops,bytes,sz=sizeof(PetscScalar);
+  char           name[64];
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetIntArray(NULL,NULL,"-n",nlist,&nn,&flg));
+  if (!flg) nn = 1;
+  PetscCall(PetscOptionsGetIntArray(NULL,NULL,"-k",klist,&nk,&flg));
+  if (!flg) nk = 1;
+  PetscCall(PetscOptionsGetStringArray(NULL,NULL,"-bv_types",types,&ntypes,&flg));
+  if (!flg) {
+    ntypes = 4;
+    PetscCall(PetscStrallocpy(BVSVEC,&types[0]));
+    PetscCall(PetscStrallocpy(BVCONTIGUOUS,&types[1]));
+    PetscCall(PetscStrallocpy(BVMAT,&types[2]));
+    PetscCall(PetscStrallocpy(BVVECS,&types[3]));
+  }
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-ldextra",&ldextra,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL));
+  PetscCall(PetscOptionsGetReal(NULL,NULL,"-peak_gflops",&peakf,NULL));
+  PetscCall(PetscOptionsGetReal(NULL,NULL,"-peak_bw",&peakb,NULL));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-terse",&terse));
+
+  for (i=0;i<nn;i++) {
+    n = nlist[i];
+    PetscCall(VecCreate(PETSC_COMM_WORLD,&t));
+    PetscCall(VecSetSizes(t,PETSC_DECIDE,n));
+    PetscCall(VecSetFromOptions(t));
+    PetscCall(VecGetLocalSize(t,&nloc));
+    for (j=0;j<nk;j++) {
+      k = klist[j];
+      for (PetscInt l=0;l<ntypes;l++) {
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD,"BV of type %s, n=%" PetscInt_FMT ", k=%" PetscInt_FMT ", ldextra=%" PetscInt_FMT "\n",types[l],n,k,ldextra));
+
+        /* Create the BV objects and the small matrices */
+        PetscCall(BVCreate(PETSC_COMM_WORLD,&X));
+        if (ldextra) PetscCall(BVSetLeadingDimension(X,nloc+ldextra));
+        PetscCall(BVSetSizesFromVec(X,t,k));
+        PetscCall(BVSetType(X,types[l]));
+        PetscCall(BVSetFromOptions(X));
+        PetscCall(BVDuplicate(X,&Y));
+        PetscCall(BVSetRandom(X));
+        PetscCall(BVSetRandom(Y));
+        PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&Q));
+        PetscCall(MatSetRandom(Q,NULL));
+        PetscCall(MatScale(Q,1.0/k));
+        PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,k,k,NULL,&M));
+
+        /* BVMult: Y = X*Q, reads X and writes Y */
+        PetscCall(BVMult(Y,1.0,0.0,X,Q));
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t0));
+        for (it=0;it<its;it++) PetscCall(BVMult(Y,1.0,0.0,X,Q));
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t1));
+        flops = 2.0*n*k*k; bytes = 2.0*n*k*sz;
+        PetscCall(PrintRate("BVMult",its,t1-t0,flops,bytes,peakf,peakb,terse));
+
+        /* BVMultInPlace: X = X*Q, reads and writes X */
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t0));
+        for (it=0;it<its;it++) PetscCall(BVMultInPlace(Y,Q,0,k));
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t1));
+        PetscCall(PrintRate("BVMultInPlace",its,t1-t0,flops,bytes,peakf,peakb,terse));
+
+        /* BVDot: M = Y'*X, reads X and Y */
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t0));
+        for (it=0;it<its;it++) PetscCall(BVDot(Y,X,M));
+        PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+        PetscCall(PetscTime(&t1));
+        PetscCall(PrintRate("BVDot",its,t1-t0,flops,bytes,peakf,peakb,terse));
+
+        /* BVOrthogonalize with each block type; the flop count is the nominal one
+           of one Gram-Schmidt pass plus reorthogonalization, 4*n*k^2 */
+        for (PetscInt b=BV_ORTHOG_BLOCK_GS;b<=BV_ORTHOG_BLOCK_SCHOLQR3;b++) {
+          PetscCall(BVSetOrthogonalization(X,BV_ORTHOG_CGS,BV_ORTHOG_REFINE_IFNEEDED,PETSC_DEFAULT,(BVOrthogBlockType)b));
+          tacc = 0.0;
+          for (it=0;it<its;it++) {
+            PetscCall(BVSetRandom(X));
+            PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+            PetscCall(PetscTime(&t0));
+            PetscCall(BVOrthogonalize(X,NULL));
+            PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+            PetscCall(PetscTime(&t1));
+            tacc += t1-t0;
+          }
+          PetscCall(PetscSNPrintf(name,sizeof(name),"BVOrthogonalize %s",BVOrthogBlockTypes[b]));
+          PetscCall(PrintRate(name,its,tacc,2.0*flops,bytes,peakf,peakb,terse));
+        }
+
+        PetscCall(MatDestroy(&Q));
+        PetscCall(MatDestroy(&M));
+        PetscCall(BVDestroy(&X));
+        PetscCall(BVDestroy(&Y));
+      }
+    }
+    PetscCall(VecDestroy(&t));
+  }
+  for (i=0;i<ntypes;i++) PetscCall(PetscFree(types[i]));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      args: -n 100 -k 8 -its 2 -terse
+      output_file: output/test23_1.out
+      requires: !single
+      test:
+         suffix: 1
+      test:
+         suffix: 1_ld
+         args: -ldextra 3
+         output_file: output/test23_1_ld.out
+      test:
+         suffix: 1_cuda
+         args: -vec_type cuda -bv_types svec,mat
+         output_file: output/test23_1_cuda.out
+         requires: cuda
+      test:
+         suffix: 1_cuda_device_only
+         args: -vec_type cuda -bv_types svec,mat -bv_device_only
+         output_file: output/test23_1_cuda.out
+         requires: cuda
+
+TEST*/
@@ -118,6 +118,10 @@ int main(int argc,char **argv)
       test:
          suffix: 1_svec_vecs
          args: -bv_type svec -bv_matmult vecs
+      test:
+         suffix: 1_panel
+         nsize: {{1 2}}
+         args: -bv_type panel -bv_panel_rows 7 -bv_matmult {{vecs mat}}
       test:
          suffix: 1_cuda
          args: -bv_type {{svec mat}} -mat_type aijcusparse
@@ -134,5 +138,9 @@ int main(int argc,char **argv)
          suffix: 3
          nsize: 2
          args: -bv_type {{vecs contiguous svec mat}shared output} -bv_orthog_type mgs
+      test:
+         suffix: 4
+         nsize: 3
+         args: -bv_type {{contiguous svec mat}shared output} -bv_hierarchical_reduction
 
 TEST*/
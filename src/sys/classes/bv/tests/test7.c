@@ -229,6 +229,9 @@ int main(int argc,char **argv)
       test:
          suffix: 2_mat
          args: -bv_type {{vecs contiguous svec mat}shared output} -bv_matmult mat
+      test:
+         suffix: 2_mat_rep
+         args: -bv_type {{contiguous svec mat}shared output} -bv_matmult mat -rep 3
 
    testset:
       output_file: output/test7_3.out
@@ -14,6 +14,80 @@
 #include <slepc/private/dsimpl.h>      /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
 
+/*
+   Check if A is upper Hessenberg except for the leading block A(l:k,l:k), which
+   is the structure after a Krylov-Schur restart (Schur form plus the arrow in row k)
+*/
+static PetscErrorCode DSNHEPHasArrow_Private(DS ds,PetscScalar *A,PetscBool *flg)
+{
+  PetscInt i,j,n=ds->n,l=ds->l,k=ds->k,ld=ds->ld;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  if (k<l+2 || k>=n) PetscFunctionReturn(PETSC_SUCCESS);
+  for (j=l;j<n-2;j++) {
+    for (i=PetscMax(j+2,k+1);i<n;i++) if (A[i+j*ld]!=0.0) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *flg = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Reduce to Hessenberg form a matrix with the structure detected in DSNHEPHasArrow_Private(),
+   and set Q to the orthogonal transformation. The leading block of size nb=k-l+1 is flipped
+   and transposed, so that _gehrd reduces it bottom-up with reflectors that leave row k
+   untouched. Then the transformation is applied to the rest of rows l:k and columns l:k.
+   The cost is O(nb^2*n), instead of O(n^3) of reducing the whole matrix.
+*/
+static PetscErrorCode DSNHEPIncrementalHessenberg_Private(DS ds,PetscScalar *A,PetscScalar *Q)
+{
+  PetscInt     i,j,l=ds->l,k=ds->k,n=ds->n,ld=ds->ld;
+  PetscScalar  *C,*Z,*W,*tau,*work,sone=1.0,szero=0.0;
+  PetscBLASInt nb,m,ll,one=1,lwork,info,ld_;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(k-l+1,&nb));
+  PetscCall(PetscBLASIntCast(n-k-1,&m));
+  PetscCall(PetscBLASIntCast(l,&ll));
+  PetscCall(PetscBLASIntCast(ld,&ld_));
+  PetscCall(PetscBLASIntCast(6*ld,&lwork));
+  PetscCall(DSAllocateWork_Private(ds,ld+lwork+2*nb*nb+nb*PetscMax(m,ll),0,0));
+  tau  = ds->work;
+  work = ds->work+ld;
+  C    = work+lwork;
+  Z    = C+nb*nb;
+  W    = Z+nb*nb;
+
+  /* C = (J*A(l:k,l:k)*J)^T, where J is the flip permutation */
+  for (j=0;j<nb;j++) {
+    for (i=0;i<nb;i++) C[i+j*nb] = A[(k-j)+(k-i)*ld];
+  }
+  PetscCallBLAS("LAPACKgehrd",LAPACKgehrd_(&nb,&one,&nb,C,&nb,tau,work,&lwork,&info));
+  SlepcCheckLapackInfo("gehrd",info);
+  PetscCall(PetscArraycpy(Z,C,nb*nb));
+  PetscCallBLAS("LAPACKorghr",LAPACKorghr_(&nb,&one,&nb,Z,&nb,tau,work,&lwork,&info));
+  SlepcCheckLapackInfo("orghr",info);
+
+  /* undo the flip and transpose, Q(l:k,l:k) = J*conj(Z)*J fixes row k */
+  for (j=0;j<nb;j++) {
+    for (i=0;i<nb;i++) {
+      A[(l+i)+(l+j)*ld] = (i<=j+1)? C[(nb-1-j)+(nb-1-i)*nb]: 0.0;
+      Q[(l+i)+(l+j)*ld] = PetscConj(Z[(nb-1-i)+(nb-1-j)*nb]);
+    }
+  }
+
+  /* apply the transformation to A(0:l-1,l:k) and A(l:k,k+1:n-1) */
+  if (ll) {
+    for (j=0;j<nb;j++) PetscCall(PetscArraycpy(W+j*ll,A+(l+j)*ld,ll));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&ll,&nb,&nb,&sone,W,&ll,Q+l+l*ld,&ld_,&szero,A+l*ld,&ld_));
+  }
+  if (m) {
+    for (j=0;j<m;j++) PetscCall(PetscArraycpy(W+j*nb,A+l+(k+1+j)*ld,nb));
+    PetscCallBLAS("BLASgemm",BLASgemm_("C","N",&nb,&m,&nb,&sone,Q+l+l*ld,&ld_,W,&nb,&szero,A+l+(k+1)*ld,&ld_));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Compute the (real) Schur form of A. At the end, A is (quasi-)triangular and Q
    contains the unitary matrix of Schur vectors. Eigenvalues are returned in wr,wi
@@ -22,7 +96,8 @@ PetscErrorCode DSSolve_NHEP_Private(DS ds,DSMatType mA,DSMatType mQ,PetscScalar
 {
   PetscScalar    *work,*tau,*A,*Q;
   PetscInt       i,j;
-  PetscBLASInt   ilo,lwork,info,n,k,ld;
+  PetscBLASInt   ilo,lwork,info,n,ld;
+  PetscBool      arrow=PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(MatDenseGetArray(ds->omat[mA],&A));
@@ -30,7 +105,6 @@ PetscErrorCode DSSolve_NHEP_Private(DS ds,DSMatType mA,DSMatType mQ,PetscScalar
   PetscCall(PetscBLASIntCast(ds->n,&n));
   PetscCall(PetscBLASIntCast(ds->ld,&ld));
   PetscCall(PetscBLASIntCast(ds->l+1,&ilo));
-  PetscCall(PetscBLASIntCast(ds->k,&k));
   PetscCall(DSAllocateWork_Private(ds,ld+6*ld,0,0));
   tau  = ds->work;
   work = ds->work+ld;
@@ -45,8 +119,13 @@ PetscErrorCode DSSolve_NHEP_Private(DS ds,DSMatType mA,DSMatType mQ,PetscScalar
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
-  /* reduce to upper Hessenberg form */
-  if (ds->state<DS_STATE_INTERMEDIATE) {
+  /* reduce to upper Hessenberg form, only the leading block if restarted */
+  if (ds->state<DS_STATE_INTERMEDIATE) PetscCall(DSNHEPHasArrow_Private(ds,A,&arrow));
+  if (arrow) {
+    PetscCall(DSNHEPIncrementalHessenberg_Private(ds,A,Q));
+    tau  = ds->work;
+    work = ds->work+ld;
+  } else if (ds->state<DS_STATE_INTERMEDIATE) {
     PetscCallBLAS("LAPACKgehrd",LAPACKgehrd_(&n,&ilo,&n,A,&ld,tau,work,&lwork,&info));
     SlepcCheckLapackInfo("gehrd",info);
     for (j=0;j<n-1;j++) {
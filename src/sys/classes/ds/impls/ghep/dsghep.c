@@ -10,6 +10,10 @@
 
 #include <slepc/private/dsimpl.h>
 #include <slepcblaslapack.h>
+#include <slepcmagma.h>
+#if defined(SLEPC_HAVE_SCALAPACK)
+#include <slepc/private/slepcscalapack.h>
+#endif
 
 static PetscErrorCode DSAllocate_GHEP(DS ds,PetscInt ld)
 {
@@ -144,6 +148,138 @@ static PetscErrorCode DSSolve_GHEP(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MAGMA)
+static PetscErrorCode DSSolve_GHEP_MAGMA(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  PetscScalar    *A,*B,*Q,qwork;
+  PetscBLASInt   itype = 1,n1,ld,lwork,liwork,iqwork;
+  PetscInt       off,i;
+  PetscReal      *rr;
+#if defined(PETSC_USE_COMPLEX)
+  PetscBLASInt   lrwork;
+  PetscReal      rqwork;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(SlepcMagmaInit());
+  PetscCall(PetscBLASIntCast(ds->n-ds->l,&n1));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  off = ds->l+ds->l*ld;
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_B],&B));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+
+  /* workspace query, the eigenvalues are stored in rwork */
+  lwork = -1; liwork = -1;
+#if defined(PETSC_USE_COMPLEX)
+  lrwork = -1;
+  PetscCallMAGMA(magma_xsygvd,itype,MagmaVec,MagmaUpper,n1,A+off,ld,B+off,ld,NULL,&qwork,lwork,&rqwork,lrwork,&iqwork,liwork);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(qwork),&lwork));
+  PetscCall(PetscBLASIntCast((PetscInt)rqwork,&lrwork));
+  liwork = iqwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,n1+lrwork,liwork));
+  rr = ds->rwork;
+  PetscCallMAGMA(magma_xsygvd,itype,MagmaVec,MagmaUpper,n1,A+off,ld,B+off,ld,rr,ds->work,lwork,ds->rwork+n1,lrwork,ds->iwork,liwork);
+#else
+  PetscCallMAGMA(magma_xsygvd,itype,MagmaVec,MagmaUpper,n1,A+off,ld,B+off,ld,NULL,&qwork,lwork,&iqwork,liwork);
+  PetscCall(PetscBLASIntCast((PetscInt)qwork,&lwork));
+  liwork = iqwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,n1,liwork));
+  rr = ds->rwork;
+  PetscCallMAGMA(magma_xsygvd,itype,MagmaVec,MagmaUpper,n1,A+off,ld,B+off,ld,rr,ds->work,lwork,ds->iwork,liwork);
+#endif
+  for (i=0;i<n1;i++) wr[ds->l+i] = rr[i];
+  PetscCall(PetscArrayzero(Q+ds->l*ld,n1*ld));
+  for (i=ds->l;i<ds->n;i++) PetscCall(PetscArraycpy(Q+ds->l+i*ld,A+ds->l+i*ld,n1));
+  PetscCall(PetscArrayzero(B+ds->l*ld,n1*ld));
+  PetscCall(PetscArrayzero(A+ds->l*ld,n1*ld));
+  for (i=ds->l;i<ds->n;i++) {
+    if (wi) wi[i] = 0.0;
+    B[i+i*ld] = 1.0;
+    A[i+i*ld] = wr[i];
+  }
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_B],&B));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+#if defined(SLEPC_HAVE_SCALAPACK)
+static PetscErrorCode DSSolve_GHEP_ScaLAPACK(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  Mat            SA,SB,Z;
+  Mat_ScaLAPACK  *a,*b,*z;
+  PetscScalar    *A,*B,*Q,minlwork[3];
+  PetscReal      rdummy=0.0,abstol=0.0,orfac=-1.0,*rr,*gap;
+  PetscBLASInt   n1,m,info,idummy=0,lwork=-1,liwork=-1,minliwork,*ifail,*iclustr,one=1,np;
+  PetscInt       off,i,ld=ds->ld;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal      minlrwork[3];
+  PetscBLASInt   lrwork=-1;
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(ds->n-ds->l,&n1));
+  off = ds->l+ds->l*ld;
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_B],&B));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+
+  /* distribute the trailing parts of A and B */
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n1,n1,A+off,ld,&SA));
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n1,n1,B+off,ld,&SB));
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n1,n1,NULL,0,&Z));
+  a = (Mat_ScaLAPACK*)SA->data;
+  b = (Mat_ScaLAPACK*)SB->data;
+  z = (Mat_ScaLAPACK*)Z->data;
+  np = a->grid->nprow*a->grid->npcol;
+  PetscCall(PetscMalloc3(np,&gap,n1,&ifail,2*np,&iclustr));
+
+  /* workspace query, the eigenvalues are stored in rwork */
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("SCALAPACKsygvx",SCALAPACKsygvx_(&one,"V","A","L",&n1,a->loc,&one,&one,a->desc,b->loc,&one,&one,b->desc,&rdummy,&rdummy,&idummy,&idummy,&abstol,&m,&idummy,NULL,&orfac,z->loc,&one,&one,z->desc,minlwork,&lwork,&minliwork,&liwork,ifail,iclustr,gap,&info));
+  PetscCheckScaLapackInfo("sygvx",info);
+  PetscCall(PetscBLASIntCast((PetscInt)minlwork[0],&lwork));
+  liwork = minliwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,n1,liwork));
+  rr = ds->rwork;
+  PetscCallBLAS("SCALAPACKsygvx",SCALAPACKsygvx_(&one,"V","A","L",&n1,a->loc,&one,&one,a->desc,b->loc,&one,&one,b->desc,&rdummy,&rdummy,&idummy,&idummy,&abstol,&m,&idummy,rr,&orfac,z->loc,&one,&one,z->desc,ds->work,&lwork,ds->iwork,&liwork,ifail,iclustr,gap,&info));
+#else
+  PetscCallBLAS("SCALAPACKsygvx",SCALAPACKsygvx_(&one,"V","A","L",&n1,a->loc,&one,&one,a->desc,b->loc,&one,&one,b->desc,&rdummy,&rdummy,&idummy,&idummy,&abstol,&m,&idummy,NULL,&orfac,z->loc,&one,&one,z->desc,minlwork,&lwork,minlrwork,&lrwork,&minliwork,&liwork,ifail,iclustr,gap,&info));
+  PetscCheckScaLapackInfo("sygvx",info);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(minlwork[0]),&lwork));
+  PetscCall(PetscBLASIntCast((PetscInt)minlrwork[0],&lrwork));
+  lrwork += n1*n1;  /* the query value is not enough, see EPSSCALAPACK */
+  liwork = minliwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,n1+lrwork,liwork));
+  rr = ds->rwork;
+  PetscCallBLAS("SCALAPACKsygvx",SCALAPACKsygvx_(&one,"V","A","L",&n1,a->loc,&one,&one,a->desc,b->loc,&one,&one,b->desc,&rdummy,&rdummy,&idummy,&idummy,&abstol,&m,&idummy,rr,&orfac,z->loc,&one,&one,z->desc,ds->work,&lwork,ds->rwork+n1,&lrwork,ds->iwork,&liwork,ifail,iclustr,gap,&info));
+#endif
+  PetscCheckScaLapackInfo("sygvx",info);
+  PetscCall(PetscFree3(gap,ifail,iclustr));
+  for (i=0;i<n1;i++) wr[ds->l+i] = rr[i];
+
+  /* gather the eigenvectors in Q */
+  PetscCall(PetscArrayzero(Q+ds->l*ld,n1*ld));
+  PetscCall(DSCopyFromScaLAPACK_Private(ds,Z,Q+off,ld));
+  PetscCall(MatDestroy(&SA));
+  PetscCall(MatDestroy(&SB));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(PetscArrayzero(B+ds->l*ld,n1*ld));
+  PetscCall(PetscArrayzero(A+ds->l*ld,n1*ld));
+  for (i=ds->l;i<ds->n;i++) {
+    if (wi) wi[i] = 0.0;
+    B[i+i*ld] = 1.0;
+    A[i+i*ld] = wr[i];
+  }
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_B],&B));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 #if !defined(PETSC_HAVE_MPIUNI)
 static PetscErrorCode DSSynchronize_GHEP(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
@@ -210,7 +346,9 @@ static PetscErrorCode DSHermitian_GHEP(DS ds,DSMatType m,PetscBool *flg)
 -  DS_MAT_Q - matrix of B-orthogonal eigenvectors, which is equal to X
 
    Implemented methods:
-.  0 - Divide and Conquer (_sygvd)
++  0 - Divide and Conquer (_sygvd)
+.  1 - Divide and Conquer in the GPU (MAGMA _sygvd)
+-  2 - Parallel bisection and inverse iteration with ScaLAPACK (p_sygvx)
 
 .seealso: DSCreate(), DSSetType(), DSType
 M*/
@@ -221,6 +359,12 @@ SLEPC_EXTERN PetscErrorCode DSCreate_GHEP(DS ds)
   ds->ops->view          = DSView_GHEP;
   ds->ops->vectors       = DSVectors_GHEP;
   ds->ops->solve[0]      = DSSolve_GHEP;
+#if defined(PETSC_HAVE_MAGMA)
+  ds->ops->solve[1]      = DSSolve_GHEP_MAGMA;
+#endif
+#if defined(SLEPC_HAVE_SCALAPACK)
+  ds->ops->solve[2]      = DSSolve_GHEP_ScaLAPACK;
+#endif
   ds->ops->sort          = DSSort_GHEP;
 #if !defined(PETSC_HAVE_MPIUNI)
   ds->ops->synchronize   = DSSynchronize_GHEP;
@@ -223,7 +223,7 @@ static PetscErrorCode HZStep(PetscBLASInt ntop,PetscBLASInt nn,PetscReal tr,Pets
 static PetscErrorCode HZIteration(PetscBLASInt nn,PetscBLASInt cgd,PetscReal *aa,PetscReal *bb,PetscReal *dd,PetscScalar *uu,PetscBLASInt ld)
 {
   PetscBLASInt   j2,one=1,its,nits,nstop,jj,ntop,nbot,ntry;
-  PetscReal      htr,det,dis,dif,tn,kt,c,s,tr,dt;
+  PetscReal      htr,det,dis,dif,tn,kt,c,s,tr,dt,h;
   PetscBool      flag=PETSC_FALSE;
 
   PetscFunctionBegin;
@@ -269,10 +269,19 @@ static PetscErrorCode HZIteration(PetscBLASInt nn,PetscBLASInt cgd,PetscReal *aa
     } else {  /* Do an HZ iteration */
       its = its + 1;
       nits = nits + 1;
-      tr = aa[nbot-1]*dd[nbot-1] + aa[nbot]*dd[nbot];
-      dt = dd[nbot-1]*dd[nbot]*(aa[nbot-1]*aa[nbot]-bb[nbot-1]*bb[nbot-1]);
+      if (its%10 == 0) {  /* exceptional shifts, in case the iteration stagnates */
+        s = PetscAbs(bb[nbot-1]);
+        if (nbot-2 >= ntop) s += PetscAbs(bb[nbot-2]);
+        h = aa[nbot]*dd[nbot] + 0.75*s;
+        tr = 2.0*h;
+        dt = h*h + 0.4375*s*s;
+      } else {  /* eigenvalues of the trailing 2x2 block */
+        tr = aa[nbot-1]*dd[nbot-1] + aa[nbot]*dd[nbot];
+        dt = dd[nbot-1]*dd[nbot]*(aa[nbot-1]*aa[nbot]-bb[nbot-1]*bb[nbot-1]);
+      }
       for (ntry=1;ntry<=6;ntry++) {
-        PetscCall(HZStep(ntop,nbot+1,tr,dt,aa,bb,dd,uu,nn,ld,&flag));
+        /* rows 0..cgd-1 of the active columns of uu are zero, so they are not updated */
+        PetscCall(HZStep(ntop,nbot+1,tr,dt,aa,bb,dd,uu+cgd,nn-cgd,ld,&flag));
         if (!flag) break;
         PetscCheck(ntry<6,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"Unable to complete hz step after six tries");
         tr = 0.9*tr; dt = 0.81*dt;
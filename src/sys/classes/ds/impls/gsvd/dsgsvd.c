@@ -28,7 +28,7 @@ static PetscErrorCode DSAllocate_GSVD(DS ds,PetscInt ld)
   PetscCall(DSAllocateMat_Private(ds,DS_MAT_T));
   PetscCall(DSAllocateMat_Private(ds,DS_MAT_D));
   PetscCall(PetscFree(ds->perm));
-  PetscCall(PetscMalloc1(ld,&ds->perm));
+  PetscCall(PetscMalloc1(2*ld,&ds->perm));  /* the second half is used in DSSort_GSVD() */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -203,8 +203,10 @@ static PetscErrorCode DSSort_GSVD(DS ds,PetscScalar *wr,PetscScalar *wi,PetscSca
   PetscCheck(ctx->m,PetscObjectComm((PetscObject)ds),PETSC_ERR_ORDER,"You should set the other dimensions with DSGSVDSetDimensions()");
   l = ds->l;
   t = ds->t;
-  perm = ds->perm;
-  PetscCall(PetscMalloc2(t,&eig,t,&perm2));
+  perm  = ds->perm;
+  perm2 = ds->perm+ld;
+  PetscCall(DSAllocateWork_Private(ds,0,t,0));
+  eig = ds->rwork;
   if (compact) {
     PetscCall(DSGetArrayReal(ds,DS_MAT_T,&T));
     PetscCall(DSGetArrayReal(ds,DS_MAT_D,&D));
@@ -236,7 +238,6 @@ static PetscErrorCode DSSort_GSVD(DS ds,PetscScalar *wr,PetscScalar *wi,PetscSca
   PetscCall(PetscArraycpy(perm2,perm,t));
   PetscCall(DSPermuteColumns_Private(ds,l,t,ctx->m,DS_MAT_X,perm2));
   PetscCall(DSPermuteColumns_Private(ds,l,t,ctx->p,DS_MAT_V,perm));
-  PetscCall(PetscFree2(eig,perm2));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
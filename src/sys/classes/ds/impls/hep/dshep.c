@@ -10,6 +10,10 @@
 
 #include <slepc/private/dsimpl.h>
 #include <slepcblaslapack.h>
+#include <slepcmagma.h>
+#if defined(SLEPC_HAVE_SCALAPACK)
+#include <slepc/private/slepcscalapack.h>
+#endif
 
 static PetscErrorCode DSAllocate_HEP(DS ds,PetscInt ld)
 {
@@ -84,7 +88,9 @@ static PetscErrorCode DSView_HEP(DS ds,PetscViewer viewer)
                      "Implicit QR method (_steqr)",
                      "Relatively Robust Representations (_stevr)",
                      "Divide and Conquer method (_stedc)",
-                     "Block Divide and Conquer method (dsbtdc)"
+                     "Block Divide and Conquer method (dsbtdc)",
+                     "Divide and Conquer method in the GPU (MAGMA _syevd)",
+                     "Parallel QR method with ScaLAPACK (p_syev)"
   };
   const int         nmeth=PETSC_STATIC_ARRAY_LENGTH(methodname);
 
@@ -136,9 +142,10 @@ static PetscErrorCode DSView_HEP(DS ds,PetscViewer viewer)
 
 static PetscErrorCode DSVectors_HEP(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
 {
-  PetscScalar       *Z;
-  const PetscScalar *Q;
+  PetscScalar       *Z,sone=1.0,szero=0.0;
+  const PetscScalar *Q,*A;
   PetscInt          ld = ds->ld;
+  PetscBLASInt      n,bs,lda,inc=1;
 
   PetscFunctionBegin;
   switch (mat) {
@@ -149,7 +156,17 @@ static PetscErrorCode DSVectors_HEP(DS ds,DSMatType mat,PetscInt *j,PetscReal *r
         if (ds->state>=DS_STATE_CONDENSED) {
           PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_Q],&Q));
           PetscCall(PetscArraycpy(Z+(*j)*ld,Q+(*j)*ld,ld));
-          if (rnorm) *rnorm = PetscAbsScalar(Q[ds->n-1+(*j)*ld]);
+          if (rnorm && !ds->compact && ds->extrarow && ds->bs>1) {
+            /* with a block of extra rows, the residual is the norm of the product by the eigenvector */
+            PetscCall(PetscBLASIntCast(ds->n,&n));
+            PetscCall(PetscBLASIntCast(ds->bs,&bs));
+            PetscCall(PetscBLASIntCast(ld,&lda));
+            PetscCall(DSAllocateWork_Private(ds,bs,0,0));
+            PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_A],&A));
+            PetscCallBLAS("BLASgemv",BLASgemv_("N",&bs,&n,&sone,A+n,&lda,Q+(*j)*ld,&inc,&szero,ds->work,&inc));
+            PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_A],&A));
+            *rnorm = BLASnrm2_(&bs,ds->work,&inc);
+          } else if (rnorm) *rnorm = PetscAbsScalar(Q[ds->n-1+(*j)*ld]);
           PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_Q],&Q));
         } else {
           PetscCall(PetscArrayzero(Z+(*j)*ld,ld));
@@ -348,8 +365,8 @@ static PetscErrorCode DSSort_HEP(DS ds,PetscScalar *wr,PetscScalar *wi,PetscScal
 
 static PetscErrorCode DSUpdateExtraRow_HEP(DS ds)
 {
-  PetscInt          i;
-  PetscBLASInt      n,ld,incx=1;
+  PetscInt          i,j;
+  PetscBLASInt      n,ld,bs,incx=1;
   PetscScalar       *A,*x,*y,one=1.0,zero=0.0;
   PetscReal         *T,*e,beta;
   const PetscScalar *Q;
@@ -365,6 +382,15 @@ static PetscErrorCode DSUpdateExtraRow_HEP(DS ds)
     for (i=0;i<n;i++) e[i] = PetscRealPart(beta*Q[n-1+i*ld]);
     PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&T));
     ds->k = n;
+  } else if (ds->bs>1) {  /* block of bs extra rows, A(n:n+bs,0:n) = A(n:n+bs,0:n)*Q */
+    PetscCall(PetscBLASIntCast(ds->bs,&bs));
+    PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+    PetscCall(DSAllocateWork_Private(ds,bs*ld,0,0));
+    x = ds->work;
+    for (j=0;j<n;j++) for (i=0;i<bs;i++) x[i+j*bs] = A[n+i+j*ld];
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&bs,&n,&n,&one,x,&bs,Q,&ld,&zero,A+n,&ld));
+    ds->k = n;
+    PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
   } else {
     PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
     PetscCall(DSAllocateWork_Private(ds,2*ld,0,0));
@@ -388,7 +414,7 @@ static PetscErrorCode DSSolve_HEP_QR(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscReal      *d,*e;
 
   PetscFunctionBegin;
-  PetscCheck(ds->bs==1,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"This method is not prepared for bs>1");
+  PetscCheck(ds->bs==1 || !ds->compact,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"This method is not prepared for bs>1");
   PetscCall(PetscBLASIntCast(ds->n,&n));
   PetscCall(PetscBLASIntCast(ds->l,&l));
   PetscCall(PetscBLASIntCast(ds->ld,&ld));
@@ -572,7 +598,235 @@ static PetscErrorCode DSSolve_HEP_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MAGMA)
+/*
+   Dense problems are solved with the hybrid CPU/GPU divide and conquer
+   method of MAGMA, while those already in tridiagonal form go to _stedc
+*/
+static PetscErrorCode DSSolve_HEP_MAGMA(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  Mat               At,Qt;  /* trailing submatrices */
+  PetscInt          i;
+  PetscBLASInt      n1,l = 0,n = 0,ld,off,lwork,liwork,iqwork;
+  PetscScalar       *Q,*A,qwork;
+  PetscReal         *d;
+#if defined(PETSC_USE_COMPLEX)
+  PetscBLASInt      lrwork;
+  PetscReal         rqwork;
+#endif
+
+  PetscFunctionBegin;
+  PetscCheck(ds->bs==1,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"This method is not prepared for bs>1");
+  if (ds->compact || ds->state>=DS_STATE_INTERMEDIATE) {
+    PetscCall(DSSolve_HEP_DC(ds,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(SlepcMagmaInit());
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ds->l,&l));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  n1 = n-l;
+  off = l+l*ld;
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+
+  /* copy the trailing part of A to Q, and the locked part to d */
+  PetscCall(DSSetIdentity(ds,DS_MAT_Q));
+  PetscCall(MatDenseGetSubMatrix(ds->omat[DS_MAT_A],ds->l,ds->n,ds->l,ds->n,&At));
+  PetscCall(MatDenseGetSubMatrix(ds->omat[DS_MAT_Q],ds->l,ds->n,ds->l,ds->n,&Qt));
+  PetscCall(MatCopy(At,Qt,SAME_NONZERO_PATTERN));
+  PetscCall(MatDenseRestoreSubMatrix(ds->omat[DS_MAT_A],&At));
+  PetscCall(MatDenseRestoreSubMatrix(ds->omat[DS_MAT_Q],&Qt));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  for (i=0;i<l;i++) d[i] = PetscRealPart(A[i+i*ld]);
+
+  /* solve the eigenproblem, with a workspace query first */
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+  lwork = -1; liwork = -1;
 #if !defined(PETSC_USE_COMPLEX)
+  PetscCallMAGMA(magma_xsyevd,MagmaVec,MagmaLower,n1,Q+off,ld,d+l,&qwork,lwork,&iqwork,liwork);
+  PetscCall(PetscBLASIntCast((PetscInt)qwork,&lwork));
+  liwork = iqwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,0,liwork));
+  PetscCallMAGMA(magma_xsyevd,MagmaVec,MagmaLower,n1,Q+off,ld,d+l,ds->work,lwork,ds->iwork,liwork);
+#else
+  lrwork = -1;
+  PetscCallMAGMA(magma_xsyevd,MagmaVec,MagmaLower,n1,Q+off,ld,d+l,&qwork,lwork,&rqwork,lrwork,&iqwork,liwork);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(qwork),&lwork));
+  PetscCall(PetscBLASIntCast((PetscInt)rqwork,&lrwork));
+  liwork = iqwork;
+  PetscCall(DSAllocateWork_Private(ds,lwork,lrwork,liwork));
+  PetscCallMAGMA(magma_xsyevd,MagmaVec,MagmaLower,n1,Q+off,ld,d+l,ds->work,lwork,ds->rwork,lrwork,ds->iwork,liwork);
+#endif
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  for (i=0;i<n;i++) wr[i] = d[i];
+
+  /* create diagonal matrix as a result */
+  if (ds->compact) PetscCall(PetscArrayzero(d+ld,n-1));
+  else {
+    for (i=l;i<n;i++) PetscCall(PetscArrayzero(A+l+i*ld,n-l));
+    for (i=l;i<n;i++) A[i+i*ld] = d[i];
+  }
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+
+  /* set zero wi */
+  if (wi) for (i=l;i<n;i++) wi[i] = 0.0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+#if defined(SLEPC_HAVE_SCALAPACK)
+/*
+   Dense problems are solved with ScaLAPACK in the communicator of the DS, with the
+   matrix distributed block-cyclically, while those in tridiagonal form go to _stedc.
+   Problems in compact storage are expanded to dense form first, so that the projected
+   problems of thick-restart Lanczos (and the BSE variants based on it) are also distributed
+*/
+static PetscErrorCode DSSolve_HEP_ScaLAPACK(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  Mat               S,Z;
+  Mat_ScaLAPACK     *s,*z;
+  PetscInt          i,l=ds->l,n=ds->n,ld=ds->ld,off;
+  PetscBLASInt      n1,lwork=-1,info,one=1;
+  PetscScalar       *Q,*A,minlwork[3];
+  PetscReal         *d;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal         minlrwork[3];
+  PetscBLASInt      lrwork=-1;
+#endif
+
+  PetscFunctionBegin;
+  PetscCheck(ds->bs==1,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"This method is not prepared for bs>1");
+  if (!ds->compact && ds->state>=DS_STATE_INTERMEDIATE) {
+    PetscCall(DSSolve_HEP_DC(ds,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscBLASIntCast(n-l,&n1));
+  off = l+l*ld;
+  /* in compact storage, the arrowhead or tridiagonal matrix is expanded so that it can be distributed */
+  if (ds->compact) {
+    PetscCall(DSAllocateMat_Private(ds,DS_MAT_A));
+    PetscCall(DSSwitchFormat_HEP(ds));
+  }
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+
+  /* distribute the trailing part of A, and copy the locked part to d */
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  for (i=0;i<l;i++) d[i] = PetscRealPart(A[i+i*ld]);
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n-l,n-l,A+off,ld,&S));
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n-l,n-l,NULL,0,&Z));
+  s = (Mat_ScaLAPACK*)S->data;
+  z = (Mat_ScaLAPACK*)Z->data;
+
+  /* solve the eigenproblem, with a workspace query first */
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("SCALAPACKsyev",SCALAPACKsyev_("V","L",&n1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,minlwork,&lwork,&info));
+  PetscCheckScaLapackInfo("syev",info);
+  PetscCall(PetscBLASIntCast((PetscInt)minlwork[0],&lwork));
+  PetscCall(DSAllocateWork_Private(ds,lwork,0,0));
+  PetscCallBLAS("SCALAPACKsyev",SCALAPACKsyev_("V","L",&n1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,ds->work,&lwork,&info));
+#else
+  PetscCallBLAS("SCALAPACKsyev",SCALAPACKsyev_("V","L",&n1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,minlwork,&lwork,minlrwork,&lrwork,&info));
+  PetscCheckScaLapackInfo("syev",info);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(minlwork[0]),&lwork));
+  lrwork = 4*n1;  /* the query value is not reliable, see EPSSCALAPACK */
+  PetscCall(DSAllocateWork_Private(ds,lwork,lrwork,0));
+  PetscCallBLAS("SCALAPACKsyev",SCALAPACKsyev_("V","L",&n1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,ds->work,&lwork,ds->rwork,&lrwork,&info));
+#endif
+  PetscCheckScaLapackInfo("syev",info);
+  for (i=0;i<n;i++) wr[i] = d[i];
+
+  /* gather the eigenvectors in Q */
+  PetscCall(DSSetIdentity(ds,DS_MAT_Q));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+  PetscCall(DSCopyFromScaLAPACK_Private(ds,Z,Q+off,ld));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  PetscCall(MatDestroy(&S));
+  PetscCall(MatDestroy(&Z));
+
+  /* create diagonal matrix as a result */
+  for (i=l;i<n;i++) PetscCall(PetscArrayzero(A+l+i*ld,n-l));
+  for (i=l;i<n;i++) A[i+i*ld] = d[i];
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+
+  /* set zero wi */
+  if (wi) for (i=l;i<n;i++) wi[i] = 0.0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+#if !defined(PETSC_USE_COMPLEX)
+/*
+   Compact storage: the arrowhead A(l:k,l:k) obtained in a thick restart is taken as the first
+   diagonal block of a block tridiagonal matrix, and the tridiagonal tail is split in blocks
+   of similar size. Each subdiagonal block has rank one, so the merges in dsbtdc deflate the
+   problem efficiently, and the arrowhead is never reduced to tridiagonal form. The locked
+   part is not modified.
+*/
+static PetscErrorCode DSSolve_HEP_BDC_Compact(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  PetscBLASInt   i,j,m,n1,nblks,kmax,ldd,lde,lrwork,liwork,ld,off,*ksizes,*iwork,mingapi,info,start,ksizes_first;
+  PetscInt       l=ds->l,n=ds->n;
+  PetscScalar    *Q;
+  PetscReal      *D,*E,*d,*e,tol=PETSC_MACHINE_EPSILON/2,tau1=1e-16,tau2=1e-18,*rwork,mingap;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  PetscCall(PetscBLASIntCast(n-l,&n1));
+  off = l+l*ld;
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+  e = d+ld;
+  for (i=0;i<l;i++) wr[i] = d[i];
+
+  /* block sizes: the arrowhead first, then blocks of the tridiagonal part */
+  PetscCall(PetscBLASIntCast((ds->state<DS_STATE_INTERMEDIATE)? PetscMax(1,ds->k-l+1): 1,&ksizes_first));
+  kmax  = PetscMin(n1,PetscMax(ksizes_first,16));
+  nblks = 1+(n1-ksizes_first+kmax-1)/kmax;
+  ldd   = PetscMax(3,kmax);
+  lde   = PetscMax(3,2*kmax+1);
+  lrwork = 4*n1*n1+60*n1+1;
+  liwork = 5*n1+5*nblks-1;
+  PetscCall(DSAllocateWork_Private(ds,ldd*ldd*nblks+lde*lde*(nblks-1),lrwork,nblks+liwork));
+  D      = ds->work;
+  E      = ds->work+ldd*ldd*nblks;
+  rwork  = ds->rwork;
+  ksizes = ds->iwork;
+  iwork  = ds->iwork+nblks;
+  PetscCall(PetscArrayzero(D,ldd*ldd*nblks+lde*lde*(nblks-1)));
+  PetscCall(PetscArrayzero(iwork,liwork));
+  ksizes[0] = ksizes_first;
+  for (i=1;i<nblks;i++) ksizes[i] = PetscMin(kmax,n1-ksizes_first-(i-1)*kmax);
+
+  /* copy the arrowhead and the tridiagonal blocks, and the coupling entries */
+  m = ksizes[0];
+  for (i=0;i<m;i++) D[i+i*ldd] = d[l+i];
+  for (i=0;i<m-1;i++) D[m-1+i*ldd] = D[i+(m-1)*ldd] = e[l+i];
+  start = m;
+  for (j=1;j<nblks;j++) {
+    m = ksizes[j];
+    E[(ksizes[j-1]-1)*lde+(j-1)*lde*lde] = e[l+start-1];
+    for (i=0;i<m;i++) D[i+i*ldd+j*ldd*ldd] = d[l+start+i];
+    for (i=0;i<m-1;i++) D[i+1+i*ldd+j*ldd*ldd] = D[i+(i+1)*ldd+j*ldd*ldd] = e[l+start+i];
+    start += m;
+  }
+
+  /* solve the block tridiagonal eigenproblem */
+  PetscCall(DSSetIdentity(ds,DS_MAT_Q));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+  PetscCall(BDC_dsbtdc_("D","A",n1,nblks,ksizes,D,ldd,ldd,E,lde,lde,tol,tau1,tau2,d+l,Q+off,ld,rwork,lrwork,iwork,liwork,&mingap,&mingapi,&info,1,1));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  for (i=l;i<n;i++) wr[i] = d[i];
+
+  /* create diagonal matrix as a result */
+  PetscCall(PetscArrayzero(e,n-1));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+
+  /* set zero wi */
+  if (wi) for (i=l;i<n;i++) wi[i] = 0.0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DSSolve_HEP_BDC(DS ds,PetscScalar *wr,PetscScalar *wi)
 {
   PetscBLASInt   i,j,k,m,n = 0,info,nblks,bs = 0,ld = 0,lde,lrwork,liwork,*ksizes,*iwork,mingapi;
@@ -580,8 +834,11 @@ static PetscErrorCode DSSolve_HEP_BDC(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscReal      *D,*E,*d,*e,tol=PETSC_MACHINE_EPSILON/2,tau1=1e-16,tau2=1e-18,*rwork,mingap;
 
   PetscFunctionBegin;
+  if (ds->compact) {
+    PetscCall(DSSolve_HEP_BDC_Compact(ds,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCheck(ds->l==0,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"This method is not prepared for l>1");
-  PetscCheck(!ds->compact,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented for compact storage");
   PetscCall(PetscBLASIntCast(ds->ld,&ld));
   PetscCall(PetscBLASIntCast(ds->bs,&bs));
   PetscCall(PetscBLASIntCast(ds->n,&n));
@@ -642,21 +899,25 @@ static PetscErrorCode DSSolve_HEP_BDC(DS ds,PetscScalar *wr,PetscScalar *wi)
 
 static PetscErrorCode DSTruncate_HEP(DS ds,PetscInt n,PetscBool trim)
 {
-  PetscInt    i,ld=ds->ld,l=ds->l;
+  PetscInt    i,j,ld=ds->ld,l=ds->l;
   PetscScalar *A;
 
   PetscFunctionBegin;
   if (!ds->compact && ds->extrarow) PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
   if (trim) {
     if (!ds->compact && ds->extrarow) {   /* clean extra row */
-      for (i=l;i<ds->n;i++) A[ds->n+i*ld] = 0.0;
+      for (j=0;j<ds->bs;j++) for (i=l;i<ds->n;i++) A[ds->n+j+i*ld] = 0.0;
     }
     ds->l = 0;
     ds->k = 0;
     ds->n = n;
     ds->t = ds->n;   /* truncated length equal to the new dimension */
   } else {
-    if (!ds->compact && ds->extrarow && ds->k==ds->n) {
+    if (!ds->compact && ds->extrarow && ds->k==ds->n && ds->bs>1) {
+      /* copy the block of extra rows to the new position, then clean the old rows */
+      for (j=0;j<ds->bs;j++) for (i=l;i<n;i++) A[n+j+i*ld] = A[ds->n+j+i*ld];
+      for (j=0;j<ds->bs;j++) if (ds->n+j>=n+ds->bs) for (i=l;i<ds->n;i++) A[ds->n+j+i*ld] = 0.0;
+    } else if (!ds->compact && ds->extrarow && ds->k==ds->n) {
       /* copy entries of extra row to the new position, then clean last row */
       for (i=l;i<n;i++) A[n+i*ld] = A[ds->n+i*ld];
       for (i=l;i<ds->n;i++) A[ds->n+i*ld] = 0.0;
@@ -845,7 +1106,10 @@ static PetscErrorCode DSSetCompact_HEP(DS ds,PetscBool comp)
 +  0 - Implicit QR (_steqr)
 .  1 - Multiple Relatively Robust Representations (_stevr)
 .  2 - Divide and Conquer (_stedc)
--  3 - Block Divide and Conquer (real scalars only)
+.  3 - Block Divide and Conquer (real scalars only), in compact storage the arrowhead is
+   taken as a diagonal block without reducing it to tridiagonal form
+.  4 - Divide and Conquer in the GPU (MAGMA _syevd), only for non-compact storage
+-  5 - Parallel QR with ScaLAPACK (p_syev), in compact storage the matrix is first expanded to dense form
 
 .seealso: DSCreate(), DSSetType(), DSType
 M*/
@@ -860,6 +1124,12 @@ SLEPC_EXTERN PetscErrorCode DSCreate_HEP(DS ds)
   ds->ops->solve[2]      = DSSolve_HEP_DC;
 #if !defined(PETSC_USE_COMPLEX)
   ds->ops->solve[3]      = DSSolve_HEP_BDC;
+#endif
+#if defined(PETSC_HAVE_MAGMA)
+  ds->ops->solve[4]      = DSSolve_HEP_MAGMA;
+#endif
+#if defined(SLEPC_HAVE_SCALAPACK)
+  ds->ops->solve[5]      = DSSolve_HEP_ScaLAPACK;
 #endif
   ds->ops->sort          = DSSort_HEP;
   ds->ops->truncate      = DSTruncate_HEP;
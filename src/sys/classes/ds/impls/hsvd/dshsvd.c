@@ -62,7 +62,8 @@ static PetscErrorCode DSView_HSVD(DS ds,PetscViewer viewer)
   PetscInt          i,j,r,c,m=ctx->m,rows,cols;
   PetscReal         *T,*S,value;
   const char        *methodname[] = {
-                     "Cross product A'*Omega*A"
+                     "Cross product A'*Omega*A",
+                     "One-sided Jacobi"
   };
   const int         nmeth=PETSC_STATIC_ARRAY_LENGTH(methodname);
 
@@ -389,6 +390,172 @@ static PetscErrorCode DSSolve_HSVD_CROSS(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Applies a Jacobi rotation to columns p and q of W (and V) so that they become
+   orthogonal with respect to the signature om, returns 1 if the rotation is done
+*/
+static inline PetscInt DSHSVDJacobiRotate(PetscInt nr,PetscInt nc,PetscScalar *W,PetscInt ldw,PetscScalar *V,PetscInt ldv,const PetscReal *om,PetscInt p,PetscInt q,PetscReal tol)
+{
+  PetscInt    i;
+  PetscReal   app=0.0,aqq=0.0,g,zeta,t,c,s;
+  PetscScalar apq=0.0,ph,xp,xq,*wp=W+p*ldw,*wq=W+q*ldw,*vp=V+p*ldv,*vq=V+q*ldv;
+
+  for (i=0;i<nr;i++) {
+    app += om[i]*PetscRealPart(PetscConj(wp[i])*wp[i]);
+    aqq += om[i]*PetscRealPart(PetscConj(wq[i])*wq[i]);
+    apq += om[i]*PetscConj(wp[i])*wq[i];
+  }
+  g = PetscAbsScalar(apq);
+  if (g==0.0 || g<=tol*PetscSqrtReal(PetscAbsReal(app*aqq))) return 0;
+  ph   = apq/g;
+  zeta = (aqq-app)/(2.0*g);
+  t    = ((zeta>=0.0)? 1.0: -1.0)/(PetscAbsReal(zeta)+PetscSqrtReal(1.0+zeta*zeta));
+  c    = 1.0/PetscSqrtReal(1.0+t*t);
+  s    = c*t;
+  for (i=0;i<nr;i++) {
+    xp = wp[i]; xq = PetscConj(ph)*wq[i];
+    wp[i] = c*xp-s*xq;
+    wq[i] = s*xp+c*xq;
+  }
+  for (i=0;i<nc;i++) {
+    xp = vp[i]; xq = PetscConj(ph)*vq[i];
+    vp[i] = c*xp-s*xq;
+    vq[i] = s*xp+c*xq;
+  }
+  return 1;
+}
+
+/*
+   One-sided Jacobi: the columns of W=A*V are made orthogonal with respect to Omega
+   by plane rotations applied from the right, so that V is orthogonal and it is not
+   necessary to form the cross product A'*Omega*A. The rotations of each step of the
+   round-robin ordering act on disjoint pairs of columns and are done in parallel
+   with OpenMP threads
+*/
+static PetscErrorCode DSSolve_HSVD_JACOBI(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  DS_HSVD        *ctx = (DS_HSVD*)ds->data;
+  PetscInt       i,j,k=ds->k,r0,nr,nc,np,sweep,step,nrot,maxsweep=60,swu=0,rwu=0,iwu=0,nv,*arr,tmp;
+  PetscBLASInt   l=0,n=0,m=0,ld,n1,off,one=1,*perm,*cmplx;
+  PetscScalar    *A,*U,*V,*W,*R,scal;
+  PetscReal      *d,*e,*Omega,*om,*dd,tol;
+
+  PetscFunctionBegin;
+  PetscCheck(ctx->m,PetscObjectComm((PetscObject)ds),PETSC_ERR_ORDER,"You should set the number of columns with DSHSVDSetDimensions()");
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ctx->m,&m));
+  PetscCheck(!ds->compact || n==m,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented for non-square matrices in compact storage");
+  PetscCheck(ds->compact || n>=m,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented for the case of more columns than rows");
+  PetscCall(PetscBLASIntCast(ds->l,&l));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  n1  = n-l;
+  off = l+l*ld;
+  r0  = ds->compact? l: 0;  /* first row of the active block */
+  nr  = n-r0;
+  nc  = m-l;
+  np  = nc+(nc%2);          /* a dummy column is added if nc is odd */
+  PetscCall(DSAllocateWork_Private(ds,(n+6)*ld+nr*nc,2*ld,2*ld+np));
+  R = ds->work+swu;
+  swu += n*ld;
+  W = ds->work+swu;
+  swu += nr*nc;
+  om = ds->rwork+rwu;
+  rwu += ld;
+  dd = ds->rwork+rwu;
+  rwu += ld;
+  perm = ds->iwork+iwu;
+  iwu += ld;
+  cmplx = ds->iwork+iwu;
+  iwu += ld;
+  arr = ds->iwork+iwu;
+
+  if (!ds->compact) PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+  e = d+ld;
+  PetscCall(DSGetArrayReal(ds,DS_MAT_D,&Omega));
+  PetscCall(PetscArrayzero(U,ld*ld));
+  for (i=0;i<l;i++) U[i+i*ld] = 1.0;
+  PetscCall(PetscArrayzero(V,ld*ld));
+  for (i=0;i<m;i++) V[i+i*ld] = 1.0;
+  for (i=0;i<l;i++) wr[i] = d[i];
+  if (wi) for (i=0;i<l;i++) wi[i] = 0.0;
+
+  /* copy the active block to W, expanding the arrow bidiagonal in compact storage */
+  PetscCall(PetscArrayzero(W,nr*nc));
+  if (ds->compact) {
+    for (i=l;i<n;i++) W[i-l+(i-l)*nr] = d[i];
+    for (i=l;i<k;i++) W[i-l+(k-l)*nr] = e[i];
+    for (i=PetscMax(k,l);i<n-1;i++) W[i-l+(i+1-l)*nr] = e[i];
+  } else {
+    for (j=l;j<m;j++) PetscCall(PetscArraycpy(W+(j-l)*nr,A+j*ld,nr));
+  }
+  for (i=0;i<nr;i++) om[i] = Omega[r0+i];
+
+  /* sweeps of the round-robin ordering */
+  tol = nr*PETSC_MACHINE_EPSILON;
+  for (i=0;i<np;i++) arr[i] = i;
+  for (sweep=0;sweep<maxsweep;sweep++) {
+    nrot = 0;
+    for (step=0;step<np-1;step++) {
+#if defined(PETSC_HAVE_OPENMP)
+      #pragma omp parallel for reduction(+:nrot) schedule(static) if(np*nr>=16384)
+#endif
+      for (j=0;j<np/2;j++) {
+        PetscInt p = PetscMin(arr[j],arr[np-1-j]),q = PetscMax(arr[j],arr[np-1-j]);
+        if (q<nc) nrot += DSHSVDJacobiRotate(nr,nc,W,nr,V+off,ld,om,p,q,tol);
+      }
+      tmp = arr[np-1];
+      for (i=np-1;i>1;i--) arr[i] = arr[i-1];
+      arr[1] = tmp;
+    }
+    if (!nrot) break;
+  }
+  PetscCheck(sweep<maxsweep,PETSC_COMM_SELF,PETSC_ERR_CONV_FAILED,"The one-sided Jacobi method did not converge in %" PetscInt_FMT " sweeps",maxsweep);
+  PetscCall(PetscInfo(ds,"One-sided Jacobi converged in %" PetscInt_FMT " sweeps\n",sweep+1));
+
+  /* singular values, new signature and left singular vectors U=W*Sigma^-1 */
+  for (j=0;j<nc;j++) {
+    dd[l+j] = 0.0;
+    for (i=0;i<nr;i++) dd[l+j] += om[i]*PetscRealPart(PetscConj(W[i+j*nr])*W[i+j*nr]);
+    d[l+j] = PetscSqrtReal(PetscAbsReal(dd[l+j]));
+    scal = 1.0/d[l+j];
+    for (i=0;i<nr;i++) U[r0+i+(l+j)*ld] = scal*W[i+j*nr];
+  }
+
+  if (ctx->reorth) { /* Reinforce orthogonality */
+    nv = n1;
+    for (i=0;i<n;i++) cmplx[i] = 0;
+    PetscCall(DSPseudoOrthog_HR(&nv,U+off,ld,Omega+l,R,ld,perm,cmplx,NULL,ds->work+swu));
+  } else { /* Update Omega */
+    for (i=l;i<m;i++) Omega[i] = PetscSign(dd[i]);
+  }
+
+  /* Update projected problem */
+  if (ds->compact) PetscCall(PetscArrayzero(e,n-1));
+  else {
+    for (i=l;i<m;i++) PetscCall(PetscArrayzero(A+l+i*ld,n-l));
+    for (i=l;i<m;i++) A[i+i*ld] = d[i];
+  }
+  for (i=l;i<m;i++) wr[i] = d[i];
+  if (wi) for (i=l;i<m;i++) wi[i] = 0.0;
+
+  if (ctx->reorth) { /* Update vectors V with R */
+    scal = -1.0;
+    for (i=0;i<nv;i++) {
+      if (PetscRealPart(R[i+i*ld]) < 0.0) PetscCallBLAS("BLASscal",BLASscal_(&n1,&scal,V+(i+l)*ld+l,&one));
+    }
+  }
+
+  if (!ds->compact) PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_D,&Omega));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #if !defined(PETSC_HAVE_MPIUNI)
 static PetscErrorCode DSSynchronize_HSVD(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
@@ -688,7 +855,14 @@ static PetscErrorCode DSSetCompact_HSVD(DS ds,PetscBool comp)
 -  DS_MAT_V - right singular vectors
 
    Implemented methods:
-.  0 - Cross product A'*Omega*A
++  0 - Cross product A'*Omega*A
+-  1 - One-sided Jacobi
+
+   The one-sided Jacobi method avoids forming the cross product, so it is more
+   accurate for small singular values, and the rotations on disjoint pairs of
+   columns are applied in parallel if PETSc is configured with OpenMP. It may be
+   faster than the cross product for large projected problems when several
+   threads are available.
 
 .seealso: DSCreate(), DSSetType(), DSType, DSHSVDSetDimensions()
 M*/
@@ -705,6 +879,7 @@ SLEPC_EXTERN PetscErrorCode DSCreate_HSVD(DS ds)
   ds->ops->view           = DSView_HSVD;
   ds->ops->vectors        = DSVectors_HSVD;
   ds->ops->solve[0]       = DSSolve_HSVD_CROSS;
+  ds->ops->solve[1]       = DSSolve_HSVD_JACOBI;
   ds->ops->sort           = DSSort_HSVD;
   ds->ops->truncate       = DSTruncate_HSVD;
   ds->ops->update         = DSUpdateExtraRow_HSVD;
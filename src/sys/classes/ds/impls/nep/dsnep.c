@@ -10,6 +10,9 @@
 
 #include <slepc/private/dsimpl.h>       /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 typedef struct {
   PetscInt       nf;                 /* number of functions in f[] */
@@ -360,6 +363,66 @@ static PetscErrorCode DSNEPNewtonRefine(DS ds,PetscInt k,PetscScalar *wr)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Loop of integration points of the contour integral, distributed among nt OpenMP
+   threads. The functions are evaluated beforehand, so that the threads only call
+   BLAS and LAPACK, each one with its own copy of T(z_k), the right-hand sides and
+   the moments, which are accumulated in S at the end
+*/
+static PetscErrorCode DSNEPContourPoints_OpenMP(DS ds,PetscInt nt,PetscInt kstart,PetscInt kend,PetscBLASInt n,PetscBLASInt p,const PetscScalar *z,const PetscScalar *zn,PetscScalar *w,const PetscScalar *Rc,PetscScalar *S)
+{
+  DS_NEP            *ctx = (DS_NEP*)ds->data;
+  const PetscScalar *E[DS_NUM_EXTRA];
+  PetscScalar       *fv,*Wt,*Rt,*St;
+  PetscBLASInt      *pt,*tinfo,ld;
+  PetscInt          i,t,nf=ctx->nf,nS=2*ctx->max_mid*n*p;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  PetscCall(PetscMalloc1(nf*(kend-kstart),&fv));
+  PetscCall(PetscInfo(NULL,"Solving integration points %" PetscInt_FMT " to %" PetscInt_FMT "\n",kstart,kend-1));
+  for (i=0;i<nf;i++) PetscCall(FNEvaluateFunctionArray(ctx->f[i],kend-kstart,z+kstart,fv+i*(kend-kstart)));
+  for (i=0;i<nf;i++) PetscCall(MatDenseGetArrayRead(ds->omat[DSMatExtra[i]],&E[i]));
+  PetscCall(PetscMalloc5(nt*n*n,&Wt,nt*n*p,&Rt,nt*nS,&St,nt*n,&pt,nt,&tinfo));
+  PetscCall(PetscArrayzero(St,nt*nS));
+  #pragma omp parallel num_threads((int)nt)
+  {
+    int          th = omp_get_thread_num();
+    PetscScalar  *W = Wt+th*n*n,*R = Rt+th*n*p,*Sl = St+th*nS,alpha;
+    PetscBLASInt *perm = pt+th*n,info = 0,inc = 1;
+    PetscInt     ii,jj,kk,ff,s,off;
+
+    for (kk=kstart+th;kk<kend && !info;kk+=nt) {
+      /* T(z_k) = sum_i f_i(z_k)*E_i, with leading dimension n */
+      for (jj=0;jj<n;jj++) {
+        for (ii=0;ii<n;ii++) W[ii+jj*n] = 0.0;
+        for (ff=0;ff<nf;ff++) {
+          alpha = fv[(kk-kstart)+ff*(kend-kstart)];
+          BLASaxpy_(&n,&alpha,(PetscScalar*)E[ff]+jj*ld,&inc,W+jj*n,&inc);
+        }
+      }
+      for (ii=0;ii<n*p;ii++) R[ii] = Rc[ii];
+      LAPACKgetrf_(&n,&n,W,&n,perm,&info);
+      if (!info) LAPACKgetrs_("N",&n,&p,W,&n,perm,R,&n,&info);
+      if (info) break;
+      for (s=0;s<2*ctx->max_mid;s++) {
+        off = s*n*p;
+        for (ii=0;ii<n*p;ii++) Sl[off+ii] += w[kk]*R[ii];
+        w[kk] *= zn[kk];
+      }
+    }
+    tinfo[th] = info;
+  }
+  for (i=0;i<nf;i++) PetscCall(MatDenseRestoreArrayRead(ds->omat[DSMatExtra[i]],&E[i]));
+  for (t=0;t<nt;t++) SlepcCheckLapackInfo("getrf/getrs",tinfo[t]);
+  for (t=0;t<nt;t++) for (i=0;i<nS;i++) S[i] += St[i+t*nS];
+  PetscCall(PetscFree5(Wt,Rt,St,pt,tinfo));
+  PetscCall(PetscFree(fv));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 PetscErrorCode DSSolve_NEP_Contour(DS ds,PetscScalar *wr,PetscScalar *wi)
 {
   DS_NEP         *ctx = (DS_NEP*)ds->data;
@@ -367,7 +430,7 @@ PetscErrorCode DSSolve_NEP_Contour(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscScalar    sone=1.0,szero=0.0,center,a;
   PetscReal      *rwork,norm,radius,vscale,rgscale,*sigma;
   PetscBLASInt   info,n,*perm,p,pp,ld,lwork,k_,rk_,colA,rowA,one=1;
-  PetscInt       mid,lds,nnod=ctx->nnod,k,i,ii,jj,j,s,off,rk,nwu=0,nw,lrwork,*inside,kstart=0,kend=nnod;
+  PetscInt       mid,lds,nnod=ctx->nnod,k,i,ii,jj,j,s,off,rk,nwu=0,nw,lrwork,*inside,kstart=0,kend=nnod,nt=1;
   PetscMPIInt    len;
   PetscBool      isellipse;
   PetscRandom    rand;
@@ -430,26 +493,33 @@ PetscErrorCode DSSolve_NEP_Contour(DS ds,PetscScalar *wr,PetscScalar *wi)
   for (j=0;j<p;j++)
     for (i=0;i<n;i++) PetscCall(PetscRandomGetValue(rand,Rc+i+j*n));
   PetscCall(PetscArrayzero(S,2*mid*n*p));
-  /* Loop of integration points */
-  for (k=kstart;k<kend;k++) {
-    PetscCall(PetscInfo(NULL,"Solving integration point %" PetscInt_FMT "\n",k));
-    PetscCall(PetscArraycpy(R,Rc,p*n));
-    PetscCall(DSNEPComputeMatrix(ds,z[k],PETSC_FALSE,DS_MAT_W));
-
-    /* LU factorization */
-    PetscCall(MatDenseGetArray(ds->omat[DS_MAT_W],&W));
-    PetscCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,W,&ld,perm,&info));
-    SlepcCheckLapackInfo("getrf",info);
-    PetscCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&n,&p,W,&ld,perm,R,&n,&info));
-    SlepcCheckLapackInfo("getrs",info);
-    PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_W],&W));
-
-    /* Moments computation */
-    for (s=0;s<2*ctx->max_mid;s++) {
-      off = s*n*p;
-      for (j=0;j<p;j++)
-        for (i=0;i<n;i++) S[off+i+j*n] += w[k]*R[j*n+i];
-      w[k] *= zn[k];
+#if defined(PETSC_HAVE_OPENMP)
+  /* a user-provided function that computes the matrix may not be thread safe */
+  if (!ctx->computematrix && !omp_in_parallel()) nt = PetscMin(omp_get_max_threads(),kend-kstart);
+  if (nt>1) PetscCall(DSNEPContourPoints_OpenMP(ds,nt,kstart,kend,n,p,z,zn,w,Rc,S));
+#endif
+  if (nt==1) {
+    /* Loop of integration points */
+    for (k=kstart;k<kend;k++) {
+      PetscCall(PetscInfo(NULL,"Solving integration point %" PetscInt_FMT "\n",k));
+      PetscCall(PetscArraycpy(R,Rc,p*n));
+      PetscCall(DSNEPComputeMatrix(ds,z[k],PETSC_FALSE,DS_MAT_W));
+
+      /* LU factorization */
+      PetscCall(MatDenseGetArray(ds->omat[DS_MAT_W],&W));
+      PetscCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,W,&ld,perm,&info));
+      SlepcCheckLapackInfo("getrf",info);
+      PetscCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&n,&p,W,&ld,perm,R,&n,&info));
+      SlepcCheckLapackInfo("getrs",info);
+      PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_W],&W));
+
+      /* Moments computation */
+      for (s=0;s<2*ctx->max_mid;s++) {
+        off = s*n*p;
+        for (j=0;j<p;j++)
+          for (i=0;i<n;i++) S[off+i+j*n] += w[k]*R[j*n+i];
+        w[k] *= zn[k];
+      }
     }
   }
 
@@ -1287,6 +1357,12 @@ static PetscErrorCode DSMatGetSize_NEP(DS ds,DSMatType t,PetscInt *rows,PetscInt
 +  0 - Successive Linear Problems (SLP), computes just one eigenpair
 -  1 - Contour integral, computes all eigenvalues inside a region
 
+   In the contour integral method, the integration points can be split among
+   the MPI processes with DSSetParallel() in 'distributed' mode. In addition,
+   if PETSc has been configured with OpenMP, the integration points of each
+   process are distributed among the OpenMP threads, unless a callback has been
+   set with DSNEPSetComputeMatrixFunction().
+
 .seealso: DSCreate(), DSSetType(), DSType, DSNEPSetFN(), DSNEPSetComputeMatrixFunction()
 M*/
 SLEPC_EXTERN PetscErrorCode DSCreate_NEP(DS ds)
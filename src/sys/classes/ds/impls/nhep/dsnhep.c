@@ -10,6 +10,7 @@
 
 #include <slepc/private/dsimpl.h>
 #include <slepcblaslapack.h>
+#include <slepcmagma.h>
 
 static PetscErrorCode DSAllocate_NHEP(DS ds,PetscInt ld)
 {
@@ -101,7 +102,7 @@ static PetscErrorCode DSVectors_NHEP_Refined_All(DS ds,PetscBool left)
 static PetscErrorCode DSVectors_NHEP_Eigen_Some(DS ds,PetscInt *k,PetscReal *rnorm,PetscBool left)
 {
   PetscInt          i;
-  PetscBLASInt      mm=1,mout,info,ld,n,*select,inc=1,cols=1,zero=0;
+  PetscBLASInt      mm=1,mout,info,ld,n,*select,inc=1,cols=1,zero=0,bs;
   PetscScalar       sone=1.0,szero=0.0;
   PetscReal         norm,done=1.0;
   PetscBool         iscomplex = PETSC_FALSE;
@@ -156,11 +157,25 @@ static PetscErrorCode DSVectors_NHEP_Eigen_Some(DS ds,PetscInt *k,PetscReal *rno
   }
 
   /* set output arguments */
-  if (iscomplex) (*k)++;
-  if (rnorm) {
+  if (rnorm && ds->extrarow && ds->bs>1) {
+    /* with a block of extra rows, the residual is the norm of the product by the eigenvector */
+    PetscCall(PetscBLASIntCast(ds->bs,&bs));
+    PetscCall(DSAllocateWork_Private(ds,2*bs,0,0));
+    PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_A],&A));
+    PetscCallBLAS("BLASgemv",BLASgemv_("N",&bs,&n,&sone,A+n,&ld,Y,&inc,&szero,ds->work,&inc));
+    *rnorm = BLASnrm2_(&bs,ds->work,&inc);
+#if !defined(PETSC_USE_COMPLEX)
+    if (iscomplex) {
+      PetscCallBLAS("BLASgemv",BLASgemv_("N",&bs,&n,&sone,A+n,&ld,Y+ld,&inc,&szero,ds->work+bs,&inc));
+      *rnorm = SlepcAbsEigenvalue(*rnorm,BLASnrm2_(&bs,ds->work+bs,&inc));
+    }
+#endif
+    PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_A],&A));
+  } else if (rnorm) {
     if (iscomplex) *rnorm = SlepcAbsEigenvalue(Y[n-1],Y[n-1+ld]);
     else *rnorm = PetscAbsScalar(Y[n-1]);
   }
+  if (iscomplex) (*k)++;
   PetscCall(MatDenseRestoreArray(ds->omat[left?DS_MAT_Y:DS_MAT_X],&X));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -225,6 +240,71 @@ static PetscErrorCode DSVectors_NHEP_Eigen_All(DS ds,PetscBool left)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Compute eigenvectors jstart..jend-1 with the subset version of _trevc, and backtransform
+   them with a product by Q, so that the cost is proportional to the number of vectors
+*/
+static PetscErrorCode DSVectors_NHEP_Eigen_Range(DS ds,PetscInt jstart,PetscInt jend,PetscBool left)
+{
+  PetscInt          i;
+  PetscBLASInt      n,ld,mm,mout,info,inc=1,cols,zero=0,*select;
+  PetscBool         iscomplex;
+  PetscScalar       *Z,*W,sone=1.0,szero=0.0;
+  const PetscScalar *A,*Q;
+  PetscReal         norm,done=1.0;
+
+  PetscFunctionBegin;
+  PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_A],&A));
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+#if !defined(PETSC_USE_COMPLEX)
+  /* do not split complex conjugate pairs */
+  if (jstart>0 && A[jstart+(jstart-1)*ld]!=0.0) jstart--;
+  if (jend<n && A[jend+(jend-1)*ld]!=0.0) jend++;
+#endif
+  PetscCall(PetscBLASIntCast(jend-jstart,&mm));
+  PetscCall(DSAllocateWork_Private(ds,3*ld+ld*mm,ld,ld));
+  select = ds->iwork;
+  W = ds->work+3*ld;
+  for (i=0;i<n;i++) select[i] = (PetscBLASInt)((i>=jstart && i<jend)? PETSC_TRUE: PETSC_FALSE);
+  PetscCall(MatDenseGetArray(ds->omat[left?DS_MAT_Y:DS_MAT_X],&Z));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKtrevc",LAPACKtrevc_(left?"L":"R","S",select,&n,(PetscScalar*)A,&ld,W,&ld,W,&ld,&mm,&mout,ds->work,&info));
+#else
+  PetscCallBLAS("LAPACKtrevc",LAPACKtrevc_(left?"L":"R","S",select,&n,(PetscScalar*)A,&ld,W,&ld,W,&ld,&mm,&mout,ds->work,ds->rwork,&info));
+#endif
+  SlepcCheckLapackInfo("trevc",info);
+  PetscCheck(mout==mm,PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Inconsistent arguments");
+
+  /* backtransform with matrix Q if DSSolve() has been called */
+  if (ds->state>=DS_STATE_CONDENSED) {
+    PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_Q],&Q));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n,&mm,&n,&sone,Q,&ld,W,&ld,&szero,Z+jstart*ld,&ld));
+    PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_Q],&Q));
+  } else {
+    for (i=0;i<mm;i++) PetscCall(PetscArraycpy(Z+(jstart+i)*ld,W+i*ld,ld));
+  }
+
+  /* normalize eigenvectors */
+  for (i=jstart;i<jend;i++) {
+    iscomplex = (i<n-1 && A[i+1+i*ld]!=0.0)? PETSC_TRUE: PETSC_FALSE;
+    cols = 1;
+    norm = BLASnrm2_(&n,Z+i*ld,&inc);
+#if !defined(PETSC_USE_COMPLEX)
+    if (iscomplex) {
+      norm = SlepcAbsEigenvalue(norm,BLASnrm2_(&n,Z+(i+1)*ld,&inc));
+      cols = 2;
+    }
+#endif
+    PetscCallBLAS("LAPACKlascl",LAPACKlascl_("G",&zero,&zero,&norm,&done,&n,&cols,Z+i*ld,&ld,&info));
+    SlepcCheckLapackInfo("lascl",info);
+    if (iscomplex) i++;
+  }
+  PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArray(ds->omat[left?DS_MAT_Y:DS_MAT_X],&Z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DSVectors_NHEP(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
 {
   PetscFunctionBegin;
@@ -253,6 +333,31 @@ static PetscErrorCode DSVectors_NHEP(DS ds,DSMatType mat,PetscInt *j,PetscReal *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode DSVectorsRange_NHEP(DS ds,DSMatType mat,PetscInt jstart,PetscInt jend)
+{
+  PetscInt j;
+
+  PetscFunctionBegin;
+  switch (mat) {
+    case DS_MAT_X:
+      if (ds->refined) {
+        PetscCheck(ds->extrarow,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Refined vectors require activating the extra row");
+        for (j=jstart;j<jend;j++) PetscCall(DSVectors_NHEP_Refined_Some(ds,&j,NULL,PETSC_FALSE));
+      } else PetscCall(DSVectors_NHEP_Eigen_Range(ds,jstart,jend,PETSC_FALSE));
+      break;
+    case DS_MAT_Y:
+      PetscCheck(!ds->refined,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented yet");
+      PetscCall(DSVectors_NHEP_Eigen_Range(ds,jstart,jend,PETSC_TRUE));
+      break;
+    case DS_MAT_U:
+    case DS_MAT_V:
+      SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented yet");
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_OUTOFRANGE,"Invalid mat parameter");
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DSSort_NHEP_Arbitrary(DS ds,PetscScalar *wr,PetscScalar *wi,PetscScalar *rr,PetscScalar *ri,PetscInt *k)
 {
   PetscInt       i;
@@ -317,22 +422,30 @@ static PetscErrorCode DSSortWithPermutation_NHEP(DS ds,PetscInt *perm,PetscScala
 
 static PetscErrorCode DSUpdateExtraRow_NHEP(DS ds)
 {
-  PetscInt          i;
-  PetscBLASInt      n,ld,incx=1;
+  PetscInt          i,j;
+  PetscBLASInt      n,ld,bs,incx=1;
   PetscScalar       *A,*x,*y,one=1.0,zero=0.0;
   const PetscScalar *Q;
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(ds->n,&n));
   PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  PetscCall(PetscBLASIntCast(ds->bs,&bs));
   PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
   PetscCall(MatDenseGetArrayRead(ds->omat[DS_MAT_Q],&Q));
-  PetscCall(DSAllocateWork_Private(ds,2*ld,0,0));
-  x = ds->work;
-  y = ds->work+ld;
-  for (i=0;i<n;i++) x[i] = PetscConj(A[n+i*ld]);
-  PetscCallBLAS("BLASgemv",BLASgemv_("C",&n,&n,&one,Q,&ld,x,&incx,&zero,y,&incx));
-  for (i=0;i<n;i++) A[n+i*ld] = PetscConj(y[i]);
+  if (bs>1) {  /* block of bs extra rows, A(n:n+bs,0:n) = A(n:n+bs,0:n)*Q */
+    PetscCall(DSAllocateWork_Private(ds,bs*ld,0,0));
+    x = ds->work;
+    for (j=0;j<n;j++) for (i=0;i<bs;i++) x[i+j*bs] = A[n+i+j*ld];
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&bs,&n,&n,&one,x,&bs,Q,&ld,&zero,A+n,&ld));
+  } else {
+    PetscCall(DSAllocateWork_Private(ds,2*ld,0,0));
+    x = ds->work;
+    y = ds->work+ld;
+    for (i=0;i<n;i++) x[i] = PetscConj(A[n+i*ld]);
+    PetscCallBLAS("BLASgemv",BLASgemv_("C",&n,&n,&one,Q,&ld,x,&incx,&zero,y,&incx));
+    for (i=0;i<n;i++) A[n+i*ld] = PetscConj(y[i]);
+  }
   PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
   PetscCall(MatDenseRestoreArrayRead(ds->omat[DS_MAT_Q],&Q));
   ds->k = n;
@@ -349,6 +462,89 @@ static PetscErrorCode DSSolve_NHEP(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MAGMA)
+/*
+   Same as DSSolve_NHEP_Private(), but the reduction to Hessenberg form, which
+   is the dominant cost together with _hseqr, is done with MAGMA in the GPU
+*/
+static PetscErrorCode DSSolve_NHEP_MAGMA(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  PetscScalar    *work,*tau,*A,*Q,qwork;
+  PetscInt       i,j;
+  PetscBLASInt   ilo,lwork,info,n,ld;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscAssertPointer(wi,3);
+#endif
+  if (ds->state>=DS_STATE_INTERMEDIATE) {
+    PetscCall(DSSolve_NHEP_Private(ds,DS_MAT_A,DS_MAT_Q,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_Q],&Q));
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  PetscCall(PetscBLASIntCast(ds->l+1,&ilo));
+
+  /* initialize orthogonal matrix */
+  PetscCall(PetscArrayzero(Q,ld*ld));
+  for (i=0;i<n;i++) Q[i+i*ld] = 1.0;
+  if (n==1) { /* quick return */
+    wr[0] = A[0];
+    if (wi) wi[0] = 0.0;
+    PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+    PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  /* reduce to upper Hessenberg form in the GPU */
+  PetscCall(SlepcMagmaInit());
+  lwork = -1;
+  PetscCallMAGMA(magma_xgehrd2,n,ilo,n,A,ld,NULL,&qwork,lwork);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(qwork),&lwork));
+  lwork = PetscMax(lwork,6*ld);
+  PetscCall(DSAllocateWork_Private(ds,ld+lwork,0,0));
+  tau  = ds->work;
+  work = ds->work+ld;
+  PetscCallMAGMA(magma_xgehrd2,n,ilo,n,A,ld,tau,work,lwork);
+  for (j=0;j<n-1;j++) {
+    for (i=j+2;i<n;i++) {
+      Q[i+j*ld] = A[i+j*ld];
+      A[i+j*ld] = 0.0;
+    }
+  }
+  PetscCallBLAS("LAPACKorghr",LAPACKorghr_(&n,&ilo,&n,Q,&ld,tau,work,&lwork,&info));
+  SlepcCheckLapackInfo("orghr",info);
+
+  /* compute the (real) Schur form */
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("S","V",&n,&ilo,&n,A,&ld,wr,wi,Q,&ld,work,&lwork,&info));
+  for (j=0;j<ds->l;j++) {
+    if (j==n-1 || A[j+1+j*ld] == 0.0) {
+      /* real eigenvalue */
+      wr[j] = A[j+j*ld];
+      wi[j] = 0.0;
+    } else {
+      /* complex eigenvalue */
+      wr[j] = A[j+j*ld];
+      wr[j+1] = A[j+j*ld];
+      wi[j] = PetscSqrtReal(PetscAbsReal(A[j+1+j*ld]))*PetscSqrtReal(PetscAbsReal(A[j+(j+1)*ld]));
+      wi[j+1] = -wi[j];
+      j++;
+    }
+  }
+#else
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("S","V",&n,&ilo,&n,A,&ld,wr,Q,&ld,work,&lwork,&info));
+  if (wi) for (i=ds->l;i<n;i++) wi[i] = 0.0;
+#endif
+  SlepcCheckLapackInfo("hseqr",info);
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_Q],&Q));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 #if !defined(PETSC_HAVE_MPIUNI)
 static PetscErrorCode DSSynchronize_NHEP(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
@@ -393,7 +589,7 @@ static PetscErrorCode DSSynchronize_NHEP(DS ds,PetscScalar eigr[],PetscScalar ei
 
 static PetscErrorCode DSTruncate_NHEP(DS ds,PetscInt n,PetscBool trim)
 {
-  PetscInt    i,ld=ds->ld,l=ds->l;
+  PetscInt    i,j,ld=ds->ld,l=ds->l;
   PetscScalar *A;
 
   PetscFunctionBegin;
@@ -404,14 +600,18 @@ static PetscErrorCode DSTruncate_NHEP(DS ds,PetscInt n,PetscBool trim)
 #endif
   if (trim) {
     if (ds->extrarow) {   /* clean extra row */
-      for (i=l;i<ds->n;i++) A[ds->n+i*ld] = 0.0;
+      for (j=0;j<ds->bs;j++) for (i=l;i<ds->n;i++) A[ds->n+j+i*ld] = 0.0;
     }
     ds->l = 0;
     ds->k = 0;
     ds->n = n;
     ds->t = ds->n;   /* truncated length equal to the new dimension */
   } else {
-    if (ds->extrarow && ds->k==ds->n) {
+    if (ds->extrarow && ds->k==ds->n && ds->bs>1) {
+      /* copy the block of extra rows to the new position, then clean the old rows */
+      for (j=0;j<ds->bs;j++) for (i=l;i<n;i++) A[n+j+i*ld] = A[ds->n+j+i*ld];
+      for (j=0;j<ds->bs;j++) if (ds->n+j>=n+ds->bs) for (i=l;i<ds->n;i++) A[ds->n+j+i*ld] = 0.0;
+    } else if (ds->extrarow && ds->k==ds->n) {
       /* copy entries of extra row to the new position, then clean last row */
       for (i=l;i<n;i++) A[n+i*ld] = A[ds->n+i*ld];
       for (i=l;i<ds->n;i++) A[ds->n+i*ld] = 0.0;
@@ -463,13 +663,56 @@ static PetscErrorCode DSCond_NHEP(DS ds,PetscReal *cond)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Solves B'*x = g, overwriting g, where B=A-tau*eye(n) is nearly upper Hessenberg.
+   This is Gaussian elimination with partial pivoting in which step j only updates
+   the rows that have a nonzero in column j, so the cost is O(n^2) for a Hessenberg
+   matrix with the arrow row left by a Krylov-Schur restart, instead of O(n^3). The
+   multipliers of step j are stored in column j of B, and swaps only involve the
+   columns not yet eliminated. On output, flg is false if B is singular.
+*/
+static PetscErrorCode DSTranslateHarmonic_NHEP_Solve(PetscBLASInt n,PetscScalar *B,PetscBLASInt ld,PetscBLASInt *ipiv,PetscScalar *g,PetscBool *flg)
+{
+  PetscBLASInt i,j,c,r,one=1;
+  PetscScalar  t,lj,done=1.0;
+  PetscReal    amax,nrows=0.0;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  for (j=0;j<n;j++) {
+    r = j; amax = PetscAbsScalar(B[j+j*ld]);
+    for (i=j+1;i<n;i++) if (PetscAbsScalar(B[i+j*ld])>amax) { r = i; amax = PetscAbsScalar(B[i+j*ld]); }
+    if (amax==0.0) PetscFunctionReturn(PETSC_SUCCESS);
+    ipiv[j] = r;
+    if (r!=j) for (c=j;c<n;c++) { t = B[j+c*ld]; B[j+c*ld] = B[r+c*ld]; B[r+c*ld] = t; }
+    for (i=j+1;i<n;i++) {
+      if (B[i+j*ld]==0.0) continue;
+      lj = B[i+j*ld]/B[j+j*ld];
+      B[i+j*ld] = lj;
+      for (c=j+1;c<n;c++) B[i+c*ld] -= lj*B[j+c*ld];
+      nrows += n-j-1;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0*nrows));
+  /* solve U'*y = g and then apply the transposed elimination steps in reverse order */
+  PetscCallBLAS("BLAStrsm",BLAStrsm_("L","U","C","N",&n,&one,&done,B,&ld,g,&ld));
+  for (j=n-2;j>=0;j--) {
+    for (i=j+1;i<n;i++) g[j] -= PetscConj(B[i+j*ld])*g[i];
+    if (ipiv[j]!=j) { t = g[j]; g[j] = g[ipiv[j]]; g[ipiv[j]] = t; }
+  }
+  PetscCall(PetscLogFlops(2.0*n*n));
+  *flg = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DSTranslateHarmonic_NHEP(DS ds,PetscScalar tau,PetscReal beta,PetscBool recover,PetscScalar *gin,PetscReal *gammaout)
 {
   PetscInt          i,j;
-  PetscBLASInt      *ipiv,info,n,ld,one=1,ncol;
+  PetscBLASInt      *ipiv,n,ld,one=1,ncol;
   PetscScalar       *A,*B,*g=gin,*ghat,done=1.0,dmone=-1.0,dzero=0.0;
   const PetscScalar *Q;
   PetscReal         gamma=1.0;
+  PetscBool         flg;
 
   PetscFunctionBegin;
   PetscCall(PetscBLASIntCast(ds->n,&n));
@@ -493,15 +736,11 @@ static PetscErrorCode DSTranslateHarmonic_NHEP(DS ds,PetscScalar tau,PetscReal b
     PetscCall(PetscArrayzero(g,n));
     g[n-1] = beta;
 
-    /* g = (A-tau*eye(n))'\b */
+    /* g = (A-tau*eye(n))'\b, exploiting the (nearly) Hessenberg pattern of A */
     for (i=0;i<n;i++) B[i+i*ld] -= tau;
-    PetscCallBLAS("LAPACKgetrf",LAPACKgetrf_(&n,&n,B,&ld,ipiv,&info));
-    SlepcCheckLapackInfo("getrf",info);
-    PetscCall(PetscLogFlops(2.0*n*n*n/3.0));
-    PetscCallBLAS("LAPACKgetrs",LAPACKgetrs_("C",&n,&one,B,&ld,ipiv,g,&ld,&info));
-    SlepcCheckLapackInfo("getrs",info);
-    PetscCall(PetscLogFlops(2.0*n*n-n));
+    PetscCall(DSTranslateHarmonic_NHEP_Solve(n,B,ld,ipiv,g,&flg));
     PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_W],&B));
+    PetscCheck(flg,PETSC_COMM_SELF,PETSC_ERR_LIB,"The matrix A-tau*I is singular, the target coincides with an eigenvalue of the projected matrix");
 
     /* A = A + g*b' */
     for (i=0;i<n;i++) A[i+(n-1)*ld] += g[i]*beta;
@@ -558,7 +797,8 @@ static PetscErrorCode DSTranslateHarmonic_NHEP(DS ds,PetscScalar tau,PetscReal b
    (intermediate step) or matrix of orthogonal Schur vectors
 
    Implemented methods:
-.  0 - Implicit QR (_hseqr)
++  0 - Implicit QR (_hseqr)
+-  1 - Implicit QR (_hseqr), with the reduction to Hessenberg form in the GPU (MAGMA _gehrd)
 
 .seealso: DSCreate(), DSSetType(), DSType
 M*/
@@ -568,7 +808,11 @@ SLEPC_EXTERN PetscErrorCode DSCreate_NHEP(DS ds)
   ds->ops->allocate        = DSAllocate_NHEP;
   ds->ops->view            = DSView_NHEP;
   ds->ops->vectors         = DSVectors_NHEP;
+  ds->ops->vectorsrange    = DSVectorsRange_NHEP;
   ds->ops->solve[0]        = DSSolve_NHEP;
+#if defined(PETSC_HAVE_MAGMA)
+  ds->ops->solve[1]        = DSSolve_NHEP_MAGMA;
+#endif
   ds->ops->sort            = DSSort_NHEP;
   ds->ops->sortperm        = DSSortWithPermutation_NHEP;
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -190,54 +190,32 @@ static PetscErrorCode DSVectors_NHEPTS(DS ds,DSMatType mat,PetscInt *j,PetscReal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The left problem has the conjugate eigenvalues of the right one, so instead of
+   sorting it independently with the comparison function, its Schur form is reordered
+   directly to match the eigenvalues of the right problem once they have been sorted
+*/
 static PetscErrorCode DSSort_NHEPTS(DS ds,PetscScalar *wr,PetscScalar *wi,PetscScalar *rr,PetscScalar *ri,PetscInt *k)
 {
   DS_NHEPTS      *ctx = (DS_NHEPTS*)ds->data;
-  PetscInt       i,j,cont,id=0,*p,*idx,*idx2;
+  PetscInt       i,j,id=0,*p=ds->perm;
   PetscReal      s,t;
-#if defined(PETSC_USE_COMPLEX)
-  Mat            A,U;
-#endif
+  PetscBLASInt   *used;
 
   PetscFunctionBegin;
   PetscCheck(!rr || wr==rr,PetscObjectComm((PetscObject)ds),PETSC_ERR_SUP,"Not implemented yet");
-  PetscCall(PetscMalloc3(ds->ld,&idx,ds->ld,&idx2,ds->ld,&p));
   PetscCall(DSSort_NHEP_Total(ds,DS_MAT_A,DS_MAT_Q,wr,wi));
-#if defined(PETSC_USE_COMPLEX)
-  PetscCall(DSGetMat(ds,DS_MAT_B,&A));
-  PetscCall(MatConjugate(A));
-  PetscCall(DSRestoreMat(ds,DS_MAT_B,&A));
-  PetscCall(DSGetMat(ds,DS_MAT_Z,&U));
-  PetscCall(MatConjugate(U));
-  PetscCall(DSRestoreMat(ds,DS_MAT_Z,&U));
-  for (i=0;i<ds->n;i++) ctx->wr[i] = PetscConj(ctx->wr[i]);
-#endif
-  PetscCall(DSSort_NHEP_Total(ds,DS_MAT_B,DS_MAT_Z,ctx->wr,ctx->wi));
-  /* check correct eigenvalue correspondence */
-  cont = 0;
-  for (i=0;i<ds->n;i++) {
-    if (SlepcAbsEigenvalue(ctx->wr[i]-wr[i],ctx->wi[i]-wi[i])>PETSC_SQRT_MACHINE_EPSILON) {idx2[cont] = i; idx[cont++] = i;}
-    p[i] = -1;
+  /* match each eigenvalue of the right problem with the closest one of the left problem */
+  PetscCall(DSAllocateWork_Private(ds,0,0,ds->ld));
+  used = ds->iwork;
+  for (j=ds->l;j<ds->n;j++) used[j] = 0;
+  for (i=ds->l;i<ds->n;i++) {
+    t = PETSC_MAX_REAL;
+    for (j=ds->l;j<ds->n;j++) if (!used[j] && (s=SlepcAbsEigenvalue(PetscConj(ctx->wr[j])-wr[i],ctx->wi[j]-wi[i]))<t) { id = j; t = s; }
+    p[i] = id;
+    used[id] = 1;
   }
-  if (cont) {
-    for (i=0;i<cont;i++) {
-      t = PETSC_MAX_REAL;
-      for (j=0;j<cont;j++) if (idx2[j]!=-1 && (s=SlepcAbsEigenvalue(ctx->wr[idx[j]]-wr[idx[i]],ctx->wi[idx[j]]-wi[idx[i]]))<t) { id = j; t = s; }
-      p[idx[i]] = idx[id];
-      idx2[id] = -1;
-    }
-    for (i=0;i<ds->n;i++) if (p[i]==-1) p[i] = i;
-    PetscCall(DSSortWithPermutation_NHEP_Private(ds,p,DS_MAT_B,DS_MAT_Z,ctx->wr,ctx->wi));
-  }
-#if defined(PETSC_USE_COMPLEX)
-  PetscCall(DSGetMat(ds,DS_MAT_B,&A));
-  PetscCall(MatConjugate(A));
-  PetscCall(DSRestoreMat(ds,DS_MAT_B,&A));
-  PetscCall(DSGetMat(ds,DS_MAT_Z,&U));
-  PetscCall(MatConjugate(U));
-  PetscCall(DSRestoreMat(ds,DS_MAT_Z,&U));
-#endif
-  PetscCall(PetscFree3(idx,idx2,p));
+  PetscCall(DSSortWithPermutation_NHEP_Private(ds,p,DS_MAT_B,DS_MAT_Z,ctx->wr,ctx->wi));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -10,6 +10,10 @@
 
 #include <slepc/private/dsimpl.h>       /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
+#include <slepcmagma.h>
+#if defined(SLEPC_HAVE_SCALAPACK)
+#include <slepc/private/slepcscalapack.h>
+#endif
 
 typedef struct {
   PetscInt m;              /* number of columns */
@@ -90,7 +94,9 @@ static PetscErrorCode DSView_SVD(DS ds,PetscViewer viewer)
   PetscReal         *T,value;
   const char        *methodname[] = {
                      "Implicit zero-shift QR for bidiagonals (_bdsqr)",
-                     "Divide and Conquer (_bdsdc or _gesdd)"
+                     "Divide and Conquer (_bdsdc or _gesdd)",
+                     "Divide and Conquer with MAGMA (_bdsdc, or MAGMA _gesdd in the GPU)",
+                     "Parallel QR with ScaLAPACK (_bdsdc, or p_gesvd)"
   };
   const int         nmeth=PETSC_STATIC_ARRAY_LENGTH(methodname);
 
@@ -550,6 +556,186 @@ static PetscErrorCode DSSolve_SVD_DC(DS ds,PetscScalar *wr,PetscScalar *wi)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MAGMA)
+/*
+   General rectangular problems are solved with the hybrid CPU/GPU _gesdd of
+   MAGMA, while those already in bidiagonal form go to _bdsdc
+*/
+static PetscErrorCode DSSolve_SVD_MAGMA(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  DS_SVD         *ctx = (DS_SVD*)ds->data;
+  PetscInt       i,j;
+  PetscBLASInt   n1,m1,l = 0,n = 0,m = 0,nm,ld,off,lwork;
+  PetscScalar    *A,*U,*V,*W,qwork;
+  PetscReal      *d,*e;
+
+  PetscFunctionBegin;
+  if (ds->state>DS_STATE_RAW) {
+    PetscCall(DSSolve_SVD_DC(ds,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(ctx->m,PetscObjectComm((PetscObject)ds),PETSC_ERR_ORDER,"You should set the number of columns with DSSVDSetDimensions()");
+  PetscCall(SlepcMagmaInit());
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ctx->m,&m));
+  PetscCall(PetscBLASIntCast(ds->l,&l));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  n1 = n-l;
+  m1 = m-l;
+  off = l+l*ld;
+  if (ds->compact) PetscCall(DSAllocateMat_Private(ds,DS_MAT_A));
+  PetscCall(DSAllocateMat_Private(ds,DS_MAT_W));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_W],&W));
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+  e = d+ld;
+  PetscCall(PetscArrayzero(U,ld*ld));
+  for (i=0;i<l;i++) U[i+i*ld] = 1.0;
+  PetscCall(PetscArrayzero(V,ld*ld));
+  for (i=0;i<l;i++) V[i+i*ld] = 1.0;
+  if (ds->compact) PetscCall(DSSwitchFormat_SVD(ds));
+  for (i=0;i<l;i++) wr[i] = d[i];
+
+  /* solve general rectangular SVD problem, with a workspace query first */
+  nm = PetscMin(n,m);
+  PetscCall(DSAllocateWork_Private(ds,0,0,8*nm));
+  lwork = -1;
+#if defined(PETSC_USE_COMPLEX)
+  PetscCall(DSAllocateWork_Private(ds,0,5*nm*nm+7*nm,0));
+  PetscCallMAGMA(magma_xgesdd,MagmaAllVec,n1,m1,A+off,ld,d+l,U+off,ld,W+off,ld,&qwork,lwork,ds->rwork,ds->iwork);
+#else
+  PetscCallMAGMA(magma_xgesdd,MagmaAllVec,n1,m1,A+off,ld,d+l,U+off,ld,W+off,ld,&qwork,lwork,ds->iwork);
+#endif
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(qwork),&lwork));
+  PetscCall(DSAllocateWork_Private(ds,lwork,0,0));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCallMAGMA(magma_xgesdd,MagmaAllVec,n1,m1,A+off,ld,d+l,U+off,ld,W+off,ld,ds->work,lwork,ds->rwork,ds->iwork);
+#else
+  PetscCallMAGMA(magma_xgesdd,MagmaAllVec,n1,m1,A+off,ld,d+l,U+off,ld,W+off,ld,ds->work,lwork,ds->iwork);
+#endif
+  for (i=l;i<m;i++) {
+    for (j=l;j<m;j++) V[i+j*ld] = PetscConj(W[j+i*ld]);  /* transpose VT returned by MAGMA */
+  }
+  for (i=l;i<PetscMin(ds->n,ctx->m);i++) wr[i] = d[i];
+
+  /* create diagonal matrix as a result */
+  if (ds->compact) PetscCall(PetscArrayzero(e,n-1));
+  else {
+    for (i=l;i<m;i++) PetscCall(PetscArrayzero(A+l+i*ld,n-l));
+    for (i=l;i<n;i++) A[i+i*ld] = d[i];
+  }
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_W],&W));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+#if defined(SLEPC_HAVE_SCALAPACK)
+/*
+   General rectangular problems are solved with ScaLAPACK in the communicator of the DS,
+   with the matrix distributed block-cyclically, while those in bidiagonal form go to _bdsdc.
+   Only the leading min(n,m) singular vectors are computed.
+*/
+static PetscErrorCode DSSolve_SVD_ScaLAPACK(DS ds,PetscScalar *wr,PetscScalar *wi)
+{
+  DS_SVD         *ctx = (DS_SVD*)ds->data;
+  Mat            S,Z,QT;
+  Mat_ScaLAPACK  *s,*z,*q;
+  PetscInt       i,j;
+  PetscBLASInt   n1,m1,l = 0,n = 0,m = 0,nm,ld,off,lwork=-1,info,one=1;
+  PetscScalar    *A,*U,*V,*W,minlwork;
+  PetscReal      *d,*e;
+#if defined(PETSC_USE_COMPLEX)
+  PetscBLASInt   lrwork;
+  PetscReal      dummy;
+#endif
+
+  PetscFunctionBegin;
+  if (ds->state>DS_STATE_RAW) {
+    PetscCall(DSSolve_SVD_DC(ds,wr,wi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(ctx->m,PetscObjectComm((PetscObject)ds),PETSC_ERR_ORDER,"You should set the number of columns with DSSVDSetDimensions()");
+  PetscCall(PetscBLASIntCast(ds->n,&n));
+  PetscCall(PetscBLASIntCast(ctx->m,&m));
+  PetscCall(PetscBLASIntCast(ds->l,&l));
+  PetscCall(PetscBLASIntCast(ds->ld,&ld));
+  n1 = n-l;
+  m1 = m-l;
+  nm = PetscMin(n1,m1);
+  off = l+l*ld;
+  if (ds->compact) PetscCall(DSAllocateMat_Private(ds,DS_MAT_A));
+  PetscCall(DSAllocateMat_Private(ds,DS_MAT_W));
+  PetscCall(MatDenseGetArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[DS_MAT_W],&W));
+  PetscCall(DSGetArrayReal(ds,DS_MAT_T,&d));
+  e = d+ld;
+  PetscCall(PetscArrayzero(U,ld*ld));
+  for (i=0;i<l;i++) U[i+i*ld] = 1.0;
+  PetscCall(PetscArrayzero(V,ld*ld));
+  for (i=0;i<l;i++) V[i+i*ld] = 1.0;
+  PetscCall(PetscArrayzero(W,ld*ld));
+  if (ds->compact) PetscCall(DSSwitchFormat_SVD(ds));
+  for (i=0;i<l;i++) wr[i] = d[i];
+
+  /* distribute the trailing part of A */
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n1,m1,A+off,ld,&S));
+  PetscCall(DSCopyToScaLAPACK_Private(ds,n1,nm,NULL,0,&Z));
+  PetscCall(DSCopyToScaLAPACK_Private(ds,nm,m1,NULL,0,&QT));
+  s = (Mat_ScaLAPACK*)S->data;
+  z = (Mat_ScaLAPACK*)Z->data;
+  q = (Mat_ScaLAPACK*)QT->data;
+
+  /* solve general rectangular SVD problem, with a workspace query first */
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("SCALAPACKgesvd",SCALAPACKgesvd_("V","V",&n1,&m1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,q->loc,&one,&one,q->desc,&minlwork,&lwork,&info));
+  PetscCheckScaLapackInfo("gesvd",info);
+  PetscCall(PetscBLASIntCast((PetscInt)minlwork,&lwork));
+  PetscCall(DSAllocateWork_Private(ds,lwork,0,0));
+  PetscCallBLAS("SCALAPACKgesvd",SCALAPACKgesvd_("V","V",&n1,&m1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,q->loc,&one,&one,q->desc,ds->work,&lwork,&info));
+#else
+  PetscCallBLAS("SCALAPACKgesvd",SCALAPACKgesvd_("V","V",&n1,&m1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,q->loc,&one,&one,q->desc,&minlwork,&lwork,&dummy,&info));
+  PetscCheckScaLapackInfo("gesvd",info);
+  PetscCall(PetscBLASIntCast((PetscInt)PetscRealPart(minlwork),&lwork));
+  lrwork = 1+4*PetscMax(n1,m1);
+  PetscCall(DSAllocateWork_Private(ds,lwork,lrwork,0));
+  PetscCallBLAS("SCALAPACKgesvd",SCALAPACKgesvd_("V","V",&n1,&m1,s->loc,&one,&one,s->desc,d+l,z->loc,&one,&one,z->desc,q->loc,&one,&one,q->desc,ds->work,&lwork,ds->rwork,&info));
+#endif
+  PetscCheckScaLapackInfo("gesvd",info);
+
+  /* gather the singular vectors */
+  PetscCall(DSCopyFromScaLAPACK_Private(ds,Z,U+off,ld));
+  PetscCall(DSCopyFromScaLAPACK_Private(ds,QT,W+off,ld));
+  PetscCall(MatDestroy(&S));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(MatDestroy(&QT));
+  for (i=l;i<m;i++) {
+    for (j=l;j<m;j++) V[i+j*ld] = PetscConj(W[j+i*ld]);  /* transpose VT returned by ScaLAPACK */
+  }
+  for (i=l;i<PetscMin(ds->n,ctx->m);i++) wr[i] = d[i];
+
+  /* create diagonal matrix as a result */
+  if (ds->compact) PetscCall(PetscArrayzero(e,n-1));
+  else {
+    for (i=l;i<m;i++) PetscCall(PetscArrayzero(A+l+i*ld,n-l));
+    for (i=l;i<PetscMin(n,m);i++) A[i+i*ld] = d[i];
+  }
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_W],&W));
+  PetscCall(MatDenseRestoreArray(ds->omat[DS_MAT_A],&A));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_U],&U));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[DS_MAT_V],&V));
+  PetscCall(DSRestoreArrayReal(ds,DS_MAT_T,&d));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 #if !defined(PETSC_HAVE_MPIUNI)
 static PetscErrorCode DSSynchronize_SVD(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
@@ -752,7 +938,9 @@ static PetscErrorCode DSSetCompact_SVD(DS ds,PetscBool comp)
 
    Implemented methods:
 +  0 - Implicit zero-shift QR for bidiagonals (_bdsqr)
--  1 - Divide and Conquer (_bdsdc or _gesdd)
+.  1 - Divide and Conquer (_bdsdc or _gesdd)
+.  2 - Divide and Conquer with MAGMA (_bdsdc, or MAGMA _gesdd in the GPU)
+-  3 - Parallel QR with ScaLAPACK (_bdsdc, or p_gesvd distributed in the DS communicator)
 
 .seealso: DSCreate(), DSSetType(), DSType, DSSVDSetDimensions()
 M*/
@@ -769,6 +957,12 @@ SLEPC_EXTERN PetscErrorCode DSCreate_SVD(DS ds)
   ds->ops->vectors       = DSVectors_SVD;
   ds->ops->solve[0]      = DSSolve_SVD_QR;
   ds->ops->solve[1]      = DSSolve_SVD_DC;
+#if defined(PETSC_HAVE_MAGMA)
+  ds->ops->solve[2]      = DSSolve_SVD_MAGMA;
+#endif
+#if defined(SLEPC_HAVE_SCALAPACK)
+  ds->ops->solve[3]      = DSSolve_SVD_ScaLAPACK;
+#endif
   ds->ops->sort          = DSSort_SVD;
   ds->ops->truncate      = DSTruncate_SVD;
   ds->ops->update        = DSUpdateExtraRow_SVD;
@@ -400,6 +400,11 @@ PetscErrorCode DSGetMethod(DS ds,PetscInt *meth)
    as the contour integral method of DSNEP. In this case, every MPI process
    will be in charge of part of the computation.
 
+   Independently of the parallel mode, the methods based on ScaLAPACK that are
+   available in DSHEP, DSGHEP and DSSVD (see DSSetMethod()) distribute the
+   matrix block-cyclically and solve the problem with all processes of the
+   DS communicator, so DSSolve() must be called by all of them.
+
    Level: advanced
 
 .seealso: DSSynchronize(), DSGetParallel()
@@ -508,11 +513,17 @@ PetscErrorCode DSGetCompact(DS ds,PetscBool *comp)
    transformations applied to the right of the matrix also affect this additional
    row. In that case, (n+1) must be less or equal than the leading dimension.
 
+   In DSNHEP and non-compact DSHEP, if the block size is larger than one the
+   extra row is replaced by a block of bs extra rows, as needed in block Krylov
+   methods, and (n+bs) must be less or equal than the leading dimension. In that
+   case, the residual norm returned by DSVectors() is the norm of the product of
+   the extra rows by the eigenvector.
+
    The default is PETSC_FALSE.
 
    Level: advanced
 
-.seealso: DSSolve(), DSAllocate(), DSGetExtraRow()
+.seealso: DSSolve(), DSAllocate(), DSGetExtraRow(), DSSetBlockSize()
 @*/
 PetscErrorCode DSSetExtraRow(DS ds,PetscBool ext)
 {
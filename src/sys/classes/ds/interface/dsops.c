@@ -12,6 +12,9 @@
 */
 
 #include <slepc/private/dsimpl.h>      /*I "slepcds.h" I*/
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#include <omp.h>
+#endif
 
 /*@
    DSGetLeadingDimension - Returns the leading dimension of the allocated
@@ -718,7 +721,7 @@ PetscErrorCode DSRestoreArrayReal(DS ds,DSMatType m,PetscReal *a[])
 
    Level: intermediate
 
-.seealso: DSSort(), DSStateType
+.seealso: DSSort(), DSStateType, DSSolveBatch()
 @*/
 PetscErrorCode DSSolve(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 {
@@ -741,6 +744,86 @@ PetscErrorCode DSSolve(DS ds,PetscScalar eigr[],PetscScalar eigi[])
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   DSSolveBatch - Solves a batch of independent problems.
+
+   Not Collective
+
+   Input Parameters:
++  nds  - number of problems
+-  ds   - array of nds direct solver contexts
+
+   Output Parameters:
++  eigr - array of nds arrays to store the computed eigenvalues (real part)
+-  eigi - (optional) array of nds arrays to store the computed eigenvalues (imaginary part)
+
+   Notes:
+   The result is the same as calling DSSolve(ds[i],eigr[i],eigi[i]) for each
+   i. The DS objects must be different, but can be of different types and sizes.
+
+   This is intended for applications that have many small projected problems,
+   where the overhead of solving them one by one is significant. If PETSc has
+   been configured with OpenMP and thread safety, the problems are solved
+   concurrently by the OpenMP threads, provided that all DS objects live in a
+   communicator of one process. Otherwise the problems are solved one after the
+   other. In the threaded case, the method selected in each DS must be thread
+   safe, which excludes methods that rely on MAGMA or ScaLAPACK.
+
+   Level: advanced
+
+.seealso: DSSolve(), DSSort()
+@*/
+PetscErrorCode DSSolveBatch(PetscInt nds,DS ds[],PetscScalar *eigr[],PetscScalar *eigi[])
+{
+  PetscInt       i;
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  PetscMPIInt    size;
+  PetscBool      threaded = PETSC_TRUE;
+  PetscErrorCode *ierr;
+#endif
+
+  PetscFunctionBegin;
+  PetscCheck(nds>=0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of problems %" PetscInt_FMT " cannot be negative",nds);
+  if (!nds) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(ds,2);
+  PetscAssertPointer(eigr,3);
+  for (i=0;i<nds;i++) {
+    PetscValidHeaderSpecific(ds[i],DS_CLASSID,2);
+    PetscValidType(ds[i],2);
+    DSCheckAlloc(ds[i],2);
+    PetscAssertPointer(eigr[i],3);
+    PetscCheck(ds[i]->ops->solve[ds[i]->method],PetscObjectComm((PetscObject)ds[i]),PETSC_ERR_ARG_OUTOFRANGE,"The specified method number does not exist for this DS");
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+    PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)ds[i]),&size));
+    if (size>1) threaded = PETSC_FALSE;
+#endif
+  }
+
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  if (threaded && nds>1 && !omp_in_parallel()) {
+    PetscCall(PetscMalloc1(nds,&ierr));
+    PetscCall(PetscLogEventBegin(DS_Solve,0,0,0,0));
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    #pragma omp parallel for schedule(dynamic)
+    for (i=0;i<nds;i++) {
+      if (ds[i]->state>=DS_STATE_CONDENSED) ierr[i] = PETSC_SUCCESS;
+      else ierr[i] = (*ds[i]->ops->solve[ds[i]->method])(ds[i],eigr[i],eigi?eigi[i]:NULL);
+    }
+    PetscCall(PetscFPTrapPop());
+    PetscCall(PetscLogEventEnd(DS_Solve,0,0,0,0));
+    for (i=0;i<nds;i++) {
+      PetscCall(ierr[i]);
+      ds[i]->state = DS_STATE_CONDENSED;
+      PetscCall(PetscObjectStateIncrease((PetscObject)ds[i]));
+    }
+    PetscCall(PetscFree(ierr));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  for (i=0;i<nds;i++) PetscCall(DSSolve(ds[i],eigr[i],eigi?eigi[i]:NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    DSSort - Sorts the result of DSSolve() according to a given sorting
    criterion.
@@ -926,7 +1009,7 @@ PetscErrorCode DSSynchronize(DS ds,PetscScalar eigr[],PetscScalar eigi[])
 
    Level: intermediate
 
-.seealso: DSSolve()
+.seealso: DSSolve(), DSVectorsRange()
 @*/
 PetscErrorCode DSVectors(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
 {
@@ -948,6 +1031,60 @@ PetscErrorCode DSVectors(DS ds,DSMatType mat,PetscInt *j,PetscReal *rnorm)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   DSVectorsRange - Compute a range of vectors associated to the dense system,
+   such as eigenvectors.
+
+   Logically Collective
+
+   Input Parameters:
++  ds     - the direct solver context
+.  mat    - the matrix, used to indicate which vectors are required
+.  jstart - index of the first vector to be computed
+-  jend   - one past the index of the last vector to be computed
+
+   Notes:
+   This is equivalent to calling DSVectors() for each index j in the range
+   [jstart,jend), but in some DS types (such as DSNHEP) all the vectors are
+   computed at once with the subset version of LAPACK's _trevc, with a cost
+   that is proportional to the number of requested vectors. The rest of
+   columns of mat are not modified.
+
+   This is useful when only a few vectors are needed, for instance the
+   eigenvectors associated to the converged eigenvalues. In real non-symmetric
+   problems, the range is enlarged if one of its ends splits a complex conjugate
+   pair.
+
+   Level: intermediate
+
+.seealso: DSVectors(), DSSolve()
+@*/
+PetscErrorCode DSVectorsRange(DS ds,DSMatType mat,PetscInt jstart,PetscInt jend)
+{
+  PetscInt j;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds,DS_CLASSID,1);
+  PetscValidType(ds,1);
+  DSCheckAlloc(ds,1);
+  PetscValidLogicalCollectiveEnum(ds,mat,2);
+  PetscValidLogicalCollectiveInt(ds,jstart,3);
+  PetscValidLogicalCollectiveInt(ds,jend,4);
+  PetscCheck(mat<DS_NUM_MAT,PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_WRONG,"Invalid matrix");
+  PetscCheck(jstart>=0 && jstart<=jend && jend<=ds->n,PetscObjectComm((PetscObject)ds),PETSC_ERR_ARG_OUTOFRANGE,"Invalid range [%" PetscInt_FMT ",%" PetscInt_FMT "), it must be within [0,%" PetscInt_FMT ")",jstart,jend,ds->n);
+  if (!ds->omat[mat]) PetscCall(DSAllocateMat_Private(ds,mat));
+  if (jstart==jend) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscInfo(ds,"Computing vectors %" PetscInt_FMT " to %" PetscInt_FMT " on %s\n",jstart,jend-1,DSMatName[mat]));
+  PetscCall(PetscLogEventBegin(DS_Vectors,ds,0,0,0));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  if (ds->ops->vectorsrange) PetscUseTypeMethod(ds,vectorsrange,mat,jstart,jend);
+  else for (j=jstart;j<jend;j++) PetscUseTypeMethod(ds,vectors,mat,&j,NULL);
+  PetscCall(PetscFPTrapPop());
+  PetscCall(PetscLogEventEnd(DS_Vectors,ds,0,0,0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)ds));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    DSUpdateExtraRow - Performs all necessary operations so that the extra
    row gets up-to-date after a call to DSSolve().
@@ -1035,7 +1172,10 @@ PetscErrorCode DSCond(DS ds,PetscReal *cond)
    It computes a translation of a Krylov decomposition in order to extract
    eigenpair approximations by harmonic Rayleigh-Ritz.
    The matrix is updated as A + g*b' where g = (A-tau*eye(n))'\b and
-   vector b is assumed to be beta*e_n^T.
+   vector b is assumed to be beta*e_n^T. In DSNHEP, the linear system is
+   solved with an elimination that only touches the nonzero entries below the
+   diagonal, so the cost is O(n^2) when A is upper Hessenberg, possibly with
+   the arrow row of a restarted Krylov-Schur decomposition.
 
    The gamma factor is defined as sqrt(1+g'*g) and can be interpreted as
    the factor by which the residual of the Krylov decomposition is scaled.
@@ -13,6 +13,9 @@
 
 #include <slepc/private/dsimpl.h>      /*I "slepcds.h" I*/
 #include <slepcblaslapack.h>
+#if defined(SLEPC_HAVE_SCALAPACK)
+#include <slepc/private/slepcscalapack.h>
+#endif
 
 PetscErrorCode DSAllocateMat_Private(DS ds,DSMatType m)
 {
@@ -66,17 +69,23 @@ PetscErrorCode DSAllocateMat_Private(DS ds,DSMatType m)
 PetscErrorCode DSAllocateWork_Private(DS ds,PetscInt s,PetscInt r,PetscInt i)
 {
   PetscFunctionBegin;
+  /* grow by at least 50%, so that a dimension that increases in every call
+     (e.g., in Davidson solvers) triggers only a few reallocations */
   if (s>ds->lwork) {
+    s = PetscMax(s,ds->lwork+ds->lwork/2);
+    PetscCall(PetscInfo(ds,"Growing workspace to %" PetscInt_FMT " scalars\n",s));
     PetscCall(PetscFree(ds->work));
     PetscCall(PetscMalloc1(s,&ds->work));
     ds->lwork = s;
   }
   if (r>ds->lrwork) {
+    r = PetscMax(r,ds->lrwork+ds->lrwork/2);
     PetscCall(PetscFree(ds->rwork));
     PetscCall(PetscMalloc1(r,&ds->rwork));
     ds->lrwork = r;
   }
   if (i>ds->liwork) {
+    i = PetscMax(i,ds->liwork+ds->liwork/2);
     PetscCall(PetscFree(ds->iwork));
     PetscCall(PetscMalloc1(i,&ds->iwork));
     ds->liwork = i;
@@ -84,6 +93,44 @@ PetscErrorCode DSAllocateWork_Private(DS ds,PetscInt s,PetscInt r,PetscInt i)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   DSViewMatBinary_Private - Writes the whole storage of one of the internal DS
+   matrices to a binary viewer. Since DS is replicated, only the first process
+   writes the data.
+*/
+PetscErrorCode DSViewMatBinary_Private(DS ds,DSMatType m,PetscViewer viewer)
+{
+  PetscInt          rows,cols;
+  const PetscScalar *M;
+
+  PetscFunctionBegin;
+  DSCheckValidMat(ds,m,2);
+  PetscCall(MatGetSize(ds->omat[m],&rows,&cols));
+  PetscCall(MatDenseGetArrayRead(ds->omat[m],&M));
+  PetscCall(PetscViewerBinaryWrite(viewer,M,rows*cols,PETSC_SCALAR));
+  PetscCall(MatDenseRestoreArrayRead(ds->omat[m],&M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   DSLoadMatBinary_Private - Reads the storage of one of the internal DS matrices,
+   as written by DSViewMatBinary_Private(). The DS must have been allocated with
+   the same leading dimension.
+*/
+PetscErrorCode DSLoadMatBinary_Private(DS ds,DSMatType m,PetscViewer viewer)
+{
+  PetscInt       rows,cols;
+  PetscScalar    *M;
+
+  PetscFunctionBegin;
+  DSCheckValidMat(ds,m,2);
+  PetscCall(MatGetSize(ds->omat[m],&rows,&cols));
+  PetscCall(MatDenseGetArrayWrite(ds->omat[m],&M));
+  PetscCall(PetscViewerBinaryRead(viewer,M,rows*cols,NULL,PETSC_SCALAR));
+  PetscCall(MatDenseRestoreArrayWrite(ds->omat[m],&M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    DSViewMat - Prints one of the internal DS matrices.
 
@@ -169,13 +216,61 @@ PetscErrorCode DSViewMat(DS ds,PetscViewer viewer,DSMatType m)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Sorts perm[l..l+start[nu]-1] with precomputed keys, where the u-th of the nu units
+  occupies positions l+start[u]..l+start[u+1]-1 and is sorted as the value (re[u],im[u]);
+  the arrays re and im are overwritten, and done is PETSC_FALSE if keys cannot be used
+ */
+static PetscErrorCode DSSortKeys_Private(DS ds,PetscInt nu,PetscScalar *re,PetscScalar *im,const PetscInt *start,PetscInt *perm,PetscBool *done)
+{
+  PetscInt  i,k,u,*grp,*idx,*perm0;
+  PetscReal *key;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc4(nu,&grp,nu,&key,nu,&idx,start[nu],&perm0));
+  PetscCall(SlepcSCGetKeys_Private(ds->sc,nu,re,im,grp,key,done));
+  if (*done) {
+    for (u=0;u<nu;u++) idx[u] = u;
+    PetscCall(SlepcSortKeys_Private(nu,grp,key,idx));
+    PetscCall(PetscArraycpy(perm0,perm+ds->l,start[nu]));
+    for (k=ds->l,u=0;u<nu;u++) for (i=start[idx[u]];i<start[idx[u]+1];i++) perm[k++] = perm0[i];
+  }
+  PetscCall(PetscFree4(grp,key,idx,perm0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DSSortEigenvalues_Private(DS ds,PetscScalar *wr,PetscScalar *wi,PetscInt *perm,PetscBool isghiep)
 {
-  PetscScalar    re,im,wi0;
-  PetscInt       n,i,j,result,tmp1,tmp2=0,d=1;
+  PetscScalar    re,im,wi0,*ure,*uim;
+  PetscInt       n,i,j,result,tmp1,tmp2=0,d=1,nu=0,*start;
+  PetscBool      pair,done=PETSC_FALSE;
 
   PetscFunctionBegin;
   n = ds->t;   /* sort only first t pairs if truncated */
+  if (n-ds->l<2) PetscFunctionReturn(PETSC_SUCCESS);
+  /* sort with precomputed keys if possible, keeping conjugate pairs together */
+  PetscCall(PetscMalloc3(n-ds->l,&ure,n-ds->l,&uim,n-ds->l+1,&start));
+  for (i=ds->l;i<n;i++) {
+    start[nu] = i-ds->l;
+    ure[nu]   = wr[perm[i]];
+    uim[nu]   = wi? wi[perm[i]]: 0.0;
+#if !defined(PETSC_USE_COMPLEX)
+    pair = (PetscBool)(wi && wi[perm[i]]!=0.0);
+#else
+    pair = (PetscBool)(isghiep && PetscImaginaryPart(wr[perm[i]])!=0.0);
+#endif
+    if (pair) {
+      if (i+1==n) break;
+      i++;
+    }
+    nu++;
+  }
+  if (i==n) {
+    start[nu] = n-ds->l;
+    PetscCall(DSSortKeys_Private(ds,nu,ure,uim,start,perm,&done));
+  }
+  PetscCall(PetscFree3(ure,uim,start));
+  if (done) PetscFunctionReturn(PETSC_SUCCESS);
   /* insertion sort */
   i=ds->l+1;
 #if !defined(PETSC_USE_COMPLEX)
@@ -223,12 +318,25 @@ PetscErrorCode DSSortEigenvalues_Private(DS ds,PetscScalar *wr,PetscScalar *wi,P
 
 PetscErrorCode DSSortEigenvaluesReal_Private(DS ds,PetscReal *eig,PetscInt *perm)
 {
-  PetscScalar    re;
-  PetscInt       i,j,result,tmp,l,n;
+  PetscScalar    re,*ure,*uim;
+  PetscInt       i,j,result,tmp,l,n,*start;
+  PetscBool      done;
 
   PetscFunctionBegin;
   n = ds->t;   /* sort only first t pairs if truncated */
   l = ds->l;
+  if (n-l<2) PetscFunctionReturn(PETSC_SUCCESS);
+  /* sort with precomputed keys if possible */
+  PetscCall(PetscMalloc3(n-l,&ure,n-l,&uim,n-l+1,&start));
+  for (i=0;i<n-l;i++) {
+    ure[i]   = eig[perm[l+i]];
+    uim[i]   = 0.0;
+    start[i] = i;
+  }
+  start[n-l] = n-l;
+  PetscCall(DSSortKeys_Private(ds,n-l,ure,uim,start,perm,&done));
+  PetscCall(PetscFree3(ure,uim,start));
+  if (done) PetscFunctionReturn(PETSC_SUCCESS);
   /* insertion sort */
   for (i=l+1;i<n;i++) {
     re = eig[perm[i]];
@@ -360,6 +468,62 @@ PetscErrorCode DSPermuteBoth_Private(DS ds,PetscInt istart,PetscInt iend,PetscIn
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(SLEPC_HAVE_SCALAPACK)
+/*
+   DSCopyToScaLAPACK_Private - Creates a ScaLAPACK matrix S of size m x n in the
+   communicator of the DS, and fills its local part of the 2D block-cyclic
+   distribution with the entries of A (which is available in all processes).
+   If A is NULL, S is set to zero.
+*/
+PetscErrorCode DSCopyToScaLAPACK_Private(DS ds,PetscInt m,PetscInt n,const PetscScalar *A,PetscInt lda,Mat *S)
+{
+  Mat_ScaLAPACK *s;
+  PetscInt      i,j,gi,gj;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateScaLAPACK(PetscObjectComm((PetscObject)ds),PETSC_DECIDE,PETSC_DECIDE,m,n,0,0,S));
+  s = (Mat_ScaLAPACK*)(*S)->data;
+  for (j=0;j<s->locc;j++) {
+    gj = ((j/s->nb)*s->grid->npcol+s->grid->mycol)*s->nb+j%s->nb;
+    for (i=0;i<s->locr;i++) {
+      gi = ((i/s->mb)*s->grid->nprow+s->grid->myrow)*s->mb+i%s->mb;
+      s->loc[i+j*s->lld] = A? A[gi+gj*lda]: 0.0;
+    }
+  }
+  PetscCall(MatAssemblyBegin(*S,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*S,MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   DSCopyFromScaLAPACK_Private - Copies the ScaLAPACK matrix S onto the array A,
+   so that the result is available in all processes of the DS
+*/
+PetscErrorCode DSCopyFromScaLAPACK_Private(DS ds,Mat S,PetscScalar *A,PetscInt lda)
+{
+  Mat_ScaLAPACK *s = (Mat_ScaLAPACK*)S->data;
+  PetscInt      i,j,gi,gj;
+  PetscScalar   *buf;
+  PetscMPIInt   len;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(s->M*s->N,&buf));
+  for (j=0;j<s->locc;j++) {
+    gj = ((j/s->nb)*s->grid->npcol+s->grid->mycol)*s->nb+j%s->nb;
+    for (i=0;i<s->locr;i++) {
+      gi = ((i/s->mb)*s->grid->nprow+s->grid->myrow)*s->mb+i%s->mb;
+      buf[gi+gj*s->M] = s->loc[i+j*s->lld];
+    }
+  }
+  /* each entry is owned by exactly one process, so the sum is exact */
+  PetscCall(PetscMPIIntCast(s->M*s->N,&len));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,buf,len,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ds)));
+  for (j=0;j<s->N;j++) PetscCall(PetscArraycpy(A+j*lda,buf+j*s->M,s->M));
+  PetscCall(PetscFree(buf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 /*@
    DSSetIdentity - Copy the identity (a diagonal matrix with ones) on the
    active part of a matrix.
@@ -22,7 +22,7 @@ int main(int argc,char **argv)
   PetscReal      re,im,rnorm,aux;
   PetscInt       i,j,n=10,ld,method;
   PetscViewer    viewer;
-  PetscBool      verbose,extrarow;
+  PetscBool      verbose,extrarow,range;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
@@ -30,6 +30,7 @@ int main(int argc,char **argv)
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Solve a Dense System of type NHEP - dimension %" PetscInt_FMT ".\n",n));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-verbose",&verbose));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-extrarow",&extrarow));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-range",&range));
 
   /* Create DS object */
   PetscCall(DSCreate(PETSC_COMM_WORLD,&ds));
@@ -112,7 +113,10 @@ int main(int argc,char **argv)
   j = 2;
   PetscCall(DSVectors(ds,DS_MAT_X,&j,&rnorm));  /* third eigenvector */
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Value of rnorm for 3rd vector = %.3f\n",(double)rnorm));
-  PetscCall(DSVectors(ds,DS_MAT_X,NULL,NULL));  /* all eigenvectors */
+  if (range) {  /* all eigenvectors, in two chunks */
+    PetscCall(DSVectorsRange(ds,DS_MAT_X,0,n/2));
+    PetscCall(DSVectorsRange(ds,DS_MAT_X,n/2,n));
+  } else PetscCall(DSVectors(ds,DS_MAT_X,NULL,NULL));  /* all eigenvectors */
   j = 0;
   rnorm = 0.0;
   PetscCall(DSGetArray(ds,DS_MAT_X,&X));
@@ -150,5 +154,12 @@ int main(int argc,char **argv)
       test:
          suffix: 2
          args: -extrarow
+      test:
+         suffix: 1_range
+         args: -range
+      test:
+         suffix: 1_magma
+         args: -ds_method 1
+         requires: cuda magma
 
 TEST*/
@@ -128,4 +128,19 @@ int main(int argc,char **argv)
          suffix: 2
          args: -extrarow
 
+   test:
+      suffix: 1_magma
+      args: -n 12 -ds_method 4
+      filter: grep -v "solving the problem"
+      output_file: output/test2_1.out
+      requires: cuda magma !single
+
+   test:
+      suffix: 1_scalapack
+      nsize: {{1 2 3}}
+      args: -n 12 -ds_method 5
+      filter: grep -v "solving the problem"
+      output_file: output/test2_1.out
+      requires: scalapack !single
+
 TEST*/
@@ -127,4 +127,10 @@ int main(int argc,char **argv)
       requires: !single
       filter: grep -v reorthogonalizing
 
+   test:
+      args: -ds_method 1 -extrarow -reorthog {{0 1}}
+      suffix: 4
+      requires: !single
+      filter: grep -v reorthogonalizing
+
 TEST*/
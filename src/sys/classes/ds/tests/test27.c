@@ -116,4 +116,9 @@ int main(int argc,char **argv)
       suffix: 1
       requires: !single
 
+   test:
+      suffix: 2
+      args: -ds_method 1
+      requires: !single
+
 TEST*/
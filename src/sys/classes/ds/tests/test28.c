@@ -0,0 +1,115 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test DSSolveBatch() with DSHEP and DSNHEP problems of different sizes.\n\n"
+  "The command line options are:\n"
+  "  -nds <nds>, where <nds> = number of problems.\n"
+  "  -n <n>, where <n> = dimension of the first problem.\n\n";
+
+#include <slepcds.h>
+
+/*
+   Fill a DS with a Toeplitz matrix, symmetric for DSHEP
+*/
+PetscErrorCode FillDS(DS ds,PetscInt n,PetscBool sym)
+{
+  PetscScalar *A;
+  PetscInt    i,j,ld;
+
+  PetscFunctionBeginUser;
+  PetscCall(DSGetLeadingDimension(ds,&ld));
+  PetscCall(DSSetDimensions(ds,n,0,0));
+  PetscCall(DSGetArray(ds,DS_MAT_A,&A));
+  PetscCall(PetscArrayzero(A,ld*ld));
+  for (i=0;i<n;i++) A[i+i*ld]=2.0;
+  for (j=1;j<3;j++) {
+    for (i=0;i<n-j;i++) { A[i+(i+j)*ld]=1.0; A[(i+j)+i*ld]=sym? 1.0: -1.0/j; }
+  }
+  PetscCall(DSRestoreArray(ds,DS_MAT_A,&A));
+  PetscCall(DSSetState(ds,DS_STATE_RAW));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  DS          *ds,dsref;
+  SlepcSC     sc;
+  PetscScalar **wr,**wi,*er,*ei;
+  PetscReal   err;
+  PetscInt    i,j,k,nds=6,n=10,nk;
+  PetscBool   sym;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-nds",&nds,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Solve a batch of %" PetscInt_FMT " dense problems.\n",nds));
+
+  /* Create the DS objects, alternating DSHEP and DSNHEP */
+  PetscCall(PetscMalloc3(nds,&ds,nds,&wr,nds,&wi));
+  for (k=0;k<nds;k++) {
+    nk  = n+k;
+    sym = (k%2)? PETSC_FALSE: PETSC_TRUE;
+    PetscCall(DSCreate(PETSC_COMM_SELF,&ds[k]));
+    PetscCall(DSSetType(ds[k],sym?DSHEP:DSNHEP));
+    PetscCall(DSSetFromOptions(ds[k]));
+    PetscCall(DSAllocate(ds[k],nk));
+    PetscCall(DSGetSlepcSC(ds[k],&sc));
+    sc->comparison    = SlepcCompareLargestMagnitude;
+    sc->comparisonctx = NULL;
+    sc->map           = NULL;
+    sc->mapobj        = NULL;
+    PetscCall(FillDS(ds[k],nk,sym));
+    PetscCall(PetscCalloc2(nk,&wr[k],nk,&wi[k]));
+  }
+
+  /* Solve all problems in a single call */
+  PetscCall(DSSolveBatch(nds,ds,wr,wi));
+
+  /* Compare with the individual solves */
+  for (k=0;k<nds;k++) {
+    nk  = n+k;
+    sym = (k%2)? PETSC_FALSE: PETSC_TRUE;
+    PetscCall(DSSort(ds[k],wr[k],wi[k],NULL,NULL,NULL));
+    PetscCall(DSDuplicate(ds[k],&dsref));
+    PetscCall(DSAllocate(dsref,nk));
+    PetscCall(DSGetSlepcSC(dsref,&sc));
+    sc->comparison    = SlepcCompareLargestMagnitude;
+    sc->comparisonctx = NULL;
+    sc->map           = NULL;
+    sc->mapobj        = NULL;
+    PetscCall(FillDS(dsref,nk,sym));
+    PetscCall(PetscCalloc2(nk,&er,nk,&ei));
+    PetscCall(DSSolve(dsref,er,ei));
+    PetscCall(DSSort(dsref,er,ei,NULL,NULL,NULL));
+    err = 0.0;
+    for (j=0;j<nk;j++) err = PetscMax(err,SlepcAbsEigenvalue(wr[k][j]-er[j],wi[k][j]-ei[j]));
+    if (err<100*PETSC_MACHINE_EPSILON) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"  problem %" PetscInt_FMT " (%s, n=%" PetscInt_FMT "): eigenvalues agree\n",k,sym?"hep":"nhep",nk));
+    else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"  problem %" PetscInt_FMT " (%s, n=%" PetscInt_FMT "): difference in eigenvalues %g\n",k,sym?"hep":"nhep",nk,(double)err));
+    PetscCall(PetscFree2(er,ei));
+    PetscCall(DSDestroy(&dsref));
+  }
+
+  for (k=0;k<nds;k++) {
+    PetscCall(PetscFree2(wr[k],wi[k]));
+    PetscCall(DSDestroy(&ds[k]));
+  }
+  PetscCall(PetscFree3(ds,wr,wi));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      requires: !single
+
+TEST*/
@@ -0,0 +1,191 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Microbenchmark of DSSolve for several DS types.\n\n"
+  "The command line options are:\n"
+  "  -n <n1,n2,...>, list of dimensions of the dense problem.\n"
+  "  -ldextra <e>, the leading dimension is n plus e.\n"
+  "  -ds_types <t1,t2,...>, list of DS types (hep, nhep, ghep, gnhep, svd).\n"
+  "  -its <its>, number of repetitions of each solve.\n"
+  "  -peak_gflops <p> and -peak_bw <b>, machine peak in GFLOP/s and GB/s for the roofline bound.\n"
+  "  -terse, do not print the measured rates.\n\n";
+
+#include <slepcds.h>
+
+#define MAXLIST 16
+
+/*
+   Nominal cost of the solve with the computation of vectors, from the operation
+   counts in Golub and Van Loan, and number of n x n matrices that are accessed
+*/
+static PetscErrorCode DSCost(DSType type,PetscReal *cost,PetscInt *nmat)
+{
+  PetscBool flg;
+
+  PetscFunctionBeginUser;
+  *cost = 0.0; *nmat = 0;
+  PetscCall(PetscStrcmp(type,DSHEP,&flg));
+  if (flg) { *cost = 9.0; *nmat = 2; }
+  PetscCall(PetscStrcmp(type,DSNHEP,&flg));
+  if (flg) { *cost = 25.0; *nmat = 2; }
+  PetscCall(PetscStrcmp(type,DSGHEP,&flg));
+  if (flg) { *cost = 14.0; *nmat = 3; }
+  PetscCall(PetscStrcmp(type,DSGNHEP,&flg));
+  if (flg) { *cost = 66.0; *nmat = 4; }
+  PetscCall(PetscStrcmp(type,DSSVD,&flg));
+  if (flg) { *cost = 21.0; *nmat = 3; }
+  PetscCheck(*nmat,PETSC_COMM_WORLD,PETSC_ERR_SUP,"DS type %s not supported in this benchmark",type);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Fill the matrices of the DS with random entries; Hermitian types get a Hermitian A,
+   and B is made diagonally dominant so that it is positive definite
+*/
+static PetscErrorCode DSFill(DS ds,PetscRandom rand,PetscInt n,PetscInt ld,PetscBool sym,PetscBool gen)
+{
+  PetscScalar *A,*B;
+  PetscInt    i,j;
+
+  PetscFunctionBeginUser;
+  PetscCall(DSGetArray(ds,DS_MAT_A,&A));
+  for (j=0;j<n;j++) {
+    for (i=sym?j:0;i<n;i++) {
+      PetscCall(PetscRandomGetValue(rand,&A[i+j*ld]));
+      if (sym) A[j+i*ld] = PetscConj(A[i+j*ld]);
+    }
+    if (sym) A[j+j*ld] = PetscRealPart(A[j+j*ld]);
+  }
+  PetscCall(DSRestoreArray(ds,DS_MAT_A,&A));
+  if (gen) {
+    PetscCall(DSGetArray(ds,DS_MAT_B,&B));
+    for (j=0;j<n;j++) {
+      for (i=sym?j:0;i<n;i++) {
+        PetscCall(PetscRandomGetValue(rand,&B[i+j*ld]));
+        if (sym) B[j+i*ld] = PetscConj(B[i+j*ld]);
+      }
+      B[j+j*ld] = PetscRealPart(B[j+j*ld])+n;
+    }
+    PetscCall(DSRestoreArray(ds,DS_MAT_B,&B));
+  }
+  PetscCall(DSSetState(ds,DS_STATE_RAW));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  DS             ds;
+  SlepcSC        sc;
+  PetscRandom    rand;
+  PetscScalar    *wr,*wi;
+  PetscInt       nlist[MAXLIST]={100},nn=MAXLIST,i,it,its=10,n,ld,ldextra=0,nmat,ntypes=MAXLIST;
+  char           *types[MAXLIST];
+  PetscReal      cost,peakf=0.0,peakb=0.0;
+  PetscBool      flg,terse,sym,gen,svd;
+  PetscLogDouble t0,t1,tacc,t,flops,bytes,gflops,gbs,bound;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetIntArray(NULL,NULL,"-n",nlist,&nn,&flg));
+  if (!flg) nn = 1;
+  PetscCall(PetscOptionsGetStringArray(NULL,NULL,"-ds_types",types,&ntypes,&flg));
+  if (!flg) {
+    ntypes = 5;
+    PetscCall(PetscStrallocpy(DSHEP,&types[0]));
+    PetscCall(PetscStrallocpy(DSNHEP,&types[1]));
+    PetscCall(PetscStrallocpy(DSGHEP,&types[2]));
+    PetscCall(PetscStrallocpy(DSGNHEP,&types[3]));
+    PetscCall(PetscStrallocpy(DSSVD,&types[4]));
+  }
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-ldextra",&ldextra,NULL));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL));
+  PetscCall(PetscOptionsGetReal(NULL,NULL,"-peak_gflops",&peakf,NULL));
+  PetscCall(PetscOptionsGetReal(NULL,NULL,"-peak_bw",&peakb,NULL));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-terse",&terse));
+
+  PetscCall(PetscRandomCreate(PETSC_COMM_SELF,&rand));
+  PetscCall(PetscRandomSetFromOptions(rand));
+
+  for (PetscInt l=0;l<ntypes;l++) {
+    PetscCall(DSCost(types[l],&cost,&nmat));
+    PetscCall(PetscStrcmp(types[l],DSHEP,&sym));
+    PetscCall(PetscStrcmp(types[l],DSGHEP,&flg));
+    sym = (PetscBool)(sym || flg);
+    gen = flg;
+    PetscCall(PetscStrcmp(types[l],DSGNHEP,&flg));
+    gen = (PetscBool)(gen || flg);
+    PetscCall(PetscStrcmp(types[l],DSSVD,&svd));
+    for (i=0;i<nn;i++) {
+      n  = nlist[i];
+      ld = n+ldextra;
+      PetscCall(DSCreate(PETSC_COMM_WORLD,&ds));
+      PetscCall(DSSetType(ds,types[l]));
+      PetscCall(DSSetFromOptions(ds));
+      PetscCall(DSAllocate(ds,ld));
+      PetscCall(DSSetDimensions(ds,n,0,0));
+      if (svd) PetscCall(DSSVDSetDimensions(ds,n));
+      PetscCall(DSGetSlepcSC(ds,&sc));
+      sc->comparison    = svd? SlepcCompareLargestReal: SlepcCompareLargestMagnitude;
+      sc->comparisonctx = NULL;
+      sc->map           = NULL;
+      sc->mapobj        = NULL;
+      PetscCall(PetscMalloc2(n,&wr,n,&wi));
+
+      /* Solve and compute all vectors; the time of filling the matrices is excluded */
+      tacc = 0.0;
+      for (it=0;it<its;it++) {
+        PetscCall(DSFill(ds,rand,n,ld,sym,gen));
+        PetscCall(PetscTime(&t0));
+        PetscCall(DSSolve(ds,wr,wi));
+        PetscCall(DSVectors(ds,svd?DS_MAT_U:DS_MAT_X,NULL,NULL));
+        if (svd) PetscCall(DSVectors(ds,DS_MAT_V,NULL,NULL));
+        PetscCall(PetscTime(&t1));
+        tacc += t1-t0;
+      }
+
+      PetscCall(PetscPrintf(PETSC_COMM_WORLD,"DS of type %-6s n=%-6" PetscInt_FMT " ld=%-6" PetscInt_FMT,types[l],n,ld));
+      if (terse) PetscCall(PetscPrintf(PETSC_COMM_WORLD," done\n"));
+      else {
+        t      = PetscMax(tacc/its,1e-12);
+        flops  = cost*n*n*n;
+        bytes  = 2.0*nmat*n*n*sizeof(PetscScalar);
+        gflops = 1e-9*flops/t;
+        gbs    = 1e-9*bytes/t;
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD,"  %10.3e s  %9.3f GFLOP/s  %9.3f GB/s",t,gflops,gbs));
+        if (peakf>0.0 && peakb>0.0) {
+          bound = PetscMin(peakf,peakb*flops/bytes);
+          PetscCall(PetscPrintf(PETSC_COMM_WORLD,"  %5.1f%% of roofline",100.0*gflops/bound));
+        }
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n"));
+      }
+      PetscCall(PetscFree2(wr,wi));
+      PetscCall(DSDestroy(&ds));
+    }
+  }
+  for (i=0;i<ntypes;i++) PetscCall(PetscFree(types[i]));
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      args: -n 20,30 -its 2 -terse
+      requires: !single
+      output_file: output/test29_1.out
+      test:
+         suffix: 1
+      test:
+         suffix: 1_ld
+         args: -ldextra 3
+         output_file: output/test29_1_ld.out
+
+TEST*/
@@ -107,4 +107,16 @@ int main(int argc,char **argv)
          suffix: 2
          args: -extrarow
 
+   testset:
+      args: -n 9 -ds_method 3
+      filter: grep -v "solving the problem" | sed -e "s/extrarow//"
+      requires: !complex !single
+      test:
+         suffix: 1_bdc
+         output_file: output/test3_1.out
+      test:
+         suffix: 2_bdc
+         args: -extrarow
+         output_file: output/test3_2.out
+
 TEST*/
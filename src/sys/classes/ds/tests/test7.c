@@ -133,4 +133,19 @@ int main(int argc,char **argv)
       filter: grep -v "solving the problem"
       requires: !single
 
+   test:
+      suffix: 1_magma
+      args: -ds_method 2
+      filter: grep -v "solving the problem"
+      output_file: output/test7_1.out
+      requires: cuda magma !single
+
+   test:
+      suffix: 1_scalapack
+      nsize: {{1 2 3}}
+      args: -ds_method 3
+      filter: grep -v "solving the problem"
+      output_file: output/test7_1.out
+      requires: scalapack !single
+
 TEST*/
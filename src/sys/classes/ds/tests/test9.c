@@ -130,4 +130,17 @@ int main(int argc,char **argv)
       suffix: 1
       requires: !single
 
+   test:
+      suffix: 1_magma
+      args: -ds_method 1
+      output_file: output/test9_1.out
+      requires: cuda magma !single
+
+   test:
+      suffix: 1_scalapack
+      nsize: 2
+      args: -ds_method 2
+      output_file: output/test9_1.out
+      requires: scalapack !single
+
 TEST*/
@@ -23,6 +23,7 @@
 
       PetscEnum, parameter :: FN_PARALLEL_REDUNDANT    =  0
       PetscEnum, parameter :: FN_PARALLEL_SYNCHRONIZED =  1
+      PetscEnum, parameter :: FN_PARALLEL_DISTRIBUTED  =  2
 
 #if defined(_WIN32) && defined(PETSC_USE_SHARED_LIBRARIES)
 !DEC$ ATTRIBUTES DLLEXPORT::SLEPC_NULL_FN
@@ -22,6 +22,8 @@
 typedef struct {
   FN            f1,f2;    /* functions */
   FNCombineType comb;     /* how the functions are combined */
+  PetscScalar   *work;    /* work space for the evaluation on arrays */
+  PetscInt      lwork;    /* length of array work */
 } FN_COMBINE;
 
 static PetscErrorCode FNEvaluateFunction_Combine(FN fn,PetscScalar x,PetscScalar *y)
@@ -89,14 +91,157 @@ static PetscErrorCode FNEvaluateDerivative_Combine(FN fn,PetscScalar x,PetscScal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+
+static PetscErrorCode FNCombineAllocateWork_Private(FN_COMBINE *ctx,PetscInt n)
+{
+  PetscFunctionBegin;
+  if (ctx->lwork<n) {
+    PetscCall(PetscFree(ctx->work));
+    PetscCall(PetscMalloc1(n,&ctx->work));
+    ctx->lwork = n;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The children are evaluated on the whole array, so there is a single dispatch per
+   node of the tree. The array x may be the same as y, so y is written only after
+   the last use of x
+*/
+static PetscErrorCode FNEvaluateFunctionArray_Combine(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
+  PetscInt       i;
+  PetscScalar    *a;
+
+  PetscFunctionBegin;
+  if (ctx->comb==FN_COMBINE_COMPOSE) {
+    PetscCall(FNEvaluateFunctionArray(ctx->f1,n,x,y));
+    PetscCall(FNEvaluateFunctionArray(ctx->f2,n,y,y));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(FNCombineAllocateWork_Private(ctx,n));
+  a = ctx->work;
+  PetscCall(FNEvaluateFunctionArray(ctx->f1,n,x,a));
+  PetscCall(FNEvaluateFunctionArray(ctx->f2,n,x,y));
+  switch (ctx->comb) {
+    case FN_COMBINE_ADD:
+      for (i=0;i<n;i++) y[i] += a[i];
+      break;
+    case FN_COMBINE_MULTIPLY:
+      for (i=0;i<n;i++) y[i] *= a[i];
+      break;
+    case FN_COMBINE_DIVIDE:
+      for (i=0;i<n;i++) PetscCheck(y[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+      for (i=0;i<n;i++) y[i] = a[i]/y[i];
+      break;
+    case FN_COMBINE_COMPOSE:
+      break;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Combine(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *yp)
+{
+  FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
+  PetscInt       i;
+  PetscScalar    *a,*ap,*b;
+
+  PetscFunctionBegin;
+  PetscCall(FNCombineAllocateWork_Private(ctx,3*n));
+  a = ctx->work; ap = ctx->work+n; b = ctx->work+2*n;
+  switch (ctx->comb) {
+    case FN_COMBINE_ADD:
+      PetscCall(FNEvaluateDerivativeArray(ctx->f1,n,x,ap));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f2,n,x,yp));
+      for (i=0;i<n;i++) yp[i] += ap[i];
+      break;
+    case FN_COMBINE_MULTIPLY:
+      PetscCall(FNEvaluateFunctionArray(ctx->f1,n,x,a));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f1,n,x,ap));
+      PetscCall(FNEvaluateFunctionArray(ctx->f2,n,x,b));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f2,n,x,yp));
+      for (i=0;i<n;i++) yp[i] = ap[i]*b[i]+a[i]*yp[i];
+      break;
+    case FN_COMBINE_DIVIDE:
+      PetscCall(FNEvaluateFunctionArray(ctx->f1,n,x,a));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f1,n,x,ap));
+      PetscCall(FNEvaluateFunctionArray(ctx->f2,n,x,b));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f2,n,x,yp));
+      for (i=0;i<n;i++) PetscCheck(b[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+      for (i=0;i<n;i++) yp[i] = (ap[i]*b[i]-a[i]*yp[i])/(b[i]*b[i]);
+      break;
+    case FN_COMBINE_COMPOSE:
+      PetscCall(FNEvaluateFunctionArray(ctx->f1,n,x,a));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f1,n,x,ap));
+      PetscCall(FNEvaluateDerivativeArray(ctx->f2,n,a,yp));
+      for (i=0;i<n;i++) yp[i] *= ap[i];
+      break;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Checks if f is a constant function, that is, a rational function whose numerator
+   and denominator have degree zero (such as the scalar coefficients that appear when
+   building split forms), and in that case returns its value in c
+*/
+static PetscErrorCode FNCombineIsConstant_Private(FN f,PetscBool *isconst,PetscScalar *c)
+{
+  PetscInt np,nq;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)f,FNRATIONAL,isconst));
+  if (*isconst) {
+    PetscCall(FNRationalGetNumerator(f,&np,NULL));
+    PetscCall(FNRationalGetDenominator(f,&nq,NULL));
+    *isconst = (np<=1 && nq<=1)? PETSC_TRUE: PETSC_FALSE;
+  }
+  if (*isconst) PetscCall(FNEvaluateFunction(f,0.0,c));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Constant children are fused with the combination, which is then applied as a
+   shift or scaling of the other child, without work matrices
+*/
 static PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
 {
   FN_COMBINE   *ctx = (FN_COMBINE*)fn->data;
   Mat          W,Z,F;
-  PetscBool    iscuda;
+  PetscBool    iscuda,isc1,isc2;
+  PetscScalar  c1,c2,c;
 
   PetscFunctionBegin;
-  PetscCall(FN_AllocateWorkMat(fn,A,&W));
+  PetscCall(FNCombineIsConstant_Private(ctx->f1,&isc1,&c1));
+  PetscCall(FNCombineIsConstant_Private(ctx->f2,&isc2,&c2));
+  if (ctx->comb==FN_COMBINE_COMPOSE && (isc1 || isc2)) {
+    if (!isc2) PetscCall(FNEvaluateFunction(ctx->f2,c1,&c2));
+    PetscCall(MatZeroEntries(B));
+    PetscCall(MatShift(B,c2));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (isc2 || (isc1 && ctx->comb!=FN_COMBINE_DIVIDE)) {
+    c = isc2? c2: c1;
+    PetscCall(FNEvaluateFunctionMat_Private(isc2?ctx->f1:ctx->f2,A,B,PETSC_FALSE));
+    switch (ctx->comb) {
+      case FN_COMBINE_ADD:
+        PetscCall(MatShift(B,c));
+        break;
+      case FN_COMBINE_MULTIPLY:
+        PetscCall(MatScale(B,c));
+        break;
+      case FN_COMBINE_DIVIDE:
+        PetscCheck(c!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+        PetscCall(MatScale(B,1.0/c));
+        break;
+      case FN_COMBINE_COMPOSE:
+        break;
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&W));
   switch (ctx->comb) {
     case FN_COMBINE_ADD:
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f1,A,W,PETSC_FALSE));
@@ -104,7 +249,7 @@ static PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
       PetscCall(MatAXPY(B,1.0,W,SAME_NONZERO_PATTERN));
       break;
     case FN_COMBINE_MULTIPLY:
-      PetscCall(FN_AllocateWorkMat(fn,A,&Z));
+      PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&Z));
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f1,A,W,PETSC_FALSE));
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f2,A,Z,PETSC_FALSE));
       PetscCall(MatMatMult(W,Z,MAT_REUSE_MATRIX,PETSC_DEFAULT,&B));
@@ -132,11 +277,44 @@ static PetscErrorCode FNEvaluateFunctionMat_Combine(FN fn,Mat A,Mat B)
 static PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
 {
   FN_COMBINE     *ctx = (FN_COMBINE*)fn->data;
-  PetscBool      iscuda;
+  PetscBool      iscuda,isc1,isc2;
+  PetscScalar    c1,c2,c;
   Mat            Z,F;
   Vec            w;
 
   PetscFunctionBegin;
+  PetscCall(FNCombineIsConstant_Private(ctx->f1,&isc1,&c1));
+  PetscCall(FNCombineIsConstant_Private(ctx->f2,&isc2,&c2));
+  if (ctx->comb==FN_COMBINE_COMPOSE && (isc1 || isc2)) {
+    if (!isc2) PetscCall(FNEvaluateFunction(ctx->f2,c1,&c2));
+    PetscCall(VecSet(v,0.0));
+    PetscCall(VecSetValue(v,0,c2,INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(v));
+    PetscCall(VecAssemblyEnd(v));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (isc2 || (isc1 && ctx->comb!=FN_COMBINE_DIVIDE)) {
+    c = isc2? c2: c1;
+    PetscCall(FNEvaluateFunctionMatVec_Private(isc2?ctx->f1:ctx->f2,A,v,PETSC_FALSE));
+    switch (ctx->comb) {
+      case FN_COMBINE_ADD:
+        PetscCall(VecSetValue(v,0,c,ADD_VALUES));
+        PetscCall(VecAssemblyBegin(v));
+        PetscCall(VecAssemblyEnd(v));
+        break;
+      case FN_COMBINE_MULTIPLY:
+        PetscCall(VecScale(v,c));
+        break;
+      case FN_COMBINE_DIVIDE:
+        PetscCheck(c!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+        PetscCall(VecScale(v,1.0/c));
+        break;
+      case FN_COMBINE_COMPOSE:
+        break;
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   switch (ctx->comb) {
     case FN_COMBINE_ADD:
       PetscCall(VecDuplicate(v,&w));
@@ -147,7 +325,7 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
       break;
     case FN_COMBINE_MULTIPLY:
       PetscCall(VecDuplicate(v,&w));
-      PetscCall(FN_AllocateWorkMat(fn,A,&Z));
+      PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&Z));
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f1,A,Z,PETSC_FALSE));
       PetscCall(FNEvaluateFunctionMatVec_Private(ctx->f2,A,w,PETSC_FALSE));
       PetscCall(MatMult(Z,w,v));
@@ -156,7 +334,7 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
       break;
     case FN_COMBINE_DIVIDE:
       PetscCall(VecDuplicate(v,&w));
-      PetscCall(FN_AllocateWorkMat(fn,A,&Z));
+      PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&Z));
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f2,A,Z,PETSC_FALSE));
       PetscCall(FNEvaluateFunctionMatVec_Private(ctx->f1,A,w,PETSC_FALSE));
       PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
@@ -169,7 +347,7 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Combine(FN fn,Mat A,Vec v)
       PetscCall(VecDestroy(&w));
       break;
     case FN_COMBINE_COMPOSE:
-      PetscCall(FN_AllocateWorkMat(fn,A,&Z));
+      PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&Z));
       PetscCall(FNEvaluateFunctionMat_Private(ctx->f1,A,Z,PETSC_FALSE));
       PetscCall(FNEvaluateFunctionMatVec_Private(ctx->f2,Z,v,PETSC_FALSE));
       PetscCall(FN_FreeWorkMat(fn,&Z));
@@ -311,6 +489,7 @@ static PetscErrorCode FNDestroy_Combine(FN fn)
   PetscFunctionBegin;
   PetscCall(FNDestroy(&ctx->f1));
   PetscCall(FNDestroy(&ctx->f2));
+  PetscCall(PetscFree(ctx->work));
   PetscCall(PetscFree(fn->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)fn,"FNCombineSetChildren_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)fn,"FNCombineGetChildren_C",NULL));
@@ -327,6 +506,8 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Combine(FN fn)
 
   fn->ops->evaluatefunction          = FNEvaluateFunction_Combine;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Combine;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Combine;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Combine;
   fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Combine;
   fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Combine;
 #if defined(PETSC_HAVE_CUDA)
@@ -14,6 +14,26 @@
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
 #include <slepcblaslapack.h>
 
+typedef struct {
+  PetscRandom      rand;          /* random generator for the norm estimates of the Higham method */
+  unsigned long    seed;          /* its initial seed, restored at each evaluation */
+  PetscScalar      *work;         /* workspace of the Higham method, holding the scaled powers of A */
+  PetscBLASInt     *ipiv;
+  PetscInt         n;             /* dimension for which work has been allocated */
+  PetscObjectId    id;            /* id and state of the matrix whose powers are stored in work */
+  PetscObjectState state;
+  PetscInt         s,m;           /* scaling and Pade degree selected for that matrix */
+  PetscObjectId    shiftid;       /* id and state of the matrix whose rightmost eigenvalue is shift */
+  PetscObjectState shiftstate;
+  PetscReal        shift;
+#if defined(PETSC_HAVE_COMPLEX)
+  PetscInt         k,mk;          /* degrees of the stored subdiagonal Pade coefficients */
+  PetscBool        product;       /* the coefficients are in product form */
+  PetscBLASInt     nr,np,nremain;
+  PetscComplex     *r,*p,*remain,mult;
+#endif
+} FN_EXP;
+
 static PetscErrorCode FNEvaluateFunction_Exp(FN fn,PetscScalar x,PetscScalar *y)
 {
   PetscFunctionBegin;
@@ -28,6 +48,15 @@ static PetscErrorCode FNEvaluateDerivative_Exp(FN fn,PetscScalar x,PetscScalar *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode FNEvaluateFunctionArray_Exp(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) y[i] = PetscExpScalar(x[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #define MAX_PADE 6
 
 static PetscErrorCode FNEvaluateFunctionMat_Exp_Pade(FN fn,Mat A,Mat B)
@@ -124,6 +153,84 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_Pade(FN fn,Mat A,Mat B)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_SCALAPACK)
+/*
+   Same algorithm as FNEvaluateFunctionMat_Exp_Pade(), written with Mat operations
+   for FN_PARALLEL_DISTRIBUTED, where A and B are MATSCALAPACK matrices
+*/
+static PetscErrorCode FNEvaluateFunctionMat_Exp_Pade_Dist(FN fn,Mat A,Mat B)
+{
+  PetscInt       k,sexp;
+  PetscBool      odd;
+  const PetscInt p=MAX_PADE;
+  PetscReal      c[MAX_PADE+1],s;
+  Mat            As,A2,Q,P,W,F;
+
+  PetscFunctionBegin;
+  PetscCall(MatDuplicate(A,MAT_COPY_VALUES,&As));
+
+  /* Pade' coefficients */
+  c[0] = 1.0;
+  for (k=1;k<=p;k++) c[k] = c[k-1]*(p+1-k)/(k*(2*p+1-k));
+
+  /* Scaling */
+  PetscCall(MatNorm(As,NORM_INFINITY,&s));
+  if (s>0.5) {
+    sexp = PetscMax(0,(int)(PetscLogReal(s)/PetscLogReal(2.0))+2);
+    PetscCall(MatScale(As,PetscPowRealInt(2.0,-sexp)));
+  } else sexp = 0;
+
+  /* Horner evaluation */
+  PetscCall(MatMatMult(As,As,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&A2));
+  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
+  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&P));
+  PetscCall(MatZeroEntries(Q));
+  PetscCall(MatZeroEntries(P));
+  PetscCall(MatShift(Q,c[p]));
+  PetscCall(MatShift(P,c[p-1]));
+  odd = PETSC_TRUE;
+  for (k=p-1;k>0;k--) {
+    if (odd) {
+      PetscCall(MatMatMult(Q,A2,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W));
+      PetscCall(MatDestroy(&Q));
+      Q = W;
+      PetscCall(MatShift(Q,c[k-1]));
+      odd = PETSC_FALSE;
+    } else {
+      PetscCall(MatMatMult(P,A2,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W));
+      PetscCall(MatDestroy(&P));
+      P = W;
+      PetscCall(MatShift(P,c[k-1]));
+      odd = PETSC_TRUE;
+    }
+  }
+  PetscCall(MatMatMult(P,As,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W));
+  PetscCall(MatDestroy(&P));
+  P = W;
+  PetscCall(MatAXPY(Q,-1.0,P,SAME_NONZERO_PATTERN));
+  PetscCall(MatGetFactor(Q,MATSOLVERSCALAPACK,MAT_FACTOR_LU,&F));
+  PetscCall(MatLUFactorSymbolic(F,Q,NULL,NULL,NULL));
+  PetscCall(MatLUFactorNumeric(F,Q,NULL));
+  PetscCall(MatMatSolve(F,P,B));
+  PetscCall(MatScale(B,2.0));
+  PetscCall(MatShift(B,1.0));
+
+  /* Squaring */
+  for (k=1;k<=sexp;k++) {
+    PetscCall(MatMatMult(B,B,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&W));
+    PetscCall(MatCopy(W,B,SAME_NONZERO_PATTERN));
+    PetscCall(MatDestroy(&W));
+  }
+
+  PetscCall(MatDestroy(&F));
+  PetscCall(MatDestroy(&As));
+  PetscCall(MatDestroy(&A2));
+  PetscCall(MatDestroy(&Q));
+  PetscCall(MatDestroy(&P));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 #if defined(PETSC_HAVE_COMPLEX)
 /*
  * Set scaling factor (s) and Pade degree (k,m)
@@ -382,6 +489,42 @@ static PetscErrorCode getcoeffsproduct(PetscInt k,PetscInt m,PetscComplex *p,Pet
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*
+ * Coefficients of the subdiagonal Pade approximant of degree (k,m), in partial
+ * fraction form (r,p,remain) or product form (roots r and p, and mult). They are
+ * kept in the FN context and recomputed only when (k,m) or the form change, which
+ * avoids the setup in repeated calls with matrices of similar norm (e.g. in MFN).
+ */
+static PetscErrorCode FNExpGetPadeCoeffs_Private(FN fn,PetscInt k,PetscInt m,PetscBool product,PetscBLASInt *nr,PetscComplex **r,PetscBLASInt *np,PetscComplex **p,PetscBLASInt *nremain,PetscComplex **remain,PetscComplex *mult)
+{
+  FN_EXP       *ctx = (FN_EXP*)fn->data;
+  PetscComplex rsize,psize,remainsize=0.0;
+
+  PetscFunctionBegin;
+  if (k!=ctx->k || m!=ctx->mk || product!=ctx->product) {
+    PetscCall(PetscFree3(ctx->r,ctx->p,ctx->remain));
+    if (product) PetscCall(getcoeffsproduct(k,m,&rsize,&psize,&ctx->mult,PETSC_TRUE));
+    else PetscCall(getcoeffs(k,m,&rsize,&psize,&remainsize,PETSC_TRUE));
+    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(rsize),&ctx->nr));
+    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(psize),&ctx->np));
+    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(remainsize),&ctx->nremain));
+    PetscCall(PetscMalloc3(ctx->nr,&ctx->r,ctx->np,&ctx->p,ctx->nremain,&ctx->remain));
+    if (product) PetscCall(getcoeffsproduct(k,m,ctx->r,ctx->p,&ctx->mult,PETSC_FALSE));
+    else PetscCall(getcoeffs(k,m,ctx->r,ctx->p,ctx->remain,PETSC_FALSE));
+    ctx->k       = k;
+    ctx->mk      = m;
+    ctx->product = product;
+  }
+  *nr      = ctx->nr;
+  *r       = ctx->r;
+  *np      = ctx->np;
+  *p       = ctx->p;
+  *nremain = ctx->nremain;
+  *remain  = ctx->remain;
+  *mult    = ctx->mult;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 #endif /* PETSC_HAVE_COMPLEX */
 
 #if defined(PETSC_USE_COMPLEX)
@@ -413,16 +556,19 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
   PetscFunctionBegin;
   SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This function requires C99 or C++ complex support");
 #else
+  FN_EXP            *ctx = (FN_EXP*)fn->data;
   PetscInt          i,j,n_,s,k,m,mod;
   PetscBLASInt      n=0,n2=0,irsize=0,rsizediv2,ipsize=0,iremainsize=0,info,*piv,minlen,lwork=0,one=1;
   PetscReal         nrm,shift=0.0;
 #if defined(PETSC_USE_COMPLEX)
   PetscReal         *rwork=NULL;
 #endif
-  PetscComplex      *As,*RR,*RR2,*expmA,*expmA2,*Maux,*Maux2,rsize,*r,psize,*p,remainsize,*remainterm,*rootp,*rootq,mult=0.0,scale,cone=1.0,czero=0.0,*aux;
+  PetscComplex      *As,*RR,*RR2,*expmA,*expmA2,*Maux,*Maux2,*r,*p,*remainterm,*rootp,*rootq,mult=0.0,scale,cone=1.0,czero=0.0,*aux;
   PetscScalar       *Ba,*Ba2,*sMaux,*wr,*wi,expshift,sone=1.0,szero=0.0,*saux;
   const PetscScalar *Aa;
   PetscBool         isreal,flg;
+  PetscObjectId     id;
+  PetscObjectState  state;
   PetscBLASInt      query=-1;
   PetscScalar       work1,*work;
 
@@ -437,6 +583,12 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
   PetscCall(PetscMalloc2(n2,&sMaux,n2,&Maux));
   Maux2 = Maux;
   PetscCall(PetscOptionsGetReal(NULL,NULL,"-fn_expm_estimated_eig",&shift,&flg));
+  PetscCall(PetscObjectGetId((PetscObject)A,&id));
+  PetscCall(PetscObjectStateGet((PetscObject)A,&state));
+  if (!flg && id==ctx->shiftid && state==ctx->shiftstate) {  /* same matrix as in the previous call */
+    shift = ctx->shift;
+    flg   = PETSC_TRUE;
+  }
   if (!flg) {
     PetscCall(PetscMalloc2(n,&wr,n,&wi));
     PetscCall(PetscArraycpy(sMaux,Aa,n2));
@@ -465,6 +617,9 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
       if (PetscRealPart(wr[i]) > shift) shift = PetscRealPart(wr[i]);
     }
     PetscCall(PetscFree2(wr,wi));
+    ctx->shift      = shift;
+    ctx->shiftid    = id;
+    ctx->shiftstate = state;
   }
   /* shift so that largest real part is (about) 0 */
   PetscCall(PetscArraycpy(sMaux,Aa,n2));
@@ -514,12 +669,7 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
 
   /* evaluate Pade approximant (partial fraction or product form) */
   if (fn->method==3 || !m) { /* partial fraction */
-    PetscCall(getcoeffs(k,m,&rsize,&psize,&remainsize,PETSC_TRUE));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(rsize),&irsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(psize),&ipsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(remainsize),&iremainsize));
-    PetscCall(PetscMalloc3(irsize,&r,ipsize,&p,iremainsize,&remainterm));
-    PetscCall(getcoeffs(k,m,r,p,remainterm,PETSC_FALSE));
+    PetscCall(FNExpGetPadeCoeffs_Private(fn,k,m,PETSC_FALSE,&irsize,&r,&ipsize,&p,&iremainsize,&remainterm,&mult));
 
     PetscCall(PetscArrayzero(expmA,n2));
 #if !defined(PETSC_USE_COMPLEX)
@@ -597,13 +747,8 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
       }
       PetscCall(SlepcLogFlopsComplex(1.0*n2));
     }
-    PetscCall(PetscFree3(r,p,remainterm));
   } else { /* product form, default */
-    PetscCall(getcoeffsproduct(k,m,&rsize,&psize,&mult,PETSC_TRUE));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(rsize),&irsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(psize),&ipsize));
-    PetscCall(PetscMalloc2(irsize,&rootp,ipsize,&rootq));
-    PetscCall(getcoeffsproduct(k,m,rootp,rootq,&mult,PETSC_FALSE));
+    PetscCall(FNExpGetPadeCoeffs_Private(fn,k,m,PETSC_TRUE,&irsize,&rootp,&ipsize,&rootq,&iremainsize,&remainterm,&mult));
 
     PetscCall(PetscArrayzero(expmA,n2));
     for (i=0;i<n;i++) { /* initialize */
@@ -646,7 +791,6 @@ static PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa(FN fn,Mat A,M
     }
     PetscCallBLAS("BLASCOMPLEXscal",BLASCOMPLEXscal_(&n2,&mult,expmA,&one));
     PetscCall(SlepcLogFlopsComplex(1.0*n2));
-    PetscCall(PetscFree2(rootp,rootq));
   }
 
 #if !defined(PETSC_USE_COMPLEX)
@@ -708,10 +852,48 @@ static PetscInt ell(PetscBLASInt n,PetscScalar *A,PetscReal coeff,PetscInt m,Pet
   PetscFunctionReturn(t);
 }
 
+/*
+ * Random generator for the norm estimates; in FNEXP it is kept in the context and
+ * reseeded, so that the estimates do not depend on previous evaluations
+ */
+static PetscErrorCode FNExpGetRandom_Private(FN fn,PetscRandom *rand)
+{
+  FN_EXP    *ctx;
+  PetscBool isexp;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)fn,FNEXP,&isexp));
+  if (!isexp) {  /* called from FNPHI */
+    PetscCall(PetscRandomCreate(PETSC_COMM_SELF,rand));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  ctx = (FN_EXP*)fn->data;
+  if (!ctx->rand) {
+    PetscCall(PetscRandomCreate(PETSC_COMM_SELF,&ctx->rand));
+    PetscCall(PetscRandomGetSeed(ctx->rand,&ctx->seed));
+  } else {
+    PetscCall(PetscRandomSetSeed(ctx->rand,ctx->seed));
+    PetscCall(PetscRandomSeed(ctx->rand));
+  }
+  *rand = ctx->rand;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNExpRestoreRandom_Private(FN fn,PetscRandom *rand)
+{
+  PetscBool isexp;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)fn,FNEXP,&isexp));
+  if (!isexp) PetscCall(PetscRandomDestroy(rand));
+  else *rand = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
  * Compute scaling parameter (s) and order of Pade approximant (m)  (required workspace is 4*n*n)
  */
-static PetscErrorCode expm_params(PetscInt n,PetscScalar **Apowers,PetscInt *s,PetscInt *m,PetscScalar *work)
+static PetscErrorCode expm_params(FN fn,PetscInt n,PetscScalar **Apowers,PetscInt *s,PetscInt *m,PetscScalar *work)
 {
   PetscScalar     sfactor,sone=1.0,szero=0.0,*A=Apowers[0],*Ascaled;
   PetscReal       d4,d6,d8,d10,eta1,eta3,eta4,eta5,rwork[1];
@@ -729,7 +911,7 @@ static PetscErrorCode expm_params(PetscInt n,PetscScalar **Apowers,PetscInt *s,P
   *s = 0;
   *m = 13;
   PetscCall(PetscBLASIntCast(n,&n_));
-  PetscCall(PetscRandomCreate(PETSC_COMM_SELF,&rand));
+  PetscCall(FNExpGetRandom_Private(fn,&rand));
   d4 = PetscPowReal(LAPACKlange_("O",&n_,&n_,Apowers[2],&n_,rwork),1.0/4.0);
   if (d4==0.0) { /* safeguard for the case A = 0 */
     *m = 3;
@@ -784,7 +966,7 @@ static PetscErrorCode expm_params(PetscInt n,PetscScalar **Apowers,PetscInt *s,P
   } else Ascaled = A;
   *s += ell(n_,Ascaled,coeff[4],13,work,rand);
 done:
-  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(FNExpRestoreRandom_Private(fn,&rand));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -796,8 +978,12 @@ done:
  */
 PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN fn,Mat A,Mat B)
 {
+  FN_EXP            *ctx=NULL;
   PetscBLASInt      n_=0,n2,*ipiv,info,one=1;
   PetscInt          n,m,j,s;
+  PetscBool         isexp,reuse=PETSC_FALSE;
+  PetscObjectId     id;
+  PetscObjectState  state;
   PetscScalar       scale,smone=-1.0,sone=1.0,stwo=2.0,szero=0.0;
   PetscScalar       *Ba,*Apowers[5],*Q,*P,*W,*work,*aux;
   const PetscScalar *Aa,*c;
@@ -817,7 +1003,21 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN fn,Mat A,Mat B)
   PetscCall(MatGetSize(A,&n,NULL));
   PetscCall(PetscBLASIntCast(n,&n_));
   n2 = n_*n_;
-  PetscCall(PetscMalloc2(8*n*n,&work,n,&ipiv));
+  PetscCall(PetscObjectTypeCompare((PetscObject)fn,FNEXP,&isexp));
+  if (isexp) {  /* keep the workspace, to reuse the powers if called again with the same matrix */
+    ctx = (FN_EXP*)fn->data;
+    PetscCall(PetscObjectGetId((PetscObject)A,&id));
+    PetscCall(PetscObjectStateGet((PetscObject)A,&state));
+    if (ctx->n!=n) {
+      PetscCall(PetscFree2(ctx->work,ctx->ipiv));
+      PetscCall(PetscMalloc2(8*n*n,&ctx->work,n,&ctx->ipiv));
+      ctx->n  = n;
+      ctx->id = 0;
+    }
+    work  = ctx->work;
+    ipiv  = ctx->ipiv;
+    reuse = (id==ctx->id && state==ctx->state)? PETSC_TRUE: PETSC_FALSE;
+  } else PetscCall(PetscMalloc2(8*n*n,&work,n,&ipiv));
 
   /* Matrix powers */
   Apowers[0] = work;                  /* Apowers[0] = A   */
@@ -826,21 +1026,33 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN fn,Mat A,Mat B)
   Apowers[3] = Apowers[2] + n*n;      /* Apowers[3] = A^6 */
   Apowers[4] = Apowers[3] + n*n;      /* Apowers[4] = A^8 */
 
-  PetscCall(PetscArraycpy(Apowers[0],Aa,n2));
-  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[0],&n_,Apowers[0],&n_,&szero,Apowers[1],&n_));
-  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[1],&n_,Apowers[1],&n_,&szero,Apowers[2],&n_));
-  PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[1],&n_,Apowers[2],&n_,&szero,Apowers[3],&n_));
-  PetscCall(PetscLogFlops(6.0*n*n*n));
-
-  /* Compute scaling parameter and order of Pade approximant */
-  PetscCall(expm_params(n,Apowers,&s,&m,Apowers[4]));
-
-  if (s) { /* rescale */
-    for (j=0;j<4;j++) {
-      scale = PetscPowRealInt(2.0,-PetscMax(2*j,1)*s);
-      PetscCallBLAS("BLASscal",BLASscal_(&n2,&scale,Apowers[j],&one));
+  if (reuse) {
+    s = ctx->s;
+    m = ctx->m;
+    PetscCall(PetscInfo(fn,"Reusing the scaled powers of A, s=%" PetscInt_FMT " m=%" PetscInt_FMT "\n",s,m));
+  } else {
+    PetscCall(PetscArraycpy(Apowers[0],Aa,n2));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[0],&n_,Apowers[0],&n_,&szero,Apowers[1],&n_));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[1],&n_,Apowers[1],&n_,&szero,Apowers[2],&n_));
+    PetscCallBLAS("BLASgemm",BLASgemm_("N","N",&n_,&n_,&n_,&sone,Apowers[1],&n_,Apowers[2],&n_,&szero,Apowers[3],&n_));
+    PetscCall(PetscLogFlops(6.0*n*n*n));
+
+    /* Compute scaling parameter and order of Pade approximant */
+    PetscCall(expm_params(fn,n,Apowers,&s,&m,Apowers[4]));
+
+    if (s) { /* rescale */
+      for (j=0;j<4;j++) {
+        scale = PetscPowRealInt(2.0,-PetscMax(2*j,1)*s);
+        PetscCallBLAS("BLASscal",BLASscal_(&n2,&scale,Apowers[j],&one));
+      }
+      PetscCall(PetscLogFlops(4.0*n*n));
+    }
+    if (ctx) {
+      ctx->id    = id;
+      ctx->state = state;
+      ctx->s     = s;
+      ctx->m     = m;
     }
-    PetscCall(PetscLogFlops(4.0*n*n));
   }
 
   /* Evaluate the Pade approximant */
@@ -926,7 +1138,7 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_Higham(FN fn,Mat A,Mat B)
   if (P!=Ba) PetscCall(PetscArraycpy(Ba,P,n2));
   PetscCall(PetscLogFlops(2.0*n*n*n*s));
 
-  PetscCall(PetscFree2(work,ipiv));
+  if (!ctx) PetscCall(PetscFree2(work,ipiv));
   PetscCall(MatDenseRestoreArrayRead(A,&Aa));
   PetscCall(MatDenseRestoreArray(B,&Ba));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1273,7 +1485,7 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_Higham_CUDAm(FN fn,Mat A,Mat B)
   PetscCallCUDA(cudaMemcpy(Apowers[1],d_Apowers[1],3*n2*sizeof(PetscScalar),cudaMemcpyDeviceToHost));
   PetscCall(PetscLogGpuToCpu(4*n2*sizeof(PetscScalar)));
   /* Compute scaling parameter and order of Pade approximant */
-  PetscCall(expm_params(n,Apowers,&s,&m,Apowers[4]));
+  PetscCall(expm_params(fn,n,Apowers,&s,&m,Apowers[4]));
 
   if (s) { /* rescale */
     for (j=0;j<4;j++) {
@@ -1389,16 +1601,19 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_Higham_CUDAm(FN fn,Mat A,Mat B)
  */
 PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Mat B)
 {
+  FN_EXP            *ctx = (FN_EXP*)fn->data;
   PetscInt          i,j,n_,s,k,m,mod;
   PetscBLASInt      n=0,n2=0,irsize=0,rsizediv2,ipsize=0,iremainsize=0,query=-1,*piv,minlen,lwork=0,one=1;
   PetscReal         nrm,shift=0.0,rone=1.0,rzero=0.0;
 #if defined(PETSC_USE_COMPLEX)
   PetscReal         *rwork=NULL;
 #endif
-  PetscComplex      *d_As,*d_RR,*d_RR2,*d_expmA,*d_expmA2,*d_Maux,*d_Maux2,rsize,*r,psize,*p,remainsize,*remainterm,*rootp,*rootq,mult=0.0,scale,cone=1.0,czero=0.0,*aux;
+  PetscComplex      *d_As,*d_RR,*d_RR2,*d_expmA,*d_expmA2,*d_Maux,*d_Maux2,*r,*p,*remainterm,*rootp,*rootq,mult=0.0,scale,cone=1.0,czero=0.0,*aux;
   PetscScalar       *d_Aa,*d_Ba,*d_Ba2,*Maux,*d_sMaux,*wr,*wi,expshift,sone=1.0,szero=0.0,*work,work1,*saux;
   const PetscScalar *Aa;
   PetscBool         isreal,*d_isreal,flg;
+  PetscObjectId     id;
+  PetscObjectState  state;
   cublasHandle_t    cublasv2handle;
 
   PetscFunctionBegin;
@@ -1425,6 +1640,12 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Ma
   PetscCall(PetscLogGpuTimeBegin());
   d_Maux2 = d_Maux;
   PetscCall(PetscOptionsGetReal(NULL,NULL,"-fn_expm_estimated_eig",&shift,&flg));
+  PetscCall(PetscObjectGetId((PetscObject)A,&id));
+  PetscCall(PetscObjectStateGet((PetscObject)A,&state));
+  if (!flg && id==ctx->shiftid && state==ctx->shiftstate) {  /* same matrix as in the previous call */
+    shift = ctx->shift;
+    flg   = PETSC_TRUE;
+  }
   if (!flg) {
     PetscCall(PetscMalloc2(n,&wr,n,&wi));
     /* estimate rightmost eigenvalue and shift A with it */
@@ -1453,6 +1674,9 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Ma
       if (PetscRealPart(wr[i]) > shift) shift = PetscRealPart(wr[i]);
     }
     PetscCall(PetscFree2(wr,wi));
+    ctx->shift      = shift;
+    ctx->shiftid    = id;
+    ctx->shiftstate = state;
   }
   /* shift so that largest real part is (about) 0 */
   PetscCallCUDA(cudaMemcpy(d_sMaux,d_Aa,sizeof(PetscScalar)*n2,cudaMemcpyDeviceToDevice));
@@ -1506,12 +1730,7 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Ma
 
   /* evaluate Pade approximant (partial fraction or product form) */
   if (fn->method==3 || !m) { /* partial fraction */
-    PetscCall(getcoeffs(k,m,&rsize,&psize,&remainsize,PETSC_TRUE));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(rsize),&irsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(psize),&ipsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(remainsize),&iremainsize));
-    PetscCall(PetscMalloc3(irsize,&r,ipsize,&p,iremainsize,&remainterm));
-    PetscCall(getcoeffs(k,m,r,p,remainterm,PETSC_FALSE));
+    PetscCall(FNExpGetPadeCoeffs_Private(fn,k,m,PETSC_FALSE,&irsize,&r,&ipsize,&p,&iremainsize,&remainterm,&mult));
 
     PetscCallCUDA(cudaMemset(d_expmA,0,sizeof(PetscComplex)*n2));
 #if !defined(PETSC_USE_COMPLEX)
@@ -1572,13 +1791,8 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Ma
       PetscCallCUBLAS(cublasXCaxpy(cublasv2handle,n2,&cone,d_RR,one,d_expmA,one));
       PetscCall(SlepcLogGpuFlopsComplex(1.0*n2));
     }
-    PetscCall(PetscFree3(r,p,remainterm));
   } else { /* product form, default */
-    PetscCall(getcoeffsproduct(k,m,&rsize,&psize,&mult,PETSC_TRUE));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(rsize),&irsize));
-    PetscCall(PetscBLASIntCast((PetscInt)PetscRealPartComplex(psize),&ipsize));
-    PetscCall(PetscMalloc2(irsize,&rootp,ipsize,&rootq));
-    PetscCall(getcoeffsproduct(k,m,rootp,rootq,&mult,PETSC_FALSE));
+    PetscCall(FNExpGetPadeCoeffs_Private(fn,k,m,PETSC_TRUE,&irsize,&rootp,&ipsize,&rootq,&iremainsize,&remainterm,&mult));
 
     PetscCallCUDA(cudaMemset(d_expmA,0,sizeof(PetscComplex)*n2));
     PetscCall(set_Cdiagonal(n,d_expmA,n,rone,rzero)); /* initialize */
@@ -1611,7 +1825,6 @@ PetscErrorCode FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm(FN fn,Mat A,Ma
     }
     PetscCallCUBLAS(cublasXCscal(cublasv2handle,n2,&mult,d_expmA,one));
     PetscCall(SlepcLogGpuFlopsComplex(1.0*n2));
-    PetscCall(PetscFree2(rootp,rootq));
   }
 
 #if !defined(PETSC_USE_COMPLEX)
@@ -1690,11 +1903,32 @@ static PetscErrorCode FNView_Exp(FN fn,PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode FNDestroy_Exp(FN fn)
+{
+  FN_EXP *ctx = (FN_EXP*)fn->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscRandomDestroy(&ctx->rand));
+  PetscCall(PetscFree2(ctx->work,ctx->ipiv));
+#if defined(PETSC_HAVE_COMPLEX)
+  PetscCall(PetscFree3(ctx->r,ctx->p,ctx->remain));
+#endif
+  PetscCall(PetscFree(fn->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 SLEPC_EXTERN PetscErrorCode FNCreate_Exp(FN fn)
 {
+  FN_EXP *ctx;
+
   PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  fn->data = (void*)ctx;
+
   fn->ops->evaluatefunction       = FNEvaluateFunction_Exp;
   fn->ops->evaluatederivative     = FNEvaluateDerivative_Exp;
+  fn->ops->evaluatefunctionarray  = FNEvaluateFunctionArray_Exp;
+  fn->ops->evaluatederivativearray = FNEvaluateFunctionArray_Exp;
   fn->ops->evaluatefunctionmat[0] = FNEvaluateFunctionMat_Exp_Higham;
   fn->ops->evaluatefunctionmat[1] = FNEvaluateFunctionMat_Exp_Pade;
   fn->ops->evaluatefunctionmat[2] = FNEvaluateFunctionMat_Exp_GuettelNakatsukasa; /* product form */
@@ -1707,7 +1941,11 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Exp(FN fn)
   fn->ops->evaluatefunctionmatcuda[2] = FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm; /* product form */
   fn->ops->evaluatefunctionmatcuda[3] = FNEvaluateFunctionMat_Exp_GuettelNakatsukasa_CUDAm; /* partial fraction */
 #endif
+#endif
+#if defined(PETSC_HAVE_SCALAPACK)
+  fn->ops->evaluatefunctionmatdist[1] = FNEvaluateFunctionMat_Exp_Pade_Dist;
 #endif
   fn->ops->view                   = FNView_Exp;
+  fn->ops->destroy                = FNDestroy_Exp;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -36,6 +36,32 @@ static PetscErrorCode FNEvaluateDerivative_Invsqrt(FN fn,PetscScalar x,PetscScal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode FNEvaluateFunctionArray_Invsqrt(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) PetscCheck(x[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = 1.0/PetscSqrtScalar(x[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Invsqrt(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) PetscCheck(x[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = -1.0/(2.0*PetscPowScalarReal(x[i],1.5));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FNEvaluateFunctionMat_Invsqrt_Schur(FN fn,Mat A,Mat B)
 {
   PetscBLASInt   n=0,ld,*ipiv,info;
@@ -265,6 +291,8 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Invsqrt(FN fn)
   PetscFunctionBegin;
   fn->ops->evaluatefunction          = FNEvaluateFunction_Invsqrt;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Invsqrt;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Invsqrt;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Invsqrt;
   fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Invsqrt_Schur;
   fn->ops->evaluatefunctionmat[1]    = FNEvaluateFunctionMat_Invsqrt_DBP;
   fn->ops->evaluatefunctionmat[2]    = FNEvaluateFunctionMat_Invsqrt_NS;
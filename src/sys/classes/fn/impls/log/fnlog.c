@@ -35,6 +35,31 @@ static PetscErrorCode FNEvaluateDerivative_Log(FN fn,PetscScalar x,PetscScalar *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode FNEvaluateFunctionArray_Log(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = PetscLogScalar(x[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Log(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) PetscCheck(x[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = 1.0/x[i];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    Block structure of a quasitriangular matrix T. Returns a list of n-1 numbers, where
    structure(j) encodes the block type of the j:j+1,j:j+1 diagonal block as one of:
@@ -640,6 +665,128 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Log_Higham(FN fn,Mat A,Vec v)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_CUDA)
+#if defined(PETSC_HAVE_MAGMA)
+#include "../src/sys/classes/fn/impls/cuda/fnutilcuda.h"
+#include <slepccupmblas.h>
+#include <slepcmagma.h>
+
+/*
+ * Matrix logarithm by inverse scaling and squaring, transformation-free variant
+ * (algorithm 5.1 of Al-Mohy and Higham). CUDA version.
+ * Square roots are taken with the product form of the Denman-Beavers iteration
+ * until ||T^(1/2^s)-I||_F is below the bound of a Pade approximant of degree
+ * at most 7, which is evaluated in partial fraction form with MAGMA solves.
+ * T is overwritten with logm(T).
+ */
+static PetscErrorCode FNLogmISS_CUDAm(FN fn,PetscBLASInt n,PetscScalar *d_T,PetscBLASInt ld)
+{
+  PetscScalar     *d_X,*d_K,*d_W,*nodes,*wts,*Q,alpha,sone=1.0,smone=-1.0;
+  PetscReal       nrm;
+  PetscInt        k,s=0,m;
+  PetscBLASInt    N,mm,one=1,*piv;
+  cublasHandle_t  cublasv2handle;
+  const PetscReal xvals[] = { 1.586970738772063e-005, 2.313807884242979e-003, 1.938179313533253e-002,
+       6.209171588994762e-002, 1.276404810806775e-001, 2.060962623452836e-001, 2.879093714241194e-001 };
+  const PetscInt  mmax=PETSC_STATIC_ARRAY_LENGTH(xvals),maxroots=100;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDeviceInitialize(PETSC_DEVICE_CUDA)); /* For CUDA event timers */
+  PetscCall(PetscCUBLASGetHandle(&cublasv2handle));
+  PetscCall(SlepcMagmaInit());
+  N = n*n;
+  PetscCall(PetscMalloc1(n,&piv));
+  PetscCallCUDA(cudaMalloc((void **)&d_X,sizeof(PetscScalar)*N));
+  PetscCallCUDA(cudaMalloc((void **)&d_K,sizeof(PetscScalar)*N));
+  PetscCallCUDA(cudaMalloc((void **)&d_W,sizeof(PetscScalar)*N));
+
+  /* square roots until X = T^(1/2^s)-I is small enough */
+  for (;;) {
+    PetscCall(PetscLogGpuTimeBegin());
+    PetscCallCUDA(cudaMemcpy(d_X,d_T,sizeof(PetscScalar)*N,cudaMemcpyDeviceToDevice));
+    PetscCall(shift_diagonal(n,d_X,ld,smone));
+    PetscCallCUBLAS(cublasXnrm2(cublasv2handle,N,d_X,one,&nrm));
+    PetscCall(PetscLogGpuTimeEnd());
+    if (nrm<=xvals[mmax-1] || s==maxroots) break;
+    PetscCall(FNSqrtmDenmanBeavers_CUDAm(fn,n,d_T,ld,PETSC_FALSE));
+    s++;
+  }
+  if (s==maxroots) PetscCall(PetscInfo(fn,"Too many matrix square roots\n"));
+  for (m=1;m<mmax;m++) if (nrm<=xvals[m-1]) break;
+  PetscCall(PetscInfo(fn,"Number of square roots: %" PetscInt_FMT ", degree of the Pade approximant: %" PetscInt_FMT "\n",s,m));
+
+  /* nodes and weights of the quadrature in [0,1], computed on the host */
+  PetscCall(PetscMalloc3(m,&nodes,m,&wts,m*m,&Q));
+  PetscCall(PetscBLASIntCast(m,&mm));
+  PetscCall(gauss_legendre(mm,nodes,wts,Q));
+  for (k=0;k<m;k++) {
+    nodes[k] = (nodes[k]+1.0)/2.0;
+    wts[k] = wts[k]/2.0;
+  }
+
+  /* T = 2^s * sum_k wts[k]*(I+nodes[k]*X)\X */
+  PetscCall(PetscLogGpuTimeBegin());
+  PetscCallCUDA(cudaMemset(d_T,0,sizeof(PetscScalar)*N));
+  for (k=0;k<m;k++) {
+    PetscCallCUDA(cudaMemcpy(d_K,d_X,sizeof(PetscScalar)*N,cudaMemcpyDeviceToDevice));
+    alpha = nodes[k];
+    PetscCallCUBLAS(cublasXscal(cublasv2handle,N,&alpha,d_K,one));
+    PetscCall(shift_diagonal(n,d_K,ld,sone));
+    PetscCallCUDA(cudaMemcpy(d_W,d_X,sizeof(PetscScalar)*N,cudaMemcpyDeviceToDevice));
+    PetscCallMAGMA(magma_xgesv_gpu,n,n,d_K,ld,piv,d_W,ld);
+    alpha = wts[k];
+    PetscCallCUBLAS(cublasXaxpy(cublasv2handle,N,&alpha,d_W,one,d_T,one));
+    PetscCall(PetscLogGpuFlops(2.0*n*n*n/3.0+2.0*n*n*n+4.0*n*n));
+  }
+  alpha = PetscPowRealInt(2.0,s);
+  PetscCallCUBLAS(cublasXscal(cublasv2handle,N,&alpha,d_T,one));
+  PetscCall(PetscLogGpuTimeEnd());
+
+  PetscCall(PetscFree3(nodes,wts,Q));
+  PetscCall(PetscFree(piv));
+  PetscCallCUDA(cudaFree(d_X));
+  PetscCallCUDA(cudaFree(d_K));
+  PetscCallCUDA(cudaFree(d_W));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateFunctionMat_Log_Higham_CUDAm(FN fn,Mat A,Mat B)
+{
+  PetscBLASInt   n = 0;
+  PetscScalar    *T;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  if (A!=B) PetscCall(MatCopy(A,B,SAME_NONZERO_PATTERN));
+  PetscCall(MatDenseCUDAGetArray(B,&T));
+  PetscCall(MatGetSize(A,&m,NULL));
+  PetscCall(PetscBLASIntCast(m,&n));
+  PetscCall(FNLogmISS_CUDAm(fn,n,T,n));
+  PetscCall(MatDenseCUDARestoreArray(B,&T));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateFunctionMatVec_Log_Higham_CUDAm(FN fn,Mat A,Vec v)
+{
+  PetscBLASInt   n = 0;
+  PetscScalar    *T;
+  PetscInt       m;
+  Mat            B;
+
+  PetscFunctionBegin;
+  PetscCall(FN_AllocateWorkMat(fn,A,&B));
+  PetscCall(MatDenseCUDAGetArray(B,&T));
+  PetscCall(MatGetSize(A,&m,NULL));
+  PetscCall(PetscBLASIntCast(m,&n));
+  PetscCall(FNLogmISS_CUDAm(fn,n,T,n));
+  PetscCall(MatDenseCUDARestoreArray(B,&T));
+  PetscCall(MatGetColumnVector(B,v,0));
+  PetscCall(FN_FreeWorkMat(fn,&B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif /* PETSC_HAVE_MAGMA */
+#endif /* PETSC_HAVE_CUDA */
+
 static PetscErrorCode FNView_Log(FN fn,PetscViewer viewer)
 {
   PetscBool      isascii;
@@ -679,8 +826,16 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Log(FN fn)
   PetscFunctionBegin;
   fn->ops->evaluatefunction          = FNEvaluateFunction_Log;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Log;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Log;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Log;
   fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Log_Higham;
   fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Log_Higham;
+#if defined(PETSC_HAVE_CUDA)
+#if defined(PETSC_HAVE_MAGMA)
+  fn->ops->evaluatefunctionmatcuda[0]    = FNEvaluateFunctionMat_Log_Higham_CUDAm;
+  fn->ops->evaluatefunctionmatveccuda[0] = FNEvaluateFunctionMatVec_Log_Higham_CUDAm;
+#endif /* PETSC_HAVE_MAGMA */
+#endif /* PETSC_HAVE_CUDA */
   fn->ops->view                      = FNView_Log;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -58,6 +58,45 @@ static PetscErrorCode FNEvaluateDerivative_Phi(FN fn,PetscScalar x,PetscScalar *
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+
+static PetscErrorCode FNEvaluateFunctionArray_Phi(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  FN_PHI      *ctx = (FN_PHI*)fn->data;
+  PetscInt    i,j;
+  PetscScalar t,p;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    t = x[i];
+    if (t==0.0) p = rfactorial[ctx->k];
+    else {
+      p = PetscExpScalar(t);
+      for (j=1;j<=ctx->k;j++) p = (p-rfactorial[j-1])/t;
+    }
+    y[i] = p;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Phi(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  FN_PHI      *ctx = (FN_PHI*)fn->data;
+  PetscInt    i,j;
+  PetscScalar t,p;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    t = x[i];
+    if (t==0.0) y[i] = rfactorial[ctx->k+1];
+    else {
+      p = PetscExpScalar(t);
+      for (j=1;j<=ctx->k;j++) p = (p-rfactorial[j-1])/t;
+      y[i] = p - (p-rfactorial[ctx->k])/t*(PetscReal)ctx->k;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FNEvaluateFunctionMatVec_Phi(FN fn,Mat A,Vec v)
 {
   FN_PHI            *ctx = (FN_PHI*)fn->data;
@@ -106,6 +145,64 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Phi(FN fn,Mat A,Vec v)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_CUDA)
+#include "../src/sys/classes/fn/impls/cuda/fnutilcuda.h"
+#include <slepccupmblas.h>
+
+/*
+   CUDA version of FNEvaluateFunctionMatVec_Phi(), the augmented matrix is built
+   and exponentiated in device memory
+*/
+static PetscErrorCode FNEvaluateFunctionMatVec_Phi_CUDA(FN fn,Mat A,Vec v)
+{
+  FN_PHI            *ctx = (FN_PHI*)fn->data;
+  PetscInt          j,m,n,nh;
+  PetscScalar       *d_Ha,*d_va;
+  const PetscScalar *d_Aa,*d_Fa;
+  PetscBool         iscuda;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(A,&m,NULL));
+  n = m+ctx->k;
+  if (ctx->H) {
+    PetscCall(MatGetSize(ctx->H,&nh,NULL));
+    PetscCall(PetscObjectTypeCompare((PetscObject)ctx->H,MATSEQDENSECUDA,&iscuda));
+    if (n!=nh || !iscuda) {
+      PetscCall(MatDestroy(&ctx->H));
+      PetscCall(MatDestroy(&ctx->F));
+    }
+  }
+  if (!ctx->H) {
+    PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,n,n,NULL,&ctx->H));
+    PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,n,n,NULL,&ctx->F));
+  }
+  PetscCall(MatDenseCUDAGetArrayWrite(ctx->H,&d_Ha));
+  PetscCall(MatDenseCUDAGetArrayRead(A,&d_Aa));
+  if (ctx->k) PetscCallCUDA(cudaMemset(d_Ha,0,sizeof(PetscScalar)*n*n));
+  PetscCallCUDA(cudaMemcpy2D(d_Ha,sizeof(PetscScalar)*n,d_Aa,sizeof(PetscScalar)*m,sizeof(PetscScalar)*m,m,cudaMemcpyDeviceToDevice));
+  PetscCall(MatDenseCUDARestoreArrayRead(A,&d_Aa));
+  if (ctx->k) {
+    PetscCallCUDA(cudaMemcpy(d_Ha+m*n,&fn->alpha,sizeof(PetscScalar),cudaMemcpyHostToDevice));
+    for (j=m+1;j<n;j++) PetscCallCUDA(cudaMemcpy(d_Ha+j-1+j*n,&fn->alpha,sizeof(PetscScalar),cudaMemcpyHostToDevice));
+  }
+  PetscCall(MatDenseCUDARestoreArrayWrite(ctx->H,&d_Ha));
+
+#if defined(PETSC_HAVE_MAGMA)
+  PetscCall(FNEvaluateFunctionMat_Exp_Higham_CUDAm(fn,ctx->H,ctx->F));
+#else
+  PetscCall(FNEvaluateFunctionMat_Exp_Pade_CUDA(fn,ctx->H,ctx->F));
+#endif
+
+  PetscCall(MatDenseCUDAGetArrayRead(ctx->F,&d_Fa));
+  PetscCall(VecCUDAGetArrayWrite(v,&d_va));
+  PetscCallCUDA(cudaMemcpy(d_va,ctx->k? d_Fa+(n-1)*n: d_Fa,sizeof(PetscScalar)*m,cudaMemcpyDeviceToDevice));
+  PetscCall(VecCUDARestoreArrayWrite(v,&d_va));
+  PetscCall(MatDenseCUDARestoreArrayRead(ctx->F,&d_Fa));
+  if (ctx->k) PetscCall(VecScale(v,PetscPowScalarInt(fn->alpha,-ctx->k)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif /* PETSC_HAVE_CUDA */
+
 static PetscErrorCode FNPhiSetIndex_Phi(FN fn,PetscInt k)
 {
   FN_PHI         *ctx = (FN_PHI*)fn->data;
@@ -261,7 +358,12 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Phi(FN fn)
 
   fn->ops->evaluatefunction          = FNEvaluateFunction_Phi;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Phi;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Phi;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Phi;
   fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Phi;
+#if defined(PETSC_HAVE_CUDA)
+  fn->ops->evaluatefunctionmatveccuda[0] = FNEvaluateFunctionMatVec_Phi_CUDA;
+#endif
   fn->ops->setfromoptions            = FNSetFromOptions_Phi;
   fn->ops->view                      = FNView_Phi;
   fn->ops->duplicate                 = FNDuplicate_Phi;
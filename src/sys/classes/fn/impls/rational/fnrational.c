@@ -12,12 +12,15 @@
 */
 
 #include <slepc/private/fnimpl.h>      /*I "slepcfn.h" I*/
+#include <slepcblaslapack.h>
 
 typedef struct {
   PetscScalar *pcoeff;    /* numerator coefficients */
   PetscInt    np;         /* length of array pcoeff, p(x) has degree np-1 */
   PetscScalar *qcoeff;    /* denominator coefficients */
   PetscInt    nq;         /* length of array qcoeff, q(x) has degree nq-1 */
+  PetscScalar *work;      /* work space for the evaluation on arrays */
+  PetscInt    lwork;      /* length of array work */
 } FN_RATIONAL;
 
 static PetscErrorCode FNEvaluateFunction_Rational(FN fn,PetscScalar x,PetscScalar *y)
@@ -70,7 +73,7 @@ static PetscErrorCode FNEvaluateFunctionMat_Rational(FN fn,Mat A,Mat B)
 {
   FN_RATIONAL *ctx = (FN_RATIONAL*)fn->data;
   Mat         P,Q,W,F;
-  PetscBool   iscuda;
+  PetscBool   iscuda,isscalapack;
 
   PetscFunctionBegin;
   if (A==B) PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&P));
@@ -82,7 +85,8 @@ static PetscErrorCode FNEvaluateFunctionMat_Rational(FN fn,Mat A,Mat B)
     PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
     PetscCall(EvaluatePoly(A,Q,W,ctx->nq,ctx->qcoeff));
     PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
-    PetscCall(MatGetFactor(Q,iscuda?MATSOLVERCUDA:MATSOLVERPETSC,MAT_FACTOR_LU,&F));
+    PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSCALAPACK,&isscalapack));
+    PetscCall(MatGetFactor(Q,iscuda?MATSOLVERCUDA:isscalapack?MATSOLVERSCALAPACK:MATSOLVERPETSC,MAT_FACTOR_LU,&F));
     PetscCall(MatLUFactorSymbolic(F,Q,NULL,NULL,NULL));
     PetscCall(MatLUFactorNumeric(F,Q,NULL));
     PetscCall(MatMatSolve(F,P,P));
@@ -98,35 +102,200 @@ static PetscErrorCode FNEvaluateFunctionMat_Rational(FN fn,Mat A,Mat B)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Horner evaluation of v=p(A)*e_1 with matrix-vector products only
+   d = degree of polynomial;   coeff = coefficients of polynomial;    e = first canonical vector;   w = workspace
+*/
+static PetscErrorCode EvaluatePolyVec(Mat A,Vec v,Vec e,Vec w,PetscInt d,PetscScalar *coeff)
+{
+  PetscInt j;
+
+  PetscFunctionBegin;
+  if (!d) PetscCall(VecCopy(e,v));
+  else {
+    PetscCall(VecCopy(e,v));
+    PetscCall(VecScale(v,coeff[0]));
+    for (j=1;j<d;j++) {
+      PetscCall(MatMult(A,v,w));
+      PetscCall(VecWAXPY(v,coeff[j],e,w));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Checks if A is a (host) dense matrix in upper Hessenberg form, such as the
+   projected matrix of Krylov methods for matrix functions
+*/
+static PetscErrorCode FNRationalIsHessenberg_Private(Mat A,PetscBool *hess)
+{
+  PetscInt          i,j,n,ld;
+  const PetscScalar *pA;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSE,hess));
+  if (!*hess) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetSize(A,&n,NULL));
+  PetscCall(MatDenseGetLDA(A,&ld));
+  PetscCall(MatDenseGetArrayRead(A,&pA));
+  for (j=0;j<n-2 && *hess;j++) {
+    for (i=j+2;i<n;i++) {
+      if (pA[i+j*ld]!=(PetscScalar)0.0) { *hess = PETSC_FALSE; break; }
+    }
+  }
+  PetscCall(MatDenseRestoreArrayRead(A,&pA));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_COMPLEX)
+/*
+   Roots of the polynomial with coefficients c (of length nc, with c[0]!=0),
+   computed as the eigenvalues of the companion matrix
+*/
+static PetscErrorCode FNRationalRoots_Private(PetscInt nc,const PetscScalar *c,PetscComplex *r)
+{
+  PetscInt     i,d=nc-1;
+  PetscBLASInt n,ilo=1,lwork,info;
+  PetscScalar  *C,*wr,*wi,*work;
+
+  PetscFunctionBegin;
+  if (!d) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(d,&n));
+  lwork = n;
+  PetscCall(PetscCalloc1(d*d,&C));
+  PetscCall(PetscMalloc3(d,&wr,d,&wi,d,&work));
+  for (i=0;i<d;i++) C[i*d] = -c[i+1]/c[0];
+  for (i=1;i<d;i++) C[i+(i-1)*d] = 1.0;
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n,&ilo,&n,C,&n,wr,wi,NULL,&n,work,&lwork,&info));
+#else
+  PetscCallBLAS("LAPACKhseqr",LAPACKhseqr_("E","N",&n,&ilo,&n,C,&n,wr,NULL,&n,work,&lwork,&info));
+#endif
+  PetscCall(PetscFPTrapPop());
+  SlepcCheckLapackInfo("hseqr",info);
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<d;i++) r[i] = PetscCMPLX(wr[i],wi[i]);
+#else
+  for (i=0;i<d;i++) r[i] = wr[i];
+#endif
+  PetscCall(PetscFree(C));
+  PetscCall(PetscFree3(wr,wi,work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solves (H-sigma*I)*x=b in place for an upper Hessenberg matrix H, with Gaussian
+   elimination with partial pivoting in O(n^2) operations; W is a work array of size n*n
+*/
+static PetscErrorCode FNRationalHessenbergSolve_Private(PetscInt n,const PetscScalar *H,PetscInt ld,PetscComplex sigma,PetscComplex *x,PetscComplex *W)
+{
+  PetscInt     i,j,k;
+  PetscComplex t,l;
+
+  PetscFunctionBegin;
+  for (j=0;j<n;j++) {
+    for (i=0;i<PetscMin(j+2,n);i++) W[i+j*n] = H[i+j*ld];
+    W[j+j*n] -= sigma;
+  }
+  for (k=0;k<n-1;k++) {
+    if (PetscAbsComplex(W[k+1+k*n])>PetscAbsComplex(W[k+k*n])) {
+      for (j=k;j<n;j++) { t = W[k+j*n]; W[k+j*n] = W[k+1+j*n]; W[k+1+j*n] = t; }
+      t = x[k]; x[k] = x[k+1]; x[k+1] = t;
+    }
+    PetscCheck(PetscAbsComplex(W[k+k*n])!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested matrix, singular denominator");
+    l = W[k+1+k*n]/W[k+k*n];
+    for (j=k+1;j<n;j++) W[k+1+j*n] -= l*W[k+j*n];
+    x[k+1] -= l*x[k];
+  }
+  PetscCheck(PetscAbsComplex(W[n-1+(n-1)*n])!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested matrix, singular denominator");
+  for (k=n-1;k>=0;k--) {
+    for (j=k+1;j<n;j++) x[k] -= W[k+j*n]*x[j];
+    x[k] /= W[k+k*n];
+  }
+  PetscCall(PetscLogFlops(8.0*n*n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+/*
+   Computes v = q(H)\v for an upper Hessenberg matrix H, with the factored form
+   q(H) = c_0*(H-r_1*I)*...*(H-r_d*I), i.e., with d shifted Hessenberg solves
+   instead of forming and factorizing q(H)
+*/
+static PetscErrorCode FNRationalShiftedSolves_Private(FN fn,Mat H,Vec v)
+{
+#if !defined(PETSC_HAVE_COMPLEX)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This function requires C99 or C++ complex support");
+#else
+  FN_RATIONAL       *ctx = (FN_RATIONAL*)fn->data;
+  PetscInt          i,k=0,n,ld,d;
+  PetscScalar       *pv,c0;
+  const PetscScalar *pH;
+  PetscComplex      *x,*W,*r;
+
+  PetscFunctionBegin;
+  while (k<ctx->nq && ctx->qcoeff[k]==(PetscScalar)0.0) k++;
+  PetscCheck(k<ctx->nq,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined, the denominator is zero");
+  c0 = ctx->qcoeff[k];
+  d  = ctx->nq-k-1;
+  PetscCall(MatGetSize(H,&n,NULL));
+  PetscCall(MatDenseGetLDA(H,&ld));
+  PetscCall(PetscMalloc3(n,&x,n*n,&W,d,&r));
+  PetscCall(FNRationalRoots_Private(d+1,ctx->qcoeff+k,r));
+  PetscCall(VecGetArray(v,&pv));
+  for (i=0;i<n;i++) x[i] = pv[i];
+  PetscCall(MatDenseGetArrayRead(H,&pH));
+  for (i=0;i<d;i++) PetscCall(FNRationalHessenbergSolve_Private(n,pH,ld,r[i],x,W));
+  PetscCall(MatDenseRestoreArrayRead(H,&pH));
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) pv[i] = PetscRealPartComplex(x[i])/c0;  /* roots appear in conjugate pairs */
+#else
+  for (i=0;i<n;i++) pv[i] = x[i]/c0;
+#endif
+  PetscCall(VecRestoreArray(v,&pv));
+  PetscCall(PetscFree3(x,W,r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+#endif
+}
+
 static PetscErrorCode FNEvaluateFunctionMatVec_Rational(FN fn,Mat A,Vec v)
 {
   FN_RATIONAL *ctx = (FN_RATIONAL*)fn->data;
-  Mat         P,Q,W,F;
-  Vec         b;
-  PetscBool   iscuda;
+  Mat         Q,W,F;
+  Vec         e,w;
+  PetscBool   iscuda,hess=PETSC_FALSE;
 
   PetscFunctionBegin;
-  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&P));
-  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&W));
-
-  PetscCall(EvaluatePoly(A,P,W,ctx->np,ctx->pcoeff));
+  PetscCall(MatCreateVecs(A,&e,&w));
+  PetscCall(VecSet(e,0.0));
+  PetscCall(VecSetValue(e,0,1.0,INSERT_VALUES));
+  PetscCall(VecAssemblyBegin(e));
+  PetscCall(VecAssemblyEnd(e));
+  PetscCall(EvaluatePolyVec(A,v,e,w,ctx->np,ctx->pcoeff));
   if (ctx->nq) {
-    PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
-    PetscCall(EvaluatePoly(A,Q,W,ctx->nq,ctx->qcoeff));
-    PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
-    PetscCall(MatGetFactor(Q,iscuda?MATSOLVERCUDA:MATSOLVERPETSC,MAT_FACTOR_LU,&F));
-    PetscCall(MatLUFactorSymbolic(F,Q,NULL,NULL,NULL));
-    PetscCall(MatLUFactorNumeric(F,Q,NULL));
-    PetscCall(MatCreateVecs(P,&b,NULL));
-    PetscCall(MatGetColumnVector(P,b,0));
-    PetscCall(MatSolve(F,b,v));
-    PetscCall(VecDestroy(&b));
-    PetscCall(MatDestroy(&F));
-    PetscCall(MatDestroy(&Q));
-  } else PetscCall(MatGetColumnVector(P,v,0));
-
-  PetscCall(MatDestroy(&P));
-  PetscCall(MatDestroy(&W));
+#if defined(PETSC_HAVE_COMPLEX)
+    PetscCall(FNRationalIsHessenberg_Private(A,&hess));
+#endif
+    if (hess) PetscCall(FNRationalShiftedSolves_Private(fn,A,v));
+    else {
+      PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&Q));
+      PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&W));
+      PetscCall(EvaluatePoly(A,Q,W,ctx->nq,ctx->qcoeff));
+      PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
+      PetscCall(MatGetFactor(Q,iscuda?MATSOLVERCUDA:MATSOLVERPETSC,MAT_FACTOR_LU,&F));
+      PetscCall(MatLUFactorSymbolic(F,Q,NULL,NULL,NULL));
+      PetscCall(MatLUFactorNumeric(F,Q,NULL));
+      PetscCall(VecCopy(v,w));
+      PetscCall(MatSolve(F,w,v));
+      PetscCall(MatDestroy(&F));
+      PetscCall(MatDestroy(&Q));
+      PetscCall(MatDestroy(&W));
+    }
+  }
+  PetscCall(VecDestroy(&e));
+  PetscCall(VecDestroy(&w));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -162,6 +331,77 @@ static PetscErrorCode FNEvaluateDerivative_Rational(FN fn,PetscScalar x,PetscSca
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+
+/*
+   Evaluates the polynomial with coefficients c (of length nc) and its derivative
+   on the array x with Horner's rule, with the loop over the points innermost
+*/
+static inline void FNRationalHorner_Private(PetscInt n,const PetscScalar *x,PetscInt nc,const PetscScalar *c,PetscScalar *p,PetscScalar *pp)
+{
+  PetscInt i,j;
+
+  if (!nc) {
+    for (i=0;i<n;i++) p[i] = 1.0;
+    if (pp) for (i=0;i<n;i++) pp[i] = 0.0;
+    return;
+  }
+  for (i=0;i<n;i++) p[i] = c[0];
+  if (pp) for (i=0;i<n;i++) pp[i] = 0.0;
+  for (j=1;j<nc;j++) {
+    if (pp) for (i=0;i<n;i++) pp[i] = p[i]+x[i]*pp[i];
+    for (i=0;i<n;i++) p[i] = c[j]+x[i]*p[i];
+  }
+}
+
+static PetscErrorCode FNRationalAllocateWork_Private(FN_RATIONAL *ctx,PetscInt n)
+{
+  PetscFunctionBegin;
+  if (ctx->lwork<n) {
+    PetscCall(PetscFree(ctx->work));
+    PetscCall(PetscMalloc1(n,&ctx->work));
+    ctx->lwork = n;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateFunctionArray_Rational(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  FN_RATIONAL *ctx = (FN_RATIONAL*)fn->data;
+  PetscInt    i;
+  PetscScalar *p,*q;
+
+  PetscFunctionBegin;
+  PetscCall(FNRationalAllocateWork_Private(ctx,2*n));
+  p = ctx->work; q = ctx->work+n;
+  FNRationalHorner_Private(n,x,ctx->np,ctx->pcoeff,p,NULL);
+  if (!ctx->nq) for (i=0;i<n;i++) y[i] = p[i];
+  else {
+    FNRationalHorner_Private(n,x,ctx->nq,ctx->qcoeff,q,NULL);
+    for (i=0;i<n;i++) PetscCheck(q[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+    for (i=0;i<n;i++) y[i] = p[i]/q[i];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Rational(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *yp)
+{
+  FN_RATIONAL *ctx = (FN_RATIONAL*)fn->data;
+  PetscInt    i;
+  PetscScalar *p,*pp,*q,*qp;
+
+  PetscFunctionBegin;
+  PetscCall(FNRationalAllocateWork_Private(ctx,4*n));
+  p = ctx->work; pp = ctx->work+n; q = ctx->work+2*n; qp = ctx->work+3*n;
+  FNRationalHorner_Private(n,x,ctx->np,ctx->pcoeff,p,pp);
+  if (!ctx->nq) for (i=0;i<n;i++) yp[i] = pp[i];
+  else {
+    FNRationalHorner_Private(n,x,ctx->nq,ctx->qcoeff,q,qp);
+    for (i=0;i<n;i++) PetscCheck(q[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+    for (i=0;i<n;i++) yp[i] = (pp[i]*q[i]-p[i]*qp[i])/(q[i]*q[i]);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FNView_Rational(FN fn,PetscViewer viewer)
 {
   FN_RATIONAL    *ctx = (FN_RATIONAL*)fn->data;
@@ -471,6 +711,7 @@ static PetscErrorCode FNDestroy_Rational(FN fn)
   PetscFunctionBegin;
   PetscCall(PetscFree(ctx->pcoeff));
   PetscCall(PetscFree(ctx->qcoeff));
+  PetscCall(PetscFree(ctx->work));
   PetscCall(PetscFree(fn->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)fn,"FNRationalSetNumerator_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)fn,"FNRationalGetNumerator_C",NULL));
@@ -489,11 +730,16 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Rational(FN fn)
 
   fn->ops->evaluatefunction          = FNEvaluateFunction_Rational;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Rational;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Rational;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Rational;
   fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Rational;
   fn->ops->evaluatefunctionmatvec[0] = FNEvaluateFunctionMatVec_Rational;
 #if defined(PETSC_HAVE_CUDA)
   fn->ops->evaluatefunctionmatcuda[0]    = FNEvaluateFunctionMat_Rational;
   fn->ops->evaluatefunctionmatveccuda[0] = FNEvaluateFunctionMatVec_Rational;
+#endif
+#if defined(PETSC_HAVE_SCALAPACK)
+  fn->ops->evaluatefunctionmatdist[0]    = FNEvaluateFunctionMat_Rational;
 #endif
   fn->ops->setfromoptions            = FNSetFromOptions_Rational;
   fn->ops->view                      = FNView_Rational;
@@ -35,6 +35,31 @@ static PetscErrorCode FNEvaluateDerivative_Sqrt(FN fn,PetscScalar x,PetscScalar
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode FNEvaluateFunctionArray_Sqrt(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Function not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = PetscSqrtScalar(x[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode FNEvaluateDerivativeArray_Sqrt(FN fn,PetscInt n,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) PetscCheck(x[i]!=0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#if !defined(PETSC_USE_COMPLEX)
+  for (i=0;i<n;i++) PetscCheck(x[i]>0.0,PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Derivative not defined in the requested value");
+#endif
+  for (i=0;i<n;i++) y[i] = 1.0/(2.0*PetscSqrtScalar(x[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FNEvaluateFunctionMat_Sqrt_Schur(FN fn,Mat A,Mat B)
 {
   PetscBLASInt   n=0;
@@ -404,6 +429,8 @@ SLEPC_EXTERN PetscErrorCode FNCreate_Sqrt(FN fn)
   PetscFunctionBegin;
   fn->ops->evaluatefunction          = FNEvaluateFunction_Sqrt;
   fn->ops->evaluatederivative        = FNEvaluateDerivative_Sqrt;
+  fn->ops->evaluatefunctionarray     = FNEvaluateFunctionArray_Sqrt;
+  fn->ops->evaluatederivativearray   = FNEvaluateDerivativeArray_Sqrt;
   fn->ops->evaluatefunctionmat[0]    = FNEvaluateFunctionMat_Sqrt_Schur;
   fn->ops->evaluatefunctionmat[1]    = FNEvaluateFunctionMat_Sqrt_DBP;
   fn->ops->evaluatefunctionmat[2]    = FNEvaluateFunctionMat_Sqrt_NS;
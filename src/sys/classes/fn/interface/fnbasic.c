@@ -20,7 +20,7 @@ PetscClassId      FN_CLASSID = 0;
 PetscLogEvent     FN_Evaluate = 0;
 static PetscBool  FNPackageInitialized = PETSC_FALSE;
 
-const char *FNParallelTypes[] = {"REDUNDANT","SYNCHRONIZED","FNParallelType","FN_PARALLEL_",NULL};
+const char *FNParallelTypes[] = {"REDUNDANT","SYNCHRONIZED","DISTRIBUTED","FNParallelType","FN_PARALLEL_",NULL};
 
 /*@C
    FNFinalizePackage - This function destroys everything in the Slepc interface
@@ -389,7 +389,7 @@ PetscErrorCode FNGetMethod(FN fn,PetscInt *meth)
 -  pmode - the parallel mode
 
    Options Database Key:
-.  -fn_parallel <mode> - Sets the parallel mode, either 'redundant' or 'synchronized'
+.  -fn_parallel <mode> - Sets the parallel mode, either 'redundant', 'synchronized' or 'distributed'
 
    Notes:
    This is relevant only when the function is evaluated on a matrix, with
@@ -405,6 +405,14 @@ PetscErrorCode FNGetMethod(FN fn,PetscInt *meth)
    processes in the communicator. This communication is done automatically at
    the end of FNEvaluateFunctionMat() or FNEvaluateFunctionMatVec().
 
+   In the 'distributed' parallel mode, the matrix is redistributed among the
+   MPI processes as a ScaLAPACK matrix and the function is evaluated with
+   parallel dense operations, then the result is gathered on all processes.
+   This is intended for large matrices, and requires PETSc configured with
+   ScaLAPACK. Only some FN types and methods implement it (currently the
+   Pade method of FNEXP and FNRATIONAL), otherwise the computation is done
+   redundantly.
+
    Level: advanced
 
 .seealso: FNEvaluateFunctionMat() or FNEvaluateFunctionMatVec(), FNGetParallel()
@@ -514,6 +522,104 @@ PetscErrorCode FNEvaluateDerivative(FN fn,PetscScalar x,PetscScalar *y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   FNEvaluateFunctionArray - Computes the values of the function f(x) for an
+   array of values of x.
+
+   Not Collective
+
+   Input Parameters:
++  fn - the math function context
+.  n  - number of values
+-  x  - the values where the function must be evaluated
+
+   Output Parameter:
+.  y  - the results f(x[i]), i=0,...,n-1
+
+   Notes:
+   This is equivalent to calling FNEvaluateFunction() n times, but the function
+   type is dispatched only once and the evaluation is done with a loop over the
+   array that the compiler can vectorize, when the FN type provides it. It is
+   more efficient when many evaluations of the same function are required.
+
+   The arrays x and y may be the same, in which case the values of x are
+   overwritten with the result. Scaling factors are taken into account as in
+   FNEvaluateFunction().
+
+   Level: intermediate
+
+.seealso: FNEvaluateFunction(), FNEvaluateDerivativeArray()
+@*/
+PetscErrorCode FNEvaluateFunctionArray(FN fn,PetscInt n,const PetscScalar x[],PetscScalar y[])
+{
+  PetscInt          i;
+  const PetscScalar *xf=x;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidType(fn,1);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(x,3);
+  PetscAssertPointer(y,4);
+  PetscCall(PetscLogEventBegin(FN_Evaluate,fn,0,0,0));
+  if (fn->alpha!=(PetscScalar)1.0) {
+    for (i=0;i<n;i++) y[i] = fn->alpha*x[i];
+    xf = y;
+  }
+  if (fn->ops->evaluatefunctionarray) PetscUseTypeMethod(fn,evaluatefunctionarray,n,xf,y);
+  else for (i=0;i<n;i++) PetscUseTypeMethod(fn,evaluatefunction,xf[i],y+i);
+  if (fn->beta!=(PetscScalar)1.0) for (i=0;i<n;i++) y[i] *= fn->beta;
+  PetscCall(PetscLogEventEnd(FN_Evaluate,fn,0,0,0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   FNEvaluateDerivativeArray - Computes the values of the derivative f'(x) for
+   an array of values of x.
+
+   Not Collective
+
+   Input Parameters:
++  fn - the math function context
+.  n  - number of values
+-  x  - the values where the derivative must be evaluated
+
+   Output Parameter:
+.  y  - the results f'(x[i]), i=0,...,n-1
+
+   Notes:
+   The arrays x and y may be the same. Scaling factors are taken into account
+   as in FNEvaluateDerivative().
+
+   Level: intermediate
+
+.seealso: FNEvaluateDerivative(), FNEvaluateFunctionArray()
+@*/
+PetscErrorCode FNEvaluateDerivativeArray(FN fn,PetscInt n,const PetscScalar x[],PetscScalar y[])
+{
+  PetscInt          i;
+  const PetscScalar *xf=x;
+  PetscScalar       s;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(fn,FN_CLASSID,1);
+  PetscValidType(fn,1);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(x,3);
+  PetscAssertPointer(y,4);
+  PetscCall(PetscLogEventBegin(FN_Evaluate,fn,0,0,0));
+  if (fn->alpha!=(PetscScalar)1.0) {
+    for (i=0;i<n;i++) y[i] = fn->alpha*x[i];
+    xf = y;
+  }
+  if (fn->ops->evaluatederivativearray) PetscUseTypeMethod(fn,evaluatederivativearray,n,xf,y);
+  else for (i=0;i<n;i++) PetscUseTypeMethod(fn,evaluatederivative,xf[i],y+i);
+  s = fn->alpha*fn->beta;
+  if (s!=(PetscScalar)1.0) for (i=0;i<n;i++) y[i] *= s;
+  PetscCall(PetscLogEventEnd(FN_Evaluate,fn,0,0,0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FNEvaluateFunctionMat_Sym_Private(FN fn,const PetscScalar *As,PetscScalar *Bs,PetscInt m,PetscBool firstonly)
 {
   PetscInt       i,j;
@@ -604,9 +710,84 @@ static PetscErrorCode FNEvaluateFunctionMat_Basic(FN fn,Mat A,Mat F)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Checks if the evaluation must be done in FN_PARALLEL_DISTRIBUTED mode, which
+   requires several processes and a distributed kernel for the selected method
+*/
+static PetscErrorCode FNUseDistributed_Private(FN fn,PetscBool *dist)
+{
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  *dist = PETSC_FALSE;
+  if (fn->pmode!=FN_PARALLEL_DISTRIBUTED) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)fn),&size));
+  if (size==1) PetscFunctionReturn(PETSC_SUCCESS);
+  if (fn->ops->evaluatefunctionmatdist[fn->method]) *dist = PETSC_TRUE;
+  else PetscCall(PetscInfo(fn,"The method %" PetscInt_FMT " is not available in distributed mode, computing redundantly\n",fn->method));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_SCALAPACK)
+/*
+   Computes F = beta*f(alpha*A) in FN_PARALLEL_DISTRIBUTED mode: the sequential
+   matrix A, equal in all processes, is redistributed as a MATSCALAPACK matrix,
+   the type-specific kernel operates on it, and the result is gathered in F
+*/
+static PetscErrorCode FNEvaluateFunctionMat_Distributed(FN fn,Mat A,Mat F)
+{
+  PetscInt          i,j,n,lda,ldd,rstart,rend;
+  PetscMPIInt       n2;
+  PetscScalar       *pD,*pF;
+  const PetscScalar *pA,*pR;
+  Mat               D,As,Fs;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)fn);
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(A,&n,NULL));
+  PetscCall(MatCreateDense(comm,PETSC_DECIDE,PETSC_DECIDE,n,n,NULL,&D));
+  PetscCall(MatGetOwnershipRange(D,&rstart,&rend));
+  PetscCall(MatDenseGetLDA(A,&lda));
+  PetscCall(MatDenseGetLDA(D,&ldd));
+  PetscCall(MatDenseGetArrayRead(A,&pA));
+  PetscCall(MatDenseGetArrayWrite(D,&pD));
+  for (j=0;j<n;j++) for (i=rstart;i<rend;i++) pD[i-rstart+j*ldd] = pA[i+j*lda];
+  PetscCall(MatDenseRestoreArrayWrite(D,&pD));
+  PetscCall(MatDenseRestoreArrayRead(A,&pA));
+  PetscCall(MatAssemblyBegin(D,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(D,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatConvert(D,MATSCALAPACK,MAT_INITIAL_MATRIX,&As));
+  PetscCall(MatDestroy(&D));
+
+  if (fn->alpha!=(PetscScalar)1.0) PetscCall(MatScale(As,fn->alpha));
+  PetscCall(MatDuplicate(As,MAT_DO_NOT_COPY_VALUES,&Fs));
+  PetscUseTypeMethod(fn,evaluatefunctionmatdist[fn->method],As,Fs);
+  PetscCall(MatScale(Fs,fn->beta));
+  PetscCall(MatDestroy(&As));
+
+  /* gather the result in all processes */
+  PetscCall(MatConvert(Fs,MATDENSE,MAT_INITIAL_MATRIX,&D));
+  PetscCall(MatDestroy(&Fs));
+  PetscCall(MatGetOwnershipRange(D,&rstart,&rend));
+  PetscCall(MatDenseGetLDA(D,&ldd));
+  PetscCall(MatDenseGetLDA(F,&lda));
+  PetscCheck(lda==n,PETSC_COMM_SELF,PETSC_ERR_SUP,"The distributed mode requires a matrix with leading dimension equal to its size");
+  PetscCall(MatDenseGetArrayRead(D,&pR));
+  PetscCall(MatDenseGetArrayWrite(F,&pF));
+  PetscCall(PetscArrayzero(pF,n*n));
+  for (j=0;j<n;j++) for (i=rstart;i<rend;i++) pF[i+j*n] = pR[i-rstart+j*ldd];
+  PetscCall(PetscMPIIntCast(n*n,&n2));
+  PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,pF,n2,MPIU_SCALAR,MPIU_SUM,comm));
+  PetscCall(MatDenseRestoreArrayWrite(F,&pF));
+  PetscCall(MatDenseRestoreArrayRead(D,&pR));
+  PetscCall(MatDestroy(&D));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 PetscErrorCode FNEvaluateFunctionMat_Private(FN fn,Mat A,Mat B,PetscBool sync)
 {
-  PetscBool      set,flg,symm=PETSC_FALSE,iscuda,hasspecificmeth;
+  PetscBool      set,flg,symm=PETSC_FALSE,iscuda,hasspecificmeth,dist;
   PetscInt       m,n;
   PetscMPIInt    size,rank,n2;
   PetscScalar    *pF;
@@ -622,7 +803,14 @@ PetscErrorCode FNEvaluateFunctionMat_Private(FN fn,Mat A,Mat B,PetscBool sync)
 
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)fn),&size));
   PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)fn),&rank));
-  if (size==1 || fn->pmode==FN_PARALLEL_REDUNDANT || (fn->pmode==FN_PARALLEL_SYNCHRONIZED && !rank)) {
+  PetscCall(FNUseDistributed_Private(fn,&dist));
+  if (dist) {
+#if defined(PETSC_HAVE_SCALAPACK)
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    PetscCall(FNEvaluateFunctionMat_Distributed(fn,A,F));
+    PetscCall(PetscFPTrapPop());
+#endif
+  } else if (size==1 || fn->pmode!=FN_PARALLEL_SYNCHRONIZED || !rank) {
     PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
     PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
     hasspecificmeth = ((iscuda && fn->ops->evaluatefunctionmatcuda[fn->method]) || (!iscuda && fn->method && fn->ops->evaluatefunctionmat[fn->method]))? PETSC_TRUE: PETSC_FALSE;
@@ -726,7 +914,7 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Default(FN fn,Mat A,Vec v)
   Mat            F;
 
   PetscFunctionBegin;
-  PetscCall(FN_AllocateWorkMat(fn,A,&F));
+  PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&F));
   PetscCall(FNEvaluateFunctionMat_Basic(fn,A,F));
   PetscCall(MatGetColumnVector(F,v,0));
   PetscCall(FN_FreeWorkMat(fn,&F));
@@ -756,7 +944,7 @@ static PetscErrorCode FNEvaluateFunctionMatVec_Sym_Default(FN fn,Mat A,Vec v)
 
 PetscErrorCode FNEvaluateFunctionMatVec_Private(FN fn,Mat A,Vec v,PetscBool sync)
 {
-  PetscBool      set,flg,symm=PETSC_FALSE,iscuda,hasspecificmeth;
+  PetscBool      set,flg,symm=PETSC_FALSE,iscuda,hasspecificmeth,dist;
   PetscInt       m,n;
   Mat            M;
   PetscMPIInt    size,rank,n_;
@@ -770,7 +958,17 @@ PetscErrorCode FNEvaluateFunctionMatVec_Private(FN fn,Mat A,Vec v,PetscBool sync
   /* evaluate matrix function */
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)fn),&size));
   PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)fn),&rank));
-  if (size==1 || fn->pmode==FN_PARALLEL_REDUNDANT || (fn->pmode==FN_PARALLEL_SYNCHRONIZED && !rank)) {
+  PetscCall(FNUseDistributed_Private(fn,&dist));
+  if (dist) {
+#if defined(PETSC_HAVE_SCALAPACK)
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    PetscCall(FN_AllocateWorkMatNoCopy(fn,A,&M));
+    PetscCall(FNEvaluateFunctionMat_Distributed(fn,A,M));
+    PetscCall(MatGetColumnVector(M,v,0));
+    PetscCall(FN_FreeWorkMat(fn,&M));
+    PetscCall(PetscFPTrapPop());
+#endif
+  } else if (size==1 || fn->pmode!=FN_PARALLEL_SYNCHRONIZED || !rank) {
     PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
     PetscCall(PetscObjectTypeCompare((PetscObject)A,MATSEQDENSECUDA,&iscuda));
     hasspecificmeth = ((iscuda && fn->ops->evaluatefunctionmatcuda[fn->method]) || (!iscuda && fn->method && fn->ops->evaluatefunctionmat[fn->method]))? PETSC_TRUE: PETSC_FALSE;
@@ -56,16 +56,21 @@ int main(int argc,char **argv)
   Mat            A;
   PetscInt       i,j,n=8,k;
   PetscScalar    tau,eta,*As;
-  PetscBool      verbose;
+  PetscBool      verbose,matcuda;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
   PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-verbose",&verbose));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-matcuda",&matcuda));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Test Phi functions, n=%" PetscInt_FMT ".\n",n));
 
   /* Create matrix, fill it with 1-D Laplacian */
-  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A));
+  if (matcuda) {
+#if defined(PETSC_HAVE_CUDA)
+    PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,n,n,NULL,&A));
+#endif
+  } else PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A));
   PetscCall(PetscObjectSetName((PetscObject)A,"A"));
   PetscCall(MatDenseGetArray(A,&As));
   for (i=0;i<n;i++) As[i+i*n]=2.0;
@@ -108,10 +113,16 @@ int main(int argc,char **argv)
 
 /*TEST
 
-   test:
-      suffix: 1
+   testset:
       nsize: 1
-      args: -fn_phi_index 3
+      output_file: output/test10_1.out
       requires: !single
+      test:
+         suffix: 1
+         args: -fn_phi_index 3
+      test:
+         suffix: 1_cuda
+         args: -fn_phi_index 3 -matcuda
+         requires: cuda
 
 TEST*/
@@ -27,9 +27,9 @@ PetscErrorCode TestMatLog(FN fn,Mat A,PetscViewer viewer,PetscBool verbose,Petsc
 
   PetscFunctionBeginUser;
   PetscCall(MatGetSize(A,&n,NULL));
-  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&F));
+  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&F));
   PetscCall(PetscObjectSetName((PetscObject)F,"F"));
-  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&R));
+  PetscCall(MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&R));
   PetscCall(PetscObjectSetName((PetscObject)R,"R"));
   PetscCall(FNGetScale(fn,&tau,&eta));
   /* compute matrix logarithm */
@@ -77,7 +77,7 @@ int main(int argc,char **argv)
   PetscInt       i,j,n=10;
   PetscScalar    *As;
   PetscViewer    viewer;
-  PetscBool      verbose,inplace,random,triang;
+  PetscBool      verbose,inplace,random,triang,matcuda;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
@@ -86,6 +86,7 @@ int main(int argc,char **argv)
   PetscCall(PetscOptionsHasName(NULL,NULL,"-inplace",&inplace));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-random",&random));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-triang",&triang));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-matcuda",&matcuda));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Matrix logarithm, n=%" PetscInt_FMT ".\n",n));
 
   /* Create logarithm function object */
@@ -99,7 +100,11 @@ int main(int argc,char **argv)
   if (verbose) PetscCall(PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_MATLAB));
 
   /* Create matrices */
-  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A));
+  if (matcuda) {
+#if defined(PETSC_HAVE_CUDA)
+    PetscCall(MatCreateSeqDenseCUDA(PETSC_COMM_SELF,n,n,NULL,&A));
+#endif
+  } else PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,n,n,NULL,&A));
   PetscCall(PetscObjectSetName((PetscObject)A,"A"));
 
   if (random) PetscCall(MatSetRandom(A,NULL));
@@ -143,5 +148,9 @@ int main(int argc,char **argv)
          args: -fn_scale .02,2 -n 75 -random
          requires: complex !__float128
          filter_output: sed -e 's/04/02/'
+      test:
+         suffix: 1_cuda
+         args: -fn_scale .04,2 -n 75 -matcuda
+         requires: cuda magma c99_complex !__float128
 
 TEST*/
@@ -0,0 +1,122 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test FNEvaluateFunctionArray() and FNEvaluateDerivativeArray().\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = number of evaluation points.\n\n";
+
+#include <slepcfn.h>
+
+/*
+   Compares the array evaluation with the evaluation of one scalar at a time,
+   both with separate input/output arrays and in-place
+*/
+PetscErrorCode CheckArray(FN fn,const char *name,PetscInt n,const PetscScalar *x)
+{
+  PetscInt    i,d;
+  PetscScalar *y,*z,*w;
+  PetscReal   err=0.0,nrm=0.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscMalloc3(n,&y,n,&z,n,&w));
+  for (d=0;d<2;d++) {
+    for (i=0;i<n;i++) {
+      if (d) PetscCall(FNEvaluateDerivative(fn,x[i],y+i));
+      else PetscCall(FNEvaluateFunction(fn,x[i],y+i));
+      nrm = PetscMax(nrm,PetscAbsScalar(y[i]));
+    }
+    PetscCall(PetscArraycpy(w,x,n));
+    if (d) {
+      PetscCall(FNEvaluateDerivativeArray(fn,n,x,z));
+      PetscCall(FNEvaluateDerivativeArray(fn,n,w,w));
+    } else {
+      PetscCall(FNEvaluateFunctionArray(fn,n,x,z));
+      PetscCall(FNEvaluateFunctionArray(fn,n,w,w));
+    }
+    for (i=0;i<n;i++) err = PetscMax(err,PetscMax(PetscAbsScalar(y[i]-z[i]),PetscAbsScalar(y[i]-w[i])));
+  }
+  if (err<100*PETSC_MACHINE_EPSILON*nrm) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"%s: array evaluation matches the scalar one\n",name));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"%s: difference with the scalar evaluation %g\n",name,(double)(err/nrm)));
+  PetscCall(PetscFree3(y,z,w));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc,char **argv)
+{
+  FN          f,g,h,e,r,c;
+  PetscInt    i,n=50;
+  PetscScalar *x,p[3]={-2.0,1.0,0.5},q[2]={1.0,3.0};
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Evaluation of functions on arrays of %" PetscInt_FMT " points.\n",n));
+  PetscCall(PetscMalloc1(n,&x));
+  for (i=0;i<n;i++) x[i] = 0.1+2.0*i/n;
+
+  /* elementary functions, with scaling */
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&f));
+  PetscCall(FNSetScale(f,0.8,1.5));
+  PetscCall(FNSetType(f,FNEXP));
+  PetscCall(CheckArray(f,"exp",n,x));
+  PetscCall(FNSetType(f,FNLOG));
+  PetscCall(CheckArray(f,"log",n,x));
+  PetscCall(FNSetType(f,FNSQRT));
+  PetscCall(CheckArray(f,"sqrt",n,x));
+  PetscCall(FNSetType(f,FNINVSQRT));
+  PetscCall(CheckArray(f,"invsqrt",n,x));
+  PetscCall(FNSetType(f,FNPHI));
+  PetscCall(FNPhiSetIndex(f,3));
+  PetscCall(CheckArray(f,"phi_3",n,x));
+  PetscCall(FNSetType(f,FNRATIONAL));
+  PetscCall(FNRationalSetNumerator(f,3,p));
+  PetscCall(FNRationalSetDenominator(f,2,q));
+  PetscCall(CheckArray(f,"rational",n,x));
+
+  /* combined function h(x) = exp(r(x))*sqrt(x)/(x+3), with r(x) rational */
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&e));
+  PetscCall(FNSetType(e,FNEXP));
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&g));
+  PetscCall(FNSetType(g,FNCOMBINE));
+  PetscCall(FNCombineSetChildren(g,FN_COMBINE_COMPOSE,f,e));
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&r));
+  PetscCall(FNSetType(r,FNSQRT));
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&c));
+  PetscCall(FNSetType(c,FNCOMBINE));
+  PetscCall(FNCombineSetChildren(c,FN_COMBINE_MULTIPLY,g,r));
+  PetscCall(FNDestroy(&r));
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&r));
+  PetscCall(FNSetType(r,FNRATIONAL));
+  PetscCall(FNRationalSetNumerator(r,2,q));
+  PetscCall(FNCreate(PETSC_COMM_WORLD,&h));
+  PetscCall(FNSetType(h,FNCOMBINE));
+  PetscCall(FNCombineSetChildren(h,FN_COMBINE_DIVIDE,c,r));
+  PetscCall(CheckArray(h,"combine",n,x));
+  PetscCall(FNCombineSetChildren(h,FN_COMBINE_ADD,c,r));
+  PetscCall(CheckArray(h,"combine (add)",n,x));
+
+  PetscCall(FNDestroy(&f));
+  PetscCall(FNDestroy(&g));
+  PetscCall(FNDestroy(&h));
+  PetscCall(FNDestroy(&e));
+  PetscCall(FNDestroy(&r));
+  PetscCall(FNDestroy(&c));
+  PetscCall(PetscFree(x));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      requires: !single
+
+TEST*/
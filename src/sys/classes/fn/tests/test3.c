@@ -172,6 +172,11 @@ int main(int argc,char **argv)
          suffix: 1_magma
          args: -fn_method {{0 1 2 3}} -matcuda
          requires: cuda magma
+      test:
+         suffix: 1_distributed
+         nsize: 2
+         args: -fn_method 1 -fn_parallel distributed
+         requires: scalapack
       test:
          suffix: 2
          args: -inplace -fn_method{{0 1}}
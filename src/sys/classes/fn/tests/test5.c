@@ -118,6 +118,12 @@ int main(int argc,char **argv)
   PetscCall(MatSetOption(A,MAT_HERMITIAN,PETSC_FALSE));
   PetscCall(TestMatRational(fn,A,viewer,verbose,inplace));
 
+  /* Repeat with an upper Hessenberg matrix */
+  PetscCall(MatDenseGetArray(A,&As));
+  for (i=0;i<n-2;i++) As[(i+2)+i*n]=0.0;
+  PetscCall(MatDenseRestoreArray(A,&As));
+  PetscCall(TestMatRational(fn,A,viewer,verbose,inplace));
+
   PetscCall(MatDestroy(&A));
   PetscCall(FNDestroy(&fn));
   PetscCall(SlepcFinalize());
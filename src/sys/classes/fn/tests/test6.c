@@ -21,7 +21,9 @@
              r(x)   e(x)          e(x) = exp(x)     (exponential)
 */
 
-static char help[] = "Test combined function.\n\n";
+static char help[] = "Test combined function.\n\n"
+  "The command line options are:\n"
+  "  -constant, to combine the function with constant functions, f(x)+0 and f(x)/1.\n\n";
 
 #include <slepcfn.h>
 
@@ -79,13 +81,13 @@ PetscErrorCode TestMatCombine(FN fn,Mat A,PetscViewer viewer,PetscBool verbose,P
 
 int main(int argc,char **argv)
 {
-  FN             f,g,h,e,r,fcopy;
+  FN             f,g,h,e,r,fcopy,c0,c1,k1=NULL,k2;
   Mat            A=NULL;
   PetscInt       i,j,n=10,np,nq;
   PetscScalar    x,y,yp,*As,p[10],q[10];
   char           strx[50],str[50];
   PetscViewer    viewer;
-  PetscBool      verbose,inplace,matcuda;
+  PetscBool      verbose,inplace,matcuda,constant;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
@@ -93,6 +95,7 @@ int main(int argc,char **argv)
   PetscCall(PetscOptionsHasName(NULL,NULL,"-verbose",&verbose));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-inplace",&inplace));
   PetscCall(PetscOptionsHasName(NULL,NULL,"-matcuda",&matcuda));
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-constant",&constant));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Combined function, n=%" PetscInt_FMT ".\n",n));
 
   /* Create function */
@@ -146,6 +149,28 @@ int main(int argc,char **argv)
   /* Test duplication */
   PetscCall(FNDuplicate(f,PetscObjectComm((PetscObject)f),&fcopy));
 
+  /* Combine with constant children, which should not change the result */
+  if (constant) {
+    PetscCall(FNCreate(PETSC_COMM_WORLD,&c0));
+    PetscCall(FNSetType(c0,FNRATIONAL));
+    p[0] = 0.0;
+    PetscCall(FNRationalSetNumerator(c0,1,p));
+    PetscCall(FNCreate(PETSC_COMM_WORLD,&c1));
+    PetscCall(FNSetType(c1,FNRATIONAL));
+    p[0] = 1.0;
+    PetscCall(FNRationalSetNumerator(c1,1,p));
+    PetscCall(FNCreate(PETSC_COMM_WORLD,&k1));
+    PetscCall(FNSetType(k1,FNCOMBINE));
+    PetscCall(FNCombineSetChildren(k1,FN_COMBINE_ADD,fcopy,c0));
+    PetscCall(FNCreate(PETSC_COMM_WORLD,&k2));
+    PetscCall(FNSetType(k2,FNCOMBINE));
+    PetscCall(FNCombineSetChildren(k2,FN_COMBINE_DIVIDE,k1,c1));
+    PetscCall(FNDestroy(&fcopy));
+    PetscCall(FNDestroy(&c0));
+    PetscCall(FNDestroy(&c1));
+    fcopy = k2;
+  }
+
   /* Create matrices */
   if (matcuda) {
 #if defined(PETSC_HAVE_CUDA)
@@ -171,6 +196,7 @@ int main(int argc,char **argv)
   PetscCall(MatDestroy(&A));
   PetscCall(FNDestroy(&f));
   PetscCall(FNDestroy(&fcopy));
+  PetscCall(FNDestroy(&k1));
   PetscCall(FNDestroy(&g));
   PetscCall(FNDestroy(&h));
   PetscCall(FNDestroy(&e));
@@ -196,5 +222,8 @@ int main(int argc,char **argv)
          suffix: 2_cuda
          args: -inplace -matcuda
          requires: cuda
+      test:
+         suffix: 3
+         args: -constant
 
 TEST*/
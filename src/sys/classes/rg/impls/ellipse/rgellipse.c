@@ -242,6 +242,54 @@ static PetscErrorCode RGCheckInside_Ellipse(RG rg,PetscReal px,PetscReal py,Pets
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode RGCheckInsideArray_Ellipse(RG rg,PetscInt n,const PetscReal *px,const PetscReal *py,PetscInt *inside)
+{
+  RG_ELLIPSE *ctx = (RG_ELLIPSE*)rg->data;
+  PetscReal  dx,dy,r,cx,cy,vs2;
+  PetscInt   i;
+
+  PetscFunctionBegin;
+  cx  = PetscRealPart(ctx->center);
+  cy  = PetscImaginaryPart(ctx->center);
+  vs2 = ctx->vscale*ctx->vscale;
+  for (i=0;i<n;i++) {
+    dx = (px[i]-cx)/ctx->radius;
+    dy = (py[i]-cy)/ctx->radius;
+    r  = 1.0-dx*dx-(dy*dy)/vs2;
+    inside[i] = PetscSign(r);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The central ellipse has radius radius/sqrt(k), so that all subregions have the same area
+*/
+static PetscErrorCode RGSplit_Ellipse(RG rg,PetscInt k,RG *sub)
+{
+  RG_ELLIPSE *ctx = (RG_ELLIPSE*)rg->data;
+  PetscReal  ri;
+  PetscInt   i;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscReal  r0,r1;
+#endif
+
+  PetscFunctionBegin;
+  ri = ctx->radius/PetscSqrtReal((PetscReal)k);
+  PetscCall(RGSetType(sub[0],RGELLIPSE));
+  PetscCall(RGEllipseSetParameters(sub[0],ctx->center,(k==1)?ctx->radius:ri,ctx->vscale));
+  for (i=1;i<k;i++) {
+    PetscCall(RGSetType(sub[i],RGRING));
+#if defined(PETSC_USE_COMPLEX)
+    PetscCall(RGRingSetParameters(sub[i],ctx->center,(ctx->radius+ri)/2.0,ctx->vscale,(PetscReal)(i-1)/(k-1),(PetscReal)i/(k-1),ctx->radius-ri));
+#else
+    r0 = ctx->radius*PetscSqrtReal((PetscReal)i/k);
+    r1 = (i==k-1)? ctx->radius: ctx->radius*PetscSqrtReal((PetscReal)(i+1)/k);
+    PetscCall(RGRingSetParameters(sub[i],ctx->center,(r0+r1)/2.0,ctx->vscale,0.0,1.0,r1-r0));
+#endif
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode RGIsAxisymmetric_Ellipse(RG rg,PetscBool vertical,PetscBool *symm)
 {
   RG_ELLIPSE *ctx = (RG_ELLIPSE*)rg->data;
@@ -296,7 +344,9 @@ SLEPC_EXTERN PetscErrorCode RGCreate_Ellipse(RG rg)
   rg->ops->computebbox       = RGComputeBoundingBox_Ellipse;
   rg->ops->computequadrature = RGComputeQuadrature_Ellipse;
   rg->ops->checkinside       = RGCheckInside_Ellipse;
+  rg->ops->checkinsidearray  = RGCheckInsideArray_Ellipse;
   rg->ops->isaxisymmetric    = RGIsAxisymmetric_Ellipse;
+  rg->ops->split             = RGSplit_Ellipse;
   rg->ops->setfromoptions    = RGSetFromOptions_Ellipse;
   rg->ops->view              = RGView_Ellipse;
   rg->ops->destroy           = RGDestroy_Ellipse;
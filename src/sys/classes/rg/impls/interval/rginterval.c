@@ -305,6 +305,49 @@ static PetscErrorCode RGCheckInside_Interval(RG rg,PetscReal dx,PetscReal dy,Pet
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode RGCheckInsideArray_Interval(RG rg,PetscInt n,const PetscReal *dx,const PetscReal *dy,PetscInt *inside)
+{
+  RG_INTERVAL *ctx = (RG_INTERVAL*)rg->data;
+  PetscInt    i,ix,iy;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) {
+    ix = (dx[i]>ctx->a && dx[i]<ctx->b)? 1: ((dx[i]==ctx->a || dx[i]==ctx->b)? 0: -1);
+    iy = (dy[i]>ctx->c && dy[i]<ctx->d)? 1: ((dy[i]==ctx->c || dy[i]==ctx->d)? 0: -1);
+    inside[i] = PetscMin(ix,iy);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RGSplit_Interval(RG rg,PetscInt k,RG *sub)
+{
+  RG_INTERVAL *ctx = (RG_INTERVAL*)rg->data;
+  PetscReal   h;
+  PetscInt    i;
+  PetscBool   horiz=PETSC_TRUE;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_COMPLEX)
+  horiz = (ctx->b-ctx->a>=ctx->d-ctx->c)? PETSC_TRUE: PETSC_FALSE;
+#endif
+  if (horiz) {
+    PetscCheck(ctx->a<ctx->b && ctx->a>-PETSC_MAX_REAL && ctx->b<PETSC_MAX_REAL,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"The interval must have finite distinct endpoints in the real axis");
+    h = (ctx->b-ctx->a)/k;
+    for (i=0;i<k;i++) {
+      PetscCall(RGSetType(sub[i],RGINTERVAL));
+      PetscCall(RGIntervalSetEndpoints(sub[i],ctx->a+i*h,(i==k-1)?ctx->b:ctx->a+(i+1)*h,ctx->c,ctx->d));
+    }
+  } else {
+    PetscCheck(ctx->c>-PETSC_MAX_REAL && ctx->d<PETSC_MAX_REAL,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"The interval must have finite endpoints in the imaginary axis");
+    h = (ctx->d-ctx->c)/k;
+    for (i=0;i<k;i++) {
+      PetscCall(RGSetType(sub[i],RGINTERVAL));
+      PetscCall(RGIntervalSetEndpoints(sub[i],ctx->a,ctx->b,ctx->c+i*h,(i==k-1)?ctx->d:ctx->c+(i+1)*h));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode RGIsAxisymmetric_Interval(RG rg,PetscBool vertical,PetscBool *symm)
 {
   RG_INTERVAL *ctx = (RG_INTERVAL*)rg->data;
@@ -361,7 +404,9 @@ SLEPC_EXTERN PetscErrorCode RGCreate_Interval(RG rg)
   rg->ops->computebbox       = RGComputeBoundingBox_Interval;
   rg->ops->computequadrature = RGComputeQuadrature_Interval;
   rg->ops->checkinside       = RGCheckInside_Interval;
+  rg->ops->checkinsidearray  = RGCheckInsideArray_Interval;
   rg->ops->isaxisymmetric    = RGIsAxisymmetric_Interval;
+  rg->ops->split             = RGSplit_Interval;
   rg->ops->setfromoptions    = RGSetFromOptions_Interval;
   rg->ops->view              = RGView_Interval;
   rg->ops->destroy           = RGDestroy_Interval;
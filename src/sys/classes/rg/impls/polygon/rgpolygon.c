@@ -19,6 +19,8 @@
 typedef struct {
   PetscInt    n;         /* number of vertices */
   PetscScalar *vr,*vi;   /* array of vertices (vi not used in complex scalars) */
+  PetscReal   x[VERTMAX],y[VERTMAX];  /* real and imaginary parts of the vertices */
+  PetscReal   xmin,xmax,ymin,ymax;    /* bounding box */
 } RG_POLYGON;
 
 static PetscErrorCode RGComputeBoundingBox_Polygon(RG,PetscReal*,PetscReal*,PetscReal*,PetscReal*);
@@ -74,6 +76,17 @@ static PetscErrorCode RGPolygonSetVertices_Polygon(RG rg,PetscInt n,PetscScalar
     ctx->vi[i] = vi[i];
 #endif
   }
+  /* precompute the data used in the inside test */
+  for (i=0;i<n;i++) {
+#if defined(PETSC_USE_COMPLEX)
+    ctx->x[i] = PetscRealPart(ctx->vr[i]);
+    ctx->y[i] = PetscImaginaryPart(ctx->vr[i]);
+#else
+    ctx->x[i] = ctx->vr[i];
+    ctx->y[i] = ctx->vi[i];
+#endif
+  }
+  PetscCall(RGComputeBoundingBox_Polygon(rg,&ctx->xmin,&ctx->xmax,&ctx->ymin,&ctx->ymax));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -355,24 +368,21 @@ static PetscErrorCode RGComputeBoundingBox_Polygon(RG rg,PetscReal *a,PetscReal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode RGCheckInside_Polygon(RG rg,PetscReal px,PetscReal py,PetscInt *inout)
+/*
+   Ray casting test for one point. Points outside the bounding box are
+   discarded first, for them all edges would be skipped in the loop
+*/
+static inline PetscInt RGPolygonCheckPoint_Private(RG_POLYGON *ctx,PetscReal px,PetscReal py)
 {
-  RG_POLYGON *ctx = (RG_POLYGON*)rg->data;
-  PetscReal  val,x[VERTMAX],y[VERTMAX];
-  PetscBool  mx,my,nx,ny;
-  PetscInt   i,j;
+  PetscReal val,x[VERTMAX],y[VERTMAX];
+  PetscBool mx,my,nx,ny;
+  PetscInt  i,j,inout=-1;
 
-  PetscFunctionBegin;
+  if (px<ctx->xmin || px>ctx->xmax || py<ctx->ymin || py>ctx->ymax) return -1;
   for (i=0;i<ctx->n;i++) {
-#if defined(PETSC_USE_COMPLEX)
-    x[i] = PetscRealPart(ctx->vr[i])-px;
-    y[i] = PetscImaginaryPart(ctx->vr[i])-py;
-#else
-    x[i] = ctx->vr[i]-px;
-    y[i] = ctx->vi[i]-py;
-#endif
+    x[i] = ctx->x[i]-px;
+    y[i] = ctx->y[i]-py;
   }
-  *inout = -1;
   for (i=0;i<ctx->n;i++) {
     j = (i+1)%ctx->n;
     mx = PetscNot(x[i]<0.0);
@@ -381,16 +391,125 @@ static PetscErrorCode RGCheckInside_Polygon(RG rg,PetscReal px,PetscReal py,Pets
     ny = PetscNot(y[j]<0.0);
     if (!((my||ny) && (mx||nx)) || (mx&&nx)) continue;
     if (((my && ny && (mx||nx)) && (!(mx&&nx)))) {
-      *inout = -*inout;
+      inout = -inout;
       continue;
     }
     val = (y[i]*x[j]-x[i]*y[j])/(x[j]-x[i]);
-    if (PetscAbs(val)<10*PETSC_MACHINE_EPSILON) {
-      *inout = 0;
-      PetscFunctionReturn(PETSC_SUCCESS);
-    } else if (val>0.0) *inout = -*inout;
+    if (PetscAbs(val)<10*PETSC_MACHINE_EPSILON) return 0;
+    else if (val>0.0) inout = -inout;
+  }
+  return inout;
+}
+
+static PetscErrorCode RGCheckInside_Polygon(RG rg,PetscReal px,PetscReal py,PetscInt *inout)
+{
+  RG_POLYGON *ctx = (RG_POLYGON*)rg->data;
+
+  PetscFunctionBegin;
+  *inout = RGPolygonCheckPoint_Private(ctx,px,py);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RGCheckInsideArray_Polygon(RG rg,PetscInt n,const PetscReal *px,const PetscReal *py,PetscInt *inout)
+{
+  RG_POLYGON *ctx = (RG_POLYGON*)rg->data;
+  PetscInt   i;
+
+  PetscFunctionBegin;
+  for (i=0;i<n;i++) inout[i] = RGPolygonCheckPoint_Private(ctx,px[i],py[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_USE_COMPLEX)
+/*
+   Clips the polygon (x,y) with the half-plane s*(X-x0)<=0 (Sutherland-Hodgman),
+   the result (cx,cy) may have up to 2*n vertices
+*/
+static void RGPolygonClip_Private(PetscInt n,const PetscReal *x,const PetscReal *y,PetscReal x0,PetscReal s,PetscInt *m,PetscReal *cx,PetscReal *cy)
+{
+  PetscInt  i,j;
+  PetscBool in,inj;
+
+  *m = 0;
+  for (i=0;i<n;i++) {
+    j   = (i+1)%n;
+    in  = (s*(x[i]-x0)<=0.0)? PETSC_TRUE: PETSC_FALSE;
+    inj = (s*(x[j]-x0)<=0.0)? PETSC_TRUE: PETSC_FALSE;
+    if (in) {
+      cx[*m] = x[i]; cy[*m] = y[i]; (*m)++;
+    }
+    if (in != inj) {
+      cx[*m] = x0; cy[*m] = y[i]+(x0-x[i])*(y[j]-y[i])/(x[j]-x[i]); (*m)++;
+    }
+  }
+}
+
+/*
+   Vertical strip x0<=X<=x1 of the polygon, without repeated consecutive vertices
+*/
+static void RGPolygonStrip_Private(RG_POLYGON *ctx,PetscReal x0,PetscReal x1,PetscInt *m,PetscReal *cx,PetscReal *cy)
+{
+  PetscReal tx[2*VERTMAX],ty[2*VERTMAX];
+  PetscInt  i,j,nt;
+
+  RGPolygonClip_Private(ctx->n,ctx->x,ctx->y,x1,1.0,&nt,tx,ty);
+  RGPolygonClip_Private(nt,tx,ty,x0,-1.0,m,cx,cy);
+  for (i=0,j=0;i<*m;i++) {
+    if (j && cx[i]==cx[j-1] && cy[i]==cy[j-1]) continue;
+    cx[j] = cx[i]; cy[j] = cy[i]; j++;
+  }
+  if (j>1 && cx[j-1]==cx[0] && cy[j-1]==cy[0]) j--;
+  *m = j;
+}
+
+static PetscReal RGPolygonArea_Private(PetscInt n,const PetscReal *x,const PetscReal *y)
+{
+  PetscInt  i;
+  PetscReal a=0.0;
+
+  for (i=0;i<n;i++) a += x[i]*y[(i+1)%n]-x[(i+1)%n]*y[i];
+  return PetscAbsReal(a)/2.0;
+}
+#endif
+
+/*
+   Vertical strips of the same area, with the cuts computed by bisection
+*/
+static PetscErrorCode RGSplit_Polygon(RG rg,PetscInt k,RG *sub)
+{
+#if defined(PETSC_USE_COMPLEX)
+  RG_POLYGON  *ctx = (RG_POLYGON*)rg->data;
+  PetscReal   cx[4*VERTMAX],cy[4*VERTMAX],area,lo,hi,xm,x0,x1;
+  PetscScalar vr[VERTMAX];
+  PetscInt    i,j,it,m;
+
+  PetscFunctionBegin;
+  area = RGPolygonArea_Private(ctx->n,ctx->x,ctx->y);
+  x0 = ctx->xmin;
+  for (i=0;i<k;i++) {
+    if (i==k-1) x1 = ctx->xmax;
+    else {
+      lo = x0; hi = ctx->xmax;
+      for (it=0;it<100 && hi-lo>PETSC_MACHINE_EPSILON*(ctx->xmax-ctx->xmin);it++) {
+        xm = (lo+hi)/2.0;
+        RGPolygonStrip_Private(ctx,ctx->xmin,xm,&m,cx,cy);
+        if (RGPolygonArea_Private(m,cx,cy)<(i+1)*area/k) lo = xm;
+        else hi = xm;
+      }
+      x1 = (lo+hi)/2.0;
+    }
+    RGPolygonStrip_Private(ctx,x0,x1,&m,cx,cy);
+    PetscCheck(m>2 && m<=VERTMAX,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"Subregion %" PetscInt_FMT " has %" PetscInt_FMT " vertices, use a different number of subregions",i,m);
+    for (j=0;j<m;j++) vr[j] = PetscCMPLX(cx[j],cy[j]);
+    PetscCall(RGSetType(sub[i],RGPOLYGON));
+    PetscCall(RGPolygonSetVertices(sub[i],m,vr,NULL));
+    x0 = x1;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
+#else
+  PetscFunctionBegin;
+  SETERRQ(PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"Splitting a polygon requires complex scalars");
+#endif
 }
 
 static PetscErrorCode RGSetFromOptions_Polygon(RG rg,PetscOptionItems *PetscOptionsObject)
@@ -448,13 +567,15 @@ SLEPC_EXTERN PetscErrorCode RGCreate_Polygon(RG rg)
   PetscCall(PetscNew(&polygon));
   rg->data = (void*)polygon;
 
-  rg->ops->istrivial      = RGIsTrivial_Polygon;
-  rg->ops->computecontour = RGComputeContour_Polygon;
-  rg->ops->computebbox    = RGComputeBoundingBox_Polygon;
-  rg->ops->checkinside    = RGCheckInside_Polygon;
-  rg->ops->setfromoptions = RGSetFromOptions_Polygon;
-  rg->ops->view           = RGView_Polygon;
-  rg->ops->destroy        = RGDestroy_Polygon;
+  rg->ops->istrivial        = RGIsTrivial_Polygon;
+  rg->ops->computecontour   = RGComputeContour_Polygon;
+  rg->ops->computebbox      = RGComputeBoundingBox_Polygon;
+  rg->ops->checkinside      = RGCheckInside_Polygon;
+  rg->ops->checkinsidearray = RGCheckInsideArray_Polygon;
+  rg->ops->split            = RGSplit_Polygon;
+  rg->ops->setfromoptions   = RGSetFromOptions_Polygon;
+  rg->ops->view             = RGView_Polygon;
+  rg->ops->destroy          = RGDestroy_Polygon;
   PetscCall(PetscObjectComposeFunction((PetscObject)rg,"RGPolygonSetVertices_C",RGPolygonSetVertices_Polygon));
   PetscCall(PetscObjectComposeFunction((PetscObject)rg,"RGPolygonGetVertices_C",RGPolygonGetVertices_Polygon));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -327,6 +327,37 @@ static PetscErrorCode RGComputeQuadrature_Ring(RG rg,RGQuadRule quad,PetscInt n,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Angle test for a point (px,py) that lies between the two ellipses;
+   inside is set to -1 if the point is outside the sector
+*/
+static inline void RGRingCheckAngle_Private(RG_RING *ctx,PetscReal px,PetscReal py,PetscInt *inside)
+{
+  PetscReal dx,dy,r;
+
+#if defined(PETSC_USE_COMPLEX)
+  dx = (px-PetscRealPart(ctx->center));
+  dy = (py-PetscImaginaryPart(ctx->center));
+#else
+  dx = px-ctx->center;
+  dy = py;
+#endif
+  if (dx == 0) {
+    if (dy == 0) r = -1;
+    else if (dy > 0) r = 0.25;
+    else r = 0.75;
+  } else if (dx > 0) {
+    r = PetscAtanReal((dy/ctx->vscale)/dx);
+    if (dy >= 0) r /= 2*PETSC_PI;
+    else r = r/(2*PETSC_PI)+1;
+  } else r = PetscAtanReal((dy/ctx->vscale)/dx)/(2*PETSC_PI)+0.5;
+  if (ctx->start_ang>ctx->end_ang) {
+    if (r>ctx->end_ang && r<ctx->start_ang) *inside = -1;
+  } else {
+    if (r<ctx->start_ang || r>ctx->end_ang) *inside = -1;
+  }
+}
+
 static PetscErrorCode RGCheckInside_Ring(RG rg,PetscReal px,PetscReal py,PetscInt *inside)
 {
   RG_RING   *ctx = (RG_RING*)rg->data;
@@ -353,29 +384,73 @@ static PetscErrorCode RGCheckInside_Ring(RG rg,PetscReal px,PetscReal py,PetscIn
 #endif
   r = -1.0+dx*dx+(dy*dy)/(ctx->vscale*ctx->vscale);
   *inside *= PetscSign(r);
-  if (*inside == 1) {  /* check angles */
+  if (*inside == 1) RGRingCheckAngle_Private(ctx,px,py,inside);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The tests against the two ellipses are done in a first loop without branches,
+   and the angles are computed only for the points that lie between the ellipses
+*/
+static PetscErrorCode RGCheckInsideArray_Ring(RG rg,PetscInt n,const PetscReal *px,const PetscReal *py,PetscInt *inside)
+{
+  RG_RING   *ctx = (RG_RING*)rg->data;
+  PetscReal dx,dy,r,cx,cy,ro,ri,vs2;
+  PetscInt  i;
+
+  PetscFunctionBegin;
+  cx  = PetscRealPart(ctx->center);
+  cy  = PetscImaginaryPart(ctx->center);
+  ro  = ctx->radius+ctx->width/2.0;
+  ri  = ctx->radius-ctx->width/2.0;
+  vs2 = ctx->vscale*ctx->vscale;
+  for (i=0;i<n;i++) {
+    dx = (px[i]-cx)/ro;
+    dy = (py[i]-cy)/ro;
+    r  = 1.0-dx*dx-(dy*dy)/vs2;
+    inside[i] = PetscSign(r);
+    dx = (px[i]-cx)/ri;
+    dy = (py[i]-cy)/ri;
+    r  = -1.0+dx*dx+(dy*dy)/vs2;
+    inside[i] *= PetscSign(r);
+  }
+  for (i=0;i<n;i++) if (inside[i] == 1) RGRingCheckAngle_Private(ctx,px[i],py[i],inside+i);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode RGSplit_Ring(RG rg,PetscInt k,RG *sub)
+{
+  RG_RING   *ctx = (RG_RING*)rg->data;
+  PetscInt  i;
 #if defined(PETSC_USE_COMPLEX)
-    dx = (px-PetscRealPart(ctx->center));
-    dy = (py-PetscImaginaryPart(ctx->center));
+  PetscReal span,a0,a1;
 #else
-    dx = px-ctx->center;
-    dy = py;
+  PetscReal ri,ro,r0,r1;
 #endif
-    if (dx == 0) {
-      if (dy == 0) r = -1;
-      else if (dy > 0) r = 0.25;
-      else r = 0.75;
-    } else if (dx > 0) {
-      r = PetscAtanReal((dy/ctx->vscale)/dx);
-      if (dy >= 0) r /= 2*PETSC_PI;
-      else r = r/(2*PETSC_PI)+1;
-    } else r = PetscAtanReal((dy/ctx->vscale)/dx)/(2*PETSC_PI)+0.5;
-    if (ctx->start_ang>ctx->end_ang) {
-      if (r>ctx->end_ang && r<ctx->start_ang) *inside = -1;
-    } else {
-      if (r<ctx->start_ang || r>ctx->end_ang) *inside = -1;
-    }
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_COMPLEX)
+  span = ctx->end_ang-ctx->start_ang;
+  if (span<0.0) span += 1.0;  /* the ring crosses over the zero angle */
+  for (i=0;i<k;i++) {
+    a0 = ctx->start_ang+i*span/k;
+    a1 = (i==k-1)? ctx->end_ang: ctx->start_ang+(i+1)*span/k;
+    if (a0>1.0) a0 -= 1.0;
+    if (a1>1.0) a1 -= 1.0;
+    PetscCall(RGSetType(sub[i],RGRING));
+    PetscCall(RGRingSetParameters(sub[i],ctx->center,ctx->radius,ctx->vscale,a0,a1,ctx->width));
+  }
+#else
+  /* concentric rings whose radii squared are equispaced, to have the same area */
+  ri = ctx->radius-ctx->width/2.0;
+  ro = ctx->radius+ctx->width/2.0;
+  for (i=0;i<k;i++) {
+    r0 = (i==0)? ri: PetscSqrtReal(ri*ri+i*(ro*ro-ri*ri)/k);
+    r1 = (i==k-1)? ro: PetscSqrtReal(ri*ri+(i+1)*(ro*ro-ri*ri)/k);
+    PetscCall(RGSetType(sub[i],RGRING));
+    PetscCall(RGRingSetParameters(sub[i],ctx->center,(r0+r1)/2.0,ctx->vscale,ctx->start_ang,ctx->end_ang,r1-r0));
   }
+#endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -439,7 +514,9 @@ SLEPC_EXTERN PetscErrorCode RGCreate_Ring(RG rg)
   rg->ops->computebbox       = RGComputeBoundingBox_Ring;
   rg->ops->computequadrature = RGComputeQuadrature_Ring;
   rg->ops->checkinside       = RGCheckInside_Ring;
+  rg->ops->checkinsidearray  = RGCheckInsideArray_Ring;
   rg->ops->isaxisymmetric    = RGIsAxisymmetric_Ring;
+  rg->ops->split             = RGSplit_Ring;
   rg->ops->setfromoptions    = RGSetFromOptions_Ring;
   rg->ops->view              = RGView_Ring;
   rg->ops->destroy           = RGDestroy_Ring;
@@ -402,13 +402,17 @@ PetscErrorCode RGIsTrivial(RG rg,PetscBool *trivial)
 
    If a scaling factor was set, the points are scaled before checking.
 
+   All points are checked in a single call to the implementation when the
+   region type provides it, so it is preferable to check many points at once
+   rather than calling this function for each point.
+
    Level: intermediate
 
 .seealso: RGSetScale(), RGSetComplement()
 @*/
 PetscErrorCode RGCheckInside(RG rg,PetscInt n,PetscScalar *ar,PetscScalar *ai,PetscInt *inside)
 {
-  PetscReal      px,py;
+  PetscReal      px,py,*x,*y;
   PetscInt       i;
 
   PetscFunctionBegin;
@@ -420,6 +424,33 @@ PetscErrorCode RGCheckInside(RG rg,PetscInt n,PetscScalar *ar,PetscScalar *ai,Pe
 #endif
   PetscAssertPointer(inside,5);
 
+  if (rg->ops->checkinsidearray) {
+    if (rg->lwork<2*n) {
+      PetscCall(PetscFree(rg->work));
+      PetscCall(PetscMalloc1(2*n,&rg->work));
+      rg->lwork = 2*n;
+    }
+    x = rg->work;
+    y = rg->work+n;
+    for (i=0;i<n;i++) {
+#if defined(PETSC_USE_COMPLEX)
+      x[i] = PetscRealPart(ar[i]);
+      y[i] = PetscImaginaryPart(ar[i]);
+#else
+      x[i] = ar[i];
+      y[i] = ai[i];
+#endif
+    }
+    if (PetscUnlikely(rg->sfactor != 1.0)) {
+      for (i=0;i<n;i++) {
+        x[i] /= rg->sfactor;
+        y[i] /= rg->sfactor;
+      }
+    }
+    PetscUseTypeMethod(rg,checkinsidearray,n,x,y,inside);
+    if (PetscUnlikely(rg->complement)) for (i=0;i<n;i++) inside[i] = -inside[i];
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   for (i=0;i<n;i++) {
 #if defined(PETSC_USE_COMPLEX)
     px = PetscRealPart(ar[i]);
@@ -649,6 +680,59 @@ PetscErrorCode RGComputeQuadrature(RG rg,RGQuadRule quad,PetscInt n,PetscScalar
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   RGSplit - Divides the region into a number of subregions of the same area.
+
+   Collective
+
+   Input Parameters:
++  rg - the region context
+-  k  - number of subregions
+
+   Output Parameter:
+.  sub - array of k subregions
+
+   Notes:
+   The array sub must be allocated by the caller, and the subregions are created
+   by this function, with the same scale factor as rg. They must be destroyed with
+   RGDestroy() by the caller. The union of the subregions is the region rg, and
+   two subregions can only intersect on their boundaries.
+
+   An interval is split along its longer side (the horizontal one in real scalars).
+   An ellipse is split into a smaller ellipse with the same center and k-1 sectors
+   of the ring that surrounds it, and a ring is split into k sectors; in real scalars,
+   where regions must be symmetric with respect to the real axis, concentric rings
+   are used instead of sectors. A polygon is split into vertical strips, in complex
+   scalars only.
+
+   The subregions can be used to run independent contour integral eigensolvers on
+   subcommunicators. The area is only a proxy for the number of eigenvalues in each
+   subregion, so the eigenvalue counts may be unbalanced.
+
+   Level: advanced
+
+.seealso: RGCreate(), RGDestroy()
+@*/
+PetscErrorCode RGSplit(RG rg,PetscInt k,RG sub[])
+{
+  PetscInt  i;
+  PetscBool trivial;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(rg,RG_CLASSID,1);
+  PetscValidType(rg,1);
+  PetscValidLogicalCollectiveInt(rg,k,2);
+  PetscAssertPointer(sub,3);
+  PetscCheck(k>0,PetscObjectComm((PetscObject)rg),PETSC_ERR_ARG_OUTOFRANGE,"The number of subregions must be > 0");
+  PetscCheck(!rg->complement,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"Cannot split a region with the complement flag set");
+  PetscCall(RGIsTrivial(rg,&trivial));
+  PetscCheck(!trivial,PetscObjectComm((PetscObject)rg),PETSC_ERR_SUP,"Cannot split a trivial region");
+  for (i=0;i<k;i++) PetscCall(RGCreate(PetscObjectComm((PetscObject)rg),&sub[i]));
+  PetscUseTypeMethod(rg,split,k,sub);
+  for (i=0;i<k;i++) PetscCall(RGSetScale(sub[i],rg->sfactor));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    RGSetComplement - Sets a flag to indicate that the region is the complement
    of the specified one.
@@ -825,6 +909,7 @@ PetscErrorCode RGDestroy(RG *rg)
   PetscValidHeaderSpecific(*rg,RG_CLASSID,1);
   if (--((PetscObject)*rg)->refct > 0) { *rg = NULL; PetscFunctionReturn(PETSC_SUCCESS); }
   PetscTryTypeMethod(*rg,destroy);
+  PetscCall(PetscFree((*rg)->work));
   PetscCall(PetscHeaderDestroy(rg));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -0,0 +1,84 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test RGSplit().\n\n"
+  "The command line options are:\n"
+  "  -k <k>, where <k> = number of subregions.\n\n";
+
+#include <slepcrg.h>
+
+#define NGRID 41
+
+int main(int argc,char **argv)
+{
+  RG          rg,sub[8];
+  PetscInt    i,j,l,k=4,inside,in,nin,nbd,nerr=0;
+  PetscReal   a,b,c,d,re,im;
+  PetscScalar ar,ai=0.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL));
+  PetscCheck(k>0 && k<=8,PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"The number of subregions must be between 1 and 8");
+  PetscCall(RGCreate(PETSC_COMM_WORLD,&rg));
+  PetscCall(RGSetType(rg,RGELLIPSE));
+  PetscCall(RGEllipseSetParameters(rg,1.0,2.0,0.5));
+  PetscCall(RGSetFromOptions(rg));
+  PetscCall(RGSplit(rg,k,sub));
+
+  /* every point of a grid strictly inside the region must be in one subregion, and no point outside */
+  PetscCall(RGComputeBoundingBox(rg,&a,&b,&c,&d));
+  for (i=0;i<NGRID;i++) {
+    for (j=0;j<NGRID;j++) {
+      re = a-0.05*(b-a)+1.1*(b-a)*(i+0.5)/NGRID;
+      im = c-0.05*(d-c)+1.1*(d-c)*(j+0.5)/NGRID;
+#if defined(PETSC_USE_COMPLEX)
+      ar = PetscCMPLX(re,im);
+#else
+      ar = re; ai = im;
+#endif
+      PetscCall(RGCheckInside(rg,1,&ar,&ai,&inside));
+      nin = 0; nbd = 0;
+      for (l=0;l<k;l++) {
+        PetscCall(RGCheckInside(sub[l],1,&ar,&ai,&in));
+        if (in>0) nin++;
+        else if (!in) nbd++;
+      }
+      if (inside>0 && (nin>1 || nin+nbd==0)) nerr++;
+      if (inside<0 && nin) nerr++;
+    }
+  }
+  if (!nerr) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Split into %" PetscInt_FMT " subregions: all points are in the correct subregions\n",k));
+  else PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Split into %" PetscInt_FMT " subregions: %" PetscInt_FMT " points are in a wrong subregion\n",k,nerr));
+
+  for (l=0;l<k;l++) PetscCall(RGDestroy(&sub[l]));
+  PetscCall(RGDestroy(&rg));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test4_1.out
+      test:
+         suffix: 1_ellipse
+      test:
+         suffix: 1_interval
+         args: -rg_type interval -rg_interval_endpoints -1,3,-.5,.5
+      test:
+         suffix: 1_ring
+         args: -rg_type ring -rg_ring_center 1 -rg_ring_radius 2 -rg_ring_width 0.4
+      test:
+         suffix: 1_polygon
+         args: -rg_type polygon -rg_polygon_vertices 0,2+1i,3,1.5-1i,1-0.5i
+         requires: complex
+
+TEST*/
@@ -0,0 +1,209 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   Damped Chebyshev polynomial filter. The filter is the Chebyshev expansion of
+   the indicator function of the wanted interval, with the coefficients damped
+   to eliminate the Gibbs oscillations.
+
+   References:
+
+       [1] E. Di Napoli, E. Polizzi, Y. Saad, "Efficient estimation of eigenvalue
+           counts in an interval", Numer. Linear Algebra Appl. 23(4):674-692, 2016.
+
+       [2] A. Pieper et al., "High-performance implementation of Chebyshev filter
+           diagonalization for interior eigenvalue computations", J. Comput. Phys.
+           325:226-243, 2016.
+*/
+
+#include <slepc/private/stimpl.h>
+#include "filter.h"
+
+/*
+   Damping factor of the k-th coefficient for a polynomial of degree deg
+*/
+static PetscReal STFilter_Chebyshev_Damping(STFilterDamping damping,PetscInt k,PetscInt deg)
+{
+  PetscReal a,t;
+
+  switch (damping) {
+    case STFILTER_DAMPING_JACKSON:
+      a = PETSC_PI/(deg+2);
+      return ((1.0-(PetscReal)k/(deg+2))*PetscSinReal(a)*PetscCosReal(k*a)+PetscCosReal(a)*PetscSinReal(k*a)/(deg+2))/PetscSinReal(a);
+    case STFILTER_DAMPING_LANCZOS:
+      if (!k) return 1.0;
+      t = k*PETSC_PI/(deg+1);
+      return PetscSinReal(t)/t;
+    case STFILTER_DAMPING_FEJER:
+      return 1.0-(PetscReal)k/(deg+1);
+    default:
+      return 1.0;
+  }
+}
+
+/*
+   Evaluates the filter at a point t of [-1,1]
+*/
+static PetscReal STFilter_Chebyshev_Eval(ST_FILTER *ctx,PetscReal t)
+{
+  PetscInt  k;
+  PetscReal t0=1.0,t1=t,t2,p;
+
+  p = ctx->coeffs[0];
+  if (ctx->ncoeffs>1) p += ctx->coeffs[1]*t1;
+  for (k=2;k<ctx->ncoeffs;k++) {
+    t2 = 2.0*t*t1-t0;
+    p += ctx->coeffs[k]*t2;
+    t0 = t1; t1 = t2;
+  }
+  return p;
+}
+
+/*
+   y = p(A)*x with the three-term recurrence of Chebyshev polynomials
+   T_{k+1}(S) = 2*S*T_k(S) - T_{k-1}(S), with S = (A-center*I)/halfwidth
+*/
+static PetscErrorCode MatMult_Chebyshev(Mat G,Vec x,Vec y)
+{
+  ST          st;
+  ST_FILTER   *ctx;
+  Vec         t0,t1,t2,aux;
+  PetscInt    k;
+  PetscReal   c,e;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(G,&st));
+  ctx = (ST_FILTER*)st->data;
+  c = ctx->center; e = ctx->halfwidth;
+  t0 = st->work[0]; t1 = st->work[1]; t2 = st->work[2];
+  PetscCall(VecCopy(x,t0));
+  PetscCall(VecCopy(x,y));
+  PetscCall(VecScale(y,ctx->coeffs[0]));
+  if (ctx->ncoeffs>1) {
+    PetscCall(MatMult(ctx->T,x,t1));
+    PetscCall(VecAXPBY(t1,-c/e,1.0/e,x));
+    PetscCall(VecAXPY(y,ctx->coeffs[1],t1));
+  }
+  for (k=2;k<ctx->ncoeffs;k++) {
+    PetscCall(MatMult(ctx->T,t1,t2));
+    PetscCall(VecAXPBYPCZ(t2,-2.0*c/e,-1.0,2.0/e,t1,t0));
+    PetscCall(VecAXPY(y,ctx->coeffs[k],t2));
+    aux = t0; t0 = t1; t1 = t2; t2 = aux;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Block version of MatMult_Chebyshev, with one MatMatMult() per degree
+*/
+static PetscErrorCode MatMatMult_Chebyshev(Mat G,Mat B,Mat C,void *pctx)
+{
+  ST          st;
+  ST_FILTER   *ctx;
+  Mat         T0,T1,T2,aux;
+  PetscInt    i,k,m1,m2;
+  PetscReal   c,e;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(G,&st));
+  ctx = (ST_FILTER*)st->data;
+  c = ctx->center; e = ctx->halfwidth;
+  if (ctx->nW) {  /* check if work matrices must be resized */
+    PetscCall(MatGetSize(B,NULL,&m1));
+    PetscCall(MatGetSize(ctx->W[0],NULL,&m2));
+    if (m1!=m2) {
+      PetscCall(MatDestroyMatrices(ctx->nW,&ctx->W));
+      ctx->nW = 0;
+    }
+  }
+  if (!ctx->nW) {  /* allocate work matrices */
+    ctx->nW = 4;
+    PetscCall(PetscMalloc1(ctx->nW,&ctx->W));
+    for (i=0;i<ctx->nW;i++) PetscCall(MatDuplicate(B,MAT_DO_NOT_COPY_VALUES,&ctx->W[i]));
+  }
+  T0 = ctx->W[0]; T1 = ctx->W[1]; T2 = ctx->W[2];
+  PetscCall(MatCopy(B,T0,SAME_NONZERO_PATTERN));
+  PetscCall(MatCopy(B,C,SAME_NONZERO_PATTERN));
+  PetscCall(MatScale(C,ctx->coeffs[0]));
+  if (ctx->ncoeffs>1) {
+    PetscCall(MatMatMult(ctx->T,B,MAT_REUSE_MATRIX,PETSC_DEFAULT,&T1));
+    PetscCall(MatScale(T1,1.0/e));
+    PetscCall(MatAXPY(T1,-c/e,B,SAME_NONZERO_PATTERN));
+    PetscCall(MatAXPY(C,ctx->coeffs[1],T1,SAME_NONZERO_PATTERN));
+  }
+  for (k=2;k<ctx->ncoeffs;k++) {
+    PetscCall(MatMatMult(ctx->T,T1,MAT_REUSE_MATRIX,PETSC_DEFAULT,&T2));
+    PetscCall(MatScale(T2,2.0/e));
+    PetscCall(MatAXPY(T2,-2.0*c/e,T1,SAME_NONZERO_PATTERN));
+    PetscCall(MatAXPY(T2,-1.0,T0,SAME_NONZERO_PATTERN));
+    PetscCall(MatAXPY(C,ctx->coeffs[k],T2,SAME_NONZERO_PATTERN));
+    aux = T0; T0 = T1; T1 = T2; T2 = aux;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the damped Chebyshev coefficients of the indicator function of the
+   wanted interval, mapped to [-1,1]. If the degree has not been set by the user,
+   it is estimated from the width of the interval relative to the numerical range,
+   so that the transition regions of the damped filter are about a quarter of
+   the interval width (measured in the angular variable, theta=acos(t)).
+   G is a shell matrix whose MatMult() applies the filter.
+*/
+PetscErrorCode STFilter_Chebyshev_setFilter(ST st,Mat *G)
+{
+  ST_FILTER      *ctx = (ST_FILTER*)st->data;
+  PetscInt       k,deg,n,m,N,M;
+  PetscReal      a,b,tha,thb,ylim=PETSC_MAX_REAL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectReference((PetscObject)st->A[0]));
+  PetscCall(MatDestroy(&ctx->T));
+  ctx->T = st->A[0];
+  ctx->center    = (ctx->left+ctx->right)/2.0;
+  ctx->halfwidth = (ctx->right-ctx->left)/2.0;
+  a = (ctx->inta>ctx->left)? (ctx->inta-ctx->center)/ctx->halfwidth: -1.0;
+  b = (ctx->intb<ctx->right)? (ctx->intb-ctx->center)/ctx->halfwidth: 1.0;
+  tha = PetscAcosReal(PetscMax(a,-1.0));
+  thb = PetscAcosReal(PetscMin(b,1.0));
+
+  if (ctx->polyDegree) deg = ctx->polyDegree;
+  else {
+    deg = (PetscInt)PetscCeilReal(8.0*PETSC_PI/(tha-thb));
+    deg = PetscMin(PetscMax(deg,10),1000);
+    PetscCall(PetscInfo(st,"Estimated degree of the Chebyshev filter = %" PetscInt_FMT "\n",deg));
+  }
+  if (ctx->ncoeffs!=deg+1) {
+    PetscCall(PetscFree(ctx->coeffs));
+    PetscCall(PetscMalloc1(deg+1,&ctx->coeffs));
+    ctx->ncoeffs = deg+1;
+  }
+  ctx->coeffs[0] = (tha-thb)/PETSC_PI;
+  for (k=1;k<=deg;k++) ctx->coeffs[k] = 2.0*(PetscSinReal(k*tha)-PetscSinReal(k*thb))/(k*PETSC_PI);
+  for (k=0;k<=deg;k++) ctx->coeffs[k] *= STFilter_Chebyshev_Damping(ctx->damping,k,deg);
+
+  /* the threshold is the value of the filter at the (finite) ends of the interval */
+  if (a>-1.0) ylim = STFilter_Chebyshev_Eval(ctx,a);
+  if (b<1.0) ylim = PetscMin(ylim,STFilter_Chebyshev_Eval(ctx,b));
+  ctx->filterInfo->yLimit = ylim;
+  PetscCall(PetscInfo(st,"Computed value of yLimit = %g\n",(double)ylim));
+  ctx->filtch = PETSC_FALSE;
+
+  /* create shell matrix*/
+  if (!*G) {
+    PetscCall(MatGetSize(ctx->T,&N,&M));
+    PetscCall(MatGetLocalSize(ctx->T,&n,&m));
+    PetscCall(MatCreateShell(PetscObjectComm((PetscObject)st),n,m,N,M,st,G));
+    PetscCall(MatShellSetOperation(*G,MATOP_MULT,(void(*)(void))MatMult_Chebyshev));
+    PetscCall(MatShellSetMatProductOperation(*G,MATPRODUCT_AB,NULL,MatMatMult_Chebyshev,NULL,MATDENSE,MATDENSE));
+    PetscCall(MatShellSetMatProductOperation(*G,MATPRODUCT_AB,NULL,MatMatMult_Chebyshev,NULL,MATDENSECUDA,MATDENSECUDA));
+    PetscCall(MatShellSetMatProductOperation(*G,MATPRODUCT_AB,NULL,MatMatMult_Chebyshev,NULL,MATDENSEHIP,MATDENSEHIP));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
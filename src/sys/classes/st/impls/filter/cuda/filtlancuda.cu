@@ -0,0 +1,47 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+/*
+   Polynomial filter (CUDA kernels)
+*/
+#include <slepc/private/stimpl.h>
+#include "../src/sys/classes/st/impls/filter/filter.h"
+
+__global__ void filtlan_fusedupdate_kernel(PetscInt n,PetscBool first,PetscBool last,PetscScalar bprev,PetscScalar alp,PetscScalar alp0,PetscScalar bet,PetscScalar *x,PetscScalar *r,PetscScalar *p,PetscScalar *ap,const PetscScalar *w,PetscInt xcount)
+{
+  PetscInt k;
+  k = xcount*gridDim.x*blockDim.x+blockIdx.x*blockDim.x+threadIdx.x;
+
+  if (k<n) {
+    x[k] += alp*p[k];
+    if (!last) {
+      if (!first) ap[k] = w[k]+bprev*ap[k];
+      r[k] -= alp0*ap[k];
+      p[k]  = r[k]+bet*p[k];
+    }
+  }
+}
+
+/*
+   GPU version of FILTLAN_FusedUpdate_Host, all arrays are device pointers
+*/
+__host__ PetscErrorCode FILTLAN_FusedUpdate_CUDA(PetscInt n,PetscBool first,PetscBool last,PetscScalar bprev,PetscScalar alp,PetscScalar alp0,PetscScalar bet,PetscScalar *x,PetscScalar *r,PetscScalar *p,PetscScalar *ap,const PetscScalar *w)
+{
+  PetscInt i,dimGrid_xcount;
+  dim3     blocks3d,threads3d;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(SlepcKernelSetGrid1D(n,&blocks3d,&threads3d,&dimGrid_xcount));
+  for (i=0;i<dimGrid_xcount;i++) {
+    filtlan_fusedupdate_kernel<<<blocks3d,threads3d>>>(n,first,last,bprev,alp,alp0,bet,x,r,p,ap,w,i);
+    PetscCallCUDA(cudaGetLastError());
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -28,12 +28,15 @@ static PetscErrorCode STComputeOperator_Filter(ST st)
   PetscCheck(ctx->intb<PETSC_MAX_REAL || ctx->inta>PETSC_MIN_REAL,PetscObjectComm((PetscObject)st),PETSC_ERR_ORDER,"Must pass an interval with STFilterSetInterval()");
   PetscCheck(ctx->right!=0.0 || ctx->left!=0.0,PetscObjectComm((PetscObject)st),PETSC_ERR_ORDER,"Must pass an approximate numerical range with STFilterSetRange()");
   PetscCheck(ctx->left<=ctx->inta && ctx->right>=ctx->intb,PetscObjectComm((PetscObject)st),PETSC_ERR_USER_INPUT,"The requested interval [%g,%g] must be contained in the numerical range [%g,%g]",(double)ctx->inta,(double)ctx->intb,(double)ctx->left,(double)ctx->right);
-  if (!ctx->polyDegree) ctx->polyDegree = 100;
-  ctx->frame[0] = ctx->left;
-  ctx->frame[1] = ctx->inta;
-  ctx->frame[2] = ctx->intb;
-  ctx->frame[3] = ctx->right;
-  PetscCall(STFilter_FILTLAN_setFilter(st,&st->T[0]));
+  if (ctx->type==STFILTER_CHEBYSHEV) PetscCall(STFilter_Chebyshev_setFilter(st,&st->T[0]));
+  else {
+    if (!ctx->polyDegree) ctx->polyDegree = 100;
+    ctx->frame[0] = ctx->left;
+    ctx->frame[1] = ctx->inta;
+    ctx->frame[2] = ctx->intb;
+    ctx->frame[3] = ctx->right;
+    PetscCall(STFilter_FILTLAN_setFilter(st,&st->T[0]));
+  }
   st->M = st->T[0];
   PetscCall(MatDestroy(&st->P));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -48,13 +51,21 @@ static PetscErrorCode STSetUp_Filter(ST st)
 
 static PetscErrorCode STSetFromOptions_Filter(ST st,PetscOptionItems *PetscOptionsObject)
 {
-  PetscReal array[2]={0,0};
-  PetscInt  k;
-  PetscBool flg;
+  PetscReal       array[2]={0,0};
+  PetscInt        k;
+  PetscBool       flg;
+  STFilterType    type;
+  STFilterDamping damping;
+  ST_FILTER       *ctx = (ST_FILTER*)st->data;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject,"ST Filter Options");
 
+    PetscCall(PetscOptionsEnum("-st_filter_type","How to construct the filter","STFilterSetType",STFilterTypes,(PetscEnum)ctx->type,(PetscEnum*)&type,&flg));
+    if (flg) PetscCall(STFilterSetType(st,type));
+    PetscCall(PetscOptionsEnum("-st_filter_damping","Damping of the Chebyshev filter","STFilterSetDamping",STFilterDampings,(PetscEnum)ctx->damping,(PetscEnum*)&damping,&flg));
+    if (flg) PetscCall(STFilterSetDamping(st,damping));
+
     k = 2;
     PetscCall(PetscOptionsRealArray("-st_filter_interval","Interval containing the desired eigenvalues (two real values separated with a comma without spaces)","STFilterSetInterval",array,&k,&flg));
     if (flg) {
@@ -74,6 +85,176 @@ static PetscErrorCode STSetFromOptions_Filter(ST st,PetscOptionItems *PetscOptio
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode STFilterSetType_Filter(ST st,STFilterType type)
+{
+  ST_FILTER *ctx = (ST_FILTER*)st->data;
+
+  PetscFunctionBegin;
+  if (ctx->type != type) {
+    ctx->type   = type;
+    st->state   = ST_STATE_INITIAL;
+    st->opready = PETSC_FALSE;
+    ctx->filtch = PETSC_TRUE;
+    if (st->T) PetscCall(MatDestroy(&st->T[0]));  /* the shell matrix of the filter depends on the type */
+    st->M = NULL;
+    PetscCall(MatDestroyMatrices(ctx->nW,&ctx->W));
+    ctx->nW = 0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STFilterSetType - Sets the method to be used to build the polynomial filter.
+
+   Logically Collective
+
+   Input Parameters:
++  st   - the spectral transformation context
+-  type - the type of filter
+
+   Options Database Key:
+.  -st_filter_type <type> - set the type of filter, either 'filtlan' or 'chebyshev'
+
+   Notes:
+   The default is STFILTER_FILTLAN, the filtered Lanczos polynomial filter, which is
+   the least-squares approximation of a piecewise polynomial base filter, evaluated
+   with a Newton-like basis.
+
+   STFILTER_CHEBYSHEV is the Chebyshev expansion of the indicator function of the
+   interval, with damped coefficients (see STFilterSetDamping()). It is cheaper to
+   build and to apply, since it only needs the three-term Chebyshev recurrence, with
+   one MatMult() (or one MatMatMult() in block eigensolvers) per degree. If the degree
+   is not set with STFilterSetDegree(), it is estimated from the width of the interval
+   relative to the numerical range.
+
+   Level: intermediate
+
+.seealso: STFilterGetType(), STFilterSetDamping(), STFilterSetDegree()
+@*/
+PetscErrorCode STFilterSetType(ST st,STFilterType type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(st,type,2);
+  PetscTryMethod(st,"STFilterSetType_C",(ST,STFilterType),(st,type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STFilterGetType_Filter(ST st,STFilterType *type)
+{
+  ST_FILTER *ctx = (ST_FILTER*)st->data;
+
+  PetscFunctionBegin;
+  *type = ctx->type;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STFilterGetType - Gets the method used to build the polynomial filter.
+
+   Not Collective
+
+   Input Parameter:
+.  st  - the spectral transformation context
+
+   Output Parameter:
+.  type - the type of filter
+
+   Level: intermediate
+
+.seealso: STFilterSetType()
+@*/
+PetscErrorCode STFilterGetType(ST st,STFilterType *type)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(type,2);
+  PetscUseMethod(st,"STFilterGetType_C",(ST,STFilterType*),(st,type));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STFilterSetDamping_Filter(ST st,STFilterDamping damping)
+{
+  ST_FILTER *ctx = (ST_FILTER*)st->data;
+
+  PetscFunctionBegin;
+  if (ctx->damping != damping) {
+    ctx->damping = damping;
+    st->state    = ST_STATE_INITIAL;
+    st->opready  = PETSC_FALSE;
+    ctx->filtch  = PETSC_TRUE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STFilterSetDamping - Sets the type of damping of the coefficients of the
+   Chebyshev filter.
+
+   Logically Collective
+
+   Input Parameters:
++  st      - the spectral transformation context
+-  damping - the type of damping
+
+   Options Database Key:
+.  -st_filter_damping <damping> - one of 'none', 'jackson', 'lanczos', 'fejer'
+
+   Notes:
+   The truncated Chebyshev expansion of the indicator function of the interval
+   exhibits Gibbs oscillations near the ends of the interval. The damping factors
+   reduce them at the cost of a wider transition region. The default is Jackson
+   damping.
+
+   This is relevant only for STFILTER_CHEBYSHEV, see STFilterSetType().
+
+   Level: intermediate
+
+.seealso: STFilterGetDamping(), STFilterSetType()
+@*/
+PetscErrorCode STFilterSetDamping(ST st,STFilterDamping damping)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(st,damping,2);
+  PetscTryMethod(st,"STFilterSetDamping_C",(ST,STFilterDamping),(st,damping));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STFilterGetDamping_Filter(ST st,STFilterDamping *damping)
+{
+  ST_FILTER *ctx = (ST_FILTER*)st->data;
+
+  PetscFunctionBegin;
+  *damping = ctx->damping;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STFilterGetDamping - Gets the type of damping of the coefficients of the
+   Chebyshev filter.
+
+   Not Collective
+
+   Input Parameter:
+.  st  - the spectral transformation context
+
+   Output Parameter:
+.  damping - the type of damping
+
+   Level: intermediate
+
+.seealso: STFilterSetDamping()
+@*/
+PetscErrorCode STFilterGetDamping(ST st,STFilterDamping *damping)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(damping,2);
+  PetscUseMethod(st,"STFilterGetDamping_C",(ST,STFilterDamping*),(st,damping));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode STFilterSetInterval_Filter(ST st,PetscReal inta,PetscReal intb)
 {
   ST_FILTER *ctx = (ST_FILTER*)st->data;
@@ -277,6 +458,10 @@ static PetscErrorCode STFilterSetDegree_Filter(ST st,PetscInt deg)
    Options Database Key:
 .  -st_filter_degree <deg> - sets the degree of the filter polynomial
 
+   Notes:
+   Use PETSC_DETERMINE to select the default, which is 100 in STFILTER_FILTLAN,
+   while in STFILTER_CHEBYSHEV the degree is estimated from the spectral bounds.
+
    Level: intermediate
 
 .seealso: STFilterGetDegree()
@@ -378,9 +563,10 @@ static PetscErrorCode STView_Filter(ST st,PetscViewer viewer)
   PetscFunctionBegin;
   PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
   if (isascii) {
+    if (ctx->type==STFILTER_CHEBYSHEV) PetscCall(PetscViewerASCIIPrintf(viewer,"  Chebyshev filter with %s damping\n",STFilterDampings[ctx->damping]));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  interval of desired eigenvalues: [%g,%g]\n",(double)ctx->inta,(double)ctx->intb));
     PetscCall(PetscViewerASCIIPrintf(viewer,"  numerical range: [%g,%g]\n",(double)ctx->left,(double)ctx->right));
-    PetscCall(PetscViewerASCIIPrintf(viewer,"  degree of filter polynomial: %" PetscInt_FMT "\n",ctx->polyDegree));
+    PetscCall(PetscViewerASCIIPrintf(viewer,"  degree of filter polynomial: %" PetscInt_FMT "\n",(ctx->type==STFILTER_CHEBYSHEV && ctx->ncoeffs)?ctx->ncoeffs-1:ctx->polyDegree));
     if (st->state>=ST_STATE_SETUP) PetscCall(PetscViewerASCIIPrintf(viewer,"  limit to accept eigenvalues: theta=%g\n",(double)ctx->filterInfo->yLimit));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -394,7 +580,12 @@ static PetscErrorCode STDestroy_Filter(ST st)
   PetscCall(PetscFree(ctx->opts));
   PetscCall(PetscFree(ctx->filterInfo));
   PetscCall(PetscFree(ctx->baseFilter));
+  PetscCall(PetscFree(ctx->coeffs));
   PetscCall(PetscFree(st->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetType_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetType_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetDamping_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetDamping_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetInterval_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetInterval_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetRange_C",NULL));
@@ -417,6 +608,8 @@ SLEPC_EXTERN PetscErrorCode STCreate_Filter(ST st)
 
   st->usesksp = PETSC_FALSE;
 
+  ctx->type               = STFILTER_FILTLAN;
+  ctx->damping            = STFILTER_DAMPING_JACKSON;
   ctx->inta               = PETSC_MIN_REAL;
   ctx->intb               = PETSC_MAX_REAL;
   ctx->left               = 0.0;
@@ -448,6 +641,7 @@ SLEPC_EXTERN PetscErrorCode STCreate_Filter(ST st)
   ctx->filterInfo         = pfi;
 
   st->ops->apply           = STApply_Generic;
+  st->ops->applymat        = STApplyMat_Generic;
   st->ops->setup           = STSetUp_Filter;
   st->ops->computeoperator = STComputeOperator_Filter;
   st->ops->setfromoptions  = STSetFromOptions_Filter;
@@ -455,6 +649,10 @@ SLEPC_EXTERN PetscErrorCode STCreate_Filter(ST st)
   st->ops->reset           = STReset_Filter;
   st->ops->view            = STView_Filter;
 
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetType_C",STFilterSetType_Filter));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetType_C",STFilterGetType_Filter));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetDamping_C",STFilterSetDamping_Filter));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetDamping_C",STFilterGetDamping_Filter));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetInterval_C",STFilterSetInterval_Filter));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterGetInterval_C",STFilterGetInterval_Filter));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STFilterSetRange_C",STFilterSetRange_Filter));
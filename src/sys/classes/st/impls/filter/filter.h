@@ -49,6 +49,8 @@ typedef struct _n_FILTLAN_PFI *FILTLAN_PFI;
 
 typedef struct {
   /* user options */
+  STFilterType    type;            /* the method used to build the filter */
+  STFilterDamping damping;         /* damping of the Chebyshev coefficients */
   PetscReal   inta,intb;           /* bounds of the interval of desired eigenvalues */
   PetscReal   left,right;          /* approximate left and right bounds of the interval containing all eigenvalues */
   PetscInt    polyDegree;          /* degree of s(z), with z*s(z) the polynomial filter */
@@ -68,7 +70,15 @@ typedef struct {
   PetscBool   filtch;              /* filter parameters have changed since last setup */
   Mat         *W;                  /* work matrices for the matrix-matrix application of the filter */
   PetscInt    nW;                  /* number of W matrices */
+  PetscReal   *coeffs;             /* coefficients of the Chebyshev filter in the Chebyshev basis */
+  PetscInt    ncoeffs;             /* number of Chebyshev coefficients (degree plus one) */
+  PetscReal   center,halfwidth;    /* map of the numerical range to [-1,1] */
 } ST_FILTER;
 
 SLEPC_INTERN PetscErrorCode STFilter_FILTLAN_Apply(ST,Vec,Vec);
 SLEPC_INTERN PetscErrorCode STFilter_FILTLAN_setFilter(ST,Mat*);
+SLEPC_INTERN PetscErrorCode STFilter_Chebyshev_setFilter(ST,Mat*);
+
+#if defined(PETSC_HAVE_CUDA)
+SLEPC_INTERN PetscErrorCode FILTLAN_FusedUpdate_CUDA(PetscInt,PetscBool,PetscBool,PetscScalar,PetscScalar,PetscScalar,PetscScalar,PetscScalar*,PetscScalar*,PetscScalar*,PetscScalar*,const PetscScalar*);
+#endif
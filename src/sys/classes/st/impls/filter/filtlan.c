@@ -877,12 +877,96 @@ static PetscErrorCode FILTLAN_FilteredConjugateResidualPolynomial(PetscReal *cpo
       in this case, one can set x0 = 0 and then the return vector is x = s(A)*b, where
       z*s(z) approximates 1-P(z); therefore, A*x is the wanted R(A)*b
 */
+/*
+   Fused update of the vectors in one iteration of the corrected CR, in a single
+   sweep over the local arrays:
+      ap = w + bprev*ap   (except in the first iteration)
+      x  = x + alp*p
+      r  = r - alp0*ap    (except in the last iteration)
+      p  = r + bet*p      (except in the last iteration)
+   where w = A*r was computed in the previous iteration
+*/
+static inline void FILTLAN_FusedUpdate_Host(PetscInt n,PetscBool first,PetscBool last,PetscScalar bprev,PetscScalar alp,PetscScalar alp0,PetscScalar bet,PetscScalar *x,PetscScalar *r,PetscScalar *p,PetscScalar *ap,const PetscScalar *w)
+{
+  PetscInt k;
+
+  if (last) for (k=0;k<n;k++) x[k] += alp*p[k];
+  else if (first) {
+    for (k=0;k<n;k++) {
+      x[k] += alp*p[k];
+      r[k] -= alp0*ap[k];
+      p[k]  = r[k]+bet*p[k];
+    }
+  } else {
+    for (k=0;k<n;k++) {
+      ap[k] = w[k]+bprev*ap[k];
+      x[k] += alp*p[k];
+      r[k] -= alp0*ap[k];
+      p[k]  = r[k]+bet*p[k];
+    }
+  }
+}
+
+static PetscErrorCode FILTLAN_FusedUpdate(Vec x,Vec r,Vec p,Vec ap,Vec w,PetscBool first,PetscBool last,PetscScalar bprev,PetscScalar alp,PetscScalar alp0,PetscScalar bet)
+{
+  PetscInt          n;
+  PetscBool         isstd,isstd2,iscuda=PETSC_FALSE,iscuda2=PETSC_FALSE;
+  PetscScalar       *px,*pr,*pp,*pap;
+  const PetscScalar *pw;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)x,&isstd,VECSEQ,VECMPI,""));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)r,&isstd2,VECSEQ,VECMPI,""));
+#if defined(PETSC_HAVE_CUDA)
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)x,&iscuda,VECSEQCUDA,VECMPICUDA,""));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)r,&iscuda2,VECSEQCUDA,VECMPICUDA,""));
+#endif
+  PetscCall(VecGetLocalSize(x,&n));
+  if (isstd && isstd2) {
+    PetscCall(VecGetArray(x,&px));
+    PetscCall(VecGetArray(r,&pr));
+    PetscCall(VecGetArray(p,&pp));
+    PetscCall(VecGetArray(ap,&pap));
+    PetscCall(VecGetArrayRead(w,&pw));
+    FILTLAN_FusedUpdate_Host(n,first,last,bprev,alp,alp0,bet,px,pr,pp,pap,pw);
+    PetscCall(VecRestoreArrayRead(w,&pw));
+    PetscCall(VecRestoreArray(ap,&pap));
+    PetscCall(VecRestoreArray(p,&pp));
+    PetscCall(VecRestoreArray(r,&pr));
+    PetscCall(VecRestoreArray(x,&px));
+    PetscCall(PetscLogFlops((last?2.0:(first?6.0:8.0))*n));
+#if defined(PETSC_HAVE_CUDA)
+  } else if (iscuda && iscuda2) {
+    PetscCall(VecCUDAGetArray(x,&px));
+    PetscCall(VecCUDAGetArray(r,&pr));
+    PetscCall(VecCUDAGetArray(p,&pp));
+    PetscCall(VecCUDAGetArray(ap,&pap));
+    PetscCall(VecCUDAGetArrayRead(w,&pw));
+    PetscCall(FILTLAN_FusedUpdate_CUDA(n,first,last,bprev,alp,alp0,bet,px,pr,pp,pap,pw));
+    PetscCall(VecCUDARestoreArrayRead(w,&pw));
+    PetscCall(VecCUDARestoreArray(ap,&pap));
+    PetscCall(VecCUDARestoreArray(p,&pp));
+    PetscCall(VecCUDARestoreArray(r,&pr));
+    PetscCall(VecCUDARestoreArray(x,&px));
+    PetscCall(PetscLogGpuFlops((last?2.0:(first?6.0:8.0))*n));
+#endif
+  } else {  /* other vector types, use separate operations */
+    if (!first && !last) PetscCall(VecAYPX(ap,bprev,w));
+    PetscCall(VecAXPY(x,alp,p));
+    if (!last) {
+      PetscCall(VecAXPY(r,-alp0,ap));
+      PetscCall(VecAYPX(p,bet,r));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode FILTLAN_FilteredConjugateResidualMatrixPolynomialVectorProduct(Mat A,Vec b,Vec x,PetscReal *baseFilter,PetscInt nbase,PetscReal *intv,PetscInt nintv,PetscReal *intervalWeights,PetscInt niter,Vec *work)
 {
   PetscInt       i,j,srpol,scpol,sarpol,sppol,sappol,ld;
-  PetscReal      rho,rho0,rho00,rho1,den,bet,alp,alp0,*cpol,*ppol,*rpol,*appol,*arpol,tol=0.0;
+  PetscReal      rho,rho0,rho00,rho1,den,bet=0.0,betprev=0.0,alp,alp0,*cpol,*ppol,*rpol,*appol,*arpol,tol=0.0;
   Vec            r=work[0],p=work[1],ap=work[2],w=work[3];
-  PetscScalar    alpha;
+  PetscBool      last;
 
   PetscFunctionBegin;
   ld = niter+3;  /* leading dimension */
@@ -927,26 +1011,23 @@ static PetscErrorCode FILTLAN_FilteredConjugateResidualMatrixPolynomialVectorPro
     PetscCall(FILTLAN_PiecewisePolynomialInChebyshevBasisMultiplyX(rpol,srpol,ld,intv,nintv,arpol,ld));
     rho0 = rho;
     rho = FILTLAN_PiecewisePolynomialInnerProductInChebyshevBasis(rpol,srpol,nintv,ld,arpol,sarpol,nintv,ld,intervalWeights);
-
-    /* update x in the vector space */
-    alpha = alp;
-    PetscCall(VecAXPY(x,alpha,p));   /* x += alp*p */
-    if (rho < tol*rho00) break;
+    last = (rho < tol*rho00 || i==niter-1)? PETSC_TRUE: PETSC_FALSE;
 
     /* finish the iteration in the polynomial space */
-    bet = rho / rho0;
-    sppol++;
-    sappol++;
-    PetscCall(Mat_AXPY_BLAS(sppol,nintv,1.0,rpol,ld,bet,ppol,ld));
-    PetscCall(Mat_AXPY_BLAS(sappol,nintv,1.0,arpol,ld,bet,appol,ld));
+    if (!last) {
+      bet = rho / rho0;
+      sppol++;
+      sappol++;
+      PetscCall(Mat_AXPY_BLAS(sppol,nintv,1.0,rpol,ld,bet,ppol,ld));
+      PetscCall(Mat_AXPY_BLAS(sappol,nintv,1.0,arpol,ld,bet,appol,ld));
+    }
 
-    /* finish the iteration in the vector space */
-    alpha = -alp0;
-    PetscCall(VecAXPY(r,alpha,ap));    /* r -= alp0*ap */
-    alpha = bet;
-    PetscCall(VecAYPX(p,alpha,r));     /* p = r + bet*p */
-    PetscCall(MatMult(A,r,w));         /* ap = A*r + bet*ap */
-    PetscCall(VecAYPX(ap,alpha,w));
+    /* iteration in the vector space, the update ap = A*r + bet*ap of the previous
+       iteration is delayed so that all vectors are updated in a single sweep */
+    PetscCall(FILTLAN_FusedUpdate(x,r,p,ap,w,PetscNot(i),last,betprev,alp,alp0,bet));
+    if (last) break;
+    PetscCall(MatMult(A,r,w));
+    betprev = bet;
   }
   PetscCall(PetscFree5(ppol,rpol,cpol,appol,arpol));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -971,12 +1052,53 @@ static PetscErrorCode MatMult_FILTLAN(Mat A,Vec x,Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Block version of FILTLAN_FusedUpdate, column by column */
+static PetscErrorCode FILTLAN_FusedUpdateBlock(Mat X,Mat R,Mat P,Mat AP,Mat W,PetscBool first,PetscBool last,PetscScalar bprev,PetscScalar alp,PetscScalar alp0,PetscScalar bet)
+{
+  PetscInt          j,n,m,ldx,ldr,ldp,ldap,ldw;
+  PetscBool         isdense;
+  PetscScalar       *px,*pr,*pp,*pap;
+  const PetscScalar *pw;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)X,&isdense,MATSEQDENSE,MATMPIDENSE,""));
+  if (isdense) {
+    PetscCall(MatGetLocalSize(X,&n,NULL));
+    PetscCall(MatGetSize(X,NULL,&m));
+    PetscCall(MatDenseGetLDA(X,&ldx));
+    PetscCall(MatDenseGetLDA(R,&ldr));
+    PetscCall(MatDenseGetLDA(P,&ldp));
+    PetscCall(MatDenseGetLDA(AP,&ldap));
+    PetscCall(MatDenseGetLDA(W,&ldw));
+    PetscCall(MatDenseGetArray(X,&px));
+    PetscCall(MatDenseGetArray(R,&pr));
+    PetscCall(MatDenseGetArray(P,&pp));
+    PetscCall(MatDenseGetArray(AP,&pap));
+    PetscCall(MatDenseGetArrayRead(W,&pw));
+    for (j=0;j<m;j++) FILTLAN_FusedUpdate_Host(n,first,last,bprev,alp,alp0,bet,px+j*ldx,pr+j*ldr,pp+j*ldp,pap+j*ldap,pw+j*ldw);
+    PetscCall(MatDenseRestoreArrayRead(W,&pw));
+    PetscCall(MatDenseRestoreArray(AP,&pap));
+    PetscCall(MatDenseRestoreArray(P,&pp));
+    PetscCall(MatDenseRestoreArray(R,&pr));
+    PetscCall(MatDenseRestoreArray(X,&px));
+    PetscCall(PetscLogFlops((last?2.0:(first?6.0:8.0))*n*m));
+  } else {  /* other matrix types, use separate operations */
+    if (!first && !last) PetscCall(MatAYPX(AP,bprev,W,SAME_NONZERO_PATTERN));
+    PetscCall(MatAXPY(X,alp,P,SAME_NONZERO_PATTERN));
+    if (!last) {
+      PetscCall(MatAXPY(R,-alp0,AP,SAME_NONZERO_PATTERN));
+      PetscCall(MatAYPX(P,bet,R,SAME_NONZERO_PATTERN));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Block version of FILTLAN_FilteredConjugateResidualMatrixPolynomialVectorProduct */
 static PetscErrorCode FILTLAN_FilteredConjugateResidualMatrixPolynomialVectorProductBlock(Mat A,Mat B,Mat C,PetscReal *baseFilter,PetscInt nbase,PetscReal *intv,PetscInt nintv,PetscReal *intervalWeights,PetscInt niter,Vec *work,Mat R,Mat P,Mat AP,Mat W)
 {
   PetscInt       i,j,srpol,scpol,sarpol,sppol,sappol,ld;
-  PetscReal      rho,rho0,rho00,rho1,den,bet,alp,alp0,*cpol,*ppol,*rpol,*appol,*arpol,tol=0.0;
-  PetscScalar    alpha;
+  PetscReal      rho,rho0,rho00,rho1,den,bet=0.0,betprev=0.0,alp,alp0,*cpol,*ppol,*rpol,*appol,*arpol,tol=0.0;
+  PetscBool      last;
 
   PetscFunctionBegin;
   ld = niter+3;  /* leading dimension */
@@ -1021,26 +1143,22 @@ static PetscErrorCode FILTLAN_FilteredConjugateResidualMatrixPolynomialVectorPro
     PetscCall(FILTLAN_PiecewisePolynomialInChebyshevBasisMultiplyX(rpol,srpol,ld,intv,nintv,arpol,ld));
     rho0 = rho;
     rho = FILTLAN_PiecewisePolynomialInnerProductInChebyshevBasis(rpol,srpol,nintv,ld,arpol,sarpol,nintv,ld,intervalWeights);
-
-    /* update x in the vector space */
-    alpha = alp;
-    PetscCall(MatAXPY(C,alpha,P,SAME_NONZERO_PATTERN));   /* x += alp*p */
-    if (rho < tol*rho00) break;
+    last = (rho < tol*rho00 || i==niter-1)? PETSC_TRUE: PETSC_FALSE;
 
     /* finish the iteration in the polynomial space */
-    bet = rho / rho0;
-    sppol++;
-    sappol++;
-    PetscCall(Mat_AXPY_BLAS(sppol,nintv,1.0,rpol,ld,bet,ppol,ld));
-    PetscCall(Mat_AXPY_BLAS(sappol,nintv,1.0,arpol,ld,bet,appol,ld));
+    if (!last) {
+      bet = rho / rho0;
+      sppol++;
+      sappol++;
+      PetscCall(Mat_AXPY_BLAS(sppol,nintv,1.0,rpol,ld,bet,ppol,ld));
+      PetscCall(Mat_AXPY_BLAS(sappol,nintv,1.0,arpol,ld,bet,appol,ld));
+    }
 
-    /* finish the iteration in the vector space */
-    alpha = -alp0;
-    PetscCall(MatAXPY(R,alpha,AP,SAME_NONZERO_PATTERN));    /* r -= alp0*ap */
-    alpha = bet;
-    PetscCall(MatAYPX(P,alpha,R,SAME_NONZERO_PATTERN));     /* p = r + bet*p */
-    PetscCall(MatMatMult(A,R,MAT_REUSE_MATRIX,PETSC_DEFAULT,&W));         /* ap = A*r + bet*ap */
-    PetscCall(MatAYPX(AP,alpha,W,SAME_NONZERO_PATTERN));
+    /* iteration in the vector space, with the update of ap delayed as in the non-blocked version */
+    PetscCall(FILTLAN_FusedUpdateBlock(C,R,P,AP,W,PetscNot(i),last,betprev,alp,alp0,bet));
+    if (last) break;
+    PetscCall(MatMatMult(A,R,MAT_REUSE_MATRIX,PETSC_DEFAULT,&W));
+    betprev = bet;
   }
   PetscCall(PetscFree5(ppol,rpol,cpol,appol,arpol));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1083,13 +1201,119 @@ static PetscErrorCode MatMatMult_FILTLAN(Mat A,Mat B,Mat C,void *pctx)
    Creates the shifted (and scaled) matrix and the base filter P(z).
    M is a shell matrix whose MatMult() applies the filter.
 */
+/*
+   Cache of computed filters, shared by all ST objects in the process, so that
+   problems with the same (shifted) frame, degrees and interval options do not
+   repeat the computation of the intervals and the base filter. It is not used
+   with thread safety, since several threads may be setting up filters at once
+*/
+#if !defined(PETSC_HAVE_THREADSAFETY)
+#define FILTLAN_CACHE_SIZE 16
+
+typedef struct {
+  PetscReal             frame[4];
+  PetscInt              polyDegree,baseDegree;
+  struct _n_FILTLAN_IOP opts;            /* interval options on input */
+  PetscInt              numGridPoints;   /* number of grid points on output */
+  PetscReal             intervals[6];
+  struct _n_FILTLAN_PFI info;
+  PetscReal             *baseFilter;
+} FILTLAN_CacheEntry;
+
+static FILTLAN_CacheEntry FILTLAN_Cache[FILTLAN_CACHE_SIZE];
+static PetscInt           FILTLAN_CacheCount = 0,FILTLAN_CacheNext = 0;
+
+static PetscErrorCode FILTLAN_CacheFinalize(void)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0;i<FILTLAN_CacheCount;i++) PetscCall(PetscFree(FILTLAN_Cache[i].baseFilter));
+  FILTLAN_CacheCount = 0;
+  FILTLAN_CacheNext  = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscBool FILTLAN_SameOptions(FILTLAN_IOP a,FILTLAN_IOP b)
+{
+  PetscInt i;
+
+  for (i=0;i<5;i++) if (a->intervalWeights[i]!=b->intervalWeights[i]) return PETSC_FALSE;
+  return (a->transIntervalRatio==b->transIntervalRatio && a->reverseInterval==b->reverseInterval &&
+          a->initialPlateau==b->initialPlateau && a->plateauShrinkRate==b->plateauShrinkRate &&
+          a->initialShiftStep==b->initialShiftStep && a->shiftStepExpanRate==b->shiftStepExpanRate &&
+          a->maxInnerIter==b->maxInnerIter && a->yLimitTol==b->yLimitTol && a->maxOuterIter==b->maxOuterIter &&
+          a->numGridPoints==b->numGridPoints && a->yBottomLine==b->yBottomLine && a->yRippleLimit==b->yRippleLimit)? PETSC_TRUE: PETSC_FALSE;
+}
+#endif
+
+/*
+   Computes the intervals and the base filter for the given (shifted) frame,
+   or copies them from the cache if they were computed before
+*/
+static PetscErrorCode FILTLAN_ComputeFilter(ST st,PetscReal *frame2)
+{
+  ST_FILTER             *ctx = (ST_FILTER*)st->data;
+  PetscInt              npoints,len;
+  const PetscInt        HighLowFlags[5] = { 1, -1, 0, -1, 1 };
+#if !defined(PETSC_HAVE_THREADSAFETY)
+  FILTLAN_CacheEntry    *e;
+  struct _n_FILTLAN_IOP opts;
+  PetscInt              i;
+#endif
+
+  PetscFunctionBegin;
+#if !defined(PETSC_HAVE_THREADSAFETY)
+  for (i=0;i<FILTLAN_CacheCount;i++) {
+    e = FILTLAN_Cache+i;
+    if (e->frame[0]==frame2[0] && e->frame[1]==frame2[1] && e->frame[2]==frame2[2] && e->frame[3]==frame2[3] && e->polyDegree==ctx->polyDegree && e->baseDegree==ctx->baseDegree && FILTLAN_SameOptions(&e->opts,ctx->opts)) {
+      PetscCall(PetscInfo(st,"Reusing a previously computed filter\n"));
+      PetscCall(PetscArraycpy(ctx->intervals,e->intervals,6));
+      *ctx->filterInfo = e->info;
+      ctx->opts->numGridPoints = e->numGridPoints;
+      len = (2*ctx->baseDegree+2)*((e->info.filterType == 2)? 5: 3);
+      PetscCall(PetscFree(ctx->baseFilter));
+      PetscCall(PetscMalloc1(len,&ctx->baseFilter));
+      PetscCall(PetscArraycpy(ctx->baseFilter,e->baseFilter,len));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  opts = *ctx->opts;  /* the number of grid points may be increased */
+#endif
+
+  PetscCall(FILTLAN_GetIntervals(ctx->intervals,frame2,ctx->polyDegree,ctx->baseDegree,ctx->opts,ctx->filterInfo));
+  npoints = (ctx->filterInfo->filterType == 2)? 6: 4;
+  len = (2*ctx->baseDegree+2)*(npoints-1);
+  PetscCall(PetscFree(ctx->baseFilter));
+  PetscCall(PetscMalloc1(len,&ctx->baseFilter));
+  PetscCall(FILTLAN_HermiteBaseFilterInChebyshevBasis(ctx->baseFilter,ctx->intervals,npoints,HighLowFlags,ctx->baseDegree));
+
+#if !defined(PETSC_HAVE_THREADSAFETY)
+  /* store in the cache, replacing the oldest entry if it is full */
+  if (!FILTLAN_CacheCount) PetscCall(PetscRegisterFinalize(FILTLAN_CacheFinalize));
+  e = FILTLAN_Cache+FILTLAN_CacheNext;
+  if (FILTLAN_CacheCount<FILTLAN_CACHE_SIZE) FILTLAN_CacheCount++;
+  else PetscCall(PetscFree(e->baseFilter));
+  FILTLAN_CacheNext = (FILTLAN_CacheNext+1)%FILTLAN_CACHE_SIZE;
+  for (i=0;i<4;i++) e->frame[i] = frame2[i];
+  e->polyDegree    = ctx->polyDegree;
+  e->baseDegree    = ctx->baseDegree;
+  e->opts          = opts;
+  e->numGridPoints = ctx->opts->numGridPoints;
+  e->info          = *ctx->filterInfo;
+  PetscCall(PetscArraycpy(e->intervals,ctx->intervals,6));
+  PetscCall(PetscMalloc1(len,&e->baseFilter));
+  PetscCall(PetscArraycpy(e->baseFilter,ctx->baseFilter,len));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode STFilter_FILTLAN_setFilter(ST st,Mat *G)
 {
   ST_FILTER      *ctx = (ST_FILTER*)st->data;
-  PetscInt       i,npoints,n,m,N,M;
+  PetscInt       i,n,m,N,M;
   PetscReal      frame2[4];
   PetscScalar    alpha;
-  const PetscInt HighLowFlags[5] = { 1, -1, 0, -1, 1 };
 
   PetscFunctionBegin;
   if (ctx->frame[0] == ctx->frame[1]) {  /* low pass filter, convert it to high pass filter */
@@ -1118,7 +1342,7 @@ PetscErrorCode STFilter_FILTLAN_setFilter(ST st,Mat *G)
 
   /* no need to recompute filter if the parameters did not change */
   if (st->state==ST_STATE_INITIAL || ctx->filtch) {
-    PetscCall(FILTLAN_GetIntervals(ctx->intervals,frame2,ctx->polyDegree,ctx->baseDegree,ctx->opts,ctx->filterInfo));
+    PetscCall(FILTLAN_ComputeFilter(st,frame2));
     /* translate the intervals back */
     if (ctx->frame[0] == ctx->frame[1]) {  /* low pass filter, convert it to high pass filter */
       for (i=0;i<4;i++) ctx->intervals2[i] = ctx->frame[3] - ctx->intervals[3-i];
@@ -1129,11 +1353,6 @@ PetscErrorCode STFilter_FILTLAN_setFilter(ST st,Mat *G)
         for (i=0;i<6;i++) ctx->intervals2[i] = ctx->intervals[i] + ctx->frame[0];
       }
     }
-
-    npoints = (ctx->filterInfo->filterType == 2)? 6: 4;
-    PetscCall(PetscFree(ctx->baseFilter));
-    PetscCall(PetscMalloc1((2*ctx->baseDegree+2)*(npoints-1),&ctx->baseFilter));
-    PetscCall(FILTLAN_HermiteBaseFilterInChebyshevBasis(ctx->baseFilter,ctx->intervals,npoints,HighLowFlags,ctx->baseDegree));
     PetscCall(PetscInfo(st,"Computed value of yLimit = %g\n",(double)ctx->filterInfo->yLimit));
   }
   ctx->filtch = PETSC_FALSE;
@@ -12,9 +12,18 @@
 */
 
 #include <slepc/private/stimpl.h>          /*I "slepcst.h" I*/
+#include <slepcblaslapack.h>
 
 typedef struct {
-  PetscBool ksphasmat;  /* the KSP must have the same matrix as PC */
+  PetscBool    ksphasmat;  /* the KSP must have the same matrix as PC */
+  PetscBool    deflation;  /* project the preconditioner against the locked vectors */
+  PC           pc;         /* preconditioner used to compute KQ */
+  BV           Q,KQ;       /* copy of the locked vectors, and K applied to them */
+  PetscInt     nq;         /* number of vectors in Q */
+  PetscInt     ld;         /* leading dimension of QKQ and F */
+  PetscScalar  *QKQ,*F;    /* Q'*K*Q and its LU factorization */
+  PetscScalar  *h;         /* workspace */
+  PetscBLASInt *ipiv;      /* pivots of the LU factorization */
 } ST_PRECOND;
 
 static PetscErrorCode STSetDefaultKSP_Precond(ST st)
@@ -114,6 +123,7 @@ static PetscErrorCode STSetShift_Precond(ST st,PetscScalar newshift)
   ST_PRECOND     *ctx = (ST_PRECOND*)st->data;
 
   PetscFunctionBegin;
+  ctx->nq = 0;  /* the preconditioner changes, so the deflation space must be recomputed */
   if (st->Psplit) { /* update custom preconditioner from the split matrices */
     if (PetscAbsScalar(st->sigma)<PETSC_MAX_REAL || st->nmat==1) PetscCall(STMatMAXPY_Private(st,-st->sigma,0.0,0,NULL,PETSC_FALSE,PETSC_TRUE,&st->Pmat));
   }
@@ -205,12 +215,274 @@ PetscErrorCode STPrecondGetKSPHasMat(ST st,PetscBool *ksphasmat)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode STPrecondSetDeflation_Precond(ST st,PetscBool deflation)
+{
+  ST_PRECOND *ctx = (ST_PRECOND*)st->data;
+
+  PetscFunctionBegin;
+  ctx->deflation = deflation;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STPrecondSetDeflation - Sets a flag indicating that the preconditioner must be
+   projected against the eigenvectors that have already converged.
+
+   Logically Collective
+
+   Input Parameters:
++  st - the spectral transformation context
+-  deflation - the flag
+
+   Options Database Key:
+.  -st_precond_deflation <bool> - Activates the projected preconditioner
+
+   Notes:
+   If this flag is set, Davidson-type eigensolvers (EPSGD and EPSJD) replace the
+   preconditioner K by (I-K*Q*inv(Q'*K*Q)*Q')*K, where Q are the locked eigenvectors,
+   so that the expansion vectors have no components in the directions of Q. The
+   vectors K*Q and the LU factorization of the small matrix Q'*K*Q are kept and
+   updated only when new eigenpairs are locked, so that the projection costs two
+   block operations with the locked vectors per application of the preconditioner.
+
+   This may improve the convergence when many eigenpairs are computed, at the
+   cost of storing a second copy of the locked eigenvectors.
+
+   Level: advanced
+
+.seealso: STPrecondGetDeflation(), EPSGD, EPSJD
+@*/
+PetscErrorCode STPrecondSetDeflation(ST st,PetscBool deflation)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveBool(st,deflation,2);
+  PetscTryMethod(st,"STPrecondSetDeflation_C",(ST,PetscBool),(st,deflation));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STPrecondGetDeflation_Precond(ST st,PetscBool *deflation)
+{
+  ST_PRECOND *ctx = (ST_PRECOND*)st->data;
+
+  PetscFunctionBegin;
+  *deflation = ctx->deflation;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STPrecondGetDeflation - Returns the flag indicating if the preconditioner is
+   projected against the eigenvectors that have already converged.
+
+   Not Collective
+
+   Input Parameter:
+.  st - the spectral transformation context
+
+   Output Parameter:
+.  deflation - the flag
+
+   Level: advanced
+
+.seealso: STPrecondSetDeflation()
+@*/
+PetscErrorCode STPrecondGetDeflation(ST st,PetscBool *deflation)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(deflation,2);
+  PetscUseMethod(st,"STPrecondGetDeflation_C",(ST,PetscBool*),(st,deflation));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STPrecondResetDeflation(ST st)
+{
+  ST_PRECOND *ctx = (ST_PRECOND*)st->data;
+
+  PetscFunctionBegin;
+  PetscCall(PCDestroy(&ctx->pc));
+  PetscCall(BVDestroy(&ctx->Q));
+  PetscCall(BVDestroy(&ctx->KQ));
+  PetscCall(PetscFree4(ctx->QKQ,ctx->F,ctx->h,ctx->ipiv));
+  ctx->nq = 0;
+  ctx->ld = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STPrecondUpdateDeflation - Updates the deflation space of the projected
+   preconditioner with the leading columns of a BV (the locked vectors).
+
+   Collective
+
+   Input Parameters:
++  st - the spectral transformation context
+.  pc - the preconditioner K
+-  V  - the basis vectors, whose leading columns are the locked vectors
+
+   Notes:
+   Only the vectors that have been locked since the previous call are processed,
+   computing K*q and the new rows and columns of Q'*K*Q. The leading columns of
+   V are assumed not to change once they have been locked.
+
+   Level: developer
+
+.seealso: STPrecondSetDeflation(), STPrecondApplyDeflated()
+@*/
+PetscErrorCode STPrecondUpdateDeflation(ST st,PC pc,BV V)
+{
+  ST_PRECOND   *ctx = (ST_PRECOND*)st->data;
+  PetscInt     i,j,l,m,n,mq=0,nloc=0;
+  Vec          v,w;
+  Mat          M;
+  PetscBLASInt l_,ld_,info;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidHeaderSpecific(pc,PC_CLASSID,2);
+  PetscValidHeaderSpecific(V,BV_CLASSID,3);
+  PetscCheckTypeName(st,STPRECOND);
+  PetscCall(BVGetActiveColumns(V,&l,NULL));
+  PetscCall(BVGetSizes(V,&n,NULL,&m));
+  if (ctx->Q) PetscCall(BVGetSizes(ctx->Q,&nloc,NULL,&mq));
+  if (ctx->Q && (mq!=m || nloc!=n)) PetscCall(STPrecondResetDeflation(st));
+  if (!ctx->Q) {
+    PetscCall(BVDuplicate(V,&ctx->Q));
+    PetscCall(BVDuplicate(V,&ctx->KQ));
+    PetscCall(PetscMalloc4(m*m,&ctx->QKQ,m*m,&ctx->F,m,&ctx->h,m,&ctx->ipiv));
+    ctx->ld = m;
+  }
+  if (pc!=ctx->pc) {
+    PetscCall(PetscObjectReference((PetscObject)pc));
+    PetscCall(PCDestroy(&ctx->pc));
+    ctx->pc = pc;
+    ctx->nq = 0;
+  }
+  if (l<ctx->nq) ctx->nq = 0;  /* the locked vectors have been discarded */
+  if (l==ctx->nq) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* Q(:,nq:l-1) <- V(:,nq:l-1), KQ(:,nq:l-1) <- K*Q(:,nq:l-1) */
+  for (j=ctx->nq;j<l;j++) {
+    PetscCall(BVGetColumn(ctx->Q,j,&v));
+    PetscCall(BVCopyVec(V,j,v));
+    PetscCall(BVGetColumn(ctx->KQ,j,&w));
+    PetscCall(PCApply(ctx->pc,v,w));
+    PetscCall(BVRestoreColumn(ctx->Q,j,&v));
+    PetscCall(BVRestoreColumn(ctx->KQ,j,&w));
+  }
+
+  /* new columns and rows of Q'*K*Q */
+  PetscCall(MatCreateSeqDense(PETSC_COMM_SELF,m,m,ctx->QKQ,&M));
+  PetscCall(BVSetActiveColumns(ctx->Q,0,l));
+  PetscCall(BVSetActiveColumns(ctx->KQ,ctx->nq,l));
+  PetscCall(BVDot(ctx->KQ,ctx->Q,M));
+  if (ctx->nq) {
+    PetscCall(BVSetActiveColumns(ctx->Q,ctx->nq,l));
+    PetscCall(BVSetActiveColumns(ctx->KQ,0,ctx->nq));
+    PetscCall(BVDot(ctx->KQ,ctx->Q,M));
+  }
+  PetscCall(MatDestroy(&M));
+
+  /* F <- LU factorization of Q'*K*Q */
+  for (i=0;i<l;i++) PetscCall(PetscArraycpy(ctx->F+i*ctx->ld,ctx->QKQ+i*ctx->ld,l));
+  PetscCall(PetscBLASIntCast(l,&l_));
+  PetscCall(PetscBLASIntCast(ctx->ld,&ld_));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKgetrf",LAPACKgetrf_(&l_,&l_,ctx->F,&ld_,ctx->ipiv,&info));
+  PetscCall(PetscFPTrapPop());
+  SlepcCheckLapackInfo("getrf",info);
+  PetscCall(PetscInfo(st,"Deflation space of the preconditioner updated from %" PetscInt_FMT " to %" PetscInt_FMT " vectors\n",ctx->nq,l));
+  ctx->nq = l;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STPrecondApplyDeflated - Applies the preconditioner projected against the
+   deflation space, y = (I-K*Q*inv(Q'*K*Q)*Q')*K*x.
+
+   Collective
+
+   Input Parameters:
++  st - the spectral transformation context
+.  pc - the preconditioner K
+-  x  - input vector
+
+   Output Parameter:
+.  y - output vector
+
+   Note:
+   If the deflation space is empty or has been computed with a different
+   preconditioner, then y = K*x.
+
+   Level: developer
+
+.seealso: STPrecondSetDeflation(), STPrecondUpdateDeflation()
+@*/
+PetscErrorCode STPrecondApplyDeflated(ST st,PC pc,Vec x,Vec y)
+{
+  ST_PRECOND   *ctx = (ST_PRECOND*)st->data;
+  PetscBLASInt nq_,ld_,one=1,info;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidHeaderSpecific(pc,PC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,4);
+  PetscCheckTypeName(st,STPRECOND);
+  PetscCall(PCApply(pc,x,y));
+  if (pc!=ctx->pc || !ctx->nq) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* h <- inv(Q'*K*Q)*Q'*y */
+  PetscCall(BVSetActiveColumns(ctx->Q,0,ctx->nq));
+  PetscCall(BVDotVec(ctx->Q,y,ctx->h));
+  PetscCall(PetscBLASIntCast(ctx->nq,&nq_));
+  PetscCall(PetscBLASIntCast(ctx->ld,&ld_));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKgetrs",LAPACKgetrs_("N",&nq_,&one,ctx->F,&ld_,ctx->ipiv,ctx->h,&nq_,&info));
+  PetscCall(PetscFPTrapPop());
+  SlepcCheckLapackInfo("getrs",info);
+
+  /* y <- y - KQ*h */
+  PetscCall(BVSetActiveColumns(ctx->KQ,0,ctx->nq));
+  PetscCall(BVMultVec(ctx->KQ,-1.0,1.0,y,ctx->h));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STSetFromOptions_Precond(ST st,PetscOptionItems *PetscOptionsObject)
+{
+  PetscBool      flg,val;
+  ST_PRECOND     *ctx = (ST_PRECOND*)st->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"ST Precond Options");
+
+    PetscCall(PetscOptionsBool("-st_precond_deflation","Project the preconditioner against the locked eigenvectors","STPrecondSetDeflation",ctx->deflation,&val,&flg));
+    if (flg) PetscCall(STPrecondSetDeflation(st,val));
+
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STView_Precond(ST st,PetscViewer viewer)
+{
+  ST_PRECOND     *ctx = (ST_PRECOND*)st->data;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii && ctx->deflation) PetscCall(PetscViewerASCIIPrintf(viewer,"  preconditioner projected against the locked eigenvectors\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode STDestroy_Precond(ST st)
 {
   PetscFunctionBegin;
+  PetscCall(STPrecondResetDeflation(st));
   PetscCall(PetscFree(st->data));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondGetKSPHasMat_C",NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondSetKSPHasMat_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondGetDeflation_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondSetDeflation_C",NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -235,8 +507,12 @@ SLEPC_EXTERN PetscErrorCode STCreate_Precond(ST st)
   st->ops->postsolve       = STPostSolve_Precond;
   st->ops->destroy         = STDestroy_Precond;
   st->ops->setdefaultksp   = STSetDefaultKSP_Precond;
+  st->ops->setfromoptions  = STSetFromOptions_Precond;
+  st->ops->view            = STView_Precond;
 
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondGetKSPHasMat_C",STPrecondGetKSPHasMat_Precond));
   PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondSetKSPHasMat_C",STPrecondSetKSPHasMat_Precond));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondGetDeflation_C",STPrecondGetDeflation_Precond));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STPrecondSetDeflation_C",STPrecondSetDeflation_Precond));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -132,7 +132,10 @@ static PetscErrorCode STSetUp_Shift(ST st)
     }
   }
   if (st->P) PetscCall(KSPSetUp(st->ksp));
-  if (st->structured) st->ops->apply = STApply_Shift_BSE;
+  if (st->structured) {
+    st->ops->apply    = STApply_Shift_BSE;
+    st->ops->applymat = NULL;
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -162,6 +165,7 @@ SLEPC_EXTERN PetscErrorCode STCreate_Shift(ST st)
   st->usesksp = PETSC_TRUE;
 
   st->ops->apply           = STApply_Generic;
+  st->ops->applymat        = STApplyMat_Generic;
   st->ops->applytrans      = STApplyTranspose_Generic;
   st->ops->applyhermtrans  = STApplyHermitianTranspose_Generic;
   st->ops->backtransform   = STBackTransform_Shift;
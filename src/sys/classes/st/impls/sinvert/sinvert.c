@@ -13,6 +13,256 @@
 
 #include <slepc/private/stimpl.h>
 
+typedef struct {
+  PetscInt         refine_its;   /* maximum number of steps of iterative refinement */
+  PetscReal        refine_tol;   /* relative tolerance of iterative refinement */
+  PetscInt         ncache;       /* maximum number of cached factorizations */
+  PetscInt         nc;           /* number of cached factorizations, the last one is the current */
+  PetscScalar      *cshift;      /* shifts of the cached factorizations */
+  Mat              *cP;          /* cached matrices A-sigma*B */
+  KSP              *cksp;        /* cached linear solvers, with the factorization of cP */
+  Mat              cA[2];        /* matrices used to build the cached factorizations */
+  PetscObjectState cstate[2];    /* state of the matrices cA */
+} ST_SINVERT;
+
+/*
+   Shift cache: each entry keeps the matrix A-sigma*B for one shift together with
+   the KSP that holds its factorization, so that returning to a previous shift in
+   STSetShift() or STSetUp() does not require a new factorization. It is available
+   only for linear problems in copy mode without a user-defined preconditioner.
+*/
+static PetscBool STSinvertCacheUsable(ST st)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+
+  return (ctx->ncache>1 && st->transform && st->matmode==ST_MATMODE_COPY && st->nmat<=2 && !st->Psplit && !st->Pmat && !st->structured)? PETSC_TRUE: PETSC_FALSE;
+}
+
+static PetscErrorCode STSinvertCacheFlush(ST st)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+  PetscInt   i;
+
+  PetscFunctionBegin;
+  for (i=0;i<ctx->nc;i++) {
+    PetscCall(MatDestroy(&ctx->cP[i]));
+    PetscCall(KSPDestroy(&ctx->cksp[i]));
+  }
+  ctx->nc = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Returns the index of the cache entry for shift sigma, or -1 if not cached.
+   The cache is flushed if the matrices have changed since it was built.
+*/
+static PetscErrorCode STSinvertCacheLookup(ST st,PetscScalar sigma,PetscInt *idx)
+{
+  ST_SINVERT       *ctx = (ST_SINVERT*)st->data;
+  PetscInt         i;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  *idx = -1;
+  if (!ctx->nc) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i=0;i<st->nmat;i++) {
+    PetscCall(PetscObjectStateGet((PetscObject)st->A[i],&state));
+    if (st->A[i]!=ctx->cA[i] || state!=ctx->cstate[i]) {
+      PetscCall(PetscInfo(st,"Matrices have changed, flushing the cache of factorizations\n"));
+      PetscCall(STSinvertCacheFlush(st));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  for (i=0;i<ctx->nc;i++) if (ctx->cshift[i]==sigma) *idx = i;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Moves the entry idx to the end of the cache (most recently used) and makes
+   its matrix and linear solver the current ones
+*/
+static PetscErrorCode STSinvertCacheActivate(ST st,PetscInt idx)
+{
+  ST_SINVERT  *ctx = (ST_SINVERT*)st->data;
+  PetscInt    i;
+  PetscScalar sigma=ctx->cshift[idx];
+  Mat         P=ctx->cP[idx];
+  KSP         ksp=ctx->cksp[idx];
+
+  PetscFunctionBegin;
+  for (i=idx;i<ctx->nc-1;i++) {
+    ctx->cshift[i] = ctx->cshift[i+1];
+    ctx->cP[i]     = ctx->cP[i+1];
+    ctx->cksp[i]   = ctx->cksp[i+1];
+  }
+  ctx->cshift[ctx->nc-1] = sigma;
+  ctx->cP[ctx->nc-1]     = P;
+  ctx->cksp[ctx->nc-1]   = ksp;
+  PetscCall(PetscObjectReference((PetscObject)P));
+  PetscCall(MatDestroy(&st->T[1]));
+  st->T[1] = P;
+  PetscCall(PetscObjectReference((PetscObject)P));
+  PetscCall(MatDestroy(&st->P));
+  st->P = P;
+  PetscCall(PetscObjectReference((PetscObject)ksp));
+  PetscCall(KSPDestroy(&st->ksp));
+  st->ksp = ksp;
+  PetscCall(PetscInfo(st,"Using the cached factorization for shift %g\n",(double)PetscRealPart(sigma)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Appends the current shift, matrix and linear solver to the cache, discarding the
+   least recently used entry if the cache is full
+*/
+static PetscErrorCode STSinvertCacheInsert(ST st,PetscScalar sigma)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+  PetscInt   i;
+
+  PetscFunctionBegin;
+  if (!ctx->cshift) PetscCall(PetscMalloc3(ctx->ncache,&ctx->cshift,ctx->ncache,&ctx->cP,ctx->ncache,&ctx->cksp));
+  if (!ctx->nc) {
+    for (i=0;i<st->nmat;i++) {
+      ctx->cA[i] = st->A[i];
+      PetscCall(PetscObjectStateGet((PetscObject)st->A[i],&ctx->cstate[i]));
+    }
+  }
+  if (ctx->nc==ctx->ncache) {
+    PetscCall(MatDestroy(&ctx->cP[0]));
+    PetscCall(KSPDestroy(&ctx->cksp[0]));
+    for (i=0;i<ctx->nc-1;i++) {
+      ctx->cshift[i] = ctx->cshift[i+1];
+      ctx->cP[i]     = ctx->cP[i+1];
+      ctx->cksp[i]   = ctx->cksp[i+1];
+    }
+    ctx->nc--;
+  }
+  ctx->cshift[ctx->nc] = sigma;
+  PetscCall(PetscObjectReference((PetscObject)st->P));
+  ctx->cP[ctx->nc] = st->P;
+  PetscCall(PetscObjectReference((PetscObject)st->ksp));
+  ctx->cksp[ctx->nc] = st->ksp;
+  ctx->nc++;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   If the current KSP belongs to the cache, replace it by a new one with the
+   same configuration, so that the cached factorization is not overwritten
+*/
+static PetscErrorCode STSinvertCacheNewKSP(ST st)
+{
+  ST_SINVERT    *ctx = (ST_SINVERT*)st->data;
+  KSP           ksp;
+  KSPType       ksptype;
+  PC            pc,newpc;
+  PCType        pctype;
+  MatSolverType solver;
+  const char    *prefix;
+  PetscReal     rtol,abstol,dtol;
+  PetscInt      i,maxits;
+  PetscBool     incache=PETSC_FALSE,isfactor;
+
+  PetscFunctionBegin;
+  if (!st->ksp) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i=0;i<ctx->nc;i++) if (ctx->cksp[i]==st->ksp) incache = PETSC_TRUE;
+  if (!incache) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(KSPCreate(PetscObjectComm((PetscObject)st),&ksp));
+  PetscCall(PetscObjectIncrementTabLevel((PetscObject)ksp,(PetscObject)st,1));
+  PetscCall(KSPGetOptionsPrefix(st->ksp,&prefix));
+  PetscCall(KSPSetOptionsPrefix(ksp,prefix));
+  PetscCall(PetscObjectSetOptions((PetscObject)ksp,((PetscObject)st)->options));
+  PetscCall(KSPGetType(st->ksp,&ksptype));
+  if (ksptype) PetscCall(KSPSetType(ksp,ksptype));
+  PetscCall(KSPGetPC(st->ksp,&pc));
+  PetscCall(KSPGetPC(ksp,&newpc));
+  PetscCall(PCGetType(pc,&pctype));
+  if (pctype) PetscCall(PCSetType(newpc,pctype));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)pc,&isfactor,PCLU,PCCHOLESKY,""));
+  if (isfactor) {
+    PetscCall(PCFactorGetMatSolverType(pc,&solver));
+    if (solver) PetscCall(PCFactorSetMatSolverType(newpc,solver));
+  }
+  PetscCall(KSPGetTolerances(st->ksp,&rtol,&abstol,&dtol,&maxits));
+  PetscCall(KSPSetTolerances(ksp,rtol,abstol,dtol,maxits));
+  PetscCall(KSPSetErrorIfNotConverged(ksp,PETSC_TRUE));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPDestroy(&st->ksp));
+  st->ksp = ksp;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Solve P*y = b, improving the solution computed by the KSP with steps of
+   iterative refinement whose residual is computed with the matrix P
+*/
+static PetscErrorCode STMatSolve_Sinvert_Refine(ST st,Vec b,Vec y)
+{
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+  Vec            r=st->work[1],d=st->work[2];
+  PetscInt       i;
+  PetscReal      nb,nr=0.0;
+
+  PetscFunctionBegin;
+  PetscCall(STMatSolve(st,b,y));
+  PetscCall(VecNorm(b,NORM_2,&nb));
+  for (i=0;i<ctx->refine_its;i++) {
+    PetscCall(MatMult(st->P,y,r));
+    PetscCall(VecAYPX(r,-1.0,b));
+    PetscCall(VecNorm(r,NORM_2,&nr));
+    if (nr<=ctx->refine_tol*nb) break;
+    PetscCall(STMatSolve(st,r,d));
+    PetscCall(VecAXPY(y,1.0,d));
+  }
+  PetscCall(PetscInfo(st,"Iterative refinement: %" PetscInt_FMT " steps, relative residual %g\n",i,(double)(nb>0.0?nr/nb:0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STApply_Sinvert(ST st,Vec x,Vec y)
+{
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  if (!ctx->refine_its || !st->P) PetscCall(STApply_Generic(st,x,y));
+  else if (st->M) {
+    PetscCall(MatMult(st->M,x,st->work[0]));
+    PetscCall(STMatSolve_Sinvert_Refine(st,st->work[0],y));
+  } else PetscCall(STMatSolve_Sinvert_Refine(st,x,y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STApplyMat_Sinvert(ST st,Mat X,Mat Y)
+{
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+  Mat            B=X,R=NULL,D;
+  PetscInt       i;
+  PetscReal      nb,nr=0.0;
+
+  PetscFunctionBegin;
+  if (!ctx->refine_its || !st->P) {
+    PetscCall(STApplyMat_Generic(st,X,Y));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (st->M) PetscCall(MatMatMult(st->M,X,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&B));
+  PetscCall(STMatMatSolve(st,B,Y));
+  PetscCall(MatDuplicate(Y,MAT_DO_NOT_COPY_VALUES,&D));
+  PetscCall(MatNorm(B,NORM_FROBENIUS,&nb));
+  for (i=0;i<ctx->refine_its;i++) {
+    PetscCall(MatMatMult(st->P,Y,R?MAT_REUSE_MATRIX:MAT_INITIAL_MATRIX,PETSC_DEFAULT,&R));
+    PetscCall(MatAYPX(R,-1.0,B,SAME_NONZERO_PATTERN));
+    PetscCall(MatNorm(R,NORM_FROBENIUS,&nr));
+    if (nr<=ctx->refine_tol*nb) break;
+    PetscCall(STMatMatSolve(st,R,D));
+    PetscCall(MatAXPY(Y,1.0,D,SAME_NONZERO_PATTERN));
+  }
+  PetscCall(PetscInfo(st,"Iterative refinement: %" PetscInt_FMT " steps, relative residual %g\n",i,(double)(nb>0.0?nr/nb:0.0)));
+  PetscCall(MatDestroy(&R));
+  PetscCall(MatDestroy(&D));
+  if (st->M) PetscCall(MatDestroy(&B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode STBackTransform_Sinvert(ST st,PetscInt n,PetscScalar *eigr,PetscScalar *eigi)
 {
   PetscInt    j;
@@ -59,16 +309,35 @@ static PetscErrorCode STPostSolve_Sinvert(ST st)
 */
 static PetscErrorCode STComputeOperator_Sinvert(ST st)
 {
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+  PetscInt       idx=-1;
+  PetscBool      cache=STSinvertCacheUsable(st);
+
   PetscFunctionBegin;
   /* if the user did not set the shift, use the target value */
   if (!st->sigma_set) st->sigma = st->defsigma;
   PetscCall(PetscObjectReference((PetscObject)st->A[1]));
   PetscCall(MatDestroy(&st->T[0]));
   st->T[0] = st->A[1];
-  PetscCall(STMatMAXPY_Private(st,-st->sigma,0.0,0,NULL,PetscNot(st->state==ST_STATE_UPDATED),PETSC_FALSE,&st->T[1]));
-  PetscCall(PetscObjectReference((PetscObject)st->T[1]));
-  PetscCall(MatDestroy(&st->P));
-  st->P = st->T[1];
+  if (cache) {
+    if (st->state==ST_STATE_UPDATED) PetscCall(STSinvertCacheFlush(st));
+    PetscCall(STSinvertCacheLookup(st,st->sigma,&idx));
+  } else if (ctx->nc) PetscCall(STSinvertCacheFlush(st));
+  if (idx>=0) PetscCall(STSinvertCacheActivate(st,idx));
+  else {
+    if (cache) {  /* do not overwrite the matrix and factorization of a cached shift */
+      PetscCall(STSinvertCacheNewKSP(st));
+      if (ctx->nc) PetscCall(MatDestroy(&st->T[1]));
+    }
+    PetscCall(STMatMAXPY_Private(st,-st->sigma,0.0,0,NULL,PetscNot(st->state==ST_STATE_UPDATED),PETSC_FALSE,&st->T[1]));
+    PetscCall(PetscObjectReference((PetscObject)st->T[1]));
+    PetscCall(MatDestroy(&st->P));
+    st->P = st->T[1];
+    if (cache) {
+      if (!st->ksp) PetscCall(STGetKSP(st,&st->ksp));
+      PetscCall(STSinvertCacheInsert(st,st->sigma));
+    }
+  }
   st->M = (st->nmat>1)? st->T[0]: NULL;
   if (st->Psplit) {  /* build custom preconditioner from the split matrices */
     PetscCall(STMatMAXPY_Private(st,-st->sigma,0.0,0,NULL,PETSC_TRUE,PETSC_TRUE,&st->Pmat));
@@ -87,9 +356,11 @@ static PetscErrorCode STSetUp_Sinvert(ST st)
   MatType        type;
   PetscBool      flg;
   char           str[64];
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
 
   PetscFunctionBegin;
-  if (nmat>1) PetscCall(STSetWorkVecs(st,1));
+  if (ctx->refine_its) PetscCall(STSetWorkVecs(st,3));
+  else if (nmat>1) PetscCall(STSetWorkVecs(st,1));
   /* if the user did not set the shift, use the target value */
   if (!st->sigma_set) st->sigma = st->defsigma;
   if (nmat>2) {  /* set-up matrices for polynomial eigenproblems */
@@ -162,10 +433,26 @@ static PetscErrorCode STSetUp_Sinvert(ST st)
 
 static PetscErrorCode STSetShift_Sinvert(ST st,PetscScalar newshift)
 {
-  PetscInt       nmat=PetscMax(st->nmat,2),k,nc;
+  PetscInt       nmat=PetscMax(st->nmat,2),k,nc,idx;
   PetscScalar    *coeffs=NULL;
 
   PetscFunctionBegin;
+  if (STSinvertCacheUsable(st)) {
+    PetscCall(STSinvertCacheLookup(st,newshift,&idx));
+    if (idx>=0) PetscCall(STSinvertCacheActivate(st,idx));
+    else {  /* new matrix and linear solver, keeping the ones of the current shift in the cache */
+      PetscCall(STSinvertCacheNewKSP(st));
+      PetscCall(MatDestroy(&st->T[1]));
+      PetscCall(STMatMAXPY_Private(st,-newshift,0.0,0,NULL,PETSC_TRUE,PETSC_FALSE,&st->T[1]));
+      PetscCall(PetscObjectReference((PetscObject)st->T[1]));
+      PetscCall(MatDestroy(&st->P));
+      st->P = st->T[1];
+      PetscCall(ST_KSPSetOperators(st,st->P,st->P));
+      PetscCall(KSPSetUp(st->ksp));
+      PetscCall(STSinvertCacheInsert(st,newshift));
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (st->transform) {
     if (st->matmode == ST_MATMODE_COPY && nmat>2) {
       nc = (nmat*(nmat+1))/2;
@@ -191,12 +478,268 @@ static PetscErrorCode STSetShift_Sinvert(ST st,PetscScalar newshift)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode STSetFromOptions_Sinvert(ST st,PetscOptionItems *PetscOptionsObject)
+{
+  PetscInt       i;
+  PetscReal      r;
+  PetscBool      flg1,flg2;
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject,"ST Shift-and-invert Options");
+
+    PetscCall(PetscOptionsInt("-st_sinvert_refine_its","Maximum number of steps of iterative refinement","STSinvertSetRefinement",ctx->refine_its,&i,&flg1));
+    PetscCall(PetscOptionsReal("-st_sinvert_refine_tol","Relative tolerance of iterative refinement","STSinvertSetRefinement",ctx->refine_tol,&r,&flg2));
+    if (flg1 || flg2) PetscCall(STSinvertSetRefinement(st,flg1?i:PETSC_CURRENT,flg2?r:PETSC_CURRENT));
+
+    PetscCall(PetscOptionsInt("-st_sinvert_shift_cache","Maximum number of factorizations kept for different shifts","STSinvertSetShiftCache",ctx->ncache,&i,&flg1));
+    if (flg1) PetscCall(STSinvertSetShiftCache(st,i));
+
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STSinvertSetRefinement_Sinvert(ST st,PetscInt its,PetscReal tol)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  if (its == PETSC_DETERMINE) ctx->refine_its = 0;
+  else if (its != PETSC_CURRENT) {
+    PetscCheck(its>=0,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of its. Must be >= 0");
+    ctx->refine_its = its;
+  }
+  if (tol == (PetscReal)PETSC_DETERMINE) ctx->refine_tol = 100*PETSC_MACHINE_EPSILON;
+  else if (tol != (PetscReal)PETSC_CURRENT) {
+    PetscCheck(tol>0.0,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of tol. Must be > 0");
+    ctx->refine_tol = tol;
+  }
+  st->state = ST_STATE_INITIAL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STSinvertSetRefinement - Sets the parameters of the iterative refinement
+   used in the linear solves of the shift-and-invert spectral transformation.
+
+   Logically Collective
+
+   Input Parameters:
++  st  - the spectral transformation context
+.  its - maximum number of refinement steps
+-  tol - relative tolerance for the residual of the linear solve
+
+   Options Database Keys:
++  -st_sinvert_refine_its - Sets the maximum number of refinement steps
+-  -st_sinvert_refine_tol - Sets the tolerance of the iterative refinement
+
+   Notes:
+   Iterative refinement allows using a cheaper factorization of A-sigma*B in
+   the KSP, for instance computed in single precision or with the block low-rank
+   compression of MUMPS, with about half the memory and time of the full
+   factorization. The solution provided by the KSP is improved by correcting it
+   with the residual b-(A-sigma*B)*x computed in working precision, until the
+   residual norm is below tol times the norm of b, so that the eigensolver sees
+   the operator with full accuracy. The extra cost is one matrix-vector product
+   and one triangular solve per step.
+
+   Use its=0 (the default) to disable iterative refinement. Use PETSC_CURRENT to
+   retain the current value of any of the parameters, or PETSC_DETERMINE to set
+   the default (the default tolerance is 100 times the machine epsilon).
+
+   Iterative refinement is applied in STApply() and STApplyMat(), but not in the
+   transposed operations.
+
+   Level: advanced
+
+.seealso: STSinvertGetRefinement(), STApply(), STGetKSP()
+@*/
+PetscErrorCode STSinvertSetRefinement(ST st,PetscInt its,PetscReal tol)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveInt(st,its,2);
+  PetscValidLogicalCollectiveReal(st,tol,3);
+  PetscTryMethod(st,"STSinvertSetRefinement_C",(ST,PetscInt,PetscReal),(st,its,tol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STSinvertGetRefinement_Sinvert(ST st,PetscInt *its,PetscReal *tol)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  if (its) *its = ctx->refine_its;
+  if (tol) *tol = ctx->refine_tol;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STSinvertGetRefinement - Gets the parameters of the iterative refinement
+   used in the linear solves of the shift-and-invert spectral transformation.
+
+   Not Collective
+
+   Input Parameter:
+.  st  - the spectral transformation context
+
+   Output Parameters:
++  its - maximum number of refinement steps
+-  tol - relative tolerance for the residual of the linear solve
+
+   Level: advanced
+
+.seealso: STSinvertSetRefinement()
+@*/
+PetscErrorCode STSinvertGetRefinement(ST st,PetscInt *its,PetscReal *tol)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscUseMethod(st,"STSinvertGetRefinement_C",(ST,PetscInt*,PetscReal*),(st,its,tol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STSinvertSetShiftCache_Sinvert(ST st,PetscInt n)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  if (n == PETSC_DECIDE || n == PETSC_DETERMINE) n = 0;
+  PetscCheck(n>=0,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of n. Must be >= 0");
+  if (ctx->ncache != n) {
+    PetscCall(STSinvertCacheFlush(st));
+    PetscCall(PetscFree3(ctx->cshift,ctx->cP,ctx->cksp));
+    ctx->ncache = n;
+    st->state   = ST_STATE_INITIAL;
+    st->opready = PETSC_FALSE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STSinvertSetShiftCache - Sets the maximum number of factorizations of A-sigma*B,
+   for different values of the shift, that are kept in the shift-and-invert spectral
+   transformation.
+
+   Logically Collective
+
+   Input Parameters:
++  st - the spectral transformation context
+-  n  - maximum number of cached factorizations
+
+   Options Database Key:
+.  -st_sinvert_shift_cache <n> - Sets the maximum number of cached factorizations
+
+   Notes:
+   When the shift changes, either with STSetShift() or because the target of the
+   eigensolver changes (e.g., when computing eigenvalues in several windows with
+   successive calls to EPSSolve() with different targets), the matrix A-sigma*B
+   and the linear solver with its factorization are kept for the previous shift,
+   instead of being overwritten. If a shift is used again, its factorization is
+   reused, so the cost of factorizing is incurred only once per shift. When more
+   than n shifts have been used, the least recently used factorization is discarded.
+
+   The cache stores a different KSP object for each shift, configured in the same
+   way as the one of the ST, so the KSP obtained with STGetKSP() may change after a
+   change of the shift. The cache is flushed whenever the matrices are modified.
+
+   It is available only for linear eigenproblems with ST_MATMODE_COPY, without a
+   user-defined preconditioner matrix. Use n=0 (the default) or n=1 to disable it.
+
+   Level: advanced
+
+.seealso: STSinvertGetShiftCache(), STSetShift(), STGetKSP()
+@*/
+PetscErrorCode STSinvertSetShiftCache(ST st,PetscInt n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveInt(st,n,2);
+  PetscTryMethod(st,"STSinvertSetShiftCache_C",(ST,PetscInt),(st,n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STSinvertGetShiftCache_Sinvert(ST st,PetscInt *n)
+{
+  ST_SINVERT *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  *n = ctx->ncache;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STSinvertGetShiftCache - Gets the maximum number of factorizations of A-sigma*B
+   that are kept in the shift-and-invert spectral transformation.
+
+   Not Collective
+
+   Input Parameter:
+.  st - the spectral transformation context
+
+   Output Parameter:
+.  n  - maximum number of cached factorizations
+
+   Level: advanced
+
+.seealso: STSinvertSetShiftCache()
+@*/
+PetscErrorCode STSinvertGetShiftCache(ST st,PetscInt *n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(n,2);
+  PetscUseMethod(st,"STSinvertGetShiftCache_C",(ST,PetscInt*),(st,n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STView_Sinvert(ST st,PetscViewer viewer)
+{
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+  PetscBool      isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii));
+  if (isascii && ctx->refine_its) PetscCall(PetscViewerASCIIPrintf(viewer,"  iterative refinement: max steps=%" PetscInt_FMT ", tolerance=%g\n",ctx->refine_its,(double)ctx->refine_tol));
+  if (isascii && ctx->ncache>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  cache of factorizations: %" PetscInt_FMT " shifts (max %" PetscInt_FMT ")\n",ctx->nc,ctx->ncache));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STReset_Sinvert(ST st)
+{
+  PetscFunctionBegin;
+  PetscCall(STSinvertCacheFlush(st));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode STDestroy_Sinvert(ST st)
+{
+  ST_SINVERT     *ctx = (ST_SINVERT*)st->data;
+
+  PetscFunctionBegin;
+  PetscCall(STSinvertCacheFlush(st));
+  PetscCall(PetscFree3(ctx->cshift,ctx->cP,ctx->cksp));
+  PetscCall(PetscFree(st->data));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertSetRefinement_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertGetRefinement_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertSetShiftCache_C",NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertGetShiftCache_C",NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 SLEPC_EXTERN PetscErrorCode STCreate_Sinvert(ST st)
 {
+  ST_SINVERT     *ctx;
+
   PetscFunctionBegin;
+  PetscCall(PetscNew(&ctx));
+  ctx->refine_tol = 100*PETSC_MACHINE_EPSILON;
+  st->data = (void*)ctx;
+
   st->usesksp = PETSC_TRUE;
 
-  st->ops->apply           = STApply_Generic;
+  st->ops->apply           = STApply_Sinvert;
+  st->ops->applymat        = STApplyMat_Sinvert;
   st->ops->applytrans      = STApplyTranspose_Generic;
   st->ops->applyhermtrans  = STApplyHermitianTranspose_Generic;
   st->ops->backtransform   = STBackTransform_Sinvert;
@@ -204,8 +747,17 @@ SLEPC_EXTERN PetscErrorCode STCreate_Sinvert(ST st)
   st->ops->getbilinearform = STGetBilinearForm_Default;
   st->ops->setup           = STSetUp_Sinvert;
   st->ops->computeoperator = STComputeOperator_Sinvert;
+  st->ops->setfromoptions  = STSetFromOptions_Sinvert;
   st->ops->postsolve       = STPostSolve_Sinvert;
+  st->ops->destroy         = STDestroy_Sinvert;
+  st->ops->reset           = STReset_Sinvert;
+  st->ops->view            = STView_Sinvert;
   st->ops->checknullspace  = STCheckNullSpace_Default;
   st->ops->setdefaultksp   = STSetDefaultKSP_Default;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertSetRefinement_C",STSinvertSetRefinement_Sinvert));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertGetRefinement_C",STSinvertGetRefinement_Sinvert));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertSetShiftCache_C",STSinvertSetShiftCache_Sinvert));
+  PetscCall(PetscObjectComposeFunction((PetscObject)st,"STSinvertGetShiftCache_C",STSinvertGetShiftCache_Sinvert));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -18,6 +18,8 @@ PetscLogEvent    ST_SetUp = 0,ST_ComputeOperator = 0,ST_Apply = 0,ST_ApplyTransp
 static PetscBool STPackageInitialized = PETSC_FALSE;
 
 const char *STMatModes[] = {"COPY","INPLACE","SHELL","STMatMode","ST_MATMODE_",NULL};
+const char *STFilterTypes[] = {"FILTLAN","CHEBYSHEV","STFilterType","STFILTER_",NULL};
+const char *STFilterDampings[] = {"NONE","JACKSON","LANCZOS","FEJER","STFilterDamping","STFILTER_DAMPING_",NULL};
 
 /*@C
    STFinalizePackage - This function destroys everything in the Slepc interface
@@ -117,7 +119,11 @@ PetscErrorCode STReset(ST st)
   st->nwork = 0;
   PetscCall(VecDestroy(&st->wb));
   PetscCall(VecDestroy(&st->wht));
+  PetscCall(VecDestroy(&st->wc));
+  PetscCall(VecDestroy(&st->wg));
+  PetscCall(VecScatterDestroy(&st->sg));
   PetscCall(VecDestroy(&st->D));
+  PetscCall(STResetInertia_Private(st));
   st->state   = ST_STATE_INITIAL;
   st->opready = PETSC_FALSE;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -186,6 +192,8 @@ PetscErrorCode STCreate(MPI_Comm comm,ST *newst)
   st->Psplit       = NULL;
   st->nsplit       = 0;
   st->strp         = UNKNOWN_NONZERO_PATTERN;
+  st->adapttol     = PETSC_FALSE;
+  st->inpart       = 1;
 
   st->ksp          = NULL;
   st->usesksp      = PETSC_FALSE;
@@ -193,11 +201,23 @@ PetscErrorCode STCreate(MPI_Comm comm,ST *newst)
   st->work         = NULL;
   st->wb           = NULL;
   st->wht          = NULL;
+  st->wc           = NULL;
+  st->wg           = NULL;
+  st->sg           = NULL;
+  st->sgid         = 0;
+  st->sgstate      = 0;
+  st->Pid          = 0;
+  st->Pstate       = 0;
   st->state        = ST_STATE_INITIAL;
   st->Astate       = NULL;
   st->T            = NULL;
   st->Op           = NULL;
   st->opseized     = PETSC_FALSE;
+  st->ksprtol      = 0.0;
+  st->isubc        = NULL;
+  st->Ai           = NULL;
+  st->Si           = NULL;
+  st->Fi           = NULL;
   st->opready      = PETSC_FALSE;
   st->P            = NULL;
   st->M            = NULL;
@@ -283,6 +303,7 @@ PetscErrorCode STSetMatrices(ST st,PetscInt n,Mat A[])
     }
     if (!same) PetscCall(STReset(st));
   } else same = PETSC_FALSE;
+  PetscCall(STResetInertia_Private(st));
   if (!same) {
     PetscCall(MatDestroyMatrices(PetscMax(2,st->nmat),&st->A));
     PetscCall(PetscCalloc1(PetscMax(2,n),&st->A));
@@ -1051,6 +1072,8 @@ PetscErrorCode STView(ST st,PetscViewer viewer)
     if (st->Psplit) PetscCall(PetscViewerASCIIPrintf(viewer,"  using split preconditioner matrices with %s\n",MatStructures[st->strp]));
     if (st->transform && st->nmat>2) PetscCall(PetscViewerASCIIPrintf(viewer,"  computing transformed matrices\n"));
     if (st->structured) PetscCall(PetscViewerASCIIPrintf(viewer,"  exploiting structure in the application of the operator\n"));
+    if (st->adapttol) PetscCall(PetscViewerASCIIPrintf(viewer,"  adapting the tolerance of the linear solver to the outer residual\n"));
+    if (st->inpart>1) PetscCall(PetscViewerASCIIPrintf(viewer,"  computing inertias concurrently in %" PetscInt_FMT " partitions\n",st->inpart));
   } else if (isstring) {
     PetscCall(STGetType(st,&cstr));
     PetscCall(PetscViewerStringSPrintf(viewer," %-7.7s",cstr));
@@ -111,6 +111,7 @@ PetscErrorCode STGetType(ST st,STType *type)
 PetscErrorCode STSetFromOptions(ST st)
 {
   PetscScalar    s;
+  PetscInt       i;
   char           type[256];
   PetscBool      flg,bval;
   STMatMode      mode;
@@ -136,6 +137,12 @@ PetscErrorCode STSetFromOptions(ST st)
     PetscCall(PetscOptionsBool("-st_transform","Whether transformed matrices are computed or not","STSetTransform",st->transform,&bval,&flg));
     if (flg) PetscCall(STSetTransform(st,bval));
 
+    PetscCall(PetscOptionsBool("-st_adaptive_inner_tol","Adapt the tolerance of the linear solver to the outer residual","STSetAdaptiveInnerTolerance",st->adapttol,&bval,&flg));
+    if (flg) PetscCall(STSetAdaptiveInnerTolerance(st,bval));
+
+    PetscCall(PetscOptionsInt("-st_inertia_partitions","Number of partitions for concurrent inertia computations","STSetInertiaPartitions",st->inpart,&i,&flg));
+    if (flg) PetscCall(STSetInertiaPartitions(st,i));
+
     PetscTryTypeMethod(st,setfromoptions,PetscOptionsObject);
     PetscCall(PetscObjectProcessOptionsHandlers((PetscObject)st,PetscOptionsObject));
   PetscOptionsEnd();
@@ -171,6 +178,18 @@ PetscErrorCode STSetFromOptions(ST st)
    If not set, the default is UNKNOWN_NONZERO_PATTERN, in which case the patterns
    will be compared to determine if they are equal.
 
+   The flag is used only when the matrix A-sigma*B is first built. In subsequent
+   changes of the shift with STSetShift(), the values are updated keeping the
+   nonzero pattern of the first build, so that the symbolic factorization of the
+   linear solver (e.g., the analysis phase of MUMPS) is reused.
+
+   With matrices stored on the GPU (e.g., MATAIJCUSPARSE or MATAIJKOKKOS),
+   these updates of A-sigma*B are done on the device, so that together with a
+   direct solver that runs on the device (e.g., -st_pc_factor_mat_solver_type cusparse)
+   there is no host stage in the change of shift. This holds whenever the pattern
+   is kept, that is, with SAME_NONZERO_PATTERN, and with the other flags in the
+   changes of shift after the first build.
+
    This function has no effect in the case of standard eigenproblems.
 
    In case of polynomial eigenproblems, the flag applies to all matrices
@@ -253,7 +272,14 @@ PetscErrorCode STGetMatStructure(ST st,MatStructure *str)
    matrix that represents the shifted matrix. This mode is the most efficient
    in creating the shifted matrix but it places serious limitations to the
    linear solves performed in each iteration of the eigensolver (typically,
-   only iterative solvers with Jacobi preconditioning can be used).
+   only iterative solvers with Jacobi preconditioning can be used). If all
+   matrices are of type MATSEQAIJ, the product by the shell matrix traverses
+   all of them in a single sweep, which is particularly efficient when they
+   share the same nonzero pattern. A more effective preconditioner can be
+   provided with STSetSplitPreconditioner(), in which case the preconditioner
+   matrix is assembled explicitly from the split matrices (typically sparser
+   than the original ones) and recomputed whenever the shift changes, while
+   the coefficient matrix of the linear solves remains implicit.
 
    In the two first modes the efficiency of the computation
    can be controlled with STSetMatStructure().
@@ -417,3 +443,132 @@ PetscErrorCode STGetStructured(ST st,PetscBool *flg)
   *flg = st->structured;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*@
+   STSetAdaptiveInnerTolerance - Sets a flag to indicate that the tolerance of
+   the linear solver must be adapted to the convergence of the eigensolver.
+
+   Logically Collective
+
+   Input Parameters:
++  st  - the spectral transformation context
+-  flg - the boolean flag
+
+   Options Database Key:
+.  -st_adaptive_inner_tol <bool> - Activate/deactivate the adaptive tolerance
+
+   Notes:
+   This is intended for inexact shift-and-invert, when the linear systems are
+   solved with an iterative method. In that case, the eigensolver reports the
+   residual norm of the first unconverged approximation at each restart via
+   STUpdateInnerTolerance(), and the relative tolerance of the KSP is set
+   proportional to it. In this way, the linear systems are solved with a relaxed
+   tolerance in the first restarts and the tolerance is tightened as the Ritz
+   pairs converge. The tolerance set by the user in the KSP is used as a lower
+   bound, and it is restored in STPostSolve().
+
+   Currently, only the Krylov-Schur eigensolver passes the residual estimates.
+
+   Level: advanced
+
+.seealso: STGetAdaptiveInnerTolerance(), STUpdateInnerTolerance(), STGetKSP()
+@*/
+PetscErrorCode STSetAdaptiveInnerTolerance(ST st,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveBool(st,flg,2);
+  st->adapttol = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STGetAdaptiveInnerTolerance - Gets a flag that indicates if the tolerance of
+   the linear solver is adapted to the convergence of the eigensolver.
+
+   Not Collective
+
+   Input Parameter:
+.  st - the spectral transformation context
+
+   Output Parameter:
+.  flg - the flag
+
+   Level: advanced
+
+.seealso: STSetAdaptiveInnerTolerance()
+@*/
+PetscErrorCode STGetAdaptiveInnerTolerance(ST st,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(flg,2);
+  *flg = st->adapttol;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STSetInertiaPartitions - Sets the number of partitions of the communicator
+   used to compute the inertia at several shifts concurrently in STGetInertia().
+
+   Logically Collective
+
+   Input Parameters:
++  st    - the spectral transformation context
+-  npart - number of partitions
+
+   Options Database Key:
+.  -st_inertia_partitions <npart> - Sets the number of partitions
+
+   Notes:
+   If npart>1, the communicator of the ST is split into npart subcommunicators,
+   each of them gets a copy of the matrices, and the shifts passed to STGetInertia()
+   are distributed among the subcommunicators, so that the factorizations for
+   different shifts are computed at the same time. The value of npart cannot
+   exceed the number of processes.
+
+   Level: advanced
+
+.seealso: STGetInertiaPartitions(), STGetInertia()
+@*/
+PetscErrorCode STSetInertiaPartitions(ST st,PetscInt npart)
+{
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveInt(st,npart,2);
+  if (npart == PETSC_DEFAULT || npart == PETSC_DECIDE) npart = 1;
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)st),&size));
+  PetscCheck(npart>0 && npart<=size,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of npart");
+  if (st->inpart != npart) {
+    PetscCall(STResetInertia_Private(st));
+    st->inpart = npart;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STGetInertiaPartitions - Gets the number of partitions used for concurrent
+   inertia computations.
+
+   Not Collective
+
+   Input Parameter:
+.  st - the spectral transformation context
+
+   Output Parameter:
+.  npart - number of partitions
+
+   Level: advanced
+
+.seealso: STSetInertiaPartitions()
+@*/
+PetscErrorCode STGetInertiaPartitions(ST st,PetscInt *npart)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscAssertPointer(npart,2);
+  *npart = st->inpart;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
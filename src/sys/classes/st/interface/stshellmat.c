@@ -15,12 +15,18 @@
 #include <slepc/private/stimpl.h>
 
 typedef struct {
-  PetscScalar alpha;
-  PetscScalar *coeffs;
-  ST          st;
-  Vec         z;
-  PetscInt    nmat;
-  PetscInt    *matIdx;
+  PetscScalar       alpha;
+  PetscScalar       *coeffs;
+  ST                st;
+  Vec               z;
+  PetscInt          nmat;
+  PetscInt          *matIdx;
+  /* data for the fused product with MATSEQAIJ matrices */
+  PetscBool         samepat;     /* all matrices have the same nonzero pattern */
+  PetscObjectState  nzstate;     /* nonzero state of the matrices when samepat was computed */
+  const PetscInt    **ia,**ja;
+  const PetscScalar **va;
+  PetscScalar       *c;
 } ST_MATSHELL;
 
 PetscErrorCode STMatShellShift(Mat A,PetscScalar alpha)
@@ -62,6 +68,111 @@ static PetscErrorCode MatMult_Shell(Mat A,Vec x,Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Checks whether the matrices have the same nonzero pattern, only if some of them
+  has been modified since the last check
+*/
+static PetscErrorCode STMatShellCheckPattern_SeqAIJ(ST_MATSHELL *ctx)
+{
+  ST               st = ctx->st;
+  PetscInt         i,n,m;
+  PetscObjectState state,total=0;
+  const PetscInt   *ia0,*ja0,*ia,*ja;
+  PetscBool        done,same=PETSC_TRUE;
+
+  PetscFunctionBegin;
+  for (i=0;i<ctx->nmat;i++) {
+    PetscCall(MatGetNonzeroState(st->A[ctx->matIdx[i]],&state));
+    total += state;
+  }
+  if (total==ctx->nzstate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetRowIJ(st->A[ctx->matIdx[0]],0,PETSC_FALSE,PETSC_FALSE,&n,&ia0,&ja0,&done));
+  PetscCheck(done,PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot get the row structure of the matrix");
+  for (i=1;i<ctx->nmat && same;i++) {
+    PetscCall(MatGetRowIJ(st->A[ctx->matIdx[i]],0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+    PetscCheck(done,PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot get the row structure of the matrix");
+    if (ia!=ia0 || ja!=ja0) {
+      PetscCall(PetscArraycmp(ia,ia0,n+1,&same));
+      if (same) PetscCall(PetscArraycmp(ja,ja0,ia0[n],&same));
+    }
+    PetscCall(MatRestoreRowIJ(st->A[ctx->matIdx[i]],0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+  }
+  PetscCall(MatRestoreRowIJ(st->A[ctx->matIdx[0]],0,PETSC_FALSE,PETSC_FALSE,&n,&ia0,&ja0,&done));
+  ctx->samepat = same;
+  ctx->nzstate = total;
+  PetscCall(PetscInfo(st,"The matrices of the shell operator %s the same nonzero pattern\n",same?"have":"do not have"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Same as MatMult_Shell, for the case that all matrices are MATSEQAIJ. The rows of
+  all matrices are traversed in a single sweep, so that vectors x and y are streamed
+  only once. If the matrices have the same nonzero pattern, the entries of the
+  combined matrix are computed on the fly and the column indices are read only once.
+*/
+static PetscErrorCode MatMult_Shell_SeqAIJ(Mat A,Vec x,Vec y)
+{
+  ST_MATSHELL       *ctx;
+  ST                st;
+  PetscInt          i,j,k,n,nm,nz=0;
+  PetscScalar       t=1.0,sum,s,v,*py;
+  const PetscScalar *px;
+  PetscBool         done;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A,&ctx));
+  st = ctx->st;
+  nm = (ctx->alpha!=0.0)? ctx->nmat: 1;
+  ctx->c[0] = ctx->coeffs? ctx->coeffs[0]: 1.0;
+  for (k=1;k<nm;k++) {
+    t *= ctx->alpha;
+    ctx->c[k] = ctx->coeffs? t*ctx->coeffs[k]: t;
+  }
+  if (nm>1) PetscCall(STMatShellCheckPattern_SeqAIJ(ctx));
+  for (k=0;k<nm;k++) {
+    PetscCall(MatGetRowIJ(st->A[ctx->matIdx[k]],0,PETSC_FALSE,PETSC_FALSE,&n,&ctx->ia[k],&ctx->ja[k],&done));
+    PetscCheck(done,PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot get the row structure of the matrix");
+    PetscCall(MatSeqAIJGetArrayRead(st->A[ctx->matIdx[k]],&ctx->va[k]));
+    nz += ctx->ia[k][n];
+  }
+  PetscCall(VecGetArrayRead(x,&px));
+  PetscCall(VecGetArrayWrite(y,&py));
+  if (nm>1 && ctx->samepat) {
+    for (i=0;i<n;i++) {
+      sum = 0.0;
+      for (j=ctx->ia[0][i];j<ctx->ia[0][i+1];j++) {
+        v = ctx->c[0]*ctx->va[0][j];
+        for (k=1;k<nm;k++) v += ctx->c[k]*ctx->va[k][j];
+        sum += v*px[ctx->ja[0][j]];
+      }
+      py[i] = sum;
+    }
+    nz = ctx->ia[0][n]*(nm+1);
+  } else {
+    for (i=0;i<n;i++) {
+      sum = 0.0;
+      for (k=0;k<nm;k++) {
+        s = 0.0;
+        for (j=ctx->ia[k][i];j<ctx->ia[k][i+1];j++) s += ctx->va[k][j]*px[ctx->ja[k][j]];
+        sum += ctx->c[k]*s;
+      }
+      py[i] = sum;
+    }
+  }
+  if (ctx->nmat==1 && ctx->alpha!=0.0) {  /* y = (A + alpha*I) x */
+    for (i=0;i<n;i++) py[i] += ctx->alpha*px[i];
+    nz += n;
+  }
+  PetscCall(VecRestoreArrayRead(x,&px));
+  PetscCall(VecRestoreArrayWrite(y,&py));
+  for (k=0;k<nm;k++) {
+    PetscCall(MatSeqAIJRestoreArrayRead(st->A[ctx->matIdx[k]],&ctx->va[k]));
+    PetscCall(MatRestoreRowIJ(st->A[ctx->matIdx[k]],0,PETSC_FALSE,PETSC_FALSE,&n,&ctx->ia[k],&ctx->ja[k],&done));
+  }
+  PetscCall(PetscLogFlops(2.0*nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultTranspose_Shell(Mat A,Vec x,Vec y)
 {
   ST_MATSHELL    *ctx;
@@ -150,6 +261,7 @@ static PetscErrorCode MatDestroy_Shell(Mat A)
   PetscCall(VecDestroy(&ctx->z));
   PetscCall(PetscFree(ctx->matIdx));
   PetscCall(PetscFree(ctx->coeffs));
+  PetscCall(PetscFree4(ctx->ia,ctx->ja,ctx->va,ctx->c));
   PetscCall(PetscFree(ctx));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -157,7 +269,7 @@ static PetscErrorCode MatDestroy_Shell(Mat A)
 PetscErrorCode STMatShellCreate(ST st,PetscScalar alpha,PetscInt nmat,PetscInt *matIdx,PetscScalar *coeffs,Mat *mat)
 {
   PetscInt       n,m,N,M,i;
-  PetscBool      has=PETSC_FALSE,hasA,hasB;
+  PetscBool      has=PETSC_FALSE,hasA,hasB,fused=PETSC_TRUE,flg;
   ST_MATSHELL    *ctx;
 
   PetscFunctionBegin;
@@ -179,8 +291,13 @@ PetscErrorCode STMatShellCreate(ST st,PetscScalar alpha,PetscInt nmat,PetscInt *
     for (i=0;i<ctx->nmat;i++) ctx->coeffs[i] = coeffs[i];
   }
   PetscCall(MatCreateVecs(st->A[0],&ctx->z,NULL));
+  for (i=0;i<ctx->nmat && fused;i++) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)st->A[ctx->matIdx[i]],MATSEQAIJ,&flg));
+    if (!flg) fused = PETSC_FALSE;
+  }
+  if (fused) PetscCall(PetscMalloc4(ctx->nmat,&ctx->ia,ctx->nmat,&ctx->ja,ctx->nmat,&ctx->va,ctx->nmat,&ctx->c));
   PetscCall(MatCreateShell(PetscObjectComm((PetscObject)st),m,n,M,N,(void*)ctx,mat));
-  PetscCall(MatShellSetOperation(*mat,MATOP_MULT,(void(*)(void))MatMult_Shell));
+  PetscCall(MatShellSetOperation(*mat,MATOP_MULT,fused?(void(*)(void))MatMult_Shell_SeqAIJ:(void(*)(void))MatMult_Shell));
   PetscCall(MatShellSetOperation(*mat,MATOP_MULT_TRANSPOSE,(void(*)(void))MatMultTranspose_Shell));
 #if defined(PETSC_USE_COMPLEX)
   PetscCall(MatShellSetOperation(*mat,MATOP_MULT_HERMITIAN_TRANSPOSE,(void(*)(void))MatMultHermitianTranspose_Shell));
@@ -178,6 +178,190 @@ PetscErrorCode STMatMultHermitianTranspose(ST st,PetscInt k,Vec x,Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatMultCombination_SeqAIJ - Computes py = sum_k coeff[k]*A[k]*px (or adds it to py),
+   where all A[k] are MATSEQAIJ with the same nonzero pattern; the row pointers and
+   column indices are traversed only once, taken from A[0]
+*/
+static PetscErrorCode MatMultCombination_SeqAIJ(PetscInt n,Mat *A,const PetscScalar *coeff,const PetscScalar *px,PetscScalar *py,PetscBool add)
+{
+  PetscInt          i,j,k,m,m1;
+  const PetscInt    *ia,*ja,*ia1,*ja1;
+  const PetscScalar **aa;
+  PetscScalar       s,v;
+  PetscBool         done;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetRowIJ(A[0],0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+  PetscCheck(done,PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot get the nonzero pattern of the matrix");
+  PetscCall(PetscMalloc1(n,&aa));
+  for (k=0;k<n;k++) {
+    if (k) {
+      PetscCall(MatGetRowIJ(A[k],0,PETSC_FALSE,PETSC_FALSE,&m1,&ia1,&ja1,&done));
+      PetscCheck(done && m1==m && ia1[m]==ia[m],PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"The matrices do not have the same nonzero pattern, use a different MatStructure in STSetMatStructure()");
+      PetscCall(MatRestoreRowIJ(A[k],0,PETSC_FALSE,PETSC_FALSE,&m1,&ia1,&ja1,&done));
+    }
+    PetscCall(MatSeqAIJGetArrayRead(A[k],&aa[k]));
+  }
+  for (i=0;i<m;i++) {
+    s = add? py[i]: 0.0;
+    for (j=ia[i];j<ia[i+1];j++) {
+      v = 0.0;
+      for (k=0;k<n;k++) v += coeff[k]*aa[k][j];
+      s += v*px[ja[j]];
+    }
+    py[i] = s;
+  }
+  PetscCall(PetscLogFlops(2.0*(n+1)*ia[m]));
+  for (k=0;k<n;k++) PetscCall(MatSeqAIJRestoreArrayRead(A[k],&aa[k]));
+  PetscCall(PetscFree(aa));
+  PetscCall(MatRestoreRowIJ(A[0],0,PETSC_FALSE,PETSC_FALSE,&m,&ia,&ja,&done));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   STMatMultCombination_Private - Computes y = sum_k coeff[k]*A[k]*x, where A[k]=NULL
+   means the identity matrix.
+
+   If the matrices have been declared to have the same nonzero pattern with
+   STSetMatStructure() and all of them are MATSEQAIJ or MATMPIAIJ, the combination
+   is computed in a single pass over the common pattern, so that the column indices
+   are read once instead of once per matrix. Otherwise, it falls back to one MatMult()
+   per matrix followed by an AXPY.
+*/
+PetscErrorCode STMatMultCombination_Private(ST st,PetscInt n,Mat *A,const PetscScalar *coeff,Vec x,Vec y)
+{
+  PetscInt          k,nf=0,nc;
+  PetscScalar       cid=0.0,*cf,*py;
+  const PetscScalar *px,*pg;
+  const PetscInt    *garray;
+  Mat               *F,*Fo,Ao;
+  PetscBool         fuse,seq,mpi,flg;
+  PetscObjectId     id;
+  PetscObjectState  nzstate;
+  IS                is;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc3(n,&F,n,&Fo,n,&cf));
+  for (k=0;k<n;k++) {
+    if (coeff[k]==0.0) continue;
+    if (!A[k]) cid += coeff[k];
+    else {
+      F[nf]  = A[k];
+      cf[nf] = coeff[k];
+      nf++;
+    }
+  }
+  fuse = (st->str==SAME_NONZERO_PATTERN && nf>1)? PETSC_TRUE: PETSC_FALSE;
+  seq = mpi = PETSC_FALSE;
+  if (fuse) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)F[0],MATSEQAIJ,&seq));
+    PetscCall(PetscObjectTypeCompare((PetscObject)F[0],MATMPIAIJ,&mpi));
+    fuse = (seq || mpi)? PETSC_TRUE: PETSC_FALSE;
+    for (k=1;k<nf && fuse;k++) {
+      PetscCall(PetscObjectTypeCompare((PetscObject)F[k],seq?MATSEQAIJ:MATMPIAIJ,&flg));
+      if (!flg) fuse = PETSC_FALSE;
+    }
+  }
+
+  if (!nf) PetscCall(VecSet(y,0.0));
+  else if (fuse && seq) {
+    PetscCall(VecGetArrayRead(x,&px));
+    PetscCall(VecGetArrayWrite(y,&py));
+    PetscCall(MatMultCombination_SeqAIJ(nf,F,cf,px,py,PETSC_FALSE));
+    PetscCall(VecRestoreArrayWrite(y,&py));
+    PetscCall(VecRestoreArrayRead(x,&px));
+  } else if (fuse) {
+    /* the ghost values are gathered with a scatter that is kept until the pattern of A[0] changes */
+    PetscCall(MatMPIAIJGetSeqAIJ(F[0],NULL,&Ao,&garray));
+    PetscCall(PetscObjectGetId((PetscObject)F[0],&id));
+    PetscCall(MatGetNonzeroState(F[0],&nzstate));
+    if (!st->sg || st->sgid!=id || st->sgstate!=nzstate) {
+      PetscCall(VecScatterDestroy(&st->sg));
+      PetscCall(VecDestroy(&st->wg));
+      PetscCall(MatGetSize(Ao,NULL,&nc));
+      PetscCall(ISCreateGeneral(PETSC_COMM_SELF,nc,garray,PETSC_COPY_VALUES,&is));
+      PetscCall(VecCreateSeq(PETSC_COMM_SELF,nc,&st->wg));
+      PetscCall(VecScatterCreate(x,is,st->wg,NULL,&st->sg));
+      PetscCall(ISDestroy(&is));
+      st->sgid    = id;
+      st->sgstate = nzstate;
+    }
+    PetscCall(VecScatterBegin(st->sg,x,st->wg,INSERT_VALUES,SCATTER_FORWARD));
+    for (k=0;k<nf;k++) PetscCall(MatMPIAIJGetSeqAIJ(F[k],&F[k],&Fo[k],NULL));
+    PetscCall(VecGetArrayRead(x,&px));
+    PetscCall(VecGetArrayWrite(y,&py));
+    PetscCall(MatMultCombination_SeqAIJ(nf,F,cf,px,py,PETSC_FALSE));
+    PetscCall(VecRestoreArrayRead(x,&px));
+    PetscCall(VecScatterEnd(st->sg,x,st->wg,INSERT_VALUES,SCATTER_FORWARD));
+    PetscCall(VecGetArrayRead(st->wg,&pg));
+    PetscCall(MatMultCombination_SeqAIJ(nf,Fo,cf,pg,py,PETSC_TRUE));
+    PetscCall(VecRestoreArrayRead(st->wg,&pg));
+    PetscCall(VecRestoreArrayWrite(y,&py));
+  } else {
+    PetscCall(MatMult(F[0],x,y));
+    if (cf[0]!=1.0) PetscCall(VecScale(y,cf[0]));
+    if (nf>1 && !st->wc) PetscCall(MatCreateVecs(F[0],NULL,&st->wc));
+    for (k=1;k<nf;k++) {
+      PetscCall(MatMult(F[k],x,st->wc));
+      PetscCall(VecAXPY(y,cf[k],st->wc));
+    }
+  }
+  if (cid!=0.0) PetscCall(VecAXPY(y,cid,x));
+  PetscCall(PetscFree3(F,Fo,cf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STMatMultCombination - Computes the linear combination of matrix-vector
+   products y = sum_k coeff[k] T[k] x, where T[k] are the matrices of the
+   spectral transformation.
+
+   Neighbor-wise Collective
+
+   Input Parameters:
++  st    - the spectral transformation context
+.  n     - number of matrices to combine, T[0],...,T[n-1]
+.  coeff - the coefficients of the combination (array of length n)
+-  x     - the vector to be multiplied
+
+   Output Parameter:
+.  y - the result
+
+   Notes:
+   Terms with a zero coefficient are skipped. If the matrices have been declared
+   to share the nonzero pattern with STSetMatStructure(st,SAME_NONZERO_PATTERN)
+   and they are of type MATSEQAIJ or MATMPIAIJ, the result is computed in a single
+   traversal of the common pattern, which reduces the memory traffic with
+   respect to computing each product separately. In other cases, this is
+   equivalent to calling STMatMult() for each matrix and combining the results.
+
+   Level: developer
+
+.seealso: STMatMult(), STSetMatStructure()
+@*/
+PetscErrorCode STMatMultCombination(ST st,PetscInt n,const PetscScalar coeff[],Vec x,Vec y)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveInt(st,n,2);
+  PetscAssertPointer(coeff,3);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,4);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,5);
+  STCheckMatrices(st,1);
+  PetscCheck(n>0 && n<=PetscMax(2,st->nmat),PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_OUTOFRANGE,"n must be between 1 and %" PetscInt_FMT,PetscMax(2,st->nmat));
+  PetscCheck(x!=y,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_IDN,"x and y must be different vectors");
+  PetscCall(VecSetErrorIfLocked(y,5));
+
+  if (st->state!=ST_STATE_SETUP) PetscCall(STSetUp(st));
+  PetscCall(VecLockReadPush(x));
+  PetscCall(PetscLogEventBegin(ST_MatMult,st,x,y,0));
+  PetscCall(STMatMultCombination_Private(st,n,st->T,coeff,x,y));
+  PetscCall(PetscLogEventEnd(ST_MatMult,st,x,y,0));
+  PetscCall(VecLockReadPop(x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    STMatSolve - Solves P x = b, where P is the preconditioner matrix of
    the spectral transformation, using a KSP object stored internally.
@@ -350,6 +534,224 @@ PetscErrorCode STCheckFactorPackage(ST st)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode STResetInertia_Private(ST st)
+{
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&st->Fi));
+  PetscCall(MatDestroy(&st->Si));
+  PetscCall(MatDestroyMatrices(2,&st->Ai));
+  PetscCall(PetscSubcommDestroy(&st->isubc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Gets the inertia from the factorization computed by the linear solver,
+   provided that it corresponds to the requested shift
+*/
+static PetscErrorCode STGetInertia_KSP(ST st,PetscReal shift,PetscInt *inertia,PetscInt *zeros,PetscBool *done)
+{
+  KSP            kspr;
+  PC             pc;
+  Mat            F;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  if (st->state!=ST_STATE_SETUP || !st->P || !st->ksp || st->Pmat || st->Psplit || st->sigma!=(PetscScalar)shift) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)st,&flg,STSINVERT,STCAYLEY,""));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(KSPGetPC(st->ksp,&pc));
+  PetscCall(PetscObjectTypeCompare((PetscObject)pc,PCREDUNDANT,&flg));
+  if (flg) {
+    PetscCall(PCRedundantGetKSP(pc,&kspr));
+    PetscCall(KSPGetPC(kspr,&pc));
+  }
+  PetscCall(PetscObjectTypeCompare((PetscObject)pc,PCCHOLESKY,&flg));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PCFactorGetMatrix(pc,&F));
+  PetscCall(MatGetInertia(F,inertia,zeros,NULL));
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the inertia of Ai[0]-shift*Ai[1] with a factorization that is used
+   only for this purpose. The nonzero pattern of Si and the symbolic factorization
+   are computed in the first call only
+*/
+static PetscErrorCode STGetInertia_Factor(ST st,PetscReal shift,PetscInt *inertia,PetscInt *zeros)
+{
+  KSP            kspr;
+  PC             pc;
+  PetscBool      flg;
+  PetscMPIInt    size;
+  MatSolverType  stype=NULL;
+  MatFactorInfo  info;
+  IS             row,col;
+
+  PetscFunctionBegin;
+  if (!st->Si) {
+    PetscCall(MatDuplicate(st->Ai[0],MAT_COPY_VALUES,&st->Si));
+    if (st->Ai[1]) PetscCall(MatAXPY(st->Si,1.0,st->Ai[1],st->str));
+    else PetscCall(MatShift(st->Si,1.0));
+#if defined(PETSC_USE_COMPLEX)
+    PetscCall(MatSetOption(st->Si,MAT_HERMITIAN,PETSC_TRUE));
+#else
+    PetscCall(MatSetOption(st->Si,MAT_SYMMETRIC,PETSC_TRUE));
+#endif
+  }
+  PetscCall(MatCopy(st->Ai[0],st->Si,SUBSET_NONZERO_PATTERN));
+  if (st->Ai[1]) PetscCall(MatAXPY(st->Si,-shift,st->Ai[1],SUBSET_NONZERO_PATTERN));
+  else PetscCall(MatShift(st->Si,-shift));
+
+  PetscCall(MatFactorInfoInitialize(&info));
+  if (!st->Fi) {
+    /* use the same package as the linear solver, if it is a factorization */
+    if (st->ksp) {
+      PetscCall(KSPGetPC(st->ksp,&pc));
+      PetscCall(PetscObjectTypeCompare((PetscObject)pc,PCREDUNDANT,&flg));
+      if (flg) {
+        PetscCall(PCRedundantGetKSP(pc,&kspr));
+        PetscCall(KSPGetPC(kspr,&pc));
+      }
+      PetscCall(PCFactorGetMatSolverType(pc,&stype));
+    }
+    if (!stype) {
+      PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)st->Si),&size));
+      stype = (size==1)? MATSOLVERPETSC: MATSOLVERMUMPS;
+    }
+    PetscCall(MatGetFactor(st->Si,stype,MAT_FACTOR_CHOLESKY,&st->Fi));
+    PetscCall(MatSetOptionsPrefix(st->Fi,((PetscObject)st)->prefix));
+    PetscCall(MatAppendOptionsPrefix(st->Fi,"st_inertia_"));
+#if defined(PETSC_HAVE_MUMPS)
+    PetscCall(PetscStrcmp(stype,MATSOLVERMUMPS,&flg));
+    if (flg) {
+      PetscCall(MatMumpsSetIcntl(st->Fi,13,1));  /* inertia of the whole matrix in parallel */
+      PetscCall(MatMumpsSetIcntl(st->Fi,24,1));  /* detection of null pivots */
+      PetscCall(MatMumpsSetIcntl(st->Fi,31,1));  /* the factors are discarded */
+    }
+#endif
+    PetscCall(MatGetOrdering(st->Si,MATORDERINGNATURAL,&row,&col));
+    PetscCall(MatCholeskyFactorSymbolic(st->Fi,st->Si,row,&info));
+    PetscCall(ISDestroy(&row));
+    PetscCall(ISDestroy(&col));
+  }
+  PetscCall(MatCholeskyFactorNumeric(st->Fi,st->Si,&info));
+  PetscCall(MatGetInertia(st->Fi,inertia,zeros,NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   STGetInertia - Computes the inertia of the matrix A-sigma*B for several
+   values of sigma.
+
+   Collective
+
+   Input Parameters:
++  st     - the spectral transformation context
+.  n      - number of shifts
+-  shifts - the values of the shifts
+
+   Output Parameters:
++  inertia - the number of negative eigenvalues of A-sigma*B for each shift
+-  zeros   - the number of zero eigenvalues of A-sigma*B for each shift (optional)
+
+   Notes:
+   The matrices must be Hermitian. The inertia is obtained from an LDL^T
+   factorization. If a shift coincides with the current shift of a shift-and-invert
+   or Cayley transformation whose linear solver is a Cholesky factorization, then
+   this factorization is used and nothing else is computed. Otherwise, a separate
+   factorization is computed that is used only for counting: the symbolic
+   factorization is computed once and reused for all shifts, and with MUMPS the
+   factors are discarded after the factorization (ICNTL(31)), so the memory
+   footprint is smaller and the solve phase is skipped. The linear solver of the
+   ST is not modified. The package is the one of the linear solver of the ST, if
+   it is a factorization, and it can be configured with options with the
+   prefix -st_inertia_, e.g., -st_inertia_mat_mumps_icntl_14.
+
+   If the number of partitions set with STSetInertiaPartitions() is larger than
+   one, the shifts are distributed among the subcommunicators and computed
+   concurrently.
+
+   Infinite values of the shifts are allowed, with inertia equal to 0 for
+   PETSC_MIN_REAL and equal to the matrix dimension for PETSC_MAX_REAL.
+
+   Level: developer
+
+.seealso: STSetInertiaPartitions(), MatGetInertia()
+@*/
+PetscErrorCode STGetInertia(ST st,PetscInt n,const PetscReal shifts[],PetscInt inertia[],PetscInt zeros[])
+{
+  PetscInt         i,j,N,*iz;
+  PetscMPIInt      color=0,len;
+  PetscBool        done;
+  PetscObjectState state;
+  MPI_Comm         child;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveInt(st,n,2);
+  STCheckMatrices(st,1);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(shifts,3);
+  PetscAssertPointer(inertia,4);
+  PetscCheck(st->nmat<=2,PetscObjectComm((PetscObject)st),PETSC_ERR_SUP,"Inertia is only available for linear eigenproblems");
+  PetscCall(MatGetSize(st->A[0],&N,NULL));
+
+  /* discard the copies of the matrices if they have been modified */
+  if (st->Ai) {
+    for (j=0;j<st->nmat;j++) {
+      PetscCall(PetscObjectStateGet((PetscObject)st->A[j],&state));
+      if (state!=st->istate[j]) break;
+    }
+    if (j<st->nmat) PetscCall(STResetInertia_Private(st));
+  }
+  if (!st->Ai) {
+    PetscCall(PetscCalloc1(2,&st->Ai));
+    if (st->inpart>1) {
+      PetscCall(PetscSubcommCreate(PetscObjectComm((PetscObject)st),&st->isubc));
+      PetscCall(PetscSubcommSetNumber(st->isubc,st->inpart));
+      PetscCall(PetscSubcommSetType(st->isubc,PETSC_SUBCOMM_CONTIGUOUS));
+      PetscCall(PetscSubcommGetChild(st->isubc,&child));
+      for (j=0;j<st->nmat;j++) PetscCall(MatCreateRedundantMatrix(st->A[j],st->inpart,child,MAT_INITIAL_MATRIX,&st->Ai[j]));
+    } else {
+      for (j=0;j<st->nmat;j++) {
+        PetscCall(PetscObjectReference((PetscObject)st->A[j]));
+        st->Ai[j] = st->A[j];
+      }
+    }
+    for (j=0;j<st->nmat;j++) PetscCall(PetscObjectStateGet((PetscObject)st->A[j],&st->istate[j]));
+  }
+  if (st->isubc) color = st->isubc->color;
+
+  /* each partition handles the shifts i such that mod(i,npart)=color */
+  PetscCall(PetscMalloc1(2*n,&iz));
+  for (i=0;i<n;i++) {
+    iz[i] = -1; iz[n+i] = -1;
+    if (i%st->inpart != color) continue;
+    if (shifts[i] >= PETSC_MAX_REAL) {
+      iz[i] = N; iz[n+i] = 0;
+    } else if (shifts[i] <= PETSC_MIN_REAL) {
+      iz[i] = 0; iz[n+i] = 0;
+    } else {
+      done = PETSC_FALSE;
+      if (st->inpart==1) PetscCall(STGetInertia_KSP(st,shifts[i],iz+i,iz+n+i,&done));
+      if (!done) PetscCall(STGetInertia_Factor(st,shifts[i],iz+i,iz+n+i));
+    }
+  }
+  if (st->inpart>1) {
+    PetscCall(PetscMPIIntCast(2*n,&len));
+    PetscCallMPI(MPIU_Allreduce(MPI_IN_PLACE,iz,len,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)st)));
+  }
+  for (i=0;i<n;i++) {
+    inertia[i] = iz[i];
+    if (zeros) zeros[i] = iz[n+i];
+    PetscCall(PetscInfo(st,"Computed inertia at shift %g: %" PetscInt_FMT "\n",(double)shifts[i],inertia[i]));
+  }
+  PetscCall(PetscFree(iz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    STSetKSP - Sets the KSP object associated with the spectral
    transformation.
@@ -410,6 +812,40 @@ PetscErrorCode STGetKSP(ST st,KSP* ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   STUpdateInnerTolerance - Adapts the tolerance of the linear solver to the
+   residual of the eigensolver, if so requested with STSetAdaptiveInnerTolerance().
+
+   Logically Collective
+
+   Input Parameters:
++  st  - the spectral transformation context
+-  res - the (relative) residual norm of the first unconverged eigenpair
+
+   Notes:
+   This function is intended to be called by the eigensolver at each restart.
+   The relative tolerance of the KSP is set to 0.01*res, bounded above by 0.01
+   and below by the tolerance set by the user.
+
+   Level: developer
+
+.seealso: STSetAdaptiveInnerTolerance()
+@*/
+PetscErrorCode STUpdateInnerTolerance(ST st,PetscReal res)
+{
+  PetscReal rtol;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(st,ST_CLASSID,1);
+  PetscValidLogicalCollectiveReal(st,res,2);
+  if (!st->adapttol || !st->usesksp || !st->ksp || !(res>0.0)) PetscFunctionReturn(PETSC_SUCCESS);
+  if (st->ksprtol==0.0) PetscCall(KSPGetTolerances(st->ksp,&st->ksprtol,NULL,NULL,NULL));
+  rtol = PetscMax(st->ksprtol,PetscMin(0.01*res,0.01));
+  PetscCall(KSPSetTolerances(st->ksp,rtol,PETSC_CURRENT,PETSC_CURRENT,PETSC_CURRENT));
+  PetscCall(PetscInfo(st,"Setting the tolerance of the linear solver to %g (outer residual %g)\n",(double)rtol,(double)res));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode STCheckNullSpace_Default(ST st,BV V)
 {
   PetscInt       nc,i,c;
@@ -87,12 +87,23 @@ PetscErrorCode STApplyMat_Generic(ST st,Mat B,Mat C)
    Output Parameter:
 .  Y - output matrix
 
+   Notes:
+   The matrices X and Y must be dense. For the spectral transformations that
+   are expressed as inv(K)*M, the product by M is computed with MatMatMult()
+   and the solve with K uses KSPMatSolve(), so that all columns are processed
+   at once, e.g., with the multiple right-hand side triangular solves of a
+   direct solver. When balancing is active or the ST type does not provide a
+   block operation, the operator is applied one column at a time.
+
    Level: developer
 
-.seealso: STApply()
+.seealso: STApply(), STMatMatSolve()
 @*/
 PetscErrorCode STApplyMat(ST st,Mat X,Mat Y)
 {
+  PetscInt       j,n;
+  Vec            x,y;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(st,ST_CLASSID,1);
   PetscValidHeaderSpecific(X,MAT_CLASSID,2);
@@ -100,7 +111,21 @@ PetscErrorCode STApplyMat(ST st,Mat X,Mat Y)
   PetscValidType(st,1);
   STCheckMatrices(st,1);
   PetscCheck(X!=Y,PetscObjectComm((PetscObject)st),PETSC_ERR_ARG_IDN,"X and Y must be different matrices");
-  PetscUseTypeMethod(st,applymat,X,Y);
+  if (!st->D && st->ops->applymat) {
+    PetscCall(STSetUp(st));
+    PetscCall(PetscLogEventBegin(ST_Apply,st,X,Y,0));
+    PetscUseTypeMethod(st,applymat,X,Y);
+    PetscCall(PetscLogEventEnd(ST_Apply,st,X,Y,0));
+  } else {  /* fall back to applying the operator one column at a time */
+    PetscCall(MatGetSize(X,NULL,&n));
+    for (j=0;j<n;j++) {
+      PetscCall(MatDenseGetColumnVecRead(X,j,&x));
+      PetscCall(MatDenseGetColumnVecWrite(Y,j,&y));
+      PetscCall(STApply(st,x,y));
+      PetscCall(MatDenseRestoreColumnVecWrite(Y,j,&y));
+      PetscCall(MatDenseRestoreColumnVecRead(X,j,&x));
+    }
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -316,7 +341,7 @@ static PetscErrorCode MatMatMult_STOperator(Mat Op,Mat B,Mat C,void *ctx)
   PetscCall(MatShellGetContext(Op,&st));
   PetscCall(STSetUp(st));
   PetscCall(PetscLogEventBegin(ST_Apply,st,B,C,0));
-  PetscCall(STApplyMat_Generic(st,B,C));
+  PetscUseTypeMethod(st,applymat,B,C);
   PetscCall(PetscLogEventEnd(ST_Apply,st,B,C,0));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -341,7 +366,7 @@ PetscErrorCode STGetOperator_Private(ST st,Mat *Op)
 #else
     PetscCall(MatShellSetOperation(st->Op,MATOP_MULT_HERMITIAN_TRANSPOSE,(void(*)(void))MatMultTranspose_STOperator));
 #endif
-    if (!st->D && st->ops->apply==STApply_Generic) {
+    if (!st->D && st->ops->applymat) {
       PetscCall(MatShellSetMatProductOperation(st->Op,MATPRODUCT_AB,NULL,MatMatMult_STOperator,NULL,MATDENSE,MATDENSE));
       PetscCall(MatShellSetMatProductOperation(st->Op,MATPRODUCT_AB,NULL,MatMatMult_STOperator,NULL,MATDENSECUDA,MATDENSECUDA));
       PetscCall(MatShellSetMatProductOperation(st->Op,MATPRODUCT_AB,NULL,MatMatMult_STOperator,NULL,MATDENSEHIP,MATDENSEHIP));
@@ -559,18 +584,27 @@ PetscErrorCode STSetUp(ST st)
    coeffs - coefficients of the expansion
    initial - true if this is the first time
    precond - whether the preconditioner matrix must be computed
+
+   In shell mode, the preconditioner matrix is assembled explicitly from the
+   split matrices as in copy mode, so that it can be used by any preconditioner
+
+   In copy mode, when S is rebuilt keeping its pattern, the values are copied
+   to S with operations that the matrix type can do in place, so that device
+   matrices (e.g., MATAIJCUSPARSE) are updated on the device without going
+   through the host
 */
 PetscErrorCode STMatMAXPY_Private(ST st,PetscScalar alpha,PetscScalar beta,PetscInt k,PetscScalar *coeffs,PetscBool initial,PetscBool precond,Mat *S)
 {
   PetscInt       *matIdx=NULL,nmat,i,ini=-1;
   PetscScalar    t=1.0,ta,gamma;
-  PetscBool      nz=PETSC_FALSE;
+  PetscBool      nz=PETSC_FALSE,oncpu;
   Mat            *A=precond?st->Psplit:st->A;
-  MatStructure   str=precond?st->strp:st->str;
+  MatStructure   str=precond?st->strp:st->str,stra;
+  STMatMode      matmode=(precond && st->matmode==ST_MATMODE_SHELL)?ST_MATMODE_COPY:st->matmode;
 
   PetscFunctionBegin;
   nmat = st->nmat-k;
-  switch (st->matmode) {
+  switch (matmode) {
   case ST_MATMODE_INPLACE:
     PetscCheck(st->nmat<=2,PetscObjectComm((PetscObject)st),PETSC_ERR_SUP,"ST_MATMODE_INPLACE not supported for polynomial eigenproblems");
     PetscCheck(!precond,PetscObjectComm((PetscObject)st),PETSC_ERR_SUP,"ST_MATMODE_INPLACE not supported for split preconditioner");
@@ -585,7 +619,6 @@ PetscErrorCode STMatMAXPY_Private(ST st,PetscScalar alpha,PetscScalar beta,Petsc
     }
     break;
   case ST_MATMODE_SHELL:
-    PetscCheck(!precond,PetscObjectComm((PetscObject)st),PETSC_ERR_SUP,"ST_MATMODE_SHELL not supported for split preconditioner");
     if (initial) {
       if (st->nmat>2) {
         PetscCall(PetscMalloc1(nmat,&matIdx));
@@ -609,9 +642,19 @@ PetscErrorCode STMatMAXPY_Private(ST st,PetscScalar alpha,PetscScalar beta,Petsc
       PetscCall(MatDestroy(S));
       *S = A[k+ini];
     } else {
+      stra = str;
       if (*S && *S!=A[k+ini]) {
         PetscCall(MatSetOption(*S,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE));
-        PetscCall(MatCopy(A[k+ini],*S,DIFFERENT_NONZERO_PATTERN));
+        /* S was built from the same matrices with nonzero coefficients, so its pattern
+           contains all of them; keeping it allows reusing the symbolic factorization */
+        if (str!=SAME_NONZERO_PATTERN && !initial && st->state!=ST_STATE_UPDATED && (st->nmat<=2 || beta!=0.0)) stra = SUBSET_NONZERO_PATTERN;
+        PetscCall(MatBoundToCPU(*S,&oncpu));
+        if (str==SAME_NONZERO_PATTERN && st->nmat>1) PetscCall(MatCopy(A[k+ini],*S,SAME_NONZERO_PATTERN));
+        else if (stra==SUBSET_NONZERO_PATTERN && !oncpu) {
+          /* MatCopy() with different pattern would set the values one by one on the host */
+          PetscCall(MatZeroEntries(*S));
+          PetscCall(MatAXPY(*S,1.0,A[k+ini],SUBSET_NONZERO_PATTERN));
+        } else PetscCall(MatCopy(A[k+ini],*S,DIFFERENT_NONZERO_PATTERN));
       } else {
         PetscCall(MatDestroy(S));
         PetscCall(MatDuplicate(A[k+ini],MAT_COPY_VALUES,S));
@@ -623,7 +666,7 @@ PetscErrorCode STMatMAXPY_Private(ST st,PetscScalar alpha,PetscScalar beta,Petsc
         ta = t;
         if (coeffs) ta *= coeffs[i-k];
         if (ta!=0.0) {
-          if (st->nmat>1) PetscCall(MatAXPY(*S,ta,A[i],str));
+          if (st->nmat>1) PetscCall(MatAXPY(*S,ta,A[i],stra));
           else PetscCall(MatShift(*S,ta));
         }
       }
@@ -674,6 +717,10 @@ PetscErrorCode STPostSolve(ST st)
   PetscValidHeaderSpecific(st,ST_CLASSID,1);
   PetscValidType(st,1);
   PetscTryTypeMethod(st,postsolve);
+  if (st->ksprtol>0.0) {  /* restore the tolerance modified by STUpdateInnerTolerance() */
+    PetscCall(KSPSetTolerances(st->ksp,st->ksprtol,PETSC_CURRENT,PETSC_CURRENT,PETSC_CURRENT));
+    st->ksprtol = 0.0;
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -753,19 +800,42 @@ PetscErrorCode STIsInjective(ST st,PetscBool* is)
     else         st->P = Sum_{i=0..nmat-1} sigma^i*A_i
 .ve
 
+   In ST_MATMODE_COPY, if st->P was built in a previous call with the same
+   matrices, its values are updated keeping the nonzero pattern, so that the
+   symbolic factorization of the linear solver (e.g., the analysis phase of
+   MUMPS) is reused for all values of sigma.
+
    Level: developer
 
 .seealso: STMatSolve()
 @*/
 PetscErrorCode STMatSetUp(ST st,PetscScalar sigma,PetscScalar *coeffs)
 {
+  PetscInt         i;
+  PetscObjectId    id;
+  PetscObjectState nzstate;
+  MatStructure     str=st->str;
+  PetscBool        own=PETSC_TRUE;
+
   PetscFunctionBegin;
   PetscValidHeaderSpecific(st,ST_CLASSID,1);
   PetscValidLogicalCollectiveScalar(st,sigma,2);
   STCheckMatrices(st,1);
 
   PetscCall(PetscLogEventBegin(ST_MatSetUp,st,0,0,0));
+  /* P built in a previous call contains the pattern of all the matrices, keep it */
+  if (st->P && st->matmode==ST_MATMODE_COPY && st->state!=ST_STATE_UPDATED && st->str!=SAME_NONZERO_PATTERN) {
+    PetscCall(PetscObjectGetId((PetscObject)st->P,&id));
+    PetscCall(MatGetNonzeroState(st->P,&nzstate));
+    if (id==st->Pid && nzstate==st->Pstate) st->str = SUBSET_NONZERO_PATTERN;
+  }
   PetscCall(STMatMAXPY_Private(st,sigma,0.0,0,coeffs,PETSC_TRUE,PETSC_FALSE,&st->P));
+  st->str = str;
+  for (i=0;i<st->nmat;i++) if (st->P==st->A[i]) own = PETSC_FALSE;
+  if (own) {
+    PetscCall(PetscObjectGetId((PetscObject)st->P,&st->Pid));
+    PetscCall(MatGetNonzeroState(st->P,&st->Pstate));
+  } else st->Pid = 0;
   if (st->Psplit) PetscCall(STMatMAXPY_Private(st,sigma,0.0,0,coeffs,PETSC_TRUE,PETSC_TRUE,&st->Pmat));
   PetscCall(ST_KSPSetOperators(st,st->P,st->Pmat?st->Pmat:st->P));
   PetscCall(KSPSetUp(st->ksp));
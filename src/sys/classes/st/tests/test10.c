@@ -0,0 +1,81 @@
+/*
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+   SLEPc - Scalable Library for Eigenvalue Problem Computations
+   Copyright (c) 2002-, Universitat Politecnica de Valencia, Spain
+
+   This file is part of SLEPc.
+   SLEPc is distributed under a 2-clause BSD license (see LICENSE).
+   - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+*/
+
+static char help[] = "Test STGetInertia() with the 1-D Laplacian.\n\n"
+  "The command line options are:\n"
+  "  -n <n>, where <n> = matrix dimension.\n\n";
+
+#include <slepcst.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  ST             st;
+  PetscInt       n=20,i,k,Istart,Iend,inertia[5],zeros[5],exact;
+  PetscReal      shifts[5] = {PETSC_MIN_REAL,0.5,1.1,2.5,4.5};
+  PetscBool      ok=PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
+  PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n1-D Laplacian, n=%" PetscInt_FMT "\n\n",n));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD,&A));
+  PetscCall(MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatGetOwnershipRange(A,&Istart,&Iend));
+  for (i=Istart;i<Iend;i++) {
+    if (i>0) PetscCall(MatSetValue(A,i,i-1,-1.0,INSERT_VALUES));
+    if (i<n-1) PetscCall(MatSetValue(A,i,i+1,-1.0,INSERT_VALUES));
+    PetscCall(MatSetValue(A,i,i,2.0,INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY));
+  PetscCall(MatSetOption(A,MAT_SYMMETRIC,PETSC_TRUE));
+
+  PetscCall(STCreate(PETSC_COMM_WORLD,&st));
+  PetscCall(STSetMatrices(st,1,&A));
+  PetscCall(STSetFromOptions(st));
+  PetscCall(STSetUp(st));
+
+  /* compare with the number of eigenvalues 2-2*cos(k*pi/(n+1)) below each shift */
+  PetscCall(STGetInertia(st,5,shifts,inertia,zeros));
+  for (i=0;i<5;i++) {
+    exact = 0;
+    for (k=1;k<=n;k++) if (2.0-2.0*PetscCosReal(k*PETSC_PI/(n+1))<shifts[i]) exact++;
+    if (inertia[i]!=exact || zeros[i]) ok = PETSC_FALSE;
+  }
+  if (ok) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Computed inertias are correct\n"));
+  else {
+    for (i=0;i<5;i++) PetscCall(PetscPrintf(PETSC_COMM_WORLD,"Inertia at shift %g: %" PetscInt_FMT " (zeros %" PetscInt_FMT ")\n",(double)shifts[i],inertia[i],zeros[i]));
+  }
+
+  PetscCall(STDestroy(&st));
+  PetscCall(MatDestroy(&A));
+  PetscCall(SlepcFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/test10_1.out
+      requires: !single
+      test:
+         suffix: 1
+      test:
+         suffix: 1_sinvert
+         args: -st_type sinvert -st_ksp_type preonly -st_pc_type cholesky -st_shift 1.1
+      test:
+         suffix: 1_partitions
+         nsize: 2
+         args: -st_inertia_partitions 2
+
+TEST*/
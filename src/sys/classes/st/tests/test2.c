@@ -8,7 +8,9 @@
    - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 */
 
-static char help[] = "Test ST with one matrix.\n\n";
+static char help[] = "Test ST with one matrix.\n\n"
+  "The command line options are:\n"
+  "  -cache, to keep the factorizations of several shifts in STSINVERT.\n\n";
 
 #include <slepcst.h>
 
@@ -20,12 +22,13 @@ int main(int argc,char **argv)
   STType         type;
   PetscScalar    sigma,tau,val;
   PetscInt       n=10,i,Istart,Iend;
-  PetscBool      test_compl=PETSC_FALSE;
+  PetscBool      test_compl=PETSC_FALSE,cache=PETSC_FALSE;
 
   PetscFunctionBeginUser;
   PetscCall(SlepcInitialize(&argc,&argv,NULL,help));
   PetscCall(PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL));
   PetscCall(PetscOptionsGetBool(NULL,NULL,"-complex",&test_compl,NULL));
+  PetscCall(PetscOptionsGetBool(NULL,NULL,"-cache",&cache,NULL));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"\n1-D Laplacian, n=%" PetscInt_FMT "\n\n",n));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -95,6 +98,7 @@ int main(int argc,char **argv)
   /* sinvert, sigma=0.1 */
   PetscCall(STPostSolve(st));   /* undo changes if inplace */
   PetscCall(STSetType(st,STSINVERT));
+  if (cache) PetscCall(STSinvertSetShiftCache(st,2));
   PetscCall(STGetType(st,&type));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"ST type %s\n",type));
   PetscCall(STGetShift(st,&sigma));
@@ -105,6 +109,10 @@ int main(int argc,char **argv)
   /* sinvert, sigma=-0.5 */
   sigma = -0.5;
   PetscCall(STSetShift(st,sigma));
+  if (cache) {  /* go back and forth, both factorizations are reused */
+    PetscCall(STSetShift(st,0.1));
+    PetscCall(STSetShift(st,sigma));
+  }
   PetscCall(STGetShift(st,&sigma));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g\n",(double)PetscRealPart(sigma)));
   PetscCall(STApply(st,v,w));
@@ -177,6 +185,12 @@ int main(int argc,char **argv)
       args: -st_matmode {{copy inplace shell}}
       requires: !single
 
+   test:
+      suffix: 1_cache
+      args: -st_matmode copy -cache
+      output_file: output/test2_1.out
+      requires: !single
+
    test:
       suffix: 2
       args: -complex -st_matmode {{copy inplace shell}}
@@ -12,6 +12,40 @@ static char help[] = "Test ST with two matrices.\n\n";
 
 #include <slepcst.h>
 
+/*
+   Check that STApplyMat() on a block of copies of v gives the same result w as STApply()
+*/
+PetscErrorCode CheckApplyMat(ST st,Vec v,Vec w)
+{
+  Mat         X,Y;
+  Vec         x,y;
+  PetscInt    j,k=3,nloc,N;
+  PetscReal   nrm,err;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecGetLocalSize(v,&nloc));
+  PetscCall(VecGetSize(v,&N));
+  PetscCall(MatCreateDense(PetscObjectComm((PetscObject)v),nloc,PETSC_DECIDE,N,k,NULL,&X));
+  PetscCall(MatDuplicate(X,MAT_DO_NOT_COPY_VALUES,&Y));
+  for (j=0;j<k;j++) {
+    PetscCall(MatDenseGetColumnVecWrite(X,j,&x));
+    PetscCall(VecCopy(v,x));
+    PetscCall(MatDenseRestoreColumnVecWrite(X,j,&x));
+  }
+  PetscCall(STApplyMat(st,X,Y));
+  PetscCall(VecNorm(w,NORM_2,&nrm));
+  for (j=0;j<k;j++) {
+    PetscCall(MatDenseGetColumnVec(Y,j,&y));
+    PetscCall(VecAXPY(y,-1.0,w));
+    PetscCall(VecNorm(y,NORM_2,&err));
+    PetscCall(MatDenseRestoreColumnVec(Y,j,&y));
+    PetscCheck(err<100*PETSC_MACHINE_EPSILON*nrm,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"STApplyMat() and STApply() differ in column %" PetscInt_FMT,j);
+  }
+  PetscCall(MatDestroy(&X));
+  PetscCall(MatDestroy(&Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 int main(int argc,char **argv)
 {
   Mat            A,B,M,mat[2];
@@ -74,6 +108,7 @@ int main(int argc,char **argv)
   PetscCall(STGetType(st,&type));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"ST type %s\n",type));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* shift, sigma=0.1 */
@@ -82,6 +117,7 @@ int main(int argc,char **argv)
   PetscCall(STGetShift(st,&sigma));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g\n",(double)PetscRealPart(sigma)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* sinvert, sigma=0.1 */
@@ -92,6 +128,7 @@ int main(int argc,char **argv)
   PetscCall(STGetShift(st,&sigma));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g\n",(double)PetscRealPart(sigma)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* sinvert, sigma=-0.5 */
@@ -100,6 +137,7 @@ int main(int argc,char **argv)
   PetscCall(STGetShift(st,&sigma));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g\n",(double)PetscRealPart(sigma)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* cayley, sigma=-0.5, tau=-0.5 (equal to sigma by default) */
@@ -112,6 +150,7 @@ int main(int argc,char **argv)
   PetscCall(STCayleyGetAntishift(st,&tau));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g, antishift=%g\n",(double)PetscRealPart(sigma),(double)PetscRealPart(tau)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* cayley, sigma=1.1, tau=1.1 (still equal to sigma) */
@@ -121,6 +160,7 @@ int main(int argc,char **argv)
   PetscCall(STCayleyGetAntishift(st,&tau));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g, antishift=%g\n",(double)PetscRealPart(sigma),(double)PetscRealPart(tau)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* cayley, sigma=1.1, tau=-1.0 */
@@ -130,6 +170,7 @@ int main(int argc,char **argv)
   PetscCall(STCayleyGetAntishift(st,&tau));
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"With shift=%g, antishift=%g\n",(double)PetscRealPart(sigma),(double)PetscRealPart(tau)));
   PetscCall(STApply(st,v,w));
+  PetscCall(CheckApplyMat(st,v,w));
   PetscCall(VecView(w,NULL));
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -156,4 +197,10 @@ int main(int argc,char **argv)
       args: -st_matmode {{copy inplace shell}}
       requires: !single
 
+   test:
+      suffix: 1_cuda
+      args: -st_matmode copy -mat_type aijcusparse -st_pc_factor_mat_solver_type cusparse
+      output_file: output/test3_1.out
+      requires: cuda !single
+
 TEST*/
@@ -144,4 +144,10 @@ int main(int argc,char **argv)
       args: -st_type {{cayley shift sinvert}separate output}
       requires: !single
 
+   test:
+      suffix: 1_shell
+      args: -st_type sinvert -st_matmode shell -ksp_rtol 1e-12
+      output_file: output/test8_1_st_type-sinvert.out
+      requires: !single
+
 TEST*/
@@ -13,6 +13,7 @@
 #include <slepcfn.h>
 #include <slepcbv.h>
 #include <slepcrg.h>
+#include <slepc/private/slepcimpl.h>
 
 #if defined(PETSC_HAVE_DYNAMIC_LIBRARIES)
 
@@ -29,7 +30,8 @@ SLEPC_EXTERN PetscErrorCode PetscDLLibraryRegister_slepclme(void);
   PetscDLLibraryRegister - This function is called when the dynamic library
   it is in is opened.
 
-  This one registers all the basic objects ST, FN, DS, BV, RG.
+  This one registers all the basic objects ST, FN, DS, BV, RG, and in the case
+  of a single library also the solver packages selected with -library_preload_packages.
  */
 #if defined(PETSC_USE_SINGLE_LIBRARY)
 SLEPC_EXTERN PetscErrorCode PetscDLLibraryRegister_slepc(void)
@@ -37,6 +39,13 @@ SLEPC_EXTERN PetscErrorCode PetscDLLibraryRegister_slepc(void)
 SLEPC_EXTERN PetscErrorCode PetscDLLibraryRegister_slepcsys(void)
 #endif
 {
+#if defined(PETSC_USE_SINGLE_LIBRARY)
+  const char     *pkgs[] = {"eps","nep","pep","svd","mfn","lme"};
+  PetscErrorCode (*reg[])(void) = {PetscDLLibraryRegister_slepceps,PetscDLLibraryRegister_slepcnep,PetscDLLibraryRegister_slepcpep,PetscDLLibraryRegister_slepcsvd,PetscDLLibraryRegister_slepcmfn,PetscDLLibraryRegister_slepclme};
+  PetscInt       i;
+  PetscBool      load;
+#endif
+
   PetscFunctionBegin;
   PetscCall(STInitializePackage());
   PetscCall(DSInitializePackage());
@@ -45,12 +54,10 @@ SLEPC_EXTERN PetscErrorCode PetscDLLibraryRegister_slepcsys(void)
   PetscCall(RGInitializePackage());
 
 #if defined(PETSC_USE_SINGLE_LIBRARY)
-  PetscCall(PetscDLLibraryRegister_slepceps());
-  PetscCall(PetscDLLibraryRegister_slepcnep());
-  PetscCall(PetscDLLibraryRegister_slepcpep());
-  PetscCall(PetscDLLibraryRegister_slepcsvd());
-  PetscCall(PetscDLLibraryRegister_slepcmfn());
-  PetscCall(PetscDLLibraryRegister_slepclme());
+  for (i=0;i<6;i++) {
+    PetscCall(SlepcPreloadPackage_Private(pkgs[i],&load));
+    if (load) PetscCall((*reg[i])());
+  }
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
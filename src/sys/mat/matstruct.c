@@ -10,6 +10,111 @@
 
 #include <slepc/private/slepcimpl.h>            /*I "slepcsys.h" I*/
 
+/* workspace of the structured product with a BSE matrix, see MatMult_BSE() */
+typedef struct {
+  Mat X,Y;        /* two-column blocks [x1 conj(x2)] and [x2 conj(x1)] */
+  Mat RX,CY;      /* products R*X and C*Y */
+} MatBSEMult;
+
+static PetscErrorCode MatBSEMultDestroy(void **data)
+{
+  MatBSEMult *ctx = (MatBSEMult*)*data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ctx->X));
+  PetscCall(MatDestroy(&ctx->Y));
+  PetscCall(MatDestroy(&ctx->RX));
+  PetscCall(MatDestroy(&ctx->CY));
+  PetscCall(PetscFree(ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes y = H*x for H = [ R C; -C^H -R^T ] exploiting that R is Hermitian and C is
+   complex symmetric, so that the bottom block of the result is
+
+       y2 = -C^H*x1-R^T*x2 = -conj(R*conj(x2)+C*conj(x1)).
+
+   The two products with R (and the two with C) are done at once with a two-column dense
+   block, so that each matrix is read only once and no transpose product is needed. The
+   dense blocks have the vector type of R, so they live in the GPU if R does.
+*/
+static PetscErrorCode MatMult_BSE(Mat H,Vec x,Vec y)
+{
+  MatBSEMult     *ctx;
+  PetscContainer container;
+  Mat            R,C;
+  Vec            x1,x2,y1,y2,v,w;
+  IS             is[2];
+  VecType        vtype;
+  PetscInt       m,M;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectQuery((PetscObject)H,"MatBSEMult",(PetscObject*)&container));
+  PetscCall(PetscContainerGetPointer(container,(void**)&ctx));
+  PetscCall(MatNestGetSubMat(H,0,0,&R));
+  PetscCall(MatNestGetSubMat(H,0,1,&C));
+  if (!ctx->X) {
+    PetscCall(MatGetVecType(R,&vtype));
+    PetscCall(MatGetLocalSize(R,NULL,&m));
+    PetscCall(MatGetSize(R,NULL,&M));
+    PetscCall(MatCreateDenseFromVecType(PetscObjectComm((PetscObject)H),vtype,m,PETSC_DECIDE,M,2,-1,NULL,&ctx->X));
+    PetscCall(MatCreateDenseFromVecType(PetscObjectComm((PetscObject)H),vtype,m,PETSC_DECIDE,M,2,-1,NULL,&ctx->Y));
+    PetscCall(MatProductCreate(R,ctx->X,NULL,&ctx->RX));
+    PetscCall(MatProductSetType(ctx->RX,MATPRODUCT_AB));
+    PetscCall(MatProductSetFromOptions(ctx->RX));
+    PetscCall(MatProductSymbolic(ctx->RX));
+    PetscCall(MatProductCreate(C,ctx->Y,NULL,&ctx->CY));
+    PetscCall(MatProductSetType(ctx->CY,MATPRODUCT_AB));
+    PetscCall(MatProductSetFromOptions(ctx->CY));
+    PetscCall(MatProductSymbolic(ctx->CY));
+  }
+
+  /* X = [x1 conj(x2)], Y = [x2 conj(x1)] */
+  PetscCall(MatNestGetISs(H,NULL,is));
+  PetscCall(VecGetSubVector(x,is[0],&x1));
+  PetscCall(VecGetSubVector(x,is[1],&x2));
+  PetscCall(MatDenseGetColumnVecWrite(ctx->X,0,&v));
+  PetscCall(MatDenseGetColumnVecWrite(ctx->Y,1,&w));
+  PetscCall(VecCopy(x1,v));
+  PetscCall(VecCopy(x1,w));
+  PetscCall(VecConjugate(w));
+  PetscCall(MatDenseRestoreColumnVecWrite(ctx->X,0,&v));
+  PetscCall(MatDenseRestoreColumnVecWrite(ctx->Y,1,&w));
+  PetscCall(MatDenseGetColumnVecWrite(ctx->X,1,&v));
+  PetscCall(MatDenseGetColumnVecWrite(ctx->Y,0,&w));
+  PetscCall(VecCopy(x2,v));
+  PetscCall(VecConjugate(v));
+  PetscCall(VecCopy(x2,w));
+  PetscCall(MatDenseRestoreColumnVecWrite(ctx->X,1,&v));
+  PetscCall(MatDenseRestoreColumnVecWrite(ctx->Y,0,&w));
+  PetscCall(VecRestoreSubVector(x,is[0],&x1));
+  PetscCall(VecRestoreSubVector(x,is[1],&x2));
+
+  PetscCall(MatProductNumeric(ctx->RX));
+  PetscCall(MatProductNumeric(ctx->CY));
+
+  /* y1 = RX(:,0)+CY(:,0), y2 = -conj(RX(:,1)+CY(:,1)) */
+  PetscCall(MatNestGetISs(H,is,NULL));
+  PetscCall(VecGetSubVector(y,is[0],&y1));
+  PetscCall(MatDenseGetColumnVecRead(ctx->RX,0,&v));
+  PetscCall(MatDenseGetColumnVecRead(ctx->CY,0,&w));
+  PetscCall(VecWAXPY(y1,1.0,v,w));
+  PetscCall(MatDenseRestoreColumnVecRead(ctx->RX,0,&v));
+  PetscCall(MatDenseRestoreColumnVecRead(ctx->CY,0,&w));
+  PetscCall(VecRestoreSubVector(y,is[0],&y1));
+  PetscCall(VecGetSubVector(y,is[1],&y2));
+  PetscCall(MatDenseGetColumnVecRead(ctx->RX,1,&v));
+  PetscCall(MatDenseGetColumnVecRead(ctx->CY,1,&w));
+  PetscCall(VecWAXPY(y2,1.0,v,w));
+  PetscCall(MatDenseRestoreColumnVecRead(ctx->RX,1,&v));
+  PetscCall(MatDenseRestoreColumnVecRead(ctx->CY,1,&w));
+  PetscCall(VecConjugate(y2));
+  PetscCall(VecScale(y2,-1.0));
+  PetscCall(VecRestoreSubVector(y,is[1],&y2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    MatCreateBSE - Create a matrix that can be used to define a structured eigenvalue
    problem of type BSE (Bethe-Salpeter Equation).
@@ -36,7 +141,11 @@
 
    In the current implementation, H is a MATNEST matrix, where R and C form the top
    block row, while the bottom block row is composed of matrices of type
-   MATTRANSPOSEVIRTUAL and MATHERMITIANTRANSPOSEVIRTUAL scaled by -1.
+   MATTRANSPOSEVIRTUAL and MATHERMITIANTRANSPOSEVIRTUAL scaled by -1. If R and C are
+   of type MATAIJ or MATDENSE (including the GPU variants), the matrix-vector product
+   with H exploits the structure: the bottom block of the result is obtained from the
+   top block row, and the products with R (and with C) are computed together with a
+   two-column dense block, so that each matrix is read only once per product with H.
 
    Level: intermediate
 
@@ -47,6 +156,8 @@ PetscErrorCode MatCreateBSE(Mat R,Mat C,Mat *H)
   PetscInt       Mr,Mc,Nr,Nc,mr,mc,nr,nc;
   Mat            block[4] = { R, C, NULL, NULL };
   SlepcMatStruct mctx;
+  MatBSEMult     *bctx;
+  PetscBool      flg1,flg2;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(R,MAT_CLASSID,1);
@@ -76,5 +187,14 @@ PetscErrorCode MatCreateBSE(Mat R,Mat C,Mat *H)
   PetscCall(PetscNew(&mctx));
   mctx->cookie = SLEPC_MAT_STRUCT_BSE;
   PetscCall(PetscObjectContainerCompose((PetscObject)*H,"SlepcMatStruct",mctx,PetscContainerUserDestroyDefault));
+
+  /* structured matrix-vector product, if the blocks support products with dense matrices */
+  PetscCall(PetscObjectBaseTypeCompareAny((PetscObject)R,&flg1,MATSEQAIJ,MATMPIAIJ,MATSEQDENSE,MATMPIDENSE,""));
+  PetscCall(PetscObjectBaseTypeCompareAny((PetscObject)C,&flg2,MATSEQAIJ,MATMPIAIJ,MATSEQDENSE,MATMPIDENSE,""));
+  if (flg1 && flg2) {
+    PetscCall(PetscNew(&bctx));
+    PetscCall(PetscObjectContainerCompose((PetscObject)*H,"MatBSEMult",bctx,MatBSEMultDestroy));
+    PetscCall(MatSetOperation(*H,MATOP_MULT,(void(*)(void))MatMult_BSE));
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
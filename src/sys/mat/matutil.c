@@ -10,6 +10,8 @@
 
 #include <slepc/private/slepcimpl.h>            /*I "slepcsys.h" I*/
 
+PetscInt MatNormEstimateId = -1;
+
 static PetscErrorCode MatCreateTile_Seq(PetscScalar a,Mat A,PetscScalar b,Mat B,PetscScalar c,Mat C,PetscScalar d,Mat D,Mat G)
 {
   PetscInt          i,j,M1,M2,N1,N2,ncols,*scols;
@@ -170,6 +172,63 @@ static PetscErrorCode MatCreateTile_MPI(PetscScalar a,Mat A,PetscScalar b,Mat B,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   MatCreateTile_Preallocate - Count the nonzeros of the local rows of G, splitting
+   them in diagonal and off-diagonal parts, and preallocate G. The column mapping is
+   the same as in MatCreateTile_MPI(), which reduces to the trivial one in MatCreateTile_Seq()
+*/
+static PetscErrorCode MatCreateTile_Preallocate(PetscScalar a,Mat A,PetscScalar b,Mat B,PetscScalar c,Mat C,PetscScalar d,Mat D,Mat G)
+{
+  PetscMPIInt    np,rank;
+  PetscInt       p,i,j,k,N1,N2,m1,m2,nrows,row,col,cstart,cend,start,ncols,*map1,*map2,*dnz,*onz;
+  const PetscInt *cols,*mapptr1,*mapptr2;
+  Mat            block[4] = {A,B,C,D};
+  PetscScalar    scal[4] = {a,b,c,d};
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(A,NULL,&N1));
+  PetscCall(MatGetLocalSize(A,&m1,NULL));
+  PetscCall(MatGetSize(D,NULL,&N2));
+  PetscCall(MatGetLocalSize(D,&m2,NULL));
+
+  /* Create mappings */
+  PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)G),&np));
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)G),&rank));
+  PetscCall(MatGetOwnershipRangesColumn(A,&mapptr1));
+  PetscCall(MatGetOwnershipRangesColumn(B,&mapptr2));
+  PetscCall(PetscMalloc2(N1,&map1,N2,&map2));
+  PetscCall(PetscCalloc2(m1+m2,&dnz,m1+m2,&onz));
+  for (p=0;p<np;p++) {
+    for (i=mapptr1[p];i<mapptr1[p+1];i++) map1[i] = i+mapptr2[p];
+  }
+  for (p=0;p<np;p++) {
+    for (i=mapptr2[p];i<mapptr2[p+1];i++) map2[i] = i+mapptr1[p+1];
+  }
+  cstart = mapptr1[rank]+mapptr2[rank];
+  cend   = mapptr1[rank+1]+mapptr2[rank+1];
+
+  /* Count nonzeros of each block, the blocks never overlap in G */
+  for (k=0;k<4;k++) {
+    if (scal[k]==0.0) continue;
+    nrows = (k<2)? m1: m2;
+    PetscCall(MatGetOwnershipRange(block[k],&start,NULL));
+    for (i=0;i<nrows;i++) {
+      row = (k<2)? i: m1+i;
+      PetscCall(MatGetRow(block[k],i+start,&ncols,&cols,NULL));
+      for (j=0;j<ncols;j++) {
+        col = (k%2)? map2[cols[j]]: map1[cols[j]];
+        if (col>=cstart && col<cend) dnz[row]++;
+        else onz[row]++;
+      }
+      PetscCall(MatRestoreRow(block[k],i+start,&ncols,&cols,NULL));
+    }
+  }
+  PetscCall(MatXAIJSetPreallocation(G,1,dnz,onz,dnz,onz));
+  PetscCall(PetscFree2(map1,map2));
+  PetscCall(PetscFree2(dnz,onz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    MatCreateTile - Explicitly build a matrix from four blocks, G = [ a*A b*B; c*C d*D ].
 
@@ -200,6 +259,10 @@ static PetscErrorCode MatCreateTile_MPI(PetscScalar a,Mat A,PetscScalar b,Mat B,
    The type of the output matrix will be the same as the first block that is not
    ConstantDiagonal (checked in the A,B,C,D order).
 
+   For matrices with block size 1, the number of nonzeros of each row is computed in a
+   first pass, so that G is exactly preallocated before the values are inserted. This
+   includes the device AIJ types such as AIJCUSPARSE or AIJKOKKOS.
+
    Level: developer
 
 .seealso: MatCreateNest()
@@ -264,6 +327,7 @@ PetscErrorCode MatCreateTile(PetscScalar a,Mat A,PetscScalar b,Mat B,PetscScalar
   PetscCall(MatSetSizes(*G,m1+m2,n1+n2,M1+M2,N1+N2));
   PetscCall(MatSetType(*G,type[k]));
   PetscCall(MatSetBlockSize(*G,bs));
+  if (bs==1) PetscCall(MatCreateTile_Preallocate(a,A,b,B,c,C,d,D,*G));
   PetscCall(MatSetUp(*G));
 
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)*G),&size));
@@ -384,6 +448,9 @@ PetscErrorCode MatCreateVecsEmpty(Mat mat,Vec *right,Vec *left)
    The input vector vrn must have unit 2-norm.
    If vrn is NULL, then it is created internally and filled with VecSetRandomNormal().
 
+   The estimate is stored in the matrix object, and it is returned without further
+   computation in subsequent calls as long as the matrix has not been modified.
+
    Level: developer
 
 .seealso: VecSetRandomNormal()
@@ -391,6 +458,7 @@ PetscErrorCode MatCreateVecsEmpty(Mat mat,Vec *right,Vec *left)
 PetscErrorCode MatNormEstimate(Mat A,Vec vrn,Vec w,PetscReal *nrm)
 {
   PetscInt       n;
+  PetscBool      flg;
   Vec            vv=NULL,ww=NULL;
 
   PetscFunctionBegin;
@@ -400,6 +468,10 @@ PetscErrorCode MatNormEstimate(Mat A,Vec vrn,Vec w,PetscReal *nrm)
   if (w) PetscValidHeaderSpecific(w,VEC_CLASSID,3);
   PetscAssertPointer(nrm,4);
 
+  if (MatNormEstimateId<0) PetscCall(PetscObjectComposedDataRegister(&MatNormEstimateId));
+  PetscCall(PetscObjectComposedDataGetReal((PetscObject)A,MatNormEstimateId,*nrm,flg));
+  if (flg) PetscFunctionReturn(PETSC_SUCCESS);
+
   if (!vrn) {
     PetscCall(MatCreateVecs(A,&vv,NULL));
     vrn = vv;
@@ -415,6 +487,7 @@ PetscErrorCode MatNormEstimate(Mat A,Vec vrn,Vec w,PetscReal *nrm)
   PetscCall(MatMult(A,vrn,w));
   PetscCall(VecNorm(w,NORM_2,nrm));
   *nrm *= PetscSqrtReal((PetscReal)n);
+  PetscCall(PetscObjectComposedDataSetReal((PetscObject)A,MatNormEstimateId,*nrm));
 
   PetscCall(VecDestroy(&vv));
   PetscCall(VecDestroy(&ww));
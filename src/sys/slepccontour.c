@@ -18,15 +18,22 @@
    n - the number of integration points
    npart - number of partitions for the subcommunicator
    parent - parent object
+
+   The partitions are interlaced, unless the option -<class>_ciss_partitions_node_aware
+   of the parent is set, see SlepcSubcommSetType_Private().
 */
 PetscErrorCode SlepcContourDataCreate(PetscInt n,PetscInt npart,PetscObject parent,SlepcContourData *contour)
 {
+  char opt[64];
+
   PetscFunctionBegin;
   PetscCall(PetscNew(contour));
   (*contour)->parent = parent;
+  PetscCall(PetscSNPrintf(opt,sizeof(opt),"-%s_ciss_partitions_node_aware",parent->class_name));
+  PetscCall(PetscStrtolower(opt));
   PetscCall(PetscSubcommCreate(PetscObjectComm(parent),&(*contour)->subcomm));
   PetscCall(PetscSubcommSetNumber((*contour)->subcomm,npart));
-  PetscCall(PetscSubcommSetType((*contour)->subcomm,PETSC_SUBCOMM_INTERLACED));
+  PetscCall(SlepcSubcommSetType_Private(parent,opt,(*contour)->subcomm,PETSC_SUBCOMM_INTERLACED));
   (*contour)->npoints = n / npart;
   if (n%npart > (*contour)->subcomm->color) (*contour)->npoints++;
   PetscFunctionReturn(PETSC_SUCCESS);
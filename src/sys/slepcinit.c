@@ -9,6 +9,7 @@
 */
 
 #include <slepc/private/slepcimpl.h>           /*I "slepcsys.h" I*/
+#include <slepc/private/vecimplslepc.h>
 
 #if defined(SLEPC_HAVE_HPDDM)
 #include <petscksp.h>
@@ -145,13 +146,49 @@ SLEPC_EXTERN PetscErrorCode MFNInitializePackage(void);
 SLEPC_EXTERN PetscErrorCode LMEInitializePackage(void);
 #endif
 
+/*
+    SlepcPreloadPackage_Private - Determines whether a solver package (eps, svd, ...)
+    must be initialized when the libraries are preloaded. By default all of them are,
+    the option -library_preload_packages restricts it to the given list.
+*/
+PetscErrorCode SlepcPreloadPackage_Private(const char name[],PetscBool *load)
+{
+  char           list[256];
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *load = PETSC_TRUE;
+  PetscCall(PetscOptionsGetString(NULL,NULL,"-library_preload_packages",list,sizeof(list),&flg));
+  if (flg) PetscCall(PetscStrInList(name,list,',',load));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    SlepcInitialize_ThreadSafety - Creates in advance the global data of the sys library
+    that is otherwise created on first use, so that threads do not race for it.
+*/
+PetscErrorCode SlepcInitialize_ThreadSafety(void)
+{
+  PetscFunctionBegin;
+  PetscCall(VecCompInitialize_Private());
+  if (MatNormEstimateId<0) PetscCall(PetscObjectComposedDataRegister(&MatNormEstimateId));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
     SlepcInitialize_DynamicLibraries - Adds the default dynamic link libraries to the
     search path.
+
+    Without preloading, each package is initialized on the first call to its Create
+    function, so a program only pays for the packages that it uses.
 */
 PetscErrorCode SlepcInitialize_DynamicLibraries(void)
 {
-  PetscBool      preload = PETSC_FALSE;
+  PetscBool      preload = PETSC_FALSE,load;
+#if defined(PETSC_USE_SINGLE_LIBRARY) != (defined(PETSC_HAVE_DYNAMIC_LIBRARIES) && defined(PETSC_USE_SHARED_LIBRARIES))
+  const char     *pkgs[] = {"eps","pep","nep","svd","mfn","lme"};
+  PetscInt       i;
+#endif
 
   PetscFunctionBegin;
 #if defined(PETSC_HAVE_THREADSAFETY)
@@ -159,6 +196,8 @@ PetscErrorCode SlepcInitialize_DynamicLibraries(void)
   preload = PETSC_TRUE;
 #endif
 
+  PetscCall(PetscOptionsHasName(NULL,NULL,"-library_preload_packages",&load));
+  if (load) preload = PETSC_TRUE;
   PetscCall(PetscOptionsGetBool(NULL,NULL,"-library_preload",&preload,NULL));
   if (preload) {
 #if defined(PETSC_HAVE_DYNAMIC_LIBRARIES) && defined(PETSC_USE_SHARED_LIBRARIES)
@@ -169,32 +208,26 @@ PetscErrorCode SlepcInitialize_DynamicLibraries(void)
 #else
     PetscCall(SlepcLoadDynamicLibrary("sys",&found));
     PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc sys dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("eps",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc EPS dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("pep",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc PEP dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("nep",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc NEP dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("svd",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc SVD dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("mfn",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc MFN dynamic library. You cannot move the dynamic libraries!");
-    PetscCall(SlepcLoadDynamicLibrary("lme",&found));
-    PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc LME dynamic library. You cannot move the dynamic libraries!");
+    for (i=0;i<6;i++) {
+      PetscCall(SlepcPreloadPackage_Private(pkgs[i],&load));
+      if (!load) continue;
+      PetscCall(SlepcLoadDynamicLibrary(pkgs[i],&found));
+      PetscCheck(found,PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Unable to locate SLEPc %s dynamic library. You cannot move the dynamic libraries!",pkgs[i]);
+    }
 #endif
 #else /* defined(PETSC_HAVE_DYNAMIC_LIBRARIES) && defined(PETSC_USE_SHARED_LIBRARIES) */
 #if defined(PETSC_USE_SINGLE_LIBRARY)
+  PetscErrorCode (*init[])(void) = {EPSInitializePackage,PEPInitializePackage,NEPInitializePackage,SVDInitializePackage,MFNInitializePackage,LMEInitializePackage};
+
   PetscCall(STInitializePackage());
   PetscCall(DSInitializePackage());
   PetscCall(FNInitializePackage());
   PetscCall(BVInitializePackage());
   PetscCall(RGInitializePackage());
-  PetscCall(EPSInitializePackage());
-  PetscCall(SVDInitializePackage());
-  PetscCall(PEPInitializePackage());
-  PetscCall(NEPInitializePackage());
-  PetscCall(MFNInitializePackage());
-  PetscCall(LMEInitializePackage());
+  for (i=0;i<6;i++) {
+    PetscCall(SlepcPreloadPackage_Private(pkgs[i],&load));
+    if (load) PetscCall((*init[i])());
+  }
 #else
   SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"Cannot use -library_preload with multiple static SLEPc libraries");
 #endif
@@ -245,6 +278,23 @@ PetscErrorCode SlepcCitationsInitialize(void)
           (use NULL for default)
 -  help - [optional] Help message to print, use NULL for no message
 
+   Options Database Keys:
++  -library_preload - initialize all SLEPc packages in SlepcInitialize()
+-  -library_preload_packages <list> - initialize only the given solver packages,
+          e.g., eps,svd, in addition to the basic objects ST, DS, FN, BV and RG
+
+   Notes:
+   By default, each SLEPc package (EPS, SVD, PEP, NEP, MFN, LME) is initialized, that
+   is, its types, monitors and log events are registered, on the first call to its
+   Create function, so short runs that use only some of the solvers do not pay for
+   the rest. Preloading is needed when PETSc is configured with thread safety, and it
+   is done for all packages then unless -library_preload_packages is given.
+
+   With thread safety, SlepcInitialize() also creates all the global data that is
+   otherwise created on first use, so that afterwards several threads can work at
+   the same time with independent SLEPc objects created on PETSC_COMM_SELF, provided
+   that each object is used by only one thread. See the users manual for details.
+
    Fortran Notes:
    Fortran syntax is very similar to that of PetscInitialize()
 
@@ -269,6 +319,9 @@ PetscErrorCode SlepcInitialize(int *argc,char ***args,const char file[],const ch
 
   /* Load the dynamic libraries (on machines that support them), this registers all the solvers etc. */
   PetscCall(SlepcInitialize_DynamicLibraries());
+#if defined(PETSC_HAVE_THREADSAFETY)
+  PetscCall(SlepcInitialize_ThreadSafety());
+#endif
 
   SlepcInitializeCalled = PETSC_TRUE;
   SlepcFinalizeCalled   = PETSC_FALSE;
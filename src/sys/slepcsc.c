@@ -62,6 +62,147 @@ PetscErrorCode SlepcSCCompare(SlepcSC sc,PetscScalar ar,PetscScalar ai,PetscScal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   SlepcSCGetKeys_Private - Computes for each of the n values (re[i],im[i]) a group grp[i]
+   and a key key[i] such that SlepcSCCompare() of two values gives the same result as the
+   lexicographic comparison of their pairs (grp,key). The arrays re and im are overwritten
+   with the mapped values.
+
+   This is possible only for the predefined comparison functions, otherwise (or if a key
+   is NaN) flg is set to PETSC_FALSE and the caller must use SlepcSCCompare().
+*/
+PetscErrorCode SlepcSCGetKeys_Private(SlepcSC sc,PetscInt n,PetscScalar *re,PetscScalar *im,PetscInt *grp,PetscReal *key,PetscBool *flg)
+{
+  PetscErrorCode (*comp)(PetscScalar,PetscScalar,PetscScalar,PetscScalar,PetscInt*,void*) = sc->comparison;
+  PetscScalar    target = sc->comparisonctx? *(PetscScalar*)sc->comparisonctx: 0.0;
+  PetscInt       i,*cin;
+  PetscReal      sign=1.0;
+
+  PetscFunctionBegin;
+  *flg = PETSC_TRUE;
+  if (comp==SlepcCompareLargestMagnitude || comp==SlepcCompareLargestReal || comp==SlepcCompareLargestImaginary) sign = -1.0;
+  else if (comp!=SlepcCompareSmallestMagnitude && comp!=SlepcCompareSmallestReal && comp!=SlepcCompareSmallestImaginary && comp!=SlepcCompareTargetMagnitude && comp!=SlepcCompareTargetReal && comp!=SlepcCompareSmallestPosReal
+#if defined(PETSC_USE_COMPLEX)
+           && comp!=SlepcCompareTargetImaginary
+#endif
+          ) {
+    *flg = PETSC_FALSE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!sc->comparisonctx && (comp==SlepcCompareTargetMagnitude || comp==SlepcCompareTargetReal
+#if defined(PETSC_USE_COMPLEX)
+      || comp==SlepcCompareTargetImaginary
+#endif
+     )) {
+    *flg = PETSC_FALSE;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (sc->map) PetscCall((*sc->map)(sc->mapobj,n,re,im));
+
+  /* values inside the region go first */
+  if (sc->rg) {
+    PetscCall(PetscMalloc1(n,&cin));
+    PetscCall(RGCheckInside(sc->rg,n,re,im,cin));
+    for (i=0;i<n;i++) grp[i] = (cin[i]<0)? 2: 0;
+    PetscCall(PetscFree(cin));
+  } else for (i=0;i<n;i++) grp[i] = 0;
+
+  for (i=0;i<n;i++) {
+    if (comp==SlepcCompareLargestMagnitude || comp==SlepcCompareSmallestMagnitude) key[i] = sign*SlepcAbsEigenvalue(re[i],im[i]);
+    else if (comp==SlepcCompareLargestReal || comp==SlepcCompareSmallestReal) key[i] = sign*PetscRealPart(re[i]);
+    else if (comp==SlepcCompareLargestImaginary || comp==SlepcCompareSmallestImaginary) {
+#if defined(PETSC_USE_COMPLEX)
+      key[i] = sign*PetscImaginaryPart(re[i]);
+#else
+      key[i] = sign*PetscAbsReal(im[i]);
+#endif
+    } else if (comp==SlepcCompareTargetMagnitude) key[i] = SlepcAbsEigenvalue(re[i]-target,im[i]);
+    else if (comp==SlepcCompareTargetReal) key[i] = PetscAbsReal(PetscRealPart(re[i]-target));
+#if defined(PETSC_USE_COMPLEX)
+    else if (comp==SlepcCompareTargetImaginary) key[i] = PetscAbsReal(PetscImaginaryPart(re[i]-target));
+#endif
+    else {  /* SlepcCompareSmallestPosReal, values on the right go first */
+      if (PetscRealPart(re[i])<=0.0) grp[i]++;
+      key[i] = SlepcAbsEigenvalue(re[i],im[i]);
+    }
+    if (PetscIsNanReal(key[i])) {
+      *flg = PETSC_FALSE;
+      break;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcSortKeys_Private - Stable sort of the indices idx[0..n-1] in increasing order of
+   the pairs (grp[idx[i]],key[idx[i]]), with a bottom-up merge sort
+*/
+PetscErrorCode SlepcSortKeys_Private(PetscInt n,const PetscInt *grp,const PetscReal *key,PetscInt *idx)
+{
+  PetscInt w,l,m,r,p,q,k,*src=idx,*dst,*tmp,*work;
+
+  PetscFunctionBegin;
+  if (n<2) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(n,&work));
+  dst = work;
+  for (w=1;w<n;w*=2) {
+    for (l=0;l<n;l+=2*w) {
+      m = PetscMin(l+w,n);
+      r = PetscMin(l+2*w,n);
+      p = l; q = m; k = l;
+      /* take from the right run only if strictly smaller, to keep the sort stable */
+      while (p<m && q<r) {
+        if (grp[src[q]]<grp[src[p]] || (grp[src[q]]==grp[src[p]] && key[src[q]]<key[src[p]])) dst[k++] = src[q++];
+        else dst[k++] = src[p++];
+      }
+      while (p<m) dst[k++] = src[p++];
+      while (q<r) dst[k++] = src[q++];
+    }
+    tmp = src; src = dst; dst = tmp;
+  }
+  if (src!=idx) PetscCall(PetscArraycpy(idx,src,n));
+  PetscCall(PetscFree(work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcSortEigenvalues_Keys - Sorts the eigenvalues with precomputed keys, giving the same
+   permutation as the insertion sort; done is PETSC_FALSE if this is not possible
+*/
+static PetscErrorCode SlepcSortEigenvalues_Keys(SlepcSC sc,PetscInt n,PetscScalar *eigr,PetscScalar *eigi,PetscInt *perm,PetscBool *done)
+{
+  PetscScalar *re,*im;
+  PetscInt    i,k,u,nu=0,*grp,*start,*idx,*perm0;
+  PetscReal   *key;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  PetscCall(PetscMalloc7(n,&re,n,&im,n,&grp,n,&key,n+1,&start,n,&idx,n,&perm0));
+  /* each complex conjugate pair is kept together and sorted as its first value */
+  for (i=0;i<n;i++) {
+    start[nu] = i;
+    re[nu]    = eigr[perm[i]];
+    im[nu]    = eigi[perm[i]];
+#if !defined(PETSC_USE_COMPLEX)
+    if (im[nu]!=0.0) {
+      if (i+1==n || eigi[perm[i+1]]==0.0 || eigr[perm[i+1]]!=re[nu]) break;
+      i++;
+    }
+#endif
+    idx[nu] = nu;
+    nu++;
+  }
+  if (i==n) PetscCall(SlepcSCGetKeys_Private(sc,nu,re,im,grp,key,done));
+  if (*done) {
+    start[nu] = n;
+    PetscCall(SlepcSortKeys_Private(nu,grp,key,idx));
+    PetscCall(PetscArraycpy(perm0,perm,n));
+    for (k=0,u=0;u<nu;u++) for (i=start[idx[u]];i<start[idx[u]+1];i++) perm[k++] = perm0[i];
+  }
+  PetscCall(PetscFree7(re,im,grp,key,start,idx,perm0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    SlepcSortEigenvalues - Sorts a list of eigenvalues according to the
    sorting criterion specified in a SlepcSC context.
@@ -77,11 +218,18 @@ PetscErrorCode SlepcSCCompare(SlepcSC sc,PetscScalar ar,PetscScalar ai,PetscScal
    Output Parameter:
 .  perm - permutation array. Must be initialized to 0:n-1 on input.
 
-   Note:
+   Notes:
    The result is a list of indices in the original eigenvalue array
    corresponding to the first n eigenvalues sorted in the specified
    criterion.
 
+   With the predefined comparison functions such as SlepcCompareTargetMagnitude(),
+   a sort key is computed once for each eigenvalue, including the mapping
+   and the check of the region, and the list is sorted with a merge sort. With
+   other comparison functions, SlepcSCCompare() is called for each pair that
+   is compared. The resulting permutation is the same in both cases, where
+   eigenvalues that compare equal keep their relative order.
+
    Level: developer
 
 .seealso: SlepcSCCompare(), SlepcSC
@@ -90,12 +238,15 @@ PetscErrorCode SlepcSortEigenvalues(SlepcSC sc,PetscInt n,PetscScalar *eigr,Pets
 {
   PetscScalar    re,im;
   PetscInt       i,j,result,tmp;
+  PetscBool      done;
 
   PetscFunctionBegin;
   PetscAssertPointer(sc,1);
   PetscAssertPointer(eigr,3);
   PetscAssertPointer(eigi,4);
   PetscAssertPointer(perm,5);
+  PetscCall(SlepcSortEigenvalues_Keys(sc,n,eigr,eigi,perm,&done));
+  if (done) PetscFunctionReturn(PETSC_SUCCESS);
   /* insertion sort */
   for (i=n-1;i>=0;i--) {
     re = eigr[perm[i]];
@@ -9,6 +9,9 @@
 */
 
 #include <slepc/private/slepcimpl.h>            /*I "slepcsys.h" I*/
+#include <slepc/private/bvimpl.h>
+#include <slepc/private/dsimpl.h>
+#include <slepc/private/stimpl.h>
 
 /*
    Internal functions used to register monitors.
@@ -68,6 +71,300 @@ PetscErrorCode SlepcBasisDestroy_Private(PetscInt *m,Vec **W)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Gets the index of the next piece to be processed by a partition in spectrum
+   slicing with dynamic load balancing, or -1 if there is no work left. It must be
+   called by the first process of partition color only. The window win contains
+   the queue of each partition, a range [q0,q1) of piece indices, and in[] gives
+   the accumulated number of eigenvalues, so that the pieces q0,...,q1-1 contain
+   in[q1]-in[q0] eigenvalues. A partition takes the pieces from the front of its
+   own queue, and when it is empty it steals the pieces at the back of the queue
+   of the partition with more eigenvalues pending, about half of them.
+*/
+PetscErrorCode SlepcSliceGetNextChunk_Private(PetscObject obj,MPI_Win win,PetscMPIInt color,PetscMPIInt npart,const PetscInt in[],PetscInt *chunk)
+{
+  PetscInt    j=0,q[2],nleft,nmax,cnt;
+  PetscMPIInt p,victim=0;
+
+  PetscFunctionBegin;
+  *chunk = -1;
+  /* take the first piece of the own queue */
+  PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,color,0,win));
+  PetscCallMPI(MPI_Get(q,2,MPIU_INT,color,0,2,MPIU_INT,win));
+  PetscCallMPI(MPI_Win_flush(color,win));
+  if (q[0]<q[1]) {
+    *chunk = q[0]++;
+    PetscCallMPI(MPI_Put(q,1,MPIU_INT,color,0,1,MPIU_INT,win));
+  }
+  PetscCallMPI(MPI_Win_unlock(color,win));
+  while (*chunk<0) {
+    /* look for the partition with more eigenvalues pending */
+    nmax = 0;
+    for (p=0;p<npart;p++) {
+      if (p==color) continue;
+      PetscCallMPI(MPI_Win_lock(MPI_LOCK_SHARED,p,0,win));
+      PetscCallMPI(MPI_Get(q,2,MPIU_INT,p,0,2,MPIU_INT,win));
+      PetscCallMPI(MPI_Win_unlock(p,win));
+      nleft = (q[0]<q[1])? in[q[1]]-in[q[0]]: 0;
+      if (nleft>nmax) { nmax = nleft; victim = p; }
+    }
+    if (!nmax) break;
+    /* steal the pieces at the back of its queue, if it has not taken them meanwhile */
+    PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,victim,0,win));
+    PetscCallMPI(MPI_Get(q,2,MPIU_INT,victim,0,2,MPIU_INT,win));
+    PetscCallMPI(MPI_Win_flush(victim,win));
+    if (q[0]<q[1]) {
+      nleft = in[q[1]]-in[q[0]];
+      j = q[1]-1;
+      cnt = in[q[1]]-in[j];
+      while (j>q[0] && 2*(cnt+in[j]-in[j-1])<=nleft) { j--; cnt += in[j+1]-in[j]; }
+      *chunk = j;
+      q[0] = j+1; /* stolen pieces, except the first one */
+      PetscCallMPI(MPI_Put(&j,1,MPIU_INT,victim,1,1,MPIU_INT,win));
+    }
+    PetscCallMPI(MPI_Win_unlock(victim,win));
+    if (*chunk>=0) {
+      PetscCall(PetscInfo(obj,"Partition %d takes %" PetscInt_FMT " pieces from partition %d\n",(int)color,q[1]-j,(int)victim));
+      PetscCallMPI(MPI_Win_lock(MPI_LOCK_EXCLUSIVE,color,0,win));
+      PetscCallMPI(MPI_Put(q,2,MPIU_INT,color,0,2,MPIU_INT,win));
+      PetscCallMPI(MPI_Win_unlock(color,win));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Sets the layout of the partitions of subc, whose number must have been set already.
+   It is the given type unless the option opt of obj is set, in which case the processes
+   are ordered by shared-memory node (as given by MPI_Comm_split_type()) and then split
+   contiguously, so that each partition spans as few nodes as possible, regardless of
+   how the ranks have been placed on the nodes. The partitions have the same sizes as
+   with PETSC_SUBCOMM_CONTIGUOUS.
+*/
+PetscErrorCode SlepcSubcommSetType_Private(PetscObject obj,const char opt[],PetscSubcomm subc,PetscSubcommType type)
+{
+  MPI_Comm    comm=PetscObjectComm(obj),node;
+  PetscMPIInt size,rank,nrank,leader,key[2],*keys,i,pos=0,sub,mod,color,subrank;
+  PetscBool   flg=PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCall(PetscOptionsGetBool(obj->options,obj->prefix,opt,&flg,NULL));
+  if (!flg) {
+    PetscCall(PetscSubcommSetType(subc,type));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCallMPI(MPI_Comm_size(comm,&size));
+  PetscCallMPI(MPI_Comm_rank(comm,&rank));
+  PetscCallMPI(MPI_Comm_split_type(comm,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&node));
+  PetscCallMPI(MPI_Comm_rank(node,&nrank));
+  leader = rank;
+  PetscCallMPI(MPI_Bcast(&leader,1,MPI_INT,0,node));
+  PetscCallMPI(MPI_Comm_free(&node));
+
+  /* position of this process when sorted by node (identified by its first rank) */
+  key[0] = leader; key[1] = nrank;
+  PetscCall(PetscMalloc1(2*size,&keys));
+  PetscCallMPI(MPI_Allgather(key,2,MPI_INT,keys,2,MPI_INT,comm));
+  for (i=0;i<size;i++) if (keys[2*i]<leader || (keys[2*i]==leader && keys[2*i+1]<nrank)) pos++;
+  PetscCall(PetscFree(keys));
+
+  /* the first mod partitions have one more process */
+  sub = size/subc->n;
+  mod = size%subc->n;
+  if (pos<mod*(sub+1)) {
+    color   = pos/(sub+1);
+    subrank = pos%(sub+1);
+  } else {
+    color   = mod+(pos-mod*(sub+1))/sub;
+    subrank = (pos-mod*(sub+1))%sub;
+  }
+  PetscCall(PetscSubcommSetTypeGeneral(subc,color,subrank));
+  PetscCall(PetscInfo(obj,"Partitions of the communicator aligned with the shared-memory nodes\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcPerfStatsGet_Private - Get the current accumulated performance data, in the
+   current logging stage, of the events associated with each SlepcPerfPhase, where
+   solve and setup are the events of the solver class. All data are zero if logging
+   is not active.
+*/
+static PetscErrorCode SlepcPerfStatsGet_Private(PetscLogEvent solve,PetscLogEvent setup,PetscEventPerfInfo info[])
+{
+  PetscLogEvent ev[SLEPC_PERF_NPHASES];
+  PetscBool     active=PETSC_FALSE;
+  PetscInt      i;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(info,SLEPC_PERF_NPHASES));
+  PetscCall(PetscLogIsActive(&active));
+  if (!active) PetscFunctionReturn(PETSC_SUCCESS);
+  /* make sure that the events are registered */
+  PetscCall(BVInitializePackage());
+  PetscCall(DSInitializePackage());
+  PetscCall(STInitializePackage());
+  ev[SLEPC_PERF_SOLVE]         = solve;
+  ev[SLEPC_PERF_SETUP]         = setup;
+  ev[SLEPC_PERF_ORTHOGONALIZE] = BV_Orthogonalize;
+  ev[SLEPC_PERF_DSSOLVE]       = DS_Solve;
+  ev[SLEPC_PERF_DSSYNCHRONIZE] = DS_Synchronize;
+  ev[SLEPC_PERF_STAPPLY]       = ST_Apply;
+  PetscCall(PetscLogEventGetId("MatMult",&ev[SLEPC_PERF_MATMULT]));
+  PetscCall(PetscLogEventGetId("KSPSolve",&ev[SLEPC_PERF_KSPSOLVE]));
+  for (i=0;i<SLEPC_PERF_NPHASES;i++) {
+    if (ev[i]>=0) PetscCall(PetscLogEventGetPerfInfo(PETSC_DETERMINE,ev[i],&info[i]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcPerfStatsBegin_Private - Take a snapshot of the performance data at the start
+   of a solve, to be passed to SlepcPerfStatsEnd_Private().
+*/
+PetscErrorCode SlepcPerfStatsBegin_Private(PetscLogEvent solve,PetscLogEvent setup,PetscEventPerfInfo perf[])
+{
+  PetscFunctionBegin;
+  PetscCall(SlepcPerfStatsGet_Private(solve,setup,perf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcPerfStatsEnd_Private - Replace the snapshot taken by SlepcPerfStatsBegin_Private()
+   with the counts, time, flops, messages and reductions accumulated since then.
+*/
+PetscErrorCode SlepcPerfStatsEnd_Private(PetscLogEvent solve,PetscLogEvent setup,PetscEventPerfInfo perf[])
+{
+  PetscEventPerfInfo now[SLEPC_PERF_NPHASES],delta;
+  PetscInt           i;
+
+  PetscFunctionBegin;
+  PetscCall(SlepcPerfStatsGet_Private(solve,setup,now));
+  for (i=0;i<SLEPC_PERF_NPHASES;i++) {
+    PetscCall(PetscMemzero(&delta,sizeof(PetscEventPerfInfo)));
+    delta.count         = now[i].count-perf[i].count;
+    delta.time          = now[i].time-perf[i].time;
+    delta.flops         = now[i].flops-perf[i].flops;
+    delta.numMessages   = now[i].numMessages-perf[i].numMessages;
+    delta.messageLength = now[i].messageLength-perf[i].messageLength;
+    delta.numReductions = now[i].numReductions-perf[i].numReductions;
+    perf[i] = delta;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcPerfStatsView_Private - Print the number of global reductions of the last solve,
+   as obtained by SlepcPerfStatsEnd_Private(), in an ASCII viewer. Nothing is printed if
+   logging was not active or there were no reductions (one process).
+*/
+PetscErrorCode SlepcPerfStatsView_Private(PetscEventPerfInfo perf[],PetscInt its,PetscViewer viewer)
+{
+  PetscLogDouble nred = perf[SLEPC_PERF_SOLVE].numReductions;
+
+  PetscFunctionBegin;
+  if (!perf[SLEPC_PERF_SOLVE].count || nred==0.0) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerASCIIPrintf(viewer,"  global reductions in the last solve: %g",nred));
+  PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_FALSE));
+  if (its>0) PetscCall(PetscViewerASCIIPrintf(viewer," (%.1f per iteration)",nred/its));
+  PetscCall(PetscViewerASCIIPrintf(viewer,", %g in orthogonalization, %g in matrix-vector products\n",perf[SLEPC_PERF_ORTHOGONALIZE].numReductions,perf[SLEPC_PERF_MATMULT].numReductions));
+  PetscCall(PetscViewerASCIIUseTabs(viewer,PETSC_TRUE));
+  if (perf[SLEPC_PERF_DSSYNCHRONIZE].count) PetscCall(PetscViewerASCIIPrintf(viewer,"  broadcasts of the projected problem in the last solve: %d\n",perf[SLEPC_PERF_DSSYNCHRONIZE].count));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcHistMonCreate_Private - Creates the context of the monitors that keep the
+   convergence history in memory, XXXMonitorAllBinary(). The buffer is allocated
+   at the first iteration, when the number of values is known.
+*/
+PetscErrorCode SlepcHistMonCreate_Private(PetscViewer viewer,PetscViewerFormat format,void *ctx,PetscViewerAndFormat **vf)
+{
+  SlepcHistMon mctx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerAndFormatCreate(viewer,format,vf));
+  PetscCall(PetscNew(&mctx));
+  (*vf)->data = (void*)mctx;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcHistMonGetSlot_Private - Records the iteration number, the number of converged
+   values and a time stamp, and returns the arrays where the caller must copy the first
+   n values and error estimates of this iteration, where n is nest truncated to the
+   value of ld at the first call. When the buffer is full
+   the oldest iteration is overwritten. The capacity of the buffer is taken from the
+   option given in opt, with the prefix of obj.
+*/
+PetscErrorCode SlepcHistMonGetSlot_Private(PetscObject obj,const char opt[],PetscInt ld,PetscInt its,PetscInt nconv,PetscInt nest,PetscViewerAndFormat *vf,PetscInt *n,PetscScalar **eigr,PetscScalar **eigi,PetscReal **errest)
+{
+  SlepcHistMon   mctx = (SlepcHistMon)vf->data;
+  PetscInt       k;
+  PetscLogDouble t;
+
+  PetscFunctionBegin;
+  PetscCall(PetscTime(&t));
+  if (!mctx->size) {
+    mctx->size = SLEPC_HISTMON_SIZE;
+    PetscCall(PetscOptionsGetInt(obj->options,obj->prefix,opt,&mctx->size,NULL));
+    PetscCheck(mctx->size>0,PetscObjectComm(obj),PETSC_ERR_ARG_OUTOFRANGE,"Illegal value of %s, must be > 0",opt);
+    mctx->ld = PetscMax(ld,1);
+    mctx->t0 = t;
+    PetscCall(PetscMalloc4(mctx->size,&mctx->its,mctx->size,&mctx->nconv,mctx->size,&mctx->nest,mctx->size,&mctx->time));
+    PetscCall(PetscMalloc3(mctx->size*mctx->ld,&mctx->eigr,mctx->size*mctx->ld,&mctx->eigi,mctx->size*mctx->ld,&mctx->errest));
+  }
+  k = mctx->count%mctx->size;
+  mctx->its[k]   = its;
+  mctx->nconv[k] = nconv;
+  mctx->nest[k]  = PetscMin(nest,mctx->ld);
+  mctx->time[k]  = t-mctx->t0;
+  mctx->count++;
+  *n      = mctx->nest[k];
+  *eigr   = mctx->eigr+k*mctx->ld;
+  *eigi   = mctx->eigi+k*mctx->ld;
+  *errest = mctx->errest+k*mctx->ld;
+  PetscCall(PetscArrayzero(*eigi,mctx->ld));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SlepcHistMonDestroy_Private - Writes the recorded convergence history to the binary
+   viewer and destroys the monitor context. The file contains the number of stored
+   iterations and then, from the oldest to the newest, the iteration number, the number
+   of converged values, the number of values nest (PETSC_INT), the time stamp in seconds
+   (PETSC_DOUBLE), nest real and nest imaginary parts (PETSC_SCALAR) and nest error
+   estimates (PETSC_REAL).
+*/
+PetscErrorCode SlepcHistMonDestroy_Private(PetscViewerAndFormat **vf)
+{
+  SlepcHistMon mctx;
+  PetscInt     i,k,n,first,ints[3];
+
+  PetscFunctionBegin;
+  if (!*vf) PetscFunctionReturn(PETSC_SUCCESS);
+  mctx  = (SlepcHistMon)(*vf)->data;
+  n     = PetscMin(mctx->count,mctx->size);
+  first = mctx->count-n;
+  PetscCall(PetscViewerBinaryWrite((*vf)->viewer,&n,1,PETSC_INT));
+  for (i=0;i<n;i++) {
+    k = (first+i)%mctx->size;
+    ints[0] = mctx->its[k]; ints[1] = mctx->nconv[k]; ints[2] = mctx->nest[k];
+    PetscCall(PetscViewerBinaryWrite((*vf)->viewer,ints,3,PETSC_INT));
+    PetscCall(PetscViewerBinaryWrite((*vf)->viewer,mctx->time+k,1,PETSC_DOUBLE));
+    PetscCall(PetscViewerBinaryWrite((*vf)->viewer,mctx->eigr+k*mctx->ld,ints[2],PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryWrite((*vf)->viewer,mctx->eigi+k*mctx->ld,ints[2],PETSC_SCALAR));
+    PetscCall(PetscViewerBinaryWrite((*vf)->viewer,mctx->errest+k*mctx->ld,ints[2],PETSC_REAL));
+  }
+  if (mctx->size) {
+    PetscCall(PetscFree4(mctx->its,mctx->nconv,mctx->nest,mctx->time));
+    PetscCall(PetscFree3(mctx->eigr,mctx->eigi,mctx->errest));
+  }
+  PetscCall(PetscFree((*vf)->data));
+  PetscCall(PetscViewerDestroy(&(*vf)->viewer));
+  PetscCall(PetscFree(*vf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    SlepcSNPrintfScalar - Prints a PetscScalar variable to a string of
    given length.
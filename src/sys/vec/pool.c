@@ -9,10 +9,38 @@
 */
 /*
    Implementation of a pool of Vec using VecDuplicateVecs
+
+   The pool is a list of chunks, each one created with VecDuplicateVecs. The
+   chunks in use form a prefix of the list, and vectors are handed out in a
+   stack-like fashion from the last chunk in use. The chunks that become empty
+   are kept for later requests, and new chunks are allocated with sizes rounded
+   up to a power of two, so that a sequence of requests of varying size does not
+   allocate and free vectors (possibly in device memory) over and over
 */
 
 #include <slepc/private/vecimplslepc.h>       /*I "slepcvec.h" I*/
 
+#define VECPOOL_MINCHUNK 4
+
+/* smallest size class that can hold n vectors */
+static PetscInt VecPoolSizeClass(PetscInt n)
+{
+  PetscInt s = VECPOOL_MINCHUNK;
+
+  while (s<n) s *= 2;
+  return s;
+}
+
+/* replace the vectors of an empty chunk with a new set of (at least) n vectors */
+static PetscErrorCode VecPoolResizeChunk(VecPool pool,Vec v,PetscInt n)
+{
+  PetscFunctionBegin;
+  PetscCall(VecDestroyVecs(pool->n,&pool->vecs));
+  pool->n = VecPoolSizeClass(n);
+  PetscCall(VecDuplicateVecs(v,pool->n,&pool->vecs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    SlepcVecPoolCreate - Create a pool of Vec.
 
@@ -94,21 +122,26 @@ PetscErrorCode SlepcVecPoolDestroy(VecPool *p)
 PetscErrorCode SlepcVecPoolGetVecs(VecPool p,PetscInt n,Vec **vecs)
 {
   VecPool_       *pool = (VecPool_*)p;
+  PetscInt       used = 0;
 
   PetscFunctionBegin;
   PetscAssertPointer(p,1);
   PetscAssertPointer(vecs,3);
   PetscCheck(n>=0,PetscObjectComm((PetscObject)pool->v),PETSC_ERR_ARG_OUTOFRANGE,"n should be positive");
-  while (pool->next) pool = pool->next;
+  /* last chunk in use, or the first one if the pool is empty */
+  while (pool->next && pool->next->used) {
+    used += pool->used;
+    pool = pool->next;
+  }
+  used += pool->used;
+  p->guess = PetscMax(p->guess,used+n);
   if (pool->n-pool->used < n) {
-    pool->guess = PetscMax(p->guess,pool->used+n);
-    if (pool->vecs && pool->used == 0) PetscCall(VecDestroyVecs(pool->n,&pool->vecs));
-    if (pool->vecs) {
-      PetscCall(SlepcVecPoolCreate(p->v,pool->guess-pool->used,&pool->next));
+    if (!pool->used) PetscCall(VecPoolResizeChunk(pool,p->v,p->guess));
+    else {
+      if (!pool->next) PetscCall(SlepcVecPoolCreate(p->v,0,&pool->next));
       pool = pool->next;
+      if (pool->n < n) PetscCall(VecPoolResizeChunk(pool,p->v,PetscMax(n,p->guess-used)));
     }
-    pool->n = pool->guess;
-    PetscCall(VecDuplicateVecs(p->v,pool->n,&pool->vecs));
   }
   *vecs = pool->vecs + pool->used;
   pool->used += n;
@@ -126,23 +159,21 @@ PetscErrorCode SlepcVecPoolGetVecs(VecPool p,PetscInt n,Vec **vecs)
 .  n    - number of vectors.
 -  vecs - vectors
 
+   Notes:
+   The vectors must be restored in the reverse order they were obtained. The
+   memory is not released until the pool is destroyed.
+
    Level: developer
 
 .seealso: SlepcVecPoolGetVecs()
 */
 PetscErrorCode SlepcVecPoolRestoreVecs(VecPool p,PetscInt n,Vec **vecs)
 {
-  VecPool_       *pool = (VecPool_*)p, *pool0 = pool;
+  VecPool_       *pool = (VecPool_*)p;
 
   PetscFunctionBegin;
-  while (pool->next) pool = (pool0 = pool)->next;
-  if (pool->used == 0 && pool0 != pool) {
-    pool0->guess = pool0->used + pool->guess;
-    PetscCall(SlepcVecPoolDestroy((VecPool*)&pool));
-    pool = pool0;
-    pool->next = NULL;
-  }
+  while (pool->next && pool->next->used) pool = pool->next;
+  PetscCheck(n<=pool->used,PetscObjectComm((PetscObject)pool->v),PETSC_ERR_ARG_OUTOFRANGE,"Unmatched SlepcVecPoolRestoreVecs");
   pool->used -= n;
-  PetscCheck(pool->used>=0,PetscObjectComm((PetscObject)pool->v),PETSC_ERR_ARG_OUTOFRANGE,"Unmatched SlepcVecPoolRestoreVecs");
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -145,8 +145,10 @@ int main(int argc,char **argv)
   PetscCall(VecNorm(yc,NORM_2,&normc));
   PetscCheck(PetscAbsReal(norm-normc)<10*PETSC_MACHINE_EPSILON,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Norms are different");
 
-  PetscCall(VecMax(xc,NULL,&vmax));
-  PetscCall(VecMin(xc,NULL,&vmin));
+  PetscCall(VecMax(xc,&k,&vmax));
+  PetscCheck(k==3,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong location of the maximum");
+  PetscCall(VecMin(xc,&k,&vmin));
+  PetscCheck(k==6,PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong location of the minimum");
   PetscCall(PetscPrintf(PETSC_COMM_WORLD,"xc has max value %g min value %g\n",(double)vmax,(double)vmin));
 
   PetscCall(VecMaxPointwiseDivide(wc,xc,&vmax));
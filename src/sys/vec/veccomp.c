@@ -105,6 +105,21 @@ static PetscErrorCode VecCompNormInit(void)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   VecCompInitialize_Private - Registers VECCOMP and creates the MPI types and operation
+   used in the norms. It is called on the first creation of a VECCOMP, or in SlepcInitialize()
+   if PETSc has been configured with thread safety.
+*/
+PetscErrorCode VecCompInitialize_Private(void)
+{
+  PetscFunctionBegin;
+  if (VecCompInitialized) PetscFunctionReturn(PETSC_SUCCESS);
+  VecCompInitialized = PETSC_TRUE;
+  PetscCall(VecRegister(VECCOMP,VecCreate_Comp));
+  PetscCall(VecCompNormInit());
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecDestroy_Comp(Vec v)
 {
   Vec_Comp       *vs = (Vec_Comp*)v->data;
@@ -229,11 +244,7 @@ static PetscErrorCode VecCreate_Comp_Private(Vec v,Vec *x,PetscInt nx,PetscBool
   PetscInt       N=0,lN=0,i,k;
 
   PetscFunctionBegin;
-  if (!VecCompInitialized) {
-    VecCompInitialized = PETSC_TRUE;
-    PetscCall(VecRegister(VECCOMP,VecCreate_Comp));
-    PetscCall(VecCompNormInit());
-  }
+  PetscCall(VecCompInitialize_Private());
 
   /* Allocate a new Vec_Comp */
   if (v->data) PetscCall(PetscFree(v->data));
@@ -584,79 +595,85 @@ PetscErrorCode VecGetLocalSize_Comp(Vec v,PetscInt *size)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode VecMax_Comp(Vec v,PetscInt *idx,PetscReal *z)
+/*
+   VecCompMaxMin_Private - local part of VecMax/VecMin on the subvectors, with a
+   single reduction at the end. Indices refer to the concatenation of subvectors
+*/
+static PetscErrorCode VecCompMaxMin_Private(Vec v,PetscBool max,PetscInt *idx,PetscReal *z)
 {
-  Vec_Comp       *vs = (Vec_Comp*)v->data;
-  PetscInt       idxp,s=0,s0;
-  PetscReal      zp,z0;
-  PetscInt       i;
+  Vec_Comp          *vs = (Vec_Comp*)v->data;
+  const PetscScalar *x;
+  PetscReal         val;
+  PetscInt          i,j,n,N,s=0,rstart;
+  struct {
+    PetscReal v;
+    PetscInt  i;
+  } in,out;
 
   PetscFunctionBegin;
-  SlepcValidVecComp(v,1);
-  if (!idx && !z) PetscFunctionReturn(PETSC_SUCCESS);
-
-  if (vs->n->n > 0) PetscCall(VecMax(vs->x[0],idx?&idxp:NULL,&zp));
-  else {
-    zp = PETSC_MIN_REAL;
-    if (idx) idxp = -1;
-  }
-  for (i=1;i<vs->n->n;i++) {
-    PetscCall(VecGetSize(vs->x[i-1],&s0));
-    s += s0;
-    PetscCall(VecMax(vs->x[i],idx?&idxp:NULL,&z0));
-    if (zp < z0) {
-      if (idx) *idx = s+idxp;
-      zp = z0;
+  in.v = max? PETSC_MIN_REAL: PETSC_MAX_REAL;
+  in.i = -1;
+  for (i=0;i<vs->n->n;i++) {
+    PetscCall(VecGetLocalSize(vs->x[i],&n));
+    PetscCall(VecGetOwnershipRange(vs->x[i],&rstart,NULL));
+    PetscCall(VecGetArrayRead(vs->x[i],&x));
+    for (j=0;j<n;j++) {
+      val = PetscRealPart(x[j]);
+      if (in.i<0 || (max && val>in.v) || (!max && val<in.v)) {
+        in.v = val;
+        in.i = s+rstart+j;
+      }
     }
+    PetscCall(VecRestoreArrayRead(vs->x[i],&x));
+    PetscCall(VecGetSize(vs->x[i],&N));
+    s += N;
   }
-  if (z) *z = zp;
+  PetscCallMPI(MPIU_Allreduce(&in,&out,1,MPIU_REAL_INT,max?MPIU_MAXLOC:MPIU_MINLOC,PetscObjectComm((PetscObject)v)));
+  if (idx) *idx = out.i;
+  if (z) *z = out.v;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode VecMin_Comp(Vec v,PetscInt *idx,PetscReal *z)
+PetscErrorCode VecMax_Comp(Vec v,PetscInt *idx,PetscReal *z)
 {
-  Vec_Comp       *vs = (Vec_Comp*)v->data;
-  PetscInt       idxp,s=0,s0;
-  PetscReal      zp,z0;
-  PetscInt       i;
-
   PetscFunctionBegin;
   SlepcValidVecComp(v,1);
   if (!idx && !z) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecCompMaxMin_Private(v,PETSC_TRUE,idx,z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  if (vs->n->n > 0) PetscCall(VecMin(vs->x[0],idx?&idxp:NULL,&zp));
-  else {
-    zp = PETSC_MAX_REAL;
-    if (idx) idxp = -1;
-  }
-  for (i=1;i<vs->n->n;i++) {
-    PetscCall(VecGetSize(vs->x[i-1],&s0));
-    s += s0;
-    PetscCall(VecMin(vs->x[i],idx?&idxp:NULL,&z0));
-    if (zp > z0) {
-      if (idx) *idx = s+idxp;
-      zp = z0;
-    }
-  }
-  if (z) *z = zp;
+PetscErrorCode VecMin_Comp(Vec v,PetscInt *idx,PetscReal *z)
+{
+  PetscFunctionBegin;
+  SlepcValidVecComp(v,1);
+  if (!idx && !z) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecCompMaxMin_Private(v,PETSC_FALSE,idx,z));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 PetscErrorCode VecMaxPointwiseDivide_Comp(Vec v,Vec w,PetscReal *m)
 {
-  Vec_Comp       *vs = (Vec_Comp*)v->data,*ws = (Vec_Comp*)w->data;
-  PetscReal      work;
-  PetscInt       i;
+  Vec_Comp          *vs = (Vec_Comp*)v->data,*ws = (Vec_Comp*)w->data;
+  const PetscScalar *x,*y;
+  PetscReal         work = 0.0;
+  PetscInt          i,j,n;
 
   PetscFunctionBegin;
   SlepcValidVecComp(v,1);
   SlepcValidVecComp(w,2);
-  if (!m || vs->n->n == 0) PetscFunctionReturn(PETSC_SUCCESS);
-  PetscCall(VecMaxPointwiseDivide(vs->x[0],ws->x[0],m));
-  for (i=1;i<vs->n->n;i++) {
-    PetscCall(VecMaxPointwiseDivide(vs->x[i],ws->x[i],&work));
-    *m = PetscMax(*m,work);
+  if (!m) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* local maximum of |v./w| over all subvectors, then a single reduction */
+  for (i=0;i<vs->n->n;i++) {
+    PetscCall(VecGetLocalSize(vs->x[i],&n));
+    PetscCall(VecGetArrayRead(vs->x[i],&x));
+    PetscCall(VecGetArrayRead(ws->x[i],&y));
+    for (j=0;j<n;j++) work = PetscMax(work,(y[j] != 0.0)? PetscAbsScalar(x[j]/y[j]): PetscAbsScalar(x[j]));
+    PetscCall(VecRestoreArrayRead(vs->x[i],&x));
+    PetscCall(VecRestoreArrayRead(ws->x[i],&y));
   }
+  PetscCallMPI(MPIU_Allreduce(&work,m,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)v)));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 